@@ -0,0 +1,278 @@
+/**
+ * @file   icarusalg/Geometry/AuxDetSpatialIndex.cxx
+ * @brief  Spatial index of CRT modules and strips (auxiliary detectors).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Geometry/AuxDetSpatialIndex.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/AuxDetSpatialIndex.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/AuxDetGeo.h"
+#include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max(), std::clamp()
+#include <cmath> // std::pow(), std::ceil(), std::floor(), std::nextafter()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Target average number of cells per indexed element.
+  constexpr double CellsPerElement = 4.0;
+
+  /// Maximum number of cells on each direction.
+  constexpr std::size_t MaxCellsPerAxis = 512U;
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+icarus::AuxDetSpatialIndex::AuxDetSpatialIndex
+  (geo::GeometryCore const& geom, double tolerance /* = 0.0 */)
+  : fGeom(&geom)
+  , fTolerance(tolerance)
+  , fNAuxDets(geom.NAuxDets())
+{
+  //
+  // collect the bounding boxes, in index order
+  //
+  std::vector<Box_t> auxDetBoxes;
+  auxDetBoxes.reserve(fNAuxDets);
+  std::vector<Box_t> sensitiveBoxes;
+  for (std::size_t ad = 0; ad < fNAuxDets; ++ad) {
+    geo::AuxDetGeo const& auxDet = geom.AuxDet(ad);
+    auxDetBoxes.push_back(boundingBox(auxDet, fTolerance));
+    for (std::size_t sv = 0; sv < auxDet.NSensitiveVolume(); ++sv) {
+      fSensitive.push_back({ ad, sv });
+      sensitiveBoxes.push_back
+        (boundingBox(auxDet.SensitiveVolume(sv), fTolerance));
+    } // for sensitive volumes
+  } // for auxiliary detectors
+
+  //
+  // fill the grid
+  //
+  defineGrid(auxDetBoxes);
+  fAuxDetCells = fillCells(auxDetBoxes);
+  fSensitiveCells = fillCells(sensitiveBoxes);
+
+} // icarus::AuxDetSpatialIndex::AuxDetSpatialIndex()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::AuxDetSpatialIndex::findAuxDet
+  (geo::Point_t const& point) const
+{
+  std::size_t const cell = cellOf(point);
+  if (cell == NoIndex) return NoIndex;
+
+  auto const begin = fAuxDetCells.elements.begin();
+  for (auto it = begin + fAuxDetCells.cellStart[cell],
+    end = begin + fAuxDetCells.cellStart[cell + 1]; it != end; ++it)
+  {
+    if (contains(fGeom->AuxDet(*it), point, fTolerance)) return *it;
+  }
+  return NoIndex;
+} // icarus::AuxDetSpatialIndex::findAuxDet()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::AuxDetSpatialIndex::findSensitive
+  (geo::Point_t const& point) const -> Location_t
+{
+  std::size_t const cell = cellOf(point);
+  if (cell == NoIndex) return {};
+
+  auto const begin = fSensitiveCells.elements.begin();
+  for (auto it = begin + fSensitiveCells.cellStart[cell],
+    end = begin + fSensitiveCells.cellStart[cell + 1]; it != end; ++it)
+  {
+    Location_t const& loc = fSensitive[*it];
+    geo::AuxDetSensitiveGeo const& sensitive
+      = fGeom->AuxDet(loc.auxDet).SensitiveVolume(loc.sensitive);
+    if (contains(sensitive, point, fTolerance)) return loc;
+  }
+  return {};
+} // icarus::AuxDetSpatialIndex::findSensitive()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::AuxDetSpatialIndex::cellOf(geo::Point_t const& point) const
+{
+  std::array<double, 3U> const coords { point.X(), point.Y(), point.Z() };
+  std::size_t cell = 0U;
+  for (std::size_t i = 0; i < 3U; ++i) {
+    double const c = std::floor((coords[i] - fGridMin[i]) / fCellSize[i]);
+    if ((c < 0.0) || (c >= fNCells[i])) return NoIndex;
+    cell = cell * fNCells[i] + static_cast<std::size_t>(c);
+  }
+  return cell;
+} // icarus::AuxDetSpatialIndex::cellOf()
+
+
+// -----------------------------------------------------------------------------
+void icarus::AuxDetSpatialIndex::defineGrid(std::vector<Box_t> const& boxes) {
+
+  fGridMin.fill(0.0);
+  fCellSize.fill(1.0);
+  fNCells.fill(1U);
+  if (boxes.empty()) return;
+
+  //
+  // overall box (sensitive volumes are contained in their detectors)
+  //
+  Box_t total = boxes.front();
+  for (Box_t const& box: boxes) {
+    for (std::size_t i = 0; i < 3U; ++i) {
+      total.min[i] = std::min(total.min[i], box.min[i]);
+      total.max[i] = std::max(total.max[i], box.max[i]);
+    }
+  } // for
+
+  //
+  // cubic cells, with a total number proportional to the number of elements;
+  // flat dimensions get a single cell
+  //
+  std::array<double, 3U> size;
+  double volume = 1.0;
+  unsigned int nDims = 0U;
+  for (std::size_t i = 0; i < 3U; ++i) {
+    size[i] = total.max[i] - total.min[i];
+    if (size[i] <= 0.0) continue;
+    volume *= size[i];
+    ++nDims;
+  }
+  double const nCells = CellsPerElement * boxes.size();
+  double side = (nDims == 0U)? 1.0: std::pow(volume / nCells, 1.0 / nDims);
+
+  auto cellsOnAxis = [&size,&side](std::size_t i) -> std::size_t
+    {
+      if (size[i] <= 0.0) return 1U;
+      return std::clamp(static_cast<std::size_t>(std::ceil(size[i] / side)),
+                        std::size_t{ 1U }, MaxCellsPerAxis);
+    };
+  // very thin dimensions may inflate the number of cells: enlarge them
+  while (cellsOnAxis(0) * cellsOnAxis(1) * cellsOnAxis(2) > 2.0 * nCells)
+    side *= 1.25;
+
+  for (std::size_t i = 0; i < 3U; ++i) {
+    fGridMin[i] = total.min[i];
+    fNCells[i] = cellsOnAxis(i);
+    // make sure the upper edge is always inside the grid
+    fCellSize[i] = (size[i] > 0.0)
+      ? std::nextafter(size[i] / fNCells[i], std::numeric_limits<double>::max())
+      : 1.0;
+  } // for
+
+} // icarus::AuxDetSpatialIndex::defineGrid()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::AuxDetSpatialIndex::fillCells
+  (std::vector<Box_t> const& boxes) const -> CellLists_t
+{
+  /*
+   * Compressed lists: first count the elements in each cell, then place them;
+   * elements are in index order within each cell.
+   */
+  std::size_t const nCells = fNCells[0] * fNCells[1] * fNCells[2];
+
+  // applies `f(cell)` to all the cells overlapping `box`
+  auto forEachCell = [this](Box_t const& box, auto&& f)
+    {
+      std::array<std::size_t, 3U> first, last;
+      for (std::size_t i = 0; i < 3U; ++i) {
+        auto cellCoord = [this,i](double c)
+          {
+            double const n = std::floor((c - fGridMin[i]) / fCellSize[i]);
+            return static_cast<std::size_t>
+              (std::clamp(n, 0.0, static_cast<double>(fNCells[i] - 1)));
+          };
+        first[i] = cellCoord(box.min[i]);
+        last[i] = cellCoord(box.max[i]);
+      } // for
+      for (std::size_t ix = first[0]; ix <= last[0]; ++ix)
+        for (std::size_t iy = first[1]; iy <= last[1]; ++iy)
+          for (std::size_t iz = first[2]; iz <= last[2]; ++iz)
+            f((ix * fNCells[1] + iy) * fNCells[2] + iz);
+    };
+
+  CellLists_t lists;
+  lists.cellStart.assign(nCells + 1, 0U);
+  for (Box_t const& box: boxes)
+    forEachCell(box, [&lists](std::size_t cell){ ++lists.cellStart[cell + 1]; });
+  for (std::size_t cell = 0; cell < nCells; ++cell)
+    lists.cellStart[cell + 1] += lists.cellStart[cell];
+
+  lists.elements.resize(lists.cellStart.back());
+  std::vector<std::size_t> next
+    { lists.cellStart.begin(), lists.cellStart.end() - 1 };
+  for (std::size_t iBox = 0; iBox < boxes.size(); ++iBox) {
+    forEachCell(boxes[iBox], [&lists,&next,iBox](std::size_t cell)
+      { lists.elements[next[cell]++] = static_cast<ElementIndex_t>(iBox); });
+  }
+
+  return lists;
+} // icarus::AuxDetSpatialIndex::fillCells()
+
+
+// -----------------------------------------------------------------------------
+template <typename GeoObj>
+auto icarus::AuxDetSpatialIndex::boundingBox
+  (GeoObj const& vol, double tolerance) -> Box_t
+{
+  using LocalPoint_t = typename GeoObj::LocalPoint_t;
+
+  double const halfWidth = std::max(vol.HalfWidth1(), vol.HalfWidth2());
+  double const halfHeight = vol.HalfHeight();
+  double const halfLength = vol.Length() / 2.0;
+
+  Box_t box;
+  box.min.fill(std::numeric_limits<double>::max());
+  box.max.fill(std::numeric_limits<double>::lowest());
+  for (double const x: { -halfWidth, +halfWidth }) {
+    for (double const y: { -halfHeight, +halfHeight }) {
+      for (double const z: { -halfLength, +halfLength }) {
+        geo::Point_t const corner = vol.toWorldCoords(LocalPoint_t{ x, y, z });
+        std::array<double, 3U> const c { corner.X(), corner.Y(), corner.Z() };
+        for (std::size_t i = 0; i < 3U; ++i) {
+          box.min[i] = std::min(box.min[i], c[i] - tolerance);
+          box.max[i] = std::max(box.max[i], c[i] + tolerance);
+        }
+      } // for z
+    } // for y
+  } // for x
+  return box;
+} // icarus::AuxDetSpatialIndex::boundingBox()
+
+
+// -----------------------------------------------------------------------------
+template <typename GeoObj>
+bool icarus::AuxDetSpatialIndex::contains
+  (GeoObj const& vol, geo::Point_t const& point, double tolerance)
+{
+  // this is the same test as in `geo::ChannelMapAlg::NearestAuxDet()`;
+  // the volume is a trapezoid, with half width `HalfWidth1()` at local
+  // -z and `HalfWidth2()` at +z
+  auto const local = vol.toLocalCoords(point);
+
+  double const halfLength = vol.Length() / 2.0;
+  double const halfCenterWidth = (vol.HalfWidth1() + vol.HalfWidth2()) / 2.0;
+  double const halfWidthAtZ = halfCenterWidth
+    + local.Z() * (vol.HalfWidth2() - halfCenterWidth) / halfLength;
+
+  return (local.Z() >= -(halfLength + tolerance))
+    && (local.Z() <= (halfLength + tolerance))
+    && (local.Y() >= -(vol.HalfHeight() + tolerance))
+    && (local.Y() <= (vol.HalfHeight() + tolerance))
+    && (local.X() >= -(halfWidthAtZ + tolerance))
+    && (local.X() <= (halfWidthAtZ + tolerance))
+    ;
+} // icarus::AuxDetSpatialIndex::contains()
+
+
+// -----------------------------------------------------------------------------
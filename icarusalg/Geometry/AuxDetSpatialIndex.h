@@ -0,0 +1,164 @@
+/**
+ * @file   icarusalg/Geometry/AuxDetSpatialIndex.h
+ * @brief  Spatial index of CRT modules and strips (auxiliary detectors).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Geometry/AuxDetSpatialIndex.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_AUXDETSPATIALINDEX_H
+#define ICARUSALG_GEOMETRY_AUXDETSPATIALINDEX_H
+
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus { class AuxDetSpatialIndex; }
+
+/**
+ * @brief Index to find the CRT module and strip containing a point.
+ *
+ * LArSoft `geo::GeometryCore::FindAuxDetSensitiveAtPosition()` finds the
+ * auxiliary detector and its sensitive volume containing a point by testing
+ * all the auxiliary detectors in sequence. This object partitions the space
+ * around the auxiliary detectors in a uniform grid of cells, each one listing
+ * the detectors (and sensitive volumes) whose bounding box overlaps it.
+ * A query tests only the few candidates of the cell containing the point,
+ * with the same containment criterion as LArSoft.
+ *
+ * The index is built once from a geometry, after its sorting, and it refers
+ * to auxiliary detectors and sensitive volumes by their index in it.
+ * The geometry must outlive the index.
+ * When multiple candidates contain the point, the one with the lowest index
+ * is returned, as LArSoft does.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::AuxDetSpatialIndex const CRTindex { geom };
+ *
+ * if (auto const where = CRTindex.findSensitive(point)) {
+ *   geo::AuxDetSensitiveGeo const& strip
+ *     = geom.AuxDet(where.auxDet).SensitiveVolume(where.sensitive);
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::AuxDetSpatialIndex {
+
+    public:
+
+  /// Value of index for "no detector".
+  static constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
+
+  /// Location of a point: auxiliary detector and sensitive volume indices.
+  struct Location_t {
+    std::size_t auxDet = NoIndex; ///< Index of the auxiliary detector.
+    std::size_t sensitive = NoIndex; ///< Index of sensitive volume in it.
+
+    /// Returns whether the location is valid.
+    explicit operator bool() const { return auxDet != NoIndex; }
+  }; // Location_t
+
+
+  /**
+   * @brief Builds the index of all auxiliary detectors in `geom`.
+   * @param geom the geometry with the auxiliary detectors to index
+   * @param tolerance tolerance on the containment of points [cm]
+   *
+   * The `tolerance` is used the same way as in
+   * `geo::GeometryCore::FindAuxDetSensitiveAtPosition()`.
+   */
+  explicit AuxDetSpatialIndex
+    (geo::GeometryCore const& geom, double tolerance = 0.0);
+
+
+  /// Returns the index of the auxiliary detector containing `point`
+  /// (`NoIndex` if none).
+  std::size_t findAuxDet(geo::Point_t const& point) const;
+
+  /// Returns the auxiliary detector and the sensitive volume containing
+  /// `point` (invalid location if none).
+  Location_t findSensitive(geo::Point_t const& point) const;
+
+
+  /// Returns the number of indexed auxiliary detectors.
+  std::size_t nAuxDets() const { return fNAuxDets; }
+
+  /// Returns the number of indexed sensitive volumes.
+  std::size_t nSensitive() const { return fSensitive.size(); }
+
+  /// Returns the number of grid cells on each direction.
+  std::array<std::size_t, 3U> const& gridSize() const { return fNCells; }
+
+
+    private:
+
+  /// Type of index of an element in the grid.
+  using ElementIndex_t = std::uint32_t;
+
+  /// Axis-aligned bounding box.
+  struct Box_t {
+    std::array<double, 3U> min, max;
+  };
+
+  /// Elements overlapping each cell (compressed: `cellStart` has an extra
+  /// element at the end).
+  struct CellLists_t {
+    std::vector<std::size_t> cellStart;
+    std::vector<ElementIndex_t> elements;
+  };
+
+
+  geo::GeometryCore const* fGeom; ///< Geometry with the detectors.
+
+  double fTolerance; ///< Tolerance on containment [cm].
+
+  std::size_t fNAuxDets; ///< Number of auxiliary detectors.
+
+  /// Location of each of the sensitive volumes in the sensitive grid.
+  std::vector<Location_t> fSensitive;
+
+  std::array<double, 3U> fGridMin; ///< Lower corner of the grid.
+  std::array<double, 3U> fCellSize; ///< Size of the cells.
+  std::array<std::size_t, 3U> fNCells; ///< Number of cells on each direction.
+
+  CellLists_t fAuxDetCells; ///< Auxiliary detectors in each cell.
+  CellLists_t fSensitiveCells; ///< Sensitive volumes in each cell.
+
+
+  /// Returns the cell including `point`, `NoIndex` if out of the grid.
+  std::size_t cellOf(geo::Point_t const& point) const;
+
+  /// Defines the grid covering all `boxes`.
+  void defineGrid(std::vector<Box_t> const& boxes);
+
+  /// Returns the lists of elements overlapping each cell.
+  CellLists_t fillCells(std::vector<Box_t> const& boxes) const;
+
+
+  /// Returns the bounding box of the volume `vol` (with `tolerance` margin).
+  template <typename GeoObj>
+  static Box_t boundingBox(GeoObj const& vol, double tolerance);
+
+  /// Returns whether `point` is inside the volume `vol` within `tolerance`.
+  /// This is the same criterion as in `geo::ChannelMapAlg`.
+  template <typename GeoObj>
+  static bool contains
+    (GeoObj const& vol, geo::Point_t const& point, double tolerance);
+
+}; // icarus::AuxDetSpatialIndex
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_AUXDETSPATIALINDEX_H
@@ -0,0 +1,169 @@
+/**
+ * @file   icarusalg/Geometry/ChannelKindMap.h
+ * @brief  Compact table of the kind of each ICARUS channel.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/ICARUSChannelMapAlg.h`
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_GEOMETRY_CHANNELKINDMAP_H
+#define ICARUSALG_GEOMETRY_CHANNELKINDMAP_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstdint> // std::uint8_t, std::uint64_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus { class ChannelKindMap; }
+/**
+ * @brief Whether each channel has wires, and the type of its plane.
+ * @see `icarus::ICARUSChannelMapAlg::channelKinds()`
+ *
+ * `icarus::ICARUSChannelMapAlg` assigns to each readout plane some channels
+ * which are not connected to any wire (see its `WirelessChannels`
+ * configuration). This object records, for each channel, whether it is one of
+ * them and the type of the plane it belongs to, so that both can be queried
+ * in constant time without going through the channel mapping.
+ *
+ * Wireless channels are recorded in a bitmap with one bit per channel
+ * (`wirelessBits()`), so that a loop on channels can skip them with a single
+ * bit test; the plane type takes one byte per channel.
+ *
+ * Example:
+ * ~~~~{.cpp}
+ * icarus::ChannelKindMap const& kinds = channelMapAlg.channelKinds();
+ * for (raw::RawDigit const& digits: allDigits) {
+ *   if (kinds.isWireless(digits.Channel())) continue;
+ *   // ...
+ * }
+ * ~~~~
+ *
+ * Channels not in the map are reported as wireless and of unknown type.
+ */
+class icarus::ChannelKindMap {
+
+    public:
+
+  /// Type of word in the bitmap of wireless channels.
+  using Word_t = std::uint64_t;
+
+  /// Number of channels in each word of the bitmap.
+  static constexpr unsigned int WordBits = 64U;
+
+  /// Type of plane a channel belongs to.
+  enum class PlaneType: std::uint8_t {
+    FirstInduction,  ///< First induction plane.
+    SecondInduction, ///< Second induction plane.
+    Collection,      ///< Collection plane.
+    Unknown          ///< Not known.
+  }; // PlaneType
+
+
+  /// Constructor: an empty map, with no channel.
+  ChannelKindMap() = default;
+
+  /// Constructor: `nChannels` channels, all wireless and of unknown type.
+  explicit ChannelKindMap(unsigned int nChannels)
+    : fPlaneTypes(nChannels, PlaneType::Unknown)
+    , fWireless((nChannels + WordBits - 1) / WordBits, ~Word_t{ 0 })
+    {}
+
+
+  // --- BEGIN -- Queries ------------------------------------------------------
+  /// @name Queries
+  /// @{
+
+  /// Returns the number of channels in the map.
+  unsigned int nChannels() const { return fPlaneTypes.size(); }
+
+  /// Returns whether `channel` is in the map.
+  bool hasChannel(raw::ChannelID_t channel) const
+    { return raw::isValidChannelID(channel) && (channel < nChannels()); }
+
+  /// Returns whether `channel` is not connected to any wire.
+  bool isWireless(raw::ChannelID_t channel) const
+    {
+      return !hasChannel(channel)
+        || ((fWireless[channel / WordBits] >> (channel % WordBits)) & 1U);
+    }
+
+  /// Returns whether `channel` is connected to some wire.
+  bool isWired(raw::ChannelID_t channel) const
+    { return !isWireless(channel); }
+
+  /// Returns the type of plane `channel` belongs to.
+  PlaneType planeType(raw::ChannelID_t channel) const
+    { return hasChannel(channel)? fPlaneTypes[channel]: PlaneType::Unknown; }
+
+  /// Returns the number of wireless channels.
+  unsigned int nWireless() const;
+
+  /**
+   * @brief Returns the bitmap of wireless channels.
+   *
+   * Channel `c` is wireless if bit `c % WordBits` of word `c / WordBits` is
+   * set. The bitmap has `(nChannels() + WordBits - 1) / WordBits` words.
+   */
+  Word_t const* wirelessBits() const { return fWireless.data(); }
+
+  /// @}
+  // --- END ---- Queries ------------------------------------------------------
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Sets the plane type of channels from `begin` to `end` (excluded).
+  void setPlaneType
+    (raw::ChannelID_t begin, raw::ChannelID_t end, PlaneType type)
+    {
+      assert(end <= nChannels());
+      for (raw::ChannelID_t channel = begin; channel < end; ++channel)
+        fPlaneTypes[channel] = type;
+    }
+
+  /// Marks channels from `begin` to `end` (excluded) as connected to wires.
+  void setWired(raw::ChannelID_t begin, raw::ChannelID_t end)
+    {
+      assert(end <= nChannels());
+      for (raw::ChannelID_t channel = begin; channel < end; ++channel) {
+        fWireless[channel / WordBits]
+          &= ~(Word_t{ 1 } << (channel % WordBits));
+      }
+    }
+
+  /// @}
+  // --- END ---- Filling ------------------------------------------------------
+
+
+    private:
+
+  std::vector<PlaneType> fPlaneTypes; ///< Plane type of each channel.
+
+  std::vector<Word_t> fWireless; ///< Bitmap of wireless channels.
+
+}; // class icarus::ChannelKindMap
+
+
+// -----------------------------------------------------------------------------
+// ---  inline implementation
+// -----------------------------------------------------------------------------
+inline unsigned int icarus::ChannelKindMap::nWireless() const {
+  unsigned int n = 0U;
+  for (raw::ChannelID_t channel = 0; channel < nChannels(); ++channel)
+    if (isWireless(channel)) ++n;
+  return n;
+} // icarus::ChannelKindMap::nWireless()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_CHANNELKINDMAP_H
@@ -0,0 +1,231 @@
+/**
+ * @file   icarusalg/Geometry/ChannelMapSnapshot.h
+ * @brief  Immutable copies of the ICARUS channel mapping, shared by threads.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/ICARUSChannelMapAlg.h`
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_GEOMETRY_CHANNELMAPSNAPSHOT_H
+#define ICARUSALG_GEOMETRY_CHANNELMAPSNAPSHOT_H
+
+// ICARUS libraries
+#include "icarusalg/Geometry/CompiledChannelMap.h"
+#include "icarusalg/Geometry/ChannelKindMap.h"
+
+// C/C++ standard libraries
+#include <memory> // std::shared_ptr, std::atomic_load()...
+#include <atomic>
+#include <mutex>
+#include <utility> // std::move()
+#include <cstdint> // std::uint64_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus {
+  class ChannelMapSnapshot;
+  class ChannelMapPublisher;
+} // namespace icarus
+
+/**
+ * @brief An immutable copy of the channel mapping, with its generation.
+ * @see `icarus::ChannelMapPublisher`
+ *
+ * The snapshot holds the flat copy of the channel mapping
+ * (`icarus::CompiledChannelMap`) and the table of channel kinds
+ * (`icarus::ChannelKindMap`) as they were when it was created, and it never
+ * changes afterwards: any number of threads can query it without
+ * synchronization. The generation number identifies the publication it came
+ * from (see `icarus::ChannelMapPublisher`).
+ */
+class icarus::ChannelMapSnapshot {
+
+    public:
+
+  /// Type of the generation number.
+  using Generation_t = std::uint64_t;
+
+  /// Constructor: takes the mapping and the channel kinds.
+  ChannelMapSnapshot(
+    icarus::CompiledChannelMap map, icarus::ChannelKindMap kinds,
+    Generation_t generation = 0U
+    )
+    : fMap{ std::move(map) }
+    , fKinds{ std::move(kinds) }
+    , fGeneration{ generation }
+    {}
+
+  /// Returns the channel mapping.
+  icarus::CompiledChannelMap const& map() const { return fMap; }
+
+  /// Returns the kind of all the channels.
+  icarus::ChannelKindMap const& kinds() const { return fKinds; }
+
+  /// Returns the generation number of this snapshot.
+  Generation_t generation() const { return fGeneration; }
+
+
+    private:
+
+  icarus::CompiledChannelMap const fMap; ///< The channel mapping.
+
+  icarus::ChannelKindMap const fKinds; ///< Kind of each channel.
+
+  Generation_t const fGeneration; ///< Generation number.
+
+}; // class icarus::ChannelMapSnapshot
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Publishes the current channel mapping snapshot to reader threads.
+ *
+ * A long-running process whose channel configuration may change cannot
+ * reinitialize `icarus::ICARUSChannelMapAlg` while other threads are using
+ * it. With this object, the new mapping is built in a separate
+ * `icarus::ICARUSChannelMapAlg` (possibly in a background thread) and then
+ * published as a new immutable `icarus::ChannelMapSnapshot`, replacing the
+ * current one with a single atomic pointer swap. Readers holding the old
+ * snapshot keep using it until they ask for the current one again, and it is
+ * destroyed when the last of them releases it (read-copy-update).
+ *
+ * Each publication gets a generation number larger than the previous one.
+ * Readers which want to avoid even the atomic `std::shared_ptr` access on
+ * each event can use a `Reader`, which keeps its own copy of the pointer and
+ * refreshes it only when the generation changes: when nothing has been
+ * published, `Reader::refresh()` costs a single atomic integer load.
+ *
+ * Example:
+ * ~~~~{.cpp}
+ * icarus::ChannelMapPublisher publisher;
+ *
+ * // writer (e.g. on configuration change)
+ * publisher.publish(newMapAlg.compiledMap(), newMapAlg.channelKinds());
+ *
+ * // reader thread
+ * icarus::ChannelMapPublisher::Reader reader { publisher };
+ * while (processing) {
+ *   icarus::ChannelMapSnapshot const& snapshot = reader.refresh();
+ *   readout::ROPID const rop = snapshot.map().ChannelToROP(channel);
+ *   // ...
+ * }
+ * ~~~~
+ *
+ * Publications are serialized among themselves; readers never wait for them.
+ * Note that whether the atomic `std::shared_ptr` operations are lock-free
+ * depends on the standard library implementation.
+ */
+class icarus::ChannelMapPublisher {
+
+    public:
+
+  using Snapshot_t = icarus::ChannelMapSnapshot; ///< Type of snapshot.
+  using Generation_t = Snapshot_t::Generation_t; ///< Type of generation.
+
+  /// Type of shared pointer to a snapshot.
+  using SnapshotPtr_t = std::shared_ptr<Snapshot_t const>;
+
+
+  /// Keeps a copy of the current snapshot, refreshing it on demand.
+  class Reader {
+
+      public:
+
+    /// Constructor: picks the current snapshot of `publisher`.
+    explicit Reader(ChannelMapPublisher const& publisher)
+      : fPublisher{ &publisher }
+      , fSnapshot{ publisher.current() }
+      {}
+
+    /// Returns the snapshot in use (may be null if nothing was published).
+    Snapshot_t const* get() const { return fSnapshot.get(); }
+
+    /// Returns the snapshot in use (must exist).
+    Snapshot_t const& snapshot() const { return *fSnapshot; }
+
+    /// Returns whether a newer snapshot has been published.
+    bool outdated() const
+      { return fPublisher->generation() != generationInUse(); }
+
+    /// Switches to the newest snapshot if needed, and returns it (must exist).
+    Snapshot_t const& refresh()
+      {
+        if (outdated()) fSnapshot = fPublisher->current();
+        return snapshot();
+      }
+
+      private:
+
+    ChannelMapPublisher const* fPublisher; ///< Where to get snapshots from.
+    SnapshotPtr_t fSnapshot; ///< The snapshot in use.
+
+    /// Returns the generation of the snapshot in use (`0` if none).
+    Generation_t generationInUse() const
+      { return fSnapshot? fSnapshot->generation(): 0U; }
+
+  }; // class Reader
+
+
+  /// Returns the current snapshot (null if nothing was published yet).
+  SnapshotPtr_t current() const
+    {
+#if __cpp_lib_atomic_shared_ptr
+      return fCurrent.load(std::memory_order_acquire);
+#else
+      return std::atomic_load_explicit(&fCurrent, std::memory_order_acquire);
+#endif // __cpp_lib_atomic_shared_ptr
+    }
+
+  /// Returns the generation of the current snapshot (`0` if none).
+  Generation_t generation() const
+    { return fGeneration.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Publishes a new snapshot of the mapping.
+   * @param map the new channel mapping
+   * @param kinds the new channel kind table
+   * @return the generation of the published snapshot
+   *
+   * The snapshot is created and then made current; readers will pick it up
+   * on their next request.
+   */
+  Generation_t publish
+    (icarus::CompiledChannelMap map, icarus::ChannelKindMap kinds)
+    {
+      std::lock_guard const lock { fPublishMutex };
+      Generation_t const generation = fGeneration.load() + 1U;
+      auto snapshot = std::make_shared<Snapshot_t const>
+        (std::move(map), std::move(kinds), generation);
+#if __cpp_lib_atomic_shared_ptr
+      fCurrent.store(std::move(snapshot), std::memory_order_release);
+#else
+      std::atomic_store_explicit
+        (&fCurrent, SnapshotPtr_t{ std::move(snapshot) },
+         std::memory_order_release);
+#endif // __cpp_lib_atomic_shared_ptr
+      // the generation is updated after the snapshot is available
+      fGeneration.store(generation, std::memory_order_release);
+      return generation;
+    }
+
+
+    private:
+
+#if __cpp_lib_atomic_shared_ptr
+  std::atomic<SnapshotPtr_t> fCurrent; ///< The current snapshot.
+#else
+  SnapshotPtr_t fCurrent; ///< The current snapshot (atomic access only).
+#endif // __cpp_lib_atomic_shared_ptr
+
+  std::atomic<Generation_t> fGeneration { 0U }; ///< Current generation.
+
+  std::mutex fPublishMutex; ///< Serializes the publications.
+
+}; // class icarus::ChannelMapPublisher
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_CHANNELMAPSNAPSHOT_H
@@ -0,0 +1,216 @@
+/**
+ * @file   icarusalg/Geometry/ChannelProcessingPlan.h
+ * @brief  Grouping of ICARUS TPC channels in contiguous processing blocks.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/ICARUSChannelMapAlg.h`
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_GEOMETRY_CHANNELPROCESSINGPLAN_H
+#define ICARUSALG_GEOMETRY_CHANNELPROCESSINGPLAN_H
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ChannelKindMap.h"
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus { class ChannelProcessingPlan; }
+/**
+ * @brief Layout of TPC channels in contiguous blocks of uniform wires.
+ * @see `icarus::ICARUSChannelMapAlg::processingPlan()`
+ *
+ * Channel numbers of `icarus::ICARUSChannelMapAlg` follow the order of
+ * cryostats, TPC sets and readout planes, but each readout plane includes
+ * wireless channels, and a channel of a second induction or collection plane
+ * may be connected to wires in two TPC. Algorithms working on the digits
+ * plane by plane (noise filtering, deconvolution) end up looking up each
+ * channel in the mapping and skipping around the wireless ones.
+ *
+ * This plan splits the wired channels in _segments_: ranges of consecutive
+ * channels in the same readout plane, connected to consecutive wires of the
+ * same wire planes. Each segment carries its readout plane, its plane type,
+ * the first wire plane its channels are connected to (with the wire of the
+ * first channel) and the number of wire planes sharing them.
+ * Segments are sorted by channel, and each one is assigned a block of
+ * consecutive _slots_ starting at a multiple of `alignment()`: data of all
+ * channels can be laid out in a single buffer by slot (`slotOf()`), each
+ * segment then being a contiguous aligned block. The slots left between the
+ * segments for alignment are padding, and are mapped to no channel
+ * (`channelAt()` returns `raw::InvalidChannelID`).
+ *
+ * Example of scattering of raw digits into a slot buffer:
+ * ~~~~{.cpp}
+ * icarus::ChannelProcessingPlan const plan
+ *   = channelMapAlg.processingPlan(8U);
+ * std::vector<float> buffer(plan.nSlots() * nTicks, 0.0f);
+ * for (raw::RawDigit const& digits: allDigits) {
+ *   std::size_t const slot = plan.slotOf(digits.Channel());
+ *   if (slot == icarus::ChannelProcessingPlan::NoSlot) continue; // wireless
+ *   std::copy(digits.ADCs().begin(), digits.ADCs().end(),
+ *     buffer.begin() + slot * nTicks);
+ * }
+ * for (auto const& segment: plan.segments()) {
+ *   float* block = buffer.data() + segment.firstSlot * nTicks;
+ *   // process `segment.nChannels` channels of `segment.planeType`...
+ * }
+ * ~~~~
+ */
+class icarus::ChannelProcessingPlan {
+
+    public:
+
+  /// Type of plane a channel belongs to.
+  using PlaneType = icarus::ChannelKindMap::PlaneType;
+
+  /// Slot of channels not in the plan.
+  static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+
+  /// Channels of a segment and their connection.
+  struct Segment_t {
+    readout::ROPID ROP; ///< Readout plane of the channels.
+    PlaneType planeType = PlaneType::Unknown; ///< Type of the readout plane.
+    geo::PlaneID plane; ///< First wire plane the channels are connected to.
+    unsigned int firstWire = 0U; ///< Wire on `plane` of the first channel.
+    unsigned int nPlanes = 0U; ///< Number of wire planes sharing the channels.
+    raw::ChannelID_t firstChannel = raw::InvalidChannelID; ///< First channel.
+    unsigned int nChannels = 0U; ///< Number of channels in the segment.
+    std::size_t firstSlot = NoSlot; ///< Slot of the first channel.
+
+    /// Returns the channel after the last one in the segment.
+    raw::ChannelID_t endChannel() const { return firstChannel + nChannels; }
+
+    /// Returns the slot after the last one in the segment.
+    std::size_t endSlot() const { return firstSlot + nChannels; }
+  }; // Segment_t
+
+
+  /// Constructor: an empty plan, with no channel.
+  ChannelProcessingPlan() = default;
+
+  /**
+   * @brief Constructor: a plan for `nChannels` channels, all out of it.
+   * @param nChannels the number of channels in the mapping
+   * @param alignment (default: `1`) each segment starts at a multiple of this
+   */
+  explicit ChannelProcessingPlan
+    (unsigned int nChannels, unsigned int alignment = 1U)
+    : fAlignment{ (alignment == 0U)? 1U: alignment }
+    , fChannelSlots(nChannels, NoSlot)
+    {}
+
+
+  // --- BEGIN -- Queries ------------------------------------------------------
+  /// @name Queries
+  /// @{
+
+  /// Returns the number of channels in the mapping.
+  unsigned int nChannels() const { return fChannelSlots.size(); }
+
+  /// Returns the alignment of the first slot of each segment.
+  unsigned int alignment() const { return fAlignment; }
+
+  /// Returns the number of segments.
+  std::size_t nSegments() const { return fSegments.size(); }
+
+  /// Returns all the segments, sorted by channel.
+  std::vector<Segment_t> const& segments() const { return fSegments; }
+
+  /// Returns the segment number `iSegment`.
+  Segment_t const& segment(std::size_t iSegment) const
+    { return fSegments[iSegment]; }
+
+  /// Returns the total number of slots, including padding.
+  std::size_t nSlots() const { return fSlotChannels.size(); }
+
+  /// Returns the slot of `channel`, `NoSlot` if not in any segment.
+  std::size_t slotOf(raw::ChannelID_t channel) const
+    {
+      return (raw::isValidChannelID(channel) && (channel < nChannels()))
+        ? fChannelSlots[channel]: NoSlot;
+    }
+
+  /// Returns the channel in `slot`, `raw::InvalidChannelID` if padding.
+  raw::ChannelID_t channelAt(std::size_t slot) const
+    { return fSlotChannels[slot]; }
+
+  /// Returns the channel of each slot (`raw::InvalidChannelID` if padding).
+  std::vector<raw::ChannelID_t> const& slotChannels() const
+    { return fSlotChannels; }
+
+  /// @}
+  // --- END ---- Queries ------------------------------------------------------
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /**
+   * @brief Appends a segment to the plan.
+   * @param segment the description of the segment
+   * @return the segment as stored, with its first slot
+   *
+   * The segment `firstSlot` is ignored and assigned at the next multiple of
+   * `alignment()`. Segments must be added in increasing channel order, with
+   * no overlap.
+   */
+  Segment_t const& addSegment(Segment_t segment)
+    {
+      assert(segment.endChannel() <= nChannels());
+      assert(fSegments.empty()
+        || (fSegments.back().endChannel() <= segment.firstChannel));
+
+      std::size_t const firstSlot
+        = (nSlots() + fAlignment - 1) / fAlignment * fAlignment;
+      fSlotChannels.resize(firstSlot, raw::InvalidChannelID);
+      for (unsigned int i = 0; i < segment.nChannels; ++i) {
+        fChannelSlots[segment.firstChannel + i] = fSlotChannels.size();
+        fSlotChannels.push_back(segment.firstChannel + i);
+      }
+      segment.firstSlot = firstSlot;
+      fSegments.push_back(segment);
+      return fSegments.back();
+    }
+
+  /// Pads the slots after the last segment up to a multiple of `alignment()`.
+  void close()
+    {
+      fSlotChannels.resize(
+        (nSlots() + fAlignment - 1) / fAlignment * fAlignment,
+        raw::InvalidChannelID
+        );
+    }
+
+  /// @}
+  // --- END ---- Filling ------------------------------------------------------
+
+
+    private:
+
+  unsigned int fAlignment = 1U; ///< Alignment of segments in slots.
+
+  std::vector<Segment_t> fSegments; ///< All segments, by channel.
+
+  std::vector<std::size_t> fChannelSlots; ///< Slot of each channel.
+
+  std::vector<raw::ChannelID_t> fSlotChannels; ///< Channel of each slot.
+
+}; // class icarus::ChannelProcessingPlan
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_CHANNELPROCESSINGPLAN_H
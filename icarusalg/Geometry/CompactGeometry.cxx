@@ -0,0 +1,132 @@
+/**
+ * @file   icarusalg/Geometry/CompactGeometry.cxx
+ * @brief  Flat geometry tables surviving the release of the full geometry.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/CompactGeometry.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/CompactGeometry.h"
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ICARUSChannelMapAlg.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+
+// ROOT libraries
+#include "TGeoManager.h" // gGeoManager
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+
+
+// -----------------------------------------------------------------------------
+icarus::CompactGeometry::CompactGeometry(
+  geo::GeometryCore const& geom,
+  icarus::ICARUSChannelMapAlg const& channelMap
+)
+  : fChannelMap{ channelMap.compiledMap() }
+  , fChannelKinds{ channelMap.channelKinds() }
+  , fWireGeometry{ channelMap.wireGeometry() }
+  , fPMTgeometry{ channelMap.pmtGeometry() }
+{
+  fillElements(geom);
+} // icarus::CompactGeometry::CompactGeometry()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::CompactGeometry::hasTPC(geo::TPCID const& tpcid) const {
+
+  if (!tpcid.isValid) return false;
+  if ((tpcid.Cryostat >= Ncryostats()) || (tpcid.TPC >= fMaxTPCs))
+    return false;
+  return TPC(tpcid).ID.isValid;
+
+} // icarus::CompactGeometry::hasTPC()
+
+
+// -----------------------------------------------------------------------------
+geo::TPCID icarus::CompactGeometry::positionToTPCID
+  (geo::Point_t const& point, double wiggle /* = 1.0 */) const
+{
+
+  for (TPCInfo_t const& tpc: fTPCs) {
+    if (tpc.ID.isValid && tpc.box.ContainsPosition(point, wiggle))
+      return tpc.ID;
+  }
+  return {};
+
+} // icarus::CompactGeometry::positionToTPCID()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::CompactGeometry::hasPlane(geo::PlaneID const& pid) const {
+
+  if (!hasTPC(pid) || (pid.Plane >= fMaxPlanes)) return false;
+  return plane(pid).ID.isValid;
+
+} // icarus::CompactGeometry::hasPlane()
+
+
+// -----------------------------------------------------------------------------
+void icarus::CompactGeometry::releaseROOTgeometry() {
+
+  // the destructor also resets `gGeoManager`
+  delete gGeoManager;
+  gGeoManager = nullptr;
+
+} // icarus::CompactGeometry::releaseROOTgeometry()
+
+
+// -----------------------------------------------------------------------------
+void icarus::CompactGeometry::fillElements(geo::GeometryCore const& geom) {
+
+  fMaxTPCs = 0U;
+  fMaxPlanes = 0U;
+  for (geo::CryostatGeo const& cryo: geom.IterateCryostats()) {
+    fMaxTPCs = std::max(fMaxTPCs, cryo.NTPC());
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs())
+      fMaxPlanes = std::max(fMaxPlanes, tpc.Nplanes());
+  } // for cryostats
+
+  fCryostatBoxes.clear();
+  fTPCs.assign(geom.Ncryostats() * fMaxTPCs, TPCInfo_t{});
+  fPlanes.assign(fTPCs.size() * fMaxPlanes, PlaneInfo_t{});
+
+  for (geo::CryostatGeo const& cryo: geom.IterateCryostats()) {
+
+    fCryostatBoxes.push_back(static_cast<geo::BoxBoundedGeo const&>(cryo));
+
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) {
+
+      fTPCs[TPCindex(tpc.ID())] = {
+        tpc.ID(),                                   // ID
+        static_cast<geo::BoxBoundedGeo const&>(tpc), // box
+        tpc.ActiveBoundingBox(),                    // activeBox
+        tpc.DriftDir()                              // driftDir
+      };
+
+      for (geo::PlaneGeo const& plane: tpc.IteratePlanes()) {
+        fPlanes[planeIndex(plane.ID())] = {
+          plane.ID(),                           // ID
+          plane.View(),                         // view
+          plane.GetCenter(),                    // center
+          plane.GetNormalDirection(),           // normal
+          plane.GetWireDirection(),             // wireDir
+          plane.GetIncreasingWireDirection(),   // pitchDir
+          plane.WirePitch(),                    // pitch
+          plane.Nwires()                        // nWires
+        };
+      } // for planes
+    } // for TPC
+  } // for cryostats
+
+} // icarus::CompactGeometry::fillElements()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+/**
+ * @file   icarusalg/Geometry/CompactGeometry.h
+ * @brief  Flat geometry tables surviving the release of the full geometry.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/CompactGeometry.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_COMPACTGEOMETRY_H
+#define ICARUSALG_GEOMETRY_COMPACTGEOMETRY_H
+
+// ICARUS libraries
+#include "icarusalg/Geometry/CompiledChannelMap.h"
+#include "icarusalg/Geometry/ChannelKindMap.h"
+#include "icarusalg/Geometry/details/WireGeometryTable.h"
+#include "icarusalg/Geometry/details/PMTgeometryTable.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/BoxBoundedGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace geo { class GeometryCore; }
+namespace icarus {
+  class ICARUSChannelMapAlg;
+  class CompactGeometry;
+}
+
+/**
+ * @brief The geometry information used after initialization, in flat tables.
+ *
+ * The full geometry (`geo::GeometryCore`) keeps in memory the whole ROOT
+ * description of the detector (`TGeoManager`, with all its volumes and
+ * materials) and a `geo::WireGeo` object for each of the wires, with its
+ * ROOT transformation matrix. After initialization, reconstruction and
+ * analysis algorithms usually need only a small part of it: the channel
+ * mapping, the position of the wires, the frame of each wire plane, the
+ * boundaries of the TPC and the position of the PMT.
+ *
+ * This object extracts once those tables from an initialized geometry and
+ * its ICARUS channel mapping:
+ * * the channel mapping (`channelMap()`, `icarus::CompiledChannelMap`) and the
+ *   kind of each channel (`channelKinds()`, `icarus::ChannelKindMap`);
+ * * the wire end points, as center, direction and half length
+ *   (`wireGeometry()`, `icarus::details::WireGeometryTable`; only the
+ *   cryostats configured in the channel mapping are included);
+ * * the PMT centers and neighbours (`pmtGeometry()`,
+ *   `icarus::details::PMTgeometryTable`);
+ * * the boxes of the cryostats and TPC, and the frame of each wire plane
+ *   (`TPC()`, `plane()`).
+ *
+ * It does not refer to the geometry afterwards, which can then be destroyed:
+ * `releaseROOTgeometry()` also deletes the ROOT geometry, which the
+ * destruction of `geo::GeometryCore` leaves in memory.
+ * `icarus::geo::LoadCompactICARUSgeometry()` loads the geometry, extracts
+ * these tables and releases everything else in a single call.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::CompactGeometry const geom
+ *   = icarus::geo::LoadCompactICARUSgeometry("standard_g4_icarus.fcl");
+ *
+ * geo::TPCID const tpcid = geom.positionToTPCID(point);
+ * if (tpcid.isValid) {
+ *   geo::PlaneID const pid { tpcid, 2U };
+ *   double const wireCoord
+ *     = geom.wireGeometry().wireCoordinate(pid, point.Y(), point.Z());
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * TPC and planes are stored in flat arrays indexed like in
+ * `icarus::CompiledChannelMap`; queries on elements which do not exist have
+ * undefined result, unless they are checked with `hasTPC()` or `hasPlane()`.
+ */
+class icarus::CompactGeometry {
+
+    public:
+
+  /// Information about a TPC.
+  struct TPCInfo_t {
+    geo::TPCID ID; ///< ID of the TPC (invalid if not present).
+    geo::BoxBoundedGeo box; ///< Boundaries of the whole TPC.
+    geo::BoxBoundedGeo activeBox; ///< Boundaries of the active volume.
+    geo::Vector_t driftDir; ///< Direction of the electron drift.
+  }; // TPCInfo_t
+
+  /// Information about the frame of a wire plane.
+  struct PlaneInfo_t {
+    geo::PlaneID ID; ///< ID of the plane (invalid if not present).
+    geo::View_t view = geo::kUnknown; ///< View of the plane.
+    geo::Point_t center; ///< Center of the wire plane.
+    geo::Vector_t normal; ///< Normal to the plane, toward the drift volume.
+    geo::Vector_t wireDir; ///< Direction of the wires.
+    geo::Vector_t pitchDir; ///< Direction of increasing wire number.
+    double pitch = 0.0; ///< Distance between wires [cm]
+    unsigned int nWires = 0U; ///< Number of wires on the plane.
+  }; // PlaneInfo_t
+
+
+  /// Constructor: empty geometry.
+  CompactGeometry() = default;
+
+  /**
+   * @brief Constructor: extracts all the tables from the geometry.
+   * @param geom the initialized geometry
+   * @param channelMap the ICARUS channel mapping `geom` was initialized with
+   */
+  CompactGeometry(
+    geo::GeometryCore const& geom,
+    icarus::ICARUSChannelMapAlg const& channelMap
+    );
+
+
+  // --- BEGIN -- Cryostats and TPC --------------------------------------------
+  /// @name Cryostats and TPC
+  /// @{
+
+  /// Returns the number of cryostats.
+  unsigned int Ncryostats() const { return fCryostatBoxes.size(); }
+
+  /// Returns the boundaries of the cryostat `cid`.
+  geo::BoxBoundedGeo const& cryostatBox(geo::CryostatID const& cid) const
+    { return fCryostatBoxes[cid.Cryostat]; }
+
+  /// Returns the largest number of TPC in a cryostat.
+  unsigned int maxTPCs() const { return fMaxTPCs; }
+
+  /// Returns whether the TPC `tpcid` is present.
+  bool hasTPC(geo::TPCID const& tpcid) const;
+
+  /// Returns the information on the TPC `tpcid`.
+  TPCInfo_t const& TPC(geo::TPCID const& tpcid) const
+    { return fTPCs[TPCindex(tpcid)]; }
+
+  /// Returns the information on all TPC (including the ones not present).
+  std::vector<TPCInfo_t> const& TPCs() const { return fTPCs; }
+
+  /**
+   * @brief Returns the TPC containing `point`.
+   * @param point the point to be located [cm]
+   * @param wiggle (default: none) relative enlargement of the TPC boxes
+   * @return the ID of the TPC, invalid if `point` is in none
+   *
+   * The boundaries of the TPC are enlarged like in
+   * `geo::BoxBoundedGeo::ContainsPosition()`.
+   */
+  geo::TPCID positionToTPCID
+    (geo::Point_t const& point, double wiggle = 1.0) const;
+
+  /// @}
+  // --- END ---- Cryostats and TPC --------------------------------------------
+
+
+  // --- BEGIN -- Wire planes --------------------------------------------------
+  /// @name Wire planes
+  /// @{
+
+  /// Returns the largest number of planes in a TPC.
+  unsigned int maxPlanes() const { return fMaxPlanes; }
+
+  /// Returns whether the plane `pid` is present.
+  bool hasPlane(geo::PlaneID const& pid) const;
+
+  /// Returns the frame of the plane `pid`.
+  PlaneInfo_t const& plane(geo::PlaneID const& pid) const
+    { return fPlanes[planeIndex(pid)]; }
+
+  /// Returns the frame of all planes (including the ones not present).
+  std::vector<PlaneInfo_t> const& planes() const { return fPlanes; }
+
+  /// @}
+  // --- END ---- Wire planes --------------------------------------------------
+
+
+  // --- BEGIN -- Tables -------------------------------------------------------
+  /// @name Tables
+  /// @{
+
+  /// Returns the channel mapping.
+  icarus::CompiledChannelMap const& channelMap() const { return fChannelMap; }
+
+  /// Returns the table of wireless channels and plane types of all channels.
+  icarus::ChannelKindMap const& channelKinds() const { return fChannelKinds; }
+
+  /// Returns the table of the position and extent of all wires.
+  icarus::details::WireGeometryTable const& wireGeometry() const
+    { return fWireGeometry; }
+
+  /// Returns the table of the position and neighbours of all PMT.
+  icarus::details::PMTgeometryTable const& pmtGeometry() const
+    { return fPMTgeometry; }
+
+  /// @}
+  // --- END ---- Tables -------------------------------------------------------
+
+
+  /**
+   * @brief Deletes the ROOT geometry description (`gGeoManager`).
+   *
+   * `geo::GeometryCore` does not own the ROOT geometry it loads, which stays
+   * in memory after the geometry object is destroyed. This function deletes
+   * it. No geometry object (`geo::GeometryCore`, including the ones created
+   * by other parts of the program) may be used afterwards.
+   */
+  static void releaseROOTgeometry();
+
+
+    private:
+
+  // --- BEGIN -- Geometry elements --------------------------------------------
+  unsigned int fMaxTPCs = 0U; ///< Largest number of TPC in a cryostat.
+  unsigned int fMaxPlanes = 0U; ///< Largest number of planes in a TPC.
+
+  std::vector<geo::BoxBoundedGeo> fCryostatBoxes; ///< Boxes of cryostats.
+  std::vector<TPCInfo_t> fTPCs; ///< Information of all TPC.
+  std::vector<PlaneInfo_t> fPlanes; ///< Frames of all planes.
+  // --- END ---- Geometry elements --------------------------------------------
+
+  // --- BEGIN -- Tables -------------------------------------------------------
+  icarus::CompiledChannelMap fChannelMap; ///< Channel mapping.
+  icarus::ChannelKindMap fChannelKinds; ///< Kind of each channel.
+  icarus::details::WireGeometryTable fWireGeometry; ///< Wire positions.
+  icarus::details::PMTgeometryTable fPMTgeometry; ///< PMT positions.
+  // --- END ---- Tables -------------------------------------------------------
+
+
+  /// Returns the index of `tpcid` in `fTPCs`.
+  std::size_t TPCindex(geo::TPCID const& tpcid) const
+    { return tpcid.Cryostat * fMaxTPCs + tpcid.TPC; }
+
+  /// Returns the index of `pid` in `fPlanes`.
+  std::size_t planeIndex(geo::PlaneID const& pid) const
+    { return TPCindex(pid) * fMaxPlanes + pid.Plane; }
+
+  /// Fills the cryostat, TPC and plane information.
+  void fillElements(geo::GeometryCore const& geom);
+
+}; // class icarus::CompactGeometry
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_COMPACTGEOMETRY_H
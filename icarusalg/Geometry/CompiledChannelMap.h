@@ -0,0 +1,168 @@
+/**
+ * @file   icarusalg/Geometry/CompiledChannelMap.h
+ * @brief  Flat copy of the ICARUS channel mapping, for direct calls.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/ICARUSChannelMapAlg.h`
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_GEOMETRY_COMPILEDCHANNELMAP_H
+#define ICARUSALG_GEOMETRY_COMPILEDCHANNELMAP_H
+
+// ICARUS libraries
+#include "icarusalg/Geometry/details/ChannelToWireTable.h"
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::move()
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus { class CompiledChannelMap; }
+/**
+ * @brief The ICARUS channel mapping, as flat arrays with inline queries.
+ * @see `icarus::ICARUSChannelMapAlg::compiledMap()`
+ *
+ * The queries of `icarus::ICARUSChannelMapAlg` are reached via the virtual
+ * interface of `geo::ChannelMapAlg` (usually through `geo::GeometryCore`),
+ * and they can't be inlined in the loops calling them.
+ * This object is a copy of the parts of that mapping most used in such
+ * loops, the channel-to-wire lookup table and the first channel of each wire
+ * plane, and its queries are all inline functions on those arrays.
+ *
+ * It is obtained from an initialized mapping with
+ * `icarus::ICARUSChannelMapAlg::compiledMap()`, and it does not refer to it
+ * afterwards: it stays valid (and unchanged) even if the mapping is
+ * reinitialized or destroyed.
+ *
+ * Example:
+ * ~~~~{.cpp}
+ * icarus::CompiledChannelMap const channelMap
+ *   = ICARUSchannelMapAlg.compiledMap();
+ *
+ * for (recob::Wire const& wire: wires) {
+ *   readout::ROPID const rop = channelMap.ChannelToROP(wire.Channel());
+ *   // ...
+ * }
+ * ~~~~
+ *
+ * Like in `icarus::details::ChannelToWireTable`, queries on channels or planes
+ * which do not exist have undefined result, except for `ChannelToROP()`.
+ */
+class icarus::CompiledChannelMap final {
+
+    public:
+
+  /// Type of view of the wire segments of a channel.
+  using WireSpan_t = icarus::details::ChannelToWireTable::WireSpan_t;
+
+
+  /// Constructor: an empty mapping, with no channel.
+  CompiledChannelMap() = default;
+
+  /**
+   * @brief Constructor: takes all the information of the mapping.
+   * @param wireTable lookup table of ROP and wire segments of each channel
+   * @param maxTPCs the largest number of TPCs in a cryostat
+   * @param maxPlanes the largest number of planes in a TPC
+   * @param planeFirstChannels first channel of each plane (see below)
+   *
+   * The first channel of plane `{ C, T, P }` is expected in
+   * `planeFirstChannels[(C * maxTPCs + T) * maxPlanes + P]`.
+   */
+  CompiledChannelMap(
+    icarus::details::ChannelToWireTable wireTable,
+    unsigned int maxTPCs, unsigned int maxPlanes,
+    std::vector<raw::ChannelID_t> planeFirstChannels
+    )
+    : fWireTable{ std::move(wireTable) }
+    , fMaxTPCs{ maxTPCs }
+    , fMaxPlanes{ maxPlanes }
+    , fPlaneFirstChannels{ std::move(planeFirstChannels) }
+    {}
+
+
+  // --- BEGIN -- Channel queries ----------------------------------------------
+  /// @name Channel queries
+  /// @{
+
+  /// Returns the number of channels (ID's go `0` to `Nchannels()`).
+  unsigned int Nchannels() const { return fWireTable.nChannels(); }
+
+  /// Returns whether `channel` exists in the mapping.
+  bool HasChannel(raw::ChannelID_t channel) const
+    { return fWireTable.hasChannel(channel); }
+
+  /// Returns the readout plane of `channel`, invalid if it does not exist.
+  readout::ROPID ChannelToROP(raw::ChannelID_t channel) const
+    { return HasChannel(channel)? fWireTable.ROP(channel): readout::ROPID{}; }
+
+  /// Returns a view of the wire segments of `channel` (must exist).
+  WireSpan_t ChannelToWire(raw::ChannelID_t channel) const
+    { return fWireTable.wires(channel); }
+
+  /// Returns the number of wire segments of `channel` (must exist).
+  unsigned int NwiresOnChannel(raw::ChannelID_t channel) const
+    { return fWireTable.nWires(channel); }
+
+  /// @}
+  // --- END ---- Channel queries ----------------------------------------------
+
+
+  // --- BEGIN -- Wire queries -------------------------------------------------
+  /// @name Wire queries
+  /// @{
+
+  /// Returns whether the plane `pid` is covered by the mapping.
+  bool HasPlane(geo::PlaneID const& pid) const
+    {
+      return pid && (pid.TPC < fMaxTPCs) && (pid.Plane < fMaxPlanes)
+        && (planeIndex(pid) < fPlaneFirstChannels.size());
+    }
+
+  /// Returns the channel the wire `wid` is connected to (plane must exist).
+  raw::ChannelID_t PlaneWireToChannel(geo::WireID const& wid) const
+    {
+      assert(HasPlane(wid));
+      return fPlaneFirstChannels[planeIndex(wid)] + wid.Wire;
+    }
+
+  /// @}
+  // --- END ---- Wire queries -------------------------------------------------
+
+
+    private:
+
+  /// Readout plane and wire segments of each channel.
+  icarus::details::ChannelToWireTable fWireTable;
+
+  unsigned int fMaxTPCs = 0U; ///< Largest number of TPCs in a cryostat.
+  unsigned int fMaxPlanes = 0U; ///< Largest number of planes in a TPC.
+
+  /// First channel of each plane (see `planeIndex()`).
+  std::vector<raw::ChannelID_t> fPlaneFirstChannels;
+
+
+  /// Returns the index of the plane `pid` in `fPlaneFirstChannels`.
+  std::size_t planeIndex(geo::PlaneID const& pid) const
+    {
+      return
+        (static_cast<std::size_t>(pid.Cryostat) * fMaxTPCs + pid.TPC)
+        * fMaxPlanes + pid.Plane;
+    }
+
+}; // class icarus::CompiledChannelMap
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_COMPILEDCHANNELMAP_H
@@ -8,6 +8,7 @@
 
 #include "icarusalg/Geometry/GeoObjectSorterICARUS.h"
 #include "icarusalg/Geometry/details/AuxDetSorting.h"
+#include "icarusalg/Geometry/details/CachedKeySorting.h"
 
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
@@ -16,6 +17,9 @@
 #include "larcorealg/Geometry/PlaneGeo.h"
 #include "larcorealg/Geometry/WireGeo.h"
 
+#include <functional> // std::less<>
+#include <execution> // std::execution::par_unseq
+
 namespace geo{
 
   //----------------------------------------------------------------------------
@@ -43,12 +47,10 @@ namespace geo{
   const double EPSILON = 0.000001;
 
   //----------------------------------------------------------------------------
-  // Define sort order for planes in standard configuration
-  static bool sortPlaneStandard(const PlaneGeo& p1, const PlaneGeo& p2)
+  // Define sort order for planes in standard configuration, from their centers
+  static bool sortPlaneCentersStandard
+    (geo::Point_t const& xyz1, geo::Point_t const& xyz2)
   {
-    auto const xyz1 = p1.GetBoxCenter();
-    auto const xyz2 = p2.GetBoxCenter();
-
     //if the planes are in the same drift coordinate, lower Z is first plane
     if( std::abs(xyz1.X() - xyz2.X()) < EPSILON)
       return xyz1.Z() < xyz2.Z();
@@ -58,11 +60,15 @@ namespace geo{
     return xyz1.X() > xyz2.X();
   }
 
+  // Define sort order for planes in standard configuration
+  static bool sortPlaneStandard(const PlaneGeo& p1, const PlaneGeo& p2)
+    { return sortPlaneCentersStandard(p1.GetBoxCenter(), p2.GetBoxCenter()); }
+
 
   //----------------------------------------------------------------------------
-  static bool sortWireStandard(WireGeo const& w1, WireGeo const& w2){
-    auto const [xyz1, xyz2] = std::pair{w1.GetCenter(), w2.GetCenter()};
-
+  static bool sortWireCentersStandard
+    (geo::Point_t const& xyz1, geo::Point_t const& xyz2)
+  {
     //we have horizontal wires...
     if( std::abs(xyz1.Z()-xyz2.Z()) < EPSILON)
       return xyz1.Y() < xyz2.Y();
@@ -71,33 +77,50 @@ namespace geo{
     return xyz1.Z() < xyz2.Z();
   }
 
+  static bool sortWireStandard(WireGeo const& w1, WireGeo const& w2)
+    { return sortWireCentersStandard(w1.GetCenter(), w2.GetCenter()); }
+
+  //----------------------------------------------------------------------------
+  // sort key of cryostats and TPCs (their center _x_ coordinate)
+  template <typename GeoObj>
+  static double centerX(GeoObj const& obj) { return obj.GetCenter().X(); }
+
   //----------------------------------------------------------------------------
   GeoObjectSorterICARUS::GeoObjectSorterICARUS(fhicl::ParameterSet const& p)
+    : fCachedSortKeys(p.get<bool>("CachedSortKeys", false))
   {
   }
 
   //----------------------------------------------------------------------------
   void GeoObjectSorterICARUS::SortAuxDets(std::vector<geo::AuxDetGeo> & adgeo) const
   {
-    icarus::SortAuxDetsStandard(adgeo);
+    icarus::SortAuxDetsStandard(adgeo, fCachedSortKeys);
   }
 
   //----------------------------------------------------------------------------
   void GeoObjectSorterICARUS::SortAuxDetSensitive(std::vector<geo::AuxDetSensitiveGeo> & adsgeo) const
   {
-    icarus::SortAuxDetSensitiveStandard(adsgeo);
+    icarus::SortAuxDetSensitiveStandard(adsgeo, fCachedSortKeys);
   }
 
   //----------------------------------------------------------------------------
   void GeoObjectSorterICARUS::SortCryostats(std::vector<geo::CryostatGeo> & cgeo) const
   {
-    std::sort(cgeo.begin(), cgeo.end(), sortCryoStandard);
+    if (fCachedSortKeys) {
+      icarus::details::sortByCachedKey(cgeo.begin(), cgeo.end(),
+        centerX<CryostatGeo>, std::less<double>{});
+    }
+    else std::sort(cgeo.begin(), cgeo.end(), sortCryoStandard);
   }
 
   //----------------------------------------------------------------------------
   void GeoObjectSorterICARUS::SortTPCs(std::vector<geo::TPCGeo>  & tgeo) const
   {
-    std::sort(tgeo.begin(), tgeo.end(), sortTPCStandard);
+    if (fCachedSortKeys) {
+      icarus::details::sortByCachedKey(tgeo.begin(), tgeo.end(),
+        centerX<TPCGeo>, std::less<double>{});
+    }
+    else std::sort(tgeo.begin(), tgeo.end(), sortTPCStandard);
   }
 
   //----------------------------------------------------------------------------
@@ -107,8 +130,17 @@ namespace geo{
     // sort the planes to increase in drift direction
     // The drift direction has to be set before this method is called.  It is set when
     // the CryostatGeo objects are sorted by the CryostatGeo::SortSubVolumes method
-    if     (driftDir == geo::kPosX) std::sort(pgeo.rbegin(), pgeo.rend(), sortPlaneStandard);
-    else if(driftDir == geo::kNegX) std::sort(pgeo.begin(),  pgeo.end(),  sortPlaneStandard);
+    auto const sortRange = [this](auto begin, auto end)
+      {
+        if (fCachedSortKeys) {
+          icarus::details::sortByCachedKey(begin, end,
+            [](PlaneGeo const& plane){ return plane.GetBoxCenter(); },
+            sortPlaneCentersStandard);
+        }
+        else std::sort(begin, end, sortPlaneStandard);
+      };
+    if     (driftDir == geo::kPosX) sortRange(pgeo.rbegin(), pgeo.rend());
+    else if(driftDir == geo::kNegX) sortRange(pgeo.begin(),  pgeo.end());
     else if(driftDir == geo::kUnknownDrift)
       throw cet::exception("TPCGeo") << "Drift direction is unknown, can't sort the planes\n";
   }
@@ -116,7 +148,15 @@ namespace geo{
   //----------------------------------------------------------------------------
   void GeoObjectSorterICARUS::SortWires(std::vector<geo::WireGeo> & wgeo) const
   {
-    std::sort(wgeo.begin(), wgeo.end(), sortWireStandard);
+    // wires are by far the largest collection (thousands per plane):
+    // extracting their centers and sorting the indices run in parallel
+    if (fCachedSortKeys) {
+      icarus::details::sortByCachedKey(std::execution::par_unseq,
+        wgeo.begin(), wgeo.end(),
+        [](WireGeo const& wire){ return wire.GetCenter(); },
+        sortWireCentersStandard);
+    }
+    else std::sort(wgeo.begin(), wgeo.end(), sortWireStandard);
   }
 
 }
@@ -17,6 +17,11 @@
 
 namespace geo{
 
+  /// Sorter for ICARUS geometry objects.
+  /// With the `CachedSortKeys` configuration flag set (default: `false`), the
+  /// sorting keys (centers, CRT module numbers) of each object are computed
+  /// once, indices are sorted instead of the objects, and the sorting is
+  /// stable. Wires, the largest collection, are sorted in parallel.
   class GeoObjectSorterICARUS : public GeoObjectSorter {
   public:
 
@@ -30,6 +35,10 @@ namespace geo{
                              geo::DriftDirection_t                  driftDir) const;
     void SortWires          (std::vector<geo::WireGeo>            & wgeo)     const;
 
+  private:
+
+    bool const fCachedSortKeys; ///< Whether to sort indices by cached keys.
+
   };
 
 }
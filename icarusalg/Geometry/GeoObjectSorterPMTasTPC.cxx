@@ -20,14 +20,14 @@
 void icarus::GeoObjectSorterPMTasTPC::SortAuxDets
   (std::vector<geo::AuxDetGeo>& adgeo) const
 {
-  icarus::SortAuxDetsStandard(adgeo);
+  icarus::SortAuxDetsStandard(adgeo, fCachedSortKeys);
 }
 
 //------------------------------------------------------------------------------
 void icarus::GeoObjectSorterPMTasTPC::SortAuxDetSensitive
   (std::vector<geo::AuxDetSensitiveGeo>& adsgeo) const
 {
-  icarus::SortAuxDetSensitiveStandard(adsgeo);
+  icarus::SortAuxDetSensitiveStandard(adsgeo, fCachedSortKeys);
 }
 
 
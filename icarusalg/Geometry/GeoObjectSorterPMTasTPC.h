@@ -71,6 +71,10 @@ namespace icarus { class GeoObjectSorterPMTasTPC; }
  * 
  * * `OpDetSorter` (configuration table; default: empty): configures the
  *   PMT sorter object (see `icarus::PMTsorter` for details)
+ * * `CachedSortKeys` (flag, default: `false`): sorts CRT modules and strips
+ *   parsing each of their volume names only once (see
+ *   `icarus::SortAuxDetsStandard()`); PMT sorting has its own, analogous flag
+ *   in `OpDetSorter`
  * 
  */
 class icarus::GeoObjectSorterPMTasTPC: public geo::GeoObjectSorterStandard {
@@ -87,6 +91,7 @@ class icarus::GeoObjectSorterPMTasTPC: public geo::GeoObjectSorterStandard {
     : geo::GeoObjectSorterStandard(pset)
     , fPMTsorter
       (PMTsorterConfigTable{ pset.get("OpDetSorter", fhicl::ParameterSet{}) }())
+    , fCachedSortKeys(pset.get("CachedSortKeys", false))
     {}
   
   
@@ -119,6 +124,8 @@ class icarus::GeoObjectSorterPMTasTPC: public geo::GeoObjectSorterStandard {
   
   PMTsorter_t fPMTsorter; ///< PMT sorting algorithm.
   
+  bool const fCachedSortKeys; ///< Whether CRT sorting uses cached keys.
+  
 }; // icarus::GeoObjectSorterPMTasTPC
 
 
@@ -0,0 +1,121 @@
+/**
+ * @file   icarusalg/Geometry/GeometryArrays.cxx
+ * @brief  Channel, wire and optical detector information in plain arrays.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/GeometryArrays.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/GeometryArrays.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::WireID
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+
+// -----------------------------------------------------------------------------
+icarus::GeometryArrays::GeometryArrays(geo::GeometryCore const& geom) {
+
+  fillChannels(geom);
+  fillWires(geom);
+  fillOpDets(geom);
+
+} // icarus::GeometryArrays::GeometryArrays()
+
+
+// -----------------------------------------------------------------------------
+void icarus::GeometryArrays::fillChannels(geo::GeometryCore const& geom) {
+
+  std::size_t const nChannels = geom.Nchannels();
+  fChannelCryostat.resize(nChannels, NoIndex);
+  fChannelTPC.resize(nChannels, NoIndex);
+  fChannelPlane.resize(nChannels, NoIndex);
+  fChannelWire.resize(nChannels, NoIndex);
+  fChannelNWires.resize(nChannels, 0U);
+
+  for (std::size_t channel = 0U; channel < nChannels; ++channel) {
+    std::vector<geo::WireID> const wires = geom.ChannelToWire(channel);
+    fChannelNWires[channel] = wires.size();
+    if (wires.empty()) continue;
+
+    geo::WireID const& first = wires.front();
+    fChannelCryostat[channel] = first.Cryostat;
+    fChannelTPC[channel] = first.TPC;
+    fChannelPlane[channel] = first.Plane;
+    fChannelWire[channel] = first.Wire;
+  } // for channels
+
+} // icarus::GeometryArrays::fillChannels()
+
+
+// -----------------------------------------------------------------------------
+void icarus::GeometryArrays::fillWires(geo::GeometryCore const& geom) {
+
+  std::size_t nWires = 0U;
+  for (geo::PlaneGeo const& plane: geom.Iterate<geo::PlaneGeo>())
+    nWires += plane.Nwires();
+
+  for (IndexColl_t* coll: { &fWireCryostat, &fWireTPC, &fWirePlane,
+    &fWireNumber, &fWireChannel }
+  ) {
+    coll->reserve(nWires);
+  }
+  for (CoordColl_t* coll: { &fWireStartX, &fWireStartY, &fWireStartZ,
+    &fWireEndX, &fWireEndY, &fWireEndZ }
+  ) {
+    coll->reserve(nWires);
+  }
+
+  for (geo::PlaneGeo const& plane: geom.Iterate<geo::PlaneGeo>()) {
+    for (unsigned int iWire = 0U; iWire < plane.Nwires(); ++iWire) {
+      geo::WireID const wid { plane.ID(), iWire };
+      geo::WireGeo const& wire = plane.Wire(iWire);
+      geo::Point_t const start = wire.GetStart();
+      geo::Point_t const end = wire.GetEnd();
+
+      fWireCryostat.push_back(wid.Cryostat);
+      fWireTPC.push_back(wid.TPC);
+      fWirePlane.push_back(wid.Plane);
+      fWireNumber.push_back(wid.Wire);
+      fWireChannel.push_back(geom.PlaneWireToChannel(wid));
+      fWireStartX.push_back(start.X());
+      fWireStartY.push_back(start.Y());
+      fWireStartZ.push_back(start.Z());
+      fWireEndX.push_back(end.X());
+      fWireEndY.push_back(end.Y());
+      fWireEndZ.push_back(end.Z());
+    } // for wires
+  } // for planes
+
+} // icarus::GeometryArrays::fillWires()
+
+
+// -----------------------------------------------------------------------------
+void icarus::GeometryArrays::fillOpDets(geo::GeometryCore const& geom) {
+
+  // optical detectors are numbered cryostat after cryostat
+  std::size_t const nOpDets = geom.NOpDets();
+  fOpDetCenterX.reserve(nOpDets);
+  fOpDetCenterY.reserve(nOpDets);
+  fOpDetCenterZ.reserve(nOpDets);
+  fOpDetCryostat.reserve(nOpDets);
+  for (geo::CryostatGeo const& cryo: geom.IterateCryostats()) {
+    for (unsigned int iOpDet = 0U; iOpDet < cryo.NOpDet(); ++iOpDet) {
+      geo::Point_t const center = cryo.OpDet(iOpDet).GetCenter();
+      fOpDetCenterX.push_back(center.X());
+      fOpDetCenterY.push_back(center.Y());
+      fOpDetCenterZ.push_back(center.Z());
+      fOpDetCryostat.push_back(cryo.ID().Cryostat);
+    }
+  } // for cryostats
+
+} // icarus::GeometryArrays::fillOpDets()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+/**
+ * @file   icarusalg/Geometry/GeometryArrays.h
+ * @brief  Channel, wire and optical detector information in plain arrays.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/GeometryArrays.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_GEOMETRYARRAYS_H
+#define ICARUSALG_GEOMETRY_GEOMETRYARRAYS_H
+
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace geo { class GeometryCore; }
+namespace icarus { class GeometryArrays; }
+
+/**
+ * @brief Channel, wire and optical detector information, in contiguous arrays.
+ *
+ * This object extracts from the geometry, once, the information that analysis
+ * scripts often need for all the channels, wires or optical detectors at once,
+ * and stores it as a structure of arrays:
+ * * channel table (`nChannels()` entries, indexed by channel): the cryostat,
+ *   TPC, plane and wire number of the first wire of the channel, and the
+ *   number of wires on the channel; channels with no wire have
+ *   `NoIndex` as IDs and `0` wires;
+ * * wire table (`nWires()` entries, in geometry order: cryostat, TPC, plane,
+ *   wire): the ID of the wire, its channel and its two end points;
+ * * optical detector table (`nOpDets()` entries, indexed by optical detector
+ *   number): the center of the detector and its cryostat.
+ *
+ * The arrays are plain `std::vector`, and their memory does not change after
+ * construction. Python scripts using PyROOT can view them as `numpy` arrays
+ * without copying (see `ICARUSutils.makeGeometryArrays()`), and then work on
+ * all the channels with vectorized operations instead of calling the geometry
+ * service once per channel.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::GeometryArrays const arrays { geom };
+ *
+ * // count the collection channels
+ * std::size_t nCollection = 0U;
+ * for (unsigned int const plane: arrays.channelPlane())
+ *   if (plane == 2U) ++nCollection;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::GeometryArrays {
+
+    public:
+
+  /// Type of all the indices (IDs, channels, counts) in the arrays.
+  using Index_t = unsigned int;
+
+  /// Type of a collection of indices.
+  using IndexColl_t = std::vector<Index_t>;
+
+  /// Type of a collection of coordinates.
+  using CoordColl_t = std::vector<double>;
+
+  /// Value of an index denoting no element.
+  static constexpr Index_t NoIndex = std::numeric_limits<Index_t>::max();
+
+
+  /// Constructor: extracts all the information from the geometry `geom`.
+  explicit GeometryArrays(geo::GeometryCore const& geom);
+
+
+  // --- BEGIN -- Channel table ------------------------------------------------
+  /// @name Channel table
+  /// @{
+
+  /// Returns the number of TPC channels.
+  std::size_t nChannels() const { return fChannelNWires.size(); }
+
+  /// Cryostat of the first wire of each channel.
+  IndexColl_t const& channelCryostat() const { return fChannelCryostat; }
+  /// TPC of the first wire of each channel.
+  IndexColl_t const& channelTPC() const { return fChannelTPC; }
+  /// Plane of the first wire of each channel.
+  IndexColl_t const& channelPlane() const { return fChannelPlane; }
+  /// Wire number of the first wire of each channel.
+  IndexColl_t const& channelWire() const { return fChannelWire; }
+  /// Number of wires on each channel.
+  IndexColl_t const& channelNWires() const { return fChannelNWires; }
+
+  /// @}
+  // --- END -- Channel table --------------------------------------------------
+
+
+  // --- BEGIN -- Wire table ---------------------------------------------------
+  /// @name Wire table
+  /// @{
+
+  /// Returns the number of wires.
+  std::size_t nWires() const { return fWireChannel.size(); }
+
+  /// Cryostat of each wire.
+  IndexColl_t const& wireCryostat() const { return fWireCryostat; }
+  /// TPC of each wire.
+  IndexColl_t const& wireTPC() const { return fWireTPC; }
+  /// Plane of each wire.
+  IndexColl_t const& wirePlane() const { return fWirePlane; }
+  /// Wire number of each wire.
+  IndexColl_t const& wireNumber() const { return fWireNumber; }
+  /// Channel of each wire.
+  IndexColl_t const& wireChannel() const { return fWireChannel; }
+
+  /// _x_ coordinate of the start of each wire.
+  CoordColl_t const& wireStartX() const { return fWireStartX; }
+  /// _y_ coordinate of the start of each wire.
+  CoordColl_t const& wireStartY() const { return fWireStartY; }
+  /// _z_ coordinate of the start of each wire.
+  CoordColl_t const& wireStartZ() const { return fWireStartZ; }
+  /// _x_ coordinate of the end of each wire.
+  CoordColl_t const& wireEndX() const { return fWireEndX; }
+  /// _y_ coordinate of the end of each wire.
+  CoordColl_t const& wireEndY() const { return fWireEndY; }
+  /// _z_ coordinate of the end of each wire.
+  CoordColl_t const& wireEndZ() const { return fWireEndZ; }
+
+  /// @}
+  // --- END -- Wire table -----------------------------------------------------
+
+
+  // --- BEGIN -- Optical detector table ---------------------------------------
+  /// @name Optical detector table
+  /// @{
+
+  /// Returns the number of optical detectors.
+  std::size_t nOpDets() const { return fOpDetCryostat.size(); }
+
+  /// _x_ coordinate of the center of each optical detector.
+  CoordColl_t const& opDetCenterX() const { return fOpDetCenterX; }
+  /// _y_ coordinate of the center of each optical detector.
+  CoordColl_t const& opDetCenterY() const { return fOpDetCenterY; }
+  /// _z_ coordinate of the center of each optical detector.
+  CoordColl_t const& opDetCenterZ() const { return fOpDetCenterZ; }
+  /// Cryostat of each optical detector.
+  IndexColl_t const& opDetCryostat() const { return fOpDetCryostat; }
+
+  /// @}
+  // --- END -- Optical detector table -----------------------------------------
+
+
+    private:
+
+  // --- BEGIN -- Channel table ------------------------------------------------
+  IndexColl_t fChannelCryostat; ///< Cryostat of the first wire of channels.
+  IndexColl_t fChannelTPC; ///< TPC of the first wire of channels.
+  IndexColl_t fChannelPlane; ///< Plane of the first wire of channels.
+  IndexColl_t fChannelWire; ///< Number of the first wire of channels.
+  IndexColl_t fChannelNWires; ///< Number of wires of channels.
+  // --- END -- Channel table --------------------------------------------------
+
+  // --- BEGIN -- Wire table ---------------------------------------------------
+  IndexColl_t fWireCryostat; ///< Cryostat of the wires.
+  IndexColl_t fWireTPC; ///< TPC of the wires.
+  IndexColl_t fWirePlane; ///< Plane of the wires.
+  IndexColl_t fWireNumber; ///< Number of the wires.
+  IndexColl_t fWireChannel; ///< Channel of the wires.
+  CoordColl_t fWireStartX; ///< _x_ coordinate of the start of the wires.
+  CoordColl_t fWireStartY; ///< _y_ coordinate of the start of the wires.
+  CoordColl_t fWireStartZ; ///< _z_ coordinate of the start of the wires.
+  CoordColl_t fWireEndX; ///< _x_ coordinate of the end of the wires.
+  CoordColl_t fWireEndY; ///< _y_ coordinate of the end of the wires.
+  CoordColl_t fWireEndZ; ///< _z_ coordinate of the end of the wires.
+  // --- END -- Wire table -----------------------------------------------------
+
+  // --- BEGIN -- Optical detector table ---------------------------------------
+  CoordColl_t fOpDetCenterX; ///< _x_ coordinate of the optical detectors.
+  CoordColl_t fOpDetCenterY; ///< _y_ coordinate of the optical detectors.
+  CoordColl_t fOpDetCenterZ; ///< _z_ coordinate of the optical detectors.
+  IndexColl_t fOpDetCryostat; ///< Cryostat of the optical detectors.
+  // --- END -- Optical detector table -----------------------------------------
+
+
+  /// Fills the channel table.
+  void fillChannels(geo::GeometryCore const& geom);
+
+  /// Fills the wire table.
+  void fillWires(geo::GeometryCore const& geom);
+
+  /// Fills the optical detector table.
+  void fillOpDets(geo::GeometryCore const& geom);
+
+}; // class icarus::GeometryArrays
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_GEOMETRYARRAYS_H
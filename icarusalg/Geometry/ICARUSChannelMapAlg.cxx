@@ -11,11 +11,15 @@
 
 // ICARUS libraries
 #include "icarusalg/Geometry/details/ROPandTPCsetBuildingAlg.h"
+#include "icarusalg/Geometry/details/BinaryBlob.h"
+#include "icarusalg/Utilities/Instrumentation.h" // ICARUS_SCOPED_TIMER()
 
 // LArSoft libraries
 #include "larcorealg/Geometry/CryostatGeo.h"
 #include "larcorealg/Geometry/TPCGeo.h"
 #include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
 #include "larcorealg/Geometry/ReadoutDataContainers.h"
 #include "larcorealg/Geometry/details/extractMaxGeometryElements.h"
 #include "larcorealg/CoreUtils/enumerate.h"
@@ -36,7 +40,6 @@
 #include <algorithm> // std::transform(), std::find()
 #include <utility> // std::move()
 #include <iterator> // std::back_inserter()
-#include <functional> // std::mem_fn()
 #include <tuple>
 
 
@@ -67,6 +70,14 @@ namespace {
       (coll.begin(), coll.end(), std::back_inserter(transformed), op);
     return transformed;
   } // transformCollection()
+  
+  
+  // Returns an empty view of a STL vector of `T`.
+  template <typename T>
+  util::span<typename std::vector<T>::const_iterator> emptySpan() {
+    static std::vector<T> const empty;
+    return util::make_const_span(empty);
+  } // emptySpan()
 
 
   // ---------------------------------------------------------------------------
@@ -78,6 +89,10 @@ namespace {
 icarus::ICARUSChannelMapAlg::ICARUSChannelMapAlg(Config const& config)
   : fWirelessChannelCounts
     (extractWirelessChannelParams(config.WirelessChannels()))
+  , fUseChannelToWireTable(config.ChannelToWireTable())
+  , fPMTneighborDistance(config.PMTneighborDistance())
+  , fTPCmapping(config.TPCmapping())
+  , fReadoutMappingCachePath(config.ReadoutMappingCache())
   , fSorter(getOptionalParameterSet(config.Sorter))
   {}
 
@@ -85,15 +100,48 @@ icarus::ICARUSChannelMapAlg::ICARUSChannelMapAlg(Config const& config)
 // -----------------------------------------------------------------------------
 void icarus::ICARUSChannelMapAlg::Initialize(geo::GeometryData_t const& geodata)
 {
+  ICARUS_SCOPED_TIMER("ICARUSChannelMapAlg::Initialize");
+  
   // This is the only INFO level message we want this object to produce;
   // given the dynamic nature of the channel mapping choice,
   // it's better for the log to have some indication of chosen channel mapping.
   mf::LogInfo("ICARUSChannelMapAlg")
     << "Initializing ICARUSChannelMapAlg channel mapping algorithm.";
   
-  buildReadoutPlanes(geodata.cryostats);
+  fillPMTgeometryTable(geodata.cryostats);
+  
+  if (!fTPCmapping) {
+    mf::LogInfo("ICARUSChannelMapAlg")
+      << "TPC readout mapping disabled by configuration (`TPCmapping`).";
+    return;
+  }
   
-  fillChannelToWireMap(geodata.cryostats);
+  std::uint64_t const cacheKey = fReadoutMappingCachePath.empty()
+    ? 0U: readoutMappingCacheKey(geodata.cryostats);
+  
+  if (fReadoutMappingCachePath.empty()
+    || !loadReadoutMappingCache(geodata.cryostats, cacheKey)
+  ) {
+    
+    buildReadoutPlanes(geodata.cryostats);
+    
+    fillChannelToWireMap(geodata.cryostats);
+    
+    if (!fReadoutMappingCachePath.empty()
+      && !saveReadoutMappingCache(cacheKey)
+    ) {
+      mf::LogWarning("ICARUSChannelMapAlg")
+        << "Failed to write the readout mapping cache file '"
+        << fReadoutMappingCachePath << "'.";
+    }
+    
+  } // if no cache
+  
+  if (fUseChannelToWireTable) fillChannelToWireTable();
+  
+  fillChannelKindMap();
+  
+  fillWireGeometryTable(geodata.cryostats);
   
   MF_LOG_TRACE("ICARUSChannelMapAlg")
     << "ICARUSChannelMapAlg::Initialize() completed.";
@@ -108,8 +156,16 @@ void icarus::ICARUSChannelMapAlg::Uninitialize() {
   
   fChannelToWireMap.clear();
   
+  fChannelToWireTable.clear();
+  
   fPlaneInfo.clear();
   
+  fWireGeometry.clear();
+  
+  fPMTgeometry.clear();
+  
+  fChannelKinds = {};
+  
 } // icarus::ICARUSChannelMapAlg::Uninitialize()
 
 
@@ -122,6 +178,14 @@ std::vector<geo::WireID> icarus::ICARUSChannelMapAlg::ChannelToWire
   //
   assert(!fPlaneInfo.empty());
   
+  //
+  // fast path: lookup table
+  //
+  if (hasChannelToWireTable()) {
+    WireSpan_t const wires = ChannelToWireSegments(channel);
+    return { wires.begin(), wires.end() };
+  }
+  
   //
   // output
   //
@@ -164,6 +228,112 @@ std::vector<geo::WireID> icarus::ICARUSChannelMapAlg::ChannelToWire
 } // icarus::ICARUSChannelMapAlg::ChannelToWire()
 
 
+//------------------------------------------------------------------------------
+auto icarus::ICARUSChannelMapAlg::ChannelToWireSegments
+  (raw::ChannelID_t channel) const -> WireSpan_t
+{
+  if (!hasChannelToWireTable()) {
+    throw cet::exception("ICARUSChannelMapAlg")
+      << "icarus::ICARUSChannelMapAlg::ChannelToWireSegments(" << channel
+      << "): channel lookup table was disabled by configuration"
+      " (`ChannelToWireTable`).\n";
+  }
+  if (!fChannelToWireTable.hasChannel(channel)) {
+    throw cet::exception("Geometry")
+      << "icarus::ICARUSChannelMapAlg::ChannelToWireSegments(" << channel
+      << "): invalid channel requested (must be lower than "
+      << Nchannels() << ")\n";
+  }
+  return fChannelToWireTable.wires(channel);
+} // icarus::ICARUSChannelMapAlg::ChannelToWireSegments()
+
+
+//------------------------------------------------------------------------------
+icarus::CompiledChannelMap icarus::ICARUSChannelMapAlg::compiledMap() const {
+  
+  assert(!fPlaneInfo.empty());
+  
+  unsigned int const nCryostats = fPlaneInfo.dimSize<0U>();
+  unsigned int const maxTPCs = fPlaneInfo.dimSize<1U>();
+  unsigned int const maxPlanes = fPlaneInfo.dimSize<2U>();
+  
+  std::vector<raw::ChannelID_t> planeFirstChannels;
+  planeFirstChannels.reserve(nCryostats * maxTPCs * maxPlanes);
+  for (auto c: util::counter<geo::CryostatID::CryostatID_t>(nCryostats)) {
+    for (auto t: util::counter<geo::TPCID::TPCID_t>(maxTPCs)) {
+      for (auto p: util::counter<geo::PlaneID::PlaneID_t>(maxPlanes)) {
+        planeFirstChannels.push_back
+          (fPlaneInfo[geo::PlaneID{ c, t, p }].firstChannel());
+      }
+    } // for TPCs
+  } // for cryostats
+  
+  return {
+    hasChannelToWireTable()? fChannelToWireTable: makeChannelToWireTable(),
+    maxTPCs, maxPlanes, std::move(planeFirstChannels)
+    };
+  
+} // icarus::ICARUSChannelMapAlg::compiledMap()
+
+
+//------------------------------------------------------------------------------
+icarus::ChannelProcessingPlan icarus::ICARUSChannelMapAlg::processingPlan
+  (unsigned int alignment /* = 1U */) const
+{
+  /*
+   * The channel range of each readout plane is cut at the first and end
+   * channel of each of its wire planes; the pieces covered by no plane are
+   * wireless channels, the others become segments.
+   */
+  icarus::ChannelProcessingPlan plan
+    { fChannelToWireMap.nChannels(), alignment };
+  
+  for (auto const& ROPinfo: fChannelToWireMap.ROPs()) {
+    
+    PlaneColl_t const& planes = ROPplanes(ROPinfo.ropid);
+    
+    std::vector<raw::ChannelID_t> boundaries;
+    for (geo::PlaneGeo const* plane: planes) {
+      PlaneInfo_t const& planeInfo = fPlaneInfo[plane->ID()];
+      boundaries.push_back(planeInfo.firstChannel());
+      boundaries.push_back(planeInfo.endChannel());
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase
+      (std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    
+    icarus::ChannelKindMap::PlaneType const planeType
+      = toChannelKindType(findPlaneType(ROPinfo.ropid));
+    
+    for (std::size_t iBound = 1U; iBound < boundaries.size(); ++iBound) {
+      raw::ChannelID_t const first = boundaries[iBound - 1];
+      raw::ChannelID_t const end = boundaries[iBound];
+      
+      icarus::ChannelProcessingPlan::Segment_t segment;
+      for (geo::PlaneGeo const* plane: planes) {
+        PlaneInfo_t const& planeInfo = fPlaneInfo[plane->ID()];
+        if (!planeInfo.channelRange().contains(first)) continue;
+        if (segment.nPlanes++ > 0U) continue;
+        segment.plane = plane->ID();
+        segment.firstWire = first - planeInfo.firstChannel();
+      } // for planes
+      if (segment.nPlanes == 0U) continue; // wireless
+      
+      segment.ROP = ROPinfo.ropid;
+      segment.planeType = planeType;
+      segment.firstChannel = first;
+      segment.nChannels = end - first;
+      plan.addSegment(segment);
+    } // for boundaries
+    
+  } // for ROPs
+  
+  plan.close();
+  return plan;
+  
+} // icarus::ICARUSChannelMapAlg::processingPlan()
+
+
 //------------------------------------------------------------------------------
 unsigned int icarus::ICARUSChannelMapAlg::Nchannels() const {
   
@@ -220,6 +390,21 @@ geo::WireID icarus::ICARUSChannelMapAlg::NearestWireID
 } // icarus::ICARUSChannelMapAlg::NearestWireID()
 
 
+//------------------------------------------------------------------------------
+icarus::details::WireCoordinateProjection const&
+icarus::ICARUSChannelMapAlg::planeProjection(geo::PlaneID const& planeID) const
+{
+  if (!fPlaneInfo.hasPlane(planeID)
+    || !fPlaneInfo[planeID].projection().isValid()
+  ) {
+    throw cet::exception("Geometry")
+      << "icarus::ICARUSChannelMapAlg::planeProjection(" << planeID
+      << "): plane not known to the channel mapping.\n";
+  }
+  return fPlaneInfo[planeID].projection();
+} // icarus::ICARUSChannelMapAlg::planeProjection()
+
+
 //------------------------------------------------------------------------------
 raw::ChannelID_t icarus::ICARUSChannelMapAlg::PlaneWireToChannel
   (geo::WireID const& wireID) const
@@ -286,15 +471,8 @@ readout::TPCsetID icarus::ICARUSChannelMapAlg::TPCtoTPCset
 std::vector<geo::TPCID> icarus::ICARUSChannelMapAlg::TPCsetToTPCs
   (readout::TPCsetID const& tpcsetid) const
 {
-  std::vector<geo::TPCID> TPCs;
-  if (!tpcsetid) return TPCs;
-  
-  auto const& TPClist = TPCsetTPCs(tpcsetid);
-  TPCs.reserve(TPClist.size());
-  std::transform(TPClist.begin(), TPClist.end(), std::back_inserter(TPCs),
-    std::mem_fn(&geo::TPCGeo::ID)
-    );
-  return TPCs;
+  auto const TPCs = TPCsetTPCIDs(tpcsetid);
+  return { TPCs.begin(), TPCs.end() };
 } // icarus::ICARUSChannelMapAlg::TPCsetToTPCs()
 
 
@@ -354,15 +532,8 @@ readout::ROPID icarus::ICARUSChannelMapAlg::WirePlaneToROP
 std::vector<geo::PlaneID> icarus::ICARUSChannelMapAlg::ROPtoWirePlanes
   (readout::ROPID const& ropid) const
 {
-  std::vector<geo::PlaneID> Planes;
-  if (!ropid) return Planes;
-  
-  auto const& PlaneList = ROPplanes(ropid);
-  Planes.reserve(PlaneList.size());
-  std::transform(PlaneList.begin(), PlaneList.end(), std::back_inserter(Planes),
-    std::mem_fn(&geo::PlaneGeo::ID)
-    );
-  return Planes;
+  auto const planes = ROPwirePlaneIDs(ropid);
+  return { planes.begin(), planes.end() };
 } // icarus::ICARUSChannelMapAlg::ROPtoWirePlanes()
 
 
@@ -370,34 +541,50 @@ std::vector<geo::PlaneID> icarus::ICARUSChannelMapAlg::ROPtoWirePlanes
 std::vector<geo::TPCID> icarus::ICARUSChannelMapAlg::ROPtoTPCs
   (readout::ROPID const& ropid) const
 {
-  std::vector<geo::TPCID> TPCs;
-  if (!ropid) return TPCs;
-  
-  /*
-   * We use the same algorithm as for extracting the plane IDs
-   * (they implicitly convert to TPC ID... kind of them).
-   * The algorithm does not test for duplication, i.e. in theory it could
-   * produce lists with the same TPC ID being present multiple times
-   * from different planes.
-   * But this is not expected in this mapping, where each TPC holds at most
-   * one wire plane for each view, and the planes in a ROP are all on the same
-   * view. It might be matter of an assertion, but it's too complex to fit in an
-   * `assert()` call.
-   */
-  auto const& PlaneList = ROPplanes(ropid);
-  TPCs.reserve(PlaneList.size());
-  std::transform(PlaneList.begin(), PlaneList.end(), std::back_inserter(TPCs),
-    std::mem_fn(&geo::PlaneGeo::ID)
-    );
-  return TPCs;
+  auto const TPCs = ROPTPCIDs(ropid);
+  return { TPCs.begin(), TPCs.end() };
 } // icarus::ICARUSChannelMapAlg::ROPtoTPCs()
 
 
+//------------------------------------------------------------------------------
+auto icarus::ICARUSChannelMapAlg::TPCsetTPCIDs
+  (readout::TPCsetID const& tpcsetid) const -> TPCIDspan_t
+{
+  if (!tpcsetid) return emptySpan<geo::TPCID>();
+  assert(fReadoutMapInfo);
+  return util::make_const_span(fReadoutMapInfo.fTPCsetTPCIDs[tpcsetid]);
+} // icarus::ICARUSChannelMapAlg::TPCsetTPCIDs()
+
+
+//------------------------------------------------------------------------------
+auto icarus::ICARUSChannelMapAlg::ROPwirePlaneIDs
+  (readout::ROPID const& ropid) const -> PlaneIDspan_t
+{
+  if (!ropid) return emptySpan<geo::PlaneID>();
+  assert(fReadoutMapInfo);
+  return util::make_const_span(fReadoutMapInfo.fROPplaneIDs[ropid]);
+} // icarus::ICARUSChannelMapAlg::ROPwirePlaneIDs()
+
+
+//------------------------------------------------------------------------------
+auto icarus::ICARUSChannelMapAlg::ROPTPCIDs
+  (readout::ROPID const& ropid) const -> TPCIDspan_t
+{
+  if (!ropid) return emptySpan<geo::TPCID>();
+  assert(fReadoutMapInfo);
+  return util::make_const_span(fReadoutMapInfo.fROPTPCIDs[ropid]);
+} // icarus::ICARUSChannelMapAlg::ROPTPCIDs()
+
+
 //------------------------------------------------------------------------------
 readout::ROPID icarus::ICARUSChannelMapAlg::ChannelToROP
   (raw::ChannelID_t channel) const
 {
   if (!raw::isValidChannelID(channel)) return {};
+  if (hasChannelToWireTable()) {
+    return fChannelToWireTable.hasChannel(channel)
+      ? fChannelToWireTable.ROP(channel): readout::ROPID{};
+  }
   icarus::details::ChannelToWireMap::ChannelsInROPStruct const* info
     = fChannelToWireMap.find(channel);
   return info? info->ropid: readout::ROPID{};
@@ -504,7 +691,8 @@ void icarus::ICARUSChannelMapAlg::fillChannelToWireMap
         fPlaneInfo[(*iPlane)->ID()] = {
           ChannelRange_t
             { firstROPchannel + WirelessChannelCounts.first, nextChannel },
-          rid
+          rid,
+          icarus::details::WireCoordinateProjection::fromPlane(**iPlane)
           };
         log << " [" << (*iPlane)->ID() << "] "
           << fPlaneInfo[(*iPlane)->ID()].firstChannel()
@@ -543,7 +731,10 @@ void icarus::ICARUSChannelMapAlg::fillChannelToWireMap
             = (nextChannel - 1) - lastMatchedWireID.Wire;
           nextChannel = firstChannel + nWires;
           
-          fPlaneInfo[plane.ID()] = { { firstChannel, nextChannel }, rid };
+          fPlaneInfo[plane.ID()] = {
+            { firstChannel, nextChannel }, rid,
+            icarus::details::WireCoordinateProjection::fromPlane(plane)
+            };
           log << " [" << plane.ID() << "] "
             << fPlaneInfo[plane.ID()].firstChannel() << " -- "
             << fPlaneInfo[plane.ID()].lastChannel() << ";";
@@ -572,6 +763,186 @@ void icarus::ICARUSChannelMapAlg::fillChannelToWireMap
 } // icarus::ICARUSChannelMapAlg::fillChannelToWireMap()
 
 
+// -----------------------------------------------------------------------------
+auto icarus::ICARUSChannelMapAlg::makeChannelToWireTable() const
+  -> icarus::details::ChannelToWireTable
+{
+  
+  //
+  // input check
+  //
+  assert(fReadoutMapInfo);
+  assert(!fPlaneInfo.empty());
+  
+  //
+  // output setup
+  //
+  icarus::details::ChannelToWireTable table;
+  
+  // each wire plane contributes one segment per wire; wireless channels none
+  std::size_t nWires = 0U;
+  for (auto const& ROPinfo: fChannelToWireMap.ROPs()) {
+    for (geo::PlaneGeo const* plane: ROPplanes(ROPinfo.ropid))
+      nWires += plane->Nwires();
+  }
+  table.reserve(fChannelToWireMap.nChannels(), nWires);
+  
+  //
+  // fill ROP by ROP, in channel order
+  //
+  for (auto const& ROPinfo: fChannelToWireMap.ROPs()) {
+    
+    assert(ROPinfo.firstChannel == table.nChannels());
+    
+    PlaneColl_t const& planes = ROPplanes(ROPinfo.ropid);
+    
+    raw::ChannelID_t const endChannel
+      = ROPinfo.firstChannel + ROPinfo.nChannels;
+    for (raw::ChannelID_t channel = ROPinfo.firstChannel;
+      channel < endChannel; ++channel
+    ) {
+      
+      table.addChannel(ROPinfo.ropid);
+      
+      for (geo::PlaneGeo const* plane: planes) {
+        
+        geo::PlaneID const& pid = plane->ID();
+        ChannelRange_t const& channelRange = fPlaneInfo[pid].channelRange();
+        
+        if (!channelRange.contains(channel)) continue;
+        table.addWire({
+          pid, static_cast<geo::WireID::WireID_t>(channel - channelRange.begin())
+          });
+        
+      } // for planes in ROP
+      
+    } // for channels in ROP
+    
+  } // for ROPs
+  
+  assert(table.nChannels() == fChannelToWireMap.nChannels());
+  assert(table.nWires() == nWires);
+  
+  return table;
+  
+} // icarus::ICARUSChannelMapAlg::makeChannelToWireTable()
+
+
+// -----------------------------------------------------------------------------
+void icarus::ICARUSChannelMapAlg::fillChannelToWireTable() {
+  
+  fChannelToWireTable = makeChannelToWireTable();
+  
+  MF_LOG_TRACE("ICARUSChannelMapAlg")
+    << "Channel lookup table: " << fChannelToWireTable.nChannels()
+    << " channels, " << fChannelToWireTable.nWires() << " wire segments.";
+  
+} // icarus::ICARUSChannelMapAlg::fillChannelToWireTable()
+
+
+// -----------------------------------------------------------------------------
+void icarus::ICARUSChannelMapAlg::fillChannelKindMap() {
+  
+  /*
+   * All the channels of a readout plane share its type; of them, only the ones
+   * in the channel range of one of its wire planes are connected to wires.
+   */
+  icarus::ChannelKindMap kinds { fChannelToWireMap.nChannels() };
+  
+  for (auto const& ROPinfo: fChannelToWireMap.ROPs()) {
+    
+    kinds.setPlaneType(
+      ROPinfo.firstChannel, ROPinfo.firstChannel + ROPinfo.nChannels,
+      toChannelKindType(findPlaneType(ROPinfo.ropid))
+      );
+    
+    for (geo::PlaneGeo const* plane: ROPplanes(ROPinfo.ropid)) {
+      PlaneInfo_t const& planeInfo = fPlaneInfo[plane->ID()];
+      kinds.setWired(planeInfo.firstChannel(), planeInfo.endChannel());
+    }
+    
+  } // for ROPs
+  
+  fChannelKinds = std::move(kinds);
+  
+  MF_LOG_TRACE("ICARUSChannelMapAlg")
+    << "Channel kinds: " << fChannelKinds.nWireless() << " wireless out of "
+    << fChannelKinds.nChannels() << " channels.";
+  
+} // icarus::ICARUSChannelMapAlg::fillChannelKindMap()
+
+
+// -----------------------------------------------------------------------------
+void icarus::ICARUSChannelMapAlg::fillWireGeometryTable
+  (geo::GeometryData_t::CryostatList_t const& Cryostats)
+{
+  std::array<unsigned int, 3U> const maxSizes
+    = geo::details::extractMaxGeometryElements<3U>(Cryostats);
+  
+  fWireGeometry.clear();
+  fWireGeometry.resize(maxSizes[0U], maxSizes[1U], maxSizes[2U]);
+  
+  std::size_t nWires = 0U;
+  for (geo::CryostatGeo const& cryo: Cryostats) {
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) {
+      for (geo::PlaneGeo const& plane: tpc.IteratePlanes())
+        nWires += plane.Nwires();
+    }
+  } // for cryostats
+  fWireGeometry.reserve(nWires);
+  
+  // planes are added in ID order, as they are in the geometry
+  for (geo::CryostatGeo const& cryo: Cryostats) {
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) {
+      for (geo::PlaneGeo const& plane: tpc.IteratePlanes()) {
+        fWireGeometry.addPlane(plane.ID(), plane.WirePitch(),
+          plane.GetIncreasingWireDirection());
+        for (geo::WireGeo const& wire: plane.IterateWires()) {
+          fWireGeometry.addWire
+            (wire.GetCenter(), wire.Direction(), wire.HalfL());
+        }
+      } // for planes
+    } // for TPCs
+  } // for cryostats
+  
+  MF_LOG_TRACE("ICARUSChannelMapAlg")
+    << "Wire geometry table: " << fWireGeometry.nWires() << " wires.";
+  
+} // icarus::ICARUSChannelMapAlg::fillWireGeometryTable()
+
+
+// -----------------------------------------------------------------------------
+void icarus::ICARUSChannelMapAlg::fillPMTgeometryTable
+  (geo::GeometryData_t::CryostatList_t const& Cryostats)
+{
+  /*
+   * Optical channels follow the optical detectors, cryostat by cryostat
+   * (the channel of each detector is also its number).
+   * The wall of each PMT is given by which side of the cryostat center it is.
+   */
+  fPMTgeometry.clear();
+  
+  std::size_t nOpDets = 0U;
+  for (geo::CryostatGeo const& cryo: Cryostats) nOpDets += cryo.NOpDet();
+  fPMTgeometry.reserve(nOpDets);
+  
+  for (geo::CryostatGeo const& cryo: Cryostats) {
+    double const centerX = cryo.GetCenter().X();
+    for (unsigned int iOpDet = 0U; iOpDet < cryo.NOpDet(); ++iOpDet) {
+      geo::Point_t const center = cryo.OpDet(iOpDet).GetCenter();
+      fPMTgeometry.addPMT
+        (center, cryo.ID().Cryostat, (center.X() < centerX)? 0U: 1U);
+    } // for optical detectors
+  } // for cryostats
+  
+  fPMTgeometry.buildNeighbors(fPMTneighborDistance);
+  
+  MF_LOG_TRACE("ICARUSChannelMapAlg")
+    << "PMT geometry table: " << fPMTgeometry.nPMTs() << " PMT.";
+  
+} // icarus::ICARUSChannelMapAlg::fillPMTgeometryTable()
+
+
 // -----------------------------------------------------------------------------
 void icarus::ICARUSChannelMapAlg::buildReadoutPlanes
   (geo::GeometryData_t::CryostatList_t const& Cryostats)
@@ -590,6 +961,315 @@ void icarus::ICARUSChannelMapAlg::buildReadoutPlanes
 } // icarus::ICARUSChannelMapAlg::buildReadoutPlanes()
 
 
+// -----------------------------------------------------------------------------
+std::uint64_t icarus::ICARUSChannelMapAlg::readoutMappingCacheKey
+  (geo::GeometryData_t::CryostatList_t const& Cryostats) const
+{
+  /*
+   * The key includes all the geometry information the mapping relies on
+   * (structure, plane position and orientation, wire count and placement),
+   * all the configuration of the mapping, and the layout of the data types
+   * stored in the cache.
+   */
+  icarus::details::FNV1aHasher hasher;
+  
+  hasher.add(ReadoutMappingCacheVersion);
+  hasher.add(sizeof(readout::ROPID)).add(sizeof(geo::PlaneID));
+  hasher.add(sizeof(icarus::details::WireCoordinateProjection));
+  
+  for (auto const& TPCsetCounts: fWirelessChannelCounts) {
+    for (auto const& [ pre, post ]: TPCsetCounts) hasher.add(pre).add(post);
+  }
+  
+  auto addPoint = [&hasher](geo::Point_t const& p)
+    { hasher.add(p.X()).add(p.Y()).add(p.Z()); };
+  
+  hasher.add(Cryostats.size());
+  for (geo::CryostatGeo const& cryo: Cryostats) {
+    hasher.add(cryo.NTPC());
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) {
+      hasher.add(tpc.Nplanes());
+      addPoint(tpc.GetCenter());
+      for (geo::PlaneGeo const& plane: tpc.IteratePlanes()) {
+        hasher.add(plane.Nwires()).add(plane.View());
+        hasher.add(plane.ThetaZ()).add(plane.WirePitch());
+        addPoint(plane.GetCenter());
+        addPoint(plane.FirstWire().GetCenter());
+        addPoint(plane.LastWire().GetCenter());
+      } // for planes
+    } // for TPCs
+  } // for cryostats
+  
+  return hasher.value();
+} // icarus::ICARUSChannelMapAlg::readoutMappingCacheKey()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::ICARUSChannelMapAlg::saveReadoutMappingCache
+  (std::uint64_t key) const
+{
+  /*
+   * Format:
+   * 
+   * * header: magic word, format version, cache key
+   * * readout mapping information (`fReadoutMapInfo`), with geometry objects
+   *   stored as their ID
+   * * plane information (`fPlaneInfo`)
+   * * channel map (`fChannelToWireMap`)
+   * * trailer: magic word
+   * 
+   * Dimensions are written before each container.
+   */
+  using namespace icarus::details;
+  
+  assert(fReadoutMapInfo);
+  
+  BlobWriter blob;
+  blob.write(ReadoutMappingCacheMagic)
+    .write(ReadoutMappingCacheVersion).write(key);
+  
+  //
+  // readout mapping
+  //
+  unsigned int const nCryostats = fReadoutMapInfo.NCryostats();
+  unsigned int const maxTPCsets = fReadoutMapInfo.MaxTPCsets();
+  unsigned int const maxROPs = fReadoutMapInfo.MaxROPs();
+  blob.write(nCryostats).write(maxTPCsets).write(maxROPs);
+  
+  for (unsigned int const count: TPCsetCount()) blob.write(count);
+  
+  for (auto c: util::counter<readout::CryostatID::CryostatID_t>(nCryostats)) {
+    for (auto s: util::counter<readout::TPCsetID::TPCsetID_t>(maxTPCsets)) {
+      readout::TPCsetID const sid { c, s };
+      blob.write(ROPcount(sid));
+      TPCColl_t const& TPCs = TPCsetTPCs(sid);
+      blob.write(static_cast<unsigned int>(TPCs.size()));
+      for (geo::TPCGeo const* TPC: TPCs) blob.write(TPC->ID());
+      for (auto r: util::counter<readout::ROPID::ROPID_t>(maxROPs)) {
+        PlaneColl_t const& planes = ROPplanes({ sid, r });
+        blob.write(static_cast<unsigned int>(planes.size()));
+        for (geo::PlaneGeo const* plane: planes) blob.write(plane->ID());
+      } // for ROPs
+    } // for TPC sets
+  } // for cryostats
+  
+  auto const& TPCtoSet = TPCtoTPCset();
+  blob.write(static_cast<unsigned int>(TPCtoSet.dimSize<0U>()))
+    .write(static_cast<unsigned int>(TPCtoSet.dimSize<1U>()));
+  for (readout::TPCsetID const& sid: TPCtoSet) blob.write(sid);
+  
+  auto const& planeToROP = PlaneToROP();
+  blob.write(static_cast<unsigned int>(planeToROP.dimSize<0U>()))
+    .write(static_cast<unsigned int>(planeToROP.dimSize<1U>()))
+    .write(static_cast<unsigned int>(planeToROP.dimSize<2U>()));
+  for (readout::ROPID const& rid: planeToROP) blob.write(rid);
+  
+  //
+  // plane information
+  //
+  blob.write(static_cast<unsigned int>(fPlaneInfo.dimSize<0U>()))
+    .write(static_cast<unsigned int>(fPlaneInfo.dimSize<1U>()))
+    .write(static_cast<unsigned int>(fPlaneInfo.dimSize<2U>()));
+  for (PlaneInfo_t const& info: fPlaneInfo) {
+    blob.write(info.channelRange().begin()).write(info.channelRange().end());
+    blob.write(info.ROP()).write(info.projection());
+  }
+  
+  //
+  // channel map
+  //
+  auto const& ROPs = fChannelToWireMap.ROPs();
+  blob.write(static_cast<unsigned int>(ROPs.size()));
+  for (auto const& ROPinfo: ROPs) {
+    blob.write(ROPinfo.firstChannel).write(ROPinfo.nChannels)
+      .write(ROPinfo.ropid);
+  }
+  blob.write(fChannelToWireMap.endChannel());
+  
+  blob.write(ReadoutMappingCacheMagic);
+  
+  if (!blob.writeToFile(fReadoutMappingCachePath)) return false;
+  
+  mf::LogTrace("ICARUSChannelMapAlg")
+    << "Readout mapping cache (" << blob.size() << " bytes) written into '"
+    << fReadoutMappingCachePath << "'.";
+  return true;
+  
+} // icarus::ICARUSChannelMapAlg::saveReadoutMappingCache()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::ICARUSChannelMapAlg::loadReadoutMappingCache(
+  geo::GeometryData_t::CryostatList_t const& Cryostats, std::uint64_t key
+) {
+  /*
+   * See `saveReadoutMappingCache()` for the format.
+   * Every geometry ID read from the cache is checked against the geometry
+   * before being converted into a pointer: since the key covers the geometry,
+   * a mismatch means a corrupted cache.
+   */
+  using namespace icarus::details;
+  
+  assert(!fReadoutMapInfo);
+  assert(fPlaneInfo.empty());
+  
+  MappedBlobReader blob { fReadoutMappingCachePath };
+  if (!blob) {
+    mf::LogDebug("ICARUSChannelMapAlg")
+      << "Readout mapping cache '" << fReadoutMappingCachePath
+      << "' not available: mapping will be built.";
+    return false;
+  }
+  
+  if ((blob.read<std::uint64_t>() != ReadoutMappingCacheMagic)
+    || (blob.read<std::uint32_t>() != ReadoutMappingCacheVersion)
+    || (blob.read<std::uint64_t>() != key)
+  ) {
+    mf::LogInfo("ICARUSChannelMapAlg")
+      << "Readout mapping cache '" << fReadoutMappingCachePath
+      << "' is obsolete: mapping will be rebuilt.";
+    return false;
+  }
+  
+  auto findTPC = [&Cryostats](geo::TPCID const& tpcid) -> geo::TPCGeo const*
+    {
+      if (!tpcid || (tpcid.Cryostat >= Cryostats.size())) return nullptr;
+      geo::CryostatGeo const& cryo = Cryostats[tpcid.Cryostat];
+      return (tpcid.TPC < cryo.NTPC())? &(cryo.TPC(tpcid)): nullptr;
+    };
+  auto findPlane = [&findTPC](geo::PlaneID const& pid) -> geo::PlaneGeo const*
+    {
+      geo::TPCGeo const* TPC = findTPC(pid);
+      return (TPC && (pid.Plane < TPC->Nplanes()))? &(TPC->Plane(pid)): nullptr;
+    };
+  
+  bool good = true;
+  
+  //
+  // readout mapping
+  //
+  unsigned int const nCryostats = blob.read<unsigned int>();
+  unsigned int const maxTPCsets = blob.read<unsigned int>();
+  unsigned int const maxROPs = blob.read<unsigned int>();
+  if (!blob || (nCryostats != Cryostats.size())) return false;
+  
+  std::vector<unsigned int> TPCsetCounts(nCryostats);
+  for (unsigned int& count: TPCsetCounts) count = blob.read<unsigned int>();
+  
+  readout::TPCsetDataContainer<TPCColl_t> TPCsetTPCs
+    { nCryostats, maxTPCsets };
+  readout::TPCsetDataContainer<unsigned int> ROPcount
+    { nCryostats, maxTPCsets };
+  readout::ROPDataContainer<PlaneColl_t> ROPplanes
+    { nCryostats, maxTPCsets, maxROPs };
+  
+  for (auto c: util::counter<readout::CryostatID::CryostatID_t>(nCryostats)) {
+    for (auto s: util::counter<readout::TPCsetID::TPCsetID_t>(maxTPCsets)) {
+      readout::TPCsetID const sid { c, s };
+      ROPcount[sid] = blob.read<unsigned int>();
+      TPCColl_t& TPCs = TPCsetTPCs[sid];
+      TPCs.resize(blob.read<unsigned int>());
+      for (geo::TPCGeo const*& TPC: TPCs) {
+        TPC = findTPC(blob.read<geo::TPCID>());
+        good = good && TPC;
+      }
+      for (auto r: util::counter<readout::ROPID::ROPID_t>(maxROPs)) {
+        PlaneColl_t& planes = ROPplanes[{ sid, r }];
+        planes.resize(blob.read<unsigned int>());
+        for (geo::PlaneGeo const*& plane: planes) {
+          plane = findPlane(blob.read<geo::PlaneID>());
+          good = good && plane;
+        }
+      } // for ROPs
+      if (!blob || !good) return false;
+    } // for TPC sets
+  } // for cryostats
+  
+  auto const [ NCryostats, MaxTPCs, MaxPlanes ]
+    = geo::details::extractMaxGeometryElements<3U>(Cryostats);
+  
+  {
+    unsigned int const dim0 = blob.read<unsigned int>();
+    unsigned int const dim1 = blob.read<unsigned int>();
+    if (!blob || (dim0 != NCryostats) || (dim1 != MaxTPCs)) return false;
+  }
+  geo::TPCDataContainer<readout::TPCsetID> TPCtoTPCset { NCryostats, MaxTPCs };
+  for (readout::TPCsetID& sid: TPCtoTPCset) sid = blob.read<readout::TPCsetID>();
+  
+  {
+    unsigned int const dim0 = blob.read<unsigned int>();
+    unsigned int const dim1 = blob.read<unsigned int>();
+    unsigned int const dim2 = blob.read<unsigned int>();
+    if (!blob || (dim0 != NCryostats) || (dim1 != MaxTPCs)
+      || (dim2 != MaxPlanes)
+    ) {
+      return false;
+    }
+  }
+  geo::PlaneDataContainer<readout::ROPID> PlaneToROP
+    { NCryostats, MaxTPCs, MaxPlanes };
+  for (readout::ROPID& rid: PlaneToROP) rid = blob.read<readout::ROPID>();
+  
+  //
+  // plane information
+  //
+  {
+    unsigned int const dim0 = blob.read<unsigned int>();
+    unsigned int const dim1 = blob.read<unsigned int>();
+    unsigned int const dim2 = blob.read<unsigned int>();
+    if (!blob || (dim0 != NCryostats) || (dim1 != MaxTPCs)
+      || (dim2 != MaxPlanes)
+    ) {
+      return false;
+    }
+  }
+  geo::PlaneDataContainer<PlaneInfo_t> planeInfo
+    { NCryostats, MaxTPCs, MaxPlanes };
+  for (PlaneInfo_t& info: planeInfo) {
+    raw::ChannelID_t const first = blob.read<raw::ChannelID_t>();
+    raw::ChannelID_t const end = blob.read<raw::ChannelID_t>();
+    readout::ROPID const rid = blob.read<readout::ROPID>();
+    info = { { first, end }, rid, blob.read<WireCoordinateProjection>() };
+  }
+  
+  //
+  // channel map
+  //
+  icarus::details::ChannelToWireMap channelMap;
+  unsigned int const nROPs = blob.read<unsigned int>();
+  raw::ChannelID_t lastChannel = 0;
+  for (unsigned int iROP = 0; iROP < nROPs; ++iROP) {
+    raw::ChannelID_t const firstChannel = blob.read<raw::ChannelID_t>();
+    unsigned int const nChannels = blob.read<unsigned int>();
+    readout::ROPID const rid = blob.read<readout::ROPID>();
+    if (!blob || ((iROP > 0) && (firstChannel <= lastChannel))) return false;
+    channelMap.addROP(rid, firstChannel, nChannels);
+    lastChannel = firstChannel;
+  }
+  channelMap.setEndChannel(blob.read<raw::ChannelID_t>());
+  
+  if ((blob.read<std::uint64_t>() != ReadoutMappingCacheMagic) || !blob.atEnd())
+    return false;
+  
+  //
+  // all good: commit the content
+  //
+  fReadoutMapInfo.set(
+    std::move(TPCsetCounts), std::move(TPCsetTPCs),
+    std::move(ROPcount), std::move(ROPplanes),
+    std::move(TPCtoTPCset), std::move(PlaneToROP)
+    );
+  fPlaneInfo = std::move(planeInfo);
+  fChannelToWireMap = std::move(channelMap);
+  
+  mf::LogTrace("ICARUSChannelMapAlg")
+    << "Readout mapping restored from cache '" << fReadoutMappingCachePath
+    << "'.";
+  return true;
+  
+} // icarus::ICARUSChannelMapAlg::loadReadoutMappingCache()
+
+
 // -----------------------------------------------------------------------------
 auto icarus::ICARUSChannelMapAlg::findPlaneType(readout::ROPID const& rid) const
   -> PlaneType_t
@@ -625,11 +1305,23 @@ geo::SigType_t icarus::ICARUSChannelMapAlg::SignalTypeForChannelImpl
    * great) to assign signal type accordingly.
    */
   
-  icarus::details::ChannelToWireMap::ChannelsInROPStruct const* channelInfo
-    = fChannelToWireMap.find(channel);
-  if (!channelInfo) return geo::kMysteryType;
+  // fast path: the plane type was already found on initialization
+  if (fChannelKinds.hasChannel(channel)) {
+    switch (fChannelKinds.planeType(channel)) {
+      case icarus::ChannelKindMap::PlaneType::FirstInduction:
+      case icarus::ChannelKindMap::PlaneType::SecondInduction:
+        return geo::kInduction;
+      case icarus::ChannelKindMap::PlaneType::Collection:
+        return geo::kCollection;
+      default:
+        return geo::kMysteryType;
+    } // switch
+  }
   
-  switch (findPlaneType(channelInfo->ropid)) {
+  readout::ROPID const ropid = ChannelToROP(channel);
+  if (!ropid) return geo::kMysteryType;
+  
+  switch (findPlaneType(ropid)) {
     case kFirstInductionType:
     case kSecondInductionType:
       return geo::kInduction;
@@ -682,6 +1374,49 @@ auto icarus::ICARUSChannelMapAlg::extractWirelessChannelParams
 } // icarus::ICARUSChannelMapAlg::extractWirelessChannelParams()
 
 
+// ----------------------------------------------------------------------------
+void icarus::ICARUSChannelMapAlg::ReadoutMappingInfo_t::fillIDs() {
+  
+  /*
+   * The ID lists are filled for all the TPC sets and readout planes the
+   * containers have room for, including the ones that do not exist
+   * (their geometry object lists are empty).
+   */
+  unsigned int const nCryostats = NCryostats();
+  unsigned int const maxTPCsets = MaxTPCsets();
+  unsigned int const maxROPs = MaxROPs();
+  
+  fTPCsetTPCIDs = readout::TPCsetDataContainer<std::vector<geo::TPCID>>
+    { nCryostats, maxTPCsets };
+  fROPplaneIDs = readout::ROPDataContainer<std::vector<geo::PlaneID>>
+    { nCryostats, maxTPCsets, maxROPs };
+  fROPTPCIDs = readout::ROPDataContainer<std::vector<geo::TPCID>>
+    { nCryostats, maxTPCsets, maxROPs };
+  
+  for (auto c: util::counter<readout::CryostatID::CryostatID_t>(nCryostats)) {
+    for (auto s: util::counter<readout::TPCsetID::TPCsetID_t>(maxTPCsets)) {
+      readout::TPCsetID const sid { c, s };
+      fTPCsetTPCIDs[sid] = transformCollection
+        (fTPCsetTPCs[sid], [](geo::TPCGeo const* TPC){ return TPC->ID(); });
+      for (auto r: util::counter<readout::ROPID::ROPID_t>(maxROPs)) {
+        readout::ROPID const rid { sid, r };
+        fROPplaneIDs[rid] = transformCollection(fROPplanes[rid],
+          [](geo::PlaneGeo const* plane){ return plane->ID(); });
+        /*
+         * We do not test for duplication: this mapping is not expected to
+         * have two planes of the same TPC in a ROP, since each TPC holds at
+         * most one wire plane for each view, and the planes in a ROP are all
+         * on the same view.
+         */
+        fROPTPCIDs[rid] = transformCollection(fROPplaneIDs[rid],
+          [](geo::PlaneID const& pid){ return geo::TPCID{ pid }; });
+      } // for ROPs
+    } // for TPC sets
+  } // for cryostats
+  
+} // icarus::ICARUSChannelMapAlg::ReadoutMappingInfo_t::fillIDs()
+
+
 // ----------------------------------------------------------------------------
 std::string icarus::ICARUSChannelMapAlg::PlaneTypeName(PlaneType_t planeType) {
   
@@ -698,4 +1433,22 @@ std::string icarus::ICARUSChannelMapAlg::PlaneTypeName(PlaneType_t planeType) {
 } // icarus::ICARUSChannelMapAlg::PlaneTypeName()
 
 
+// -----------------------------------------------------------------------------
+icarus::ChannelKindMap::PlaneType
+icarus::ICARUSChannelMapAlg::toChannelKindType(PlaneType_t planeType) {
+  
+  switch (planeType) {
+    case kFirstInductionType:
+      return icarus::ChannelKindMap::PlaneType::FirstInduction;
+    case kSecondInductionType:
+      return icarus::ChannelKindMap::PlaneType::SecondInduction;
+    case kCollectionType:
+      return icarus::ChannelKindMap::PlaneType::Collection;
+    default:
+      return icarus::ChannelKindMap::PlaneType::Unknown;
+  } // switch
+  
+} // icarus::ICARUSChannelMapAlg::toChannelKindType()
+
+
 // ----------------------------------------------------------------------------
@@ -12,6 +12,13 @@
 // ICARUS libraries
 #include "icarusalg/Geometry/GeoObjectSorterPMTasTPC.h"
 #include "icarusalg/Geometry/details/ChannelToWireMap.h"
+#include "icarusalg/Geometry/details/ChannelToWireTable.h"
+#include "icarusalg/Geometry/CompiledChannelMap.h"
+#include "icarusalg/Geometry/ChannelKindMap.h"
+#include "icarusalg/Geometry/ChannelProcessingPlan.h"
+#include "icarusalg/Geometry/details/WireCoordinateProjection.h"
+#include "icarusalg/Geometry/details/WireGeometryTable.h"
+#include "icarusalg/Geometry/details/PMTgeometryTable.h"
 #include "icarusalg/Geometry/details/GeometryObjectCollections.h"
 
 // LArSoft libraries
@@ -20,6 +27,7 @@
 #include "larcorealg/Geometry/GeometryData.h"
 #include "larcorealg/Geometry/GeometryDataContainers.h"
 #include "larcorealg/Geometry/ReadoutDataContainers.h"
+#include "larcorealg/CoreUtils/span.h" // util::span
 #include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
@@ -31,6 +39,9 @@
 
 // C/C++ standard libraries
 #include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
 #include <cassert>
 
 
@@ -162,6 +173,98 @@ namespace icarus {
  * `CollectionOddPostChannels`. They are all `0` by default.
  * 
  * 
+ * Channel lookup table
+ * =====================
+ * 
+ * Unless disabled by the `ChannelToWireTable` configuration parameter, on
+ * initialization a dense table is filled with the readout plane and the wire
+ * segments of each channel (see `icarus::details::ChannelToWireTable`).
+ * With the table, `ChannelToWire()`, `ChannelToROP()` and the signal type
+ * queries perform no search. Moreover, `ChannelToWireSegments()` returns a
+ * view of the wire segments that requires no memory allocation either: this
+ * is the preferred interface in high-throughput loops.
+ * 
+ * Algorithms which know they run with this mapping can also obtain a copy of
+ * the table with `compiledMap()` (`icarus::CompiledChannelMap`), whose
+ * queries are not virtual and can be inlined in the calling loops.
+ * Long-running processes whose channel configuration may change while reader
+ * threads run can publish that copy, together with `channelKinds()`, as
+ * immutable snapshots via `icarus::ChannelMapPublisher`, building the new
+ * mapping in a separate object instead of reinitializing this one.
+ * 
+ * 
+ * Channel kinds
+ * ==============
+ * 
+ * On initialization, whether each channel is wireless and the type of its
+ * plane are recorded in a compact table (`icarus::ChannelKindMap`, from
+ * `channelKinds()`), which answers both questions with a single array access
+ * and is also used for the signal type queries.
+ * 
+ * Algorithms processing the digits plane by plane can obtain with
+ * `processingPlan()` a layout (`icarus::ChannelProcessingPlan`) grouping the
+ * wired channels in contiguous, aligned segments of the same readout plane
+ * and wire planes, which need no further lookup in the mapping.
+ * 
+ * 
+ * Wire geometry table
+ * ====================
+ * 
+ * On initialization the center, direction and half length of all wires, and
+ * the pitch of all planes, are also copied into flat arrays
+ * (`icarus::details::WireGeometryTable`, from `wireGeometry()`), in the same
+ * order as the channels of each plane. Wire crossing points and the wires
+ * crossing a box can be computed from them without accessing the geometry
+ * objects.
+ * 
+ * 
+ * PMT geometry table
+ * ===================
+ * 
+ * On initialization, after the optical detectors are sorted, their center,
+ * cryostat and wall are copied into a flat table indexed by optical channel
+ * (`icarus::details::PMTgeometryTable`, from `pmtGeometry()`), together with
+ * a graph of the neighbours of each PMT on the same wall, within the distance
+ * set by the `PMTneighborDistance` configuration parameter. Flash clustering
+ * and trigger emulation can use it without accessing `geo::OpDetGeo`.
+ * 
+ * 
+ * Partial initialization
+ * =======================
+ * 
+ * Jobs that need only part of the detector can skip part of the
+ * initialization:
+ * 
+ * * with `TPCmapping` set to `false` no TPC readout mapping is built at all:
+ *   there are no TPC sets, readout planes nor TPC channels, and none of the
+ *   TPC readout queries can be used; the geometry is still sorted as usual,
+ *   and the optical detector channel queries and the PMT geometry table are
+ *   still available. This is meant for jobs using only the optical detectors.
+ * 
+ * The TPC readout mapping can't be restricted to some of the cryostats:
+ * the channel numbers of each cryostat depend on the ones before it, and the
+ * rest of the work for a cryostat is small compared to the loading of the
+ * geometry itself.
+ * 
+ * 
+ * Readout mapping cache
+ * ======================
+ * 
+ * Building the readout planes and the channel map requires a few passes on the
+ * whole geometry. If the `ReadoutMappingCache` configuration parameter is set
+ * to a file path, the result of that construction is saved into that file as
+ * a versioned binary blob, and jobs that find an up-to-date file memory-map it
+ * and restore the mapping from it instead of building it again.
+ * 
+ * The blob is keyed by a hash of the geometry description (the position and
+ * the structure of all cryostats, TPCs and wire planes, which is what the GDML
+ * file describes as far as the mapping is concerned) and of the mapping
+ * configuration. If the key in the file does not match, or the file is missing
+ * or unreadable, the mapping is built from scratch as usual and the file is
+ * (re)written. Failure to write the file is not an error.
+ * The blob is written in the native binary representation: it is not meant
+ * to be shared between different platforms.
+ * 
  */
 class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   
@@ -261,6 +364,30 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
       Comment("configuration of channels with no connected wire")
       };
     
+    fhicl::Atom<std::string> ReadoutMappingCache {
+      Name("ReadoutMappingCache"),
+      Comment("path of the readout mapping cache file (empty: no cache)"),
+      ""
+      };
+    
+    fhicl::Atom<bool> ChannelToWireTable {
+      Name("ChannelToWireTable"),
+      Comment("precompute a dense channel-to-wire table for fast lookup"),
+      true
+      };
+    
+    fhicl::Atom<double> PMTneighborDistance {
+      Name("PMTneighborDistance"),
+      Comment("largest distance between the centers of neighbouring PMT [cm]"),
+      60.0
+      };
+    
+    fhicl::Atom<bool> TPCmapping {
+      Name("TPCmapping"),
+      Comment("build the TPC readout mapping (false for optical detector only jobs)"),
+      true
+      };
+    
   }; // struct Config
   
   /// Type of FHiCL configuration table for this object.
@@ -299,6 +426,58 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   virtual std::vector<geo::WireID> ChannelToWire(raw::ChannelID_t channel) const
     override;
   
+  /// Type of view of the wire segments connected to a channel.
+  using WireSpan_t = icarus::details::ChannelToWireTable::WireSpan_t;
+  
+  /**
+   * @brief Returns a view of the IDs of wires connected to the `channel`.
+   * @param channel TPC readout channel number
+   * @return a view of the wire IDs associated with `channel`
+   * @throws cet::exception (category: "Geometry") if non-existent channel
+   * @throws cet::exception (category: "ICARUSChannelMapAlg") if the channel
+   *         lookup table was disabled in the configuration
+   * @see `ChannelToWire()`
+   * 
+   * This is the same as `ChannelToWire()`, but the returned object is a view
+   * of the internal lookup table (see `icarus::details::ChannelToWireTable`)
+   * which stays valid until the mapping is uninitialized.
+   * No memory allocation is performed.
+   */
+  WireSpan_t ChannelToWireSegments(raw::ChannelID_t channel) const;
+  
+  /// Returns whether the dense channel lookup table is available.
+  bool hasChannelToWireTable() const { return !fChannelToWireTable.empty(); }
+  
+  /// Returns whether the TPC readout mapping is built (`TPCmapping`).
+  bool hasTPCmapping() const { return fTPCmapping; }
+  
+  /**
+   * @brief Returns a flat copy of the channel mapping.
+   * @return a `icarus::CompiledChannelMap` with this mapping
+   * 
+   * The returned object answers `ChannelToROP()`, `ChannelToWire()` and
+   * `PlaneWireToChannel()` queries like this mapping, but with inline calls
+   * rather than through the `geo::ChannelMapAlg` virtual interface.
+   * The lookup table is built for it even when it is disabled in this object
+   * by configuration.
+   * The mapping must be already initialized.
+   */
+  icarus::CompiledChannelMap compiledMap() const;
+  
+  /**
+   * @brief Returns a layout of the wired channels in contiguous segments.
+   * @param alignment (default: `1`) each segment starts at a multiple of this
+   * @return a `icarus::ChannelProcessingPlan` of all the TPC channels
+   * 
+   * Each readout plane is split into segments at the boundaries of the
+   * channel ranges of its wire planes; wireless channels are left out.
+   * Segments are in channel order, and each starts at a slot which is a
+   * multiple of `alignment`.
+   * The mapping must be already initialized.
+   */
+  icarus::ChannelProcessingPlan processingPlan
+    (unsigned int alignment = 1U) const;
+  
   /// Returns the number of readout channels (ID's go `0` to `Nchannels()`).
   virtual unsigned int Nchannels() const override;
   
@@ -337,6 +516,79 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   /// @}
   
   
+  // --- BEGIN -- Batch wire projection ----------------------------------------
+  /**
+   * @name Batch wire projection
+   * 
+   * These methods project many points at once on a wire plane, using the
+   * plane geometry cached on initialization
+   * (`icarus::details::WireCoordinateProjection`).
+   * The points are passed as plain arrays, either as a structure of arrays of
+   * _y_ and _z_ coordinates or as an array of `geo::Point_t`, and the results
+   * are written into a preallocated output array of the same size.
+   * 
+   * Unlike the deprecated single-point methods above, these are supported and
+   * intended for high-throughput projection (e.g. of all the trajectory points
+   * of a track).
+   * The nearest wire of points outside the plane is reported as
+   * `geo::WireID::InvalidID`.
+   * 
+   * All methods throw `cet::exception` (category: `"Geometry"`) if the
+   * `planeID` is not known to the mapping.
+   */
+  /// @{
+  
+  /// Type of wire number used in batch projection results.
+  using WireNo_t = icarus::details::WireCoordinateProjection::WireNo_t;
+  
+  /// Computes the wire coordinates of `n` points `(YPos[i], ZPos[i])`.
+  void WireCoordinates(
+    geo::PlaneID const& planeID,
+    std::size_t n, double const* YPos, double const* ZPos, double* coords
+    ) const
+    { planeProjection(planeID).wireCoordinates(n, YPos, ZPos, coords); }
+  
+  /// Computes the wire coordinates of `n` `points`.
+  void WireCoordinates(
+    geo::PlaneID const& planeID,
+    std::size_t n, geo::Point_t const* points, double* coords
+    ) const
+    { planeProjection(planeID).wireCoordinates(n, points, coords); }
+  
+  /// Finds the wire nearest to each of `n` points `(YPos[i], ZPos[i])`.
+  void NearestWires(
+    geo::PlaneID const& planeID,
+    std::size_t n, double const* YPos, double const* ZPos, WireNo_t* wires
+    ) const
+    { planeProjection(planeID).nearestWires(n, YPos, ZPos, wires); }
+  
+  /// Finds the wire nearest to each of `n` `points`.
+  void NearestWires(
+    geo::PlaneID const& planeID,
+    std::size_t n, geo::Point_t const* points, WireNo_t* wires
+    ) const
+    { planeProjection(planeID).nearestWires(n, points, wires); }
+  
+  /// Returns the cached projection on the plane `planeID`.
+  /// @throw cet::exception (category: `"Geometry"`) if plane is not known
+  icarus::details::WireCoordinateProjection const& planeProjection
+    (geo::PlaneID const& planeID) const;
+  
+  /// Returns the table of wireless channels and plane types of all channels.
+  icarus::ChannelKindMap const& channelKinds() const { return fChannelKinds; }
+  
+  /// Returns the table of the position and extent of all wires.
+  icarus::details::WireGeometryTable const& wireGeometry() const
+    { return fWireGeometry; }
+  
+  /// Returns the table of the position and neighbours of all PMT.
+  icarus::details::PMTgeometryTable const& pmtGeometry() const
+    { return fPMTgeometry; }
+  
+  /// @}
+  // --- END -- Batch wire projection ------------------------------------------
+  
+  
   //
   // TPC set interface
   //
@@ -485,6 +737,39 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   /// @}
   // --- END -- Readout plane interface ----------------------------------------
 
+
+  // --- BEGIN -- ICARUS-specific readout views --------------------------------
+  /**
+   * @name ICARUS-specific readout views
+   * 
+   * These are the same lists as from `TPCsetToTPCs()`, `ROPtoWirePlanes()`
+   * and `ROPtoTPCs()`, returned as views of ID lists precomputed with the
+   * readout mapping, rather than new vectors.
+   * The views are valid until the readout mapping is changed (i.e. for the
+   * whole job in practice).
+   * Like in the standard interface, an invalid ID yields an empty view,
+   * while a valid ID of an element that does not exist has undefined result.
+   */
+  /// @{
+  
+  /// Type of view of a list of TPC IDs.
+  using TPCIDspan_t = util::span<std::vector<geo::TPCID>::const_iterator>;
+  
+  /// Type of view of a list of wire plane IDs.
+  using PlaneIDspan_t = util::span<std::vector<geo::PlaneID>::const_iterator>;
+  
+  /// Returns a view of the IDs of the TPCs in the TPC set `tpcsetid`.
+  TPCIDspan_t TPCsetTPCIDs(readout::TPCsetID const& tpcsetid) const;
+  
+  /// Returns a view of the IDs of the wire planes in the readout plane `ropid`.
+  PlaneIDspan_t ROPwirePlaneIDs(readout::ROPID const& ropid) const;
+  
+  /// Returns a view of the IDs of the TPCs spanned by readout plane `ropid`.
+  TPCIDspan_t ROPTPCIDs(readout::ROPID const& ropid) const;
+  
+  /// @}
+  // --- END -- ICARUS-specific readout views ----------------------------------
+
   
   /// Return the sorter.
   virtual geo::GeoObjectSorter const& Sorter() const override
@@ -534,6 +819,15 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
     /// The ROP each wire plane belongs to.
     geo::PlaneDataContainer<readout::ROPID> fPlaneToROP;
     
+    /// ID of the TPCs in each TPC set, in the same order as `fTPCsetTPCs`.
+    readout::TPCsetDataContainer<std::vector<geo::TPCID>> fTPCsetTPCIDs;
+    
+    /// ID of the planes in each readout plane, in the order of `fROPplanes`.
+    readout::ROPDataContainer<std::vector<geo::PlaneID>> fROPplaneIDs;
+    
+    /// ID of the TPC of each plane in each readout plane (as `fROPplaneIDs`).
+    readout::ROPDataContainer<std::vector<geo::TPCID>> fROPTPCIDs;
+    
     ReadoutMappingInfo_t() = default;
     
     void set(
@@ -559,6 +853,7 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
         assert(fTPCsetTPCs.dimSize<1U>() == fROPcount.dimSize<1U>());
         assert(fTPCsetTPCs.dimSize<1U>() == fROPplanes.dimSize<1U>());
         assert(fTPCtoTPCset.dimSize<1U>() == fPlaneToROP.dimSize<1U>());
+        fillIDs();
       } // set()
     
     unsigned int NCryostats() const
@@ -572,6 +867,7 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
         fTPCsetCount.clear(); fTPCsetTPCs.clear();
         fROPcount.clear(); fROPplanes.clear();
         fTPCtoTPCset.clear(); fPlaneToROP.clear();
+        fTPCsetTPCIDs.clear(); fROPplaneIDs.clear(); fROPTPCIDs.clear();
       }
     
     /// Returns whether all the data containers are initialized.
@@ -582,6 +878,10 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
           && !fTPCtoTPCset.empty() && !fPlaneToROP.empty();
       }
     
+      private:
+    /// Fills the ID lists from the geometry object lists.
+    void fillIDs();
+    
   }; // ReadoutMappingInfo_t
   
   /// Collection of information on one plane.
@@ -590,6 +890,9 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
     ChannelRange_t fChannelRange; ///< Range of channels covered by the plane.
     readout::ROPID fROPID; ///< Which readout plane this wire plane belongs to.
     
+    /// Projection of points into the wire coordinate of this plane.
+    icarus::details::WireCoordinateProjection fProjection;
+    
     /// Returns the range of channels covered by the wire plane.
     constexpr ChannelRange_t const& channelRange() const
       { return fChannelRange; }
@@ -609,6 +912,11 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
     /// Returns the ID of the readout plane this wire plane belongs to.
     constexpr readout::ROPID ROP() const { return fROPID; }
     
+    /// Returns the projection of points into the wire coordinate.
+    constexpr icarus::details::WireCoordinateProjection const& projection()
+      const
+      { return fProjection; }
+    
   }; // struct PlaneInfo_t
   
   
@@ -621,6 +929,18 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   /// Range of channels covered by each of the wire planes.
   geo::PlaneDataContainer<PlaneInfo_t> fPlaneInfo;
   
+  /// Position and extent of all wires.
+  icarus::details::WireGeometryTable fWireGeometry;
+  
+  /// Position and neighbours of all PMT.
+  icarus::details::PMTgeometryTable fPMTgeometry;
+  
+  /// Wireless channels and plane type of each channel.
+  icarus::ChannelKindMap fChannelKinds;
+  
+  /// Dense table of ROP and wires of each channel (empty if disabled).
+  icarus::details::ChannelToWireTable fChannelToWireTable;
+  
   
   /// @}
   // --- END -- Readout element information ------------------------------------
@@ -630,6 +950,18 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   /// Count of wireless channels on each plane.
   WirelessChannelCounts_t const fWirelessChannelCounts;
   
+  /// Whether to fill the dense channel lookup table.
+  bool const fUseChannelToWireTable;
+  
+  /// Largest distance between the centers of neighbouring PMT [cm].
+  double const fPMTneighborDistance;
+  
+  /// Whether to build the TPC readout mapping at all.
+  bool const fTPCmapping;
+  
+  /// Path of the readout mapping cache file (empty if no cache is used).
+  std::string const fReadoutMappingCachePath;
+  
   // --- END -- Configuration parameters ---------------------------------------
 
   // --- BEGIN -- Sorting ------------------------------------------------------
@@ -729,6 +1061,34 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
     (geo::GeometryData_t::CryostatList_t const& Cryostats);
   
   
+  /**
+   * @brief Fills the dense channel lookup table `fChannelToWireTable`.
+   * 
+   * The channel mapping must have been already filled
+   * (`fillChannelToWireMap()`).
+   */
+  void fillChannelToWireTable();
+  
+  /// Returns a new dense channel lookup table (see `fillChannelToWireTable()`).
+  icarus::details::ChannelToWireTable makeChannelToWireTable() const;
+  
+  /**
+   * @brief Fills the channel kind table `fChannelKinds`.
+   * 
+   * The channel mapping must have been already filled
+   * (`fillChannelToWireMap()`).
+   */
+  void fillChannelKindMap();
+  
+  /// Fills the wire geometry table `fWireGeometry` from the geometry.
+  void fillWireGeometryTable
+    (geo::GeometryData_t::CryostatList_t const& Cryostats);
+  
+  /// Fills the PMT geometry table `fPMTgeometry` from the (sorted) geometry.
+  void fillPMTgeometryTable
+    (geo::GeometryData_t::CryostatList_t const& Cryostats);
+  
+  
   /**
    * @brief Fills information about the TPC set and readout plane structure.
    * @param Cryostats the sorted list of cryostats in the detector
@@ -748,6 +1108,37 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   void buildReadoutPlanes(geo::GeometryData_t::CryostatList_t const& Cryostats);
   
   
+  // --- BEGIN -- Readout mapping cache ----------------------------------------
+  /// Version of the format of the readout mapping cache.
+  static constexpr std::uint32_t ReadoutMappingCacheVersion = 1U;
+  
+  /// Magic word marking the beginning and the end of the mapping cache.
+  static constexpr std::uint64_t ReadoutMappingCacheMagic
+    = 0x50414d5355524143ULL; // "CARUSMAP" in little endian
+  
+  /// Returns the key of the mapping cache for this geometry and configuration.
+  std::uint64_t readoutMappingCacheKey
+    (geo::GeometryData_t::CryostatList_t const& Cryostats) const;
+  
+  /**
+   * @brief Restores the readout mapping from the cache file.
+   * @param Cryostats the sorted list of cryostats in the detector
+   * @param key the expected key of the cache
+   * @return whether the mapping was successfully restored
+   * 
+   * This method fills the same information as `buildReadoutPlanes()` and
+   * `fillChannelToWireMap()`. On failure, that information is left empty.
+   */
+  bool loadReadoutMappingCache(
+    geo::GeometryData_t::CryostatList_t const& Cryostats, std::uint64_t key
+    );
+  
+  /// Writes the current readout mapping into the cache file; `false` on error.
+  bool saveReadoutMappingCache(std::uint64_t key) const;
+  
+  // --- END -- Readout mapping cache ------------------------------------------
+  
+  
   /**
    * @brief Returns the "type" of readout plane.
    * @param ropid ID of the readout plane to query
@@ -775,6 +1166,10 @@ class icarus::ICARUSChannelMapAlg: public geo::ChannelMapAlg {
   /// Returns the name of the specified plane type.
   static std::string PlaneTypeName(PlaneType_t planeType);
   
+  /// Converts a plane type into its `icarus::ChannelKindMap` equivalent.
+  static icarus::ChannelKindMap::PlaneType toChannelKindType
+    (PlaneType_t planeType);
+  
 
   
 }; // class icarus::ICARUSChannelMapAlg
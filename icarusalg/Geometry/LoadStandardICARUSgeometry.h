@@ -3,7 +3,12 @@
  * @brief Single-line utility to create `geo::GeometryCore` in non-art contexts.
  * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
  * 
- * Provides `icarus::geo::LoadStandardICARUSgeometry()`.
+ * Provides `icarus::geo::LoadStandardICARUSgeometry()`, and its instrumented
+ * version reporting the time and memory spent in each phase of the loading
+ * (`icarus::geo::GeometryLoadProfile`). Both can restrict the loading to part
+ * of the detector (`icarus::geo::GeometryLoadOptions`).
+ * `icarus::geo::LoadCompactICARUSgeometry()` loads the same geometry, keeps
+ * only its flat tables (`icarus::CompactGeometry`) and releases the rest.
  * 
  * This library is (intentionally and stubbornly) header-only.
  * It requires linking with:
@@ -23,27 +28,279 @@
 // ICARUS libraries
 #include "icarusalg/Geometry/ICARUSstandaloneGeometrySetup.h"
 #include "icarusalg/Geometry/ICARUSChannelMapAlg.h"
+#include "icarusalg/Geometry/CompactGeometry.h"
 
 // LArSoft and framework libraries
 #include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/GeoObjectSorter.h"
+#include "larcorealg/Geometry/AuxDetGeo.h"
+#include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
 #include "messagefacility/MessageLogger/MessageLogger.h" // mf::StartMessageFacility()
 #include "fhiclcpp/make_ParameterSet.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "cetlib/filepath_maker.h"
+#include "cetlib/search_path.h"
+
+// POSIX libraries
+#include <unistd.h> // sysconf()
 
 // C/C++ libraries
+#include <ostream>
+#include <fstream>
+#include <iomanip> // std::setw()
 #include <stdexcept> // std::runtime_error
 #include <memory> // std::unique_ptr
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <vector>
 #include <string>
+#include <utility> // std::move()
 
 
 // -----------------------------------------------------------------------------
 namespace icarus::geo {
+  
+  struct GeometryLoadProfile;
+  struct GeometryLoadOptions;
+  
   std::unique_ptr<::geo::GeometryCore> LoadStandardICARUSgeometry [[nodiscard]]
     (std::string const& configPath);
+  
+  std::unique_ptr<::geo::GeometryCore> LoadStandardICARUSgeometry [[nodiscard]]
+    (std::string const& configPath, GeometryLoadProfile& profile);
+  
+  std::unique_ptr<::geo::GeometryCore> LoadStandardICARUSgeometry [[nodiscard]]
+    (std::string const& configPath, GeometryLoadOptions const& options);
+  
+  std::unique_ptr<::geo::GeometryCore> LoadStandardICARUSgeometry [[nodiscard]]
+    (
+      std::string const& configPath, GeometryLoadOptions const& options,
+      GeometryLoadProfile& profile
+    );
+  
+  icarus::CompactGeometry LoadCompactICARUSgeometry [[nodiscard]]
+    (std::string const& configPath);
+  
+  icarus::CompactGeometry LoadCompactICARUSgeometry [[nodiscard]]
+    (std::string const& configPath, GeometryLoadOptions const& options);
+  
 } // namespace icarus::geo
 
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief Restrictions of the geometry loading to part of the detector.
+ * @see `icarus::geo::LoadStandardICARUSgeometry()`
+ * 
+ * These options override the corresponding parameters of the channel mapping
+ * configuration (see the "partial initialization" section of
+ * `icarus::ICARUSChannelMapAlg` documentation), but only to restrict it:
+ * default options leave the configuration unchanged.
+ * 
+ * For example, a tool using only the PMT can skip the TPC mapping with:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::geo::GeometryLoadOptions options;
+ * options.TPCmapping = false;
+ * std::unique_ptr<geo::GeometryCore> geom
+ *   = icarus::geo::LoadStandardICARUSgeometry("standard_g4_icarus.fcl", options);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+struct icarus::geo::GeometryLoadOptions {
+  
+  /// Whether to build the TPC readout mapping (`false` for PMT-only jobs).
+  bool TPCmapping = true;
+  
+}; // icarus::geo::GeometryLoadOptions
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Record of the time and memory spent loading the geometry.
+ * @see `icarus::geo::LoadStandardICARUSgeometry()`
+ * 
+ * Each phase of the loading is recorded with its wall time and the change of
+ * resident memory of the process across it. The phases are, in order:
+ * 
+ * * `"configuration"`: parsing of the FHiCL configuration file;
+ * * `"message facility"`: message facility initialization (if needed);
+ * * `"geometry description"`: parsing of the GDML/ROOT geometry description;
+ * * `"sorting"`: sorting of all geometry objects (with the sorter of the
+ *   channel mapping: `icarus::GeoObjectSorterPMTasTPC`);
+ * * `"channel mapping"`: channel mapping initialization
+ *   (`icarus::ICARUSChannelMapAlg::Initialize()`);
+ * * `"geometry update"`: the rest of the channel mapping application (e.g.
+ *   updating the geometry after sorting).
+ * 
+ * Resident memory is read from `/proc/self/statm`, and it is reported as `0`
+ * where that is not available.
+ */
+struct icarus::geo::GeometryLoadProfile {
+  
+  /// Information on a single loading phase.
+  struct Phase_t {
+    std::string name; ///< Name of the phase.
+    double wallTime = 0.0; ///< Wall time spent in the phase [s].
+    long memoryDelta = 0L; ///< Change of resident memory in the phase [kiB].
+  }; // Phase_t
+  
+  /// Largest number of phases a loading can have.
+  static constexpr std::size_t MaxPhases = 6U;
+  
+  std::vector<Phase_t> phases; ///< All the phases, in execution order.
+  
+  long finalMemory = 0L; ///< Resident memory at the end of loading [kiB].
+  
+  /// Returns the total time spent in all phases [s].
+  double totalTime() const
+    {
+      double total = 0.0;
+      for (Phase_t const& phase: phases) total += phase.wallTime;
+      return total;
+    }
+  
+  /// Returns the phase with the specified `name`, `nullptr` if none.
+  Phase_t const* phase(std::string const& name) const
+    {
+      for (Phase_t const& phase: phases) if (phase.name == name) return &phase;
+      return nullptr;
+    }
+  
+  /// Adds a new phase with the specified `name` and returns it.
+  Phase_t& addPhase(std::string name)
+    { phases.push_back({ std::move(name) }); return phases.back(); }
+  
+  /// Prints a table of the phases into `out` (no end-of-line at the end).
+  template <typename Stream>
+  void dump(Stream&& out, std::string const& indent = "") const
+    {
+      double const total = totalTime();
+      out << indent << "Geometry loading took " << (total * 1000.0) << " ms"
+        << " (" << phases.size() << " phases, final resident memory: "
+        << (finalMemory / 1024.0) << " MiB):";
+      for (Phase_t const& phase: phases) {
+        out << "\n" << indent << "  " << std::setw(22) << std::left
+          << phase.name << std::right << std::setw(10)
+          << (phase.wallTime * 1000.0) << " ms (" << std::setw(5)
+          << ((total > 0.0)? (100.0 * phase.wallTime / total): 0.0)
+          << "%), memory " << ((phase.memoryDelta >= 0)? "+": "")
+          << (phase.memoryDelta / 1024.0) << " MiB";
+      }
+    }
+  
+}; // icarus::geo::GeometryLoadProfile
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::geo::details {
+  
+  /// Returns the resident memory of this process [kiB], `0` if not available.
+  inline long residentMemoryKiB() {
+    std::ifstream statm { "/proc/self/statm" };
+    long pages = 0L, resident = 0L;
+    if (!(statm >> pages >> resident)) return 0L;
+    return resident * (::sysconf(_SC_PAGESIZE) / 1024L);
+  } // residentMemoryKiB()
+  
+  
+  /// Adds to a phase the time and memory change between construction and
+  /// destruction of this object.
+  class PhaseTimer {
+    
+    using Clock_t = std::chrono::steady_clock;
+    
+    GeometryLoadProfile::Phase_t& fPhase;
+    Clock_t::time_point const fStart = Clock_t::now();
+    long const fStartMemory = residentMemoryKiB();
+    
+      public:
+    PhaseTimer(GeometryLoadProfile::Phase_t& phase): fPhase(phase) {}
+    PhaseTimer(PhaseTimer const&) = delete;
+    ~PhaseTimer()
+      {
+        fPhase.wallTime
+          += std::chrono::duration<double>(Clock_t::now() - fStart).count();
+        fPhase.memoryDelta += residentMemoryKiB() - fStartMemory;
+      }
+  }; // PhaseTimer
+  
+  
+  /// Geometry sorter recording the time spent sorting with another sorter.
+  class TimedGeoObjectSorter: public ::geo::GeoObjectSorter {
+    
+    ::geo::GeoObjectSorter const& fSorter; ///< The actual sorter.
+    GeometryLoadProfile::Phase_t& fPhase; ///< Where to record the time.
+    
+      public:
+    TimedGeoObjectSorter
+      (::geo::GeoObjectSorter const& sorter, GeometryLoadProfile::Phase_t& phase)
+      : fSorter(sorter), fPhase(phase) {}
+    
+    virtual void SortAuxDets
+      (std::vector<::geo::AuxDetGeo>& adgeo) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortAuxDets(adgeo); }
+    virtual void SortAuxDetSensitive
+      (std::vector<::geo::AuxDetSensitiveGeo>& adsgeo) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortAuxDetSensitive(adsgeo); }
+    virtual void SortCryostats
+      (std::vector<::geo::CryostatGeo>& cgeo) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortCryostats(cgeo); }
+    virtual void SortTPCs(std::vector<::geo::TPCGeo>& tgeo) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortTPCs(tgeo); }
+    virtual void SortPlanes(
+      std::vector<::geo::PlaneGeo>& pgeo, ::geo::DriftDirection_t driftDir
+      ) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortPlanes(pgeo, driftDir); }
+    virtual void SortWires(std::vector<::geo::WireGeo>& wgeo) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortWires(wgeo); }
+    virtual void SortOpDets(std::vector<::geo::OpDetGeo>& opdet) const override
+      { PhaseTimer timer { fPhase }; fSorter.SortOpDets(opdet); }
+    
+  }; // TimedGeoObjectSorter
+  
+  
+  /// ICARUS channel mapping recording its sorting and initialization times.
+  class ProfiledICARUSChannelMapAlg: public icarus::ICARUSChannelMapAlg {
+    
+    TimedGeoObjectSorter fTimedSorter; ///< Sorter wrapper.
+    GeometryLoadProfile::Phase_t& fInitPhase; ///< Initialization record.
+    
+      public:
+    ProfiledICARUSChannelMapAlg(
+      Config const& config,
+      GeometryLoadProfile::Phase_t& sortPhase,
+      GeometryLoadProfile::Phase_t& initPhase
+      )
+      : icarus::ICARUSChannelMapAlg(config)
+      , fTimedSorter(icarus::ICARUSChannelMapAlg::Sorter(), sortPhase)
+      , fInitPhase(initPhase)
+      {}
+    
+    virtual void Initialize(::geo::GeometryData_t const& geodata) override
+      {
+        PhaseTimer timer { fInitPhase };
+        icarus::ICARUSChannelMapAlg::Initialize(geodata);
+      }
+    
+    virtual ::geo::GeoObjectSorter const& Sorter() const override
+      { return fTimedSorter; }
+    
+  }; // ProfiledICARUSChannelMapAlg
+  
+  
+  /// Implementation of `icarus::geo::LoadStandardICARUSgeometry()`;
+  /// `profile` may be `nullptr` if no instrumentation is desired;
+  /// if `mapping` is not `nullptr`, it is set to the channel mapping object.
+  std::unique_ptr<::geo::GeometryCore> LoadStandardICARUSgeometryImpl(
+    std::string const& configPath, GeometryLoadOptions const& options,
+    GeometryLoadProfile* profile,
+    icarus::ICARUSChannelMapAlg const** mapping = nullptr
+    );
+  
+} // namespace icarus::geo::details
+
+
 // -----------------------------------------------------------------------------
 // ---  inline implementation
 // -----------------------------------------------------------------------------
@@ -87,6 +344,151 @@ inline std::unique_ptr<::geo::GeometryCore>
 icarus::geo::LoadStandardICARUSgeometry [[nodiscard]]
   (std::string const& configPath)
 {
+  return details::LoadStandardICARUSgeometryImpl
+    (configPath, GeometryLoadOptions{}, nullptr);
+} // icarus::geo::LoadStandardICARUSgeometry()
+
+
+/**
+ * @brief Returns an instance of `geo::GeometryCore` with ICARUS geometry loaded
+ * @param configPath path to a FHiCL configuration file including geometry
+ * @param[out] profile record of the time spent in each phase of the loading
+ * @return a unique pointer with `geo::GeometryCore` object
+ * @see `LoadStandardICARUSgeometry(std::string const&)`
+ * 
+ * This is the same as `LoadStandardICARUSgeometry(std::string const&)`, but it
+ * also records the wall time and memory usage of each of its phases into
+ * `profile` (which is cleared first); see `GeometryLoadProfile` for the list
+ * of phases. The same information is also printed into the `INFO` stream
+ * `"LoadStandardICARUSgeometry"` of the message facility.
+ * 
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::geo::GeometryLoadProfile profile;
+ * std::unique_ptr<geo::GeometryCore> geom
+ *   = icarus::geo::LoadStandardICARUSgeometry("standard_g4_icarus.fcl", profile);
+ * std::cout << profile.phase("sorting")->wallTime << " s for sorting" << std::endl;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+inline std::unique_ptr<::geo::GeometryCore>
+icarus::geo::LoadStandardICARUSgeometry [[nodiscard]]
+  (std::string const& configPath, GeometryLoadProfile& profile)
+{
+  return LoadStandardICARUSgeometry
+    (configPath, GeometryLoadOptions{}, profile);
+} // icarus::geo::LoadStandardICARUSgeometry(GeometryLoadProfile)
+
+
+/**
+ * @brief Returns an instance of `geo::GeometryCore` with ICARUS geometry loaded
+ * @param configPath path to a FHiCL configuration file including geometry
+ * @param options restrictions of the loading to part of the detector
+ * @return a unique pointer with `geo::GeometryCore` object
+ * @see `LoadStandardICARUSgeometry(std::string const&)`
+ * 
+ * This is the same as `LoadStandardICARUSgeometry(std::string const&)`, but
+ * the channel mapping configuration is restricted according to `options`
+ * (see `GeometryLoadOptions`).
+ */
+inline std::unique_ptr<::geo::GeometryCore>
+icarus::geo::LoadStandardICARUSgeometry [[nodiscard]]
+  (std::string const& configPath, GeometryLoadOptions const& options)
+{
+  return details::LoadStandardICARUSgeometryImpl(configPath, options, nullptr);
+} // icarus::geo::LoadStandardICARUSgeometry(GeometryLoadOptions)
+
+
+/**
+ * @brief Returns an instance of `geo::GeometryCore` with ICARUS geometry loaded
+ * @param configPath path to a FHiCL configuration file including geometry
+ * @param options restrictions of the loading to part of the detector
+ * @param[out] profile record of the time spent in each phase of the loading
+ * @return a unique pointer with `geo::GeometryCore` object
+ * @see `LoadStandardICARUSgeometry(std::string const&, GeometryLoadProfile&)`
+ * 
+ * This is the same as
+ * `LoadStandardICARUSgeometry(std::string const&, GeometryLoadProfile&)`, but
+ * the channel mapping configuration is restricted according to `options`
+ * (see `GeometryLoadOptions`).
+ */
+inline std::unique_ptr<::geo::GeometryCore>
+icarus::geo::LoadStandardICARUSgeometry [[nodiscard]] (
+  std::string const& configPath, GeometryLoadOptions const& options,
+  GeometryLoadProfile& profile
+) {
+  profile = GeometryLoadProfile{};
+  auto geom
+    = details::LoadStandardICARUSgeometryImpl(configPath, options, &profile);
+  profile.finalMemory = details::residentMemoryKiB();
+  profile.dump(mf::LogInfo{ "LoadStandardICARUSgeometry" });
+  return geom;
+} // icarus::geo::LoadStandardICARUSgeometry(GeometryLoadOptions, ...)
+
+
+/**
+ * @brief Returns the flat tables of ICARUS geometry, releasing the rest.
+ * @param configPath path to a FHiCL configuration file including geometry
+ * @return the tables of the geometry (`icarus::CompactGeometry`)
+ * @see `LoadStandardICARUSgeometry(std::string const&)`
+ * 
+ * The geometry is loaded as in
+ * `LoadStandardICARUSgeometry(std::string const&)`, and the tables of
+ * `icarus::CompactGeometry` are extracted from it. Then the geometry is
+ * destroyed, and the ROOT geometry description with it
+ * (`icarus::CompactGeometry::releaseROOTgeometry()`): no other geometry
+ * object may be in use in the program at the time of this call, nor after it.
+ * 
+ * This is meant for jobs which, after initialization, need only the channel
+ * mapping and the position of wires and PMT, and which would otherwise keep
+ * in memory the full geometry for their whole duration.
+ * 
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::CompactGeometry const geom
+ *   = icarus::geo::LoadCompactICARUSgeometry("standard_g4_icarus.fcl");
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+inline icarus::CompactGeometry
+icarus::geo::LoadCompactICARUSgeometry [[nodiscard]]
+  (std::string const& configPath)
+{
+  return LoadCompactICARUSgeometry(configPath, GeometryLoadOptions{});
+} // icarus::geo::LoadCompactICARUSgeometry()
+
+
+/**
+ * @brief Returns the flat tables of ICARUS geometry, releasing the rest.
+ * @param configPath path to a FHiCL configuration file including geometry
+ * @param options restrictions of the loading to part of the detector
+ * @return the tables of the geometry (`icarus::CompactGeometry`)
+ * @see `LoadCompactICARUSgeometry(std::string const&)`
+ * 
+ * This is the same as `LoadCompactICARUSgeometry(std::string const&)`, but
+ * the channel mapping configuration is restricted according to `options`
+ * (see `GeometryLoadOptions`).
+ */
+inline icarus::CompactGeometry
+icarus::geo::LoadCompactICARUSgeometry [[nodiscard]]
+  (std::string const& configPath, GeometryLoadOptions const& options)
+{
+  icarus::CompactGeometry compact;
+  {
+    icarus::ICARUSChannelMapAlg const* channelMap = nullptr;
+    std::unique_ptr<::geo::GeometryCore> geom
+      = details::LoadStandardICARUSgeometryImpl
+        (configPath, options, nullptr, &channelMap);
+    compact = icarus::CompactGeometry{ *geom, *channelMap };
+  } // geometry (and its channel mapping) destroyed here
+  icarus::CompactGeometry::releaseROOTgeometry();
+  return compact;
+} // icarus::geo::LoadCompactICARUSgeometry(GeometryLoadOptions)
+
+
+// -----------------------------------------------------------------------------
+inline std::unique_ptr<::geo::GeometryCore>
+icarus::geo::details::LoadStandardICARUSgeometryImpl(
+  std::string const& configPath, GeometryLoadOptions const& options,
+  GeometryLoadProfile* profile,
+  icarus::ICARUSChannelMapAlg const** mapping /* = nullptr */
+) {
   /*
    * 1. load the FHiCL configuration
    * 2. configuration check
@@ -100,11 +502,22 @@ icarus::geo::LoadStandardICARUSgeometry [[nodiscard]]
   static std::string const MagicToolName
     { "ICARUSsplitInductionChannelMapSetupTool"s };
   
+  // this is where profiling goes when not requested;
+  // phase references are kept around, so their storage must not be reallocated
+  GeometryLoadProfile::Phase_t dummyPhase;
+  if (profile) profile->phases.reserve(GeometryLoadProfile::MaxPhases);
+  auto phase = [profile,&dummyPhase](std::string name)
+    -> GeometryLoadProfile::Phase_t&
+    {
+      return profile? profile->addPhase(std::move(name)): (dummyPhase = {});
+    };
+  
   //
   // 1. load the FHiCL configuration
   //
   fhicl::ParameterSet config;
   {
+    PhaseTimer timer { phase("configuration") };
     std::unique_ptr<cet::filepath_maker> const policy
       { cet::lookup_policy_selector{}.select("permissive", "FHICL_FILE_PATH") };
     fhicl::make_ParameterSet(configPath, *policy, config);
@@ -129,7 +542,7 @@ icarus::geo::LoadStandardICARUSgeometry [[nodiscard]]
     geomConfigPath = path;
     break;
   }
-  fhicl::ParameterSet const geomConfig = geomConfigPath.empty()
+  fhicl::ParameterSet geomConfig = geomConfigPath.empty()
     ? config: config.get<fhicl::ParameterSet>(geomConfigPath);
   
   if (!geomConfig.is_key_to_table("ChannelMapping")) {
@@ -155,19 +568,87 @@ icarus::geo::LoadStandardICARUSgeometry [[nodiscard]]
       );
   }
   
+  // restrictions from the options
+  if (!options.TPCmapping) {
+    auto channelMapConfig
+      = geomConfig.get<fhicl::ParameterSet>("ChannelMapping");
+    channelMapConfig.put_or_replace("TPCmapping", false);
+    geomConfig.put_or_replace("ChannelMapping", channelMapConfig);
+  } // if options
+  
   //
   // 3. load the standard geometry
   //
   
   // set up message facility (we can live without, output would go to std::cerr)
-  if (!mfConfigPath.empty())
+  if (!mfConfigPath.empty()) {
+    PhaseTimer timer { phase("message facility") };
     mf::StartMessageFacility(config.get<fhicl::ParameterSet>(mfConfigPath));
+  }
   
   
   // 4. return the geometry object
-  return SetupICARUSGeometry<icarus::ICARUSChannelMapAlg>(geomConfig);
+  if (!profile && !mapping)
+    return SetupICARUSGeometry<icarus::ICARUSChannelMapAlg>(geomConfig);
+  if (!profile) {
+    // same as `SetupICARUSGeometry()`, keeping track of the channel mapping
+    auto channelMap = std::make_unique<icarus::ICARUSChannelMapAlg>(
+      ConfigObjectMaker<icarus::ICARUSChannelMapAlg>::make
+        (geomConfig.get<fhicl::ParameterSet>("ChannelMapping"))
+      );
+    *mapping = channelMap.get();
+    return lar::standalone::SetupGeometryWithChannelMapping
+      (geomConfig, std::move(channelMap));
+  }
   
-} // icarus::geo::LoadStandardICARUSgeometry()
+  /*
+   * When profiling, we follow step by step what
+   * `lar::standalone::SetupGeometryWithChannelMapping()` does,
+   * with the channel mapping instrumented to record sorting and initialization.
+   */
+  std::unique_ptr<::geo::GeometryCore> geom;
+  {
+    PhaseTimer timer { phase("geometry description") };
+    
+    geom = std::make_unique<::geo::GeometryCore>(geomConfig);
+    
+    std::string const relPath = geomConfig.get("RelativePath", ""s);
+    std::string const GDMLFileName
+      = relPath + geomConfig.get<std::string>("GDML");
+    std::string const ROOTFileName
+      = relPath + geomConfig.get<std::string>("ROOT");
+    
+    cet::search_path const sp { "FW_SEARCH_PATH" };
+    std::string ROOTfile;
+    if (!sp.find_file(ROOTFileName, ROOTfile)) ROOTfile = ROOTFileName;
+    std::string GDMLfile;
+    if (!sp.find_file(GDMLFileName, GDMLfile)) GDMLfile = GDMLFileName;
+    
+    geom->LoadGeometryFile(GDMLfile, ROOTfile);
+  }
+  
+  GeometryLoadProfile::Phase_t& sortPhase = phase("sorting");
+  GeometryLoadProfile::Phase_t& initPhase = phase("channel mapping");
+  GeometryLoadProfile::Phase_t& updatePhase = phase("geometry update");
+  {
+    auto const& channelMapConfig
+      = ConfigObjectMaker<icarus::ICARUSChannelMapAlg>::make
+        (geomConfig.get<fhicl::ParameterSet>("ChannelMapping"));
+    
+    auto channelMap = std::make_unique<ProfiledICARUSChannelMapAlg>
+      (channelMapConfig, sortPhase, initPhase);
+    if (mapping) *mapping = channelMap.get();
+    
+    PhaseTimer timer { updatePhase };
+    geom->ApplyChannelMap(std::move(channelMap));
+  }
+  // the update phase includes the other two: remove them
+  updatePhase.wallTime -= sortPhase.wallTime + initPhase.wallTime;
+  updatePhase.memoryDelta -= sortPhase.memoryDelta + initPhase.memoryDelta;
+  
+  return geom;
+  
+} // icarus::geo::details::LoadStandardICARUSgeometryImpl()
 
 
 #endif // ICARUSALG_GEOMETRY_LOADSTANDARDICARUSGEOMETRY_H
@@ -0,0 +1,300 @@
+/**
+ * @file   icarusalg/Geometry/PMTspatialIndex.cxx
+ * @brief  Spatial index of the optical detectors (PMT).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/PMTspatialIndex.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/PMTspatialIndex.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::nth_element(), std::sort(), std::min(), ...
+#include <numeric> // std::iota()
+#include <type_traits> // std::decay_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+icarus::PMTspatialIndex::PMTspatialIndex(geo::GeometryCore const& geom) {
+
+  // optical detectors are numbered cryostat after cryostat
+  std::vector<geo::Point_t> centers;
+  std::vector<unsigned int> cryostats;
+  centers.reserve(geom.NOpDets());
+  cryostats.reserve(geom.NOpDets());
+  for (geo::CryostatGeo const& cryo: geom.IterateCryostats()) {
+    for (unsigned int iOpDet = 0U; iOpDet < cryo.NOpDet(); ++iOpDet) {
+      centers.push_back(cryo.OpDet(iOpDet).GetCenter());
+      cryostats.push_back(cryo.ID().Cryostat);
+    }
+  } // for cryostats
+
+  build(centers, cryostats);
+
+} // icarus::PMTspatialIndex::PMTspatialIndex(GeometryCore)
+
+
+// -----------------------------------------------------------------------------
+icarus::PMTspatialIndex::PMTspatialIndex
+  (icarus::details::PMTgeometryTable const& table)
+{
+  std::vector<geo::Point_t> centers;
+  std::vector<unsigned int> cryostats;
+  centers.reserve(table.nPMTs());
+  cryostats.reserve(table.nPMTs());
+  for (OpDet_t channel = 0U; channel < table.nPMTs(); ++channel) {
+    centers.push_back(table.center(channel));
+    cryostats.push_back(table.cryostat(channel));
+  }
+
+  build(centers, cryostats);
+
+} // icarus::PMTspatialIndex::PMTspatialIndex(PMTgeometryTable)
+
+
+// -----------------------------------------------------------------------------
+auto icarus::PMTspatialIndex::nearest(geo::Point_t const& point) const
+  -> OpDet_t
+{
+  double const p[3] { point.X(), point.Y(), point.Z() };
+  OpDet_t best = NoOpDet;
+  double bestDist2 = std::numeric_limits<double>::max();
+  for (NodeRange_t const& range: fCryostatRanges)
+    searchNearest(range, p, best, bestDist2);
+  return best;
+} // icarus::PMTspatialIndex::nearest()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::PMTspatialIndex::nearestInCryostat
+  (geo::Point_t const& point, unsigned int cryostat) const -> OpDet_t
+{
+  if (cryostat >= nCryostats()) return NoOpDet;
+  double const p[3] { point.X(), point.Y(), point.Z() };
+  OpDet_t best = NoOpDet;
+  double bestDist2 = std::numeric_limits<double>::max();
+  searchNearest(fCryostatRanges[cryostat], p, best, bestDist2);
+  return best;
+} // icarus::PMTspatialIndex::nearestInCryostat()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::PMTspatialIndex::withinRadius
+  (geo::Point_t const& point, double radius, std::vector<OpDet_t>& opDets)
+  const
+{
+  opDets.clear();
+  if (radius < 0.0) return 0U;
+  double const p[3] { point.X(), point.Y(), point.Z() };
+  for (NodeRange_t const& range: fCryostatRanges)
+    searchRadius(range, p, radius * radius, opDets);
+  std::sort(opDets.begin(), opDets.end());
+  return opDets.size();
+} // icarus::PMTspatialIndex::withinRadius()
+
+
+// -----------------------------------------------------------------------------
+void icarus::PMTspatialIndex::nearest
+  (std::size_t n, geo::Point_t const* points, OpDet_t* opDets) const
+{
+  for (std::size_t i = 0; i < n; ++i) opDets[i] = nearest(points[i]);
+} // icarus::PMTspatialIndex::nearest(batch)
+
+
+// -----------------------------------------------------------------------------
+void icarus::PMTspatialIndex::nearestInCryostat(
+  std::size_t n, geo::Point_t const* points, unsigned int const* cryostats,
+  OpDet_t* opDets
+) const {
+  for (std::size_t i = 0; i < n; ++i)
+    opDets[i] = nearestInCryostat(points[i], cryostats[i]);
+} // icarus::PMTspatialIndex::nearestInCryostat(batch)
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::PMTspatialIndex::withinRadius(
+  std::size_t n, geo::Point_t const* points, double radius,
+  std::vector<std::size_t>& offsets, std::vector<OpDet_t>& opDets
+) const {
+
+  offsets.assign(1U, 0U);
+  offsets.reserve(n + 1U);
+  opDets.clear();
+  if (radius < 0.0) {
+    offsets.resize(n + 1U, 0U);
+    return 0U;
+  }
+
+  double const radius2 = radius * radius;
+  for (std::size_t i = 0; i < n; ++i) {
+    double const p[3] { points[i].X(), points[i].Y(), points[i].Z() };
+    std::size_t const first = opDets.size();
+    for (NodeRange_t const& range: fCryostatRanges)
+      searchRadius(range, p, radius2, opDets);
+    std::sort(opDets.begin() + first, opDets.end());
+    offsets.push_back(opDets.size());
+  } // for points
+
+  return opDets.size();
+} // icarus::PMTspatialIndex::withinRadius(batch)
+
+
+// -----------------------------------------------------------------------------
+void icarus::PMTspatialIndex::build(
+  std::vector<geo::Point_t> const& centers,
+  std::vector<unsigned int> const& cryostats
+) {
+  /*
+   * Nodes are sorted by cryostat (and, within it, by detector number), then
+   * the nodes of each cryostat are arranged in their own tree.
+   */
+  assert(centers.size() == cryostats.size());
+
+  std::vector<OpDet_t> order(centers.size());
+  std::iota(order.begin(), order.end(), OpDet_t{ 0U });
+  std::stable_sort(order.begin(), order.end(),
+    [&cryostats](OpDet_t a, OpDet_t b){ return cryostats[a] < cryostats[b]; });
+
+  fX.clear();
+  fY.clear();
+  fZ.clear();
+  fOpDet = order;
+  for (OpDet_t const opDet: order) {
+    fX.push_back(centers[opDet].X());
+    fY.push_back(centers[opDet].Y());
+    fZ.push_back(centers[opDet].Z());
+  }
+  fAxis.assign(order.size(), 0U);
+
+  fCryostatRanges.clear();
+  unsigned int const nCryostats = cryostats.empty()
+    ? 0U: (*std::max_element(cryostats.begin(), cryostats.end()) + 1U);
+  fCryostatRanges.resize(nCryostats, { 0U, 0U });
+  for (std::size_t begin = 0U; begin < order.size(); ) {
+    unsigned int const cryostat = cryostats[order[begin]];
+    std::size_t end = begin;
+    while ((end < order.size()) && (cryostats[order[end]] == cryostat)) ++end;
+    fCryostatRanges[cryostat] = { begin, end };
+    buildTree(fCryostatRanges[cryostat]);
+    begin = end;
+  } // for cryostats
+
+} // icarus::PMTspatialIndex::build()
+
+
+// -----------------------------------------------------------------------------
+void icarus::PMTspatialIndex::buildTree(NodeRange_t range) {
+
+  /*
+   * The median node along the axis with the largest spread goes in the middle
+   * of the range, and the two halves are the subtrees.
+   */
+  std::size_t const begin = range.first, end = range.second;
+  if (end - begin <= 1U) return;
+
+  unsigned int axis = 0U;
+  double maxSpread = -1.0;
+  for (unsigned int a = 0U; a < 3U; ++a) {
+    double min = coord(begin, a), max = min;
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      min = std::min(min, coord(i, a));
+      max = std::max(max, coord(i, a));
+    }
+    if (max - min <= maxSpread) continue;
+    maxSpread = max - min;
+    axis = a;
+  } // for axes
+
+  // sort a list of node indices, then move the nodes accordingly
+  std::vector<std::size_t> nodes(end - begin);
+  std::iota(nodes.begin(), nodes.end(), begin);
+  std::size_t const middle = (end - begin) / 2U;
+  std::nth_element(nodes.begin(), nodes.begin() + middle, nodes.end(),
+    [this,axis](std::size_t a, std::size_t b)
+      { return coord(a, axis) < coord(b, axis); }
+    );
+
+  auto reorder = [&nodes,begin](auto& v)
+    {
+      std::vector<std::decay_t<decltype(v[0])>> moved;
+      moved.reserve(nodes.size());
+      for (std::size_t const i: nodes) moved.push_back(v[i]);
+      std::copy(moved.begin(), moved.end(), v.begin() + begin);
+    };
+  reorder(fX);
+  reorder(fY);
+  reorder(fZ);
+  reorder(fOpDet);
+
+  std::size_t const mid = begin + middle;
+  fAxis[mid] = axis;
+  buildTree({ begin, mid });
+  buildTree({ mid + 1, end });
+
+} // icarus::PMTspatialIndex::buildTree()
+
+
+// -----------------------------------------------------------------------------
+void icarus::PMTspatialIndex::searchNearest(
+  NodeRange_t range, double const* point,
+  OpDet_t& best, double& bestDist2
+) const {
+
+  auto const [ begin, end ] = range;
+  if (begin >= end) return;
+
+  std::size_t const mid = begin + (end - begin) / 2U;
+  double const dx = fX[mid] - point[0];
+  double const dy = fY[mid] - point[1];
+  double const dz = fZ[mid] - point[2];
+  double const dist2 = dx*dx + dy*dy + dz*dz;
+  if ((dist2 < bestDist2) || ((dist2 == bestDist2) && (fOpDet[mid] < best))) {
+    bestDist2 = dist2;
+    best = fOpDet[mid];
+  }
+
+  // the near side first; the far side only if it may hold a closer detector
+  // (or one as close, with lower number)
+  unsigned int const axis = fAxis[mid];
+  double const diff = point[axis] - coord(mid, axis);
+  NodeRange_t const lower { begin, mid }, upper { mid + 1, end };
+  searchNearest((diff < 0.0)? lower: upper, point, best, bestDist2);
+  if (diff * diff <= bestDist2)
+    searchNearest((diff < 0.0)? upper: lower, point, best, bestDist2);
+
+} // icarus::PMTspatialIndex::searchNearest()
+
+
+// -----------------------------------------------------------------------------
+void icarus::PMTspatialIndex::searchRadius(
+  NodeRange_t range, double const* point, double radius2,
+  std::vector<OpDet_t>& opDets
+) const {
+
+  auto const [ begin, end ] = range;
+  if (begin >= end) return;
+
+  std::size_t const mid = begin + (end - begin) / 2U;
+  double const dx = fX[mid] - point[0];
+  double const dy = fY[mid] - point[1];
+  double const dz = fZ[mid] - point[2];
+  if (dx*dx + dy*dy + dz*dz <= radius2) opDets.push_back(fOpDet[mid]);
+
+  unsigned int const axis = fAxis[mid];
+  double const diff = point[axis] - coord(mid, axis);
+  if ((diff <= 0.0) || (diff * diff <= radius2))
+    searchRadius({ begin, mid }, point, radius2, opDets);
+  if ((diff >= 0.0) || (diff * diff <= radius2))
+    searchRadius({ mid + 1, end }, point, radius2, opDets);
+
+} // icarus::PMTspatialIndex::searchRadius()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+/**
+ * @file   icarusalg/Geometry/PMTspatialIndex.h
+ * @brief  Spatial index of the optical detectors (PMT).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/PMTspatialIndex.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_PMTSPATIALINDEX_H
+#define ICARUSALG_GEOMETRY_PMTSPATIALINDEX_H
+
+
+// ICARUS libraries
+#include "icarusalg/Geometry/details/PMTgeometryTable.h"
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <limits>
+#include <cstdint> // std::uint8_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace geo { class GeometryCore; }
+namespace icarus { class PMTspatialIndex; }
+
+/**
+ * @brief Index to find the optical detectors closest to a point.
+ *
+ * LArSoft `geo::GeometryCore::GetClosestOpDet()` finds the optical detector
+ * closest to a point by computing the distance of all the optical detectors
+ * in the cryostat containing it. This object arranges the centers of the
+ * optical detectors of each cryostat in a _k_-d tree, so that the closest
+ * detector and all the detectors within a distance from a point are found
+ * testing only a few of them.
+ *
+ * Optical detectors are identified by their number, which follows the sorting
+ * of the geometry (`icarus::PMTsorterStandard`) and, in ICARUS, is also their
+ * channel. Distances are measured from the center of the detectors, as in
+ * LArSoft. When more detectors are at the same distance, the one with the
+ * lowest number is chosen, as LArSoft does.
+ *
+ * Each query comes in a version working on a single point and in a batch
+ * version working on many points at once.
+ * The queries on the detectors of a single cryostat (`nearestInCryostat()`)
+ * reproduce `geo::GeometryCore::GetClosestOpDet()` when given the cryostat
+ * containing the point.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::PMTspatialIndex const PMTindex { geom };
+ *
+ * std::vector<icarus::PMTspatialIndex::OpDet_t> closeOpDets;
+ * PMTindex.withinRadius(point, 100.0, closeOpDets);
+ * for (icarus::PMTspatialIndex::OpDet_t const opDet: closeOpDets) {
+ *   geo::OpDetGeo const& PMT = geom.OpDetGeoFromOpDet(opDet);
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::PMTspatialIndex {
+
+    public:
+
+  /// Type of optical detector number.
+  using OpDet_t = unsigned int;
+
+  /// Value of optical detector number for "no detector".
+  static constexpr OpDet_t NoOpDet = std::numeric_limits<OpDet_t>::max();
+
+
+  /// Builds the index of all optical detectors in `geom`.
+  explicit PMTspatialIndex(geo::GeometryCore const& geom);
+
+  /// Builds the index of all optical detectors in the PMT `table`.
+  explicit PMTspatialIndex(icarus::details::PMTgeometryTable const& table);
+
+
+  // --- BEGIN -- Single point queries -----------------------------------------
+  /// @name Single point queries
+  /// @{
+
+  /// Returns the optical detector closest to `point` (`NoOpDet` if none).
+  OpDet_t nearest(geo::Point_t const& point) const;
+
+  /// Returns the optical detector in `cryostat` closest to `point`
+  /// (`NoOpDet` if none).
+  OpDet_t nearestInCryostat
+    (geo::Point_t const& point, unsigned int cryostat) const;
+
+  /**
+   * @brief Finds all optical detectors within `radius` from `point`.
+   * @param point the reference point
+   * @param radius the largest distance from `point` [cm]
+   * @param[out] opDets the detectors found, in increasing number
+   * @return the number of detectors found
+   *
+   * The content of `opDets` is replaced; reusing the same vector for many
+   * queries avoids memory allocations.
+   */
+  std::size_t withinRadius
+    (geo::Point_t const& point, double radius, std::vector<OpDet_t>& opDets)
+    const;
+
+  /// @}
+  // --- END ---- Single point queries -----------------------------------------
+
+
+  // --- BEGIN -- Batch queries ------------------------------------------------
+  /// @name Batch queries
+  /// @{
+
+  /// Stores into `opDets` the detector closest to each of the `n` `points`.
+  void nearest
+    (std::size_t n, geo::Point_t const* points, OpDet_t* opDets) const;
+
+  /// Stores into `opDets` the detector closest to each of the `n` `points`,
+  /// among the ones in the cryostat specified for it in `cryostats`.
+  void nearestInCryostat(
+    std::size_t n, geo::Point_t const* points, unsigned int const* cryostats,
+    OpDet_t* opDets
+    ) const;
+
+  /**
+   * @brief Finds all optical detectors within `radius` from each point.
+   * @param n the number of points
+   * @param points the reference points
+   * @param radius the largest distance from each point [cm]
+   * @param[out] offsets where the detectors of each point start in `opDets`
+   * @param[out] opDets the detectors found, point by point
+   * @return the total number of detectors found
+   *
+   * The detectors of point `i` are the ones from `opDets[offsets[i]]` to
+   * `opDets[offsets[i + 1]]` (excluded), in increasing number; `offsets` has
+   * `n + 1` elements. The content of both vectors is replaced.
+   */
+  std::size_t withinRadius(
+    std::size_t n, geo::Point_t const* points, double radius,
+    std::vector<std::size_t>& offsets, std::vector<OpDet_t>& opDets
+    ) const;
+
+  /// @}
+  // --- END ---- Batch queries ------------------------------------------------
+
+
+  /// Returns the number of indexed optical detectors.
+  std::size_t nOpDets() const { return fOpDet.size(); }
+
+  /// Returns the number of cryostats with indexed optical detectors.
+  unsigned int nCryostats() const { return fCryostatRanges.size(); }
+
+
+    private:
+
+  /// Range of nodes (first included, second excluded).
+  using NodeRange_t = std::pair<std::size_t, std::size_t>;
+
+  /// Coordinates of the detector at each tree node.
+  std::vector<double> fX, fY, fZ;
+
+  std::vector<OpDet_t> fOpDet; ///< Detector at each tree node.
+
+  std::vector<std::uint8_t> fAxis; ///< Split axis of each tree node.
+
+  /// Nodes of the tree of each cryostat.
+  std::vector<NodeRange_t> fCryostatRanges;
+
+
+  /// Builds the trees from the `centers` and cryostat of each detector.
+  void build(
+    std::vector<geo::Point_t> const& centers,
+    std::vector<unsigned int> const& cryostats
+    );
+
+  /// Arranges nodes in `range` as a (sub)tree, recursively.
+  void buildTree(NodeRange_t range);
+
+  /// Returns the coordinate `axis` of the node `i`.
+  double coord(std::size_t i, unsigned int axis) const
+    { return (axis == 0U)? fX[i]: ((axis == 1U)? fY[i]: fZ[i]); }
+
+  /// Looks for a node closer than `bestDist2` in the (sub)tree `range`.
+  void searchNearest(
+    NodeRange_t range, double const* point,
+    OpDet_t& best, double& bestDist2
+    ) const;
+
+  /// Adds to `opDets` the detectors of (sub)tree `range` within the distance.
+  void searchRadius(
+    NodeRange_t range, double const* point, double radius2,
+    std::vector<OpDet_t>& opDets
+    ) const;
+
+}; // icarus::PMTspatialIndex
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_PMTSPATIALINDEX_H
@@ -0,0 +1,189 @@
+/**
+ * @file icarusalg/Geometry/SharedICARUSgeometry.h
+ * @brief Process-wide registry of shared, immutable ICARUS geometry instances.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ *
+ * Provides `icarus::geo::SharedGeometryRegistry` and the shortcut
+ * `icarus::geo::SharedICARUSgeometry()`.
+ *
+ * This library is header-only, like `LoadStandardICARUSgeometry.h`, and it
+ * has the same linking requirements.
+ *
+ */
+
+#ifndef ICARUSALG_GEOMETRY_SHAREDICARUSGEOMETRY_H
+#define ICARUSALG_GEOMETRY_SHAREDICARUSGEOMETRY_H
+
+
+// ICARUS libraries
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+#include "icarusalg/Geometry/ICARUSstandaloneGeometrySetup.h"
+#include "icarusalg/Geometry/ICARUSChannelMapAlg.h"
+
+// LArSoft and framework libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ libraries
+#include <map>
+#include <memory> // std::shared_ptr, std::weak_ptr
+#include <mutex>
+#include <string>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::geo { class SharedGeometryRegistry; }
+
+/**
+ * @brief Registry of ICARUS geometry instances shared within the process.
+ *
+ * A full `geo::GeometryCore` with its ICARUS channel mapping takes a sizable
+ * amount of memory and time to build. When several consumers in the same
+ * process (analysis threads, embedded interpreters...) need the same geometry,
+ * this registry builds it once and hands out shared pointers to a constant
+ * instance.
+ *
+ * Geometries are keyed by their configuration:
+ * * the geometry service configuration (parameter set ID) when the
+ *   configuration is provided as a parameter set (`get()`);
+ * * the path of the configuration file when created from a file, like in
+ *   `icarus::geo::LoadStandardICARUSgeometry()` (`getFromFile()`).
+ *
+ * The registry holds only weak references: a geometry is destroyed when its
+ * last user releases it, and it is rebuilt on the next request.
+ * All member functions are thread-safe. The construction of a geometry happens
+ * under a lock, so that concurrent requests for the same configuration wait
+ * for it to be built once, rather than each building their own.
+ *
+ * The geometry objects are returned as constant: `geo::GeometryCore` constant
+ * interface does not modify the object and it is safe to use concurrently.
+ *
+ * @note ROOT geometry manager (`gGeoManager`) is global: loading two different
+ *       geometry descriptions in the same process is not supported by ROOT,
+ *       and neither it is by this registry.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * // in each thread:
+ * std::shared_ptr<geo::GeometryCore const> geom
+ *   = icarus::geo::SharedICARUSgeometry("standard_g4_icarus.fcl");
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::geo::SharedGeometryRegistry {
+
+    public:
+
+  /// Type of pointer to the shared geometry.
+  using GeometryPtr_t = std::shared_ptr<::geo::GeometryCore const>;
+
+
+  /// Returns the registry of this process.
+  static SharedGeometryRegistry& instance()
+    { static SharedGeometryRegistry registry; return registry; }
+
+
+  /**
+   * @brief Returns the geometry for the specified service configuration.
+   * @param geomConfig configuration of geometry service provider
+   * @return a shared pointer to the geometry
+   * @see `icarus::geo::SetupICARUSGeometry()`
+   *
+   * The configuration follows the ICARUS conventions, and it must include
+   * a `ChannelMapping` table.
+   */
+  GeometryPtr_t get(fhicl::ParameterSet const& geomConfig)
+    {
+      return obtain("pset:" + geomConfig.id().to_string(), [&geomConfig]()
+        {
+          return
+            SetupICARUSGeometry<icarus::ICARUSChannelMapAlg>(geomConfig);
+        });
+    }
+
+
+  /**
+   * @brief Returns the geometry for the specified configuration file.
+   * @param configPath path to a FHiCL configuration file including geometry
+   * @return a shared pointer to the geometry
+   * @see `icarus::geo::LoadStandardICARUSgeometry()`
+   */
+  GeometryPtr_t getFromFile(std::string const& configPath)
+    {
+      return obtain("file:" + configPath, [&configPath]()
+        { return LoadStandardICARUSgeometry(configPath); }
+        );
+    }
+
+
+  /// Returns the number of geometries currently alive in the registry.
+  std::size_t size() const
+    {
+      std::lock_guard const lock { fMutex };
+      std::size_t n = 0U;
+      for (auto const& entry: fGeometries) if (!entry.second.expired()) ++n;
+      return n;
+    }
+
+
+  /// Removes the entries of the geometries which have been destroyed.
+  void purge()
+    {
+      std::lock_guard const lock { fMutex };
+      for (auto it = fGeometries.begin(); it != fGeometries.end();) {
+        if (it->second.expired()) it = fGeometries.erase(it);
+        else ++it;
+      }
+    }
+
+
+    private:
+
+  /// Protects the registry content.
+  mutable std::mutex fMutex;
+
+  /// Geometries by key.
+  std::map<std::string, std::weak_ptr<::geo::GeometryCore const>> fGeometries;
+
+
+  SharedGeometryRegistry() = default;
+
+  /// Returns the geometry with `key`, building it with `make()` if needed.
+  template <typename Make>
+  GeometryPtr_t obtain(std::string const& key, Make make)
+    {
+      std::lock_guard const lock { fMutex };
+      std::weak_ptr<::geo::GeometryCore const>& entry = fGeometries[key];
+      GeometryPtr_t geom = entry.lock();
+      if (!geom) {
+        geom = GeometryPtr_t{ make() };
+        entry = geom;
+      }
+      return geom;
+    }
+
+}; // icarus::geo::SharedGeometryRegistry
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::geo {
+
+  /// Returns the shared geometry from the specified configuration file.
+  /// @see `icarus::geo::SharedGeometryRegistry::getFromFile()`
+  inline SharedGeometryRegistry::GeometryPtr_t SharedICARUSgeometry
+    (std::string const& configPath)
+    { return SharedGeometryRegistry::instance().getFromFile(configPath); }
+
+  /// Returns the shared geometry for the specified service configuration.
+  /// @see `icarus::geo::SharedGeometryRegistry::get()`
+  inline SharedGeometryRegistry::GeometryPtr_t SharedICARUSgeometry
+    (fhicl::ParameterSet const& geomConfig)
+    { return SharedGeometryRegistry::instance().get(geomConfig); }
+
+} // namespace icarus::geo
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_SHAREDICARUSGEOMETRY_H
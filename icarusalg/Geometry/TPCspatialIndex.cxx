@@ -0,0 +1,265 @@
+/**
+ * @file   icarusalg/Geometry/TPCspatialIndex.cxx
+ * @brief  Spatial index to find the TPC and TPC set containing a point.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/TPCspatialIndex.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/TPCspatialIndex.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max(), std::clamp()
+#include <cmath> // std::ceil(), std::floor(), std::nextafter()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Number of cells covering the smallest TPC on each direction.
+  constexpr double CellsPerTPC = 2.0;
+
+  /// Maximum number of cells on each direction.
+  constexpr std::size_t MaxCellsPerAxis = 512U;
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+icarus::TPCspatialIndex::TPCspatialIndex
+  (geo::GeometryCore const& geom, double positionEpsilon /* = 1e-4 */)
+  : fGeom(&geom)
+  , fWiggle(1.0 + positionEpsilon)
+{
+  //
+  // collect the TPC, in geometry order (cryostat by cryostat)
+  //
+  std::vector<Box_t> boxes;
+  for (geo::CryostatGeo const& cryo: geom.IterateCryostats()) {
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) {
+      geo::TPCID const tpcid = tpc.ID();
+      fTPCs.push_back({ tpcid, geom.TPCtoTPCset(tpcid) });
+      boxes.push_back(boundingBox(tpc, fWiggle));
+    } // for TPC
+  } // for cryostats
+
+  //
+  // fill the grid
+  //
+  defineGrid(boxes);
+  fillCells(boxes);
+
+} // icarus::TPCspatialIndex::TPCspatialIndex()
+
+
+// -----------------------------------------------------------------------------
+geo::TPCID icarus::TPCspatialIndex::findTPC(geo::Point_t const& point) const {
+  std::size_t const iTPC = findElement(point);
+  return (iTPC == NoIndex)? geo::TPCID{}: fTPCs[iTPC].ID;
+} // icarus::TPCspatialIndex::findTPC()
+
+
+// -----------------------------------------------------------------------------
+readout::TPCsetID icarus::TPCspatialIndex::findTPCset
+  (geo::Point_t const& point) const
+{
+  std::size_t const iTPC = findElement(point);
+  return (iTPC == NoIndex)? readout::TPCsetID{}: fTPCs[iTPC].TPCset;
+} // icarus::TPCspatialIndex::findTPCset()
+
+
+// -----------------------------------------------------------------------------
+void icarus::TPCspatialIndex::findTPCs
+  (std::size_t n, geo::Point_t const* points, geo::TPCID* TPCs) const
+{
+  for (std::size_t i = 0; i < n; ++i) TPCs[i] = findTPC(points[i]);
+} // icarus::TPCspatialIndex::findTPCs(batch)
+
+
+// -----------------------------------------------------------------------------
+void icarus::TPCspatialIndex::findTPCsets
+  (std::size_t n, geo::Point_t const* points, readout::TPCsetID* TPCsets) const
+{
+  for (std::size_t i = 0; i < n; ++i) TPCsets[i] = findTPCset(points[i]);
+} // icarus::TPCspatialIndex::findTPCsets(batch)
+
+
+// -----------------------------------------------------------------------------
+void icarus::TPCspatialIndex::findTPCsAndTPCsets(
+  std::size_t n, geo::Point_t const* points,
+  geo::TPCID* TPCs, readout::TPCsetID* TPCsets
+) const {
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t const iTPC = findElement(points[i]);
+    if (iTPC == NoIndex) {
+      TPCs[i] = geo::TPCID{};
+      TPCsets[i] = readout::TPCsetID{};
+    }
+    else {
+      TPCs[i] = fTPCs[iTPC].ID;
+      TPCsets[i] = fTPCs[iTPC].TPCset;
+    }
+  } // for
+} // icarus::TPCspatialIndex::findTPCsAndTPCsets(batch)
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::TPCspatialIndex::findElement
+  (geo::Point_t const& point) const
+{
+  /*
+   * LArSoft picks the first cryostat containing the point, and then the first
+   * TPC in that cryostat containing the point. The candidates of the cell are
+   * in geometry order, so the first one in the right cryostat containing the
+   * point is the same as LArSoft's. The cryostat is looked for only when
+   * there is a TPC containing the point.
+   */
+  std::size_t const cell = cellOf(point);
+  if (cell == NoIndex) return NoIndex;
+
+  geo::CryostatID cid; // invalid until looked for
+  auto const begin = fCellTPCs.begin();
+  for (auto it = begin + fCellStart[cell], end = begin + fCellStart[cell + 1];
+    it != end; ++it)
+  {
+    geo::TPCID const& tpcid = fTPCs[*it].ID;
+    if (!fGeom->TPC(tpcid).ContainsPosition(point, fWiggle)) continue;
+    if (!cid.isValid) {
+      cid = findCryostat(point);
+      if (!cid.isValid) return NoIndex;
+    }
+    if (tpcid.Cryostat == cid.Cryostat) return *it;
+  } // for
+  return NoIndex;
+} // icarus::TPCspatialIndex::findElement()
+
+
+// -----------------------------------------------------------------------------
+geo::CryostatID icarus::TPCspatialIndex::findCryostat
+  (geo::Point_t const& point) const
+{
+  for (geo::CryostatGeo const& cryo: fGeom->IterateCryostats())
+    if (cryo.ContainsPosition(point, fWiggle)) return cryo.ID();
+  return {};
+} // icarus::TPCspatialIndex::findCryostat()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::TPCspatialIndex::cellOf(geo::Point_t const& point) const {
+  std::array<double, 3U> const coords { point.X(), point.Y(), point.Z() };
+  std::size_t cell = 0U;
+  for (std::size_t i = 0; i < 3U; ++i) {
+    double const c = std::floor((coords[i] - fGridMin[i]) / fCellSize[i]);
+    if ((c < 0.0) || (c >= fNCells[i])) return NoIndex;
+    cell = cell * fNCells[i] + static_cast<std::size_t>(c);
+  }
+  return cell;
+} // icarus::TPCspatialIndex::cellOf()
+
+
+// -----------------------------------------------------------------------------
+void icarus::TPCspatialIndex::defineGrid(std::vector<Box_t> const& boxes) {
+
+  fGridMin.fill(0.0);
+  fCellSize.fill(1.0);
+  fNCells.fill(1U);
+  if (boxes.empty()) return;
+
+  //
+  // overall box and smallest TPC size on each direction
+  //
+  Box_t total = boxes.front();
+  std::array<double, 3U> smallest;
+  smallest.fill(std::numeric_limits<double>::max());
+  for (Box_t const& box: boxes) {
+    for (std::size_t i = 0; i < 3U; ++i) {
+      total.min[i] = std::min(total.min[i], box.min[i]);
+      total.max[i] = std::max(total.max[i], box.max[i]);
+      smallest[i] = std::min(smallest[i], box.max[i] - box.min[i]);
+    }
+  } // for
+
+  //
+  // TPC are boxes aligned with the axes and tiling the cryostats: cells a
+  // fraction of the smallest TPC on each direction keep the candidates per
+  // cell to one or two while the grid stays small
+  //
+  for (std::size_t i = 0; i < 3U; ++i) {
+    double const size = total.max[i] - total.min[i];
+    fGridMin[i] = total.min[i];
+    if ((size <= 0.0) || (smallest[i] <= 0.0)) continue; // one cell
+    double const side = smallest[i] / CellsPerTPC;
+    fNCells[i] = std::clamp(static_cast<std::size_t>(std::ceil(size / side)),
+                            std::size_t{ 1U }, MaxCellsPerAxis);
+    // make sure the upper edge is always inside the grid
+    fCellSize[i]
+      = std::nextafter(size / fNCells[i], std::numeric_limits<double>::max());
+  } // for
+
+} // icarus::TPCspatialIndex::defineGrid()
+
+
+// -----------------------------------------------------------------------------
+void icarus::TPCspatialIndex::fillCells(std::vector<Box_t> const& boxes) {
+  /*
+   * Compressed lists: first count the TPC in each cell, then place them;
+   * TPC are in geometry order within each cell.
+   */
+  std::size_t const nCells = fNCells[0] * fNCells[1] * fNCells[2];
+
+  // applies `f(cell)` to all the cells overlapping `box`
+  auto forEachCell = [this](Box_t const& box, auto&& f)
+    {
+      std::array<std::size_t, 3U> first, last;
+      for (std::size_t i = 0; i < 3U; ++i) {
+        auto cellCoord = [this,i](double c)
+          {
+            double const n = std::floor((c - fGridMin[i]) / fCellSize[i]);
+            return static_cast<std::size_t>
+              (std::clamp(n, 0.0, static_cast<double>(fNCells[i] - 1)));
+          };
+        first[i] = cellCoord(box.min[i]);
+        last[i] = cellCoord(box.max[i]);
+      } // for
+      for (std::size_t ix = first[0]; ix <= last[0]; ++ix)
+        for (std::size_t iy = first[1]; iy <= last[1]; ++iy)
+          for (std::size_t iz = first[2]; iz <= last[2]; ++iz)
+            f((ix * fNCells[1] + iy) * fNCells[2] + iz);
+    };
+
+  fCellStart.assign(nCells + 1, 0U);
+  for (Box_t const& box: boxes)
+    forEachCell(box, [this](std::size_t cell){ ++fCellStart[cell + 1]; });
+  for (std::size_t cell = 0; cell < nCells; ++cell)
+    fCellStart[cell + 1] += fCellStart[cell];
+
+  fCellTPCs.resize(fCellStart.back());
+  std::vector<std::size_t> next{ fCellStart.begin(), fCellStart.end() - 1 };
+  for (std::size_t iBox = 0; iBox < boxes.size(); ++iBox) {
+    forEachCell(boxes[iBox], [this,&next,iBox](std::size_t cell)
+      { fCellTPCs[next[cell]++] = static_cast<ElementIndex_t>(iBox); });
+  }
+
+} // icarus::TPCspatialIndex::fillCells()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::TPCspatialIndex::boundingBox
+  (geo::TPCGeo const& tpc, double wiggle) -> Box_t
+{
+  // the limits are extended as in `geo::BoxBoundedGeo::CoordinateContained()`
+  auto lower = [wiggle](double c){ return (c > 0.0)? c / wiggle: c * wiggle; };
+  auto upper = [wiggle](double c){ return (c < 0.0)? c / wiggle: c * wiggle; };
+  return {
+    { lower(tpc.MinX()), lower(tpc.MinY()), lower(tpc.MinZ()) },
+    { upper(tpc.MaxX()), upper(tpc.MaxY()), upper(tpc.MaxZ()) }
+    };
+} // icarus::TPCspatialIndex::boundingBox()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,187 @@
+/**
+ * @file   icarusalg/Geometry/TPCspatialIndex.h
+ * @brief  Spatial index to find the TPC and TPC set containing a point.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/TPCspatialIndex.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_TPCSPATIALINDEX_H
+#define ICARUSALG_GEOMETRY_TPCSPATIALINDEX_H
+
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h" // TPCsetID
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::TPCID
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus { class TPCspatialIndex; }
+
+/**
+ * @brief Index to find the TPC and TPC set (drift volume) containing a point.
+ *
+ * LArSoft `geo::GeometryCore::PositionToTPCID()` finds the TPC containing a
+ * point by testing the bounding box of each cryostat and then of each TPC in
+ * the cryostat found, and the TPC set is then obtained via
+ * `geo::GeometryCore::TPCtoTPCset()`, which is a virtual call to the channel
+ * mapping. Code converting many points (space points, energy deposits,
+ * extrapolated CRT tracks) pays these costs for each point.
+ *
+ * This object partitions the space around both cryostats in a coarse uniform
+ * grid of cells, each one listing the TPC whose box overlaps it, and caches
+ * the TPC set of each TPC. A query tests only the (one or two) candidate TPC
+ * of the cell containing the point, with the same containment criterion and
+ * the same tolerance as `geo::GeometryCore`: the result is always the same
+ * as `PositionToTPCID()` (and `TPCtoTPCset()` of it).
+ *
+ * The index is built once from a geometry after its initialization (that is,
+ * when the channel mapping has been also set up), and it keeps a reference to
+ * it: the geometry must outlive the index.
+ * Queries come in a single point and in a batch version.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::TPCspatialIndex const TPCindex { geom };
+ *
+ * std::vector<readout::TPCsetID> TPCsets(points.size());
+ * TPCindex.findTPCsets(points.size(), points.data(), TPCsets.data());
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::TPCspatialIndex {
+
+    public:
+
+  /// Value of index for "no TPC".
+  static constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
+
+
+  /**
+   * @brief Builds the index of all TPC in `geom`.
+   * @param geom the initialized geometry with the TPC to index
+   * @param positionEpsilon relative tolerance on containment
+   *
+   * The `positionEpsilon` must match the `PositionEpsilon` configuration
+   * parameter of `geom` (LArSoft default is `1e-4`), which determines the
+   * tolerance of `geo::GeometryCore::PositionToTPCID()`.
+   */
+  explicit TPCspatialIndex
+    (geo::GeometryCore const& geom, double positionEpsilon = 1e-4);
+
+
+  // --- BEGIN -- Single point queries -----------------------------------------
+  /// @name Single point queries
+  /// @{
+
+  /// Returns the TPC containing `point` (invalid if none), as
+  /// `geo::GeometryCore::PositionToTPCID()`.
+  geo::TPCID findTPC(geo::Point_t const& point) const;
+
+  /// Returns the TPC set containing `point` (invalid if none).
+  readout::TPCsetID findTPCset(geo::Point_t const& point) const;
+
+  /// @}
+  // --- END ---- Single point queries -----------------------------------------
+
+
+  // --- BEGIN -- Batch queries ------------------------------------------------
+  /// @name Batch queries
+  /// @{
+
+  /// Stores into `TPCs` the TPC containing each of the `n` `points`.
+  void findTPCs
+    (std::size_t n, geo::Point_t const* points, geo::TPCID* TPCs) const;
+
+  /// Stores into `TPCsets` the TPC set containing each of the `n` `points`.
+  void findTPCsets
+    (std::size_t n, geo::Point_t const* points, readout::TPCsetID* TPCsets)
+    const;
+
+  /**
+   * @brief Finds both TPC and TPC set containing each of the `n` `points`.
+   * @param n the number of points
+   * @param points the points to be located
+   * @param[out] TPCs the TPC of each point (invalid if none)
+   * @param[out] TPCsets the TPC set of each point (invalid if none)
+   */
+  void findTPCsAndTPCsets(
+    std::size_t n, geo::Point_t const* points,
+    geo::TPCID* TPCs, readout::TPCsetID* TPCsets
+    ) const;
+
+  /// @}
+  // --- END ---- Batch queries ------------------------------------------------
+
+
+  /// Returns the number of indexed TPC.
+  std::size_t nTPCs() const { return fTPCs.size(); }
+
+  /// Returns the number of grid cells on each direction.
+  std::array<std::size_t, 3U> const& gridSize() const { return fNCells; }
+
+
+    private:
+
+  /// Type of index of an element in the grid.
+  using ElementIndex_t = std::uint32_t;
+
+  /// Axis-aligned bounding box.
+  struct Box_t {
+    std::array<double, 3U> min, max;
+  };
+
+  /// Information cached for each TPC.
+  struct TPCinfo_t {
+    geo::TPCID ID; ///< ID of the TPC.
+    readout::TPCsetID TPCset; ///< ID of the TPC set including the TPC.
+  };
+
+
+  geo::GeometryCore const* fGeom; ///< Geometry with the TPC.
+
+  double fWiggle; ///< Scale factor of the containment tolerance.
+
+  std::vector<TPCinfo_t> fTPCs; ///< All TPC, in geometry order.
+
+  std::array<double, 3U> fGridMin; ///< Lower corner of the grid.
+  std::array<double, 3U> fCellSize; ///< Size of the cells.
+  std::array<std::size_t, 3U> fNCells; ///< Number of cells on each direction.
+
+  /// Start of the TPC list of each cell in `fCellTPCs`, plus the end.
+  std::vector<std::size_t> fCellStart;
+  std::vector<ElementIndex_t> fCellTPCs; ///< TPC in each cell, in order.
+
+
+  /// Returns the index of the TPC containing `point`, `NoIndex` if none.
+  std::size_t findElement(geo::Point_t const& point) const;
+
+  /// Returns the cryostat containing `point` as LArSoft would find it.
+  geo::CryostatID findCryostat(geo::Point_t const& point) const;
+
+  /// Returns the cell including `point`, `NoIndex` if out of the grid.
+  std::size_t cellOf(geo::Point_t const& point) const;
+
+  /// Defines the grid covering all `boxes`.
+  void defineGrid(std::vector<Box_t> const& boxes);
+
+  /// Fills the lists of elements overlapping each cell.
+  void fillCells(std::vector<Box_t> const& boxes);
+
+  /// Returns the box of `tpc` as extended by the tolerance `wiggle`.
+  static Box_t boundingBox(geo::TPCGeo const& tpc, double wiggle);
+
+}; // icarus::TPCspatialIndex
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_TPCSPATIALINDEX_H
@@ -9,6 +9,9 @@
 // library header
 #include "icarusalg/Geometry/details/AuxDetSorting.h"
 
+// ICARUS libraries
+#include "icarusalg/Geometry/details/CachedKeySorting.h"
+
 // LArSoft libraries
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
@@ -16,87 +19,84 @@
 // C/C++ standard libraries
 #include <string>
 #include <algorithm> // std::sort()
+#include <functional> // std::less<>
+#include <utility> // std::pair
 #include <cstdlib> // std::atoi()
 
 
 namespace {
   
   //--------------------------------------------------------------------------
-  /// Define sort order for CRT modules in standard configuration.
-  bool AuxDetStandardSortingRule
-    (const geo::AuxDetGeo& ad1, const geo::AuxDetGeo& ad2)
+  /// Returns the module number of a CRT module, parsed from its volume name.
+  int AuxDetStandardSortingKey(const geo::AuxDetGeo& ad)
   {
     
-    std::string type1 = "", type2 = "";
-    switch (ad1.NSensitiveVolume()) {
-        case 20 : type1 = "MINOS"; break;
-        case 16 : type1 = "CERN"; break;
-        case 64 : type1 = "DC"; break;
-    }
-    switch (ad2.NSensitiveVolume()) {
-        case 20 : type2 = "MINOS"; break;
-        case 16 : type2 = "CERN"; break;
-        case 64 : type2 = "DC"; break;
+    std::string type = "";
+    switch (ad.NSensitiveVolume()) {
+        case 20 : type = "MINOS"; break;
+        case 16 : type = "CERN"; break;
+        case 64 : type = "DC"; break;
     }
 
     // sort based off of GDML name, module number
-    std::string ad1name = (ad1.TotalVolume())->GetName();
-    std::string ad2name = (ad2.TotalVolume())->GetName();
+    std::string adname = (ad.TotalVolume())->GetName();
     // assume volume name is "volAuxDet<type>module###<region>"
-    std::string base1 = "volAuxDet"+type1+"module";
-    std::string base2 = "volAuxDet"+type2+"module";
+    std::string base = "volAuxDet"+type+"module";
 
     //keep compatibility with legacy g4
-    ad1name.erase(std::remove(ad1name.begin(), ad1name.end(), '_'), ad1name.end());
-    ad2name.erase(std::remove(ad2name.begin(), ad2name.end(), '_'), ad2name.end());
-
-    int ad1Num = std::atoi( ad1name.substr( base1.size(), 3).c_str() );
-    int ad2Num = std::atoi( ad2name.substr( base2.size(), 3).c_str() );
+    adname.erase(std::remove(adname.begin(), adname.end(), '_'), adname.end());
 
-    return ad1Num < ad2Num;
+    return std::atoi( adname.substr( base.size(), 3).c_str() );
 
+  } // AuxDetStandardSortingKey()
+  
+  
+  //--------------------------------------------------------------------------
+  /// Define sort order for CRT modules in standard configuration.
+  bool AuxDetStandardSortingRule
+    (const geo::AuxDetGeo& ad1, const geo::AuxDetGeo& ad2)
+  {
+    return AuxDetStandardSortingKey(ad1) < AuxDetStandardSortingKey(ad2);
   } // AuxDetStandardSortingRule()
   
   
   //----------------------------------------------------------------------------
-  /// Define sort order for CRT submodules in standard configuration.
-  bool AuxDetSensitiveStandardSortingRule
-    (const geo::AuxDetSensitiveGeo& ad1, const geo::AuxDetSensitiveGeo& ad2)
+  /// Returns module and strip number of a CRT submodule, from its volume name.
+  std::pair<int, int> AuxDetSensitiveStandardSortingKey
+    (const geo::AuxDetSensitiveGeo& ad)
   {
-    std::string type1 = "", type2 = "";
+    std::string type = "";
 
     // sort based off of GDML name, assuming ordering is encoded
-    std::string ad1name = (ad1.TotalVolume())->GetName();
-    std::string ad2name = (ad2.TotalVolume())->GetName();
+    std::string adname = (ad.TotalVolume())->GetName();
 
-    if ( ad1name.find("MINOS") != std::string::npos ) type1 = "MINOS";
-    if ( ad1name.find("CERN") != std::string::npos ) type1 = "CERN";
-    if ( ad1name.find("DC") != std::string::npos ) type1 = "DC";
-    if ( ad2name.find("MINOS") != std::string::npos ) type2 = "MINOS";
-    if ( ad2name.find("CERN") != std::string::npos ) type2 = "CERN";
-    if ( ad2name.find("DC") != std::string::npos ) type2 = "DC";
+    if ( adname.find("MINOS") != std::string::npos ) type = "MINOS";
+    if ( adname.find("CERN") != std::string::npos ) type = "CERN";
+    if ( adname.find("DC") != std::string::npos ) type = "DC";
 
     // assume volume name is "volAuxDetSensitive<type>module###strip##"
-    std::string baseMod1 = "volAuxDetSensitive"+type1+"module";
-    std::string baseStr1 = "volAuxDetSensitive"+type1+"module###strip";
-    std::string baseMod2 = "volAuxDetSensitive"+type2+"module";
-    std::string baseStr2 = "volAuxDetSensitive"+type2+"module###strip";
+    std::string baseMod = "volAuxDetSensitive"+type+"module";
+    std::string baseStr = "volAuxDetSensitive"+type+"module###strip";
 
     //keep compatibility with legacy g4
-    ad1name.erase(std::remove(ad1name.begin(), ad1name.end(), '_'), ad1name.end());
-    ad2name.erase(std::remove(ad2name.begin(), ad2name.end(), '_'), ad2name.end());
-
-    int ad1Num = atoi( ad1name.substr( baseMod1.size(), 3).c_str() );
-    int ad2Num = atoi( ad2name.substr( baseMod2.size(), 3).c_str() );
-
-    if(ad1Num!=ad2Num) return ad1Num < ad2Num;
+    adname.erase(std::remove(adname.begin(), adname.end(), '_'), adname.end());
 
-    ad1Num = std::atoi( ad1name.substr( baseStr1.size(), 2).c_str() );
-    ad2Num = std::atoi( ad2name.substr( baseStr2.size(), 2).c_str() );
-
-
-    return ad1Num < ad2Num;
+    return {
+      std::atoi( adname.substr( baseMod.size(), 3).c_str() ),
+      std::atoi( adname.substr( baseStr.size(), 2).c_str() )
+      };
 
+  } // AuxDetSensitiveStandardSortingKey()
+  
+  
+  //----------------------------------------------------------------------------
+  /// Define sort order for CRT submodules in standard configuration.
+  bool AuxDetSensitiveStandardSortingRule
+    (const geo::AuxDetSensitiveGeo& ad1, const geo::AuxDetSensitiveGeo& ad2)
+  {
+    // module number first, then strip number
+    return AuxDetSensitiveStandardSortingKey(ad1)
+      < AuxDetSensitiveStandardSortingKey(ad2);
   } // AuxDetSensitiveStandardSortingRule()
   
   
@@ -106,16 +106,27 @@ namespace {
 
 
 //------------------------------------------------------------------------------
-void icarus::SortAuxDetsStandard(std::vector<geo::AuxDetGeo> & adgeo) {
-  std::sort(adgeo.begin(), adgeo.end(), AuxDetStandardSortingRule);
+void icarus::SortAuxDetsStandard
+  (std::vector<geo::AuxDetGeo> & adgeo, bool cachedKeys /* = false */)
+{
+  if (cachedKeys) {
+    icarus::details::sortByCachedKey(adgeo.begin(), adgeo.end(),
+      AuxDetStandardSortingKey, std::less<int>{});
+  }
+  else std::sort(adgeo.begin(), adgeo.end(), AuxDetStandardSortingRule);
 }
 
 
 //------------------------------------------------------------------------------
 void icarus::SortAuxDetSensitiveStandard
-  (std::vector<geo::AuxDetSensitiveGeo>& adsgeo)
+  (std::vector<geo::AuxDetSensitiveGeo>& adsgeo, bool cachedKeys /* = false */)
 {
-  std::sort(adsgeo.begin(), adsgeo.end(), AuxDetSensitiveStandardSortingRule);
+  if (cachedKeys) {
+    icarus::details::sortByCachedKey(adsgeo.begin(), adsgeo.end(),
+      AuxDetSensitiveStandardSortingKey, std::less<std::pair<int, int>>{});
+  }
+  else
+    std::sort(adsgeo.begin(), adsgeo.end(), AuxDetSensitiveStandardSortingRule);
 }
 
 
@@ -21,14 +21,31 @@
 namespace icarus {
   
   //----------------------------------------------------------------------------
-  /// Sorts ICARUS CRT modules in standard configuration.
-  void SortAuxDetsStandard(std::vector<geo::AuxDetGeo>& adgeo);
+  /**
+   * @brief Sorts ICARUS CRT modules in standard configuration.
+   * @param adgeo the modules to be sorted
+   * @param cachedKeys parse each module name only once (stable sorting)
+   * 
+   * Modules are sorted by the number encoded in their volume name.
+   * With `cachedKeys`, the number is extracted once per module instead of at
+   * each comparison, and the modules are moved only at the end.
+   */
+  void SortAuxDetsStandard
+    (std::vector<geo::AuxDetGeo>& adgeo, bool cachedKeys = false);
   
   
   //----------------------------------------------------------------------------
-  /// Sorts ICARUS CRT submodules in standard configuration.
+  /**
+   * @brief Sorts ICARUS CRT submodules in standard configuration.
+   * @param adsgeo the submodules (strips) to be sorted
+   * @param cachedKeys parse each submodule name only once (stable sorting)
+   * @see `SortAuxDetsStandard()`
+   * 
+   * Submodules are sorted by module number, then by strip number, both
+   * encoded in their volume name.
+   */
   void SortAuxDetSensitiveStandard
-    (std::vector<geo::AuxDetSensitiveGeo>& adsgeo);
+    (std::vector<geo::AuxDetSensitiveGeo>& adsgeo, bool cachedKeys = false);
   
   
   //----------------------------------------------------------------------------
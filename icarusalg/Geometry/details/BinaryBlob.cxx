@@ -0,0 +1,78 @@
+/**
+ * @file   icarusalg/Geometry/details/BinaryBlob.cxx
+ * @brief  Minimal utilities to write and memory-map binary data blobs.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Geometry/details/BinaryBlob.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/details/BinaryBlob.h"
+
+// POSIX libraries
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <fcntl.h> // open()
+#include <unistd.h> // close(), getpid()
+
+// C/C++ standard libraries
+#include <fstream>
+#include <cstdio> // std::rename(), std::remove()
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::details::BlobWriter
+// -----------------------------------------------------------------------------
+bool icarus::details::BlobWriter::writeToFile(std::string const& path) const {
+
+  std::string const tempPath = path + ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream out { tempPath, std::ios::binary | std::ios::trunc };
+    if (!out) return false;
+    out.write(reinterpret_cast<char const*>(fData.data()), fData.size());
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  return true;
+
+} // icarus::details::BlobWriter::writeToFile()
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::details::MappedBlobReader
+// -----------------------------------------------------------------------------
+icarus::details::MappedBlobReader::MappedBlobReader(std::string const& path) {
+
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct ::stat info;
+  if ((::fstat(fd, &info) == 0) && (info.st_size > 0)) {
+    void* const addr = ::mmap
+      (nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      fBegin = static_cast<unsigned char const*>(addr);
+      fSize = static_cast<std::size_t>(info.st_size);
+      fGood = true;
+    }
+  }
+  ::close(fd); // the mapping survives the file descriptor
+
+} // icarus::details::MappedBlobReader::MappedBlobReader()
+
+
+// -----------------------------------------------------------------------------
+icarus::details::MappedBlobReader::~MappedBlobReader() {
+  if (fBegin) ::munmap(const_cast<unsigned char*>(fBegin), fSize);
+} // icarus::details::MappedBlobReader::~MappedBlobReader()
+
+
+// -----------------------------------------------------------------------------
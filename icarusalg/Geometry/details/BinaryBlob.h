@@ -0,0 +1,172 @@
+/**
+ * @file   icarusalg/Geometry/details/BinaryBlob.h
+ * @brief  Minimal utilities to write and memory-map binary data blobs.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Geometry/details/BinaryBlob.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_DETAILS_BINARYBLOB_H
+#define ICARUSALG_GEOMETRY_DETAILS_BINARYBLOB_H
+
+
+// C/C++ standard libraries
+#include <string>
+#include <vector>
+#include <cstring> // std::memcpy()
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+#include <type_traits> // std::is_trivially_copyable_v
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::details {
+
+  class FNV1aHasher;
+  class BlobWriter;
+  class MappedBlobReader;
+
+} // namespace icarus::details
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Accumulates a 64-bit FNV-1a hash of trivially copyable values.
+ *
+ * This is not a cryptographic hash: it is meant to detect changes in the
+ * input of a computation (cache key), not to resist tampering.
+ */
+class icarus::details::FNV1aHasher {
+
+  std::uint64_t fHash = 0xcbf29ce484222325ULL; ///< Offset basis.
+
+    public:
+
+  /// Adds `size` bytes starting at `data` to the hash.
+  void addBytes(void const* data, std::size_t size)
+    {
+      auto const* bytes = static_cast<unsigned char const*>(data);
+      for (std::size_t i = 0; i < size; ++i) {
+        fHash ^= bytes[i];
+        fHash *= 0x100000001b3ULL;
+      }
+    }
+
+  /// Adds the object representation of `value` to the hash.
+  template <typename T>
+  FNV1aHasher& add(T const& value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      addBytes(&value, sizeof(T));
+      return *this;
+    }
+
+  /// Adds the content of a string to the hash.
+  FNV1aHasher& add(std::string const& s)
+    { add(s.size()); addBytes(s.data(), s.size()); return *this; }
+
+  /// Returns the current value of the hash.
+  std::uint64_t value() const { return fHash; }
+
+}; // icarus::details::FNV1aHasher
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Accumulates trivially copyable values into a binary blob.
+ *
+ * Values are stored one after the other with their native representation and
+ * no padding. The blob is therefore only meant to be read back on the same
+ * platform (which the cache key should also guarantee).
+ */
+class icarus::details::BlobWriter {
+
+  std::vector<unsigned char> fData; ///< Accumulated content.
+
+    public:
+
+  /// Appends the object representation of `value`.
+  template <typename T>
+  BlobWriter& write(T const& value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      auto const* bytes = reinterpret_cast<unsigned char const*>(&value);
+      fData.insert(fData.end(), bytes, bytes + sizeof(T));
+      return *this;
+    }
+
+  /// Returns the size of the blob so far, in bytes.
+  std::size_t size() const { return fData.size(); }
+
+  /**
+   * @brief Writes the blob into the file at `path`.
+   * @return whether writing was successful
+   *
+   * The blob is first written in a temporary file in the same directory, which
+   * is then renamed: a concurrent reader will never see a partial blob.
+   */
+  bool writeToFile(std::string const& path) const;
+
+}; // icarus::details::BlobWriter
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Memory-maps a binary blob file and reads values from it in sequence.
+ *
+ * The file is mapped read-only on construction and unmapped on destruction.
+ * Reads past the end of the blob do not happen: instead, the reader is marked
+ * as failed and default-constructed values are returned.
+ * ~~~~{.cpp}
+ * icarus::details::MappedBlobReader reader { path };
+ * auto const version = reader.read<std::uint32_t>();
+ * if (!reader) ... // file not present, too short, ...
+ * ~~~~
+ */
+class icarus::details::MappedBlobReader {
+
+  unsigned char const* fBegin = nullptr; ///< Start of the mapped region.
+  std::size_t fSize = 0U; ///< Size of the mapped region.
+  std::size_t fPos = 0U; ///< Position of the next read.
+  bool fGood = false; ///< Whether no error occurred so far.
+
+    public:
+
+  /// Maps the file at `path`; the reader is failed if that is not possible.
+  explicit MappedBlobReader(std::string const& path);
+
+  MappedBlobReader(MappedBlobReader const&) = delete;
+  MappedBlobReader& operator= (MappedBlobReader const&) = delete;
+
+  ~MappedBlobReader();
+
+  /// Returns whether no error occurred so far.
+  bool good() const { return fGood; }
+
+  /// Returns whether no error occurred so far.
+  explicit operator bool() const { return good(); }
+
+  /// Returns whether the whole blob has been read.
+  bool atEnd() const { return fPos == fSize; }
+
+  /// Returns the next value from the blob.
+  template <typename T>
+  T read()
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      T value {};
+      if (!fGood || (fSize - fPos < sizeof(T))) {
+        fGood = false;
+        return value;
+      }
+      std::memcpy(&value, fBegin + fPos, sizeof(T));
+      fPos += sizeof(T);
+      return value;
+    }
+
+}; // icarus::details::MappedBlobReader
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_DETAILS_BINARYBLOB_H
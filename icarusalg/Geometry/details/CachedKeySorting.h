@@ -0,0 +1,172 @@
+/**
+ * @file   icarusalg/Geometry/details/CachedKeySorting.h
+ * @brief  Sorting of geometry objects by precomputed keys.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ *
+ * This is a header-only library. The overloads with an execution policy may
+ * require linking with TBB.
+ */
+
+#ifndef ICARUSALG_GEOMETRY_DETAILS_CACHEDKEYSORTING_H
+#define ICARUSALG_GEOMETRY_DETAILS_CACHEDKEYSORTING_H
+
+
+// C/C++ standard libraries
+#include <vector>
+#include <iterator> // std::iterator_traits, std::distance()
+#include <algorithm> // std::sort(), std::transform(), std::move()
+#include <execution> // std::execution::seq, std::is_execution_policy_v
+#include <numeric> // std::iota()
+#include <utility> // std::move()
+#include <type_traits> // std::decay_t, std::enable_if_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::details {
+
+  /**
+   * @brief Returns the order of the `keys` according to `less`.
+   * @tparam ExecPolicy type of execution policy (like `std::execution::par`)
+   * @tparam Key type of sorting key
+   * @tparam Less type of comparison functor between two keys
+   * @param policy the execution policy for the sorting
+   * @param keys the sorting key of each element
+   * @param less strict ordering functor between keys
+   * @return a list of indices of `keys`, sorted
+   *
+   * The returned list contains all the indices of `keys`, so that the first
+   * one is the index of the smallest key, and so on.
+   * Elements with equivalent keys are left in their original order (as in
+   * `std::stable_sort()`), so that the result does not depend on the
+   * implementation of the sorting algorithm nor on the execution policy.
+   */
+  template <
+    typename ExecPolicy, typename Key, typename Less,
+    typename = std::enable_if_t
+      <std::is_execution_policy_v<std::decay_t<ExecPolicy>>>
+    >
+  std::vector<std::size_t> sortedKeyIndices
+    (ExecPolicy&& policy, std::vector<Key> const& keys, Less less)
+  {
+    std::vector<std::size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::sort(std::forward<ExecPolicy>(policy), order.begin(), order.end(),
+      [&keys, &less](std::size_t a, std::size_t b)
+        {
+          if (less(keys[a], keys[b])) return true;
+          if (less(keys[b], keys[a])) return false;
+          return a < b;
+        }
+      );
+    return order;
+  } // sortedKeyIndices()
+
+
+  /// Returns the order of the `keys` according to `less` (serial sorting).
+  /// @see `sortedKeyIndices(ExecPolicy&&, std::vector<Key> const&, Less)`
+  template <typename Key, typename Less>
+  std::vector<std::size_t> sortedKeyIndices
+    (std::vector<Key> const& keys, Less less)
+    { return sortedKeyIndices(std::execution::seq, keys, std::move(less)); }
+
+
+  /**
+   * @brief Rearranges the elements in `[ first, last )` as specified.
+   * @tparam Iter type of random access iterator to the elements
+   * @param first iterator to the first element
+   * @param last iterator past the last element
+   * @param order the index of the element to be moved in each position
+   *
+   * Each element is moved twice, through a temporary buffer.
+   */
+  template <typename Iter>
+  void applyPermutation
+    (Iter first, Iter last, std::vector<std::size_t> const& order)
+  {
+    using Value_t = typename std::iterator_traits<Iter>::value_type;
+
+    std::vector<Value_t> sorted;
+    sorted.reserve(std::distance(first, last));
+    for (std::size_t const index: order)
+      sorted.push_back(std::move(first[index]));
+    std::move(sorted.begin(), sorted.end(), first);
+  } // applyPermutation()
+
+
+  /**
+   * @brief Sorts the elements in the range by a key computed only once.
+   * @tparam Iter type of random access iterator to the elements
+   * @tparam KeyOf type of functor extracting the key from an element
+   * @tparam Less type of comparison functor between two keys
+   * @param first iterator to the first element
+   * @param last iterator past the last element
+   * @param keyOf functor returning the sorting key of an element
+   * @param less strict ordering functor between keys
+   *
+   * Compared to `std::sort()` with a comparison of the elements, the key of
+   * each element is computed once rather than at each comparison, and the
+   * elements (geometry objects, which can be large) are moved into their final
+   * place at the end instead of being swapped around during sorting.
+   * The sorting is stable.
+   */
+  template <typename Iter, typename KeyOf, typename Less>
+  void sortByCachedKey(Iter first, Iter last, KeyOf keyOf, Less less)
+  {
+    using Key_t = std::decay_t<decltype(keyOf(*first))>;
+
+    std::vector<Key_t> keys;
+    keys.reserve(std::distance(first, last));
+    for (Iter it = first; it != last; ++it) keys.push_back(keyOf(*it));
+
+    applyPermutation(first, last, sortedKeyIndices(keys, less));
+
+  } // sortByCachedKey()
+
+
+  /**
+   * @brief Sorts the elements in the range by a key computed only once.
+   * @tparam ExecPolicy type of execution policy (like `std::execution::par`)
+   * @tparam Iter type of random access iterator to the elements
+   * @tparam KeyOf type of functor extracting the key from an element
+   * @tparam Less type of comparison functor between two keys
+   * @param policy the execution policy for key extraction and sorting
+   * @param first iterator to the first element
+   * @param last iterator past the last element
+   * @param keyOf functor returning the sorting key of an element
+   * @param less strict ordering functor between keys
+   *
+   * This is the same as
+   * `sortByCachedKey(Iter, Iter, KeyOf, Less)`, but the keys are extracted
+   * and the indices sorted according to `policy`; `keyOf` and `less` must be
+   * safe to call concurrently (and, with `std::execution::par_unseq`, must
+   * neither allocate nor lock). The key type must be default-constructible.
+   * The elements are moved into place serially, and the result is the same
+   * as the serial sorting.
+   */
+  template <
+    typename ExecPolicy, typename Iter, typename KeyOf, typename Less,
+    typename = std::enable_if_t
+      <std::is_execution_policy_v<std::decay_t<ExecPolicy>>>
+    >
+  void sortByCachedKey
+    (ExecPolicy&& policy, Iter first, Iter last, KeyOf keyOf, Less less)
+  {
+    using Key_t = std::decay_t<decltype(keyOf(*first))>;
+
+    std::vector<Key_t> keys(std::distance(first, last));
+    std::transform(policy, first, last, keys.begin(), keyOf);
+
+    applyPermutation(first, last,
+      sortedKeyIndices(std::forward<ExecPolicy>(policy), keys, less));
+
+  } // sortByCachedKey(ExecPolicy)
+
+
+} // namespace icarus::details
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_DETAILS_CACHEDKEYSORTING_H
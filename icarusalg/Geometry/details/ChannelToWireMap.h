@@ -92,6 +92,10 @@ class icarus::details::ChannelToWireMap {
   unsigned int nChannels() const
     { return endChannel() - raw::ChannelID_t{0}; }
   
+  /// Returns the information of all ROPs, sorted by first channel.
+  std::vector<ChannelsInROPStruct> const& ROPs() const
+    { return fROPfirstChannel; }
+  
   /// Adds the next ROP with its first channel ID
   /// (must be larger than previous).
   void addROP(
@@ -0,0 +1,39 @@
+/**
+ * @file   icarusalg/Geometry/details/ChannelToWireTable.cxx
+ * @brief  Dense channel-to-wire lookup table (implementation file).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Geometry/details/ChannelToWireTable.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/details/ChannelToWireTable.h"
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::ChannelToWireTable::reserve
+  (unsigned int nChannels, std::size_t nWires)
+{
+  fROPs.reserve(nChannels);
+  fFirstWire.reserve(nChannels + 1);
+  fWires.reserve(nWires);
+} // icarus::details::ChannelToWireTable::reserve()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::ChannelToWireTable::shrink_to_fit() {
+  fROPs.shrink_to_fit();
+  fFirstWire.shrink_to_fit();
+  fWires.shrink_to_fit();
+} // icarus::details::ChannelToWireTable::shrink_to_fit()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::ChannelToWireTable::clear() {
+  fWires.clear();
+  fFirstWire.assign(1U, 0U);
+  fROPs.clear();
+} // icarus::details::ChannelToWireTable::clear()
+
+
+// -----------------------------------------------------------------------------
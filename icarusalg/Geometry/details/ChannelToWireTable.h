@@ -0,0 +1,151 @@
+/**
+ * @file   icarusalg/Geometry/details/ChannelToWireTable.h
+ * @brief  Dense channel-to-wire lookup table.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Geometry/details/ChannelToWireTable.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_DETAILS_CHANNELTOWIRETABLE_H
+#define ICARUSALG_GEOMETRY_DETAILS_CHANNELTOWIRETABLE_H
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/span.h" // util::span
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::details::ChannelToWireTable
+// -----------------------------------------------------------------------------
+namespace icarus::details { class ChannelToWireTable; }
+/**
+ * @brief Dense table of the wire segments and readout plane of each channel.
+ *
+ * The table has one entry for each channel, from `0` to `nChannels()`
+ * (excluded), and it covers all channels including the wireless ones (which
+ * have a readout plane but no wire).
+ * All the wire segments of all the channels are stored in a single contiguous
+ * array, and an offset table (one entry per channel, plus one) delimits the
+ * segments of each channel. Lookups are therefore a couple of array accesses,
+ * with no search and no memory allocation.
+ *
+ * The table is filled one channel at a time, in increasing channel order:
+ * ~~~~{.cpp}
+ * icarus::details::ChannelToWireTable table;
+ * for (raw::ChannelID_t channel: ...) { // must be 0, 1, 2, ...
+ *   table.addChannel(ropid);
+ *   for (geo::WireID const& wireID: ...)
+ *     table.addWire(wireID);
+ * }
+ * ~~~~
+ */
+class icarus::details::ChannelToWireTable {
+
+    public:
+
+  /// Type of collection of wire segments.
+  using WireColl_t = std::vector<geo::WireID>;
+
+  /// Type of view of the wire segments of a channel.
+  using WireSpan_t = util::span<WireColl_t::const_iterator>;
+
+
+  ChannelToWireTable() = default;
+
+
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query
+  /// @{
+
+  /// Returns the number of channels in the table.
+  unsigned int nChannels() const { return fROPs.size(); }
+
+  /// Returns the total number of wire segments in the table.
+  std::size_t nWires() const { return fWires.size(); }
+
+  /// Returns whether the table has no channel.
+  bool empty() const { return fROPs.empty(); }
+
+  /// Returns whether `channel` is covered by this table.
+  bool hasChannel(raw::ChannelID_t channel) const
+    { return raw::isValidChannelID(channel) && (channel < nChannels()); }
+
+  /// Returns the wire segments of `channel` (undefined if `!hasChannel()`).
+  WireSpan_t wires(raw::ChannelID_t channel) const
+    {
+      assert(hasChannel(channel));
+      auto const wbegin = fWires.cbegin();
+      return
+        { wbegin + fFirstWire[channel], wbegin + fFirstWire[channel + 1] };
+    }
+
+  /// Returns the number of wire segments on `channel` (undefined if invalid).
+  unsigned int nWires(raw::ChannelID_t channel) const
+    {
+      assert(hasChannel(channel));
+      return fFirstWire[channel + 1] - fFirstWire[channel];
+    }
+
+  /// Returns the readout plane of `channel` (undefined if `!hasChannel()`).
+  readout::ROPID const& ROP(raw::ChannelID_t channel) const
+    { assert(hasChannel(channel)); return fROPs[channel]; }
+
+  /// @}
+  // --- END -- Query ----------------------------------------------------------
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Prepares memory for the specified number of channels and wire segments.
+  void reserve(unsigned int nChannels, std::size_t nWires);
+
+  /// Adds the next channel, belonging to readout plane `ropid`.
+  void addChannel(readout::ROPID const& ropid)
+    {
+      fROPs.push_back(ropid);
+      fFirstWire.push_back(fFirstWire.back());
+    }
+
+  /// Adds a wire segment to the last added channel.
+  void addWire(geo::WireID const& wireID)
+    {
+      assert(!empty());
+      fWires.push_back(wireID);
+      fFirstWire.back() = fWires.size();
+    }
+
+  /// Releases any unused memory.
+  void shrink_to_fit();
+
+  /// Resets the table to like just constructed.
+  void clear();
+
+  /// @}
+  // --- END -- Filling --------------------------------------------------------
+
+    private:
+
+  /// All wire segments, sorted by channel.
+  WireColl_t fWires;
+
+  /// Index in `fWires` of the first segment of each channel, plus end index.
+  std::vector<unsigned int> fFirstWire { 0U };
+
+  /// Readout plane of each channel.
+  std::vector<readout::ROPID> fROPs;
+
+}; // class icarus::details::ChannelToWireTable
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_DETAILS_CHANNELTOWIRETABLE_H
@@ -0,0 +1,107 @@
+/**
+ * @file   icarusalg/Geometry/details/PMTgeometryTable.cxx
+ * @brief  Flat table of the position and neighbours of all PMT
+ *         (implementation file).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/details/PMTgeometryTable.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/details/PMTgeometryTable.h"
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::details::PMTgeometryTable
+// -----------------------------------------------------------------------------
+auto icarus::details::PMTgeometryTable::wallChannels
+  (unsigned int cryostat, unsigned int wall) const -> ChannelSpan_t
+{
+  static ChannelColl_t const NoChannels;
+  
+  assert(wall < NWalls);
+  std::size_t const iWall = static_cast<std::size_t>(cryostat) * NWalls + wall;
+  ChannelColl_t const& channels
+    = (iWall < fWallChannels.size())? fWallChannels[iWall]: NoChannels;
+  return { channels.begin(), channels.end() };
+} // icarus::details::PMTgeometryTable::wallChannels()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::PMTgeometryTable::reserve(std::size_t nPMTs) {
+  for (auto* v: { &fCenterX, &fCenterY, &fCenterZ }) v->reserve(nPMTs);
+  fCryostat.reserve(nPMTs);
+  fWall.reserve(nPMTs);
+} // icarus::details::PMTgeometryTable::reserve()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::PMTgeometryTable::addPMT
+  (geo::Point_t const& center, unsigned int cryostat, unsigned int wall)
+{
+  assert(wall < NWalls);
+
+  Channel_t const channel = nPMTs();
+
+  fCenterX.push_back(center.X());
+  fCenterY.push_back(center.Y());
+  fCenterZ.push_back(center.Z());
+  fCryostat.push_back(cryostat);
+  fWall.push_back(wall);
+
+  std::size_t const iWall = static_cast<std::size_t>(cryostat) * NWalls + wall;
+  if (iWall >= fWallChannels.size()) fWallChannels.resize(iWall + 1);
+  fWallChannels[iWall].push_back(channel);
+
+} // icarus::details::PMTgeometryTable::addPMT()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::PMTgeometryTable::buildNeighbors(double maxDistance) {
+
+  /*
+   * Walls have O(100) PMT each: comparing all the pairs in a wall is cheap
+   * enough, and it is done once per job.
+   * Since the channels of each wall are in increasing order, so are the
+   * neighbours found for each channel.
+   */
+  double const maxDistance2 = maxDistance * maxDistance;
+
+  fNeighborDistance = maxDistance;
+  fNeighborOffsets.assign(1U, 0U);
+  fNeighborOffsets.reserve(nPMTs() + 1U);
+  fNeighbors.clear();
+
+  for (Channel_t channel = 0U; channel < nPMTs(); ++channel) {
+
+    ChannelColl_t const& sameWall
+      = fWallChannels[fCryostat[channel] * NWalls + fWall[channel]];
+
+    for (Channel_t const other: sameWall) {
+      if (other == channel) continue;
+      double const dx = fCenterX[other] - fCenterX[channel];
+      double const dy = fCenterY[other] - fCenterY[channel];
+      double const dz = fCenterZ[other] - fCenterZ[channel];
+      if (dx*dx + dy*dy + dz*dz <= maxDistance2) fNeighbors.push_back(other);
+    } // for other PMT on the wall
+
+    fNeighborOffsets.push_back(fNeighbors.size());
+
+  } // for channel
+
+} // icarus::details::PMTgeometryTable::buildNeighbors()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::PMTgeometryTable::clear() {
+  for (auto* v: { &fCenterX, &fCenterY, &fCenterZ }) v->clear();
+  fCryostat.clear();
+  fWall.clear();
+  fWallChannels.clear();
+  fNeighborOffsets.clear();
+  fNeighbors.clear();
+  fNeighborDistance = 0.0;
+} // icarus::details::PMTgeometryTable::clear()
+
+
+// -----------------------------------------------------------------------------
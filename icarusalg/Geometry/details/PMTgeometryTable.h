@@ -0,0 +1,199 @@
+/**
+ * @file   icarusalg/Geometry/details/PMTgeometryTable.h
+ * @brief  Flat table of the position and neighbours of all PMT.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/details/PMTgeometryTable.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_DETAILS_PMTGEOMETRYTABLE_H
+#define ICARUSALG_GEOMETRY_DETAILS_PMTGEOMETRYTABLE_H
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/span.h" // util::span
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::details::PMTgeometryTable
+// -----------------------------------------------------------------------------
+namespace icarus::details { class PMTgeometryTable; }
+/**
+ * @brief Position, cryostat, wall and neighbours of all PMT, in arrays.
+ *
+ * The table stores for each optical detector (PMT) its center, its cryostat
+ * and the wall of the cryostat it is mounted on, indexed by its channel,
+ * which in ICARUS is also the optical detector number. It is filled after the
+ * geometry is sorted (see `icarus::GeoObjectSorterPMTasTPC`), so that the
+ * channels follow that sorting, and it does not change afterwards.
+ *
+ * Each cryostat has `NWalls` PMT walls, one on each side of the cathode:
+ * wall `0` is the one with lower _x_. The channels of each wall are also
+ * available as a list (`wallChannels()`).
+ *
+ * The table also includes a neighbour graph: two PMT are neighbours if they
+ * are on the same wall and their centers are not farther than a given
+ * distance (see `buildNeighbors()`). The neighbours of each PMT are listed
+ * in increasing channel order (`neighbors()`).
+ *
+ * The table is filled one PMT at a time, in channel order, then the neighbour
+ * graph is built:
+ * ~~~~{.cpp}
+ * icarus::details::PMTgeometryTable table;
+ * table.reserve(nOpDets);
+ * for (geo::OpDetGeo const& opDet: ...) // in channel order
+ *   table.addPMT(opDet.GetCenter(), cryostat, wall);
+ * table.buildNeighbors(60.0);
+ * ~~~~
+ */
+class icarus::details::PMTgeometryTable {
+
+    public:
+
+  /// Type of optical detector channel (also optical detector number).
+  using Channel_t = unsigned int;
+
+  /// Type of collection of channels.
+  using ChannelColl_t = std::vector<Channel_t>;
+
+  /// Type of view of a list of channels.
+  using ChannelSpan_t = util::span<ChannelColl_t::const_iterator>;
+
+  /// Number of PMT walls in each cryostat.
+  static constexpr unsigned int NWalls = 2U;
+
+
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query
+  /// @{
+
+  /// Returns whether the table has no PMT.
+  bool empty() const { return fCryostat.empty(); }
+
+  /// Returns the number of PMT in the table.
+  unsigned int nPMTs() const { return fCryostat.size(); }
+
+  /// Returns whether `channel` is in the table.
+  bool hasChannel(Channel_t channel) const { return channel < nPMTs(); }
+
+  /// Returns the center of the PMT on `channel`.
+  geo::Point_t center(Channel_t channel) const
+    {
+      assert(hasChannel(channel));
+      return { fCenterX[channel], fCenterY[channel], fCenterZ[channel] };
+    }
+
+  /// Returns the number of the cryostat the PMT on `channel` is in.
+  unsigned int cryostat(Channel_t channel) const
+    { assert(hasChannel(channel)); return fCryostat[channel]; }
+
+  /// Returns the wall (`0` or `1`) the PMT on `channel` is on.
+  unsigned int wall(Channel_t channel) const
+    { assert(hasChannel(channel)); return fWall[channel]; }
+
+  /// Returns the channels of the PMT on the specified wall, in order.
+  ChannelSpan_t wallChannels(unsigned int cryostat, unsigned int wall) const;
+
+  /// Returns the channels of the neighbours of `channel`, in order.
+  ChannelSpan_t neighbors(Channel_t channel) const
+    {
+      assert(hasChannel(channel) && (channel + 1 < fNeighborOffsets.size()));
+      return {
+        fNeighbors.begin() + fNeighborOffsets[channel],
+        fNeighbors.begin() + fNeighborOffsets[channel + 1]
+        };
+    }
+
+  /// Returns the number of neighbours of `channel`.
+  unsigned int nNeighbors(Channel_t channel) const
+    {
+      assert(hasChannel(channel) && (channel + 1 < fNeighborOffsets.size()));
+      return fNeighborOffsets[channel + 1] - fNeighborOffsets[channel];
+    }
+
+  /// Returns the distance used to build the neighbour graph.
+  double neighborDistance() const { return fNeighborDistance; }
+
+  /// @}
+  // --- END -- Query ----------------------------------------------------------
+
+
+  // --- BEGIN -- Arrays -------------------------------------------------------
+  /**
+   * @name Arrays
+   *
+   * Direct access to the arrays, with `nPMTs()` elements each, indexed by
+   * channel.
+   */
+  /// @{
+
+  double const* centerX() const { return fCenterX.data(); }
+  double const* centerY() const { return fCenterY.data(); }
+  double const* centerZ() const { return fCenterZ.data(); }
+
+  /// @}
+  // --- END -- Arrays ---------------------------------------------------------
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Prepares memory for the specified number of PMT.
+  void reserve(std::size_t nPMTs);
+
+  /**
+   * @brief Adds the PMT with the next channel.
+   * @param center position of the center of the PMT
+   * @param cryostat number of the cryostat the PMT is in
+   * @param wall the wall the PMT is on (`0` or `1`, see `NWalls`)
+   */
+  void addPMT
+    (geo::Point_t const& center, unsigned int cryostat, unsigned int wall);
+
+  /**
+   * @brief Builds the neighbour graph of all the PMT added so far.
+   * @param maxDistance largest distance between the centers of neighbours
+   *
+   * Neighbours are on the same wall of the same cryostat.
+   * Any previous graph is replaced.
+   */
+  void buildNeighbors(double maxDistance);
+
+  /// Resets the table to like just constructed.
+  void clear();
+
+  /// @}
+  // --- END -- Filling --------------------------------------------------------
+
+
+    private:
+
+  std::vector<double> fCenterX; ///< _x_ coordinate of the PMT centers.
+  std::vector<double> fCenterY; ///< _y_ coordinate of the PMT centers.
+  std::vector<double> fCenterZ; ///< _z_ coordinate of the PMT centers.
+  std::vector<unsigned int> fCryostat; ///< Cryostat of each PMT.
+  std::vector<unsigned int> fWall; ///< Wall of each PMT.
+
+  /// Channels of each wall, indexed by `cryostat * NWalls + wall`.
+  std::vector<ChannelColl_t> fWallChannels;
+
+  /// Neighbours of channel `c` are from `fNeighborOffsets[c]` to
+  /// `fNeighborOffsets[c + 1]` (excluded) in `fNeighbors`.
+  std::vector<std::size_t> fNeighborOffsets;
+
+  ChannelColl_t fNeighbors; ///< Neighbour channels, channel by channel.
+
+  double fNeighborDistance = 0.0; ///< Distance of the neighbour graph.
+
+}; // icarus::details::PMTgeometryTable
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_DETAILS_PMTGEOMETRYTABLE_H
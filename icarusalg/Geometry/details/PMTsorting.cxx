@@ -10,6 +10,9 @@
 // library header
 #include "icarusalg/Geometry/details/PMTsorting.h"
 
+// ICARUS libraries
+#include "icarusalg/Geometry/details/CachedKeySorting.h"
+
 // LArSoft libraries
 // #include "larcorealg/CoreUtils/span.h"
 
@@ -24,6 +27,11 @@
 void icarus::PMTsorterStandard::sort(std::vector<geo::OpDetGeo>& opDets) const {
   assert(opDets.size() % 2 == 0); // must be even!
   
+  if (fCachedSortKeys) {
+    sortWithCachedKeys(opDets);
+    return;
+  }
+  
   /*
    * 1. sort all optical detectors by _x_
    * 2. split them by plane
@@ -77,4 +85,52 @@ void icarus::PMTsorterStandard::sortInPlane(OpDetSpan_t const& opDets) const {
 } // icarus::PMTsorterStandard::sortInPlane()
 
 
+// -----------------------------------------------------------------------------
+void icarus::PMTsorterStandard::sortWithCachedKeys
+  (std::vector<geo::OpDetGeo>& opDets) const
+{
+  /*
+   * Same procedure as in `sort()`, on indices of the detectors:
+   * 1. sort all optical detectors by _x_
+   * 2. split them by plane (in two halves)
+   * 3. sort the detectors within each plane by _y_, then stably by _z_
+   * Finally, move the detectors in the sorted order.
+   */
+  std::vector<geo::Point_t> centers;
+  centers.reserve(opDets.size());
+  for (geo::OpDetGeo const& opDet: opDets) centers.push_back(opDet.GetCenter());
+  
+  //
+  // 1. sort all optical detectors by _x_
+  //
+  std::vector<std::size_t> order
+    = icarus::details::sortedKeyIndices(centers, fSmallerCenterX);
+  
+  //
+  // 2. split them by plane: same horrible shortcut as in `sort()`
+  //
+  auto const middle = std::next(order.begin(), order.size() / 2U);
+  assert(order.empty()
+    || fSmallerCenterX(centers[*std::prev(middle)], centers[*middle]));
+  
+  //
+  // 3. sort the detectors within each plane
+  //
+  auto const smallerY = [this, &centers](std::size_t a, std::size_t b)
+    { return fSmallerCenterY(centers[a], centers[b]); };
+  auto const smallerZ = [this, &centers](std::size_t a, std::size_t b)
+    { return fSmallerCenterZ(centers[a], centers[b]); };
+  auto const sortPlane = [&smallerY, &smallerZ](auto begin, auto end)
+    {
+      std::stable_sort(begin, end, smallerY);
+      std::stable_sort(begin, end, smallerZ);
+    };
+  sortPlane(order.begin(), middle);
+  sortPlane(middle, order.end());
+  
+  icarus::details::applyPermutation(opDets.begin(), opDets.end(), order);
+  
+} // icarus::PMTsorterStandard::sortWithCachedKeys()
+
+
 // -----------------------------------------------------------------------------
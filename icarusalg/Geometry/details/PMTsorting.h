@@ -58,6 +58,11 @@ namespace icarus { class PMTsorterStandard; }
  *   for that coordinate (absolute), they two detectors are considered to be at
  *   the same position in that coordinate
  *   (note that the default value is very generous).
+ * * `CachedSortKeys` (flag, default: `false`): if set, the center of each
+ *   optical detector is read only once, the sorting is performed on a list of
+ *   indices and the detectors are moved into their final position at the end;
+ *   the sorting is then also stable, i.e. detectors at the same position
+ *   within tolerance keep their original relative order.
  * 
  */
 class icarus::PMTsorterStandard {
@@ -93,6 +98,12 @@ class icarus::PMTsorterStandard {
       1.0 // default
       };
     
+    fhicl::Atom<bool> CachedSortKeys {
+      Name("CachedSortKeys"),
+      Comment("extract the detector centers once and sort their indices"),
+      false // default
+      };
+    
   }; // Config
   
   
@@ -101,6 +112,7 @@ class icarus::PMTsorterStandard {
     : fSmallerCenterX{ config.ToleranceX() }
     , fSmallerCenterY{ config.ToleranceY() }
     , fSmallerCenterZ{ config.ToleranceZ() }
+    , fCachedSortKeys{ config.CachedSortKeys() }
     {}
   
   
@@ -140,10 +152,11 @@ class icarus::PMTsorterStandard {
     
     /// Returns whether `A` has a center coordinate `Coord` smaller than `B`.
     bool operator() (geo::OpDetGeo const& A, geo::OpDetGeo const& B) const
-      {
-        return fCmp.strictlySmaller
-            ((A.GetCenter().*Coord)(), (B.GetCenter().*Coord)());
-      }
+      { return (*this)(A.GetCenter(), B.GetCenter()); }
+    
+    /// Returns whether `A` has a coordinate `Coord` smaller than `B`.
+    bool operator() (geo::Point_t const& A, geo::Point_t const& B) const
+      { return fCmp.strictlySmaller((A.*Coord)(), (B.*Coord)()); }
     
   }; // OpDetGeoCenterCoordComparer
   
@@ -157,10 +170,15 @@ class icarus::PMTsorterStandard {
   /// Sorting criterium according to _z_ coordinate of `geo::OpDetGeo` center.
   OpDetGeoCenterCoordComparer<&geo::Point_t::Z> const fSmallerCenterZ;
   
+  bool const fCachedSortKeys; ///< Whether to sort indices on cached centers.
+  
   
   /// Sorts the `geo::OpDetGeo` assuming they belong to the same plane.
   void sortInPlane(OpDetSpan_t const& opDets) const;
   
+  /// Sorts `opDets` like `sort()` does, on indices with cached centers.
+  void sortWithCachedKeys(std::vector<geo::OpDetGeo>& opDets) const;
+  
 }; // icarus::PMTsorterStandard
 
 
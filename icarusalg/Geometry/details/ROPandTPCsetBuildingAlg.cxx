@@ -25,7 +25,10 @@
 #include <string>
 #include <vector>
 #include <tuple>
+#include <map>
 #include <algorithm> // std::max(), std::transform(), std::stable_sort()
+#include <numeric> // std::iota()
+#include <limits> // std::numeric_limits<>
 #include <utility> // std::move(), std::pair, std::declval()
 #include <type_traits> // std::decay_t
 #include <cmath> // std::abs()
@@ -64,6 +67,23 @@ namespace icarus::details {
   template <typename SetColl> SetColl stableMerge(SetColl const& sets);
 }
 
+/**
+ * @brief Merges all the sets sharing at least one element.
+ * @tparam SetColl type of collection of sets (e.g. a vector of vectors)
+ * 
+ * Sets are joined whenever they share an element, directly or through other
+ * sets (i.e. the result holds the connected components of the input).
+ * The merge is performed in a single pass with a disjoint-set forest, and
+ * its cost is about linear in the total number of elements.
+ * 
+ * The result is stable:
+ * * merged sets are in the order their first input set appears in `sets`;
+ * * within a merged set, elements appear in the order they appear in its
+ *   input sets, with the larger input sets first (and in input order among
+ *   sets of the same size); duplicates are removed.
+ * 
+ * The element type must be less-than comparable.
+ */
 template <typename SetColl>
 class icarus::details::StableMerger {
   
@@ -76,14 +96,8 @@ class icarus::details::StableMerger {
   using Coll_t = typename SetColl_t::value_type;
   using Value_t = typename Coll_t::value_type;
   
-  static bool addNewValue(Coll_t& coll, Value_t const& value);
-  
-  static Coll_t mergeColls(Coll_t const& a, Coll_t const& b);
-  
-  static bool overlap(Coll_t const& a, Coll_t const& b);
-  
-  static SetColl_t mergePass(SetColl_t const& sets);
-  
+  /// Returns the root of the tree including `i` (with path halving).
+  static std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t i);
   
 }; // class icarus::details::StableMerger<>
 
@@ -95,100 +109,86 @@ SetColl icarus::details::stableMerge(SetColl const& sets)
 
 // -----------------------------------------------------------------------------
 template <typename SetColl>
-bool icarus::details::StableMerger<SetColl>::addNewValue
-  (Coll_t& coll, Value_t const& value)
-{
-  if (std::find(coll.begin(), coll.end(), value) != coll.end()) return false;
-  coll.push_back(value);
-  return true;
-} // icarus::details::StableMerger<>::mergeColls()
-
-
-// -----------------------------------------------------------------------------
-template <typename SetColl>
-auto icarus::details::StableMerger<SetColl>::mergeColls
-  (Coll_t const& a, Coll_t const& b) -> Coll_t
-{
-  Coll_t merged;
-  for (Value_t const& value: a) addNewValue(merged, value);
-  for (Value_t const& value: b) addNewValue(merged, value);
-  return merged;
-} // icarus::details::StableMerger<>::mergeColls()
-
-
-// -----------------------------------------------------------------------------
-template <typename SetColl>
-bool icarus::details::StableMerger<SetColl>::overlap
-  (Coll_t const& a, Coll_t const& b)
+std::size_t icarus::details::StableMerger<SetColl>::findRoot
+  (std::vector<std::size_t>& parent, std::size_t i)
 {
-  // brute force since we can't assume ordering
-  for (auto const& aElem: a) {
-    if (std::find(b.begin(), b.end(), aElem) != b.end()) return true;
-  } // for
-  return false;
-} // icarus::details::StableMerger<>::overlap()
+  while (parent[i] != i) i = parent[i] = parent[parent[i]];
+  return i;
+} // icarus::details::StableMerger<>::findRoot()
 
 
 // -----------------------------------------------------------------------------
 template <typename SetColl>
-auto icarus::details::StableMerger<SetColl>::mergePass(SetColl_t const& sets)
+auto icarus::details::StableMerger<SetColl>::merge(SetColl_t const& sets)
   -> SetColl_t
 {
+  std::size_t const nSets = util::size(sets);
+  constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
   
-  SetColl_t mergedSets;
-  for (Coll_t const& set: sets) {
-    
-    //
-    // overlap check
-    //
-    Coll_t* mergeWith = nullptr;
-    for (Coll_t& mergedSet: mergedSets) {
-      if (!overlap(mergedSet, set)) continue;
-      mergeWith = &mergedSet;
-      break;
-    }
-    
-    if (mergeWith) {
-      *mergeWith = (mergeWith->size() < set.size())
-        ? mergeColls(set, *mergeWith)
-        : mergeColls(*mergeWith, set)
-        ;
-    }
-    else {
-      mergedSets.push_back(set);
+  //
+  // 1. join each set with the first set sharing any of its values;
+  //    the root of each tree is always its earliest set
+  //
+  std::vector<std::size_t> parent(nSets);
+  std::iota(parent.begin(), parent.end(), 0U);
+  
+  // for each value: its sequential index and the first set including it
+  std::map<Value_t, std::pair<std::size_t, std::size_t>> valueInfo;
+  for (auto&& [ iSet, set ]: util::enumerate(sets)) {
+    for (Value_t const& value: set) {
+      auto const [ it, newValue ]
+        = valueInfo.try_emplace(value, valueInfo.size(), iSet);
+      if (newValue) continue;
+      std::size_t const rootA = findRoot(parent, it->second.second);
+      std::size_t const rootB = findRoot(parent, iSet);
+      if (rootA < rootB) parent[rootB] = rootA;
+      else if (rootB < rootA) parent[rootA] = rootB;
+    } // for values
+  } // for sets
+  
+  //
+  // 2. collect the members of each group, groups sorted by first appearance
+  //
+  std::vector<std::size_t> groupOfRoot(nSets, NoIndex);
+  std::vector<std::vector<std::size_t>> groupMembers;
+  for (std::size_t iSet = 0; iSet < nSets; ++iSet) {
+    std::size_t& group = groupOfRoot[findRoot(parent, iSet)];
+    if (group == NoIndex) {
+      group = groupMembers.size();
+      groupMembers.emplace_back();
     }
-    
-  } // for input sets
-  return mergedSets;
-} // icarus::details::StableMerger<>::mergePass()
-
-
-// -----------------------------------------------------------------------------
-template <typename SetColl>
-auto icarus::details::StableMerger<SetColl>::merge(SetColl_t const& sets)
-  -> SetColl_t
-{
+    groupMembers[group].push_back(iSet);
+  } // for sets
+  
   //
-  // do merging until no more overlap is detected (i.e. no merge is performed)
-  // (for example, if the sets are {0} {1} {0, 1}, the first pass will merge
-  // {0, 1} with {0} but the resulting sets {0, 1} {1} still overlap
+  // 3. fill each group, larger sets first, skipping the duplicate values
   //
-  SetColl_t mergedSets { sets };
-  std::size_t nSets;
-  do {
-    
-    nSets = mergedSets.size();
-    
-    mergedSets = mergePass(mergedSets);
-    
-  } while (mergedSets.size() != nSets);
+  std::vector<bool> used(valueInfo.size(), false);
+  SetColl_t mergedSets;
+  mergedSets.reserve(groupMembers.size());
+  for (std::vector<std::size_t>& members: groupMembers) {
+    std::stable_sort(members.begin(), members.end(),
+      [&sets](std::size_t a, std::size_t b)
+        { return util::size(sets[a]) > util::size(sets[b]); }
+      );
+    Coll_t merged;
+    for (std::size_t const iSet: members) {
+      for (Value_t const& value: sets[iSet]) {
+        auto const index = valueInfo.find(value)->second.first;
+        if (used[index]) continue;
+        used[index] = true;
+        merged.push_back(value);
+      } // for values
+    } // for sets in the group
+    mergedSets.push_back(std::move(merged));
+  } // for groups
   
   return mergedSets;
 } // icarus::details::StableMerger<SetColl>::merge()
 
 
 // -----------------------------------------------------------------------------
-// ---  icarus::details::StableMerger
+// ---  icarus::details::ROPnumberDispatcher
 // -----------------------------------------------------------------------------
 namespace icarus::details { class ROPnumberDispatcher; }
 
@@ -498,6 +498,7 @@ auto icarus::details::ROPandTPCsetBuildingAlg::groupPlanesAndTPCs
     // readout plane sets
     //
     std::vector<geo::PlaneGeo const*> planes;
+    planes.reserve(cryo.NTPC() * cryo.MaxPlanes());
     for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) {
       for (geo::PlaneGeo const& plane: tpc.IteratePlanes()) {
         planes.push_back(&plane);
@@ -513,6 +514,7 @@ auto icarus::details::ROPandTPCsetBuildingAlg::groupPlanesAndTPCs
     // which makes a lot of sense but complicates the sorting afterwards.
     //
     std::vector<PlaneColl_t> groupedPlanes;
+    groupedPlanes.reserve(protoGroups.size());
     for (PlaneColl_t const& protoGroup: protoGroups) {
       if (protoGroup.empty()) continue;
       PlaneColl_t group;
@@ -690,27 +692,43 @@ auto icarus::details::ROPandTPCsetBuildingAlg::groupPlanesIntoROPs(
   unsigned int nErrors = 0U; // count errors, then bail out at the end
   // we still don't know the maximum number of ROPs in a TPC set
   MaxROPs = 0U;
+  constexpr auto NoTPCset = std::numeric_limits<std::size_t>::max();
   for (auto&& [ c, ROPs ]: util::enumerate(AllPlanesInROPs)) {
     // find which TPC set number each ROP belongs to;
-    // brute force approach: check the content of each TPC set until we find
-    // one that matched; then we are happy.
-    // We assume that each ROP has one plane from *each* of the TPC's in a set.
+    // TPC sets are disjoint after merging, so we can index the set of each TPC
+    // and then look up the one of the first TPC of the ROP; we also check that
+    // all the other TPCs in the ROP are in the same set.
     geo::CryostatGeo const& cryo = Cryostats[c];
     std::vector<std::vector<geo::TPCID>> const& TPCsets = AllTPCsOnROPs[c];
-    for (std::vector<geo::PlaneGeo const*>& ROPplanes: ROPs) {
-      std::vector<geo::TPCID> const ROPTPCIDs = extractTPCIDs(ROPplanes);
+    
+    std::vector<std::size_t> TPCsetOfTPC(cryo.NTPC(), NoTPCset);
+    for (auto&& [ s, TPCset ]: util::enumerate(TPCsets))
+      for (geo::TPCID const& tpcid: TPCset) TPCsetOfTPC[tpcid.TPC] = s;
+    
+    auto TPCsetOf = [&TPCsetOfTPC](geo::PlaneGeo const* plane)
+      {
+        auto const t = plane->ID().TPC;
+        if (t >= TPCsetOfTPC.size()) return NoTPCset;
+        return TPCsetOfTPC[t];
+      };
+    
+    // first pass: assign a TPC set to each ROP, and count them
+    std::vector<std::size_t> ROPsets;
+    ROPsets.reserve(ROPs.size());
+    std::vector<unsigned int> nROPsInSet(TPCsets.size(), 0U);
+    for (std::vector<geo::PlaneGeo const*> const& ROPplanes: ROPs) {
       
-      // find the TPC set
-      readout::TPCsetID tpcsetid; // destination set, invalid by default
-      for (auto&& [ s, TPCset ]: util::enumerate(TPCsets)) {
-        // here is where we assume the ROP has one plane per TOC in the TPC set;
-        // we are also gambling that the order is the same
-        if (!isROPinTPCset(ROPTPCIDs, TPCset)) continue;
-        tpcsetid = { cryo.ID(), static_cast<readout::TPCsetID::TPCsetID_t>(s) };
+      // find the TPC set; with no planes, the first set (if any) is taken
+      std::size_t iSet = ROPplanes.empty()
+        ? (TPCsets.empty()? NoTPCset: 0U): TPCsetOf(ROPplanes.front());
+      for (geo::PlaneGeo const* plane: ROPplanes) {
+        if (TPCsetOf(plane) == iSet) continue;
+        iSet = NoTPCset;
         break;
-      } // for all sets
+      }
+      ROPsets.push_back(iSet);
       
-      if (!tpcsetid) { // long error message to help debugging
+      if (iSet == NoTPCset) { // long error message to help debugging
         mf::LogError log(fLogCategory);
         log << "Candidate ROP did not match any TPC set.";
         log << "\nROP planes:";
@@ -727,13 +745,25 @@ auto icarus::details::ROPandTPCsetBuildingAlg::groupPlanesIntoROPs(
         continue;
       } // if no TPC set matched
       
-      // we have found the (first) TPC set matching the set of TPCs in ROP;
-      // we store (move) the information into the proper cell
-      auto& TPCsetROPs = PlanesInProtoROPs[tpcsetid];
-      TPCsetROPs.push_back(std::move(ROPplanes));
-      MaxROPs = std::max(MaxROPs, static_cast<unsigned int>(TPCsetROPs.size()));
+      ++nROPsInSet[iSet];
       
-    } // for TPC sets
+    } // for ROPs
+    
+    // second pass: reserve and store (move) the information into the cells
+    for (auto&& [ s, nROPs ]: util::enumerate(nROPsInSet)) {
+      PlanesInProtoROPs
+        [{ cryo.ID(), static_cast<readout::TPCsetID::TPCsetID_t>(s) }]
+        .reserve(nROPs);
+      MaxROPs = std::max(MaxROPs, nROPs);
+    }
+    for (auto&& [ iROP, ROPplanes ]: util::enumerate(ROPs)) {
+      std::size_t const iSet = ROPsets[iROP];
+      if (iSet == NoTPCset) continue;
+      readout::TPCsetID const tpcsetid
+        { cryo.ID(), static_cast<readout::TPCsetID::TPCsetID_t>(iSet) };
+      PlanesInProtoROPs[tpcsetid].push_back(std::move(ROPplanes));
+    } // for ROPs
+    
   } // for cryostats
   
   AllPlanesInROPs.clear(); // we have already depleted it anyway
@@ -1107,24 +1137,4 @@ icarus::details::ROPandTPCsetBuildingAlg::ROPnumberFromPlanes
 } // icarus::details::ROPandTPCsetBuildingAlg::ROPnumberFromPlanes()
 
 
-// -----------------------------------------------------------------------------
-bool icarus::details::ROPandTPCsetBuildingAlg::isROPinTPCset(
-  std::vector<geo::TPCID> const& ROPTPCIDs,
-  std::vector<geo::TPCID> const& TPCsetTPCIDs
-) {
-  
-  for (geo::TPCID const& ROPTPC: ROPTPCIDs) {
-    bool found = false;
-    for (geo::TPCID const& TPC: TPCsetTPCIDs) {
-      if (TPC != ROPTPC) continue;
-      found = true;
-      break;
-    } // for all TPCs in set
-    if (found) continue;
-    return false;
-  } // for all TPCs in ROP
-  return true;
-} // icarus::details::ROPandTPCsetBuildingAlg::isROPinTPCset()
-
-
 // ----------------------------------------------------------------------------
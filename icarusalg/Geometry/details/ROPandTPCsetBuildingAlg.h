@@ -68,6 +68,16 @@ namespace icarus::details {
  * Readout planes closer to the cathode have lower ID.
  * 
  * 
+ * Assignment of TPC sets
+ * -----------------------
+ * 
+ * The TPCs spanned by each candidate readout plane are collected, and all the
+ * candidates sharing any TPC are merged into the same TPC set.
+ * The merge happens in a single pass, and each readout plane candidate is then
+ * assigned to its TPC set by direct lookup of its TPCs, so that the cost of
+ * the algorithm grows about linearly with the number of wire planes.
+ * 
+ * 
  * Algorithm workflow
  * ===================
  * 
@@ -384,13 +394,6 @@ class icarus::details::ROPandTPCsetBuildingAlg {
     (std::vector<geo::PlaneGeo const*> const& planes);
   
   
-  /// Returns whether all the TPCs covered by a ROP are in a given TPC set.
-  static bool isROPinTPCset(
-    std::vector<geo::TPCID> const& ROPTPCIDs,
-    std::vector<geo::TPCID> const& TPCsetTPCIDs
-    );
-  
-  
   /**
    * @brief Returns ROP number matching the plane number shared by all `planes`.
    * @return a ROP number, or `readout::ROPID::getInvalidID()` on failure
@@ -0,0 +1,147 @@
+/**
+ * @file   icarusalg/Geometry/details/WireCoordinateProjection.h
+ * @brief  Cached linear projection of points into wire plane coordinates.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_GEOMETRY_DETAILS_WIRECOORDINATEPROJECTION_H
+#define ICARUSALG_GEOMETRY_DETAILS_WIRECOORDINATEPROJECTION_H
+
+
+// LArSoft libraries
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::WireID
+
+// C/C++ standard libraries
+#include <cmath> // std::floor()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::details { struct WireCoordinateProjection; }
+
+/**
+ * @brief Affine map from a point in space to the wire coordinate of a plane.
+ *
+ * The wire coordinate of a point on a wire plane (as in
+ * `geo::PlaneGeo::WireCoordinate()`) is a linear function of the position of
+ * the point, which can be written as `offset + dx x + dy y + dz z`.
+ * This object caches the coefficients of that function, so that projections
+ * can be computed without virtual calls and without going through the
+ * geometry object.
+ *
+ * All the batch member functions take plain arrays, receive the number of
+ * points and write into a preallocated output array: their loops carry no
+ * dependency between iterations and are suitable for auto-vectorization.
+ *
+ * The projection is exact as long as the wires of the plane are straight and
+ * parallel, as the ones in LArSoft geometry always are.
+ */
+struct icarus::details::WireCoordinateProjection {
+
+  using WireNo_t = geo::WireID::WireID_t; ///< Type of wire number.
+
+  /// Wire number assigned to points outside of the plane.
+  static constexpr WireNo_t InvalidWire = geo::WireID::InvalidID;
+
+  double offset = 0.0; ///< Wire coordinate at the origin.
+  double dx = 0.0; ///< Change of wire coordinate per unit of _x_.
+  double dy = 0.0; ///< Change of wire coordinate per unit of _y_.
+  double dz = 0.0; ///< Change of wire coordinate per unit of _z_.
+
+  /// Wire coordinate at _x_ of the plane center, for _(y, z)_ projections.
+  double offsetYZ = 0.0;
+
+  unsigned int nWires = 0U; ///< Number of wires on the plane.
+
+
+  /// Returns whether the projection has been set up.
+  constexpr bool isValid() const { return nWires > 0U; }
+
+
+  // --- BEGIN -- Single point -------------------------------------------------
+  /// Returns the wire coordinate of `point`.
+  double wireCoordinate(geo::Point_t const& point) const
+    { return offset + dx * point.X() + dy * point.Y() + dz * point.Z(); }
+
+  /// Returns the wire coordinate of the point at `(y, z)` on the plane.
+  constexpr double wireCoordinate(double y, double z) const
+    { return offsetYZ + dy * y + dz * z; }
+
+  /// Returns the number of the wire closest to the specified coordinate,
+  /// `InvalidWire` if out of the plane.
+  WireNo_t nearestWire(double wireCoord) const
+    {
+      double const w = std::floor(wireCoord + 0.5);
+      return ((w >= 0.0) && (w < nWires))
+        ? static_cast<WireNo_t>(w): InvalidWire;
+    }
+  // --- END -- Single point ---------------------------------------------------
+
+
+  // --- BEGIN -- Batch --------------------------------------------------------
+  /// Writes in `coords` the wire coordinates of the `n` points
+  /// `(YPos[i], ZPos[i])`.
+  void wireCoordinates
+    (std::size_t n, double const* YPos, double const* ZPos, double* coords)
+    const
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        coords[i] = offsetYZ + dy * YPos[i] + dz * ZPos[i];
+    }
+
+  /// Writes in `coords` the wire coordinates of the `n` `points`.
+  void wireCoordinates
+    (std::size_t n, geo::Point_t const* points, double* coords) const
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        coords[i] = wireCoordinate(points[i]);
+    }
+
+  /// Writes in `wires` the number of the wire closest to each of the `n`
+  /// points `(YPos[i], ZPos[i])` (`InvalidWire` if out of the plane).
+  void nearestWires
+    (std::size_t n, double const* YPos, double const* ZPos, WireNo_t* wires)
+    const
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        wires[i] = nearestWire(wireCoordinate(YPos[i], ZPos[i]));
+    }
+
+  /// Writes in `wires` the number of the wire closest to each of the `n`
+  /// `points` (`InvalidWire` if out of the plane).
+  void nearestWires
+    (std::size_t n, geo::Point_t const* points, WireNo_t* wires) const
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        wires[i] = nearestWire(wireCoordinate(points[i]));
+    }
+  // --- END -- Batch ----------------------------------------------------------
+
+
+  /// Extracts the projection from the specified wire `plane`.
+  static WireCoordinateProjection fromPlane(geo::PlaneGeo const& plane)
+    {
+      // the wire coordinate is affine: sample it at the origin and one unit
+      // away along each axis
+      double const c0 = plane.WireCoordinate(geo::Point_t{ 0.0, 0.0, 0.0 });
+      WireCoordinateProjection proj;
+      proj.offset = c0;
+      proj.dx = plane.WireCoordinate(geo::Point_t{ 1.0, 0.0, 0.0 }) - c0;
+      proj.dy = plane.WireCoordinate(geo::Point_t{ 0.0, 1.0, 0.0 }) - c0;
+      proj.dz = plane.WireCoordinate(geo::Point_t{ 0.0, 0.0, 1.0 }) - c0;
+      proj.offsetYZ = c0 + proj.dx * plane.GetCenter().X();
+      proj.nWires = plane.Nwires();
+      return proj;
+    } // fromPlane()
+
+}; // icarus::details::WireCoordinateProjection
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_DETAILS_WIRECOORDINATEPROJECTION_H
@@ -0,0 +1,230 @@
+/**
+ * @file   icarusalg/Geometry/details/WireGeometryTable.cxx
+ * @brief  Flat tables of the position and extent of all wires
+ *         (implementation file).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/details/WireGeometryTable.h`
+ */
+
+// library header
+#include "icarusalg/Geometry/details/WireGeometryTable.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max(), std::swap()
+#include <cmath> // std::abs(), std::ceil(), std::floor()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+  
+  /// Tolerance on wire coordinates when selecting wire ranges [wire pitches]
+  constexpr double WireCoordinateTolerance = 1e-9;
+  
+  /// Wires with directions closer than this are considered parallel.
+  constexpr double ParallelTolerance = 1e-9;
+  
+  
+  /**
+   * @brief Clips the parameter range of a segment to a slab of space.
+   * @param c coordinate of the center of the segment
+   * @param d component of the direction of the segment
+   * @param lo lower bound of the slab
+   * @param hi upper bound of the slab
+   * @param[in,out] s0 lower bound of the segment parameter
+   * @param[in,out] s1 upper bound of the segment parameter
+   * @return whether any part of the segment is still within the slab
+   */
+  bool clipToSlab
+    (double c, double d, double lo, double hi, double& s0, double& s1)
+  {
+    if (d == 0.0) return (c >= lo) && (c <= hi);
+    double a = (lo - c) / d;
+    double b = (hi - c) / d;
+    if (a > b) std::swap(a, b);
+    s0 = std::max(s0, a);
+    s1 = std::min(s1, b);
+    return s0 <= s1;
+  } // clipToSlab()
+  
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::details::WireGeometryTable::intersect(
+  std::size_t n, geo::WireID const* wires1, geo::WireID const* wires2,
+  double* y, double* z, std::uint8_t* crossing
+) const {
+  std::size_t nCrossing = 0U;
+  for (std::size_t i = 0; i < n; ++i) {
+    y[i] = z[i] = 0.0;
+    bool const crosses = intersect(wires1[i], wires2[i], y[i], z[i]);
+    crossing[i] = crosses? 1: 0;
+    if (crosses) ++nCrossing;
+  } // for
+  return nCrossing;
+} // icarus::details::WireGeometryTable::intersect(n)
+
+
+// -----------------------------------------------------------------------------
+auto icarus::details::WireGeometryTable::wireRangeInBox(
+  geo::PlaneID const& pid,
+  double minY, double maxY, double minZ, double maxZ
+) const -> WireRange_t {
+  
+  if (!hasPlane(pid)) return { 0U, 0U };
+  
+  PlaneInfo_t const& info = plane(pid);
+  
+  // the wire coordinate is linear: its extremes are on the corners of the box
+  double const cY1 = (minY - info.refY) * info.pitchDirY;
+  double const cY2 = (maxY - info.refY) * info.pitchDirY;
+  double const cZ1 = (minZ - info.refZ) * info.pitchDirZ;
+  double const cZ2 = (maxZ - info.refZ) * info.pitchDirZ;
+  double const minCoord
+    = std::min(cY1, cY2) + std::min(cZ1, cZ2) - WireCoordinateTolerance;
+  double const maxCoord
+    = std::max(cY1, cY2) + std::max(cZ1, cZ2) + WireCoordinateTolerance;
+  
+  double const lastWire = info.nWires - 1U;
+  if ((maxCoord < 0.0) || (minCoord > lastWire) || (minY > maxY)
+    || (minZ > maxZ)
+  ) {
+    return { 0U, 0U };
+  }
+  
+  auto const first
+    = static_cast<WireNo_t>(std::ceil(std::max(minCoord, 0.0)));
+  auto const last
+    = static_cast<WireNo_t>(std::floor(std::min(maxCoord, lastWire)));
+  return (first <= last)
+    ? WireRange_t{ first, last + 1U }: WireRange_t{ first, first };
+  
+} // icarus::details::WireGeometryTable::wireRangeInBox()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::details::WireGeometryTable::wiresCrossingBox(
+  geo::PlaneID const& pid,
+  double minY, double maxY, double minZ, double maxZ,
+  std::vector<WireNo_t>& wires
+) const {
+  
+  wires.clear();
+  
+  auto const [ first, end ] = wireRangeInBox(pid, minY, maxY, minZ, maxZ);
+  if (first == end) return 0U;
+  
+  std::size_t const firstIndex = plane(pid).firstWire;
+  for (WireNo_t w = first; w < end; ++w) {
+    std::size_t const i = firstIndex + w;
+    double s0 = -fHalfLength[i], s1 = fHalfLength[i];
+    if (!clipToSlab(fCenterY[i], fDirY[i], minY, maxY, s0, s1)) continue;
+    if (!clipToSlab(fCenterZ[i], fDirZ[i], minZ, maxZ, s0, s1)) continue;
+    wires.push_back(w);
+  } // for
+  
+  return wires.size();
+} // icarus::details::WireGeometryTable::wiresCrossingBox()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::WireGeometryTable::resize
+  (unsigned int nCryostats, unsigned int maxTPCs, unsigned int maxPlanes)
+{
+  fNCryostats = nCryostats;
+  fMaxTPCs = maxTPCs;
+  fMaxPlanes = maxPlanes;
+  fPlanes.assign(std::size_t(nCryostats) * maxTPCs * maxPlanes, PlaneInfo_t{});
+  fLastPlane = NoPlane;
+} // icarus::details::WireGeometryTable::resize()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::WireGeometryTable::reserve(std::size_t nWires) {
+  for (auto* v: { &fCenterX, &fCenterY, &fCenterZ, &fDirX, &fDirY, &fDirZ })
+    v->reserve(nWires);
+  fHalfLength.reserve(nWires);
+} // icarus::details::WireGeometryTable::reserve()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::WireGeometryTable::addPlane
+  (geo::PlaneID const& pid, double pitch, geo::Vector_t increasingWireDir)
+{
+  assert(pid.Cryostat < fNCryostats);
+  assert(pid.TPC < fMaxTPCs);
+  assert(pid.Plane < fMaxPlanes);
+  assert(pitch > 0.0);
+  
+  fLastPlane = planeIndex(pid);
+  PlaneInfo_t& info = fPlanes[fLastPlane];
+  info = {};
+  info.firstWire = nWires();
+  info.pitch = pitch;
+  info.pitchDirY = increasingWireDir.Y() / pitch;
+  info.pitchDirZ = increasingWireDir.Z() / pitch;
+  
+} // icarus::details::WireGeometryTable::addPlane()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::WireGeometryTable::addWire
+  (geo::Point_t const& center, geo::Vector_t const& dir, double halfLength)
+{
+  assert(fLastPlane != NoPlane);
+  
+  PlaneInfo_t& info = fPlanes[fLastPlane];
+  if (info.nWires++ == 0U) {
+    info.refY = center.Y();
+    info.refZ = center.Z();
+  }
+  
+  fCenterX.push_back(center.X());
+  fCenterY.push_back(center.Y());
+  fCenterZ.push_back(center.Z());
+  fDirX.push_back(dir.X());
+  fDirY.push_back(dir.Y());
+  fDirZ.push_back(dir.Z());
+  fHalfLength.push_back(halfLength);
+  
+} // icarus::details::WireGeometryTable::addWire()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::WireGeometryTable::clear() {
+  fNCryostats = fMaxTPCs = fMaxPlanes = 0U;
+  fPlanes.clear();
+  fLastPlane = NoPlane;
+  for (auto* v: { &fCenterX, &fCenterY, &fCenterZ, &fDirX, &fDirY, &fDirZ })
+    v->clear();
+  fHalfLength.clear();
+} // icarus::details::WireGeometryTable::clear()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::details::WireGeometryTable::intersectAt
+  (std::size_t i1, std::size_t i2, double& y, double& z) const
+{
+  /*
+   * Solves on the (y, z) plane `c1 + s d1 = c2 + t d2`;
+   * the wires cross if `|s|` and `|t|` are within their half lengths.
+   */
+  double const d1y = fDirY[i1], d1z = fDirZ[i1];
+  double const d2y = fDirY[i2], d2z = fDirZ[i2];
+  double const det = d2y * d1z - d1y * d2z;
+  if (std::abs(det) < ParallelTolerance) return false;
+  
+  double const dy = fCenterY[i2] - fCenterY[i1];
+  double const dz = fCenterZ[i2] - fCenterZ[i1];
+  double const s = (d2y * dz - d2z * dy) / det;
+  double const t = (d1y * dz - d1z * dy) / det;
+  
+  y = fCenterY[i1] + s * d1y;
+  z = fCenterZ[i1] + s * d1z;
+  return (std::abs(s) <= fHalfLength[i1]) && (std::abs(t) <= fHalfLength[i2]);
+  
+} // icarus::details::WireGeometryTable::intersectAt()
+
+
+// -----------------------------------------------------------------------------
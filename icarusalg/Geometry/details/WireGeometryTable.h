@@ -0,0 +1,337 @@
+/**
+ * @file   icarusalg/Geometry/details/WireGeometryTable.h
+ * @brief  Flat tables of the position and extent of all wires.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Geometry/details/WireGeometryTable.cxx`
+ */
+
+#ifndef ICARUSALG_GEOMETRY_DETAILS_WIREGEOMETRYTABLE_H
+#define ICARUSALG_GEOMETRY_DETAILS_WIREGEOMETRYTABLE_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t ...
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::details::WireGeometryTable
+// -----------------------------------------------------------------------------
+namespace icarus::details { class WireGeometryTable; }
+/**
+ * @brief Position, direction, length and pitch of all the wires, in arrays.
+ *
+ * The table stores for each wire its center, its direction and its half
+ * length, each coordinate in its own contiguous array (structure of arrays).
+ * Wires are stored plane by plane, in the order of the plane ID (cryostat,
+ * TPC, plane) and within each plane in order of wire number: this is also
+ * the order of the channels of each plane in `icarus::ICARUSChannelMapAlg`.
+ * Each plane also records its wire pitch and the direction of increasing
+ * wire number.
+ *
+ * On top of the plain accessors, two queries are provided which 3D hit
+ * matching performs in bulk, without going through `geo::PlaneGeo`,
+ * `geo::WireGeo` and their ROOT transformations:
+ * * `intersect()`: the point where two wires from different planes of the same
+ *   TPC cross, projected on the _(y, z)_ plane;
+ * * `wiresCrossingBox()`: the wires of a plane which cross a box; since wires
+ *   of a plane are parallel, only the wires with wire coordinate within the
+ *   projection of the box are tested, and of them only the ones whose
+ *   segment (which may be short, as for the split induction wires of ICARUS)
+ *   actually overlaps the box are reported.
+ *
+ * All the queries work in the _(y, z)_ projection, i.e. along the drift
+ * direction _x_, which is the only one wire planes can't tell apart.
+ * Queries on planes or wires that are not in the table have undefined result,
+ * unless their documentation states otherwise.
+ *
+ * The table is filled one plane at a time, in plane ID order:
+ * ~~~~{.cpp}
+ * icarus::details::WireGeometryTable table;
+ * table.resize(nCryostats, maxTPCs, maxPlanes);
+ * for (geo::PlaneGeo const& plane: ...) {
+ *   table.addPlane
+ *     (plane.ID(), plane.WirePitch(), plane.GetIncreasingWireDirection());
+ *   for (geo::WireGeo const& wire: plane.IterateWires())
+ *     table.addWire(wire.GetCenter(), wire.Direction(), wire.HalfL());
+ * }
+ * ~~~~
+ */
+class icarus::details::WireGeometryTable {
+
+    public:
+
+  using WireNo_t = geo::WireID::WireID_t; ///< Type of wire number.
+
+  /// Range of wire numbers (`first` included, `second` excluded).
+  using WireRange_t = std::pair<WireNo_t, WireNo_t>;
+
+
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query
+  /// @{
+
+  /// Returns whether the table has no wire.
+  bool empty() const { return fHalfLength.empty(); }
+
+  /// Returns the total number of wires in the table.
+  std::size_t nWires() const { return fHalfLength.size(); }
+
+  /// Returns whether the plane `pid` is in the table.
+  bool hasPlane(geo::PlaneID const& pid) const
+    {
+      return pid && (pid.Cryostat < fNCryostats) && (pid.TPC < fMaxTPCs)
+        && (pid.Plane < fMaxPlanes) && (plane(pid).nWires > 0U);
+    }
+
+  /// Returns the number of wires on plane `pid`.
+  unsigned int nWires(geo::PlaneID const& pid) const
+    { return plane(pid).nWires; }
+
+  /// Returns the wire pitch of plane `pid`.
+  double pitch(geo::PlaneID const& pid) const { return plane(pid).pitch; }
+
+  /// Returns the index of the wire `wid` in the table arrays.
+  std::size_t wireIndex(geo::WireID const& wid) const
+    {
+      assert(wid.Wire < nWires(wid));
+      return plane(wid).firstWire + wid.Wire;
+    }
+
+  /// Returns the center of wire `wid`.
+  geo::Point_t wireCenter(geo::WireID const& wid) const
+    {
+      std::size_t const i = wireIndex(wid);
+      return { fCenterX[i], fCenterY[i], fCenterZ[i] };
+    }
+
+  /// Returns the direction of wire `wid` (unit vector).
+  geo::Vector_t wireDirection(geo::WireID const& wid) const
+    {
+      std::size_t const i = wireIndex(wid);
+      return { fDirX[i], fDirY[i], fDirZ[i] };
+    }
+
+  /// Returns half the length of wire `wid`.
+  double halfLength(geo::WireID const& wid) const
+    { return fHalfLength[wireIndex(wid)]; }
+
+  /// Returns the wire coordinate of the point `(y, z)` on plane `pid`.
+  double wireCoordinate(geo::PlaneID const& pid, double y, double z) const
+    {
+      PlaneInfo_t const& info = plane(pid);
+      return
+        (y - info.refY) * info.pitchDirY + (z - info.refZ) * info.pitchDirZ;
+    }
+
+  /// @}
+  // --- END -- Query ----------------------------------------------------------
+
+
+  // --- BEGIN -- Arrays -------------------------------------------------------
+  /**
+   * @name Arrays
+   *
+   * Direct access to the arrays, with `nWires()` elements each.
+   * The index of a wire is `wireIndex()`.
+   */
+  /// @{
+
+  double const* centerX() const { return fCenterX.data(); }
+  double const* centerY() const { return fCenterY.data(); }
+  double const* centerZ() const { return fCenterZ.data(); }
+  double const* directionX() const { return fDirX.data(); }
+  double const* directionY() const { return fDirY.data(); }
+  double const* directionZ() const { return fDirZ.data(); }
+  double const* halfLength() const { return fHalfLength.data(); }
+
+  /// @}
+  // --- END -- Arrays ---------------------------------------------------------
+
+
+  // --- BEGIN -- Intersections ------------------------------------------------
+  /// @name Intersections
+  /// @{
+
+  /**
+   * @brief Computes where two wires cross, on the _(y, z)_ plane.
+   * @param wid1 one of the wires
+   * @param wid2 the other wire
+   * @param[out] y _y_ coordinate of the crossing point
+   * @param[out] z _z_ coordinate of the crossing point
+   * @return whether the two wire segments cross
+   *
+   * If the wires are parallel, `false` is returned and `y` and `z` are left
+   * unchanged. If the lines of the two wires cross outside either of the
+   * segments, `false` is returned but `y` and `z` are still set to the crossing
+   * point of the lines.
+   */
+  bool intersect
+    (geo::WireID const& wid1, geo::WireID const& wid2, double& y, double& z)
+    const
+    { return intersectAt(wireIndex(wid1), wireIndex(wid2), y, z); }
+
+  /**
+   * @brief Computes where `n` pairs of wires cross, on the _(y, z)_ plane.
+   * @param n number of wire pairs
+   * @param wires1 the first wire of each pair
+   * @param wires2 the second wire of each pair
+   * @param[out] y _y_ coordinate of each crossing point
+   * @param[out] z _z_ coordinate of each crossing point
+   * @param[out] crossing whether each pair of wires cross (`1`) or not (`0`)
+   * @return the number of pairs of wires which cross
+   * @see `intersect()`
+   *
+   * All output arrays must have room for `n` elements.
+   * Coordinates of pairs of parallel wires are set to `0`.
+   */
+  std::size_t intersect(
+    std::size_t n, geo::WireID const* wires1, geo::WireID const* wires2,
+    double* y, double* z, std::uint8_t* crossing
+    ) const;
+
+  /**
+   * @brief Returns the wires of plane `pid` within the projection of a box.
+   * @param pid the wire plane
+   * @param minY lower _y_ coordinate of the box
+   * @param maxY upper _y_ coordinate of the box
+   * @param minZ lower _z_ coordinate of the box
+   * @param maxZ upper _z_ coordinate of the box
+   * @return range of wire numbers, empty if none
+   *
+   * The wires in the range are the ones whose line crosses the box; the
+   * segments of some of them might not reach it (`wiresCrossingBox()` tells
+   * which ones do). An empty range is returned if `pid` is not in the table.
+   */
+  WireRange_t wireRangeInBox(
+    geo::PlaneID const& pid,
+    double minY, double maxY, double minZ, double maxZ
+    ) const;
+
+  /**
+   * @brief Finds the wires of plane `pid` crossing a box.
+   * @param pid the wire plane
+   * @param minY lower _y_ coordinate of the box
+   * @param maxY upper _y_ coordinate of the box
+   * @param minZ lower _z_ coordinate of the box
+   * @param maxZ upper _z_ coordinate of the box
+   * @param[out] wires the wire numbers crossing the box, in increasing order
+   * @return the number of wires crossing the box
+   *
+   * The content of `wires` is replaced; reusing the same vector for many
+   * queries avoids memory allocations. Wires just touching the box are
+   * included. No wire is returned if `pid` is not in the table.
+   */
+  std::size_t wiresCrossingBox(
+    geo::PlaneID const& pid,
+    double minY, double maxY, double minZ, double maxZ,
+    std::vector<WireNo_t>& wires
+    ) const;
+
+  /// Finds the wires of plane `pid` crossing the `box`
+  /// (like `geo::BoxBoundedGeo`).
+  template <typename Box>
+  std::size_t wiresCrossingBox
+    (geo::PlaneID const& pid, Box const& box, std::vector<WireNo_t>& wires)
+    const
+    {
+      return wiresCrossingBox
+        (pid, box.MinY(), box.MaxY(), box.MinZ(), box.MaxZ(), wires);
+    }
+
+  /// @}
+  // --- END -- Intersections --------------------------------------------------
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Prepares the table for the specified maximum number of planes.
+  void resize
+    (unsigned int nCryostats, unsigned int maxTPCs, unsigned int maxPlanes);
+
+  /// Prepares memory for the specified number of wires.
+  void reserve(std::size_t nWires);
+
+  /**
+   * @brief Starts a new plane; its wires are added next with `addWire()`.
+   * @param pid ID of the plane
+   * @param pitch the distance between consecutive wires
+   * @param increasingWireDir direction of increasing wire number (unit vector)
+   */
+  void addPlane
+    (geo::PlaneID const& pid, double pitch, geo::Vector_t increasingWireDir);
+
+  /// Adds the next wire to the last added plane.
+  void addWire
+    (geo::Point_t const& center, geo::Vector_t const& dir, double halfLength);
+
+  /// Resets the table to like just constructed.
+  void clear();
+
+  /// @}
+  // --- END -- Filling --------------------------------------------------------
+
+
+    private:
+
+  /// Value of plane index meaning no plane.
+  static constexpr std::size_t NoPlane = ~std::size_t{ 0 };
+
+  /// Information about a single plane.
+  struct PlaneInfo_t {
+    std::size_t firstWire = 0U; ///< Index of the first wire of the plane.
+    unsigned int nWires = 0U; ///< Number of wires.
+    double pitch = 0.0; ///< Wire pitch.
+    /// Direction of increasing wire number, divided by the pitch.
+    double pitchDirY = 0.0, pitchDirZ = 0.0;
+    double refY = 0.0, refZ = 0.0; ///< Center of the first wire.
+  }; // PlaneInfo_t
+
+  unsigned int fNCryostats = 0U; ///< Number of cryostats.
+  unsigned int fMaxTPCs = 0U; ///< Largest number of TPCs in a cryostat.
+  unsigned int fMaxPlanes = 0U; ///< Largest number of planes in a TPC.
+
+  std::vector<PlaneInfo_t> fPlanes; ///< Information of each plane.
+
+  /// Index of the plane being filled (none if `NoPlane`).
+  std::size_t fLastPlane = NoPlane;
+
+  std::vector<double> fCenterX; ///< _x_ coordinate of the wire centers.
+  std::vector<double> fCenterY; ///< _y_ coordinate of the wire centers.
+  std::vector<double> fCenterZ; ///< _z_ coordinate of the wire centers.
+  std::vector<double> fDirX; ///< _x_ component of the wire directions.
+  std::vector<double> fDirY; ///< _y_ component of the wire directions.
+  std::vector<double> fDirZ; ///< _z_ component of the wire directions.
+  std::vector<double> fHalfLength; ///< Half length of the wires.
+
+
+  /// Returns the index of plane `pid` in `fPlanes`.
+  std::size_t planeIndex(geo::PlaneID const& pid) const
+    {
+      return
+        (static_cast<std::size_t>(pid.Cryostat) * fMaxTPCs + pid.TPC)
+        * fMaxPlanes + pid.Plane;
+    }
+
+  /// Returns the information about plane `pid`.
+  PlaneInfo_t const& plane(geo::PlaneID const& pid) const
+    { return fPlanes[planeIndex(pid)]; }
+
+  /// Implementation of `intersect()` on wire indices.
+  bool intersectAt(std::size_t i1, std::size_t i2, double& y, double& z) const;
+
+}; // class icarus::details::WireGeometryTable
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GEOMETRY_DETAILS_WIREGEOMETRYTABLE_H
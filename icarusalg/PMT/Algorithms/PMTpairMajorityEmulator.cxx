@@ -0,0 +1,301 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.cxx
+ * @brief  Emulation of a majority trigger on sums of PMT pair waveforms.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.h
+ */
+
+// library header
+#include "icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::fill(), std::copy(), std::max(), std::min()
+#include <utility> // std::move(), std::swap()
+#include <cmath> // std::lround()
+
+
+//------------------------------------------------------------------------------
+//---  opdet::PMTpairMajorityEmulator
+//------------------------------------------------------------------------------
+opdet::PMTpairMajorityEmulator::PMTpairMajorityEmulator(Params_t params)
+  : fParams{ std::move(params) }
+{
+  if (fParams.gateTicks == 0U) fParams.gateTicks = 1U;
+  if (fParams.windowStride == 0U) fParams.windowStride = 1U;
+
+  //
+  // assign a row to each channel in a pair
+  //
+  auto const assignRow = [this](Channel_t channel)
+    {
+      if (channel == NoChannel) return;
+      if (channel >= fChannelRows.size())
+        fChannelRows.resize(channel + 1, NoIndex);
+      if (fChannelRows[channel] == NoIndex)
+        fChannelRows[channel] = fNChannelRows++;
+    };
+  for (auto const& [ first, second ]: fParams.pairs) {
+    assignRow(first);
+    assignRow(second);
+  }
+
+  //
+  // sliding windows
+  //
+  std::size_t const nPairs = fParams.pairs.size();
+  fWindowPairs = ((fParams.windowPairs == 0U) || (fParams.windowPairs > nPairs))
+    ? nPairs: fParams.windowPairs;
+  if (nPairs > 0U) {
+    for (std::size_t start = 0U; start + fWindowPairs <= nPairs;
+      start += fParams.windowStride
+    )
+      fWindowStarts.push_back(start);
+  }
+
+} // opdet::PMTpairMajorityEmulator::PMTpairMajorityEmulator()
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTpairMajorityEmulator::standardPairs(std::size_t nChannels)
+  -> std::vector<ChannelPair_t>
+{
+  std::vector<ChannelPair_t> pairs;
+  pairs.reserve((nChannels + 1) / 2);
+  for (std::size_t channel = 0U; channel < nChannels; channel += 2) {
+    pairs.emplace_back(
+      static_cast<Channel_t>(channel),
+      (channel + 1 < nChannels)? static_cast<Channel_t>(channel + 1): NoChannel
+      );
+  }
+  return pairs;
+} // opdet::PMTpairMajorityEmulator::standardPairs()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTpairMajorityEmulator::setup
+  (Time_t startTime, Time_t tickDuration, std::size_t nTicks)
+{
+  fStartTime = startTime;
+  fTickDuration = tickDuration;
+  fNTicks = nTicks;
+  fStride = (nTicks + BlockSize - 1) / BlockSize * BlockSize;
+
+  // assign() keeps the capacity: no allocation after the largest event
+  fChannelSamples.assign(fNChannelRows * fStride, Sample_t{ 0 });
+  fPairSums.assign(nPairs() * fStride, PairSample_t{ 0 });
+  fGates.assign(nPairs() * fStride, Gate_t{ 0 });
+  fGateBuffer.assign(fStride, Gate_t{ 0 });
+  fCumulative.assign((nPairs() + 1) * fStride, Count_t{ 0 });
+  fWindowCounts.assign(nWindows() * fStride, Count_t{ 0 });
+
+} // opdet::PMTpairMajorityEmulator::setup()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTpairMajorityEmulator::addWaveform
+  (raw::OpDetWaveform const& waveform, Sample_t baseline)
+{
+  Channel_t const channel = waveform.ChannelNumber();
+  if (channel >= fChannelRows.size()) return;
+  std::size_t const row = fChannelRows[channel];
+  if (row == NoIndex) return;
+
+  // first tick of the waveform (may be negative, or after the window)
+  long int const firstTick
+    = std::lround((waveform.TimeStamp() - fStartTime) / fTickDuration);
+  long int const nSamples = waveform.size();
+
+  long int const skip = std::max(0L, -firstTick);
+  long int const startTick = firstTick + skip;
+  long int const endTick
+    = std::min<long int>(firstTick + nSamples, fNTicks);
+  if (startTick >= endTick) return;
+
+  Sample_t const* const begin = waveform.data() + skip;
+  Sample_t const* const end = begin + (endTick - startTick);
+  Sample_t* const dest = fChannelSamples.data() + row * fStride + startTick;
+
+  // flip the polarity so that signals are always positive
+  if (fParams.polarity < 0) {
+    icarus::waveform_operations::NegativePolarityOperations<Sample_t>
+      ::subtractBaseline(begin, end, baseline, dest);
+  }
+  else {
+    icarus::waveform_operations::PositivePolarityOperations<Sample_t>
+      ::subtractBaseline(begin, end, baseline, dest);
+  }
+
+} // opdet::PMTpairMajorityEmulator::addWaveform()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTpairMajorityEmulator::addWaveforms(
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  std::vector<Sample_t> const& baselines
+) {
+  for (raw::OpDetWaveform const& waveform: waveforms) {
+    Channel_t const channel = waveform.ChannelNumber();
+    if (channel >= baselines.size()) continue;
+    addWaveform(waveform, baselines[channel]);
+  }
+} // opdet::PMTpairMajorityEmulator::addWaveforms()
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTpairMajorityEmulator::process() -> Result_t {
+
+  sumPairs();
+  openGates();
+  countWindows();
+  return findMajority();
+
+} // opdet::PMTpairMajorityEmulator::process()
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTpairMajorityEmulator::channelSamples(Channel_t channel) const
+  -> Sample_t const*
+{
+  if (channel >= fChannelRows.size()) return nullptr;
+  std::size_t const row = fChannelRows[channel];
+  return (row == NoIndex)? nullptr: fChannelSamples.data() + row * fStride;
+} // opdet::PMTpairMajorityEmulator::channelSamples()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTpairMajorityEmulator::sumPairs() {
+
+  for (std::size_t iPair = 0; iPair < nPairs(); ++iPair) {
+    auto const [ first, second ] = fParams.pairs[iPair];
+    Sample_t const* a = channelSamples(first);
+    Sample_t const* b = channelSamples(second);
+    if (!a) std::swap(a, b);
+    PairSample_t* const sum = fPairSums.data() + iPair * fStride;
+    if (b) {
+      for (std::size_t i = 0; i < fStride; ++i)
+        sum[i] = PairSample_t{ a[i] } + PairSample_t{ b[i] };
+    }
+    else if (a) {
+      for (std::size_t i = 0; i < fStride; ++i) sum[i] = a[i];
+    }
+    else std::fill(sum, sum + fStride, PairSample_t{ 0 });
+  } // for pairs
+
+} // opdet::PMTpairMajorityEmulator::sumPairs()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTpairMajorityEmulator::openGates() {
+
+  PairSample_t const threshold = fParams.threshold;
+  std::size_t const gateTicks = fParams.gateTicks;
+
+  for (std::size_t iPair = 0; iPair < nPairs(); ++iPair) {
+
+    PairSample_t const* const sum = fPairSums.data() + iPair * fStride;
+    Gate_t* gate = fGates.data() + iPair * fStride;
+
+    // discrimination
+    for (std::size_t i = 0; i < fStride; ++i)
+      gate[i] = (sum[i] >= threshold)? 1U: 0U;
+    // padding ticks must not open gates
+    std::fill(gate + fNTicks, gate + fStride, Gate_t{ 0 });
+
+    if (gateTicks == 1U) continue;
+
+    //
+    // the gate at tick `i` is open if the threshold was reached in any of
+    // the `gateTicks` ticks up to `i`: the width of the window is doubled
+    // at each pass (`1`, `2`, `4`, ...) and a last pass combines two
+    // windows of the largest width to get the exact width
+    //
+    Gate_t* buffer = fGateBuffer.data();
+    auto const widenBy = [this,&gate,&buffer](std::size_t shift)
+      {
+        std::size_t const head = std::min(shift, fStride);
+        for (std::size_t i = 0; i < head; ++i) buffer[i] = gate[i];
+        for (std::size_t i = head; i < fStride; ++i)
+          buffer[i] = gate[i] | gate[i - shift];
+        std::swap(gate, buffer);
+      };
+    std::size_t width = 1U;
+    while (2 * width <= gateTicks) {
+      widenBy(width);
+      width *= 2;
+    } // while
+    if (gateTicks > width) widenBy(gateTicks - width);
+
+    // the result may be in the buffer
+    Gate_t* const pairGate = fGates.data() + iPair * fStride;
+    if (gate != pairGate) std::copy(gate, gate + fStride, pairGate);
+
+  } // for pairs
+
+} // opdet::PMTpairMajorityEmulator::openGates()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTpairMajorityEmulator::countWindows() {
+
+  //
+  // cumulative count of open gates: row `p` has the open gates in the pairs
+  // before the `p`-th; row `0` is all zeros
+  //
+  for (std::size_t iPair = 0; iPair < nPairs(); ++iPair) {
+    Count_t const* const before = fCumulative.data() + iPair * fStride;
+    Count_t* const after = fCumulative.data() + (iPair + 1) * fStride;
+    Gate_t const* const gate = pairGates(iPair);
+    for (std::size_t i = 0; i < fStride; ++i)
+      after[i] = before[i] + gate[i];
+  } // for pairs
+
+  for (std::size_t iWindow = 0; iWindow < nWindows(); ++iWindow) {
+    std::size_t const first = fWindowStarts[iWindow];
+    Count_t const* const begin = fCumulative.data() + first * fStride;
+    Count_t const* const end
+      = fCumulative.data() + (first + fWindowPairs) * fStride;
+    Count_t* const counts = fWindowCounts.data() + iWindow * fStride;
+    for (std::size_t i = 0; i < fStride; ++i)
+      counts[i] = end[i] - begin[i];
+  } // for windows
+
+} // opdet::PMTpairMajorityEmulator::countWindows()
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTpairMajorityEmulator::findMajority() const -> Result_t {
+
+  Result_t result;
+  Count_t const majority = static_cast<Count_t>(fParams.majority);
+
+  for (std::size_t iWindow = 0; iWindow < nWindows(); ++iWindow) {
+
+    Count_t const* const begin = windowCounts(iWindow);
+    Count_t const* const end = begin + fNTicks;
+
+    Count_t maxCount = 0U;
+    for (Count_t const* it = begin; it != end; ++it)
+      maxCount = std::max(maxCount, *it);
+    result.maxCount = std::max(result.maxCount, maxCount);
+    if (maxCount < majority) continue;
+
+    // only look before the earliest trigger found so far
+    Count_t const* const searchEnd
+      = result.fired()? begin + result.tick: end;
+    Count_t const* const found
+      = icarus::waveform_operations::details::findFirstIf(begin, searchEnd,
+        [majority](Count_t count){ return count >= majority; }
+        );
+    if (found == searchEnd) continue;
+
+    result.tick = found - begin;
+    result.window = iWindow;
+
+  } // for windows
+
+  return result;
+} // opdet::PMTpairMajorityEmulator::findMajority()
+
+
+//------------------------------------------------------------------------------
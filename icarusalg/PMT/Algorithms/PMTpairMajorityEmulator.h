@@ -0,0 +1,326 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.h
+ * @brief  Emulation of a majority trigger on sums of PMT pair waveforms.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.cxx
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_PMTPAIRMAJORITYEMULATOR_H
+#define ICARUSALG_PMT_ALGORITHMS_PMTPAIRMAJORITYEMULATOR_H
+
+
+// ICARUS libraries
+#include "icarusalg/Utilities/WaveformOperations.h"
+
+// LArSoft libraries
+#include <cstdint>  // uint16_t in OpDetWaveform.h
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::ADC_Count_t, ...
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <string>
+#include <ostream>
+#include <limits>
+#include <cstdint> // std::int32_t, std::uint8_t, std::uint16_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet { class PMTpairMajorityEmulator; }
+/**
+ * @class opdet::PMTpairMajorityEmulator
+ * @brief Emulates a majority trigger on the sum of the waveforms of PMT pairs.
+ *
+ * This algorithm emulates the logic of a trigger based on PMT pairs:
+ *
+ * 1. the waveforms of each channel are placed on a common time axis, starting
+ *    at a chosen time and with a fixed number of ticks, with the baseline
+ *    subtracted and the polarity flipped so that signals are positive
+ *    (missing samples are left at the baseline, i.e. `0`);
+ * 2. the samples of the two PMT of each pair are added;
+ * 3. each pair sum is discriminated against a threshold, and a gate is open
+ *    from each tick the sum reaches the threshold until `gateTicks` ticks
+ *    later;
+ * 4. the pairs are grouped in windows of `windowPairs` consecutive pairs,
+ *    one window starting every `windowStride` pairs (the sliding windows),
+ *    and the number of open gates in each window is counted at each tick;
+ * 5. the trigger fires at the first tick in which any window reaches the
+ *    `majority` level.
+ *
+ * The PMT pairs are chosen at construction. `standardPairs()` pairs channels
+ * with consecutive numbers, which with the standard channel assignment of
+ * `icarus::PMTsorterStandard` are neighbouring PMT on the same wall.
+ *
+ * All the data of a step is kept in channel-, pair- or window-major arrays of
+ * rows, one row per channel (or pair, or window) with all the ticks. The rows
+ * are padded to a multiple of `BlockSize` ticks, so that each step is a plain
+ * loop on whole blocks of contiguous ticks, which compilers vectorize;
+ * the baseline subtraction and the search of the first tick reaching the
+ * majority are the ones from `icarus::waveform_operations`.
+ * The gate opening uses log2(`gateTicks`) vectorizable passes, and the
+ * counts of all the sliding windows are obtained from cumulative counts on
+ * the pairs, with one subtraction per window.
+ *
+ * The object keeps all its memory after each event: reusing the same
+ * emulator for all the events avoids further allocations.
+ * It can't process multiple events at the same time.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * opdet::PMTpairMajorityEmulator::Params_t params;
+ * params.pairs = opdet::PMTpairMajorityEmulator::standardPairs(360U);
+ * params.threshold = 400; // ADC counts above baseline
+ * params.gateTicks = 80U; // 160 ns
+ * params.windowPairs = 6U;
+ * params.windowStride = 3U;
+ * params.majority = 5U;
+ * opdet::PMTpairMajorityEmulator emulator { std::move(params) };
+ *
+ * emulator.setup(-2.0, 0.002, 5000U); // from -2 us, 2 ns ticks, 10 us
+ * emulator.addWaveforms(waveforms, baselines);
+ * opdet::PMTpairMajorityEmulator::Result_t const result = emulator.process();
+ * if (result) std::cout << "Trigger at tick " << result.tick;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class opdet::PMTpairMajorityEmulator {
+    public:
+
+  using Sample_t = raw::ADC_Count_t; ///< Type of waveform sample.
+
+  using PairSample_t = std::int32_t; ///< Type of sum of two samples.
+
+  using Gate_t = std::uint8_t; ///< Type of gate state (`0` is closed).
+
+  using Count_t = std::uint16_t; ///< Type of count of open gates.
+
+  using Channel_t = raw::Channel_t; ///< Type of channel number.
+
+  using Time_t = double; ///< Type of time [&micro;s]
+
+  /// A pair of PMT channels.
+  using ChannelPair_t = std::pair<Channel_t, Channel_t>;
+
+  /// Number of ticks each row is padded to a multiple of.
+  static constexpr std::size_t BlockSize
+    = icarus::waveform_operations::details::SearchBlockSize;
+
+  /// Channel number meaning no channel (second channel of unpaired PMT).
+  static constexpr Channel_t NoChannel = std::numeric_limits<Channel_t>::max();
+
+  /// Value used for no tick and no index.
+  static constexpr std::size_t NoIndex
+    = std::numeric_limits<std::size_t>::max();
+
+
+  /// Algorithm parameters.
+  struct Params_t {
+
+    /// The pairs of PMT channels, in order of the sliding windows.
+    std::vector<ChannelPair_t> pairs;
+
+    /// Polarity of the signal: negative if it develops below baseline.
+    int polarity = -1;
+
+    /// Threshold on the pair sum [ADC counts above the baseline].
+    PairSample_t threshold = 0;
+
+    /// Ticks a gate stays open after the threshold is reached (at least 1).
+    std::size_t gateTicks = 1U;
+
+    /// Number of pairs in each window (`0`: one window with all pairs).
+    std::size_t windowPairs = 0U;
+
+    /// Number of pairs between the first pair of consecutive windows.
+    std::size_t windowStride = 1U;
+
+    /// Number of open gates in a window required to trigger.
+    unsigned int majority = 1U;
+
+    /// Dumps this configuration into the output stream `out`.
+    template <typename Stream>
+    void dump(
+      Stream& out,
+      std::string const& indent, std::string const& firstIndent
+      ) const;
+    template <typename Stream>
+    void dump(Stream& out, std::string const& indent = "") const
+      { dump(out, indent, indent); }
+
+  }; // Params_t
+
+
+  /// Outcome of the emulation.
+  struct Result_t {
+
+    std::size_t tick = NoIndex; ///< First tick reaching majority.
+    std::size_t window = NoIndex; ///< First window reaching majority there.
+    Count_t maxCount = 0U; ///< Largest count in any window and tick.
+
+    /// Returns whether the trigger fired.
+    bool fired() const noexcept { return tick != NoIndex; }
+    operator bool() const noexcept { return fired(); }
+    bool operator!() const noexcept { return !fired(); }
+
+  }; // Result_t
+
+
+  /// Constructor: sets the parameters of the emulation.
+  explicit PMTpairMajorityEmulator(Params_t params);
+
+
+  /// Returns the pairs `(0, 1)`, `(2, 3)`, ... of `nChannels` channels.
+  static std::vector<ChannelPair_t> standardPairs(std::size_t nChannels);
+
+
+  // --- BEGIN -- Processing ---------------------------------------------------
+  /// @name Processing
+  /// @{
+
+  /**
+   * @brief Prepares for a new event.
+   * @param startTime time of the first tick [&micro;s]
+   * @param tickDuration duration of a tick [&micro;s]
+   * @param nTicks number of ticks to emulate
+   *
+   * All channels are reset to the baseline.
+   */
+  void setup(Time_t startTime, Time_t tickDuration, std::size_t nTicks);
+
+  /**
+   * @brief Places the `waveform` samples in the time window of its channel.
+   * @param waveform the waveform to be added
+   * @param baseline the baseline of the waveform [ADC counts]
+   *
+   * The samples out of the time window are ignored, and so are the channels
+   * not in any of the pairs. Each sample is assigned to the closest tick.
+   * Samples overlapping a previous waveform of the same channel replace its.
+   */
+  void addWaveform(raw::OpDetWaveform const& waveform, Sample_t baseline);
+
+  /// Adds all the `waveforms`, with baselines indexed by channel.
+  void addWaveforms(
+    std::vector<raw::OpDetWaveform> const& waveforms,
+    std::vector<Sample_t> const& baselines
+    );
+
+  /// Emulates the trigger on the waveforms added so far.
+  Result_t process();
+
+  /// @}
+  // --- END ---- Processing ---------------------------------------------------
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access to the intermediate results
+  /// @{
+
+  /// Returns the parameters of the algorithm.
+  Params_t const& parameters() const noexcept { return fParams; }
+
+  /// Returns the number of ticks emulated.
+  std::size_t nTicks() const noexcept { return fNTicks; }
+
+  /// Returns the number of PMT pairs.
+  std::size_t nPairs() const noexcept { return fParams.pairs.size(); }
+
+  /// Returns the number of sliding windows.
+  std::size_t nWindows() const noexcept { return fWindowStarts.size(); }
+
+  /// Returns the first pair of the specified window.
+  std::size_t windowStart(std::size_t window) const
+    { return fWindowStarts[window]; }
+
+  /// Returns the baseline-subtracted samples of `channel` (`nullptr` if none).
+  Sample_t const* channelSamples(Channel_t channel) const;
+
+  /// Returns the sum of the samples of the pair (after `process()`).
+  PairSample_t const* pairSamples(std::size_t pair) const
+    { return fPairSums.data() + pair * fStride; }
+
+  /// Returns the gate of the pair (after `process()`).
+  Gate_t const* pairGates(std::size_t pair) const
+    { return fGates.data() + pair * fStride; }
+
+  /// Returns the open gate count of the window (after `process()`).
+  Count_t const* windowCounts(std::size_t window) const
+    { return fWindowCounts.data() + window * fStride; }
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+
+    private:
+
+  Params_t fParams; ///< Algorithm parameters.
+
+  std::vector<std::size_t> fChannelRows; ///< Row of each channel, or `NoIndex`.
+  std::size_t fNChannelRows = 0U; ///< Number of channels in pairs.
+  std::vector<std::size_t> fWindowStarts; ///< First pair of each window.
+  std::size_t fWindowPairs = 0U; ///< Actual pairs per window.
+
+  Time_t fStartTime = 0.0; ///< Time of the first tick [&micro;s]
+  Time_t fTickDuration = 1.0; ///< Duration of a tick [&micro;s]
+  std::size_t fNTicks = 0U; ///< Number of emulated ticks.
+  std::size_t fStride = 0U; ///< Padded row length.
+
+  // --- BEGIN -- Workspace ----------------------------------------------------
+  std::vector<Sample_t> fChannelSamples; ///< Samples by channel row.
+  std::vector<PairSample_t> fPairSums; ///< Sum of samples by pair.
+  std::vector<Gate_t> fGates; ///< Gates by pair.
+  std::vector<Gate_t> fGateBuffer; ///< Scratch for gate opening.
+  std::vector<Count_t> fCumulative; ///< Open gates in the first pairs.
+  std::vector<Count_t> fWindowCounts; ///< Open gates by window.
+  // --- END ---- Workspace ----------------------------------------------------
+
+
+  /// Adds the two channels of each pair.
+  void sumPairs();
+
+  /// Discriminates the pair sums and opens the gates.
+  void openGates();
+
+  /// Counts the open gates in each window.
+  void countWindows();
+
+  /// Finds the first tick and window reaching majority.
+  Result_t findMajority() const;
+
+}; // opdet::PMTpairMajorityEmulator
+
+
+// -----------------------------------------------------------------------------
+namespace opdet {
+
+  inline std::ostream& operator<<
+    (std::ostream& out, PMTpairMajorityEmulator::Params_t const& params)
+    { params.dump(out); return out; }
+
+} // namespace opdet
+
+
+// -----------------------------------------------------------------------------
+// ---  Template implementation
+// -----------------------------------------------------------------------------
+template <typename Stream>
+void opdet::PMTpairMajorityEmulator::Params_t::dump(
+  Stream& out,
+  std::string const& indent, std::string const& firstIndent
+  ) const
+{
+  out << firstIndent << pairs.size() << " PMT pairs, "
+    << ((polarity < 0)? "negative": "positive") << " polarity"
+    << "\n" << indent << "pair threshold: " << threshold
+    << " ADC counts, gates open for " << gateTicks << " ticks"
+    << "\n" << indent << "majority: " << majority << " in ";
+  if (windowPairs == 0U) out << "all pairs";
+  else {
+    out << "windows of " << windowPairs << " pairs every " << windowStride;
+  }
+} // opdet::PMTpairMajorityEmulator::Params_t::dump()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_PMTPAIRMAJORITYEMULATOR_H
@@ -0,0 +1,64 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTreadoutSettings.cxx
+ * @brief  Table of the hardware readout settings of each PMT channel.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTreadoutSettings.h
+ */
+
+// library header
+#include "icarusalg/PMT/Algorithms/PMTreadoutSettings.h"
+
+// C/C++ standard libraries
+#include <stdexcept> // std::runtime_error
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Sets `value` (if any) into `table`; throws if already present.
+  template <typename T>
+  void setOnce(
+    opdet::ChannelSettingTable<T>& table, raw::Channel_t channel,
+    std::optional<T> const& value, char const* what
+  ) {
+    if (!value) return;
+    if (table.contains(channel)) {
+      throw std::runtime_error{
+        std::string{ "Duplicate " } + what + " setting for channel "
+        + std::to_string(channel) + " (" + std::to_string(table(channel))
+        + ", then " + std::to_string(*value) + ")."
+        };
+    }
+    table.set(channel, *value);
+  } // setOnce()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//---  opdet::PMTreadoutSettings
+//------------------------------------------------------------------------------
+opdet::PMTreadoutSettings::PMTreadoutSettings(std::size_t nChannels) {
+
+  fBaselines.resize(nChannels);
+  fThresholds.resize(nChannels);
+  fBoardNumbers.resize(nChannels);
+  fBoardChannels.resize(nChannels);
+
+} // opdet::PMTreadoutSettings::PMTreadoutSettings()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTreadoutSettings::add(ChannelSettings_t const& settings) {
+
+  Channel_t const channel = settings.channel;
+  setOnce(fBaselines, channel, settings.baseline, "baseline");
+  setOnce(fThresholds, channel, settings.threshold, "threshold");
+  setOnce(fBoardNumbers, channel, settings.boardNumber, "board number");
+  setOnce(fBoardChannels, channel, settings.boardChannel, "board channel");
+
+} // opdet::PMTreadoutSettings::add()
+
+
+//------------------------------------------------------------------------------
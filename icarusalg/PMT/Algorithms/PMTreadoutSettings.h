@@ -0,0 +1,220 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTreadoutSettings.h
+ * @brief  Table of the hardware readout settings of each PMT channel.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTreadoutSettings.cxx
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_PMTREADOUTSETTINGS_H
+#define ICARUSALG_PMT_ALGORITHMS_PMTREADOUTSETTINGS_H
+
+
+// LArSoft libraries
+#include <cstdint>  // uint16_t in OpDetWaveform.h
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::Channel_t, ...
+
+// C/C++ standard libraries
+#include <vector>
+#include <optional>
+#include <stdexcept> // std::out_of_range
+#include <string>
+#include <utility> // std::move()
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet {
+
+  template <typename T> class ChannelSettingTable;
+  class PMTreadoutSettings;
+
+} // namespace opdet
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Value of a setting for each channel, in a channel-indexed array.
+ * @tparam T type of the setting value
+ *
+ * Values are stored in an array indexed by channel, and a bitmap records which
+ * channels have a value. Channel numbers are expected to be dense (like the
+ * PMT channels, from `0` to the number of PMT): the arrays cover all the
+ * channels up to the highest one with a value.
+ * Access is constant time.
+ *
+ * The interface mirrors a map from channel to value.
+ */
+template <typename T>
+class opdet::ChannelSettingTable {
+
+    public:
+
+  using Setting_t = T; ///< Type held by this setting table.
+
+  using Channel_t = raw::Channel_t; ///< Type of channel number.
+
+
+  /// Returns whether a value is available for `channel`.
+  bool contains(Channel_t channel) const noexcept
+    {
+      std::size_t const word = channel / WordBits;
+      return (word < fPresent.size())
+        && (fPresent[word] & (Word_t{ 1 } << (channel % WordBits)));
+    }
+
+  /// Returns the value for the specified `channel`.
+  /// @throw std::out_of_range if not available
+  Setting_t const& operator() (Channel_t channel) const
+    {
+      if (!contains(channel)) {
+        throw std::out_of_range{
+          "opdet::ChannelSettingTable: no setting for channel "
+          + std::to_string(channel)
+          };
+      }
+      return fValues[channel];
+    }
+
+  /// Returns a copy of the value for the specified `channel`, or `defVal`.
+  Setting_t operator() (Channel_t channel, Setting_t defVal) const noexcept
+    { return contains(channel)? fValues[channel]: defVal; }
+
+  /// Returns a pointer to the value for the specified `channel` or `nullptr`.
+  Setting_t const* get(Channel_t channel) const noexcept
+    { return contains(channel)? &(fValues[channel]): nullptr; }
+
+  /// Returns the number of channels with a value.
+  std::size_t nSet() const noexcept { return fNSet; }
+
+  /// Returns the number of channels covered by the table.
+  std::size_t size() const noexcept { return fValues.size(); }
+
+  /// Returns whether no channel has a value.
+  bool empty() const noexcept { return fNSet == 0U; }
+
+  /// Returns the array of values, indexed by channel (valid if `contains()`).
+  Setting_t const* data() const noexcept { return fValues.data(); }
+
+
+  /// Sets or replaces a `value` for `channel`.
+  void set(Channel_t channel, Setting_t value)
+    {
+      if (channel >= fValues.size()) resize(channel + 1);
+      if (!contains(channel)) ++fNSet;
+      fValues[channel] = std::move(value);
+      fPresent[channel / WordBits] |= Word_t{ 1 } << (channel % WordBits);
+    }
+
+  /// Prepares the table for channels from `0` to `nChannels - 1`.
+  void resize(std::size_t nChannels)
+    {
+      if (nChannels <= fValues.size()) return;
+      fValues.resize(nChannels, Setting_t{});
+      fPresent.resize((nChannels + WordBits - 1) / WordBits, Word_t{ 0 });
+    }
+
+  /// Removes all the values.
+  void clear() noexcept
+    { fValues.clear(); fPresent.clear(); fNSet = 0U; }
+
+
+    private:
+
+  using Word_t = std::uint64_t; ///< Type of the words of the bitmap.
+
+  /// Number of bits in a bitmap word.
+  static constexpr std::size_t WordBits = sizeof(Word_t) * 8U;
+
+  std::vector<Setting_t> fValues; ///< Value of each channel.
+  std::vector<Word_t> fPresent; ///< Bitmap of the channels with a value.
+  std::size_t fNSet = 0U; ///< Number of channels with a value.
+
+}; // opdet::ChannelSettingTable<>
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Hardware readout settings of the PMT channels.
+ *
+ * This object collects the readout settings of the PMT channels, as printed
+ * by `DumpPMTconfiguration` module and converted by `PMTconfigToSettings.py`
+ * script: the baseline and the threshold of the readout, and the readout board
+ * and channel within it. Each setting may be missing for some channels.
+ *
+ * Each setting is held in its own `opdet::ChannelSettingTable`, with constant
+ * time access by channel.
+ *
+ * The table can be filled from FHiCL configuration via
+ * `opdet::makePMTreadoutSettings()` (`PMTreadoutSettingsConfig.h`).
+ */
+class opdet::PMTreadoutSettings {
+
+    public:
+
+  using Channel_t = raw::Channel_t; ///< Type of channel number.
+
+  using ADCsetting_t = raw::ADC_Count_t; ///< Type of setting in ADC counts.
+
+  /// All the settings of a single channel.
+  struct ChannelSettings_t {
+    Channel_t channel; ///< Channel the settings apply to.
+    std::optional<ADCsetting_t> baseline; ///< Readout baseline.
+    std::optional<ADCsetting_t> threshold; ///< LVDS discrimination threshold.
+    std::optional<int> boardNumber; ///< Number of the readout board.
+    std::optional<int> boardChannel; ///< Channel within the readout board.
+  }; // ChannelSettings_t
+
+
+  /// Constructor: empty table.
+  PMTreadoutSettings() = default;
+
+  /// Constructor: empty table, prepared for `nChannels` channels.
+  explicit PMTreadoutSettings(std::size_t nChannels);
+
+
+  /**
+   * @brief Adds the `settings` of a channel.
+   * @throw std::runtime_error if any of the settings was already present
+   */
+  void add(ChannelSettings_t const& settings);
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+
+  /// Returns the readout baselines.
+  ChannelSettingTable<ADCsetting_t> const& baselines() const
+    { return fBaselines; }
+
+  /// Returns the readout thresholds.
+  ChannelSettingTable<ADCsetting_t> const& thresholds() const
+    { return fThresholds; }
+
+  /// Returns the readout board numbers.
+  ChannelSettingTable<int> const& boardNumbers() const
+    { return fBoardNumbers; }
+
+  /// Returns the channels within the readout boards.
+  ChannelSettingTable<int> const& boardChannels() const
+    { return fBoardChannels; }
+
+  /// @}
+  // --- END -- Access ---------------------------------------------------------
+
+
+    private:
+
+  ChannelSettingTable<ADCsetting_t> fBaselines; ///< Readout baselines.
+  ChannelSettingTable<ADCsetting_t> fThresholds; ///< Readout thresholds.
+  ChannelSettingTable<int> fBoardNumbers; ///< Readout board numbers.
+  ChannelSettingTable<int> fBoardChannels; ///< Channels within the boards.
+
+}; // opdet::PMTreadoutSettings
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_PMTREADOUTSETTINGS_H
@@ -0,0 +1,122 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTreadoutSettingsConfig.h
+ * @brief  FHiCL configuration of the PMT readout settings.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTreadoutSettings.h
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_PMTREADOUTSETTINGSCONFIG_H
+#define ICARUSALG_PMT_ALGORITHMS_PMTREADOUTSETTINGSCONFIG_H
+
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/PMTreadoutSettings.h"
+
+// framework libraries
+#include "fhiclcpp/types/OptionalAtom.h"
+#include "fhiclcpp/types/Atom.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet {
+
+  struct PMTreadoutSettingsConfig;
+
+  /**
+   * @brief Returns a table with the readout settings of all the channels.
+   * @param configs the configuration of the settings of each channel
+   * @param nChannels (default: `0`) number of channels to prepare the table for
+   * @throw std::runtime_error if a setting appears twice for the same channel
+   * @see `opdet::PMTreadoutSettingsConfig`
+   */
+  PMTreadoutSettings makePMTreadoutSettings(
+    std::vector<PMTreadoutSettingsConfig> const& configs,
+    std::size_t nChannels = 0U
+    );
+
+} // namespace opdet
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief FHiCL configuration of the readout settings of one PMT channel.
+ *
+ * This is the format of `PMTconfigToSettings.py` FHiCL output; a list of all
+ * the channels is read into a `opdet::PMTreadoutSettings` table by
+ * `opdet::makePMTreadoutSettings()`:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * struct Config {
+ *
+ *   fhicl::OptionalSequence<fhicl::Table<opdet::PMTreadoutSettingsConfig>>
+ *     ReadoutSettings {
+ *       fhicl::Name{ "ReadoutSettings" },
+ *       fhicl::Comment{ "hardware readout settings of the PMT channels" }
+ *       };
+ *
+ * };
+ *
+ * // ...
+ *
+ * opdet::PMTreadoutSettings const settings = opdet::makePMTreadoutSettings
+ *   (config().ReadoutSettings().value_or({}), 360U);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+struct opdet::PMTreadoutSettingsConfig {
+
+  using Name = fhicl::Name;
+  using Comment = fhicl::Comment;
+
+  using ADCsetting_t = PMTreadoutSettings::ADCsetting_t;
+
+  fhicl::Atom<raw::Channel_t> Channel {
+    Name{ "Channel" },
+    Comment{ "ID of the channel these settings are applied to" }
+    };
+  fhicl::OptionalAtom<ADCsetting_t> Baseline {
+    Name{ "Baseline" },
+    Comment{ "readout waveform baseline, in ADC counts" }
+    };
+  fhicl::OptionalAtom<ADCsetting_t> Threshold {
+    Name{ "Threshold" },
+    Comment{ "LVDS discrimination threshold, in ADC counts" }
+    };
+  fhicl::OptionalAtom<int> BoardChannel {
+    Name{ "BoardChannel" },
+    Comment{ "Channel within the readout board" }
+    };
+  fhicl::OptionalAtom<int> BoardNumber {
+    Name{ "BoardNumber" },
+    Comment{ "Readout board number" }
+    };
+
+}; // opdet::PMTreadoutSettingsConfig
+
+
+// -----------------------------------------------------------------------------
+inline opdet::PMTreadoutSettings opdet::makePMTreadoutSettings
+  (std::vector<PMTreadoutSettingsConfig> const& configs, std::size_t nChannels)
+{
+  PMTreadoutSettings settings { nChannels };
+  for (PMTreadoutSettingsConfig const& config: configs) {
+    settings.add({
+        config.Channel()
+      , config.Baseline()
+      , config.Threshold()
+      , config.BoardNumber()
+      , config.BoardChannel()
+      });
+  } // for
+  return settings;
+} // opdet::makePMTreadoutSettings()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_PMTREADOUTSETTINGSCONFIG_H
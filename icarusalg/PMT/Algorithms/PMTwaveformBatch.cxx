@@ -0,0 +1,211 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTwaveformBatch.cxx
+ * @brief  Processing of all the PMT waveforms of an event in one batch.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTwaveformBatch.h
+ */
+
+// library header
+#include "icarusalg/PMT/Algorithms/PMTwaveformBatch.h"
+
+// ICARUS libraries
+#include "icarusalg/Utilities/WaveformOperations.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::for_each(), std::transform(), std::min()
+#include <execution> // std::execution::par_unseq
+#include <numeric> // std::iota()
+#include <cmath> // std::sqrt(), std::lround()
+#include <cstdint> // std::int64_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using Sample_t = opdet::PMTwaveformBatch::Sample_t;
+  using Gate_t = opdet::PMTwaveformBatch::Gate_t;
+
+  //
+  // the kernels, shared by all backends so that they compute the same
+  //
+
+  /// Computes baseline and RMS of the first `nBaseline` samples of `iWf`.
+  inline void baselineKernel(
+    std::uint32_t iWf,
+    Sample_t const* samples, std::size_t const* offsets, std::size_t nBaseline,
+    float* baselines, float* baselineRMS, Sample_t* baselineCounts
+  ) {
+    std::size_t const begin = offsets[iWf];
+    std::size_t const n = std::min(nBaseline, offsets[iWf + 1] - begin);
+    if (n == 0U) {
+      baselines[iWf] = 0.0f;
+      baselineRMS[iWf] = 0.0f;
+      baselineCounts[iWf] = 0;
+      return;
+    }
+
+    // integral sums are exact in any order
+    std::int64_t sum = 0, sumSq = 0;
+    for (std::size_t i = begin; i < begin + n; ++i) {
+      std::int64_t const sample = samples[i];
+      sum += sample;
+      sumSq += sample * sample;
+    }
+    double const average = static_cast<double>(sum) / n;
+    double const variance = static_cast<double>(sumSq) / n - average * average;
+
+    baselines[iWf] = static_cast<float>(average);
+    baselineRMS[iWf]
+      = static_cast<float>((variance > 0.0)? std::sqrt(variance): 0.0);
+    baselineCounts[iWf] = static_cast<Sample_t>(std::lround(average));
+  } // baselineKernel()
+
+
+  /// Returns the `sample` from `baseline`, with `polarity` flipped.
+  constexpr Sample_t subtractKernel
+    (Sample_t sample, Sample_t baseline, int polarity)
+  {
+    using namespace icarus::waveform_operations;
+    return (polarity < 0)
+      ? NegativePolarityOperations<Sample_t>::subtractBaseline(sample, baseline)
+      : PositivePolarityOperations<Sample_t>::subtractBaseline(sample, baseline)
+      ;
+  } // subtractKernel()
+
+
+  /// Returns the state of the gate for a (subtracted) `sample`.
+  constexpr Gate_t gateKernel(Sample_t sample, Sample_t threshold)
+    { return (sample >= threshold)? Gate_t{ 1 }: Gate_t{ 0 }; }
+
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//---  opdet::PMTwaveformBatch
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::clear() {
+
+  fSamples.clear();
+  fOffsets.assign(1U, 0U);
+  fWaveformOf.clear();
+
+} // opdet::PMTwaveformBatch::clear()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::add(raw::OpDetWaveform const& waveform) {
+
+  std::uint32_t const iWaveform = size();
+  fSamples.insert(fSamples.end(), waveform.begin(), waveform.end());
+  fWaveformOf.insert(fWaveformOf.end(), waveform.size(), iWaveform);
+  fOffsets.push_back(fSamples.size());
+
+} // opdet::PMTwaveformBatch::add()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::add
+  (std::vector<raw::OpDetWaveform> const& waveforms)
+{
+  std::size_t nNewSamples = 0U;
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    nNewSamples += waveform.size();
+  fSamples.reserve(fSamples.size() + nNewSamples);
+  fWaveformOf.reserve(fWaveformOf.size() + nNewSamples);
+  fOffsets.reserve(fOffsets.size() + waveforms.size());
+
+  for (raw::OpDetWaveform const& waveform: waveforms) add(waveform);
+
+} // opdet::PMTwaveformBatch::add()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::process(Backend backend /* = DefaultBackend */)
+{
+  prepareResults();
+  switch (backend) {
+    case Backend::Reference: processReference(); break;
+    case Backend::Parallel:  processParallel();  break;
+  } // switch
+} // opdet::PMTwaveformBatch::process()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::prepareResults() {
+
+  std::size_t const nWaveforms = size();
+  if (fWaveformIndices.size() < nWaveforms) {
+    std::size_t const nOld = fWaveformIndices.size();
+    fWaveformIndices.resize(nWaveforms);
+    std::iota(fWaveformIndices.begin() + nOld, fWaveformIndices.end(), nOld);
+  }
+  fBaselines.resize(nWaveforms);
+  fBaselineRMS.resize(nWaveforms);
+  fBaselineCounts.resize(nWaveforms);
+  fSubtracted.resize(nSamples());
+  fGates.resize(nSamples());
+
+} // opdet::PMTwaveformBatch::prepareResults()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::processReference() {
+
+  for (std::uint32_t iWf = 0; iWf < size(); ++iWf) {
+    baselineKernel(iWf, fSamples.data(), fOffsets.data(),
+      fParams.baselineSamples,
+      fBaselines.data(), fBaselineRMS.data(), fBaselineCounts.data()
+      );
+  }
+
+  for (std::size_t i = 0; i < nSamples(); ++i) {
+    fSubtracted[i] = subtractKernel
+      (fSamples[i], fBaselineCounts[fWaveformOf[i]], fParams.polarity);
+  }
+
+  for (std::size_t i = 0; i < nSamples(); ++i)
+    fGates[i] = gateKernel(fSubtracted[i], fParams.threshold);
+
+} // opdet::PMTwaveformBatch::processReference()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformBatch::processParallel() {
+
+  // lambdas capture only values and pointers to heap memory,
+  // as required to offload the algorithms to a device
+  Sample_t const* const samples = fSamples.data();
+  std::size_t const* const offsets = fOffsets.data();
+  std::size_t const nBaseline = fParams.baselineSamples;
+  float* const baselines = fBaselines.data();
+  float* const baselineRMS = fBaselineRMS.data();
+  Sample_t* const baselineCounts = fBaselineCounts.data();
+  int const polarity = fParams.polarity;
+  Sample_t const threshold = fParams.threshold;
+
+  std::for_each(std::execution::par_unseq,
+    fWaveformIndices.begin(), fWaveformIndices.begin() + size(),
+    [=](std::uint32_t iWf)
+      {
+        baselineKernel(iWf, samples, offsets, nBaseline,
+          baselines, baselineRMS, baselineCounts);
+      }
+    );
+
+  std::transform(std::execution::par_unseq,
+    fSamples.begin(), fSamples.end(), fWaveformOf.begin(), fSubtracted.begin(),
+    [=](Sample_t sample, std::uint32_t iWf)
+      { return subtractKernel(sample, baselineCounts[iWf], polarity); }
+    );
+
+  std::transform(std::execution::par_unseq,
+    fSubtracted.begin(), fSubtracted.end(), fGates.begin(),
+    [=](Sample_t sample){ return gateKernel(sample, threshold); }
+    );
+
+} // opdet::PMTwaveformBatch::processParallel()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,234 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTwaveformBatch.h
+ * @brief  Processing of all the PMT waveforms of an event in one batch.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTwaveformBatch.cxx
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_PMTWAVEFORMBATCH_H
+#define ICARUSALG_PMT_ALGORITHMS_PMTWAVEFORMBATCH_H
+
+
+// LArSoft libraries
+#include <cstdint>  // uint16_t in OpDetWaveform.h
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::ADC_Count_t, ...
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <cstdint> // std::uint8_t, std::uint32_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet { class PMTwaveformBatch; }
+/**
+ * @class opdet::PMTwaveformBatch
+ * @brief Runs the basic waveform kernels on all the waveforms of an event.
+ *
+ * The samples of all the waveforms of an event are copied in a single
+ * contiguous array, and the following kernels are run on all of them at once:
+ *
+ * 1. the baseline of each waveform is estimated as the average of its first
+ *    `baselineSamples` samples (the first portion used by
+ *    `opdet::SharedWaveformBaseline`), together with their RMS;
+ * 2. the baseline (rounded to ADC counts) is subtracted from each sample and
+ *    the polarity is flipped, so that signals are positive
+ *    (as in `icarus::waveform_operations::Operations::subtractBaseline()`);
+ * 3. each sample is discriminated: the gate is open (`1`) where the sample
+ *    reaches `threshold` from the baseline, closed (`0`) elsewhere.
+ *
+ * Each kernel is a single loop on all the waveforms (step 1) or on all the
+ * samples of the event (steps 2 and 3), with no dependency between
+ * iterations. Two backends are available:
+ * * `Backend::Reference`: plain serial loops;
+ * * `Backend::Parallel`: C++17 parallel algorithms with the
+ *   `std::execution::par_unseq` policy. GCC runs them on threads (with Intel
+ *   TBB); compilers supporting standard parallelism offload (e.g. NVIDIA
+ *   `nvc++ -stdpar=gpu`, enabled by the `ICARUSALG_WAVEFORM_OFFLOAD` CMake
+ *   option) run them on a GPU. All the data is kept in heap memory, which
+ *   those compilers can migrate to the device.
+ *
+ * The two backends give identical results on the integer outputs
+ * (subtracted samples and gates). The sums for each baseline are performed
+ * in the same order in both, and they match within the floating point
+ * rounding of the device (a relative tolerance of `1e-6` is used in the
+ * tests for `float` results).
+ *
+ * The backend used by default is `DefaultBackend`, which is `Parallel` if the
+ * library was built with `ICARUSALG_WAVEFORM_OFFLOAD` and `Reference`
+ * otherwise.
+ *
+ * The batch keeps its memory when cleared: reusing the same object for all
+ * the events avoids further allocations.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * opdet::PMTwaveformBatch batch{ { -1, 50U, 20 } };
+ * batch.add(waveforms);
+ * batch.process();
+ * for (std::size_t i = 0; i < batch.size(); ++i)
+ *   std::cout << "\n" << batch.baseline(i) << " +/- " << batch.baselineRMS(i);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class opdet::PMTwaveformBatch {
+    public:
+
+  using Sample_t = raw::ADC_Count_t; ///< Type of waveform sample.
+
+  using Gate_t = std::uint8_t; ///< Type of gate state (`0` is closed).
+
+  /// Available implementations of the kernels.
+  enum class Backend {
+    Reference, ///< Serial loops.
+    Parallel   ///< C++17 parallel algorithms (offloaded where supported).
+  }; // Backend
+
+  /// Backend used when none is specified.
+  static constexpr Backend DefaultBackend =
+#ifdef ICARUSALG_WAVEFORM_OFFLOAD
+    Backend::Parallel
+#else // !ICARUSALG_WAVEFORM_OFFLOAD
+    Backend::Reference
+#endif // ICARUSALG_WAVEFORM_OFFLOAD
+    ;
+
+  /// Algorithm parameters.
+  struct Params_t {
+
+    /// Polarity of the signal: negative if it develops below baseline.
+    int polarity = -1;
+
+    /// Number of samples at the start of each waveform used for the baseline.
+    std::size_t baselineSamples = 50U;
+
+    /// Threshold for the gates [ADC counts above the baseline].
+    Sample_t threshold = 0;
+
+    /// Dumps this configuration into the output stream `out`.
+    template <typename Stream>
+    void dump(
+      Stream& out,
+      std::string const& indent, std::string const& firstIndent
+      ) const;
+    template <typename Stream>
+    void dump(Stream& out, std::string const& indent = "") const
+      { dump(out, indent, indent); }
+
+  }; // Params_t
+
+
+  /// Constructor: sets the parameters of the algorithm.
+  explicit PMTwaveformBatch(Params_t params): fParams{ params } {}
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Removes all the waveforms (memory is kept).
+  void clear();
+
+  /// Adds a copy of the samples of `waveform` to the batch.
+  void add(raw::OpDetWaveform const& waveform);
+
+  /// Adds a copy of the samples of all the `waveforms` to the batch.
+  void add(std::vector<raw::OpDetWaveform> const& waveforms);
+
+  /// @}
+  // --- END ---- Filling ------------------------------------------------------
+
+
+  /// Runs all the kernels on the waveforms in the batch.
+  void process(Backend backend = DefaultBackend);
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access to the results
+  /// @{
+
+  /// Returns the parameters of the algorithm.
+  Params_t const& parameters() const noexcept { return fParams; }
+
+  /// Returns the number of waveforms in the batch.
+  std::size_t size() const noexcept { return fOffsets.size() - 1; }
+
+  /// Returns whether there is no waveform in the batch.
+  bool empty() const noexcept { return size() == 0U; }
+
+  /// Returns the total number of samples in the batch.
+  std::size_t nSamples() const noexcept { return fSamples.size(); }
+
+  /// Returns the number of samples of the waveform `i`.
+  std::size_t nSamples(std::size_t i) const
+    { return fOffsets[i + 1] - fOffsets[i]; }
+
+  /// Returns the estimated baseline of the waveform `i` [ADC counts].
+  float baseline(std::size_t i) const { return fBaselines[i]; }
+
+  /// Returns the RMS of the baseline samples of the waveform `i`.
+  float baselineRMS(std::size_t i) const { return fBaselineRMS[i]; }
+
+  /// Returns the samples of the waveform `i`, baseline subtracted.
+  Sample_t const* subtracted(std::size_t i) const
+    { return fSubtracted.data() + fOffsets[i]; }
+
+  /// Returns the gates of the waveform `i`.
+  Gate_t const* gates(std::size_t i) const
+    { return fGates.data() + fOffsets[i]; }
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+
+    private:
+
+  Params_t fParams; ///< Algorithm parameters.
+
+  // --- BEGIN -- Batch data ---------------------------------------------------
+  std::vector<Sample_t> fSamples; ///< All samples, waveform after waveform.
+  std::vector<std::size_t> fOffsets { 0U }; ///< First sample of waveforms.
+  std::vector<std::uint32_t> fWaveformOf; ///< Waveform of each sample.
+  std::vector<std::uint32_t> fWaveformIndices; ///< `0`, `1`, `2`, ...
+  // --- END ---- Batch data ---------------------------------------------------
+
+  // --- BEGIN -- Results ------------------------------------------------------
+  std::vector<float> fBaselines; ///< Baseline of each waveform.
+  std::vector<float> fBaselineRMS; ///< Baseline RMS of each waveform.
+  std::vector<Sample_t> fBaselineCounts; ///< Rounded baseline.
+  std::vector<Sample_t> fSubtracted; ///< Baseline-subtracted samples.
+  std::vector<Gate_t> fGates; ///< Gates of all the samples.
+  // --- END ---- Results ------------------------------------------------------
+
+
+  /// Sizes the result arrays for the current batch.
+  void prepareResults();
+
+  /// Runs all the kernels with serial loops.
+  void processReference();
+
+  /// Runs all the kernels with parallel algorithms.
+  void processParallel();
+
+}; // opdet::PMTwaveformBatch
+
+
+// -----------------------------------------------------------------------------
+// ---  Template implementation
+// -----------------------------------------------------------------------------
+template <typename Stream>
+void opdet::PMTwaveformBatch::Params_t::dump(
+  Stream& out,
+  std::string const& indent, std::string const& firstIndent
+  ) const
+{
+  out << firstIndent << ((polarity < 0)? "negative": "positive")
+    << " polarity, baseline from the first " << baselineSamples << " samples"
+    << "\n" << indent << "gate threshold: " << threshold << " ADC counts";
+} // opdet::PMTwaveformBatch::Params_t::dump()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_PMTWAVEFORMBATCH_H
@@ -0,0 +1,226 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.cxx
+ * @brief  Index of PMT waveforms by their time span.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.h
+ */
+
+// library header
+#include "icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::lower_bound(), std::max()
+#include <numeric> // std::iota()
+#include <limits>
+#include <cmath> // std::nextafter()
+
+
+//------------------------------------------------------------------------------
+//---  opdet::PMTwaveformTimeIndex
+//------------------------------------------------------------------------------
+opdet::PMTwaveformTimeIndex::PMTwaveformTimeIndex(
+  std::vector<Waveform_t> const& waveforms, Time_t tickDuration,
+  bool byChannel /* = false */
+) {
+
+  fWaveforms.reserve(waveforms.size());
+  for (Waveform_t const& waveform: waveforms) fWaveforms.push_back(&waveform);
+  build(tickDuration, byChannel);
+
+} // opdet::PMTwaveformTimeIndex::PMTwaveformTimeIndex()
+
+
+//------------------------------------------------------------------------------
+opdet::PMTwaveformTimeIndex::PMTwaveformTimeIndex(
+  std::vector<Waveform_t const*> const& waveforms, Time_t tickDuration,
+  bool byChannel /* = false */
+)
+  : fWaveforms{ waveforms }
+{
+  build(tickDuration, byChannel);
+} // opdet::PMTwaveformTimeIndex::PMTwaveformTimeIndex()
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTwaveformTimeIndex::startTime(std::size_t position) const
+  -> Time_t
+  { return fWaveforms[position]->TimeStamp(); }
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTwaveformTimeIndex::endTime(std::size_t position) const
+  -> Time_t
+  { return fEnds[position]; }
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> opdet::PMTwaveformTimeIndex::overlapping
+  (Time_t start, Time_t stop) const
+{
+  std::vector<std::size_t> positions;
+  overlapping(start, stop, positions);
+  return positions;
+} // opdet::PMTwaveformTimeIndex::overlapping()
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> opdet::PMTwaveformTimeIndex::overlapping
+  (Channel_t channel, Time_t start, Time_t stop) const
+{
+  std::vector<std::size_t> positions;
+  overlapping(channel, start, stop, positions);
+  return positions;
+} // opdet::PMTwaveformTimeIndex::overlapping()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformTimeIndex::overlapping
+  (Time_t start, Time_t stop, std::vector<std::size_t>& positions) const
+{
+  fIndex.query(start, stop, positions);
+} // opdet::PMTwaveformTimeIndex::overlapping()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformTimeIndex::overlapping(
+  Channel_t channel, Time_t start, Time_t stop,
+  std::vector<std::size_t>& positions
+) const {
+
+  if (hasChannelPartitions()) {
+    if (channel < fChannels.size())
+      fChannels[channel].query(start, stop, positions);
+    return;
+  }
+
+  // no partition: filter the full result
+  std::size_t const nOld = positions.size();
+  fIndex.query(start, stop, positions);
+  auto const itFirst = positions.begin() + nOld;
+  positions.erase(
+    std::remove_if(itFirst, positions.end(),
+      [this,channel](std::size_t position)
+        { return fWaveforms[position]->ChannelNumber() != channel; }
+      ),
+    positions.end()
+    );
+
+} // opdet::PMTwaveformTimeIndex::overlapping()
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> opdet::PMTwaveformTimeIndex::at(Time_t t) const {
+  return
+    overlapping(t, std::nextafter(t, std::numeric_limits<Time_t>::infinity()));
+} // opdet::PMTwaveformTimeIndex::at()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformTimeIndex::build(Time_t tickDuration, bool byChannel) {
+
+  std::size_t const nWaveforms = fWaveforms.size();
+
+  fEnds.resize(nWaveforms);
+  for (std::size_t i = 0; i < nWaveforms; ++i) {
+    Waveform_t const& waveform = *(fWaveforms[i]);
+    fEnds[i] = waveform.TimeStamp() + waveform.size() * tickDuration;
+  }
+
+  std::vector<std::size_t> order(nWaveforms);
+  std::iota(order.begin(), order.end(), 0U);
+  std::sort(order.begin(), order.end(),
+    [this](std::size_t a, std::size_t b)
+      { return fWaveforms[a]->TimeStamp() < fWaveforms[b]->TimeStamp(); }
+    );
+
+  auto fill = [this](SortedWaveforms_t& index, std::size_t position)
+    {
+      index.starts.push_back(fWaveforms[position]->TimeStamp());
+      index.ends.push_back(fEnds[position]);
+      index.positions.push_back(position);
+    };
+
+  fIndex.starts.reserve(nWaveforms);
+  fIndex.ends.reserve(nWaveforms);
+  fIndex.positions.reserve(nWaveforms);
+  for (std::size_t const position: order) fill(fIndex, position);
+  fIndex.buildTree();
+
+  if (!byChannel) return;
+
+  Channel_t maxChannel = 0;
+  for (Waveform_t const* waveform: fWaveforms)
+    maxChannel = std::max(maxChannel, waveform->ChannelNumber());
+  fChannels.resize(nWaveforms? maxChannel + 1: 0);
+
+  // still sorted by time in each channel
+  for (std::size_t const position: order)
+    fill(fChannels[fWaveforms[position]->ChannelNumber()], position);
+  for (SortedWaveforms_t& channelIndex: fChannels) channelIndex.buildTree();
+
+} // opdet::PMTwaveformTimeIndex::build()
+
+
+//------------------------------------------------------------------------------
+//---  opdet::PMTwaveformTimeIndex::SortedWaveforms_t
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformTimeIndex::SortedWaveforms_t::buildTree() {
+
+  maxEnds.assign(4 * size(), std::numeric_limits<Time_t>::lowest());
+  if (!empty()) fillTree(1U, 0U, size());
+
+} // opdet::PMTwaveformTimeIndex::SortedWaveforms_t::buildTree()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformTimeIndex::SortedWaveforms_t::query
+  (Time_t start, Time_t stop, std::vector<std::size_t>& found) const
+{
+  if (empty() || (start >= stop)) return;
+
+  // waveforms starting at or after `stop` are excluded
+  std::size_t const limit
+    = std::lower_bound(starts.begin(), starts.end(), stop) - starts.begin();
+
+  collect(1U, 0U, size(), limit, start, found);
+
+} // opdet::PMTwaveformTimeIndex::SortedWaveforms_t::query()
+
+
+//------------------------------------------------------------------------------
+auto opdet::PMTwaveformTimeIndex::SortedWaveforms_t::fillTree
+  (std::size_t node, std::size_t begin, std::size_t end) -> Time_t
+{
+  if (end - begin == 1) return maxEnds[node] = ends[begin];
+
+  std::size_t const middle = begin + (end - begin) / 2;
+  return maxEnds[node] = std::max(
+    fillTree(2 * node, begin, middle), fillTree(2 * node + 1, middle, end)
+    );
+
+} // opdet::PMTwaveformTimeIndex::SortedWaveforms_t::fillTree()
+
+
+//------------------------------------------------------------------------------
+void opdet::PMTwaveformTimeIndex::SortedWaveforms_t::collect(
+  std::size_t node, std::size_t begin, std::size_t end,
+  std::size_t limit, Time_t start, std::vector<std::size_t>& found
+) const {
+
+  // skip subtrees starting too late or ending too early
+  if ((begin >= limit) || (maxEnds[node] <= start)) return;
+
+  if (end - begin == 1) {
+    found.push_back(positions[begin]);
+    return;
+  }
+
+  std::size_t const middle = begin + (end - begin) / 2;
+  collect(2 * node, begin, middle, limit, start, found);
+  collect(2 * node + 1, middle, end, limit, start, found);
+
+} // opdet::PMTwaveformTimeIndex::SortedWaveforms_t::collect()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,210 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.h
+ * @brief  Index of PMT waveforms by their time span.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.cxx
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_PMTWAVEFORMTIMEINDEX_H
+#define ICARUSALG_PMT_ALGORITHMS_PMTWAVEFORMTIMEINDEX_H
+
+
+// LArSoft libraries
+#include <cstdint>  // uint16_t in OpDetWaveform.h
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::Channel_t, ...
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet { class PMTwaveformTimeIndex; }
+/**
+ * @brief Index of PMT waveforms sorted by time, answering overlap queries.
+ *
+ * The index is built once (e.g. for each event) from a list of waveforms, and
+ * then answers which of them overlap a time interval `[ start, stop [`.
+ * A waveform spans the time from its time stamp (`raw::OpDetWaveform`
+ * `TimeStamp()`, the time of its first sample) to the end of its last sample.
+ * Times are in microseconds, as `TimeStamp()`.
+ *
+ * Queries return the position of the waveforms in the list the index was
+ * built from (for example, `waveforms[i]` where `i` is one of the returned
+ * values), sorted by start time.
+ * The waveforms are not copied and they need to outlive the index.
+ *
+ * Waveforms are sorted by start time, and a balanced tree on that sorted list
+ * keeps the latest end time of each subtree: a query skips all the waveforms
+ * starting after the end of the interval and all the subtrees ending before
+ * its start, taking a logarithmic time plus the time to list the result.
+ *
+ * Optionally, the index may be partitioned by channel: the queries restricted
+ * to a channel then only visit the waveforms of that channel. Without
+ * partitions, the same queries work by filtering the full result.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * opdet::PMTwaveformTimeIndex const index { waveforms, 0.002 };
+ *
+ * for (std::size_t const iWaveform: index.overlapping(-2.0, 10.0))
+ *   std::cout << "\n" << waveforms[iWaveform].ChannelNumber();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class opdet::PMTwaveformTimeIndex {
+
+    public:
+
+  using Waveform_t = raw::OpDetWaveform; ///< Type of waveform in the index.
+
+  using Channel_t = raw::Channel_t; ///< Type of channel number.
+
+  using Time_t = double; ///< Type of time [&micro;s]
+
+  /// Value used for the position of no waveform.
+  static constexpr std::size_t NoIndex = static_cast<std::size_t>(-1);
+
+
+  // --- BEGIN -- Constructors -------------------------------------------------
+  /// @name Constructors
+  /// @{
+
+  /// Constructor: an empty index.
+  PMTwaveformTimeIndex() = default;
+
+  /**
+   * @brief Constructor: indexes all the `waveforms`.
+   * @param waveforms the waveforms to be indexed
+   * @param tickDuration duration of a sample [&micro;s]
+   * @param byChannel (default: `false`) also partitions the index by channel
+   */
+  PMTwaveformTimeIndex(
+    std::vector<Waveform_t> const& waveforms, Time_t tickDuration,
+    bool byChannel = false
+    );
+
+  /**
+   * @brief Constructor: indexes all the `waveforms`.
+   * @param waveforms pointers to the waveforms to be indexed (not null)
+   * @param tickDuration duration of a sample [&micro;s]
+   * @param byChannel (default: `false`) also partitions the index by channel
+   */
+  PMTwaveformTimeIndex(
+    std::vector<Waveform_t const*> const& waveforms, Time_t tickDuration,
+    bool byChannel = false
+    );
+
+  /// @}
+  // --- END ---- Constructors -------------------------------------------------
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+
+  /// Returns the number of indexed waveforms.
+  std::size_t size() const noexcept { return fIndex.size(); }
+
+  /// Returns whether no waveform is indexed.
+  bool empty() const noexcept { return fIndex.empty(); }
+
+  /// Returns whether the index is also partitioned by channel.
+  bool hasChannelPartitions() const noexcept { return !fChannels.empty(); }
+
+  /// Returns the position of all the waveforms, sorted by start time.
+  std::vector<std::size_t> const& sorted() const noexcept
+    { return fIndex.positions; }
+
+  /// Returns the waveform at the specified `position` in the original list.
+  Waveform_t const& waveform(std::size_t position) const
+    { return *(fWaveforms[position]); }
+
+  /// Returns the start time of the waveform at `position` [&micro;s].
+  Time_t startTime(std::size_t position) const;
+
+  /// Returns the end time of the waveform at `position` [&micro;s].
+  Time_t endTime(std::size_t position) const;
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+
+  // --- BEGIN -- Queries ------------------------------------------------------
+  /// @name Queries
+  /// @{
+
+  /// Returns the position of the waveforms overlapping `[ start, stop [`.
+  std::vector<std::size_t> overlapping(Time_t start, Time_t stop) const;
+
+  /// Returns the position of `channel` waveforms overlapping `[start, stop[`.
+  std::vector<std::size_t> overlapping
+    (Channel_t channel, Time_t start, Time_t stop) const;
+
+  /// Appends to `positions` the waveforms overlapping `[ start, stop [`.
+  void overlapping
+    (Time_t start, Time_t stop, std::vector<std::size_t>& positions) const;
+
+  /// Appends to `positions` the `channel` waveforms overlapping
+  /// `[ start, stop [`.
+  void overlapping(
+    Channel_t channel, Time_t start, Time_t stop,
+    std::vector<std::size_t>& positions
+    ) const;
+
+  /// Returns the position of the waveforms covering the time `t`.
+  std::vector<std::size_t> at(Time_t t) const;
+
+  /// @}
+  // --- END ---- Queries ------------------------------------------------------
+
+
+    private:
+
+  /// Waveforms sorted by start time, with a tree of end times.
+  struct SortedWaveforms_t {
+
+    std::vector<Time_t> starts; ///< Start times, sorted.
+    std::vector<Time_t> ends; ///< End times, in the same order as `starts`.
+    std::vector<std::size_t> positions; ///< Original position of waveforms.
+
+    /// Latest end time of each node of the tree (root is `1`).
+    std::vector<Time_t> maxEnds;
+
+    /// Builds the tree of end times (`starts` etc. must be filled already).
+    void buildTree();
+
+    /// Appends the waveforms overlapping `[ start, stop [` to `found`.
+    void query
+      (Time_t start, Time_t stop, std::vector<std::size_t>& found) const;
+
+    std::size_t size() const noexcept { return positions.size(); }
+    bool empty() const noexcept { return positions.empty(); }
+
+      private:
+    Time_t fillTree(std::size_t node, std::size_t begin, std::size_t end);
+    void collect(
+      std::size_t node, std::size_t begin, std::size_t end,
+      std::size_t limit, Time_t start, std::vector<std::size_t>& found
+      ) const;
+
+  }; // SortedWaveforms_t
+
+
+  std::vector<Waveform_t const*> fWaveforms; ///< Waveforms, original order.
+  std::vector<Time_t> fEnds; ///< End times, in original order.
+
+  SortedWaveforms_t fIndex; ///< Index of all waveforms.
+
+  std::vector<SortedWaveforms_t> fChannels; ///< Index for each channel.
+
+
+  /// Fills the index from `fWaveforms`.
+  void build(Time_t tickDuration, bool byChannel);
+
+}; // opdet::PMTwaveformTimeIndex
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_PMTWAVEFORMTIMEINDEX_H
@@ -9,19 +9,27 @@
 // library header
 #include "icarusalg/PMT/Algorithms/SharedWaveformBaseline.h"
 
+// ICARUS libraries
+#include "icarusalg/Utilities/WaveformOperations.h" // findFirstRunOutside()
+#include "icarusalg/Utilities/CountingMedian.h"
+#include "icarusalg/Utilities/mfLoggingClass.h" // ICARUS_LOG_TRACE()
+#include "icarusalg/Utilities/Instrumentation.h" // ICARUS_SCOPED_TIMER()
+#include "icarusalg/Utilities/runConcurrently.h"
+
 // LArSoft libraries
 #include "lardataalg/Utilities/StatCollector.h"
 #include "lardataobj/RawData/OpDetWaveform.h"
 
 // framework libraries
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "cetlib_except/exception.h"
 
 // C/C++ standard libraries
 #include <vector>
-#include <algorithm> // std::nth_element(), std::copy()
+#include <algorithm> // std::nth_element(), std::max_element()
 #include <iterator> // std::distance(), std::next()
 #include <ostream>
-#include <cmath> // std::round()
+#include <cmath> // std::round(), std::sqrt()
 #include <type_traits> // std::enable_if_t
 #include <cassert>
 
@@ -57,17 +65,6 @@ namespace {
   } // median(collection rvalue ref)
   
   
-  /// Extracts the median of the collection between the specified iterators.
-  template <typename BIter, typename EIter>
-  auto median(BIter begin, EIter end) {
-    
-    using value_type = typename BIter::value_type;
-    
-    return median(std::vector<value_type>{ begin, end });
-    
-  } // median(iterators)
-  
-  
   /**
    * Returns iterator to the first sample outside `lower`-`upper` range
    * (inclusive) which is the first of at least `maxLower` samples all below
@@ -83,28 +80,10 @@ namespace {
     assert(lower <= upper);
     assert(maxLower > 0U);
     assert(maxUpper > 0U);
-
-    unsigned int nAbove = 0U;
-    unsigned int nBelow = 0U;
-    for (auto it = begin; it != end; ++it) {
-      
-      if (*it > upper) {
-        if (++nAbove >= maxUpper) return it - maxUpper + 1;
-        nBelow = 0U;
-        continue;
-      }
-      
-      if (*it < lower) {
-        if (++nBelow >= maxLower) return it - maxLower + 1;
-        nAbove = 0U;
-        continue;
-      }
-      
-      nAbove = nBelow = 0U;
-      
-    } // while
     
-    return end;
+    return icarus::waveform_operations::findFirstRunOutside
+      (begin, end, lower, upper, maxLower, maxUpper);
+    
   } // findOutOfBoundary()
   
   
@@ -141,6 +120,8 @@ auto opdet::SharedWaveformBaseline::operator()
   (std::vector<raw::OpDetWaveform const*> const& waveforms) const
   -> BaselineInfo_t
 {
+  ICARUS_SCOPED_TIMER("SharedWaveformBaseline");
+  ICARUS_COUNT("SharedWaveformBaseline waveforms", waveforms.size());
   if (waveforms.empty()) return {};
   
   //
@@ -177,16 +158,19 @@ auto opdet::SharedWaveformBaseline::operator()
     auto const firstExcess = sampleOutOfBoundary(begin, end);
     if (firstExcess != end) {
       
-      mf::LogTrace log { fLogCategory };
-      log
-        << waveformIntro(waveform) << " has " << fParams.nExcessSamples
-        << " samples in a row out of [ " << belowThreshold << " ; "
-        << aboveThreshold << " ] ADC starting at sample #"
-        << (firstExcess - begin) << ":";
-      for (
-        auto it = firstExcess; it != firstExcess + fParams.nExcessSamples; ++it
-      )
-        log << " " << *it;
+      if (mf::isDebugEnabled()) {
+        mf::LogTrace log { fLogCategory };
+        log
+          << waveformIntro(waveform) << " has " << fParams.nExcessSamples
+          << " samples in a row out of [ " << belowThreshold << " ; "
+          << aboveThreshold << " ] ADC starting at sample #"
+          << (firstExcess - begin) << ":";
+        for (
+          auto it = firstExcess; it != firstExcess + fParams.nExcessSamples;
+          ++it
+        )
+          log << " " << *it;
+      } // if debug
       
       // should we try to recover part of the waveform here? e.g.
       /*
@@ -218,7 +202,7 @@ auto opdet::SharedWaveformBaseline::operator()
   }
   else {
     // backup: take the median of the medians of all waveforms
-    mf::LogTrace{ fLogCategory }
+    ICARUS_LOG_TRACE(fLogCategory)
       << "No waveform of channel " << waveforms.front()->ChannelNumber()
       << " qualified for baseline computation: falling back to use all of them";
     return {
@@ -232,22 +216,182 @@ auto opdet::SharedWaveformBaseline::operator()
 } // opdet::SharedWaveformBaseline::operator()
 
 
+//------------------------------------------------------------------------------
+auto opdet::SharedWaveformBaseline::operator()
+  (WaveformGroup_t waveforms, Workspace_t& workspace) const -> BaselineInfo_t
+{
+  ICARUS_SCOPED_TIMER("SharedWaveformBaseline");
+  ICARUS_COUNT("SharedWaveformBaseline waveforms", waveforms.size());
+  if (waveforms.empty()) return {};
+  
+  //
+  // first pass: sums and histogram of the first portion of each waveform
+  //
+  workspace.sums.clear();
+  workspace.RMSs.clear();
+  workspace.histogram.clear();
+  
+  double const nSample = static_cast<double>(fParams.nSample);
+  for (raw::OpDetWaveform const* waveform: waveforms) {
+    
+    ICARUS_LOG_TRACE(fLogCategory)
+      << "Now processing: " << waveformIntro(waveform);
+    
+    if ((fParams.nSample == 0) || (waveform->size() < fParams.nSample)) {
+      ICARUS_LOG_TRACE(fLogCategory) << waveformIntro(waveform)
+        << ": skipped because shorter than " << fParams.nSample
+        << " samples";
+      continue;
+    }
+    
+    Workspace_t::WaveformSums_t sums { waveform };
+    auto const begin = waveform->cbegin();
+    auto const end = std::next(begin, fParams.nSample);
+    for (auto it = begin; it != end; ++it) {
+      std::int64_t const sample = *it;
+      sums.sum += sample;
+      sums.sumSq += sample * sample;
+      workspace.histogram.add(*it);
+    } // for samples
+    
+    double const average = sums.sum / nSample;
+    double const variance = sums.sumSq / nSample - average * average;
+    workspace.RMSs.push_back((variance > 0.0)? std::sqrt(variance): 0.0);
+    workspace.sums.push_back(sums);
+    
+  } // for waveforms
+  
+  if (workspace.sums.empty()) {
+    ICARUS_LOG_TRACE(fLogCategory)
+      << "No waveform of channel " << waveforms.front()->ChannelNumber()
+      << " has enough samples: falling back to use all of them";
+    return {
+        static_cast<double>(medianOfMedians(waveforms, workspace)) // baseline
+      , BaselineInfo_t::NoInfo                       // RMS
+      , static_cast<unsigned int>(waveforms.size())  // nWaveforms
+      , 0                                            // nSamples (special value)
+      };
+  }
+  
+  raw::ADC_Count_t const med = workspace.histogram.median();
+  double const medRMS = median(std::move(workspace.RMSs));
+  
+  ICARUS_LOG_TRACE(fLogCategory) << "Stats of channel "
+    << waveforms.front()->ChannelNumber() << " from "
+    << fParams.nSample << " starting samples of " << waveforms.size()
+    << " waveforms: median=" << med << " ADC, median RMS of each waveform="
+    << medRMS << " ADC";
+  
+  //
+  // second pass: selection of the waveforms
+  //
+  raw::ADC_Count_t const aboveThreshold
+    = static_cast<raw::ADC_Count_t>(std::round(med + medRMS * fParams.nRMS));
+  raw::ADC_Count_t const belowThreshold
+    = static_cast<raw::ADC_Count_t>(std::round(med - medRMS * fParams.nRMS));
+  
+  std::int64_t sum = 0;
+  std::size_t nSamples = 0U;
+  unsigned int nUsedWaveforms = 0U;
+  for (Workspace_t::WaveformSums_t const& sums: workspace.sums) {
+    
+    auto const begin = sums.waveform->cbegin();
+    auto const end = std::next(begin, fParams.nSample);
+    
+    auto const firstExcess = findOutOfBoundary(begin, end,
+      belowThreshold, aboveThreshold,
+      fParams.nExcessSamples, fParams.nExcessSamples
+      );
+    if (firstExcess != end) {
+      
+      if (mf::isDebugEnabled()) {
+        mf::LogTrace log { fLogCategory };
+        log
+          << waveformIntro(sums.waveform) << " has " << fParams.nExcessSamples
+          << " samples in a row out of [ " << belowThreshold << " ; "
+          << aboveThreshold << " ] ADC starting at sample #"
+          << (firstExcess - begin) << ":";
+        for (
+          auto it = firstExcess; it != firstExcess + fParams.nExcessSamples;
+          ++it
+        )
+          log << " " << *it;
+      } // if debug
+      
+      continue;
+    } // if
+    
+    // the sums from the first pass are all we need
+    ++nUsedWaveforms;
+    sum += sums.sum;
+    nSamples += fParams.nSample;
+    
+  } // for
+  
+  if (nSamples > 0) {
+    return {
+        static_cast<double>(sum) / nSamples  // baseline
+      , medRMS                               // RMS
+      , nUsedWaveforms                       // nWaveforms
+      , static_cast<unsigned int>(nSamples)  // nSamples
+      };
+  }
+  else {
+    // backup: take the median of the medians of all waveforms
+    ICARUS_LOG_TRACE(fLogCategory)
+      << "No waveform of channel " << waveforms.front()->ChannelNumber()
+      << " qualified for baseline computation: falling back to use all of them";
+    return {
+        static_cast<double>(medianOfMedians(waveforms, workspace)) // baseline
+      , medRMS                                       // RMS
+      , static_cast<unsigned int>(waveforms.size())  // nWaveforms
+      , 0                                            // nSamples (special value)
+      };
+  }
+  
+} // opdet::SharedWaveformBaseline::operator()(Workspace_t)
+
+
+//------------------------------------------------------------------------------
+auto opdet::SharedWaveformBaseline::groupBaselines(
+  std::vector<WaveformGroup_t> const& groups,
+  std::vector<Workspace_t>& workspaces
+) const -> std::vector<BaselineInfo_t>
+{
+  if (workspaces.empty()) workspaces.emplace_back();
+  
+  std::vector<BaselineInfo_t> baselines(groups.size());
+  
+  // each worker uses its own workspace
+  auto const processGroup = [this,&groups,&workspaces,&baselines]
+    (std::size_t iGroup, unsigned int iWorker)
+    {
+      WaveformGroup_t const group = groups[iGroup];
+      if (group.empty()) return;
+      baselines[iGroup] = (*this)(group, workspaces[iWorker]);
+    };
+  icarus::ns::util::runConcurrently(groups.size(),
+    static_cast<unsigned int>(workspaces.size()), processGroup);
+  
+  return baselines;
+} // opdet::SharedWaveformBaseline::groupBaselines()
+
+
 //------------------------------------------------------------------------------
 std::pair<double, double> opdet::SharedWaveformBaseline::acceptanceRange
   (std::vector<raw::OpDetWaveform const*> const& waveforms) const
 {
-  std::vector<raw::ADC_Count_t> samples;
-  samples.reserve(fParams.nSample * waveforms.size());
+  icarus::ns::util::CountingMedian<raw::ADC_Count_t> samples;
   std::vector<double> RMSs;
   RMSs.reserve(waveforms.size());
   
   for (raw::OpDetWaveform const* waveform: waveforms) {
     
-    mf::LogTrace{ fLogCategory }
+    ICARUS_LOG_TRACE(fLogCategory)
       << "Now processing: " << waveformIntro(waveform);
     
     if (waveform->size() < fParams.nSample) {
-      mf::LogTrace{ fLogCategory } << waveformIntro(waveform)
+      ICARUS_LOG_TRACE(fLogCategory) << waveformIntro(waveform)
         << ": skipped because shorter than " << fParams.nSample
         << " samples";
       continue;
@@ -260,13 +404,13 @@ std::pair<double, double> opdet::SharedWaveformBaseline::acceptanceRange
     for (auto it = begin; it != end; ++it) stats.add(*it);
     RMSs.push_back(stats.RMS());
     
-    std::copy(waveform->begin(), waveform->end(), back_inserter(samples));
+    samples.add(waveform->begin(), waveform->end());
   } // for
   
-  raw::ADC_Count_t const med = median(std::move(samples));
+  raw::ADC_Count_t const med = samples.median();
   double const medRMS = median(std::move(RMSs));
   
-  mf::LogTrace{ fLogCategory } << "Stats of channel "
+  ICARUS_LOG_TRACE(fLogCategory) << "Stats of channel "
     << waveforms.front()->ChannelNumber() << " from "
     << fParams.nSample << " starting samples of " << waveforms.size()
     << " waveforms: median=" << med << " ADC, median RMS of each waveform="
@@ -284,13 +428,14 @@ std::vector<raw::ADC_Count_t> opdet::SharedWaveformBaseline::waveformMedians
   std::vector<raw::ADC_Count_t> medians;
   medians.reserve(waveforms.size());
   
+  icarus::ns::util::CountingMedian<raw::ADC_Count_t> samples;
   for (raw::OpDetWaveform const* waveform: waveforms) {
     
     if (waveform->empty()) continue;
       
-    medians.push_back(median(waveform->begin(), waveform->end()));
+    medians.push_back(samples.median(waveform->begin(), waveform->end()));
     
-    mf::LogTrace{ fLogCategory } << "Median of " << waveformIntro(waveform)
+    ICARUS_LOG_TRACE(fLogCategory) << "Median of " << waveformIntro(waveform)
       << ": " << medians.back() << " ADC#";
     
   } // for
@@ -310,6 +455,35 @@ raw::ADC_Count_t opdet::SharedWaveformBaseline::medianOfMedians
 } // opdet::SharedWaveformBaseline::medianOfMedians()
 
 
+//------------------------------------------------------------------------------
+raw::ADC_Count_t opdet::SharedWaveformBaseline::medianOfMedians
+  (WaveformGroup_t waveforms, Workspace_t& workspace) const
+{
+  
+  workspace.medians.clear();
+  for (raw::OpDetWaveform const* waveform: waveforms) {
+    
+    if (waveform->empty()) continue;
+    
+    workspace.medians.push_back
+      (workspace.histogram.median(waveform->begin(), waveform->end()));
+    
+    ICARUS_LOG_TRACE(fLogCategory) << "Median of " << waveformIntro(waveform)
+      << ": " << workspace.medians.back() << " ADC#";
+    
+  } // for
+  
+  if (workspace.medians.empty()) {
+    throw cet::exception("SharedWaveformBaseline")
+      << "All the " << waveforms.size() << " waveforms of channel "
+      << waveforms.front()->ChannelNumber() << " are empty.\n";
+  }
+  
+  return median(std::move(workspace.medians));
+  
+} // opdet::SharedWaveformBaseline::medianOfMedians(Workspace_t)
+
+
 //------------------------------------------------------------------------------
 raw::ADC_Count_t opdet::SharedWaveformBaseline::maximumOfMedians
   (std::vector<raw::OpDetWaveform const*> const& waveforms) const
@@ -329,7 +503,7 @@ raw::ADC_Count_t opdet::SharedWaveformBaseline::maximaMedian
   
   for (raw::OpDetWaveform const* waveform: waveforms) {
     
-    mf::LogTrace{ fLogCategory }
+    ICARUS_LOG_TRACE(fLogCategory)
       << "Now processing: " << waveformIntro(waveform);
     
     if (waveform->empty()) continue;
@@ -10,16 +10,24 @@
 #define ICARUSALG_PMT_ALGORITHMS_SHAREDWAVEFORMBASELINE_H
 
 
+// ICARUS libraries
+#include "icarusalg/Utilities/CountingMedian.h"
+
 // LArSoft libraries
 #include <cstdint>  // uint16_t in OpDetWaveform.h
 #include "lardataobj/RawData/OpDetWaveform.h"
 
 // C/C++ standard libraries
+#include "gsl/span"
 #include <vector>
 #include <utility> // std::move()
 #include <string>
 #include <ostream>
-#include <cstdint> // std::size_t
+#include <algorithm> // std::max()
+#include <thread> // std::thread::hardware_concurrency()
+#include <limits>
+#include <cstdint> // std::int64_t
+#include <cstddef> // std::size_t
 
 
 // -----------------------------------------------------------------------------
@@ -53,6 +61,44 @@ namespace opdet { class SharedWaveformBaseline; }
  * The parameters are specified at algorithm construction time and are contained
  * in the `Params_t` object.
  * 
+ * 
+ * Single-pass mode
+ * -----------------
+ * 
+ * When called with a `Workspace_t` object, the algorithm follows the same
+ * steps, but reads the first portion of each waveform only twice: the sums
+ * needed for the RMS and the average, and a histogram of the sample values
+ * for the median, are collected in a single pass (steps 1, 2 and 5), and the
+ * second pass only checks the acceptance range (step 4).
+ * All the scratch memory is kept in the workspace, which should be reused
+ * for all the calls (e.g. one workspace for all the channels of an event, and
+ * for all the events): after the first few calls, no more memory is allocated.
+ * A workspace can't be used by multiple calls at the same time.
+ * 
+ * The results are the same as the ones of the standard mode, except that:
+ * * the median of step 2 is computed only from the first portion of each
+ *   waveform, as in the description above (the standard mode uses all the
+ *   samples of the waveforms);
+ * * waveforms shorter than the first portion are always excluded (in the
+ *   standard mode they are excluded only from steps 1 and 2).
+ * 
+ * 
+ * Multiple channels
+ * ------------------
+ * 
+ * `channelBaselines()` extracts the baselines of all the channels of an event
+ * at once, using the single-pass mode. The waveforms must be already grouped by
+ * channel, e.g. with `icarus::ns::util::GroupByIndex`:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::GroupByIndex const byChannel
+ *  { waveforms, std::mem_fn(&raw::OpDetWaveform::ChannelNumber) };
+ * 
+ * std::vector<opdet::SharedWaveformBaseline::BaselineInfo_t> const baselines
+ *   = baselineAlg.channelBaselines(byChannel, 4U);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * The channels can be processed by multiple threads, each with its own
+ * workspace.
+ * 
  */
 class opdet::SharedWaveformBaseline {
     public:
@@ -101,6 +147,40 @@ class opdet::SharedWaveformBaseline {
   }; // BaselineInfo_t
   
   
+  /// Type of group of waveforms sharing the same baseline.
+  using WaveformGroup_t = gsl::span<raw::OpDetWaveform const* const>;
+  
+  
+  /**
+   * @brief Scratch memory for the single-pass mode.
+   * 
+   * The content of this object is meaningful only to the algorithm,
+   * and it is overwritten on each call.
+   */
+  class Workspace_t {
+    
+    friend class SharedWaveformBaseline;
+    
+    /// Sums from the first portion of a waveform.
+    struct WaveformSums_t {
+      raw::OpDetWaveform const* waveform = nullptr;
+      std::int64_t sum = 0; ///< Sum of the samples.
+      std::int64_t sumSq = 0; ///< Sum of the squares of the samples.
+    }; // WaveformSums_t
+    
+    /// Sums of each waveform with enough samples.
+    std::vector<WaveformSums_t> sums;
+    
+    std::vector<double> RMSs; ///< RMS of each waveform with enough samples.
+    
+    std::vector<raw::ADC_Count_t> medians; ///< Median of each waveform.
+    
+    /// Histogram of the samples.
+    icarus::ns::util::CountingMedian<raw::ADC_Count_t> histogram;
+    
+  }; // Workspace_t
+  
+  
   SharedWaveformBaseline(Params_t params, std::string logCategory):
       fParams{ std::move(params) }
     , fLogCategory{ std::move(logCategory) }
@@ -110,15 +190,77 @@ class opdet::SharedWaveformBaseline {
   BaselineInfo_t operator()
     (std::vector<raw::OpDetWaveform const*> const& waveforms) const;
   
+  /**
+   * @brief Returns a common baseline from all the specified waveforms.
+   * @param waveforms the waveforms to extract the baseline from
+   * @param workspace scratch memory, reused across calls
+   * @return the baseline information
+   * @throw cet::exception (category: `SharedWaveformBaseline`) if all the
+   *        `waveforms` are empty
+   * @see `Workspace_t`
+   * 
+   * This is the single-pass mode described in the class documentation.
+   */
+  BaselineInfo_t operator()
+    (WaveformGroup_t waveforms, Workspace_t& workspace) const;
+  
+  /**
+   * @brief Returns the baselines of all the channels.
+   * @tparam Groups type of collection of groups of waveforms
+   * @param byChannel the waveforms of each channel
+   * @param nThreads number of threads to use (`0`: one per hardware core)
+   * @return the baseline of each channel, indexed by channel number
+   * 
+   * The collection `byChannel` must include one group of waveforms per
+   * channel, each group being a contiguous sequence of
+   * `raw::OpDetWaveform const*` (like `std::vector` or a span) with all the
+   * waveforms of that channel, in channel order; for example,
+   * `icarus::ns::util::GroupByIndex<raw::OpDetWaveform>`.
+   * Each group is converted into a `WaveformGroup_t` span, and its baseline
+   * is extracted with the single-pass mode
+   * (see `operator()(WaveformGroup_t, Workspace_t&) const`).
+   * Channels with no waveform have a default `BaselineInfo_t` baseline.
+   * 
+   * The groups are distributed among `nThreads` threads, each one using its
+   * own workspace. The result does not depend on the number of threads.
+   * If the extraction of any group throws an exception, the exception is
+   * rethrown in the calling thread after all the threads are done.
+   */
+  template <typename Groups>
+  std::vector<BaselineInfo_t> channelBaselines
+    (Groups const& byChannel, unsigned int nThreads = 1U) const;
+  
+  /**
+   * @brief Returns the baselines of all the channels.
+   * @tparam Groups type of collection of groups of waveforms
+   * @param byChannel the waveforms of each channel
+   * @param workspaces scratch memory, one per thread, reused across calls
+   * @return the baseline of each channel, indexed by channel number
+   * @see `channelBaselines(Groups const&, unsigned int) const`
+   * 
+   * One thread is used for each of the workspaces. If `workspaces` is empty,
+   * a workspace is added and a single thread is used.
+   */
+  template <typename Groups>
+  std::vector<BaselineInfo_t> channelBaselines
+    (Groups const& byChannel, std::vector<Workspace_t>& workspaces) const;
+  
   /// Returns the set of configuration parameters of this algorithm.
   Params_t const& parameters() const { return fParams; }
   
     private:
+  
   Params_t fParams; ///< Algorithm parameters.
   
   std::string fLogCategory; ///< Name of stream category for console messages.
   
   
+  /// Returns the baseline of each of the `groups`, using all `workspaces`.
+  std::vector<BaselineInfo_t> groupBaselines(
+    std::vector<WaveformGroup_t> const& groups,
+    std::vector<Workspace_t>& workspaces
+    ) const;
+  
   /// Returns central value and radius for the accepted sample range.
   std::pair<double, double> acceptanceRange
     (std::vector<raw::OpDetWaveform const*> const& waveforms) const;
@@ -139,6 +281,10 @@ class opdet::SharedWaveformBaseline {
   raw::ADC_Count_t maximumOfMedians
     (std::vector<raw::OpDetWaveform const*> const& waveforms) const;
   
+  /// Single-pass version of `medianOfMedians()`, using the `workspace`.
+  raw::ADC_Count_t medianOfMedians
+    (WaveformGroup_t waveforms, Workspace_t& workspace) const;
+  
 }; // opdet::SharedWaveformBaseline
 
 
@@ -154,6 +300,30 @@ namespace opdet {
 
 //------------------------------------------------------------------------------
 //---  Template implementation
+//------------------------------------------------------------------------------
+template <typename Groups>
+auto opdet::SharedWaveformBaseline::channelBaselines
+  (Groups const& byChannel, unsigned int nThreads /* = 1U */) const
+  -> std::vector<BaselineInfo_t>
+{
+  if (nThreads == 0U) nThreads = std::thread::hardware_concurrency();
+  std::vector<Workspace_t> workspaces(std::max(nThreads, 1U));
+  return channelBaselines(byChannel, workspaces);
+} // opdet::SharedWaveformBaseline::channelBaselines(unsigned int)
+
+
+//------------------------------------------------------------------------------
+template <typename Groups>
+auto opdet::SharedWaveformBaseline::channelBaselines
+  (Groups const& byChannel, std::vector<Workspace_t>& workspaces) const
+  -> std::vector<BaselineInfo_t>
+{
+  std::vector<WaveformGroup_t> groups;
+  for (auto const& group: byChannel) groups.emplace_back(group);
+  return groupBaselines(groups, workspaces);
+} // opdet::SharedWaveformBaseline::channelBaselines(workspaces)
+
+
 //------------------------------------------------------------------------------
 template <typename Stream>
 void opdet::SharedWaveformBaseline::Params_t::dump(
@@ -0,0 +1,75 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/StreamingWaveformBaseline.cxx
+ * @brief  Baseline following a PMT waveform, sample by sample.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    icarusalg/PMT/Algorithms/StreamingWaveformBaseline.h
+ */
+
+// library header
+#include "icarusalg/PMT/Algorithms/StreamingWaveformBaseline.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy(), std::fill(), std::min(), std::max()
+#include <utility> // std::move()
+
+
+//------------------------------------------------------------------------------
+//---  opdet::StreamingWaveformBaseline
+//------------------------------------------------------------------------------
+opdet::StreamingWaveformBaseline::StreamingWaveformBaseline(Params_t params)
+  : fParams{ std::move(params) }
+{
+  if (fParams.windowSize == 0U) {
+    throw cet::exception("StreamingWaveformBaseline")
+      << "The window of the running baseline must include at least one sample.\n";
+  }
+  fWindow.resize(fParams.windowSize);
+  fCounts.resize(InitialBins, 0U);
+} // opdet::StreamingWaveformBaseline::StreamingWaveformBaseline()
+
+
+//------------------------------------------------------------------------------
+void opdet::StreamingWaveformBaseline::reset() {
+  
+  // only the counters of the samples in the window may be non-zero
+  for (std::size_t i = 0; i < fNInWindow; ++i) count(fWindow[i]) = 0U;
+  
+  fNext = 0U;
+  fNInWindow = 0U;
+  fNSamples = 0U;
+  fNBelow = 0U;
+  
+} // opdet::StreamingWaveformBaseline::reset()
+
+
+//------------------------------------------------------------------------------
+void opdet::StreamingWaveformBaseline::extendTo(int value) {
+  
+  // the current range spans the values in the window, and the median
+  int lower = std::min<int>(value, fMedian);
+  int upper = std::max<int>(value, fMedian);
+  for (std::size_t i = 0; i < fNInWindow; ++i) {
+    lower = std::min<int>(lower, fWindow[i]);
+    upper = std::max<int>(upper, fWindow[i]);
+  }
+  std::size_t const span = upper - lower + 1;
+  
+  // leave room for a further spread of the same size
+  std::size_t newSize = fCounts.size();
+  while (newSize < 2 * span) newSize *= 2;
+  int const newOffset = lower - static_cast<int>((newSize - span) / 2);
+  
+  std::vector<unsigned int> counts(newSize, 0U);
+  for (int v = lower; v <= upper; ++v)
+    if (hasCounter(v)) counts[v - newOffset] = count(v);
+  fCounts = std::move(counts);
+  fOffset = newOffset;
+  
+} // opdet::StreamingWaveformBaseline::extendTo()
+
+
+//------------------------------------------------------------------------------
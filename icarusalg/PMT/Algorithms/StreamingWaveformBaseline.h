@@ -0,0 +1,244 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/StreamingWaveformBaseline.h
+ * @brief  Baseline following a PMT waveform, sample by sample.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    icarusalg/PMT/Algorithms/StreamingWaveformBaseline.cxx
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_STREAMINGWAVEFORMBASELINE_H
+#define ICARUSALG_PMT_ALGORITHMS_STREAMINGWAVEFORMBASELINE_H
+
+
+// LArSoft libraries
+#include <cstdint>  // uint16_t in OpDetWaveform.h
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::ADC_Count_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet { class StreamingWaveformBaseline; }
+/**
+ * @class opdet::StreamingWaveformBaseline
+ * @brief Running median of the last samples of a waveform.
+ * 
+ * This algorithm estimates a baseline which follows the waveform, as the
+ * median of the last `windowSize` samples: the baseline at a given sample is
+ * the median of that sample and of the `windowSize - 1` ones before it.
+ * Pulses shorter than about half the window are therefore ignored, while
+ * slow drifts of the baseline are followed with a delay of about half the
+ * window.
+ * Until the window is full (see `ready()`), the median of all the samples
+ * so far is used.
+ * 
+ * The samples are fed one at a time (`add()`) or in chunks (`process()`),
+ * so that a long waveform can be processed while it is read, and chunks
+ * from the same waveform must be fed in order. Only the samples in the window
+ * are kept. Use `reset()` before starting a new waveform.
+ * 
+ * The median is tracked with a histogram of the values in the window:
+ * each new sample costs a number of operations proportional to the change in
+ * median value (in ADC counts), which for a baseline is usually none or one.
+ * Memory is allocated on construction and whenever the spread of the values
+ * exceeds the one seen so far; reusing the same object for many waveforms
+ * avoids further allocations.
+ * 
+ * The median is defined as the `windowSize/2`-th value (starting from `0`)
+ * of the sorted samples in the window.
+ * 
+ * The parameters are specified at algorithm construction time and are
+ * contained in the `Params_t` object.
+ * 
+ */
+class opdet::StreamingWaveformBaseline {
+    public:
+  
+  using Sample_t = raw::ADC_Count_t; ///< Type of waveform sample.
+  
+  /// Algorithm configuration parameters.
+  struct Params_t {
+    
+    std::size_t windowSize; ///< Number of samples in the running window.
+    
+    /// Dumps this configuration into the output stream `out`.
+    template <typename Stream>
+    void dump(
+      Stream& out,
+      std::string const& indent, std::string const& firstIndent
+      ) const;
+    template <typename Stream>
+    void dump(Stream& out, std::string const& indent = "") const
+      { dump(out, indent, indent); }
+    
+  }; // Params_t
+  
+  
+  /// Constructor: prepares the algorithm (window size must not be `0`).
+  StreamingWaveformBaseline(Params_t params);
+  
+  
+  /// Forgets all the samples, to start a new waveform.
+  void reset();
+  
+  /// Adds the next `sample` of the waveform and returns the updated baseline.
+  Sample_t add(Sample_t sample);
+  
+  /**
+   * @brief Adds the next chunk of samples of the waveform.
+   * @tparam BIter type of iterator to the first sample
+   * @tparam EIter type of iterator past the last sample
+   * @tparam OIter type of output iterator for the baselines
+   * @param begin iterator to the first sample of the chunk
+   * @param end iterator past the last sample of the chunk
+   * @param baselines output iterator receiving the baseline at each sample
+   * @return the output iterator past the last written baseline
+   */
+  template <typename BIter, typename EIter, typename OIter>
+  OIter process(BIter begin, EIter end, OIter baselines);
+  
+  /// Adds the next chunk of samples of the waveform; returns the baseline.
+  template <typename BIter, typename EIter>
+  Sample_t process(BIter begin, EIter end);
+  
+  
+  /// Returns the current baseline (undefined if no sample was added).
+  Sample_t baseline() const { return fMedian; }
+  
+  /// Returns whether the window is full of samples.
+  bool ready() const { return fNInWindow == fWindow.size(); }
+  
+  /// Returns the number of samples added since the last reset.
+  std::size_t nSamples() const { return fNSamples; }
+  
+  /// Returns the set of configuration parameters of this algorithm.
+  Params_t const& parameters() const { return fParams; }
+  
+  
+    private:
+  
+  /// Number of counters allocated at the first sample.
+  static constexpr std::size_t InitialBins = 256U;
+  
+  Params_t fParams; ///< Algorithm parameters.
+  
+  std::vector<Sample_t> fWindow; ///< Ring buffer of the samples in window.
+  std::size_t fNext = 0U; ///< Position in the ring of the next sample.
+  std::size_t fNInWindow = 0U; ///< Number of samples in the window.
+  std::size_t fNSamples = 0U; ///< Number of samples since reset.
+  
+  std::vector<unsigned int> fCounts; ///< Count of each value in the window.
+  int fOffset = 0; ///< Value counted in `fCounts[0]`.
+  
+  Sample_t fMedian = 0; ///< Current median.
+  std::size_t fNBelow = 0U; ///< Samples in window with value below median.
+  
+  
+  /// Returns the counter of `value` (which must have one).
+  unsigned int& count(int value) { return fCounts[value - fOffset]; }
+  
+  /// Returns whether `value` has a counter.
+  bool hasCounter(int value) const
+    { return (value >= fOffset) && (value - fOffset < (int) fCounts.size()); }
+  
+  /// Relocates the counters so that `value` has one too.
+  void extendTo(int value);
+  
+  /// Moves the median to the right value after changes in the window.
+  void updateMedian();
+  
+}; // opdet::StreamingWaveformBaseline
+
+
+//------------------------------------------------------------------------------
+namespace opdet {
+  
+  inline std::ostream& operator<<
+    (std::ostream& out, StreamingWaveformBaseline::Params_t const& params)
+    { params.dump(out); return out; }
+
+} // namespace opdet
+
+
+//------------------------------------------------------------------------------
+//---  Inline and template implementation
+//------------------------------------------------------------------------------
+inline auto opdet::StreamingWaveformBaseline::add(Sample_t sample) -> Sample_t
+{
+  if (fNSamples++ == 0U) {
+    // start the counters centered on the first sample
+    fOffset = sample - static_cast<int>(fCounts.size() / 2);
+    fMedian = sample;
+    fNBelow = 0U;
+  }
+  else if (!hasCounter(sample)) extendTo(sample);
+  
+  // the sample leaving the window
+  if (ready()) {
+    Sample_t const old = fWindow[fNext];
+    --count(old);
+    if (old < fMedian) --fNBelow;
+  }
+  else ++fNInWindow;
+  
+  fWindow[fNext] = sample;
+  if (++fNext == fWindow.size()) fNext = 0U;
+  ++count(sample);
+  if (sample < fMedian) ++fNBelow;
+  
+  updateMedian();
+  return fMedian;
+} // opdet::StreamingWaveformBaseline::add()
+
+
+//------------------------------------------------------------------------------
+inline void opdet::StreamingWaveformBaseline::updateMedian() {
+  
+  // the median is the value with `target` samples below it, or less, and
+  // more than `target` samples up to it
+  std::size_t const target = fNInWindow / 2;
+  while (fNBelow > target) fNBelow -= count(--fMedian);
+  while (fNBelow + count(fMedian) <= target) fNBelow += count(fMedian++);
+  
+} // opdet::StreamingWaveformBaseline::updateMedian()
+
+
+//------------------------------------------------------------------------------
+template <typename BIter, typename EIter, typename OIter>
+OIter opdet::StreamingWaveformBaseline::process
+  (BIter begin, EIter end, OIter baselines)
+{
+  for (auto it = begin; it != end; ++it) *(baselines++) = add(*it);
+  return baselines;
+} // opdet::StreamingWaveformBaseline::process()
+
+
+//------------------------------------------------------------------------------
+template <typename BIter, typename EIter>
+auto opdet::StreamingWaveformBaseline::process(BIter begin, EIter end)
+  -> Sample_t
+{
+  for (auto it = begin; it != end; ++it) add(*it);
+  return baseline();
+} // opdet::StreamingWaveformBaseline::process()
+
+
+//------------------------------------------------------------------------------
+template <typename Stream>
+void opdet::StreamingWaveformBaseline::Params_t::dump(
+  Stream& out,
+  std::string const& /* indent */, std::string const& firstIndent
+  ) const
+{
+  out << firstIndent << "running median of the last " << windowSize
+    << " samples";
+} // opdet::StreamingWaveformBaseline::Params_t::dump()
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_STREAMINGWAVEFORMBASELINE_H
@@ -0,0 +1,162 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/WaveformCodec.cxx
+ * @brief  Compact encoding of PMT waveform samples around their baseline.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/WaveformCodec.h
+ */
+
+// library header
+#include "icarusalg/PMT/Algorithms/WaveformCodec.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <cstdint> // std::int32_t, std::uint32_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Maps a signed difference into a non-negative number (0, -1, 1, -2...).
+  constexpr std::uint32_t zigzag(std::int32_t d)
+    {
+      return (static_cast<std::uint32_t>(d) << 1)
+        ^ static_cast<std::uint32_t>(d >> 31);
+    }
+
+  /// Inverse of `zigzag()`.
+  constexpr std::int32_t unzigzag(std::uint32_t u)
+    {
+      return static_cast<std::int32_t>(u >> 1)
+        ^ -static_cast<std::int32_t>(u & 1U);
+    }
+
+  static_assert(zigzag(0) == 0U);
+  static_assert(zigzag(-1) == 1U);
+  static_assert(zigzag(1) == 2U);
+  static_assert(unzigzag(zigzag(-65535)) == -65535);
+  static_assert(unzigzag(zigzag(65535)) == 65535);
+
+  /// Returns the number of bits needed to represent `value`.
+  unsigned int bitWidth(std::uint32_t value) {
+    unsigned int width = 0U;
+    while (value) { ++width; value >>= 1; }
+    return width;
+  } // bitWidth()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+//---  opdet::WaveformCodec
+//------------------------------------------------------------------------------
+void opdet::WaveformCodec::encode(
+  Sample_t const* samples, std::size_t nSamples, Sample_t reference,
+  EncodedWaveform& encoded
+) {
+
+  std::size_t const nBlocks = (nSamples + BlockSize - 1) / BlockSize;
+
+  encoded.nSamples = nSamples;
+  encoded.reference = reference;
+  encoded.widths.resize(nBlocks);
+  encoded.words.clear();
+  encoded.words.reserve(nBlocks * MaxWidth); // no reallocation in the loop
+
+  std::uint32_t values[BlockSize];
+  for (std::size_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+
+    Sample_t const* blockSamples = samples + iBlock * BlockSize;
+    std::size_t const n
+      = std::min(BlockSize, nSamples - iBlock * BlockSize);
+
+    // the width of the largest value is the one of the bitwise OR of all
+    std::uint32_t allBits = 0U;
+    for (std::size_t i = 0; i < BlockSize; ++i) {
+      values[i] = (i < n)
+        ? zigzag(std::int32_t{ blockSamples[i] } - std::int32_t{ reference })
+        : 0U;
+      allBits |= values[i];
+    } // for
+
+    unsigned int const width = bitWidth(allBits);
+    encoded.widths[iBlock] = static_cast<std::uint8_t>(width);
+    if (width == 0U) continue; // all samples are equal to the reference
+
+    // a block of `BlockSize` (32) values with `width` bits takes `width` words
+    std::size_t const start = encoded.words.size();
+    encoded.words.resize(start + width, 0U);
+    std::uint32_t* const out = encoded.words.data() + start;
+    for (std::size_t i = 0; i < BlockSize; ++i) {
+      std::size_t const bit = i * width;
+      unsigned int const shift = bit % 32U;
+      out[bit / 32U] |= values[i] << shift;
+      if (shift + width > 32U)
+        out[bit / 32U + 1U] |= values[i] >> (32U - shift);
+    } // for
+
+  } // for blocks
+
+} // opdet::WaveformCodec::encode()
+
+
+//------------------------------------------------------------------------------
+auto opdet::WaveformCodec::encode
+  (std::vector<Sample_t> const& samples, Sample_t reference) -> EncodedWaveform
+{
+  EncodedWaveform encoded;
+  encode(samples, reference, encoded);
+  return encoded;
+} // opdet::WaveformCodec::encode()
+
+
+//------------------------------------------------------------------------------
+void opdet::WaveformCodec::decode
+  (EncodedWaveform const& encoded, std::vector<Sample_t>& samples)
+{
+  std::size_t const nSamples = encoded.nSamples;
+  std::int32_t const reference = encoded.reference;
+
+  samples.resize(nSamples);
+
+  std::uint32_t const* in = encoded.words.data();
+  for (std::size_t iBlock = 0; iBlock < encoded.nBlocks(); ++iBlock) {
+
+    Sample_t* const blockSamples = samples.data() + iBlock * BlockSize;
+    std::size_t const n
+      = std::min(BlockSize, nSamples - iBlock * BlockSize);
+    unsigned int const width = encoded.widths[iBlock];
+
+    if (width == 0U) {
+      std::fill(blockSamples, blockSamples + n, encoded.reference);
+      continue;
+    }
+
+    std::uint32_t const mask = (std::uint32_t{ 1U } << width) - 1U;
+    for (std::size_t i = 0; i < n; ++i) {
+      std::size_t const bit = i * width;
+      unsigned int const shift = bit % 32U;
+      std::uint32_t value = in[bit / 32U] >> shift;
+      if (shift + width > 32U) value |= in[bit / 32U + 1U] << (32U - shift);
+      blockSamples[i]
+        = static_cast<Sample_t>(reference + unzigzag(value & mask));
+    } // for
+
+    in += width;
+
+  } // for blocks
+
+} // opdet::WaveformCodec::decode()
+
+
+//------------------------------------------------------------------------------
+auto opdet::WaveformCodec::decode(EncodedWaveform const& encoded)
+  -> std::vector<Sample_t>
+{
+  std::vector<Sample_t> samples;
+  decode(encoded, samples);
+  return samples;
+} // opdet::WaveformCodec::decode()
+
+
+//------------------------------------------------------------------------------
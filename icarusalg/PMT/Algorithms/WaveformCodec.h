@@ -0,0 +1,161 @@
+/**
+ * @file   icarusalg/PMT/Algorithms/WaveformCodec.h
+ * @brief  Compact encoding of PMT waveform samples around their baseline.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/PMT/Algorithms/WaveformCodec.cxx
+ */
+
+#ifndef ICARUSALG_PMT_ALGORITHMS_WAVEFORMCODEC_H
+#define ICARUSALG_PMT_ALGORITHMS_WAVEFORMCODEC_H
+
+
+// LArSoft libraries
+#include <cstdint>  // uint16_t in OpDetWaveform.h
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::ADC_Count_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cmath> // std::round()
+#include <cstdint> // std::uint8_t, std::uint32_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet {
+
+  struct EncodedWaveform;
+  class WaveformCodec;
+
+} // namespace opdet
+
+
+/// Samples of a waveform encoded by `opdet::WaveformCodec`.
+struct opdet::EncodedWaveform {
+
+  std::size_t nSamples = 0U; ///< Number of encoded samples.
+
+  raw::ADC_Count_t reference = 0; ///< Value the samples are encoded from.
+
+  /// Bits per sample of each block (one entry per block).
+  std::vector<std::uint8_t> widths;
+
+  /// Packed sample differences (each block takes as many words as its width).
+  std::vector<std::uint32_t> words;
+
+  /// Returns the number of blocks.
+  std::size_t nBlocks() const { return widths.size(); }
+
+  /// Returns the size of the encoded data, in bytes.
+  std::size_t bytes() const
+    {
+      return sizeof(nSamples) + sizeof(reference)
+        + widths.size() * sizeof(std::uint8_t)
+        + words.size() * sizeof(std::uint32_t);
+    }
+
+  /// Removes all the content (memory is kept).
+  void clear() { nSamples = 0U; reference = 0; widths.clear(); words.clear(); }
+
+}; // opdet::EncodedWaveform
+
+
+/**
+ * @class opdet::WaveformCodec
+ * @brief Lossless compression of PMT waveform samples.
+ *
+ * The samples of a PMT waveform spend most of the time in a narrow band around
+ * the baseline. This codec stores the difference of each sample from a
+ * reference value, usually the baseline (see `referenceFor()`), using only as
+ * many bits as needed: a noise of a few ADC counts takes 3 to 5 bits per
+ * sample instead of 16.
+ *
+ * The samples are encoded in blocks of `BlockSize` (32) samples. In each
+ * block, the differences are mapped to non-negative numbers
+ * (_zig-zag_ encoding: `0, -1, 1, -2, 2...` become `0, 1, 2, 3, 4...`), and
+ * they are all stored with the number of bits of the largest one (the _width_
+ * of the block, from 0 to 17) in consecutive bits of 32-bit words. Therefore a
+ * block with width `w` occupies exactly `w` words, and the only per-block
+ * metadata is its width (one byte). The last block is padded with the
+ * reference value. Blocks with a pulse are wider, without affecting the rest
+ * of the waveform.
+ *
+ * The fixed block size and the regular layout make the encoding and decoding
+ * loops of each block fixed-length and branch-free, easy for the compiler to
+ * unroll and vectorize; decoding a block does not depend on any other block.
+ *
+ * Encoding and decoding into the same objects repeatedly does not allocate
+ * memory after the first waveforms.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * opdet::EncodedWaveform encoded;
+ * opdet::WaveformCodec::encode
+ *   (waveform, opdet::WaveformCodec::referenceFor(baseline), encoded);
+ *
+ * std::vector<raw::ADC_Count_t> samples;
+ * opdet::WaveformCodec::decode(encoded, samples); // same as `waveform`
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class opdet::WaveformCodec {
+    public:
+
+  using Sample_t = raw::ADC_Count_t; ///< Type of waveform sample.
+
+  /// Number of samples in each block.
+  static constexpr std::size_t BlockSize = 32U;
+
+  /// Largest number of bits used by a sample.
+  static constexpr unsigned int MaxWidth = 17U;
+
+
+  /// Returns the reference value closest to the specified `baseline`.
+  static Sample_t referenceFor(double baseline)
+    { return static_cast<Sample_t>(std::round(baseline)); }
+
+  // @{
+  /**
+   * @brief Encodes the samples of a waveform.
+   * @param samples pointer to the first sample
+   * @param nSamples number of samples
+   * @param reference value the samples are encoded from (e.g. the baseline)
+   * @param[out] encoded object to store the encoded samples into
+   *
+   * The previous content of `encoded` is replaced.
+   * Any `reference` is acceptable, but the closer to most of the samples, the
+   * more compact the encoding.
+   */
+  static void encode(
+    Sample_t const* samples, std::size_t nSamples, Sample_t reference,
+    EncodedWaveform& encoded
+    );
+  static void encode(
+    std::vector<Sample_t> const& samples, Sample_t reference,
+    EncodedWaveform& encoded
+    )
+    { encode(samples.data(), samples.size(), reference, encoded); }
+  // @}
+
+  /// Returns the encoded `samples` (see `encode()`).
+  static EncodedWaveform encode
+    (std::vector<Sample_t> const& samples, Sample_t reference);
+
+  /**
+   * @brief Decodes the samples of a waveform.
+   * @param encoded the encoded samples
+   * @param[out] samples where to store the decoded samples
+   *
+   * The previous content of `samples` is replaced.
+   */
+  static void decode
+    (EncodedWaveform const& encoded, std::vector<Sample_t>& samples);
+
+  /// Returns the samples decoded from `encoded`.
+  static std::vector<Sample_t> decode(EncodedWaveform const& encoded);
+
+}; // opdet::WaveformCodec
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSALG_PMT_ALGORITHMS_WAVEFORMCODEC_H
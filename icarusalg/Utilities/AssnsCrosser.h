@@ -8,6 +8,10 @@
 #ifndef ICARUSALG_UTILITIES_ASSNSCROSSER_H
 #define ICARUSALG_UTILITIES_ASSNSCROSSER_H
 
+// ICARUS libraries
+#include "icarusalg/Utilities/Instrumentation.h" // ICARUS_SCOPED_TIMER()
+#include "icarusalg/Utilities/runConcurrently.h"
+
 // LArSoft libraries
 #include "larcorealg/CoreUtils/DebugUtils.h" // lar::debug::demangle()
 #include "larcorealg/CoreUtils/enumerate.h"
@@ -23,8 +27,12 @@
 #include "canvas/Utilities/InputTag.h"
 #include "canvas/Utilities/Exception.h"
 
+// Guideline Support Library
+#include "gsl/span"
+
 // C/C++ standard libraries
 #include <algorithm> // std::set_difference(), std::any_of(), ...
+#include <numeric> // std::partial_sum()
 #include <functional> // std::mem_fn()
 #include <utility> // std::move(), std::forward()
 #include <ostream>
@@ -33,11 +41,14 @@
 #include <optional>
 #include <initializer_list>
 #include <unordered_map>
+#include <unordered_set>
 #include <tuple>
+#include <memory> // std::shared_ptr
 #include <string>
 #include <iterator> // std::move_iterator, std::back_inserter
 #include <stdexcept> // std::logic_error
 #include <type_traits> // std::is_constructible_v, std::enable_if_t...
+#include <chrono>
 #include <cstddef>
 #include <cassert>
 
@@ -51,6 +62,9 @@ namespace icarus::ns::util {
   template <typename T> using hopTo = InputSpecs<T>;
   template <typename T> using startFrom = StartSpecs<T>;
   template <typename KeyType, typename... OtherTypes> class AssnsCrosser;
+  struct AssnsCrosserHopTiming;
+  struct AssnsCrosserOptions;
+  class AssnsCrosserCache;
   
   template <typename KeyType, typename... OtherTypes, typename Event>
   AssnsCrosser<KeyType, OtherTypes...> makeAssnsCrosser
@@ -74,8 +88,14 @@ namespace icarus::ns::util {
     template <typename SupportedVariants> class SpecBase;
     template <typename SpecType> class InputSpecsBase;
     template <typename KeyType, typename TargetType> class AssnsMap;
+    template <typename KeyType, typename TargetType> class FlatAssnsMap;
+    struct IndexAssns;
+    template <typename KeyType, typename... HopTypes> struct IndexJoiner;
     template <typename KeyType, typename... OtherTypes> class AssnsCrosserTypes;
     template <typename T> struct PointerSelector;
+    template <typename T> class FrontierSelector;
+    struct HopStats;
+    class TraversalCostModel;
     using SupportedInputSpecs = std::variant<
         std::monostate
       , art::InputTag
@@ -97,6 +117,163 @@ namespace icarus::ns::util {
   
 } // namespace icarus::ns::util
 
+// -----------------------------------------------------------------------------
+/// Time spent on one hop by `icarus::ns::util::AssnsCrosser`.
+struct icarus::ns::util::AssnsCrosserHopTiming {
+  
+  std::string left; ///< Name of the type on the left side of the hop.
+  std::string right; ///< Name of the type on the right side of the hop.
+  
+  std::size_t nProducts = 0; ///< Number of association data products read.
+  std::size_t nAssns = 0; ///< Number of associated pairs read.
+  
+  double readTime = 0.0; ///< Time reading the data products [s]
+  double mergeTime = 0.0; ///< Time sorting and merging the products [s]
+  double joinTime = 0.0; ///< Time joining with the rest of the chain [s]
+  
+  /// Returns the total time spent on this hop [s]
+  double totalTime() const { return readTime + mergeTime + joinTime; }
+  
+}; // icarus::ns::util::AssnsCrosserHopTiming
+
+
+/**
+ * @brief Options for the construction of `icarus::ns::util::AssnsCrosser`.
+ * 
+ * The association data products of a hop are independent, and with
+ * `nThreads` larger than `1` they are read, and their content sorted by key,
+ * concurrently; then they are merged. Likewise, when all the hops are made of
+ * a single data product, the hops are read and sorted concurrently.
+ * This requires the event to support concurrent reading, as `art::Event` does.
+ * 
+ * If `timing` is not null, a record for each hop is appended to it, in the
+ * order the hops are processed (which depends on the traversal algorithm; the
+ * types in the record identify the hop).
+ * 
+ * If `cache` is not null, the crossing of the chain of hops is shared with the
+ * other `AssnsCrosser` objects using the same cache (see `AssnsCrosserCache`).
+ */
+struct icarus::ns::util::AssnsCrosserOptions {
+  
+  /// Threads used for reading the data products (`0`: one per core).
+  unsigned int nThreads = 1U;
+  
+  /// If not null, timing of each hop is appended to it.
+  std::vector<AssnsCrosserHopTiming>* timing = nullptr;
+  
+  /// If not null, crossed hops are looked up in and added to this cache.
+  AssnsCrosserCache* cache = nullptr;
+  
+}; // icarus::ns::util::AssnsCrosserOptions
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Crossed associations shared by `AssnsCrosser` objects in one event.
+ * 
+ * Several `AssnsCrosser` objects built in the same event often share their
+ * leading hops: for example, `recob::Hit` &rarr; `recob::Cluster` &rarr;
+ * `recob::PFParticle` &rarr; `recob::Slice` and `recob::Hit` &rarr;
+ * `recob::Cluster` &rarr; `recob::PFParticle` &rarr; `recob::Track`.
+ * When this cache is passed to each of them via `AssnsCrosserOptions::cache`,
+ * the key-to-intermediate association map of each leading part of the chain
+ * of hops is kept, and the next crosser starts from the longest leading part
+ * already crossed, reading and joining only the hops after it.
+ * 
+ * A chain is identified by the key type and, for each hop, by its type and by
+ * the input tags of its association data products, in order: crossers sharing
+ * the first hops with the same types and tags share their crossing, while e.g.
+ * an input tag with the process name and one without are considered
+ * different.
+ * 
+ * The cache is used only by crossers with all the hops explicitly specified
+ * and no selection of the keys (`startFrom` specifications); the other
+ * crossers ignore it. The chain is then always joined forward (the first time
+ * with _art_ pointer maps rather than with indices), so that all its leading
+ * parts can be kept.
+ * 
+ * Each crosser using the cache is counted as a hit if it found at least its
+ * first hop already crossed, and as a miss otherwise.
+ * 
+ * The cache holds copies of the association maps, and it should not outlive
+ * the event they come from: it is meant to be created in the event loop (e.g.
+ * in `art::EDProducer::produce()`) and shared by the crossers of that event
+ * only. It does not support concurrent use.
+ * 
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * using icarus::ns::util::startFrom, icarus::ns::util::hopTo;
+ * icarus::ns::util::AssnsCrosserCache cache;
+ * icarus::ns::util::AssnsCrosserOptions const options{ 1U, nullptr, &cache };
+ * 
+ * icarus::ns::util::AssnsCrosser const hitToSlice{ event, options
+ *   , startFrom<recob::Hit>{}
+ *   , hopTo<recob::Cluster>{ "pandora" }
+ *   , hopTo<recob::PFParticle>{ "pandora" }
+ *   , hopTo<recob::Slice>{ "pandora" }
+ *   };
+ * 
+ * // hit to PFParticle associations are taken from the cache:
+ * icarus::ns::util::AssnsCrosser const hitToTrack{ event, options
+ *   , startFrom<recob::Hit>{}
+ *   , hopTo<recob::Cluster>{ "pandora" }
+ *   , hopTo<recob::PFParticle>{ "pandora" }
+ *   , hopTo<recob::Track>{ "pandoraTrack" }
+ *   };
+ * 
+ * std::cout << "Cache: " << cache.hits() << " hits, " << cache.misses()
+ *   << " misses" << std::endl; // 1 hit, 1 miss
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::ns::util::AssnsCrosserCache {
+  
+  template <typename KeyType, typename... OtherTypes>
+  friend class AssnsCrosser;
+  
+    public:
+  
+  /// Returns the number of crossers which found part of their chain here.
+  std::size_t hits() const noexcept { return fHits; }
+  
+  /// Returns the number of crossers which found none of their chain here.
+  std::size_t misses() const noexcept { return fMisses; }
+  
+  /// Returns the number of association maps in the cache.
+  std::size_t size() const noexcept { return fMaps.size(); }
+  
+  /// Returns whether the cache holds no association map.
+  bool empty() const noexcept { return fMaps.empty(); }
+  
+  /// Removes all the association maps (the counters are kept).
+  void clear() { fMaps.clear(); }
+  
+  /// Resets the hit and miss counters.
+  void resetCounters() noexcept { fHits = 0U; fMisses = 0U; }
+  
+  
+    private:
+  
+  /// Association maps by chain identifier (type is encoded in the identifier).
+  std::unordered_map<std::string, std::shared_ptr<void const>> fMaps;
+  
+  std::size_t fHits = 0U; ///< Number of lookups which found a map.
+  std::size_t fMisses = 0U; ///< Number of lookups which found no map.
+  
+  /// Returns the map with the specified `chain` identifier (`nullptr` if none).
+  template <typename KeyType, typename TargetType>
+  details::AssnsMap<KeyType, TargetType> const* find
+    (std::string const& chain) const;
+  
+  /// Stores a copy of `map` with the specified `chain` identifier.
+  template <typename KeyType, typename TargetType>
+  void store(std::string chain, details::AssnsMap<KeyType, TargetType> map);
+  
+  /// Records the outcome of a lookup.
+  void count(bool hit) noexcept { ++(hit? fHits: fMisses); }
+  
+}; // icarus::ns::util::AssnsCrosserCache
+
+
 // -----------------------------------------------------------------------------
 /**
  * @brief Builds multi-hop one-to-many associations from associated pairs.
@@ -196,6 +373,36 @@ namespace icarus::ns::util {
  * `A1` and `C1`.
  * 
  * 
+ * ### Performance
+ * 
+ * When each hop is specified by a single input tag or product ID, and the
+ * associations of each hop refer to a single data product on each side (one
+ * for the left objects, one for the right ones), the associations are joined
+ * working on the `art::Ptr::key()` of the objects in dense arrays rather than
+ * on the full pointers in hash tables, which is substantially faster.
+ * The result is the same. The benchmark `assnscrosser_benchmark` in
+ * `test/Utilities` compares the two approaches.
+ * 
+ * Otherwise, when all the hops are explicitly specified, the order in which
+ * the associations are joined is chosen from an estimate of the cost based on
+ * the size and the fan-out of the associations of each hop and on the number
+ * of selected keys (`details::TraversalCostModel`): a few selected keys are
+ * followed forward, a sparse last hop is followed backward, and long chains
+ * can be joined starting from both ends and meeting in the middle.
+ * In all cases only the associations which can contribute to the result are
+ * stored while joining.
+ * 
+ * The constructor accepting `AssnsCrosserOptions` can read the association
+ * data products of each hop with multiple threads, and it can record how much
+ * time was spent reading, merging and joining each hop
+ * (`AssnsCrosserHopTiming`). It can also share the crossing of the leading
+ * hops with other crossers of the same event (`AssnsCrosserCache`).
+ * 
+ * When only the targets of a few keys are needed, `LazyAssnsCrosser` (in
+ * `icarusalg/Utilities/LazyAssnsCrosser.h`) follows only those keys through
+ * the hops, instead of joining the associations of all of them.
+ * 
+ * 
  * ### Comparison with `art::FindManyP`
  * 
  * Both `art::FindManyP` and `icarus::ns::util::AssnsCrosser`:
@@ -203,8 +410,8 @@ namespace icarus::ns::util {
  *    (but then there is little reason to use `AssnsCrosser` over `FindManyP`).
  *  * precompute all the information at construction, so they are better
  *    instantiated once.
- *  * yield for each associated key a vector of _art_ pointers to the associated
- *    target elements.
+ *  * yield for each associated key a sequence of _art_ pointers to the
+ *    associated target elements.
  *  * support a generic `art::Event`-like interface, including (in principle)
  *    `gallery::Event`.
  * 
@@ -334,6 +541,7 @@ class icarus::ns::util::AssnsCrosser
   using KeyPtr_t = typename This_t::KeyPtr_t;
   using TargetPtr_t = typename This_t::TargetPtr_t;
   using TargetPtrs_t = typename This_t::TargetPtrs_t;
+  using TargetPtrSpan_t = typename This_t::TargetPtrSpan_t;
   
   /**
    * @brief Constructor: reads and joins the specified associations.
@@ -377,6 +585,41 @@ class icarus::ns::util::AssnsCrosser
     StartSpecs<KeyType> startSpec,
     InputSpecs<OtherTypes>... otherInputSpecs
     );
+  
+  /**
+   * @brief Constructor: reads and joins the specified associations.
+   * @tparam Event type to read the data from (`art::Event` interface)
+   * @param event data source
+   * @param options options for reading (threads, timing)
+   * @param startSpec specifies which type to start hopping from
+   * @param otherInputSpecs input specifications for all the hops
+   * @see `AssnsCrosserOptions`
+   * 
+   * This constructor acts like the one without `options`, with the specified
+   * `options`. For example, to read the associations of
+   * each hop with up to four threads and print where the time was spent:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * using icarus::ns::util::startFrom, icarus::ns::util::hopTo;
+   * std::vector<icarus::ns::util::AssnsCrosserHopTiming> timing;
+   * icarus::ns::util::AssnsCrosser const AtoC{ event
+   *   , icarus::ns::util::AssnsCrosserOptions{ 4U, &timing }
+   *   , startFrom<DataTypeA>{}
+   *   , hopTo<DataTypeB>{ "B:1", "B:2" }
+   *   , hopTo<DataTypeC>{ "C" }
+   *   );
+   * for (auto const& hop: timing) {
+   *   std::cout << hop.left << " => " << hop.right << ": "
+   *     << hop.totalTime() << " s" << std::endl;
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename Event>
+  AssnsCrosser(
+    Event const& event,
+    AssnsCrosserOptions const& options,
+    StartSpecs<KeyType> startSpec,
+    InputSpecs<OtherTypes>... otherInputSpecs
+    );
 
   /**
    * @brief Returns pointers to all target objects associated to `keyPtr`.
@@ -400,7 +643,7 @@ class icarus::ns::util::AssnsCrosser
    *   
    *   art::Ptr<DataTypeA> const Aptr{ Ahandle, iA };
    *   
-   *   std::vector<art::Ptr<DataTypeC>> const& Cptrs = AtoC.assPtrs(Aptr);
+   *   gsl::span<art::Ptr<DataTypeC> const> const Cptrs = AtoC.assPtrs(Aptr);
    *   
    *   // ...
    * } // for
@@ -408,8 +651,12 @@ class icarus::ns::util::AssnsCrosser
    * In the loop, a _art_ pointer to each `DataTypeA` object is created in order
    * to query the associated `DataTypeC`. See also `assPtr()` for further usage
    * patterns common to the two methods.
+   * 
+   * The returned span points to memory owned by this object, and it is valid
+   * as long as this object is. Use e.g.
+   * `TargetPtrs_t{ Cptrs.begin(), Cptrs.end() }` for an independent copy.
    */
-  TargetPtrs_t const& assPtrs(KeyPtr_t const& keyPtr) const
+  TargetPtrSpan_t assPtrs(KeyPtr_t const& keyPtr) const
     { return fAssnsMap.assPtrs(keyPtr); }
   
   /**
@@ -477,29 +724,69 @@ class icarus::ns::util::AssnsCrosser
   using Target_t = typename This_t::Target_t;
   
   using AssnsMap_t = details::AssnsMap<Key_t, Target_t>;
+  using FlatAssnsMap_t = details::FlatAssnsMap<Key_t, Target_t>;
   
   /// Which algorithm to use for traversing the associations.
-  enum class HoppingAlgo { forward, backward };
+  enum class HoppingAlgo { forward, backward, middle };
   
-  AssnsMap_t fAssnsMap; ///< Associated objects per key.
+  /// How to traverse the associations.
+  struct Traversal_t {
+    HoppingAlgo algo; ///< The algorithm.
+    std::size_t split = 0; ///< Number of hops joined forward (`middle` only).
+  }; // Traversal_t
+  
+  FlatAssnsMap_t fAssnsMap; ///< Associated objects per key (compacted).
   
   
   static TargetPtr_t const NullTargetPtr; ///< Used as return reference value.
   
   
+  /// Type of the hop with index `I`.
+  template <std::size_t I>
+  using HopType_t = std::tuple_element_t<I, std::tuple<OtherTypes...>>;
+  
   /// Returns the full content of the association map.
   template <typename Event>
-  AssnsMap_t prepare(
-    Event const& event,
+  FlatAssnsMap_t prepare(
+    Event const& event, AssnsCrosserOptions const& options,
     StartSpecs<KeyType> startSpecs, InputSpecs<OtherTypes>... otherInputSpecs
     ) const;
   
+  /// Returns the full content of the association map, sharing `options.cache`.
+  template <typename Event>
+  static FlatAssnsMap_t prepareWithCache(
+    Event const& event, AssnsCrosserOptions const& options,
+    InputSpecs<OtherTypes>... otherInputSpecs
+    );
+  
+  /// Returns the map from the keys to the hop `I`, from `options.cache` if
+  /// there, crossing the hops and adding them to it otherwise.
+  template <std::size_t I, typename Event>
+  static details::AssnsMap<Key_t, HopType_t<I>> crossCachedHops(
+    Event const& event, AssnsCrosserOptions const& options,
+    std::tuple<InputSpecs<OtherTypes>...>& specs,
+    std::vector<std::string> const& chains, bool& hit
+    );
+  
   /// Determines which algorithm should be used for association traversal.
-  HoppingAlgo chooseTraversalAlgorithm(
+  template <typename Event>
+  Traversal_t chooseTraversalAlgorithm(
+    Event const& event,
+    AssnsCrosserOptions const& options,
     StartSpecs<KeyType> const& startSpecs,
+    std::optional<details::PointerSelector<Key_t>> const& keySelector,
     InputSpecs<OtherTypes> const&... otherInputSpecs
     ) const;
   
+  /// Returns the size statistics of the associations of each hop.
+  template <typename Event, std::size_t... I>
+  static std::vector<details::HopStats> collectHopStats(
+    Event const& event,
+    AssnsCrosserOptions const& options,
+    std::tuple<InputSpecs<OtherTypes> const&...> const& specs,
+    std::index_sequence<I...>
+    );
+  
   /// Returns a list of relevant pointers from the start specifications.
   template <typename T, typename Event>
   std::optional<details::PointerSelector<T>> keysFromSpecs
@@ -733,6 +1020,10 @@ namespace icarus::ns::util::details {
   template <typename... Ts>
   struct last_type { using type = typename end_type<0, Ts...>::type; };
   
+  /// An empty object carrying the type `T` (like C++20 `std::type_identity`).
+  template <typename T>
+  struct TypeTag { using type = T; };
+  
   template <typename KeyType, typename FirstHopType, typename... OtherHopTypes>
   struct MapJoiner;
   
@@ -758,6 +1049,8 @@ namespace icarus::ns::util::details {
   std::vector<typename Minuend::value_type> set_difference
     (Minuend const& minuend, Subtrahend const& subtrahend);
   
+  class ScopedHopTimer;
+  
   template <typename SpecType>
   std::ostream& operator<<
     (std::ostream& out, InputSpecsBase<SpecType> const& specs);
@@ -782,6 +1075,7 @@ class icarus::ns::util::details::AssnsCrosserTypes {
   using KeyPtr_t = art::Ptr<Key_t>;
   using TargetPtr_t = art::Ptr<Target_t>;
   using TargetPtrs_t = std::vector<TargetPtr_t>;
+  using TargetPtrSpan_t = gsl::span<TargetPtr_t const>;
   
   using Assns_t = art::Assns<Key_t, Target_t>;
   
@@ -806,6 +1100,9 @@ class icarus::ns::util::details::AssnsMap
   
   using AssnsMap_t = typename This_t::AssnsMap_t;
   
+  /// Type of a key/targets entry of the map.
+  using Entry_t = typename AssnsMap_t::value_type;
+  
   
   // --- BEGIN -- Modify interface ---------------------------------------------
   ///@name Modify interface
@@ -849,6 +1146,9 @@ class icarus::ns::util::details::AssnsMap
   /// Returns a map of key pointers to a sequence of associated target pointers.
   AssnsMap_t const& assnsMap() const { return fAssnsMap; }
   
+  /// Returns pointers to all the entries, sorted by key pointer.
+  std::vector<Entry_t const*> sortedEntries() const;
+  
   /// Returns a sorted list of all the product IDs in the key pointers.
   std::vector<art::ProductID> keyProductIDs() const;
   
@@ -872,6 +1172,84 @@ class icarus::ns::util::details::AssnsMap
 }; // icarus::ns::util::details::AssnsMap
 
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief Read-only association map with compact storage.
+ * @tparam KeyType type of the key objects
+ * @tparam TargetType type of the associated objects
+ * @see `icarus::ns::util::details::AssnsMap`
+ * 
+ * The content of an `AssnsMap` is stored in three flat arrays: the key
+ * pointers (sorted as `art::Ptr`), the target pointers of all the keys one
+ * after the other in the same order, and the offset of the first target of
+ * each key in the latter (plus a last one marking the end).
+ * Lookup is by binary search, and the associated targets are returned as a
+ * contiguous span without copies.
+ */
+template <typename KeyType, typename TargetType>
+class icarus::ns::util::details::FlatAssnsMap
+  : public details::AssnsCrosserTypes<KeyType, TargetType>
+{
+  
+    public:
+  
+  using This_t = FlatAssnsMap<KeyType, TargetType>;
+  
+  using KeyPtr_t = typename This_t::KeyPtr_t;
+  using TargetPtr_t = typename This_t::TargetPtr_t;
+  using TargetPtrs_t = typename This_t::TargetPtrs_t;
+  using TargetPtrSpan_t = typename This_t::TargetPtrSpan_t;
+  
+  /// Constructor: an empty map.
+  FlatAssnsMap() = default;
+  
+  /// Constructor: takes over all the content of `map`.
+  explicit FlatAssnsMap(AssnsMap<KeyType, TargetType>&& map);
+  
+  /**
+   * @brief Constructor: adopts already compacted content.
+   * @param keys the key pointers, sorted
+   * @param offsets position of the first target of each key, plus the end
+   * @param targets all targets, grouped by key in the same order as `keys`
+   * 
+   * No check is performed on the consistency of the arguments.
+   */
+  FlatAssnsMap(
+    std::vector<KeyPtr_t> keys, std::vector<std::size_t> offsets,
+    TargetPtrs_t targets
+    )
+    : fKeys{ std::move(keys) }
+    , fOffsets{ std::move(offsets) }
+    , fTargets{ std::move(targets) }
+    {}
+  
+  /// Returns whether there is data in the map.
+  bool empty() const noexcept { return fKeys.empty(); }
+  
+  /// Returns the number of keys with at least one associated target.
+  std::size_t nKeys() const noexcept { return fKeys.size(); }
+  
+  /// Returns the total number of associated targets.
+  std::size_t nTargets() const noexcept { return fTargets.size(); }
+  
+  /// Returns all the key pointers, sorted.
+  std::vector<KeyPtr_t> const& keys() const noexcept { return fKeys; }
+  
+  /// Returns the pointers associated to `keyPtr` (empty if none).
+  TargetPtrSpan_t assPtrs(KeyPtr_t const& keyPtr) const;
+  
+    private:
+  
+  std::vector<KeyPtr_t> fKeys; ///< All keys, sorted.
+  
+  /// Position in `fTargets` of the first target of each key, plus the end.
+  std::vector<std::size_t> fOffsets;
+  
+  TargetPtrs_t fTargets; ///< All targets, grouped by key in `fKeys` order.
+  
+}; // icarus::ns::util::details::FlatAssnsMap
+
+
 // -----------------------------------------------------------------------------
 /// Instructions on which pointers of type T to select.
 template <typename T>
@@ -882,6 +1260,12 @@ struct icarus::ns::util::details::PointerSelector {
   
   bool operator() (Ptr_t const& ptr) const;
   
+  /// Returns the number of pointers explicitly listed.
+  std::size_t nPointers() const noexcept { return fPtrs.size(); }
+  
+  /// Returns whether whole data products are selected.
+  bool hasProductIDs() const noexcept { return !fIDs.empty(); }
+  
     private:
   std::vector<Ptr_t> fPtrs; ///< Listed pointers pass.
   std::vector<art::ProductID> fIDs; ///< All objects with these ID pass.
@@ -889,6 +1273,123 @@ struct icarus::ns::util::details::PointerSelector {
 }; // icarus::ns::util::details::PointerSelector
 
 
+// -----------------------------------------------------------------------------
+/// Selects the pointers of type `T` which are on one side of an association
+/// map (by default, the targets).
+template <typename T>
+class icarus::ns::util::details::FrontierSelector {
+  
+  std::unordered_set<art::Ptr<T>> fPtrs; ///< Pointers passing the selection.
+  
+    public:
+  
+  /// Constructor: selects all the targets of `map`.
+  template <typename Left>
+  FrontierSelector(AssnsMap<Left, T> const& map);
+  
+  /// Returns a selector of all the keys of `map`.
+  template <typename Right>
+  static FrontierSelector<T> keysOf(AssnsMap<T, Right> const& map);
+  
+  /// Returns the number of selected pointers.
+  std::size_t size() const noexcept { return fPtrs.size(); }
+  
+  bool operator() (art::Ptr<T> const& ptr) const
+    { return fPtrs.count(ptr) > 0; }
+  
+    private:
+  
+  FrontierSelector() = default;
+  
+}; // icarus::ns::util::details::FrontierSelector
+
+
+// -----------------------------------------------------------------------------
+/// Sizes of the associations of a hop, for traversal cost estimation.
+struct icarus::ns::util::details::HopStats {
+  
+  std::size_t nAssns = 0; ///< Number of associated pairs.
+  
+  /// Estimated number of distinct left elements (runs of equal left pointer).
+  std::size_t nLeft = 0;
+  
+  /// Number of distinct right elements (per data product tag).
+  std::size_t nRight = 0;
+  
+  /// Returns the average number of right elements per left element.
+  double fanOut() const
+    { return (nLeft == 0)? 0.0: static_cast<double>(nAssns) / nLeft; }
+  
+  /// Adds the content of `assns` to the statistics.
+  template <typename Left, typename Right>
+  void add(art::Assns<Left, Right> const& assns);
+  
+}; // icarus::ns::util::details::HopStats
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Estimates the cost of the different ways to join a chain of hops.
+ * 
+ * The cost is estimated as the number of pointers stored in the association
+ * maps, which is the dominant part of the `MapJoiner` algorithms (all the
+ * algorithms read all the associations, so that part is not counted).
+ * The size of the maps is extrapolated from the number of keys, from the
+ * average fan-out of each hop and from the fraction of the elements of each hop
+ * which continue into the next one (`HopStats`). The algorithms are assumed to
+ * store only the associations which may contribute to the result, i.e.
+ * starting from the current targets when joining forward, and ending at the
+ * current keys when joining backward.
+ * 
+ * The traversal is described by a split point: the first `split` hops are
+ * joined forward (starting from the keys), the others backward (starting from
+ * the last hop), and then the two partial results are joined.
+ * A split point of `0` means a fully backward traversal, a split point equal
+ * to the number of hops a fully forward one.
+ */
+class icarus::ns::util::details::TraversalCostModel {
+  
+  std::vector<HopStats> fHops; ///< Statistics of each hop.
+  
+  double fNKeys; ///< Number of keys considered.
+  
+  /// Number of paths from the keys to the right of each hop.
+  std::vector<double> fPaths;
+  
+    public:
+  
+  /**
+   * @brief Constructor.
+   * @param hops statistics for all the hops
+   * @param nKeys number of selected keys (if unknown, all the keys are used)
+   */
+  TraversalCostModel
+    (std::vector<HopStats> hops, std::optional<std::size_t> nKeys = {});
+  
+  /// Returns the number of hops.
+  std::size_t nHops() const noexcept { return fHops.size(); }
+  
+  /// Returns the estimated cost of the traversal with the specified `split`.
+  double cost(std::size_t split) const;
+  
+  /// Returns the split point with the smallest cost (simplest in a tie).
+  std::size_t bestSplit() const;
+  
+    private:
+  
+  /// Fraction of the right elements of the hop before `iHop` which have
+  /// associations in `iHop`.
+  double coverage(std::size_t iHop) const;
+  
+  /// Cost of joining forward the first `split` hops.
+  double forwardCost(std::size_t split) const;
+  
+  /// Cost of joining backward the hops from `split` on.
+  double backwardCost(std::size_t split) const;
+  
+}; // icarus::ns::util::details::TraversalCostModel
+
+
 // -----------------------------------------------------------------------------
 // ---  template implementation
 // -----------------------------------------------------------------------------
@@ -942,6 +1443,63 @@ icarus::ns::util::details::set_difference
 } // icarus::ns::util::details::set_difference()
 
 
+// -----------------------------------------------------------------------------
+/// Adds the time of its lifetime to a field of the last hop timing record.
+class icarus::ns::util::details::ScopedHopTimer {
+  
+  using Clock_t = std::chrono::steady_clock;
+  
+  std::vector<AssnsCrosserHopTiming>* fTiming; ///< Records (may be null).
+  double AssnsCrosserHopTiming::* fField; ///< The field to add time to.
+  Clock_t::time_point const fStart; ///< Start time.
+  
+    public:
+  
+  ScopedHopTimer
+    (AssnsCrosserOptions const& options, double AssnsCrosserHopTiming::* field)
+    : fTiming{ options.timing }, fField{ field }
+    , fStart{ fTiming? Clock_t::now(): Clock_t::time_point{} }
+    {}
+  
+  ScopedHopTimer(ScopedHopTimer const&) = delete;
+  ScopedHopTimer& operator= (ScopedHopTimer const&) = delete;
+  
+  ~ScopedHopTimer()
+    {
+      if (!fTiming || fTiming->empty()) return;
+      fTiming->back().*fField
+        += std::chrono::duration<double>(Clock_t::now() - fStart).count();
+    }
+  
+}; // icarus::ns::util::details::ScopedHopTimer
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::AssnsCrosserCache
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename TargetType>
+auto icarus::ns::util::AssnsCrosserCache::find(std::string const& chain) const
+  -> details::AssnsMap<KeyType, TargetType> const*
+{
+  auto const it = fMaps.find(chain);
+  if (it == fMaps.end()) return nullptr;
+  // the types are part of the chain identifier
+  return static_cast<details::AssnsMap<KeyType, TargetType> const*>
+    (it->second.get());
+} // icarus::ns::util::AssnsCrosserCache::find()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename TargetType>
+void icarus::ns::util::AssnsCrosserCache::store
+  (std::string chain, details::AssnsMap<KeyType, TargetType> map)
+{
+  fMaps[std::move(chain)]
+    = std::make_shared<details::AssnsMap<KeyType, TargetType> const>
+      (std::move(map));
+} // icarus::ns::util::AssnsCrosserCache::store()
+
+
 // -----------------------------------------------------------------------------
 // ---  icarus::ns::util::details::AssnsMap
 // -----------------------------------------------------------------------------
@@ -987,6 +1545,20 @@ auto icarus::ns::util::details::AssnsMap<KeyType, TargetType>::assPtrs
 } // icarus::ns::util::details::AssnsMap<>::assPtrs()
 
 
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename TargetType>
+auto icarus::ns::util::details::AssnsMap<KeyType, TargetType>::sortedEntries()
+  const -> std::vector<Entry_t const*>
+{
+  std::vector<Entry_t const*> entries;
+  entries.reserve(fAssnsMap.size());
+  for (Entry_t const& entry: fAssnsMap) entries.push_back(&entry);
+  std::sort(entries.begin(), entries.end(),
+    [](Entry_t const* a, Entry_t const* b){ return a->first < b->first; });
+  return entries;
+} // icarus::ns::util::details::AssnsMap::sortedEntries()
+
+
 // -----------------------------------------------------------------------------
 template <typename KeyType, typename TargetType>
 auto icarus::ns::util::details::AssnsMap<KeyType, TargetType>::keyProductIDs()
@@ -1074,6 +1646,61 @@ std::ostream& icarus::ns::util::details::operator<<
 } // icarus::ns::util::details::operator<< (AssnsMap)
 
 
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::details::FlatAssnsMap
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename TargetType>
+icarus::ns::util::details::FlatAssnsMap<KeyType, TargetType>::FlatAssnsMap
+  (AssnsMap<KeyType, TargetType>&& map)
+{
+  using Entry_t = typename AssnsMap<KeyType, TargetType>::Entry_t;
+  
+  // entries sorted by key; the targets are moved away from them
+  std::vector<Entry_t*> entries;
+  entries.reserve(map.assnsMap().size());
+  std::size_t nTargets = 0;
+  for (Entry_t& entry: map.assnsMap()) {
+    entries.push_back(&entry);
+    nTargets += entry.second.size();
+  }
+  std::sort(entries.begin(), entries.end(),
+    [](Entry_t const* a, Entry_t const* b){ return a->first < b->first; });
+  
+  fKeys.reserve(entries.size());
+  fOffsets.reserve(entries.size() + 1);
+  fTargets.reserve(nTargets);
+  
+  fOffsets.push_back(0);
+  for (Entry_t* entry: entries) {
+    TargetPtrs_t& targets = entry->second;
+    if (targets.empty()) continue;
+    fKeys.push_back(entry->first);
+    fTargets.insert(fTargets.end(),
+      std::move_iterator(targets.begin()), std::move_iterator(targets.end())
+      );
+    fOffsets.push_back(fTargets.size());
+  } // for
+  
+  map.clear();
+  
+} // icarus::ns::util::details::FlatAssnsMap<>::FlatAssnsMap()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename TargetType>
+auto icarus::ns::util::details::FlatAssnsMap<KeyType, TargetType>::assPtrs
+  (KeyPtr_t const& keyPtr) const -> TargetPtrSpan_t
+{
+  auto const it = std::lower_bound(fKeys.begin(), fKeys.end(), keyPtr);
+  if ((it == fKeys.end()) || (*it != keyPtr)) return {};
+  std::size_t const iKey = std::distance(fKeys.begin(), it);
+  return {
+    fTargets.data() + fOffsets[iKey],
+    static_cast<std::size_t>(fOffsets[iKey + 1] - fOffsets[iKey])
+    };
+} // icarus::ns::util::details::FlatAssnsMap<>::assPtrs()
+
+
 // -----------------------------------------------------------------------------
 // --- icarus::ns::util::details::PointerSelector
 // -----------------------------------------------------------------------------
@@ -1098,24 +1725,195 @@ bool icarus::ns::util::details::PointerSelector<T>::operator()
 
 
 // -----------------------------------------------------------------------------
-// ---  icarus::ns::util::InputSpec and related
+// --- icarus::ns::util::details::FrontierSelector
 // -----------------------------------------------------------------------------
-bool icarus::ns::util::InputSpec::hasSpec() const noexcept {
-  
-  struct HasInputSpecTest: HasSpecTest {};
-  
-  return std::visit(HasInputSpecTest{}, spec());
-} // icarus::ns::util::InputSpec::hasSpec()
+template <typename T>
+template <typename Left>
+icarus::ns::util::details::FrontierSelector<T>::FrontierSelector
+  (AssnsMap<Left, T> const& map)
+{
+  for (auto const& pairs: map.assnsMap())
+    fPtrs.insert(pairs.second.begin(), pairs.second.end());
+} // icarus::ns::util::details::FrontierSelector<>::FrontierSelector()
 
 
-// -----------------------------------------------------------------------------
 template <typename T>
-bool icarus::ns::util::StartSpec<T>::hasSpec() const noexcept {
-  
-  struct HasStartSpecTest: Base_t::HasSpecTest {
-    using Base_t::HasSpecTest::operator();
-    bool operator() (art::Ptr<Key_t> const& ptr) const
-      { return ptr.isNonnull(); }
+template <typename Right>
+auto icarus::ns::util::details::FrontierSelector<T>::keysOf
+  (AssnsMap<T, Right> const& map) -> FrontierSelector<T>
+{
+  FrontierSelector<T> selector;
+  selector.fPtrs.reserve(map.assnsMap().size());
+  for (auto const& pairs: map.assnsMap()) selector.fPtrs.insert(pairs.first);
+  return selector;
+} // icarus::ns::util::details::FrontierSelector<>::keysOf()
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::ns::util::details::HopStats
+// -----------------------------------------------------------------------------
+template <typename Left, typename Right>
+void icarus::ns::util::details::HopStats::add
+  (art::Assns<Left, Right> const& assns)
+{
+  nAssns += assns.size();
+  art::Ptr<Left> const* lastLeft = nullptr; // associations are usually grouped
+  for (auto const& pairs: assns) {
+    if (lastLeft && (pairs.first == *lastLeft)) continue;
+    lastLeft = &pairs.first;
+    ++nLeft;
+  } // for
+  
+  std::unordered_map<art::ProductID, std::vector<bool>> seenRight;
+  for (auto const& pairs: assns) {
+    std::vector<bool>& seen = seenRight[pairs.second.id()];
+    std::size_t const key = pairs.second.key();
+    if (key >= seen.size()) seen.resize(key + 1, false);
+    if (seen[key]) continue;
+    seen[key] = true;
+    ++nRight;
+  } // for
+} // icarus::ns::util::details::HopStats::add()
+
+
+// -----------------------------------------------------------------------------
+// --- icarus::ns::util::details::TraversalCostModel
+// -----------------------------------------------------------------------------
+inline icarus::ns::util::details::TraversalCostModel::TraversalCostModel
+  (std::vector<HopStats> hops, std::optional<std::size_t> nKeys /* = {} */)
+  : fHops{ std::move(hops) }
+  , fNKeys{ 0.0 }
+{
+  if (fHops.empty()) return;
+  
+  double const nAllKeys = fHops.front().nLeft;
+  fNKeys = nKeys? std::min<double>(*nKeys, nAllKeys): nAllKeys;
+  
+  double paths = fNKeys;
+  fPaths.reserve(fHops.size());
+  for (std::size_t iHop = 0; iHop < nHops(); ++iHop) {
+    paths *= coverage(iHop) * fHops[iHop].fanOut();
+    fPaths.push_back(paths);
+  } // for
+} // icarus::ns::util::details::TraversalCostModel::TraversalCostModel()
+
+
+// -----------------------------------------------------------------------------
+inline double icarus::ns::util::details::TraversalCostModel::cost
+  (std::size_t split) const
+{
+  if (split >= nHops()) return forwardCost(nHops());
+  if (split == 0) return backwardCost(0);
+  // the two partial results are joined into the final map
+  return forwardCost(split) + backwardCost(split) + fPaths.back();
+} // icarus::ns::util::details::TraversalCostModel::cost()
+
+
+// -----------------------------------------------------------------------------
+inline std::size_t icarus::ns::util::details::TraversalCostModel::bestSplit()
+  const
+{
+  // in a tie, forward is preferred, then backward, then the others
+  std::size_t best = nHops();
+  double bestCost = cost(best);
+  for (std::size_t i = 0; i < nHops(); ++i) {
+    std::size_t const split = (i == 0)? 0: nHops() - i;
+    double const splitCost = cost(split);
+    if (splitCost >= bestCost) continue;
+    best = split;
+    bestCost = splitCost;
+  } // for
+  return best;
+} // icarus::ns::util::details::TraversalCostModel::bestSplit()
+
+
+// -----------------------------------------------------------------------------
+inline double icarus::ns::util::details::TraversalCostModel::coverage
+  (std::size_t iHop) const
+{
+  if (iHop == 0) return 1.0;
+  double const nPrevRight = fHops[iHop - 1].nRight;
+  return (nPrevRight == 0.0)
+    ? 0.0: std::min(1.0, fHops[iHop].nLeft / nPrevRight);
+} // icarus::ns::util::details::TraversalCostModel::coverage()
+
+
+// -----------------------------------------------------------------------------
+inline double icarus::ns::util::details::TraversalCostModel::forwardCost
+  (std::size_t split) const
+{
+  /*
+   * The first map holds only the selected keys; each following hop needs a
+   * map of the associations starting from the current targets (at most all of
+   * them), and then the joined map.
+   */
+  if (split == 0) return 0.0;
+  double cost = fPaths[0];
+  for (std::size_t iHop = 1; iHop < split; ++iHop) {
+    double const nAssns = fHops[iHop].nAssns;
+    cost += std::min(nAssns, fPaths[iHop]) + fPaths[iHop];
+  }
+  return cost;
+} // icarus::ns::util::details::TraversalCostModel::forwardCost()
+
+
+// -----------------------------------------------------------------------------
+inline double icarus::ns::util::details::TraversalCostModel::backwardCost
+  (std::size_t split) const
+{
+  /*
+   * The last hop needs a map of all its associations. Each previous hop needs
+   * a map of the associations ending in elements which lead to the end
+   * ("live"), and then the joined map, whose size is the number of paths from
+   * the left of the hop to the end. The map of the first hop holds only the
+   * selected keys.
+   */
+  if (split >= nHops()) return 0.0;
+  std::size_t const last = nHops() - 1;
+  if (last == 0) return fPaths[0];
+  
+  double cost = fHops[last].nAssns;
+  double pathsToEnd = fHops[last].nAssns; // paths from the left of the hop
+  double liveLeft = 1.0; // fraction of left elements of the hop leading to end
+  for (std::size_t iHop = last; iHop-- > split; ) {
+    HopStats const& hop = fHops[iHop];
+    double const nLiveNext = fHops[iHop + 1].nLeft * liveLeft;
+    double const liveRight = (hop.nRight == 0)
+      ? 0.0: std::min(1.0, nLiveNext / hop.nRight);
+    double const nLiveAssns = hop.nAssns * liveRight;
+    if (iHop == 0) {
+      double const keyFraction = (hop.nLeft == 0)? 0.0: fNKeys / hop.nLeft;
+      cost += nLiveAssns * keyFraction + fPaths.back();
+      break;
+    }
+    pathsToEnd = (nLiveNext == 0.0)
+      ? 0.0: nLiveAssns * (pathsToEnd / nLiveNext);
+    liveLeft = std::min(1.0, hop.fanOut() * liveRight);
+    cost += nLiveAssns + pathsToEnd;
+  } // for
+  return cost;
+} // icarus::ns::util::details::TraversalCostModel::backwardCost()
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::InputSpec and related
+// -----------------------------------------------------------------------------
+bool icarus::ns::util::InputSpec::hasSpec() const noexcept {
+  
+  struct HasInputSpecTest: HasSpecTest {};
+  
+  return std::visit(HasInputSpecTest{}, spec());
+} // icarus::ns::util::InputSpec::hasSpec()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool icarus::ns::util::StartSpec<T>::hasSpec() const noexcept {
+  
+  struct HasStartSpecTest: Base_t::HasSpecTest {
+    using Base_t::HasSpecTest::operator();
+    bool operator() (art::Ptr<Key_t> const& ptr) const
+      { return ptr.isNonnull(); }
 #if defined CANVAS_DEC_VERSION && (CANVAS_DEC_VERSION >= 531100)
     bool operator() (art::ProductPtr<Key_t> const& ptr) const
       { return (*this)(ptr.id()); }
@@ -1237,6 +2035,9 @@ struct icarus::ns::util::details::MapJoiner {
   
   static constexpr NoSelector_t NoSelector{};
   
+  /// No selection (an empty selector).
+  static inline std::optional<NoSelector_t> const NoSelection;
+  
   /**
    * @brief Returns a association map from `KeyType` to `TargetType`.
    * @tparam Event a data repository (`art::Event`-like interface)
@@ -1257,19 +2058,50 @@ struct icarus::ns::util::details::MapJoiner {
     InputSpecs<FirstHopType> firstHopInputSpec,
     InputSpecs<OtherHopTypes>... otherHopInputSpecs
   ) {
+      return joinBackward(event,
+        std::move(firstHopInputSpec), std::move(otherHopInputSpecs)...,
+        std::optional<NoSelector_t>{}
+        );
+    } // joinBackward()
+  
+  /**
+   * @brief Returns a association map from `KeyType` to `TargetType`.
+   * @tparam Event a data repository (`art::Event`-like interface)
+   * @tparam Selector functor with `bool operator() const (art::Ptr<KeyType>)`
+   * @param event the event to read the associations from
+   * @param firstHopInputSpec specification for the first hop associations
+   * @param otherHopInputSpec specification for all other hop associations
+   * @param selector if specified, only keys passing the selector are considered
+   * @param options reading options (see `AssnsCrosserOptions`)
+   * @return a association map from `KeyType` to `TargetType`
+   * 
+   * Like the other `joinBackward()`, but the keys are selected when the last
+   * hop (the first association) is joined.
+   */
+  template <typename Event, typename Selector>
+  static AssnsMap<KeyType, TargetType> joinBackward(
+    Event const& event,
+    InputSpecs<FirstHopType> firstHopInputSpec,
+    InputSpecs<OtherHopTypes>... otherHopInputSpecs,
+    std::optional<Selector> const& selector,
+    AssnsCrosserOptions const& options = {}
+  ) {
       
       if constexpr(nHops == 1) {
         std::vector<art::InputTag> const firstHopTags
           = extractTagList(std::move(firstHopInputSpec), event);
-        return assnsToMap<KeyType, TargetType>(event, firstHopTags);
+        return assnsToMap<KeyType, TargetType>
+          (event, firstHopTags, selector, options);
       }
       else {
         // 1 is the first hop (KeyType -> FirstHopType),
         // 2 is all the others (FirstHopType -> TargetType)
         auto assnsMap2 = MapJoiner<FirstHopType, OtherHopTypes...>::joinBackward
-          (event, std::move(otherHopInputSpecs)...);
-        return leftExtendMapWithAssns<KeyType>
-          (std::move(assnsMap2), event, std::move(firstHopInputSpec));
+          (event, std::move(otherHopInputSpecs)..., NoSelection, options);
+        return leftExtendMapWithAssns<KeyType>(
+          std::move(assnsMap2), event, std::move(firstHopInputSpec), selector,
+          options
+          );
       } // if more than one hop
     } // joinBackward()
   
@@ -1278,10 +2110,53 @@ struct icarus::ns::util::details::MapJoiner {
    * @brief Returns a association map from `KeyType` to `TargetType`.
    * @tparam Event a data repository (`art::Event`-like interface)
    * @tparam Selector functor with `bool operator() const (art::Ptr<KeyType>)`
+   * @param split number of hops to be joined forward
    * @param event the event to read the associations from
    * @param firstHopInputSpec specification for the first hop associations
    * @param otherHopInputSpec specification for all other hop associations
    * @param selector if specified, only keys passing the selector are considered
+   * @param options reading options (see `AssnsCrosserOptions`)
+   * @return a association map from `KeyType` to `TargetType`
+   * @throw std::logic_error if `split` is not between `1` and `nHops - 1`
+   * 
+   * The first `split` hops are joined forward (`joinForward()`), the other
+   * hops are joined backward (`joinBackward()`), and finally the two partial
+   * maps are joined together.
+   */
+  template <typename Event, typename Selector>
+  static AssnsMap<KeyType, TargetType> joinFromMiddle(
+    std::size_t split,
+    Event const& event,
+    InputSpecs<FirstHopType> firstHopInputSpec,
+    InputSpecs<OtherHopTypes>... otherHopInputSpecs,
+    std::optional<Selector> const& selector,
+    AssnsCrosserOptions const& options = {}
+  ) {
+      auto specs = std::make_tuple
+        (std::move(firstHopInputSpec), std::move(otherHopInputSpecs)...);
+      
+      AssnsMap<KeyType, TargetType> map;
+      if (!joinAtSplit(
+        map, split, event, specs, selector, options,
+        std::make_index_sequence<nHops>{}
+      )) {
+        throw std::logic_error{ "Invalid split point "
+          + std::to_string(split) + " for " + std::to_string(nHops) + " hops."
+          };
+      }
+      return map;
+    } // joinFromMiddle()
+  
+  
+  /**
+   * @brief Returns a association map from `KeyType` to `TargetType`.
+   * @tparam Event a data repository (`art::Event`-like interface)
+   * @tparam Selector functor with `bool operator() const (art::Ptr<KeyType>)`
+   * @param event the event to read the associations from
+   * @param firstHopInputSpec specification for the first hop associations
+   * @param otherHopInputSpec specification for all other hop associations
+   * @param selector if specified, only keys passing the selector are considered
+   * @param options reading options (see `AssnsCrosserOptions`)
    * @return a association map from `KeyType` to `TargetType`
    * 
    * The algorithm starts from the first hop (associations from the
@@ -1293,24 +2168,97 @@ struct icarus::ns::util::details::MapJoiner {
     Event const& event,
     InputSpecs<FirstHopType> firstHopInputSpec,
     InputSpecs<OtherHopTypes>... otherHopInputSpecs,
-    std::optional<Selector> const& selector = NoSelector
+    std::optional<Selector> const& selector = NoSelector,
+    AssnsCrosserOptions const& options = {}
   ) {
       std::vector<art::InputTag> const firstHopTags
         = extractTagList(std::move(firstHopInputSpec), event);
       
-      auto leftMap
-        = assnsToMap<KeyType, FirstHopType>(event, firstHopTags, selector);
+      auto leftMap = assnsToMap<KeyType, FirstHopType>
+        (event, firstHopTags, selector, options);
       
       if constexpr(nHops == 1) {
         return leftMap;
       }
       else {
-        return multiRightExtendMapWithAssns
-          (std::move(leftMap), event, std::move(otherHopInputSpecs)...);
+        return multiRightExtendMapWithAssns(
+          std::move(leftMap), event, options,
+          std::move(otherHopInputSpecs)...
+          );
       }
     } // joinForward()
   
   
+  /// Type of the hop with index `I`.
+  template <std::size_t I>
+  using HopType_t
+    = std::tuple_element_t<I, std::tuple<FirstHopType, OtherHopTypes...>>;
+  
+  /// Runs `joinAtSplit<Split>()` for the `Split` in `Splits` matching `split`.
+  template <
+    typename Event, typename Specs, typename Selector, std::size_t... Splits
+    >
+  static bool joinAtSplit(
+    AssnsMap<KeyType, TargetType>& map, std::size_t split,
+    Event const& event, Specs& specs, std::optional<Selector> const& selector,
+    AssnsCrosserOptions const& options, std::index_sequence<Splits...>
+    )
+    {
+      return (... || (
+        (Splits > 0) && (Splits == split)
+        && (map = joinAtSplit<Splits>(event, specs, selector, options), true)
+        ));
+    }
+  
+  /// Joins forward the first `Split` hops, backward the others, then both.
+  template <
+    std::size_t Split, typename Event, typename Specs, typename Selector
+    >
+  static AssnsMap<KeyType, TargetType> joinAtSplit(
+    Event const& event, Specs& specs, std::optional<Selector> const& selector,
+    AssnsCrosserOptions const& options
+    )
+    {
+      if constexpr ((Split == 0) || (Split >= nHops)) {
+        throw std::logic_error{ "Invalid split point." };
+      }
+      else {
+        auto const leftMap = joinFirstHops
+          (event, specs, selector, options, std::make_index_sequence<Split>{});
+        auto const rightMap = joinLastHops<Split>
+          (event, specs, options, std::make_index_sequence<nHops - Split>{});
+        ScopedHopTimer timer { options, &AssnsCrosserHopTiming::joinTime };
+        return joinMaps(leftMap, rightMap);
+      }
+    }
+  
+  /// Joins forward the hops `I`, starting from the keys.
+  template <
+    typename Event, typename Specs, typename Selector, std::size_t... I
+    >
+  static auto joinFirstHops(
+    Event const& event, Specs& specs, std::optional<Selector> const& selector,
+    AssnsCrosserOptions const& options, std::index_sequence<I...>
+    )
+    {
+      return MapJoiner<KeyType, HopType_t<I>...>::joinForward
+        (event, std::move(std::get<I>(specs))..., selector, options);
+    }
+  
+  /// Joins backward the hops from `Split` on.
+  template <std::size_t Split, typename Event, typename Specs, std::size_t... I>
+  static auto joinLastHops(
+    Event const& event, Specs& specs, AssnsCrosserOptions const& options,
+    std::index_sequence<I...>
+    )
+    {
+      return MapJoiner<HopType_t<Split - 1>, HopType_t<Split + I>...>
+        ::joinBackward(
+          event, std::move(std::get<Split + I>(specs))..., NoSelection, options
+          );
+    }
+  
+  
   /// Returns an association map from `tag` associations read from `event`.
   /// Only left entries passing `selector` are included.
   template <
@@ -1319,41 +2267,14 @@ struct icarus::ns::util::details::MapJoiner {
     >
   static AssnsMap<Left, Right> assnsToMap(
     Event const& event, InputTags const& tags,
-    std::optional<Selector> const& selector = std::nullopt
-    ) {
-      AssnsMap<Left, Right> assnsMap;
-      for (art::InputTag const& tag: tags)
-        addAssnsToMap(assnsMap, event, tag, selector);
-      return assnsMap;
-    } // assnsToMap()
-  
-  /// Extends the association `map` with `tag` associations read from `event`,
-  /// adding only the ones with left pointer listed in `selector`.
-  template <
-    typename Left, typename Right,
-    typename Event, typename Selector = NoSelector_t
-    >
-  static AssnsMap<Left, Right>& addAssnsToMap(
-    AssnsMap<Left, Right>& map, Event const& event, art::InputTag const& tag,
-    std::optional<Selector> const& selector = std::nullopt
+    std::optional<Selector> const& selector = std::nullopt,
+    AssnsCrosserOptions const& options = {}
     ) {
-      return addAssnsToMap(
-        map, event.template getProduct<art::Assns<Left, Right>>(tag), selector
+      return assnsListToMap(
+        readHopAssns<Left, Right, 0U>(event, tags, {}, options),
+        selector, NoSelection, options
         );
-    }
-  
-  /// Extends the association `map` with the specified _art_ associations,
-  /// adding only the ones with left pointer passing `selector`.
-  template <typename Left, typename Right, typename Selector = NoSelector_t>
-  static AssnsMap<Left, Right>& addAssnsToMap(
-    AssnsMap<Left, Right>& map, art::Assns<Left, Right> const& assns,
-    std::optional<Selector> const& selector = std::nullopt
-    ) {
-      for (auto const& [ leftPtr, rightPtr ]: assns) {
-        if (!selector || (*selector)(leftPtr)) map.add(leftPtr, rightPtr);
-      }
-      return map;
-    } // addAssnsToMap()
+    } // assnsToMap()
   
   /**
    * @brief Returns a new association map extended on the key side
@@ -1372,21 +2293,41 @@ struct icarus::ns::util::details::MapJoiner {
    * The resulting map is joining the key of the input `map` with the target of
    * the associations being read.
    * The map _may_ come out smaller than the two inputs.
+   * If a `selector` is specified, only the new keys passing it are included.
+   * 
+   * When the keys of `map` are significantly fewer than the associations being
+   * read, only the associations ending at those keys are stored for the
+   * joining.
    */
   template <
-    typename NewLeft, typename Left, typename Right, typename Event, typename T
+    typename NewLeft, typename Left, typename Right, typename Event, typename T,
+    typename Selector = NoSelector_t
     >
   static AssnsMap<NewLeft, Right> leftExtendMapWithAssns(
-    AssnsMap<Left, Right>&& map, Event const& event, InputSpecs<T> specs) {
+    AssnsMap<Left, Right>&& map, Event const& event, InputSpecs<T> specs,
+    std::optional<Selector> const& selector = std::nullopt,
+    AssnsCrosserOptions const& options = {}
+  ) {
       // read the associations with the material for the extension
       bool const bAutodetect = specs.hasEmptySpecs();
       std::vector<art::InputTag> const tags
         = extractTagList(std::move(specs), event);
       std::vector<art::ProductID> neededIDs;
       if (bAutodetect) neededIDs = map.keyProductIDs();
-      auto const leftMap = mapExtensionPreparation<NewLeft, Left, 1>
-        (event, tags, std::move(neededIDs));
-      return joinMaps(leftMap, std::move(map));
+      
+      std::vector<art::Assns<NewLeft, Left> const*> const assnsList
+        = readHopAssns<NewLeft, Left, 1>(event, tags, neededIDs, options);
+      
+      AssnsMap<NewLeft, Left> leftMap;
+      if (2 * map.assnsMap().size() < countAssns(assnsList)) {
+        std::optional<FrontierSelector<Left>> const frontier
+          { FrontierSelector<Left>::keysOf(map) };
+        leftMap = assnsListToMap(assnsList, selector, frontier, options);
+      }
+      else leftMap = assnsListToMap(assnsList, selector, NoSelection, options);
+      
+      ScopedHopTimer timer { options, &AssnsCrosserHopTiming::joinTime };
+      return joinMaps(leftMap, map);
     } // leftExtendMapWithAssns()
   
   
@@ -1398,19 +2339,20 @@ struct icarus::ns::util::details::MapJoiner {
   multiRightExtendMapWithAssns(
     AssnsMap<Left, Right>&& map,
     Event const& event,
+    AssnsCrosserOptions const& options,
     InputSpecs<NextRight> nextInputSpec,
     InputSpecs<MoreRights>... otherInputSpec
     )
     {
       AssnsMap<Left, NextRight> assnsMap = rightExtendMapWithAssns<NextRight>
-        (std::move(map), event, std::move(nextInputSpec));
+        (std::move(map), event, std::move(nextInputSpec), options);
       
       if constexpr(sizeof...(MoreRights) == 0) {
         return assnsMap;
       }
       else {
         return multiRightExtendMapWithAssns
-          (std::move(assnsMap), event, std::move(otherInputSpec)...);
+          (std::move(assnsMap), event, options, std::move(otherInputSpec)...);
       }
     } // multiRightExtendMapWithAssns()
   
@@ -1431,12 +2373,18 @@ struct icarus::ns::util::details::MapJoiner {
    * The resulting map is joining the key of the association being read with the
    * key of the input `map`.
    * The map _may_ come out smaller than the two inputs.
+   * 
+   * When the targets of `map` are significantly fewer than the associations
+   * being read, only the associations starting from those targets are stored
+   * for the joining.
    */
   template<
     typename NewRight, typename Left, typename Right, typename Event, typename T
     >
-  static AssnsMap<Left, NewRight> rightExtendMapWithAssns
-    (AssnsMap<Left, Right> map, Event const& event, InputSpecs<T> specs)
+  static AssnsMap<Left, NewRight> rightExtendMapWithAssns(
+    AssnsMap<Left, Right> map, Event const& event, InputSpecs<T> specs,
+    AssnsCrosserOptions const& options = {}
+    )
     {
       // read the associations with the material for the extension
       bool const bAutodetect = specs.hasEmptySpecs();
@@ -1444,20 +2392,43 @@ struct icarus::ns::util::details::MapJoiner {
         = extractTagList(std::move(specs), event);
       std::vector<art::ProductID> neededIDs;
       if (bAutodetect) neededIDs = map.targetProductIDs();
-      auto rightMap = mapExtensionPreparation<Right, NewRight, 0U>
-        (event, tags, std::move(neededIDs));
-      return joinMaps(map, std::move(rightMap));
+      
+      std::vector<art::Assns<Right, NewRight> const*> const assnsList
+        = readHopAssns<Right, NewRight, 0U>(event, tags, neededIDs, options);
+      
+      std::size_t nFrontier = 0;
+      for (auto const& pairs: map.assnsMap()) nFrontier += pairs.second.size();
+      
+      AssnsMap<Right, NewRight> rightMap;
+      if (2 * nFrontier < countAssns(assnsList)) {
+        std::optional<FrontierSelector<Right>> const frontier
+          { std::in_place, map };
+        rightMap = assnsListToMap(assnsList, frontier, NoSelection, options);
+      }
+      else {
+        rightMap
+          = assnsListToMap(assnsList, NoSelection, NoSelection, options);
+      }
+      
+      ScopedHopTimer timer { options, &AssnsCrosserHopTiming::joinTime };
+      return joinMaps(map, rightMap);
     }
   
-  /// Joins two maps in the middle, stealing content from the right one.
+  /// Joins two maps in the middle.
+  /// The left keys are processed in `art::Ptr` order, so that the result does
+  /// not depend on the hashing of the left map. A middle object associated to
+  /// more than one left object contributes its targets to all of them.
   template <typename Left, typename Middle, typename Right>
-  static AssnsMap<Left, Right> joinMaps
-    (AssnsMap<Left, Middle> const& leftMap, AssnsMap<Middle, Right>&& rightMap)
+  static AssnsMap<Left, Right> joinMaps(
+    AssnsMap<Left, Middle> const& leftMap,
+    AssnsMap<Middle, Right> const& rightMap
+    )
     {
       AssnsMap<Left, Right> map;
-      for (auto& [ leftPtr, middlePtrs ]: leftMap.assnsMap()) {
+      for (auto const* entry: leftMap.sortedEntries()) {
+        auto const& [ leftPtr, middlePtrs ] = *entry;
         for (art::Ptr<Middle> const& middlePtr: middlePtrs) {
-          map.add(leftPtr, rightMap.yieldAssPtrs(middlePtr));
+          map.add(leftPtr, rightMap.assPtrs(middlePtr));
         } // for middle pointers
       } // for left map
       return map;
@@ -1465,20 +2436,20 @@ struct icarus::ns::util::details::MapJoiner {
   
   
   /**
-   * @brief Collects a map of Left-to-Right pointers.
+   * @brief Reads the `Left`-to-`Right` associations of a hop.
    * @tparam Left type of key in the map
    * @tparam Right type of target in the map
    * @tparam JointSide `0` for `Left` side, `1` for `Right` side
    * @tparam Event type of data repository to read data from (`art::Event` I/F)
-   * @tparam InputTags type of collection of `art::InputTag` objects
    * @param event the event to read the data from
    * @param tags the list of input tags to needed `Left`-to`Right` associations
    * @param requiredIDs list of product IDs needed for the the extension
-   * @return a `Left`-to-`Right` association map
+   * @param options reading options (see `AssnsCrosserOptions`)
+   * @return the `Left`-to-`Right` association data products
    * @throw art::Exception (code: `art::errors::ProductNotFound`) if a required
    *        association is not found
    * 
-   * The returned map contains all the `Left`-to-`Right` associations specified
+   * The returned list contains all the `Left`-to-`Right` associations specified
    * by `tags`; if any is missing, an exception is thrown.
    * 
    * After these associations are collected, the product ID of the pointers
@@ -1487,21 +2458,22 @@ struct icarus::ns::util::details::MapJoiner {
    * appear in the associations collected so far, the algorithm attempts
    * to read another `Left`-to-`Right` association using the exact same input
    * tag as the one associated to that product ID. If such association data
-   * product is found, its content is added to the map. Otherwise, the algorithm
+   * product is found, it is added to the list. Otherwise, the algorithm
    * moves on, not considering this a fatal error.
    * 
    * The only clear fatal error condition tested by this algorithm is when no
    * mandatory tag is specified, some IDs are present in `requiredIDs` _and_
    * no data product has been found from any of them. In that case, an exception
    * is thrown (still `art::errors::ProductNotFound` code).
+   * 
+   * The data products are read concurrently if so requested in `options`,
+   * and a new timing record is started in `options.timing`, if present.
    */
-  template <
-    typename Left, typename Right, std::size_t JointSide,
-    typename Event, typename InputTags
-    >
-  static AssnsMap<Left, Right> mapExtensionPreparation(
-    Event const& event, InputTags const& tags,
-    std::vector<art::ProductID> const& requiredIDs
+  template <typename Left, typename Right, std::size_t JointSide, typename Event>
+  static std::vector<art::Assns<Left, Right> const*> readHopAssns(
+    Event const& event, std::vector<art::InputTag> const& tags,
+    std::vector<art::ProductID> const& requiredIDs,
+    AssnsCrosserOptions const& options
     ) {
       /*
        * First read all the associations with tags that are explicitly tagged;
@@ -1509,28 +2481,39 @@ struct icarus::ns::util::details::MapJoiner {
        * For each required ID not present in the original tags,
        * an association is read (failure is not an error).
        */
-      using Assns_t = AssnsMap<Left, Right>;
-      Assns_t map = assnsToMap<Left, Right>(event, tags);
+      using Assns_t = art::Assns<Left, Right>;
+      using Clock_t = std::chrono::steady_clock;
+      Clock_t::time_point const start = Clock_t::now();
+      
+      std::vector<Assns_t const*> assnsList(tags.size(), nullptr);
+      runConcurrently(tags.size(), options.nThreads,
+        [&event,&tags,&assnsList](std::size_t i)
+        { assnsList[i] = &(event.template getProduct<Assns_t>(tags[i])); }
+        );
       
-      constexpr auto extractProductIDs = (JointSide == 0)
-        ? &Assns_t::keyProductIDs: &Assns_t::targetProductIDs;
-      std::vector<art::ProductID> const mapIDs = (map.*extractProductIDs)();
+      std::vector<art::ProductID> const assnsIDs
+        = assnsProductIDs<JointSide>(assnsList);
       
       std::vector<art::ProductID> const missingIDs
-        = details::set_difference(requiredIDs, mapIDs);
+        = details::set_difference(requiredIDs, assnsIDs);
       
+      std::vector<Assns_t const*> discovered(missingIDs.size(), nullptr);
+      runConcurrently(missingIDs.size(), options.nThreads,
+        [&event,&missingIDs,&discovered](std::size_t i)
+        {
+          auto handle = event.template getHandle<Assns_t>
+            (getInputTag(event, missingIDs[i]));
+          if (handle) discovered[i] = &*handle;
+        });
       unsigned int nDiscovered = 0;
-      for (art::ProductID const ID: missingIDs) {
-        art::InputTag const tag = getInputTag(event, ID);
-        auto handle = event.template getHandle<art::Assns<Left, Right>>(tag);
-        if (!handle) continue;
-        addAssnsToMap(map, *handle);
+      for (Assns_t const* assns: discovered) {
+        if (!assns) continue;
+        assnsList.push_back(assns);
         ++nDiscovered;
       } // for
       
       // error check for an extreme case:
-      using std::empty;
-      if (empty(tags) && !missingIDs.empty() && (nDiscovered == 0)) {
+      if (tags.empty() && !missingIDs.empty() && (nDiscovered == 0)) {
         std::string const leftName = lar::debug::demangle<Left>();
         std::string const rightName = lar::debug::demangle<Right>();
         // even if this error is not triggered we may still be missing some
@@ -1543,8 +2526,103 @@ struct icarus::ns::util::details::MapJoiner {
           << "\n";
       }
       
+      if (options.timing) {
+        AssnsCrosserHopTiming& timing = options.timing->emplace_back();
+        timing.left = lar::debug::demangle<Left>();
+        timing.right = lar::debug::demangle<Right>();
+        timing.nProducts = assnsList.size();
+        timing.nAssns = countAssns(assnsList);
+        timing.readTime
+          = std::chrono::duration<double>(Clock_t::now() - start).count();
+      }
+      
+      return assnsList;
+    } // readHopAssns()
+  
+  
+  /**
+   * @brief Returns a map with the content of all the associations in the list.
+   * @param assnsList the associations to be put in the map
+   * @param selector if specified, only left pointers passing it are included
+   * @param rightSelector if specified, only right pointers passing it are
+   *                      included
+   * @param options reading options (see `AssnsCrosserOptions`)
+   * @return a `Left`-to-`Right` association map
+   * 
+   * If so requested in `options`, the content of each association data
+   * product is sorted by key in a separate map concurrently, and then all the
+   * maps are merged, in the order of `assnsList`.
+   */
+  template <
+    typename Left, typename Right,
+    typename Selector = NoSelector_t, typename RightSelector = NoSelector_t
+    >
+  static AssnsMap<Left, Right> assnsListToMap(
+    std::vector<art::Assns<Left, Right> const*> const& assnsList,
+    std::optional<Selector> const& selector = std::nullopt,
+    std::optional<RightSelector> const& rightSelector = std::nullopt,
+    AssnsCrosserOptions const& options = {}
+    ) {
+      ScopedHopTimer timer { options, &AssnsCrosserHopTiming::mergeTime };
+      
+      auto addAssns = [&selector,&rightSelector]
+        (AssnsMap<Left, Right>& map, art::Assns<Left, Right> const& assns)
+        {
+          for (auto const& [ leftPtr, rightPtr ]: assns) {
+            if (selector && !(*selector)(leftPtr)) continue;
+            if (rightSelector && !(*rightSelector)(rightPtr)) continue;
+            map.add(leftPtr, rightPtr);
+          }
+        };
+      
+      if ((options.nThreads == 1U) || (assnsList.size() <= 1)) {
+        AssnsMap<Left, Right> map;
+        for (art::Assns<Left, Right> const* assns: assnsList)
+          addAssns(map, *assns);
+        return map;
+      }
+      
+      std::vector<AssnsMap<Left, Right>> maps(assnsList.size());
+      runConcurrently(assnsList.size(), options.nThreads,
+        [&addAssns,&maps,&assnsList](std::size_t i)
+        { addAssns(maps[i], *(assnsList[i])); }
+        );
+      
+      AssnsMap<Left, Right> map = std::move(maps.front());
+      for (auto it = std::next(maps.begin()); it != maps.end(); ++it) {
+        for (auto& [ keyPtr, targetPtrs ]: it->assnsMap())
+          map.add(keyPtr, std::move(targetPtrs));
+      } // for
       return map;
-    } // mapExtensionPreparation()
+    } // assnsListToMap()
+  
+  /// Returns the total number of associated pairs in `assnsList`.
+  template <typename Left, typename Right>
+  static std::size_t countAssns
+    (std::vector<art::Assns<Left, Right> const*> const& assnsList)
+    {
+      std::size_t n = 0;
+      for (art::Assns<Left, Right> const* assns: assnsList) n += assns->size();
+      return n;
+    }
+  
+  /// Returns the sorted product IDs on the `Side` of all `assnsList` content.
+  template <std::size_t Side, typename Left, typename Right>
+  static std::vector<art::ProductID> assnsProductIDs
+    (std::vector<art::Assns<Left, Right> const*> const& assnsList)
+    {
+      std::vector<art::ProductID> IDs;
+      for (art::Assns<Left, Right> const* assns: assnsList) {
+        for (auto const& pairs: *assns) {
+          art::ProductID const ID = std::get<Side>(pairs).id();
+          if (!IDs.empty() && (IDs.back() == ID)) continue; // common case
+          if (std::find(IDs.begin(), IDs.end(), ID) == IDs.end())
+            IDs.push_back(ID);
+        } // for pairs
+      } // for associations
+      std::sort(IDs.begin(), IDs.end());
+      return IDs;
+    } // assnsProductIDs()
   
   /// Returns the input tag associated to the product `ID` (empty if not found).
   template <typename Event>
@@ -1595,6 +2673,392 @@ struct icarus::ns::util::details::MapJoiner {
 }; // icarus::ns::util::details::MapJoiner
 
 
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::details::IndexAssns
+// -----------------------------------------------------------------------------
+/**
+ * @brief Associations between the elements of two data products, by index.
+ * 
+ * The associations are stored in compressed rows: the elements of the right
+ * data product associated to the element with index `i` of the left one have
+ * indices `rights[offsets[i]]` to `rights[offsets[i + 1] - 1]`, in the same
+ * order as in the original association.
+ */
+struct icarus::ns::util::details::IndexAssns {
+  
+  art::ProductID leftID; ///< ID of the left data product.
+  art::ProductID rightID; ///< ID of the right data product.
+  
+  /// Position in `rights` of the first entry of each left element, plus end.
+  std::vector<std::size_t> offsets;
+  
+  std::vector<std::size_t> rights; ///< Indices of the right elements.
+  
+  /// Returns the number of left elements (including unassociated ones).
+  std::size_t nLeft() const noexcept
+    { return offsets.empty()? 0: offsets.size() - 1; }
+  
+  /**
+   * @brief Returns the associations in `assns` by index.
+   * @return the associations, or none if `assns` can't be represented
+   * 
+   * No value is returned if `assns` is empty, or if it refers to more than one
+   * data product on either side.
+   */
+  template <typename Left, typename Right>
+  static std::optional<IndexAssns> fromAssns
+    (art::Assns<Left, Right> const& assns);
+  
+  /// Returns the associations from following these and then the `next` ones.
+  IndexAssns join(IndexAssns const& next) const;
+  
+}; // icarus::ns::util::details::IndexAssns
+
+
+// -----------------------------------------------------------------------------
+template <typename Left, typename Right>
+auto icarus::ns::util::details::IndexAssns::fromAssns
+  (art::Assns<Left, Right> const& assns) -> std::optional<IndexAssns>
+{
+  if (assns.size() == 0) return std::nullopt;
+  
+  IndexAssns indexAssns;
+  indexAssns.leftID = assns.begin()->first.id();
+  indexAssns.rightID = assns.begin()->second.id();
+  
+  std::size_t nLeft = 0;
+  for (auto const& [ leftPtr, rightPtr ]: assns) {
+    if ((leftPtr.id() != indexAssns.leftID)
+      || (rightPtr.id() != indexAssns.rightID)
+      || leftPtr.isNull() || rightPtr.isNull()
+    ) {
+      return std::nullopt;
+    }
+    nLeft = std::max(nLeft, leftPtr.key() + 1);
+  } // for
+  
+  // counting sort by left index, preserving the original order of the rights
+  std::vector<std::size_t>& offsets = indexAssns.offsets;
+  offsets.assign(nLeft + 1, 0);
+  for (auto const& pairs: assns) ++offsets[pairs.first.key() + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  
+  std::vector<std::size_t> next { offsets.begin(), offsets.end() - 1 };
+  indexAssns.rights.resize(offsets.back());
+  for (auto const& [ leftPtr, rightPtr ]: assns)
+    indexAssns.rights[next[leftPtr.key()]++] = rightPtr.key();
+  
+  return indexAssns;
+} // icarus::ns::util::details::IndexAssns::fromAssns()
+
+
+// -----------------------------------------------------------------------------
+inline auto icarus::ns::util::details::IndexAssns::join
+  (IndexAssns const& next) const -> IndexAssns
+{
+  IndexAssns joined;
+  joined.leftID = leftID;
+  joined.rightID = next.rightID;
+  joined.offsets.reserve(offsets.size());
+  joined.offsets.push_back(0);
+  
+  std::size_t const nMiddle = next.nLeft();
+  for (std::size_t iLeft = 0; iLeft < nLeft(); ++iLeft) {
+    for (std::size_t i = offsets[iLeft]; i < offsets[iLeft + 1]; ++i) {
+      std::size_t const iMiddle = rights[i];
+      if (iMiddle >= nMiddle) continue;
+      joined.rights.insert(joined.rights.end(),
+        next.rights.begin() + next.offsets[iMiddle],
+        next.rights.begin() + next.offsets[iMiddle + 1]
+        );
+    } // for middle
+    joined.offsets.push_back(joined.rights.size());
+  } // for left
+  
+  return joined;
+} // icarus::ns::util::details::IndexAssns::join()
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::details::IndexJoiner
+// -----------------------------------------------------------------------------
+/**
+ * @brief Joins associations working on element indices.
+ * @tparam KeyType type of the key of the joined associations
+ * @tparam HopTypes type of each hop, the last being the target type
+ * 
+ * This engine applies when each hop is specified by a single input tag, and
+ * the associations of each hop refer to a single data product on each side,
+ * with the right product of each hop being the left product of the next one.
+ * In that case the joining is performed on `art::Ptr::key()` indices in dense
+ * arrays (`IndexAssns`), and `art::Ptr` are used only for the final result.
+ * 
+ * The result is the same as with `MapJoiner`.
+ */
+template <typename KeyType, typename... HopTypes>
+struct icarus::ns::util::details::IndexJoiner {
+  
+  using TargetType = typename last_type<HopTypes...>::type;
+  
+  using Result_t = FlatAssnsMap<KeyType, TargetType>;
+  
+  /// Returns whether the specifications are suitable for this engine.
+  static bool canJoin(InputSpecs<HopTypes> const&... inputSpecs)
+    { return (isSingleSpec(inputSpecs) && ...); }
+  
+  /**
+   * @brief Returns the joined associations, if this engine applies.
+   * @tparam Event a data repository (`art::Event`-like interface)
+   * @tparam Selector functor with `bool operator() const (art::Ptr<KeyType>)`
+   * @param event the event to read the associations from
+   * @param inputSpecs the specification of each hop
+   * @param selector if specified, only keys passing the selector are included
+   * @param options reading options (see `AssnsCrosserOptions`)
+   * @return the associations from the key to the target, or none
+   * 
+   * If any hop does not match the requirements of this engine (including the
+   * associations not being found in `event`), no value is returned.
+   * 
+   * The hops are read and sorted concurrently if so requested in `options`.
+   * Timing records are added to `options.timing` (if present) only if a value
+   * is returned.
+   */
+  template <typename Event, typename Selector>
+  static std::optional<Result_t> join(
+    Event const& event, InputSpecs<HopTypes> const&... inputSpecs,
+    std::optional<Selector> const& selector,
+    AssnsCrosserOptions const& options = {}
+    );
+  
+    private:
+  
+  /// Whether `specs` holds exactly one explicit input specification.
+  template <typename T>
+  static bool isSingleSpec(InputSpecs<T> const& specs)
+    { return (specs.size() == 1) && !specs.hasEmptySpecs(); }
+  
+  /// Returns the `Left`-to-`Right` association data product from `spec`.
+  template <typename Left, typename Right, typename Event>
+  static art::Assns<Left, Right> const* readAssns
+    (Event const& event, InputSpecs<Right> const& spec);
+  
+  /// Type on the left of the hop number `I`.
+  template <std::size_t I>
+  using Left_t = std::tuple_element_t<I, std::tuple<KeyType, HopTypes...>>;
+  
+  /// Type on the right of the hop number `I`.
+  template <std::size_t I>
+  using Right_t = std::tuple_element_t<I + 1, std::tuple<KeyType, HopTypes...>>;
+  
+  /// Key and target pointers (by key), and hops being read.
+  struct HopData_t {
+    std::vector<std::optional<IndexAssns>> hops; ///< All the hops.
+    std::vector<AssnsCrosserHopTiming> timing; ///< Timing of all the hops.
+    std::vector<art::Ptr<KeyType>> keyPtrs; ///< Key pointers, by key.
+    std::vector<art::Ptr<TargetType>> targetPtrs; ///< Target pointers, by key.
+  }; // HopData_t
+  
+  /**
+   * @brief Reads all the hops `I` into `data`.
+   * @param event the event to read the associations from
+   * @param specs the specification of each hop
+   * @param data the hop information to be filled
+   * @param nThreads number of threads to read the hops with
+   * 
+   * Hops which can't be used with this engine are left empty.
+   */
+  template <typename Event, typename Specs, std::size_t... I>
+  static void readHops(
+    Event const& event, Specs const& specs, HopData_t& data,
+    unsigned int nThreads, std::index_sequence<I...>
+    );
+  
+  /// Reads the hop number `I` into `data`.
+  template <std::size_t I, typename Event>
+  static void readHop
+    (Event const& event, InputSpecs<Right_t<I>> const& spec, HopData_t& data);
+  
+  /// Fills `ptrs` with pointers of the `Side` of `assns`, by key.
+  template <std::size_t Side, typename Left, typename Right, typename T>
+  static void collectPtrs
+    (art::Assns<Left, Right> const& assns, std::vector<art::Ptr<T>>& ptrs);
+  
+}; // icarus::ns::util::details::IndexJoiner
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... HopTypes>
+template <typename Event, typename Selector>
+auto icarus::ns::util::details::IndexJoiner<KeyType, HopTypes...>::join(
+  Event const& event, InputSpecs<HopTypes> const&... inputSpecs,
+  std::optional<Selector> const& selector,
+  AssnsCrosserOptions const& options /* = {} */
+) -> std::optional<Result_t>
+{
+  using Clock_t = std::chrono::steady_clock;
+  auto secondsSince = [](Clock_t::time_point start)
+    { return std::chrono::duration<double>(Clock_t::now() - start).count(); };
+  
+  if (!canJoin(inputSpecs...)) return std::nullopt;
+  
+  constexpr std::size_t nHops = sizeof...(HopTypes);
+  
+  HopData_t data;
+  readHops(event, std::forward_as_tuple(inputSpecs...), data, options.nThreads,
+    std::make_index_sequence<nHops>{});
+  
+  std::vector<IndexAssns> hops;
+  hops.reserve(nHops);
+  for (std::optional<IndexAssns>& hop: data.hops) {
+    if (!hop) return std::nullopt;
+    hops.push_back(std::move(*hop));
+  }
+  std::vector<art::Ptr<KeyType>> const& keyPtrs = data.keyPtrs;
+  std::vector<art::Ptr<TargetType>> const& targetPtrs = data.targetPtrs;
+  
+  for (std::size_t iHop = 1; iHop < hops.size(); ++iHop)
+    if (hops[iHop - 1].rightID != hops[iHop].leftID) return std::nullopt;
+  
+  // unselected keys are removed before joining, and their paths not followed
+  Clock_t::time_point start = Clock_t::now();
+  if (selector) {
+    IndexAssns& first = hops.front();
+    std::vector<std::size_t> offsets { 0 };
+    offsets.reserve(first.offsets.size());
+    std::vector<std::size_t> rights;
+    for (std::size_t iKey = 0; iKey < first.nLeft(); ++iKey) {
+      auto const begin = first.rights.cbegin() + first.offsets[iKey];
+      auto const end = first.rights.cbegin() + first.offsets[iKey + 1];
+      if ((begin != end) && (*selector)(keyPtrs[iKey]))
+        rights.insert(rights.end(), begin, end);
+      offsets.push_back(rights.size());
+    } // for
+    first.offsets = std::move(offsets);
+    first.rights = std::move(rights);
+  } // if selector
+  
+  data.timing.front().mergeTime += secondsSince(start);
+  
+  IndexAssns joined = std::move(hops.front());
+  for (std::size_t iHop = 1; iHop < hops.size(); ++iHop) {
+    start = Clock_t::now();
+    joined = joined.join(hops[iHop]);
+    data.timing[iHop].joinTime += secondsSince(start);
+  }
+  
+  start = Clock_t::now();
+  
+  // all keys are from the same data product, so index order is pointer order
+  std::vector<art::Ptr<KeyType>> keys;
+  std::vector<std::size_t> offsets { 0 };
+  std::vector<art::Ptr<TargetType>> targets;
+  targets.reserve(joined.rights.size());
+  for (std::size_t iKey = 0; iKey < joined.nLeft(); ++iKey) {
+    std::size_t const begin = joined.offsets[iKey];
+    std::size_t const end = joined.offsets[iKey + 1];
+    if (begin == end) continue;
+    keys.push_back(keyPtrs[iKey]);
+    for (std::size_t i = begin; i < end; ++i)
+      targets.push_back(targetPtrs[joined.rights[i]]);
+    offsets.push_back(targets.size());
+  } // for
+  data.timing.back().joinTime += secondsSince(start);
+  
+  if (options.timing) append(*options.timing, std::move(data.timing));
+  
+  return std::optional<Result_t>{ std::in_place,
+    std::move(keys), std::move(offsets), std::move(targets)
+    };
+  
+} // icarus::ns::util::details::IndexJoiner<>::join()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... HopTypes>
+template <typename Left, typename Right, typename Event>
+auto icarus::ns::util::details::IndexJoiner<KeyType, HopTypes...>::readAssns
+  (Event const& event, InputSpecs<Right> const& spec)
+  -> art::Assns<Left, Right> const*
+{
+  std::vector<art::InputTag> const tags
+    = MapJoiner<KeyType, HopTypes...>::extractTagList
+      (InputSpecs<Right>{ spec }, event);
+  if (tags.size() != 1) return nullptr;
+  auto const handle
+    = event.template getHandle<art::Assns<Left, Right>>(tags.front());
+  return handle? &*handle: nullptr;
+} // icarus::ns::util::details::IndexJoiner<>::readAssns()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... HopTypes>
+template <typename Event, typename Specs, std::size_t... I>
+void icarus::ns::util::details::IndexJoiner<KeyType, HopTypes...>::readHops(
+  Event const& event, Specs const& specs, HopData_t& data,
+  unsigned int nThreads, std::index_sequence<I...>
+) {
+  data.hops.resize(sizeof...(I));
+  data.timing.resize(sizeof...(I));
+  
+  // each task writes only its own hop data (and the key or target pointers)
+  std::vector<std::function<void()>> const tasks {
+    [&event,&specs,&data](){ readHop<I>(event, std::get<I>(specs), data); }...
+    };
+  runConcurrently
+    (tasks.size(), nThreads, [&tasks](std::size_t iTask){ tasks[iTask](); });
+  
+} // icarus::ns::util::details::IndexJoiner<>::readHops()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... HopTypes>
+template <std::size_t I, typename Event>
+void icarus::ns::util::details::IndexJoiner<KeyType, HopTypes...>::readHop
+  (Event const& event, InputSpecs<Right_t<I>> const& spec, HopData_t& data)
+{
+  using Clock_t = std::chrono::steady_clock;
+  using Left = Left_t<I>;
+  using Right = Right_t<I>;
+  
+  AssnsCrosserHopTiming& timing = data.timing[I];
+  timing.left = lar::debug::demangle<Left>();
+  timing.right = lar::debug::demangle<Right>();
+  
+  Clock_t::time_point const start = Clock_t::now();
+  art::Assns<Left, Right> const* assns = readAssns<Left>(event, spec);
+  Clock_t::time_point const read = Clock_t::now();
+  timing.readTime = std::chrono::duration<double>(read - start).count();
+  if (!assns) return;
+  timing.nProducts = 1;
+  timing.nAssns = assns->size();
+  
+  data.hops[I] = IndexAssns::fromAssns(*assns);
+  if (!data.hops[I]) return;
+  
+  if constexpr(I == 0) collectPtrs<0U>(*assns, data.keyPtrs);
+  if constexpr(I + 1 == sizeof...(HopTypes))
+    collectPtrs<1U>(*assns, data.targetPtrs);
+  
+  timing.mergeTime
+    = std::chrono::duration<double>(Clock_t::now() - read).count();
+  
+} // icarus::ns::util::details::IndexJoiner<>::readHop()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... HopTypes>
+template <std::size_t Side, typename Left, typename Right, typename T>
+void icarus::ns::util::details::IndexJoiner<KeyType, HopTypes...>::collectPtrs
+  (art::Assns<Left, Right> const& assns, std::vector<art::Ptr<T>>& ptrs)
+{
+  for (auto const& pairs: assns) {
+    art::Ptr<T> const& ptr = std::get<Side>(pairs);
+    if (ptr.key() >= ptrs.size()) ptrs.resize(ptr.key() + 1);
+    ptrs[ptr.key()] = ptr;
+  } // for
+} // icarus::ns::util::details::IndexJoiner<>::collectPtrs()
+
+
 // -----------------------------------------------------------------------------
 // ---  icarus::ns::util::AssnsCrosser
 // -----------------------------------------------------------------------------
@@ -1622,8 +3086,25 @@ icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::AssnsCrosser(
   StartSpecs<KeyType> startSpecs,
   InputSpecs<OtherTypes>... otherInputSpecs
 )
-  : fAssnsMap
-    { prepare(event, std::move(startSpecs), std::move(otherInputSpecs)... ) }
+  : AssnsCrosser{ event, AssnsCrosserOptions{},
+    std::move(startSpecs), std::move(otherInputSpecs)...
+    }
+{}
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <typename Event>
+icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::AssnsCrosser(
+  Event const& event,
+  AssnsCrosserOptions const& options,
+  StartSpecs<KeyType> startSpecs,
+  InputSpecs<OtherTypes>... otherInputSpecs
+)
+  : fAssnsMap{
+    prepare
+      (event, options, std::move(startSpecs), std::move(otherInputSpecs)...)
+    }
 {}
 
 
@@ -1632,7 +3113,7 @@ template <typename KeyType, typename... OtherTypes>
 auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::assPtr
   (KeyPtr_t const& keyPtr) const -> TargetPtr_t const&
 {
-  TargetPtrs_t const& targets = assPtrs(keyPtr);
+  TargetPtrSpan_t const targets = assPtrs(keyPtr);
   if (targets.size() > 1) {
     // using LogicError because that's what art::FindOne does
     throw art::Exception{ art::errors::LogicError }
@@ -1640,7 +3121,7 @@ auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::assPtr
       << lar::debug::demangle<Target_t>() << " objects associated to Ptr<"
       << lar::debug::demangle<Key_t>() << ">=" << keyPtr << "!\n";
   }
-  return targets.empty()? NullTargetPtr: targets.front();
+  return targets.empty()? NullTargetPtr: targets[0];
 } // icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::assPtr()
 
 
@@ -1648,42 +3129,156 @@ auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::assPtr
 template <typename KeyType, typename... OtherTypes>
 template <typename Event>
 auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::prepare(
-  Event const& event,
+  Event const& event, AssnsCrosserOptions const& options,
   StartSpecs<KeyType> startSpecs, InputSpecs<OtherTypes>... otherInputSpecs
-) const -> AssnsMap_t
+) const -> FlatAssnsMap_t
 {
+  ICARUS_SCOPED_TIMER("AssnsCrosser::prepare");
+  
   std::optional<details::PointerSelector<Key_t>> keySelector
     = keysFromSpecs(event, startSpecs);
-  HoppingAlgo const algo
-    = chooseTraversalAlgorithm(startSpecs, otherInputSpecs...);
-  switch (algo) {
+  
+  // crossings of the whole event with all hops specified can be shared
+  if (options.cache && !keySelector
+    && (... && (!otherInputSpecs.empty() && !otherInputSpecs.hasEmptySpecs()))
+  ) {
+    return prepareWithCache(event, options, std::move(otherInputSpecs)...);
+  }
+  
+  // with one data product per hop, work on indices instead than pointers
+  using IndexJoiner_t = details::IndexJoiner<KeyType, OtherTypes...>;
+  if (IndexJoiner_t::canJoin(otherInputSpecs...)) {
+    std::optional<FlatAssnsMap_t> map
+      = IndexJoiner_t::join(event, otherInputSpecs..., keySelector, options);
+    if (map) return std::move(*map);
+  }
+  
+  Traversal_t const traversal = chooseTraversalAlgorithm
+    (event, options, startSpecs, keySelector, otherInputSpecs...);
+  
+  using MapJoiner_t = details::MapJoiner<KeyType, OtherTypes...>;
+  switch (traversal.algo) {
     case HoppingAlgo::forward:
-      return details::MapJoiner<KeyType, OtherTypes...>::joinForward
-        (event, std::move(otherInputSpecs)..., keySelector);
+      return FlatAssnsMap_t{
+        MapJoiner_t::joinForward
+          (event, std::move(otherInputSpecs)..., keySelector, options)
+        };
     case HoppingAlgo::backward:
-      return details::MapJoiner<KeyType, OtherTypes...>::joinBackward
-        (event, std::move(otherInputSpecs)... );
+      return FlatAssnsMap_t{
+        MapJoiner_t::joinBackward
+          (event, std::move(otherInputSpecs)..., keySelector, options)
+        };
+    case HoppingAlgo::middle:
+      return FlatAssnsMap_t{
+        MapJoiner_t::joinFromMiddle(traversal.split,
+          event, std::move(otherInputSpecs)..., keySelector, options
+          )
+        };
     default:
-      throw std::logic_error
-        { "Unexpected direction: " + std::to_string(static_cast<int>(algo)) };
+      throw std::logic_error{ "Unexpected direction: "
+        + std::to_string(static_cast<int>(traversal.algo)) };
   } // switch
 } // icarus::ns::util::AssnsCrosser<>::prepare()
 
 
 // -----------------------------------------------------------------------------
 template <typename KeyType, typename... OtherTypes>
+template <typename Event>
+auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::prepareWithCache(
+  Event const& event, AssnsCrosserOptions const& options,
+  InputSpecs<OtherTypes>... otherInputSpecs
+) -> FlatAssnsMap_t
+{
+  constexpr std::size_t nHops = sizeof...(OtherTypes);
+  
+  // identifier of the chain up to each hop, from its types and input tags
+  std::vector<std::string> chains;
+  chains.reserve(nHops);
+  std::string chain = lar::debug::demangle<Key_t>();
+  auto const addHop
+    = [&event,&chains,&chain](std::string const& typeName, auto hopSpecs)
+    {
+      std::vector<art::InputTag> const tags
+        = details::MapJoiner<KeyType, OtherTypes...>::extractTagList
+          (std::move(hopSpecs), event);
+      chain += " => " + typeName + " [";
+      for (std::size_t iTag = 0; iTag < tags.size(); ++iTag) {
+        if (iTag > 0) chain += ", ";
+        chain += tags[iTag].encode();
+      }
+      chain += "]";
+      chains.push_back(chain);
+    };
+  (addHop(lar::debug::demangle<OtherTypes>(), otherInputSpecs), ...);
+  
+  std::tuple<InputSpecs<OtherTypes>...> specs{ std::move(otherInputSpecs)... };
+  bool hit = false;
+  FlatAssnsMap_t map
+    { crossCachedHops<nHops - 1>(event, options, specs, chains, hit) };
+  options.cache->count(hit);
+  return map;
+} // icarus::ns::util::AssnsCrosser<>::prepareWithCache()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <std::size_t I, typename Event>
+auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::crossCachedHops(
+  Event const& event, AssnsCrosserOptions const& options,
+  std::tuple<InputSpecs<OtherTypes>...>& specs,
+  std::vector<std::string> const& chains, bool& hit
+) -> details::AssnsMap<Key_t, HopType_t<I>>
+{
+  using Hop_t = HopType_t<I>;
+  
+  AssnsCrosserCache& cache = *options.cache;
+  if (auto const* cached = cache.template find<Key_t, Hop_t>(chains[I])) {
+    hit = true;
+    return *cached;
+  }
+  
+  // not in the cache: cross from the previous hop (also looked up) forward
+  details::AssnsMap<Key_t, Hop_t> map;
+  if constexpr (I == 0) {
+    map = details::MapJoiner<KeyType, Hop_t>::joinForward(
+      event, std::move(std::get<0>(specs)),
+      std::optional<details::PointerSelector<Key_t>>{}, options
+      );
+  }
+  else {
+    map = details::MapJoiner<KeyType, OtherTypes...>
+      ::template rightExtendMapWithAssns<Hop_t>(
+        crossCachedHops<I - 1>(event, options, specs, chains, hit),
+        event, std::move(std::get<I>(specs)), options
+      );
+  }
+  cache.store(chains[I], map);
+  return map;
+} // icarus::ns::util::AssnsCrosser<>::crossCachedHops()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <typename Event>
 auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>
   ::chooseTraversalAlgorithm
 (
+  Event const& event,
+  AssnsCrosserOptions const& options,
   StartSpecs<KeyType> const& startSpecs,
+  std::optional<details::PointerSelector<Key_t>> const& keySelector,
   InputSpecs<OtherTypes> const&... otherInputSpecs
-) const -> HoppingAlgo {
+) const -> Traversal_t {
   /*
-   * If there is a start specification, we need (and can) to go forward.
-   * Otherwise, we go backward (faster) unless there is no specification for
-   * the last hop (in which case we can't start from the back).
+   * If all the hops are explicitly specified, any traversal is possible:
+   * the one with the smallest estimated cost is chosen, based on the size of
+   * the associations and on the number of selected keys.
    * 
-   * When both algorithms are available, the backward one is chosen.
+   * Otherwise, the products of some hops need to be autodetected, which is
+   * possible only continuing from a known hop. If there is a start
+   * specification or a specification of the first hop, we go forward;
+   * otherwise, we go backward unless there is no specification for the last
+   * hop (in which case we can't start from the back).
    */
   
   bool const hasStartInfo = startSpecs.hasSpecs();
@@ -1707,9 +3302,29 @@ auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>
   
   // --- END ---- DEBUG --------------------------------------------------------
 #endif // 0
+  bool const fullySpecified
+    = (... && (!otherInputSpecs.empty() && !otherInputSpecs.hasEmptySpecs()));
+  if (fullySpecified) {
+    std::optional<std::size_t> nKeys;
+    if (keySelector && !keySelector->hasProductIDs())
+      nKeys = keySelector->nPointers();
+    
+    details::TraversalCostModel const costModel{
+      collectHopStats(event, options,
+        std::forward_as_tuple(otherInputSpecs...),
+        std::make_index_sequence<nHops>{}
+        ),
+      nKeys
+      };
+    std::size_t const split = costModel.bestSplit();
+    if (split == 0) return { HoppingAlgo::backward };
+    if (split >= nHops) return { HoppingAlgo::forward };
+    return { HoppingAlgo::middle, split };
+  } // if fully specified
+  
   if constexpr(nHops == 1) {
-    if (hasStartInfo) return HoppingAlgo::forward;
-    if (hasEndSpecs) return HoppingAlgo::backward;
+    if (hasStartInfo) return { HoppingAlgo::forward };
+    if (hasEndSpecs) return { HoppingAlgo::backward };
     throw std::logic_error
       { "Insufficient specifications for single association traversal." };
   }
@@ -1717,8 +3332,8 @@ auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>
     bool const hasFirstSpecs
       = hasStartInfo || details::getElement<0>(otherInputSpecs...).hasSpecs();
     
-    if (hasFirstSpecs) return HoppingAlgo::forward;
-    if (hasEndSpecs) return HoppingAlgo::backward;
+    if (hasFirstSpecs) return { HoppingAlgo::forward };
+    if (hasEndSpecs) return { HoppingAlgo::backward };
     
     throw std::logic_error{
       "Insufficient specifications for traversal of " + std::to_string(nHops)
@@ -1730,6 +3345,62 @@ auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>
 } // icarus::ns::util::AssnsCrosser<>::chooseTraversalAlgorithm()
 
 
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <typename Event, std::size_t... I>
+auto icarus::ns::util::AssnsCrosser<KeyType, OtherTypes...>::collectHopStats(
+  Event const& event,
+  AssnsCrosserOptions const& options,
+  std::tuple<InputSpecs<OtherTypes> const&...> const& specs,
+  std::index_sequence<I...>
+) -> std::vector<details::HopStats>
+{
+  using Types_t = std::tuple<KeyType, OtherTypes...>;
+  using Clock_t = std::chrono::steady_clock;
+  
+  std::vector<details::HopStats> stats(sizeof...(I));
+  std::vector<AssnsCrosserHopTiming> timing(sizeof...(I));
+  auto addHop = [&event,&stats,&timing]
+    (std::size_t iHop, auto const& hopSpecs, auto assnsType)
+    {
+      // assnsType is a `details::TypeTag` of the association type
+      using Assns_t = typename decltype(assnsType)::type;
+      Clock_t::time_point const start = Clock_t::now();
+      std::vector<art::InputTag> const tags
+        = details::MapJoiner<KeyType, OtherTypes...>::extractTagList
+          (std::decay_t<decltype(hopSpecs)>{ hopSpecs }, event);
+      
+      AssnsCrosserHopTiming& hopTiming = timing[iHop];
+      hopTiming.left = lar::debug::demangle<typename Assns_t::left_t>();
+      hopTiming.right = lar::debug::demangle<typename Assns_t::right_t>();
+      for (art::InputTag const& tag: tags) {
+        auto const handle = event.template getHandle<Assns_t>(tag);
+        if (!handle) continue;
+        stats[iHop].add(*handle);
+        ++hopTiming.nProducts;
+      }
+      hopTiming.nAssns = stats[iHop].nAssns;
+      hopTiming.readTime
+        = std::chrono::duration<double>(Clock_t::now() - start).count();
+    };
+  
+  // each hop is read in its own task
+  std::vector<std::function<void()>> const tasks {
+    [&addHop,&specs](){
+      addHop(I, std::get<I>(specs), details::TypeTag<art::Assns<
+          std::tuple_element_t<I, Types_t>, std::tuple_element_t<I + 1, Types_t>
+        >>{});
+    }...
+    };
+  runConcurrently(tasks.size(), options.nThreads,
+    [&tasks](std::size_t iTask){ tasks[iTask](); });
+  
+  if (options.timing) details::append(*options.timing, std::move(timing));
+  
+  return stats;
+} // icarus::ns::util::AssnsCrosser<>::collectHopStats()
+
+
 // -----------------------------------------------------------------------------
 template <typename KeyType, typename... OtherTypes>
 template <typename T, typename Event>
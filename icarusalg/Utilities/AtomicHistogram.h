@@ -0,0 +1,276 @@
+/**
+ * @file   icarusalg/Utilities/AtomicHistogram.h
+ * @brief  Histogram with fixed binning which can be filled concurrently.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Utilities/PlotSandbox.h`
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSALG_UTILITIES_ATOMICHISTOGRAM_H
+#define ICARUSALG_UTILITIES_ATOMICHISTOGRAM_H
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <array>
+#include <atomic>
+#include <memory> // std::unique_ptr<>
+#include <type_traits> // std::enable_if_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+
+  template <std::size_t NDims> class AtomicHistogram;
+
+  using AtomicHist1D = AtomicHistogram<1U>; ///< One-dimension histogram.
+  using AtomicHist2D = AtomicHistogram<2U>; ///< Two-dimension histogram.
+
+} // namespace icarus::ns::util
+
+/**
+ * @brief Histogram content with fixed binning, filled without locks.
+ * @tparam NDims number of dimensions of the histogram
+ *
+ * This object holds the content of a histogram with uniform binning on each
+ * axis, with the same bin numbering as ROOT (bin `0` is the underflow, bin
+ * `nBins + 1` the overflow; for more dimensions the global bin number is
+ * `ix + (nx + 2) * iy`).
+ * All the counters are atomic, and `fill()` can be called by any number of
+ * threads at the same time with no synchronization and no ROOT involvement.
+ *
+ * The content is transferred into a ROOT histogram with `transferTo()`, which
+ * is _not_ thread-safe:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::AtomicHist1D times { { 100U, -5.0, 5.0 } };
+ *
+ * // in any thread:
+ * for (double const time: photonTimes) times.fill(time);
+ *
+ * // after all threads are done:
+ * TH1F HTimes { "HTimes", "Photon times;time [us];photons", 100, -5.0, 5.0 };
+ * times.transferTo(HTimes);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * The statistics of the ROOT histogram (mean, RMS...) are computed from the
+ * bin content, as with `TH1::ResetStats()`, rather than from the unbinned
+ * values.
+ *
+ * `icarus::ns::util::PlotSandbox::makeDeferred()` creates a ROOT histogram
+ * in the sandbox together with one of these objects, and takes care of the
+ * transfer (`PlotSandbox::flushDeferred()`).
+ */
+template <std::size_t NDims>
+class icarus::ns::util::AtomicHistogram {
+
+  static_assert(NDims > 0U, "Histograms need at least one dimension.");
+  static_assert(std::atomic<double>::is_always_lock_free,
+    "Atomic histograms require lock-free atomic double.");
+
+    public:
+
+  /// Number of dimensions of the histogram.
+  static constexpr std::size_t Dimensions = NDims;
+
+  /// Uniform binning of one axis.
+  struct Axis_t {
+
+    unsigned int nBins = 1U; ///< Number of bins (excluding under/overflow).
+    double lower = 0.0; ///< Lower limit of the axis (included).
+    double upper = 1.0; ///< Upper limit of the axis (excluded).
+
+    /// Returns the ROOT-style bin number of `x` (`0` is underflow).
+    unsigned int binOf(double x) const
+      {
+        if (x < lower) return 0U;
+        if (!(x < upper)) return nBins + 1U;
+        auto const bin = static_cast<unsigned int>
+          (nBins * (x - lower) / (upper - lower)); // same as ROOT
+        return std::min(bin, nBins - 1U) + 1U; // protect from rounding
+      }
+
+  }; // Axis_t
+
+
+  /// Constructor: sets the binning of all the axes.
+  explicit AtomicHistogram(std::array<Axis_t, NDims> axes);
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling (thread-safe)
+  /// @{
+
+  /// Adds an entry with the specified `weight` at position `x` (1D only).
+  template <std::size_t N = NDims, std::enable_if_t<N == 1U>* = nullptr>
+  void fill(double x, double weight = 1.0)
+    { fillBin(axis(0U).binOf(x), weight); }
+
+  /// Adds an entry with the specified `weight` at position (`x`, `y`) (2D).
+  template <std::size_t N = NDims, std::enable_if_t<N == 2U>* = nullptr>
+  void fill(double x, double y, double weight = 1.0)
+    {
+      fillBin
+        (axis(0U).binOf(x) + (axis(0U).nBins + 2U) * axis(1U).binOf(y), weight);
+    }
+
+  /// Adds an entry with the specified `weight` to the global bin `bin`.
+  void fillBin(std::size_t bin, double weight = 1.0);
+
+  /// @}
+  // --- END ---- Filling ------------------------------------------------------
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+
+  /// Returns the binning of the axis number `iAxis`.
+  Axis_t const& axis(std::size_t iAxis) const { return fAxes[iAxis]; }
+
+  /// Returns the total number of bins, including underflow and overflow.
+  std::size_t nCells() const { return fNCells; }
+
+  /// Returns the content (sum of weights) of the global bin `bin`.
+  double binContent(std::size_t bin) const
+    { return fContent[bin].load(std::memory_order_relaxed); }
+
+  /// Returns the sum of the squares of the weights in the global bin `bin`.
+  double binSumw2(std::size_t bin) const
+    { return fSumw2[bin].load(std::memory_order_relaxed); }
+
+  /// Returns the number of fill operations.
+  unsigned long long entries() const
+    { return fEntries.load(std::memory_order_relaxed); }
+
+  /// Returns whether any entry was filled with a weight different than `1`.
+  bool weighted() const { return fWeighted.load(std::memory_order_relaxed); }
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+
+  // --- BEGIN -- Transfer and reset (not thread-safe) -------------------------
+  /// @name Transfer and reset (not thread-safe)
+  /// @{
+
+  /// Removes all the content.
+  void reset();
+
+  /**
+   * @brief Adds the content into a ROOT histogram, and removes it from here.
+   * @tparam Hist type of ROOT histogram (`TH1` interface)
+   * @param hist the histogram
+   *
+   * The histogram `hist` must have the same binning as this object.
+   * Its existing content is preserved.
+   */
+  template <typename Hist>
+  void transferTo(Hist& hist);
+
+  /// @}
+  // --- END ---- Transfer and reset (not thread-safe) -------------------------
+
+
+    private:
+
+  using Counter_t = std::atomic<double>; ///< Type of counter of bin content.
+
+  std::array<Axis_t, NDims> fAxes; ///< Binning of the axes.
+
+  std::size_t fNCells; ///< Number of bins, including underflow and overflow.
+
+  std::unique_ptr<Counter_t[]> fContent; ///< Sum of weights in each bin.
+
+  std::unique_ptr<Counter_t[]> fSumw2; ///< Sum of squared weights in each bin.
+
+  std::atomic<unsigned long long> fEntries { 0U }; ///< Number of entries.
+
+  std::atomic<bool> fWeighted { false }; ///< Whether weights were used.
+
+
+  /// Adds `value` to the atomic `counter`.
+  static void atomicAdd(Counter_t& counter, double value)
+    {
+      double old = counter.load(std::memory_order_relaxed);
+      while (!counter.compare_exchange_weak
+        (old, old + value, std::memory_order_relaxed)
+        )
+        {}
+    }
+
+}; // icarus::ns::util::AtomicHistogram
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <std::size_t NDims>
+icarus::ns::util::AtomicHistogram<NDims>::AtomicHistogram
+  (std::array<Axis_t, NDims> axes)
+  : fAxes{ axes }
+  , fNCells{ 1U }
+{
+  for (Axis_t const& axis: fAxes) fNCells *= axis.nBins + 2U;
+  fContent.reset(new Counter_t[fNCells]);
+  fSumw2.reset(new Counter_t[fNCells]);
+  reset();
+} // icarus::ns::util::AtomicHistogram<>::AtomicHistogram()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t NDims>
+void icarus::ns::util::AtomicHistogram<NDims>::fillBin
+  (std::size_t bin, double weight /* = 1.0 */)
+{
+  atomicAdd(fContent[bin], weight);
+  atomicAdd(fSumw2[bin], weight * weight);
+  fEntries.fetch_add(1U, std::memory_order_relaxed);
+  if ((weight != 1.0) && !weighted())
+    fWeighted.store(true, std::memory_order_relaxed);
+} // icarus::ns::util::AtomicHistogram<>::fillBin()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t NDims>
+void icarus::ns::util::AtomicHistogram<NDims>::reset() {
+
+  for (std::size_t bin = 0U; bin < fNCells; ++bin) {
+    fContent[bin].store(0.0, std::memory_order_relaxed);
+    fSumw2[bin].store(0.0, std::memory_order_relaxed);
+  }
+  fEntries.store(0U, std::memory_order_relaxed);
+  fWeighted.store(false, std::memory_order_relaxed);
+
+} // icarus::ns::util::AtomicHistogram<>::reset()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t NDims>
+template <typename Hist>
+void icarus::ns::util::AtomicHistogram<NDims>::transferTo(Hist& hist) {
+
+  double const entries = hist.GetEntries() + this->entries();
+
+  // with unit weights ROOT does not need the sum of squares, unless asked to
+  if (weighted() && (hist.GetSumw2N() == 0)) hist.Sumw2();
+  bool const hasSumw2 = hist.GetSumw2N() > 0;
+
+  for (std::size_t bin = 0U; bin < fNCells; ++bin) {
+    double const sumw2 = binSumw2(bin);
+    if (sumw2 == 0.0) continue; // no entry at all
+    hist.AddBinContent(bin, binContent(bin));
+    if (hasSumw2) (*hist.GetSumw2())[bin] += sumw2;
+  } // for
+
+  hist.ResetStats(); // statistics from the bin content...
+  hist.SetEntries(entries); // ... but the actual number of entries
+
+  reset();
+
+} // icarus::ns::util::AtomicHistogram<>::transferTo()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_ATOMICHISTOGRAM_H
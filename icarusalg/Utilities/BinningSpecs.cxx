@@ -14,6 +14,7 @@
 // C/C++ standard libraries
 #include <utility> // std::move(), std::pair
 #include <cmath>
+#include <cstddef> // std::size_t
 #include <cassert>
 
 
@@ -59,6 +60,27 @@ int icarus::ns::util::BinningSpecs::binWith(double value) const
   { return static_cast<int>(std::floor((value - lower()) / binWidth())); }
 
 
+// -----------------------------------------------------------------------------
+void icarus::ns::util::BinningSpecs::binIndices
+  (gsl::span<double const> values, gsl::span<int> indices) const
+{
+  assert(indices.size() >= values.size());
+  
+  double const offset = lower();
+  double const invWidth = 1.0 / binWidth();
+  double const* const value = values.data();
+  int* const index = indices.data();
+  std::size_t const n = values.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    // floor via truncation: unlike `std::floor()` to `int`, it is vectorized
+    double const r = (value[i] - offset) * invWidth;
+    int const t = static_cast<int>(r);
+    index[i] = t - (r < t);
+  } // for
+  
+} // icarus::ns::util::BinningSpecs::binIndices()
+
+
 // -----------------------------------------------------------------------------
 std::pair<double, double> icarus::ns::util::BinningSpecs::binBorders
   (int iBin) const
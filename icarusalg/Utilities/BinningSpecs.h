@@ -11,6 +11,9 @@
 #define ICARUSALG_UTILITIES_BINNINGSPECS_H
 
 
+// C++ core guideline library
+#include "gsl/span"
+
 // C/C++ standard libraries
 #include <initializer_list>
 #include <utility> // std::pair
@@ -212,6 +215,20 @@ class icarus::ns::util::BinningSpecs {
   /// (bin of `lower()` is `0`, bin of `upper()` is `nBins()`).
   int binWith(double value) const;
   
+  /**
+   * @brief Stores in `indices` the index of the bin of each of the `values`.
+   * @param values the values to be binned
+   * @param indices the span where to store the bin indices (as large as
+   *                `values`)
+   * @see `binWith()`
+   * 
+   * The bin indices are defined as in `binWith()`, but they are computed in a
+   * simple loop with the reciprocal of the bin width, which the compiler can
+   * vectorize. For values within rounding error from a bin boundary, the
+   * result may differ from the one of `binWith()`.
+   */
+  void binIndices(gsl::span<double const> values, gsl::span<int> indices) const;
+  
   /// Returns the lower and upper borders of the bin with the specified index.
   std::pair<double, double> binBorders(int iBin) const;
   
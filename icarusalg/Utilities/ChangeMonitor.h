@@ -11,13 +11,45 @@
 
 // C/C++ standard libraries
 #include <mutex>
+#include <atomic>
 #include <optional>
 #include <utility> // std::move()
 #include <functional> // std::equal_to<>
+#include <type_traits> // std::is_trivially_copyable_v, std::enable_if_t
+#include <cstring> // std::memcpy()
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 
 namespace icarus::ns::util {
   
+  namespace details {
+    
+    /// Whether `ThreadSafeChangeMonitor` can avoid locks for `T`.
+    template <typename T>
+    constexpr bool isLockFreeMonitorable
+      = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+    
+    /// Whether `std::atomic<T>` is lock-free (`false` if it is not valid).
+    template <typename T>
+    constexpr bool isAlwaysLockFreeAtomic() {
+      if constexpr (isLockFreeMonitorable<T>)
+        return std::atomic<T>::is_always_lock_free;
+      else return false;
+    } // isAlwaysLockFreeAtomic()
+    
+    /// Whether `ThreadSafeChangeMonitor` can use a single atomic for `T`.
+    template <typename T>
+    constexpr bool isAtomicMonitorable = isAlwaysLockFreeAtomic<T>();
+    
+    /// Whether `ThreadSafeChangeMonitor` can use a sequence lock for `T`.
+    template <typename T>
+    constexpr bool isSeqLockMonitorable
+      = isLockFreeMonitorable<T> && !isAtomicMonitorable<T>;
+    
+  } // namespace details
+  
+  
   //----------------------------------------------------------------------------
   /**
    * @brief Helper to check if an object has changed.
@@ -153,12 +185,27 @@ namespace icarus::ns::util {
    * This class operates like `ChangeMonitor`, but it is made thread-safe by
    * the use of a mutex.
    * 
+   * For trivially copyable and default-constructible types, specializations
+   * which never take a lock are used instead:
+   * * values whose `std::atomic` is always lock-free (usually up to 8 bytes)
+   *   are kept in a single `std::atomic`, and `update()` replaces them with a
+   *   compare-and-exchange loop;
+   * * all other values are protected by a sequence lock ("seqlock"): readers
+   *   retry on a concurrent update instead of waiting for a mutex, and
+   *   `update()` calls only contend with each other.
+   * In both cases `reference()` returns a copy of the value rather than a
+   * reference, and the comparison `Comp` is evaluated on a snapshot of the
+   * reference value: when concurrent `update()` calls race, each of them
+   * reports the change from the value it actually replaced.
+   * 
    * @note This class is actually only _partially_ thread-safe:
    *       the member `reference()` is effectively not, since it returns a
    *       reference that can be then modified by another thread while accessed
-   *       (read only) by another.
+   *       (read only) by another. The lock-free specializations do not have
+   *       this limitation.
    */
-  template <typename T, typename Comp = std::equal_to<T>>
+  template
+    <typename T, typename Comp = std::equal_to<T>, typename = void>
   class ThreadSafeChangeMonitor: public ChangeMonitor<T, Comp> {
     
     using Base_t = ChangeMonitor<T, Comp>;
@@ -200,6 +247,191 @@ namespace icarus::ns::util {
   }; // ThreadSafeChangeMonitor
   
   
+  // ---------------------------------------------------------------------------
+  /// `ThreadSafeChangeMonitor` on values with a lock-free `std::atomic`.
+  template <typename T, typename Comp>
+  class ThreadSafeChangeMonitor
+    <T, Comp, std::enable_if_t<details::isAtomicMonitorable<T>>>
+  {
+    
+    /// State of the reference value.
+    enum class State_t: unsigned char { NoReference, Setting, Ready };
+    
+      public:
+    using Data_t = T; ///< Type of the object being monitored.
+    using Comparison_t = Comp; ///< Type of object for reference comparison.
+    
+    /// Default constructor: starts with no reference value.
+    ThreadSafeChangeMonitor(Comparison_t comp = Comparison_t{})
+      : fComp(std::move(comp)) {}
+    
+    /// Constructor: starts with `ref` as the reference value.
+    ThreadSafeChangeMonitor(Data_t const& ref, Comp comp = Comp{})
+      : fRefObj(ref), fState(State_t::Ready), fComp(std::move(comp)) {}
+    
+    
+    /// Returns the old object if different from `currentObj` (lock-free).
+    /// @see `ChangeMonitor::update()`
+    std::optional<Data_t> update(Data_t const& currentObj)
+      {
+        if (State_t state = fState.load(std::memory_order_acquire);
+          state != State_t::Ready
+        ) {
+          // first update ever: only one thread sets the reference...
+          if ((state == State_t::NoReference)
+            && fState.compare_exchange_strong(state, State_t::Setting))
+          {
+            fRefObj.store(currentObj, std::memory_order_relaxed);
+            fState.store(State_t::Ready, std::memory_order_release);
+            return {};
+          }
+          // ... and the others wait for it to be there
+          while (fState.load(std::memory_order_acquire) != State_t::Ready);
+        }
+        
+        Data_t refObj = fRefObj.load(std::memory_order_acquire);
+        do {
+          if (same(currentObj, refObj)) return {};
+        } while (!fRefObj.compare_exchange_weak(refObj, currentObj,
+          std::memory_order_acq_rel, std::memory_order_acquire));
+        return refObj;
+      }
+    
+    /// As `update()`.
+    std::optional<Data_t> operator() (Data_t const& currentObj)
+      { return update(currentObj); }
+    
+    /// Returns whether a reference value is present.
+    bool hasReference() const
+      { return fState.load(std::memory_order_acquire) != State_t::NoReference; }
+    
+    /// Returns a copy of the reference value; undefined if `hasReference()` is
+    /// `false`.
+    Data_t reference() const { return fRefObj.load(std::memory_order_acquire); }
+    
+      private:
+    
+    std::atomic<Data_t> fRefObj {}; ///< The last object seen.
+    
+    /// Whether `fRefObj` holds a reference value.
+    std::atomic<State_t> fState { State_t::NoReference };
+    
+    Comparison_t fComp; ///< Comparison used for reference testing.
+    
+    /// Returns whether `A` and `B` represent the same value.
+    bool same(Data_t const& A, Data_t const& B) const { return fComp(A, B); }
+    
+  }; // ThreadSafeChangeMonitor<atomic>
+  
+  
+  // ---------------------------------------------------------------------------
+  /// `ThreadSafeChangeMonitor` on other trivially copyable values: seqlock.
+  template <typename T, typename Comp>
+  class ThreadSafeChangeMonitor
+    <T, Comp, std::enable_if_t<details::isSeqLockMonitorable<T>>>
+  {
+    
+    using Word_t = std::uint64_t; ///< Unit of storage of the value.
+    
+    /// Number of words needed to store the value.
+    static constexpr std::size_t NWords
+      = (sizeof(T) + sizeof(Word_t) - 1) / sizeof(Word_t);
+    
+    /// Type of the sequence counter: odd while writing, `0` if no reference.
+    using Sequence_t = std::uint64_t;
+    
+      public:
+    using Data_t = T; ///< Type of the object being monitored.
+    using Comparison_t = Comp; ///< Type of object for reference comparison.
+    
+    /// Default constructor: starts with no reference value.
+    ThreadSafeChangeMonitor(Comparison_t comp = Comparison_t{})
+      : fComp(std::move(comp)) {}
+    
+    /// Constructor: starts with `ref` as the reference value.
+    ThreadSafeChangeMonitor(Data_t const& ref, Comp comp = Comp{})
+      : fSequence(2U), fComp(std::move(comp)) { storeValue(ref); }
+    
+    
+    /// Returns the old object if different from `currentObj`.
+    /// @see `ChangeMonitor::update()`
+    std::optional<Data_t> update(Data_t const& currentObj)
+      {
+        while (true) {
+          Sequence_t seq;
+          Data_t const refObj = readConsistent(seq);
+          bool const hasRef = (seq != 0U);
+          if (hasRef && same(currentObj, refObj)) return {};
+          
+          // claim the writing; if anybody else wrote meanwhile, start over
+          if (!fSequence.compare_exchange_weak(seq, seq + 1U,
+            std::memory_order_acquire, std::memory_order_relaxed)
+          ) {
+            continue;
+          }
+          std::atomic_thread_fence(std::memory_order_release);
+          storeValue(currentObj);
+          fSequence.store(seq + 2U, std::memory_order_release);
+          
+          if (!hasRef) return {};
+          return refObj;
+        } // while
+      }
+    
+    /// As `update()`.
+    std::optional<Data_t> operator() (Data_t const& currentObj)
+      { return update(currentObj); }
+    
+    /// Returns whether a reference value is present.
+    bool hasReference() const
+      { return fSequence.load(std::memory_order_acquire) != 0U; }
+    
+    /// Returns a copy of the reference value; undefined if `hasReference()` is
+    /// `false`.
+    Data_t reference() const { Sequence_t seq; return readConsistent(seq); }
+    
+      private:
+    
+    /// Sequence counter, incremented at the start and at the end of writing.
+    std::atomic<Sequence_t> fSequence { 0U };
+    
+    std::atomic<Word_t> fWords[NWords] {}; ///< The last object seen.
+    
+    Comparison_t fComp; ///< Comparison used for reference testing.
+    
+    /// Returns whether `A` and `B` represent the same value.
+    bool same(Data_t const& A, Data_t const& B) const { return fComp(A, B); }
+    
+    /// Copies `value` into the storage words (caller holds the sequence).
+    void storeValue(Data_t const& value)
+      {
+        Word_t words[NWords] = {};
+        std::memcpy(words, &value, sizeof(Data_t));
+        for (std::size_t i = 0; i < NWords; ++i)
+          fWords[i].store(words[i], std::memory_order_relaxed);
+      }
+    
+    /// Returns a value not being written, and its sequence number in `seq`.
+    Data_t readConsistent(Sequence_t& seq) const
+      {
+        Word_t words[NWords];
+        do {
+          seq = fSequence.load(std::memory_order_acquire);
+          if (seq & 1U) continue; // being written: try again
+          for (std::size_t i = 0; i < NWords; ++i)
+            words[i] = fWords[i].load(std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (fSequence.load(std::memory_order_relaxed) == seq) break;
+        } while (true);
+        
+        Data_t value;
+        std::memcpy(&value, words, sizeof(Data_t));
+        return value;
+      }
+    
+  }; // ThreadSafeChangeMonitor<seqlock>
+  
+  
   // Deduction guide: a single parameter is always a reference value.
   template <typename T>
   ThreadSafeChangeMonitor(T const&) -> ThreadSafeChangeMonitor<T>;
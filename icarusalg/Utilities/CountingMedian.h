@@ -0,0 +1,297 @@
+/**
+ * @file icarusalg/Utilities/CountingMedian.h
+ * @brief Class computing medians of integral data by counting.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 14, 2026
+ * 
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_UTILITIES_COUNTINGMEDIAN_H
+#define ICARUSALG_UTILITIES_COUNTINGMEDIAN_H
+
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy(), std::fill(), std::min(), std::max()
+#include <vector>
+#include <type_traits> // std::is_integral_v
+#include <utility> // std::move()
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+  
+  template <typename T, typename C = unsigned int> class CountingMedian;
+  
+} // namespace icarus::ns::util
+
+/**
+ * @brief Exact median of integral values, from their counts.
+ * @param T type of data (integral)
+ * @param C (default: `unsigned int`) data type for the count of each value
+ * 
+ * This object counts how many times each value is `add()`-ed, in a histogram
+ * with one bin per value, and extracts the median (or any other order
+ * statistic) from the counts.
+ * Both operations take a time linear in the number of data values, plus the
+ * spread of their values; the data itself is not copied nor reordered.
+ * This is convenient when the values are packed in a narrow range, like the
+ * ADC counts around a baseline.
+ * 
+ * The median is defined as by `std::nth_element()` on the element in the
+ * middle: for `N` values, it is the value which would be at position `N/2`
+ * (starting from `0`) after sorting them.
+ * 
+ * The storage of the counts grows to cover the range of the added values, and
+ * it is kept after `clear()`, so that an object reused for many data sets of
+ * similar spread stops allocating memory after the first few.
+ * Clearing takes a time proportional to the spread of the values.
+ * 
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::CountingMedian<raw::ADC_Count_t> medianCounter;
+ * for (raw::OpDetWaveform const& waveform: waveforms) {
+ *   raw::ADC_Count_t const median
+ *     = medianCounter.median(waveform.begin(), waveform.end());
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename T, typename C /* = unsigned int */>
+class icarus::ns::util::CountingMedian {
+  
+  static_assert(std::is_integral_v<T>, "CountingMedian requires integral data");
+  
+    public:
+  
+  using Data_t = T; ///< Type of data.
+  
+  using Count_t = C; ///< Type of the count of each value.
+  
+  
+  // --- BEGIN -- Content modification -----------------------------------------
+  /// @name Content modification
+  /// @{
+  
+  /// Adds one occurrence of `value`.
+  void add(Data_t value);
+  
+  /// Adds all the values in the range from `begin` to `end`.
+  template <typename BIter, typename EIter>
+  void add(BIter begin, EIter end);
+  
+  /// Removes all the values (allocated memory is kept).
+  void clear() noexcept;
+  
+  /// @}
+  // --- END ---- Content modification -----------------------------------------
+  
+  
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query interface
+  /// @{
+  
+  /// Returns the number of added values.
+  std::size_t size() const noexcept { return fN; }
+  
+  /// Returns whether no value has been added.
+  bool empty() const noexcept { return fN == 0U; }
+  
+  /// Returns the lowest added value. Undefined if `empty()`.
+  Data_t min() const noexcept { return fMin; }
+  
+  /// Returns the highest added value. Undefined if `empty()`.
+  Data_t max() const noexcept { return fMax; }
+  
+  /// Returns how many times `value` was added.
+  Count_t count(Data_t value) const noexcept;
+  
+  /**
+   * @brief Returns the value at position `n` in the sorted data.
+   * @param n the position in the data, `0` being the lowest value
+   * @return the value at position `n` (`max()` if `n` is too large)
+   * 
+   * Undefined if `empty()`.
+   */
+  Data_t nth(std::size_t n) const noexcept;
+  
+  /// Returns the median of the added values. Undefined if `empty()`.
+  Data_t median() const noexcept { return nth(size() / 2); }
+  
+  /// @}
+  // --- END ---- Query --------------------------------------------------------
+  
+  
+  /**
+   * @brief Returns the median of the values in the range.
+   * @param begin iterator to the first value
+   * @param end iterator past the last value
+   * @return the median of the values in the range
+   * 
+   * The previous content is cleared and replaced by the values in the range.
+   * The range must not be empty.
+   */
+  template <typename BIter, typename EIter>
+  Data_t median(BIter begin, EIter end);
+  
+  
+    private:
+  
+  using Storage_t = std::vector<Count_t>; ///< Type of storage for counts.
+  
+  /// Number of bins allocated at the first value.
+  static constexpr std::size_t InitialBins = 256U;
+  
+  Storage_t fCounters; ///< Count of each value, starting from `fOffset`.
+  std::ptrdiff_t fOffset = 0; ///< Value counted in `fCounters[0]`.
+  std::size_t fN = 0U; ///< Number of added values.
+  Data_t fMin = 0; ///< Lowest added value.
+  Data_t fMax = 0; ///< Highest added value.
+  
+  /// Returns whether `value` has a counter.
+  bool hasCounter(Data_t value) const noexcept;
+  
+  /// Returns the storage index of the counter of `value`.
+  std::size_t storageIndex(Data_t value) const noexcept
+    { return static_cast<std::size_t>(value - fOffset); }
+  
+  /// Relocates the counters so that `value` has one too.
+  void extendTo(Data_t value);
+  
+}; // icarus::ns::util::CountingMedian
+
+
+/* -----------------------------------------------------------------------------
+ * --- template implementation
+ * -----------------------------------------------------------------------------
+ * 
+ * Implementation details
+ * -----------------------
+ * 
+ * Counters between `fMin` and `fMax` (included) are the only ones that may be
+ * non-zero. The window of counters is centered on the first value added when
+ * empty, and when a value falls outside it, it is reallocated with at least
+ * twice the spread of the values, centered on them.
+ * 
+ */
+template <typename T, typename C /* = unsigned int */>
+void icarus::ns::util::CountingMedian<T, C>::add(Data_t value) {
+  
+  if (empty()) {
+    if (fCounters.empty()) fCounters.resize(InitialBins, Count_t{ 0 });
+    fOffset = static_cast<std::ptrdiff_t>(value)
+      - static_cast<std::ptrdiff_t>(fCounters.size() / 2);
+    fMin = fMax = value;
+  }
+  else if (!hasCounter(value)) extendTo(value);
+  
+  ++fCounters[storageIndex(value)];
+  ++fN;
+  if (value < fMin) fMin = value;
+  else if (value > fMax) fMax = value;
+  
+} // icarus::ns::util::CountingMedian<>::add()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+template <typename BIter, typename EIter>
+void icarus::ns::util::CountingMedian<T, C>::add(BIter begin, EIter end)
+  { for (auto it = begin; it != end; ++it) add(*it); }
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+void icarus::ns::util::CountingMedian<T, C>::clear() noexcept {
+  
+  if (!empty()) {
+    std::fill(fCounters.begin() + storageIndex(fMin),
+      fCounters.begin() + storageIndex(fMax) + 1, Count_t{ 0 });
+  }
+  fN = 0U;
+  
+} // icarus::ns::util::CountingMedian<>::clear()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+auto icarus::ns::util::CountingMedian<T, C>::count
+  (Data_t value) const noexcept -> Count_t
+{
+  return (!empty() && (value >= fMin) && (value <= fMax))
+    ? fCounters[storageIndex(value)]: Count_t{ 0 };
+} // icarus::ns::util::CountingMedian<>::count()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+auto icarus::ns::util::CountingMedian<T, C>::nth
+  (std::size_t n) const noexcept -> Data_t
+{
+  assert(!empty());
+  
+  std::size_t cumulative = 0U;
+  auto it = fCounters.begin() + storageIndex(fMin);
+  for (Data_t value = fMin; value < fMax; ++value) {
+    cumulative += *(it++);
+    if (cumulative > n) return value;
+  }
+  return fMax;
+  
+} // icarus::ns::util::CountingMedian<>::nth()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+template <typename BIter, typename EIter>
+auto icarus::ns::util::CountingMedian<T, C>::median(BIter begin, EIter end)
+  -> Data_t
+{
+  clear();
+  add(begin, end);
+  return median();
+} // icarus::ns::util::CountingMedian<>::median(BIter, EIter)
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+bool icarus::ns::util::CountingMedian<T, C>::hasCounter
+  (Data_t value) const noexcept
+{
+  std::ptrdiff_t const index = static_cast<std::ptrdiff_t>(value) - fOffset;
+  return (index >= 0) && (static_cast<std::size_t>(index) < fCounters.size());
+} // icarus::ns::util::CountingMedian<>::hasCounter()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+void icarus::ns::util::CountingMedian<T, C>::extendTo(Data_t value) {
+  assert(!empty());
+  
+  std::ptrdiff_t const lower = std::min(fMin, value);
+  std::ptrdiff_t const upper = std::max(fMax, value);
+  std::size_t const span = static_cast<std::size_t>(upper - lower + 1);
+  
+  // leave room for a further spread of the same size
+  std::size_t newSize = fCounters.size();
+  while (newSize < 2 * span) newSize *= 2;
+  std::ptrdiff_t const newOffset
+    = lower - static_cast<std::ptrdiff_t>((newSize - span) / 2);
+  
+  Storage_t counters(newSize, Count_t{ 0 });
+  std::copy(
+    fCounters.begin() + storageIndex(fMin),
+    fCounters.begin() + storageIndex(fMax) + 1,
+    counters.begin() + (fMin - newOffset)
+    );
+  fCounters = std::move(counters);
+  fOffset = newOffset;
+  
+} // icarus::ns::util::CountingMedian<>::extendTo()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_COUNTINGMEDIAN_H
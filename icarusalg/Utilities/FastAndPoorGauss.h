@@ -12,6 +12,14 @@
 
 // C/C++ standard library
 #include <array>
+#include <map>
+#include <memory> // std::shared_ptr, std::weak_ptr
+#include <mutex>
+#include <new> // std::align_val_t
+#include <stdexcept> // std::invalid_argument
+#include <string>
+#include <iterator> // std::begin(), std::size()
+#include <utility> // std::pair
 #include <type_traits> // std::is_integral_v, std::is_signed_v
 #include <cmath> // std::sqrt()
 #include <cstddef> // std::size_t
@@ -34,6 +42,83 @@ namespace util::details {
     } // isPowerOfTwo()
   
   
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Transforms all the values in `u` into `out` using a table.
+   * @param table the `N` precomputed values
+   * @param N number of elements in the table
+   * @param u the values to be transformed, in [ 0, 1 [
+   * @param out the destination of the transformed values
+   * 
+   * Both `u` and `out` are collections ("spans") with `std::begin()` and
+   * `std::size()` support, and `out` must be at least as large as `u`.
+   * The loop is kept simple, so that the compiler can vectorize it.
+   */
+  template <typename T, typename USpan, typename ZSpan>
+  void transformWithTable
+    (T const* table, std::size_t N, USpan const& u, ZSpan&& out)
+    {
+      std::size_t const n = std::size(u);
+      auto const uBegin = std::begin(u);
+      auto const zBegin = std::begin(out);
+      for (std::size_t i = 0; i < n; ++i)
+        zBegin[i] = table[static_cast<std::size_t>(uBegin[i] * N)];
+    } // transformWithTable()
+  
+  
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Mathematical functions usable at compile time.
+   * 
+   * These implementations are simple and slow, and good enough to fill
+   * small tables at compilation time.
+   */
+  namespace constexpr_math {
+    
+    /// Returns @f$ e^{x} @f$ (range reduction, then Taylor series).
+    constexpr double exp(double x)
+      {
+        if (x < 0.0) return 1.0 / exp(-x);
+        unsigned int nHalvings = 0U;
+        while (x > 0.5) { x /= 2.0; ++nHalvings; }
+        double term = 1.0, sum = 1.0;
+        for (unsigned int n = 1U; n < 20U; ++n) { term *= x / n; sum += term; }
+        while (nHalvings-- > 0U) sum *= sum;
+        return sum;
+      } // exp()
+    
+    /// Returns `erf(x)` for `x >= 0`, and its derivative.
+    constexpr std::pair<double, double> erfAndDerivative(double x)
+      {
+        // series with positive terms only:
+        // erf(x) = 2/sqrt(pi) e^(-x^2) sum_n 2^n x^(2n+1) / (2n+1)!!
+        constexpr double TwoOverSqrtPi = 1.1283791670955126;
+        double const x2 = x * x;
+        double term = x, sum = x;
+        for (unsigned int n = 1U; term > 1e-17 * sum; ++n) {
+          term *= 2.0 * x2 / (2 * n + 1);
+          sum += term;
+        }
+        double const derivative = TwoOverSqrtPi * exp(-x2);
+        return { sum * derivative, derivative };
+      } // erfAndDerivative()
+    
+    /// Returns `x` so that `erf(x) = y` (`y >= 0`), starting from `x0`.
+    constexpr double erfInverse(double y, double x0 = 0.0)
+      {
+        double x = x0;
+        for (unsigned int i = 0; i < 100U; ++i) { // Newton method
+          auto const [ erf, derivative ] = erfAndDerivative(x);
+          double const dx = (erf - y) / derivative;
+          x -= dx;
+          if (((dx < 0.0)? -dx: dx) <= 1e-15 * ((x > 1.0)? x: 1.0)) break;
+        }
+        return x;
+      } // erfInverse()
+    
+  } // namespace constexpr_math
+  
+  
   // ---------------------------------------------------------------------------
   
   
@@ -45,6 +130,12 @@ namespace util {
   template <std::size_t N, typename T>
   class FastAndPoorGauss;
   
+  template <std::size_t N, typename T>
+  class StaticFastAndPoorGauss;
+  
+  template <typename T>
+  class DynamicFastAndPoorGauss;
+  
   template <typename T>
   class GaussianTransformer;
   
@@ -82,12 +173,37 @@ namespace util {
  * `sizeof(T) * N` bytes large.
  * 
  * 
+ * Accuracy
+ * ---------
+ * 
+ * The distribution of the returned values is the one of the table, where
+ * each entry has the same probability. Some of its features, for a few
+ * table sizes (the same in single and double precision):
+ * 
+ * | `N`  | @f$ \sigma - 1 @f$ | kurtosis excess | largest @f$ |z| @f$ |
+ * | ---: | ----------------: | --------------: | ----------------: |
+ * | 2^8^  | -2.5e-3 | -8.2e-2 | 2.89 |
+ * | 2^12^ | -1.6e-4 | -8.5e-3 | 3.67 |
+ * | 2^16^ | -1.0e-5 | -7.5e-4 | 4.32 |
+ * | 2^20^ | -6.4e-7 | -6.1e-5 | 4.90 |
+ * 
+ * The mean and the skewness are 0 by construction. The standard deviation is
+ * always underestimated, mostly because the tails are truncated: no value
+ * beyond the largest @f$ |z| @f$ is ever returned. Tables with fewer than
+ * 2^14^ points return no value beyond 4 standard deviations.
+ * The full table, together with the generation speed compared to
+ * `CLHEP::RandGauss` and `std::normal_distribution`, is produced by the
+ * `fastgauss_benchmark` program in `test/Utilities`.
+ * 
+ * 
  * @note This class is tuned for performance, and it allocates its data on the
  *       stack. Stack overflows have been observed in Linux with a size of
  *       `N` 2^20^. Stack overflows are very puzzling since they do not present
  *       any standard diagnostics and debuggers may not notice them.
- *       Bottom line is: do not overdo with the number of samples, or ask the
- *       author to provide a special version using dynamic memory allocation.
+ *       Bottom line is: do not overdo with the number of samples; for large
+ *       tables, use `util::DynamicFastAndPoorGauss`, which allocates its data
+ *       dynamically. For small tables, `util::StaticFastAndPoorGauss` computes
+ *       the table at compilation time.
  * 
  */
 template <std::size_t N, typename T = double>
@@ -107,6 +223,19 @@ class util::FastAndPoorGauss {
   Data_t operator() (Data_t const u) const { return transform(u); }
   //@}
   
+  /**
+   * @brief Transforms all the values in `u`, writing them into `out`.
+   * @tparam USpan type of collection of input values (e.g. `util::span`)
+   * @tparam ZSpan type of collection of output values
+   * @param u the values to be transformed
+   * @param out the collection to write the Gaussian values into
+   * 
+   * The collection `out` must have at least as many elements as `u`.
+   */
+  template <typename USpan, typename ZSpan>
+  void transform(USpan const& u, ZSpan&& out) const
+    { details::transformWithTable(fSamples.data(), NPoints, u, out); }
+  
     private:
   /// Sampled points of inverse Gaussian.
   static std::array<Data_t, N> const fSamples;
@@ -120,6 +249,133 @@ class util::FastAndPoorGauss {
 }; // util::FastAndPoorGauss<>
 
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief Version of `util::FastAndPoorGauss` with a table computed at compile
+ *        time.
+ * @param N number of possible values returned; it *must* be a power of 2
+ * @param T (default: `double`) type of number for _u_ and _z_
+ * 
+ * This object behaves like `util::FastAndPoorGauss<N, T>`, but its table
+ * is computed by the compiler, so that no time is spent filling it when the
+ * program starts. The values differ from the ones of `util::FastAndPoorGauss`
+ * only by rounding.
+ * 
+ * Since compile time evaluation is slow, only tables with up to
+ * `MaxPoints` points are supported.
+ */
+template <std::size_t N, typename T = double>
+class util::StaticFastAndPoorGauss {
+  static_assert(
+    util::details::isPowerOfTwo(N), "Template parameter N must be a power of 2."
+    );
+  
+    public:
+  using Data_t = T; ///< Type of data to deal with.
+  
+  static constexpr std::size_t NPoints = N; ///< Number of sampled points.
+  
+  /// Maximum number of sampled points supported.
+  static constexpr std::size_t MaxPoints = 1024U;
+  
+  static_assert(N <= MaxPoints,
+    "Too many points for a table computed at compile time:"
+    " use util::FastAndPoorGauss or util::DynamicFastAndPoorGauss."
+    );
+  
+  //@{
+  /// Returns the Gaussian distributed value corresponding to `u`.
+  constexpr Data_t transform(Data_t const u) const
+    { return fSamples[static_cast<std::size_t>(u * NPoints)]; }
+  constexpr Data_t operator() (Data_t const u) const { return transform(u); }
+  //@}
+  
+  /// Transforms all the values in `u`, writing them into `out`.
+  /// @see `util::FastAndPoorGauss::transform(USpan const&, ZSpan&&) const`
+  template <typename USpan, typename ZSpan>
+  void transform(USpan const& u, ZSpan&& out) const
+    { details::transformWithTable(fSamples.data(), NPoints, u, out); }
+  
+    private:
+  
+  /// Fills the pre-sampling table.
+  static constexpr std::array<Data_t, NPoints> makeSamples();
+  
+  /// Sampled points of inverse Gaussian.
+  static constexpr std::array<Data_t, N> fSamples = makeSamples();
+  
+}; // util::StaticFastAndPoorGauss<>
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Version of `util::FastAndPoorGauss` with a table of arbitrary size.
+ * @param T (default: `double`) type of number for _u_ and _z_
+ * 
+ * This object behaves like `util::FastAndPoorGauss`, but the size of its table
+ * is chosen at run time (still a power of 2), and the table is allocated
+ * dynamically, aligned to the cache lines, allowing for finer tables.
+ * 
+ * All the objects with the same number of points share the same table, which
+ * is computed only once (the first time one of such objects is constructed)
+ * and it is released when the last object using it is destroyed.
+ * Construction is thread-safe, and the table is immutable, so that the
+ * objects can be used by multiple threads at the same time.
+ * The values are the same as the ones of `util::FastAndPoorGauss`.
+ */
+template <typename T = double>
+class util::DynamicFastAndPoorGauss {
+  
+    public:
+  using Data_t = T; ///< Type of data to deal with.
+  
+  /// Alignment of the table [bytes].
+  static constexpr std::size_t Alignment = 64U;
+  
+  /**
+   * @brief Constructor: uses a table of `nPoints` points.
+   * @param nPoints number of points of the table; must be a power of 2
+   * @throw std::invalid_argument if `nPoints` is not a power of two
+   */
+  DynamicFastAndPoorGauss(std::size_t nPoints);
+  
+  //@{
+  /// Returns the Gaussian distributed value corresponding to `u`.
+  Data_t transform(Data_t const u) const
+    { return fTable[static_cast<std::size_t>(u * fNPoints)]; }
+  Data_t operator() (Data_t const u) const { return transform(u); }
+  //@}
+  
+  /// Transforms all the values in `u`, writing them into `out`.
+  /// @see `util::FastAndPoorGauss::transform(USpan const&, ZSpan&&) const`
+  template <typename USpan, typename ZSpan>
+  void transform(USpan const& u, ZSpan&& out) const
+    { details::transformWithTable(fTable, fNPoints, u, out); }
+  
+  /// Returns the number of points in the table.
+  std::size_t nPoints() const { return fNPoints; }
+  
+  /// Returns the table of sampled points.
+  Data_t const* table() const { return fTable; }
+  
+    private:
+  using Table_t = std::shared_ptr<Data_t const>;
+  
+  std::size_t fNPoints; ///< Number of points in the table.
+  
+  Table_t fTableOwner; ///< Shared ownership of the table.
+  
+  Data_t const* fTable; ///< Sampled points of inverse Gaussian.
+  
+  /// Returns the table with `nPoints` points, creating it if needed.
+  static Table_t sharedTable(std::size_t nPoints);
+  
+  /// Returns a new table with `nPoints` points.
+  static Table_t makeTable(std::size_t nPoints);
+  
+}; // util::DynamicFastAndPoorGauss<>
+
+
 
 // -----------------------------------------------------------------------------
 /**
@@ -161,8 +417,8 @@ class util::GaussianTransformer {
   
     private:
   
-  Data_t const fMean   = Data_t{ 0.0 };
-  Data_t const fStdDev = Data_t{ 1.0 };
+  Data_t fMean   = Data_t{ 0.0 };
+  Data_t fStdDev = Data_t{ 1.0 };
   
 }; // util::GaussianTransformer<>
 
@@ -254,6 +510,98 @@ auto util::FastAndPoorGauss<N, T>::makeSamples() -> std::array<Data_t, NPoints>
 } // util::FastAndPoorGauss<>::makeSamples()
 
 
+// -----------------------------------------------------------------------------
+// ---  util::StaticFastAndPoorGauss
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename T>
+constexpr auto util::StaticFastAndPoorGauss<N, T>::makeSamples()
+  -> std::array<Data_t, NPoints>
+{
+  /*
+   * The value of the point `i` is the one with cumulative probability
+   * ( i + 1/2 ) / N, as for `util::FastAndPoorGauss`.
+   * The distribution is symmetric, and only the positive half is computed,
+   * each point starting the search from the previous one.
+   */
+  constexpr double V2 = 1.4142135623730951;
+  
+  std::array<Data_t, NPoints> samples {};
+  double x = 0.0;
+  for (std::size_t i = NPoints / 2; i < NPoints; ++i) {
+    double const y = static_cast<double>(2 * i + 1 - NPoints) / NPoints;
+    x = details::constexpr_math::erfInverse(y, x);
+    samples[i] = static_cast<Data_t>(x * V2);
+    samples[NPoints - 1 - i] = -samples[i];
+  } // for
+  
+  return samples;
+} // util::StaticFastAndPoorGauss<>::makeSamples()
+
+
+// -----------------------------------------------------------------------------
+// ---  util::DynamicFastAndPoorGauss
+// -----------------------------------------------------------------------------
+template <typename T>
+util::DynamicFastAndPoorGauss<T>::DynamicFastAndPoorGauss(std::size_t nPoints)
+  : fNPoints(nPoints)
+  , fTableOwner(sharedTable(nPoints))
+  , fTable(fTableOwner.get())
+  {}
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+auto util::DynamicFastAndPoorGauss<T>::sharedTable(std::size_t nPoints)
+  -> Table_t
+{
+  if (!util::details::isPowerOfTwo(nPoints)) {
+    throw std::invalid_argument{
+      "util::DynamicFastAndPoorGauss: number of points ("
+      + std::to_string(nPoints) + ") must be a power of 2."
+      };
+  }
+  
+  static std::mutex lock;
+  static std::map<std::size_t, std::weak_ptr<Data_t const>> tables;
+  
+  std::lock_guard lg { lock };
+  std::weak_ptr<Data_t const>& cached = tables[nPoints];
+  Table_t table = cached.lock();
+  if (!table) {
+    table = makeTable(nPoints);
+    cached = table;
+  }
+  return table;
+} // util::DynamicFastAndPoorGauss<>::sharedTable()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+auto util::DynamicFastAndPoorGauss<T>::makeTable(std::size_t nPoints)
+  -> Table_t
+{
+  static_assert(std::is_trivially_destructible_v<Data_t>);
+  
+  Data_t* const table = static_cast<Data_t*>(::operator new
+    (nPoints * sizeof(Data_t), std::align_val_t{ Alignment }));
+  Table_t owner { table, [](Data_t const* p)
+    {
+      ::operator delete(const_cast<Data_t*>(p), std::align_val_t{ Alignment });
+    }
+    };
+  
+  // same table as `util::FastAndPoorGauss::makeSamples()`
+  double const V2 = std::sqrt(2.0);
+  util::UniformSequence<Data_t> extract { static_cast<unsigned int>(nPoints) };
+  for (std::size_t i = 0; i < nPoints; ++i) {
+    table[i]
+      = static_cast<Data_t>(TMath::ErfInverse(extract() * 2.0 - 1.0) * V2);
+  }
+  
+  return owner;
+} // util::DynamicFastAndPoorGauss<>::makeTable()
+
+
 // -----------------------------------------------------------------------------
 // ---  util::UniformSequence
 // -----------------------------------------------------------------------------
@@ -0,0 +1,377 @@
+/**
+ * @file    icarusalg/Utilities/FastPoissonAndExponential.h
+ * @brief   Fast table-based Poisson and exponential random translators.
+ * @author  Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date    October 15, 2026
+ * @see     icarusalg/Utilities/FastAndPoorGauss.h
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_UTILITIES_FASTPOISSONANDEXPONENTIAL_H
+#define ICARUSALG_UTILITIES_FASTPOISSONANDEXPONENTIAL_H
+
+// ICARUS libraries
+#include "icarusalg/Utilities/FastAndPoorGauss.h" // util::UniformSequence, ...
+
+// C/C++ standard library
+#include <vector>
+#include <stdexcept> // std::invalid_argument
+#include <string>
+#include <iterator> // std::begin(), std::size()
+#include <utility> // std::move()
+#include <cmath> // std::log(), std::lgamma(), std::exp(), std::sqrt()
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace util {
+
+  template <typename T>
+  class FastExponential;
+
+  template <typename T>
+  class ExponentialTransformer;
+
+  template <typename T>
+  class FastPoisson;
+
+} // namespace util
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Translates a number _u_ uniformly distributed between 0 and 1
+ *        into an exponentially distributed one _t_.
+ * @param T (default: `double`) type of number for _u_ and _t_
+ *
+ * This is the exponential sibling of `util::DynamicFastAndPoorGauss`:
+ * the mapping of @f$ u \in [ 0, +1 [ @f$ into a real number is a step
+ * function with `nPoints()` steps, each step with the value of the inverse of
+ * the cumulative distribution at the center of the step.
+ * The returned number _t_ is distributed according to an exponential
+ * distribution with mean (and slope) 1; it can be turned into one with an
+ * arbitrary mean with the transformation @f$ x = \tau t @f$
+ * (see `util::ExponentialTransformer`).
+ *
+ * The largest value returned is @f$ \log(2 N) @f$: the tail of the
+ * distribution beyond that is missing, which for `N` 2^16^ amounts to
+ * a fraction of about @f$ 10^{-5} @f$ of the values.
+ *
+ * Math is internally performed in `T` precision, except for the initialization
+ * that is performed in double precision. The table is `sizeof(T) * N` bytes
+ * large, allocated on the heap.
+ */
+template <typename T = double>
+class util::FastExponential {
+
+    public:
+  using Data_t = T; ///< Type of data to deal with.
+
+  /**
+   * @brief Constructor: uses a table of `nPoints` points.
+   * @param nPoints number of points of the table; must be a power of 2
+   * @throw std::invalid_argument if `nPoints` is not a power of two
+   */
+  FastExponential(std::size_t nPoints);
+
+  //@{
+  /// Returns the exponentially distributed value corresponding to `u`.
+  Data_t transform(Data_t const u) const
+    { return fTable[static_cast<std::size_t>(u * nPoints())]; }
+  Data_t operator() (Data_t const u) const { return transform(u); }
+  //@}
+
+  /// Transforms all the values in `u`, writing them into `out`.
+  /// @see `util::FastAndPoorGauss::transform(USpan const&, ZSpan&&) const`
+  template <typename USpan, typename ZSpan>
+  void transform(USpan const& u, ZSpan&& out) const
+    { details::transformWithTable(fTable.data(), nPoints(), u, out); }
+
+  /// Returns the number of points in the table.
+  std::size_t nPoints() const { return fTable.size(); }
+
+    private:
+
+  std::vector<Data_t> fTable; ///< Sampled points of inverse cumulative.
+
+}; // util::FastExponential<>
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Transforms a standard exponential number into one with a different
+ *        mean.
+ * @tparam T type of the data
+ *
+ * This functor scales an exponentially distributed variable with mean 1 into
+ * one with arbitrary mean @f$ \tau @f$: @f$ x = \tau t @f$.
+ * It is the exponential sibling of `util::GaussianTransformer`.
+ */
+template <typename T>
+class util::ExponentialTransformer {
+
+    public:
+  using Data_t = T; ///< Type of data to deal with.
+
+  /// Constructor: selects the mean.
+  ExponentialTransformer(T mean): fMean(mean) {}
+
+  //@{
+  /// Transforms exponential value `t` into the target distribution.
+  Data_t transform(Data_t const t) const { return transform(t, mean()); }
+  Data_t operator() (Data_t const t) const { return transform(t); }
+  //@}
+
+  /// Returns the mean of the target exponential distribution.
+  Data_t mean() const { return fMean; }
+
+  /// Transforms exponential value `t` into one distributed with `mean`.
+  static Data_t transform(Data_t const t, Data_t const mean)
+    { return t * mean; }
+
+    private:
+
+  Data_t fMean = Data_t{ 1.0 };
+
+}; // util::ExponentialTransformer<>
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Translates a number _u_ uniformly distributed between 0 and 1
+ *        into a Poisson distributed count.
+ * @param T (default: `double`) type of number for _u_
+ *
+ * The distribution of the counts is tabulated at construction with the alias
+ * method (Walker, Vose): the possible counts are arranged in a table with one
+ * entry per count, each entry holding a probability and an alternative
+ * ("alias") count. A single uniform number _u_ selects both the entry (its
+ * integral part after scaling by the table size) and whether to return the
+ * count of the entry or its alias (its fractional part).
+ * The extraction takes constant time, independent of the mean, with one
+ * table lookup and one comparison and no loop, so that the batch
+ * `transform()` can be vectorized by the compiler.
+ *
+ * Counts with a probability smaller than `tailProbability` at the extremes of
+ * the distribution are not included; the mean must not exceed `maxMean`
+ * (by default `DefaultMaxMean`), since the size of the table grows with the
+ * mean. For larger means, a Gaussian approximation (e.g. via
+ * `util::FastAndPoorGauss`) is usually adequate.
+ *
+ * The precision of the selection is limited by the precision of `T`: with
+ * `float`, tables longer than a few hundred entries lose resolution in the
+ * alias choice.
+ */
+template <typename T = double>
+class util::FastPoisson {
+
+    public:
+  using Data_t = T; ///< Type of the uniform input.
+
+  using Count_t = std::uint32_t; ///< Type of the returned count.
+
+  /// Largest mean supported by default.
+  static constexpr double DefaultMaxMean = 1000.0;
+
+  /// Default probability of the counts excluded from each tail.
+  static constexpr double DefaultTailProbability = 1e-10;
+
+  /**
+   * @brief Constructor: tabulates the Poisson distribution with `mean`.
+   * @param mean the mean of the distribution
+   * @param maxMean (default: `DefaultMaxMean`) the largest mean allowed
+   * @param tailProbability (default: `DefaultTailProbability`) counts with
+   *                        smaller probability in the tails are not included
+   * @throw std::invalid_argument if mean is negative or larger than `maxMean`
+   */
+  FastPoisson(
+    double mean, double maxMean = DefaultMaxMean,
+    double tailProbability = DefaultTailProbability
+    );
+
+  //@{
+  /// Returns the Poisson distributed count corresponding to `u`.
+  Count_t transform(Data_t const u) const
+    {
+      Data_t const scaled = u * fProbs.size();
+      std::size_t const i = static_cast<std::size_t>(scaled);
+      return (scaled - static_cast<Data_t>(i) < fProbs[i])
+        ? static_cast<Count_t>(fMin + i): fAlias[i];
+    }
+  Count_t operator() (Data_t const u) const { return transform(u); }
+  //@}
+
+  /**
+   * @brief Transforms all the values in `u`, writing them into `out`.
+   * @tparam USpan type of collection of input values (e.g. `util::span`)
+   * @tparam NSpan type of collection of output counts
+   * @param u the values to be transformed
+   * @param out the collection to write the counts into
+   *
+   * The collection `out` must have at least as many elements as `u`.
+   */
+  template <typename USpan, typename NSpan>
+  void transform(USpan const& u, NSpan&& out) const;
+
+  /// Returns the mean of the distribution.
+  double mean() const { return fMean; }
+
+  /// Returns the smallest count that can be returned.
+  Count_t minCount() const { return fMin; }
+
+  /// Returns the largest count that can be returned.
+  Count_t maxCount() const { return fMin + fProbs.size() - 1; }
+
+  /// Returns the number of entries in the table.
+  std::size_t nPoints() const { return fProbs.size(); }
+
+    private:
+
+  double fMean; ///< Mean of the distribution.
+
+  Count_t fMin = 0; ///< Count of the first entry.
+
+  std::vector<Data_t> fProbs; ///< Probability to keep the count of the entry.
+  std::vector<Count_t> fAlias; ///< Alternative count of each entry.
+
+  /// Fills the alias table from the probabilities of the counts.
+  void makeAliasTable(std::vector<double> probs);
+
+}; // util::FastPoisson<>
+
+
+// -----------------------------------------------------------------------------
+// ---  Template implementation
+// -----------------------------------------------------------------------------
+// ---  util::FastExponential
+// -----------------------------------------------------------------------------
+template <typename T>
+util::FastExponential<T>::FastExponential(std::size_t nPoints) {
+
+  if (!util::details::isPowerOfTwo(nPoints)) {
+    throw std::invalid_argument{
+      "util::FastExponential: number of points ("
+      + std::to_string(nPoints) + ") must be a power of 2."
+      };
+  }
+
+  // the point `i` has cumulative probability ( i + 1/2 ) / N
+  fTable.resize(nPoints);
+  util::UniformSequence<double> extract { static_cast<unsigned int>(nPoints) };
+  for (Data_t& value: fTable)
+    value = static_cast<Data_t>(-std::log(1.0 - extract()));
+
+} // util::FastExponential<>::FastExponential()
+
+
+// -----------------------------------------------------------------------------
+// ---  util::FastPoisson
+// -----------------------------------------------------------------------------
+template <typename T>
+util::FastPoisson<T>::FastPoisson
+  (double mean, double maxMean, double tailProbability)
+  : fMean(mean)
+{
+  if ((mean < 0.0) || (mean > maxMean)) {
+    throw std::invalid_argument{
+      "util::FastPoisson: mean (" + std::to_string(mean)
+      + ") must be between 0 and " + std::to_string(maxMean) + "."
+      };
+  }
+
+  if (mean == 0.0) {
+    fMin = 0;
+    makeAliasTable({ 1.0 });
+    return;
+  }
+
+  // probabilities are computed in logarithm, to avoid underflows
+  double const logMean = std::log(mean);
+  auto const probability = [mean,logMean](Count_t n)
+    { return std::exp(n * logMean - mean - std::lgamma(n + 1.0)); };
+
+  // start from the mode and extend in both directions
+  Count_t const mode = static_cast<Count_t>(mean);
+  Count_t first = mode, last = mode;
+  while ((first > 0) && (probability(first - 1) >= tailProbability)) --first;
+  while (probability(last + 1) >= tailProbability) ++last;
+
+  std::vector<double> probs;
+  probs.reserve(last - first + 1);
+  for (Count_t n = first; n <= last; ++n) probs.push_back(probability(n));
+
+  fMin = first;
+  makeAliasTable(std::move(probs));
+
+} // util::FastPoisson<>::FastPoisson()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+template <typename USpan, typename NSpan>
+void util::FastPoisson<T>::transform(USpan const& u, NSpan&& out) const {
+
+  std::size_t const n = std::size(u);
+  auto const uBegin = std::begin(u);
+  auto const nBegin = std::begin(out);
+  Data_t const N = static_cast<Data_t>(fProbs.size());
+  Data_t const* const probs = fProbs.data();
+  Count_t const* const alias = fAlias.data();
+  Count_t const min = fMin;
+  for (std::size_t i = 0; i < n; ++i) {
+    Data_t const scaled = uBegin[i] * N;
+    std::size_t const j = static_cast<std::size_t>(scaled);
+    nBegin[i] = (scaled - static_cast<Data_t>(j) < probs[j])
+      ? static_cast<Count_t>(min + j): alias[j];
+  }
+
+} // util::FastPoisson<>::transform()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void util::FastPoisson<T>::makeAliasTable(std::vector<double> probs) {
+
+  /*
+   * Vose's alias method: probabilities are scaled so that their average is 1;
+   * entries below 1 ("small") are filled up with probability from entries
+   * above 1 ("large"), which become their alias.
+   */
+  std::size_t const N = probs.size();
+  double total = 0.0;
+  for (double p: probs) total += p;
+  for (double& p: probs) p *= N / total;
+
+  fProbs.assign(N, Data_t{ 1 });
+  fAlias.resize(N);
+  for (std::size_t i = 0; i < N; ++i) fAlias[i] = fMin + i;
+
+  std::vector<std::size_t> small, large;
+  for (std::size_t i = 0; i < N; ++i)
+    ((probs[i] < 1.0)? small: large).push_back(i);
+
+  while (!small.empty() && !large.empty()) {
+    std::size_t const s = small.back();
+    small.pop_back();
+    std::size_t const l = large.back();
+
+    fProbs[s] = static_cast<Data_t>(probs[s]);
+    fAlias[s] = fMin + l;
+
+    probs[l] -= 1.0 - probs[s];
+    if (probs[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  } // while
+  // leftovers (from rounding) keep their own count: probability 1
+
+} // util::FastPoisson<>::makeAliasTable()
+
+
+// -----------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_UTILITIES_FASTPOISSONANDEXPONENTIAL_H
@@ -10,11 +10,11 @@
 
 
 // C/C++ standard libraries
-#include <algorithm> // std::copy(), std::fill()
+#include <algorithm> // std::copy(), std::fill(), std::minmax_element()
 #include <vector>
-#include <iterator> // std::next()
+#include <iterator> // std::next(), std::begin(), std::end()
 #include <utility> // std::declval(), std::move()
-#include <cmath> // std::floor()
+#include <cmath> // std::floor(), std::abs()
 #include <cstddef> // std::size_t, std::ptrdiff_t
 #include <cassert>
 
@@ -63,9 +63,21 @@ namespace icarus::ns::util {
  * (supposedly the first non-empty bin) and which is the last one.
  * Bin content can be asked for any value and any bin.
  * 
- * Currently the modification interface is very limited: the only way to add
- * entries to the bins is one by one by value (`add()`), and the only other
- * supported modifying action is to empty all the content (`clear()`).
+ * Currently the modification interface is limited: entries can be added to
+ * the bins one by one by value (`add()`) or many at once (`insert()`), the
+ * content of another object with compatible binning can be added
+ * (`merge()`), and all the content can be emptied (`clear()`).
+ * 
+ * 
+ * Concurrent filling
+ * -------------------
+ * 
+ * This object is not thread-safe: it must not be modified by multiple threads
+ * at the same time. To fill a distribution from many threads, each thread
+ * should fill its own object with the same binning (`emptyCopy()`), and the
+ * objects should be `merge()`-d at the end. The class
+ * `icarus::ns::util::ShardedFixedBins` (`icarusalg/Utilities/ShardedFixedBins.h`)
+ * takes care of the bookkeeping.
  * 
  * The bin index is of type `ptrdiff_t`.
  * 
@@ -117,6 +129,39 @@ class icarus::ns::util::FixedBins {
    */
   BinIndex_t add(Data_t value);
   
+  /**
+   * @brief Increases by a unit the count at the bin of each of the values.
+   * @tparam BIter type of iterator to the first value
+   * @tparam EIter type of iterator past the last value
+   * @param begin iterator to the first value
+   * @param end iterator past the last value
+   * 
+   * The range of the values is computed first, and the storage is extended at
+   * most once to cover all of them. The range is traversed twice, so the
+   * iterators must be at least forward iterators.
+   */
+  template <typename BIter, typename EIter>
+  void insert(BIter begin, EIter end);
+  
+  /// Increases by a unit the count at the bin of each of the `values`.
+  /// @see `insert(BIter, EIter)`
+  template <typename Coll>
+  void insert(Coll const& values)
+    { using std::begin, std::end; insert(begin(values), end(values)); }
+  
+  /**
+   * @brief Adds the counts of `other` to this object.
+   * @param other the object whose counts are added
+   * @return this object
+   * @see `hasCompatibleBinning()`
+   * 
+   * The storage is extended at most once to include all the bins of `other`,
+   * which may start and end at different values than the ones of this object.
+   * The binning (width and alignment) of `other` must be compatible with the
+   * one of this object (`hasCompatibleBinning()`).
+   */
+  FixedBins& merge(FixedBins const& other);
+  
   /**
    * @brief Resets all counts to `0`.
    *
@@ -142,6 +187,19 @@ class icarus::ns::util::FixedBins {
   /// Returns the width of the bins.
   Interval_t binWidth() const noexcept;
   
+  /**
+   * @brief Returns whether the bins of `other` match the bins of this object.
+   * @param other the object whose binning is checked
+   * @return whether `other` has the same bin width and alignment
+   * 
+   * The alignment is the same if the offsets of the two objects differ by an
+   * integral number of bins (with some tolerance for rounding).
+   */
+  bool hasCompatibleBinning(FixedBins const& other) const noexcept;
+  
+  /// Returns an object with no content and the same binning as this one.
+  FixedBins emptyCopy() const noexcept { return FixedBins{ fWidth, fOffset }; }
+  
   /**
    * @brief Returns the alignment offset of the bins.
    * @return the alignment offset of the bins
@@ -297,6 +355,11 @@ class icarus::ns::util::FixedBins {
   /// index. Requires some storage to exist already.
   std::size_t allocateBin(BinIndex_t index);
   
+  /// Ensures all the bins from `first` to `last` (included) exist, extending
+  /// the storage at most once, and returns the storage index of `first`.
+  /// Requires some storage to exist already.
+  std::size_t allocateRange(BinIndex_t first, BinIndex_t last);
+  
 }; // icarus::ns::util::FixedBins
 
 // deduction guide:
@@ -344,6 +407,57 @@ auto icarus::ns::util::FixedBins<T, C>::add(Data_t value) -> BinIndex_t {
 } // icarus::ns::util::FixedBins<>::add()
 
 
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+template <typename BIter, typename EIter>
+void icarus::ns::util::FixedBins<T, C>::insert(BIter begin, EIter end) {
+  
+  if (begin == end) return;
+  
+  auto const [ itMin, itMax ] = std::minmax_element(begin, end);
+  if (empty()) initializeWith(*itMin);
+  // with negative bin width, the lowest value has the highest bin index
+  BinIndex_t const binA = binWith(*itMin), binB = binWith(*itMax);
+  if (binA <= binB) allocateRange(binA, binB);
+  else              allocateRange(binB, binA);
+  
+  // no allocation happens from now on
+  for (auto it = begin; it != end; ++it)
+    ++fCounters[static_cast<std::size_t>(storageIndex(binWith(*it)))];
+  
+} // icarus::ns::util::FixedBins<>::insert()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+auto icarus::ns::util::FixedBins<T, C>::merge(FixedBins const& other)
+  -> FixedBins&
+{
+  assert(hasCompatibleBinning(other));
+  
+  if (other.empty()) return *this;
+  
+  if (empty()) {
+    fMin = other.fMin;
+    fMinBin = 0;
+    fCounters = other.fCounters;
+    return *this;
+  }
+  
+  // bin of this object including the center of the first bin of `other`
+  BinIndex_t const first = binWith(other.min() + binWidth() / 2);
+  std::size_t const stFirst
+    = allocateRange(first, first + other.nBins() - 1);
+  
+  Count_t* const counts = fCounters.data() + stFirst;
+  Count_t const* const otherCounts = other.fCounters.data();
+  std::size_t const n = other.nBins();
+  for (std::size_t i = 0; i < n; ++i) counts[i] += otherCounts[i];
+  
+  return *this;
+} // icarus::ns::util::FixedBins<>::merge()
+
+
 // -----------------------------------------------------------------------------
 template <typename T, typename C /* = unsigned int */>
 void icarus::ns::util::FixedBins<T, C>::clear() noexcept { fCounters.clear(); }
@@ -367,6 +481,22 @@ auto icarus::ns::util::FixedBins<T, C>::binWidth() const noexcept -> Interval_t
   { return fWidth; }
 
 
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+bool icarus::ns::util::FixedBins<T, C>::hasCompatibleBinning
+  (FixedBins const& other) const noexcept
+{
+  using std::abs, std::floor;
+  
+  if (other.binWidth() != binWidth()) return false;
+  
+  // the offset difference, in bins, must be (close to) an integral number
+  auto const shift = (other.offset() - offset()) / binWidth();
+  return abs(shift - floor(shift + 0.5)) < 1e-6;
+  
+} // icarus::ns::util::FixedBins<>::hasCompatibleBinning()
+
+
 // -----------------------------------------------------------------------------
 template <typename T, typename C /* = unsigned int */>
 auto icarus::ns::util::FixedBins<T, C>::offset() const noexcept -> Data_t
@@ -519,33 +649,47 @@ std::size_t icarus::ns::util::FixedBins<T, C>::initializeWith(Data_t value) {
 
 // -----------------------------------------------------------------------------
 template <typename T, typename C /* = unsigned int */>
-std::size_t icarus::ns::util::FixedBins<T, C>::allocateBin(BinIndex_t index) {
+std::size_t icarus::ns::util::FixedBins<T, C>::allocateBin(BinIndex_t index)
+  { return allocateRange(index, index); }
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C /* = unsigned int */>
+std::size_t icarus::ns::util::FixedBins<T, C>::allocateRange
+  (BinIndex_t first, BinIndex_t last)
+{
   assert(!empty());
+  assert(first <= last);
   
-  BinIndex_t stIndex = storageIndex(index);
+  BinIndex_t stIndex = storageIndex(first);
+  BinIndex_t const stLast = storageIndex(last);
   if (stIndex < 0) {
     // (changes the first index)
     
     // extend the data storage on the left, filling with zeroes
+    // (and on the right too, if needed)
     std::size_t const nExtend = static_cast<std::size_t>(-stIndex);
-    Storage_t data(nExtend + fCounters.size()); // uninitialized
-    auto const itOldFirst = std::next(data.begin(), nExtend);
-    std::fill(data.begin(), itOldFirst, CountZero);
-    std::copy(fCounters.cbegin(), fCounters.cend(), itOldFirst);
+    std::size_t const newSize = std::max(
+      nExtend + fCounters.size(), static_cast<std::size_t>(stLast - stIndex + 1)
+      );
+    Storage_t data(newSize, CountZero);
+    std::copy
+      (fCounters.cbegin(), fCounters.cend(), std::next(data.begin(), nExtend));
     fCounters = std::move(data);
     
-    fMinBin = index;
+    fMinBin = first;
     fMin -= nExtend * binWidth(); // numerically not the best choice...
     stIndex = 0;
   }
-  else if (static_cast<std::size_t>(stIndex) >= fCounters.size()) {
+  else if (static_cast<std::size_t>(stLast) >= fCounters.size()) {
     // (does not change the first index -- nor `stIndex`)
-    fCounters.resize(static_cast<std::size_t>(stIndex) + 1, CountZero);
+    fCounters.resize(static_cast<std::size_t>(stLast) + 1, CountZero);
   }
   assert(hasStorageIndex(stIndex));
+  assert(hasStorageIndex(storageIndex(last)));
   return static_cast<std::size_t>(stIndex);
 
-} // icarus::ns::util::FixedBins<>::allocateBin()
+} // icarus::ns::util::FixedBins<>::allocateRange()
 
 
 // -----------------------------------------------------------------------------
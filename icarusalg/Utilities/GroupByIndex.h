@@ -11,19 +11,29 @@
 #define ICARUSALG_UTILITIES_GROUPBYINDEX_H
 
 
+// ICARUS libraries
+#include "icarusalg/Utilities/runConcurrently.h"
+
 // C/C++ standard libraries
+#include "gsl/span"
+#include <algorithm> // std::min(), std::max()
+#include <iterator> // std::input_iterator_tag
+#include <thread> // std::thread::hardware_concurrency()
 #include <vector>
 #include <utility> // std::forward()
-#include <cstddef> // std::size_t
+#include <cstddef> // std::size_t, std::ptrdiff_t
 
 //------------------------------------------------------------------------------
 namespace icarus::ns::util {
   template <typename T> class GroupByIndex;
   
-  // deduction guide
+  // deduction guides
   template <typename Coll, typename KeyFunc>
   GroupByIndex(Coll const&, KeyFunc&&)
     -> GroupByIndex<typename Coll::value_type>;
+  template <typename Coll, typename KeyFunc>
+  GroupByIndex(Coll const&, KeyFunc&&, unsigned int)
+    -> GroupByIndex<typename Coll::value_type>;
   
 } // namespace icarus::ns::util
 
@@ -35,12 +45,12 @@ namespace icarus::ns::util {
  * The index is supposed to be an integer whose value ranges from `0` to some
  * number; a list of objects is allocated for each of the `N` indices.
  * 
- * Each group is implemented as a vector (`std::vector`) of pointers to the
- * original data. _These groups are valid only as long as the original data is
- * accessible._
+ * Each group is a span (`gsl::span`) of pointers to the original data, in the
+ * same order as in the original collection. _These groups are valid only as
+ * long as the original data is accessible._
  * 
- * Access is valid for any index, even `N` and above; in the latter cases, a
- * prepacked empty list is returned.
+ * Access is valid for any index, even `N` and above; in the latter cases, an
+ * empty list is returned.
  * 
  * The map is defined on construction and can't be modified afterwards.
  * Also the pointed original objects can't be modified via the pointers from
@@ -57,13 +67,24 @@ namespace icarus::ns::util {
  * icarus::ns::util::GroupByIndex byChannel
  *  { waveforms, std::mem_fn(&raw::OpDetWaveform::ChannelNumber) };
  * 
- * for (std::vector<raw::OpDetWaveform const*> const& chWf: byChannel) {
+ * for (auto const& chWf: byChannel) {
  *   if (chWf.empty()) continue;
  *   std::cout << "Channel " << chWf.front()->ChannelNumber() << ": "
  *     << chWf.size() << " waveforms" << std::endl;
  * }
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * 
+ * 
+ * Implementation details
+ * -----------------------
+ * 
+ * The map is built with a counting sort in two passes, the first one counting
+ * the objects in each group and the second one placing their pointers.
+ * All the pointers are stored in a single array, sorted by group, and a
+ * second array holds the position in it where each group starts.
+ * 
+ * For large collections, the construction can be split among threads.
+ * In that case, the extraction function is called concurrently.
  */
 template <typename T>
 class icarus::ns::util::GroupByIndex {
@@ -73,9 +94,13 @@ class icarus::ns::util::GroupByIndex {
   using Object_t = T; ///< Type of the object being grouped.
   
   /// Collection of objects (as non-mutable pointers to the original position).
-  using ObjectPtrColl_t = std::vector<Object_t const*>;
-  using size_type = typename std::vector<ObjectPtrColl_t>::size_type;
-  using const_iterator = typename std::vector<ObjectPtrColl_t>::const_iterator;
+  using ObjectPtrColl_t = gsl::span<Object_t const* const>;
+  using size_type = std::size_t;
+  
+  class const_iterator; // defined below
+  
+  /// Collections smaller than this are always grouped by a single thread.
+  static constexpr std::size_t MinParallelSize = 16384U;
   
   /**
    * @brief Constructor: groups the elements of the collection.
@@ -83,20 +108,36 @@ class icarus::ns::util::GroupByIndex {
    * @tparam KeyFunc type of functor to extract an index from object of type `T`
    * @param coll collection of objects of type `T` to be grouped
    * @param extractKey functor extracting an index from an object of type `T`
+   * @param nThreads (default: `1`) number of threads to use (`0`: all cores)
+   * 
+   * More than one thread is used only when `coll` has at least
+   * `MinParallelSize` elements. In that case, `extractKey` must be safe to call
+   * concurrently. The result does not depend on the number of threads.
    */
   template <typename Coll, typename KeyFunc>
-  GroupByIndex(Coll const& coll, KeyFunc&& extractKey)
-    : fMap{ buildMap(coll, std::forward<KeyFunc>(extractKey)) } {}
+  GroupByIndex
+    (Coll const& coll, KeyFunc&& extractKey, unsigned int nThreads = 1U)
+    { buildMap(coll, std::forward<KeyFunc>(extractKey), nThreads); }
   
   /// Returns the list of objects in the specified group `index`.
-  ObjectPtrColl_t const& operator[] (std::size_t index) const
-    { return (index < size())? fMap[index]: EmptyGroup; }
+  ObjectPtrColl_t operator[] (std::size_t index) const
+    {
+      return (index < size())
+        ? ObjectPtrColl_t
+          { fObjects.data() + fOffsets[index], groupSize(index) }
+        : ObjectPtrColl_t{}
+        ;
+    }
   
   /// Returns whether there is at least one entry in the map.
-  bool empty() const noexcept { return fMap.empty(); }
+  bool empty() const noexcept { return size() == 0U; }
   
   /// Returns the number of groups in the map (including empty ones).
-  size_type size() const noexcept { return fMap.size(); }
+  size_type size() const noexcept
+    { return fOffsets.empty()? 0U: fOffsets.size() - 1U; }
+  
+  /// Returns the total number of grouped objects.
+  size_type nObjects() const noexcept { return fObjects.size(); }
   
   /**
    * @name Iterators
@@ -106,50 +147,206 @@ class icarus::ns::util::GroupByIndex {
    */
   /// @{
   const_iterator begin() const { return cbegin(); }
-  const_iterator cbegin() const { return fMap.cbegin(); }
+  const_iterator cbegin() const { return { this, 0U }; }
   const_iterator end() const { return cend(); }
-  const_iterator cend() const { return fMap.cend(); }
+  const_iterator cend() const { return { this, size() }; }
   /// @}
   
     private:
   
-  static ObjectPtrColl_t const EmptyGroup;
+  /// Pointers to all the objects, sorted by group.
+  std::vector<Object_t const*> fObjects;
+  
+  /// Position in `fObjects` of the first object of each group, plus the end.
+  std::vector<std::size_t> fOffsets;
   
-  std::vector<ObjectPtrColl_t> fMap; ///< Internal representation of the map.
+  /// Returns the number of objects in the group `index` (must be valid).
+  std::size_t groupSize(std::size_t index) const
+    { return fOffsets[index + 1] - fOffsets[index]; }
   
-  /// Groups the data and returns the underlying map.
+  /// Groups the data into `fObjects` and `fOffsets`.
   template <typename Coll, typename KeyFunc>
-  static std::vector<ObjectPtrColl_t> buildMap
-    (Coll const& coll, KeyFunc&& extractKey);
+  void buildMap(Coll const& coll, KeyFunc&& extractKey, unsigned int nThreads);
+  
+  /// Groups the data into `fObjects` and `fOffsets` with `nChunks` threads.
+  template <typename KeyFunc>
+  void buildMapParallel(
+    std::vector<Object_t const*> const& objects, KeyFunc& extractKey,
+    unsigned int nChunks
+    );
   
 }; // icarus::ns::util::GroupByIndex
 
 
 // -----------------------------------------------------------------------------
-// --- Template implementation
-// -----------------------------------------------------------------------------
+/// Iterator through the groups of a `GroupByIndex`.
 template <typename T>
-typename icarus::ns::util::GroupByIndex<T>::ObjectPtrColl_t const
-icarus::ns::util::GroupByIndex<T>::EmptyGroup;
+class icarus::ns::util::GroupByIndex<T>::const_iterator {
+  
+  GroupByIndex<T> const* fMap = nullptr; ///< The map being iterated.
+  
+  std::size_t fIndex = 0U; ///< Index of the current group.
+  
+    public:
+  
+  using iterator_category = std::input_iterator_tag;
+  using value_type = ObjectPtrColl_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = ObjectPtrColl_t;
+  
+  const_iterator() = default;
+  
+  const_iterator(GroupByIndex<T> const* map, std::size_t index)
+    : fMap{ map }, fIndex{ index } {}
+  
+  /// Returns the current group.
+  reference operator*() const { return (*fMap)[fIndex]; }
+  
+  /// Moves to the next group.
+  const_iterator& operator++() { ++fIndex; return *this; }
+  
+  /// Moves to the next group, returning an iterator to the current one.
+  const_iterator operator++(int) { auto old = *this; ++fIndex; return old; }
+  
+  bool operator== (const_iterator const& other) const
+    { return (fMap == other.fMap) && (fIndex == other.fIndex); }
+  
+  bool operator!= (const_iterator const& other) const
+    { return !(*this == other); }
+  
+}; // icarus::ns::util::GroupByIndex<>::const_iterator
 
 
+// -----------------------------------------------------------------------------
+// --- Template implementation
 // -----------------------------------------------------------------------------
 template <typename T>
 template <typename Coll, typename KeyFunc>
-auto icarus::ns::util::GroupByIndex<T>::buildMap
-  (Coll const& coll, KeyFunc&& extractKey) -> std::vector<ObjectPtrColl_t>
+void icarus::ns::util::GroupByIndex<T>::buildMap
+  (Coll const& coll, KeyFunc&& extractKey, unsigned int nThreads)
 {
-  std::vector<ObjectPtrColl_t> map;
+  fObjects.clear();
+  fOffsets.clear();
+  
+  //
+  // first pass: extract the indices and count the objects in each group
+  //
+  std::vector<std::size_t> keys;
+  std::vector<Object_t const*> objects; // used only for parallel processing
+  for (Object_t const& obj: coll) {
+    if (nThreads == 1U) keys.push_back(extractKey(obj));
+    else                objects.push_back(&obj);
+  }
+  
+  if (nThreads != 1U) {
+    if (nThreads == 0U) nThreads = std::thread::hardware_concurrency();
+    std::size_t const maxChunks = objects.size() / (MinParallelSize / 2U);
+    unsigned int const nChunks = static_cast<unsigned int>
+      (std::min<std::size_t>(std::max(nThreads, 1U), maxChunks));
+    if (nChunks > 1U) {
+      buildMapParallel(objects, extractKey, nChunks);
+      return;
+    }
+    for (Object_t const* obj: objects) keys.push_back(extractKey(*obj));
+  } // if multithreading was requested
   
-  auto const accessMap = [&map](std::size_t index) -> ObjectPtrColl_t&
-    { if (index >= map.size()) map.resize(index + 1); return map[index]; };
+  std::size_t nGroups = 0U;
+  for (std::size_t const key: keys) nGroups = std::max(nGroups, key + 1U);
   
-  for (Object_t const& obj: coll) accessMap(extractKey(obj)).push_back(&obj);
+  // the offset of each group is first used as counter of the previous group
+  fOffsets.assign(nGroups + 1U, 0U);
+  for (std::size_t const key: keys) ++fOffsets[key + 1U];
+  for (std::size_t iGroup = 0; iGroup < nGroups; ++iGroup)
+    fOffsets[iGroup + 1U] += fOffsets[iGroup];
+  
+  //
+  // second pass: place the objects, keeping their relative order
+  //
+  std::vector<std::size_t> next { fOffsets.begin(), fOffsets.end() - 1 };
+  fObjects.resize(keys.size());
+  auto iKey = keys.cbegin();
+  if (objects.empty()) {
+    for (Object_t const& obj: coll) fObjects[next[*iKey++]++] = &obj;
+  }
+  else {
+    for (Object_t const* obj: objects) fObjects[next[*iKey++]++] = obj;
+  }
   
-  return map;
 } // icarus::ns::util::GroupByIndex<>::buildMap()
 
 
+// -----------------------------------------------------------------------------
+template <typename T>
+template <typename KeyFunc>
+void icarus::ns::util::GroupByIndex<T>::buildMapParallel(
+  std::vector<Object_t const*> const& objects, KeyFunc& extractKey,
+  unsigned int nChunks
+) {
+  /*
+   * Each thread processes a contiguous chunk of the objects.
+   * Each chunk places its objects after the ones of the same group from the
+   * previous chunks, so that the result is the same as with a single thread.
+   */
+  std::size_t const nObjects = objects.size();
+  auto const chunkBegin = [nObjects,nChunks](unsigned int iChunk)
+    { return nObjects * iChunk / nChunks; };
+  
+  // runs `work(iChunk)` on all chunks, with up to one thread per chunk
+  auto const runOnChunks = [nChunks](auto const& work)
+    { runConcurrently(nChunks, nChunks, work); };
+  
+  // first pass: indices, and their maximum in each chunk
+  std::vector<std::size_t> keys(nObjects);
+  std::vector<std::size_t> chunkGroups(nChunks, 0U);
+  runOnChunks([&](unsigned int iChunk)
+    {
+      std::size_t nGroups = 0U;
+      for (std::size_t i = chunkBegin(iChunk); i < chunkBegin(iChunk + 1); ++i)
+      {
+        keys[i] = extractKey(*objects[i]);
+        nGroups = std::max(nGroups, keys[i] + 1U);
+      }
+      chunkGroups[iChunk] = nGroups;
+    });
+  std::size_t nGroups = 0U;
+  for (std::size_t const n: chunkGroups) nGroups = std::max(nGroups, n);
+  
+  // count of objects of each group in each chunk
+  std::vector<std::size_t> counts(nChunks * nGroups, 0U);
+  runOnChunks([&](unsigned int iChunk)
+    {
+      std::size_t* const chunkCounts = counts.data() + iChunk * nGroups;
+      for (std::size_t i = chunkBegin(iChunk); i < chunkBegin(iChunk + 1); ++i)
+        ++chunkCounts[keys[i]];
+    });
+  
+  // group offsets; the counts become the starting position of each chunk
+  fOffsets.assign(nGroups + 1U, 0U);
+  std::size_t offset = 0U;
+  for (std::size_t iGroup = 0; iGroup < nGroups; ++iGroup) {
+    fOffsets[iGroup] = offset;
+    for (unsigned int iChunk = 0U; iChunk < nChunks; ++iChunk) {
+      std::size_t& count = counts[iChunk * nGroups + iGroup];
+      std::size_t const n = count;
+      count = offset;
+      offset += n;
+    } // for chunks
+  } // for groups
+  fOffsets[nGroups] = offset;
+  
+  // second pass: place the objects
+  fObjects.resize(nObjects);
+  runOnChunks([&](unsigned int iChunk)
+    {
+      std::size_t* const next = counts.data() + iChunk * nGroups;
+      for (std::size_t i = chunkBegin(iChunk); i < chunkBegin(iChunk + 1); ++i)
+        fObjects[next[keys[i]]++] = objects[i];
+    });
+  
+} // icarus::ns::util::GroupByIndex<>::buildMapParallel()
+
+
 // -----------------------------------------------------------------------------
 
 #endif // ICARUSALG_UTILITIES_GROUPBYINDEX_H
@@ -0,0 +1,132 @@
+/**
+ * @file   icarusalg/Utilities/HitColumns.cxx
+ * @brief  The reconstructed hits of an event, one array per quantity.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Utilities/HitColumns.h`
+ */
+
+// library header
+#include "icarusalg/Utilities/HitColumns.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+
+//------------------------------------------------------------------------------
+void icarus::ns::util::HitColumns::fill(std::vector<recob::Hit> const& hits) {
+
+  std::size_t const n = hits.size();
+  resize(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    recob::Hit const& hit = hits[i];
+    geo::WireID const& wid = hit.WireID();
+
+    fChannel[i] = hit.Channel();
+    fCryostat[i] = wid.Cryostat;
+    fTPC[i] = wid.TPC;
+    fPlane[i] = wid.Plane;
+    fWire[i] = wid.Wire;
+    fView[i] = hit.View();
+    fStartTick[i] = hit.StartTick();
+    fEndTick[i] = hit.EndTick();
+    fPeakTime[i] = hit.PeakTime();
+    fRMS[i] = hit.RMS();
+    fPeakAmplitude[i] = hit.PeakAmplitude();
+    fSummedADC[i] = hit.SummedADC();
+    fIntegral[i] = hit.Integral();
+    fGoodnessOfFit[i] = hit.GoodnessOfFit();
+    fDegreesOfFreedom[i] = hit.DegreesOfFreedom();
+    fMultiplicity[i] = hit.Multiplicity();
+    fLocalIndex[i] = hit.LocalIndex();
+
+    // invalid wires are marked with invalid numbers, checked below
+    if (!wid.isValid) fCryostat[i] = geo::CryostatID::InvalidID;
+
+  } // for hits
+
+  fillIndices();
+
+} // icarus::ns::util::HitColumns::fill()
+
+
+//------------------------------------------------------------------------------
+auto icarus::ns::util::HitColumns::makeLayout(geo::GeometryCore const& geom)
+  -> Layout_t
+{
+  Layout_t layout {
+    geom.Ncryostats(),   // nCryostats
+    geom.MaxTPCs(),      // maxTPCs
+    geom.MaxPlanes(),    // maxPlanes
+    geom.MaxTPCsets(),   // maxTPCsets
+    {}                   // TPCsetOfTPC
+  };
+
+  layout.TPCsetOfTPC.assign(layout.nCryostats * layout.maxTPCs, NoIndex);
+  for (readout::TPCsetID const& sid: geom.Iterate<readout::TPCsetID>()) {
+    for (geo::TPCID const& tpcid: geom.TPCsetToTPCs(sid))
+      layout.TPCsetOfTPC[layout.TPCindex(tpcid)] = sid.TPCset;
+  } // for TPC sets
+
+  return layout;
+} // icarus::ns::util::HitColumns::makeLayout()
+
+
+//------------------------------------------------------------------------------
+void icarus::ns::util::HitColumns::resize(std::size_t n) {
+
+  fChannel.resize(n);
+  fCryostat.resize(n);
+  fTPC.resize(n);
+  fPlane.resize(n);
+  fWire.resize(n);
+  fView.resize(n);
+  fTPCset.resize(n);
+  fPlaneIndex.resize(n);
+  fTPCsetIndex.resize(n);
+  fStartTick.resize(n);
+  fEndTick.resize(n);
+  fPeakTime.resize(n);
+  fRMS.resize(n);
+  fPeakAmplitude.resize(n);
+  fSummedADC.resize(n);
+  fIntegral.resize(n);
+  fGoodnessOfFit.resize(n);
+  fDegreesOfFreedom.resize(n);
+  fMultiplicity.resize(n);
+  fLocalIndex.resize(n);
+
+} // icarus::ns::util::HitColumns::resize()
+
+
+//------------------------------------------------------------------------------
+void icarus::ns::util::HitColumns::fillIndices() {
+
+  Layout_t const& layout = fLayout;
+  std::size_t const n = size();
+
+  for (std::size_t i = 0; i < n; ++i) {
+
+    bool const inLayout = (fCryostat[i] < layout.nCryostats)
+      && (fTPC[i] < layout.maxTPCs) && (fPlane[i] < layout.maxPlanes);
+    if (!inLayout) {
+      fPlaneIndex[i] = fTPCset[i] = fTPCsetIndex[i] = NoIndex;
+      continue;
+    }
+
+    Index_t const TPCindex = fCryostat[i] * layout.maxTPCs + fTPC[i];
+    Index_t const TPCset = layout.TPCsetOfTPC[TPCindex];
+
+    fPlaneIndex[i] = TPCindex * layout.maxPlanes + fPlane[i];
+    fTPCset[i] = TPCset;
+    fTPCsetIndex[i] = (TPCset == NoIndex)
+      ? NoIndex: fCryostat[i] * layout.maxTPCsets + TPCset;
+
+  } // for hits
+
+} // icarus::ns::util::HitColumns::fillIndices()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,303 @@
+/**
+ * @file   icarusalg/Utilities/HitColumns.h
+ * @brief  The reconstructed hits of an event, one array per quantity.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Utilities/HitColumns.cxx`
+ */
+
+#ifndef ICARUSALG_UTILITIES_HITCOLUMNS_H
+#define ICARUSALG_UTILITIES_HITCOLUMNS_H
+
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits>
+#include <utility> // std::move()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace geo { class GeometryCore; }
+namespace recob { class Hit; }
+namespace icarus::ns::util { class HitColumns; }
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief The hits of an event, in flat arrays with one entry per hit.
+ *
+ * The hits of a collection (`std::vector<recob::Hit>`, usually all the hits
+ * of the event from one data product) are decoded once into one array per
+ * quantity: the row `i` of each array describes the hit `i` of the
+ * collection, which is also the key of `art::Ptr` pointing to that hit.
+ * Besides the content of the hits, each row also holds indices computed
+ * once from the geometry: the flat index of the wire plane
+ * (`planeIndex()`, in the layout of `geo::PlaneDataContainer`) and the TPC
+ * set the hit was read from (`TPCset()`, `TPCsetIndex()`, the latter in the
+ * layout of `readout::TPCsetDataContainer`).
+ *
+ * Analysis code can then loop on the arrays it needs, which the compiler
+ * vectorizes, rather than hit by hit through the accessors of `recob::Hit`,
+ * and many algorithms can share the same decoding of the event.
+ *
+ * Example filling the table once per event and using it in a loop:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::HitColumns hitColumns { geom }; // at setup
+ *
+ * // in the event loop:
+ * hitColumns.fill(*event.getValidHandle<std::vector<recob::Hit>>(hitTag));
+ *
+ * double totalCharge = 0.0;
+ * float const* integral = hitColumns.integral();
+ * for (std::size_t i = 0; i < hitColumns.size(); ++i)
+ *   totalCharge += integral[i];
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The object is meant to be filled again for each event: the arrays keep
+ * their memory between events.
+ * Hits on a plane not described in the layout get `NoIndex` as plane and
+ * TPC set indices.
+ */
+class icarus::ns::util::HitColumns {
+
+    public:
+
+  using Index_t = unsigned int; ///< Type of the precomputed flat indices.
+
+  /// Index value for hits out of the layout.
+  static constexpr Index_t NoIndex = std::numeric_limits<Index_t>::max();
+
+  /// Dimensions of the detector and TPC to TPC set map used for the indices.
+  struct Layout_t {
+
+    unsigned int nCryostats = 0U; ///< Number of cryostats.
+    unsigned int maxTPCs = 0U; ///< Largest number of TPC in a cryostat.
+    unsigned int maxPlanes = 0U; ///< Largest number of planes in a TPC.
+    unsigned int maxTPCsets = 0U; ///< Largest number of TPC sets in a cryostat.
+
+    /// Number of the TPC set of each TPC (`NoIndex` if none), by TPC index.
+    std::vector<Index_t> TPCsetOfTPC;
+
+    /// Returns the number of entries of a container of all planes.
+    std::size_t nPlanes() const
+      { return std::size_t(nCryostats) * maxTPCs * maxPlanes; }
+
+    /// Returns the number of entries of a container of all TPC sets.
+    std::size_t nTPCsets() const
+      { return std::size_t(nCryostats) * maxTPCsets; }
+
+    /// Returns whether `pid` is within the dimensions of the layout.
+    bool hasPlane(geo::PlaneID const& pid) const;
+
+    /// Returns the flat index of the TPC `tpcid` (no check performed).
+    Index_t TPCindex(geo::TPCID const& tpcid) const
+      { return tpcid.Cryostat * maxTPCs + tpcid.TPC; }
+
+    /// Returns the flat index of the plane `pid` (no check performed).
+    Index_t planeIndex(geo::PlaneID const& pid) const
+      { return TPCindex(pid) * maxPlanes + pid.Plane; }
+
+    /// Returns the flat index of the TPC set `sid` (no check performed).
+    Index_t TPCsetIndex(readout::TPCsetID const& sid) const
+      { return sid.Cryostat * maxTPCsets + sid.TPCset; }
+
+  }; // Layout_t
+
+
+  /// Constructor: no layout, all hits get `NoIndex` indices.
+  HitColumns() = default;
+
+  /// Constructor: uses the specified detector layout.
+  explicit HitColumns(Layout_t layout): fLayout{ std::move(layout) } {}
+
+  /// Constructor: extracts the detector layout from the geometry.
+  explicit HitColumns(geo::GeometryCore const& geom)
+    : HitColumns{ makeLayout(geom) } {}
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Replaces the content with the one of all the `hits`.
+  void fill(std::vector<recob::Hit> const& hits);
+
+  /// Removes all the hits (memory is not released).
+  void clear() { resize(0U); }
+
+  /// @}
+  // --- END ---- Filling ------------------------------------------------------
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+
+  /// Returns the number of hits.
+  std::size_t size() const noexcept { return fChannel.size(); }
+
+  /// Returns whether there is no hit.
+  bool empty() const noexcept { return fChannel.empty(); }
+
+  /// Returns the detector layout the indices refer to.
+  Layout_t const& layout() const noexcept { return fLayout; }
+
+  /// Returns the ID of the wire of hit `i`.
+  geo::WireID wireID(std::size_t i) const
+    { return { fCryostat[i], fTPC[i], fPlane[i], fWire[i] }; }
+
+  /// Returns the ID of the plane of hit `i`.
+  geo::PlaneID planeID(std::size_t i) const
+    { return { fCryostat[i], fTPC[i], fPlane[i] }; }
+
+  /// Returns the ID of the TPC set of hit `i` (invalid if not in the layout).
+  readout::TPCsetID TPCsetID(std::size_t i) const;
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+
+  // --- BEGIN -- Columns ------------------------------------------------------
+  /// @name Columns
+  /// Each column has `size()` entries, one per hit.
+  /// @{
+
+  /// Channel of each hit.
+  raw::ChannelID_t const* channel() const noexcept { return fChannel.data(); }
+
+  /// Cryostat number of each hit.
+  geo::CryostatID::CryostatID_t const* cryostat() const noexcept
+    { return fCryostat.data(); }
+
+  /// TPC number of each hit.
+  geo::TPCID::TPCID_t const* TPC() const noexcept { return fTPC.data(); }
+
+  /// Plane number of each hit.
+  geo::PlaneID::PlaneID_t const* plane() const noexcept
+    { return fPlane.data(); }
+
+  /// Wire number of each hit.
+  geo::WireID::WireID_t const* wire() const noexcept { return fWire.data(); }
+
+  /// View of each hit.
+  geo::View_t const* view() const noexcept { return fView.data(); }
+
+  /// TPC set number of each hit (`NoIndex` if not in the layout).
+  Index_t const* TPCset() const noexcept { return fTPCset.data(); }
+
+  /// Flat index of the plane of each hit (`NoIndex` if not in the layout).
+  Index_t const* planeIndex() const noexcept { return fPlaneIndex.data(); }
+
+  /// Flat index of the TPC set of each hit (`NoIndex` if not in the layout).
+  Index_t const* TPCsetIndex() const noexcept { return fTPCsetIndex.data(); }
+
+  /// First tick of the region of each hit.
+  raw::TDCtick_t const* startTick() const noexcept
+    { return fStartTick.data(); }
+
+  /// Tick past the region of each hit.
+  raw::TDCtick_t const* endTick() const noexcept { return fEndTick.data(); }
+
+  /// Peak time of each hit [ticks]
+  float const* peakTime() const noexcept { return fPeakTime.data(); }
+
+  /// Width (RMS) of each hit [ticks]
+  float const* RMS() const noexcept { return fRMS.data(); }
+
+  /// Peak amplitude of each hit [ADC]
+  float const* peakAmplitude() const noexcept
+    { return fPeakAmplitude.data(); }
+
+  /// Sum of the ADC counts of the region of each hit [ADC x tick]
+  float const* summedADC() const noexcept { return fSummedADC.data(); }
+
+  /// Integral of each hit [ADC x tick]
+  float const* integral() const noexcept { return fIntegral.data(); }
+
+  /// Goodness of fit of each hit.
+  float const* goodnessOfFit() const noexcept
+    { return fGoodnessOfFit.data(); }
+
+  /// Degrees of freedom of the fit of each hit.
+  int const* degreesOfFreedom() const noexcept
+    { return fDegreesOfFreedom.data(); }
+
+  /// Number of hits in the region of each hit.
+  int const* multiplicity() const noexcept { return fMultiplicity.data(); }
+
+  /// Index of each hit in its region.
+  int const* localIndex() const noexcept { return fLocalIndex.data(); }
+
+  /// @}
+  // --- END ---- Columns ------------------------------------------------------
+
+
+  /// Extracts the detector layout from the geometry and its channel mapping.
+  static Layout_t makeLayout(geo::GeometryCore const& geom);
+
+
+    private:
+
+  Layout_t fLayout; ///< Detector layout for the precomputed indices.
+
+  // --- BEGIN -- Columns ------------------------------------------------------
+  std::vector<raw::ChannelID_t> fChannel;
+  std::vector<geo::CryostatID::CryostatID_t> fCryostat;
+  std::vector<geo::TPCID::TPCID_t> fTPC;
+  std::vector<geo::PlaneID::PlaneID_t> fPlane;
+  std::vector<geo::WireID::WireID_t> fWire;
+  std::vector<geo::View_t> fView;
+  std::vector<Index_t> fTPCset;
+  std::vector<Index_t> fPlaneIndex;
+  std::vector<Index_t> fTPCsetIndex;
+  std::vector<raw::TDCtick_t> fStartTick;
+  std::vector<raw::TDCtick_t> fEndTick;
+  std::vector<float> fPeakTime;
+  std::vector<float> fRMS;
+  std::vector<float> fPeakAmplitude;
+  std::vector<float> fSummedADC;
+  std::vector<float> fIntegral;
+  std::vector<float> fGoodnessOfFit;
+  std::vector<int> fDegreesOfFreedom;
+  std::vector<int> fMultiplicity;
+  std::vector<int> fLocalIndex;
+  // --- END ---- Columns ------------------------------------------------------
+
+  /// Sets the number of hits of all the columns.
+  void resize(std::size_t n);
+
+  /// Fills the plane and TPC set indices of all the hits from their wire.
+  void fillIndices();
+
+}; // icarus::ns::util::HitColumns
+
+
+//------------------------------------------------------------------------------
+//---  Inline implementation
+//------------------------------------------------------------------------------
+inline bool icarus::ns::util::HitColumns::Layout_t::hasPlane
+  (geo::PlaneID const& pid) const
+{
+  return pid.isValid && (pid.Cryostat < nCryostats) && (pid.TPC < maxTPCs)
+    && (pid.Plane < maxPlanes);
+} // icarus::ns::util::HitColumns::Layout_t::hasPlane()
+
+
+//------------------------------------------------------------------------------
+inline readout::TPCsetID icarus::ns::util::HitColumns::TPCsetID
+  (std::size_t i) const
+{
+  return (fTPCset[i] == NoIndex)
+    ? readout::TPCsetID{}: readout::TPCsetID{ fCryostat[i], fTPCset[i] };
+} // icarus::ns::util::HitColumns::TPCsetID()
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_HITCOLUMNS_H
@@ -0,0 +1,381 @@
+/**
+ * @file   icarusalg/Utilities/Instrumentation.h
+ * @brief  Scoped timers and counters to measure the cost of algorithms.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Utilities/AtomicHistogram.h`
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSALG_UTILITIES_INSTRUMENTATION_H
+#define ICARUSALG_UTILITIES_INSTRUMENTATION_H
+
+// ICARUS libraries
+#include "icarusalg/Utilities/AtomicHistogram.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max()
+#include <atomic>
+#include <chrono>
+#include <cmath> // std::log10()
+#include <limits>
+#include <map>
+#include <memory> // std::unique_ptr<>
+#include <mutex>
+#include <string>
+#include <utility> // std::forward()
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+
+  class TimerStats;
+  class ScopedTimer;
+  class Instrumentation;
+
+} // namespace icarus::ns::util
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Statistics of the time spent in a piece of code.
+ *
+ * For each measurement, the number of calls, the total, minimum and maximum
+ * time are updated, and the time is added to a histogram with logarithmic
+ * binning (`latencies()`, the axis being log10 of the time in seconds, from
+ * 100 ns to 100 s).
+ *
+ * All updates are thread-safe and lock-free.
+ * Measurements are usually added via `icarus::ns::util::ScopedTimer`.
+ */
+class icarus::ns::util::TimerStats {
+
+    public:
+
+  /// Type of the histogram of latencies.
+  using Histogram_t = AtomicHist1D;
+
+  /// Binning of the latency histogram: log10 of the time in seconds.
+  static constexpr Histogram_t::Axis_t LatencyAxis { 90U, -7.0, 2.0 };
+
+
+  /// Adds a measurement of `seconds`.
+  void add(double seconds)
+    {
+      fCalls.fetch_add(1U, std::memory_order_relaxed);
+      atomicUpdate(fTotal, [seconds](double t){ return t + seconds; });
+      atomicUpdate(fMin, [seconds](double t){ return std::min(t, seconds); });
+      atomicUpdate(fMax, [seconds](double t){ return std::max(t, seconds); });
+      fLatencies.fill((seconds > 0.0)
+        ? std::log10(seconds): std::numeric_limits<double>::lowest());
+    }
+
+  /// Returns the number of measurements.
+  unsigned long long calls() const
+    { return fCalls.load(std::memory_order_relaxed); }
+
+  /// Returns the total time measured [s].
+  double total() const { return fTotal.load(std::memory_order_relaxed); }
+
+  /// Returns the average time per measurement [s] (`0` if none).
+  double mean() const { return calls()? (total() / calls()): 0.0; }
+
+  /// Returns the shortest time measured [s] (`0` if none).
+  double min() const
+    { return calls()? fMin.load(std::memory_order_relaxed): 0.0; }
+
+  /// Returns the longest time measured [s] (`0` if none).
+  double max() const
+    { return calls()? fMax.load(std::memory_order_relaxed): 0.0; }
+
+  /// Returns the histogram of log10 of the times [s].
+  Histogram_t const& latencies() const { return fLatencies; }
+
+  /// Returns the histogram of log10 of the times [s].
+  Histogram_t& latencies() { return fLatencies; }
+
+  /// Removes all measurements (not thread-safe).
+  void reset()
+    {
+      fCalls = 0U;
+      fTotal = 0.0;
+      fMin = std::numeric_limits<double>::max();
+      fMax = 0.0;
+      fLatencies.reset();
+    }
+
+
+    private:
+
+  std::atomic<unsigned long long> fCalls { 0U }; ///< Number of measurements.
+  std::atomic<double> fTotal { 0.0 }; ///< Total time [s].
+  std::atomic<double> fMin { std::numeric_limits<double>::max() }; ///< [s]
+  std::atomic<double> fMax { 0.0 }; ///< Longest time [s].
+
+  Histogram_t fLatencies { { LatencyAxis } }; ///< log10 of the times [s].
+
+
+  /// Replaces atomically the value of `value` with `op(value)`.
+  template <typename Op>
+  static void atomicUpdate(std::atomic<double>& value, Op op)
+    {
+      double old = value.load(std::memory_order_relaxed);
+      while (!value.compare_exchange_weak
+        (old, op(old), std::memory_order_relaxed)
+        )
+        {}
+    }
+
+}; // icarus::ns::util::TimerStats
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Adds to a `TimerStats` the time spent until it is destroyed.
+ *
+ * ~~~~{.cpp}
+ * {
+ *   icarus::ns::util::ScopedTimer timer
+ *     { icarus::ns::util::Instrumentation::global().timer("baseline") };
+ *   // ...
+ * } // time is recorded here
+ * ~~~~
+ * Usually the `ICARUS_SCOPED_TIMER()` macro is more convenient.
+ */
+class icarus::ns::util::ScopedTimer {
+
+    public:
+
+  using Clock_t = std::chrono::steady_clock; ///< Clock used for measurements.
+
+  /// Starts measuring the time for `stats`.
+  explicit ScopedTimer(TimerStats& stats)
+    : fStats(&stats), fStart(Clock_t::now()) {}
+
+  ScopedTimer(ScopedTimer const&) = delete;
+  ScopedTimer& operator= (ScopedTimer const&) = delete;
+
+  /// Records the time spent since construction.
+  ~ScopedTimer() { stop(); }
+
+  /// Records the time spent since construction; later calls do nothing.
+  void stop()
+    {
+      if (!fStats) return;
+      fStats->add(
+        std::chrono::duration<double>(Clock_t::now() - fStart).count()
+        );
+      fStats = nullptr;
+    }
+
+
+    private:
+
+  TimerStats* fStats; ///< Where to record the time (`nullptr` when done).
+  Clock_t::time_point const fStart; ///< When the measurement started.
+
+}; // icarus::ns::util::ScopedTimer
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Registry of named timers and counters.
+ *
+ * Timers (`TimerStats`) and counters are created on their first request by
+ * name, and they live as long as the registry. Requests by name are
+ * serialized, while updating the returned timers and counters is lock-free:
+ * code in a loop should ask for them once and keep the reference (the
+ * `ICARUS_SCOPED_TIMER()` and `ICARUS_COUNT()` macros do that).
+ *
+ * A job-wide registry is available as `Instrumentation::global()`.
+ *
+ * The content can be printed on any output stream, including the message
+ * facility ones:
+ * ~~~~{.cpp}
+ * icarus::ns::util::Instrumentation::global().dump(mf::LogInfo{ "Timing" });
+ * ~~~~
+ * and the latency histograms can be moved into ROOT histograms in a
+ * `PlotSandbox`:
+ * ~~~~{.cpp}
+ * icarus::ns::util::Instrumentation::global().makePlots<TH1D>(plots);
+ * ~~~~
+ */
+class icarus::ns::util::Instrumentation {
+
+    public:
+
+  /// Type of counter.
+  using Counter_t = std::atomic<unsigned long long>;
+
+
+  /// Returns the timer with the specified `name`, creating it if needed.
+  TimerStats& timer(std::string const& name)
+    { return getOrCreate(fTimers, name); }
+
+  /// Returns the counter with the specified `name`, creating it if needed.
+  Counter_t& counter(std::string const& name)
+    { return getOrCreate(fCounters, name); }
+
+
+  /**
+   * @brief Prints all timers and counters into the stream `out`.
+   * @tparam Stream type of output stream
+   * @param out the stream to print into
+   * @param indent string to prepend to each line
+   * @return `out`
+   *
+   * One line is printed per timer or counter, in order of name.
+   */
+  template <typename Stream>
+  Stream&& dump(Stream&& out, std::string const& indent = "") const;
+
+  /**
+   * @brief Moves the latency histograms into ROOT histograms.
+   * @tparam Hist type of ROOT histogram to create (e.g. `TH1D`)
+   * @tparam Sandbox type of plot sandbox (e.g. `PlotSandbox`)
+   * @param box where to create the histograms
+   *
+   * A histogram is created in `box` (with `make<Hist>()`) for each timer,
+   * named after it. The content of the latency histograms is moved into them
+   * (see `AtomicHistogram::transferTo()`). Not thread-safe.
+   */
+  template <typename Hist, typename Sandbox>
+  void makePlots(Sandbox& box);
+
+  /// Resets all timers and counters (not thread-safe).
+  void reset();
+
+
+  /// Returns the job-wide registry.
+  static Instrumentation& global()
+    { static Instrumentation registry; return registry; }
+
+
+    private:
+
+  mutable std::mutex fLock; ///< Lock for creation and iteration.
+
+  /// All timers, by name.
+  std::map<std::string, std::unique_ptr<TimerStats>> fTimers;
+
+  /// All counters, by name.
+  std::map<std::string, std::unique_ptr<Counter_t>> fCounters;
+
+
+  /// Returns the element in `registry` with `name`, creating it if needed.
+  template <typename T>
+  T& getOrCreate(
+    std::map<std::string, std::unique_ptr<T>>& registry,
+    std::string const& name
+    )
+    {
+      std::lock_guard const lock { fLock };
+      std::unique_ptr<T>& ptr = registry[name];
+      if (!ptr) ptr = std::make_unique<T>();
+      return *ptr;
+    }
+
+}; // icarus::ns::util::Instrumentation
+
+
+// -----------------------------------------------------------------------------
+// --- Instrumentation macros
+// -----------------------------------------------------------------------------
+/**
+ * @def ICARUS_SCOPED_TIMER(name)
+ * @brief Measures the time until the end of the current scope.
+ * @param name name of the timer in the global registry (a string)
+ *
+ * @def ICARUS_COUNT(name, n)
+ * @brief Adds `n` to a counter.
+ * @param name name of the counter in the global registry (a string)
+ * @param n the amount to add
+ *
+ * These macros record into `icarus::ns::util::Instrumentation::global()`.
+ * The timer or counter is looked up only the first time each macro is
+ * executed; `name` should not change between calls.
+ *
+ * Unless `ICARUSALG_INSTRUMENTATION` is defined (see the CMake option of the
+ * same name), they expand to nothing, and their arguments are not evaluated.
+ */
+#ifdef ICARUSALG_INSTRUMENTATION
+
+#  define ICARUS_INSTRUMENTATION_CONCAT_(a, b) a##b
+#  define ICARUS_INSTRUMENTATION_NAME_(prefix, line) \
+     ICARUS_INSTRUMENTATION_CONCAT_(prefix, line)
+
+#  define ICARUS_SCOPED_TIMER(name)                                            \
+     static icarus::ns::util::TimerStats&                                      \
+       ICARUS_INSTRUMENTATION_NAME_(icarusTimerStats_, __LINE__)               \
+       = icarus::ns::util::Instrumentation::global().timer(name);              \
+     icarus::ns::util::ScopedTimer                                             \
+       ICARUS_INSTRUMENTATION_NAME_(icarusScopedTimer_, __LINE__)              \
+       { ICARUS_INSTRUMENTATION_NAME_(icarusTimerStats_, __LINE__) }
+
+#  define ICARUS_COUNT(name, n)                                                \
+     do {                                                                      \
+       static icarus::ns::util::Instrumentation::Counter_t& counter            \
+         = icarus::ns::util::Instrumentation::global().counter(name);          \
+       counter.fetch_add((n), std::memory_order_relaxed);                      \
+     } while (false)
+
+#else // !ICARUSALG_INSTRUMENTATION
+
+#  define ICARUS_SCOPED_TIMER(name) static_assert(true)
+#  define ICARUS_COUNT(name, n) do {} while (false)
+
+#endif // ICARUSALG_INSTRUMENTATION
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename Stream>
+Stream&& icarus::ns::util::Instrumentation::dump
+  (Stream&& out, std::string const& indent /* = "" */) const
+{
+  std::lock_guard const lock { fLock };
+  out << indent << fTimers.size() << " timers, " << fCounters.size()
+    << " counters";
+  for (auto const& [ name, stats ]: fTimers) {
+    out << "\n" << indent << "  timer '" << name << "': " << stats->calls()
+      << " calls, " << stats->total() << " s";
+    if (stats->calls() == 0U) continue;
+    out << " (mean: " << (stats->mean() * 1e6) << " us, min: "
+      << (stats->min() * 1e6) << " us, max: " << (stats->max() * 1e6) << " us)";
+  } // for timers
+  for (auto const& [ name, counter ]: fCounters) {
+    out << "\n" << indent << "  counter '" << name << "': "
+      << counter->load(std::memory_order_relaxed);
+  } // for counters
+  return std::forward<Stream>(out);
+} // icarus::ns::util::Instrumentation::dump()
+
+
+// -----------------------------------------------------------------------------
+template <typename Hist, typename Sandbox>
+void icarus::ns::util::Instrumentation::makePlots(Sandbox& box) {
+  std::lock_guard const lock { fLock };
+  for (auto const& [ name, stats ]: fTimers) {
+    TimerStats::Histogram_t::Axis_t const& axis = stats->latencies().axis(0U);
+    Hist* hist = box.template make<Hist>(name,
+      "Time spent in " + name + ";log_{10}(time/s);calls",
+      axis.nBins, axis.lower, axis.upper
+      );
+    stats->latencies().transferTo(*hist);
+  } // for timers
+} // icarus::ns::util::Instrumentation::makePlots()
+
+
+// -----------------------------------------------------------------------------
+inline void icarus::ns::util::Instrumentation::reset() {
+  std::lock_guard const lock { fLock };
+  for (auto const& [ name, stats ]: fTimers) stats->reset();
+  for (auto const& [ name, counter ]: fCounters) *counter = 0U;
+} // icarus::ns::util::Instrumentation::reset()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_INSTRUMENTATION_H
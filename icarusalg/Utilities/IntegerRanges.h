@@ -14,10 +14,15 @@
 // C/C++ standard libraries
 #include <ostream>
 #include <vector>
+#include <string>
 #include <initializer_list>
+#include <algorithm> // std::upper_bound(), std::max(), std::min()
+#include <iterator> // std::prev()
 #include <numeric> // std::accumulate()
 #include <stdexcept> // std::runtime_error
-#include <type_traits> // std::is_integral_v
+#include <type_traits> // std::is_integral_v, std::make_unsigned_t
+#include <cstdint> // std::uint8_t, std::uint64_t, std::int64_t
+#include <cstddef> // std::size_t
 
 
 // -----------------------------------------------------------------------------
@@ -39,6 +44,8 @@ namespace icarus {
   
   
   template <typename T = int, bool CheckGrowing = false> class IntegerRanges;
+  template <typename T = int, bool CheckGrowing = false>
+  class IntegerRangesBuilder;
   
   template <bool CheckGrowing = true , typename Coll>
   IntegerRanges<typename Coll::value_type, CheckGrowing> makeIntegerRanges
@@ -120,6 +127,9 @@ class icarus::details::IntegerRangesBase {
   /// Returns an iterable object with all sorted ranges as elements.
   decltype(auto) ranges() const noexcept;
   
+  /// Returns whether `value` is in any of the ranges (binary search).
+  bool contains(Data_t value) const noexcept;
+  
   /// @}
   // --- END ---- Queries ------------------------------------------------------
   
@@ -146,6 +156,27 @@ class icarus::details::IntegerRangesBase {
   template <bool CheckGrowing, typename BIter, typename EIter>
   static std::vector<Range_t> compactRange(BIter b, EIter e);
   
+  /// Adds `value` to sorted `ranges`, extending the last one if contiguous.
+  template <bool CheckGrowing>
+  static void appendValue(std::vector<Range_t>& ranges, Data_t value);
+  
+  /// Returns the sorted ranges of the values in either `a` or `b`.
+  static std::vector<Range_t> unionRanges
+    (std::vector<Range_t> const& a, std::vector<Range_t> const& b);
+  
+  /// Returns the sorted ranges of the values in both `a` and `b`.
+  static std::vector<Range_t> intersectionRanges
+    (std::vector<Range_t> const& a, std::vector<Range_t> const& b);
+  
+  /// Writes the ranges in compact binary form (see `IntegerRanges`).
+  static std::vector<std::uint8_t> serializeRanges
+    (std::vector<Range_t> const& ranges);
+  
+  /// Reads ranges written by `serializeRanges()`.
+  template <bool CheckGrowing>
+  static std::vector<Range_t> deserializeRanges
+    (std::uint8_t const* data, std::size_t size);
+  
   
   /// Returns `value` incremented by 1.
   static constexpr Data_t plusOne(Data_t value) noexcept;
@@ -189,16 +220,46 @@ class icarus::details::IntegerRangesBase {
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * will print something like `Ranges: 1 2 4--6 8 10`.
  * 
+ * When the values are not all available at once, `icarus::IntegerRangesBuilder`
+ * collects them one at a time.
+ * 
+ * 
+ * Set operations
+ * ---------------
+ * 
+ * The union (`a | b`) and the intersection (`a & b`) of two sets of ranges
+ * are computed in a single pass on both, with time linear in their number of
+ * ranges. The result is again a sorted sequence of non-contiguous ranges.
+ * Membership of a single value is tested by `contains()` with a binary search.
+ * These operations assume that the ranges were built from a growing sequence.
+ * 
+ * 
+ * Serialization
+ * --------------
+ * 
+ * `serialize()` writes the ranges into a compact buffer of bytes, which
+ * `deserialize()` turns back into an equal object, for example after sending
+ * it to another process. The format is independent of the platform:
+ * the number of ranges, then for each range the distance of its lower limit
+ * from the upper one of the previous range (from `0` for the first range)
+ * and its size minus 1. Each of these numbers is written in
+ * [LEB128](https://en.wikipedia.org/wiki/LEB128) variable-length encoding,
+ * with the distance zig-zag encoded: a mask of a few groups of contiguous
+ * channels takes a few bytes per group.
+ * 
  */
 template <typename T /* = int */, bool CheckGrowing /* = false */>
 class icarus::IntegerRanges: public icarus::details::IntegerRangesBase<T> {
   
   using Base_t = icarus::details::IntegerRangesBase<T>;
   
+  friend class icarus::IntegerRangesBuilder<T, CheckGrowing>;
+  
     public:
   static constexpr bool IsChecked = CheckGrowing;
   
   using Data_t = typename Base_t::Data_t;
+  using Range_t = typename Base_t::Range_t;
   
   /// Default constructor: an empty set of ranges.
   IntegerRanges() = default;
@@ -209,9 +270,119 @@ class icarus::IntegerRanges: public icarus::details::IntegerRangesBase<T> {
   
   IntegerRanges(std::initializer_list<Data_t> data);
   
+  
+  // --- BEGIN -- Serialization ------------------------------------------------
+  /// @name Serialization
+  /// @{
+  
+  /// Returns the ranges in compact binary form.
+  std::vector<std::uint8_t> serialize() const
+    { return Base_t::serializeRanges(this->ranges()); }
+  
+  /**
+   * @brief Returns the ranges from their binary form.
+   * @param data pointer to the data from `serialize()`
+   * @param size number of bytes in `data`
+   * @return the ranges
+   * @throw std::runtime_error if `data` is not a valid set of ranges
+   * 
+   * All the `size` bytes must belong to the serialized ranges.
+   * If `CheckGrowing` is `true`, the ranges are also checked to be sorted.
+   */
+  static IntegerRanges deserialize(std::uint8_t const* data, std::size_t size)
+    {
+      return IntegerRanges
+        { Base_t::template deserializeRanges<CheckGrowing>(data, size) };
+    }
+  
+  /// Returns the ranges from their binary form (see `deserialize()`).
+  static IntegerRanges deserialize(std::vector<std::uint8_t> const& data)
+    { return deserialize(data.data(), data.size()); }
+  
+  /// @}
+  // --- END ---- Serialization ------------------------------------------------
+  
+  
+  /// Returns the set of values in either `a` or `b` (linear time).
+  friend IntegerRanges operator|
+    (IntegerRanges const& a, IntegerRanges const& b)
+    { return IntegerRanges{ Base_t::unionRanges(a.ranges(), b.ranges()) }; }
+  
+  /// Returns the set of values in both `a` and `b` (linear time).
+  friend IntegerRanges operator&
+    (IntegerRanges const& a, IntegerRanges const& b)
+    {
+      return IntegerRanges
+        { Base_t::intersectionRanges(a.ranges(), b.ranges()) };
+    }
+  
+    private:
+  
+  /// Constructor: adopts the specified (already compact) ranges.
+  explicit IntegerRanges(std::vector<Range_t> ranges)
+    : Base_t{ std::move(ranges) } {}
+  
 }; // class icarus::IntegerRanges<>
 
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief Collects values one at a time into an `IntegerRanges` object.
+ * @tparam T type of the integral numbers
+ * @tparam CheckGrowing if `true`, an exception is thrown on decreasing values
+ * 
+ * The values are added with `add()`, with the same requirements as the input
+ * of `IntegerRanges` constructors: they must be a growing sequence, with
+ * consecutive duplicates allowed (and ignored). Memory is used only for the
+ * ranges, not for the values.
+ * 
+ * Example collecting channels with a bad status while they are processed:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::IntegerRangesBuilder<raw::ChannelID_t> badChannels;
+ * for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel)
+ *   if (isBad(channel)) badChannels.add(channel);
+ * 
+ * icarus::IntegerRanges<raw::ChannelID_t> const badRanges
+ *   = badChannels.release();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename T /* = int */, bool CheckGrowing /* = false */>
+class icarus::IntegerRangesBuilder {
+  
+    public:
+  using Ranges_t = icarus::IntegerRanges<T, CheckGrowing>;
+  using Data_t = typename Ranges_t::Data_t;
+  using Range_t = typename Ranges_t::Range_t;
+  
+  /// Adds a `value` which must not be smaller than the last one added.
+  /// @throw std::runtime_error if `CheckGrowing` and `value` is smaller
+  IntegerRangesBuilder& add(Data_t value)
+    {
+      Ranges_t::template appendValue<CheckGrowing>(fRanges, value);
+      return *this;
+    }
+  
+  /// Adds all the values between `b` and `e` iterators (see `add()`).
+  template <typename BIter, typename EIter>
+  IntegerRangesBuilder& add(BIter b, EIter e)
+    { while (b != e) add(*b++); return *this; }
+  
+  /// Returns whether no value has been added yet.
+  bool empty() const noexcept { return fRanges.empty(); }
+  
+  /// Returns the number of ranges collected so far.
+  std::size_t nRanges() const noexcept { return fRanges.size(); }
+  
+  /// Returns the ranges collected so far, and resets the builder.
+  Ranges_t release()
+    { Ranges_t ranges { std::move(fRanges) }; fRanges.clear(); return ranges; }
+  
+    private:
+  std::vector<Range_t> fRanges; ///< The ranges collected so far.
+  
+}; // class icarus::IntegerRangesBuilder<>
+
+
 // -----------------------------------------------------------------------------
 /// Returns a `IntegerRanges` object from the elements in `coll`.
 template <bool CheckGrowing, typename Coll>
@@ -337,46 +508,207 @@ decltype(auto) icarus::details::IntegerRangesBase<T>::ranges() const noexcept
 
 // -----------------------------------------------------------------------------
 template <typename T /* = int */>
-template <bool CheckGrowing, typename BIter, typename EIter>
-auto icarus::details::IntegerRangesBase<T>::compactRange(BIter b, EIter e)
+bool icarus::details::IntegerRangesBase<T>::contains
+  (Data_t value) const noexcept
+{
+  // first range starting after `value`; the one before may contain it
+  auto const it = std::upper_bound(fRanges.begin(), fRanges.end(), value,
+    [](Data_t v, Range_t const& r){ return v < r.lower; });
+  return (it != fRanges.begin()) && (value < std::prev(it)->upper);
+} // icarus::details::IntegerRangesBase<>::contains()
+
+
+// -----------------------------------------------------------------------------
+template <typename T /* = int */>
+template <bool CheckGrowing>
+void icarus::details::IntegerRangesBase<T>::appendValue
+  (std::vector<Range_t>& ranges, Data_t value)
+{
+  if (!ranges.empty()) {
+    Range_t& last = ranges.back();
+    Data_t const lastValue = minusOne(last.upper);
+    if (value == lastValue) return; // duplicate entry: quietly skip
+    if constexpr (CheckGrowing) {
+      if (value < lastValue) {
+        using std::to_string;
+        throw std::runtime_error{ "icarus::IntegerRanges"
+          " initialized with non-monotonically growing sequence ("
+          + to_string(lastValue) + " then " + to_string(value)
+          + ")"
+          };
+      }
+    } // if checking growth
+    if (value == last.upper) { // contiguous to previous
+      last.upper = plusOne(value);
+      return;
+    }
+  } // if not the first value
+  
+  ranges.emplace_back(value, plusOne(value));
+  
+} // icarus::details::IntegerRangesBase<>::appendValue()
+
+
+// -----------------------------------------------------------------------------
+template <typename T /* = int */>
+auto icarus::details::IntegerRangesBase<T>::unionRanges
+  (std::vector<Range_t> const& a, std::vector<Range_t> const& b)
   -> std::vector<Range_t>
 {
-  if (b == e) return {};
-  
   std::vector<Range_t> ranges;
+  ranges.reserve(a.size() + b.size());
+  
+  auto ia = a.begin(), ib = b.begin();
+  auto const aend = a.end(), bend = b.end();
+  while ((ia != aend) || (ib != bend)) {
+    // pick the range starting first
+    Range_t const& r
+      = ((ib == bend) || ((ia != aend) && (ia->lower < ib->lower)))
+      ? *ia++: *ib++;
+    // merge into the last one if overlapping or contiguous
+    if (!ranges.empty() && !(ranges.back().upper < r.lower))
+      ranges.back().upper = std::max(ranges.back().upper, r.upper);
+    else
+      ranges.push_back(r);
+  } // while
   
-  auto it = b;
-  auto iPrev = it; // not sure if BIter default-constructible, so copy instead
-  auto iFirst = b;
+  return ranges;
+} // icarus::details::IntegerRangesBase<>::unionRanges()
+
+
+// -----------------------------------------------------------------------------
+template <typename T /* = int */>
+auto icarus::details::IntegerRangesBase<T>::intersectionRanges
+  (std::vector<Range_t> const& a, std::vector<Range_t> const& b)
+  -> std::vector<Range_t>
+{
+  std::vector<Range_t> ranges;
   
-  while (it != e) {
-    
-    iPrev = it++;
-    
-    if (it != e) { // check current and previous elements
-      if (*iPrev == *it) continue; // duplicate entry: quietly skip
-      if constexpr (CheckGrowing) {
-        if (*it < *iPrev) {
-          using std::to_string;
-          throw std::runtime_error{ "icarus::IntegerRanges"
-            " initialized with non-monotonically growing sequence ("
-            + to_string(*iPrev) + " then " + to_string(*it)
-            + ")"
-            };
-        }
-      } // if checking growth
-    } // if not at the end
-    
-    auto const nextExpected = plusOne(*iPrev);
-    
-    if ((it != e) && (*it == nextExpected)) continue; // contiguous to previous
-    
-    ranges.emplace_back(*iFirst, nextExpected);
-    
-    iFirst = it;
-    
+  auto ia = a.begin(), ib = b.begin();
+  auto const aend = a.end(), bend = b.end();
+  while ((ia != aend) && (ib != bend)) {
+    Data_t const lower = std::max(ia->lower, ib->lower);
+    Data_t const upper = std::min(ia->upper, ib->upper);
+    if (lower < upper) ranges.emplace_back(lower, upper);
+    // the range ending first can't overlap with anything else
+    if (ia->upper < ib->upper) ++ia;
+    else ++ib;
   } // while
   
+  return ranges;
+} // icarus::details::IntegerRangesBase<>::intersectionRanges()
+
+
+// -----------------------------------------------------------------------------
+template <typename T /* = int */>
+auto icarus::details::IntegerRangesBase<T>::serializeRanges
+  (std::vector<Range_t> const& ranges) -> std::vector<std::uint8_t>
+{
+  /*
+   * All the arithmetic is performed on 64-bit unsigned integers, where it
+   * wraps around: the values are recovered exactly for any type `T` up to
+   * 64 bits, including negative ones.
+   */
+  std::vector<std::uint8_t> data;
+  data.reserve(1U + 3U * ranges.size());
+  
+  auto const writeVarInt = [&data](std::uint64_t value)
+    {
+      while (value >= 0x80U) {
+        data.push_back(static_cast<std::uint8_t>(value | 0x80U));
+        value >>= 7U;
+      }
+      data.push_back(static_cast<std::uint8_t>(value));
+    };
+  auto const zigzag = [](std::uint64_t value) -> std::uint64_t
+    {
+      return (value << 1U)
+        ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63U);
+    };
+  
+  writeVarInt(ranges.size());
+  std::uint64_t prevUpper = 0U;
+  for (Range_t const& range: ranges) {
+    std::uint64_t const lower = static_cast<std::uint64_t>(range.lower);
+    std::uint64_t const upper = static_cast<std::uint64_t>(range.upper);
+    writeVarInt(zigzag(lower - prevUpper));
+    writeVarInt(upper - lower - 1U);
+    prevUpper = upper;
+  } // for
+  
+  return data;
+} // icarus::details::IntegerRangesBase<>::serializeRanges()
+
+
+// -----------------------------------------------------------------------------
+template <typename T /* = int */>
+template <bool CheckGrowing>
+auto icarus::details::IntegerRangesBase<T>::deserializeRanges
+  (std::uint8_t const* data, std::size_t size) -> std::vector<Range_t>
+{
+  std::uint8_t const* const end = data + size;
+  
+  auto const error = [](std::string const& msg)
+    {
+      return std::runtime_error
+        { "icarus::IntegerRanges::deserialize(): " + msg };
+    };
+  auto const readVarInt = [&data,end,&error]() -> std::uint64_t
+    {
+      std::uint64_t value = 0U;
+      for (unsigned int shift = 0U; shift < 64U; shift += 7U) {
+        if (data == end) throw error("data is truncated");
+        std::uint8_t const byte = *data++;
+        value |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+        if (!(byte & 0x80U)) return value;
+      }
+      throw error("invalid variable-length integer");
+    };
+  auto const unzigzag = [](std::uint64_t value) -> std::uint64_t
+    { return (value >> 1U) ^ (~(value & 1U) + 1U); };
+  auto const toData = [&error](std::uint64_t value) -> Data_t
+    {
+      Data_t const v = static_cast<Data_t>(value);
+      if (static_cast<std::uint64_t>(v) != value)
+        throw error("value out of range of the data type");
+      return v;
+    };
+  
+  std::uint64_t const nRanges = readVarInt();
+  if (nRanges > size) throw error("data is truncated"); // 2 bytes per range
+  
+  std::vector<Range_t> ranges;
+  ranges.reserve(nRanges);
+  std::uint64_t prevUpper = 0U;
+  for (std::uint64_t i = 0; i < nRanges; ++i) {
+    std::uint64_t const lower = prevUpper + unzigzag(readVarInt());
+    std::uint64_t const upper = lower + readVarInt() + 1U;
+    Range_t const range { toData(lower), toData(upper) };
+    if constexpr (CheckGrowing) {
+      if (!(range.lower < range.upper)
+        || (!ranges.empty() && !(ranges.back().upper < range.lower))
+      ) {
+        throw error("ranges are not sorted");
+      }
+    } // if checking growth
+    ranges.push_back(range);
+    prevUpper = upper;
+  } // for
+  
+  if (data != end) throw error("unexpected data after the ranges");
+  
+  return ranges;
+} // icarus::details::IntegerRangesBase<>::deserializeRanges()
+
+
+// -----------------------------------------------------------------------------
+template <typename T /* = int */>
+template <bool CheckGrowing, typename BIter, typename EIter>
+auto icarus::details::IntegerRangesBase<T>::compactRange(BIter b, EIter e)
+  -> std::vector<Range_t>
+{
+  std::vector<Range_t> ranges;
+  while (b != e) appendValue<CheckGrowing>(ranges, *b++);
   return ranges;
 } // icarus::details::IntegerRangesBase<>::compactRange()
 
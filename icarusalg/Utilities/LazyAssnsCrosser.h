@@ -0,0 +1,436 @@
+/**
+ * @file icarusalg/Utilities/LazyAssnsCrosser.h
+ * @brief Multi-hop associations resolved only for the requested keys.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ * @see icarusalg/Utilities/AssnsCrosser.h
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_UTILITIES_LAZYASSNSCROSSER_H
+#define ICARUSALG_UTILITIES_LAZYASSNSCROSSER_H
+
+// ICARUS libraries
+#include "icarusalg/Utilities/AssnsCrosser.h"
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/DebugUtils.h" // lar::debug::demangle()
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+#include "canvas/Utilities/Exception.h"
+
+// Guideline Support Library
+#include "gsl/span"
+
+// C/C++ standard libraries
+#include <algorithm> // std::stable_sort(), std::equal_range()
+#include <utility> // std::move(), std::pair, std::index_sequence
+#include <vector>
+#include <unordered_map>
+#include <tuple>
+#include <string>
+#include <stdexcept> // std::logic_error
+#include <cstddef>
+
+
+namespace icarus::ns::util {
+
+  template <typename KeyType, typename... OtherTypes> class LazyAssnsCrosser;
+
+  template <typename KeyType, typename... OtherTypes, typename Event>
+  LazyAssnsCrosser<KeyType, OtherTypes...> makeLazyAssnsCrosser
+    (Event const& event, InputSpecs<OtherTypes>... inputSpecs);
+
+  namespace details {
+    template <typename Left, typename Right> class LazyHopIndex;
+  } // namespace details
+
+} // namespace icarus::ns::util
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Multi-hop associations resolved only for the keys which are queried.
+ * @tparam Key the type of the data to associate to
+ * @tparam OtherTypes intermediate types to reach the target type (the last one)
+ * @see `icarus::ns::util::AssnsCrosser`
+ *
+ * This class has the same query interface as `AssnsCrosser` (`assPtrs()` and
+ * `assPtr()`), but it does not join the associations of all the keys on
+ * construction. Instead, on construction it only reads the association data
+ * products of each hop, and when the targets of a key are first requested:
+ *  1. the associations of each hop on the way are indexed by their left
+ *     object (once per hop: the associations of all the data products of the
+ *     hop are sorted by left _art_ pointer);
+ *  2. the key is followed through the hops by binary search in those indices;
+ *  3. the result is kept, so that following requests for the same key are
+ *     answered directly.
+ *
+ * The cost after reading the data products is then proportional to the
+ * number of keys queried (and to the number of objects they are associated
+ * with) rather than to the size of the associations, which is convenient when
+ * only a few keys are of interest, like a few candidate neutrino slices among
+ * all the slices of the event. When the targets of most of the keys are
+ * needed, `AssnsCrosser` is faster.
+ *
+ * The targets associated to a key are the same as with `AssnsCrosser`,
+ * including the duplicates from "diamond" associations. They are sorted by the
+ * order of the associations in each hop, in the order of the data products as
+ * specified.
+ *
+ * All the hops must be explicitly specified (input tags or product IDs of all
+ * the association data products): the autodetection of the data products
+ * supported by `AssnsCrosser` is not available here.
+ *
+ * The association data products must stay available for the whole life of
+ * this object, i.e. it should not outlive the event it was created from.
+ * Queries modify the cached content of this object, and they must not be
+ * performed concurrently.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * using icarus::ns::util::hopTo;
+ * auto const sliceToHits = icarus::ns::util::makeLazyAssnsCrosser<recob::Slice>
+ *   (event, hopTo<recob::PFParticle>{ "pandora" },
+ *    hopTo<recob::Cluster>{ "pandora" }, hopTo<recob::Hit>{ "pandora" });
+ *
+ * for (art::Ptr<recob::Slice> const& slice: candidateSlices) {
+ *   gsl::span<art::Ptr<recob::Hit> const> const hits
+ *     = sliceToHits.assPtrs(slice);
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename KeyType, typename... OtherTypes>
+class icarus::ns::util::LazyAssnsCrosser
+  : public details::AssnsCrosserTypes<KeyType, OtherTypes...>
+{
+
+  using This_t = LazyAssnsCrosser<KeyType, OtherTypes...>;
+
+    public:
+
+  using KeyPtr_t = typename This_t::KeyPtr_t;
+  using TargetPtr_t = typename This_t::TargetPtr_t;
+  using TargetPtrs_t = typename This_t::TargetPtrs_t;
+  using TargetPtrSpan_t = typename This_t::TargetPtrSpan_t;
+
+  /**
+   * @brief Constructor: reads the specified associations.
+   * @tparam Event type to read the data from (`art::Event` interface)
+   * @param event data source
+   * @param otherInputSpecs input specifications for all the hops
+   * @throw std::logic_error if the specifications of a hop are missing
+   *
+   * There needs to be one input specification for each hop, the first
+   * specification being the one from the key to the first intermediate object
+   * type, and each must explicitly list all the data products of the hop.
+   * The associations are read, but not indexed or joined yet.
+   */
+  template <typename Event>
+  LazyAssnsCrosser
+    (Event const& event, InputSpecs<OtherTypes>... otherInputSpecs);
+
+  /**
+   * @brief Returns pointers to all target objects associated to `keyPtr`.
+   * @param keyPtr pointer to the key object to find the associated objects of
+   * @return a list pointers to all target objects associated to `keyPtr`
+   * @see `AssnsCrosser::assPtrs()`
+   *
+   * The result is the same as `AssnsCrosser::assPtrs()`.
+   * The returned span points to memory owned by this object, and it is valid
+   * as long as this object is.
+   */
+  TargetPtrSpan_t assPtrs(KeyPtr_t const& keyPtr) const;
+
+  /**
+   * @brief Returns a pointer to the target object associated to `keyPtr`.
+   * @param keyPtr pointer to the key object to find the associated objects of
+   * @return a pointer to the target object associated to `keyPtr`
+   * @throw art::Exception (code: `art::errors::LogicError`) if there are more
+   *        than one target pointer associated to the specified key
+   * @see `AssnsCrosser::assPtr()`
+   */
+  TargetPtr_t const& assPtr(KeyPtr_t const& keyPtr) const;
+
+
+  /// Returns the number of keys resolved so far.
+  std::size_t nResolvedKeys() const noexcept { return fResolved.size(); }
+
+  /// Returns the number of hops indexed so far.
+  std::size_t nIndexedHops() const noexcept
+    { return nIndexedHops(std::make_index_sequence<NHops>{}); }
+
+
+    private:
+
+  using Key_t = typename This_t::Key_t;
+  using Target_t = typename This_t::Target_t;
+
+  /// Number of hops.
+  static constexpr std::size_t NHops = sizeof...(OtherTypes);
+
+  /// All the types, from the key to the target.
+  using Types_t = std::tuple<KeyType, OtherTypes...>;
+
+  /// Type of the index of the hop number `I`.
+  template <std::size_t I>
+  using HopIndex_t = details::LazyHopIndex
+    <std::tuple_element_t<I, Types_t>, std::tuple_element_t<I + 1, Types_t>>;
+
+  template <std::size_t... I>
+  static std::tuple<HopIndex_t<I>...> hopsType(std::index_sequence<I...>);
+
+  /// Type of the indices of all the hops.
+  using Hops_t = decltype(hopsType(std::make_index_sequence<NHops>{}));
+
+
+  Hops_t fHops; ///< Associations of each hop.
+
+  /// Targets of each key resolved so far.
+  mutable std::unordered_map<KeyPtr_t, TargetPtrs_t> fResolved;
+
+
+  static TargetPtr_t const NullTargetPtr; ///< Used as return reference value.
+
+
+  /// Reads the associations of all the hops.
+  template <typename Event, typename Specs, std::size_t... I>
+  static Hops_t readHops
+    (Event const& event, Specs&& specs, std::index_sequence<I...>);
+
+  /// Reads the associations of the hop `I`.
+  template <std::size_t I, typename Event, typename T>
+  static HopIndex_t<I> readHop(Event const& event, InputSpecs<T>&& specs);
+
+  /// Follows the `frontier` objects from the hop `I` to the target.
+  template <std::size_t I, typename Left>
+  void follow
+    (std::vector<art::Ptr<Left>> const& frontier, TargetPtrs_t& targets) const;
+
+  template <std::size_t... I>
+  std::size_t nIndexedHops(std::index_sequence<I...>) const noexcept
+    { return (0U + ... + (std::get<I>(fHops).indexed()? 1U: 0U)); }
+
+}; // icarus::ns::util::LazyAssnsCrosser
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Associations of a single hop, indexed by left object on demand.
+ * @tparam Left type on the left side of the associations
+ * @tparam Right type on the right side of the associations
+ *
+ * The index is created the first time the associated objects are requested.
+ */
+template <typename Left, typename Right>
+class icarus::ns::util::details::LazyHopIndex {
+
+    public:
+
+  using Assns_t = art::Assns<Left, Right>;
+
+  /// Constructor: will index the associations in all the `assnsList`.
+  LazyHopIndex(std::vector<Assns_t const*> assnsList)
+    : fAssnsList{ std::move(assnsList) } {}
+
+  /// Appends to `rights` all the objects associated to `left`.
+  void appendRights
+    (art::Ptr<Left> const& left, std::vector<art::Ptr<Right>>& rights) const;
+
+  /// Returns whether the index has been created already.
+  bool indexed() const noexcept { return fIndexed; }
+
+    private:
+
+  std::vector<Assns_t const*> fAssnsList; ///< Associations to be indexed.
+
+  mutable bool fIndexed = false; ///< Whether the index has been created.
+
+  mutable std::vector<art::Ptr<Left>> fLefts; ///< All left objects, sorted.
+  mutable std::vector<art::Ptr<Right>> fRights; ///< Right objects, by left.
+
+  /// Fills the index.
+  void makeIndex() const;
+
+}; // icarus::ns::util::details::LazyHopIndex
+
+
+// -----------------------------------------------------------------------------
+// ---  Implementation
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::details::LazyHopIndex
+// -----------------------------------------------------------------------------
+template <typename Left, typename Right>
+void icarus::ns::util::details::LazyHopIndex<Left, Right>::appendRights
+  (art::Ptr<Left> const& left, std::vector<art::Ptr<Right>>& rights) const
+{
+  if (!fIndexed) makeIndex();
+  auto const [ begin, end ]
+    = std::equal_range(fLefts.cbegin(), fLefts.cend(), left);
+  rights.insert(rights.end(),
+    fRights.cbegin() + (begin - fLefts.cbegin()),
+    fRights.cbegin() + (end - fLefts.cbegin())
+    );
+} // icarus::ns::util::details::LazyHopIndex<>::appendRights()
+
+
+// -----------------------------------------------------------------------------
+template <typename Left, typename Right>
+void icarus::ns::util::details::LazyHopIndex<Left, Right>::makeIndex() const {
+
+  std::size_t nAssns = 0;
+  for (Assns_t const* assns: fAssnsList) nAssns += assns->size();
+
+  std::vector<std::pair<art::Ptr<Left>, art::Ptr<Right>>> pairs;
+  pairs.reserve(nAssns);
+  for (Assns_t const* assns: fAssnsList)
+    for (auto const& assn: *assns) pairs.emplace_back(assn.first, assn.second);
+
+  // stable, to preserve the order of the associations of each left object
+  std::stable_sort(pairs.begin(), pairs.end(),
+    [](auto const& a, auto const& b){ return a.first < b.first; });
+
+  fLefts.reserve(nAssns);
+  fRights.reserve(nAssns);
+  for (auto& [ left, right ]: pairs) {
+    fLefts.push_back(std::move(left));
+    fRights.push_back(std::move(right));
+  }
+
+  fIndexed = true;
+} // icarus::ns::util::details::LazyHopIndex<>::makeIndex()
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::ns::util::LazyAssnsCrosser
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+typename icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::TargetPtr_t
+const icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::NullTargetPtr;
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <typename Event>
+icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::LazyAssnsCrosser(
+  Event const& event,
+  InputSpecs<OtherTypes>... otherInputSpecs
+)
+  : fHops{
+    readHops(event, std::forward_as_tuple(std::move(otherInputSpecs)...),
+      std::make_index_sequence<NHops>{})
+    }
+{}
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+auto icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::assPtrs
+  (KeyPtr_t const& keyPtr) const -> TargetPtrSpan_t
+{
+  auto it = fResolved.find(keyPtr);
+  if (it == fResolved.end()) {
+    TargetPtrs_t targets;
+    follow<0U>(std::vector<KeyPtr_t>{ keyPtr }, targets);
+    it = fResolved.emplace(keyPtr, std::move(targets)).first;
+  }
+  return { it->second.data(), it->second.size() };
+} // icarus::ns::util::LazyAssnsCrosser<>::assPtrs()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+auto icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::assPtr
+  (KeyPtr_t const& keyPtr) const -> TargetPtr_t const&
+{
+  TargetPtrSpan_t const targets = assPtrs(keyPtr);
+  if (targets.size() > 1) {
+    // using LogicError because that's what art::FindOne does
+    throw art::Exception{ art::errors::LogicError }
+      << "LazyAssnsCrosser::assPtr(): there are " << targets.size() << " "
+      << lar::debug::demangle<Target_t>() << " objects associated to Ptr<"
+      << lar::debug::demangle<Key_t>() << ">=" << keyPtr << "!\n";
+  }
+  return targets.empty()? NullTargetPtr: targets[0];
+} // icarus::ns::util::LazyAssnsCrosser<>::assPtr()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <typename Event, typename Specs, std::size_t... I>
+auto icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::readHops
+  (Event const& event, Specs&& specs, std::index_sequence<I...>) -> Hops_t
+{
+  return { readHop<I>(event, std::move(std::get<I>(specs)))... };
+} // icarus::ns::util::LazyAssnsCrosser<>::readHops()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <std::size_t I, typename Event, typename T>
+auto icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::readHop
+  (Event const& event, InputSpecs<T>&& specs) -> HopIndex_t<I>
+{
+  using Assns_t = typename HopIndex_t<I>::Assns_t;
+
+  if (specs.empty() || specs.hasEmptySpecs()) {
+    throw std::logic_error{ "LazyAssnsCrosser: hop #" + std::to_string(I)
+      + " (" + lar::debug::demangle<typename Assns_t::left_t>() + " => "
+      + lar::debug::demangle<typename Assns_t::right_t>()
+      + ") needs the explicit specification of all its data products."
+      };
+  }
+
+  std::vector<art::InputTag> const tags
+    = details::MapJoiner<KeyType, OtherTypes...>::extractTagList
+      (std::move(specs), event);
+
+  std::vector<Assns_t const*> assnsList;
+  assnsList.reserve(tags.size());
+  for (art::InputTag const& tag: tags)
+    assnsList.push_back(&(event.template getProduct<Assns_t>(tag)));
+
+  return { std::move(assnsList) };
+} // icarus::ns::util::LazyAssnsCrosser<>::readHop()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes>
+template <std::size_t I, typename Left>
+void icarus::ns::util::LazyAssnsCrosser<KeyType, OtherTypes...>::follow
+  (std::vector<art::Ptr<Left>> const& frontier, TargetPtrs_t& targets) const
+{
+  using Right_t = std::tuple_element_t<I + 1, Types_t>;
+
+  HopIndex_t<I> const& hop = std::get<I>(fHops);
+  if constexpr (I + 1 == NHops) {
+    for (art::Ptr<Left> const& left: frontier) hop.appendRights(left, targets);
+  }
+  else {
+    std::vector<art::Ptr<Right_t>> next;
+    for (art::Ptr<Left> const& left: frontier) hop.appendRights(left, next);
+    if (!next.empty()) follow<I + 1>(next, targets);
+  }
+} // icarus::ns::util::LazyAssnsCrosser<>::follow()
+
+
+// -----------------------------------------------------------------------------
+template <typename KeyType, typename... OtherTypes, typename Event>
+auto icarus::ns::util::makeLazyAssnsCrosser(
+  Event const& event,
+  InputSpecs<OtherTypes>... inputSpecs
+) -> LazyAssnsCrosser<KeyType, OtherTypes...>
+{
+  return
+    LazyAssnsCrosser<KeyType, OtherTypes...>(event, std::move(inputSpecs)...);
+}
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_LAZYASSNSCROSSER_H
@@ -0,0 +1,161 @@
+/**
+ * @file   icarusalg/Utilities/LazyEventCache.h
+ * @brief  Cache of values computed on demand, valid for a single event.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_UTILITIES_LAZYEVENTCACHE_H
+#define ICARUSALG_UTILITIES_LAZYEVENTCACHE_H
+
+
+// ICARUS libraries
+#include "icarusalg/Utilities/ChangeMonitor.h"
+
+// C/C++ standard libraries
+#include <unordered_map>
+#include <memory> // std::unique_ptr
+#include <mutex> // std::once_flag, std::call_once()
+#include <optional>
+#include <functional> // std::hash<>
+#include <utility> // std::forward()
+#include <cstddef> // std::size_t
+
+
+namespace icarus::ns::util {
+
+  //----------------------------------------------------------------------------
+  /**
+   * @brief Cache of values computed on first request, cleared at each event.
+   * @tparam Key type of the key identifying each value (e.g. a pointer)
+   * @tparam Value type of the cached value
+   * @tparam EventID type of the event identifier (e.g. `art::EventID`)
+   * @tparam Hash hash function for the key
+   *
+   * The cache is told the current event with `setEvent()`, and when the event
+   * identifier changes (as detected by `icarus::ns::util::ChangeMonitor`) all
+   * the cached values are dropped.
+   * The value for a key is computed by the function passed to `get()` the
+   * first time that key is requested in the event, and then returned from the
+   * cache on all the following requests.
+   *
+   * Example of usage, caching the baseline of each waveform:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * icarus::ns::util::LazyEventCache
+   *   <raw::OpDetWaveform const*, double, art::EventID> baselines;
+   *
+   * baselines.setEvent(event.eventAuxiliary().id());
+   * for (raw::OpDetWaveform const& waveform: waveforms) {
+   *   double const baseline = baselines.get
+   *     (&waveform, [](raw::OpDetWaveform const* wf){ return extract(*wf); });
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   *
+   *
+   * Multithreading
+   * ---------------
+   *
+   * `get()` can be called concurrently: each value is computed only once,
+   * by the first thread requesting it, while other threads requesting it wait.
+   * Values for different keys are computed concurrently.
+   * The references returned by `get()` are valid until the cache is cleared.
+   * `setEvent()` and `clear()` must not be called concurrently with any other
+   * method.
+   */
+  template <
+    typename Key, typename Value, typename EventID,
+    typename Hash = std::hash<Key>
+    >
+  class LazyEventCache {
+
+      public:
+
+    using Key_t = Key; ///< Type of key of the cached values.
+    using Value_t = Value; ///< Type of cached value.
+    using EventID_t = EventID; ///< Type of event identifier.
+
+
+    /**
+     * @brief Sets the current event, clearing the cache if it has changed.
+     * @param id identifier of the current event
+     * @return whether the cache was cleared
+     */
+    bool setEvent(EventID_t const& id)
+      {
+        if (!fEventMonitor(id)) return false;
+        clear();
+        return true;
+      }
+
+    /**
+     * @brief Returns the value for `key`, computing it if not cached yet.
+     * @tparam Compute type of functor computing the value
+     * @param key the key of the value
+     * @param compute functor returning the value, called as `compute(key)`
+     * @return a reference to the cached value for `key`
+     *
+     * If `compute` throws an exception, nothing is cached and the next request
+     * of the same `key` will attempt the computation again.
+     */
+    template <typename Compute>
+    Value_t const& get(Key_t const& key, Compute&& compute)
+      {
+        Entry_t& entry = entryFor(key);
+        std::call_once(entry.computed,
+          [&entry,&key,&compute](){ entry.value.emplace(compute(key)); });
+        return *(entry.value);
+      }
+
+    /// Returns whether a value for `key` has been requested in this event.
+    bool has(Key_t const& key) const
+      {
+        std::lock_guard lg { fLock };
+        return fEntries.count(key) > 0;
+      }
+
+    /// Returns the number of values requested in this event.
+    std::size_t size() const
+      { std::lock_guard lg { fLock }; return fEntries.size(); }
+
+    /// Removes all the cached values.
+    void clear() { std::lock_guard lg { fLock }; fEntries.clear(); }
+
+
+      private:
+
+    /// Cache element (whose address does not change).
+    struct Entry_t {
+      std::once_flag computed; ///< Whether the value has been computed.
+      std::optional<Value_t> value; ///< The cached value.
+    }; // Entry_t
+
+    /// The event the cached values belong to.
+    ChangeMonitor<EventID_t> fEventMonitor;
+
+    /// Cached values.
+    std::unordered_map<Key_t, std::unique_ptr<Entry_t>, Hash> fEntries;
+
+    mutable std::mutex fLock; ///< Lock for the access to the entry list.
+
+
+    /// Returns the entry for `key`, creating an empty one if needed.
+    Entry_t& entryFor(Key_t const& key)
+      {
+        std::lock_guard lg { fLock };
+        std::unique_ptr<Entry_t>& entry = fEntries[key];
+        if (!entry) entry = std::make_unique<Entry_t>();
+        return *entry;
+      }
+
+  }; // LazyEventCache
+
+
+  // ---------------------------------------------------------------------------
+
+} // namespace icarus::ns::util
+
+
+#endif // ICARUSALG_UTILITIES_LAZYEVENTCACHE_H
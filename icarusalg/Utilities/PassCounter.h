@@ -81,6 +81,9 @@ class icarus::ns::util::PassCounter {
   /// Resets all counts.
   void reset();
   
+  /// Sets all counts at once (e.g. from a saved state).
+  void restore(Count_t total, Count_t passed);
+  
   /// @}
   // --- END ---- Registration and reset ---------------------------------------
   
@@ -127,6 +130,18 @@ void icarus::ns::util::PassCounter<Count>::reset() {
 } // icarus::ns::util::PassCounter<>::reset()
 
 
+// -----------------------------------------------------------------------------
+template <typename Count>
+void icarus::ns::util::PassCounter<Count>::restore
+  (Count_t total, Count_t passed)
+{
+  
+  fTotal = total;
+  fPassed = passed;
+  
+} // icarus::ns::util::PassCounter<>::restore()
+
+
 // -----------------------------------------------------------------------------
 
 #endif // ICARUSALG_UTILITIES_PASSCOUNTER_H
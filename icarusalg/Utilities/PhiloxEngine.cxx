@@ -0,0 +1,243 @@
+/**
+ * @file   icarusalg/Utilities/PhiloxEngine.cxx
+ * @brief  Counter-based random engine (Philox4x32-10) (implementation).
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Utilities/PhiloxEngine.h`
+ *
+ */
+
+// library header
+#include "icarusalg/Utilities/PhiloxEngine.h"
+
+// CLHEP
+#include "CLHEP/Random/engineIDulong.h"
+
+// C/C++ standard library
+#include <fstream>
+#include <iostream> // std::cout
+#include <algorithm> // std::copy()
+
+
+// -----------------------------------------------------------------------------
+util::PhiloxEngine::PhiloxEngine(std::uint64_t seed, std::uint64_t stream) {
+
+  fKey = {
+    static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)
+    };
+  fCounter[2] = static_cast<std::uint32_t>(stream);
+  fCounter[3] = static_cast<std::uint32_t>(stream >> 32);
+  restart();
+  updateSeed();
+
+} // util::PhiloxEngine::PhiloxEngine()
+
+
+// -----------------------------------------------------------------------------
+util::PhiloxEngine::PhiloxEngine(std::istream& is): PhiloxEngine() { get(is); }
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::flatArray(const int size, double* vect) {
+
+  double* const end = vect + size;
+  while (vect != end) *(vect++) = flat();
+
+} // util::PhiloxEngine::flatArray()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::discard(std::uint64_t n) {
+
+  // use up the current block first
+  while ((n > 0U) && (fWord <= 2U)) { fWord += 2U; --n; }
+  if (n == 0U) return;
+
+  // skip the blocks which are entirely discarded
+  std::uint64_t block = join(fCounter[0], fCounter[1]) + n / 2U;
+  fCounter[0] = static_cast<std::uint32_t>(block);
+  fCounter[1] = static_cast<std::uint32_t>(block >> 32);
+  fWord = 4U;
+
+  // the last one is discarded only in half
+  if (n % 2U) { nextBlock(); fWord = 2U; }
+
+} // util::PhiloxEngine::discard()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::setSeed(long seed, int) {
+
+  auto const key = static_cast<std::uint64_t>(seed);
+  fKey = {
+    static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)
+    };
+  restart();
+  updateSeed();
+
+} // util::PhiloxEngine::setSeed()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::setSeeds(long const* seeds, int n /* = 0 */) {
+
+  // CLHEP convention: with no size, the list is terminated by a 0
+  bool const hasStream
+    = (n > 0)? (n > 1): ((seeds[0] != 0) && (seeds[1] != 0));
+  if (hasStream) setStream(static_cast<std::uint64_t>(seeds[1]));
+  setSeed(seeds[0]);
+  theSeeds = seeds;
+
+} // util::PhiloxEngine::setSeeds()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::setStream(std::uint64_t stream) {
+
+  fCounter[2] = static_cast<std::uint32_t>(stream);
+  fCounter[3] = static_cast<std::uint32_t>(stream >> 32);
+  restart();
+
+} // util::PhiloxEngine::setStream()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::saveStatus
+  (const char filename[] /* = "PhiloxEngine.conf" */) const
+{
+  std::ofstream f { filename };
+  if (!f) return; // shouldn't we complain? HepJamesRandom does not
+
+  put(f);
+
+} // util::PhiloxEngine::saveStatus()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::restoreStatus
+  (const char filename[] /* = "PhiloxEngine.conf" */)
+{
+  std::ifstream f { filename };
+  if (!f) return; // shouldn't we complain? HepJamesRandom does not
+
+  get(f);
+
+} // util::PhiloxEngine::restoreStatus()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::showStatus() const {
+
+  std::cout << "--------- " << engineName() << " engine status ---------"
+    << "\n Seed (key):  " << seed()
+    << "\n Stream:      " << stream()
+    << "\n Block:       " << join(fCounter[0], fCounter[1])
+    << " (next word: " << fWord << ")"
+    << "\n----------------------------------------------" << std::endl;
+
+} // util::PhiloxEngine::showStatus()
+
+
+// -----------------------------------------------------------------------------
+std::ostream& util::PhiloxEngine::put(std::ostream& os) const {
+
+  std::vector<unsigned long> const state = put();
+
+  os << beginTag() << "\n";
+  for (auto it = state.begin() + 1; it != state.end(); ++it) os << *it << " ";
+  os << "\n" << endTag() << "\n";
+
+  return os;
+} // util::PhiloxEngine::put()
+
+
+// -----------------------------------------------------------------------------
+std::istream& util::PhiloxEngine::get(std::istream& is) {
+
+  std::string tag;
+  is >> tag;
+  if (tag != beginTag()) {
+    std::cerr << "Input stream does not contain a " << engineName()
+      << " status (found '" << tag << "')\n";
+    is.setstate(std::ios::failbit);
+    return is;
+  }
+  return getState(is);
+
+} // util::PhiloxEngine::get()
+
+
+// -----------------------------------------------------------------------------
+std::istream& util::PhiloxEngine::getState(std::istream& is) {
+
+  std::vector<unsigned long> state(VectorSize);
+  state[0] = CLHEP::engineIDulong<PhiloxEngine>();
+  for (auto it = state.begin() + 1; it != state.end(); ++it) is >> *it;
+
+  std::string tag;
+  is >> tag;
+  if (!is || (tag != endTag()) || !getState(state)) {
+    std::cerr << "Invalid " << engineName() << " status in input stream\n";
+    is.setstate(std::ios::failbit);
+  }
+  return is;
+
+} // util::PhiloxEngine::getState()
+
+
+// -----------------------------------------------------------------------------
+std::vector<unsigned long> util::PhiloxEngine::put() const {
+
+  return {
+    CLHEP::engineIDulong<PhiloxEngine>(),
+    fKey[0], fKey[1],
+    fCounter[0], fCounter[1], fCounter[2], fCounter[3],
+    fWord
+    };
+
+} // util::PhiloxEngine::put()
+
+
+// -----------------------------------------------------------------------------
+bool util::PhiloxEngine::get(std::vector<unsigned long> const& v) {
+
+  if (v.empty() || (v[0] != CLHEP::engineIDulong<PhiloxEngine>())) {
+    std::cerr << "PhiloxEngine::get(): vector has wrong ID word"
+      " - state unchanged\n";
+    return false;
+  }
+  return getState(v);
+
+} // util::PhiloxEngine::get()
+
+
+// -----------------------------------------------------------------------------
+bool util::PhiloxEngine::getState(std::vector<unsigned long> const& v) {
+
+  if ((v.size() != VectorSize) || (v[7] > 4U)) {
+    std::cerr << "PhiloxEngine::getState(): vector has wrong length or content"
+      " - state unchanged\n";
+    return false;
+  }
+
+  std::copy(v.begin() + 1, v.begin() + 3, fKey.begin());
+  std::copy(v.begin() + 3, v.begin() + 7, fCounter.begin());
+  fWord = static_cast<unsigned int>(v[7]);
+  if (fWord < 4U) fBlock = generate(fCounter, fKey);
+  updateSeed();
+  return true;
+
+} // util::PhiloxEngine::getState()
+
+
+// -----------------------------------------------------------------------------
+void util::PhiloxEngine::restart() {
+
+  // the first block generated will have position 0
+  fCounter[0] = fCounter[1] = ~std::uint32_t{ 0 };
+  fWord = 4U;
+
+} // util::PhiloxEngine::restart()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,248 @@
+/**
+ * @file   icarusalg/Utilities/PhiloxEngine.h
+ * @brief  Counter-based random engine (Philox4x32-10) with CLHEP interface.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 14, 2026
+ * @see    `icarusalg/Utilities/PhiloxEngine.cxx`
+ */
+
+#ifndef ICARUSALG_UTILITIES_PHILOXENGINE_H
+#define ICARUSALG_UTILITIES_PHILOXENGINE_H
+
+// CLHEP
+#include "CLHEP/Random/defs.h"
+#include "CLHEP/Random/RandomEngine.h"
+
+// C/C++ standard library
+#include <array>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+
+// -----------------------------------------------------------------------------
+namespace util { class PhiloxEngine; }
+
+/**
+ * @brief Counter-based random engine, implementing Philox4x32-10.
+ *
+ * This engine implements the Philox4x32 algorithm with 10 rounds, by
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw ("Parallel random
+ * numbers: as easy as 1, 2, 3", SC'11), which produces 128 pseudorandom bits
+ * as a function of a 128-bit counter and a 64-bit key, with no other state.
+ *
+ * The key is the seed of the engine, and the counter is split in two halves:
+ * the upper one identifies an independent stream (for example, a channel
+ * number), the lower one is the position in that stream. Therefore, the
+ * random sequence for a given seed (for example, derived from the event
+ * number) and stream can be generated by any thread, at any time and in any
+ * order, with the same result, and with no coordination among threads:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * // in any thread, for any channel:
+ * util::PhiloxEngine engine { eventSeed, channel };
+ * util::RandFastGauss noise { engine, 0.0, noiseRMS };
+ * noise.fireArray(nSamples, samples.data());
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Each stream has 2^64^ blocks of 128 bits, and any position can be reached
+ * directly (`discard()`). The raw algorithm is also exposed as `generate()`.
+ *
+ * Each `flat()` number uses 64 bits (two per block) and has 53 bits of
+ * resolution, in the interval ] 0, 1 [.
+ *
+ * The engine fully supports the CLHEP interface for seeding and for saving
+ * and restoring its status.
+ */
+class util::PhiloxEngine: public CLHEP::HepRandomEngine {
+
+    public:
+
+  using Counter_t = std::array<std::uint32_t, 4U>; ///< Counter of Philox4x32.
+  using Key_t = std::array<std::uint32_t, 2U>; ///< Key of Philox4x32.
+  using Block_t = std::array<std::uint32_t, 4U>; ///< Output of Philox4x32.
+
+  /// Number of rounds of the algorithm.
+  static constexpr unsigned int NRounds = 10U;
+
+
+  /// Constructor: seed `0`, stream `0`.
+  PhiloxEngine(): PhiloxEngine(0U, 0U) {}
+
+  /// Constructor: specified seed, stream `0`.
+  explicit PhiloxEngine(long seed)
+    : PhiloxEngine(static_cast<std::uint64_t>(seed), 0U) {}
+
+  /// Constructor: specified seed and stream.
+  PhiloxEngine(std::uint64_t seed, std::uint64_t stream);
+
+  /// Constructor: reads the status from a stream (as written by `put()`).
+  explicit PhiloxEngine(std::istream& is);
+
+
+  // --- BEGIN -- Generation ---------------------------------------------------
+  /// Returns a pseudorandom number uniformly distributed in ] 0, 1 [.
+  virtual double flat() override
+    {
+      if (fWord > 2U) nextBlock();
+      std::uint64_t const bits
+        = (std::uint64_t{ fBlock[fWord] } << 32) | fBlock[fWord + 1];
+      fWord += 2U;
+      return toDouble(bits);
+    }
+
+  /// Fills `vect` with `size` numbers, as `size` calls to `flat()` would.
+  virtual void flatArray(const int size, double* vect) override;
+
+  /// Returns 32 pseudorandom bits.
+  virtual operator unsigned int() override
+    {
+      if (fWord > 3U) nextBlock();
+      return fBlock[fWord++];
+    }
+
+  /// Skips the next `n` `flat()` numbers.
+  void discard(std::uint64_t n);
+
+  /// Returns the output block of Philox4x32-10 for `counter` and `key`.
+  static Block_t generate(Counter_t counter, Key_t key);
+
+  // --- END ---- Generation ---------------------------------------------------
+
+
+  // --- BEGIN -- Seeds and streams --------------------------------------------
+  /// Sets the seed (key) and restarts the current stream.
+  virtual void setSeed(long seed, int = 0) override;
+
+  /**
+   * @brief Sets seed and, optionally, stream, and restarts the stream.
+   * @param seeds the seed (`seeds[0]`) and the stream (`seeds[1]`)
+   * @param n the number of values in `seeds`
+   *
+   * If `n` is `1`, only the seed is set.
+   * If `n` is `0` or negative, `seeds` is a list terminated by a `0` value
+   * (CLHEP convention).
+   */
+  virtual void setSeeds(long const* seeds, int n = 0) override;
+
+  /// Returns the current seed (key).
+  std::uint64_t seed() const { return join(fKey[0], fKey[1]); }
+
+  /// Returns the current stream.
+  std::uint64_t stream() const { return join(fCounter[2], fCounter[3]); }
+
+  /// Moves to the beginning of the specified stream.
+  void setStream(std::uint64_t stream);
+
+  // --- END ---- Seeds and streams --------------------------------------------
+
+
+  // --- BEGIN -- Status -------------------------------------------------------
+  virtual void saveStatus(const char filename[] = "PhiloxEngine.conf") const
+    override;
+
+  virtual void restoreStatus(const char filename[] = "PhiloxEngine.conf")
+    override;
+
+  virtual void showStatus() const override;
+
+  virtual std::ostream& put(std::ostream& os) const override;
+
+  virtual std::istream& get(std::istream& is) override;
+
+  virtual std::istream& getState(std::istream& is) override;
+
+  virtual std::vector<unsigned long> put() const override;
+
+  virtual bool get(std::vector<unsigned long> const& v) override;
+
+  virtual bool getState(std::vector<unsigned long> const& v) override;
+
+  // --- END ---- Status -------------------------------------------------------
+
+
+  virtual std::string name() const override { return engineName(); }
+
+  /// Returns the name of this engine.
+  static std::string engineName() { return "PhiloxEngine"; }
+
+  /// Tag at the beginning of the status written by `put()`.
+  static std::string beginTag() { return "PhiloxEngine-begin"; }
+
+  /// Tag at the end of the status written by `put()`.
+  static std::string endTag() { return "PhiloxEngine-end"; }
+
+
+    private:
+
+  /// Number of values in the status vector (including the engine ID).
+  static constexpr std::size_t VectorSize = 8U;
+
+  Key_t fKey; ///< Key (the seed).
+
+  /// Counter of the current block: position (low half), stream (high half).
+  Counter_t fCounter;
+
+  Block_t fBlock; ///< Current block of random bits.
+
+  unsigned int fWord = 4U; ///< Next unused word in `fBlock` (4: none).
+
+
+  /// Moves to the next block and generates it.
+  void nextBlock()
+    {
+      // the position in the stream is the lower half of the counter
+      if (++fCounter[0] == 0U) ++fCounter[1];
+      fBlock = generate(fCounter, fKey);
+      fWord = 0U;
+    }
+
+  /// Sets the position to the beginning of the current stream.
+  void restart();
+
+  /// Updates the CLHEP seed of the engine.
+  void updateSeed() { theSeed = static_cast<long>(seed()); }
+
+  /// Returns the 53 most significant bits of `bits` as a number in ] 0, 1 [.
+  static double toDouble(std::uint64_t bits)
+    {
+      constexpr double Epsilon = 1.0 / 9007199254740992.0; // 2^-53
+      return (static_cast<double>(bits >> 11) + 0.5) * Epsilon;
+    }
+
+  /// Joins two 32-bit words into a 64-bit one.
+  static std::uint64_t join(std::uint32_t low, std::uint32_t high)
+    { return (std::uint64_t{ high } << 32) | low; }
+
+}; // util::PhiloxEngine
+
+
+// -----------------------------------------------------------------------------
+// --- inline implementation
+// -----------------------------------------------------------------------------
+inline auto util::PhiloxEngine::generate(Counter_t counter, Key_t key)
+  -> Block_t
+{
+  constexpr std::uint32_t M0 = 0xD2511F53;
+  constexpr std::uint32_t M1 = 0xCD9E8D57;
+  constexpr std::uint32_t W0 = 0x9E3779B9; // golden ratio
+  constexpr std::uint32_t W1 = 0xBB67AE85; // sqrt(3) - 1
+
+  for (unsigned int round = 0; round < NRounds; ++round) {
+    if (round > 0U) { key[0] += W0; key[1] += W1; }
+    std::uint64_t const p0 = std::uint64_t{ M0 } * counter[0];
+    std::uint64_t const p1 = std::uint64_t{ M1 } * counter[2];
+    counter = {
+      static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+      static_cast<std::uint32_t>(p1),
+      static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+      static_cast<std::uint32_t>(p0)
+      };
+  } // for rounds
+  return counter;
+
+} // util::PhiloxEngine::generate()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_PHILOXENGINE_H
@@ -9,6 +9,9 @@
 #ifndef ICARUSALG_UTILITIES_PLOTSANDBOX_H
 #define ICARUSALG_UTILITIES_PLOTSANDBOX_H
 
+// ICARUS libraries
+#include "icarusalg/Utilities/AtomicHistogram.h"
+
 // framework libraries
 #include "cetlib_except/exception.h"
 
@@ -18,10 +21,15 @@
 // C/C++ standard libraries
 #include <initializer_list>
 #include <string>
-#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <optional>
+#include <future>
 #include <utility> // std::move(), std::pair<>
 #include <memory> // std::unique_ptr<>
 #include <functional> // std::hash<>
+#include <cstddef> // std::size_t
 
 
 //------------------------------------------------------------------------------
@@ -29,15 +37,71 @@ namespace icarus::ns::util {
   
   template <typename DirectoryBackend> class PlotSandbox;
   
+  template <typename Obj> class PlotHandle;
+  
   namespace details {
     template <typename Map>
     decltype(auto) map_dereferenced_values(Map&& map);
     
+    template <typename Coll>
+    decltype(auto) dereferenced_values(Coll&& coll);
+    
     template <typename Backend> class TDirectoryHelper;
+    
+    class DeferredPlotBase;
+    template <typename Hist> class DeferredPlot;
+    
+    /// Number of dimensions of the ROOT histogram type `Hist`.
+    template <typename Hist>
+    constexpr std::size_t histogramDimensions();
+    
   }
   
 } // namespace icarus::ns::util
 
+
+/**
+ * @brief Direct access to an object in a `PlotSandbox`.
+ * @tparam Obj type of the object
+ * @see `icarus::ns::util::PlotSandbox::handle()`
+ * 
+ * A handle is resolved once (`PlotSandbox::handle()`) and then gives access
+ * to the object with no lookup. It is valid as long as the object is owned by
+ * its ROOT directory (that is, typically until the output file is written and
+ * closed).
+ */
+template <typename Obj>
+class icarus::ns::util::PlotHandle {
+  
+  Obj* fObj = nullptr; ///< Pointer to the object.
+  
+    public:
+  
+  using Object_t = Obj; ///< Type of the object.
+  
+  /// Constructor: an invalid handle.
+  PlotHandle() = default;
+  
+  /// Constructor: handle of the object `obj` (`nullptr` makes it invalid).
+  explicit PlotHandle(Obj* obj): fObj(obj) {}
+  
+  /// Returns whether this handle points to an object.
+  bool isValid() const { return fObj != nullptr; }
+  
+  /// Returns whether this handle points to an object.
+  explicit operator bool() const { return isValid(); }
+  
+  /// Returns a pointer to the object (`nullptr` if invalid).
+  Obj* get() const { return fObj; }
+  
+  /// Returns a pointer to the object.
+  Obj* operator-> () const { return get(); }
+  
+  /// Returns the object. Undefined behaviour if the handle is invalid.
+  Obj& operator* () const { return *get(); }
+  
+}; // icarus::ns::util::PlotHandle
+
 /**
  * @brief A helper to manage ROOT objects with consistent naming.
  * @tparam DirectoryBackend type enclosing the interaction with the output file
@@ -63,6 +127,64 @@ namespace icarus::ns::util {
  * @note By convention the subdirectory names are not processed.
  * 
  * 
+ * Access in loops
+ * ----------------
+ * 
+ * Each access by name (`get()`, `use()`, `demand()`) processes the name and
+ * looks up the object in its ROOT directory. When the same object is accessed
+ * repeatedly (e.g. on each event), it's better to resolve it once into a
+ * `PlotHandle` (`handle()`) and fill it via that one:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * // at setup time
+ * fHEnergy = box.handle<TH1>("HEnergy");
+ * 
+ * // for each event
+ * fHEnergy->Fill(energy);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Lookup of contained sandboxes by name (`findSandbox()`) uses a hash table.
+ * 
+ * 
+ * 
+ * Deferred histograms
+ * --------------------
+ * 
+ * ROOT histograms are not thread-safe. A histogram created with
+ * `makeDeferred()` is registered in the sandbox like the ones from `make()`,
+ * but it should not be filled directly: the filling goes instead into a
+ * lock-free content object (`icarus::ns::util::AtomicHistogram`) which is
+ * returned by `makeDeferred()` and which can be filled by many threads at once.
+ * The content is moved into the ROOT histograms by `flushDeferred()`, which
+ * must be called before the output is written (e.g. at the end of the job).
+ * 
+ * 
+ * Lazy directories
+ * -----------------
+ * 
+ * By default each sandbox creates its ROOT directory on construction.
+ * When a sandbox is constructed with the `LazyDirectories` flag, its directory
+ * and the ones of all its contained sandboxes are instead created only when
+ * the first object is registered in them (`make()`, `makeDeferred()`,
+ * `acquire()`) or when the directory is explicitly requested
+ * (`getDirectory()`). Sandboxes which are never used therefore leave no trace
+ * in the output file, which is convenient when a large hierarchy of categories
+ * is set up in advance:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * using PlotSandbox_t = icarus::ns::util::PlotSandbox<TDirectory*>;
+ * PlotSandbox_t plots
+ *   { outputFile, "Selection", "", PlotSandbox_t::LazyDirectories };
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * 
+ * 
+ * Writing
+ * --------
+ * 
+ * The objects are usually written by the owner of the output file when it is
+ * closed (e.g. by _art_ `TFileService`). Alternatively, `write()` writes all
+ * the objects of the sandbox hierarchy, skipping the empty sandboxes, and
+ * `writeAsync()` does the same in a separate thread, so that the serialization
+ * of the histograms can proceed while other end-of-job tasks are performed.
+ * 
+ * 
  * This utility class is expected to work both within and without _art_.
  * When _art_ is available, `DirectoryBackend` can be set to use
  * `art::TFileDirectory`, while in a pure ROOT environment `TDirectoryFile`
@@ -88,10 +210,23 @@ class icarus::ns::util::PlotSandbox {
     /// Optional parent sandbox.
     PlotSandbox_t const* parent = nullptr;
     
-    /// Contained sand boxes.
-    std::map<std::string, std::unique_ptr<PlotSandbox_t>> subBoxes;
+    /// Whether the output directory is created only when needed.
+    bool lazy = false;
+    
+    /// Parent directory, for the lazy creation of a box with no parent box.
+    std::optional<DirectoryBackend> parentDir;
     
-    DirectoryHelper_t outputDir; ///< Output ROOT directory of the sandbox.
+    /// Contained sand boxes, in order of creation.
+    std::vector<std::unique_ptr<PlotSandbox_t>> subBoxes;
+    
+    /// Index in `subBoxes` of each contained sand box, by name.
+    std::unordered_map<std::string, std::size_t> subBoxIndex;
+    
+    /// Output ROOT directory of the sandbox (created on demand if `lazy`).
+    mutable std::optional<DirectoryHelper_t> outputDir;
+    
+    /// Histograms whose content is filled separately (`makeDeferred()`).
+    std::vector<std::unique_ptr<details::DeferredPlotBase>> deferredPlots;
     
     Data_t() = default;
     Data_t(Data_t const&) = delete;
@@ -99,8 +234,10 @@ class icarus::ns::util::PlotSandbox {
     Data_t& operator= (Data_t const&) = delete;
     Data_t& operator= (Data_t&&) = default;
     
-    Data_t
-      (std::string&& name, std::string&& desc, DirectoryHelper_t outputDir)
+    Data_t(
+      std::string&& name, std::string&& desc,
+      std::optional<DirectoryHelper_t> outputDir
+      )
       : name(std::move(name)), desc(std::move(desc))
       , outputDir(std::move(outputDir))
       {}
@@ -113,12 +250,20 @@ class icarus::ns::util::PlotSandbox {
   /// Helper function for `findSandbox()` implementations.
   template <typename SandboxType>
   static PlotSandbox_t* findSandbox
-    (SandboxType& sandbox, std::string const& name);
+    (SandboxType& sandbox, std::string_view name);
   
   /// Helper function for `demandSandbox()` implementations.
   template <typename SandboxType>
   static PlotSandbox_t& demandSandbox
-    (SandboxType& sandbox, std::string const& name);
+    (SandboxType& sandbox, std::string_view name);
+  
+  /// Creates the output directory for a box with `name` in `parentDir`.
+  static DirectoryHelper_t makeOutputDir(
+    DirectoryBackend parentDir, std::string const& name, std::string const& desc
+    );
+  
+  /// Returns the output directory, creating it (and its parents) if needed.
+  DirectoryHelper_t const& outputDirectory() const;
   
   
     public:
@@ -128,6 +273,12 @@ class icarus::ns::util::PlotSandbox {
   /// Special value for marking `make()` parameters.
   static constexpr NoNameTitle_t NoNameTitle {};
   
+  /// Special type for requesting lazy creation of directories.
+  struct LazyDirectories_t {};
+  
+  /// Special value requesting lazy creation of directories to the constructor.
+  static constexpr LazyDirectories_t LazyDirectories {};
+  
   /**
    * @brief Constructor: specifies all sandbox characteristics.
    * @param parentDir ROOT directory under which the sandbox is created
@@ -145,6 +296,22 @@ class icarus::ns::util::PlotSandbox {
    */
   PlotSandbox(DirectoryBackend parentDir, std::string name, std::string desc);
   
+  /**
+   * @brief Constructor: sandbox with lazy creation of the directories.
+   * @param parentDir ROOT directory under which the sandbox is created
+   * @param name the name of the sandbox
+   * @param desc description of the sandbox
+   * 
+   * This constructor is equivalent to the one without the `LazyDirectories`
+   * flag, except that the output directory of this sandbox and of all the
+   * sandboxes it will contain is created only when first needed.
+   * `parentDir` must stay valid until then.
+   */
+  PlotSandbox(
+    DirectoryBackend parentDir, std::string name, std::string desc,
+    LazyDirectories_t
+    );
+  
   PlotSandbox(PlotSandbox_t const&) = delete;
   PlotSandbox(PlotSandbox_t&& from);
   
@@ -181,6 +348,12 @@ class icarus::ns::util::PlotSandbox {
   /// Processes the specified string as it were a description or title.
   virtual std::string processTitle(std::string const& title) const;
   
+  /// Returns whether the directories of this sandbox are created lazily.
+  bool hasLazyDirectories() const { return fData.lazy; }
+  
+  /// Returns whether the output directory of this sandbox has been created.
+  bool hasDirectory() const { return fData.outputDir.has_value(); }
+  
   
   // --- BEGIN -- ROOT object management ---------------------------------------
   /// @name ROOT object management
@@ -236,12 +409,29 @@ class icarus::ns::util::PlotSandbox {
   template <typename Obj = TObject>
   Obj& demand(std::string const& name) const;
   
+  /**
+   * @brief Returns a handle to the object with the specified name.
+   * @tparam Obj (default: `TObject`) type of the object to fetch
+   * @param name unprocessed name and path of the object to fetch
+   * @return a handle to the requested object
+   * @throw cet::exception (category: `"PlotSandbox"`) if no object with `name`
+   *        exists in the box
+   * @see `demand()`, `PlotHandle`
+   * 
+   * The object is looked up as in `demand()`, but only once: access through
+   * the returned handle does not involve any further lookup.
+   */
+  template <typename Obj = TObject>
+  PlotHandle<Obj> handle(std::string const& name) const
+    { return PlotHandle<Obj>{ &demand<Obj>(name) }; }
+  
   /**
    * @brief Fetches the base directory of the sandbox.
    * @return a pointer to the requested directory, or `nullptr` if wrong type
    * 
    * The directory is converted to the desired type via `dynamic_cast`.
    * If conversion fails, a null pointer is returned.
+   * With lazy directories, the directory is created if it does not exist yet.
    */
   template <typename DirObj = TDirectory>
   DirObj* getDirectory() const;
@@ -255,6 +445,8 @@ class icarus::ns::util::PlotSandbox {
    * 
    * The fetched object is converted to the desired type via `dynamic_cast`.
    * If conversion fails, a null pointer is returned.
+   * With lazy directories, the base directory is created if it does not exist
+   * yet.
    */
   template <typename DirObj = TDirectory>
   DirObj* getDirectory(std::string const& path) const;
@@ -304,6 +496,67 @@ class icarus::ns::util::PlotSandbox {
     );
   
   
+  /**
+   * @brief Creates a ROOT histogram and returns a thread-safe filler for it.
+   * @tparam Hist type of ROOT histogram to be created (1D or 2D)
+   * @tparam Args types of the arguments to be forwarded to the constructor
+   * @param name unprocessed name of the new histogram
+   * @param title unprocessed title of the new histogram
+   * @param args additional arguments forwarded to the constructor
+   * @return the object to be filled in place of the histogram
+   * @throw cet::exception (category: `"PlotSandbox"`) if the histogram does
+   *        not have uniform binning
+   * @see `flushDeferred()`
+   * 
+   * The histogram is created as with `make()`, and it is available via `get()`
+   * and `use()`; but it is filled only on `flushDeferred()` calls, with the
+   * content accumulated meanwhile in the returned object.
+   * The returned object can be filled concurrently, with no lock.
+   * Only histograms with uniform binning (on all axes) are supported.
+   */
+  template <typename Hist, typename... Args>
+  AtomicHistogram<details::histogramDimensions<Hist>()>& makeDeferred
+    (std::string const& name, std::string const& title, Args&&... args);
+  
+  /// Returns the number of deferred histograms in this box (not subboxes).
+  std::size_t nDeferred() const { return fData.deferredPlots.size(); }
+  
+  /**
+   * @brief Moves the content of all deferred histograms into ROOT histograms.
+   * @see `makeDeferred()`
+   * 
+   * This applies to this sandbox and all the contained ones.
+   * This method is not thread-safe, and no deferred histogram must be filled
+   * while it runs.
+   */
+  void flushDeferred();
+  
+  
+  /**
+   * @brief Writes all the objects of this sandbox and of the contained ones.
+   * @return the number of objects written
+   * @see `writeAsync()`
+   * 
+   * Each object is written into its directory, replacing any previous version
+   * (`TObject::kOverwrite`). Empty sandboxes are skipped.
+   * Deferred histograms are not flushed: call `flushDeferred()` first.
+   */
+  std::size_t write() const;
+  
+  /**
+   * @brief Writes all the objects like `write()`, in a background thread.
+   * @return a future holding the number of objects written
+   * @see `write()`
+   * 
+   * No object of this sandbox and no other object of the same ROOT file must
+   * be used, and the file must not be closed, until the returned future is
+   * ready (`wait()` or `get()`). Unless ROOT thread safety is enabled
+   * (`ROOT::EnableThreadSafety()`), the current ROOT directory of the calling
+   * thread may also be changed meanwhile.
+   */
+  std::future<std::size_t> writeAsync() const;
+  
+  
   /// @}
   // --- END -- ROOT object management -----------------------------------------
   
@@ -349,8 +602,8 @@ class icarus::ns::util::PlotSandbox {
    * Full sandbox paths, separated by a '/' character, are supported.
    * The function returns `nullptr` if any sandbox in the path is not found.
    */
-  PlotSandbox_t const* findSandbox(std::string const& name) const;
-  PlotSandbox_t* findSandbox(std::string const& name);
+  PlotSandbox_t const* findSandbox(std::string_view name) const;
+  PlotSandbox_t* findSandbox(std::string_view name);
   // @}
   
   // @{
@@ -365,16 +618,17 @@ class icarus::ns::util::PlotSandbox {
    * Full sandbox paths, separated by a '/' character, are supported.
    * The function returns `nullptr` if any sandbox in the path is not found.
    */
-  PlotSandbox_t const& demandSandbox(std::string const& name) const;
-  PlotSandbox_t& demandSandbox(std::string const& name);
+  PlotSandbox_t const& demandSandbox(std::string_view name) const;
+  PlotSandbox_t& demandSandbox(std::string_view name);
   // @}
   
   // @{
   /// Returns an object proper to iterate through all contained sand boxes.
+  /// The boxes are iterated in the order they were added.
   decltype(auto) subSandboxes() const
-    { return details::map_dereferenced_values(fData.subBoxes); }
+    { return details::dereferenced_values(fData.subBoxes); }
   decltype(auto) subSandboxes()
-    { return details::map_dereferenced_values(fData.subBoxes); }
+    { return details::dereferenced_values(fData.subBoxes); }
   // @}
   
   /**
@@ -15,7 +15,6 @@
 
 // LArSoft libraries
 #include "larcorealg/CoreUtils/span.h" // util::make_transformed_span(), ...
-#include "larcorealg/CoreUtils/values.h"
 
 // framework libraries
 #include "cetlib_except/exception.h"
@@ -27,14 +26,22 @@
 #include "TKey.h"
 #include "TClass.h"
 #include "TObject.h"
+#include "TAxis.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
 
 // C/C++ standard libraries
 #include <string_view>
+#include <array>
 #include <string>
 #include <vector>
+#include <optional>
+#include <future> // std::async()
+#include <algorithm> // std::find()
 #include <iterator> // std::prev()
 #include <utility> // std::forward(), std::move()
-#include <type_traits> // std::add_const_t<>
+#include <type_traits> // std::add_const_t<>, std::is_base_of_v<>
 
 
 //------------------------------------------------------------------------------
@@ -64,6 +71,14 @@ namespace icarus::ns::util::details {
     { return map_dereferenced_values_impl<std::decay_t<Map>>::iterate(std::forward<Map>(map)); }
   
   
+  template <typename Coll>
+  decltype(auto) dereferenced_values(Coll&& coll)
+    {
+      auto extractor = [](auto&& value) -> decltype(auto) { return *value; };
+      return ::util::make_transformed_span(coll, extractor);
+    }
+  
+  
   /**
    * @brief Helper with management of a `TDirectory` content.
    * @tparam Backend type of class providing object management in the directory
@@ -135,11 +150,83 @@ namespace icarus::ns::util::details {
     
   }; // class TDirectoryHelper
 
+  
+  /// Interface to a histogram with deferred filling.
+  class DeferredPlotBase {
+      public:
+    virtual ~DeferredPlotBase() = default;
+    
+    /// Moves the accumulated content into the ROOT histogram.
+    virtual void flush() = 0;
+  }; // class DeferredPlotBase
+  
+  
+  /// A ROOT histogram and the lock-free content to be added to it.
+  template <typename Hist>
+  class DeferredPlot: public DeferredPlotBase {
+    
+      public:
+    using Content_t = AtomicHistogram<histogramDimensions<Hist>()>;
+    
+    /// Constructor: binning is learnt from `hist` (which is not owned).
+    DeferredPlot(Hist& hist): fHist(&hist), fContent(axesOf(hist)) {}
+    
+    /// Returns the object collecting the content.
+    Content_t& content() { return fContent; }
+    
+    virtual void flush() override { fContent.transferTo(*fHist); }
+    
+      private:
+    Hist* fHist; ///< The ROOT histogram (owned by its directory).
+    Content_t fContent; ///< The content not yet moved to the histogram.
+    
+    /// Returns the binning of all the axes of `hist`.
+    static std::array<typename Content_t::Axis_t, Content_t::Dimensions>
+    axesOf(Hist const& hist);
+    
+  }; // class DeferredPlot
+  
+  
 } // namespace icarus::ns::util::details
 
 
 //------------------------------------------------------------------------------
 //--- template implementation
+//------------------------------------------------------------------------------
+//--- icarus::ns::util::details::DeferredPlot
+//------------------------------------------------------------------------------
+template <typename Hist>
+constexpr std::size_t icarus::ns::util::details::histogramDimensions() {
+  static_assert(std::is_base_of_v<TH1, Hist>, "Only histograms are supported.");
+  static_assert(!std::is_base_of_v<TH3, Hist>,
+    "Three-dimension histograms are not supported.");
+  return std::is_base_of_v<TH2, Hist>? 2U: 1U;
+} // icarus::ns::util::details::histogramDimensions()
+
+
+//------------------------------------------------------------------------------
+template <typename Hist>
+auto icarus::ns::util::details::DeferredPlot<Hist>::axesOf(Hist const& hist)
+  -> std::array<typename Content_t::Axis_t, Content_t::Dimensions>
+{
+  TAxis const* axes[] = { hist.GetXaxis(), hist.GetYaxis() };
+  
+  std::array<typename Content_t::Axis_t, Content_t::Dimensions> binning;
+  for (std::size_t iAxis = 0; iAxis < binning.size(); ++iAxis) {
+    TAxis const& axis = *axes[iAxis];
+    if (axis.IsVariableBinSize()) {
+      throw cet::exception("PlotSandbox")
+        << "PlotSandbox::makeDeferred(): histogram '" << hist.GetName()
+        << "' has variable size bins, not supported.\n";
+    }
+    binning[iAxis] = {
+      static_cast<unsigned int>(axis.GetNbins()), axis.GetXmin(), axis.GetXmax()
+      };
+  } // for
+  return binning;
+} // icarus::ns::util::details::DeferredPlot<>::axesOf()
+
+
 //------------------------------------------------------------------------------
 //--- icarus::ns::util::PlotSandbox::TFileDirectoryHelper
 //------------------------------------------------------------------------------
@@ -303,7 +390,7 @@ template <typename DirectoryBackend>
 void icarus::ns::util::PlotSandbox<DirectoryBackend>::Data_t::resetSubboxParents
   (PlotSandbox_t const* newParent)
 {
-  for (auto& subbox: ::util::values(subBoxes)) subbox->setParent(newParent);
+  for (auto& subbox: subBoxes) subbox->setParent(newParent);
 } // icarus::ns::util::PlotSandbox::Data_t::resetSubboxParents()
 
 
@@ -311,20 +398,20 @@ void icarus::ns::util::PlotSandbox<DirectoryBackend>::Data_t::resetSubboxParents
 template <typename DirectoryBackend>
 template <typename SandboxType>
 auto icarus::ns::util::PlotSandbox<DirectoryBackend>::findSandbox
-  (SandboxType& sandbox, std::string const& name) -> PlotSandbox_t*
+  (SandboxType& sandbox, std::string_view name) -> PlotSandbox_t*
 {
-  // if `name` does not have any path, `firstDir` is empty
-  auto const& [ firstDir, restOfPath ] = peelDir(name);
+  // dirName denotes the first sandbox in the path (if no path, it's all name)
+  auto const iSep = name.find('/');
+  std::string_view const dirName = name.substr(0U, iSep);
   
-  // dirName denotes the first sandbox in the path
-  std::string const& dirName = firstDir.empty()? restOfPath: firstDir;
-  
-  auto const it = sandbox.fData.subBoxes.find(dirName);
-  PlotSandbox_t* dir
-    = (it == sandbox.fData.subBoxes.end())? nullptr: it->second.get();
+  auto const& index = sandbox.fData.subBoxIndex;
+  auto const it = index.find(std::string{ dirName });
+  PlotSandbox_t* dir = (it == index.end())
+    ? nullptr: sandbox.fData.subBoxes[it->second].get();
   
   // if there is still path to search, recurse
-  return (!dir || firstDir.empty())? dir: findSandbox(*dir, restOfPath);
+  return (!dir || (iSep == std::string_view::npos))
+    ? dir: findSandbox(*dir, name.substr(iSep + 1));
 } // icarus::ns::util::PlotSandbox::findSandbox()
 
 
@@ -332,7 +419,7 @@ auto icarus::ns::util::PlotSandbox<DirectoryBackend>::findSandbox
 template <typename DirectoryBackend>
 template <typename SandboxType>
 auto icarus::ns::util::PlotSandbox<DirectoryBackend>::demandSandbox
-  (SandboxType& sandbox, std::string const& name) -> PlotSandbox_t&
+  (SandboxType& sandbox, std::string_view name) -> PlotSandbox_t&
 {
   auto* box = findSandbox(sandbox, name);
   if (box) return *box;
@@ -353,21 +440,59 @@ auto icarus::ns::util::PlotSandbox<DirectoryBackend>::demandSandbox
 } // icarus::ns::util::PlotSandbox::demandSandbox(SandboxType)
 
 
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+auto icarus::ns::util::PlotSandbox<DirectoryBackend>::makeOutputDir(
+  DirectoryBackend parentDir, std::string const& name, std::string const& desc
+  ) -> DirectoryHelper_t
+{
+  return name.empty()
+    ? DirectoryHelper_t::create(parentDir)
+    : DirectoryHelper_t::create(parentDir, name, desc)
+    ;
+} // icarus::ns::util::PlotSandbox::makeOutputDir()
+
+
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+auto icarus::ns::util::PlotSandbox<DirectoryBackend>::outputDirectory() const
+  -> DirectoryHelper_t const&
+{
+  if (!fData.outputDir) {
+    // the directory of the parent box is needed first (and created if lazy)
+    DirectoryBackend const parentDir = fData.parent
+      ? fData.parent->outputDirectory().backend(): *fData.parentDir;
+    fData.outputDir.emplace(makeOutputDir(parentDir, fData.name, fData.desc));
+  }
+  return *fData.outputDir;
+} // icarus::ns::util::PlotSandbox::outputDirectory()
+
+
 //------------------------------------------------------------------------------
 template <typename DirectoryBackend>
 icarus::ns::util::PlotSandbox<DirectoryBackend>::PlotSandbox(
   DirectoryBackend parentDir,
   std::string name, std::string desc
   )
-  : fData {
-    std::move(name), std::move(desc),
-    name.empty()
-      ? DirectoryHelper_t::create(parentDir)
-      : DirectoryHelper_t::create(parentDir, name, desc)
-    }
+  : fData
+    { std::move(name), std::move(desc), makeOutputDir(parentDir, name, desc) }
 {}
 
 
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+icarus::ns::util::PlotSandbox<DirectoryBackend>::PlotSandbox(
+  DirectoryBackend parentDir,
+  std::string name, std::string desc,
+  LazyDirectories_t
+  )
+  : fData { std::move(name), std::move(desc), std::nullopt }
+{
+  fData.lazy = true;
+  fData.parentDir = parentDir;
+}
+
+
 //------------------------------------------------------------------------------
 template <typename DirectoryBackend>
 icarus::ns::util::PlotSandbox<DirectoryBackend>::PlotSandbox
@@ -408,12 +533,16 @@ std::string icarus::ns::util::PlotSandbox<DirectoryBackend>::processTitle
 template <typename DirectoryBackend>
 bool icarus::ns::util::PlotSandbox<DirectoryBackend>::empty() const {
   
+  // with no directory yet, neither this box nor its subboxes have any object
+  if (!fData.outputDir) return true;
+  
   std::vector<TDirectory const*> subDirectories; // directories of subboxes
   
   // if any of the subboxes is not empty, then this one is not either
   for (auto& subbox: subSandboxes()) {
     if (!subbox.empty()) return false;
-    subDirectories.push_back(subbox.getDirectory());
+    if (subbox.fData.outputDir)
+      subDirectories.push_back(subbox.fData.outputDir->getDirectory());
   } // for
   
   auto const isSubDirectory = [b=subDirectories.begin(),e=subDirectories.end()]
@@ -423,13 +552,15 @@ bool icarus::ns::util::PlotSandbox<DirectoryBackend>::empty() const {
       return dir && std::find(b, e, dir) != e;
     };
   
+  TDirectory const* dir = fData.outputDir->getDirectory();
+  
   // if there is any object in memory associated to the directory,
   // that is not empty (directories from subboxes are exempted)
-  for (TObject const* obj: *(getDirectory()->GetList()))
+  for (TObject const* obj: *(dir->GetList()))
     if (!isSubDirectory(obj)) return false;
   
   // if there is any key associated to the directory, that is not empty
-  if (getDirectory()->GetListOfKeys()->GetSize()) return false;
+  if (dir->GetListOfKeys()->GetSize()) return false;
   
   return true;
 } // icarus::ns::util::PlotSandbox::empty()
@@ -448,6 +579,16 @@ template <typename DirectoryBackend>
 template <typename Obj /* = TObject */>
 Obj* icarus::ns::util::PlotSandbox<DirectoryBackend>::use(std::string const& name) const {
   
+  // a lazy directory not created yet can't hold any object
+  if (!fData.outputDir) return nullptr;
+  
+  // with no path, skip the splitting (and copying) of the name
+  if (name.find('/') == std::string::npos) {
+    std::string const processedName = processName(name);
+    return fData.outputDir->getDirectory()->template Get<Obj>
+      (processedName.c_str());
+  }
+  
   auto [ objDir, objName ] = splitPath(name);
   
   TDirectory* dir = getDirectory(objDir);
@@ -482,7 +623,7 @@ Obj& icarus::ns::util::PlotSandbox<DirectoryBackend>::demand
 template <typename DirectoryBackend>
 template <typename DirObj /* = TDirectory */>
 DirObj* icarus::ns::util::PlotSandbox<DirectoryBackend>::getDirectory() const
-  { return dynamic_cast<DirObj*>(fData.outputDir.getDirectory()); }
+  { return dynamic_cast<DirObj*>(outputDirectory().getDirectory()); }
 
 
 //------------------------------------------------------------------------------
@@ -491,7 +632,7 @@ template <typename DirObj /* = TDirectory */>
 DirObj* icarus::ns::util::PlotSandbox<DirectoryBackend>::getDirectory
   (std::string const& path) const
 {
-  TDirectory* pBaseDir = fData.outputDir.getDirectory();
+  TDirectory* pBaseDir = outputDirectory().getDirectory();
   return dynamic_cast<DirObj*>
     (path.empty()? pBaseDir: pBaseDir->GetDirectory(path.c_str()));
 } // icarus::ns::util::PlotSandbox::getDirectory()
@@ -508,8 +649,9 @@ Obj* icarus::ns::util::PlotSandbox<DirectoryBackend>::make
   std::string const processedName = processName(objName);
   std::string const processedTitle = processPlotTitle(title);
   
+  DirectoryHelper_t const& outputDir = outputDirectory(); // created if lazy
   DirectoryHelper_t destDir // no title for the implicit subdirectories
-    = objDir.empty()? fData.outputDir: fData.outputDir.mkdir(objDir);
+    = objDir.empty()? outputDir: outputDir.mkdir(objDir);
   
   return makeImpl<Obj>
     (destDir, processedName, processedTitle, std::forward<Args>(args)...);
@@ -534,6 +676,74 @@ Obj* icarus::ns::util::PlotSandbox<DirectoryBackend>::acquire(
 } // icarus::ns::util::PlotSandbox::acquire()
 
 
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+template <typename Hist, typename... Args>
+auto icarus::ns::util::PlotSandbox<DirectoryBackend>::makeDeferred
+  (std::string const& name, std::string const& title, Args&&... args)
+  -> AtomicHistogram<details::histogramDimensions<Hist>()>&
+{
+  Hist* hist = make<Hist>(name, title, std::forward<Args>(args)...);
+  
+  auto plot = std::make_unique<details::DeferredPlot<Hist>>(*hist);
+  auto& content = plot->content();
+  fData.deferredPlots.push_back(std::move(plot));
+  return content;
+  
+} // icarus::ns::util::PlotSandbox::makeDeferred()
+
+
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+void icarus::ns::util::PlotSandbox<DirectoryBackend>::flushDeferred() {
+  
+  for (auto& plot: fData.deferredPlots) plot->flush();
+  for (auto& subbox: subSandboxes()) subbox.flushDeferred();
+  
+} // icarus::ns::util::PlotSandbox::flushDeferred()
+
+
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+std::size_t icarus::ns::util::PlotSandbox<DirectoryBackend>::write() const {
+  
+  if (empty()) return 0U; // also covers boxes with no directory yet
+  
+  std::vector<TDirectory const*> subDirectories; // directories of subboxes
+  for (auto const& subbox: subSandboxes()) {
+    if (subbox.fData.outputDir)
+      subDirectories.push_back(subbox.fData.outputDir->getDirectory());
+  }
+  
+  TDirectory* dir = fData.outputDir->getDirectory();
+  ::util::ROOT::TDirectoryChanger dirGuard(dir);
+  
+  std::size_t nWritten = 0U;
+  for (TObject const* obj: *(dir->GetList())) {
+    // subbox directories are written (or skipped) by their own box;
+    // other directories (from object paths) are written with all their content
+    if (std::find(subDirectories.begin(), subDirectories.end(), obj)
+      != subDirectories.end()
+    ) {
+      continue;
+    }
+    obj->Write(nullptr, TObject::kOverwrite);
+    ++nWritten;
+  } // for
+  
+  for (auto const& subbox: subSandboxes()) nWritten += subbox.write();
+  
+  return nWritten;
+} // icarus::ns::util::PlotSandbox::write()
+
+
+//------------------------------------------------------------------------------
+template <typename DirectoryBackend>
+std::future<std::size_t>
+icarus::ns::util::PlotSandbox<DirectoryBackend>::writeAsync() const
+  { return std::async(std::launch::async, [this](){ return write(); }); }
+
+
 //------------------------------------------------------------------------------
 template <typename DirectoryBackend>
 template
@@ -555,41 +765,44 @@ SandboxType& icarus::ns::util::PlotSandbox<DirectoryBackend>::addSubSandbox
     }
   }
   
-  // we can't use make_unique() because the constructor it needs is protected:
-  auto [ it, bInserted ] = fData.subBoxes.try_emplace(
-    baseName,
-    new SandboxType(*this, baseName, desc, std::forward<Args>(args)...)
-    );
-  if (!bInserted) {
+  if (fData.subBoxIndex.count(baseName)) {
     throw cet::exception("PlotSandbox")
       << "PlotSandbox::addSubSandbox(): a subbox with name '" << baseName
       << "' already exists in  box '" << ID() << "'.\n";
   }
-  return *(it->second); // it iterator to the inserted element
+  
+  // we can't use make_unique() because the constructor it needs is protected:
+  std::unique_ptr<SandboxType> subbox {
+    new SandboxType(*this, baseName, desc, std::forward<Args>(args)...)
+    };
+  SandboxType& newBox = *subbox;
+  fData.subBoxes.push_back(std::move(subbox));
+  fData.subBoxIndex.emplace(baseName, fData.subBoxes.size() - 1U);
+  return newBox;
 } // icarus::ns::util::PlotSandbox::addSubSandbox()
 
 
 //------------------------------------------------------------------------------
 template <typename DirectoryBackend>
 auto icarus::ns::util::PlotSandbox<DirectoryBackend>::findSandbox
-  (std::string const& name) -> PlotSandbox_t*
+  (std::string_view name) -> PlotSandbox_t*
   { return findSandbox(*this, name); }
 
 template <typename DirectoryBackend>
 auto icarus::ns::util::PlotSandbox<DirectoryBackend>::findSandbox
-  (std::string const& name) const -> PlotSandbox_t const*
+  (std::string_view name) const -> PlotSandbox_t const*
   { return findSandbox(*this, name); }
 
 
 //------------------------------------------------------------------------------
 template <typename DirectoryBackend>
 auto icarus::ns::util::PlotSandbox<DirectoryBackend>::demandSandbox
-  (std::string const& name) -> PlotSandbox_t&
+  (std::string_view name) -> PlotSandbox_t&
   { return demandSandbox(*this, name); }
 
 template <typename DirectoryBackend>
 auto icarus::ns::util::PlotSandbox<DirectoryBackend>::demandSandbox
-  (std::string const& name) const -> PlotSandbox_t const&
+  (std::string_view name) const -> PlotSandbox_t const&
   { return demandSandbox(*this, name); }
 
 
@@ -604,16 +817,24 @@ bool icarus::ns::util::PlotSandbox<DirectoryBackend>::deleteSubSandbox
     return parent? parent->deleteSubSandbox(baseName): false;
   }
   
-  auto const it = fData.subBoxes.find(name);
-  if (it == fData.subBoxes.end()) return false;
+  auto const it = fData.subBoxIndex.find(name);
+  if (it == fData.subBoxIndex.end()) return false;
   
-  if (it->second) {
-    auto&& subbox = std::move(it->second); // will get destroyed at end of scope
-    if (subbox->getDirectory()) delete subbox->getDirectory();
-    if (getDirectory()) getDirectory()->Delete((name + ";*").c_str());
+  std::size_t const iBox = it->second;
+  if (fData.subBoxes[iBox]) {
+    // will get destroyed at end of scope
+    auto subbox = std::move(fData.subBoxes[iBox]);
+    // a lazy subbox may have no directory yet (and then neither has any key)
+    if (subbox->fData.outputDir) {
+      delete subbox->fData.outputDir->getDirectory();
+      fData.outputDir->getDirectory()->Delete((name + ";*").c_str());
+    }
   }
   
-  fData.subBoxes.erase(it);
+  // the boxes after the deleted one move back by one
+  fData.subBoxes.erase(fData.subBoxes.begin() + iBox);
+  fData.subBoxIndex.erase(it);
+  for (auto& [ boxName, index ]: fData.subBoxIndex) if (index > iBox) --index;
   return true;
 } // icarus::ns::util::PlotSandbox::deleteSubSandbox()
 
@@ -645,10 +866,11 @@ void icarus::ns::util::PlotSandbox<DirectoryBackend>::dump
 template <typename DirectoryBackend>
 icarus::ns::util::PlotSandbox<DirectoryBackend>::PlotSandbox
   (PlotSandbox_t const& parent, std::string name, std::string desc)
-  : PlotSandbox
-    { parent.fData.outputDir.backend(), std::move(name), std::move(desc) }
+  : fData { std::move(name), std::move(desc), std::nullopt }
 {
   setParent(&parent);
+  fData.lazy = parent.fData.lazy;
+  if (!fData.lazy) outputDirectory(); // directory is created right away
 }
 
 
@@ -722,7 +944,8 @@ void icarus::ns::util::PlotSandbox<DirectoryBackend>::dumpContent
 {
   out << firstIndent;
   
-  TDirectory const* pDir = fData.outputDir.getDirectory();
+  TDirectory const* pDir
+    = fData.outputDir? fData.outputDir->getDirectory(): nullptr;
   if (!pDir) {
     out << "no content available";
     return;
@@ -0,0 +1,312 @@
+/**
+ * @file icarusalg/Utilities/QuantileCollector.h
+ * @brief Statistics and quantiles of a stream of data with bounded memory.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_UTILITIES_QUANTILECOLLECTOR_H
+#define ICARUSALG_UTILITIES_QUANTILECOLLECTOR_H
+
+
+// ICARUS libraries
+#include "icarusalg/Utilities/FixedBins.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::clamp()
+#include <optional>
+#include <vector>
+#include <limits>
+#include <stdexcept> // std::out_of_range
+#include <cmath> // std::sqrt(), std::floor()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+
+  template <typename T> class QuantileCollector;
+
+} // namespace icarus::ns::util
+
+/**
+ * @brief Collects count, average, RMS, extremes and quantiles of data.
+ * @param T type of data (floating point or integral)
+ *
+ * This object accumulates values one by one (`add()`), and can be queried at
+ * any time for their number, average, RMS, minimum, maximum and quantiles
+ * (e.g. the `median()`).
+ * The naming of the statistics queries follows `lar::util::StatCollector`.
+ *
+ * Quantiles can be computed in two modes:
+ * * _exact_ (`Exact`, and default): all the values are stored, and quantiles
+ *   are extracted from them; memory grows with the number of values;
+ * * _binned_: the values are counted in bins of a fixed width (see
+ *   `icarus::ns::util::FixedBins`), and the quantiles are interpolated within
+ *   the bin they fall into, assuming the values evenly spread in it; the error
+ *   on the quantiles is smaller than the bin width, and memory grows with the
+ *   spread of the values divided by the bin width, but it does not grow with
+ *   their number.
+ * The binned mode is suitable to accumulate data like waveform baselines over
+ * long periods, when the values are packed in a narrow range and a resolution
+ * can be chosen in advance.
+ *
+ * The quantile of fraction `f` is defined, in exact mode, as the value at
+ * position `f (N - 1)` in the sorted data, interpolating linearly between the
+ * two closest values when that position is not integral. With this definition
+ * the median of an even number of values is the average of the two middle
+ * ones.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::QuantileCollector<double> baselines { 0.1 }; // binned
+ * for (double const baseline: waveformBaselines) baselines.add(baseline);
+ *
+ * std::cout << "Baseline: " << baselines.Average() << " +/- "
+ *   << baselines.RMS() << ", median: " << baselines.median() << std::endl;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @note In exact mode, the stored values are sorted at the first quantile
+ *       query after they change; therefore this object is not safe to query
+ *       from multiple threads at the same time, even if constant.
+ */
+template <typename T>
+class icarus::ns::util::QuantileCollector {
+
+    public:
+
+  using Data_t = T; ///< Type of data.
+
+  /// Type of binned counts used in binned mode.
+  using Bins_t = icarus::ns::util::FixedBins<double>;
+
+  /// Type of flag for exact mode.
+  struct Exact_t {};
+
+  /// Flag for exact mode.
+  static constexpr Exact_t Exact {};
+
+
+  /// Constructor: exact mode.
+  QuantileCollector() = default;
+
+  /// Constructor: exact mode.
+  QuantileCollector(Exact_t) {}
+
+  /**
+   * @brief Constructor: binned mode.
+   * @param binWidth width of the bins used to count the values
+   * @param offset (default: `0`) the lower edge of one of the bins
+   *
+   * If `binWidth` is not positive, exact mode is used instead.
+   */
+  explicit QuantileCollector(double binWidth, double offset = 0.0)
+    {
+      if (binWidth > 0.0) fBins.emplace(binWidth, offset);
+    }
+
+
+  // --- BEGIN -- Content modification -----------------------------------------
+  /// @name Content modification
+  /// @{
+
+  /// Adds one `value`.
+  void add(Data_t value);
+
+  /// Adds all the values in the range from `begin` to `end`.
+  template <typename BIter, typename EIter>
+  void add(BIter begin, EIter end)
+    { for (auto it = begin; it != end; ++it) add(*it); }
+
+  /// Removes all the values (the mode is kept).
+  void clear() noexcept;
+
+  /// @}
+  // --- END ---- Content modification -----------------------------------------
+
+
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query interface
+  /// @{
+
+  /// Returns whether quantiles are computed exactly.
+  bool isExact() const noexcept { return !fBins.has_value(); }
+
+  /// Returns whether any value has been added.
+  bool has_data() const noexcept { return fN > 0U; }
+
+  /// Returns the number of added values.
+  std::size_t N() const noexcept { return fN; }
+
+  /// Returns the average of the values. Undefined if there is no data.
+  double Average() const noexcept { return fSum / fN; }
+
+  /// Returns the variance of the values. Undefined if there is no data.
+  double Variance() const noexcept;
+
+  /// Returns the root mean square of the values. Undefined if there is no data.
+  double RMS() const noexcept { return std::sqrt(Variance()); }
+
+  /// Returns the lowest added value. Undefined if there is no data.
+  Data_t min() const noexcept { return fMin; }
+
+  /// Returns the highest added value. Undefined if there is no data.
+  Data_t max() const noexcept { return fMax; }
+
+  /**
+   * @brief Returns the quantile of the specified `fraction` of the values.
+   * @param fraction the fraction of values below the quantile (`0` to `1`)
+   * @return the estimated quantile
+   * @throw std::out_of_range if there is no data
+   *
+   * `fraction` is clamped into `[ 0, 1 ]`.
+   * The result is always between `min()` and `max()`.
+   */
+  double quantile(double fraction) const;
+
+  /// Returns the median of the values. @throw std::out_of_range if no data
+  double median() const { return quantile(0.5); }
+
+  /// Returns the number of values or bins stored.
+  std::size_t storageSize() const noexcept
+    { return isExact()? fData.size(): fBins->nBins(); }
+
+  /// @}
+  // --- END ---- Query --------------------------------------------------------
+
+
+    private:
+
+  std::size_t fN = 0U; ///< Number of added values.
+  double fSum = 0.0; ///< Sum of the values.
+  double fSumSq = 0.0; ///< Sum of the square of the values.
+  Data_t fMin = std::numeric_limits<Data_t>::max(); ///< Lowest added value.
+  Data_t fMax = std::numeric_limits<Data_t>::lowest(); ///< Highest value.
+
+  mutable std::vector<Data_t> fData; ///< All values (exact mode only).
+  mutable bool fSorted = true; ///< Whether `fData` is sorted.
+
+  std::optional<Bins_t> fBins; ///< Counts of the values (binned mode only).
+
+  /// Returns the quantile at `position` in the stored sorted data.
+  double exactQuantile(double position) const;
+
+  /// Returns the quantile at `position` interpolated from the bin counts.
+  double binnedQuantile(double position) const;
+
+}; // icarus::ns::util::QuantileCollector
+
+
+// -----------------------------------------------------------------------------
+// --- template implementation
+// -----------------------------------------------------------------------------
+template <typename T>
+void icarus::ns::util::QuantileCollector<T>::add(Data_t value) {
+
+  double const v = static_cast<double>(value);
+  ++fN;
+  fSum += v;
+  fSumSq += v * v;
+  if (value < fMin) fMin = value;
+  if (value > fMax) fMax = value;
+
+  if (fBins) fBins->add(v);
+  else {
+    if (fSorted && !fData.empty() && (value < fData.back())) fSorted = false;
+    fData.push_back(value);
+  }
+
+} // icarus::ns::util::QuantileCollector<>::add()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void icarus::ns::util::QuantileCollector<T>::clear() noexcept {
+
+  fN = 0U;
+  fSum = fSumSq = 0.0;
+  fMin = std::numeric_limits<Data_t>::max();
+  fMax = std::numeric_limits<Data_t>::lowest();
+  fData.clear();
+  fSorted = true;
+  if (fBins) fBins->clear();
+
+} // icarus::ns::util::QuantileCollector<>::clear()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double icarus::ns::util::QuantileCollector<T>::Variance() const noexcept {
+  double const average = Average();
+  double const variance = fSumSq / fN - average * average;
+  return (variance > 0.0)? variance: 0.0; // protect against rounding
+} // icarus::ns::util::QuantileCollector<>::Variance()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double icarus::ns::util::QuantileCollector<T>::quantile(double fraction) const
+{
+  if (!has_data()) {
+    throw std::out_of_range
+      { "icarus::ns::util::QuantileCollector::quantile(): no data" };
+  }
+
+  double const position = std::clamp(fraction, 0.0, 1.0) * (fN - 1);
+  double const value
+    = isExact()? exactQuantile(position): binnedQuantile(position);
+  return std::clamp(value, double(fMin), double(fMax));
+
+} // icarus::ns::util::QuantileCollector<>::quantile()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double icarus::ns::util::QuantileCollector<T>::exactQuantile
+  (double position) const
+{
+  if (!fSorted) {
+    std::sort(fData.begin(), fData.end());
+    fSorted = true;
+  }
+
+  std::size_t const below = static_cast<std::size_t>(std::floor(position));
+  double const value = fData[below];
+  if (below + 1 >= fData.size()) return value;
+  double const f = position - below;
+  return (f == 0.0)? value: value + f * (double(fData[below + 1]) - value);
+
+} // icarus::ns::util::QuantileCollector<>::exactQuantile()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double icarus::ns::util::QuantileCollector<T>::binnedQuantile
+  (double position) const
+{
+  /*
+   * The values in each bin are assumed to be evenly spread in it, each at the
+   * center of its share of the bin.
+   */
+  Bins_t const& bins = *fBins;
+  double before = 0.0; // values in the bins before the current one
+  for (auto iBin = bins.minBin(); iBin <= bins.maxBin(); ++iBin) {
+    double const count = bins.count(iBin);
+    if (position >= before + count) {
+      before += count;
+      continue;
+    }
+    double const lowerEdge
+      = bins.min() + (iBin - bins.minBin()) * bins.binWidth();
+    return lowerEdge + (position - before + 0.5) * bins.binWidth() / count;
+  } // for
+  return fMax; // only because of rounding
+
+} // icarus::ns::util::QuantileCollector<>::binnedQuantile()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_QUANTILECOLLECTOR_H
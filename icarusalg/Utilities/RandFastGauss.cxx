@@ -0,0 +1,146 @@
+/**
+ * @file    icarusalg/Utilities/RandFastGauss.cxx
+ * @brief   Fast approximate Gaussian random translator (implementation).
+ * @date    October 14, 2026
+ * @see     `icarusalg/Utilities/RandFastGauss.h`
+ */
+
+// library header
+#include "icarusalg/Utilities/RandFastGauss.h"
+
+// C/C++ standard libraries
+#include <istream>
+#include <ostream>
+#include <limits> // std::numeric_limits<>
+
+
+// -----------------------------------------------------------------------------
+namespace {
+  
+  /// Tag written with the state of the distribution.
+  std::string const DistStateTag = "NO_CACHED_DATA";
+  
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+util::RandFastGauss::RandFastGauss(
+  CLHEP::HepRandomEngine& anEngine,
+  double mean /* = 0.0 */, double stdDev /* = 1.0 */
+)
+  : HepRandom()
+  , fTransform(mean, stdDev)
+  , localEngine(&anEngine, [](void const*){})
+  {}
+
+
+// -----------------------------------------------------------------------------
+util::RandFastGauss::RandFastGauss(
+  CLHEP::HepRandomEngine* anEngine,
+  double mean /* = 0.0 */, double stdDev /* = 1.0 */
+)
+  : HepRandom()
+  , fTransform(mean, stdDev)
+  , localEngine(anEngine)
+  {}
+
+
+// -----------------------------------------------------------------------------
+void util::RandFastGauss::shootArray(
+  CLHEP::HepRandomEngine* anEngine,
+  const int size, double* vect,
+  double mean /* = 0.0 */, double stdDev /* = 1.0 */
+) {
+  if (size <= 0) return;
+  
+  // uniform numbers are written directly in the destination,
+  // then transformed in place
+  anEngine->flatArray(size, vect);
+  
+  Gauss_t const gauss;
+  for (int i = 0; i < size; ++i)
+    vect[i] = Transform_t::transform(gauss(vect[i]), mean, stdDev);
+  
+} // util::RandFastGauss::shootArray()
+
+
+// -----------------------------------------------------------------------------
+std::ostream& util::RandFastGauss::put(std::ostream& os) const {
+  
+  auto const oldPrecision
+    = os.precision(std::numeric_limits<double>::max_digits10);
+  os << " " << name() << "\n"
+    << defaultMean() << " " << defaultStdDev() << "\n";
+  os.precision(oldPrecision);
+  return os;
+  
+} // util::RandFastGauss::put()
+
+
+// -----------------------------------------------------------------------------
+std::istream& util::RandFastGauss::get(std::istream& is) {
+  
+  std::string tag;
+  is >> tag;
+  if (tag != name()) {
+    is.setstate(std::ios::failbit);
+    return is;
+  }
+  
+  double mean, stdDev;
+  if (is >> mean >> stdDev) fTransform = Transform_t{ mean, stdDev };
+  return is;
+  
+} // util::RandFastGauss::get()
+
+
+// -----------------------------------------------------------------------------
+void util::RandFastGauss::saveEngineStatus
+  (const char filename[] /* = "Config.conf" */)
+{
+  // no cached data to add
+  getTheEngine()->saveStatus(filename);
+} // util::RandFastGauss::saveEngineStatus()
+
+
+// -----------------------------------------------------------------------------
+void util::RandFastGauss::restoreEngineStatus
+  (const char filename[] /* = "Config.conf" */)
+{
+  getTheEngine()->restoreStatus(filename);
+} // util::RandFastGauss::restoreEngineStatus()
+
+
+// -----------------------------------------------------------------------------
+std::ostream& util::RandFastGauss::saveFullState(std::ostream& os) {
+  CLHEP::HepRandom::saveFullState(os);
+  return saveDistState(os);
+} // util::RandFastGauss::saveFullState()
+
+
+// -----------------------------------------------------------------------------
+std::istream& util::RandFastGauss::restoreFullState(std::istream& is) {
+  CLHEP::HepRandom::restoreFullState(is);
+  return restoreDistState(is);
+} // util::RandFastGauss::restoreFullState()
+
+
+// -----------------------------------------------------------------------------
+std::ostream& util::RandFastGauss::saveDistState(std::ostream& os) {
+  return os << distributionName() << " " << DistStateTag << "\n";
+} // util::RandFastGauss::saveDistState()
+
+
+// -----------------------------------------------------------------------------
+std::istream& util::RandFastGauss::restoreDistState(std::istream& is) {
+  
+  std::string name, tag;
+  is >> name >> tag;
+  if ((name != distributionName()) || (tag != DistStateTag))
+    is.setstate(std::ios::failbit);
+  return is;
+  
+} // util::RandFastGauss::restoreDistState()
+
+
+// -----------------------------------------------------------------------------
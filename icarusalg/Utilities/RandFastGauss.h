@@ -2,6 +2,7 @@
  * @file    icarusalg/Utilities/RandFastGauss.h
  * @brief   Fast approximate Gaussian random translator.
  * @date    February 15, 2020
+ * @see     `icarusalg/Utilities/RandFastGauss.cxx`
  */
 
 #ifndef ICARUSALG_UTILITIES_RANDFASTGAUS_H
@@ -16,7 +17,10 @@
 #include "CLHEP/Random/RandomEngine.h"
 
 // C/C++ standard libraries
+#include <iosfwd>
 #include <memory> // std::shared_ptr
+#include <string>
+#include <cstddef> // std::size_t
 
 
 // -----------------------------------------------------------------------------
@@ -24,24 +28,57 @@ namespace util { class RandFastGauss; }
 
 /**
  * @brief Normal distribution focussing on speed.
- * 
- * The random number is generated via `util::FastAndPoorGauss<double>`.
- * 
- * @note This class is incomplete.
+ *
+ * The random number is generated via `util::FastAndPoorGauss<double>`, from
+ * a single uniform number from the engine. The resolution of the values is
+ * limited by the size of its table (`NPoints`).
+ *
+ * The interface follows the one of the CLHEP distributions
+ * (e.g. `CLHEP::RandGauss`): the static `shoot()` methods use the static
+ * generator engine (`CLHEP::HepRandom::getTheEngine()`) or the one specified
+ * in the call, while the `fire()` methods use the engine of the object.
+ *
+ *
+ * Extraction of many numbers
+ * ---------------------------
+ *
+ * `fireArray()` and `shootArray()` fill an array with normal numbers,
+ * fetching all the needed uniform numbers from the engine at once
+ * (`CLHEP::HepRandomEngine::flatArray()`) and then transforming them in a
+ * single, simple loop which the compiler can vectorize. The result is the same
+ * as the one of a sequence of `fire()` calls.
+ *
+ *
+ * Saving the status
+ * ------------------
+ *
+ * This distribution does not cache any number, so that the status of the
+ * random sequence is entirely in the engine. The full state saved by
+ * `saveFullState()` is the state of the static engine, followed by the state
+ * of the distribution, which includes only a tag for validation.
+ * `put()` and `get()` save and restore the parameters of this object (mean and
+ * standard deviation), but not its engine: use the engine methods directly
+ * (e.g. `engine().put(os)`).
  */
 class util::RandFastGauss: public CLHEP::HepRandom {
 
     public:
 
+  /// Number of points in the Gaussian table.
+  static constexpr std::size_t NPoints = 32768U;
+
+  /// Type of the transformation of uniform into normal numbers.
+  using Gauss_t = util::FastAndPoorGauss<NPoints>;
+
   /// Constructor: borrows an engine but does not manage it.
   RandFastGauss(
     CLHEP::HepRandomEngine& anEngine,
     double mean = 0.0, double stdDev = 1.0
     );
-  
+
   /**
    * @brief Constructor: takes ownership of the engine.
-   * 
+   *
    * The ownership of the specified engine is transferred to this object, which
    * will dispose of it at the end of its life.
    */
@@ -50,120 +87,128 @@ class util::RandFastGauss: public CLHEP::HepRandom {
     double mean = 0.0, double stdDev = 1.0
     );
 
-  // --- BEGIN -- Not implemented ----------------------------------------------
-  static double shoot();
+  // --- BEGIN -- Static generation --------------------------------------------
+  /// @name Generation with the static engine or a specified one
+  /// @{
+
+  /// Returns a standard normal number from the static engine.
+  static double shoot() { return shoot(getTheEngine()); }
 
-  static double shoot(double mean, double stdDev);
+  /// Returns a normal number from the static engine.
+  static double shoot(double mean, double stdDev)
+    { return shoot(getTheEngine(), mean, stdDev); }
 
+  /// Fills `vect` with `size` normal numbers from the static engine.
   static void shootArray
-    (const int size, double* vect, double mean = 0.0, double stdDev = 1.0);
+    (const int size, double* vect, double mean = 0.0, double stdDev = 1.0)
+    { shootArray(getTheEngine(), size, vect, mean, stdDev); }
 
-  static double shoot(CLHEP::HepRandomEngine* anEngine);
+  /// Returns a standard normal number from `anEngine`.
+  static double shoot(CLHEP::HepRandomEngine* anEngine)
+    { return toGauss(anEngine->flat()); }
 
+  /// Returns a normal number from `anEngine`.
   static double shoot
-    (CLHEP::HepRandomEngine* anEngine, double mean, double stdDev);
+    (CLHEP::HepRandomEngine* anEngine, double mean, double stdDev)
+    { return Transform_t::transform(shoot(anEngine), mean, stdDev); }
 
+  /// Fills `vect` with `size` normal numbers from `anEngine`.
   static void shootArray(CLHEP::HepRandomEngine* anEngine,
     const int size, double* vect, double mean = 0.0, double stdDev = 1.0);
 
-  // --- END -- Not implemented ------------------------------------------------
-  
+  /// @}
+  // --- END ---- Static generation --------------------------------------------
+
   /// Extracts a single normal value under the default distribution.
   double fire() { return fTransform(normal()); }
 
   /// Extracts a single normal value under the specified normal distribution.
   double fire(double mean, double stdDev) { return normal() * stdDev + mean; }
-  
-  // --- BEGIN -- Not implemented ----------------------------------------------
-  void fireArray(const int size, double* vect);
-  void fireArray(const int size, double* vect, double mean, double stdDev);
-  // --- END -- Not implemented ------------------------------------------------
+
+  /// Fills `vect` with `size` values under the default distribution.
+  void fireArray(const int size, double* vect)
+    { fireArray(size, vect, fTransform.mean(), fTransform.stdDev()); }
+
+  /// Fills `vect` with `size` values under the specified normal distribution.
+  void fireArray(const int size, double* vect, double mean, double stdDev)
+    { shootArray(localEngine.get(), size, vect, mean, stdDev); }
 
   /// Extracts a single normal value under the default distribution.
   virtual double operator()() override { return fire(); }
-  
+
   /// Extracts a single normal value under the specified normal distribution.
   double operator()(double mean, double stdDev) { return fire(mean, stdDev); }
 
   /// Returns the name of the distribution.
   virtual std::string name() const override { return distributionName(); }
-  
+
   /// Returns the default random generator engine.
   virtual CLHEP::HepRandomEngine& engine() override { return *localEngine; }
 
   /// Returns the name of the distribution.
   static std::string distributionName() { return "RandFastGauss"; }
-  
-  // --- BEGIN -- Not implemented ----------------------------------------------
-  virtual std::ostream& put(std::ostream& os) const override
-    { return os; }
-  virtual std::istream& get(std::istream& is) override
-    { return is; }
-  
+
+  /// Returns the mean of the default distribution.
+  double defaultMean() const { return fTransform.mean(); }
+
+  /// Returns the standard deviation of the default distribution.
+  double defaultStdDev() const { return fTransform.stdDev(); }
+
+
+  // --- BEGIN -- Status -------------------------------------------------------
+  /// @name Saving and restoring the status
+  /// @{
+
+  /// Writes the parameters of the distribution into `os`.
+  virtual std::ostream& put(std::ostream& os) const override;
+
+  /// Reads the parameters of the distribution from `is`.
+  virtual std::istream& get(std::istream& is) override;
+
   // Methods overriding the base class static saveEngineStatus ones,
   // by adding extra data so that save in one program, then further gaussians,
-  // will produce the identical sequence to restore in another program, then 
-  // generating gaussian randoms there 
+  // will produce the identical sequence to restore in another program, then
+  // generating gaussian randoms there
 
-  static void saveEngineStatus( const char filename[] = "Config.conf" );
-  // Saves to file the current status of the current engine.
+  /// Saves to file the current status of the static engine.
+  static void saveEngineStatus(const char filename[] = "Config.conf");
 
-  static void restoreEngineStatus( const char filename[] = "Config.conf" );
-  // Restores a saved status (if any) for the current engine.
+  /// Restores a saved status (if any) for the static engine.
+  static void restoreEngineStatus(const char filename[] = "Config.conf");
 
-  static std::ostream& saveFullState ( std::ostream & os );
-  // Saves to stream the state of the engine and cached data.
+  /// Saves to stream the state of the static engine and cached data.
+  static std::ostream& saveFullState(std::ostream& os);
 
-  static std::istream& restoreFullState ( std::istream & is );
-  // Restores from stream the state of the engine and cached data.
+  /// Restores from stream the state of the static engine and cached data.
+  static std::istream& restoreFullState(std::istream& is);
 
-  static std::ostream& saveDistState ( std::ostream & os );
-  // Saves to stream the state of the cached data.
+  /// Saves to stream the state of the cached data (actually none).
+  static std::ostream& saveDistState(std::ostream& os);
 
-  static std::istream& restoreDistState ( std::istream & is );
-  // Restores from stream the state of the cached data.
-  // --- END -- Not implemented ------------------------------------------------
+  /// Restores from stream the state of the cached data (actually none).
+  static std::istream& restoreDistState(std::istream& is);
+
+  /// @}
+  // --- END ---- Status -------------------------------------------------------
 
 
 protected:
-  
-  util::GaussianTransformer<double> fTransform;
 
-  std::shared_ptr<CLHEP::HepRandomEngine> localEngine;
+  using Transform_t = util::GaussianTransformer<double>;
 
-  double normal() { return fToGauss(localEngine->flat()); }
+  Transform_t fTransform;
 
-private:
-  
-  /// Translates uniform number in [ 0, 1 ] into a Gaussian number.
-  util::FastAndPoorGauss<32768U> fToGauss; // TODO make it static
-  
+  std::shared_ptr<CLHEP::HepRandomEngine> localEngine;
 
-}; // util::RandFastGauss
+  double normal() { return toGauss(localEngine->flat()); }
 
+private:
 
-// -----------------------------------------------------------------------------
-// ---  inline implementation
-// -----------------------------------------------------------------------------
-util::RandFastGauss::RandFastGauss(
-  CLHEP::HepRandomEngine& anEngine,
-  double mean /* = 0.0 */, double stdDev /* = 1.0 */
-)
-  : HepRandom()
-  , fTransform(mean, stdDev)
-  , localEngine(&anEngine, [](void const*){})
-  {}
+  /// Translates uniform number in [ 0, 1 ] into a Gaussian number.
+  static double toGauss(double u) { return Gauss_t{}(u); }
 
 
-// -----------------------------------------------------------------------------
-util::RandFastGauss::RandFastGauss(
-  CLHEP::HepRandomEngine* anEngine,
-  double mean /* = 0.0 */, double stdDev /* = 1.0 */
-)
-  : HepRandom()
-  , fTransform(mean, stdDev)
-  , localEngine(anEngine)
-  {}
+}; // util::RandFastGauss
 
 
 // -----------------------------------------------------------------------------
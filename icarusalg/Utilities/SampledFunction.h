@@ -20,9 +20,13 @@
 
 // C++ standard library
 #include <vector>
+#include <string>
 #include <functional> // std::function<>
+#include <memory> // std::shared_ptr<>
+#include <utility> // std::move()
 #include <limits> // std::numeric_limits<>
-#include <cmath> // std::isnormal()
+#include <algorithm> // std::min(), std::max()
+#include <cmath> // std::isnormal(), std::floor()
 #include <cassert>
 
 
@@ -55,6 +59,39 @@ namespace util {
  * The function must be unary.
  *
  *
+ * Copies and sharing of the samples
+ * ----------------------------------
+ *
+ * The samples are not modified after construction, and they are held in
+ * shared, immutable storage (`Storage_t`): copies of a sampled function
+ * share the same samples instead of duplicating them. Therefore, copying a
+ * sampled function (e.g. one for each thread) is cheap, and all the copies
+ * can be used concurrently.
+ *
+ * The sampled function is not retained, and its type does not enter the type
+ * of this object: the constructors are templates on the type of the function,
+ * which is called directly, with no type erasure, for the sampling.
+ *
+ *
+ * Evaluation
+ * -----------
+ *
+ * All the _M N_ samples together make a single sampling of the function with
+ * step size `substepSize()`, starting at `lower()`. `evaluate()` computes the
+ * value of the function from it at arbitrary points, either taking the value
+ * of the nearest sample (`Interpolation::nearest`) or interpolating linearly
+ * between the two closest samples (`Interpolation::linear`).
+ * The batch version fills a whole range of values in a single loop without
+ * branches, which the compiler can vectorize:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * sampled.evaluate<decltype(sampled)::Interpolation::linear>(times, values);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * If the number of subsamples is known at compile time, it can be specified
+ * as second template argument (e.g. `evaluate<Interpolation::nearest, 4>()`),
+ * and the index arithmetic to locate a sample in the storage reduces to
+ * multiplications and shifts by constants.
+ *
+ *
  * Technical note
  * ---------------
  *
@@ -96,12 +133,24 @@ class util::SampledFunction {
   using Y_t = YType; ///< Type of value returned by the function.
   using Function_t = std::function<Y_t(X_t)>; ///< Type of sampled function.
 
+  /// Type of the (shared, immutable) storage of all the samples.
+  using Storage_t = std::shared_ptr<std::vector<Y_t> const>;
+
   /// Invalid index of sample, returned in case of error.
   static constexpr auto npos = std::numeric_limits<gsl::index>::max();
 
   /// Span of subsample data. Can be forward iterated.
   using SubsampleData_t = gsl::span<Y_t const>;
 
+  /// Interpolation modes for `evaluate()`.
+  enum class Interpolation {
+    nearest, ///< Value of the closest sample.
+    linear   ///< Linear interpolation between the two closest samples.
+  }; // Interpolation
+
+  /// Value for `evaluate()` when the number of subsamples is not fixed.
+  static constexpr gsl::index DynamicSubsamples = 0;
+
   SampledFunction() = default; // FIXME remove this
   
   /**
@@ -234,6 +283,12 @@ class util::SampledFunction {
     { return { subsampleData(n), static_cast<std::size_t>(fNSamples) }; }
   // @}
 
+  // @{
+  /// Returns the storage of all the samples, shared with the copies of this
+  /// object (the first subsample first).
+  Storage_t const& samplesStorage() const { return fAllSamples; }
+  // @}
+
   // @{
   /**
    * @brief Returns the index of the step including `x`.
@@ -282,6 +337,56 @@ class util::SampledFunction {
   /// @}
   // --- END --- Access --------------------------------------------------------
 
+
+  // --- BEGIN --- Evaluation --------------------------------------------------
+  /**
+   * @name Evaluation
+   *
+   * The function is evaluated from all the samples of all the subsamples,
+   * which together cover the range with steps of `substepSize()`.
+   * The function is considered to have value `outside` out of the sampled
+   * points: with `Interpolation::nearest`, points whose closest sample does not
+   * exist are assigned `outside`; with `Interpolation::linear`, the value
+   * between the first (last) sample and the non-existing one before (after) it
+   * is interpolated between that sample and `outside`.
+   *
+   * The template argument `Subsamples`, if not `DynamicSubsamples`, must be
+   * equal to `nSubsamples()`: it allows the compiler to optimize the access to
+   * the samples.
+   */
+  /// @{
+
+  /// Returns the function evaluated at `x` with the specified interpolation.
+  template <
+    Interpolation Interp = Interpolation::nearest,
+    gsl::index Subsamples = DynamicSubsamples
+    >
+  Y_t evaluate(X_t x, Y_t outside = Y_t{}) const;
+
+  /**
+   * @brief Evaluates the function at all points `xs` and stores them in `out`.
+   * @tparam Interp the interpolation mode
+   * @tparam Subsamples number of subsamples, if known at compile time
+   * @param xs the points where to evaluate the function
+   * @param out the span where to store the values (as large as `xs`)
+   * @param outside (default: `0`) value of the function out of the samples
+   */
+  template <
+    Interpolation Interp = Interpolation::nearest,
+    gsl::index Subsamples = DynamicSubsamples
+    >
+  void evaluate
+    (gsl::span<X_t const> xs, gsl::span<Y_t> out, Y_t outside = Y_t{}) const;
+
+  /// Evaluates the function at all points `xs` with interpolation `interp`.
+  void evaluate(
+    gsl::span<X_t const> xs, gsl::span<Y_t> out, Interpolation interp,
+    Y_t outside = Y_t{}
+    ) const;
+
+  /// @}
+  // --- END --- Evaluation ----------------------------------------------------
+
   /// Dumps the full content of the sampling into `out` stream.
   template <typename Stream>
   void dump
@@ -310,40 +415,71 @@ class util::SampledFunction {
 
   X_t fStep; ///< Step size.
 
-  /// All samples, the entire first subsample first.
-  std::vector<Y_t> fAllSamples;
+  /// All samples, the entire first subsample first (shared among copies).
+  Storage_t fAllSamples;
 
   /// Constructor implementation.
+  template <typename Func>
   SampledFunction
-    (Function_t const& function, Range_t const& range, gsl::index subsamples);
+    (Func const& function, Range_t const& range, gsl::index subsamples);
 
   /// Returns the starting point of the subsample `n`.
   X_t subsampleOffset(gsl::index n) const
     { return lower() + substepSize() * n; }
 
 
-  // @{
   /// Start of the block of values for subsample `n` (unchecked).
   Y_t const* subsampleData(gsl::index n) const
-    { return fAllSamples.data() + fNSamples * n; }
-  Y_t* subsampleData(gsl::index n) { return fAllSamples.data() + fNSamples * n; }
-  // @}
+    { return fAllSamples->data() + fNSamples * n; }
 
   /// Computes the total size of the data.
   std::size_t computeTotalSize() const { return nSubsamples() * size(); }
 
+  /**
+   * @brief Evaluation of the function from a copy of the sampling parameters.
+   * @tparam Subsamples number of subsamples, or `DynamicSubsamples`
+   *
+   * Loops on a local evaluator object do not need to reload the sampling
+   * parameters after each write, and can be vectorized.
+   */
+  template <gsl::index Subsamples>
+  struct Evaluator_t {
+    Y_t const* data; ///< All the samples.
+    gsl::index nSamples; ///< Number of samples in each subsample.
+    gsl::index nSubsamples; ///< Number of subsamples.
+    double lower; ///< Lower limit of the sampled range.
+    double substep; ///< Substep size.
+
+    /// Returns the function evaluated at `x`.
+    template <Interpolation Interp>
+    Y_t evaluate(X_t x, Y_t outside) const;
+
+    /// Returns the value of the sample `k` in the full sampling, or `outside`.
+    Y_t sampleOrDefault(gsl::index k, Y_t outside) const;
+
+    /// Returns the number of subsamples (constant if possible).
+    constexpr gsl::index M() const
+      { return (Subsamples == DynamicSubsamples)? nSubsamples: Subsamples; }
+
+  }; // Evaluator_t
+
+  /// Returns an evaluator for this function.
+  template <gsl::index Subsamples>
+  Evaluator_t<Subsamples> makeEvaluator() const;
+
 
   /// Returns a range including at least from `lower` to `min_upper`,
   /// extended enough that `until(upper, f(upper))` is `true`, and with an
   /// integral number of steps.
-  template <typename UntilFunc>
+  template <typename Func, typename UntilFunc>
   static Range_t extendRange(
-    Function_t const& function, X_t lower, X_t min_upper, X_t step,
+    Func const& function, X_t lower, X_t min_upper, X_t step,
     UntilFunc&& until
     );
 
   /// Samples the `function` and fills the internal caches.
-  void fillSamples(Function_t const& function);
+  template <typename Func>
+  void fillSamples(Func const& function);
 
 
   /// Returns `value` made non-negative by adding multiples of `range`.
@@ -384,7 +520,7 @@ util::SampledFunction<XType, YType>::SampledFunction(
   gsl::index subsamples
   )
   : SampledFunction(
-      Function_t(function),
+      function,
       Range_t{ lower, upper, (upper - lower) / nSamples, nSamples },
       subsamples
     )
@@ -401,7 +537,7 @@ util::SampledFunction<XType, YType>::SampledFunction(
   X_t min_upper
   )
   : SampledFunction(
-      Function_t(function),
+      function,
       extendRange
         (function, lower, min_upper, step, std::forward<UntilFunc>(until)),
       subsamples
@@ -431,6 +567,66 @@ gsl::index util::SampledFunction<XType, YType>::closestSubsampleIndex
 } // gsl::index util::SampledFunction<XType, YType>::stepIndex()
 
 
+// -----------------------------------------------------------------------------
+template <typename XType, typename YType>
+template <
+  typename util::SampledFunction<XType, YType>::Interpolation Interp,
+  gsl::index Subsamples
+  >
+auto util::SampledFunction<XType, YType>::evaluate
+  (X_t const x, Y_t const outside /* = Y_t{} */) const -> Y_t
+{
+  return makeEvaluator<Subsamples>().template evaluate<Interp>(x, outside);
+} // util::SampledFunction<>::evaluate()
+
+
+// -----------------------------------------------------------------------------
+template <typename XType, typename YType>
+template <
+  typename util::SampledFunction<XType, YType>::Interpolation Interp,
+  gsl::index Subsamples
+  >
+void util::SampledFunction<XType, YType>::evaluate(
+  gsl::span<X_t const> xs, gsl::span<Y_t> out, Y_t const outside /* = Y_t{} */
+) const {
+  assert(out.size() >= xs.size());
+
+  // the values are computed in chunks in a local buffer: the compiler knows
+  // that it can't alias the samples, and can then vectorize the gathering loop
+  constexpr gsl::index ChunkSize = 64;
+  Y_t buffer[ChunkSize];
+
+  auto const evaluator = makeEvaluator<Subsamples>();
+  X_t const* x = xs.data();
+  Y_t* y = out.data();
+  for (auto n = static_cast<gsl::index>(xs.size()); n > 0; n -= ChunkSize) {
+    gsl::index const nChunk = std::min(n, ChunkSize);
+    for (gsl::index i = 0; i < nChunk; ++i)
+      buffer[i] = evaluator.template evaluate<Interp>(x[i], outside);
+    y = std::copy(buffer, buffer + nChunk, y);
+    x += nChunk;
+  } // for chunks
+
+} // util::SampledFunction<>::evaluate(span)
+
+
+// -----------------------------------------------------------------------------
+template <typename XType, typename YType>
+void util::SampledFunction<XType, YType>::evaluate(
+  gsl::span<X_t const> xs, gsl::span<Y_t> out, Interpolation interp,
+  Y_t const outside /* = Y_t{} */
+) const {
+  switch (interp) {
+    case Interpolation::nearest:
+      evaluate<Interpolation::nearest>(xs, out, outside);
+      return;
+    case Interpolation::linear:
+      evaluate<Interpolation::linear>(xs, out, outside);
+      return;
+  } // switch
+} // util::SampledFunction<>::evaluate(interp)
+
+
 // -----------------------------------------------------------------------------
 template <typename XType, typename YType>
 template <typename Stream>
@@ -457,8 +653,9 @@ void util::SampledFunction<XType, YType>::dump
 
 // -----------------------------------------------------------------------------
 template <typename XType, typename YType>
+template <typename Func>
 util::SampledFunction<XType, YType>::SampledFunction(
-  Function_t const& function,
+  Func const& function,
   Range_t const& range,
   gsl::index subsamples
   )
@@ -467,7 +664,6 @@ util::SampledFunction<XType, YType>::SampledFunction(
   , fNSamples(range.nSamples)
   , fNSubsamples(subsamples)
   , fStep(range.step)
-  , fAllSamples(computeTotalSize())
 {
   assert(fNSamples > 0);
   assert(subsamples > 0);
@@ -477,9 +673,9 @@ util::SampledFunction<XType, YType>::SampledFunction(
 
 // -----------------------------------------------------------------------------
 template <typename XType, typename YType>
-template <typename UntilFunc>
+template <typename Func, typename UntilFunc>
 auto util::SampledFunction<XType, YType>::extendRange(
-  Function_t const& function, X_t lower, X_t min_upper, X_t step,
+  Func const& function, X_t lower, X_t min_upper, X_t step,
   UntilFunc&& until
   ) -> Range_t
 {
@@ -504,15 +700,15 @@ auto util::SampledFunction<XType, YType>::extendRange(
 
 // -----------------------------------------------------------------------------
 template <typename XType, typename YType>
-void util::SampledFunction<XType, YType>::fillSamples
-  (Function_t const& function)
-{
+template <typename Func>
+void util::SampledFunction<XType, YType>::fillSamples(Func const& function) {
 
   /*
    * Plan:
    * 0. rely on the currently stored size specifications (range and samples)
    * 1. resize the data structure to the required size
    * 2. fill all the subsamples, in sequence
+   * 3. move the samples into their shared storage
    *
    */
 
@@ -527,12 +723,12 @@ void util::SampledFunction<XType, YType>::fillSamples
   //
   // 1. resize the data structure to the required size
   //
-  fAllSamples.resize(dataSize);
+  std::vector<Y_t> samples(dataSize);
 
   //
   // 2. fill all the subsamples, in sequence
   //
-  auto iValue = fAllSamples.begin();
+  auto iValue = samples.begin();
   for (gsl::index const iSubsample: util::counter(nSubsamples())) {
     X_t const offset = subsampleOffset(iSubsample);
     for (gsl::index const iStep: util::counter(size())) {
@@ -542,9 +738,73 @@ void util::SampledFunction<XType, YType>::fillSamples
     } // for steps
   } // for subsamples
 
+  //
+  // 3. move the samples into their shared storage
+  //
+  fAllSamples = std::make_shared<std::vector<Y_t> const>(std::move(samples));
+
 } // util::SampledFunction<>::fillSamples()
 
 
+// -----------------------------------------------------------------------------
+template <typename XType, typename YType>
+template <gsl::index Subsamples>
+auto util::SampledFunction<XType, YType>::makeEvaluator() const
+  -> Evaluator_t<Subsamples>
+{
+  static_assert(Subsamples >= 0);
+  assert((Subsamples == DynamicSubsamples) || (Subsamples == nSubsamples()));
+  return {
+    fAllSamples->data(), size(), nSubsamples(),
+    static_cast<double>(lower()), static_cast<double>(substepSize())
+    };
+} // util::SampledFunction<>::makeEvaluator()
+
+
+// -----------------------------------------------------------------------------
+template <typename XType, typename YType>
+template <gsl::index Subsamples>
+template <typename util::SampledFunction<XType, YType>::Interpolation Interp>
+auto util::SampledFunction<XType, YType>::Evaluator_t<Subsamples>::evaluate
+  (X_t const x, Y_t const outside) const -> Y_t
+{
+  // position in units of substeps, clamped so that conversions are defined
+  auto const nTotal = static_cast<double>(nSamples * M());
+  double const t = std::min(
+    std::max((static_cast<double>(x) - lower) / substep, -1.0), nTotal
+    );
+
+  // since t >= -1, truncation of t + 1 is its floor plus 1: unlike
+  // `std::floor()`, truncation to an integer can be vectorized
+  if constexpr (Interp == Interpolation::nearest) {
+    return sampleOrDefault(static_cast<gsl::index>(t + 1.5) - 1, outside);
+  }
+  else {
+    gsl::index const i = static_cast<gsl::index>(t + 1.0) - 1;
+    auto const f = static_cast<Y_t>(t - static_cast<double>(i));
+    Y_t const y0 = sampleOrDefault(i, outside);
+    Y_t const y1 = sampleOrDefault(i + 1, outside);
+    return y0 + f * (y1 - y0);
+  }
+
+} // util::SampledFunction<>::Evaluator_t<>::evaluate()
+
+
+// -----------------------------------------------------------------------------
+template <typename XType, typename YType>
+template <gsl::index Subsamples>
+auto util::SampledFunction<XType, YType>::Evaluator_t<Subsamples>
+  ::sampleOrDefault(gsl::index const k, Y_t const outside) const -> Y_t
+{
+  // written with no branches, so that loops on it can be vectorized
+  bool const inRange = (k >= 0) & (k < nSamples * M());
+  gsl::index const kc = inRange? k: 0;
+  // sample `k` is sample `k / M` of the subsample `k % M`
+  Y_t const y = data[(kc % M()) * nSamples + kc / M()];
+  return inRange? y: outside;
+} // util::SampledFunction<>::Evaluator_t<>::sampleOrDefault()
+
+
 // -----------------------------------------------------------------------------
 template <typename XType, typename YType>
 template <typename T>
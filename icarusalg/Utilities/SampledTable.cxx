@@ -0,0 +1,50 @@
+/**
+ * @file   icarusalg/Utilities/SampledTable.cxx
+ * @brief  Class for a multi-dimensional function with precomputed values.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Utilities/SampledTable.h`
+ */
+
+// library header
+#include "icarusalg/Utilities/SampledTable.h"
+
+// POSIX libraries
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <fcntl.h> // open()
+#include <unistd.h> // close()
+
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<void const> util::details::mapFileReadOnly
+  (std::string const& path, std::size_t& size)
+{
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error
+      { "util::SampledTable: can't open '" + path + "'" };
+  }
+
+  struct ::stat info;
+  if ((::fstat(fd, &info) != 0) || (info.st_size <= 0)) {
+    ::close(fd);
+    throw std::runtime_error
+      { "util::SampledTable: '" + path + "' is empty or not readable" };
+  }
+  size = static_cast<std::size_t>(info.st_size);
+
+  void* const addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping survives the file descriptor
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error
+      { "util::SampledTable: can't map '" + path + "' in memory" };
+  }
+
+  return std::shared_ptr<void const>
+    { addr, [size](void const* p){ ::munmap(const_cast<void*>(p), size); } };
+
+} // util::details::mapFileReadOnly()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,875 @@
+/**
+ * @file   icarusalg/Utilities/SampledTable.h
+ * @brief  Class for a multi-dimensional function with precomputed values.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    `icarusalg/Utilities/SampledTable.cxx`,
+ *         `icarusalg/Utilities/SampledFunction.h`
+ *
+ * The class is header-only, but the support for files requires linking with
+ * `icarusalg_Utilities`.
+ */
+
+#ifndef ICARUSALG_UTILITIES_SAMPLEDTABLE_H
+#define ICARUSALG_UTILITIES_SAMPLEDTABLE_H
+
+// C++ core guideline library
+#include "gsl/span"
+#include "gsl/util" // gsl::index
+
+// C++ standard library
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <memory> // std::shared_ptr<>
+#include <tuple> // std::apply()
+#include <type_traits> // std::is_invocable_v
+#include <utility> // std::move()
+#include <algorithm> // std::min(), std::max(), std::copy()
+#include <stdexcept> // std::runtime_error
+#include <cstdint> // std::uint32_t, std::int64_t
+#include <cstdio> // std::rename(), std::remove()
+#include <cstring> // std::memcpy()
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// ---------------------------------------------------------------------------
+namespace util {
+
+  template <std::size_t N, typename XType, typename YType> class SampledTable;
+
+  namespace details {
+
+    /**
+     * @brief Maps read-only the file at `path` in memory.
+     * @param path the file to be mapped
+     * @param[out] size the size of the file, in bytes
+     * @return a pointer to the start of the mapping, which it owns
+     * @throw std::runtime_error if the file can't be mapped
+     *
+     * The mapping is released when the last copy of the pointer is destroyed.
+     */
+    std::shared_ptr<void const> mapFileReadOnly
+      (std::string const& path, std::size_t& size);
+
+  } // namespace details
+
+} // namespace util
+
+/**
+ * @brief Precomputed sampling of a function of `N` variables on a grid.
+ * @tparam N number of variables (dimensions) of the function
+ * @tparam XType (default: `double`) type of the variables of the function
+ * @tparam YType (default: as `XType`) type of value returned by the function
+ *
+ * This object is the multi-dimensional version of `util::SampledFunction`
+ * (without subsampling): it stores the values of a function on a regular grid,
+ * and evaluates the function anywhere from them, either taking the value of the
+ * nearest sample (`Interpolation::nearest`) or interpolating multilinearly
+ * between the `2^N` surrounding samples (`Interpolation::linear`).
+ * It is meant for lookup tables like the photon visibility (position and
+ * optical detector) or the field response (position and time).
+ *
+ * Each dimension is described by an `Axis_t`: _n_ samples, starting at
+ * `lower` and spaced by `step`, last value (`upper()`) excluded, like in
+ * `util::SampledFunction`.
+ *
+ *
+ * Creation
+ * ---------
+ *
+ * * from a function, with the constructor: the function is called either with
+ *   `N` arguments of type `X_t`, or with a single `Coords_t` (array of `N`
+ *   coordinates);
+ * * from existing values (e.g. a table read from a file), with `fromValues()`;
+ * * from a file written by `save()` or `sampleToFile()`, with `mapFile()`.
+ *
+ *
+ * Storage
+ * --------
+ *
+ * The samples are stored in a single contiguous array, in blocks of
+ * `BlockEdge^N` samples covering a small hypercube of the grid (with a single
+ * dimension, blocks are not needed and the samples are stored in order).
+ * The `2^N` samples used by a multilinear interpolation, and the ones of
+ * nearby points, are then mostly in the same block, that is in a few cache
+ * lines, while with a plain row-major layout they would be spread at the
+ * distance of whole rows and planes of the table.
+ * `fromValues()` accepts values in row-major order (last index running
+ * fastest) and rearranges them.
+ *
+ * As in `util::SampledFunction`, the samples are not modified after creation,
+ * and they are held in shared, immutable storage (`Storage_t`): copies of a
+ * table share the same samples, and can be used concurrently.
+ *
+ *
+ * Tables larger than memory
+ * --------------------------
+ *
+ * A table can be written into a file (`save()`), or sampled directly into a
+ * file one block at a time (`sampleToFile()`), without ever holding the whole
+ * table in memory. `mapFile()` then creates a table whose storage is that file
+ * mapped in memory: the operating system loads only the blocks which are
+ * actually used, and can drop them again when memory is needed.
+ * The file format is the in-memory representation: it is meant to be read
+ * on the same platform it was written on.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * using Table_t = util::SampledTable<2U, double, float>;
+ * Table_t const response {
+ *   [](double x, double t){ return std::exp(-x * x - t); },
+ *   { Table_t::makeAxis(-1.0, 1.0, 100), Table_t::makeAxis(0.0, 5.0, 500) }
+ *   };
+ * float const value = response.evaluate<Table_t::Interpolation::linear>
+ *   ({ 0.25, 1.3 });
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <std::size_t N, typename XType = double, typename YType = XType>
+class util::SampledTable {
+
+  static_assert(N > 0U, "SampledTable requires at least one dimension.");
+
+    public:
+
+  using X_t = XType; ///< Type of the variables of the function.
+  using Y_t = YType; ///< Type of value returned by the function.
+
+  /// Number of variables (dimensions) of the function.
+  static constexpr std::size_t Dims = N;
+
+  /// Type of the coordinates of a point.
+  using Coords_t = std::array<X_t, N>;
+
+  /// Type of the index of a sample (one index per dimension).
+  using Index_t = std::array<gsl::index, N>;
+
+  /// Type of the (shared, immutable) storage of all the samples.
+  using Storage_t = std::shared_ptr<Y_t const>;
+
+  /// Sampling of one dimension.
+  struct Axis_t {
+    X_t lower; ///< Coordinate of the first sample.
+    X_t step; ///< Distance between samples.
+    gsl::index nSamples; ///< Number of samples.
+
+    /// Returns the upper limit of the sampled range (excluded).
+    X_t upper() const { return lower + step * nSamples; }
+  }; // Axis_t
+
+  /// Sampling of all the dimensions.
+  using Axes_t = std::array<Axis_t, N>;
+
+  /// Interpolation modes for `evaluate()`.
+  enum class Interpolation {
+    nearest, ///< Value of the closest sample.
+    linear   ///< Multilinear interpolation between the closest samples.
+  }; // Interpolation
+
+  /// Number of samples on each side of a storage block.
+  static constexpr gsl::index BlockEdge = (N == 1U)? 1: 4;
+
+  /// Number of samples in a storage block.
+  static constexpr gsl::index BlockSize = [](){
+      gsl::index size = 1;
+      for (std::size_t d = 0; d < N; ++d) size *= BlockEdge;
+      return size;
+    }();
+
+
+  /// Returns the sampling of `nSamples` from `lower` to `upper` (excluded).
+  static Axis_t makeAxis(X_t lower, X_t upper, gsl::index nSamples)
+    { return { lower, (upper - lower) / nSamples, nSamples }; }
+
+
+  /// Constructor: an empty table, with no sample.
+  SampledTable() = default;
+
+  /**
+   * @brief Constructor: samples `function` on the grid described by `axes`.
+   * @tparam Func type of the function
+   * @param function the function to be sampled
+   * @param axes sampling of each dimension
+   *
+   * The `function` must be callable either with `N` arguments convertible
+   * from `X_t`, or with one argument `Coords_t const&`, returning a value
+   * convertible to `Y_t`. It is not copied nor retained.
+   */
+  template <typename Func>
+  SampledTable(Func const& function, Axes_t const& axes);
+
+
+  /**
+   * @brief Returns a table with the specified values.
+   * @param axes sampling of each dimension
+   * @param values all the samples, in row-major order
+   * @throw std::runtime_error if the number of values does not match `axes`
+   *
+   * The sample with index `{ i0, i1, ..., iN }` is expected at position
+   * `(... (i0 * n1 + i1) * n2 + ...) + iN` of `values`, where `nD` is the
+   * number of samples of the dimension `D`.
+   */
+  static SampledTable fromValues
+    (Axes_t const& axes, gsl::span<Y_t const> values);
+
+  /**
+   * @brief Returns a table with its samples mapped from the file at `path`.
+   * @param path the file, written by `save()` or `sampleToFile()`
+   * @throw std::runtime_error if the file can't be mapped or it does not
+   *        contain a table of this type
+   */
+  static SampledTable mapFile(std::string const& path);
+
+  /**
+   * @brief Samples `function` directly into the file at `path`.
+   * @tparam Func type of the function (as for the constructor)
+   * @param path the file to be written (replaced if already present)
+   * @param function the function to be sampled
+   * @param axes sampling of each dimension
+   * @throw std::runtime_error if the file can't be written
+   *
+   * Samples are computed and written one block at a time, so that the table
+   * can be larger than the available memory. The file can then be used with
+   * `mapFile()`. It is written with a temporary name and then renamed.
+   */
+  template <typename Func>
+  static void sampleToFile
+    (std::string const& path, Func const& function, Axes_t const& axes);
+
+
+  // --- BEGIN --- Query -------------------------------------------------------
+  /// @name Query
+  /// @{
+
+  /// Returns the sampling of all the dimensions.
+  Axes_t const& axes() const { return fAxes; }
+
+  /// Returns the sampling of the dimension `d`.
+  Axis_t const& axis(std::size_t d) const { return fAxes[d]; }
+
+  /// Returns the number of samples in the dimension `d`.
+  gsl::index nSamples(std::size_t d) const { return fAxes[d].nSamples; }
+
+  /// Returns the lower limit of the dimension `d`.
+  X_t lower(std::size_t d) const { return fAxes[d].lower; }
+
+  /// Returns the upper limit of the dimension `d` (excluded).
+  X_t upper(std::size_t d) const { return fAxes[d].upper(); }
+
+  /// Returns the step size in the dimension `d`.
+  X_t stepSize(std::size_t d) const { return fAxes[d].step; }
+
+  /// Returns the total number of samples.
+  gsl::index size() const;
+
+  /// Returns whether the table has no sample.
+  bool empty() const { return !fData; }
+
+  /// @}
+  // --- END --- Query ---------------------------------------------------------
+
+
+  // --- BEGIN --- Access ------------------------------------------------------
+  /// @name Access to the sampled data
+  /// @{
+
+  /// Returns the value of the sample with the specified `index`.
+  Y_t value(Index_t const& index) const { return fData.get()[offset(index)]; }
+
+  /// Returns the storage of all the samples, shared with the copies of this
+  /// object (in blocks, including padding).
+  Storage_t const& samplesStorage() const { return fData; }
+
+  /// Returns the number of elements in the storage (including padding).
+  std::size_t storageSize() const { return fStorageSize; }
+
+  /// @}
+  // --- END --- Access --------------------------------------------------------
+
+
+  // --- BEGIN --- Evaluation --------------------------------------------------
+  /**
+   * @name Evaluation
+   *
+   * The function is considered to have value `outside` out of the sampled
+   * points: with `Interpolation::nearest`, points whose closest sample does not
+   * exist are assigned `outside`; with `Interpolation::linear`, the samples
+   * which do not exist contribute to the interpolation with value `outside`.
+   */
+  /// @{
+
+  /// Returns the function evaluated at `x` with the specified interpolation.
+  template <Interpolation Interp = Interpolation::nearest>
+  Y_t evaluate(Coords_t const& x, Y_t outside = Y_t{}) const;
+
+  /**
+   * @brief Evaluates the function at all points `xs` and stores them in `out`.
+   * @tparam Interp the interpolation mode
+   * @param xs the points where to evaluate the function
+   * @param out the span where to store the values (as large as `xs`)
+   * @param outside (default: `0`) value of the function out of the samples
+   */
+  template <Interpolation Interp = Interpolation::nearest>
+  void evaluate
+    (gsl::span<Coords_t const> xs, gsl::span<Y_t> out, Y_t outside = Y_t{})
+    const;
+
+  /// Evaluates the function at all points `xs` with interpolation `interp`.
+  void evaluate(
+    gsl::span<Coords_t const> xs, gsl::span<Y_t> out, Interpolation interp,
+    Y_t outside = Y_t{}
+    ) const;
+
+  /// @}
+  // --- END --- Evaluation ----------------------------------------------------
+
+
+  /**
+   * @brief Writes the table into the file at `path`.
+   * @throw std::runtime_error if the file can't be written
+   * @see `mapFile()`
+   */
+  void save(std::string const& path) const;
+
+
+    private:
+
+  /// Header of the table files.
+  struct FileHeader_t {
+    char magic[8] = { 'S', 'M', 'P', 'L', 'T', 'B', 'L', '\0' };
+    std::uint32_t dims = N; ///< Number of dimensions.
+    std::uint32_t blockEdge = BlockEdge; ///< Block side.
+    std::uint32_t coordSize = sizeof(X_t); ///< Size of a coordinate.
+    std::uint32_t valueSize = sizeof(Y_t); ///< Size of a sample.
+    Axes_t axes {}; ///< Sampling of each dimension.
+  }; // FileHeader_t
+
+  /// Alignment of the samples in the table files.
+  static constexpr std::size_t FileDataAlignment = 64U;
+
+  /// Offset of the samples in the table files.
+  static constexpr std::size_t FileDataOffset
+    = (sizeof(FileHeader_t) + FileDataAlignment - 1U)
+      / FileDataAlignment * FileDataAlignment;
+
+
+  /// Storage layout, from the axes.
+  struct Layout_t {
+    std::array<gsl::index, N> nBlocks; ///< Number of blocks per dimension.
+    std::array<gsl::index, N> blockStride; ///< Storage stride of blocks.
+    std::array<gsl::index, N> innerStride; ///< Stride within a block.
+    std::size_t storageSize; ///< Total storage, including padding.
+
+    explicit Layout_t(Axes_t const& axes);
+
+    /// Returns the storage offset of the sample `index` (valid indices).
+    std::size_t offset(Index_t const& index) const
+      { return offsetOf(index, blockStride, innerStride); }
+  }; // Layout_t
+
+
+  Axes_t fAxes {}; ///< Sampling of each dimension.
+  std::array<gsl::index, N> fBlockStride {}; ///< Storage stride of blocks.
+  std::array<gsl::index, N> fInnerStride {}; ///< Stride within a block.
+  std::size_t fStorageSize = 0U; ///< Number of elements in the storage.
+
+  Storage_t fData; ///< All samples, in blocks (shared among copies).
+
+
+  /// Constructor: takes axes and (already arranged) storage.
+  SampledTable(Axes_t const& axes, Storage_t data);
+
+  /// Returns the storage offset of the sample `index` (valid indices).
+  std::size_t offset(Index_t const& index) const
+    { return offsetOf(index, fBlockStride, fInnerStride); }
+
+  /// Returns the storage offset of the sample `index` with the given strides.
+  static std::size_t offsetOf(
+    Index_t const& index,
+    std::array<gsl::index, N> const& blockStride,
+    std::array<gsl::index, N> const& innerStride
+    );
+
+  /**
+   * @brief Evaluation of the function from a copy of the table parameters.
+   *
+   * Loops on a local evaluator object do not need to reload the table
+   * parameters after each write, and can be vectorized.
+   */
+  struct Evaluator_t {
+    Y_t const* data; ///< All the samples.
+    std::array<double, N> lower; ///< First sample of each dimension.
+    std::array<double, N> step; ///< Step size of each dimension.
+    std::array<gsl::index, N> nSamples; ///< Samples in each dimension.
+    std::array<gsl::index, N> blockStride; ///< Storage stride of blocks.
+    std::array<gsl::index, N> innerStride; ///< Stride within a block.
+
+    /// Returns the function evaluated at `x`.
+    template <Interpolation Interp>
+    Y_t evaluate(Coords_t const& x, Y_t outside) const;
+
+    /// Returns the value of the sample `index`, or `outside` if not present.
+    Y_t sampleOrDefault(Index_t const& index, Y_t outside) const;
+
+  }; // Evaluator_t
+
+  /// Returns an evaluator for this table.
+  Evaluator_t makeEvaluator() const;
+
+
+  /// Calls `function` at the point `x`.
+  template <typename Func>
+  static Y_t call(Func const& function, Coords_t const& x);
+
+  /**
+   * @brief Samples `function` block by block.
+   * @param function the function to be sampled
+   * @param axes sampling of each dimension
+   * @param sink called with each block of `BlockSize` samples, in order
+   */
+  template <typename Func, typename Sink>
+  static void sampleBlocks
+    (Func const& function, Axes_t const& axes, Sink&& sink);
+
+  /// Writes the header and the blocks from `fillBlocks(sink)` into `path`.
+  template <typename FillBlocks>
+  static void writeFile
+    (std::string const& path, Axes_t const& axes, FillBlocks&& fillBlocks);
+
+}; // class util::SampledTable<>
+
+
+// =============================================================================
+// ===  template implementation
+// =============================================================================
+// --- util::SampledTable<>::Layout_t
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+util::SampledTable<N, XType, YType>::Layout_t::Layout_t(Axes_t const& axes) {
+
+  // blocks and samples within a block are both in row-major order
+  gsl::index blockStrideNext = BlockSize;
+  gsl::index innerStrideNext = 1;
+  for (std::size_t d = N; d-- > 0U; ) {
+    assert(axes[d].nSamples > 0);
+    nBlocks[d] = (axes[d].nSamples + BlockEdge - 1) / BlockEdge;
+    blockStride[d] = blockStrideNext;
+    innerStride[d] = innerStrideNext;
+    blockStrideNext *= nBlocks[d];
+    innerStrideNext *= BlockEdge;
+  } // for
+  storageSize = static_cast<std::size_t>(blockStrideNext);
+
+} // util::SampledTable<>::Layout_t::Layout_t()
+
+
+// -----------------------------------------------------------------------------
+// --- util::SampledTable<>
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename Func>
+util::SampledTable<N, XType, YType>::SampledTable
+  (Func const& function, Axes_t const& axes)
+{
+  Layout_t const layout { axes };
+  auto samples = std::make_shared<std::vector<Y_t>>();
+  samples->reserve(layout.storageSize);
+  sampleBlocks(function, axes, [&samples](Y_t const* block)
+    { samples->insert(samples->end(), block, block + BlockSize); }
+    );
+  assert(samples->size() == layout.storageSize);
+
+  *this = SampledTable{ axes, Storage_t{ samples, samples->data() } };
+} // util::SampledTable<>::SampledTable()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+util::SampledTable<N, XType, YType>::SampledTable
+  (Axes_t const& axes, Storage_t data)
+  : fAxes{ axes }
+  , fData{ std::move(data) }
+{
+  Layout_t const layout { axes };
+  fBlockStride = layout.blockStride;
+  fInnerStride = layout.innerStride;
+  fStorageSize = layout.storageSize;
+} // util::SampledTable<>::SampledTable(storage)
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+auto util::SampledTable<N, XType, YType>::fromValues
+  (Axes_t const& axes, gsl::span<Y_t const> values) -> SampledTable
+{
+  Layout_t const layout { axes };
+
+  std::size_t nValues = 1U;
+  for (Axis_t const& axis: axes) nValues *= axis.nSamples;
+  if (values.size() != nValues) {
+    throw std::runtime_error{ "util::SampledTable::fromValues(): "
+      + std::to_string(values.size()) + " values for a table of "
+      + std::to_string(nValues) + " samples" };
+  }
+
+  auto samples = std::make_shared<std::vector<Y_t>>(layout.storageSize);
+
+  // walk the values in row-major order, keeping track of the index
+  Index_t index {};
+  for (Y_t const& value: values) {
+    (*samples)[layout.offset(index)] = value;
+    for (std::size_t d = N; d-- > 0U; ) {
+      if (++index[d] < axes[d].nSamples) break;
+      index[d] = 0;
+    }
+  } // for values
+
+  return { axes, Storage_t{ samples, samples->data() } };
+} // util::SampledTable<>::fromValues()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+auto util::SampledTable<N, XType, YType>::mapFile(std::string const& path)
+  -> SampledTable
+{
+  std::size_t fileSize = 0U;
+  std::shared_ptr<void const> const mapping
+    = details::mapFileReadOnly(path, fileSize);
+
+  auto fail = [&path](std::string const& msg)
+    {
+      return std::runtime_error
+        { "util::SampledTable::mapFile(): '" + path + "' " + msg };
+    };
+
+  FileHeader_t const expected;
+  if (fileSize < FileDataOffset) throw fail("is too short");
+  auto const& header = *static_cast<FileHeader_t const*>(mapping.get());
+  if (!std::equal(
+    std::begin(header.magic), std::end(header.magic), std::begin(expected.magic)
+  )) {
+    throw fail("is not a sampled table file");
+  }
+  if ((header.dims != expected.dims)
+    || (header.blockEdge != expected.blockEdge)
+    || (header.coordSize != expected.coordSize)
+    || (header.valueSize != expected.valueSize)
+  ) {
+    throw fail("contains a table of different type ("
+      + std::to_string(header.dims) + " dimensions, value size "
+      + std::to_string(header.valueSize) + ")");
+  }
+  for (Axis_t const& axis: header.axes)
+    if (axis.nSamples <= 0) throw fail("has an invalid sampling");
+
+  Layout_t const layout { header.axes };
+  if (fileSize < FileDataOffset + layout.storageSize * sizeof(Y_t))
+    throw fail("is truncated");
+
+  // the storage shares the ownership of the mapping
+  auto const* data = reinterpret_cast<Y_t const*>
+    (static_cast<char const*>(mapping.get()) + FileDataOffset);
+  return { header.axes, Storage_t{ mapping, data } };
+} // util::SampledTable<>::mapFile()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename Func>
+void util::SampledTable<N, XType, YType>::sampleToFile
+  (std::string const& path, Func const& function, Axes_t const& axes)
+{
+  writeFile(path, axes, [&function,&axes](auto&& sink)
+    { sampleBlocks(function, axes, sink); }
+    );
+} // util::SampledTable<>::sampleToFile()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+void util::SampledTable<N, XType, YType>::save(std::string const& path) const {
+  writeFile(path, fAxes, [this](auto&& sink)
+    {
+      Y_t const* const data = fData.get();
+      for (std::size_t i = 0; i < fStorageSize; i += BlockSize) sink(data + i);
+    }
+    );
+} // util::SampledTable<>::save()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+gsl::index util::SampledTable<N, XType, YType>::size() const {
+  if (empty()) return 0;
+  gsl::index n = 1;
+  for (Axis_t const& axis: fAxes) n *= axis.nSamples;
+  return n;
+} // util::SampledTable<>::size()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename util::SampledTable<N, XType, YType>::Interpolation Interp>
+auto util::SampledTable<N, XType, YType>::evaluate
+  (Coords_t const& x, Y_t const outside /* = Y_t{} */) const -> Y_t
+{
+  return makeEvaluator().template evaluate<Interp>(x, outside);
+} // util::SampledTable<>::evaluate()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename util::SampledTable<N, XType, YType>::Interpolation Interp>
+void util::SampledTable<N, XType, YType>::evaluate(
+  gsl::span<Coords_t const> xs, gsl::span<Y_t> out,
+  Y_t const outside /* = Y_t{} */
+) const {
+  assert(out.size() >= xs.size());
+
+  // the values are computed in chunks in a local buffer: the compiler knows
+  // that it can't alias the samples, and can then vectorize the gathering loop
+  constexpr gsl::index ChunkSize = 64;
+  Y_t buffer[ChunkSize];
+
+  auto const evaluator = makeEvaluator();
+  Coords_t const* x = xs.data();
+  Y_t* y = out.data();
+  for (auto n = static_cast<gsl::index>(xs.size()); n > 0; n -= ChunkSize) {
+    gsl::index const nChunk = std::min(n, ChunkSize);
+    for (gsl::index i = 0; i < nChunk; ++i)
+      buffer[i] = evaluator.template evaluate<Interp>(x[i], outside);
+    y = std::copy(buffer, buffer + nChunk, y);
+    x += nChunk;
+  } // for chunks
+
+} // util::SampledTable<>::evaluate(span)
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+void util::SampledTable<N, XType, YType>::evaluate(
+  gsl::span<Coords_t const> xs, gsl::span<Y_t> out, Interpolation interp,
+  Y_t const outside /* = Y_t{} */
+) const {
+  switch (interp) {
+    case Interpolation::nearest:
+      evaluate<Interpolation::nearest>(xs, out, outside);
+      return;
+    case Interpolation::linear:
+      evaluate<Interpolation::linear>(xs, out, outside);
+      return;
+  } // switch
+} // util::SampledTable<>::evaluate(interp)
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+std::size_t util::SampledTable<N, XType, YType>::offsetOf(
+  Index_t const& index,
+  std::array<gsl::index, N> const& blockStride,
+  std::array<gsl::index, N> const& innerStride
+) {
+  // `BlockEdge` is a power of 2: division and remainder are bit operations
+  std::size_t offset = 0U;
+  for (std::size_t d = 0; d < N; ++d) {
+    auto const i = static_cast<std::size_t>(index[d]);
+    offset += (i / BlockEdge) * static_cast<std::size_t>(blockStride[d])
+      + (i % BlockEdge) * static_cast<std::size_t>(innerStride[d]);
+  }
+  return offset;
+} // util::SampledTable<>::offsetOf()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+auto util::SampledTable<N, XType, YType>::makeEvaluator() const
+  -> Evaluator_t
+{
+  assert(!empty());
+  Evaluator_t evaluator;
+  evaluator.data = fData.get();
+  for (std::size_t d = 0; d < N; ++d) {
+    evaluator.lower[d] = static_cast<double>(fAxes[d].lower);
+    evaluator.step[d] = static_cast<double>(fAxes[d].step);
+    evaluator.nSamples[d] = fAxes[d].nSamples;
+  }
+  evaluator.blockStride = fBlockStride;
+  evaluator.innerStride = fInnerStride;
+  return evaluator;
+} // util::SampledTable<>::makeEvaluator()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename util::SampledTable<N, XType, YType>::Interpolation Interp>
+auto util::SampledTable<N, XType, YType>::Evaluator_t::evaluate
+  (Coords_t const& x, Y_t const outside) const -> Y_t
+{
+  // position in units of steps, clamped so that conversions are defined;
+  // since t >= -1, truncation of t + 1 is its floor plus 1: unlike
+  // `std::floor()`, truncation to an integer can be vectorized
+  std::array<double, N> t;
+  for (std::size_t d = 0; d < N; ++d) {
+    t[d] = std::min(
+      std::max((static_cast<double>(x[d]) - lower[d]) / step[d], -1.0),
+      static_cast<double>(nSamples[d])
+      );
+  } // for
+
+  if constexpr (Interp == Interpolation::nearest) {
+    Index_t index;
+    for (std::size_t d = 0; d < N; ++d)
+      index[d] = static_cast<gsl::index>(t[d] + 1.5) - 1;
+    return sampleOrDefault(index, outside);
+  }
+  else {
+    Index_t base;
+    std::array<Y_t, N> f;
+    for (std::size_t d = 0; d < N; ++d) {
+      base[d] = static_cast<gsl::index>(t[d] + 1.0) - 1;
+      f[d] = static_cast<Y_t>(t[d] - static_cast<double>(base[d]));
+    }
+
+    // sum of the 2^N corners, each weighted by the product of its fractions
+    Y_t value {};
+    for (unsigned int corner = 0; corner < (1U << N); ++corner) {
+      Index_t index = base;
+      Y_t weight { 1 };
+      for (std::size_t d = 0; d < N; ++d) {
+        bool const upperSide = (corner >> d) & 1U;
+        index[d] += upperSide;
+        weight *= upperSide? f[d]: (Y_t{ 1 } - f[d]);
+      }
+      value += weight * sampleOrDefault(index, outside);
+    } // for corners
+    return value;
+  }
+
+} // util::SampledTable<>::Evaluator_t::evaluate()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+auto util::SampledTable<N, XType, YType>::Evaluator_t::sampleOrDefault
+  (Index_t const& index, Y_t const outside) const -> Y_t
+{
+  // written with no branches, so that loops on it can be vectorized
+  bool inRange = true;
+  for (std::size_t d = 0; d < N; ++d)
+    inRange &= (index[d] >= 0) & (index[d] < nSamples[d]);
+
+  Index_t clamped;
+  for (std::size_t d = 0; d < N; ++d) clamped[d] = inRange? index[d]: 0;
+  Y_t const y = data[offsetOf(clamped, blockStride, innerStride)];
+  return inRange? y: outside;
+} // util::SampledTable<>::Evaluator_t::sampleOrDefault()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename Func>
+auto util::SampledTable<N, XType, YType>::call
+  (Func const& function, Coords_t const& x) -> Y_t
+{
+  if constexpr (std::is_invocable_v<Func const&, Coords_t const&>)
+    return static_cast<Y_t>(function(x));
+  else
+    return static_cast<Y_t>(std::apply(function, x));
+} // util::SampledTable<>::call()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename Func, typename Sink>
+void util::SampledTable<N, XType, YType>::sampleBlocks
+  (Func const& function, Axes_t const& axes, Sink&& sink)
+{
+  Layout_t const layout { axes };
+
+  std::array<Y_t, BlockSize> block;
+  Index_t blockIndex {};
+  std::size_t const nBlocks = layout.storageSize / BlockSize;
+  for (std::size_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+
+    // samples in the block, in row-major order; padding is left at zero
+    Index_t inner {};
+    for (Y_t& y: block) {
+      Coords_t x;
+      bool inRange = true;
+      for (std::size_t d = 0; d < N; ++d) {
+        gsl::index const i = blockIndex[d] * BlockEdge + inner[d];
+        inRange = inRange && (i < axes[d].nSamples);
+        x[d] = axes[d].lower + axes[d].step * i;
+      }
+      y = inRange? call(function, x): Y_t{};
+
+      for (std::size_t d = N; d-- > 0U; ) {
+        if (++inner[d] < BlockEdge) break;
+        inner[d] = 0;
+      }
+    } // for samples in block
+
+    sink(block.data());
+
+    for (std::size_t d = N; d-- > 0U; ) {
+      if (++blockIndex[d] < layout.nBlocks[d]) break;
+      blockIndex[d] = 0;
+    }
+  } // for blocks
+
+} // util::SampledTable<>::sampleBlocks()
+
+
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename XType, typename YType>
+template <typename FillBlocks>
+void util::SampledTable<N, XType, YType>::writeFile
+  (std::string const& path, Axes_t const& axes, FillBlocks&& fillBlocks)
+{
+  static_assert(std::is_trivially_copyable_v<Y_t>);
+  static_assert(std::is_trivially_copyable_v<FileHeader_t>);
+
+  std::string const tempPath = path + ".tmp";
+  {
+    std::ofstream out { tempPath, std::ios::binary | std::ios::trunc };
+    if (!out) {
+      throw std::runtime_error
+        { "util::SampledTable: can't write '" + tempPath + "'" };
+    }
+
+    FileHeader_t header;
+    header.axes = axes;
+    std::array<char, FileDataOffset> headerData {};
+    std::memcpy(headerData.data(), &header, sizeof(header));
+    out.write(headerData.data(), headerData.size());
+
+    fillBlocks([&out](Y_t const* block)
+      {
+        out.write(reinterpret_cast<char const*>(block),
+          BlockSize * sizeof(Y_t));
+      });
+
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      throw std::runtime_error
+        { "util::SampledTable: error writing '" + tempPath + "'" };
+    }
+  }
+
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    throw std::runtime_error{ "util::SampledTable: can't move '" + tempPath
+      + "' into '" + path + "'" };
+  }
+
+} // util::SampledTable<>::writeFile()
+
+
+// -----------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_UTILITIES_SAMPLEDTABLE_H
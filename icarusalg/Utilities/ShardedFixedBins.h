@@ -0,0 +1,164 @@
+/**
+ * @file icarusalg/Utilities/ShardedFixedBins.h
+ * @brief Binned counts filled concurrently by different threads.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 14, 2026
+ * @see icarusalg/Utilities/FixedBins.h
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_UTILITIES_SHARDEDFIXEDBINS_H
+#define ICARUSALG_UTILITIES_SHARDEDFIXEDBINS_H
+
+// ICARUS libraries
+#include "icarusalg/Utilities/FixedBins.h"
+
+// C/C++ standard libraries
+#include <unordered_map>
+#include <mutex>
+#include <thread> // std::this_thread
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+  template <typename T, typename C = unsigned int> class ShardedFixedBins;
+}
+
+/**
+ * @brief Binned counts which can be filled by many threads at the same time.
+ * @param T type of data on the binning axis
+ * @param C (default: `unsigned int`) data type for the bin count
+ * @see `icarus::ns::util::FixedBins`
+ *
+ * This object holds one `icarus::ns::util::FixedBins` object ("shard") for
+ * each thread filling it, all with the same binning. Each thread fills its own
+ * shard with no synchronization, and the content from all the shards is
+ * combined on request (`merged()`).
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::ShardedFixedBins<double> times { 0.5 }; // 0.5 us bins
+ *
+ * // in each thread:
+ * auto& localTimes = times.local(); // (synchronized)
+ * for (double const time: photonTimes) localTimes.add(time); // lock-free
+ *
+ * // after all threads are done:
+ * icarus::ns::util::FixedBins<double> const allTimes = times.merged();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Access to the shard (`local()`) is synchronized, and it should happen once
+ * per task rather than once per value.
+ * The shards themselves are not synchronized: `merged()` and `clear()` must
+ * not be called while any thread is filling its shard.
+ */
+template <typename T, typename C /* = unsigned int */>
+class icarus::ns::util::ShardedFixedBins {
+
+    public:
+
+  using Bins_t = icarus::ns::util::FixedBins<T, C>; ///< Type of each shard.
+
+  using Data_t = typename Bins_t::Data_t; ///< Type on the bin axis.
+
+  using Count_t = typename Bins_t::Count_t; ///< Type on the bin content.
+
+  /// Type of interval on the bin axis.
+  using Interval_t = typename Bins_t::Interval_t;
+
+
+  /**
+   * @brief Constructor: initializes the binning.
+   * @param width the bin width
+   * @param offset (default: 0) the border of one of the bins
+   * @see `icarus::ns::util::FixedBins::FixedBins()`
+   */
+  explicit ShardedFixedBins(Interval_t width, Data_t offset = Data_t{})
+    : fEmpty{ width, offset } {}
+
+
+  /**
+   * @brief Returns the shard of the calling thread.
+   * @return the shard of the calling thread, created if needed
+   *
+   * The returned shard stays valid for the whole life of this object, and it
+   * should be filled exclusively by the calling thread.
+   */
+  Bins_t& local();
+
+  /// Returns the counts from all the shards.
+  Bins_t merged() const;
+
+  /// Removes all counts from all the shards (the shards are kept).
+  void clear();
+
+  /// Returns the number of shards (i.e. of threads which requested one).
+  std::size_t nShards() const;
+
+  /// Returns the width of the bins.
+  Interval_t binWidth() const noexcept { return fEmpty.binWidth(); }
+
+  /// Returns the alignment offset of the bins.
+  Data_t offset() const noexcept { return fEmpty.offset(); }
+
+
+    private:
+
+  Bins_t const fEmpty; ///< Empty object with the binning of all the shards.
+
+  mutable std::mutex fShardMutex; ///< Protects the shard list.
+
+  /// The shards, one per thread (references are stable on insertion).
+  std::unordered_map<std::thread::id, Bins_t> fShards;
+
+}; // icarus::ns::util::ShardedFixedBins
+
+
+// -----------------------------------------------------------------------------
+// --- template implementation
+// -----------------------------------------------------------------------------
+template <typename T, typename C>
+auto icarus::ns::util::ShardedFixedBins<T, C>::local() -> Bins_t& {
+
+  std::lock_guard const lock { fShardMutex };
+  return fShards.try_emplace(std::this_thread::get_id(), fEmpty).first->second;
+
+} // icarus::ns::util::ShardedFixedBins<>::local()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C>
+auto icarus::ns::util::ShardedFixedBins<T, C>::merged() const -> Bins_t {
+
+  Bins_t bins { fEmpty };
+  std::lock_guard const lock { fShardMutex };
+  for (auto const& shard: fShards) bins.merge(shard.second);
+  return bins;
+
+} // icarus::ns::util::ShardedFixedBins<>::merged()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C>
+void icarus::ns::util::ShardedFixedBins<T, C>::clear() {
+
+  std::lock_guard const lock { fShardMutex };
+  for (auto& shard: fShards) shard.second.clear();
+
+} // icarus::ns::util::ShardedFixedBins<>::clear()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename C>
+std::size_t icarus::ns::util::ShardedFixedBins<T, C>::nShards() const {
+
+  std::lock_guard const lock { fShardMutex };
+  return fShards.size();
+
+} // icarus::ns::util::ShardedFixedBins<>::nShards()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_SHARDEDFIXEDBINS_H
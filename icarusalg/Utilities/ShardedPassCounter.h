@@ -0,0 +1,191 @@
+/**
+ * @file   icarusalg/Utilities/ShardedPassCounter.h
+ * @brief  Class to keep count of a pass/fail result from many threads.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/Utilities/AtomicPassCounter.h
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSALG_UTILITIES_SHARDEDPASSCOUNTER_H
+#define ICARUSALG_UTILITIES_SHARDEDPASSCOUNTER_H
+
+// C/C++ standard libraries
+#include <array>
+#include <atomic>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+  template <typename Count, std::size_t NShards> class ShardedPassCounter;
+}
+/**
+ * @brief Class counting pass/fail events, optimised for many writing threads.
+ * @tparam Count (default: `unsigned int`) type of counter
+ * @tparam NShards (default: `64`) number of independent counters
+ * @see icarus::ns::util::PassCounter, icarus::ns::util::AtomicPassCounter
+ *
+ * This is a thread-safe implementation of `icarus::ns::util::PassCounter`
+ * which splits the counts into `NShards` independent pairs of atomic
+ * counters ("shards"), each on its own cache line.
+ * Each thread is assigned a shard the first time it uses any such counter,
+ * in turns, so that up to `NShards` threads never write on the same cache
+ * line. The counts from all the shards are added up when read.
+ *
+ * Compared to `icarus::ns::util::AtomicPassCounter`, registering an event is
+ * much cheaper when many threads do it at the same time, while reading the
+ * counts costs a loop over all the shards, and each counter takes
+ * `NShards` cache lines of memory (4 kiB with the default parameters).
+ * This class is therefore suited to counters updated for each event by many
+ * threads and read only at the end of the job.
+ * Only `Count` types that are lock-free are supported.
+ *
+ * This class exposes an interface equivalent to `PassCounter`: see its
+ * documentation for usage details.
+ * Counts are guaranteed to be exact once all the threads writing them are
+ * done. While they are being updated, `failed()` is never negative, but
+ * `passed()` and `total()` may be out of sync.
+ *
+ */
+template <typename Count = unsigned int, std::size_t NShards = 64U>
+class icarus::ns::util::ShardedPassCounter {
+  static_assert(std::atomic<Count>::is_always_lock_free,
+    "Only types whose atomic type is non-blocking are supported."
+    );
+  static_assert(NShards > 0U, "At least one shard is needed.");
+
+    public:
+  using Count_t = Count; ///< Type used for counters.
+
+  /// Size of the cache line the shards are aligned to [bytes].
+  static constexpr std::size_t CacheLineSize = 64U;
+
+  // constructors are all default
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+
+  /// Returns the number of events which "passed".
+  Count_t passed() const { return sum(&Shard_t::passed); }
+
+  /// Returns the number of events which "failed".
+  Count_t failed() const
+    {
+      // passed counts first: all the total counts they imply are then visible
+      Count_t const nPassed = passed();
+      return total() - nPassed;
+    }
+
+  /// Returns the total number of registered events.
+  Count_t total() const { return sum(&Shard_t::total); }
+
+  /// Returns whether there is no event recorded yet.
+  bool empty() const { return total() == Count_t{}; }
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+  // --- BEGIN -- Registration and reset ---------------------------------------
+  /// @name Registration and reset
+  /// @{
+
+  /// Adds a single event, specifying whether it "passes" or not.
+  void add(bool pass);
+
+  /// Adds a single event which did not "pass".
+  void addFailed() { add(false); }
+
+  /// Adds a single event which did "pass".
+  void addPassed() { add(true); }
+
+  /// Resets all counts. Not safe while other threads are adding events.
+  void reset();
+
+  /// @}
+  // --- END ---- Registration and reset ---------------------------------------
+
+    private:
+
+  /// Counters of one shard, alone in their cache line.
+  struct alignas(CacheLineSize) Shard_t {
+    std::atomic<Count_t> total {};  ///< Total entries.
+    std::atomic<Count_t> passed {}; ///< Entries which "passed".
+  }; // Shard_t
+
+
+  // --- BEGIN -- Data members -------------------------------------------------
+
+  std::array<Shard_t, NShards> fShards; ///< All the counters.
+
+  // --- END ---- Data members -------------------------------------------------
+
+
+  /// Returns the sum of the counter `member` from all the shards.
+  Count_t sum(std::atomic<Count_t> Shard_t::*member) const;
+
+  /// Returns the shard assigned to the current thread.
+  Shard_t& localShard() { return fShards[threadIndex() % NShards]; }
+
+  /// Returns the index assigned to the current thread.
+  static std::size_t threadIndex();
+
+}; // icarus::ns::util::ShardedPassCounter<>
+
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename Count, std::size_t NShards>
+void icarus::ns::util::ShardedPassCounter<Count, NShards>::add(bool pass) {
+
+  Shard_t& shard = localShard();
+  shard.total.fetch_add(Count_t{ 1 }, std::memory_order_relaxed);
+  if (pass) shard.passed.fetch_add(Count_t{ 1 }, std::memory_order_release);
+
+} // icarus::ns::util::ShardedPassCounter<>::add()
+
+
+// -----------------------------------------------------------------------------
+template <typename Count, std::size_t NShards>
+void icarus::ns::util::ShardedPassCounter<Count, NShards>::reset() {
+
+  for (Shard_t& shard: fShards) {
+    shard.total.store(Count_t{}, std::memory_order_relaxed);
+    shard.passed.store(Count_t{}, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+} // icarus::ns::util::ShardedPassCounter<>::reset()
+
+
+// -----------------------------------------------------------------------------
+template <typename Count, std::size_t NShards>
+auto icarus::ns::util::ShardedPassCounter<Count, NShards>::sum
+  (std::atomic<Count_t> Shard_t::*member) const -> Count_t
+{
+  Count_t count {};
+  for (Shard_t const& shard: fShards)
+    count += (shard.*member).load(std::memory_order_acquire);
+  return count;
+} // icarus::ns::util::ShardedPassCounter<>::sum()
+
+
+// -----------------------------------------------------------------------------
+template <typename Count, std::size_t NShards>
+std::size_t icarus::ns::util::ShardedPassCounter<Count, NShards>::threadIndex()
+{
+  // threads are given indices in turn, the first time they need one
+  static std::atomic<std::size_t> nextIndex { 0U };
+  thread_local std::size_t const index
+    = nextIndex.fetch_add(1U, std::memory_order_relaxed);
+  return index;
+} // icarus::ns::util::ShardedPassCounter<>::threadIndex()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_SHARDEDPASSCOUNTER_H
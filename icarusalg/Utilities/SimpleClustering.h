@@ -10,8 +10,14 @@
 #ifndef ICARUSALG_UTILITIES_SIMPLECLUSTERING_H
 #define ICARUSALG_UTILITIES_SIMPLECLUSTERING_H
 
+// LArSoft libraries
+#include "larcorealg/CoreUtils/StdUtils.h" // util::begin(), util::end()
+#include "larcorealg/CoreUtils/span.h" // util::span
+
 // C/C++ standard libraries
 #include <vector>
+#include <tuple> // std::get()
+#include <iterator> // std::back_inserter(), std::next(), std::distance()
 #include <algorithm> // std::transform(), std::sort()
 #include <utility> // std::pair, std::move(), std::declval()
 #include <type_traits> // std::decay_t
@@ -80,11 +86,162 @@ namespace util {
   auto clusterBy
     (Coll const& objs, KeyOp keyFunc, CmpOp sameGroup, KeySortOp keySort);
 
+
+  // --- BEGIN -- Clustering of sorted objects ---------------------------------
+  /**
+   * @brief Calls `onCluster` on each cluster of an already sorted sequence.
+   * @tparam Iter type of iterator to the objects
+   * @tparam KeyOp type of operation extracting the relevant key for clustering
+   * @tparam CmpOp type of operation determining if object belongs to a cluster
+   * @tparam ClusterOp type of operation called on each cluster
+   * @param begin iterator to the first object
+   * @param end iterator past the last object
+   * @param keyFunc operation extracting the relevant key for clustering
+   * @param sameGroup operation determining if an object belongs to a cluster
+   * @param onCluster operation called on each cluster
+   * @return the number of clusters
+   *
+   * The objects must already be sorted by key. The clustering follows the same
+   * criteria as `clusterBy()`, but it is performed in a single sweep without
+   * any copy or allocation: each cluster is passed to `onCluster` as the range
+   * of iterators `onCluster(first, last)` (`last` excluded) as soon as it is
+   * complete.
+   *
+   * The key of each object is extracted only once.
+   */
+  template <typename Iter, typename KeyOp, typename CmpOp, typename ClusterOp>
+  std::size_t forEachSortedCluster
+    (Iter begin, Iter end, KeyOp keyFunc, CmpOp sameGroup, ClusterOp onCluster);
+
+  /**
+   * @brief Performs a simple clustering of objects already sorted by key.
+   * @return a STL vector of clusters of object "references"
+   * @see `clusterBy()`, `forEachSortedCluster()`
+   *
+   * This is the same as `clusterBy()`, but `objs` must already be sorted by
+   * key, and neither the sorting nor the temporary copy of all the keys and
+   * object references are needed.
+   */
+  template <typename Coll, typename KeyOp, typename CmpOp, typename RefOp>
+  auto clusterSortedBy
+    (Coll const& objs, KeyOp keyFunc, CmpOp sameGroup, RefOp objRef);
+
+  /// A version of `clusterSortedBy()` storing a copy of each object.
+  template <typename Coll, typename KeyOp, typename CmpOp>
+  auto clusterSortedBy(Coll const& objs, KeyOp keyFunc, CmpOp sameGroup);
+
+  // --- END ---- Clustering of sorted objects ---------------------------------
+
+
+  // --- BEGIN -- Clustering into indices --------------------------------------
+  template <typename Key> struct ClusterIndices;
+
+  /**
+   * @brief Clusters objects, reporting clusters as ranges of object indices.
+   * @tparam Coll type of collection of objects to cluster
+   * @tparam KeyOp type of operation extracting the relevant key for clustering
+   * @tparam CmpOp type of operation determining if object belongs to a cluster
+   * @tparam KeySortOp type of operation sorting the clustering keys
+   * @tparam Key type of the clustering key
+   * @param coll collection of objects to cluster
+   * @param keyFunc operation extracting the relevant key for clustering
+   * @param sameGroup operation determining if an object belongs to a cluster
+   * @param keySort operation sorting the clustering keys
+   * @param[out] clusters where to store the clusters
+   * @return the number of clusters
+   *
+   * The clustering follows the same criteria as `clusterBy()`. The result is
+   * stored in `clusters` as two flat lists (see `util::ClusterIndices`):
+   * the index of each object in `coll`, sorted by key and grouped by cluster,
+   * and where each cluster starts in that list.
+   * The previous content of `clusters` is replaced, but its memory is reused:
+   * clustering with the same `clusters` object event after event does not
+   * allocate memory once it is large enough.
+   * Objects with the same key are sorted by their index.
+   */
+  template <
+    typename Coll, typename KeyOp, typename CmpOp, typename KeySortOp,
+    typename Key
+    >
+  std::size_t clusterIndicesBy(
+    Coll const& objs, KeyOp keyFunc, CmpOp sameGroup, KeySortOp keySort,
+    ClusterIndices<Key>& clusters
+    );
+
+  // --- END ---- Clustering into indices --------------------------------------
+
   // ---------------------------------------------------------------------------
 
 } // namespace util
 
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief Result of `util::clusterIndicesBy()`, reusable for many clusterings.
+ * @tparam Key type of the clustering key
+ *
+ * The objects of cluster `i` have indices from `indices[offsets[i]]` to
+ * `indices[offsets[i + 1]]` (excluded); `offsets` has one more element than
+ * the number of clusters.
+ * The keys are kept as working space of the clustering.
+ *
+ * Example:
+ * ~~~~{.cpp}
+ * util::ClusterIndices<double> clusters; // reused event after event
+ *
+ * util::clusterIndicesBy(waveforms,
+ *   [](raw::OpDetWaveform const& waveform){ return waveform.TimeStamp(); },
+ *   [](double a, double b){ return std::abs(a - b) < 2.0; },
+ *   std::less<double>{}, clusters
+ *   );
+ * for (std::size_t iCluster = 0; iCluster < clusters.size(); ++iCluster) {
+ *   for (std::size_t const index: clusters.cluster(iCluster)) {
+ *     raw::OpDetWaveform const& waveform = waveforms[index];
+ *     // ...
+ *   }
+ * }
+ * ~~~~
+ */
+template <typename Key>
+struct util::ClusterIndices {
+
+  using Key_t = Key; ///< Type of the clustering key.
+
+  /// Index of each object, grouped by cluster.
+  std::vector<std::size_t> indices;
+
+  /// Where each cluster starts in `indices` (plus the end of the last one).
+  std::vector<std::size_t> offsets;
+
+  /// Working space: key and index of each object, sorted by key.
+  std::vector<std::pair<Key_t, std::size_t>> keys;
+
+
+  /// Returns the number of clusters.
+  std::size_t size() const
+    { return offsets.empty()? 0U: (offsets.size() - 1U); }
+
+  /// Returns whether there is no cluster.
+  bool empty() const { return size() == 0U; }
+
+  /// Returns the number of objects in cluster `i`.
+  std::size_t clusterSize(std::size_t i) const
+    { return offsets[i + 1] - offsets[i]; }
+
+  /// Returns the indices of the objects in cluster `i`.
+  util::span<std::vector<std::size_t>::const_iterator> cluster
+    (std::size_t i) const
+    {
+      return
+        { indices.begin() + offsets[i], indices.begin() + offsets[i + 1] };
+    }
+
+  /// Removes all clusters, keeping the allocated memory.
+  void clear() { indices.clear(); offsets.clear(); keys.clear(); }
+
+}; // util::ClusterIndices<>
+
+
 
 // -----------------------------------------------------------------------------
 // --- template implementation
@@ -99,7 +256,7 @@ namespace util::details {
 
     template <typename A, typename B>
     auto operator() (A&& a, B&& b) const
-      { return sorter(std::forward<A>(a), std::forward<B>(b)); }
+      { return sorter(std::get<I>(a), std::get<I>(b)); }
 
   }; // TupleElementOp<>
 
@@ -209,6 +366,114 @@ auto util::clusterBy
 } // util::clusterBy(Coll, KeyOp, CmpOp, KeySortOp)
 
 
+// -----------------------------------------------------------------------------
+template <typename Iter, typename KeyOp, typename CmpOp, typename ClusterOp>
+std::size_t util::forEachSortedCluster
+  (Iter begin, Iter end, KeyOp keyFunc, CmpOp sameGroup, ClusterOp onCluster)
+{
+  if (begin == end) return 0U;
+
+  std::size_t nClusters = 0U;
+  Iter clusterStart = begin;
+  auto clusterKey = keyFunc(*clusterStart);
+  for (Iter it = std::next(begin); it != end; ++it) {
+    auto key = keyFunc(*it);
+    if (sameGroup(key, clusterKey)) continue;
+    onCluster(clusterStart, it);
+    ++nClusters;
+    clusterStart = it;
+    clusterKey = std::move(key);
+  } // for
+  onCluster(clusterStart, end);
+
+  return ++nClusters;
+
+} // util::forEachSortedCluster()
+
+
+// -----------------------------------------------------------------------------
+template <typename Coll, typename KeyOp, typename CmpOp, typename RefOp>
+auto util::clusterSortedBy
+  (Coll const& objs, KeyOp keyFunc, CmpOp sameGroup, RefOp objRef)
+{
+  using Object_t = typename Coll::value_type;
+  using ObjectRef_t = std::decay_t<decltype(objRef(std::declval<Object_t>()))>;
+  using Cluster_t = std::vector<ObjectRef_t>;
+
+  std::vector<Cluster_t> clusters;
+  auto makeCluster = [&clusters,&objRef](auto first, auto last)
+    {
+      Cluster_t& cluster = clusters.emplace_back();
+      cluster.reserve(std::distance(first, last));
+      std::transform(first, last, std::back_inserter(cluster), objRef);
+    };
+
+  forEachSortedCluster(util::begin(objs), util::end(objs),
+    std::move(keyFunc), std::move(sameGroup), makeCluster);
+
+  return clusters;
+
+} // util::clusterSortedBy(Coll, KeyOp, CmpOp, RefOp)
+
+
+// -----------------------------------------------------------------------------
+template <typename Coll, typename KeyOp, typename CmpOp>
+auto util::clusterSortedBy(Coll const& objs, KeyOp keyFunc, CmpOp sameGroup) {
+  return clusterSortedBy(objs,
+    std::move(keyFunc), std::move(sameGroup),
+    [](auto const& obj){ return obj; }
+    );
+} // util::clusterSortedBy(Coll, KeyOp, CmpOp)
+
+
+// -----------------------------------------------------------------------------
+template <
+  typename Coll, typename KeyOp, typename CmpOp, typename KeySortOp,
+  typename Key
+  >
+std::size_t util::clusterIndicesBy(
+  Coll const& objs, KeyOp keyFunc, CmpOp sameGroup, KeySortOp keySort,
+  ClusterIndices<Key>& clusters
+) {
+
+  /*
+   * 1. fill the list of key and index of each object
+   * 2. sort that list by key (and index)
+   * 3. sweep through the list and record where each cluster starts
+   */
+  clusters.clear();
+
+  std::size_t index = 0U;
+  for (auto const& obj: objs) clusters.keys.emplace_back(keyFunc(obj), index++);
+
+  std::sort(clusters.keys.begin(), clusters.keys.end(),
+    [&keySort](auto const& a, auto const& b)
+      {
+        if (keySort(a.first, b.first)) return true;
+        if (keySort(b.first, a.first)) return false;
+        return a.second < b.second;
+      }
+    );
+
+  clusters.indices.reserve(clusters.keys.size());
+  for (auto const& keyAndIndex: clusters.keys)
+    clusters.indices.push_back(keyAndIndex.second);
+
+  clusters.offsets.push_back(0U);
+  auto const keysBegin = clusters.keys.cbegin();
+  auto const nClusters = forEachSortedCluster(
+    keysBegin, clusters.keys.cend(),
+    [](auto const& keyAndIndex) -> auto const& { return keyAndIndex.first; },
+    std::move(sameGroup),
+    [&clusters,keysBegin](auto, auto last)
+      { clusters.offsets.push_back(last - keysBegin); }
+    );
+
+  return nClusters;
+
+} // util::clusterIndicesBy()
+
+
 // -----------------------------------------------------------------------------
 
 #endif // ICARUSALG_UTILITIES_SIMPLECLUSTERING_H
@@ -13,6 +13,7 @@
 
 // ICARUS libraries
 #include "icarusalg/Utilities/TimeInterval.h"
+#include "icarusalg/Utilities/TimeIntervalSet.h"
 #include "lardataalg/Utilities/intervals_fhicl.h" // convenience
 #include "lardataalg/Utilities/quantities_fhicl.h" // convenience
 
@@ -24,6 +25,7 @@
 
 // C/C++ standard libraries
 #include <optional>
+#include <vector>
 
 
 //--------------------------------------------------------------------------
@@ -71,6 +73,28 @@ namespace icarus::ns::fhicl {
   std::optional<icarus::ns::util::TimeInterval<Time>> makeTimeInterval
     (std::optional<TimeIntervalConfig<Time>> const& config);
   
+  /**
+   * @brief Extracts a `icarus::ns::util::TimeIntervalSet` from a sequence of
+   *        FHiCL interval configurations.
+   * @tparam Time type of time the interval objects use
+   * @param configs the FHiCL configurations of all the intervals
+   * @return a set with all the intervals, sorted and merged
+   * 
+   * Each of the `configs` is interpreted by `makeTimeInterval()`, and the
+   * resulting intervals are merged in a single
+   * `icarus::ns::util::TimeIntervalSet`. The configuration can be read via
+   * `fhicl::Sequence<icarus::ns::fhicl::TimeIntervalTable<Time>>`, e.g.:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * Windows: [
+   *   { Start: "-2 us"  Duration: "1.6 us" },  # beam gate
+   *   { Start: "10 us"  End: "15 us" }
+   * ]
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename Time>
+  icarus::ns::util::TimeIntervalSet<Time> makeTimeIntervalSet
+    (std::vector<TimeIntervalConfig<Time>> const& configs);
+  
   /**
    * @brief FHiCL configuration object for specification of a (time) interval.
    * @tparam Time the type of the time point being read by the configuration
@@ -341,6 +365,19 @@ icarus::ns::fhicl::makeTimeInterval
   { return config? std::optional{ makeTimeInterval(*config) }: std::nullopt; }
 
 
+//--------------------------------------------------------------------------
+template <typename Time>
+icarus::ns::util::TimeIntervalSet<Time> icarus::ns::fhicl::makeTimeIntervalSet
+  (std::vector<TimeIntervalConfig<Time>> const& configs)
+{
+  std::vector<icarus::ns::util::TimeInterval<Time>> intervals;
+  intervals.reserve(configs.size());
+  for (TimeIntervalConfig<Time> const& config: configs)
+    intervals.push_back(makeTimeInterval(config));
+  return icarus::ns::util::TimeIntervalSet<Time>{ intervals };
+} // icarus::ns::fhicl::makeTimeIntervalSet()
+
+
 //--------------------------------------------------------------------------
 
 
@@ -0,0 +1,297 @@
+/**
+ * @file   icarusalg/Utilities/TimeIntervalSet.h
+ * @brief  Set of time intervals optimised for selecting many times.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/Utilities/TimeInterval.h
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_UTILITIES_TIMEINTERVALSET_H
+#define ICARUSALG_UTILITIES_TIMEINTERVALSET_H
+
+
+// ICARUS libraries
+#include "icarusalg/Utilities/TimeInterval.h"
+
+// C/C++ standard libraries
+#include <ostream>
+#include <vector>
+#include <initializer_list>
+#include <algorithm> // std::sort(), std::upper_bound(), std::fill_n()
+#include <utility> // std::declval()
+#include <type_traits> // std::void_t, std::true_type
+#include <cstdint> // std::uint8_t
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::ns::util {
+
+  template <typename Time> class TimeIntervalSet;
+
+  template <typename Time>
+  std::ostream& operator<<
+    (std::ostream& out, TimeIntervalSet<Time> const& intervals);
+
+  namespace details {
+
+    /// Whether `T` is a quantity-like type with a `value()` method.
+    template <typename T, typename = void>
+    struct HasValueMethod: std::false_type {};
+
+    template <typename T>
+    struct HasValueMethod<T, std::void_t<decltype(std::declval<T>().value())>>
+      : std::true_type {};
+
+    /// Returns the plain number representing `t`.
+    template <typename T>
+    constexpr auto plainTimeValue(T const& t)
+      {
+        if constexpr (HasValueMethod<T>::value) return t.value();
+        else return t;
+      }
+
+  } // namespace details
+
+} // namespace icarus::ns::util
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief A set of time intervals, sorted and merged, for fast selection.
+ * @tparam Time type of time for the intervals
+ * @see `icarus::ns::util::TimeInterval`,
+ *      `icarus::ns::fhicl::makeTimeIntervalSet()`
+ *
+ * This object is built from a list of `icarus::ns::util::TimeInterval`
+ * (e.g. beam gates, vetoes, time slices from the configuration), and it
+ * answers whether a time is contained in any of them.
+ * At construction, empty intervals are dropped and the others are sorted and
+ * merged when overlapping or adjacent, so that each time belongs to at most
+ * one of the stored intervals. Each interval includes its `start` and excludes
+ * its `stop`, as in `TimeInterval::contains()`.
+ *
+ * The limits of the intervals are stored as plain numbers (the `value()` of
+ * LArSoft quantities like `detinfo::timescales::electronics_time`), in two
+ * separate arrays. The selection of a whole array of times
+ * (`contains(times, n, mask)`) loops over the intervals, and for each one
+ * over all the times with no branching, which the compiler vectorizes;
+ * with many intervals, a binary search is performed for each time instead.
+ *
+ * Example selecting waveforms in a list of configured time windows:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::TimeIntervalSet<optical_time> const windows
+ *   { icarus::ns::fhicl::makeTimeIntervalSet(config.Windows()) };
+ *
+ * std::vector<optical_time> times;
+ * for (raw::OpDetWaveform const& waveform: waveforms)
+ *   times.emplace_back(microsecond{ waveform.TimeStamp() });
+ *
+ * std::vector<std::uint8_t> const selected = windows.contains(times);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename Time>
+class icarus::ns::util::TimeIntervalSet {
+
+    public:
+
+  using Time_t = Time; ///< Type of time used.
+
+  using Interval_t = icarus::ns::util::TimeInterval<Time_t>; ///< Interval type.
+
+  /// Type of plain number used to represent times.
+  using Value_t = decltype(details::plainTimeValue(std::declval<Time_t>()));
+
+  /// Largest number of intervals for which the scan of all is preferred.
+  static constexpr std::size_t MaxScannedIntervals = 8U;
+
+
+  // --- BEGIN -- Constructors -------------------------------------------------
+  /// @name Constructors
+  /// @{
+
+  /// Constructor: an empty set, containing no time.
+  TimeIntervalSet() = default;
+
+  /// Constructor: merges all the `intervals` in the collection.
+  template <typename Coll>
+  explicit TimeIntervalSet(Coll const& intervals)
+    { using std::begin, std::end; build(begin(intervals), end(intervals)); }
+
+  /// Constructor: merges all the specified `intervals`.
+  TimeIntervalSet(std::initializer_list<Interval_t> intervals)
+    { build(intervals.begin(), intervals.end()); }
+
+  /// @}
+  // --- END ---- Constructors -------------------------------------------------
+
+
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query
+  /// @{
+
+  /// Returns whether there is no interval (no time is contained).
+  bool empty() const noexcept { return fStarts.empty(); }
+
+  /// Returns the number of intervals after merging.
+  std::size_t size() const noexcept { return fStarts.size(); }
+
+  /// Returns the merged intervals, sorted.
+  std::vector<Interval_t> intervals() const;
+
+  /// @}
+  // --- END ---- Query --------------------------------------------------------
+
+
+  // --- BEGIN -- Selection ----------------------------------------------------
+  /// @name Selection
+  /// @{
+
+  /// Returns whether time `t` is in any of the intervals.
+  bool contains(Time_t t) const;
+
+  /**
+   * @brief Tests whether each of the `times` is in any of the intervals.
+   * @param times pointer to the first of the times to test
+   * @param n number of times to test
+   * @param[out] mask pointer to `n` elements, set to `1` or `0`
+   *
+   * The result for `times[i]` is `mask[i]`, `1` if that time is contained in
+   * any of the intervals, `0` otherwise.
+   */
+  void contains(Time_t const* times, std::size_t n, std::uint8_t* mask) const;
+
+  /// Returns for each of the `times` whether it is in any of the intervals.
+  std::vector<std::uint8_t> contains(std::vector<Time_t> const& times) const;
+
+  /// @}
+  // --- END ---- Selection ----------------------------------------------------
+
+
+    private:
+
+  std::vector<Value_t> fStarts; ///< Start of each interval (included).
+  std::vector<Value_t> fStops; ///< Stop of each interval (excluded).
+
+  /// Fills the intervals from the sequence between `begin` and `end`.
+  template <typename BIter, typename EIter>
+  void build(BIter begin, EIter end);
+
+  /// Returns the plain number representing time `t`.
+  static constexpr Value_t valueOf(Time_t const& t)
+    { return details::plainTimeValue(t); }
+
+}; // icarus::ns::util::TimeIntervalSet
+
+
+//------------------------------------------------------------------------------
+//---  Template implementation
+//------------------------------------------------------------------------------
+template <typename Time>
+auto icarus::ns::util::TimeIntervalSet<Time>::intervals() const
+  -> std::vector<Interval_t>
+{
+  std::vector<Interval_t> intervals;
+  intervals.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i)
+    intervals.emplace_back(Time_t{ fStarts[i] }, Time_t{ fStops[i] });
+  return intervals;
+} // icarus::ns::util::TimeIntervalSet<>::intervals()
+
+
+//------------------------------------------------------------------------------
+template <typename Time>
+bool icarus::ns::util::TimeIntervalSet<Time>::contains(Time_t t) const {
+
+  Value_t const v = valueOf(t);
+
+  // the first interval starting after `v`; the one before may contain it
+  auto const iNext = std::upper_bound(fStarts.begin(), fStarts.end(), v);
+  if (iNext == fStarts.begin()) return false;
+  return v < fStops[(iNext - fStarts.begin()) - 1];
+
+} // icarus::ns::util::TimeIntervalSet<>::contains()
+
+
+//------------------------------------------------------------------------------
+template <typename Time>
+void icarus::ns::util::TimeIntervalSet<Time>::contains
+  (Time_t const* times, std::size_t n, std::uint8_t* mask) const
+{
+  if (size() > MaxScannedIntervals) {
+    for (std::size_t i = 0; i < n; ++i) mask[i] = contains(times[i]);
+    return;
+  }
+
+  // each interval on all times: the inner loop has no branch and vectorizes
+  std::fill_n(mask, n, std::uint8_t{ 0 });
+  for (std::size_t k = 0; k < size(); ++k) {
+    Value_t const start = fStarts[k], stop = fStops[k];
+    for (std::size_t i = 0; i < n; ++i) {
+      Value_t const v = valueOf(times[i]);
+      mask[i] |= static_cast<std::uint8_t>((v >= start) & (v < stop));
+    } // for times
+  } // for intervals
+
+} // icarus::ns::util::TimeIntervalSet<>::contains(array)
+
+
+//------------------------------------------------------------------------------
+template <typename Time>
+std::vector<std::uint8_t> icarus::ns::util::TimeIntervalSet<Time>::contains
+  (std::vector<Time_t> const& times) const
+{
+  std::vector<std::uint8_t> mask(times.size());
+  contains(times.data(), times.size(), mask.data());
+  return mask;
+} // icarus::ns::util::TimeIntervalSet<>::contains(vector)
+
+
+//------------------------------------------------------------------------------
+template <typename Time>
+template <typename BIter, typename EIter>
+void icarus::ns::util::TimeIntervalSet<Time>::build(BIter begin, EIter end) {
+
+  std::vector<Interval_t> intervals;
+  for (auto it = begin; it != end; ++it) {
+    Interval_t const interval { *it };
+    if (!interval.empty()) intervals.push_back(interval);
+  }
+
+  std::sort(intervals.begin(), intervals.end(),
+    [](Interval_t const& a, Interval_t const& b){ return a.start < b.start; });
+
+  fStarts.clear();
+  fStops.clear();
+  for (Interval_t const& interval: intervals) {
+    Value_t const start = valueOf(interval.start);
+    Value_t const stop = valueOf(interval.stop);
+    if (!fStops.empty() && !(fStops.back() < start)) { // overlap or adjacent
+      if (fStops.back() < stop) fStops.back() = stop;
+      continue;
+    }
+    fStarts.push_back(start);
+    fStops.push_back(stop);
+  } // for
+
+} // icarus::ns::util::TimeIntervalSet<>::build()
+
+
+//------------------------------------------------------------------------------
+template <typename Time>
+std::ostream& icarus::ns::util::operator<<
+  (std::ostream& out, TimeIntervalSet<Time> const& intervals)
+{
+  if (intervals.empty()) return out << "{ none }";
+  out << "{";
+  for (auto const& interval: intervals.intervals()) out << " " << interval;
+  return out << " }";
+} // icarus::ns::util::operator<< (TimeIntervalSet)
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_UTILITIES_TIMEINTERVALSET_H
@@ -16,6 +16,7 @@
 
 // C/C++ standard libraries
 #include <ostream>
+#include <memory> // std::make_shared()
 #include <utility> // std::move()
 #include <cmath> // std::abs()
 #include <cassert>
@@ -27,8 +28,10 @@ lar::util::TrackTimeInterval::TrackTimeInterval(
   detinfo::DetectorPropertiesData detProp,
   detinfo::DetectorTimings detTimings
 )
-  : TrackTimeInterval
-    { buildGeomCache(geom), std::move(detProp), std::move(detTimings) }
+  : TrackTimeInterval{
+      std::make_shared<GeometryCache_t const>(buildGeomCache(geom)),
+      std::move(detProp), std::move(detTimings)
+    }
   {}
 
 
@@ -81,28 +84,28 @@ auto lar::util::TrackTimeInterval::timeRange(
    * and give directly t0(max) in those other scales.
    */
   
-  detinfo::timescales::electronics_time const time
-    = fDetTimings.toElectronicsTime(TPCtick);
-  
-  TimeLimits_t const& planeTimeLimits = fGeomCache.limits[planeID];
-  microseconds const driftTime{
-    planeTimeLimits.driftDistance.convertInto<centimeters>().value()
-    / fDriftVelocity
-    };
-  return { time - driftTime, time };
+  /*
+   * The conversion from tick to electronics time is linear, and its parameters
+   * are extracted from `DetectorTimings` at construction.
+   */
+  return planeTimeRange(TPCtick.value(), fGeomCache->limits[planeID]);
   
 } // lar::util::TrackTimeInterval::timeRange(tick)
 
 
 // -----------------------------------------------------------------------------
 lar::util::TrackTimeInterval::TrackTimeInterval(
-  GeometryCache_t geomCache,
+  std::shared_ptr<GeometryCache_t const> geomCache,
   detinfo::DetectorPropertiesData detProp,
   detinfo::DetectorTimings detTimings
 )
   : fDetProp{ std::move(detProp) }
   , fDetTimings{ std::move(detTimings) }
   , fDriftVelocity{ fDetProp.DriftVelocity() }
+  , fTickTime0{ fDetTimings.toElectronicsTime
+      (detinfo::timescales::TPCelectronics_tick_d{ 0.0 }).value()
+    }
+  , fTickPeriod{ fDetTimings.clockData().TPCClock().TickPeriod() }
   , fGeomCache{ std::move(geomCache) }
   {}
 
@@ -111,11 +114,17 @@ lar::util::TrackTimeInterval::TrackTimeInterval(
 auto lar::util::TrackTimeInterval::buildGeomCache(geo::GeometryCore const& geom)
   -> GeometryCache_t
 {
-  return {
+  GeometryCache_t cache {
       extractTimeLimits(geom),                   // limits
       { geom.Ncryostats(), geom.MaxTPCsets() },  // TPCsetDims
       extractTPCtoSetMap(geom)                   // TPCtoSet
     };
+  
+  // each plane also knows its TPC set, saving a lookup per hit
+  for (geo::PlaneGeo const& plane: geom.Iterate<geo::PlaneGeo>())
+    cache.limits[plane.ID()].TPCset = cache.TPCtoSet[plane.ID()];
+  
+  return cache;
 } // lar::util::TrackTimeInterval::buildGeomCache()
 
 
@@ -146,7 +155,7 @@ auto lar::util::TrackTimeInterval::extractTimeLimits
       
       geo::PlaneID const& planeID = plane.ID();
       
-      limits[planeID] = { driftDistance };
+      limits[planeID] = { driftDistance, {} }; // TPC set is assigned later
       
     } // for planes
   } // for TPC
@@ -179,13 +188,13 @@ auto lar::util::TrackTimeInterval::mergeTPCsetRanges_SBN
   -> TimeRange
 {
   // reduce to each cryostat
-  std::vector<TimeRange> cryoRanges{ fGeomCache.Ncryostats() };
+  std::vector<TimeRange> cryoRanges{ fGeomCache->Ncryostats() };
   for (readout::CryostatID::CryostatID_t const cryoNo
     : ::util::counter(cryoRanges.size())
   ) {
     readout::CryostatID const cryoID{ cryoNo };
     
-    unsigned int const NTPCsets = fGeomCache.TPCsetDims[1];
+    unsigned int const NTPCsets = fGeomCache->TPCsetDims[1];
     
     TimeRange& cryoRange = cryoRanges[cryoNo];
     
@@ -223,6 +232,64 @@ auto lar::util::TrackTimeInterval::mergeTPCsetRanges_SBN
 } // lar::util::TrackTimeInterval::mergeTPCsetRanges_SBN()
 
 
+// -----------------------------------------------------------------------------
+auto lar::util::TrackTimeInterval::timeRangeOfWorkspaceHits
+  (Workspace& workspace) const -> TimeRange
+{
+  readout::TPCsetDataContainer<TimeRange>& TPCsetRanges
+    = resetTPCsetRanges(workspace);
+  
+  // per TPC set (i.e. drift volume)
+  for (recob::Hit const* hit: workspace.hits) {
+    if (!hit) continue; // like `timeRange(nullptr)`, no constraint
+    TimeLimits_t const& planeLimits = fGeomCache->limits.at(hit->WireID());
+    TPCsetRanges[planeLimits.TPCset].intersect
+      (planeTimeRange(hit->PeakTime(), planeLimits));
+  } // for
+  
+  return mergeTPCsetRanges_SBN(TPCsetRanges);
+} // lar::util::TrackTimeInterval::timeRangeOfWorkspaceHits()
+
+
+// -----------------------------------------------------------------------------
+auto lar::util::TrackTimeInterval::timeRangeOfWorkspaceRows
+  (icarus::ns::util::HitColumns const& hits, Workspace& workspace) const
+  -> TimeRange
+{
+  readout::TPCsetDataContainer<TimeRange>& TPCsetRanges
+    = resetTPCsetRanges(workspace);
+  
+  // per TPC set (i.e. drift volume); plane and TPC set are from the table
+  float const* peakTime = hits.peakTime();
+  for (std::size_t const row: workspace.rows) {
+    TimeLimits_t const& planeLimits = fGeomCache->limits.at(hits.planeID(row));
+    TPCsetRanges[hits.TPCsetID(row)].intersect
+      (planeTimeRange(peakTime[row], planeLimits));
+  } // for
+  
+  return mergeTPCsetRanges_SBN(TPCsetRanges);
+} // lar::util::TrackTimeInterval::timeRangeOfWorkspaceRows()
+
+
+// -----------------------------------------------------------------------------
+auto lar::util::TrackTimeInterval::resetTPCsetRanges
+  (Workspace& workspace) const -> readout::TPCsetDataContainer<TimeRange>&
+{
+  // reuse the per-TPC set ranges of the workspace after a reset
+  readout::TPCsetDataContainer<TimeRange>& TPCsetRanges
+    = workspace.TPCsetRanges;
+  if (TPCsetRanges.size()
+    != fGeomCache->TPCsetDims[0] * fGeomCache->TPCsetDims[1]
+  ) {
+    TPCsetRanges = makeTPCsetData<TimeRange>();
+  }
+  else {
+    for (TimeRange& range: TPCsetRanges) range = TimeRange{};
+  }
+  return TPCsetRanges;
+} // lar::util::TrackTimeInterval::resetTPCsetRanges()
+
+
 // -----------------------------------------------------------------------------
 auto lar::util::TrackTimeInterval::mergeCathodeRanges
   (TimeRange const& range1, TimeRange const& range2) const -> TimeRange
@@ -244,11 +311,6 @@ auto lar::util::TrackTimeInterval::mergeCathodeRanges
 } // lar::util::TrackTimeInterval::mergeCathodeRanges()
 
 
-// -----------------------------------------------------------------------------
-geo::WireID lar::util::TrackTimeInterval::hitWire(recob::Hit const& hit)
-  { return hit.WireID(); }
-
-
 // -----------------------------------------------------------------------------
 // --- lar::util::TrackTimeInterval::TimeRange implementation
 // -----------------------------------------------------------------------------
@@ -300,7 +362,10 @@ std::ostream& lar::util::operator<<
 // -----------------------------------------------------------------------------
 lar::util::TrackTimeIntervalMaker::TrackTimeIntervalMaker
   (geo::GeometryCore const& geom)
-  : fGeomCache{ TrackTimeInterval::buildGeomCache(geom) }
+  : fGeomCache{
+      std::make_shared<TrackTimeInterval::GeometryCache_t const>
+        (TrackTimeInterval::buildGeomCache(geom))
+    }
   {}
 
 
@@ -315,4 +380,39 @@ auto lar::util::TrackTimeIntervalMaker::make(
 }
 
 
+// -----------------------------------------------------------------------------
+auto lar::util::TrackTimeIntervalMaker::makeCached(
+  detinfo::DetectorPropertiesData const& detProp,
+  detinfo::DetectorTimings const& detTimings
+) const -> std::shared_ptr<TrackTimeInterval const>
+{
+  TimingKey_t const key = timingKey(detProp, detTimings);
+  
+  std::lock_guard lg { fLastIntervalLock };
+  
+  // the monitor reports no change on its first call
+  bool const changed = fTimingMonitor.update(key).has_value();
+  if (changed || !fLastInterval) {
+    fLastInterval.reset
+      (new TrackTimeInterval{ fGeomCache, detProp, detTimings });
+  }
+  return fLastInterval;
+} // lar::util::TrackTimeIntervalMaker::makeCached()
+
+
+// -----------------------------------------------------------------------------
+auto lar::util::TrackTimeIntervalMaker::timingKey(
+  detinfo::DetectorPropertiesData const& detProp,
+  detinfo::DetectorTimings const& detTimings
+) -> TimingKey_t
+{
+  detinfo::timescales::TPCelectronics_tick_d const tick0{ 0.0 };
+  return {
+      detTimings.toElectronicsTime(tick0).value()      // tickTime0
+    , detTimings.clockData().TPCClock().TickPeriod()   // tickPeriod
+    , detProp.DriftVelocity()                          // driftVelocity
+    };
+} // lar::util::TrackTimeIntervalMaker::timingKey()
+
+
 // -----------------------------------------------------------------------------
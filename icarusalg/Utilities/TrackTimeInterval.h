@@ -10,6 +10,10 @@
 #define ICARUSALG_UTILITIES_TRACKTIMEINTERVAL_H
 
 
+// ICARUS libraries
+#include "icarusalg/Utilities/ChangeMonitor.h"
+#include "icarusalg/Utilities/HitColumns.h"
+
 // LArSoft libraries
 #include "lardataalg/DetectorInfo/DetectorTimings.h"
 #include "lardataalg/DetectorInfo/DetectorTimingTypes.h"
@@ -24,6 +28,9 @@
 
 // C/C++ standard libraries
 #include <string>
+#include <vector>
+#include <memory> // std::shared_ptr<>
+#include <mutex>
 #include <iterator> // std::cbegin(), std::cend()
 #include <iosfwd>
 
@@ -92,6 +99,14 @@ namespace lar::util {
  * } // for
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * 
+ * When processing many tracks, the memory needed by each call can be reused
+ * by passing a `Workspace` object, or all the tracks can be processed at once:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * std::vector<std::vector<art::Ptr<recob::Hit>>> const trackHits = ...;
+ * std::vector<lar::util::TrackTimeInterval::TimeRange> const hitTimeRanges
+ *   = chargeTime.timeRangesOfHits(trackHits);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * 
  * 
  */
 class lar::util::TrackTimeInterval {
@@ -169,6 +184,26 @@ class lar::util::TrackTimeInterval {
     
   }; // TimeRange
   
+  /**
+   * @brief Memory reused by `timeRangeOfHits()` calls.
+   * 
+   * A workspace can be used with any `TrackTimeInterval` object, but by only
+   * one call at a time (i.e. one workspace per thread).
+   */
+  class Workspace {
+    friend class TrackTimeInterval;
+    
+    /// Hits being processed.
+    std::vector<recob::Hit const*> hits;
+    
+    /// Rows of the hits being processed from a `HitColumns` table.
+    std::vector<std::size_t> rows;
+    
+    /// Allowed time range in each TPC set.
+    readout::TPCsetDataContainer<TimeRange> TPCsetRanges;
+    
+  }; // Workspace
+  
   // ---  END  ----- data structures -------------------------------------------
   
   
@@ -259,12 +294,68 @@ class lar::util::TrackTimeInterval {
   TimeRange timeRangeOfHits(HitColl const& hits) const;
   
   
+  /// Returns the time range including all the hits in a sequence, using the
+  /// memory of `workspace`.
+  /// @see `timeRangeOfHits(BIter, EIter) const`
+  template <typename BIter, typename EIter>
+  TimeRange timeRangeOfHits(BIter begin, EIter end, Workspace& workspace) const;
+  
+  /// Returns the time range including all the hits in the collection, using
+  /// the memory of `workspace`.
+  /// @see `timeRangeOfHits(BIter, EIter) const`
+  template <typename HitColl>
+  TimeRange timeRangeOfHits(HitColl const& hits, Workspace& workspace) const;
+  
+  /**
+   * @brief Returns the time range of each of the collections of hits.
+   * @tparam HitColls type of sequence of hit collections
+   * @param hitColls the sequence of hit collections (e.g. one per track)
+   * @return time range of each collection, in the same order
+   * @see `timeRangeOfHits(HitColl const&) const`
+   * 
+   * Each element of `hitColls` (a `std::vector`, a span...) must be acceptable
+   * to `timeRangeOfHits(HitColl const&) const`, and the result is the same.
+   */
+  template <typename HitColls>
+  std::vector<TimeRange> timeRangesOfHits(HitColls const& hitColls) const;
+  
+  
+  /**
+   * @brief Returns the time range including the hits in the specified rows.
+   * @tparam Rows type of sequence of row indices
+   * @param hits table of the hits of the event
+   * @param rows the indices in `hits` of the hits to be included
+   * @return time range including all the selected hits
+   * @see `timeRangeOfHits(BIter, EIter) const`
+   * 
+   * The result is the same as from `timeRangeOfHits()` on the selected hits,
+   * but the time, the plane and the TPC set of each hit are read from the
+   * table, which must have been filled with the layout of the same geometry
+   * as this object.
+   * The row of a hit in the table is the key of its `art::Ptr`, so the rows
+   * of the hits associated to a track are the keys of their pointers.
+   */
+  template <typename Rows>
+  TimeRange timeRangeOfHitRows
+    (icarus::ns::util::HitColumns const& hits, Rows const& rows) const;
+  
+  /// Returns the time range including the hits in the specified rows, using
+  /// the memory of `workspace`.
+  /// @see `timeRangeOfHitRows(HitColumns const&, Rows const&) const`
+  template <typename Rows>
+  TimeRange timeRangeOfHitRows(
+    icarus::ns::util::HitColumns const& hits, Rows const& rows,
+    Workspace& workspace
+    ) const;
+  
+  
     private:
   friend class TrackTimeIntervalMaker;
   
   using centimeters = ::util::quantities::intervals::centimeters;
   struct TimeLimits_t {
-    centimeters driftDistance;
+    centimeters driftDistance; ///< Distance from the plane to the cathode.
+    readout::TPCsetID TPCset; ///< TPC set of the plane.
   };
   
   struct GeometryCache_t {
@@ -286,9 +377,9 @@ class lar::util::TrackTimeInterval {
   }; // GeometryCache_t
   
   
-  /// Constructor: uses a provided cache instead of creating it.
+  /// Constructor: shares a provided cache instead of creating it.
   TrackTimeInterval(
-    GeometryCache_t geomCache,
+    std::shared_ptr<GeometryCache_t const> geomCache,
     detinfo::DetectorPropertiesData detProp,
     detinfo::DetectorTimings detTimings
     );
@@ -302,7 +393,12 @@ class lar::util::TrackTimeInterval {
   
   double const fDriftVelocity; ///< Detector drift velocity [cm/us]
   
-  GeometryCache_t const fGeomCache; ///< Cached geometry information.
+  double const fTickTime0; ///< Electronics time of TPC tick `0` [us]
+  
+  double const fTickPeriod; ///< TPC readout tick period [us]
+  
+  /// Cached geometry information (shared among objects from the same maker).
+  std::shared_ptr<GeometryCache_t const> const fGeomCache;
   
   
   /// Creates a geometry cache.
@@ -347,16 +443,32 @@ class lar::util::TrackTimeInterval {
   TimeRange mergeTPCsetRanges_SBN
     (readout::TPCsetDataContainer<TimeRange> const& TPCsetRanges) const;
   
+  /// Returns the range for charge detected at `TPCtick` on a plane with the
+  /// specified limits.
+  TimeRange planeTimeRange(double TPCtick, TimeLimits_t const& planeLimits)
+    const;
+  
+  /// Returns the time range of the hits in `workspace.hits`.
+  TimeRange timeRangeOfWorkspaceHits(Workspace& workspace) const;
   
-  /// Returns a copy of the wire ID of a `hit`.
-  static geo::WireID hitWire(recob::Hit const& hit);
+  /// Returns the time range of the hits of `hits` in `workspace.rows`.
+  TimeRange timeRangeOfWorkspaceRows
+    (icarus::ns::util::HitColumns const& hits, Workspace& workspace) const;
   
-  /// Returns a copy of the wire ID of a `hit`.
-  static geo::WireID hitWire(recob::Hit const* hit) { return hitWire(*hit); }
+  /// Returns the per-TPC set ranges of `workspace`, all reset.
+  readout::TPCsetDataContainer<TimeRange>& resetTPCsetRanges
+    (Workspace& workspace) const;
   
-  /// Returns a copy of the wire ID of a hit.
-  static geo::WireID hitWire(art::Ptr<recob::Hit> const& hitPtr)
-     { return hitWire(*hitPtr); }
+  
+  /// Returns a pointer to the `hit`.
+  static recob::Hit const* hitPtr(recob::Hit const& hit) { return &hit; }
+  
+  /// Returns a pointer to the `hit`.
+  static recob::Hit const* hitPtr(recob::Hit const* hit) { return hit; }
+  
+  /// Returns a pointer to the hit.
+  template <typename T>
+  static T const* hitPtr(art::Ptr<T> const& hitPtr) { return hitPtr.get(); }
   
   /// Returns a `readout::TPCsetDataContainer` with the cached dimensions.
   template <typename T>
@@ -384,8 +496,9 @@ namespace lar::util {
  * not event-dependent.
  * 
  * To avoid the recalculation of that part of information, this class computes
- * it once at construction, and then it copies that to a new `TrackTimeInterval`
- * object any time one is requested.
+ * it once at construction, and then it shares it with each new
+ * `TrackTimeInterval` object it makes (the cache is immutable, and the sharing
+ * is thread-safe).
  * This object should be declared as a data member of an analysis class
  * (an _art_ module, for example), and in the event loop it should be invoked
  * to get a usable `lar::util::TrackTimeInterval`.
@@ -465,11 +578,43 @@ namespace lar::util {
  * }
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * which does not benefit from the precomputed cache.
+ * 
+ * In the common case where the detector timing does not change from event to
+ * event, `makeCached()` saves also the copy of the detector information:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ *   std::shared_ptr<lar::util::TrackTimeInterval const> const timeIntervals
+ *     = fTimeIntervalMaker.makeCached(detProp, detTimings);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * returns the same object as the previous call, unless the timing parameters
+ * changed in the meanwhile.
  */
 class lar::util::TrackTimeIntervalMaker {
   
-  /// Geometry cache to be copied to the `TrackTimeInterval` objects.
-  TrackTimeInterval::GeometryCache_t const fGeomCache;
+  /// Parameters the time ranges depend on, besides the geometry.
+  struct TimingKey_t {
+    double tickTime0; ///< Electronics time of TPC tick `0` [us]
+    double tickPeriod; ///< TPC readout tick period [us]
+    double driftVelocity; ///< Detector drift velocity [cm/us]
+    
+    bool operator== (TimingKey_t const&) const = default;
+  }; // TimingKey_t
+  
+  /// Geometry cache to be shared with the `TrackTimeInterval` objects.
+  std::shared_ptr<TrackTimeInterval::GeometryCache_t const> const fGeomCache;
+  
+  /// Timing of the last object from `makeCached()`.
+  mutable icarus::ns::util::ChangeMonitor<TimingKey_t> fTimingMonitor;
+  
+  /// Last object from `makeCached()`.
+  mutable std::shared_ptr<TrackTimeInterval const> fLastInterval;
+  
+  mutable std::mutex fLastIntervalLock; ///< Lock for `makeCached()` memo.
+  
+  /// Extracts the timing parameters from the detector information.
+  static TimingKey_t timingKey(
+    detinfo::DetectorPropertiesData const& detProp,
+    detinfo::DetectorTimings const& detTimings
+    );
   
     public:
   
@@ -490,6 +635,22 @@ class lar::util::TrackTimeIntervalMaker {
     { return make(std::move(detProp), std::move(detTimings)); }
   //@}
   
+  /**
+   * @brief Returns a `TrackTimeInterval`, reusing the last one if possible.
+   * @param detProp detector properties
+   * @param detTimings detector timing conversion utility
+   * @return a `TrackTimeInterval` with the specified detector properties
+   * 
+   * If the timing parameters relevant to `TrackTimeInterval` (TPC clock,
+   * trigger time and drift velocity) are the same as in the previous call,
+   * the object returned then is returned again.
+   * Otherwise a new object is created. This method can be called concurrently.
+   */
+  std::shared_ptr<TrackTimeInterval const> makeCached(
+    detinfo::DetectorPropertiesData const& detProp,
+    detinfo::DetectorTimings const& detTimings
+    ) const;
+  
 }; // lar::util::TrackTimeIntervalMaker
 
 
@@ -515,6 +676,18 @@ inline auto lar::util::TrackTimeInterval::timeRange
 }
 
 
+// -----------------------------------------------------------------------------
+inline auto lar::util::TrackTimeInterval::planeTimeRange
+  (double TPCtick, TimeLimits_t const& planeLimits) const -> TimeRange
+{
+  // see `timeRange(TPCelectronics_tick_d, geo::PlaneID const&)` for the recipe
+  electronics_time const time{ fTickTime0 + fTickPeriod * TPCtick };
+  microseconds const driftTime
+    { planeLimits.driftDistance.value() / fDriftVelocity };
+  return { time - driftTime, time };
+}
+
+
 // -----------------------------------------------------------------------------
 // ---  Template implementation
 // -----------------------------------------------------------------------------
@@ -522,18 +695,22 @@ template <typename BIter, typename EIter>
 auto lar::util::TrackTimeInterval::timeRangeOfHits(BIter begin, EIter end) const
   -> TimeRange
 {
-  auto TPCsetRanges = makeTPCsetData<TimeRange>();
-  
-  // per TPC set (i.e. drift volume)
-  while (begin != end) {
-    readout::TPCsetID const tpcsetID = fGeomCache.TPCtoSet.at(hitWire(*begin));
-    TPCsetRanges[tpcsetID].intersect(timeRange(*begin++));
-  }
-  
-  return mergeTPCsetRanges_SBN(TPCsetRanges);
+  Workspace workspace;
+  return timeRangeOfHits(begin, end, workspace);
 } // lar::util::TrackTimeInterval::timeRangeOfHits(Iter)
 
 
+// -----------------------------------------------------------------------------
+template <typename BIter, typename EIter>
+auto lar::util::TrackTimeInterval::timeRangeOfHits
+  (BIter begin, EIter end, Workspace& workspace) const -> TimeRange
+{
+  workspace.hits.clear();
+  while (begin != end) workspace.hits.push_back(hitPtr(*begin++));
+  return timeRangeOfWorkspaceHits(workspace);
+} // lar::util::TrackTimeInterval::timeRangeOfHits(Iter, Workspace)
+
+
 // -----------------------------------------------------------------------------
 template <typename HitColl>
 auto lar::util::TrackTimeInterval::timeRangeOfHits(HitColl const& hits) const
@@ -544,13 +721,59 @@ auto lar::util::TrackTimeInterval::timeRangeOfHits(HitColl const& hits) const
 } // lar::util::TrackTimeInterval::timeRangeOfHits(HitColl)
 
 
+// -----------------------------------------------------------------------------
+template <typename HitColl>
+auto lar::util::TrackTimeInterval::timeRangeOfHits
+  (HitColl const& hits, Workspace& workspace) const -> TimeRange
+{
+  using std::cbegin, std::cend;
+  return timeRangeOfHits(cbegin(hits), cend(hits), workspace);
+} // lar::util::TrackTimeInterval::timeRangeOfHits(HitColl, Workspace)
+
+
+// -----------------------------------------------------------------------------
+template <typename HitColls>
+auto lar::util::TrackTimeInterval::timeRangesOfHits
+  (HitColls const& hitColls) const -> std::vector<TimeRange>
+{
+  Workspace workspace;
+  std::vector<TimeRange> ranges;
+  for (auto const& hits: hitColls)
+    ranges.push_back(timeRangeOfHits(hits, workspace));
+  return ranges;
+} // lar::util::TrackTimeInterval::timeRangesOfHits()
+
+
+// -----------------------------------------------------------------------------
+template <typename Rows>
+auto lar::util::TrackTimeInterval::timeRangeOfHitRows
+  (icarus::ns::util::HitColumns const& hits, Rows const& rows) const
+  -> TimeRange
+{
+  Workspace workspace;
+  return timeRangeOfHitRows(hits, rows, workspace);
+} // lar::util::TrackTimeInterval::timeRangeOfHitRows()
+
+
+// -----------------------------------------------------------------------------
+template <typename Rows>
+auto lar::util::TrackTimeInterval::timeRangeOfHitRows(
+  icarus::ns::util::HitColumns const& hits, Rows const& rows,
+  Workspace& workspace
+) const -> TimeRange {
+  using std::cbegin, std::cend;
+  workspace.rows.assign(cbegin(rows), cend(rows));
+  return timeRangeOfWorkspaceRows(hits, workspace);
+} // lar::util::TrackTimeInterval::timeRangeOfHitRows(Workspace)
+
+
 // -----------------------------------------------------------------------------
 template <typename T>
 readout::TPCsetDataContainer<T> lar::util::TrackTimeInterval::makeTPCsetData
   () const
 {
   return readout::TPCsetDataContainer<T>
-    { fGeomCache.TPCsetDims[0], fGeomCache.TPCsetDims[1] };
+    { fGeomCache->TPCsetDims[0], fGeomCache->TPCsetDims[1] };
 } // lar::util::TrackTimeInterval::makeTPCsetData()
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,202 @@
+/**
+ * @file   icarusalg/Utilities/TrackTimeRangeIndex.cxx
+ * @brief  Index of track time ranges for matching many times at once.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/Utilities/TrackTimeRangeIndex.h
+ */
+
+// library header
+#include "icarusalg/Utilities/TrackTimeRangeIndex.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::upper_bound(), std::max()
+#include <numeric> // std::iota()
+#include <utility> // std::pair
+#include <limits>
+
+
+//------------------------------------------------------------------------------
+//---  lar::util::TrackTimeRangeIndex
+//------------------------------------------------------------------------------
+lar::util::TrackTimeRangeIndex::TrackTimeRangeIndex(
+  std::vector<TimeRange_t> const& ranges,
+  microseconds startMargin, microseconds stopMargin
+)
+  : fNTracks{ ranges.size() }
+{
+  constexpr Value_t Infinity = std::numeric_limits<Value_t>::infinity();
+
+  // undefined limits extend indefinitely (invalid ranges contain everything);
+  // the limits are computed as in `TimeRange::contains()`
+  std::vector<std::pair<Value_t, Value_t>> limits;
+  std::vector<std::size_t> tracks;
+  limits.reserve(ranges.size());
+  tracks.reserve(ranges.size());
+  for (std::size_t iTrack = 0; iTrack < ranges.size(); ++iTrack) {
+    TimeRange_t const& range = ranges[iTrack];
+    Value_t const start = (range.start == TimeRange_t::UndefinedTime)
+      ? -Infinity: (range.start - startMargin).value();
+    Value_t const stop = (range.stop == TimeRange_t::UndefinedTime)
+      ? Infinity: (range.stop + stopMargin).value();
+    if (start >= stop) continue; // never contains anything
+    limits.emplace_back(start, stop);
+    tracks.push_back(iTrack);
+  } // for
+
+  std::size_t const nRanges = limits.size();
+  std::vector<std::size_t> order(nRanges);
+  std::iota(order.begin(), order.end(), 0U);
+  std::sort(order.begin(), order.end(),
+    [&limits](std::size_t a, std::size_t b)
+      { return limits[a].first < limits[b].first; }
+    );
+
+  fStarts.reserve(nRanges);
+  fStops.reserve(nRanges);
+  fTracks.reserve(nRanges);
+  for (std::size_t const i: order) {
+    fStarts.push_back(limits[i].first);
+    fStops.push_back(limits[i].second);
+    fTracks.push_back(tracks[i]);
+  }
+
+  fMaxStops.assign(4 * nRanges, -Infinity);
+  if (nRanges > 0) fillTree(1U, 0U, nRanges);
+
+  fByStop.resize(nRanges);
+  std::iota(fByStop.begin(), fByStop.end(), 0U);
+  std::sort(fByStop.begin(), fByStop.end(),
+    [this](std::size_t a, std::size_t b){ return fStops[a] < fStops[b]; });
+
+} // lar::util::TrackTimeRangeIndex::TrackTimeRangeIndex()
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> lar::util::TrackTimeRangeIndex::tracksAt
+  (electronics_time time) const
+{
+  std::vector<std::size_t> tracks;
+  tracksAt(time, tracks);
+  return tracks;
+} // lar::util::TrackTimeRangeIndex::tracksAt()
+
+
+//------------------------------------------------------------------------------
+void lar::util::TrackTimeRangeIndex::tracksAt
+  (electronics_time time, std::vector<std::size_t>& tracks) const
+{
+  if (fStarts.empty()) return;
+
+  Value_t const t = time.value();
+
+  // ranges starting after `time` are excluded
+  std::size_t const limit
+    = std::upper_bound(fStarts.begin(), fStarts.end(), t) - fStarts.begin();
+
+  std::size_t const nOld = tracks.size();
+  collect(1U, 0U, fStarts.size(), limit, t, tracks);
+  std::sort(tracks.begin() + nOld, tracks.end());
+
+} // lar::util::TrackTimeRangeIndex::tracksAt()
+
+
+//------------------------------------------------------------------------------
+void lar::util::TrackTimeRangeIndex::tracksAt(
+  std::vector<electronics_time> const& times,
+  std::vector<std::size_t>& offsets, std::vector<std::size_t>& tracks
+) const {
+
+  std::size_t const nTimes = times.size();
+  std::size_t const nRanges = fStarts.size();
+
+  // times are visited in increasing order
+  std::vector<std::size_t> timeOrder(nTimes);
+  std::iota(timeOrder.begin(), timeOrder.end(), 0U);
+  std::sort(timeOrder.begin(), timeOrder.end(),
+    [&times](std::size_t a, std::size_t b){ return times[a] < times[b]; });
+
+  // sweep: the active ranges are the ones started and not yet stopped;
+  // the result of each time (in sweep order) is collected in `found`
+  constexpr std::size_t NotActive = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> active; // position of the range in `fStarts`
+  std::vector<std::size_t> activeIndex(nRanges, NotActive);
+  std::vector<std::size_t> found;
+  std::vector<std::size_t> foundOffsets(nTimes + 1, 0U);
+  std::size_t nextStart = 0U, nextStop = 0U;
+  for (std::size_t iSorted = 0; iSorted < nTimes; ++iSorted) {
+    Value_t const t = times[timeOrder[iSorted]].value();
+
+    for (; (nextStart < nRanges) && (fStarts[nextStart] <= t); ++nextStart) {
+      activeIndex[nextStart] = active.size();
+      active.push_back(nextStart);
+    }
+    for (; (nextStop < nRanges) && (fStops[fByStop[nextStop]] <= t); ++nextStop)
+    {
+      std::size_t const position = fByStop[nextStop];
+      std::size_t const index = activeIndex[position];
+      if (index == NotActive) continue; // guard: empty ranges are excluded
+      activeIndex[active.back()] = index;
+      active[index] = active.back();
+      active.pop_back();
+      activeIndex[position] = NotActive;
+    } // for stops
+
+    for (std::size_t const position: active)
+      found.push_back(fTracks[position]);
+    std::sort(found.begin() + foundOffsets[iSorted], found.end());
+    foundOffsets[iSorted + 1] = found.size();
+  } // for times
+
+  // rearrangement of the results in the original order of the times
+  offsets.assign(nTimes + 1, 0U);
+  for (std::size_t iSorted = 0; iSorted < nTimes; ++iSorted) {
+    offsets[timeOrder[iSorted] + 1]
+      = foundOffsets[iSorted + 1] - foundOffsets[iSorted];
+  }
+  for (std::size_t i = 0; i < nTimes; ++i) offsets[i + 1] += offsets[i];
+
+  tracks.resize(found.size());
+  for (std::size_t iSorted = 0; iSorted < nTimes; ++iSorted) {
+    std::copy(
+      found.begin() + foundOffsets[iSorted],
+      found.begin() + foundOffsets[iSorted + 1],
+      tracks.begin() + offsets[timeOrder[iSorted]]
+      );
+  }
+
+} // lar::util::TrackTimeRangeIndex::tracksAt()
+
+
+//------------------------------------------------------------------------------
+auto lar::util::TrackTimeRangeIndex::fillTree
+  (std::size_t node, std::size_t begin, std::size_t end) -> Value_t
+{
+  if (end - begin == 1) return fMaxStops[node] = fStops[begin];
+  std::size_t const middle = begin + (end - begin) / 2;
+  return fMaxStops[node] = std::max(
+    fillTree(2 * node, begin, middle), fillTree(2 * node + 1, middle, end)
+    );
+} // lar::util::TrackTimeRangeIndex::fillTree()
+
+
+//------------------------------------------------------------------------------
+void lar::util::TrackTimeRangeIndex::collect(
+  std::size_t node, std::size_t begin, std::size_t end,
+  std::size_t limit, Value_t time, std::vector<std::size_t>& tracks
+) const {
+
+  // skip subtrees starting too late or stopping too early
+  if ((begin >= limit) || (fMaxStops[node] <= time)) return;
+  if (end - begin == 1) {
+    tracks.push_back(fTracks[begin]);
+    return;
+  }
+  std::size_t const middle = begin + (end - begin) / 2;
+  collect(2 * node, begin, middle, limit, time, tracks);
+  collect(2 * node + 1, middle, end, limit, time, tracks);
+
+} // lar::util::TrackTimeRangeIndex::collect()
+
+
+//------------------------------------------------------------------------------
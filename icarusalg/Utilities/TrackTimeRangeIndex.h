@@ -0,0 +1,168 @@
+/**
+ * @file   icarusalg/Utilities/TrackTimeRangeIndex.h
+ * @brief  Index of track time ranges for matching many times at once.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/Utilities/TrackTimeRangeIndex.cxx
+ */
+
+#ifndef ICARUSALG_UTILITIES_TRACKTIMERANGEINDEX_H
+#define ICARUSALG_UTILITIES_TRACKTIMERANGEINDEX_H
+
+
+// ICARUS libraries
+#include "icarusalg/Utilities/TrackTimeInterval.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace lar::util { class TrackTimeRangeIndex; }
+/**
+ * @brief Finds the tracks whose time range is compatible with given times.
+ * @see `lar::util::TrackTimeInterval`
+ *
+ * Matching optical flashes to tracks requires checking each flash time against
+ * the `lar::util::TrackTimeInterval::TimeRange` of each track
+ * (`TimeRange::contains()`), which takes a time proportional to the number of
+ * tracks times the number of flashes.
+ * This index collects the ranges of all the tracks of the event, extended by
+ * the same margins which would be given to `TimeRange::contains()`, and
+ * answers with the same result:
+ * * `tracksAt(time)` returns the tracks compatible with a single time, in a
+ *   time logarithmic in the number of tracks (plus the number of tracks
+ *   found), using the ranges sorted by start and a tree of their largest stop;
+ * * `tracksAt(times, offsets, tracks)` returns the tracks compatible with each
+ *   of the `times` in a single sweep of the sorted times through the sorted
+ *   range boundaries, in a time proportional to
+ *   @f$ (T + F) \log (T + F) @f$ for @f$ T @f$ tracks and @f$ F @f$ times,
+ *   plus the size of the result.
+ *
+ * As in `TimeRange::contains()`, a range with no start (stop) extends
+ * indefinitely back (forward) in time, and an invalid range contains all
+ * times. Tracks are identified by their index in the list of ranges used at
+ * construction, and they are always reported sorted by that index.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * std::vector<lar::util::TrackTimeInterval::TimeRange> const trackRanges
+ *   = chargeTime.timeRangesOfHits(trackHits);
+ * lar::util::TrackTimeRangeIndex const index{ trackRanges, 5_us };
+ *
+ * std::vector<std::size_t> offsets, tracks;
+ * index.tracksAt(flashTimes, offsets, tracks);
+ * for (std::size_t iFlash = 0; iFlash < flashTimes.size(); ++iFlash) {
+ *   for (std::size_t i = offsets[iFlash]; i < offsets[iFlash + 1]; ++i)
+ *     std::cout << " " << tracks[i]; // compatible with flash #iFlash
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class lar::util::TrackTimeRangeIndex {
+
+    public:
+
+  using TimeRange_t = lar::util::TrackTimeInterval::TimeRange;
+  using electronics_time = lar::util::TrackTimeInterval::electronics_time;
+  using microseconds = lar::util::TrackTimeInterval::microseconds;
+
+  /// Type of plain number for times (electronics time scale) [&micro;s].
+  using Value_t = double;
+
+
+  /// Constructor: an empty index.
+  TrackTimeRangeIndex() = default;
+
+  /**
+   * @brief Constructor: indexes all the track `ranges` with the same margin.
+   * @param ranges the time range of each track
+   * @param margin (default: none) extension of each range on both sides
+   * @see `TimeRange::contains(electronics_time, microseconds) const`
+   */
+  explicit TrackTimeRangeIndex
+    (std::vector<TimeRange_t> const& ranges, microseconds margin = 0_us)
+    : TrackTimeRangeIndex{ ranges, margin, margin }
+    {}
+
+  /**
+   * @brief Constructor: indexes all the track `ranges` with margins.
+   * @param ranges the time range of each track
+   * @param startMargin the start of each range is anticipated by this amount
+   * @param stopMargin the stop of each range is delayed by this amount
+   * @see `TimeRange::contains(electronics_time, microseconds, microseconds)`
+   */
+  TrackTimeRangeIndex(
+    std::vector<TimeRange_t> const& ranges,
+    microseconds startMargin, microseconds stopMargin
+    );
+
+
+  /// Returns the number of tracks in the index.
+  std::size_t size() const noexcept { return fNTracks; }
+
+  /// Returns whether there is no track in the index.
+  bool empty() const noexcept { return fNTracks == 0U; }
+
+
+  // --- BEGIN -- Queries ------------------------------------------------------
+  /// @name Queries
+  /// @{
+
+  /// Returns the tracks whose range contains `time`, sorted.
+  std::vector<std::size_t> tracksAt(electronics_time time) const;
+
+  /// Appends to `tracks` the tracks whose range contains `time`, sorted.
+  void tracksAt(electronics_time time, std::vector<std::size_t>& tracks) const;
+
+  /**
+   * @brief Finds the tracks compatible with each of the `times`.
+   * @param times the times to be matched (in any order)
+   * @param[out] offsets the start of the result of each time in `tracks`
+   * @param[out] tracks the indices of compatible tracks, time by time
+   *
+   * The tracks compatible with `times[i]` are the ones in `tracks` from
+   * `offsets[i]` to `offsets[i + 1]` (excluded), sorted; `offsets` has one
+   * more element than `times`. The content of both vectors is replaced, and
+   * their memory reused.
+   */
+  void tracksAt(
+    std::vector<electronics_time> const& times,
+    std::vector<std::size_t>& offsets, std::vector<std::size_t>& tracks
+    ) const;
+
+  /// @}
+  // --- END ---- Queries ------------------------------------------------------
+
+
+    private:
+
+  std::size_t fNTracks = 0U; ///< Number of indexed tracks.
+
+  // --- BEGIN -- Ranges sorted by start ---------------------------------------
+  std::vector<Value_t> fStarts; ///< Sorted range starts (included).
+  std::vector<Value_t> fStops; ///< Stops (excluded), by start.
+  std::vector<std::size_t> fTracks; ///< Track of each range, by start.
+  std::vector<Value_t> fMaxStops; ///< Tree of largest stop in each subrange.
+  // --- END ---- Ranges sorted by start ---------------------------------------
+
+  /// Position (in `fStarts`) of the ranges sorted by stop.
+  std::vector<std::size_t> fByStop;
+
+
+  /// Fills `fMaxStops` for the subrange `[ begin, end [`; returns its maximum.
+  Value_t fillTree(std::size_t node, std::size_t begin, std::size_t end);
+
+  /// Appends to `tracks` ranges in `[ begin, end [` from `limit` and stopping
+  /// after `time`.
+  void collect(
+    std::size_t node, std::size_t begin, std::size_t end,
+    std::size_t limit, Value_t time, std::vector<std::size_t>& tracks
+    ) const;
+
+}; // lar::util::TrackTimeRangeIndex
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_UTILITIES_TRACKTIMERANGEINDEX_H
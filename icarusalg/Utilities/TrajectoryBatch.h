@@ -0,0 +1,442 @@
+/**
+ * @file   icarusalg/Utilities/TrajectoryBatch.h
+ * @brief  Points of many trajectories, stored for batch processing.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_UTILITIES_TRAJECTORYBATCH_H
+#define ICARUSALG_UTILITIES_TRAJECTORYBATCH_H
+
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::fill_n()
+#include <cmath> // std::sqrt()
+#include <cstdint> // std::uint8_t
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::ns::util {
+  class TrajectoryBatch;
+  class BoxSet;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief The points of many trajectories, in flat coordinate arrays.
+ * @see `icarus::ns::util::BoxSet`
+ *
+ * The points of all the trajectories added to this object (e.g. all the
+ * reconstructed tracks or all the simulated particles of an event) are
+ * stored in three arrays, one per coordinate, one trajectory after the
+ * other; trajectory `i` owns the points from `firstPoint(i)` to
+ * `firstPoint(i + 1)`.
+ * Quantities like the length of all the trajectories are then computed
+ * by loops on the whole arrays, which the compiler vectorizes, rather than
+ * point by point through the accessors of each object.
+ *
+ * Points are added a trajectory at a time, from any collection of objects
+ * with `X()`, `Y()` and `Z()` methods (`add(points)`), or from a function
+ * returning the point with a given index (`add(n, pointAt)`), optionally
+ * skipping some of the points (`add(n, pointAt, keep)`).
+ *
+ * Example computing the length of all the tracks in the event:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::TrajectoryBatch batch;
+ * for (recob::Track const& track: tracks) {
+ *   batch.add(track.NumberTrajectoryPoints(),
+ *     [&track](std::size_t i){ return track.LocationAtPoint(i); },
+ *     [&track](std::size_t i){ return track.HasValidPoint(i); }
+ *     );
+ * }
+ * std::vector<double> const lengths = batch.lengths();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The object can be reused for each event after a `clear()`, keeping the
+ * memory already allocated.
+ */
+class icarus::ns::util::TrajectoryBatch {
+
+    public:
+
+  using Coord_t = double; ///< Type of coordinate.
+
+  /// A direction, or any vector.
+  struct Vector_t { Coord_t x = 0.0, y = 0.0, z = 0.0; };
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /// @name Filling
+  /// @{
+
+  /// Removes all the trajectories (memory is not released).
+  void clear();
+
+  /// Prepares memory for `nTrajectories` with a total of `nPoints`.
+  void reserve(std::size_t nTrajectories, std::size_t nPoints);
+
+  /// Adds a trajectory with all the `points` (with `X()`, `Y()`, `Z()`).
+  /// @return the index of the new trajectory
+  template <typename Points>
+  std::size_t add(Points const& points);
+
+  /// Adds a trajectory with the `n` points `pointAt(0)` to `pointAt(n - 1)`.
+  /// @return the index of the new trajectory
+  template <typename PointAt>
+  std::size_t add(std::size_t n, PointAt pointAt)
+    { return add(n, pointAt, [](std::size_t){ return true; }); }
+
+  /// Adds a trajectory with the points `pointAt(i)` for which `keep(i)`.
+  /// @return the index of the new trajectory
+  template <typename PointAt, typename Keep>
+  std::size_t add(std::size_t n, PointAt pointAt, Keep keep);
+
+  /// @}
+  // --- END ---- Filling ------------------------------------------------------
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+
+  /// Returns the number of trajectories.
+  std::size_t size() const noexcept { return fOffsets.size() - 1U; }
+
+  /// Returns whether there is no trajectory.
+  bool empty() const noexcept { return size() == 0U; }
+
+  /// Returns the total number of points of all trajectories.
+  std::size_t nPoints() const noexcept { return fX.size(); }
+
+  /// Returns the number of points of the trajectory `i`.
+  std::size_t nPoints(std::size_t i) const
+    { return fOffsets[i + 1] - fOffsets[i]; }
+
+  /// Returns the index of the first point of trajectory `i` (`i <= size()`).
+  std::size_t firstPoint(std::size_t i) const { return fOffsets[i]; }
+
+  /// Returns the array of the _x_ coordinates of all the points.
+  Coord_t const* x() const noexcept { return fX.data(); }
+
+  /// Returns the array of the _y_ coordinates of all the points.
+  Coord_t const* y() const noexcept { return fY.data(); }
+
+  /// Returns the array of the _z_ coordinates of all the points.
+  Coord_t const* z() const noexcept { return fZ.data(); }
+
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+
+
+  // --- BEGIN -- Batch computations -------------------------------------------
+  /// @name Batch computations
+  /// @{
+
+  /// Computes the length of each trajectory into `lengths` (`size()` of them).
+  void lengths(Coord_t* lengths) const;
+
+  /// Returns the length of each trajectory.
+  std::vector<Coord_t> lengths() const;
+
+  /**
+   * @brief Returns the direction of each trajectory at its start.
+   *
+   * The direction is the one from the first to the second point, normalized;
+   * it is a null vector for trajectories with fewer than two points.
+   */
+  std::vector<Vector_t> startDirections() const;
+
+  /**
+   * @brief Returns a batch with only some of the points.
+   * @param mask for each point, `1` to keep it, `0` to drop it
+   * @return a new batch with the same trajectories, and only the kept points
+   *
+   * The `mask` has `nPoints()` elements, e.g. from `BoxSet::contains()`.
+   * All trajectories are kept, even the ones left with no point.
+   */
+  TrajectoryBatch select(std::uint8_t const* mask) const;
+
+  /// @}
+  // --- END ---- Batch computations -------------------------------------------
+
+
+    private:
+
+  std::vector<Coord_t> fX; ///< The _x_ coordinate of all the points.
+  std::vector<Coord_t> fY; ///< The _y_ coordinate of all the points.
+  std::vector<Coord_t> fZ; ///< The _z_ coordinate of all the points.
+
+  /// Index of the first point of each trajectory, plus the total.
+  std::vector<std::size_t> fOffsets = { 0U };
+
+  /// Adds a point to the current trajectory.
+  void push(Coord_t x, Coord_t y, Coord_t z)
+    { fX.push_back(x); fY.push_back(y); fZ.push_back(z); }
+
+  /// Closes the current trajectory and returns its index.
+  std::size_t closeTrajectory()
+    { fOffsets.push_back(fX.size()); return size() - 1U; }
+
+}; // icarus::ns::util::TrajectoryBatch
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief A list of boxes aligned to the axes, for testing many points.
+ *
+ * The limits of the boxes are copied on construction (e.g. from the active
+ * volume of all the TPCs, which the geometry service would otherwise look up
+ * point by point) and stored in one array per limit. The test of a whole
+ * array of points loops over the boxes, and for each over all the points with
+ * no branching, which the compiler vectorizes.
+ * The boxes include all their border, as in `geo::BoxBoundedGeo`.
+ *
+ * Example selecting the points of all trajectories in the active volume:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::ns::util::BoxSet activeVolumes;
+ * for (geo::TPCGeo const& tpc: geom.Iterate<geo::TPCGeo>())
+ *   activeVolumes.add(tpc.ActiveBoundingBox());
+ *
+ * std::vector<double> const activeLengths
+ *   = batch.select(activeVolumes.contains(batch).data()).lengths();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::ns::util::BoxSet {
+
+    public:
+
+  using Coord_t = TrajectoryBatch::Coord_t; ///< Type of coordinate.
+
+  /// Constructor: no box, no point contained.
+  BoxSet() = default;
+
+  /// Constructor: adds all the `boxes` in the collection.
+  template <typename Boxes>
+  explicit BoxSet(Boxes const& boxes)
+    { for (auto const& box: boxes) add(box); }
+
+  /// Adds a box with the specified limits.
+  void add(
+    Coord_t minX, Coord_t minY, Coord_t minZ,
+    Coord_t maxX, Coord_t maxY, Coord_t maxZ
+    );
+
+  /// Adds a `box` (with `MinX()`, `MaxX()` etc., like `geo::BoxBoundedGeo`).
+  template <typename Box>
+  void add(Box const& box)
+    {
+      add(box.MinX(), box.MinY(), box.MinZ(),
+        box.MaxX(), box.MaxY(), box.MaxZ());
+    }
+
+  /// Returns the number of boxes.
+  std::size_t size() const noexcept { return fMinX.size(); }
+
+  /// Returns whether there is no box.
+  bool empty() const noexcept { return fMinX.empty(); }
+
+  /// Returns whether the point (`x`, `y`, `z`) is in any of the boxes.
+  bool contains(Coord_t x, Coord_t y, Coord_t z) const;
+
+  /**
+   * @brief Tests whether each of `n` points is in any of the boxes.
+   * @param x pointer to the _x_ coordinate of the first point
+   * @param y pointer to the _y_ coordinate of the first point
+   * @param z pointer to the _z_ coordinate of the first point
+   * @param n number of points
+   * @param[out] mask pointer to `n` elements, set to `1` or `0`
+   */
+  void contains(
+    Coord_t const* x, Coord_t const* y, Coord_t const* z,
+    std::size_t n, std::uint8_t* mask
+    ) const;
+
+  /// Returns for each point in `batch` whether it is in any of the boxes.
+  std::vector<std::uint8_t> contains(TrajectoryBatch const& batch) const;
+
+
+    private:
+
+  std::vector<Coord_t> fMinX, fMinY, fMinZ; ///< Lower limits of each box.
+  std::vector<Coord_t> fMaxX, fMaxY, fMaxZ; ///< Upper limits of each box.
+
+}; // icarus::ns::util::BoxSet
+
+
+//------------------------------------------------------------------------------
+//---  Inline implementation
+//------------------------------------------------------------------------------
+inline void icarus::ns::util::TrajectoryBatch::clear() {
+  fX.clear();
+  fY.clear();
+  fZ.clear();
+  fOffsets.resize(1U);
+} // icarus::ns::util::TrajectoryBatch::clear()
+
+
+//------------------------------------------------------------------------------
+inline void icarus::ns::util::TrajectoryBatch::reserve
+  (std::size_t nTrajectories, std::size_t nPoints)
+{
+  fX.reserve(nPoints);
+  fY.reserve(nPoints);
+  fZ.reserve(nPoints);
+  fOffsets.reserve(nTrajectories + 1U);
+} // icarus::ns::util::TrajectoryBatch::reserve()
+
+
+//------------------------------------------------------------------------------
+template <typename Points>
+std::size_t icarus::ns::util::TrajectoryBatch::add(Points const& points) {
+  for (auto const& point: points) push(point.X(), point.Y(), point.Z());
+  return closeTrajectory();
+} // icarus::ns::util::TrajectoryBatch::add(Points)
+
+
+//------------------------------------------------------------------------------
+template <typename PointAt, typename Keep>
+std::size_t icarus::ns::util::TrajectoryBatch::add
+  (std::size_t n, PointAt pointAt, Keep keep)
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!keep(i)) continue;
+    auto const& point = pointAt(i);
+    push(point.X(), point.Y(), point.Z());
+  }
+  return closeTrajectory();
+} // icarus::ns::util::TrajectoryBatch::add(PointAt, Keep)
+
+
+//------------------------------------------------------------------------------
+inline void icarus::ns::util::TrajectoryBatch::lengths(Coord_t* lengths) const
+{
+  std::size_t const n = nPoints();
+
+  // length of all segments, including the ones across two trajectories
+  std::vector<Coord_t> segments(n);
+  for (std::size_t i = 1; i < n; ++i) {
+    Coord_t const dx = fX[i] - fX[i - 1];
+    Coord_t const dy = fY[i] - fY[i - 1];
+    Coord_t const dz = fZ[i] - fZ[i - 1];
+    segments[i] = std::sqrt(dx*dx + dy*dy + dz*dz);
+  } // for points
+
+  // segment `i` ends at point `i`: each trajectory skips its first one
+  for (std::size_t iTraj = 0; iTraj < size(); ++iTraj) {
+    Coord_t length = 0.0;
+    for (std::size_t i = fOffsets[iTraj] + 1; i < fOffsets[iTraj + 1]; ++i)
+      length += segments[i];
+    lengths[iTraj] = length;
+  } // for trajectories
+
+} // icarus::ns::util::TrajectoryBatch::lengths(Coord_t*)
+
+
+//------------------------------------------------------------------------------
+inline auto icarus::ns::util::TrajectoryBatch::lengths() const
+  -> std::vector<Coord_t>
+{
+  std::vector<Coord_t> result(size());
+  lengths(result.data());
+  return result;
+} // icarus::ns::util::TrajectoryBatch::lengths()
+
+
+//------------------------------------------------------------------------------
+inline auto icarus::ns::util::TrajectoryBatch::startDirections() const
+  -> std::vector<Vector_t>
+{
+  std::vector<Vector_t> directions(size());
+  for (std::size_t iTraj = 0; iTraj < size(); ++iTraj) {
+    if (nPoints(iTraj) < 2U) continue;
+    std::size_t const i = fOffsets[iTraj];
+    Vector_t const d
+      { fX[i + 1] - fX[i], fY[i + 1] - fY[i], fZ[i + 1] - fZ[i] };
+    Coord_t const norm = std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z);
+    if (norm > 0.0) directions[iTraj] = { d.x/norm, d.y/norm, d.z/norm };
+  } // for
+  return directions;
+} // icarus::ns::util::TrajectoryBatch::startDirections()
+
+
+//------------------------------------------------------------------------------
+inline auto icarus::ns::util::TrajectoryBatch::select
+  (std::uint8_t const* mask) const -> TrajectoryBatch
+{
+  TrajectoryBatch selected;
+  selected.reserve(size(), nPoints());
+  for (std::size_t iTraj = 0; iTraj < size(); ++iTraj) {
+    for (std::size_t i = fOffsets[iTraj]; i < fOffsets[iTraj + 1]; ++i)
+      if (mask[i]) selected.push(fX[i], fY[i], fZ[i]);
+    selected.closeTrajectory();
+  } // for
+  return selected;
+} // icarus::ns::util::TrajectoryBatch::select()
+
+
+//------------------------------------------------------------------------------
+inline void icarus::ns::util::BoxSet::add(
+  Coord_t minX, Coord_t minY, Coord_t minZ,
+  Coord_t maxX, Coord_t maxY, Coord_t maxZ
+) {
+  fMinX.push_back(minX);
+  fMinY.push_back(minY);
+  fMinZ.push_back(minZ);
+  fMaxX.push_back(maxX);
+  fMaxY.push_back(maxY);
+  fMaxZ.push_back(maxZ);
+} // icarus::ns::util::BoxSet::add()
+
+
+//------------------------------------------------------------------------------
+inline bool icarus::ns::util::BoxSet::contains
+  (Coord_t x, Coord_t y, Coord_t z) const
+{
+  std::uint8_t mask;
+  contains(&x, &y, &z, 1U, &mask);
+  return mask;
+} // icarus::ns::util::BoxSet::contains()
+
+
+//------------------------------------------------------------------------------
+inline void icarus::ns::util::BoxSet::contains(
+  Coord_t const* x, Coord_t const* y, Coord_t const* z,
+  std::size_t n, std::uint8_t* mask
+) const {
+
+  // each box on all points: the inner loop has no branch and vectorizes
+  std::fill_n(mask, n, std::uint8_t{ 0 });
+  for (std::size_t k = 0; k < size(); ++k) {
+    Coord_t const minX = fMinX[k], minY = fMinY[k], minZ = fMinZ[k];
+    Coord_t const maxX = fMaxX[k], maxY = fMaxY[k], maxZ = fMaxZ[k];
+    for (std::size_t i = 0; i < n; ++i) {
+      mask[i] |= static_cast<std::uint8_t>(
+          (x[i] >= minX) & (x[i] <= maxX)
+        & (y[i] >= minY) & (y[i] <= maxY)
+        & (z[i] >= minZ) & (z[i] <= maxZ)
+        );
+    } // for points
+  } // for boxes
+
+} // icarus::ns::util::BoxSet::contains(arrays)
+
+
+//------------------------------------------------------------------------------
+inline std::vector<std::uint8_t> icarus::ns::util::BoxSet::contains
+  (TrajectoryBatch const& batch) const
+{
+  std::vector<std::uint8_t> mask(batch.nPoints());
+  contains(batch.x(), batch.y(), batch.z(), batch.nPoints(), mask.data());
+  return mask;
+} // icarus::ns::util::BoxSet::contains(TrajectoryBatch)
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_UTILITIES_TRAJECTORYBATCH_H
@@ -12,14 +12,19 @@
 
 
 // C/C++ standard library
-#include <type_traits> // std::enable_if_t
+#include <algorithm> // std::find_if(), std::max(), std::min()
+#include <iterator> // std::distance(), std::next()
+#include <type_traits> // std::enable_if_t, std::conditional_t, ...
+#include <cstdint> // std::int64_t
+#include <cstddef> // std::size_t
 
 
 /**
  * @brief Functions to manipulate waveform sample values.
  *
  * This namespace provides trivial functions to manage operations on waveform
- * samples given a certain polarity.
+ * samples given a certain polarity, and functions applying them to a whole
+ * range of contiguous samples at once.
  *
  *
  */
@@ -46,6 +51,39 @@ namespace icarus::waveform_operations {
       { return FlipImpl<Sample, Polarity>::transform(sample); }
 
 
+    // -------------------------------------------------------------------------
+    /// Number of samples tested together by the range searches.
+    inline constexpr std::size_t SearchBlockSize = 32U;
+
+    /**
+     * @brief Returns the first sample in the range satisfying `pred`.
+     * @tparam Sample type of the samples
+     * @tparam Pred type of predicate on a single sample
+     * @param begin pointer to the first sample
+     * @param end pointer past the last sample
+     * @param pred the predicate
+     * @return a pointer to the first sample satisfying `pred`, or `end`
+     *
+     * The samples are tested in blocks of `SearchBlockSize`, all the samples
+     * of a block without any early exit, so that the compiler can vectorize
+     * the test. Only the block with the first match is tested sample by
+     * sample.
+     */
+    template <typename Sample, typename Pred>
+    Sample const* findFirstIf(Sample const* begin, Sample const* end, Pred pred)
+    {
+      Sample const* it = begin;
+      while (static_cast<std::size_t>(end - it) >= SearchBlockSize) {
+        unsigned int matches = 0U;
+        for (std::size_t i = 0; i < SearchBlockSize; ++i)
+          matches |= pred(it[i])? 1U: 0U;
+        if (matches) break;
+        it += SearchBlockSize;
+      } // while
+      return std::find_if(it, end, pred);
+    } // findFirstIf()
+
+
     // -------------------------------------------------------------------------
     /**
      * @brief Operations on a waveform with a fixed baseline.
@@ -63,6 +101,15 @@ namespace icarus::waveform_operations {
      *  * shifts with respect to a baseline
      *  * distance from the baseline
      *  * relative comparisons
+     *  * the same operations on whole ranges of samples (baseline subtraction,
+     *    search of the first sample reaching a threshold, of the maximum and
+     *    minimum, and integral)
+     *
+     * The range operations work on contiguous samples (e.g. the `data()` of a
+     * `std::vector`), given as pointers to the first sample and past the last
+     * one. Their loops are written so that compilers can vectorize them;
+     * they are not explicitly vectorized, and the achieved speed depends on
+     * the compiler and its optimization options.
      *
      */
     template <typename Sample, Sample Transform(Sample)>
@@ -70,6 +117,10 @@ namespace icarus::waveform_operations {
 
       using Sample_t = Sample; ///< Type of ADC samples.
 
+      /// Type of sum of samples (64-bit integers or `double`).
+      using Sum_t = std::conditional_t
+        <std::is_integral_v<Sample_t>, std::int64_t, double>;
+
       // --- BEGIN --- Constructors --------------------------------------------
       /// Constructor: sets the baseline to `0`.
       WaveformTransformedOperations() = default;
@@ -137,6 +188,57 @@ namespace icarus::waveform_operations {
       // --- END --- Comparisons -----------------------------------------------
 
 
+      // --- BEGIN --- Range operations ----------------------------------------
+      /**
+       * @name Operations on a range of samples.
+       *
+       * All these functions act on the contiguous samples from `begin` up to
+       * `end` excluded.
+       */
+      /// @{
+
+      /// Writes into `result` the distance of each sample from `baseline`.
+      /// The `result` buffer may be the same as the input (`begin`).
+      static void subtractBaseline(
+        Sample_t const* begin, Sample_t const* end, Sample_t baseline,
+        Sample_t* result
+        );
+
+      /// Writes into `result` the distance of each sample from the baseline.
+      void subtractBaseline
+        (Sample_t const* begin, Sample_t const* end, Sample_t* result) const
+        { subtractBaseline(begin, end, fBaseline, result); }
+
+      /// Returns a pointer to the first sample reaching `threshold`
+      /// (`noLessThan(sample, threshold)`), `end` if none.
+      static Sample_t const* findFirstReaching
+        (Sample_t const* begin, Sample_t const* end, Sample_t threshold);
+
+      /// Returns a pointer to the first sample reaching `amplitude` from the
+      /// baseline (see `shiftFromBaseline()`), `end` if none.
+      Sample_t const* findFirstReachingAmplitude
+        (Sample_t const* begin, Sample_t const* end, Sample_t amplitude) const
+        { return findFirstReaching(begin, end, shiftFromBaseline(amplitude)); }
+
+      /// Returns a pointer to the first of the largest samples, `end` if none.
+      static Sample_t const* findMax(Sample_t const* begin, Sample_t const* end);
+
+      /// Returns a pointer to the first of the smallest samples, `end` if none.
+      static Sample_t const* findMin(Sample_t const* begin, Sample_t const* end);
+
+      /// Returns the sum of the distances of all samples from `baseline`.
+      /// The transformation is assumed to be linear (like polarity flips).
+      static Sum_t integral
+        (Sample_t const* begin, Sample_t const* end, Sample_t baseline);
+
+      /// Returns the sum of the distances of all samples from the baseline.
+      Sum_t integral(Sample_t const* begin, Sample_t const* end) const
+        { return integral(begin, end, fBaseline); }
+
+      /// @}
+      // --- END --- Range operations ------------------------------------------
+
+
         private:
 
       Sample_t fBaseline { 0 }; ///< Waveform baseline [ADC counts]
@@ -148,6 +250,72 @@ namespace icarus::waveform_operations {
     }; // WaveformTransformedOperations
 
 
+    // -------------------------------------------------------------------------
+    template <typename Sample, Sample Transform(Sample)>
+    void WaveformTransformedOperations<Sample, Transform>::subtractBaseline(
+      Sample_t const* begin, Sample_t const* end, Sample_t baseline,
+      Sample_t* result
+    ) {
+      std::size_t const n = end - begin;
+      for (std::size_t i = 0; i < n; ++i)
+        result[i] = distance(baseline, begin[i]);
+    } // WaveformTransformedOperations<>::subtractBaseline()
+
+
+    // -------------------------------------------------------------------------
+    template <typename Sample, Sample Transform(Sample)>
+    auto WaveformTransformedOperations<Sample, Transform>::findFirstReaching
+      (Sample_t const* begin, Sample_t const* end, Sample_t threshold)
+      -> Sample_t const*
+    {
+      Sample_t const level = transform(threshold);
+      return findFirstIf
+        (begin, end, [level](Sample_t s){ return transform(s) >= level; });
+    } // WaveformTransformedOperations<>::findFirstReaching()
+
+
+    // -------------------------------------------------------------------------
+    template <typename Sample, Sample Transform(Sample)>
+    auto WaveformTransformedOperations<Sample, Transform>::findMax
+      (Sample_t const* begin, Sample_t const* end) -> Sample_t const*
+    {
+      if (begin == end) return end;
+      // first the value (a vectorizable reduction), then its position
+      Sample_t maxValue = transform(*begin);
+      for (Sample_t const* it = begin + 1; it != end; ++it)
+        maxValue = std::max(maxValue, transform(*it));
+      return findFirstIf
+        (begin, end, [maxValue](Sample_t s){ return transform(s) == maxValue; });
+    } // WaveformTransformedOperations<>::findMax()
+
+
+    // -------------------------------------------------------------------------
+    template <typename Sample, Sample Transform(Sample)>
+    auto WaveformTransformedOperations<Sample, Transform>::findMin
+      (Sample_t const* begin, Sample_t const* end) -> Sample_t const*
+    {
+      if (begin == end) return end;
+      Sample_t minValue = transform(*begin);
+      for (Sample_t const* it = begin + 1; it != end; ++it)
+        minValue = std::min(minValue, transform(*it));
+      return findFirstIf
+        (begin, end, [minValue](Sample_t s){ return transform(s) == minValue; });
+    } // WaveformTransformedOperations<>::findMin()
+
+
+    // -------------------------------------------------------------------------
+    template <typename Sample, Sample Transform(Sample)>
+    auto WaveformTransformedOperations<Sample, Transform>::integral
+      (Sample_t const* begin, Sample_t const* end, Sample_t baseline) -> Sum_t
+    {
+      // the transformation is linear: sum first, transform only the result
+      Sum_t sum { 0 };
+      for (Sample_t const* it = begin; it != end; ++it) sum += *it;
+      Sum_t const total = sum - static_cast<Sum_t>(baseline) * (end - begin);
+      return (transform(Sample_t{ 1 }) < Sample_t{ 0 })? -total: total;
+    } // WaveformTransformedOperations<>::integral()
+
+
     // -------------------------------------------------------------------------
 
 
@@ -178,6 +346,95 @@ namespace icarus::waveform_operations {
   using NegativePolarityOperations = Operations<Sample, -1>;
 
 
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Returns the first run of `length` consecutive samples passing
+   *        `pred`.
+   * @tparam Iter type of random access iterator to the samples
+   * @tparam Pred type of predicate on a single sample
+   * @param begin iterator to the first sample
+   * @param end iterator past the last sample
+   * @param length the minimum length of the run
+   * @param pred the predicate all the samples of the run must satisfy
+   * @return an iterator to the first sample of the run, `end` if none
+   *
+   * Any run of `length` samples starting within a window of `length` samples
+   * must include the last sample of that window: when the predicate fails on
+   * that sample, the whole window is skipped at once. Only the samples near
+   * the ones passing the predicate are tested one by one.
+   * In a quiet waveform, only one sample every `length` is tested.
+   *
+   * A `length` of `0` matches at `begin`.
+   */
+  template <typename Iter, typename Pred>
+  Iter findFirstRun(Iter begin, Iter end, std::size_t length, Pred pred) {
+    
+    if (length == 0U) return begin;
+    
+    std::size_t const n = std::distance(begin, end);
+    std::size_t start = 0U; // no run starts before this sample
+    while (start + length <= n) {
+      
+      std::size_t const last = start + length - 1;
+      if (!pred(begin[last])) { start = last + 1; continue; }
+      
+      // extend backward from the last sample of the window...
+      std::size_t first = last;
+      while ((first > start) && pred(begin[first - 1])) --first;
+      
+      // ... and then forward, up to the full length
+      std::size_t const runEnd = first + length;
+      std::size_t next = last + 1;
+      while ((next < runEnd) && (next < n) && pred(begin[next])) ++next;
+      if (next == runEnd) return std::next(begin, first);
+      
+      // sample `next` fails (or is missing) and it's in all runs starting
+      // from `first` to itself
+      start = next + 1;
+      
+    } // while
+    
+    return end;
+  } // findFirstRun()
+
+
+  /**
+   * @brief Returns the first run of samples all above or all below a range.
+   * @tparam Iter type of random access iterator to the samples
+   * @param begin iterator to the first sample
+   * @param end iterator past the last sample
+   * @param lower the lowest value in the range
+   * @param upper the highest value in the range
+   * @param minBelow minimum number of consecutive samples below `lower`
+   * @param minAbove minimum number of consecutive samples above `upper`
+   * @return an iterator to the first sample of the first run, `end` if none
+   * @see `findFirstRun()`
+   *
+   * The range from `lower` to `upper` includes both the limits.
+   * A run is made either by at least `minBelow` samples all below `lower`, or
+   * by at least `minAbove` samples all above `upper`; samples below and samples
+   * above the range do not form a run together.
+   */
+  template <typename Iter>
+  Iter findFirstRunOutside(
+    Iter begin, Iter end,
+    typename std::iterator_traits<Iter>::value_type lower,
+    typename std::iterator_traits<Iter>::value_type upper,
+    std::size_t minBelow, std::size_t minAbove
+  ) {
+    using Sample_t = typename std::iterator_traits<Iter>::value_type;
+    
+    Iter const above = findFirstRun
+      (begin, end, minAbove, [upper](Sample_t s){ return s > upper; });
+    
+    // the two kinds of run can't overlap: a run below the range comes first
+    // only if it is also complete before the run above starts
+    return findFirstRun
+      (begin, above, minBelow, [lower](Sample_t s){ return s < lower; });
+    
+  } // findFirstRunOutside()
+
+
   // ---------------------------------------------------------------------------
 
 
@@ -40,6 +40,38 @@ namespace icarus::ns::util { class mfLoggingClass; }
  * }; // class Algorithm
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * 
+ * 
+ * Logging in loops
+ * -----------------
+ * 
+ * The loggers returned by `mfLogDebug()`, `mfLogTrace()` etc. discard their
+ * output when their severity is disabled, but the arguments streamed into them
+ * are still evaluated, and formatting them may cost much more than the
+ * message facility itself. Where that matters, output can be skipped with
+ * a check of `mfLogDebugEnabled()` (which also covers `mfLogTrace()`),
+ * `mfLogInfoEnabled()` or `mfLogWarningEnabled()`, or with the lazy
+ * versions of the loggers, which are given a callable doing the output:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * for (auto const& waveform: waveforms) {
+ *   mfLogTraceLazy([&waveform](auto& log)
+ *     { log << "Now processing: " << describe(waveform); });
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * For code not deriving from this class, the `ICARUS_LOG_DEBUG()` and
+ * `ICARUS_LOG_TRACE()` macros take a category and evaluate the streamed
+ * arguments only if debug messages are enabled:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * ICARUS_LOG_TRACE(fLogCategory) << "Now processing: " << describe(waveform);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * In all cases, disabled output costs a single check of a message facility
+ * flag.
+ * 
+ * @note The message facility only allows to enable and disable severities
+ *       for whole modules, not for each category: the checks are on the
+ *       severity, and messages of enabled severities are still filtered by
+ *       category by the message facility destinations.
+ * 
  */
 class icarus::ns::util::mfLoggingClass {
   
@@ -51,7 +83,7 @@ class icarus::ns::util::mfLoggingClass {
   mfLoggingClass(std::string const& logCategory): fLogCategory(logCategory) {}
   
   /// Returns the logging category string for this object.
-  std::string logCategory() const { return fLogCategory; }
+  std::string const& logCategory() const { return fLogCategory; }
   
   /// Returns this object (as a logging class object).
   mfLoggingClass const& loggingClass() const { return *this; }
@@ -136,7 +168,71 @@ class icarus::ns::util::mfLoggingClass {
   /// @}
   // --- END -- Access to temporary loggers ------------------------------------
   
+  
+  // --- BEGIN -- Checks and lazy loggers --------------------------------------
+  /**
+   * @name Checks and lazy loggers
+   * 
+   * The checks tell whether the output of the loggers of the corresponding
+   * severity is enabled.
+   * The lazy loggers call `output(log)` with a temporary logger `log` only
+   * when their severity is enabled, so that no output is formatted otherwise:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * mfLogDebugLazy([&](auto& log){ log << "Details: " << details(); });
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  /// @{
+  
+  /// Returns whether `mfLogWarning()` output is enabled.
+  static bool mfLogWarningEnabled() { return mf::isWarningEnabled(); }
+  
+  /// Returns whether `mfLogInfo()` output is enabled.
+  static bool mfLogInfoEnabled() { return mf::isInfoEnabled(); }
+  
+  /// Returns whether `mfLogDebug()` and `mfLogTrace()` output is enabled.
+  static bool mfLogDebugEnabled() { return mf::isDebugEnabled(); }
+  
+  /// Calls `output` with a `mf::LogInfo` stream, if enabled.
+  template <typename Output>
+  void mfLogInfoLazy(Output&& output) const
+    { if (mfLogInfoEnabled()) { auto log = mfLogInfo(); output(log); } }
+  
+  /// Calls `output` with a `mf::LogDebug` stream, if enabled.
+  template <typename Output>
+  void mfLogDebugLazy(Output&& output) const
+    { if (mfLogDebugEnabled()) { auto log = mfLogDebug(); output(log); } }
+  
+  /// Calls `output` with a `mf::LogTrace` stream, if enabled.
+  template <typename Output>
+  void mfLogTraceLazy(Output&& output) const
+    { if (mfLogDebugEnabled()) { auto log = mfLogTrace(); output(log); } }
+  
+  /// @}
+  // --- END -- Checks and lazy loggers ----------------------------------------
+  
 }; // class icarus::ns::util::mfLoggingClass
 
 
+//------------------------------------------------------------------------------
+/**
+ * @brief Streams into a `mf::LogDebug` with the specified `category`, only if
+ *        debug messages are enabled.
+ * 
+ * The streamed arguments are not evaluated when debug messages are disabled.
+ * See `icarus::ns::util::mfLoggingClass` for an example.
+ */
+#define ICARUS_LOG_DEBUG(category) \
+  if (!mf::isDebugEnabled()) {} else mf::LogDebug{ (category) }
+
+/**
+ * @brief Streams into a `mf::LogTrace` with the specified `category`, only if
+ *        debug messages are enabled.
+ * 
+ * The streamed arguments are not evaluated when debug messages are disabled.
+ * See `icarus::ns::util::mfLoggingClass` for an example.
+ */
+#define ICARUS_LOG_TRACE(category) \
+  if (!mf::isDebugEnabled()) {} else mf::LogTrace{ (category) }
+
+
 #endif // ICARUSALG_UTILITIES_MFLOGGINGCLASS_H
@@ -0,0 +1,131 @@
+/**
+ * @file   icarusalg/Utilities/runConcurrently.h
+ * @brief  Runs a list of tasks on a pool of threads.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * 
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSALG_UTILITIES_RUNCONCURRENTLY_H
+#define ICARUSALG_UTILITIES_RUNCONCURRENTLY_H
+
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <atomic>
+#include <exception> // std::exception_ptr, std::current_exception(), ...
+#include <thread>
+#include <type_traits> // std::is_invocable_v
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::ns::util {
+  
+  /**
+   * @brief Calls `task` for each task index from `0` to `nTasks`.
+   * @tparam Task type of the callable running a task
+   * @param nTasks number of tasks to run
+   * @param nThreads maximum number of threads to use (`0`: one per core)
+   * @param task the callable running a task
+   * 
+   * The tasks are run by up to `nThreads` workers, but no more than `nTasks`.
+   * The calling thread is the first worker, and a new thread is started for
+   * each of the others. Each worker repeatedly takes the next task not yet
+   * taken by any other worker, so the order the tasks are run in, and the
+   * worker running each task, are not defined.
+   * 
+   * The task is called as `task(iTask, iWorker)` if it accepts two arguments,
+   * or as `task(iTask)` otherwise; `iWorker` is the index of the worker
+   * running the task, from `0` (the calling thread) to the number of workers
+   * (excluded), and it can be used to give each worker its own resources.
+   * 
+   * If a task throws an exception, its worker stops, while the other workers
+   * still finish all the remaining tasks. When all the workers are done, the
+   * exception from the task with the lowest index is rethrown.
+   * With a single worker, the tasks are run in order in the calling thread,
+   * and an exception stops all of them.
+   * 
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::vector<double> results(inputs.size());
+   * icarus::ns::util::runConcurrently(inputs.size(), 4U,
+   *   [&inputs,&results](std::size_t i){ results[i] = compute(inputs[i]); }
+   *   );
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename Task>
+  void runConcurrently(std::size_t nTasks, unsigned int nThreads, Task&& task);
+  
+} // namespace icarus::ns::util
+
+
+// -----------------------------------------------------------------------------
+// --- Template implementation
+// -----------------------------------------------------------------------------
+template <typename Task>
+void icarus::ns::util::runConcurrently
+  (std::size_t nTasks, unsigned int nThreads, Task&& task)
+{
+  auto const runTask = [&task](std::size_t iTask, unsigned int iWorker)
+    {
+      if constexpr (std::is_invocable_v<Task&, std::size_t, unsigned int>)
+        task(iTask, iWorker);
+      else
+        task(iTask);
+    };
+  
+  if (nThreads == 0U) nThreads = std::thread::hardware_concurrency();
+  unsigned int const nWorkers
+    = static_cast<unsigned int>(std::min<std::size_t>(nThreads, nTasks));
+  if (nWorkers <= 1U) {
+    for (std::size_t iTask = 0; iTask < nTasks; ++iTask) runTask(iTask, 0U);
+    return;
+  }
+  
+  // the failed task of each worker (`nTasks` if none) and its exception
+  struct Failure_t {
+    std::size_t iTask;
+    std::exception_ptr error;
+  };
+  std::vector<Failure_t> failures(nWorkers, Failure_t{ nTasks, nullptr });
+  
+  std::atomic<std::size_t> nextTask { 0U };
+  auto const worker
+    = [&runTask,&nextTask,&failures,nTasks](unsigned int iWorker)
+    {
+      std::size_t iTask;
+      while ((iTask = nextTask++) < nTasks) {
+        try { runTask(iTask, iWorker); }
+        catch (...) {
+          failures[iWorker] = { iTask, std::current_exception() };
+          return;
+        }
+      } // while
+    };
+  
+  // the first worker is this thread
+  std::vector<std::thread> threads;
+  threads.reserve(nWorkers - 1);
+  for (unsigned int iWorker = 1; iWorker < nWorkers; ++iWorker)
+    threads.emplace_back(worker, iWorker);
+  worker(0U);
+  for (std::thread& thread: threads) thread.join();
+  
+  Failure_t const* firstFailure = nullptr;
+  for (Failure_t const& failure: failures) {
+    if (!failure.error) continue;
+    if (!firstFailure || (failure.iTask < firstFailure->iTask))
+      firstFailure = &failure;
+  } // for
+  if (firstFailure) std::rethrow_exception(firstFailure->error);
+  
+} // icarus::ns::util::runConcurrently()
+
+
+// -----------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_UTILITIES_RUNCONCURRENTLY_H
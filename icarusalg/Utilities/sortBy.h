@@ -10,6 +10,8 @@
 #ifndef ICARUSALG_UTILITIES_SORTBY_H
 #define ICARUSALG_UTILITIES_SORTBY_H
 
+// ICARUS libraries
+#include "icarusalg/Utilities/sortLike.h"
 
 // C/C++ standard libraries
 #include <algorithm> // std::transform(), std::sort()
@@ -77,6 +79,93 @@ namespace util {
   template <typename Coll, typename Key, typename Sorter = std::less<void>>
   auto sortCollBy(Coll& coll, Key key, Sorter sorter = {});
   
+  
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Sorts in place the elements of a range by `key`.
+   * @tparam RIter type of random access iterator to objects to be sorted
+   * @tparam Key type of functor extracting the key from an element
+   * @tparam Sorter (default: `std::less`) type of functor comparing two keys
+   * @param begin iterator to the first element of the range to be sorted
+   * @param end iterator after the last element of the range to be sorted
+   * @param key functor extracting the key from an element
+   * @param sorter (default: `std::less{}`) functor comparing two keys
+   * @see `sortCollInPlaceBy()`, `sortLike()`
+   * 
+   * The key of each element is extracted only once and cached, then the
+   * elements are moved in place by `sortLike()` following the order of their
+   * keys. This is convenient when `key` is not trivial, since `std::sort()`
+   * with a comparison of `key(a)` and `key(b)` would evaluate it
+   * _O(N log N)_ times. The sorting is stable.
+   * 
+   * The key type must be default-constructible, and the elements movable.
+   */
+  template <
+    typename RIter, typename Key, typename Sorter = std::less<void>,
+    typename = std::enable_if_t
+      <!std::is_execution_policy_v<std::decay_t<RIter>>>
+    >
+  void sortInPlaceBy(RIter begin, RIter end, Key key, Sorter sorter = {});
+  
+  /**
+   * @brief Sorts in place the elements of a range by `key`.
+   * @tparam ExecPolicy type of execution policy (like `std::execution::par`)
+   * @param policy the execution policy for the key extraction and sorting
+   * @see `sortInPlaceBy(RIter, RIter, Key, Sorter)`
+   * 
+   * The key extraction and the sorting of keys are performed according to
+   * the execution `policy`; `key` and `sorter` must then be safe to call
+   * concurrently.
+   */
+  template <
+    typename ExecPolicy, typename RIter, typename Key,
+    typename Sorter = std::less<void>,
+    typename = std::enable_if_t
+      <std::is_execution_policy_v<std::decay_t<ExecPolicy>>>
+    >
+  void sortInPlaceBy
+    (ExecPolicy&& policy, RIter begin, RIter end, Key key, Sorter sorter = {});
+  
+  
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Sorts in place the elements of `coll` by `key`.
+   * @tparam Coll type of collection of objects to be sorted
+   * @tparam Key type of functor extracting the key from an element
+   * @tparam Sorter (default: `std::less`) type of functor comparing two keys
+   * @param coll collection of objects to be sorted
+   * @param key functor extracting the key from an element
+   * @param sorter (default: `std::less{}`) functor comparing two keys
+   * @see `sortInPlaceBy()`
+   * 
+   * Example sorting wires by their (expensive) distance from a point:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * util::sortCollInPlaceBy(wires,
+   *   [&point](geo::WireGeo const& wire){ return wire.DistanceFrom(point); });
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <
+    typename Coll, typename Key, typename Sorter = std::less<void>,
+    typename = std::enable_if_t
+      <!std::is_execution_policy_v<std::decay_t<Coll>>>
+    >
+  void sortCollInPlaceBy(Coll& coll, Key key, Sorter sorter = {});
+  
+  /**
+   * @brief Sorts in place the elements of `coll` by `key`.
+   * @tparam ExecPolicy type of execution policy (like `std::execution::par`)
+   * @param policy the execution policy for the key extraction and sorting
+   * @see `sortInPlaceBy(ExecPolicy&&, RIter, RIter, Key, Sorter)`
+   */
+  template <
+    typename ExecPolicy, typename Coll, typename Key,
+    typename Sorter = std::less<void>,
+    typename = std::enable_if_t
+      <std::is_execution_policy_v<std::decay_t<ExecPolicy>>>
+    >
+  void sortCollInPlaceBy
+    (ExecPolicy&& policy, Coll& coll, Key key, Sorter sorter = {});
+  
   // ---------------------------------------------------------------------------
   
 } // namespace util
@@ -88,11 +177,17 @@ namespace util {
 // -----------------------------------------------------------------------------
 namespace util::details {
   
-  template <typename Iter>
-  constexpr bool is_random_access_iterator_v = std::is_base_of_v<
-    std::random_access_iterator_tag,
-    typename std::iterator_traits<Iter>::iterator_category
-    >;
+  // `is_random_access_iterator_v` is defined in `sortLike.h`
+  
+  /// Returns the keys of all the elements in the range, in order.
+  template <typename ExecPolicy, typename RIter, typename Key>
+  auto extractKeys(ExecPolicy&& policy, RIter begin, RIter end, Key& key) {
+    using Key_t = std::decay_t<decltype(key(*begin))>;
+    std::vector<Key_t> keys(std::distance(begin, end));
+    std::transform
+      (std::forward<ExecPolicy>(policy), begin, end, keys.begin(), key);
+    return keys;
+  } // extractKeys()
   
 } // namespace util::details
 
@@ -173,6 +268,61 @@ auto util::sortCollBy(Coll& coll, Key key, Sorter sorter /* = {} */) {
 } // util::sortCollBy()
 
 
+//------------------------------------------------------------------------------
+template <
+  typename RIter, typename Key, typename Sorter /* = std::less<void> */,
+  typename /* = enable_if_t<...> */
+  >
+void util::sortInPlaceBy
+  (RIter begin, RIter end, Key key, Sorter sorter /* = {} */)
+{
+  sortInPlaceBy
+    (std::execution::seq, begin, end, std::move(key), std::move(sorter));
+} // util::sortInPlaceBy()
+
+
+//------------------------------------------------------------------------------
+template <
+  typename ExecPolicy, typename RIter, typename Key,
+  typename Sorter /* = std::less<void> */, typename /* = enable_if_t<...> */
+  >
+void util::sortInPlaceBy(
+  ExecPolicy&& policy, RIter begin, RIter end, Key key,
+  Sorter sorter /* = {} */
+) {
+  static_assert(details::is_random_access_iterator_v<RIter>,
+    "sortInPlaceBy() requires random access iterators.");
+  auto const keys = details::extractKeys(policy, begin, end, key);
+  sortLike(std::forward<ExecPolicy>(policy),
+    begin, end, keys.cbegin(), keys.cend(), std::move(sorter));
+} // util::sortInPlaceBy(ExecPolicy)
+
+
+//------------------------------------------------------------------------------
+template <
+  typename Coll, typename Key, typename Sorter /* = std::less<void> */,
+  typename /* = enable_if_t<...> */
+  >
+void util::sortCollInPlaceBy(Coll& coll, Key key, Sorter sorter /* = {} */) {
+  using std::begin, std::end;
+  sortInPlaceBy(begin(coll), end(coll), std::move(key), std::move(sorter));
+} // util::sortCollInPlaceBy()
+
+
+//------------------------------------------------------------------------------
+template <
+  typename ExecPolicy, typename Coll, typename Key,
+  typename Sorter /* = std::less<void> */, typename /* = enable_if_t<...> */
+  >
+void util::sortCollInPlaceBy(
+  ExecPolicy&& policy, Coll& coll, Key key, Sorter sorter /* = {} */
+) {
+  using std::begin, std::end;
+  sortInPlaceBy(std::forward<ExecPolicy>(policy),
+    begin(coll), end(coll), std::move(key), std::move(sorter));
+} // util::sortCollInPlaceBy(ExecPolicy)
+
+
 // -----------------------------------------------------------------------------
 
 
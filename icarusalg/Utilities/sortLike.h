@@ -12,12 +12,16 @@
 
 
 // C/C++ standard libraries
-#include <algorithm> // std::partition()
+#include <algorithm> // std::partition(), std::stable_sort()
+#include <execution> // std::is_execution_policy_v
 #include <functional> // std::less<>
+#include <numeric> // std::iota()
 #include <vector>
 #include <iterator> // std::back_inserter(), std::iterator_traits, ...
-#include <utility> // std::pair<>
+#include <type_traits> // std::enable_if_t, std::is_base_of_v, ...
+#include <utility> // std::pair<>, std::move()
 #include <cassert>
+#include <cstddef> // std::size_t
 
 
 // -----------------------------------------------------------------------------
@@ -63,13 +67,49 @@ namespace util {
    * 
    * In fact, chances are that the requirements are looser, since the algorithm
    * should work also with any forward iterator.
+   * 
+   * When both the data and the key iterators are random access, the sorting
+   * is performed on a permutation of indices, which is then applied to the
+   * data in place, moving each element exactly once (or twice, for the first
+   * element of each permutation cycle). In that case the objects need to be
+   * move-constructible and move-assignable, and the sorting is stable.
+   * Otherwise, the objects are sorted by swapping them, and the sorting is not
+   * stable.
    */
   template <
     typename BIter, typename EIter, typename BKIter, typename EKIter,
-    typename Comp = std::less<void>
+    typename Comp = std::less<void>,
+    typename = std::enable_if_t
+      <!std::is_execution_policy_v<std::decay_t<BIter>>>
     >
   void sortLike
     (BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp = {});
+  
+  /**
+   * @brief Sorts elements on a range according to keys from another range.
+   * @tparam ExecPolicy type of execution policy (like `std::execution::par`)
+   * @param policy the execution policy for the sorting of the keys
+   * @see `sortLike(BIter, EIter, BKIter, EKIter, Comp)`
+   * 
+   * This version sorts the permutation of indices with the specified execution
+   * `policy` (for example, `std::execution::par`), and requires both data and
+   * key iterators to be random access. The permutation is then applied to the
+   * data serially. The sorting is stable.
+   * 
+   * Note that in GCC the parallel policies are implemented with Intel TBB,
+   * and the code using them needs to be linked to its library.
+   */
+  template <
+    typename ExecPolicy,
+    typename BIter, typename EIter, typename BKIter, typename EKIter,
+    typename Comp = std::less<void>,
+    typename = std::enable_if_t
+      <std::is_execution_policy_v<std::decay_t<ExecPolicy>>>
+    >
+  void sortLike(
+    ExecPolicy&& policy,
+    BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp = {}
+    );
 
   
   // ---------------------------------------------------------------------------
@@ -96,9 +136,29 @@ namespace util {
    * should print `ICARUS`.
    * 
    */
-  template <typename DataColl, typename KeyColl, typename Comp = std::less<>>
+  template <
+    typename DataColl, typename KeyColl, typename Comp = std::less<>,
+    typename = std::enable_if_t
+      <!std::is_execution_policy_v<std::decay_t<DataColl>>>
+    >
   void sortCollLike(DataColl& data, KeyColl const& keys, Comp comp = {});
   
+  /**
+   * @brief Sorts `data` elements according to keys from another range.
+   * @tparam ExecPolicy type of execution policy (like `std::execution::par`)
+   * @param policy the execution policy for the sorting of the keys
+   * @see `sortCollLike(DataColl&, KeyColl const&, Comp)`,
+   *      `sortLike(ExecPolicy&&, BIter, EIter, BKIter, EKIter, Comp)`
+   */
+  template <
+    typename ExecPolicy, typename DataColl, typename KeyColl,
+    typename Comp = std::less<>,
+    typename = std::enable_if_t
+      <std::is_execution_policy_v<std::decay_t<ExecPolicy>>>
+    >
+  void sortCollLike
+    (ExecPolicy&& policy, DataColl& data, KeyColl const& keys, Comp comp = {});
+  
   // ---------------------------------------------------------------------------
   
 } // namespace util
@@ -156,18 +216,117 @@ namespace util::details {
     unoptimisedQuickSort(begin, middle1, comp);
     unoptimisedQuickSort(middle2, end, comp);
   } // unoptimisedQuickSort()
-
+  
+  
+  template <typename Iter>
+  constexpr bool is_random_access_iterator_v = std::is_base_of_v<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<Iter>::iterator_category
+    >;
+  
+  
+  /// Sorts the data by swapping elements (any forward iterator; not stable).
+  template <
+    typename BIter, typename EIter, typename BKIter, typename EKIter,
+    typename Comp
+    >
+  void sortLikeBySwapping
+    (BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp);
+  
+  
+  /**
+   * @brief Moves the elements from `data` so that `data[i]` becomes
+   *        `data[index(i)]`.
+   * @param data random access iterator to the first element to be permuted
+   * @param n number of elements to be permuted
+   * @param index functor returning a (mutable) reference to the `i`-th index
+   *              of the permutation; the permutation is left as identity
+   * 
+   * The permutation is decomposed in cycles, and each cycle is applied by
+   * moving each element directly to its final position, using a single
+   * temporary object per cycle.
+   */
+  template <typename RIter, typename Index>
+  void applyPermutation(RIter data, std::size_t n, Index&& index) {
+    using Value_t = typename std::iterator_traits<RIter>::value_type;
+    for (std::size_t start = 0; start < n; ++start) {
+      if (index(start) == start) continue; // in place, or cycle already done
+      Value_t tmp = std::move(data[start]);
+      std::size_t dest = start;
+      for (std::size_t src = index(dest); src != start; src = index(dest)) {
+        data[dest] = std::move(data[src]);
+        index(dest) = dest;
+        dest = src;
+      }
+      data[dest] = std::move(tmp);
+      index(dest) = dest;
+    } // for
+  } // applyPermutation()
+  
+  
+  /**
+   * @brief Sorts data via a permutation of indices sorted with `policy`.
+   * 
+   * Small, trivially copyable keys (like numbers) are copied next to their
+   * index before sorting, so that the comparisons do not need to reach for the
+   * key collection at random. Other keys are accessed through their index.
+   * Either way the sorting is stable.
+   */
+  template <
+    typename ExecPolicy, typename RIter, typename RKIter, typename Comp
+    >
+  void sortLikeByPermutation(
+    ExecPolicy&& policy,
+    RIter begin, RIter end, RKIter key_begin, RKIter key_end, Comp comp
+  ) {
+    using Key_t = typename std::iterator_traits<RKIter>::value_type;
+    
+    std::size_t const n = std::distance(key_begin, key_end);
+    assert(std::distance(begin, end) == static_cast<std::ptrdiff_t>(n));
+    
+    if constexpr(
+      std::is_trivially_copyable_v<Key_t> && (sizeof(Key_t) <= sizeof(double))
+    ) {
+      using KeyIndex_t = std::pair<Key_t, std::size_t>;
+      std::vector<KeyIndex_t> keyIndex;
+      keyIndex.reserve(n);
+      for (std::size_t i = 0; i < n; ++i)
+        keyIndex.emplace_back(key_begin[i], i);
+      std::stable_sort(
+        std::forward<ExecPolicy>(policy), keyIndex.begin(), keyIndex.end(),
+        [&comp](KeyIndex_t const& a, KeyIndex_t const& b)
+          { return comp(a.first, b.first); }
+        );
+      applyPermutation(begin, n,
+        [&keyIndex](std::size_t i) -> std::size_t&
+          { return keyIndex[i].second; }
+        );
+    }
+    else {
+      std::vector<std::size_t> perm(n);
+      std::iota(perm.begin(), perm.end(), std::size_t{ 0 });
+      std::stable_sort(
+        std::forward<ExecPolicy>(policy), perm.begin(), perm.end(),
+        [key_begin,&comp](std::size_t a, std::size_t b)
+          { return comp(key_begin[a], key_begin[b]); }
+        );
+      applyPermutation(begin, n,
+        [&perm](std::size_t i) -> std::size_t& { return perm[i]; });
+    }
+  } // sortLikeByPermutation()
+  
+  
 } // namespace util::details
 
 
 // -----------------------------------------------------------------------------
 template <
   typename BIter, typename EIter, typename BKIter, typename EKIter,
-  typename Comp /* = std::less<void> */
+  typename Comp
   >
-void util::sortLike(
-  BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp /* = {} */
-) {
+void util::details::sortLikeBySwapping
+  (BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp)
+{
 #if 1
   
   /*
@@ -227,12 +386,58 @@ void util::sortLike(
   
 #endif // 0
   
+} // util::details::sortLikeBySwapping()
+
+
+// -----------------------------------------------------------------------------
+template <
+  typename BIter, typename EIter, typename BKIter, typename EKIter,
+  typename Comp /* = std::less<void> */, typename /* = enable_if_t<...> */
+  >
+void util::sortLike(
+  BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp /* = {} */
+) {
+  if constexpr(
+    std::is_same_v<BIter, EIter> && std::is_same_v<BKIter, EKIter>
+    && details::is_random_access_iterator_v<BIter>
+    && details::is_random_access_iterator_v<BKIter>
+  ) {
+    details::sortLikeByPermutation(std::execution::seq,
+      begin, end, key_begin, key_end, std::move(comp));
+  }
+  else {
+    details::sortLikeBySwapping
+      (begin, end, key_begin, key_end, std::move(comp));
+  }
 } // util::sortLike()
 
 
 // -----------------------------------------------------------------------------
-template
-  <typename DataColl, typename KeyColl, typename Comp /* = std::less<> */>
+template <
+  typename ExecPolicy,
+  typename BIter, typename EIter, typename BKIter, typename EKIter,
+  typename Comp /* = std::less<void> */, typename /* = enable_if_t<...> */
+  >
+void util::sortLike(
+  ExecPolicy&& policy,
+  BIter begin, EIter end, BKIter key_begin, EKIter key_end, Comp comp /* = {} */
+) {
+  static_assert(std::is_same_v<BIter, EIter> && std::is_same_v<BKIter, EKIter>,
+    "sortLike() with execution policy requires iterators of the same type.");
+  static_assert(details::is_random_access_iterator_v<BIter>,
+    "sortLike() with execution policy requires random access data iterators.");
+  static_assert(details::is_random_access_iterator_v<BKIter>,
+    "sortLike() with execution policy requires random access key iterators.");
+  details::sortLikeByPermutation(std::forward<ExecPolicy>(policy),
+    begin, end, key_begin, key_end, std::move(comp));
+} // util::sortLike(ExecPolicy)
+
+
+// -----------------------------------------------------------------------------
+template <
+  typename DataColl, typename KeyColl, typename Comp /* = std::less<> */,
+  typename /* = enable_if_t<...> */
+  >
 void util::sortCollLike
   (DataColl& data, KeyColl const& keys, Comp comp /* = {} */)
 {
@@ -241,6 +446,21 @@ void util::sortCollLike
 } // util::sortCollLike()
 
 
+// -----------------------------------------------------------------------------
+template <
+  typename ExecPolicy, typename DataColl, typename KeyColl,
+  typename Comp /* = std::less<> */, typename /* = enable_if_t<...> */
+  >
+void util::sortCollLike(
+  ExecPolicy&& policy, DataColl& data, KeyColl const& keys,
+  Comp comp /* = {} */
+) {
+  using std::begin, std::end;
+  sortLike(std::forward<ExecPolicy>(policy),
+    begin(data), end(data), begin(keys), end(keys), std::move(comp));
+} // util::sortCollLike(ExecPolicy)
+
+
 // -----------------------------------------------------------------------------
 
 
@@ -13,10 +13,13 @@
 #include "nusimdata/SimulationBase/MCTruth.h"
 #include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
 #include "lardataobj/RecoBase/Hit.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 // nutools
 #include "icarusalg/gallery/MCTruthBase/MCTruthEmEveIdCalculator.h"
+#include "icarusalg/Utilities/Instrumentation.h" // ICARUS_SCOPED_TIMER()
 
 // canvas libraries
 #include "canvas/Persistency/Common/FindMany.h"
@@ -25,7 +28,9 @@
 #include "TVector3.h"
 
 // C/C++ standard libraries
-#include <algorithm> // std::count_if()
+#include <algorithm> // std::sort(), std::equal_range(), std::binary_search()...
+#include <iterator> // std::prev()
+#include <utility> // std::move()
 
 namespace truth
 {
@@ -33,6 +38,7 @@ namespace truth
 MCTruthAssociations::MCTruthAssociations(const fhicl::ParameterSet& config)
 {
     fMinHitEnergyFraction = config.get<float>("MinHitEnergyFraction", 0.);
+    fEveIdThreads         = config.get<unsigned int>("EveIdThreads", 1);
 }
 
 void MCTruthAssociations::setup(const HitParticleAssociationsVec&  partToHitAssnsVec,
@@ -40,36 +46,37 @@ void MCTruthAssociations::setup(const HitParticleAssociationsVec&  partToHitAssn
                                 const MCTruthAssns&                truthToPartAssns,
                                 const geo::GeometryCore&           geometry)
 {
+    // the MCTruth of each particle, by particle key
+    MCTruthTruthVec particleTruths;
+    particleTruths.reserve(truthToPartAssns.size());
+    for(std::size_t iPart = 0; iPart < truthToPartAssns.size(); ++iPart)
+        particleTruths.push_back(truthToPartAssns.at(iPart));
+    
+    setup(partToHitAssnsVec, mcPartVec, particleTruths, geometry);
+}
+
+void MCTruthAssociations::setup(const HitParticleAssociationsVec&  partToHitAssnsVec,
+                                const MCParticleVec&               mcPartVec,
+                                const MCTruthTruthVec&             particleTruths,
+                                const geo::GeometryCore&           geometry)
+{
+    ICARUS_SCOPED_TIMER("MCTruthAssociations::setup");
+    
     // Keep track of input services
     fGeometry           = &geometry;
     
-    fHitPartAssnsVec.clear();
+    // Reuse the tables of the previous event (and their memory) where possible
+    fHitPartAssnsVec.resize(partToHitAssnsVec.size());
     
     // Loop through the input vector of associations
-    for(const HitParticleAssociations* partToHitAssns : partToHitAssnsVec)
+    for(std::size_t iAssns = 0; iAssns < partToHitAssnsVec.size(); ++iAssns)
     {
-        // Note that one element of our struct is non copiable which means
-        // we need to construct in place before filling
-        fHitPartAssnsVec.emplace_back();
-    
-        HitPartAssnsStruct& hitPartAssns = fHitPartAssnsVec.back();
+        MCTruthHitParticleTable& hitPartAssns = fHitPartAssnsVec[iAssns];
     
-        // Clear the maps in case they were previously filled
-        hitPartAssns.fHitToPartVecMap.clear();
-        hitPartAssns.fPartToHitVecMap.clear();
-    
-        // Build out the maps between hits/particles
-        for(HitParticleAssociations::const_iterator partHitItr = partToHitAssns->begin(); partHitItr != partToHitAssns->end(); ++partHitItr)
-        {
-            const art::Ptr<simb::MCParticle>&       mcParticle = partHitItr->first;
-            const art::Ptr<recob::Hit>&             recoHit    = partHitItr->second;
-            const anab::BackTrackerHitMatchingData* data       = partHitItr->data;
+        // Build out the tables between hits/particles
+        hitPartAssns.fill(*partToHitAssnsVec[iAssns]);
         
-            hitPartAssns.fHitToPartVecMap[recoHit.get()].insert(PartMatchDataPair(mcParticle.get(),data));
-            hitPartAssns.fPartToHitVecMap[mcParticle.get()].insert(HitMatchDataPair(recoHit.get(),data));
-        }
-        
-        mf::LogDebug("MCTruthAssociations") << "Built maps with " << hitPartAssns.fHitToPartVecMap.size() << " hits, " << hitPartAssns.fPartToHitVecMap.size() << "\n";
+        mf::LogDebug("MCTruthAssociations") << "Built maps with " << hitPartAssns.nHits() << " hits, " << hitPartAssns.nParticles() << "\n";
     }
     
     // Note that there is only one instance of MCTruth <--> MCParticle associations so we do this external to the above loop
@@ -81,26 +88,57 @@ void MCTruthAssociations::setup(const HitParticleAssociationsVec&  partToHitAssn
     {
         fParticleList.Add(mcParticle.get());
         
-        try
-        {
-            art::Ptr<simb::MCTruth> mcTruth = truthToPartAssns.at(mcParticle.key());
-            
-            // Add to the list
-            if (std::find(fMCTruthVec.begin(),fMCTruthVec.end(),mcTruth) == fMCTruthVec.end())
-                fMCTruthVec.push_back(mcTruth);
-            
-            fTrackIDToMCTruthIndex[mcParticle->TrackId()] = mcTruth;
-        }
-        catch(...)
+        if (mcParticle.key() >= particleTruths.size())
         {
             mf::LogDebug("MCTruthAssociations") << ">>>> No MCTruth found for particle: " << *mcParticle << "\n";
+            continue;
         }
+        
+        const art::Ptr<simb::MCTruth>& mcTruth = particleTruths[mcParticle.key()];
+        
+        // Add to the list
+        if (std::find(fMCTruthVec.begin(),fMCTruthVec.end(),mcTruth) == fMCTruthVec.end())
+            fMCTruthVec.push_back(mcTruth);
+        
+        fTrackIDToMCTruthIndex.emplace_back(mcParticle->TrackId(), mcTruth);
     }
 
+    // Sort the track IDs for lookup; if a track ID is repeated, the last particle wins
+    std::stable_sort(fTrackIDToMCTruthIndex.begin(), fTrackIDToMCTruthIndex.end(),
+                     [](const auto& a, const auto& b){ return a.first < b.first; });
+    auto trackTruthOut = fTrackIDToMCTruthIndex.begin();
+    for(auto trackTruthItr = fTrackIDToMCTruthIndex.begin(); trackTruthItr != fTrackIDToMCTruthIndex.end(); ++trackTruthItr)
+    {
+        if (trackTruthOut != fTrackIDToMCTruthIndex.begin() && std::prev(trackTruthOut)->first == trackTruthItr->first)
+            *std::prev(trackTruthOut) = std::move(*trackTruthItr);
+        else
+            *trackTruthOut++ = std::move(*trackTruthItr);
+    }
+    fTrackIDToMCTruthIndex.erase(trackTruthOut, fTrackIDToMCTruthIndex.end());
+
+    // All particles are in: lookups by track ID from now on go through a flat table
+    fParticleList.BuildLookupTable();
+
     // Follow former backtracker convention of resetting the eve id calculator each event...
     // Note that the calculator is stored as a unique_ptr (mutable) so memory ok
     fParticleList.AdoptEveIdCalculator(new MCTruthEmEveIdCalculator);
 
+    // All the eve IDs are computed once now, and just looked up later
+    fParticleList.ComputeAllEveIds(fEveIdThreads);
+
+    // Memory bookkeeping
+    std::size_t eventBytes = fParticleList.MemoryUsage()
+                           + fHitPartAssnsVec.capacity() * sizeof(HitPartAssnsList::value_type)
+                           + fMCTruthVec.capacity() * sizeof(MCTruthTruthVec::value_type)
+                           + fTrackIDToMCTruthIndex.capacity() * sizeof(MCTruthTrackIDMap::value_type);
+    for(const auto& hitPartAssns : fHitPartAssnsVec) eventBytes += hitPartAssns.memoryUsage();
+
+    ++fMemoryStats.nEvents;
+    fMemoryStats.eventBytes = eventBytes;
+    fMemoryStats.peakBytes  = std::max(fMemoryStats.peakBytes, eventBytes);
+
+    mf::LogDebug("MCTruthAssociations") << "Memory used for this event: " << eventBytes << " bytes (peak: " << fMemoryStats.peakBytes << ")\n";
+
     return;
 }
     
@@ -109,15 +147,16 @@ const MCTruthParticleList& MCTruthAssociations::getParticleList() const
     return fParticleList;
 }
 
+const MCTruthMemoryStats& MCTruthAssociations::getMemoryStats() const
+{
+    return fMemoryStats;
+}
+
 // Return a pointer to the simb::MCParticle object corresponding to the given TrackID
 const simb::MCParticle* MCTruthAssociations::TrackIDToParticle(int const& id) const
 {
     // Pointer to return
-    const simb::MCParticle* mcParticle(0);
-    
-    MCTruthParticleList::const_iterator partItr = fParticleList.find(id);
-    
-    if (partItr != fParticleList.end()) mcParticle = partItr->second;
+    const simb::MCParticle* mcParticle = fParticleList.FindParticle(id);
     
     if(!mcParticle)
     {
@@ -140,9 +179,11 @@ const simb::MCParticle* MCTruthAssociations::TrackIDToMotherParticle(int const&
 const art::Ptr<simb::MCTruth>& MCTruthAssociations::TrackIDToMCTruth(int const& id) const
 {
     // find the entry in the MCTruth collection for this track id
-    MCTruthTrackIDMap::const_iterator trackTruthItr = fTrackIDToMCTruthIndex.find(abs(id));
+    MCTruthTrackIDMap::const_iterator trackTruthItr
+        = std::lower_bound(fTrackIDToMCTruthIndex.begin(), fTrackIDToMCTruthIndex.end(), abs(id),
+                           [](const auto& entry, int trackID){ return entry.first < trackID; });
     
-    if (trackTruthItr == fTrackIDToMCTruthIndex.end())
+    if (trackTruthItr == fTrackIDToMCTruthIndex.end() || trackTruthItr->first != abs(id))
         throw cet::exception("MCTruthAssociations") << "attempting to find MCTruth index for "
         << "out of range value: " << id
         << "/" << fMCTruthVec.size() << "\n";
@@ -175,48 +216,63 @@ const MCTruthTruthVec& MCTruthAssociations::MCTruthVector() const
     return fMCTruthVec;
 }
     
+// converts the particles matched to a hit into TrackIDEs
+std::vector<TrackIDE> MCTruthAssociations::toTrackIDEs(MCTruthHitParticleTable::PartMatchRange matches)
+{
+    std::vector<TrackIDE> trackIDEs;
+    
+    trackIDEs.reserve(matches.size());
+    
+    for (const auto& match : matches)
+    {
+        const simb::MCParticle*                 part = match.particle;
+        const anab::BackTrackerHitMatchingData* data = match.data;
+        
+        TrackIDE trackIDE;
+        
+        trackIDE.trackID      = part->TrackId();
+        trackIDE.energyFrac   = data->ideFraction;
+        trackIDE.energy       = data->energy;
+        trackIDE.numElectrons = data->numElectrons;
+        
+        trackIDEs.emplace_back(trackIDE);
+    }
+    
+    return trackIDEs;
+}
+    
 // this method will return the Geant4 track IDs of
 // the particles contributing ionization electrons to the identified hit
 std::vector<TrackIDE> MCTruthAssociations::HitToTrackID(const recob::Hit* hit) const
 {
-    std::vector<TrackIDE> trackIDEs;
-    
-    // Apply brute force loop through all possible collections
+    // Loop through all possible collections, the first one with the hit wins
     for(const auto& hitPartAssns : fHitPartAssnsVec)
     {
-        HitToPartVecMap::const_iterator hitMatchPairItr = hitPartAssns.fHitToPartVecMap.find(hit);
+        MCTruthHitParticleTable::PartMatchRange const matches = hitPartAssns.particlesOf(hit);
     
-        if (hitMatchPairItr != hitPartAssns.fHitToPartVecMap.end())
-        {
-            size_t nTrackIDEs(hitMatchPairItr->second.size());
-            
-            trackIDEs.reserve(nTrackIDEs);
-                              
-            for (const auto& matchPair : hitMatchPairItr->second)
-            {
-                const simb::MCParticle*                 part = matchPair.first;
-                const anab::BackTrackerHitMatchingData* data = matchPair.second;
-                
-                TrackIDE trackIDE;
-                
-                trackIDE.trackID      = part->TrackId();
-                trackIDE.energyFrac   = data->ideFraction;
-                trackIDE.energy       = data->energy;
-                trackIDE.numElectrons = data->numElectrons;
-                
-                trackIDEs.emplace_back(trackIDE);
-            }
-            
-            break;
-        }
+        if (!matches.empty()) return toTrackIDEs(matches);
     }
     
-    return trackIDEs;
+    return {};
 }
     
 std::vector<TrackIDE> MCTruthAssociations::HitToTrackID(const art::Ptr<recob::Hit>& hit) const
 {
-    return HitToTrackID(hit.get());
+    // same as above, but the tables can be looked up by hit key
+    return toTrackIDEs(hitMatches(hit));
+}
+
+MCTruthHitParticleTable::PartMatchRange MCTruthAssociations::hitMatches(const art::Ptr<recob::Hit>& hit) const
+{
+    // the first collection with the hit wins
+    for(const auto& hitPartAssns : fHitPartAssnsVec)
+    {
+        MCTruthHitParticleTable::PartMatchRange const matches = hitPartAssns.particlesOf(hit);
+        
+        if (!matches.empty()) return matches;
+    }
+    
+    return {};
 }
 
 //----------------------------------------------------------------------
@@ -226,30 +282,35 @@ const std::vector<std::vector<art::Ptr<recob::Hit>>> MCTruthAssociations::TrackI
     // returns a subset of the hits in the allhits collection that are matched
     // to MC particles listed in tkIDs
     
-    // temporary vector of TrackIDs and Ptrs to hits so only one
-    // loop through the (possibly large) allhits collection is needed
-    std::unordered_map<int, std::vector<art::Ptr<recob::Hit>>> trackIDHitVecMap;
+    // sorted copy of the requested track IDs (a duplicate ID duplicates its
+    // matched hits), and the hits matched to each of them, so
+    // only one loop through the (possibly large) allhits collection is needed
+    std::vector<int> sortedIDs(tkIDs);
+    std::sort(sortedIDs.begin(), sortedIDs.end());
+    
+    std::vector<std::vector<art::Ptr<recob::Hit>>> trackIDHitVec(sortedIDs.size());
     
     for(const auto& hit : allHits)
     {
-        std::vector<TrackIDE> trackIDEVec = this->HitToTrackID(hit.get());
-        
-        for(const auto trackIDE : trackIDEVec)
+        for(const auto& match : hitMatches(hit))
         {
-            for(auto trackID : tkIDs)
-            {
-                if(trackID == trackIDE.trackID && trackIDE.energyFrac > fMinHitEnergyFraction)
-                {
-                    trackIDHitVecMap[trackID].push_back(hit);
-                }
-            }
+            if (!(match.data->ideFraction > fMinHitEnergyFraction)) continue;
+            
+            auto const [ first, last ] = std::equal_range(sortedIDs.begin(), sortedIDs.end(), match.particle->TrackId());
+            
+            // the hits of each track ID are collected in the entry of its first copy
+            for(auto iID = first; iID != last; ++iID) trackIDHitVec[first - sortedIDs.begin()].push_back(hit);
         }
     }
     
-    // now build the truHits vector that will be returned to the caller
+    // now build the truHits vector that will be returned to the caller,
+    // sorted by track ID
     std::vector<std::vector<art::Ptr<recob::Hit>>> truHits;
     
-    for(const auto& trackHitPair : trackIDHitVecMap) truHits.emplace_back(trackHitPair.second);
+    for(auto& trackHits : trackIDHitVec)
+    {
+        if (!trackHits.empty()) truHits.push_back(std::move(trackHits));
+    }
     
     return truHits;
 }
@@ -260,7 +321,7 @@ const std::vector<std::vector<art::Ptr<recob::Hit>>> MCTruthAssociations::TrackI
 // the one you always want to use
 std::vector<TrackIDE> MCTruthAssociations::HitToEveID(const art::Ptr<recob::Hit>& hit) const
 {
-    std::vector<TrackIDE> trackIDEVec = this->HitToTrackID(hit.get());
+    std::vector<TrackIDE> trackIDEVec = this->HitToTrackID(hit);
     
     // Need the particle list, want the "biggest" one to make sure we have all the particles
     const MCTruthParticleList& particleList = getParticleList();
@@ -290,15 +351,117 @@ std::vector<TrackIDE> MCTruthAssociations::HitToEveID(const art::Ptr<recob::Hit>
 // method to return the XYZ position of the weighted average energy deposition for a given hit
 std::vector<double> MCTruthAssociations::HitToXYZ(art::Ptr<recob::Hit> const& hit) const
 {
-    mf::LogWarning("MCTruthAssociations") << " ** HitToXYZ currently not implemented in MCTruthAssociations, return a zero point";
-    return std::vector<double>() = {0.,0.,0.};
+    std::vector<double> xyz(3, 0.); // a zero point unless reconstructed
+    hitXYZ(hit, xyz.data());
+    return xyz;
 }
 
 // method to return the XYZ position of a space point (unweighted average XYZ of component hits).
 std::vector<double> MCTruthAssociations::SpacePointHitsToXYZ(art::PtrVector<recob::Hit> const& hits) const
 {
-    mf::LogWarning("MCTruthAssociations") << " ** SpacePointHitsToXYZ currently not implemented in MCTruthAssociations, return a zero point";
-    return std::vector<double>() = {0.,0.,0.};
+    double sum[3] = { 0., 0., 0. };
+    unsigned int nMatched = 0;
+    for(const auto& hit : hits)
+    {
+        double xyz[3];
+        if (!hitXYZ(hit, xyz)) continue;
+        for(unsigned int i = 0; i < 3; ++i) sum[i] += xyz[i];
+        ++nMatched;
+    }
+    
+    if (nMatched == 0) return std::vector<double>(3, 0.);
+    return { sum[0] / nMatched, sum[1] / nMatched, sum[2] / nMatched };
+}
+
+// method to return the XYZ position of many hits at once
+void MCTruthAssociations::HitsToXYZ(const std::vector< art::Ptr<recob::Hit> >& hits,
+                                    std::size_t                                begin,
+                                    std::size_t                                end,
+                                    TruthXYZArrays&                            xyz) const
+{
+    xyz.resize(end - begin);
+    
+    for(std::size_t iHit = begin; iHit < end; ++iHit)
+    {
+        std::size_t const i = iHit - begin;
+        double point[3];
+        bool const matched = hitXYZ(hits[iHit], point);
+        xyz.matched[i] = matched;
+        xyz.x[i] = matched? point[0]: 0.;
+        xyz.y[i] = matched? point[1]: 0.;
+        xyz.z[i] = matched? point[2]: 0.;
+    }
+}
+
+// method to return the XYZ position of many space points at once
+void MCTruthAssociations::SpacePointsHitsToXYZ(const std::vector< art::Ptr<recob::Hit> >& hits,
+                                               const std::vector<std::size_t>&            offsets,
+                                               TruthXYZArrays&                            xyz) const
+{
+    std::size_t const nPoints = offsets.empty()? 0: offsets.size() - 1;
+    xyz.resize(nPoints);
+    
+    for(std::size_t iPoint = 0; iPoint < nPoints; ++iPoint)
+    {
+        double sum[3] = { 0., 0., 0. };
+        unsigned int nMatched = 0;
+        for(std::size_t iHit = offsets[iPoint]; iHit < offsets[iPoint + 1]; ++iHit)
+        {
+            double point[3];
+            if (!hitXYZ(hits[iHit], point)) continue;
+            for(unsigned int i = 0; i < 3; ++i) sum[i] += point[i];
+            ++nMatched;
+        }
+        
+        xyz.matched[iPoint] = (nMatched > 0);
+        xyz.x[iPoint] = (nMatched > 0)? sum[0] / nMatched: 0.;
+        xyz.y[iPoint] = (nMatched > 0)? sum[1] / nMatched: 0.;
+        xyz.z[iPoint] = (nMatched > 0)? sum[2] / nMatched: 0.;
+    }
+}
+
+// computes the truth position of a single hit
+bool MCTruthAssociations::hitXYZ(const art::Ptr<recob::Hit>& hit, double xyz[3]) const
+{
+    MCTruthHitParticleTable::PartMatchRange const matches = hitMatches(hit);
+    if (matches.empty() || !fGeometry) return false;
+    
+    geo::WireID const& wireID = hit->WireID();
+    geo::PlaneGeo const& plane = fGeometry->Plane(wireID);
+    geo::TPCGeo const& tpc = fGeometry->TPC(wireID);
+    double const wire = wireID.Wire;
+    
+    double sum[3] = { 0., 0., 0. };
+    double sumWeights = 0.;
+    for(const auto& match : matches)
+    {
+        const simb::MCParticle& particle = *match.particle;
+        
+        // the first trajectory segment in the TPC which crosses the wire of the hit
+        unsigned int const nPoints = particle.NumberTrajectoryPoints();
+        for(unsigned int iPoint = 1; iPoint < nPoints; ++iPoint)
+        {
+            geo::Point_t const start { particle.Vx(iPoint - 1), particle.Vy(iPoint - 1), particle.Vz(iPoint - 1) };
+            geo::Point_t const stop  { particle.Vx(iPoint),     particle.Vy(iPoint),     particle.Vz(iPoint)     };
+            double const startWire = plane.WireCoordinate(start) - wire;
+            double const stopWire  = plane.WireCoordinate(stop)  - wire;
+            
+            if (startWire * stopWire > 0.) continue; // same side of the wire
+            if (!tpc.ContainsPosition(start) && !tpc.ContainsPosition(stop)) continue;
+            
+            double const f = (startWire == stopWire)? 0.: startWire / (startWire - stopWire);
+            double const weight = match.data->ideFraction;
+            sum[0] += weight * (start.X() + f * (stop.X() - start.X()));
+            sum[1] += weight * (start.Y() + f * (stop.Y() - start.Y()));
+            sum[2] += weight * (start.Z() + f * (stop.Z() - start.Z()));
+            sumWeights += weight;
+            break;
+        }
+    }
+    
+    if (!(sumWeights > 0.)) return false;
+    for(unsigned int i = 0; i < 3; ++i) xyz[i] = sum[i] / sumWeights;
+    return true;
 }
 
 // method to return the fraction of hits in a collection that come from the specified Geant4 track ids
@@ -315,7 +478,7 @@ double MCTruthAssociations::HitCollectionPurity(std::set<int>
     // the correct plane by definition then.
     for(const auto& hit : hitVec)
     {
-        std::vector<TrackIDE> hitTrackIDEVec = this->HitToTrackID(hit.get());
+        std::vector<TrackIDE> hitTrackIDEVec = this->HitToTrackID(hit);
         
         for(const auto& trackIDE : hitTrackIDEVec)
         {
@@ -490,6 +653,144 @@ double MCTruthAssociations::HitChargeCollectionEfficiency(std::set<int>
     return efficiency;
 }
 
+// method to return purity and efficiency of many collections of hits at once
+std::vector<HitCollectionMatch> MCTruthAssociations::HitCollectionPurityAndEfficiency(const std::vector<HitCollectionSpec>&       collections,
+                                                                                      const std::vector< art::Ptr<recob::Hit> >& hits,
+                                                                                      const std::vector< art::Ptr<recob::Hit> >& allHitVec) const
+{
+    return collectionsPurityAndEfficiency(collections, hits, allHitVec, nullptr);
+}
+
+std::vector<HitCollectionMatch> MCTruthAssociations::HitCollectionPurityAndEfficiency(const std::vector<HitCollectionSpec>&       collections,
+                                                                                      const std::vector< art::Ptr<recob::Hit> >& hits,
+                                                                                      const std::vector< art::Ptr<recob::Hit> >& allHitVec,
+                                                                                      const icarus::ns::util::HitColumns&        allHitColumns) const
+{
+    if (allHitColumns.size() != allHitVec.size())
+    {
+        throw cet::exception("MCTruthAssociations") << "HitCollectionPurityAndEfficiency(): the hit table has "
+            << allHitColumns.size() << " hits, but " << allHitVec.size() << " hits were specified\n";
+    }
+    return collectionsPurityAndEfficiency(collections, hits, allHitVec, &allHitColumns);
+}
+
+std::vector<HitCollectionMatch> MCTruthAssociations::collectionsPurityAndEfficiency(const std::vector<HitCollectionSpec>&       collections,
+                                                                                    const std::vector< art::Ptr<recob::Hit> >& hits,
+                                                                                    const std::vector< art::Ptr<recob::Hit> >& allHitVec,
+                                                                                    const icarus::ns::util::HitColumns*        allHitColumns) const
+{
+    std::size_t const nCollections = collections.size();
+    
+    // all the (track ID, collection) pairs, sorted by track ID: each track ID
+    // is looked up once per hit, and it yields all the collections it belongs to
+    std::vector<std::pair<int, std::size_t>> trackCollections;
+    for(std::size_t iColl = 0; iColl < nCollections; ++iColl)
+    {
+        for(int trackID : collections[iColl].trackIDs) trackCollections.emplace_back(trackID, iColl);
+    }
+    std::sort(trackCollections.begin(), trackCollections.end());
+    trackCollections.erase(std::unique(trackCollections.begin(), trackCollections.end()), trackCollections.end());
+    
+    std::vector<double> nHits(nCollections, 0.), charge(nCollections, 0.);      // all hits in the collection
+    std::vector<double> nPure(nCollections, 0.), pureCharge(nCollections, 0.);  // matched, any energy fraction
+    std::vector<double> nFound(nCollections, 0.), foundCharge(nCollections, 0.);// matched above threshold
+    std::vector<double> nTotal(nCollections, 0.), totalCharge(nCollections, 0.);// all matched hits in the view
+    
+    // the numerators: the hits of each collection
+    for(std::size_t iColl = 0; iColl < nCollections; ++iColl)
+    {
+        const HitCollectionSpec& collection = collections[iColl];
+        std::vector<int> sortedIDs(collection.trackIDs);
+        std::sort(sortedIDs.begin(), sortedIDs.end());
+        
+        auto const isCandidate = [&sortedIDs](int trackID)
+            { return std::binary_search(sortedIDs.begin(), sortedIDs.end(), trackID); };
+        
+        for(std::size_t iHit = collection.begin; iHit < collection.end; ++iHit)
+        {
+            const art::Ptr<recob::Hit>& hit = hits[iHit];
+            double const integral = hit->Integral();
+            
+            nHits[iColl] += 1.;
+            charge[iColl] += integral;
+            
+            bool pure = false, found = false;
+            for(const auto& match : hitMatches(hit))
+            {
+                if (!isCandidate(match.particle->TrackId())) continue;
+                pure = true;
+                if (match.data->ideFraction >= fMinHitEnergyFraction) { found = true; break; }
+            }
+            
+            if (pure)
+            {
+                nPure[iColl] += 1.;
+                pureCharge[iColl] += integral;
+            }
+            if (found)
+            {
+                nFound[iColl] += 1.;
+                foundCharge[iColl] += integral;
+            }
+        }
+    }
+    
+    // the denominators of efficiency: one loop over all the hits;
+    // for each collection, the last hit which was counted (hits are counted only once)
+    constexpr std::size_t NoHit = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> lastHit(nCollections, NoHit);
+    
+    // view and charge of all the hits, from the table if available
+    const geo::View_t* views     = allHitColumns? allHitColumns->view():     nullptr;
+    const float*       integrals = allHitColumns? allHitColumns->integral(): nullptr;
+    
+    for(std::size_t iHit = 0; iHit < allHitVec.size(); ++iHit)
+    {
+        const art::Ptr<recob::Hit>& hit = allHitVec[iHit];
+        
+        for(const auto& match : hitMatches(hit))
+        {
+            if (!(match.data->ideFraction >= fMinHitEnergyFraction)) continue;
+            
+            int const trackID = match.particle->TrackId();
+            auto itr = std::lower_bound(trackCollections.begin(), trackCollections.end(),
+                                        std::pair<int, std::size_t>{ trackID, 0 });
+            
+            // all the collections with this track ID
+            for(; itr != trackCollections.end() && itr->first == trackID; ++itr)
+            {
+                std::size_t const iColl = itr->second;
+                if (lastHit[iColl] == iHit) continue;
+                
+                // check that we are looking at the appropriate view here
+                // in the case of 3D objects we take all hits
+                geo::View_t const view = collections[iColl].view;
+                geo::View_t const hitView = views? views[iHit]: hit->View();
+                if(hitView != view && view != geo::k3D ) continue;
+                
+                lastHit[iColl] = iHit;
+                nTotal[iColl] += 1.;
+                totalCharge[iColl] += integrals? integrals[iHit]: hit->Integral();
+            }
+        }
+    }
+    
+    auto const ratio = [](double num, double den){ return (den > 0.)? num / den: 0.; };
+    
+    std::vector<HitCollectionMatch> results(nCollections);
+    for(std::size_t iColl = 0; iColl < nCollections; ++iColl)
+    {
+        HitCollectionMatch& result = results[iColl];
+        
+        result.purity           = ratio(nPure[iColl], nHits[iColl]);
+        result.efficiency       = ratio(nFound[iColl], nTotal[iColl]);
+        result.chargePurity     = ratio(pureCharge[iColl], charge[iColl]);
+        result.chargeEfficiency = ratio(foundCharge[iColl], totalCharge[iColl]);
+    }
+    
+    return results;
+}
+
 // method to return all EveIDs corresponding to the current sim::ParticleList
 std::set<int> MCTruthAssociations::GetSetOfEveIDs() const
 {
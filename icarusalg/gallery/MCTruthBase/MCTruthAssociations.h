@@ -28,6 +28,10 @@ namespace detinfo {
 
 // nutools
 #include "icarusalg/gallery/MCTruthBase/MCTruthParticleList.h"
+#include "icarusalg/gallery/MCTruthBase/MCTruthHitParticleTable.h"
+
+// ICARUS libraries
+#include "icarusalg/Utilities/HitColumns.h"
 
 // canvas libraries
 #include "fhiclcpp/ParameterSet.h"
@@ -35,6 +39,9 @@ namespace detinfo {
 // C/C++ standard libraries
 #include <vector>
 #include <memory> // std::unique_ptr<>
+#include <utility> // std::pair<>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t
 
 namespace truth
 {
@@ -54,12 +61,55 @@ struct TrackIDE{
     float numElectrons; ///< number of electrons from the particle detected on the wires
 };
 
+/// Specification of a collection of hits for batched truth matching
+struct HitCollectionSpec
+{
+    std::size_t      begin = 0;          ///< index of the first hit of the collection in the hit list
+    std::size_t      end   = 0;          ///< index after the last hit of the collection in the hit list
+    std::vector<int> trackIDs;           ///< Geant4 track IDs the collection is tested against
+    geo::View_t      view  = geo::k3D;   ///< view of the hits counted for efficiency (`geo::k3D`: all)
+};
+
+/// Purity and efficiency of a collection of hits
+struct HitCollectionMatch
+{
+    double purity           = 0.;   ///< as in `HitCollectionPurity()`
+    double efficiency       = 0.;   ///< as in `HitCollectionEfficiency()`
+    double chargePurity     = 0.;   ///< as in `HitChargeCollectionPurity()`
+    double chargeEfficiency = 0.;   ///< as in `HitChargeCollectionEfficiency()`
+};
+
+/// Truth positions of many hits or space points, one array per coordinate [cm]
+struct TruthXYZArrays
+{
+    std::vector<double>       x;       ///< x coordinate of each position
+    std::vector<double>       y;       ///< y coordinate of each position
+    std::vector<double>       z;       ///< z coordinate of each position
+    std::vector<std::uint8_t> matched; ///< whether the position could be reconstructed (`0`: zero point)
+    
+    std::size_t size() const { return x.size(); }
+    
+    // sets the number of positions (memory is kept when shrinking)
+    void resize(std::size_t n) { x.resize(n); y.resize(n); z.resize(n); matched.resize(n); }
+};
+
+/// Memory held by `MCTruthAssociations` (estimated from the containers)
+struct MCTruthMemoryStats
+{
+    std::size_t nEvents    = 0;   ///< number of calls to `setup()` so far
+    std::size_t eventBytes = 0;   ///< memory held after the last `setup()` [bytes]
+    std::size_t peakBytes  = 0;   ///< largest `eventBytes` so far [bytes]
+};
+
 /**
  * @brief Obtains truth matching by using hit <--> MCParticle associations
  * 
  * Configuration
  * --------------
  * 
+ * The same object is meant to be set up again for each event: the containers
+ * keep their memory between events, and `getMemoryStats()` reports how much
+ * of it is used.
  */
 class MCTruthAssociations
 {
@@ -71,9 +121,19 @@ public:
                const MCParticleVec&,
                const MCTruthAssns&,
                const geo::GeometryCore&);
+
+    // same as above, with the MCTruth of each particle in a vector indexed by the particle key
+    // (particles with a key beyond the end of the vector have no MCTruth)
+    void setup(const HitParticleAssociationsVec&,
+               const MCParticleVec&,
+               const MCTruthTruthVec&,
+               const geo::GeometryCore&);
     
     const MCTruthParticleList& getParticleList() const;
 
+    // Returns the memory used by the last event, and the largest so far
+    const MCTruthMemoryStats& getMemoryStats() const;
+
     // Return a pointer to the simb::MCParticle object corresponding to
     // the given TrackID
     const simb::MCParticle* TrackIDToParticle(int const& id)       const;
@@ -98,11 +158,28 @@ public:
     // electrons to the identified hit
     std::vector<TrackIDE> HitToEveID(art::Ptr<recob::Hit> const& hit) const;
 
-    // method to return the XYZ position of the weighted average energy deposition for a given hit
+    // method to return the XYZ position of the weighted average energy deposition for a given hit:
+    // for each particle matched to the hit, the point where its trajectory crosses the wire of the hit
+    // (within the TPC of the hit), averaged with the fraction of the hit energy from that particle;
+    // a zero point if no matched particle crosses the wire
     std::vector<double>  HitToXYZ(art::Ptr<recob::Hit> const& hit) const;
     
     // method to return the XYZ position of a space point (unweighted average XYZ of component hits).
     std::vector<double> SpacePointHitsToXYZ(art::PtrVector<recob::Hit> const& hits) const;
+    
+    // method to return the XYZ position of the hits with index in [ begin, end [ of the hits list
+    // in the first ( end - begin ) entries of the arrays, as `HitToXYZ()` would;
+    // `xyz` is resized, and its memory is reused when it is large enough
+    void HitsToXYZ(std::vector< art::Ptr<recob::Hit> > const& hits,
+                   std::size_t begin, std::size_t end,
+                   TruthXYZArrays&                     xyz) const;
+    
+    // method to return the XYZ position of many space points, as `SpacePointHitsToXYZ()` would;
+    // the hits of the space point `i` are the ones in [ offsets[i], offsets[i + 1] [ of the hits list,
+    // and `xyz` is resized to the number of space points ( offsets.size() - 1 )
+    void SpacePointsHitsToXYZ(std::vector< art::Ptr<recob::Hit> > const& hits,
+                              std::vector<std::size_t>            const& offsets,
+                              TruthXYZArrays&                            xyz) const;
 
     // method to return the fraction of hits in a collection that come from the specified Geant4 track ids
     double HitCollectionPurity(std::set<int>,
@@ -126,6 +203,21 @@ public:
                                          std::vector< art::Ptr<recob::Hit> > const&,
                                          geo::View_t                         const&) const;
     
+    // method to return purity and efficiency, both in hits and in charge, of many collections at once;
+    // the hits of each collection are a range [ begin, end [ of indices in the hits list, and the
+    // result is the same as calling the four single-collection methods on each collection
+    // (with the track IDs of the collection and allHitVec), with a single loop on allHitVec
+    std::vector<HitCollectionMatch> HitCollectionPurityAndEfficiency(std::vector<HitCollectionSpec>     const&,
+                                                                     std::vector< art::Ptr<recob::Hit> > const& hits,
+                                                                     std::vector< art::Ptr<recob::Hit> > const& allHitVec) const;
+    
+    // same as above, with the view and charge of allHitVec read from allHitColumns, which must have been
+    // filled from the same hits in the same order (e.g. allHitVec pointing to all the hits of the data product)
+    std::vector<HitCollectionMatch> HitCollectionPurityAndEfficiency(std::vector<HitCollectionSpec>     const&,
+                                                                     std::vector< art::Ptr<recob::Hit> > const& hits,
+                                                                     std::vector< art::Ptr<recob::Hit> > const& allHitVec,
+                                                                     icarus::ns::util::HitColumns        const& allHitColumns) const;
+    
     // method to return all EveIDs corresponding to the current sim::ParticleList
     std::set<int> GetSetOfEveIDs() const;
     
@@ -140,24 +232,29 @@ public:
 
 private:
     
-    // Declare the containers for the basic maps
-    using HitMatchDataPair  = std::pair<const recob::Hit*,const anab::BackTrackerHitMatchingData*>;
-    using PartMatchDataPair = std::pair<const simb::MCParticle*,const anab::BackTrackerHitMatchingData*>;
-    using HitToPartVecMap   = std::map<const recob::Hit*,std::set<PartMatchDataPair>>;
-    using PartToHitVecMap   = std::map<const simb::MCParticle*, std::set<HitMatchDataPair>>;
-    using MCTruthTrackIDMap = std::unordered_map<int, art::Ptr<simb::MCTruth>>;
+    // track ID to MCTruth, sorted by track ID (a flat vector keeps its memory between events)
+    using MCTruthTrackIDMap = std::vector<std::pair<int, art::Ptr<simb::MCTruth>>>;
 
     // Must allow for the case of multiple instances of hit <--> MCParticle associations
     // You ask "why do it this way? Can't these all be in a single set of containers?"
     // The answer is no because you want to avoid multiple counting
-    struct HitPartAssnsStruct
-    {
-        // Declare containers as member variables
-        HitToPartVecMap     fHitToPartVecMap;       ///< Mapping from hits to associated MCParticle/data pairs
-        PartToHitVecMap     fPartToHitVecMap;       ///< Mapping from MCParticle to associated hit/data pairs
-    };
+    // Each table holds hits to MCParticle/data pairs and MCParticle to hit/data pairs
+    using HitPartAssnsList = std::vector<MCTruthHitParticleTable>;
+
+    // returns the particles matched to the hit in the first collection which has any
+    MCTruthHitParticleTable::PartMatchRange hitMatches(art::Ptr<recob::Hit> const&) const;
+    
+    // converts the particles matched to a hit into TrackIDEs
+    static std::vector<TrackIDE> toTrackIDEs(MCTruthHitParticleTable::PartMatchRange);
+    
+    // implementation of HitCollectionPurityAndEfficiency(), with optional columns of allHitVec
+    std::vector<HitCollectionMatch> collectionsPurityAndEfficiency(std::vector<HitCollectionSpec>     const&,
+                                                                   std::vector< art::Ptr<recob::Hit> > const& hits,
+                                                                   std::vector< art::Ptr<recob::Hit> > const& allHitVec,
+                                                                   icarus::ns::util::HitColumns const*        allHitColumns) const;
     
-    using HitPartAssnsList = std::list<HitPartAssnsStruct>;
+    // computes the truth position of the hit into `xyz`; returns whether successful
+    bool hitXYZ(art::Ptr<recob::Hit> const&, double xyz[3]) const;
 
     int    calculateEvdID(int) const;
     double length(const recob::Track*) const;
@@ -175,6 +272,8 @@ private:
                                                                ///< contribute to a hit to be counted in
                                                                ///< purity and efficiency calculations
                                                                ///< based on hit collections
+    unsigned int                       fEveIdThreads;          ///< threads used to compute all the eve IDs
+    MCTruthMemoryStats                 fMemoryStats;           ///< memory used by the containers
 
     geo::GeometryCore const*           fGeometry           = nullptr;
 
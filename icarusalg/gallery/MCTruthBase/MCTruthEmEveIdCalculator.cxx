@@ -19,6 +19,28 @@
 
 #include <TString.h>
 
+namespace {
+
+  // Returns whether the process is pair production, compton
+  // scattering, photoelectric effect, bremstrahlung, annihilation, or
+  // any ionization. (The ultimate source of the process names are the
+  // physics lists used in Geant4.)
+  bool IsEmShowerProcess( const std::string& process )
+  {
+    return process.find("conv")              != std::string::npos ||
+           process.find("LowEnConversion")   != std::string::npos ||
+           process.find("Pair")              != std::string::npos ||
+           process.find("compt")             != std::string::npos ||
+           process.find("Compt")             != std::string::npos ||
+           process.find("Brem")              != std::string::npos ||
+           process.find("phot")              != std::string::npos ||
+           process.find("Photo")             != std::string::npos ||
+           process.find("Ion")               != std::string::npos ||
+           process.find("annihil")           != std::string::npos;
+  }
+
+} // local namespace
+
 namespace truth {
 
   //----------------------------------------------------------------------------
@@ -50,21 +72,8 @@ namespace truth {
       // the particle.
       std::string process = (*i)->Process();
 
-      // Skip it if it was created by pair production, compton
-      // scattering, photoelectric effect, bremstrahlung,
-      // annihilation, or any ionization. (The ultimate source of
-      // the process names are the physics lists used in Geant4.)
-      
-      if ( process.find("conv")              != std::string::npos ||
-	   process.find("LowEnConversion")   != std::string::npos ||
-	   process.find("Pair")              != std::string::npos ||
-	   process.find("compt")             != std::string::npos ||
-	   process.find("Compt")             != std::string::npos ||
-	   process.find("Brem")              != std::string::npos ||
-	   process.find("phot")              != std::string::npos ||
-	   process.find("Photo")             != std::string::npos ||
-	   process.find("Ion")               != std::string::npos ||
-	   process.find("annihil")           != std::string::npos) continue;         
+      // Skip it if it was created by a trivial e-m process.
+      if ( IsEmShowerProcess(process) ) continue;
 
       // If we get here, the particle wasn't created by any of the
       // above processes. Return its ID.
@@ -76,4 +85,20 @@ namespace truth {
     return 0;
   }
 
+  //----------------------------------------------------------------------------
+  // A particle not from a trivial e-m process is its own eve; otherwise
+  // its eve is the one of its mother, if the history goes on.
+  MCTruthEveIdCalculator::EveStep_t MCTruthEmEveIdCalculator::DoEveStep( const simb::MCParticle& particle ) const
+  {
+    if ( !IsEmShowerProcess( particle.Process() ) ) return { EveStep_t::Resolved, particle.TrackId() };
+    
+    // the history stops at a primary particle, or where the chain is broken
+    if ( m_particleList->IsPrimary( particle.TrackId() ) ) return { EveStep_t::Resolved, 0 };
+    
+    const simb::MCParticle* mother = m_particleList->FindParticle( particle.Mother() );
+    if ( !mother ) return { EveStep_t::Resolved, 0 };
+    
+    return { EveStep_t::Next, mother->TrackId() };
+  }
+
 } // namespace sim
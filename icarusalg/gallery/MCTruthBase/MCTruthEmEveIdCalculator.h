@@ -78,6 +78,9 @@ namespace truth {
   private:
     // This is the method that does the actual eve ID calculation.
     virtual int DoCalculateEveId( const int trackID );
+    
+    // The same calculation, one particle at a time (for ComputeAllEveIds()).
+    virtual EveStep_t DoEveStep( const simb::MCParticle& particle ) const;
   };
 
 } // namespace sim
@@ -16,8 +16,41 @@
 #include "icarusalg/gallery/MCTruthBase/MCTruthEveIdCalculator.h"
 #include "icarusalg/gallery/MCTruthBase/MCTruthParticleList.h"
 #include "icarusalg/gallery/MCTruthBase/MCTruthParticleHistory.h"
+#include "icarusalg/Utilities/runConcurrently.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
 
+#include <algorithm> // std::lower_bound(), std::max(), std::min()
+#include <atomic>
+#include <thread> // std::thread::hardware_concurrency()
+#include <typeinfo>
+#include <cstddef> // std::size_t
+
+namespace {
+
+  /// Calls `func(begin, end)` on `nThreads` consecutive chunks of `[0, n[`,
+  /// each in its own thread (the first one in the calling thread);
+  /// the exception from the first failing chunk, if any, is rethrown.
+  template <typename Func>
+  void forEachChunk( std::size_t n, unsigned int nThreads, Func const& func )
+  {
+    std::size_t const nChunks = std::min<std::size_t>(nThreads, n);
+    if (nChunks <= 1) {
+      func(std::size_t{ 0 }, n);
+      return;
+    }
+    
+    std::size_t const chunkSize = (n + nChunks - 1) / nChunks;
+    icarus::ns::util::runConcurrently
+      (nChunks, static_cast<unsigned int>(nChunks),
+      [&func,n,chunkSize]( std::size_t iChunk )
+        {
+          std::size_t const begin = iChunk * chunkSize;
+          func(begin, std::min(begin + chunkSize, n));
+        });
+  } // forEachChunk()
+
+} // local namespace
+
 namespace truth {
 
   //----------------------------------------------------------------------------
@@ -43,11 +76,20 @@ namespace truth {
 
     // Reset the results of previous calculations.
     m_previousList.clear();
+    m_allEveIds.clear();
+    m_allEveIdsValid = false;
   }
 
   //----------------------------------------------------------------------------
   int MCTruthEveIdCalculator::CalculateEveId( const int trackID )
   {
+    // If all the eve IDs were computed at once, just look there.
+    if ( m_allEveIdsValid ){
+      auto const found = std::lower_bound
+        ( m_allEveIds.begin(), m_allEveIds.end(), std::pair<int, int>{ trackID, 0 } );
+      if ( found != m_allEveIds.end() && found->first == trackID ) return found->second;
+    }
+    
     // Look to see if the eve ID has been previously calculated for
     // this track.
     m_previousList_ptr search = m_previousList.find( trackID );
@@ -90,4 +132,149 @@ namespace truth {
     return particle->TrackId();
   }
 
+  //----------------------------------------------------------------------------
+  MCTruthEveIdCalculator::EveStep_t MCTruthEveIdCalculator::DoEveStep( const simb::MCParticle& particle ) const
+  {
+    // A derived class which changed DoCalculateEveId() but not this
+    // method must go through the former.
+    if ( typeid(*this) != typeid(MCTruthEveIdCalculator) )
+      return { EveStep_t::Fallback, 0 };
+    
+    // Same as DoCalculateEveId(): the history stops at a primary
+    // particle, or where the chain is broken.
+    int const trackID = particle.TrackId();
+    if ( m_particleList->IsPrimary( trackID ) ) return { EveStep_t::Resolved, trackID };
+    
+    const simb::MCParticle* mother = m_particleList->FindParticle( particle.Mother() );
+    if ( !mother ) return { EveStep_t::Resolved, trackID };
+    
+    return { EveStep_t::Next, mother->TrackId() };
+  }
+
+  //----------------------------------------------------------------------------
+  void MCTruthEveIdCalculator::ComputeAllEveIds( unsigned int nThreads /* = 1 */ )
+  {
+    m_allEveIds.clear();
+    m_allEveIdsValid = false;
+    if ( !m_particleList ) return;
+    
+    if ( nThreads == 0 ) nThreads = std::max( 1U, std::thread::hardware_concurrency() );
+    
+    // The particles in the list are the nodes of the forest.
+    std::vector<int>                     trackIDs;
+    std::vector<const simb::MCParticle*> particles;
+    trackIDs.reserve( m_particleList->size() );
+    particles.reserve( m_particleList->size() );
+    for ( auto const& [ trackID, particle ]: *m_particleList ){
+      trackIDs.push_back( trackID );
+      particles.push_back( particle );
+    }
+    std::size_t const n = trackIDs.size();
+    
+    constexpr std::size_t NoIndex = static_cast<std::size_t>( -1 );
+    auto indexOf = [&trackIDs]( int trackID )
+      {
+        auto const found = std::lower_bound( trackIDs.begin(), trackIDs.end(), trackID );
+        return ( found != trackIDs.end() && *found == trackID )
+          ? static_cast<std::size_t>( found - trackIDs.begin() ): NoIndex;
+      };
+    
+    // For each node, either next[i] is the node with its same eve ID,
+    // or it is NoIndex and eveIDs[i] is its eve ID.
+    std::vector<int>         eveIDs( n, 0 );
+    std::vector<std::size_t> next( n, NoIndex );
+    std::vector<char>        fallback( n, 0 );
+    
+    forEachChunk( n, nThreads, [&,this]( std::size_t begin, std::size_t end )
+      {
+        for ( std::size_t i = begin; i < end; ++i ){
+          // archived particles have no history: let the full calculation decide
+          if ( !particles[i] ) { fallback[i] = 1; continue; }
+          
+          EveStep_t const step = DoEveStep( *particles[i] );
+          switch ( step.kind ){
+            case EveStep_t::Resolved:
+              eveIDs[i] = step.trackID;
+              break;
+            case EveStep_t::Next:
+              next[i] = indexOf( step.trackID );
+              if ( next[i] == NoIndex ) fallback[i] = 1;
+              break;
+            case EveStep_t::Fallback:
+              fallback[i] = 1;
+              break;
+          } // switch
+        }
+      });
+    
+    // The full calculation is not required to be thread-safe.
+    for ( std::size_t i = 0; i < n; ++i ){
+      if ( fallback[i] ) eveIDs[i] = DoCalculateEveId( trackIDs[i] );
+    }
+    
+    if ( nThreads <= 1 ){
+      // Follow each chain once, and point all its nodes directly to
+      // the result (path compression); a loop in the chain gives 0.
+      std::vector<std::size_t> path;
+      std::vector<char>        onPath( n, 0 );
+      for ( std::size_t i = 0; i < n; ++i ){
+        std::size_t j = i;
+        while ( next[j] != NoIndex && !onPath[j] ){
+          onPath[j] = 1;
+          path.push_back( j );
+          j = next[j];
+        }
+        int const eveID = ( next[j] == NoIndex )? eveIDs[j]: 0;
+        for ( std::size_t k: path ){
+          eveIDs[k] = eveID;
+          next[k]   = NoIndex;
+          onPath[k] = 0;
+        }
+        path.clear();
+      }
+    }
+    else {
+      // Pointer jumping: at each round every node points to its next
+      // node's next, so chains of length L are resolved in log2(L)
+      // rounds; nodes still pending after enough rounds are in a loop.
+      std::vector<int>         newEveIDs( n );
+      std::vector<std::size_t> newNext( n );
+      std::atomic<bool>        pending;
+      constexpr unsigned int MaxRounds = 8 * sizeof( std::size_t );
+      for ( unsigned int round = 0; round < MaxRounds; ++round ){
+        pending = false;
+        forEachChunk( n, nThreads, [&]( std::size_t begin, std::size_t end )
+          {
+            bool anyPending = false;
+            for ( std::size_t i = begin; i < end; ++i ){
+              std::size_t const j = next[i];
+              if ( j == NoIndex ){
+                newEveIDs[i] = eveIDs[i];
+                newNext[i]   = NoIndex;
+              }
+              else if ( next[j] == NoIndex ){
+                newEveIDs[i] = eveIDs[j];
+                newNext[i]   = NoIndex;
+              }
+              else {
+                newNext[i]   = next[j];
+                anyPending   = true;
+              }
+            }
+            if ( anyPending ) pending = true;
+          });
+        eveIDs.swap( newEveIDs );
+        next.swap( newNext );
+        if ( !pending ) break;
+      }
+      for ( std::size_t i = 0; i < n; ++i ){
+        if ( next[i] != NoIndex ) eveIDs[i] = 0;
+      }
+    }
+    
+    m_allEveIds.reserve( n );
+    for ( std::size_t i = 0; i < n; ++i ) m_allEveIds.emplace_back( trackIDs[i], eveIDs[i] );
+    m_allEveIdsValid = true;
+  }
+
 }
@@ -80,6 +80,10 @@
 #define TRUTH_MCTruthEveIdCalculator_H
 
 #include <map>
+#include <vector>
+#include <utility> // std::pair
+
+namespace simb { class MCParticle; }
 
 namespace truth {
 
@@ -115,19 +119,57 @@ namespace truth {
     /// a given track ID.
     int CalculateEveId( const int trackID );
 
+    /// Computes at once the eve ID of all the particles in the list.
+    /// Instead of following the history of each particle, each
+    /// particle is resolved in a single step (DoEveStep()) either to
+    /// its eve ID or to the particle it shares the eve ID with; the
+    /// whole particle forest is then resolved with path compression,
+    /// so that each chain is followed only once. With more than one
+    /// thread (`0` means one per core), the forest is resolved by
+    /// pointer jumping, with all the particles updated in parallel at
+    /// each of the (logarithmically many) rounds. After this call,
+    /// CalculateEveId() of a particle in the list is a table lookup.
+    void ComputeAllEveIds( unsigned int nThreads = 1 );
+
+    /// Returns whether ComputeAllEveIds() was called on this list.
+    bool HasAllEveIds() const { return m_allEveIdsValid; }
+
   protected:
+    /// Result of a single step of eve ID calculation of a particle.
+    struct EveStep_t {
+      enum Kind_t {
+        Resolved, ///< `trackID` is the eve ID
+        Next,     ///< `trackID` is a particle with the same eve ID
+        Fallback  ///< DoCalculateEveId() must be used instead
+      };
+      Kind_t kind    = Resolved;
+      int    trackID = 0;
+    };
+
     /// This is the core method to calculate the eve ID. If another
     /// class is going to override the default calculation, this the
     /// method that must be implemented.
     virtual int DoCalculateEveId( const int trackID );
 
-    const MCTruthParticleList* m_particleList; ///> The ParticleList associated with the eve ID calculation.
+    /// This is the single-step form of DoCalculateEveId(), used by
+    /// ComputeAllEveIds(): it returns either the eve ID of `particle`
+    /// or the track ID of the (live) particle which has the same eve
+    /// ID. A class which overrides DoCalculateEveId() should override
+    /// this method consistently; if it does not, its eve IDs are
+    /// computed with DoCalculateEveId() one by one.
+    virtual EveStep_t DoEveStep( const simb::MCParticle& particle ) const;
+
+    const MCTruthParticleList* m_particleList = nullptr; ///> The ParticleList associated with the eve ID calculation.
 
   private:
     /// Keep track of the previous eve IDs for the current ParticleList.
     typedef std::map< int, int >             m_previousList_t;
     typedef m_previousList_t::const_iterator m_previousList_ptr;
     m_previousList_t                         m_previousList; ///> The results of previous eve ID calculations for the current ParticleList.
+
+    /// Eve ID of all the particles in the list, sorted by track ID.
+    std::vector<std::pair<int, int>>         m_allEveIds;
+    bool                                     m_allEveIdsValid = false; ///> Whether `m_allEveIds` is filled.
   };
 
 } // namespace sim
@@ -0,0 +1,187 @@
+/**
+ * @file    MCTruthHitParticleTable.cxx
+ * @brief   Flat tables of hit <--> MCParticle associations (implementation).
+ * @author  Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date    October 14, 2026
+ * @see     MCTruthHitParticleTable.h
+ *
+ */
+
+#include "icarusalg/gallery/MCTruthBase/MCTruthHitParticleTable.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::unique(), std::lower_bound()
+#include <functional> // std::less<>
+#include <tuple> // std::tie()
+
+namespace
+{
+    // pointers are compared with `std::less`, which gives them a total order
+    template <typename T>
+    bool ptrLess(const T* a, const T* b) { return std::less<const T*>{}(a, b); }
+}
+
+namespace truth
+{
+
+MCTruthHitParticleTable::MCTruthHitParticleTable(const HitParticleAssociations& assns)
+{
+    fill(assns);
+}
+
+void MCTruthHitParticleTable::clear()
+{
+    fHits.clear();
+    fHitOffsets.clear();
+    fPartMatches.clear();
+    fHitProductID = art::ProductID{};
+    fHitIndexByKey.clear();
+    fTrackIDs.clear();
+    fTrackOffsets.clear();
+    fHitMatches.clear();
+}
+
+void MCTruthHitParticleTable::fill(const HitParticleAssociations& assns)
+{
+    clear();
+
+    std::vector<Entry>& entries = fEntries;
+    entries.clear();
+    entries.reserve(assns.size());
+
+    for(HitParticleAssociations::const_iterator partHitItr = assns.begin(); partHitItr != assns.end(); ++partHitItr)
+    {
+        const art::Ptr<recob::Hit>& recoHit = partHitItr->second;
+        entries.push_back({ recoHit.get(), partHitItr->first.get(), partHitItr->data, recoHit.key(), recoHit.id() });
+    }
+
+    //
+    // hit --> particles: sort by hit, then remove the repeated matches
+    //
+    auto const byHit = [](const Entry& a, const Entry& b)
+        {
+            if (a.hit != b.hit) return ptrLess(a.hit, b.hit);
+            if (a.particle != b.particle) return ptrLess(a.particle, b.particle);
+            return ptrLess(a.data, b.data);
+        };
+    auto const sameMatch = [](const Entry& a, const Entry& b)
+        { return std::tie(a.hit, a.particle, a.data) == std::tie(b.hit, b.particle, b.data); };
+
+    std::sort(entries.begin(), entries.end(), byHit);
+    entries.erase(std::unique(entries.begin(), entries.end(), sameMatch), entries.end());
+
+    if (!entries.empty()) fHitProductID = entries.front().hitProductID;
+    std::size_t maxKey = 0;
+
+    fPartMatches.reserve(entries.size());
+    for(const Entry& entry : entries)
+    {
+        if (fHits.empty() || (fHits.back() != entry.hit))
+        {
+            fHits.push_back(entry.hit);
+            fHitOffsets.push_back(fPartMatches.size());
+
+            if (entry.hitProductID != fHitProductID) fHitProductID = art::ProductID{};
+            if (entry.hitKey > maxKey) maxKey = entry.hitKey;
+        }
+        fPartMatches.push_back({ entry.particle, entry.data });
+    }
+    fHitOffsets.push_back(fPartMatches.size());
+
+    // with a single hit data product, hits are also addressed by their key
+    if (fHitProductID.isValid())
+    {
+        fHitIndexByKey.assign(maxKey + 1, NoHit);
+        for(std::size_t iHit = 0; iHit < fHits.size(); ++iHit)
+            fHitIndexByKey[entries[fHitOffsets[iHit]].hitKey] = iHit;
+    }
+
+    //
+    // particle --> hits: sort by track ID, then remove the repeated matches
+    // (different particles might share the same track ID)
+    //
+    std::vector<TrackEntry>& trackEntries = fTrackEntries;
+    trackEntries.clear();
+    trackEntries.reserve(entries.size());
+    for(const Entry& entry : entries)
+        trackEntries.push_back({ entry.particle->TrackId(), entry.hit, entry.data });
+
+    auto const byTrack = [](const TrackEntry& a, const TrackEntry& b)
+        {
+            if (a.trackID != b.trackID) return a.trackID < b.trackID;
+            if (a.hit != b.hit) return ptrLess(a.hit, b.hit);
+            return ptrLess(a.data, b.data);
+        };
+    auto const sameTrackMatch = [](const TrackEntry& a, const TrackEntry& b)
+        { return std::tie(a.trackID, a.hit, a.data) == std::tie(b.trackID, b.hit, b.data); };
+
+    std::sort(trackEntries.begin(), trackEntries.end(), byTrack);
+    trackEntries.erase
+      (std::unique(trackEntries.begin(), trackEntries.end(), sameTrackMatch), trackEntries.end());
+
+    fHitMatches.reserve(trackEntries.size());
+    for(const TrackEntry& entry : trackEntries)
+    {
+        if (fTrackIDs.empty() || (fTrackIDs.back() != entry.trackID))
+        {
+            fTrackIDs.push_back(entry.trackID);
+            fTrackOffsets.push_back(fHitMatches.size());
+        }
+        fHitMatches.push_back({ entry.hit, entry.data });
+    }
+    fTrackOffsets.push_back(fHitMatches.size());
+}
+
+std::size_t MCTruthHitParticleTable::memoryUsage() const
+{
+    return fHits.capacity()           * sizeof(decltype(fHits)::value_type)
+         + fHitOffsets.capacity()     * sizeof(decltype(fHitOffsets)::value_type)
+         + fPartMatches.capacity()    * sizeof(decltype(fPartMatches)::value_type)
+         + fHitIndexByKey.capacity()  * sizeof(decltype(fHitIndexByKey)::value_type)
+         + fTrackIDs.capacity()       * sizeof(decltype(fTrackIDs)::value_type)
+         + fTrackOffsets.capacity()   * sizeof(decltype(fTrackOffsets)::value_type)
+         + fHitMatches.capacity()     * sizeof(decltype(fHitMatches)::value_type)
+         + fEntries.capacity()        * sizeof(decltype(fEntries)::value_type)
+         + fTrackEntries.capacity()   * sizeof(decltype(fTrackEntries)::value_type);
+}
+
+MCTruthHitParticleTable::PartMatchRange MCTruthHitParticleTable::hitMatches(std::size_t iHit) const
+{
+    return { fPartMatches.data() + fHitOffsets[iHit], fHitOffsets[iHit + 1] - fHitOffsets[iHit] };
+}
+
+MCTruthHitParticleTable::PartMatchRange MCTruthHitParticleTable::particlesOf(const recob::Hit* hit) const
+{
+    auto const hitItr = std::lower_bound(fHits.begin(), fHits.end(), hit, ptrLess<recob::Hit>);
+
+    if ((hitItr == fHits.end()) || (*hitItr != hit)) return {};
+
+    return hitMatches(hitItr - fHits.begin());
+}
+
+MCTruthHitParticleTable::PartMatchRange MCTruthHitParticleTable::particlesOf(const art::Ptr<recob::Hit>& hit) const
+{
+    if (fHits.empty()) return {};
+
+    // hits from more than one data product: look up by address
+    if (!fHitProductID.isValid()) return particlesOf(hit.get());
+
+    if ((hit.id() != fHitProductID) || (hit.key() >= fHitIndexByKey.size())) return {};
+
+    std::size_t const iHit = fHitIndexByKey[hit.key()];
+
+    return (iHit == NoHit)? PartMatchRange{}: hitMatches(iHit);
+}
+
+MCTruthHitParticleTable::HitMatchRange MCTruthHitParticleTable::hitsOf(int trackID) const
+{
+    auto const trackItr = std::lower_bound(fTrackIDs.begin(), fTrackIDs.end(), trackID);
+
+    if ((trackItr == fTrackIDs.end()) || (*trackItr != trackID)) return {};
+
+    std::size_t const iTrack = trackItr - fTrackIDs.begin();
+
+    return { fHitMatches.data() + fTrackOffsets[iTrack], fTrackOffsets[iTrack + 1] - fTrackOffsets[iTrack] };
+}
+
+}  // End of namespace
@@ -0,0 +1,152 @@
+/**
+ * @file    MCTruthHitParticleTable.h
+ * @brief   Flat tables of hit <--> MCParticle associations.
+ * @author  Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date    October 14, 2026
+ * @see     MCTruthHitParticleTable.cxx, MCTruthAssociations.h
+ *
+ */
+
+#ifndef MCTruthHitParticleTable_H
+#define MCTruthHitParticleTable_H
+
+// LArSoft libraries
+#include "nusimdata/SimulationBase/MCParticle.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+// C/C++ standard libraries
+#include "gsl/span"
+#include <vector>
+#include <cstddef> // std::size_t
+
+namespace truth
+{
+
+/**
+ * @brief Hit <--> MCParticle associations in flat, sorted tables.
+ *
+ * The content of one `art::Assns<simb::MCParticle, recob::Hit,
+ * anab::BackTrackerHitMatchingData>` data product is stored in two tables in
+ * compressed sparse row layout:
+ *  * the particles matched to each hit, grouped by hit;
+ *  * the hits matched to each particle, grouped by particle track ID.
+ *
+ * Each group is a contiguous range of a single vector, so that filling the
+ * tables takes a couple of sorts and looking them up a binary search at most.
+ * As with the `std::set` containers this replaces, a repeated association is
+ * recorded only once.
+ *
+ * When all the hits in the association belong to the same data product,
+ * the hit group is also directly addressed by the hit key, and the lookup by
+ * `art::Ptr` takes constant time.
+ *
+ * Neither `fill()` nor `clear()` release memory: a table reused for
+ * many events allocates only when an event is larger than all the previous
+ * ones.
+ */
+class MCTruthHitParticleTable
+{
+public:
+
+    using HitParticleAssociations
+      = art::Assns<simb::MCParticle, recob::Hit, anab::BackTrackerHitMatchingData>;
+
+    /// A particle matched to a hit, with its matching information.
+    struct PartMatch
+    {
+        const simb::MCParticle*                 particle = nullptr;
+        const anab::BackTrackerHitMatchingData* data     = nullptr;
+    };
+
+    /// A hit matched to a particle, with its matching information.
+    struct HitMatch
+    {
+        const recob::Hit*                       hit      = nullptr;
+        const anab::BackTrackerHitMatchingData* data     = nullptr;
+    };
+
+    using PartMatchRange = gsl::span<const PartMatch>;
+    using HitMatchRange  = gsl::span<const HitMatch>;
+
+    /// Constructor: empty tables.
+    MCTruthHitParticleTable() = default;
+
+    /// Constructor: fills the tables with the content of `assns`.
+    explicit MCTruthHitParticleTable(const HitParticleAssociations& assns);
+
+    /// Replaces the content of the tables with the one of `assns`.
+    void fill(const HitParticleAssociations& assns);
+
+    /// Removes all the content of the tables.
+    void clear();
+
+    /// Returns the particles matched to `hit` (empty if none).
+    PartMatchRange particlesOf(const recob::Hit* hit) const;
+
+    /// Returns the particles matched to `hit` (empty if none).
+    PartMatchRange particlesOf(const art::Ptr<recob::Hit>& hit) const;
+
+    /// Returns the hits matched to the particle with `trackID` (empty if none).
+    HitMatchRange hitsOf(int trackID) const;
+
+    /// Returns the number of hits with at least one matched particle.
+    std::size_t nHits() const { return fHits.size(); }
+
+    /// Returns the number of particles with at least one matched hit.
+    std::size_t nParticles() const { return fTrackIDs.size(); }
+
+    /// Returns the memory allocated by the tables (and their workspace) [bytes].
+    std::size_t memoryUsage() const;
+
+private:
+
+    /// Marks a hit key with no matched particle.
+    static constexpr std::size_t NoHit = static_cast<std::size_t>(-1);
+
+    /// One association, as read from the data product.
+    struct Entry
+    {
+        const recob::Hit*                       hit;
+        const simb::MCParticle*                 particle;
+        const anab::BackTrackerHitMatchingData* data;
+        std::size_t                             hitKey;
+        art::ProductID                          hitProductID;
+    };
+
+    /// One association, by particle track ID.
+    struct TrackEntry
+    {
+        int                                     trackID;
+        const recob::Hit*                       hit;
+        const anab::BackTrackerHitMatchingData* data;
+    };
+
+    /// Returns the particles of the hit with the specified index in `fHits`.
+    PartMatchRange hitMatches(std::size_t iHit) const;
+
+    // hit --> particles
+    std::vector<const recob::Hit*> fHits;       ///< Matched hits, sorted by address
+    std::vector<std::size_t>       fHitOffsets; ///< Start of each hit group in `fPartMatches`
+    std::vector<PartMatch>         fPartMatches;///< Matched particles, grouped by hit
+
+    art::ProductID                 fHitProductID; ///< Product of all hits (if just one)
+    std::vector<std::size_t>       fHitIndexByKey;///< Index in `fHits` of each hit key
+
+    // particle --> hits
+    std::vector<int>               fTrackIDs;     ///< Matched track IDs, sorted
+    std::vector<std::size_t>       fTrackOffsets; ///< Start of each track group in `fHitMatches`
+    std::vector<HitMatch>          fHitMatches;   ///< Matched hits, grouped by track ID
+
+    // workspace for `fill()`, kept to reuse its memory
+    std::vector<Entry>             fEntries;      ///< Associations being sorted by hit
+    std::vector<TrackEntry>        fTrackEntries; ///< Associations being sorted by track
+
+}; // class MCTruthHitParticleTable
+
+}  // End of namespace
+
+#endif // MCTruthHitParticleTable_H
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  MCTruthParticleAncestry.cxx
+/// \brief Production history of all the particles in a MCTruthParticleList.
+///
+/// \author  Gianluca Petrillo (petrillo@slac.stanford.edu)
+/// \date    October 15, 2026
+////////////////////////////////////////////////////////////////////////
+
+#include "icarusalg/gallery/MCTruthBase/MCTruthParticleAncestry.h"
+#include "icarusalg/gallery/MCTruthBase/MCTruthParticleList.h"
+
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+#include <algorithm> // std::lower_bound()
+#include <utility> // std::pair
+#include <cstdlib> // std::abs()
+
+namespace truth {
+
+//----------------------------------------------------------------------------
+MCTruthParticleAncestry::MCTruthParticleAncestry
+  ( const MCTruthParticleList& list )
+{
+    // the list is sorted by track ID, and so are the indices;
+    // archived particles are not part of any history
+    m_particles.reserve( list.size() );
+    m_trackIDs.reserve( list.size() );
+    for ( const auto& [ trackID, particle ]: list ) {
+        if ( !particle ) continue;
+        m_particles.push_back( particle );
+        m_trackIDs.push_back( trackID );
+    }
+
+    // with dense track IDs, a direct table is affordable
+    if ( !m_trackIDs.empty() ) {
+        std::size_t const range = 1 + static_cast<std::size_t>
+          ( m_trackIDs.back() - m_trackIDs.front() );
+        if ( range <= 2 * m_trackIDs.size() ) {
+            m_denseOffset = m_trackIDs.front();
+            m_denseIndex.assign( range, NoIndex );
+            for ( Index_t i = 0; i < m_trackIDs.size(); ++i )
+                m_denseIndex[m_trackIDs[i] - m_denseOffset] = i;
+        }
+    }
+
+    BuildParents( list );
+    BuildTour();
+}
+
+//----------------------------------------------------------------------------
+void MCTruthParticleAncestry::BuildParents( const MCTruthParticleList& list )
+{
+    // same rule as MCTruthParticleHistory: the chain stops at primary
+    // particles and at mothers which are not live in the list
+    m_parents.resize( size() );
+    for ( Index_t i = 0; i < size(); ++i ) {
+        m_parents[i] = list.IsPrimary( m_trackIDs[i] )
+          ? NoIndex: IndexOf( m_particles[i]->Mother() );
+    }
+}
+
+//----------------------------------------------------------------------------
+void MCTruthParticleAncestry::BuildTour()
+{
+    std::size_t const n = size();
+
+    // children of each particle, in a single array (by parent index)
+    std::vector<Index_t> firstChild( n + 1, 0 );
+    for ( Index_t const parent: m_parents )
+        if ( parent != NoIndex ) ++firstChild[parent + 1];
+    for ( Index_t i = 0; i < n; ++i ) firstChild[i + 1] += firstChild[i];
+    std::vector<Index_t> children( firstChild[n] );
+    {
+        std::vector<Index_t> next( firstChild.begin(), firstChild.end() - 1 );
+        for ( Index_t i = 0; i < n; ++i )
+            if ( m_parents[i] != NoIndex ) children[next[m_parents[i]]++] = i;
+    }
+
+    // depth-first visit, without recursion; the stack holds the particle
+    // and the next of its children to be visited
+    m_depths.assign( n, 0U );
+    m_enter.assign( n, NoIndex );
+    m_exit.assign( n, NoIndex );
+    std::vector<std::pair<Index_t, Index_t>> stack;
+    Index_t time = 0;
+    auto visitTree = [&]( Index_t root )
+    {
+        m_enter[root] = time++;
+        stack.emplace_back( root, firstChild[root] );
+        while ( !stack.empty() ) {
+            auto& [ index, nextChild ] = stack.back();
+            if ( nextChild == firstChild[index + 1] ) {
+                m_exit[index] = time++;
+                stack.pop_back();
+                continue;
+            }
+            Index_t const child = children[nextChild++];
+            if ( m_enter[child] != NoIndex ) continue; // only after a cut
+            m_depths[child] = m_depths[index] + 1;
+            m_enter[child] = time++;
+            stack.emplace_back( child, firstChild[child] );
+        }
+    };
+
+    for ( Index_t i = 0; i < n; ++i )
+        if ( m_parents[i] == NoIndex ) visitTree( i );
+
+    // particles not reached are in a loop of mothers (broken input);
+    // the loop is cut, and each becomes a tree on its own
+    for ( Index_t i = 0; i < n; ++i ) {
+        if ( m_enter[i] != NoIndex ) continue;
+        m_parents[i] = NoIndex;
+        visitTree( i );
+    }
+}
+
+//----------------------------------------------------------------------------
+MCTruthParticleAncestry::Index_t MCTruthParticleAncestry::IndexOf
+  ( int trackID ) const
+{
+    trackID = std::abs( trackID ); // as in the list
+    if ( !m_denseIndex.empty() ) {
+        if ( trackID < m_denseOffset ) return NoIndex;
+        std::size_t const key = trackID - m_denseOffset;
+        return ( key < m_denseIndex.size() )? m_denseIndex[key]: NoIndex;
+    }
+    auto const it
+      = std::lower_bound( m_trackIDs.begin(), m_trackIDs.end(), trackID );
+    return ( ( it == m_trackIDs.end() ) || ( *it != trackID ) )
+      ? NoIndex: static_cast<Index_t>( it - m_trackIDs.begin() );
+}
+
+//----------------------------------------------------------------------------
+MCTruthParticleAncestry::Index_t MCTruthParticleAncestry::Root
+  ( Index_t index ) const
+{
+    while ( m_parents[index] != NoIndex ) index = m_parents[index];
+    return index;
+}
+
+//----------------------------------------------------------------------------
+bool MCTruthParticleAncestry::IsAncestor
+  ( int ancestorID, int descendantID ) const
+{
+    Index_t const ancestor = IndexOf( ancestorID );
+    if ( ancestor == NoIndex ) return false;
+    Index_t const descendant = IndexOf( descendantID );
+    if ( descendant == NoIndex ) return false;
+    return IsAncestorIndex( ancestor, descendant );
+}
+
+//----------------------------------------------------------------------------
+void MCTruthParticleAncestry::FillHistory
+  ( int trackID, std::vector<const simb::MCParticle*>& history ) const
+{
+    history.clear();
+    Index_t index = IndexOf( trackID );
+    if ( index == NoIndex ) return;
+
+    // filled from the end, root first
+    history.resize( m_depths[index] + 1 );
+    for ( auto it = history.rbegin(); it != history.rend(); ++it ) {
+        *it = m_particles[index];
+        index = m_parents[index];
+    }
+}
+
+//----------------------------------------------------------------------------
+void MCTruthParticleAncestry::FillHistoryIndices
+  ( Index_t index, std::vector<Index_t>& history ) const
+{
+    history.resize( m_depths[index] + 1 );
+    for ( auto it = history.rbegin(); it != history.rend(); ++it ) {
+        *it = index;
+        index = m_parents[index];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+} // namespace truth
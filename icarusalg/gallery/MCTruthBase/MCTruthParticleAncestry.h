@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  MCTruthParticleAncestry.h
+/// \brief Production history of all the particles in a MCTruthParticleList.
+///
+/// \author  Gianluca Petrillo (petrillo@slac.stanford.edu)
+/// \date    October 15, 2026
+////////////////////////////////////////////////////////////////////////
+///
+/// MCTruthParticleHistory follows the chain of mothers of a single
+/// particle, and it fills a new deque each time. When the history of
+/// every particle of the event is needed, this class does the same job
+/// at once: it is built once per event from the particle list, and
+/// then it answers queries on any particle without further allocation.
+///
+/// The particles of the list are arranged in a forest, where the parent
+/// of each particle is the particle that would precede it in its
+/// MCTruthParticleHistory: primary particles, and particles whose
+/// mother is not a live particle of the list, are roots. Each particle
+/// is assigned an index (in track ID order), and the forest is stored
+/// in flat arrays indexed by it:
+///
+/// - the index of the parent (`NoIndex` for roots);
+/// - the depth in the tree (`0` for roots);
+/// - the entry and exit position in a depth-first visit of the forest
+///   (Euler tour): particle A is in the history of particle B if and
+///   only if the visit of B is nested inside the visit of A, which is
+///   checked in constant time.
+///
+/// Example:
+///
+///     truth::MCTruthParticleList const& particleList = // ...
+///     truth::MCTruthParticleAncestry const ancestry{ particleList };
+///
+///     if ( ancestry.IsAncestor( 2, 343 ) ) { ... } // constant time
+///
+///     std::vector<const simb::MCParticle*> history; // reused
+///     for ( int trackID: trackIDs ) {
+///       ancestry.FillHistory( trackID, history );
+///       // history[0] is the root, history.back() the particle itself,
+///       // as in MCTruthParticleHistory
+///     }
+///
+/// Queries by track ID look up the index of the particle first, which
+/// takes constant time if the track IDs are dense, logarithmic time
+/// otherwise. Queries by index always take constant time (or time
+/// proportional to the depth, for the history).
+///
+/// As for MCTruthParticleHistory, the ancestry refers to the particles
+/// of the list: it must be built again when the list changes, and it
+/// becomes invalid when the list is destroyed.
+
+#ifndef TRUTH_MCTruthParticleAncestry_H
+#define TRUTH_MCTruthParticleAncestry_H
+
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t
+
+namespace simb { class MCParticle; }
+
+namespace truth {
+
+// Forward declaration
+class MCTruthParticleList;
+
+class MCTruthParticleAncestry
+{
+public:
+
+    using Index_t = std::size_t; ///< Type of particle index.
+
+    /// Index of no particle.
+    static constexpr Index_t NoIndex = std::numeric_limits<Index_t>::max();
+
+    /// Builds the ancestry of all the live particles in `list`.
+    explicit MCTruthParticleAncestry( const MCTruthParticleList& list );
+
+    /// Returns the number of particles.
+    std::size_t size() const { return m_particles.size(); }
+
+    /// Returns whether there is no particle.
+    bool empty() const { return m_particles.empty(); }
+
+    // --- BEGIN -- Queries by index -------------------------------------------
+    /// Returns the index of the particle with `trackID` (`NoIndex` if none).
+    Index_t IndexOf( int trackID ) const;
+
+    /// Returns the particle with index `index`.
+    const simb::MCParticle* Particle( Index_t index ) const
+    { return m_particles[index]; }
+
+    /// Returns the track ID of the particle with index `index`.
+    int TrackId( Index_t index ) const { return m_trackIDs[index]; }
+
+    /// Returns the index of the parent of `index` (`NoIndex` for a root).
+    Index_t Parent( Index_t index ) const { return m_parents[index]; }
+
+    /// Returns the number of ancestors of `index` (`0` for a root).
+    unsigned int Depth( Index_t index ) const { return m_depths[index]; }
+
+    /// Returns the index of the root of the history of `index`.
+    Index_t Root( Index_t index ) const;
+
+    /// Returns whether `ancestor` is in the history of `descendant`
+    /// (a particle is in its own history).
+    bool IsAncestorIndex( Index_t ancestor, Index_t descendant ) const
+    {
+        return (m_enter[ancestor] <= m_enter[descendant])
+            && (m_exit[descendant] <= m_exit[ancestor]);
+    }
+    // --- END ---- Queries by index -------------------------------------------
+
+    // --- BEGIN -- Queries by track ID ----------------------------------------
+    /// Returns whether there is a particle with `trackID`.
+    bool HasParticle( int trackID ) const
+    { return IndexOf( trackID ) != NoIndex; }
+
+    /// Returns whether `ancestorID` is in the history of `descendantID`;
+    /// `false` if either particle is unknown.
+    bool IsAncestor( int ancestorID, int descendantID ) const;
+
+    /// Fills `history` with the particles in the history of `trackID`,
+    /// in the same order as MCTruthParticleHistory (root first, the
+    /// particle itself last); empty if the particle is unknown.
+    /// The content of `history` is replaced, but its memory is reused.
+    void FillHistory
+      ( int trackID, std::vector<const simb::MCParticle*>& history ) const;
+
+    /// Fills `history` with the indices of the history of `index`, in the
+    /// same order as FillHistory().
+    void FillHistoryIndices
+      ( Index_t index, std::vector<Index_t>& history ) const;
+    // --- END ---- Queries by track ID ----------------------------------------
+
+private:
+    std::vector<const simb::MCParticle*> m_particles; ///< Particle by index.
+    std::vector<int>          m_trackIDs; ///< Track ID by index (sorted).
+    std::vector<Index_t>      m_parents;  ///< Parent index by index.
+    std::vector<unsigned int> m_depths;   ///< Depth by index.
+    std::vector<Index_t>      m_enter;    ///< Start of the visit by index.
+    std::vector<Index_t>      m_exit;     ///< End of the visit by index.
+
+    /// Index by track ID (minus `m_denseOffset`), if track IDs are dense.
+    std::vector<Index_t>      m_denseIndex;
+    int                       m_denseOffset = 0; ///< ID of first dense entry.
+
+    /// Fills the parent of each particle.
+    void BuildParents( const MCTruthParticleList& list );
+
+    /// Visits the forest filling depths and visit times.
+    void BuildTour();
+};
+
+} // namespace truth
+
+#endif // TRUTH_MCTruthParticleAncestry_H
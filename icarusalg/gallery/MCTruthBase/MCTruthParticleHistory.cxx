@@ -19,12 +19,12 @@ MCTruthParticleHistory::MCTruthParticleHistory( const MCTruthParticleList* list,
     : m_particleList(list)
     , m_trackID(trackID)
 {
-    // Look for the track in the particle list.
-    MCTruthParticleList::const_iterator search = m_particleList->find( m_trackID );
+    // Look for the track in the particle list
+    // (through its lookup table, if it was built).
+    const simb::MCParticle* particle = m_particleList->FindParticle( m_trackID );
 
     // While we're still finding particles in the chain...
-    while ( search != m_particleList->end() ){
-        const simb::MCParticle* particle = (*search).second;
+    while ( particle ){
         push_front( particle );
       
         // If this is a primary particle, we're done.
@@ -33,7 +33,7 @@ MCTruthParticleHistory::MCTruthParticleHistory( const MCTruthParticleList* list,
       
         // Now look for the parent of this particle.
         int parentID = particle->Mother();
-        search = m_particleList->find( parentID );
+        particle = m_particleList->FindParticle( parentID );
       
     } // while we're finding particles in the chain
 }
@@ -81,6 +81,10 @@
 /// simulation cuts. The first element just represents as far back we
 /// can go in the production chain given the ParticleList.
 
+/// When the history of many particles of the same event is needed,
+/// MCTruthParticleAncestry builds it for all of them at once, and it
+/// answers "is A an ancestor of B" in constant time.
+
 #ifndef TRUTH_MCTruthParticleHistory_H
 #define TRUTH_MCTruthParticleHistory_H
 
@@ -26,6 +26,7 @@
 #include <TLorentzVector.h>
 
 #include <set>
+#include <stdexcept> // std::out_of_range
 // #include <iterator>
 //#include <cmath>
 // #include <memory>
@@ -115,6 +116,10 @@ MCTruthParticleList::mapped_type MCTruthParticleList::Particle( const size_type
 //----------------------------------------------------------------------------
 bool MCTruthParticleList::IsPrimary( int trackID ) const
 {
+    if (m_lookupValid) {
+        lookup_entry_type const* entry = FindLookupEntry(trackID);
+        if (entry) return entry->primary;
+    }
     return m_primaries.find( trackID )  !=  m_primaries.end();
 }
 
@@ -258,6 +263,8 @@ std::vector<const simb::MCParticle*> MCTruthParticleList::GetPrimaries() const
 //  - If it's a primary particle, add it to the list of primaries.
 void MCTruthParticleList::insert( const simb::MCParticle* particle )
 {
+    InvalidateLookupTable();
+    
     int trackID = key(particle);
     iterator insertion = m_MCTruthParticleList.lower_bound( trackID );
     if ( insertion == m_MCTruthParticleList.end() )
@@ -291,6 +298,12 @@ void MCTruthParticleList::Archive( const key_type& key )
      // dispose of the particle in the list (the cell will still be there
      delete part;
      part = nullptr;
+     
+     // the table entry is still there too, just without the particle
+     if (m_lookupValid) {
+         lookup_entry_type const* entry = FindLookupEntry(key);
+         if (entry) m_lookup[entry - m_lookup.data()].particle = nullptr;
+     }
 } // MCTruthParticleList::Archive()
   
   
@@ -303,6 +316,11 @@ void MCTruthParticleList::Archive( const mapped_type& part )
 //----------------------------------------------------------------------------
 int MCTruthParticleList::GetMotherOf( const key_type& key ) const
 {
+     if (m_lookupValid) {
+         lookup_entry_type const* entry = FindLookupEntry(key);
+         if (!entry) throw std::out_of_range("MCTruthParticleList::GetMotherOf(): unknown track ID");
+         return entry->mother;
+     }
      auto part = m_MCTruthParticleList.at(key);
      return part? part->Mother(): m_archive.at(key).Mother();
 } // MCTruthParticleList::GetMotherOf()
@@ -310,6 +328,7 @@ int MCTruthParticleList::GetMotherOf( const key_type& key ) const
 //----------------------------------------------------------------------------
 void MCTruthParticleList::clear()
 {
+    InvalidateLookupTable();
     m_MCTruthParticleList.clear();
     m_archive.clear();
     m_primaries.clear();
@@ -319,6 +338,7 @@ void MCTruthParticleList::clear()
 // An erase that includes the deletion of the associated Particle*.
 MCTruthParticleList::iterator MCTruthParticleList::erase( iterator position )
 {
+    InvalidateLookupTable();
     delete position->second;
     return m_MCTruthParticleList.erase( position );
 }
@@ -332,6 +352,51 @@ MCTruthParticleList::size_type MCTruthParticleList::erase( const key_type& key )
 }
 
 
+//----------------------------------------------------------------------------
+void MCTruthParticleList::BuildLookupTable()
+{
+    InvalidateLookupTable();
+    
+    if (!m_MCTruthParticleList.empty()) {
+        // the map is sorted: the first and last entries are the extremes
+        long long const minID = m_MCTruthParticleList.begin()->first;
+        long long const maxID = m_MCTruthParticleList.rbegin()->first;
+        long long const span = maxID - minID + 1;
+        
+        // a direct table is used if no more than about 3/4 of it are holes
+        m_lookupDense = (span <= 4LL * static_cast<long long>(m_MCTruthParticleList.size()));
+        m_lookupOffset = static_cast<int>(minID);
+        if (m_lookupDense) m_lookup.resize(span);
+        else               m_lookup.reserve(m_MCTruthParticleList.size());
+        
+        for (auto const& [ trackID, part ]: m_MCTruthParticleList) {
+            lookup_entry_type entry;
+            entry.trackID  = trackID;
+            entry.particle = part;
+            entry.mother   = part? part->Mother(): m_archive.at(trackID).Mother();
+            entry.known    = true;
+            entry.primary  = m_primaries.count(trackID) > 0;
+            
+            if (m_lookupDense) m_lookup[trackID - minID] = entry;
+            else               m_lookup.push_back(entry);
+        }
+    }
+    
+    m_lookupValid = true;
+} // MCTruthParticleList::BuildLookupTable()
+
+//----------------------------------------------------------------------------
+std::size_t MCTruthParticleList::MemoryUsage() const
+{
+    // a node of a (libstdc++) red-black tree has a colour and three pointers
+    constexpr std::size_t NodeOverhead = 4 * sizeof(void*);
+    
+    return m_MCTruthParticleList.size() * ( NodeOverhead + sizeof(list_type::value_type) )
+         + m_primaries.size()           * ( NodeOverhead + sizeof(primaries_type::value_type) )
+         + m_archive.size()             * ( NodeOverhead + sizeof(archive_type::value_type) )
+         + m_lookup.capacity()          * sizeof(lookup_entry_type);
+} // MCTruthParticleList::MemoryUsage()
+
 //----------------------------------------------------------------------------
 std::ostream& operator<< ( std::ostream& output, const MCTruthParticleList& list )
 {
@@ -367,8 +432,8 @@ std::ostream& operator<< ( std::ostream& output, const MCTruthParticleList& list
 }
 
 //----------------------------------------------------------------------------
-// The eve ID calculation.
-int MCTruthParticleList::EveId( const int trackID ) const
+// The eve ID calculator, ready to work on this list.
+MCTruthEveIdCalculator& MCTruthParticleList::PrepareEveIdCalculator() const
 {
     // If the eve ID calculator has never been initialized, use the
     // default method.
@@ -388,9 +453,23 @@ int MCTruthParticleList::EveId( const int trackID ) const
         m_eveIdCalculator->Init( this );
     }
     
+    return *m_eveIdCalculator;
+}
+
+//----------------------------------------------------------------------------
+// The eve ID calculation.
+int MCTruthParticleList::EveId( const int trackID ) const
+{
     // After the "bookkeeping" tests, here's where we actually do the
     // calculation.
-    return m_eveIdCalculator->CalculateEveId( trackID );
+    return PrepareEveIdCalculator().CalculateEveId( trackID );
+}
+
+//----------------------------------------------------------------------------
+// The eve ID calculation of all the particles at once.
+void MCTruthParticleList::ComputeAllEveIds( unsigned int nThreads /* = 1 */ ) const
+{
+    PrepareEveIdCalculator().ComputeAllEveIds( nThreads );
 }
 
 //----------------------------------------------------------------------------
@@ -109,6 +109,16 @@
 ///
 /// - Print() and operator<< methods for ROOT display and ease of
 ///   debugging.
+///
+/// - A flat lookup table can be built once the list is complete:
+///      truth::MCTruthParticleList MCTruthParticleList = // ...;
+///      MCTruthParticleList.BuildLookupTable();
+///   After that, HasParticle(), KnownParticle(), FindParticle(), IsPrimary()
+///   and GetMotherOf() take constant time when the track IDs are dense
+///   (a direct table indexed by track ID), logarithmic time on a sorted
+///   flat vector otherwise, rather than walking the map. The table is
+///   discarded when particles are added or removed, and it must be built
+///   again (archiving a particle keeps it up to date).
 
 #ifndef SIM_MCTruthParticleList_H
 #define SIM_MCTruthParticleList_H
@@ -118,6 +128,10 @@
 #include <memory>
 #include <ostream>
 #include <map>
+#include <set>
+#include <vector>
+#include <algorithm> // std::lower_bound()
+#include <utility> // std::swap()
 #include <cstdlib> // std::abs()
 
 namespace truth {
@@ -179,12 +193,39 @@ private:
                                     ///< primary particles.
     archive_type    m_archive;      ///< archive of the particles no longer among us
 
+    /// Information about one track ID in the flat lookup table.
+    struct lookup_entry_type {
+      int                     trackID  = 0;       ///< Track ID of this entry
+      const simb::MCParticle* particle = nullptr; ///< Live particle (or null)
+      int                     mother   = 0;       ///< Track ID of the mother
+      bool                    known    = false;   ///< Whether in the list at all
+      bool                    primary  = false;   ///< Whether a primary particle
+    }; // lookup_entry_type
+
+    /// Flat lookup table: indexed by track ID (minus `m_lookupOffset`) if
+    /// dense, sorted by track ID otherwise; empty if not built.
+    std::vector<lookup_entry_type> m_lookup;
+    int             m_lookupOffset = 0;     ///< Dense table: ID of first entry
+    bool            m_lookupDense  = false; ///< Whether table is dense
+    bool            m_lookupValid  = false; ///< Whether table is up to date
+
+    /// Returns the table entry of `trackID` if known, `nullptr` otherwise
+    /// (the lookup table must be valid).
+    const lookup_entry_type* FindLookupEntry( int trackID ) const;
+    
+    /// Discards the lookup table.
+    void InvalidateLookupTable() { m_lookupValid = false; m_lookup.clear(); }
+
     //----------------------------------------------------------------------------
     // variable for eve ID calculator. We're using an unique_ptr,
     // so when this object is eventually deleted (at the end of the job)
     // it will delete the underlying pointer.
     mutable std::unique_ptr<MCTruthEveIdCalculator> m_eveIdCalculator;
 
+    // Returns the eve ID calculator (the default one if none was adopted),
+    // initialized for this list.
+    MCTruthEveIdCalculator& PrepareEveIdCalculator() const;
+
 #ifndef __GCCXML__
 
 public:
@@ -219,13 +260,27 @@ public:
 
     /// Returns whether we have this particle, live (with full information)
     bool HasParticle( int trackID ) const
+    { return FindParticle(trackID) != nullptr; }
+    
+    /// Returns whether we have had this particle, archived or live
+    bool KnownParticle( int trackID ) const
     {
-        auto iParticle = find(trackID);
-        return (iParticle != end()) && (iParticle->second != nullptr);
+        if (m_lookupValid) return FindLookupEntry(std::abs(trackID)) != nullptr;
+        return find(trackID) != end();
     }
     
-    /// Returns whether we have had this particle, archived or live
-    bool KnownParticle( int trackID ) const { return find(trackID) != end(); }
+    /// Returns the live particle with this track ID, `nullptr` if none
+    const simb::MCParticle* FindParticle( int trackID ) const;
+    
+    /// Builds the flat lookup table of the particles currently in the list
+    void BuildLookupTable();
+    
+    /// Returns whether the flat lookup table is built and up to date
+    bool HasLookupTable() const { return m_lookupValid; }
+    
+    /// Returns an estimate of the memory allocated by the list [bytes]
+    /// (the particles themselves are not owned, and not included)
+    std::size_t MemoryUsage() const;
     
     bool IsPrimary( int trackID ) const;
     int NumberOfPrimaries() const;
@@ -301,6 +356,10 @@ public:
     // Methods associated with the eve ID calculation.
     // Calculate the eve ID.
     int EveId ( const int trackID ) const;
+    // Calculate the eve ID of all the particles in the list at once,
+    // with up to `nThreads` threads; EveId() then just looks them up.
+    // The list must not change in the meanwhile.
+    void ComputeAllEveIds( unsigned int nThreads = 1 ) const;
     // Set a pointer to a different eve ID calculation. The name
     // begins with "Adopt" because it accepts control of the ponters;
     // do NOT delete the pointer yourself if you use this method.
@@ -324,7 +383,9 @@ inline    truth::MCTruthParticleList::size_type              truth::MCTruthParti
 inline    bool truth::MCTruthParticleList::empty()                                       const { return m_MCTruthParticleList.empty();  }
 inline    void truth::MCTruthParticleList::Add(const simb::MCParticle* value)                  { insert(value);                  }
 inline    void truth::MCTruthParticleList::swap( truth::MCTruthParticleList& other )                         
-{ m_MCTruthParticleList.swap( other.m_MCTruthParticleList ); m_archive.swap( other.m_archive ); m_primaries.swap( other.m_primaries); }
+{ m_MCTruthParticleList.swap( other.m_MCTruthParticleList ); m_archive.swap( other.m_archive ); m_primaries.swap( other.m_primaries);
+  m_lookup.swap( other.m_lookup ); std::swap( m_lookupOffset, other.m_lookupOffset );
+  std::swap( m_lookupDense, other.m_lookupDense ); std::swap( m_lookupValid, other.m_lookupValid ); }
 inline    truth::MCTruthParticleList::iterator       truth::MCTruthParticleList::find(const truth::MCTruthParticleList::key_type& key)              
 { return m_MCTruthParticleList.find(abs(key));        }
 inline    truth::MCTruthParticleList::const_iterator truth::MCTruthParticleList::find(const truth::MCTruthParticleList::key_type& key)        const 
@@ -347,6 +408,30 @@ inline    truth::MCTruthParticleList::mapped_type const& truth::MCTruthParticleL
 { return at(key); }
 inline    truth::MCTruthParticleList::key_type truth::MCTruthParticleList::key(mapped_type const& part) const { return part->TrackId(); }
 
+inline    const truth::MCTruthParticleList::lookup_entry_type* truth::MCTruthParticleList::FindLookupEntry( int trackID ) const
+{
+    if (m_lookupDense) {
+        // unsigned arithmetic takes care of IDs below the offset as well
+        std::size_t const index = static_cast<unsigned int>(trackID) - static_cast<unsigned int>(m_lookupOffset);
+        if (index >= m_lookup.size()) return nullptr;
+        lookup_entry_type const& entry = m_lookup[index];
+        return entry.known? &entry: nullptr;
+    }
+    auto const iEntry = std::lower_bound(m_lookup.begin(), m_lookup.end(), trackID,
+      [](lookup_entry_type const& entry, int ID){ return entry.trackID < ID; });
+    return ((iEntry == m_lookup.end()) || (iEntry->trackID != trackID))? nullptr: &*iEntry;
+}
+
+inline    const simb::MCParticle* truth::MCTruthParticleList::FindParticle( int trackID ) const
+{
+    if (m_lookupValid) {
+        lookup_entry_type const* entry = FindLookupEntry(std::abs(trackID));
+        return entry? entry->particle: nullptr;
+    }
+    auto iParticle = find(trackID);
+    return (iParticle != end())? iParticle->second: nullptr;
+}
+
 
 #endif
 
@@ -11,11 +11,15 @@
 #define ICARUSALG_GALLERY_DETECTORACTIVITYRATEPLOTS_BINNER_H
 
 
+// C++ core guideline library
+#include "gsl/span"
+
 // C/C++ standard libraries
 #include <ostream>
 #include <algorithm> // std::clamp()
 #include <utility> // std::declval()
 #include <cmath> // std::ceil(), std::floor()
+#include <cstddef> // std::size_t
 #include <cassert>
 
 
@@ -135,6 +139,12 @@ class util::Binner {
    *           `nBins()`, where bin `-1` includes all values smaller than
    *           `lower()` and bin `nBins()` includes all values larger or equal
    *           to `upper()`
+   * * bin indices for many values at once: `binIndices()` (as `bin()`) and
+   *   `cappedBinIndicesWithOverflows()` (as `cappedBinWithOverflows()`);
+   *   these are computed in a simple loop using the reciprocal of the bin
+   *   width, which the compiler can vectorize; for values within rounding
+   *   error from a bin boundary, the result may differ from the one of the
+   *   single value queries.
    */
   /// @{
   
@@ -167,6 +177,18 @@ class util::Binner {
     { return cappedBin(value, -1, nBins()); }
   // @}
   
+  // @{
+  /// Stores in `indices` the bin number of each of the `values` (unbound).
+  void binIndices(gsl::span<Data_t const> values, gsl::span<int> indices) const;
+  // @}
+  
+  // @{
+  /// Stores in `indices` the bin number of each of the `values`, `-1` for
+  /// underflow or `nBins()` for overflow.
+  void cappedBinIndicesWithOverflows
+    (gsl::span<Data_t const> values, gsl::span<int> indices) const;
+  // @}
+  
   /// @}
   // -- END -- Bin index queries -----------------------------------------------
   
@@ -198,6 +220,13 @@ class util::Binner {
   unsigned int fNBins; ///< Number of bins in the range.
   Data_t fUpper; ///< Upper bound of the covered range.
   
+  /// Returns the value of `interval` in the unit of `Step_t`.
+  static double plainInterval(Step_t interval) { return interval / Step_t{ 1 }; }
+  
+  /// Returns the largest integer not larger than `value` (vectorizable).
+  static int floorToInt(double value)
+    { int const t = static_cast<int>(value); return t - (value < t); }
+  
 }; // util::Binner<>
 
 
@@ -213,6 +242,45 @@ util::Binner<T>::Binner(Data_t lower, Data_t upper, Step_t step)
   { assert(lower <= upper); }
 
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void util::Binner<T>::binIndices
+  (gsl::span<Data_t const> values, gsl::span<int> indices) const
+{
+  assert(indices.size() >= values.size());
+  
+  Data_t const lower = fLower;
+  double const invStep = 1.0 / plainInterval(fStep);
+  Data_t const* const value = values.data();
+  int* const index = indices.data();
+  std::size_t const n = values.size();
+  for (std::size_t i = 0; i < n; ++i)
+    index[i] = floorToInt(plainInterval(value[i] - lower) * invStep);
+  
+} // util::Binner<>::binIndices()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void util::Binner<T>::cappedBinIndicesWithOverflows
+  (gsl::span<Data_t const> values, gsl::span<int> indices) const
+{
+  assert(indices.size() >= values.size());
+  
+  Data_t const lower = fLower;
+  double const invStep = 1.0 / plainInterval(fStep);
+  double const maxBin = static_cast<double>(nBins());
+  Data_t const* const value = values.data();
+  int* const index = indices.data();
+  std::size_t const n = values.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    double const r = plainInterval(value[i] - lower) * invStep;
+    index[i] = floorToInt(std::clamp(r, -1.0, maxBin));
+  }
+  
+} // util::Binner<>::cappedBinIndicesWithOverflows()
+
+
 // -----------------------------------------------------------------------------
 template <typename T>
 std::ostream& util::operator<< (std::ostream& out, Binner<T> const& binner) {
@@ -17,7 +17,11 @@
 
 // SBN code
 #include "icarusalg/Utilities/ROOTutils.h" // util::ROOT::TDirectoryChanger
+#include "icarusalg/Utilities/Instrumentation.h" // ICARUS_SCOPED_TIMER()
 #include "icarusalg/gallery/helpers/C++/expandInputFiles.h"
+#include "icarusalg/gallery/helpers/C++/InputFileManifest.h"
+#include "icarusalg/gallery/helpers/C++/EventIndex.h"
+#include "icarusalg/gallery/helpers/C++/SelectedEventLoop.h"
 
 // LArSoft
 // - data products
@@ -52,16 +56,20 @@
 #include "lardataalg/Utilities/quantities/energy.h" // megaelectronvolt
 #include "lardataalg/Utilities/quantities/electronics.h" // tick, ticks
 #include "lardataalg/Utilities/quantities/spacetime.h" // microseconds, ...
-#include "larcorealg/CoreUtils/enumerate.h"
 
 // gallery/canvas
 #include "gallery/Event.h"
 #include "canvas/Utilities/InputTag.h"
+#include "canvas/Persistency/Provenance/EventID.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "fhiclcpp/types/Table.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/ParameterSet.h"
 
+// TBB
+#include "tbb/task_arena.h"
+#include "tbb/parallel_for.h"
+
 // ROOT
 #include "TFile.h"
 #include "TDirectory.h"
@@ -80,7 +88,7 @@
 
 // #if !defined(__CLING__)
 // // these are needed in the main() function
-#include <algorithm> // std::copy()
+#include <algorithm> // std::copy(), std::fill()
 #include <iterator> // std::back_inserter()
 // #include <iostream> // std::cerr
 // #endif // !__CLING__
@@ -175,9 +183,57 @@ class PlotDetectorActivityRates {
     BinConfig<electronics_tick> TPCBinning;
     BinConfig<trigger_time> opDetBinning;
     
+    unsigned int nThreads = 1U; ///< Threads for processing channels.
+    
   }; // AlgorithmConfiguration
   
   
+  /// Content of a time profile for one event, indexed as ROOT bins.
+  struct ProfileBuffer_t {
+    
+    std::vector<double> binCenters; ///< Center of each bin (with overflows).
+    std::vector<double> content; ///< Content of each bin in this event.
+    
+    /// Prepares for the bins of `binner`, plus underflow and overflow.
+    template <typename T>
+    void setup(util::Binner<T> const& binner);
+    
+    /// Sets the content of all the bins to `0`.
+    void clear() { std::fill(content.begin(), content.end(), 0.0); }
+    
+    /// Adds `1` to each of the `bins` (`-1` is underflow, as from `Binner`).
+    void add(std::vector<int> const& bins);
+    
+    /// Adds `weights[i]` to each bin `bins[i]` (`-1` is underflow).
+    void add(std::vector<int> const& bins, std::vector<double> const& weights);
+    
+    /// Returns the sum of the content of all bins.
+    double total() const
+      { return std::accumulate(content.cbegin(), content.cend(), 0.0); }
+    
+    /// Adds the content of each bin as one entry of the same bin of `profile`.
+    void fillInto(TProfile& profile) const
+      {
+        profile.FillN(static_cast<int>(content.size()),
+          binCenters.data(), content.data(), nullptr);
+      }
+    
+  }; // ProfileBuffer_t
+  
+  
+  /// Buffers for binning the items of one chunk of channels.
+  template <typename Time>
+  struct ChunkBuffer_t {
+    std::vector<Time> times; ///< Time of each item.
+    std::vector<double> weights; ///< Weight of each item (empty: all `1`).
+    std::vector<int> bins; ///< Bin index of each item.
+    ProfileBuffer_t profile; ///< Content from this chunk (no bin centers).
+  }; // ChunkBuffer_t
+  
+  /// Number of channels processed together, independently of the threads.
+  static constexpr std::size_t ChannelChunkSize = 1024U;
+  
+  
   // --- BEGIN -- Data members -------------------------------------------------
   
   // ----- BEGIN -- Configuration ----------------------------------------------
@@ -220,6 +276,27 @@ class PlotDetectorActivityRates {
   /// Statistics of the total light (photoelectron count) per event.
   lar::util::StatCollector<unsigned int> fPhotonStats;
   
+  
+  // ----- BEGIN -- Per-event buffers ------------------------------------------
+  // reused in all events, so that no memory is allocated after the first ones
+  ProfileBuffer_t fEDepBuffer; ///< Deposited energy per time bin [MeV].
+  ProfileBuffer_t fTPCchargeBuffer; ///< Ionization electrons per tick bin.
+  ProfileBuffer_t fPhotonBuffer; ///< Photoelectrons per time bin.
+  
+  std::vector<simulation_time> fSimTimes; ///< Times of energy deposits.
+  std::vector<double> fWeights; ///< Weight of each binned item.
+  std::vector<int> fBins; ///< Bin index of each binned item.
+  
+  /// Buffers for each chunk of TPC channels.
+  std::vector<ChunkBuffer_t<electronics_tick>> fTPCchunks;
+  
+  /// Buffers for each chunk of optical detector channels.
+  std::vector<ChunkBuffer_t<trigger_time>> fOpDetChunks;
+  // ----- END -- Per-event buffers --------------------------------------------
+  
+  /// Threads processing the chunks of channels (none if sequential).
+  std::unique_ptr<tbb::task_arena> fArena;
+  
 
   // --- END -- Data members ---------------------------------------------------
   
@@ -270,6 +347,14 @@ class PlotDetectorActivityRates {
       Comment{ "input tag for simulated optical detector channel data product" },
       "largeant"
       };
+    fhicl::Atom<unsigned int> Threads {
+      Name{ "Threads" },
+      Comment{
+        "number of threads processing the channels of each event"
+        " (results do not depend on it)"
+        },
+      1U
+      };
     
     fhicl::Table<BinningConfig<millisecond, milliseconds>> SimBinning {
       Name{ "SimulationBinning" },
@@ -408,6 +493,26 @@ class PlotDetectorActivityRates {
   /// Plots data from photoelectron collection.
   void plotPhotons(std::vector<sim::SimPhotons> const& photonChannels);
   
+  /**
+   * @brief Bins in `result` all the items of all the `channels`.
+   * @param channels the channels to be processed
+   * @param binner the binning of the item times
+   * @param chunks buffers for each chunk of channels
+   * @param[out] result where the content of all the bins is stored
+   * @param collect `collect(channel, times, weights)` adds the items of a channel
+   * 
+   * The channels are split in chunks of `ChannelChunkSize`, each binned on its
+   * own (in parallel with multiple threads). The content of the chunks is then
+   * merged in a fixed order, so that the result does not depend on the number
+   * of threads nor on their scheduling.
+   */
+  template <typename Channels, typename Time, typename Collect>
+  void binChannelChunks(
+    Channels const& channels, util::Binner<Time> const& binner,
+    std::vector<ChunkBuffer_t<Time>>& chunks, ProfileBuffer_t& result,
+    Collect collect
+    );
+  
   // --- END -- Plots ----------------------------------------------------------
   
   
@@ -429,7 +534,10 @@ PlotDetectorActivityRates::PlotDetectorActivityRates
   , fSimBinner{ makeBinning<simulation_time>(fConfig.simBinning) }
   , fTPCBinner{ makeBinning<electronics_tick>(fConfig.TPCBinning) }
   , fOpDetBinner{ makeBinning<trigger_time>(fConfig.opDetBinning) }
-  {}
+{
+  if (fConfig.nThreads > 1U)
+    fArena = std::make_unique<tbb::task_arena>(fConfig.nThreads);
+} // PlotDetectorActivityRates::PlotDetectorActivityRates()
 
 
 auto PlotDetectorActivityRates::parseAlgorithmConfiguration
@@ -439,6 +547,7 @@ auto PlotDetectorActivityRates::parseAlgorithmConfiguration
   algConfig.edepTag = pset.get<art::InputTag>("Deposits", "largeant");
   algConfig.chanTag = pset.get<art::InputTag>("TPCchannels", "largeant");
   algConfig.photTag = pset.get<art::InputTag>("OpDetChannels", "largeant");
+  algConfig.nThreads = pset.get<unsigned int>("Threads", 1U);
   
   parseBinning
     (algConfig.simBinning, pset.get<fhicl::ParameterSet>("SimBinning"));
@@ -458,6 +567,7 @@ auto PlotDetectorActivityRates::parseValidatedAlgorithmConfiguration
   algConfig.edepTag = config.Deposits();
   algConfig.chanTag = config.TPCchannels();
   algConfig.photTag = config.OpDetChannels();
+  algConfig.nThreads = config.Threads();
   parseAndValidateBinning(algConfig.simBinning, config.SimBinning());
   parseAndValidateBinning(algConfig.TPCBinning, config.TPCBinning());
   parseAndValidateBinning(algConfig.opDetBinning, config.OpDetBinning());
@@ -541,6 +651,7 @@ void PlotDetectorActivityRates::initializeEnergyDepositPlots() {
     ).c_str(),
     fSimBinner.nBins(), fSimBinner.lower().value(), fSimBinner.upper().value()
     );
+  fEDepBuffer.setup(fSimBinner);
   
 } // PlotDetectorActivityRates::initializeEnergyDepositPlots()
 
@@ -564,6 +675,7 @@ void PlotDetectorActivityRates::initializeTPCionizationPlots() {
     ).c_str(),
     fTPCBinner.nBins(), fTPCBinner.lower().value(), fTPCBinner.upper().value()
     );
+  fTPCchargeBuffer.setup(fTPCBinner);
   
 } // PlotDetectorActivityRates::initializeTPCionizationPlots()
 
@@ -581,6 +693,7 @@ void PlotDetectorActivityRates::initializePhotonPlots() {
     fOpDetBinner.nBins(),
     fOpDetBinner.lower().value(), fOpDetBinner.upper().value()
     );
+  fPhotonBuffer.setup(fOpDetBinner);
   
 } // PlotDetectorActivityRates::initializePhotonPlots()
 
@@ -599,6 +712,7 @@ void PlotDetectorActivityRates::setupEvent(
 template <typename Event>
 void PlotDetectorActivityRates::plotEvent(Event const& event) {
   assert(fDetTimings); // setupEvent() should have taken care of this
+  ICARUS_SCOPED_TIMER("PlotDetectorActivityRates::plotEvent");
   
   //
   // energy depositions
@@ -650,6 +764,7 @@ void PlotDetectorActivityRates::printConfig(Stream&& out) const {
     << "\n   - simulation:              " << fSimBinner
     << "\n   - TPC:                     " << fTPCBinner
     << "\n   - optical detectors:       " << fOpDetBinner
+    << "\n * channel threads:           " << fConfig.nThreads
     << "\n"
     ;
   
@@ -680,32 +795,22 @@ void PlotDetectorActivityRates::printTimingSummary(Stream&& out) const {
 void PlotDetectorActivityRates::plotEnergyDeposits
   (std::vector<sim::SimEnergyDeposit> const& energyDeps)
 {
-  // funny fact: this method modifies the plot content but does not modify the
-  // plot object pointer, so we can declare it const.
-  
-  // shifted by 1 ([0] is underflow, ROOT standard)
-  std::vector<EDepUnit_t> counters(fSimBinner.nBins() + 2U, EDepUnit_t{ 0.0 });
-  
-  // all channels are aggregated together
+  // all the times are binned at once
+  fSimTimes.clear();
+  fWeights.clear();
   for (sim::SimEnergyDeposit const& edep: energyDeps) {
-    
-    simulation_time const time { edep.Time() };
-    
-    int const timeBin = fSimBinner.cappedBinWithOverflows(time);
-    assert(timeBin + 1 < counters.size());
-    
-    EDepUnit_t const energy { edep.Energy() }; // explicit with the unit
-    
-    counters[timeBin + 1] += energy;
-    
-  } // for channels
-  
-  for (auto const [ iCount, count ]: util::enumerate(counters))
-    fEDepDistrib->Fill(fSimBinner.binCenter(iCount - 1).value(), count.value());
+    fSimTimes.emplace_back(edep.Time());
+    fWeights.push_back(edep.Energy()); // in EDepUnit_t
+  }
+  fBins.resize(fSimTimes.size());
+  fSimBinner.cappedBinIndicesWithOverflows(fSimTimes, fBins);
   
+  // all channels are aggregated together
+  fEDepBuffer.clear();
+  fEDepBuffer.add(fBins, fWeights);
+  fEDepBuffer.fillInto(*fEDepDistrib);
   
-  EDepUnit_t const totalE
-    = std::accumulate(counters.cbegin(), counters.cend(), EDepUnit_t{ 0.0 });
+  EDepUnit_t const totalE { fEDepBuffer.total() };
   fEDepStats.add(totalE.value());
   
   mf::LogVerbatim("PlotDetectorActivityRates")
@@ -717,35 +822,32 @@ void PlotDetectorActivityRates::plotEnergyDeposits
 void PlotDetectorActivityRates::plotTPCionization
   (std::vector<sim::SimChannel> const& TPCchannels)
 {
-  // funny fact: this method modifies the plot content but does not modify the
-  // plot object pointer, so we can declare it const.
-
-  // shifted by 1 ([0] is underflow, ROOT standard)
-  std::vector<double> counters(fTPCBinner.nBins() + 2U, 0U);
+  // the charge of each TDC is summed directly from its IDE, in a single pass
+  // on the map (`SimChannel::Charge()` would look each TDC up again)
+  auto const collectCharge = [](
+    sim::SimChannel const& channel,
+    std::vector<electronics_tick>& ticks, std::vector<double>& charges
+    )
+    {
+      for (auto const& [ TDC, IDEs ]: channel.TDCIDEMap()) {
+        
+        double charge = 0.0;
+        for (sim::IDE const& ide: IDEs) charge += ide.numElectrons;
+        
+        // the TDC is filled by `LArVoxelReadout` with
+        // clockData.TPCClock().Ticks(clockData.G4ToElecTime(time))
+        ticks.emplace_back(TDC);
+        charges.push_back(charge);
+        
+      } // for all TDC
+    };
   
   // all channels are aggregated together
-  for (sim::SimChannel const& channel: TPCchannels) {
-    
-    for (auto const& [ TDC, IDEs ]: channel.TDCIDEMap()) {
-      
-      // the TDC is filled by `LArVoxelReadout` with
-      // clockData.TPCClock().Ticks(clockData.G4ToElecTime(time))
-      electronics_tick const tick { TDC };
-      
-      int const tickBin = fTPCBinner.cappedBinWithOverflows(tick);
-      assert(tickBin + 1 < counters.size());
-      
-      counters[tickBin + 1] += channel.Charge(TDC);
-      
-    } // for all TDC
-    
-  } // for channels
+  binChannelChunks
+    (TPCchannels, fTPCBinner, fTPCchunks, fTPCchargeBuffer, collectCharge);
+  fTPCchargeBuffer.fillInto(*fTPCchargeDistrib);
   
-  for (auto const [ iCount, count ]: util::enumerate(counters))
-    fTPCchargeDistrib->Fill(fTPCBinner.binCenter(iCount - 1).value(), count);
-  
-  double const totalElectrons
-    = std::accumulate(counters.cbegin(), counters.cend(), 0.0);
+  double const totalElectrons = fTPCchargeBuffer.total();
   fTPCchargeStats.add(totalElectrons);
   mf::LogVerbatim("PlotDetectorActivityRates")
     << "Detected " << totalElectrons
@@ -758,34 +860,23 @@ void PlotDetectorActivityRates::plotTPCionization
 void PlotDetectorActivityRates::plotPhotons
   (std::vector<sim::SimPhotons> const& photonChannels)
 {
-  // funny fact: this method modifies the plot content but does not modify the
-  // plot object pointer, so we can declare it const.
-  
-  // shifted by 1 ([0] is underflow, ROOT standard)
-  std::vector<unsigned int> counters(fOpDetBinner.nBins() + 2U, 0U);
+  detinfo::DetectorTimings const& detTimings = *fDetTimings;
+  auto const collectPhotons = [&detTimings](
+    sim::SimPhotons const& photons,
+    std::vector<trigger_time>& times, std::vector<double>& /* weights */
+    )
+    {
+      for (sim::OnePhoton const& photon: photons)
+        times.push_back(detTimings.toTriggerTime(simulation_time{ photon.Time }));
+    };
   
   // all channels are aggregated together
-  for (sim::SimPhotons const& photons: photonChannels) {
-    
-    for (sim::OnePhoton const& photon: photons) {
-      
-      simulation_time const time { photon.Time };
-      
-      int const timeBin
-        = fOpDetBinner.cappedBinWithOverflows(fDetTimings->toTriggerTime(time));
-      assert(timeBin + 1 < counters.size());
-      
-      ++counters[timeBin + 1];
-      
-    } // for photons in channel
-    
-  } // for channels
-  
-  for (auto const [ iCount, count ]: util::enumerate(counters))
-    fPhotonDistrib->Fill(fOpDetBinner.binCenter(iCount - 1).value(), count);
+  binChannelChunks
+    (photonChannels, fOpDetBinner, fOpDetChunks, fPhotonBuffer, collectPhotons);
+  fPhotonBuffer.fillInto(*fPhotonDistrib);
   
   unsigned int const totalPhotons
-    = std::accumulate(counters.cbegin(), counters.cend(), 0U);
+    = static_cast<unsigned int>(fPhotonBuffer.total());
   fPhotonStats.add(totalPhotons);
   
   mf::LogVerbatim("PlotDetectorActivityRates")
@@ -796,6 +887,60 @@ void PlotDetectorActivityRates::plotPhotons
 } // PlotDetectorActivityRates::plotPhotons()
 
 
+template <typename Channels, typename Time, typename Collect>
+void PlotDetectorActivityRates::binChannelChunks(
+  Channels const& channels, util::Binner<Time> const& binner,
+  std::vector<ChunkBuffer_t<Time>>& chunks, ProfileBuffer_t& result,
+  Collect collect
+) {
+  
+  std::size_t const nChannels = channels.size();
+  std::size_t const nChunks
+    = (nChannels + ChannelChunkSize - 1) / ChannelChunkSize;
+  if (chunks.size() < nChunks) chunks.resize(nChunks);
+  
+  auto const binChunk = [&](std::size_t iChunk)
+    {
+      ChunkBuffer_t<Time>& chunk = chunks[iChunk];
+      chunk.times.clear();
+      chunk.weights.clear();
+      std::size_t const end
+        = std::min((iChunk + 1) * ChannelChunkSize, nChannels);
+      for (std::size_t i = iChunk * ChannelChunkSize; i < end; ++i)
+        collect(channels[i], chunk.times, chunk.weights);
+      
+      chunk.bins.resize(chunk.times.size());
+      binner.cappedBinIndicesWithOverflows(chunk.times, chunk.bins);
+      
+      chunk.profile.content.assign(result.content.size(), 0.0);
+      if (chunk.weights.empty()) chunk.profile.add(chunk.bins);
+      else                       chunk.profile.add(chunk.bins, chunk.weights);
+    };
+  
+  if (fArena) {
+    fArena->execute([&binChunk,nChunks]()
+      { tbb::parallel_for(std::size_t{ 0 }, nChunks, binChunk); });
+  }
+  else {
+    for (std::size_t iChunk = 0; iChunk < nChunks; ++iChunk) binChunk(iChunk);
+  }
+  
+  // pairwise merge, always in the same order: { 0 + 1, 2 + 3, ... }, ...
+  for (std::size_t stride = 1; stride < nChunks; stride *= 2) {
+    for (std::size_t i = 0; i + stride < nChunks; i += 2 * stride) {
+      std::vector<double>& dest = chunks[i].profile.content;
+      std::vector<double> const& src = chunks[i + stride].profile.content;
+      for (std::size_t iBin = 0; iBin < dest.size(); ++iBin)
+        dest[iBin] += src[iBin];
+    } // for pairs
+  } // for strides
+  
+  if (nChunks > 0) result.content = chunks.front().profile.content;
+  else             result.clear();
+  
+} // PlotDetectorActivityRates::binChannelChunks()
+
+
 void PlotDetectorActivityRates::savePlots() {
   
   if (!fDestDir) return;
@@ -833,6 +978,43 @@ void PlotDetectorActivityRates::Serialize(std::unique_ptr<Plot>& plot) {
 } // PlotDetectorActivityRates::Serialize()
 
 
+template <typename T>
+void PlotDetectorActivityRates::ProfileBuffer_t::setup
+  (util::Binner<T> const& binner)
+{
+  // shifted by 1 ([0] is underflow, ROOT standard)
+  int const nBins = binner.nBins();
+  binCenters.resize(nBins + 2);
+  for (int iBin = -1; iBin <= nBins; ++iBin)
+    binCenters[iBin + 1] = binner.binCenter(iBin).value();
+  content.assign(binCenters.size(), 0.0);
+} // PlotDetectorActivityRates::ProfileBuffer_t::setup()
+
+
+void PlotDetectorActivityRates::ProfileBuffer_t::add
+  (std::vector<int> const& bins)
+{
+  double* const counts = content.data() + 1; // [-1] is the underflow
+  for (int const bin: bins) {
+    assert(bin + 1 < static_cast<int>(content.size()));
+    counts[bin] += 1.0;
+  }
+} // PlotDetectorActivityRates::ProfileBuffer_t::add()
+
+
+void PlotDetectorActivityRates::ProfileBuffer_t::add
+  (std::vector<int> const& bins, std::vector<double> const& weights)
+{
+  assert(weights.size() >= bins.size());
+  double* const counts = content.data() + 1; // [-1] is the underflow
+  std::size_t const n = bins.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    assert(bins[i] + 1 < static_cast<int>(content.size()));
+    counts[bins[i]] += weights[i];
+  }
+} // PlotDetectorActivityRates::ProfileBuffer_t::add(weights)
+
+
 // -----------------------------------------------------------------------------
 
 
@@ -888,8 +1070,20 @@ int makePlots
   
   // event loop options
   constexpr auto NoLimits = std::numeric_limits<unsigned int>::max();
-  unsigned int nSkip = analysisConfig.get("skipEvents", 0U);
+  unsigned int const nSkip = analysisConfig.get("skipEvents", 0U);
   unsigned int const maxEvents = analysisConfig.get("maxEvents", NoLimits);
+  
+  // explicit list of events, as [ run, subrun, event ] (overrides the above)
+  std::vector<art::EventID> selectedEvents;
+  for (auto const& id: analysisConfig.get<std::vector<std::vector<unsigned int>>>
+    ("events", {})
+  ) {
+    if (id.size() != 3) {
+      throw std::runtime_error
+        ("Each entry of `analysis.events` must be [ run, subrun, event ]");
+    }
+    selectedEvents.emplace_back(id[0], id[1], id[2]);
+  } // for
 
   /*
    * the preparation of input file list
@@ -898,6 +1092,38 @@ int makePlots
     throw std::runtime_error("Support for multiple input files not implemented yet!");
   }
   std::vector<std::string> const allInputFiles = expandInputFiles(inputFiles);
+  
+  /*
+   * selection of the entries to be processed: files and entries not selected
+   * are never read
+   */
+  std::vector<InputFileInfo> const manifest
+    = scanInputFiles(allInputFiles, 1U, !selectedEvents.empty());
+  for (InputFileInfo const& info: manifest) {
+    if (info.valid()) continue;
+    mf::LogWarning("makePlots")
+      << "Input file '" << info.path << "' skipped: " << info.error;
+  } // for
+  
+  std::vector<FileEntries> selection;
+  if (selectedEvents.empty()) {
+    selection = selectEntryRange(
+      manifest, nSkip,
+      (maxEvents == NoLimits)? -1: static_cast<long long int>(maxEvents)
+      );
+  }
+  else {
+    std::vector<art::EventID> missing;
+    selection = EventIndex{ manifest }.select(selectedEvents, &missing);
+    for (art::EventID const& id: missing) {
+      mf::LogWarning("makePlots")
+        << "Requested event " << id << " not found in the input files.";
+    }
+  }
+  unsigned int const nSelected = std::accumulate(
+    selection.begin(), selection.end(), 0U,
+    [](unsigned int n, FileEntries const& file){ return n + file.entries.size(); }
+    );
 
   /*
    * other parameters
@@ -945,13 +1171,7 @@ int makePlots
   /*
    * the event loop
    */
-  for (gallery::Event event(allInputFiles); !event.atEnd(); event.next()) {
-    
-    if (nSkip > 0) { --nSkip; continue; }
-    if (numEvents >= maxEvents) {
-      mf::LogVerbatim("makePlots") << "Maximum number of events reached.";
-      break;
-    }
+  forEachSelectedEvent(selection, [&](gallery::Event const& event) {
     
     // *************************************************************************
     // ***  SINGLE EVENT PROCESSING BEGIN  *************************************
@@ -961,9 +1181,7 @@ int makePlots
     {
       mf::LogVerbatim log("makePlots");
       log << "This is event " << event.fileEntry() << "-" << event.eventEntry()
-        << " (" << numEvents;
-      if (maxEvents < NoLimits) log << "/" << maxEvents;
-      log << ")";
+        << " (" << numEvents << "/" << nSelected << ")";
     }
     
     {
@@ -979,10 +1197,14 @@ int makePlots
     // ***  SINGLE EVENT PROCESSING END    *************************************
     // *************************************************************************
 
-  } // for
+  }); // forEachSelectedEvent()
 
   plotAlg.finish();
   plotAlg.printTimingSummary(mf::LogVerbatim{"makePlots"} << "Once again:\n");
+#ifdef ICARUSALG_INSTRUMENTATION
+  icarus::ns::util::Instrumentation::global()
+    .dump(mf::LogVerbatim{"makePlots"} << "Instrumentation: ");
+#endif // ICARUSALG_INSTRUMENTATION
   
   return 0;
 } // makePlots()
@@ -7,12 +7,29 @@
  * The configuration requires:
  *  * `analysis` table configuring the job
  * 
+ * The output is controlled by the `OutputMode` configuration parameter:
+ *  * `Canvases` (default): a `TCanvas` for each group of waveforms, written
+ *    into a directory per event and waveform cluster of the ROOT output file;
+ *  * `Images`: the same canvases, drawn off screen and saved as image files
+ *    (format `ImageFormat`, e.g. `png` or `pdf`) in `ImageDirectory`, with
+ *    nothing written into the ROOT output file;
+ *  * `Data`: no drawing at all; the samples of each waveform and their
+ *    metadata (cluster, channel, times, baselines) are stored in a `TTree`
+ *    (`PMTwaveforms`) of the ROOT output file, one entry per waveform, from
+ *    which the plots can be rendered later on demand.
+ * 
  * Run the executable with no parameters for FHiCL configuration description
  * 
  */
 
 // SBN code
 #include "icarusalg/Utilities/ROOTutils.h" // util::ROOT::TDirectoryChanger
+#include "icarusalg/Utilities/LazyEventCache.h"
+#include "icarusalg/Utilities/TimeIntervalSet.h"
+#include "icarusalg/Utilities/QuantileCollector.h"
+#include "icarusalg/PMT/Algorithms/PMTreadoutSettingsConfig.h"
+#include "icarusalg/PMT/Algorithms/PMTreadoutSettings.h"
+#include "icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.h"
 #include "icarusalg/gallery/helpers/C++/expandInputFiles.h"
 
 // LArSoft
@@ -52,19 +69,28 @@
 #include "TH1.h"
 #include "TGraph.h"
 #include "TLine.h"
+#include "TTree.h"
+#include "TSystem.h" // gSystem
 #include "TROOT.h" // gROOT
 
 // C/C++ standard libraries
 #include <string>
 #include <numeric> // std::reduce(), std::transform_reduce()
 #include <vector>
-#include <map>
 #include <optional>
 #include <memory> // std::make_unique()
 #include <iostream> // std::cerr, std::endl
 #include <limits>
+#include <cstdint> // std::uint8_t
 #include <type_traits> // std::void_t
 #include <cmath> // std::round()
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <exception> // std::exception_ptr, std::current_exception()
+#include <utility> // std::move(), std::pair
 
 
 #if !defined(__CLING__)
@@ -86,45 +112,8 @@ using optical_time = detinfo::timescales::optical_time;
 // --- BEGIN -- Simple numeric algorithms --------------------------------------
 namespace {
   
-  /// Collects statistics, minimum and maximum, with reduced interface.
-  template <typename T, typename W = T>
-  class StatCollectorWithMinMaxAndMedian
-    : public lar::util::StatCollector<T,W>, public lar::util::MinMaxCollector<T>
-  {
-    std::vector<T> fData; // weights are ignored
-    
-      public:
-    
-    using Data_t = T;
-    using Weight_t = W;
-    using StatCollector_t = lar::util::StatCollector<Data_t, Weight_t>;
-    using MinMaxCollector_t = lar::util::MinMaxCollector<Data_t>;
-    
-    void add(Data_t value, Weight_t weight = { 1 })
-      {
-        StatCollector_t::add(value, weight);
-        MinMaxCollector_t::add(value);
-        fData.push_back(value);
-      }
-    
-    void clear()
-      { StatCollector_t::clear(); MinMaxCollector_t::clear(); fData.clear(); }
-    
-    Data_t median() { return extractMedian(fData); }
-    
-    Data_t median() const
-      { std::vector<Data_t> data{ fData }; return extractMedian(data); }
-    
-      private:
-    Data_t extractMedian(std::vector<Data_t>& data) const
-      {
-        std::sort(data.begin(), data.end());
-        std::size_t const middle = data.size()/2;
-        return (data.size() % 2 == 0) // deliberately throws if no data
-          ? (data.at(middle - 1) + data.at(middle)) / 2: data.at(middle);
-      }
-    
-  }; // StatCollectorWithMinMaxAndMedian()
+  /// Statistics of baselines of a channel.
+  using BaselineStats_t = icarus::ns::util::QuantileCollector<double>;
   
   
   template <typename Iter>
@@ -218,48 +207,115 @@ std::ostream& operator<< (std::ostream& out, ValueRange<T> const& range) {
 } // operator<< (ValueRange)
 
 
-/// Lookup of settings by channel number.
-template <typename Setting>
-class HWSettingMap {
-    public:
-  using Setting_t = Setting; ///< Type held by this setting map.
-  
-  /// Returns whether a value is available.
-  bool contains(raw::Channel_t channel) const
-    { return fValues.find(channel) != fValues.end(); } // C++20: `contains()`
+/// Returns a set with all the `ranges`; missing limits extend to "forever".
+template <typename T>
+icarus::ns::util::TimeIntervalSet<T> makeTimeIntervalSet
+  (std::vector<ValueRange<T>> const& ranges)
+{
+  using Limits_t = std::numeric_limits<typename T::value_t>;
+  T const beginning { Limits_t::lowest() }, forever { Limits_t::max() };
+  std::vector<icarus::ns::util::TimeInterval<T>> intervals;
+  for (ValueRange<T> const& range: ranges) {
+    intervals.emplace_back
+      (range.lower().value_or(beginning), range.upper().value_or(forever));
+  }
+  return icarus::ns::util::TimeIntervalSet<T>{ intervals };
+} // makeTimeIntervalSet()
+
+
+// --- END ---- Simple numeric algorithms --------------------------------------
+
+
+// --- BEGIN -- Threading utilities --------------------------------------------
+namespace {
   
-  /// Returns the value for the specified `channel`.
-  /// @throw std::out_of_range if not found
-  Setting_t const& operator() (raw::Channel_t channel) const
-    { return fValues.at(channel); }
+  /// Queue with a maximum size: `push()` waits for room, `pop()` for data.
+  template <typename T>
+  class BoundedQueue {
+    
+    std::deque<T> fData;
+    std::size_t const fMaxSize;
+    bool fClosed = false;
+    std::mutex fMutex;
+    std::condition_variable fNotFull;
+    std::condition_variable fNotEmpty;
+    
+      public:
+    
+    BoundedQueue(std::size_t maxSize)
+      : fMaxSize{ std::max(maxSize, std::size_t{ 1U }) } {}
+    
+    /// Adds an element, waiting until there is room for it.
+    void push(T value)
+      {
+        std::unique_lock lock { fMutex };
+        fNotFull.wait(lock, [this](){ return fData.size() < fMaxSize; });
+        fData.push_back(std::move(value));
+        fNotEmpty.notify_one();
+      }
+    
+    /// Extracts the next element into `value`; returns `false` if the queue
+    /// is closed and empty.
+    bool pop(T& value)
+      {
+        std::unique_lock lock { fMutex };
+        fNotEmpty.wait(lock, [this](){ return fClosed || !fData.empty(); });
+        if (fData.empty()) return false;
+        value = std::move(fData.front());
+        fData.pop_front();
+        fNotFull.notify_one();
+        return true;
+      }
+    
+    /// No more elements will be pushed.
+    void close()
+      {
+        std::lock_guard lock { fMutex };
+        fClosed = true;
+        fNotEmpty.notify_all();
+      }
+    
+  }; // BoundedQueue
   
-  /// Returns a copy of the value for the specified `channel`, or `defVal`.
-  Setting_t operator() (raw::Channel_t channel, Setting_t defVal) const
-    {
-      auto const it = fValues.find(channel);
-      return (it == fValues.end())? defVal: it->second;
-    }
   
-  /// Returns a pointer to the value for the specified `channel` or `nullptr`.
-  Setting_t const* get(raw::Channel_t channel) const
-    {
-      auto const it = fValues.find(channel);
-      return (it == fValues.end())? nullptr: &(it->second);
+  /// Runs `task(i)` for all `i` from `0` to `nTasks`, on `nThreads` threads
+  /// (including the calling one); the first exception is rethrown.
+  template <typename Task>
+  void runInParallel(std::size_t nTasks, unsigned int nThreads, Task task) {
+    
+    if ((nThreads <= 1U) || (nTasks <= 1U)) {
+      for (std::size_t i = 0; i < nTasks; ++i) task(i);
+      return;
     }
+    
+    std::atomic<std::size_t> nextTask { 0U };
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto worker = [&](unsigned int iThread)
+      {
+        try {
+          std::size_t i;
+          while ((i = nextTask++) < nTasks) task(i);
+        }
+        catch (...) {
+          errors[iThread] = std::current_exception();
+          nextTask = nTasks; // stop everybody
+        }
+      };
+    
+    std::vector<std::thread> threads;
+    for (unsigned int iThread = 1; iThread < nThreads; ++iThread)
+      threads.emplace_back(worker, iThread);
+    worker(0U);
+    for (std::thread& thread: threads) thread.join();
+    
+    for (std::exception_ptr const& error: errors)
+      if (error) std::rethrow_exception(error);
+    
+  } // runInParallel()
   
-  /// Sets or replaces a `value` for `channel`.
-  void set(raw::Channel_t channel, Setting_t value)
-    { fValues[channel] = std::move(value); }
-  
-    private:
-  
-  std::map<raw::Channel_t, Setting_t> fValues; ///< All settings.
-  
-}; // HWSettingMap<>
-
-
+} // local namespace
 
-// --- END ---- Simple numeric algorithms --------------------------------------
+// --- END ---- Threading utilities --------------------------------------------
 
 
 // --- BEGIN -- FHiCL interfaces -----------------------------------------------
@@ -325,6 +381,9 @@ class DrawPMTwaveforms {
       unsigned int nSamples = 0;
       
       bool doPrint = false; ///< Whether to print the value on screen.
+      
+      /// Resolution of the median of the baselines (`0`: exact).
+      double medianResolution = 0.0;
     }; // BaselineConfig
     
     
@@ -342,17 +401,55 @@ class DrawPMTwaveforms {
     
     std::vector<ValueRange<optical_time>> plotTimes;
     
-    /// Configured baselines per channel.
-    HWSettingMap<raw::ADC_Count_t> readoutBaselines;
-    /// Configured thresholds per channel.
-    HWSettingMap<raw::ADC_Count_t> readoutThresholds;
+    /// All `plotTimes` merged, for the selection.
+    icarus::ns::util::TimeIntervalSet<optical_time> plotTimeSet;
+    
+    /// Configured readout settings (baselines, thresholds...) per channel.
+    opdet::PMTreadoutSettings readoutSettings;
     
     float staggerFraction = 0.0;
     
     nanoseconds tickDuration;
     
+    /// Number of threads for baselines and plots (`1`: no parallel mode).
+    unsigned int nThreads = 1U;
+    
+    /// What to produce for each waveform cluster.
+    enum class OutputMode_t {
+      Canvases, ///< Canvases written into the ROOT output file.
+      Images,   ///< Canvases saved as image files.
+      Data      ///< Waveform samples and metadata in a tree, no canvas.
+    };
+    
+    OutputMode_t outputMode = OutputMode_t::Canvases; ///< Output mode.
+    
+    std::string imageFormat { "png" }; ///< Format of the images (`Images`).
+    
+    std::string imageDirectory { "." }; ///< Where to save the images.
+    
   }; // AlgorithmConfiguration
   
+  using OutputMode_t = AlgorithmConfiguration::OutputMode_t;
+  
+  /// Content of an entry of the waveform tree (`OutputMode_t::Data` mode).
+  struct WaveformRecord_t {
+    unsigned int run = 0U; ///< Run number.
+    unsigned int event = 0U; ///< Event number.
+    unsigned int cluster = 0U; ///< Index of the waveform cluster in the event.
+    double clusterTime = 0.0; ///< Time of the cluster [us].
+    unsigned int channel = 0U; ///< Channel of the waveform.
+    double timeStamp = 0.0; ///< Time of the first sample [us].
+    double tick = 0.0; ///< Duration of a sample [us].
+    float baseline = 0.0f; ///< Estimated baseline (`0` if not estimated).
+    int hwBaseline = 0; ///< Configured readout baseline.
+    int hwThreshold = 0; ///< Configured readout threshold.
+    double triggerTime = 0.0; ///< Time of the global trigger [us].
+    double beamGateTime = 0.0; ///< Time of the beam gate opening [us].
+    double beamGateWidth = 0.0; ///< Duration of the beam gate [us].
+    std::vector<raw::ADC_Count_t> samples; ///< All the samples.
+  }; // WaveformRecord_t
+
+  
   
   // --- BEGIN -- Data members -------------------------------------------------
   
@@ -366,6 +463,11 @@ class DrawPMTwaveforms {
   // ----- BEGIN -- Setup ------------------------------------------------------
   TDirectory* fDestDir = nullptr; ///< ROOT directory where to write the plots.
   
+  /// Tree of waveform data (`OutputMode_t::Data` only; owned by `fDestDir`).
+  TTree* fWaveformTree = nullptr;
+  
+  WaveformRecord_t fWaveformRecord; ///< Data of the next waveform tree entry.
+  
   // ----- END -- Setup --------------------------------------------------------
 
   
@@ -410,31 +512,16 @@ class DrawPMTwaveforms {
         Comment{ "prints the baseline on screen for each channel and plot." },
         false
         };
-    }; // BaselineOptions_t
-    
-    
-    struct ReadoutSettings_t {
-      fhicl::Atom<raw::Channel_t> Channel {
-        Name{ "Channel" },
-        Comment{ "ID of the channel these settings are applied to" }
-        };
-      fhicl::OptionalAtom<raw::ADC_Count_t> Baseline {
-        Name{ "Baseline" },
-        Comment{ "readout waveform baseline, in ADC counts" }
-        };
-      fhicl::OptionalAtom<raw::ADC_Count_t> Threshold {
-        Name{ "Threshold" },
-        Comment{ "LVDS discrimination threshold, in ADC counts" }
-        };
-      fhicl::OptionalAtom<int> BoardChannel {
-        Name{ "BoardChannel" },
-        Comment{ "Channel within the readout board (unused)" }
-        };
-      fhicl::OptionalAtom<int> BoardNumber {
-        Name{ "BoardNumber" },
-        Comment{ "Readout board number (unused)" }
+      
+      fhicl::Atom<double> MedianResolution {
+        Name{ "MedianResolution" },
+        Comment{
+          "resolution of the median of the printed baselines [ADC];"
+          " 0 keeps all the baselines to compute it exactly"
+          },
+        0.1
         };
-    }; // ReadoutSettings_t
+    }; // BaselineOptions_t
     
     
     fhicl::Atom<art::InputTag> WaveformTag {
@@ -472,7 +559,8 @@ class DrawPMTwaveforms {
       Comment{ "whether all plots in a screen will share the same ADC range" }
       };
     
-    fhicl::OptionalSequence<fhicl::Table<ReadoutSettings_t>> ReadoutSettings {
+    fhicl::OptionalSequence<fhicl::Table<opdet::PMTreadoutSettingsConfig>>
+      ReadoutSettings {
       Name{ "ReadoutSettings" },
       Comment{ "Configured readout settings, per channel" },
       };
@@ -496,6 +584,36 @@ class DrawPMTwaveforms {
       2_ns
       };
     
+    fhicl::Atom<unsigned int> Threads {
+      Name{ "Threads" },
+      Comment{
+        "threads extracting baselines and drawing plots"
+        " (1: all serial; 0: one per core); plots are written by one more thread"
+        },
+      1U
+      };
+    
+    fhicl::Atom<std::string> OutputMode {
+      Name{ "OutputMode" },
+      Comment{
+        "what to save: \"Canvases\" into the ROOT file, \"Images\" files"
+        " or waveform \"Data\" into a tree, to be drawn later"
+        },
+      "Canvases"
+      };
+    
+    fhicl::Atom<std::string> ImageFormat {
+      Name{ "ImageFormat" },
+      Comment{ "format of the images (\"Images\" mode): \"png\", \"pdf\"..." },
+      "png"
+      };
+    
+    fhicl::Atom<std::string> ImageDirectory {
+      Name{ "ImageDirectory" },
+      Comment{ "directory where the images are saved (\"Images\" mode)" },
+      "."
+      };
+    
   }; // FHiCLconfig
   
   using Parameters = fhicl::Table<FHiCLconfig>;
@@ -597,36 +715,82 @@ class DrawPMTwaveforms {
     RangeStats_t regionA; ///< First partial of the most trusted region.
     RangeStats_t regionB; ///< Second partial of the most trusted region.
     RangeStats_t regionE; ///< Contol region.
-    double const& baseline = estimate.baseline; ///< Best baseline estimate.
     double baselineAverage; ///< Average baseline of trusted and control region.
     double RMS; ///< Baseline RMS.
+    
+    /// Best baseline estimate.
+    double const& baseline() const { return estimate.baseline; }
   }; // BaselineInfo_t
   
-  using BaselineEstimates_t = std::vector
-    <std::pair<art::EventID, StatCollectorWithMinMaxAndMedian<double>>>;
+  using BaselineEstimates_t
+    = std::vector<std::pair<art::EventID, BaselineStats_t>>;
   
   /// The best estimation for each channel so far.
   BaselineEstimates_t fBestBaselineEstimates;
   
+  /// Baseline information of the waveforms of the current event.
+  mutable icarus::ns::util::LazyEventCache
+    <raw::OpDetWaveform const*, BaselineInfo_t, art::EventID>
+    fBaselineCache;
+  
   /// Extracts (and plots) baseline information from the specified `waveform`.
   BaselineInfo_t extractBaseline(raw::OpDetWaveform const& waveform) const;
   
+  /**
+   * @brief Returns the baseline information of the specified `waveform`.
+   * 
+   * The information is extracted (`extractBaseline()`) on the first request
+   * for `waveform` in the current event, and then reused.
+   * This method can be called concurrently.
+   */
+  BaselineInfo_t const& baselineOf(raw::OpDetWaveform const& waveform) const;
+  
   // --- END ---- Analysis -----------------------------------------------------
 
   /// Produces a graph with the full content of the waveform.
   std::unique_ptr<TGraph> drawWaveform
     (WaveformInfo_t const& wf, art::EventID const& id) const;
   
-  std::vector<Cluster_t> clusterWaveforms
-    (std::vector<WaveformInfo_t> waveforms, microseconds duration) const;
+  /// Groups the `waveforms` in time, using their `timeIndex`.
+  std::vector<Cluster_t> clusterWaveforms(
+    std::vector<WaveformInfo_t> const& waveforms,
+    opdet::PMTwaveformTimeIndex const& timeIndex,
+    microseconds duration
+    ) const;
   
   /// Returns the representative time of the cluster.
   optical_time clusterTime(Cluster_t const& waveforms) const;
   
+  /// Creates the output directory of the cluster at the specified `time`
+  /// (none if `eventOutputDir` is `nullptr`).
+  std::unique_ptr<TDirectory> makeClusterDirectory
+    (art::EventID const& id, optical_time time, TDirectory* eventOutputDir)
+    const;
+  
+  /// Plots the `cluster` into a new directory in `eventOutputDir`, or into
+  /// image files if `eventOutputDir` is `nullptr` (then returns `nullptr`).
   std::unique_ptr<TDirectory> plotWaveformCluster(
-    Cluster_t const& cluster, art::EventID const& id, TDirectory& eventOutputDir
+    Cluster_t const& cluster, art::EventID const& id, TDirectory* eventOutputDir
     ) const;
   
+  /**
+   * @brief Plots and writes all the `clusters` using multiple threads.
+   * 
+   * The canvases are drawn by `fConfig.nThreads` threads, and handed over
+   * through a bounded queue to a single thread writing them into their
+   * directories; only that thread operates on ROOT directories. The output is
+   * the same as in the serial mode, except for the order of the canvases in
+   * the directory of each cluster.
+   */
+  void plotWaveformClustersInParallel(
+    std::vector<Cluster_t> const& clusters, art::EventID const& id,
+    TDirectory* eventOutputDir
+    ) const;
+  
+  /// Stores the waveforms of all the `clusters` into the waveform tree.
+  void storeWaveformClusters
+    (std::vector<Cluster_t> const& clusters, art::EventID const& id);
+  
   /// Prints the average baselines of an event on screen.
   void printBaselines(BaselineEstimates_t const& baselines) const;
   
@@ -637,8 +801,15 @@ class DrawPMTwaveforms {
   /// Plots the full group of waveforms in a single canvas.
   std::unique_ptr<TCanvas> plotWaveformGroup(
     Cluster_t const& group, art::EventID const& id, optical_time time,
-    TDirectory& clusterOutputDir
+    TDirectory* clusterOutputDir
     ) const;
+  
+  /// Writes `canvas` into `outputDir`, or into an image file if `nullptr`.
+  void saveCanvas(TCanvas& canvas, TDirectory* outputDir) const;
+  
+  /// Creates in `outputDir` the tree of waveform data, filled from `record`.
+  static TTree* makeWaveformTree
+    (TDirectory& outputDir, WaveformRecord_t& record);
 
   /// Returns the lowest and highest channel number among the `waveforms`.
   static std::pair<raw::Channel_t, raw::Channel_t> channelRange
@@ -668,50 +839,41 @@ auto DrawPMTwaveforms::parseValidatedAlgorithmConfiguration
   algConfig.triggerTag = config.TriggerTag().value_or(art::InputTag{});
   algConfig.nChannels = config.Channels();
   algConfig.plotTimes = config.TimeSlices();
+  algConfig.plotTimeSet = makeTimeIntervalSet(algConfig.plotTimes);
   algConfig.staggerFraction = config.StaggerPlots();
   if (std::optional<FHiCLconfig::BaselineOptions_t> baselineOpts = config.Baseline()) {
     algConfig.baseline.subtract = baselineOpts->SubtractBaseline();
     algConfig.baseline.nSamples = baselineOpts->EstimationSamples();
     algConfig.baseline.doPrint = baselineOpts->PrintBaseline();
+    algConfig.baseline.medianResolution = baselineOpts->MedianResolution();
   } // if baseline specs
   
   if (config.ReadoutSettings()) {
-    for (FHiCLconfig::ReadoutSettings_t const& settings
-        : *(config.ReadoutSettings())
-    ) {
-      
-      raw::Channel_t const channel = settings.Channel();
-      
-      if (settings.Baseline()) {
-        raw::ADC_Count_t const value = *(settings.Baseline());
-        if (algConfig.readoutBaselines.contains(channel)) {
-          throw std::runtime_error{
-            "Duplicate baseline setting for channel " + std::to_string(channel)
-            + " (" + std::to_string(algConfig.readoutBaselines(channel))
-            + ", then " + std::to_string(value) + ")."
-            };
-        }
-        algConfig.readoutBaselines.set(channel, value);
-      }
-      
-      if (settings.Threshold()) {
-        raw::ADC_Count_t const value = *(settings.Threshold());
-        if (algConfig.readoutThresholds.contains(channel)) {
-          throw std::runtime_error{
-            "Duplicate threshold setting for channel " + std::to_string(channel)
-            + " (" + std::to_string(algConfig.readoutThresholds(channel))
-            + ", then " + std::to_string(value) + ")."
-            };
-        }
-        algConfig.readoutThresholds.set(channel, value);
-      }
-      
-    } // for
-  } // if
+    algConfig.readoutSettings = opdet::makePMTreadoutSettings
+      (*(config.ReadoutSettings()), algConfig.nChannels);
+  }
   
   algConfig.sharedADCrange = config.SharedADCrange();
   
   algConfig.tickDuration = config.TickDuration();
+  algConfig.nThreads = config.Threads();
+  if (algConfig.nThreads == 0U)
+    algConfig.nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  
+  std::string const outputMode = config.OutputMode();
+  if (outputMode == "Canvases")
+    algConfig.outputMode = OutputMode_t::Canvases;
+  else if (outputMode == "Images")
+    algConfig.outputMode = OutputMode_t::Images;
+  else if (outputMode == "Data")
+    algConfig.outputMode = OutputMode_t::Data;
+  else {
+    throw std::runtime_error{ "Unsupported output mode '" + outputMode
+      + "' (supported: \"Canvases\", \"Images\", \"Data\")." };
+  }
+  algConfig.imageFormat = config.ImageFormat();
+  algConfig.imageDirectory = config.ImageDirectory();
+  
   return algConfig;
 } // DrawPMTwaveforms::parseValidatedAlgorithmConfiguration()
 
@@ -731,6 +893,17 @@ void DrawPMTwaveforms::setup(TDirectory* pDestDir) {
   
   fDestDir = pDestDir;
   
+  switch (fConfig.outputMode) {
+    case OutputMode_t::Images:
+      gSystem->mkdir(fConfig.imageDirectory.c_str(), kTRUE);
+      break;
+    case OutputMode_t::Data:
+      fWaveformTree = makeWaveformTree(*fDestDir, fWaveformRecord);
+      break;
+    case OutputMode_t::Canvases:
+      break;
+  } // switch
+  
 } // DrawPMTwaveforms::setup()
 
 
@@ -745,6 +918,7 @@ template <typename Event>
 void DrawPMTwaveforms::analyze(Event const& event, art::EventID const& id) {
   
   ++fNEvents;
+  fBaselineCache.setEvent(id);
   
   //
   // read the data
@@ -790,41 +964,56 @@ void DrawPMTwaveforms::analyze(Event const& event, art::EventID const& id) {
   //
   // preselect the waveforms
   //
-  std::vector<StatCollectorWithMinMaxAndMedian<double>> Baselines
-    { fConfig.nChannels };
+  std::vector<std::uint8_t> selected; // all the times tested in one go
+  if (!fConfig.plotTimes.empty()) {
+    std::vector<optical_time> times;
+    times.reserve(waveforms.size());
+    for (raw::OpDetWaveform const& waveform: waveforms)
+      times.emplace_back(microsecond{ waveform.TimeStamp() });
+    selected = fConfig.plotTimeSet.contains(times);
+  }
+  
+  auto const& hwBaselines = fConfig.readoutSettings.baselines();
+  auto const& hwThresholds = fConfig.readoutSettings.thresholds();
   std::vector<WaveformInfo_t> selectedWaveforms;
-  for (raw::OpDetWaveform const& waveform: waveforms) {
-    optical_time const time { microsecond { waveform.TimeStamp() } };
-    raw::Channel_t const channel = waveform.ChannelNumber();
+  for (auto const& [ iWaveform, waveform ]: util::enumerate(waveforms)) {
+    if (!selected.empty() && !selected[iWaveform]) continue;
     
-    bool selected = fConfig.plotTimes.empty();
-    for (ValueRange<optical_time> const& goodTime: fConfig.plotTimes) {
-      if (!goodTime.contains(time)) continue;
-      selected = true;
-      break;
-    } // for time ranges
-    if (!selected) continue;
-    
-    float baseline = 0.0; // no baseline
-    if (fConfig.baseline.subtract || fConfig.baseline.doPrint) {
-      BaselineInfo_t baselineInfo = extractBaseline(waveform);
-      baseline = baselineInfo.baseline;
-      Baselines.at(channel).add(baseline);
-    }
+    raw::Channel_t const channel = waveform.ChannelNumber();
     
     selectedWaveforms.push_back(WaveformInfo_t{
         &waveform
       , triggerTime
       , beamGateTime
       , beamGateWidth
-      , baseline
+      , 0.0 // no baseline (yet)
       , WaveformInfo_t::NoThreshold
-      , fConfig.readoutBaselines(channel, WaveformInfo_t::NoHWSetting)
-      , fConfig.readoutThresholds(channel, WaveformInfo_t::NoHWSetting)
+      , hwBaselines(channel, WaveformInfo_t::NoHWSetting)
+      , hwThresholds(channel, WaveformInfo_t::NoHWSetting)
       });
     
   } // for all waveforms
   
+  //
+  // extract the baselines (each waveform independently)
+  //
+  std::vector<BaselineStats_t> Baselines
+    (fConfig.nChannels, BaselineStats_t{ fConfig.baseline.medianResolution });
+  if (fConfig.baseline.subtract || fConfig.baseline.doPrint) {
+    
+    runInParallel(selectedWaveforms.size(), fConfig.nThreads,
+      [this,&selectedWaveforms](std::size_t iWaveform)
+      {
+        WaveformInfo_t& wf = selectedWaveforms[iWaveform];
+        wf.baseline = baselineOf(*(wf.waveform)).baseline();
+      }
+      );
+    
+    for (WaveformInfo_t const& wf: selectedWaveforms)
+      Baselines.at(wf->ChannelNumber()).add(wf.baseline);
+    
+  } // if baselines
+  
   if (fConfig.baseline.doPrint) {
     
     for (auto const& [ channel, stats ]: util::enumerate(Baselines)) {
@@ -841,58 +1030,85 @@ void DrawPMTwaveforms::analyze(Event const& event, art::EventID const& id) {
   // cluster waveforms in time
   //
   
+  std::vector<raw::OpDetWaveform const*> selectedWaveformPtrs;
+  selectedWaveformPtrs.reserve(selectedWaveforms.size());
+  for (WaveformInfo_t const& wf: selectedWaveforms)
+    selectedWaveformPtrs.push_back(wf.waveform);
+  opdet::PMTwaveformTimeIndex const timeIndex{
+    selectedWaveformPtrs,
+    fConfig.tickDuration.convertInto<microseconds>().value()
+    };
+  
   std::vector<Cluster_t> waveformClusters
-    = clusterWaveforms(selectedWaveforms, 2.0_us);
+    = clusterWaveforms(selectedWaveforms, timeIndex, 2.0_us);
   
   //
-  // draw each cluster
+  // only store the data of each cluster, if so requested
   //
-  TDirectory* eventOutputDir = fDestDir->mkdir(
-    ("R" + std::to_string(id.run()) + "E" + std::to_string(id.event())).c_str(),
-    ("Run " + std::to_string(id.run()) + " event " + std::to_string(id.event()))
-      .c_str()
-    );
+  if (fConfig.outputMode == OutputMode_t::Data) {
+    storeWaveformClusters(waveformClusters, id);
+    return;
+  }
   
-  for (Cluster_t const& cluster: waveformClusters) {
-    
-    std::unique_ptr<TDirectory> plots
-      = plotWaveformCluster(cluster, id, *eventOutputDir);
-    
-    util::ROOT::TDirectoryChanger dg { eventOutputDir };
-    plots->Write();
-    
-  } // for clusters
+  //
+  // draw each cluster (images need no output directory)
+  //
+  TDirectory* eventOutputDir = (fConfig.outputMode == OutputMode_t::Canvases)
+    ? fDestDir->mkdir(
+      ("R" + std::to_string(id.run()) + "E" + std::to_string(id.event()))
+        .c_str(),
+      ("Run " + std::to_string(id.run()) + " event "
+        + std::to_string(id.event())).c_str()
+      )
+    : nullptr
+    ;
   
-  eventOutputDir->Write();
-  delete eventOutputDir;
+  if (fConfig.nThreads > 1U)
+    plotWaveformClustersInParallel(waveformClusters, id, eventOutputDir);
+  else {
+    for (Cluster_t const& cluster: waveformClusters) {
+      
+      std::unique_ptr<TDirectory> plots
+        = plotWaveformCluster(cluster, id, eventOutputDir);
+      if (!plots) continue;
+      
+      util::ROOT::TDirectoryChanger dg { eventOutputDir };
+      plots->Write();
+      
+    } // for clusters
+  }
+  
+  if (eventOutputDir) {
+    eventOutputDir->Write();
+    delete eventOutputDir;
+  }
   
 } // DrawPMTwaveforms::analyze()
 
 
-auto DrawPMTwaveforms::clusterWaveforms
-  (std::vector<WaveformInfo_t> waveforms, microseconds duration) const
-  -> std::vector<Cluster_t>
-{
+auto DrawPMTwaveforms::clusterWaveforms(
+  std::vector<WaveformInfo_t> const& waveforms,
+  opdet::PMTwaveformTimeIndex const& timeIndex,
+  microseconds duration
+) const -> std::vector<Cluster_t> {
   //
   // simple clustering in time;
-  // returned waveforms in each cluster are sorted by channel number
+  // the time index already provides the waveforms sorted by time
   //
   
-  std::sort(waveforms.begin(), waveforms.end(), WaveformInfo_t::byTime);
-  
   std::vector<Cluster_t> clusters;
-  auto itWf = waveforms.begin();
-  auto const wend = waveforms.end();
+  auto itWf = timeIndex.sorted().begin();
+  auto const wend = timeIndex.sorted().end();
   
   if (itWf == wend) return clusters;
   
-  Cluster_t currentCluster { *itWf };
+  Cluster_t currentCluster { waveforms[*itWf] };
   util::quantities::points::microsecond currentClusterTime
-    { itWf->waveform->TimeStamp() };
+    { timeIndex.startTime(*itWf) };
   while (++itWf != wend) {
     
     util::quantities::points::microsecond const waveformTime
-      { itWf->waveform->TimeStamp() };
+      { timeIndex.startTime(*itWf) };
     
     if (waveformTime - currentClusterTime >= duration) { // next cluster
       // close and store the current cluster
@@ -901,7 +1117,7 @@ auto DrawPMTwaveforms::clusterWaveforms
       currentClusterTime = waveformTime;
     } // if
     
-    currentCluster.push_back(*itWf);
+    currentCluster.push_back(waveforms[*itWf]);
     
   } // for
   
@@ -921,14 +1137,13 @@ auto DrawPMTwaveforms::clusterTime
 } // DrawPMTwaveforms::clusterTime()
 
 
-std::unique_ptr<TDirectory> DrawPMTwaveforms::plotWaveformCluster
-  (Cluster_t const& cluster, art::EventID const& id, TDirectory& eventOutputDir)
-  const
+std::unique_ptr<TDirectory> DrawPMTwaveforms::makeClusterDirectory
+  (art::EventID const& id, optical_time time, TDirectory* eventOutputDir) const
 {
+  if (!eventOutputDir) return nullptr; // canvases are saved as images
   
-  optical_time const time = clusterTime(cluster);
   using std::to_string;
-  auto outDir = std::make_unique<TDirectoryFile>(
+  return std::make_unique<TDirectoryFile>(
     ("R" + to_string(id.run()) + "E" + to_string(id.event())
       + "TS" + to_string
         (static_cast<int>(std::round(time.convertInto<microsecond>().value())))
@@ -936,8 +1151,19 @@ std::unique_ptr<TDirectory> DrawPMTwaveforms::plotWaveformCluster
     ("Run " + to_string(id.run()) + " event " + to_string(id.event())
       + " cluster at time " + to_string(time.convertInto<microsecond>())
     ).c_str(),
-    "TDirectoryFile", &eventOutputDir
+    "TDirectoryFile", eventOutputDir
     );
+} // DrawPMTwaveforms::makeClusterDirectory()
+
+
+std::unique_ptr<TDirectory> DrawPMTwaveforms::plotWaveformCluster
+  (Cluster_t const& cluster, art::EventID const& id, TDirectory* eventOutputDir)
+  const
+{
+  
+  optical_time const time = clusterTime(cluster);
+  std::unique_ptr<TDirectory> outDir
+    = makeClusterDirectory(id, time, eventOutputDir);
   
   std::vector<Cluster_t> groups = groupWaveformCluster(cluster);
   
@@ -949,15 +1175,14 @@ std::unique_ptr<TDirectory> DrawPMTwaveforms::plotWaveformCluster
     if (group.empty()) continue;
     
     std::unique_ptr<TCanvas> canvas
-      = plotWaveformGroup(group, id, time, *outDir);
+      = plotWaveformGroup(group, id, time, outDir.get());
     if (!canvas) continue;
     
     auto const [ firstChannel, lastChannel ] = channelRange(group);
     log << "  " << firstChannel;
     if (lastChannel != firstChannel) log << "-" << lastChannel;
     
-    util::ROOT::TDirectoryChanger dg { outDir.get() };
-    canvas->Write();
+    saveCanvas(*canvas, outDir.get());
     gPad = nullptr; // just in case
     
   } // for groups
@@ -966,6 +1191,92 @@ std::unique_ptr<TDirectory> DrawPMTwaveforms::plotWaveformCluster
 } // DrawPMTwaveforms::plotWaveformCluster()
 
 
+void DrawPMTwaveforms::plotWaveformClustersInParallel(
+  std::vector<Cluster_t> const& clusters, art::EventID const& id,
+  TDirectory* eventOutputDir
+) const {
+  
+  //
+  // directories and work list are prepared here, serially
+  //
+  struct PlotTask_t {
+    std::size_t iCluster; ///< Index of the cluster of the group.
+    optical_time time; ///< Time of the cluster.
+    Cluster_t group; ///< Waveforms to be plotted together.
+  };
+  
+  std::vector<std::unique_ptr<TDirectory>> clusterDirs;
+  std::vector<PlotTask_t> tasks;
+  for (auto const& [ iCluster, cluster ]: util::enumerate(clusters)) {
+    optical_time const time = clusterTime(cluster);
+    clusterDirs.push_back(makeClusterDirectory(id, time, eventOutputDir));
+    for (Cluster_t& group: groupWaveformCluster(cluster)) {
+      if (group.empty()) continue;
+      tasks.push_back({ iCluster, time, std::move(group) });
+    }
+  } // for clusters
+  
+  //
+  // a single writer thread, fed by the plotting threads
+  //
+  using Plot_t = std::pair<std::size_t, std::unique_ptr<TCanvas>>;
+  BoundedQueue<Plot_t> toBeWritten { 2U * fConfig.nThreads };
+  std::thread writer{ [this,&toBeWritten,&clusterDirs]()
+    {
+      Plot_t plot;
+      while (toBeWritten.pop(plot)) {
+        saveCanvas(*(plot.second), clusterDirs[plot.first].get());
+        plot.second.reset();
+      } // while
+    }
+    };
+  
+  auto plotGroup = [this,&tasks,&clusterDirs,&id,&toBeWritten](std::size_t i)
+    {
+      PlotTask_t const& task = tasks[i];
+      std::unique_ptr<TCanvas> canvas = plotWaveformGroup
+        (task.group, id, task.time, clusterDirs[task.iCluster].get());
+      gPad = nullptr; // just in case
+      if (canvas) toBeWritten.push({ task.iCluster, std::move(canvas) });
+    };
+  
+  try {
+    runInParallel(tasks.size(), fConfig.nThreads, plotGroup);
+  }
+  catch (...) {
+    toBeWritten.close();
+    writer.join();
+    throw;
+  }
+  toBeWritten.close();
+  writer.join();
+  
+  //
+  // report and write the cluster directories, in cluster order
+  //
+  auto itTask = tasks.cbegin();
+  for (auto const& [ iCluster, cluster ]: util::enumerate(clusters)) {
+    
+    mf::LogVerbatim log { "DrawPMTwaveforms" };
+    log
+      << "Run " << id.run() << " event " << id.event() << ": " << cluster.size()
+      << " waveforms at t=" << clusterTime(cluster) << ": channels";
+    for (; (itTask != tasks.cend()) && (itTask->iCluster == iCluster); ++itTask)
+    {
+      auto const [ firstChannel, lastChannel ] = channelRange(itTask->group);
+      log << "  " << firstChannel;
+      if (lastChannel != firstChannel) log << "-" << lastChannel;
+    } // for groups
+    
+    if (!clusterDirs[iCluster]) continue; // images were saved already
+    util::ROOT::TDirectoryChanger dg { eventOutputDir };
+    clusterDirs[iCluster]->Write();
+    
+  } // for clusters
+  
+} // DrawPMTwaveforms::plotWaveformClustersInParallel()
+
+
 auto DrawPMTwaveforms::groupWaveformCluster(Cluster_t const& waveforms) const
   -> std::vector<Cluster_t>
 {
@@ -997,7 +1308,7 @@ auto DrawPMTwaveforms::groupWaveformCluster(Cluster_t const& waveforms) const
 
 std::unique_ptr<TCanvas> DrawPMTwaveforms::plotWaveformGroup(
   Cluster_t const& group, art::EventID const& id, optical_time time,
-  TDirectory& clusterOutputDir
+  TDirectory* clusterOutputDir
   ) const
 {
   /*
@@ -1068,7 +1379,7 @@ std::unique_ptr<TCanvas> DrawPMTwaveforms::plotWaveformGroup(
     = [](optical_time t){ return t.convertInto<microsecond>().value(); };
   
   using std::to_string;
-  util::ROOT::TDirectoryChanger dg { &clusterOutputDir };
+  util::ROOT::TDirectoryChanger dg { clusterOutputDir };
   auto canvas = std::make_unique<TCanvas>(
     ("R" + to_string(id.run()) + "E" + to_string(id.event())
       + "TS" + to_string(static_cast<int>(std::round(opticalToUS(time))))
@@ -1229,6 +1540,87 @@ std::unique_ptr<TCanvas> DrawPMTwaveforms::plotWaveformGroup(
 } // DrawPMTwaveforms::plotWaveformGroup()
 
 
+void DrawPMTwaveforms::saveCanvas(TCanvas& canvas, TDirectory* outputDir) const
+{
+  if (outputDir) {
+    util::ROOT::TDirectoryChanger dg { outputDir };
+    canvas.Write();
+  }
+  else {
+    canvas.SaveAs((fConfig.imageDirectory + "/" + canvas.GetName()
+      + "." + fConfig.imageFormat).c_str());
+  }
+} // DrawPMTwaveforms::saveCanvas()
+
+
+TTree* DrawPMTwaveforms::makeWaveformTree
+  (TDirectory& outputDir, WaveformRecord_t& record)
+{
+  util::ROOT::TDirectoryChanger dg { &outputDir };
+  TTree* tree = new TTree
+    ("PMTwaveforms", "PMT waveforms (one per entry) clustered in time");
+  tree->SetDirectory(&outputDir);
+  
+  tree->Branch("run", &record.run);
+  tree->Branch("event", &record.event);
+  tree->Branch("cluster", &record.cluster);
+  tree->Branch("clusterTime", &record.clusterTime);
+  tree->Branch("channel", &record.channel);
+  tree->Branch("timeStamp", &record.timeStamp);
+  tree->Branch("tick", &record.tick);
+  tree->Branch("baseline", &record.baseline);
+  tree->Branch("hwBaseline", &record.hwBaseline);
+  tree->Branch("hwThreshold", &record.hwThreshold);
+  tree->Branch("triggerTime", &record.triggerTime);
+  tree->Branch("beamGateTime", &record.beamGateTime);
+  tree->Branch("beamGateWidth", &record.beamGateWidth);
+  tree->Branch("samples", &record.samples);
+  
+  return tree;
+} // DrawPMTwaveforms::makeWaveformTree()
+
+
+void DrawPMTwaveforms::storeWaveformClusters
+  (std::vector<Cluster_t> const& clusters, art::EventID const& id)
+{
+  auto const opticalToUS
+    = [](optical_time t){ return t.convertInto<microsecond>().value(); };
+  
+  WaveformRecord_t& record = fWaveformRecord;
+  record.run = id.run();
+  record.event = id.event();
+  record.tick = fConfig.tickDuration.convertInto<microseconds>().value();
+  
+  std::size_t nWaveforms = 0U;
+  for (auto const& [ iCluster, cluster ]: util::enumerate(clusters)) {
+    
+    record.cluster = iCluster;
+    record.clusterTime = opticalToUS(clusterTime(cluster));
+    
+    for (WaveformInfo_t const& wf: cluster) {
+      record.channel = wf->ChannelNumber();
+      record.timeStamp = wf->TimeStamp();
+      record.baseline = wf.baseline;
+      record.hwBaseline = wf.hwBaseline;
+      record.hwThreshold = wf.hwThreshold;
+      record.triggerTime = opticalToUS(wf.triggerTime);
+      record.beamGateTime = opticalToUS(wf.beamGateTime);
+      record.beamGateWidth
+        = wf.beamGateWidth.convertInto<microseconds>().value();
+      record.samples.assign(wf->begin(), wf->end());
+      fWaveformTree->Fill();
+    } // for waveforms
+    
+    nWaveforms += cluster.size();
+  } // for clusters
+  
+  mf::LogVerbatim{ "DrawPMTwaveforms" }
+    << "Run " << id.run() << " event " << id.event() << ": stored "
+    << nWaveforms << " waveforms in " << clusters.size() << " clusters";
+  
+} // DrawPMTwaveforms::storeWaveformClusters()
+
+
 
 std::pair<raw::Channel_t, raw::Channel_t> DrawPMTwaveforms::channelRange
   (Cluster_t const& waveforms)
@@ -1255,7 +1647,8 @@ void DrawPMTwaveforms::printBaselines(BaselineEstimates_t const& baselines) cons
       continue;
     }
     raw::ADC_Count_t const hwBaseline
-      = fConfig.readoutBaselines(channel, WaveformInfo_t::NoHWSetting);
+      = fConfig.readoutSettings.baselines()
+        (channel, WaveformInfo_t::NoHWSetting);
     auto const medianBaseline = stats.median();
     out << " baseline " << stats.Average()
       << " +/- " << stats.RMS() << " from " << stats.N()
@@ -1299,6 +1692,20 @@ void DrawPMTwaveforms::printConfig(Stream&& out) const {
   }
   if (fConfig.baseline.subtract)
     out << "\n * subtract baseline in each plot";
+  if (fConfig.nThreads > 1U)
+    out << "\n * drawing with " << fConfig.nThreads << " threads";
+  switch (fConfig.outputMode) {
+    case OutputMode_t::Canvases:
+      out << "\n * canvases written into the output file";
+      break;
+    case OutputMode_t::Images:
+      out << "\n * canvases saved as " << fConfig.imageFormat << " images in '"
+        << fConfig.imageDirectory << "'";
+      break;
+    case OutputMode_t::Data:
+      out << "\n * waveform data stored in a tree, no drawing";
+      break;
+  } // switch
   
   out << "\n";
 } // DrawPMTwaveforms::printConfig()
@@ -1347,12 +1754,22 @@ auto DrawPMTwaveforms::extractBaseline(raw::OpDetWaveform const& waveform) const
   info.RMS
     = (info.estimate.variance > 0.0)? std::sqrt(info.estimate.variance): 1.0;
   
-  info.baselineAverage = info.baseline;
+  info.baselineAverage = info.baseline();
 
   return info;
 } // DrawPMTwaveforms::extractBaseline()
 
 
+// -----------------------------------------------------------------------------
+auto DrawPMTwaveforms::baselineOf(raw::OpDetWaveform const& waveform) const
+  -> BaselineInfo_t const&
+{
+  return fBaselineCache.get(&waveform,
+    [this](raw::OpDetWaveform const* wf){ return extractBaseline(*wf); }
+    );
+} // DrawPMTwaveforms::baselineOf()
+
+
 // -----------------------------------------------------------------------------
 std::unique_ptr<TGraph> DrawPMTwaveforms::drawWaveform
   (WaveformInfo_t const& wf, art::EventID const& id) const
@@ -1412,6 +1829,18 @@ int runAnalysis
 
   auto const& analysisConfig = config.get<fhicl::ParameterSet>("analysis");
   
+  // in parallel mode ROOT must be ready for threads before any other use;
+  // drawing happens off the screen
+  auto const& algConfig = analysisConfig.get<fhicl::ParameterSet>
+    (DrawPMTwaveforms::ConfigurationKey);
+  if (algConfig.get("Threads", 1U) != 1U) {
+    ROOT::EnableThreadSafety();
+    gROOT->SetBatch(kTRUE);
+  }
+  // images are also drawn off the screen (and data is not drawn at all)
+  if (algConfig.get<std::string>("OutputMode", "Canvases") != "Canvases")
+    gROOT->SetBatch(kTRUE);
+  
   // event loop options
   constexpr auto NoLimits = std::numeric_limits<unsigned int>::max();
   unsigned int nSkip = analysisConfig.get("skipEvents", 0U);
@@ -3,6 +3,40 @@
 
 #include <cmath>
 #include <algorithm>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+    // Suffix for the names of the histograms of a plane, e.g. "C0T1P2"
+    std::string planeSuffix(const geo::PlaneID& planeID)
+    {
+        return "C" + std::to_string(planeID.Cryostat) + "T" + std::to_string(planeID.TPC)
+             + "P" + std::to_string(planeID.Plane);
+    }
+    
+    // Creates a histogram for the plane, attached to the output directory
+    template <typename Hist, typename... Args>
+    std::unique_ptr<Hist> makePlaneHist(const std::string& name, const geo::PlaneID& planeID,
+                                        TDirectory* directory, Args... args)
+    {
+        auto hist = std::make_unique<Hist>((name + planeSuffix(planeID)).c_str(), args...);
+        hist->SetDirectory(directory);
+        return hist;
+    }
+    
+    // Bins all the `values` into `hist` at once
+    void fillColumn(TH1& hist, const std::vector<double>& values)
+    {
+        if (!values.empty()) hist.FillN(int(values.size()), values.data(), nullptr);
+    }
+    
+    void fillColumns(TH2& hist, const std::vector<double>& x, const std::vector<double>& y)
+    {
+        if (!x.empty()) hist.FillN(int(x.size()), x.data(), y.data(), nullptr);
+    }
+    
+} // local namespace
 
 namespace HitAnalysis
 {
@@ -38,7 +72,8 @@ HitAnalysisAlg::~HitAnalysisAlg()
 ///
 void HitAnalysisAlg::reconfigure(fhicl::ParameterSet const & pset)
 {
-    fLocalDirName = pset.get<std::string>("LocalDirName", std::string("wow"));
+    fLocalDirName  = pset.get<std::string>("LocalDirName", std::string("wow"));
+    fWriteHitTable = pset.get<bool>("HitTable", false);
 }
 
 //----------------------------------------------------------------------------
@@ -53,136 +88,91 @@ void HitAnalysisAlg::setup(const geo::GeometryCore&           geometry,
     // Make a directory for these histograms
 //    art::TFileDirectory dir = tfs->mkdir(fLocalDirName.c_str());
 
-    fHitsByWire[0]            = std::make_unique<TH1D>("HitsByWire0", ";Wire #", fGeometry->Nwires({ 0, 0, 0 }), 0., fGeometry->Nwires({ 0, 0, 0 }));
-    fHitsByWire[1]            = std::make_unique<TH1D>("HitsByWire1", ";Wire #", fGeometry->Nwires({ 0, 0, 1 }), 0., fGeometry->Nwires({ 0, 0, 1 }));
-    fHitsByWire[2]            = std::make_unique<TH1D>("HitsByWire2", ";Wire #", fGeometry->Nwires({ 0, 0, 2 }), 0., fGeometry->Nwires({ 0, 0, 2 }));
-    
-    fDriftTimes[0]            = std::make_unique<TH1D>("DriftTime0",  ";time(ticks)", 3200, 0., 9600.);
-    fDriftTimes[1]            = std::make_unique<TH1D>("DriftTime1",  ";time(ticks)", 3200, 0., 9600.);
-    fDriftTimes[2]            = std::make_unique<TH1D>("DriftTime2",  ";time(ticks)", 3200, 0., 9600.);
-    
-    fHitsByTime[0]            = std::make_unique<TH1D>("HitsByTime0", ";Tick",   1600, 0., 6400.);
-    fHitsByTime[1]            = std::make_unique<TH1D>("HitsByTime1", ";Tick",   1600, 0., 6400.);
-    fHitsByTime[2]            = std::make_unique<TH1D>("HitsByTime2", ";Tick",   1600, 0., 6400.);
-    
-    fPulseHeight[0]           = std::make_unique<TH1D>("PulseHeight0",  "PH (ADC)",  300,  0.,  150.);
-    fPulseHeight[1]           = std::make_unique<TH1D>("PulseHeight1",  "PH (ADC)",  300,  0.,  150.);
-    fPulseHeight[2]           = std::make_unique<TH1D>("PulseHeight2",  "PH (ADC)",  300,  0.,  150.);
-    fPulseHeightSingle[0]     = std::make_unique<TH1D>("PulseHeightS0", "PH (ADC)",  300,  0.,  150.);
-    fPulseHeightSingle[1]     = std::make_unique<TH1D>("PulseHeightS1", "PH (ADC)",  300,  0.,  150.);
-    fPulseHeightSingle[2]     = std::make_unique<TH1D>("PulseHeightS2", "PH (ADC)",  300,  0.,  150.);
-    fPulseHeightMulti[0]      = std::make_unique<TH1D>("PulseHeightM0", "PH (ADC)",  300,  0.,  150.);
-    fPulseHeightMulti[1]      = std::make_unique<TH1D>("PulseHeightM1", "PH (ADC)",  300,  0.,  150.);
-    fPulseHeightMulti[2]      = std::make_unique<TH1D>("PulseHeightM2", "PH (ADC)",  300,  0.,  150.);
-    fChi2DOF[0]               = std::make_unique<TH1D>("Chi2DOF0",      "Chi2DOF",   502, -1.,  250.);
-    fChi2DOF[1]               = std::make_unique<TH1D>("Chi2DOF1",      "Chi2DOF",   502, -1.,  250.);
-    fChi2DOF[2]               = std::make_unique<TH1D>("Chi2DOF2",      "Chi2DOF",   502, -1.,  250.);
-    fNumDegFree[0]            = std::make_unique<TH1D>("NumDegFree0",   "NDF",       100,  0.,  100.);
-    fNumDegFree[1]            = std::make_unique<TH1D>("NumDegFree1",   "NDF",       100,  0.,  100.);
-    fNumDegFree[2]            = std::make_unique<TH1D>("NumDegFree2",   "NDF",       100,  0.,  100.);
-    fChi2DOFSingle[0]         = std::make_unique<TH1D>("Chi2DOFS0",     "Chi2DOF",   502, -1.,  250.);
-    fChi2DOFSingle[1]         = std::make_unique<TH1D>("Chi2DOFS1",     "Chi2DOF",   502, -1.,  250.);
-    fChi2DOFSingle[2]         = std::make_unique<TH1D>("Chi2DOFS2",     "Chi2DOF",   502, -1.,  250.);
-    fHitMult[0]               = std::make_unique<TH1D>("HitMult0",      "# hits",     15,  0.,   15.);
-    fHitMult[1]               = std::make_unique<TH1D>("HitMult1",      "# hits",     15,  0.,   15.);
-    fHitMult[2]               = std::make_unique<TH1D>("HitMult2",      "# hits",     15,  0.,   15.);
-    fHitCharge[0]             = std::make_unique<TH1D>("HitCharge0",    "Charge",   1000,  0., 2000.);
-    fHitCharge[1]             = std::make_unique<TH1D>("HitCharge1",    "Charge",   1000,  0., 2000.);
-    fHitCharge[2]             = std::make_unique<TH1D>("HitCharge2",    "Charge",   1000,  0., 2000.);
-    fFitWidth[0]              = std::make_unique<TH1D>("FitWidth0",     "Width",     100,  0.,   10.);
-    fFitWidth[1]              = std::make_unique<TH1D>("FitWidth1",     "Width",     100,  0.,   10.);
-    fFitWidth[2]              = std::make_unique<TH1D>("FitWidth2",     "Width",     100,  0.,   10.);
-    fHitSumADC[0]             = std::make_unique<TH1D>("SumADC0",       "Sum ADC",  1000,  0., 2000.);
-    fHitSumADC[1]             = std::make_unique<TH1D>("SumADC1",       "Sum ADC",  1000,  0., 2000.);
-    fHitSumADC[2]             = std::make_unique<TH1D>("SumADC2",       "Sum ADC",  1000,  0., 2000.);
-    
-    fNDFVsChi2[0]             = std::make_unique<TH2D>("NDFVsChi20",    ";NDF;Chi2",  50,  0.,   50., 101, -1., 100.);
-    fNDFVsChi2[1]             = std::make_unique<TH2D>("NDFVsChi21",    ";NDF;Chi2",  50,  0.,   50., 101, -1., 100.);
-    fNDFVsChi2[2]             = std::make_unique<TH2D>("NDFVsChi22",    ";NDF;Chi2",  50,  0.,   50., 101, -1., 100.);
-    
-    fPulseHVsWidth[0]         = std::make_unique<TH2D>("PHVsWidth0",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    fPulseHVsWidth[1]         = std::make_unique<TH2D>("PHVsWidth1",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    fPulseHVsWidth[2]         = std::make_unique<TH2D>("PHVsWidth2",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    
-    fPulseHVsCharge[0]        = std::make_unique<TH2D>("PHVsChrg0",     ";PH;Q",     100,  0.,  100., 100,  0., 2000.);
-    fPulseHVsCharge[1]        = std::make_unique<TH2D>("PHVsChrg1",     ";PH;Q",     100,  0.,  100., 100,  0., 2000.);
-    fPulseHVsCharge[2]        = std::make_unique<TH2D>("PHVsChrg2",     ";PH;Q",     100,  0.,  100., 100,  0., 2000.);
-    
-    fPulseHVsHitNo[0]         = std::make_unique<TProfile>("PHVsNo0",   ";Hit #;PH", 1000, 0., 1000., 0., 100.);
-    fPulseHVsHitNo[1]         = std::make_unique<TProfile>("PHVsNo1",   ";Hit #;PH", 1000, 0., 1000., 0., 100.);
-    fPulseHVsHitNo[2]         = std::make_unique<TProfile>("PHVsNo2",   ";Hit #;PH", 1000, 0., 1000., 0., 100.);
-    
-    fChargeVsHitNo[0]         = std::make_unique<TProfile>("QVsNo0",    ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
-    fChargeVsHitNo[1]         = std::make_unique<TProfile>("QVsNo1",    ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
-    fChargeVsHitNo[2]         = std::make_unique<TProfile>("QVsNo2",    ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
-    
-    fChargeVsHitNoS[0]        = std::make_unique<TProfile>("QVsNoS0",   ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
-    fChargeVsHitNoS[1]        = std::make_unique<TProfile>("QVsNoS1",   ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
-    fChargeVsHitNoS[2]        = std::make_unique<TProfile>("QVsNoS2",   ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
-    
-    fBadWPulseHeight          = std::make_unique<TH1D>("BWPulseHeight", "PH (ADC)",  300,  0.,  150.);
-    fBadWPulseHVsWidth        = std::make_unique<TH2D>("BWPHVsWidth",   ";PH;Width", 100,  0.,  100., 100,  0., 10.);
-    fBadWHitsByWire           = std::make_unique<TH1D>("BWHitsByWire",  ";Wire #", fGeometry->Nwires({ 0, 0, 2 }), 0., fGeometry->Nwires({ 0, 0, 2 }));
-    
-    fSPHvsIdx[0]              = std::make_unique<TH2D>("SPHVsIdx0",     ";PH;Idx", 30,  0.,  30., 100,  0., 100.);
-    fSPHvsIdx[1]              = std::make_unique<TH2D>("SPHVsIdx1",     ";PH;Idx", 30,  0.,  30., 100,  0., 100.);
-    fSPHvsIdx[2]              = std::make_unique<TH2D>("SPHVsIdx2",     ";PH;Idx", 30,  0.,  30., 100,  0., 100.);
-    
-    fSWidVsIdx[0]             = std::make_unique<TH2D>("SWidsIdx0",     ";Width;Idx", 30,  0.,  30., 100,  0., 10.);
-    fSWidVsIdx[1]             = std::make_unique<TH2D>("SWidsIdx1",     ";Width;Idx", 30,  0.,  30., 100,  0., 10.);
-    fSWidVsIdx[2]             = std::make_unique<TH2D>("SWidsIdx2",     ";Width;Idx", 30,  0.,  30., 100,  0., 10.);
-    
-    f1PPHvsWid[0]             = std::make_unique<TH2D>("1PPHVsWid0",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    f1PPHvsWid[1]             = std::make_unique<TH2D>("1PPHVsWid1",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    f1PPHvsWid[2]             = std::make_unique<TH2D>("1PPHVsWid2",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    
-    fSPPHvsWid[0]             = std::make_unique<TH2D>("SPPHVsWid0",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    fSPPHvsWid[1]             = std::make_unique<TH2D>("SPPHVsWid1",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    fSPPHvsWid[2]             = std::make_unique<TH2D>("SPPHVsWid2",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    
-    fSOPHvsWid[0]             = std::make_unique<TH2D>("SOPHVsWid0",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    fSOPHvsWid[1]             = std::make_unique<TH2D>("SOPHVsWid1",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    fSOPHvsWid[2]             = std::make_unique<TH2D>("SOPHVsWid2",    ";PH;Width", 100,  0.,  100., 100,  0., 20.);
-    
-    fPHRatVsIdx[0]            = std::make_unique<TH2D>("PHRatVsIdx0",   ";PHRat;Idx", 30,  0.,  30., 51,  0., 1.02);
-    fPHRatVsIdx[1]            = std::make_unique<TH2D>("PHRatVsIdx1",   ";PHRat;Idx", 30,  0.,  30., 51,  0., 1.02);
-    fPHRatVsIdx[2]            = std::make_unique<TH2D>("PHRatVsIdx2",   ";PHRat;Idx", 30,  0.,  30., 51,  0., 1.02);
-
-    // Now attach them to the output file
-    for(int idx = 0; idx < 3; idx++)
+    // One set of histograms for each plane of each TPC
+    const unsigned int nCryostats = fGeometry->Ncryostats();
+    const unsigned int maxTPCs    = fGeometry->MaxTPCs();
+    const unsigned int maxPlanes  = fGeometry->MaxPlanes();
+    
+    auto const allocate = [=](auto& planeHists)
+        { planeHists = std::decay_t<decltype(planeHists)>{ nCryostats, maxTPCs, maxPlanes }; };
+    
+    allocate(fHitsByWire);        allocate(fDriftTimes);       allocate(fHitsByTime);
+    allocate(fPulseHeight);       allocate(fPulseHeightSingle); allocate(fPulseHeightMulti);
+    allocate(fChi2DOF);           allocate(fNumDegFree);       allocate(fChi2DOFSingle);
+    allocate(fHitMult);           allocate(fHitCharge);        allocate(fFitWidth);
+    allocate(fHitSumADC);         allocate(fNDFVsChi2);        allocate(fPulseHVsWidth);
+    allocate(fPulseHVsCharge);    allocate(fPulseHVsHitNo);    allocate(fChargeVsHitNo);
+    allocate(fChargeVsHitNoS);    allocate(fSPHvsIdx);         allocate(fSWidVsIdx);
+    allocate(f1PPHvsWid);         allocate(fSPPHvsWid);        allocate(fSOPHvsWid);
+    allocate(fPHRatVsIdx);
+    fHitColumns = icarus::ns::util::HitColumns{ geometry };
+    fColumns.assign(fHitColumns.layout().nPlanes(), PlaneColumns{});
+    
+    TDirectory* dir = fRootDirectory;
+    
+    for(const geo::PlaneID& planeID : fGeometry->Iterate<geo::PlaneID>())
     {
-        fHitsByWire[idx]->SetDirectory(fRootDirectory);
-        fDriftTimes[idx]->SetDirectory(fRootDirectory);
-        fHitsByTime[idx]->SetDirectory(fRootDirectory);
-        fPulseHeight[idx]->SetDirectory(fRootDirectory);
-        fPulseHeightSingle[idx]->SetDirectory(fRootDirectory);
-        fPulseHeightMulti[idx]->SetDirectory(fRootDirectory);
-        fChi2DOF[idx]->SetDirectory(fRootDirectory);
-        fNumDegFree[idx]->SetDirectory(fRootDirectory);
-        fChi2DOFSingle[idx]->SetDirectory(fRootDirectory);
-        fHitMult[idx]->SetDirectory(fRootDirectory);
-        fHitCharge[idx]->SetDirectory(fRootDirectory);
-        fFitWidth[idx]->SetDirectory(fRootDirectory);
-        fHitSumADC[idx]->SetDirectory(fRootDirectory);
-        fNDFVsChi2[idx]->SetDirectory(fRootDirectory);
-        fPulseHVsWidth[idx]->SetDirectory(fRootDirectory);
-        fPulseHVsCharge[idx]->SetDirectory(fRootDirectory);
-        fPulseHVsHitNo[idx]->SetDirectory(fRootDirectory);
-        fChargeVsHitNo[idx]->SetDirectory(fRootDirectory);
-        fChargeVsHitNoS[idx]->SetDirectory(fRootDirectory);
+        const unsigned int nWires = fGeometry->Nwires(planeID);
+        
+        fHitsByWire[planeID]        = makePlaneHist<TH1D>("HitsByWire",  planeID, dir, ";Wire #", nWires, 0., nWires);
+        
+        fDriftTimes[planeID]        = makePlaneHist<TH1D>("DriftTime",   planeID, dir, ";time(ticks)", 3200, 0., 9600.);
+        
+        fHitsByTime[planeID]        = makePlaneHist<TH1D>("HitsByTime",  planeID, dir, ";Tick",   1600, 0., 6400.);
+        
+        fPulseHeight[planeID]       = makePlaneHist<TH1D>("PulseHeight", planeID, dir, "PH (ADC)",  300,  0.,  150.);
+        fPulseHeightSingle[planeID] = makePlaneHist<TH1D>("PulseHeightS",planeID, dir, "PH (ADC)",  300,  0.,  150.);
+        fPulseHeightMulti[planeID]  = makePlaneHist<TH1D>("PulseHeightM",planeID, dir, "PH (ADC)",  300,  0.,  150.);
+        fChi2DOF[planeID]           = makePlaneHist<TH1D>("Chi2DOF",     planeID, dir, "Chi2DOF",   502, -1.,  250.);
+        fNumDegFree[planeID]        = makePlaneHist<TH1D>("NumDegFree",  planeID, dir, "NDF",       100,  0.,  100.);
+        fChi2DOFSingle[planeID]     = makePlaneHist<TH1D>("Chi2DOFS",    planeID, dir, "Chi2DOF",   502, -1.,  250.);
+        fHitMult[planeID]           = makePlaneHist<TH1D>("HitMult",     planeID, dir, "# hits",     15,  0.,   15.);
+        fHitCharge[planeID]         = makePlaneHist<TH1D>("HitCharge",   planeID, dir, "Charge",   1000,  0., 2000.);
+        fFitWidth[planeID]          = makePlaneHist<TH1D>("FitWidth",    planeID, dir, "Width",     100,  0.,   10.);
+        fHitSumADC[planeID]         = makePlaneHist<TH1D>("SumADC",      planeID, dir, "Sum ADC",  1000,  0., 2000.);
+        
+        fNDFVsChi2[planeID]         = makePlaneHist<TH2D>("NDFVsChi2",   planeID, dir, ";NDF;Chi2",  50,  0.,   50., 101, -1., 100.);
+        
+        fPulseHVsWidth[planeID]     = makePlaneHist<TH2D>("PHVsWidth",   planeID, dir, ";PH;Width", 100,  0.,  100., 100,  0., 20.);
+        
+        fPulseHVsCharge[planeID]    = makePlaneHist<TH2D>("PHVsChrg",    planeID, dir, ";PH;Q",     100,  0.,  100., 100,  0., 2000.);
+        
+        fPulseHVsHitNo[planeID]     = makePlaneHist<TProfile>("PHVsNo",  planeID, dir, ";Hit #;PH", 1000, 0., 1000., 0., 100.);
+        
+        fChargeVsHitNo[planeID]     = makePlaneHist<TProfile>("QVsNo",   planeID, dir, ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
+        
+        fChargeVsHitNoS[planeID]    = makePlaneHist<TProfile>("QVsNoS",  planeID, dir, ";Hit No;Q", 1000, 0., 1000., 0., 2000.);
         
-        fSPHvsIdx[idx]->SetDirectory(fRootDirectory);
-        fSWidVsIdx[idx]->SetDirectory(fRootDirectory);
-        f1PPHvsWid[idx]->SetDirectory(fRootDirectory);
-        fSPPHvsWid[idx]->SetDirectory(fRootDirectory);
-        fSOPHvsWid[idx]->SetDirectory(fRootDirectory);
-        fPHRatVsIdx[idx]->SetDirectory(fRootDirectory);
+        fSPHvsIdx[planeID]          = makePlaneHist<TH2D>("SPHVsIdx",    planeID, dir, ";PH;Idx", 30,  0.,  30., 100,  0., 100.);
+        
+        fSWidVsIdx[planeID]         = makePlaneHist<TH2D>("SWidsIdx",    planeID, dir, ";Width;Idx", 30,  0.,  30., 100,  0., 10.);
+        
+        f1PPHvsWid[planeID]         = makePlaneHist<TH2D>("1PPHVsWid",   planeID, dir, ";PH;Width", 100,  0.,  100., 100,  0., 20.);
+        
+        fSPPHvsWid[planeID]         = makePlaneHist<TH2D>("SPPHVsWid",   planeID, dir, ";PH;Width", 100,  0.,  100., 100,  0., 20.);
+        
+        fSOPHvsWid[planeID]         = makePlaneHist<TH2D>("SOPHVsWid",   planeID, dir, ";PH;Width", 100,  0.,  100., 100,  0., 20.);
+        
+        fPHRatVsIdx[planeID]        = makePlaneHist<TH2D>("PHRatVsIdx",  planeID, dir, ";PHRat;Idx", 30,  0.,  30., 51,  0., 1.02);
     }
     
     // get the overall now
+    fBadWPulseHeight          = std::make_unique<TH1D>("BWPulseHeight", "PH (ADC)",  300,  0.,  150.);
+    fBadWPulseHVsWidth        = std::make_unique<TH2D>("BWPHVsWidth",   ";PH;Width", 100,  0.,  100., 100,  0., 10.);
+    fBadWHitsByWire           = std::make_unique<TH1D>("BWHitsByWire",  ";Wire #", fGeometry->Nwires({ 0, 0, 2 }), 0., fGeometry->Nwires({ 0, 0, 2 }));
+    
     fBadWPulseHeight->SetDirectory(fRootDirectory);
     fBadWPulseHVsWidth->SetDirectory(fRootDirectory);
     fBadWHitsByWire->SetDirectory(fRootDirectory);
+    
+    // The table of hits, for studies not needing to read the art files again
+    if (fWriteHitTable)
+    {
+        fHitTable = std::make_unique<HitTable>(fRootDirectory, "Hits", HitTable::Names_t{
+            "cryostat", "tpc", "plane", "wire", "peakTime", "rms", "peakAmplitude",
+            "integral", "summedADC", "chi2DOF", "ndf", "multiplicity"
+            });
+    }
 
     return;
 }
@@ -218,9 +208,11 @@ void HitAnalysisAlg::fillHistograms(const TrackPlaneHitMap& trackPlaneHitMap) co
         
             for(const auto& hit : planeHitPair.second)
             {
-                if (hit.Multiplicity() < 2) fChargeVsHitNoS[planeHitPair.first]->Fill(float(hitNo)+0.5, std::min(float(1999.),hit.Integral()), 1.);
-                fPulseHVsHitNo[planeHitPair.first]->Fill(float(hitNo)+0.5, std::min(float(99.9),hit.PeakAmplitude()), 1.);
-                fChargeVsHitNo[planeHitPair.first]->Fill(float(hitNo)+0.5, std::min(float(1999.),hit.Integral()), 1.);
+                const geo::PlaneID& planeID = hit.WireID();
+                
+                if (hit.Multiplicity() < 2) fChargeVsHitNoS[planeID]->Fill(float(hitNo)+0.5, std::min(float(1999.),hit.Integral()), 1.);
+                fPulseHVsHitNo[planeID]->Fill(float(hitNo)+0.5, std::min(float(99.9),hit.PeakAmplitude()), 1.);
+                fChargeVsHitNo[planeID]->Fill(float(hitNo)+0.5, std::min(float(1999.),hit.Integral()), 1.);
                 hitNo++;
             }
         }
@@ -231,28 +223,58 @@ void HitAnalysisAlg::fillHistograms(const TrackPlaneHitMap& trackPlaneHitMap) co
     
 void HitAnalysisAlg::fillHistograms(const HitVec& hitVec) const
 {
-    // Keep track of number of hits per plane
-    size_t nHitsPerPlane[] = {0,0,0};
+    // Decode the hits once, then work on their columns
+    fHitColumns.fill(hitVec);
+    
+    fillHistograms(fHitColumns);
+}
+    
+void HitAnalysisAlg::fillHistograms(const icarus::ns::util::HitColumns& hits) const
+{
+    using icarus::ns::util::HitColumns;
+    
+    // Hit quantities are first collected in columns, plane by plane,
+    // and then each column is binned at once
+    const HitColumns::Layout_t& layout = hits.layout();
+    
+    if (fColumns.size() != layout.nPlanes()) fColumns.resize(layout.nPlanes());
+    for(PlaneColumns& columns : fColumns) columns.clear();
+    
+    const HitColumns::Index_t* planeIndices   = hits.planeIndex();
+    const auto*                cryostats      = hits.cryostat();
+    const auto*                tpcs           = hits.TPC();
+    const auto*                planes         = hits.plane();
+    const auto*                wires          = hits.wire();
+    const float*               goodnessOfFits = hits.goodnessOfFit();
+    const int*                 degsOfFreedom  = hits.degreesOfFreedom();
+    const int*                 multiplicities = hits.multiplicity();
+    const int*                 localIndices   = hits.localIndex();
+    const float*               peakTimes      = hits.peakTime();
+    const float*               integrals      = hits.integral();
+    const float*               summedADCs     = hits.summedADC();
+    const float*               peakAmplitudes = hits.peakAmplitude();
+    const float*               RMSs           = hits.RMS();
+    
     size_t negCount(0);
     
-    std::vector<const recob::Hit*> hitSnippetVec;
+    // Rows of the hits of the current snippet
+    std::vector<size_t> hitSnippetVec;
     
     // Loop the hits and make some plots
-    for(const auto& hit : hitVec)
+    for(size_t iHit = 0; iHit < hits.size(); ++iHit)
     {
         // Extract interesting hit parameters
-        const geo::WireID& wireID   = hit.WireID();
-        float              chi2DOF  = std::min(hit.GoodnessOfFit(),float(249.8));
-        int                numDOF   = hit.DegreesOfFreedom();
-        int                hitMult  = hit.Multiplicity();
-        float              peakTime = hit.PeakTime();
-        float              charge   = hit.Integral();
-        float              sumADC   = hit.SummedADC();
-        float              hitPH    = std::min(hit.PeakAmplitude(),float(249.8));
-        float              hitSigma = hit.RMS();
+        float              chi2DOF  = std::min(goodnessOfFits[iHit],float(249.8));
+        int                numDOF   = degsOfFreedom[iHit];
+        int                hitMult  = multiplicities[iHit];
+        float              peakTime = peakTimes[iHit];
+        float              charge   = integrals[iHit];
+        float              sumADC   = summedADCs[iHit];
+        float              hitPH    = std::min(peakAmplitudes[iHit],float(249.8));
+        float              hitSigma = RMSs[iHit];
         
-        size_t             plane    = wireID.Plane;
-        size_t             wire     = wireID.Wire;
+        size_t             plane    = planes[iHit];
+        size_t             wire     = wires[iHit];
         
 //        if (plane == 2 && (wire == 18 || wire == 527 || wire == 528)) continue;
         
@@ -263,26 +285,35 @@ void HitAnalysisAlg::fillHistograms(const HitVec& hitVec) const
             std::cout << "Hit plane: " << plane << ", wire: " << wire << ", T: " << peakTime << ", PH: " << hitPH << ", charge: " << charge << ", sumADC: " << sumADC << std::endl;
         }
         
-        nHitsPerPlane[plane]++;
+        if (fHitTable)
+        {
+            fHitTable->push(cryostats[iHit], tpcs[iHit], planes[iHit], wires[iHit],
+                            peakTime, hitSigma, peakAmplitudes[iHit], charge, sumADC,
+                            goodnessOfFits[iHit], numDOF, hitMult);
+        }
+        
+        // Hits on planes unknown to the geometry are not plotted
+        if (planeIndices[iHit] == HitColumns::NoIndex) continue;
+        
+        PlaneColumns& columns = fColumns[planeIndices[iHit]];
         
-        fHitsByWire[plane]->Fill(wire,1.);
-        fHitsByTime[plane]->Fill(peakTime, 1.);
-        fPulseHeight[plane]->Fill(hitPH, 1.);
-        fChi2DOF[plane]->Fill(chi2DOF, 1.);
-        fNumDegFree[plane]->Fill(numDOF, 1.);
-        fHitMult[plane]->Fill(hitMult, 1.);
-        fHitCharge[plane]->Fill(charge, 1.);
-        fFitWidth[plane]->Fill(std::min(float(19.99),hitSigma), 1.);
-        fHitSumADC[plane]->Fill(sumADC, 1.);
-        fNDFVsChi2[plane]->Fill(numDOF, chi2DOF, 1.);
-        fDriftTimes[plane]->Fill(peakTime, 1.);
+        columns.wire.push_back(wire);
+        columns.peakTime.push_back(peakTime);
+        columns.pulseHeight.push_back(hitPH);
+        columns.chi2DOF.push_back(chi2DOF);
+        columns.numDOF.push_back(numDOF);
+        columns.hitMult.push_back(hitMult);
+        columns.charge.push_back(charge);
+        columns.width.push_back(std::min(float(19.99),hitSigma));
+        columns.sumADC.push_back(sumADC);
         
         if (hitMult == 1)
         {
-            fPulseHeightSingle[plane]->Fill(hitPH, 1.);
-            fChi2DOFSingle[plane]->Fill(chi2DOF, 1.);
-            fPulseHVsWidth[plane]->Fill(std::min(float(99.9),hitPH), std::min(float(19.99),hitSigma), 1.);
-            fPulseHVsCharge[plane]->Fill(std::min(float(99.9),hitPH), std::min(float(1999.),charge), 1.);
+            columns.pulseHeightSingle.push_back(hitPH);
+            columns.chi2DOFSingle.push_back(chi2DOF);
+            columns.cappedPHSingle.push_back(std::min(float(99.9),hitPH));
+            columns.cappedWidthSingle.push_back(std::min(float(19.99),hitSigma));
+            columns.cappedChargeSingle.push_back(std::min(float(1999.),charge));
             
             if (plane == 2 && hitPH < 5 && hitSigma < 2.2)
             {
@@ -294,99 +325,141 @@ void HitAnalysisAlg::fillHistograms(const HitVec& hitVec) const
             }
         }
         else
-            fPulseHeightMulti[plane]->Fill(hitPH, 1.);
+            columns.pulseHeightMulti.push_back(hitPH);
         
         // Look at hits on snippets
-        if (!hitSnippetVec.empty() && hitSnippetVec.back()->LocalIndex() >= hit.LocalIndex())
+        if (!hitSnippetVec.empty() && localIndices[hitSnippetVec.back()] >= localIndices[iHit])
         {
             // Only worried about multi hit snippets
             if (hitSnippetVec.size() > 1)
             {
                 // Sort in order of largest to smallest pulse height
-                std::sort(hitSnippetVec.begin(),hitSnippetVec.end(),[](const auto* left, const auto* right){return left->PeakAmplitude() > right->PeakAmplitude();});
+                std::sort(hitSnippetVec.begin(),hitSnippetVec.end(),[peakAmplitudes](size_t left, size_t right){return peakAmplitudes[left] > peakAmplitudes[right];});
                 
-                float maxPulseHeight = hitSnippetVec.front()->PeakAmplitude();
+                float maxPulseHeight = peakAmplitudes[hitSnippetVec.front()];
                 
                 for(size_t idx = 0; idx < hitSnippetVec.size(); idx++)
                 {
-                    float pulseHeight      = hitSnippetVec.at(idx)->PeakAmplitude();
-                    float pulseWid         = hitSnippetVec.at(idx)->RMS();
+                    float pulseHeight      = peakAmplitudes[hitSnippetVec.at(idx)];
+                    float pulseWid         = RMSs[hitSnippetVec.at(idx)];
                     float pulseHeightRatio = pulseHeight / maxPulseHeight;
                     
-                    size_t plane = hitSnippetVec.at(idx)->WireID().Plane;
+                    const geo::PlaneID snippetPlaneID = hits.planeID(hitSnippetVec.at(idx));
                     
-                    fSPHvsIdx[plane]->Fill(idx, std::min(float(99.9),pulseHeight), 1.);
-                    fSWidVsIdx[plane]->Fill(idx, std::min(float(19.99),pulseWid), 1.);
-                    fPHRatVsIdx[plane]->Fill(idx, pulseHeightRatio, 1.);
+                    fSPHvsIdx[snippetPlaneID]->Fill(idx, std::min(float(99.9),pulseHeight), 1.);
+                    fSWidVsIdx[snippetPlaneID]->Fill(idx, std::min(float(19.99),pulseWid), 1.);
+                    fPHRatVsIdx[snippetPlaneID]->Fill(idx, pulseHeightRatio, 1.);
                     
-                    if (idx == 0) fSPPHvsWid[plane]->Fill(std::min(float(99.9),pulseHeight), std::min(float(19.99),pulseWid), 1.);
-                    else          fSOPHvsWid[plane]->Fill(std::min(float(99.9),pulseHeight), std::min(float(19.99),pulseWid), 1.);
+                    if (idx == 0) fSPPHvsWid[snippetPlaneID]->Fill(std::min(float(99.9),pulseHeight), std::min(float(19.99),pulseWid), 1.);
+                    else          fSOPHvsWid[snippetPlaneID]->Fill(std::min(float(99.9),pulseHeight), std::min(float(19.99),pulseWid), 1.);
                 }
             }
             else
             {
-                float  pulseHeight = hitSnippetVec.front()->PeakAmplitude();
-                float  pulseWid    = hitSnippetVec.front()->RMS();
-                size_t plane        = hitSnippetVec.front()->WireID().Plane;
+                float  pulseHeight = peakAmplitudes[hitSnippetVec.front()];
+                float  pulseWid    = RMSs[hitSnippetVec.front()];
+                const geo::PlaneID snippetPlaneID = hits.planeID(hitSnippetVec.front());
                 
-                f1PPHvsWid[plane]->Fill(std::min(float(99.9),pulseHeight), std::min(float(19.99),pulseWid), 1.);
+                f1PPHvsWid[snippetPlaneID]->Fill(std::min(float(99.9),pulseHeight), std::min(float(19.99),pulseWid), 1.);
             }
             
             hitSnippetVec.clear();
         }
         
-        hitSnippetVec.push_back(&hit);
+        hitSnippetVec.push_back(iHit);
+    }
+    
+    // Now bin the columns of each plane
+    for(const geo::PlaneID& planeID : fGeometry->Iterate<geo::PlaneID>())
+    {
+        if (layout.hasPlane(planeID)) fillPlaneHistograms(planeID, fColumns[layout.planeIndex(planeID)]);
     }
     
     return;
 }
     
+void HitAnalysisAlg::fillPlaneHistograms(const geo::PlaneID& planeID, const PlaneColumns& columns) const
+{
+    if (columns.wire.empty()) return;
+    
+    fillColumn(*fHitsByWire[planeID],        columns.wire);
+    fillColumn(*fHitsByTime[planeID],        columns.peakTime);
+    fillColumn(*fPulseHeight[planeID],       columns.pulseHeight);
+    fillColumn(*fChi2DOF[planeID],           columns.chi2DOF);
+    fillColumn(*fNumDegFree[planeID],        columns.numDOF);
+    fillColumn(*fHitMult[planeID],           columns.hitMult);
+    fillColumn(*fHitCharge[planeID],         columns.charge);
+    fillColumn(*fFitWidth[planeID],          columns.width);
+    fillColumn(*fHitSumADC[planeID],         columns.sumADC);
+    fillColumns(*fNDFVsChi2[planeID],        columns.numDOF, columns.chi2DOF);
+    fillColumn(*fDriftTimes[planeID],        columns.peakTime);
+    
+    fillColumn(*fPulseHeightSingle[planeID], columns.pulseHeightSingle);
+    fillColumn(*fChi2DOFSingle[planeID],     columns.chi2DOFSingle);
+    fillColumns(*fPulseHVsWidth[planeID],    columns.cappedPHSingle, columns.cappedWidthSingle);
+    fillColumns(*fPulseHVsCharge[planeID],   columns.cappedPHSingle, columns.cappedChargeSingle);
+    
+    fillColumn(*fPulseHeightMulti[planeID],  columns.pulseHeightMulti);
+    
+    return;
+}
+    
+void HitAnalysisAlg::PlaneColumns::clear()
+{
+    for(auto* column : { &wire, &peakTime, &pulseHeight, &chi2DOF, &numDOF, &hitMult, &charge, &width, &sumADC,
+                         &pulseHeightSingle, &chi2DOFSingle, &cappedPHSingle, &cappedWidthSingle, &cappedChargeSingle,
+                         &pulseHeightMulti })
+        column->clear();
+}
+    
 // Useful for normalizing histograms
 void HitAnalysisAlg::endJob(int numEvents)
 {
     // Normalize wire profiles to be hits/event
     double normFactor(1./numEvents);
     
-    for(size_t idx = 0; idx < 3; idx++) fHitsByWire[idx]->Scale(normFactor);
+    for(const geo::PlaneID& planeID : fGeometry->Iterate<geo::PlaneID>()) fHitsByWire[planeID]->Scale(normFactor);
     
     // Now write out everything...
     fRootDirectory->cd();
     
     // Start by looping over the planes
-    for(int idx = 0; idx < 3; idx++)
+    for(const geo::PlaneID& planeID : fGeometry->Iterate<geo::PlaneID>())
     {
-        fHitsByWire[idx]->Write();
-        fDriftTimes[idx]->Write();
-        fHitsByTime[idx]->Write();
-        fPulseHeight[idx]->Write();
-        fPulseHeightSingle[idx]->Write();
-        fPulseHeightMulti[idx]->Write();
-        fChi2DOF[idx]->Write();
-        fNumDegFree[idx]->Write();
-        fChi2DOFSingle[idx]->Write();
-        fHitMult[idx]->Write();
-        fHitCharge[idx]->Write();
-        fFitWidth[idx]->Write();
-        fHitSumADC[idx]->Write();
-        fNDFVsChi2[idx]->Write();
-        fPulseHVsWidth[idx]->Write();
-        fPulseHVsCharge[idx]->Write();
-        fPulseHVsHitNo[idx]->Write();
-        fChargeVsHitNo[idx]->Write();
-        fChargeVsHitNoS[idx]->Write();
+        fHitsByWire[planeID]->Write();
+        fDriftTimes[planeID]->Write();
+        fHitsByTime[planeID]->Write();
+        fPulseHeight[planeID]->Write();
+        fPulseHeightSingle[planeID]->Write();
+        fPulseHeightMulti[planeID]->Write();
+        fChi2DOF[planeID]->Write();
+        fNumDegFree[planeID]->Write();
+        fChi2DOFSingle[planeID]->Write();
+        fHitMult[planeID]->Write();
+        fHitCharge[planeID]->Write();
+        fFitWidth[planeID]->Write();
+        fHitSumADC[planeID]->Write();
+        fNDFVsChi2[planeID]->Write();
+        fPulseHVsWidth[planeID]->Write();
+        fPulseHVsCharge[planeID]->Write();
+        fPulseHVsHitNo[planeID]->Write();
+        fChargeVsHitNo[planeID]->Write();
+        fChargeVsHitNoS[planeID]->Write();
         
-        fSPHvsIdx[idx]->Write();
-        fSWidVsIdx[idx]->Write();
-        f1PPHvsWid[idx]->Write();
-        fSPPHvsWid[idx]->Write();
-        fSOPHvsWid[idx]->Write();
-        fPHRatVsIdx[idx]->Write();
+        fSPHvsIdx[planeID]->Write();
+        fSWidVsIdx[planeID]->Write();
+        f1PPHvsWid[planeID]->Write();
+        fSPPHvsWid[planeID]->Write();
+        fSOPHvsWid[planeID]->Write();
+        fPHRatVsIdx[planeID]->Write();
     }
     
     // get the overall now
     fBadWPulseHeight->Write();
     fBadWPulseHVsWidth->Write();
     fBadWHitsByWire->Write();
+    
+    if (fHitTable) fHitTable->write();
 
     return;
 }
@@ -12,6 +12,7 @@
 // Configuration parameters:
 //
 // TruncMeanFraction     - the fraction of waveform bins to discard when
+// HitTable              - also write a flat table with one row per hit
 //
 // Created by Tracy Usher (usher@slac.stanford.edu) on February 19, 2016
 //
@@ -20,15 +21,23 @@
 #include "fhiclcpp/ParameterSet.h"
 
 #include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/GeometryDataContainers.h"
 
 #include "lardataobj/RecoBase/Hit.h"
 
+#include "icarusalg/gallery/helpers/C++/ColumnWriter.h"
+#include "icarusalg/Utilities/HitColumns.h"
+
 #include "TDirectory.h"
 #include "TH1.h"
 #include "TH2.h"
 #include "TProfile.h"
 #include "TProfile2D.h"
 
+#include <memory>
+#include <vector>
+#include <map>
+
 namespace HitAnalysis
 {
     
@@ -53,42 +62,78 @@ public:
     void fillHistograms(const TrackPlaneHitMap&) const;
     void fillHistograms(const HitVec&)           const;
     
+    // the hit table must have been filled with the layout of the geometry from setup()
+    void fillHistograms(const icarus::ns::util::HitColumns&) const;
+    
 private:
 
     // Fcl parameters.
     std::string fLocalDirName;     ///< Fraction for truncated mean
+    bool        fWriteHitTable;    ///< Whether to write a table of all hits
     TDirectory* fRootDirectory;
     
-    // Pointers to the histograms we'll create.
-    std::unique_ptr<TH1D>     fHitsByWire[3];
-    std::unique_ptr<TH1D>     fDriftTimes[3];
-    std::unique_ptr<TH1D>     fHitsByTime[3];
-    std::unique_ptr<TH1D>     fPulseHeight[3];
-    std::unique_ptr<TH1D>     fPulseHeightSingle[3];
-    std::unique_ptr<TH1D>     fPulseHeightMulti[3];
-    std::unique_ptr<TH1D>     fChi2DOF[3];
-    std::unique_ptr<TH1D>     fNumDegFree[3];
-    std::unique_ptr<TH1D>     fChi2DOFSingle[3];
-    std::unique_ptr<TH1D>     fHitMult[3];
-    std::unique_ptr<TH1D>     fHitCharge[3];
-    std::unique_ptr<TH1D>     fFitWidth[3];
-    std::unique_ptr<TH1D>     fHitSumADC[3];
-    std::unique_ptr<TH2D>     fNDFVsChi2[3];
-    std::unique_ptr<TH2D>     fPulseHVsWidth[3];
-    std::unique_ptr<TH2D>     fPulseHVsCharge[3];
-    std::unique_ptr<TH1D>     fBadWPulseHeight;
-    std::unique_ptr<TH2D>     fBadWPulseHVsWidth;
-    std::unique_ptr<TH1D>     fBadWHitsByWire;
-    std::unique_ptr<TProfile> fPulseHVsHitNo[3];
-    std::unique_ptr<TProfile> fChargeVsHitNo[3];
-    std::unique_ptr<TProfile> fChargeVsHitNoS[3];
+    // Flat table of hits: cryostat, TPC, plane, wire, peak time, RMS,
+    // peak amplitude, integral, summed ADC, chi2/DOF, DOF, multiplicity
+    using HitTable = ColumnWriter<
+        unsigned int, unsigned int, unsigned int, unsigned int,
+        float, float, float, float, float, float, int, int
+        >;
+    std::unique_ptr<HitTable> fHitTable;
+    
+    // Pointers to the histograms we'll create, one of each for every plane
+    template <typename Hist>
+    using PlaneHists = geo::PlaneDataContainer<std::unique_ptr<Hist>>;
+    
+    PlaneHists<TH1D>     fHitsByWire;
+    PlaneHists<TH1D>     fDriftTimes;
+    PlaneHists<TH1D>     fHitsByTime;
+    PlaneHists<TH1D>     fPulseHeight;
+    PlaneHists<TH1D>     fPulseHeightSingle;
+    PlaneHists<TH1D>     fPulseHeightMulti;
+    PlaneHists<TH1D>     fChi2DOF;
+    PlaneHists<TH1D>     fNumDegFree;
+    PlaneHists<TH1D>     fChi2DOFSingle;
+    PlaneHists<TH1D>     fHitMult;
+    PlaneHists<TH1D>     fHitCharge;
+    PlaneHists<TH1D>     fFitWidth;
+    PlaneHists<TH1D>     fHitSumADC;
+    PlaneHists<TH2D>     fNDFVsChi2;
+    PlaneHists<TH2D>     fPulseHVsWidth;
+    PlaneHists<TH2D>     fPulseHVsCharge;
+    std::unique_ptr<TH1D> fBadWPulseHeight;
+    std::unique_ptr<TH2D> fBadWPulseHVsWidth;
+    std::unique_ptr<TH1D> fBadWHitsByWire;
+    PlaneHists<TProfile> fPulseHVsHitNo;
+    PlaneHists<TProfile> fChargeVsHitNo;
+    PlaneHists<TProfile> fChargeVsHitNoS;
+    
+    PlaneHists<TH2D>     fSPHvsIdx;
+    PlaneHists<TH2D>     fSWidVsIdx;
+    PlaneHists<TH2D>     f1PPHvsWid;
+    PlaneHists<TH2D>     fSPPHvsWid;
+    PlaneHists<TH2D>     fSOPHvsWid;
+    PlaneHists<TH2D>     fPHRatVsIdx;
+    
+    // Hit quantities of one plane, one column per quantity, filled together
+    struct PlaneColumns
+    {
+        std::vector<double> wire, peakTime, pulseHeight, chi2DOF, numDOF;
+        std::vector<double> hitMult, charge, width, sumADC;
+        std::vector<double> pulseHeightSingle, chi2DOFSingle;       // single hits
+        std::vector<double> cappedPHSingle, cappedWidthSingle, cappedChargeSingle;
+        std::vector<double> pulseHeightMulti;                       // multiple hits
+        
+        void clear();
+    };
+    
+    // Column buffers by plane index of the hit table, reused for all the events (hence mutable)
+    mutable std::vector<PlaneColumns> fColumns;
+    
+    // Table of the hits being processed, when they are passed as a vector
+    mutable icarus::ns::util::HitColumns fHitColumns;
     
-    std::unique_ptr<TH2D>     fSPHvsIdx[3];
-    std::unique_ptr<TH2D>     fSWidVsIdx[3];
-    std::unique_ptr<TH2D>     f1PPHvsWid[3];
-    std::unique_ptr<TH2D>     fSPPHvsWid[3];
-    std::unique_ptr<TH2D>     fSOPHvsWid[3];
-    std::unique_ptr<TH2D>     fPHRatVsIdx[3];
+    // Bins all the columns of a plane into its histograms
+    void fillPlaneHistograms(const geo::PlaneID&, const PlaneColumns&) const;
     
     // Useful services, keep copies for now (we can update during begin run periods)
     const geo::GeometryCore*           fGeometry;             ///< pointer to Geometry service
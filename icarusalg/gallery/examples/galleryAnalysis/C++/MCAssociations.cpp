@@ -13,16 +13,21 @@
 #include "nusimdata/SimulationBase/MCTruth.h"
 #include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
 #include "lardataobj/RecoBase/Hit.h"
-#include "larcorealg/Geometry/geo_vectors_utils.h" // geo::vect::toPoint()
+#include "larcorealg/Geometry/TPCGeo.h"
 
 // canvas libraries
-#include "canvas/Persistency/Common/FindMany.h"
+#include "canvas/Persistency/Common/FindManyP.h"
 
 // ROOT libraries
 #include "TVector3.h"
 
 // C/C++ standard libraries
-#include <algorithm> // std::count_if()
+#include <vector>
+#include <utility> // std::pair
+#include <numeric> // std::partial_sum()
+#include <algorithm> // std::count_if(), std::find(), std::max()
+#include <cstdint> // std::uint8_t
+#include <cstddef> // std::size_t
 
 
 MCAssociations::MCAssociations(fhicl::ParameterSet const& config)
@@ -40,6 +45,11 @@ void MCAssociations::setup(const geo::GeometryCore&           geometry,
     fGeometry           = &geometry;
     fDetectorProperties = std::make_unique<detinfo::DetectorPropertiesData const>(detectorProperties);
     fDir                = outDir->mkdir(fLocalDirName.c_str());
+    
+    // cache the active volumes, looked up for each trajectory point
+    fActiveVolumes = icarus::ns::util::BoxSet{};
+    for (const geo::TPCGeo& tpc : fGeometry->Iterate<geo::TPCGeo>())
+        fActiveVolumes.add(tpc.ActiveBoundingBox());
 }
 
 void MCAssociations::prepare()
@@ -115,97 +125,123 @@ void MCAssociations::prepare()
     return;
 } // MCAssociations::prepare()
 
-void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
+namespace
 {
-    // First step is to recover the MCTruth object vector...
-    const auto& mcParticleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fMCTruthProducerLabel);
-    
-    // Now see how many reco hits might be associated to this particle
-    art::FindMany<recob::Hit, anab::BackTrackerHitMatchingData> hitsPerMCParticle(mcParticleHandle, event, fAssnsProducerLabel);
-    
-    // Make maps, we really like to make maps
-    using HitToPartVecMap = std::map<const recob::Hit*,std::set<const simb::MCParticle*>>;
-    using PartToHitVecMap = std::map<const simb::MCParticle*, std::set<const recob::Hit*>>;
+    /**
+     * Truth table from hits to MC particles, as compressed rows indexed by
+     * hit key: the particles of the hit with key `k` are the indices in
+     * `particles` from `offsets[k]` to `offsets[k + 1]`, sorted.
+     * It also records how many hits each particle has.
+     */
+    struct HitParticleTable
+    {
+        std::vector<std::size_t> offsets;   ///< Start of the particles of each hit key.
+        std::vector<std::size_t> particles; ///< Indices of the particles, by hit key.
+        std::vector<std::size_t> nHits;     ///< Number of hits of each particle.
+        
+        /// Returns the number of hit keys covered by the table.
+        std::size_t nHitKeys() const { return offsets.empty()? 0: offsets.size() - 1; }
+        
+        /// Returns whether the hit with `key` is associated to particle `mcIdx`.
+        bool hasParticle(std::size_t key, std::size_t mcIdx) const
+        {
+            if (key >= nHitKeys()) return false;
+            auto const first = particles.begin() + offsets[key];
+            auto const last  = particles.begin() + offsets[key + 1];
+            return std::find(first, last, mcIdx) != last;
+        }
+    };
     
-    HitToPartVecMap hitToPartVecMap;
-    PartToHitVecMap partToHitVecMap;
-
-    // Loop through the particles
-    for(size_t mcIdx = 0; mcIdx < mcParticleHandle->size(); mcIdx++)
+    /// Builds the table from the hits associated to each of `nParticles` particles,
+    /// covering at least `minHitKeys` hit keys.
+    template <typename HitsPerParticle>
+    HitParticleTable makeHitParticleTable(HitsPerParticle const& hitsPerParticle, std::size_t nParticles,
+                                          std::size_t minHitKeys = 0)
     {
-        try
+        // collect all the (hit key, particle index) pairs, in particle order
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        std::size_t nHitKeys = minHitKeys;
+        for(size_t mcIdx = 0; mcIdx < nParticles; mcIdx++)
         {
-            const simb::MCParticle& mcParticle = mcParticleHandle->at(mcIdx);
-            
-            std::vector<const recob::Hit*> hitsVec = hitsPerMCParticle.at(mcIdx);
-            
-            for(const auto& hit : hitsVec)
+            for(const auto& hit : hitsPerParticle.at(mcIdx))
             {
-                hitToPartVecMap[hit].insert(&mcParticle);
-                partToHitVecMap[&mcParticle].insert(hit);
+                pairs.emplace_back(hit.key(), mcIdx);
+                nHitKeys = std::max(nHitKeys, std::size_t(hit.key() + 1));
             }
         }
-        catch(...) {break;}
-    }
-    
-    // In this section try looking at tracking. Eventually we want to move this out of here...
-    // First step is to recover the MCTruth object vector...
-    const auto& trackHandle = event.getValidHandle<std::vector<recob::Track>>(fTrackProducerLabel);
-    
-    // Now see how many reco hits might be associated to this particle
-    art::FindMany<recob::Hit> hitsPerTrack(trackHandle, event, fTrackProducerLabel);
-    
-    // Define a mapping between tracks and associated MCParticles
-    using TrackToParticleSetMap  = std::map<const recob::Track*, std::set<const simb::MCParticle*>>;
-    using ParticleToTrackSetMap  = std::map<const simb::MCParticle*, std::set<const recob::Track*>>;
-    using ParticleToHitSetMap    = std::map<const simb::MCParticle*, std::set<const recob::Hit*>>;
-    using TrackToPartHitSetMap   = std::map<const recob::Track*, ParticleToHitSetMap>;
-    using TrackToHitsVecMap      = std::map<const recob::Track*, std::vector<const recob::Hit*>>;
-    
-    TrackToParticleSetMap  trackToParticleSetMap;
-    ParticleToTrackSetMap  particleToTrackSetMap;
-    
-    TrackToPartHitSetMap   trackToPartHitSetMap;
-    TrackToHitsVecMap      trackToHitsVecMap;
-
-    // Loop through the tracks and associate via the hits to MCParticles
-    for(size_t trkIdx = 0; trkIdx < trackHandle->size(); trkIdx++)
-    {
-        const recob::Track& track = trackHandle->at(trkIdx);
-        
-        std::vector<const recob::Hit*> hitsVec = hitsPerTrack.at(trkIdx);
         
-        trackToHitsVecMap[&track] = hitsVec;
+        // counting sort by hit key: the particles of each hit stay sorted
+        HitParticleTable table;
+        table.offsets.assign(nHitKeys + 1, 0);
+        for(const auto& pair : pairs) ++table.offsets[pair.first + 1];
+        std::partial_sum(table.offsets.begin(), table.offsets.end(), table.offsets.begin());
         
-        ParticleToHitSetMap& particleToHitSetMap = trackToPartHitSetMap[&track];
+        table.particles.resize(pairs.size());
+        std::vector<std::size_t> next(table.offsets.begin(), table.offsets.end() - 1);
+        for(const auto& pair : pairs) table.particles[next[pair.first]++] = pair.second;
         
-        for(const auto& hit : hitsVec)
+        // drop repeated associations of the same hit and particle, and count hits
+        table.nHits.assign(nParticles, 0);
+        std::size_t nKept = 0;
+        for(size_t key = 0; key < nHitKeys; key++)
         {
-            HitToPartVecMap::iterator partItr = hitToPartVecMap.find(hit);
+            std::size_t const begin = table.offsets[key];
+            std::size_t const end   = table.offsets[key + 1];
             
-            if (partItr != hitToPartVecMap.end())
+            table.offsets[key] = nKept;
+            for(size_t i = begin; i < end; i++)
             {
-                for(const auto& particle : partItr->second)
-                {
-                    particleToHitSetMap[particle].insert(hit);
-                    trackToParticleSetMap[&track].insert(particle);
-                    particleToTrackSetMap[particle].insert(&track);
-                }
+                if ((i > begin) && (table.particles[i] == table.particles[i - 1])) continue;
+                table.particles[nKept++] = table.particles[i];
+                ++table.nHits[table.particles[i]];
             }
         }
-    }
+        table.offsets[nHitKeys] = nKept;
+        table.particles.resize(nKept);
+        
+        return table;
+    } // makeHitParticleTable()
+    
+} // local namespace
+
+void MCAssociations::doTrackHitMCAssociations(gallery::Event const& event)
+{
+    // without a hit table, the tables cover only the hits in the associations
+    doTrackHitMCAssociations(event, icarus::ns::util::HitColumns{});
+}
+
+void MCAssociations::doTrackHitMCAssociations(gallery::Event const&               event,
+                                              icarus::ns::util::HitColumns const& hits)
+{
+    // First step is to recover the MCTruth object vector...
+    const auto& mcParticleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fMCTruthProducerLabel);
+    
+    // Now see how many reco hits might be associated to this particle
+    art::FindManyP<recob::Hit, anab::BackTrackerHitMatchingData> hitsPerMCParticle(mcParticleHandle, event, fAssnsProducerLabel);
+    
+    // Rather than maps, we use tables indexed by hit key and MC particle index,
+    // which are built in a time linear with the number of associations;
+    // the hit table sets their size to all the hits of the event up front
+    const HitParticleTable hitParticles = makeHitParticleTable(hitsPerMCParticle, mcParticleHandle->size(), hits.size());
+    
+    // In this section try looking at tracking. Eventually we want to move this out of here...
+    // First step is to recover the MCTruth object vector...
+    const auto& trackHandle = event.getValidHandle<std::vector<recob::Track>>(fTrackProducerLabel);
+    
+    // Now see how many reco hits might be associated to this particle
+    // (tracks and MC particles are expected to be associated to the same hits)
+    art::FindManyP<recob::Hit> hitsPerTrack(trackHandle, event, fTrackProducerLabel);
     
     // *****************************************************************************************
     // The bits below here should eventually be moved into their own analyzer algorithm
     // but we are in a hurry now so do it all here...
     // Ok, at this point we should be able to relate MCParticles to tracks and hits
     // Let's start by just looking at the primary particle
-    const simb::MCParticle& primaryParticle = mcParticleHandle->at(0);
-    
-    ParticleToTrackSetMap::iterator partTrackItr = particleToTrackSetMap.find(&primaryParticle);
+    const size_t            primaryIdx = 0;
+    const simb::MCParticle& primaryParticle = mcParticleHandle->at(primaryIdx);
     
     // Define the parameters we want...
-    int   numPrimaryHitsTotal = partToHitVecMap[&primaryParticle].size();
+    int   numPrimaryHitsTotal = hitParticles.nHits[primaryIdx];
     
     // If there are NO reconstructed hits associated to this particle then we don't count
     // But this should really be a check on fiducial volume I think...
@@ -216,73 +252,77 @@ void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
         float               completeness(0.);
         float               purity(0.);
         size_t              numTrackHits(0);
+        size_t              numBestTrackHitsTotal(0);
         
         // Here we find the best matched track to the MCParticle.
         // Nothing exciting, most hits wins sort of thing...
-        if (partTrackItr != particleToTrackSetMap.end())
+        // Each hit is counted once per track: `lastTrackOfHit` records the last
+        // track (plus one) that hit was seen in.
+        std::vector<size_t> lastTrackOfHit(hitParticles.nHitKeys(), 0);
+        
+        for(size_t trkIdx = 0; trkIdx < trackHandle->size(); trkIdx++)
         {
-            // Recover the longest track...
-            for(const auto& track : partTrackItr->second)
+            const auto& hitsVec = hitsPerTrack.at(trkIdx);
+            
+            size_t numPrimaryHitsMatch = 0;
+            for(const auto& hit : hitsVec)
             {
-                if (trackToPartHitSetMap[track][partTrackItr->first].size() > numTrackHits)
-                {
-                    bestTrack    = track;
-                    numTrackHits = trackToPartHitSetMap[track][partTrackItr->first].size();
-                }
+                if (!hitParticles.hasParticle(hit.key(), primaryIdx)) continue;
+                if (lastTrackOfHit[hit.key()] == trkIdx + 1) continue;
+                lastTrackOfHit[hit.key()] = trkIdx + 1;
+                ++numPrimaryHitsMatch;
             }
-        
-            if (bestTrack)
+            
+            // Recover the longest track...
+            if (numPrimaryHitsMatch > numTrackHits)
             {
-                int numPrimaryHitsMatch = numTrackHits;
-                int numTrackHitsTotal   = trackToHitsVecMap[bestTrack].size();
-        
-                completeness = float(numPrimaryHitsMatch) / float(numPrimaryHitsTotal);
-                purity       = float(numPrimaryHitsMatch) / float(numTrackHitsTotal);
-                
-                if (completeness > 0.2) efficiency = 1.;
+                bestTrack             = &trackHandle->at(trkIdx);
+                numTrackHits          = numPrimaryHitsMatch;
+                numBestTrackHitsTotal = hitsVec.size();
             }
         }
+        
+        if (bestTrack)
+        {
+            int numPrimaryHitsMatch = numTrackHits;
+            int numTrackHitsTotal   = numBestTrackHitsTotal;
+            
+            completeness = float(numPrimaryHitsMatch) / float(numPrimaryHitsTotal);
+            purity       = float(numPrimaryHitsMatch) / float(numTrackHitsTotal);
+            
+            if (completeness > 0.2) efficiency = 1.;
+        }
     
-        // Calculate the length of this mc particle inside the fiducial volume.
-        geo::Point_t mcstart [[maybe_unused]], mcend [[maybe_unused]];
-        geo::Vector_t mcstartmom [[maybe_unused]], mcendmom [[maybe_unused]];
-    
-        double xOffset(0.);
+        // Calculate the length of the mc particles with hits inside the active volume, all together
+        const std::vector<double> mcTrackLengths = activeLengths(*mcParticleHandle, hitParticles.nHits);
     
-        double mcTrackLen = length(primaryParticle, xOffset, mcstart, mcend, mcstartmom, mcendmom);
+        double mcTrackLen = mcTrackLengths[primaryIdx];
         double trackLen   = 0.;
         
         if (bestTrack) trackLen = length(bestTrack);
     
-        fNTracks->Fill(partToHitVecMap.size(), 1.);
-        fNHitsPerPrimary->Fill(std::log10(double(partToHitVecMap[&primaryParticle].size())), 1.);
+        fNTracks->Fill(std::count_if(hitParticles.nHits.begin(), hitParticles.nHits.end(), [](size_t n){ return n > 0; }), 1.);
+        fNHitsPerPrimary->Fill(std::log10(double(hitParticles.nHits[primaryIdx])), 1.);
         fPrimaryLength->Fill(mcTrackLen, 1.);
-        fPrimaryLenVsHits->Fill(mcTrackLen, partToHitVecMap[&primaryParticle].size(), 1.);
+        fPrimaryLenVsHits->Fill(mcTrackLen, hitParticles.nHits[primaryIdx], 1.);
         
         fPrimaryRecoLength->Fill(trackLen, 1.);
         fDeltaTrackLen->Fill(trackLen-mcTrackLen, 1.);
         
         fNHitsPerReco->Fill(std::log10(numTrackHits), 1.);
-        fDeltaNHits->Fill(numTrackHits - int(partToHitVecMap[&primaryParticle].size()), 1.);
+        fDeltaNHits->Fill(numTrackHits - int(hitParticles.nHits[primaryIdx]), 1.);
 
         // Loop through the particles again to histogram some secondary info...
         for(size_t mcIdx = 0; mcIdx < mcParticleHandle->size(); mcIdx++)
         {
-            try
+            if (hitParticles.nHits[mcIdx] > 0)
             {
-                const simb::MCParticle& mcParticle = mcParticleHandle->at(mcIdx);
+                double secTrackLen = mcTrackLengths[mcIdx];
             
-                if (!partToHitVecMap[&mcParticle].empty())
-                {
-                    // Calculate the length of this mc particle inside the fiducial volume.
-                    double secTrackLen = length(mcParticle, xOffset, mcstart, mcend, mcstartmom, mcendmom);
-                
-                    fNHitsPerTrack->Fill(partToHitVecMap[&mcParticle].size(), 1.);
-                    fTrackLength->Fill(secTrackLen, 1.);
-                    fTrackLenVsHits->Fill(secTrackLen, partToHitVecMap[&mcParticle].size(), 1.);
-                }
+                fNHitsPerTrack->Fill(hitParticles.nHits[mcIdx], 1.);
+                fTrackLength->Fill(secTrackLen, 1.);
+                fTrackLenVsHits->Fill(secTrackLen, hitParticles.nHits[mcIdx], 1.);
             }
-            catch(...) {break;}
         }
     
         // Final sets of plots
@@ -353,86 +393,26 @@ double MCAssociations::length(const recob::Track* track) const
     return track->Length();
 }
 
-// Length of MC particle.
+// Length of MC particles in the active volume.
 //----------------------------------------------------------------------------
-double MCAssociations::length(const simb::MCParticle& part, double dx,
-                              geo::Point_t& start, geo::Point_t& end, geo::Vector_t& startmom, geo::Vector_t& endmom) const
+std::vector<double> MCAssociations::activeLengths(const std::vector<simb::MCParticle>& particles,
+                                                  const std::vector<std::size_t>& nHits)
 {
-    // Need the readout window size...
-  //    double readOutWindowSize = fDetectorProperties->ReadOutWindowSize();
-    
-    double result = 0.;
-    geo::Point_t prev;
-    int n = part.NumberTrajectoryPoints();
-    bool first = true;
-    
-    // The following for debugging purposes
-    int findTrackID(-1);
-    
-    if (part.TrackId() == findTrackID) std::cout << ">>> length, mcpart: " << part << std::endl;
-    
-    // Loop over the complete collection of trajectory points
-    for(int i = 0; i < n; ++i)
+    // Particles with no hits get an empty trajectory, so that indices match
+    fParticleTrajectories.clear();
+    for(size_t mcIdx = 0; mcIdx < particles.size(); mcIdx++)
     {
-        geo::Point_t pos = geo::vect::toPoint(part.Position(i).Vect());
-        
-        // Try identifying the TPC we are in
-        const geo::TPCGeo* tpcGeo = fGeometry->PositionToTPCptr(pos);
-        // Need to make sure this position is in an active region of the TPC
-        // If the particle is not in the cryostat then we skip
-        if (!tpcGeo) continue;
-        if (!tpcGeo->ActiveBoundingBox().ContainsPosition(pos)) continue;
+        const simb::MCParticle& part = particles[mcIdx];
+        const size_t            n    = (nHits[mcIdx] > 0)? part.NumberTrajectoryPoints(): 0;
         
-        
-        geo::Vector_t const activePos = pos - tpcGeo->GetActiveVolumeCenter();
-        geo::Vector_t const posInTPC = activePos + tpcGeo->ActiveHalfWidth() * geo::Xaxis();
-        
-        if (part.TrackId() == findTrackID) {
-            std::cout << "   --> traj point: " << i << ", pos: " << pos << ", active pos: " << activePos << std::endl;
-        }
-        
-        // Make fiducial cuts.
-        // There are two sets here:
-        // 1) We check the original x,y,z position of the trajectory points and require they be
-        //    within the confines of the physical TPC
-        // 2) We then check the timing of the presumed hit and make sure it lies within the
-        //    readout window for this simulation
-        pos += dx * geo::Xaxis();
-        double ticks = fDetectorProperties->ConvertXToTicks(posInTPC.X(), geo::PlaneID{ tpcGeo->ID(), 0 });
-        
-        if (part.TrackId() == findTrackID)
-            std::cout << "   ==> " << tpcGeo->ID() << ", ticks: " << ticks << std::endl;
-
-        // Currently it appears that the detector properties are not getting initialized properly and the returned
-        // number of ticks is garbage so we need to skip this for now. Will be important when we get CR's
-//        if(ticks >= 0. && ticks < readOutWindowSize)
-        {
-            if(first)
-            {
-                start = pos;
-                startmom = geo::vect::toVector(part.Momentum(i).Vect());
-                first = false;
-            }
-            else
-            {
-                result += (pos - prev).R();
-            }
-            prev = pos;
-            end = pos;
-            endmom = geo::vect::toVector(part.Momentum(i).Vect());
-        }
-        
-        if (part.TrackId() == findTrackID)
-        {
-            try
-            {
-                std::cout << ">>> Track #" << findTrackID << ", pos: " << pos << ", ticks: " << ticks << ", nearest collection wire: ";
-                geo::WireID wireID = fGeometry->NearestWireID(pos, geo::PlaneID{ tpcGeo->ID(), 2 });
-                std::cout << wireID << std::endl;
-            }
-            catch(...) {}
-        }
+        fParticleTrajectories.add(n, [&part](size_t i){ return part.Position(i).Vect(); });
     }
     
-    return result;
+    // Only the trajectory points in the active volume of any TPC are counted;
+    // the trajectory is joined across the points which are not.
+    // The readout window is not checked, since the detector properties do
+    // not appear to be initialized properly.
+    const std::vector<std::uint8_t> active = fActiveVolumes.contains(fParticleTrajectories);
+    
+    return fParticleTrajectories.select(active.data()).lengths();
 }
@@ -17,6 +17,10 @@
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "lardataobj/RecoBase/Track.h"
 
+// ICARUS libraries
+#include "icarusalg/Utilities/TrajectoryBatch.h"
+#include "icarusalg/Utilities/HitColumns.h"
+
 // canvas libraries
 #include "fhiclcpp/ParameterSet.h"
 
@@ -29,6 +33,7 @@
 // C/C++ standard libraries
 #include <vector>
 #include <memory> // std::unique_ptr<>
+#include <cstddef> // std::size_t
 
 
 /**
@@ -52,14 +57,19 @@ public:
   
     void prepare();
   
-    void doTrackHitMCAssociations(gallery::Event&);
+    void doTrackHitMCAssociations(gallery::Event const&);
+    
+    /// As above, with the table of all the hits the associations point to.
+    void doTrackHitMCAssociations(gallery::Event const&,
+                                  icarus::ns::util::HitColumns const& hits);
   
     void finish();
     
 private:
     double length(const recob::Track*) const;
-    double length(const simb::MCParticle& part, double dx,
-                  geo::Point_t& start, geo::Point_t& end, geo::Vector_t& startmom, geo::Vector_t& endmom) const;
+    /// Returns the length in the active volume of each of the `particles` with hits.
+    std::vector<double> activeLengths(const std::vector<simb::MCParticle>& particles,
+                                      const std::vector<std::size_t>& nHits);
     
     art::InputTag            fHitProducerLabel;
     art::InputTag            fMCTruthProducerLabel;
@@ -71,6 +81,9 @@ private:
     std::unique_ptr<detinfo::DetectorPropertiesData const> fDetectorProperties;
     TDirectory*                        fDir                = nullptr;
     
+    icarus::ns::util::BoxSet           fActiveVolumes;      ///< Active volume of all TPCs.
+    icarus::ns::util::TrajectoryBatch  fParticleTrajectories; ///< Reused for each event.
+    
     std::unique_ptr<TH1>      fNTracks;
     std::unique_ptr<TH1>      fNHitsPerTrack;
     std::unique_ptr<TH1>      fTrackLength;
@@ -16,7 +16,9 @@
 // ROOT libraries
 
 // C/C++ standard libraries
+#include <vector>
 #include <algorithm> // std::count_if()
+#include <cstddef> // std::size_t
 
 
 TrackAnalysis::TrackAnalysis(fhicl::ParameterSet const& config)
@@ -28,19 +30,37 @@ void TrackAnalysis::prepare() {
     fHNTracks = std::make_unique<TH1F>
       ("HNTracks", "Number of tracks;number of tracks;events", 50, 0., 50.);
     fHNTracks->SetDirectory(fDir);
+    fHTrackLength = std::make_unique<TH1F>
+      ("HTrackLength", "Track length;length [cm];tracks", 200, 0., 1000.);
+    fHTrackLength->SetDirectory(fDir);
+  }
+  else {
+    fHNTracks.reset();
+    fHTrackLength.reset();
   }
-  else fHNTracks.reset();
 } // TrackAnalysis::prepare()
 
 
 void TrackAnalysis::processTracks(std::vector<recob::Track> const& tracks) {
   
+  // all the tracks are measured together
+  fTrajectories.clear();
+  for (recob::Track const& track: tracks) {
+    fTrajectories.add(track.NumberTrajectoryPoints(),
+      [&track](std::size_t i){ return track.LocationAtPoint(i); },
+      [&track](std::size_t i){ return track.HasValidPoint(i); }
+      );
+  } // for
+  std::vector<double> const lengths = fTrajectories.lengths();
+  
   unsigned int nTracksAboveThreshold = std::count_if(
-    tracks.begin(), tracks.end(),
-    [this](auto const& track){ return track.Length() > fMinLength; }
+    lengths.begin(), lengths.end(),
+    [this](double length){ return length > fMinLength; }
     );
   
   if (fHNTracks) fHNTracks->Fill(nTracksAboveThreshold);
+  if (fHTrackLength && !lengths.empty())
+    fHTrackLength->FillN(lengths.size(), lengths.data(), nullptr);
   
 } // TrackAnalysis::processTracks()
 
@@ -49,6 +69,7 @@ void TrackAnalysis::finish() {
   if (fHNTracks) {
     fDir->cd();
     fHNTracks->Write();
+    fHTrackLength->Write();
   }
 } // TrackAnalysis::finish()
 
@@ -14,6 +14,9 @@
 #include "lardataobj/RecoBase/Track.h"
 #include "larcorealg/Geometry/GeometryCore.h"
 
+// ICARUS libraries
+#include "icarusalg/Utilities/TrajectoryBatch.h"
+
 // canvas libraries
 #include "fhiclcpp/ParameterSet.h"
 
@@ -41,6 +44,9 @@ class TrackAnalysis {
   TDirectory* fDir = nullptr;
   double fMinLength = 0.0;                  ///< Minimum length, in centimetres.
   std::unique_ptr<TH1> fHNTracks;
+  std::unique_ptr<TH1> fHTrackLength;
+  
+  icarus::ns::util::TrajectoryBatch fTrajectories; ///< Reused for each event.
   
     public:
   
@@ -22,7 +22,9 @@
 #include "MCAssociations.h"
 
 // ICARUS code
+#include "icarusalg/Utilities/HitColumns.h"
 #include "icarusalg/gallery/helpers/C++/expandInputFiles.h"
+#include "icarusalg/gallery/helpers/C++/CheckpointedEventLoop.h"
 
 // LArSoft
 // - data products
@@ -57,6 +59,7 @@
 #include <vector>
 #include <memory> // std::make_unique()
 #include <iostream> // std::cerr
+#include <chrono> // std::chrono::seconds
 
 
 #if !defined(__CLING__)
@@ -146,17 +149,39 @@ int galleryAnalysis(std::string const& configFile, std::vector<std::string> cons
     
     hitAnalysisAlg.setup(*geom, pHistFile.get());
     
-    MCAssociations mcAssociations(analysisConfig.get<fhicl::ParameterSet>("mcAssociations"));
+    fhicl::ParameterSet const mcAssociationsConfig = analysisConfig.get<fhicl::ParameterSet>("mcAssociations");
+    MCAssociations mcAssociations(mcAssociationsConfig);
     auto const detProp = detp->DataFor(detclk->DataForJob());
     mcAssociations.setup(*geom, detProp, pHistFile.get());
     mcAssociations.prepare();
     
-    int numEvents(0);
-  
+    // the hits of each event, decoded once and shared by the algorithms
+    // (the MC associations use them only if they refer to the same hits)
+    icarus::ns::util::HitColumns hitColumns { *geom };
+    bool const mcAssociationsShareHits
+        = (mcAssociationsConfig.get<art::InputTag>("HitProducerLabel", "") == hitsTag);
+    
     /*
-     * the event loop
+     * checkpoints (optional): the job periodically saves its histograms and
+     * position, and if restarted it resumes from there
      */
-    for (gallery::Event event(allInputFiles); !event.atEnd(); event.next())
+    std::unique_ptr<EventLoopCheckpoint> checkpoint;
+    if (analysisConfig.has_key("checkpoint"))
+    {
+        auto const& checkpointConfig = analysisConfig.get<fhicl::ParameterSet>("checkpoint");
+        EventLoopCheckpoint::Config config;
+        config.path = checkpointConfig.get<std::string>("path");
+        config.eventInterval = checkpointConfig.get<unsigned long long int>("eventInterval", config.eventInterval);
+        config.timeInterval = std::chrono::seconds{ checkpointConfig.get<long int>("timeInterval", config.timeInterval.count()) };
+        checkpoint = std::make_unique<EventLoopCheckpoint>(std::move(config));
+        if (pHistFile) checkpoint->registerHistograms(*pHistFile);
+        if (checkpoint->exists())
+            std::cout << "Resuming from checkpoint: '" << checkpointConfig.get<std::string>("path") << "'" << std::endl;
+    }
+    
+    int numEvents(0);
+  
+    auto processEvent = [&](gallery::Event const& event)
     {
         // *************************************************************************
         // ***  SINGLE EVENT PROCESSING BEGIN  *************************************
@@ -166,22 +191,42 @@ int galleryAnalysis(std::string const& configFile, std::vector<std::string> cons
     
         trackAnalysis.processTracks(*(event.getValidHandle<std::vector<recob::Track>>(trackTag)));
         
-        hitAnalysisAlg.fillHistograms(*(event.getValidHandle<std::vector<recob::Hit>>(hitsTag)));
+        hitColumns.fill(*(event.getValidHandle<std::vector<recob::Hit>>(hitsTag)));
         
-        mcAssociations.doTrackHitMCAssociations(event);
-
-        numEvents++;
+        hitAnalysisAlg.fillHistograms(hitColumns);
+        
+        if (mcAssociationsShareHits) mcAssociations.doTrackHitMCAssociations(event, hitColumns);
+        else                         mcAssociations.doTrackHitMCAssociations(event);
     
         // *************************************************************************
         // ***  SINGLE EVENT PROCESSING END    *************************************
         // *************************************************************************
-    
-    } // for
+    }; // processEvent
+  
+    /*
+     * the event loop
+     */
+    if (checkpoint)
+    {
+        numEvents = forEachEventWithCheckpoints(allInputFiles, *checkpoint, processEvent);
+    }
+    else
+    {
+        for (gallery::Event event(allInputFiles); !event.atEnd(); event.next())
+        {
+            processEvent(event);
+            numEvents++;
+        } // for
+    }
   
     trackAnalysis.finish();
     mcAssociations.finish();
     
     hitAnalysisAlg.endJob(numEvents);
+    
+    // the output is complete: a new job must not resume from the checkpoint
+    if (pHistFile) pHistFile->Close();
+    if (checkpoint) checkpoint->discard();
   
     return 0;
 } // galleryAnalysis()
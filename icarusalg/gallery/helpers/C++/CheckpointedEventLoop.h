@@ -0,0 +1,72 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/CheckpointedEventLoop.h
+ * @brief  Event loop saving checkpoints, and resuming from them.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/EventLoopCheckpoint.h
+ *
+ * This library is header only, and it requires linking to `gallery`.
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_CHECKPOINTEDEVENTLOOP_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_CHECKPOINTEDEVENTLOOP_H
+
+// library header
+#include "icarusalg/gallery/helpers/C++/EventLoopCheckpoint.h"
+
+// framework libraries
+#include "gallery/Event.h"
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Calls `processEvent(event)` on each event, with checkpoints.
+ * @tparam ProcessEvent type of callable processing a `gallery::Event`
+ * @param inputFiles the input files, in processing order
+ * @param checkpoint the checkpoint manager, with all the state registered
+ * @param processEvent callable object called on each event
+ * @return the number of processed events, including the ones before resuming
+ * @see `EventLoopCheckpoint`
+ *
+ * The loop first restores the state from the checkpoint (if any) and jumps
+ * to its position (`gallery::Event::goToEntry()`), without reading the events
+ * already processed. After each event, `checkpoint.update()` is given the
+ * position of the next one. Files are opened one at a time.
+ * The checkpoint file is not removed at the end of the loop: the caller
+ * should `discard()` it after writing the output.
+ */
+template <typename ProcessEvent>
+unsigned long long int forEachEventWithCheckpoints(
+  std::vector<std::string> const& inputFiles,
+  EventLoopCheckpoint& checkpoint, ProcessEvent&& processEvent
+) {
+  CheckpointPosition position = checkpoint.restore(inputFiles);
+  for (; position.fileIndex < inputFiles.size(); ++position.fileIndex) {
+    position.filePath = inputFiles[position.fileIndex];
+
+    gallery::Event event({ position.filePath });
+    if (position.entry >= event.numberOfEventsInFile()) {
+      position.entry = 0;
+      continue;
+    }
+    if (position.entry > 0) event.goToEntry(position.entry);
+
+    for (; !event.atEnd(); event.next()) {
+      processEvent(static_cast<gallery::Event const&>(event));
+      ++position.entry;
+      ++position.nEvents;
+      checkpoint.update(position);
+    } // for entries
+    position.entry = 0;
+  } // for files
+  return position.nEvents;
+} // forEachEventWithCheckpoints()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_CHECKPOINTEDEVENTLOOP_H
@@ -0,0 +1,217 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/ColumnWriter.h
+ * @brief  Writes flat tables of typed columns, in batches.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ *
+ * This library is header only, and it requires linking to ROOT `Tree` library.
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_COLUMNWRITER_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_COLUMNWRITER_H
+
+// ROOT
+#include "TTree.h"
+#include "TDirectory.h"
+
+// C/C++ libraries
+#include <array>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <memory> // std::unique_ptr
+#include <type_traits> // std::is_arithmetic_v
+#include <utility> // std::index_sequence_for
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Writes a flat table with one column per declared type.
+ * @tparam Columns the type of each of the columns (plain numbers only)
+ *
+ * This object produces a table (a ROOT tree with one plain branch per
+ * column) that can be read back much faster than the original art/ROOT
+ * files, e.g. with `ROOT::RDataFrame` or `uproot`, so that new studies need
+ * not to read again all the data products. The columns are declared once,
+ * their types as template arguments and their names at construction.
+ *
+ * Rows are added with `push()` and kept in memory, one array per column,
+ * until `batchSize` of them are collected; then the whole batch is moved into
+ * the tree (`flush()`). The table is written in its directory by `write()`.
+ *
+ * Example dumping one row per hit:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * ColumnWriter<unsigned int, unsigned int, float, float> hitTable
+ *   { outputDir, "Hits", { "plane", "wire", "peakTime", "integral" } };
+ *
+ * for (recob::Hit const& hit: hits) {
+ *   hitTable.push
+ *     (hit.WireID().Plane, hit.WireID().Wire, hit.PeakTime(), hit.Integral());
+ * }
+ *
+ * hitTable.write();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The tree is owned by the output directory; if no directory is specified,
+ * the tree is kept in memory and owned by this object.
+ */
+template <typename... Columns>
+class ColumnWriter {
+  static_assert(sizeof...(Columns) > 0, "At least one column is needed.");
+  static_assert((std::is_arithmetic_v<Columns> && ...),
+    "Only plain number columns are supported.");
+
+    public:
+
+  /// Number of columns in the table.
+  static constexpr std::size_t NColumns = sizeof...(Columns);
+
+  /// Type of list of column names.
+  using Names_t = std::array<std::string, NColumns>;
+
+  /// Default number of rows collected before moving them to the tree.
+  static constexpr std::size_t DefaultBatchSize = 4096U;
+
+
+  /**
+   * @brief Constructor: creates the table.
+   * @param outputDir ROOT directory to write the table into
+   * @param name name of the table (the tree)
+   * @param columnNames the name of each column
+   * @param batchSize (default: `DefaultBatchSize`) rows collected in memory
+   * @param title (default: same as `name`) title of the tree
+   */
+  ColumnWriter(
+    TDirectory* outputDir, std::string const& name, Names_t const& columnNames,
+    std::size_t batchSize = DefaultBatchSize, std::string const& title = ""
+    );
+
+  /// Destructor: moves the pending rows into the tree (but does not write it).
+  ~ColumnWriter() { flush(); }
+
+  // the tree holds the address of the row data member
+  ColumnWriter(ColumnWriter const&) = delete;
+  ColumnWriter& operator= (ColumnWriter const&) = delete;
+
+
+  /// Adds a row with the specified values.
+  void push(Columns... values);
+
+  /// Moves all the collected rows into the tree.
+  void flush();
+
+  /// Moves all the collected rows into the tree, and writes it.
+  void write();
+
+  /// Returns the number of rows added so far.
+  std::size_t nRows() const { return fNRows; }
+
+  /// Returns the underlying ROOT tree.
+  TTree& tree() { return *fTree; }
+
+
+    private:
+
+  std::size_t const fBatchSize; ///< Rows collected before flushing.
+
+  std::unique_ptr<TTree> fOwnedTree; ///< The tree, if not owned by directory.
+  TTree* fTree = nullptr; ///< The tree being filled.
+
+  std::tuple<std::vector<Columns>...> fBuffers; ///< Collected rows.
+  std::tuple<Columns...> fRow; ///< The current row (tree branch addresses).
+
+  std::size_t fNRows = 0U; ///< Number of rows added.
+
+  /// Creates a branch for each column.
+  template <std::size_t... I>
+  void makeBranches(Names_t const& names, std::index_sequence<I...>);
+
+  /// Moves all buffered rows into the tree.
+  template <std::size_t... I>
+  void flushRows(std::index_sequence<I...>);
+
+}; // ColumnWriter
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename... Columns>
+ColumnWriter<Columns...>::ColumnWriter(
+  TDirectory* outputDir, std::string const& name, Names_t const& columnNames,
+  std::size_t batchSize /* = DefaultBatchSize */,
+  std::string const& title /* = "" */
+)
+  : fBatchSize{ (batchSize > 0U)? batchSize: 1U }
+{
+  fTree = new TTree
+    (name.c_str(), (title.empty()? name: title).c_str());
+  fTree->SetDirectory(outputDir);
+  if (!outputDir) fOwnedTree.reset(fTree);
+
+  makeBranches(columnNames, std::index_sequence_for<Columns...>{});
+
+  std::apply
+    ([this](auto&... buffer){ (buffer.reserve(fBatchSize), ...); }, fBuffers);
+
+} // ColumnWriter<>::ColumnWriter()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Columns>
+void ColumnWriter<Columns...>::push(Columns... values) {
+
+  std::apply([&values...](auto&... buffer)
+    { (buffer.push_back(values), ...); }, fBuffers);
+  ++fNRows;
+  if (std::get<0>(fBuffers).size() >= fBatchSize) flush();
+
+} // ColumnWriter<>::push()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Columns>
+void ColumnWriter<Columns...>::flush()
+  { flushRows(std::index_sequence_for<Columns...>{}); }
+
+
+// -----------------------------------------------------------------------------
+template <typename... Columns>
+void ColumnWriter<Columns...>::write() {
+
+  flush();
+  if (TDirectory* const dir = fTree->GetDirectory())
+    dir->WriteTObject(fTree, nullptr, "Overwrite");
+
+} // ColumnWriter<>::write()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Columns>
+template <std::size_t... I>
+void ColumnWriter<Columns...>::makeBranches
+  (Names_t const& names, std::index_sequence<I...>)
+{
+  (fTree->Branch(names[I].c_str(), &std::get<I>(fRow)), ...);
+} // ColumnWriter<>::makeBranches()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Columns>
+template <std::size_t... I>
+void ColumnWriter<Columns...>::flushRows(std::index_sequence<I...>) {
+
+  std::size_t const nRows = std::get<0>(fBuffers).size();
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    ((std::get<I>(fRow) = std::get<I>(fBuffers)[iRow]), ...);
+    fTree->Fill();
+  }
+  (std::get<I>(fBuffers).clear(), ...);
+
+} // ColumnWriter<>::flushRows()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_COLUMNWRITER_H
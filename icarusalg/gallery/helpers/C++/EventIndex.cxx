@@ -0,0 +1,101 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/EventIndex.cxx
+ * @brief  Index of the location of events in a set of input files.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/EventIndex.h
+ */
+
+// library header
+#include "icarusalg/gallery/helpers/C++/EventIndex.h"
+
+// C/C++ libraries
+#include <algorithm> // std::stable_sort(), std::lower_bound(), ...
+#include <utility> // std::move()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+  
+  /// Orders index records by event ID.
+  struct RecordIDcmp {
+    template <typename A, typename B>
+    bool operator() (A const& a, B const& b) const { return id(a) < id(b); }
+    
+    template <typename Record>
+    static art::EventID const& id(Record const& record) { return record.id; }
+    static art::EventID const& id(art::EventID const& id) { return id; }
+  }; // RecordIDcmp
+  
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+EventIndex::EventIndex(std::vector<InputFileInfo> const& manifest) {
+  for (InputFileInfo const& info: manifest)
+    if (info.valid()) addFile(info.path, info.events);
+} // EventIndex::EventIndex()
+
+
+// -----------------------------------------------------------------------------
+void EventIndex::addFile
+  (std::string path, std::vector<art::EventID> const& events)
+{
+  std::size_t const iFile = fFiles.size();
+  fFiles.push_back(std::move(path));
+  
+  std::size_t const nOld = fIndex.size();
+  fIndex.reserve(nOld + events.size());
+  for (std::size_t entry = 0; entry < events.size(); ++entry) {
+    fIndex.push_back
+      ({ events[entry], { iFile, static_cast<long long int>(entry) } });
+  }
+  
+  // sort the new records and merge them with the old ones, keeping the order
+  // of equal IDs, so that the first occurrence of an event comes first
+  auto const newBegin = fIndex.begin() + nOld;
+  std::stable_sort(newBegin, fIndex.end(), RecordIDcmp{});
+  std::inplace_merge(fIndex.begin(), newBegin, fIndex.end(), RecordIDcmp{});
+  
+} // EventIndex::addFile()
+
+
+// -----------------------------------------------------------------------------
+auto EventIndex::find(art::EventID const& id) const
+  -> std::optional<Location_t>
+{
+  auto const iRecord
+    = std::lower_bound(fIndex.begin(), fIndex.end(), id, RecordIDcmp{});
+  if ((iRecord == fIndex.end()) || (iRecord->id != id)) return std::nullopt;
+  return iRecord->location;
+} // EventIndex::find()
+
+
+// -----------------------------------------------------------------------------
+std::vector<FileEntries> EventIndex::select(
+  std::vector<art::EventID> const& events,
+  std::vector<art::EventID>* missing /* = nullptr */
+) const {
+  
+  std::vector<std::vector<long long int>> entries(fFiles.size());
+  for (art::EventID const& id: events) {
+    std::optional<Location_t> const location = find(id);
+    if (location) entries[location->file].push_back(location->entry);
+    else if (missing) missing->push_back(id);
+  } // for
+  
+  std::vector<FileEntries> selection;
+  for (std::size_t iFile = 0; iFile < fFiles.size(); ++iFile) {
+    std::vector<long long int>& fileEntries = entries[iFile];
+    if (fileEntries.empty()) continue; // this file is not needed at all
+    std::sort(fileEntries.begin(), fileEntries.end());
+    fileEntries.erase
+      (std::unique(fileEntries.begin(), fileEntries.end()), fileEntries.end());
+    selection.push_back({ fFiles[iFile], std::move(fileEntries) });
+  } // for
+  return selection;
+  
+} // EventIndex::select()
+
+
+// -----------------------------------------------------------------------------
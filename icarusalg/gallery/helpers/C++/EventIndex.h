@@ -0,0 +1,120 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/EventIndex.h
+ * @brief  Index of the location of events in a set of input files.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/EventIndex.cxx
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_EVENTINDEX_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_EVENTINDEX_H
+
+// library header
+#include "icarusalg/gallery/helpers/C++/InputFileManifest.h"
+
+// framework libraries
+#include "canvas/Persistency/Provenance/EventID.h"
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Index of the file and entry of each event from a list of files.
+ * 
+ * The index is built once from a manifest of the input files including the
+ * event IDs (`scanInputFiles()` with `readEventIDs` set), and it can then
+ * tell where each event is, or which entries of which files need to be read
+ * to process a list of events.
+ * 
+ * Example processing only two events:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * EventIndex const index
+ *   { scanInputFiles(allInputFiles, 4U, true) }; // with event IDs
+ * 
+ * std::vector<FileEntries> const selection = index.select
+ *   ({ art::EventID{ 8413, 1, 22 }, art::EventID{ 8413, 3, 512 } });
+ * 
+ * forEachSelectedEvent(selection, [&](gallery::Event const& event)
+ *   { analysis.process(event); });
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * (see `SelectedEventLoop.h` for `forEachSelectedEvent()`).
+ * 
+ * If the same event ID appears more than once, the first one (in file and
+ * entry order) is used.
+ */
+class EventIndex {
+  
+    public:
+  
+  /// Where an event is.
+  struct Location_t {
+    std::size_t file; ///< Index of the file in the list (`files()`).
+    long long int entry; ///< Entry in the event tree of the file.
+  }; // Location_t
+  
+  
+  /// Constructor: an empty index.
+  EventIndex() = default;
+  
+  /// Constructor: indexes all the events from the valid files of `manifest`.
+  explicit EventIndex(std::vector<InputFileInfo> const& manifest);
+  
+  
+  /// Adds `events` (in entry order) from the file at `path`.
+  void addFile(std::string path, std::vector<art::EventID> const& events);
+  
+  
+  // --- BEGIN -- Query --------------------------------------------------------
+  /// @name Query
+  /// @{
+  
+  /// Returns the number of indexed events.
+  std::size_t size() const { return fIndex.size(); }
+  
+  /// Returns the paths of all the indexed files.
+  std::vector<std::string> const& files() const { return fFiles; }
+  
+  /// Returns the location of the event `id`, if indexed.
+  std::optional<Location_t> find(art::EventID const& id) const;
+  
+  /**
+   * @brief Returns the entries holding the requested `events`.
+   * @param events IDs of the events to be selected
+   * @param[out] missing (optional) appended the IDs not present in the index
+   * @return the selected entries, file by file, only for files with any
+   * 
+   * Files are in the order they were added, and entries in each file are
+   * sorted, so that reading them all moves forward in the input.
+   */
+  std::vector<FileEntries> select(
+    std::vector<art::EventID> const& events,
+    std::vector<art::EventID>* missing = nullptr
+    ) const;
+  
+  /// @}
+  // --- END ---- Query --------------------------------------------------------
+  
+  
+    private:
+  
+  /// Index record: an event and its location.
+  struct Record_t {
+    art::EventID id;
+    Location_t location;
+  }; // Record_t
+  
+  std::vector<std::string> fFiles; ///< Path of all the files.
+  
+  std::vector<Record_t> fIndex; ///< All the events, sorted by ID.
+  
+}; // EventIndex
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_EVENTINDEX_H
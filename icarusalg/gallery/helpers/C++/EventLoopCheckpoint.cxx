@@ -0,0 +1,281 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/EventLoopCheckpoint.cxx
+ * @brief  Periodic saving of the state of an event loop, to resume it later.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/EventLoopCheckpoint.h
+ */
+
+// library header
+#include "icarusalg/gallery/helpers/C++/EventLoopCheckpoint.h"
+
+// ROOT
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TH1.h"
+#include "TNamed.h"
+#include "TParameter.h"
+
+// C/C++ libraries
+#include <memory> // std::unique_ptr
+#include <fstream>
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::pair, std::move()
+#include <cstdio> // std::rename(), std::remove()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Returns the subdirectory `path` of `dir`, creating it if needed.
+  TDirectory& subdirectory(TDirectory& dir, std::string const& path) {
+    TDirectory* subdir = &dir;
+    std::size_t start = 0U;
+    while (start < path.length()) {
+      std::size_t end = path.find('/', start);
+      if (end == std::string::npos) end = path.length();
+      std::string const name = path.substr(start, end - start);
+      if (!name.empty()) {
+        TDirectory* next = subdir->GetDirectory(name.c_str());
+        if (!next) next = subdir->mkdir(name.c_str());
+        if (!next) {
+          throw std::runtime_error
+            ("EventLoopCheckpoint: can't create directory '" + path + "'");
+        }
+        subdir = next;
+      }
+      start = end + 1;
+    } // while
+    return *subdir;
+  } // subdirectory()
+
+
+  /// Splits `path` into its directory and its name.
+  std::pair<std::string, std::string> splitPath(std::string const& path) {
+    std::size_t const iSep = path.rfind('/');
+    if (iSep == std::string::npos) return { "", path };
+    return { path.substr(0, iSep), path.substr(iSep + 1) };
+  } // splitPath()
+
+
+  /// Writes `value` as a `TParameter` called `name` into `dir`.
+  void writeParameter(TDirectory& dir, char const* name, long long int value)
+  {
+    TParameter<Long64_t> param { name, static_cast<Long64_t>(value) };
+    dir.WriteTObject(&param, name);
+  } // writeParameter()
+
+
+  /// Reads the value of the `TParameter` at `path` from `file`.
+  long long int readParameter(TFile& file, std::string const& path) {
+    std::unique_ptr<TParameter<Long64_t>> const param
+      { file.Get<TParameter<Long64_t>>(path.c_str()) };
+    if (!param) {
+      throw std::runtime_error("EventLoopCheckpoint: '" + path
+        + "' not found in checkpoint '" + file.GetName() + "'");
+    }
+    return param->GetVal();
+  } // readParameter()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+EventLoopCheckpoint::EventLoopCheckpoint(Config config)
+  : fConfig{ std::move(config) }
+  , fLastTime{ std::chrono::steady_clock::now() }
+  {}
+
+
+// -----------------------------------------------------------------------------
+void EventLoopCheckpoint::registerHistogram(TH1& hist, std::string name) {
+  fHistograms.push_back({ &hist, std::move(name) });
+} // EventLoopCheckpoint::registerHistogram()
+
+
+// -----------------------------------------------------------------------------
+unsigned int EventLoopCheckpoint::registerHistograms
+  (TDirectory& dir, std::string const& prefix /* = "" */)
+{
+  unsigned int nHistograms = 0U;
+  for (TObject* obj: *(dir.GetList())) {
+    if (auto* const hist = dynamic_cast<TH1*>(obj)) {
+      registerHistogram(*hist, prefix + hist->GetName());
+      ++nHistograms;
+    }
+    else if (auto* const subdir = dynamic_cast<TDirectory*>(obj)) {
+      nHistograms
+        += registerHistograms(*subdir, prefix + subdir->GetName() + "/");
+    }
+  } // for
+  return nHistograms;
+} // EventLoopCheckpoint::registerHistograms()
+
+
+// -----------------------------------------------------------------------------
+void EventLoopCheckpoint::registerState(
+  std::string name,
+  std::function<Values_t()> save,
+  std::function<void(Values_t const&)> restore
+) {
+  fStates.push_back({ std::move(name), std::move(save), std::move(restore) });
+} // EventLoopCheckpoint::registerState()
+
+
+// -----------------------------------------------------------------------------
+bool EventLoopCheckpoint::exists() const {
+  return std::ifstream{ fConfig.path }.good();
+} // EventLoopCheckpoint::exists()
+
+
+// -----------------------------------------------------------------------------
+CheckpointPosition EventLoopCheckpoint::restore
+  (std::vector<std::string> const& inputFiles)
+{
+  CheckpointPosition position;
+  fLastTime = std::chrono::steady_clock::now();
+  fLastEvents = 0U;
+  if (!exists()) return position;
+
+  // keep the current directory
+  TDirectory::TContext const context;
+
+  std::unique_ptr<TFile> file { TFile::Open(fConfig.path.c_str(), "READ") };
+  if (!file || file->IsZombie()) {
+    throw std::runtime_error
+      ("EventLoopCheckpoint: can't read checkpoint '" + fConfig.path + "'");
+  }
+
+  // --- BEGIN -- position -----------------------------------------------------
+  position.fileIndex
+    = static_cast<std::size_t>(readParameter(*file, "position/fileIndex"));
+  position.entry = readParameter(*file, "position/entry");
+  position.nEvents = static_cast<unsigned long long int>
+    (readParameter(*file, "position/nEvents"));
+  std::unique_ptr<TNamed> const filePath
+    { file->Get<TNamed>("position/filePath") };
+  if (filePath) position.filePath = filePath->GetTitle();
+
+  if (position.fileIndex > inputFiles.size()) {
+    throw std::runtime_error("EventLoopCheckpoint: checkpoint '"
+      + fConfig.path + "' is at file #" + std::to_string(position.fileIndex)
+      + ", but there are only " + std::to_string(inputFiles.size())
+      + " input files");
+  }
+  if ((position.fileIndex < inputFiles.size())
+    && (inputFiles[position.fileIndex] != position.filePath)
+  ) {
+    throw std::runtime_error("EventLoopCheckpoint: checkpoint '"
+      + fConfig.path + "' is at file #" + std::to_string(position.fileIndex)
+      + " '" + position.filePath + "', but that input file is '"
+      + inputFiles[position.fileIndex] + "'");
+  }
+  // --- END ---- position -----------------------------------------------------
+
+  // --- BEGIN -- histograms ---------------------------------------------------
+  for (HistogramRecord const& record: fHistograms) {
+    std::string const path = "histograms/" + record.name;
+    std::unique_ptr<TH1> saved { file->Get<TH1>(path.c_str()) };
+    if (!saved) {
+      throw std::runtime_error("EventLoopCheckpoint: histogram '" + path
+        + "' not found in checkpoint '" + fConfig.path + "'");
+    }
+    saved->SetDirectory(nullptr);
+    record.hist->Reset();
+    if (!record.hist->Add(saved.get())) {
+      throw std::runtime_error("EventLoopCheckpoint: histogram '" + path
+        + "' in checkpoint '" + fConfig.path
+        + "' is not compatible with the registered one");
+    }
+  } // for histograms
+  // --- END ---- histograms ---------------------------------------------------
+
+  // --- BEGIN -- generic states -----------------------------------------------
+  for (StateRecord const& record: fStates) {
+    std::string const path = "states/" + record.name;
+    Values_t values
+      (static_cast<std::size_t>(readParameter(*file, path + "/size")));
+    for (std::size_t i = 0; i < values.size(); ++i)
+      values[i] = readParameter(*file, path + "/" + std::to_string(i));
+    record.restore(values);
+  } // for states
+  // --- END ---- generic states -----------------------------------------------
+
+  fLastEvents = position.nEvents;
+  return position;
+} // EventLoopCheckpoint::restore()
+
+
+// -----------------------------------------------------------------------------
+bool EventLoopCheckpoint::update(CheckpointPosition const& position) {
+
+  bool const eventsDue = (fConfig.eventInterval > 0U)
+    && (position.nEvents - fLastEvents >= fConfig.eventInterval);
+  bool const timeDue = (fConfig.timeInterval.count() > 0)
+    && (std::chrono::steady_clock::now() - fLastTime >= fConfig.timeInterval);
+  if (!eventsDue && !timeDue) return false;
+
+  save(position);
+  return true;
+} // EventLoopCheckpoint::update()
+
+
+// -----------------------------------------------------------------------------
+void EventLoopCheckpoint::save(CheckpointPosition const& position) {
+
+  /*
+   * The checkpoint is written in full under a temporary name, and then moved
+   * in place: renaming within a directory replaces the old file atomically.
+   */
+  std::string const tempPath = fConfig.path + ".tmp";
+
+  // keep the current directory
+  TDirectory::TContext const context;
+
+  std::unique_ptr<TFile> file { TFile::Open(tempPath.c_str(), "RECREATE") };
+  if (!file || file->IsZombie()) {
+    throw std::runtime_error
+      ("EventLoopCheckpoint: can't create checkpoint '" + tempPath + "'");
+  }
+
+  TDirectory& positionDir = subdirectory(*file, "position");
+  writeParameter(positionDir, "fileIndex", position.fileIndex);
+  writeParameter(positionDir, "entry", position.entry);
+  writeParameter(positionDir, "nEvents", position.nEvents);
+  TNamed filePath { "filePath", position.filePath.c_str() };
+  positionDir.WriteTObject(&filePath, "filePath");
+
+  for (HistogramRecord const& record: fHistograms) {
+    auto const [ dirPath, name ] = splitPath("histograms/" + record.name);
+    subdirectory(*file, dirPath).WriteTObject(record.hist, name.c_str());
+  }
+
+  for (StateRecord const& record: fStates) {
+    Values_t const values = record.save();
+    TDirectory& stateDir = subdirectory(*file, "states/" + record.name);
+    writeParameter(stateDir, "size", values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      writeParameter(stateDir, std::to_string(i).c_str(), values[i]);
+  } // for states
+
+  file->Close();
+  file.reset();
+
+  if (std::rename(tempPath.c_str(), fConfig.path.c_str()) != 0) {
+    throw std::runtime_error("EventLoopCheckpoint: can't move checkpoint '"
+      + tempPath + "' into '" + fConfig.path + "'");
+  }
+
+  fLastEvents = position.nEvents;
+  fLastTime = std::chrono::steady_clock::now();
+  ++fNSaved;
+} // EventLoopCheckpoint::save()
+
+
+// -----------------------------------------------------------------------------
+void EventLoopCheckpoint::discard() {
+  std::remove(fConfig.path.c_str());
+} // EventLoopCheckpoint::discard()
+
+
+// -----------------------------------------------------------------------------
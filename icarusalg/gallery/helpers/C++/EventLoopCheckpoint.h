@@ -0,0 +1,239 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/EventLoopCheckpoint.h
+ * @brief  Periodic saving of the state of an event loop, to resume it later.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/EventLoopCheckpoint.cxx
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_EVENTLOOPCHECKPOINT_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_EVENTLOOPCHECKPOINT_H
+
+// ICARUS libraries
+#include "icarusalg/Utilities/PassCounter.h"
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+#include <functional> // std::function
+#include <utility> // std::move()
+#include <chrono>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+class TH1;
+class TDirectory;
+
+
+// -----------------------------------------------------------------------------
+/// Position of an event loop through its input files.
+struct CheckpointPosition {
+
+  std::size_t fileIndex = 0U; ///< Index of the current file in the input list.
+
+  std::string filePath; ///< Path of the current file (for cross-check).
+
+  long long int entry = 0; ///< First entry in the file not processed yet.
+
+  unsigned long long int nEvents = 0U; ///< Events processed until here.
+
+}; // CheckpointPosition
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Saves the state of an analysis event loop, and restores it.
+ * @see `forEachEventWithCheckpoints()` in `CheckpointedEventLoop.h`
+ *
+ * Long single-process jobs on preemptible slots lose all their progress when
+ * killed. This object periodically writes a checkpoint file with the
+ * position of the loop (`CheckpointPosition`: file and entry) and the state
+ * of the analysis algorithms, so that a new job with the same input can
+ * restore that state and continue from that position.
+ *
+ * The state to be saved is registered before the loop:
+ * * histograms (`registerHistogram()`, or all the ones in a ROOT directory
+ *   tree with `registerHistograms()`): their content is saved as a copy, and
+ *   restored by replacing the content of the registered histogram;
+ * * pass counters (`registerCounter()`);
+ * * any other state as a list of integers, through a pair of callables
+ *   (`registerState()`).
+ *
+ * Objects are identified by name: the job resuming from a checkpoint must
+ * register the same objects with the same names.
+ * Trees (e.g. from `ColumnWriter`) can't be saved this way: a resumed job
+ * writes in them only the events it processes.
+ *
+ * A checkpoint is saved by `update()` when either `Config::eventInterval`
+ * events or `Config::timeInterval` have passed since the last one. The file
+ * is first written with a temporary name and then renamed, so that a job
+ * killed while saving still leaves the previous checkpoint intact.
+ * When the job has safely written its output, the checkpoint should be
+ * removed with `discard()`, so that a new run does not resume from it.
+ */
+class EventLoopCheckpoint {
+
+    public:
+
+  /// Type of the values saving a generic state.
+  using Values_t = std::vector<long long int>;
+
+  /// Configuration of the checkpoints.
+  struct Config {
+
+    std::string path; ///< Path of the checkpoint file.
+
+    /// Events between checkpoints (`0`: no limit).
+    unsigned long long int eventInterval = 10000U;
+
+    /// Time between checkpoints (`0`: no limit).
+    std::chrono::seconds timeInterval { 600 };
+
+  }; // Config
+
+
+  /// Constructor: no state registered, no checkpoint read yet.
+  explicit EventLoopCheckpoint(Config config);
+
+
+  // --- BEGIN -- State registration -------------------------------------------
+  /// @name State registration
+  /// @{
+
+  /// Registers `hist` to be saved with the specified `name`.
+  void registerHistogram(TH1& hist, std::string name);
+
+  /**
+   * @brief Registers all the histograms in `dir` and its subdirectories.
+   * @param dir the directory to look into
+   * @param prefix (default: none) prefix to the name of the histograms
+   * @return the number of histograms registered
+   *
+   * The histograms are those currently in memory in the directories (as
+   * created by the algorithms at setup time), and they are registered with
+   * their path under `dir` as name.
+   */
+  unsigned int registerHistograms
+    (TDirectory& dir, std::string const& prefix = "");
+
+  /// Registers a state, saved as the values returned by `save()`, and
+  /// restored by calling `restore(values)`.
+  void registerState(
+    std::string name,
+    std::function<Values_t()> save,
+    std::function<void(Values_t const&)> restore
+    );
+
+  /// Registers `counter` to be saved with the specified `name`.
+  template <typename Count>
+  void registerCounter
+    (std::string name, icarus::ns::util::PassCounter<Count>& counter);
+
+  /// @}
+  // --- END ---- State registration -------------------------------------------
+
+
+  // --- BEGIN -- Checkpoints --------------------------------------------------
+  /// @name Checkpoints
+  /// @{
+
+  /// Returns whether a checkpoint file is present.
+  bool exists() const;
+
+  /**
+   * @brief Restores the state from the checkpoint file, if any.
+   * @param inputFiles the list of input files of the job
+   * @return the position to resume the loop from
+   * @throw std::runtime_error if the checkpoint does not match the job
+   *
+   * If there is no checkpoint file, nothing is changed and the start
+   * position is returned. Otherwise, all registered objects are restored.
+   * It is an error if the checkpoint position refers to a different file in
+   * `inputFiles`, or if a registered object is missing from the checkpoint.
+   */
+  CheckpointPosition restore(std::vector<std::string> const& inputFiles);
+
+  /**
+   * @brief Saves a checkpoint if enough events or time passed since the last.
+   * @param position the position the loop would resume from
+   * @return whether a checkpoint was saved
+   */
+  bool update(CheckpointPosition const& position);
+
+  /**
+   * @brief Saves a checkpoint with the current state and `position`.
+   * @throw std::runtime_error if the checkpoint can't be written
+   */
+  void save(CheckpointPosition const& position);
+
+  /// Removes the checkpoint file (e.g. when the job output is complete).
+  void discard();
+
+  /// Returns the number of checkpoints saved so far.
+  unsigned int nSaved() const { return fNSaved; }
+
+  /// @}
+  // --- END ---- Checkpoints --------------------------------------------------
+
+
+    private:
+
+  /// A histogram to be saved.
+  struct HistogramRecord {
+    TH1* hist; ///< The histogram (not owned).
+    std::string name; ///< Name of the histogram in the checkpoint.
+  }; // HistogramRecord
+
+  /// A generic state to be saved.
+  struct StateRecord {
+    std::string name; ///< Name of the state in the checkpoint.
+    std::function<Values_t()> save; ///< Extracts the state.
+    std::function<void(Values_t const&)> restore; ///< Sets the state.
+  }; // StateRecord
+
+  Config const fConfig; ///< Configuration.
+
+  std::vector<HistogramRecord> fHistograms; ///< Registered histograms.
+
+  std::vector<StateRecord> fStates; ///< Registered generic states.
+
+  /// Number of processed events at the last checkpoint.
+  unsigned long long int fLastEvents = 0U;
+
+  /// Time of the last checkpoint (or of the start).
+  std::chrono::steady_clock::time_point fLastTime;
+
+  unsigned int fNSaved = 0U; ///< Number of checkpoints saved.
+
+}; // class EventLoopCheckpoint
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename Count>
+void EventLoopCheckpoint::registerCounter
+  (std::string name, icarus::ns::util::PassCounter<Count>& counter)
+{
+  registerState(
+    std::move(name),
+    [&counter]()
+      {
+        return Values_t{
+          static_cast<long long int>(counter.total()),
+          static_cast<long long int>(counter.passed())
+        };
+      },
+    [&counter](Values_t const& values)
+      {
+        counter.restore(static_cast<Count>(values.at(0)),
+          static_cast<Count>(values.at(1)));
+      }
+    );
+} // EventLoopCheckpoint::registerCounter()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_EVENTLOOPCHECKPOINT_H
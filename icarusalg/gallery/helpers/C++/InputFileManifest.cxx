@@ -0,0 +1,177 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/InputFileManifest.cxx
+ * @brief  Scan of the content of input ROOT files.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/InputFileManifest.h
+ */
+
+// library header
+#include "icarusalg/gallery/helpers/C++/InputFileManifest.h"
+
+// ICARUS libraries
+#include "icarusalg/Utilities/runConcurrently.h"
+
+// framework libraries
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+
+// ROOT
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TROOT.h" // ROOT::EnableThreadSafety()
+
+// C/C++ libraries
+#include <memory> // std::unique_ptr
+#include <algorithm> // std::max()
+#include <numeric> // std::accumulate()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+  
+  /// Fills `info.events` with the ID of each event in `tree`.
+  void readEventIDs(InputFileInfo& info, TTree& tree) {
+    
+    TBranch* const branch = tree.GetBranch("EventAuxiliary");
+    if (!branch) {
+      info.error = "no event auxiliary information";
+      return;
+    }
+    
+    // the branch is read alone, and no data product is loaded
+    art::EventAuxiliary* aux = nullptr;
+    branch->SetAddress(&aux);
+    info.events.reserve(info.nEvents);
+    for (long long int entry = 0; entry < info.nEvents; ++entry) {
+      if (branch->GetEntry(entry) <= 0) {
+        info.error = "can't read event auxiliary information of entry "
+          + std::to_string(entry);
+        break;
+      }
+      info.events.push_back(aux->id());
+    } // for
+    branch->ResetAddress();
+    delete aux;
+    
+  } // readEventIDs()
+  
+  
+  /// Fills `info` with the content of the file at `info.path`.
+  void scanInputFile
+    (InputFileInfo& info, bool readEventIDs, std::string const& treeName)
+  {
+    
+    std::unique_ptr<TFile> file { TFile::Open(info.path.c_str(), "READ") };
+    if (!file || file->IsZombie()) {
+      info.error = "can't open the file";
+      return;
+    }
+    
+    TTree* const tree = file->Get<TTree>(treeName.c_str());
+    if (!tree) {
+      info.error = "no '" + treeName + "' tree";
+      return;
+    }
+    
+    info.nEvents = tree->GetEntries();
+    
+    if (readEventIDs) ::readEventIDs(info, *tree);
+    
+  } // scanInputFile()
+  
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+std::vector<InputFileInfo> scanInputFiles(
+  std::vector<std::string> const& filePaths,
+  unsigned int nThreads /* = 1U */, bool readEventIDs /* = false */,
+  std::string const& treeName /* = "Events" */
+) {
+  
+  std::vector<InputFileInfo> manifest(filePaths.size());
+  for (std::size_t i = 0; i < filePaths.size(); ++i)
+    manifest[i].path = filePaths[i];
+  
+  if (nThreads > filePaths.size()) nThreads = filePaths.size();
+  if (nThreads > 1U) ROOT::EnableThreadSafety();
+  
+  icarus::ns::util::runConcurrently(manifest.size(), std::max(nThreads, 1U),
+    [&manifest,readEventIDs,&treeName](std::size_t i)
+    { scanInputFile(manifest[i], readEventIDs, treeName); }
+    );
+  
+  return manifest;
+} // scanInputFiles()
+
+
+// -----------------------------------------------------------------------------
+std::vector<std::vector<std::string>> shardInputFiles
+  (std::vector<InputFileInfo> const& manifest, unsigned int nShards)
+{
+  std::vector<InputFileInfo const*> files;
+  for (InputFileInfo const& info: manifest)
+    if (info.valid() && (info.nEvents > 0)) files.push_back(&info);
+  
+  if (nShards == 0) nShards = 1;
+  if (nShards > files.size()) nShards = files.size();
+  
+  long long int const totalEvents = std::accumulate(files.begin(), files.end(),
+    0LL, [](long long int n, InputFileInfo const* info){ return n + info->nEvents; }
+    );
+  
+  // a shard is closed when its events bring the total over its share
+  long long int const nShardsL = nShards;
+  std::vector<std::vector<std::string>> shards(nShards);
+  long long int nEvents = 0;
+  std::size_t iShard = 0;
+  for (std::size_t iFile = 0; iFile < files.size(); ++iFile) {
+    // leave at least one file for each of the remaining shards
+    std::size_t const filesLeft = files.size() - iFile;
+    if ((iShard + 1 < nShards) && !shards[iShard].empty()
+      && (filesLeft == nShards - iShard - 1)
+    ) {
+      ++iShard;
+    }
+    shards[iShard].push_back(files[iFile]->path);
+    nEvents += files[iFile]->nEvents;
+    long long int const shareEnd = totalEvents * (iShard + 1);
+    if ((iShard + 1 < nShards) && (nEvents * nShardsL >= shareEnd)) ++iShard;
+  } // for
+  
+  return shards;
+} // shardInputFiles(manifest)
+
+
+// -----------------------------------------------------------------------------
+std::vector<FileEntries> selectEntryRange(
+  std::vector<InputFileInfo> const& manifest,
+  long long int skip, long long int count /* = -1 */
+) {
+  std::vector<FileEntries> selection;
+  for (InputFileInfo const& info: manifest) {
+    if (count == 0) break;
+    if (!info.valid()) continue;
+    
+    if (skip >= info.nEvents) { // the whole file is skipped, and not opened
+      skip -= info.nEvents;
+      continue;
+    }
+    
+    long long int const end = ((count < 0) || (skip + count > info.nEvents))
+      ? info.nEvents: skip + count;
+    FileEntries entries { info.path, {} };
+    entries.entries.reserve(end - skip);
+    for (long long int entry = skip; entry < end; ++entry)
+      entries.entries.push_back(entry);
+    if (count > 0) count -= end - skip;
+    skip = 0;
+    selection.push_back(std::move(entries));
+  } // for
+  return selection;
+} // selectEntryRange()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/InputFileManifest.h
+ * @brief  Scan of the content of input ROOT files.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/InputFileManifest.cxx
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_INPUTFILEMANIFEST_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_INPUTFILEMANIFEST_H
+
+// framework libraries
+#include "canvas/Persistency/Provenance/EventID.h"
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+/// Information about one input file, from `scanInputFiles()`.
+struct InputFileInfo {
+  
+  std::string path; ///< Path of the file.
+  
+  long long int nEvents = 0; ///< Number of events in the file.
+  
+  /// ID of each event, in entry order (only if requested).
+  std::vector<art::EventID> events;
+  
+  std::string error; ///< Why the file can't be used (empty if it can).
+  
+  /// Returns whether the file could be opened and its events counted.
+  bool valid() const { return error.empty(); }
+  
+}; // InputFileInfo
+
+
+// -----------------------------------------------------------------------------
+/// A file and a list of entries in it (e.g. the events selected there).
+struct FileEntries {
+  
+  std::string path; ///< Path of the file.
+  
+  std::vector<long long int> entries; ///< Entries in the event tree, sorted.
+  
+}; // FileEntries
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Opens all the files and counts their events.
+ * @param filePaths paths of the ROOT files (e.g. from `expandInputFiles()`)
+ * @param nThreads (default: `1`) number of files to open at the same time
+ * @param readEventIDs (default: `false`) also read the ID of all the events
+ * @param treeName (default: `"Events"`) name of the tree of the events
+ * @return a manifest: information about each file, in the input order
+ * 
+ * Each file is opened and the number of entries in its event tree is read.
+ * Files which can't be opened, are corrupted or have no event tree are not
+ * dropped: their information has an explanation in `InputFileInfo::error`
+ * instead, and no events. This allows to find out problems with the input
+ * at the start of a job, rather than in the middle of it.
+ * 
+ * If `readEventIDs` is `true`, the event auxiliary information of all the
+ * events is also read (and nothing else), and their IDs are stored in
+ * `InputFileInfo::events`, e.g. to build an `EventIndex`.
+ * 
+ * With more than one thread, ROOT thread safety is enabled.
+ */
+std::vector<InputFileInfo> scanInputFiles(
+  std::vector<std::string> const& filePaths,
+  unsigned int nThreads = 1U, bool readEventIDs = false,
+  std::string const& treeName = "Events"
+  );
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Splits the files of `manifest` in up to `nShards` lists of files,
+ *        with similar number of events.
+ * @param manifest information about the files, as from `scanInputFiles()`
+ * @param nShards the number of lists to split the files into
+ * @return the lists of files
+ * 
+ * Each list is a contiguous sequence of the files in `manifest`.
+ * Files which are not valid or have no event are left out.
+ * There are fewer lists than `nShards` if there are fewer files.
+ */
+std::vector<std::vector<std::string>> shardInputFiles
+  (std::vector<InputFileInfo> const& manifest, unsigned int nShards);
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns the entries of `count` events after skipping `skip`.
+ * @param manifest information about the files, as from `scanInputFiles()`
+ * @param skip number of events to skip from the start
+ * @param count (default: all) maximum number of events to select
+ * @return the selected entries, file by file, only for files with any
+ * 
+ * Events are counted through all the valid files of `manifest`, in order,
+ * as a `gallery::Event` loop on all of them would.
+ * Files with no selected entry are not included in the result at all.
+ */
+std::vector<FileEntries> selectEntryRange(
+  std::vector<InputFileInfo> const& manifest,
+  long long int skip, long long int count = -1
+  );
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_INPUTFILEMANIFEST_H
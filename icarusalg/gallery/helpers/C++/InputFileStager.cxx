@@ -0,0 +1,240 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/InputFileStager.cxx
+ * @brief  Opens or copies the next input files in background.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/InputFileStager.h
+ */
+
+// library header
+#include "icarusalg/gallery/helpers/C++/InputFileStager.h"
+
+// ROOT
+#include "TFile.h"
+#include "TSystem.h" // gSystem
+#include "TROOT.h" // ROOT::EnableThreadSafety()
+
+// C/C++ libraries
+#include <fstream>
+#include <algorithm> // std::max()
+#include <utility> // std::move()
+#include <cstdio> // std::rename(), std::remove()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Returns the file name part of `path` (or URL).
+  std::string fileNameOf(std::string const& path) {
+    std::size_t const iSep = path.rfind('/');
+    std::string name
+      = (iSep == std::string::npos)? path: path.substr(iSep + 1);
+    // drop URL options
+    std::size_t const iOpts = name.find('?');
+    if (iOpts != std::string::npos) name.erase(iOpts);
+    return name;
+  } // fileNameOf()
+
+
+  /// Returns the size of the local file at `path` (`0` if not readable).
+  unsigned long long int fileSize(std::string const& path) {
+    std::ifstream file { path, std::ios::binary | std::ios::ate };
+    if (!file) return 0U;
+    auto const size = file.tellg();
+    return (size > 0)? static_cast<unsigned long long int>(size): 0U;
+  } // fileSize()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+bool isRemoteFile(std::string const& path) {
+  return path.find("://") != std::string::npos;
+} // isRemoteFile()
+
+
+// -----------------------------------------------------------------------------
+InputFileStager::InputFileStager
+  (std::vector<std::string> inputFiles, Config config)
+  : fInputFiles{ std::move(inputFiles) }
+  , fConfig{ std::move(config) }
+  , fFiles(fInputFiles.size())
+{
+  ROOT::EnableThreadSafety();
+  if (!fConfig.scratchDir.empty())
+    gSystem->mkdir(fConfig.scratchDir.c_str(), kTRUE);
+
+  fStager = std::thread{ &InputFileStager::stageFiles, this };
+} // InputFileStager::InputFileStager()
+
+
+// -----------------------------------------------------------------------------
+InputFileStager::~InputFileStager() {
+
+  {
+    std::lock_guard lock { fLock };
+    fStop = true;
+  }
+  fSlotAvailable.notify_all();
+  if (fStager.joinable()) fStager.join();
+
+  for (std::size_t iFile = 0; iFile < fFiles.size(); ++iFile) release(iFile);
+
+} // InputFileStager::~InputFileStager()
+
+
+// -----------------------------------------------------------------------------
+InputFileStager::FileInfo const& InputFileStager::next() {
+
+  auto const start = std::chrono::steady_clock::now();
+  std::unique_lock lock { fLock };
+
+  // the previous file is not needed any more
+  if (fNextToUse > 0U) release(fNextToUse - 1U);
+
+  std::size_t const iFile = fNextToUse++;
+  lock.unlock();
+  fSlotAvailable.notify_all();
+
+  lock.lock();
+  fFileReady.wait(lock, [this,iFile](){ return fFiles[iFile].ready; });
+  fWaitTime += std::chrono::steady_clock::now() - start;
+
+  return fFiles[iFile].info;
+} // InputFileStager::next()
+
+
+// -----------------------------------------------------------------------------
+unsigned int InputFileStager::nRetries() const {
+  std::lock_guard lock { fLock };
+  return fNRetries;
+} // InputFileStager::nRetries()
+
+
+// -----------------------------------------------------------------------------
+unsigned long long int InputFileStager::stagedBytes() const {
+  std::lock_guard lock { fLock };
+  return fStagedBytes;
+} // InputFileStager::stagedBytes()
+
+
+// -----------------------------------------------------------------------------
+void InputFileStager::stageFiles() {
+
+  for (std::size_t iFile = 0; iFile < fInputFiles.size(); ++iFile) {
+
+    FileState_t state;
+    state.info.path = fInputFiles[iFile];
+    state.info.localPath = state.info.path;
+
+    if (isRemoteFile(state.info.path)) {
+      /*
+       * Wait for a slot: at most `nAhead` files beyond the current one, and
+       * a new copy only within the disk budget, unless the file is the very
+       * next one needed.
+       */
+      bool const staging = !fConfig.scratchDir.empty();
+      {
+        std::unique_lock lock { fLock };
+        fSlotAvailable.wait(lock, [this,iFile,staging]()
+          {
+            if (fStop) return true;
+            if (iFile >= fNextToUse + fConfig.nAhead) return false;
+            return !staging || (iFile <= fNextToUse)
+              || (fUsedBytes < fConfig.maxScratchBytes);
+          });
+        if (fStop) return;
+      }
+
+      auto const start = std::chrono::steady_clock::now();
+      if (!prepare(iFile, state)) return;
+      state.info.prepareTime = std::chrono::steady_clock::now() - start;
+    } // if remote
+
+    {
+      std::lock_guard lock { fLock };
+      fNRetries += (state.info.attempts > 1U)? state.info.attempts - 1U: 0U;
+      if (state.info.staged) {
+        fUsedBytes += state.bytes;
+        fStagedBytes += state.bytes;
+      }
+      state.ready = true;
+      fFiles[iFile] = std::move(state);
+    }
+    fFileReady.notify_all();
+
+  } // for
+
+} // InputFileStager::stageFiles()
+
+
+// -----------------------------------------------------------------------------
+bool InputFileStager::prepare(std::size_t iFile, FileState_t& state) {
+
+  FileInfo& info = state.info;
+  bool const staging = !fConfig.scratchDir.empty();
+  std::string const localPath = staging
+    ? (fConfig.scratchDir + "/" + std::to_string(iFile) + "-"
+      + fileNameOf(info.path))
+    : info.path;
+  std::string const partialPath = localPath + ".part";
+
+  unsigned int const maxAttempts = std::max(fConfig.maxAttempts, 1U);
+  for (info.attempts = 1U; ; ++info.attempts) {
+
+    if (staging) {
+      // the copy is written with a temporary name, and renamed when complete
+      if (TFile::Cp(info.path.c_str(), partialPath.c_str(), kFALSE)
+        && (std::rename(partialPath.c_str(), localPath.c_str()) == 0)
+      ) {
+        info.localPath = localPath;
+        info.staged = true;
+        state.bytes = fileSize(localPath);
+        info.error.clear();
+        return true;
+      }
+      std::remove(partialPath.c_str());
+      info.error = "can't copy '" + info.path + "' into '" + localPath + "'";
+    }
+    else {
+      std::unique_ptr<TFile> file { TFile::Open(info.path.c_str(), "READ") };
+      if (file && !file->IsZombie()) {
+        state.openFile = std::move(file);
+        info.error.clear();
+        return true;
+      }
+      info.error = "can't open '" + info.path + "'";
+    }
+
+    if (info.attempts >= maxAttempts) break;
+
+    // wait longer after each failure, unless asked to stop
+    std::unique_lock lock { fLock };
+    if (fSlotAvailable.wait_for(lock, fConfig.retryDelay * info.attempts,
+      [this](){ return fStop; }))
+    {
+      return false;
+    }
+  } // for attempts
+
+  info.error += " (" + std::to_string(info.attempts) + " attempts)";
+  return true;
+} // InputFileStager::prepare()
+
+
+// -----------------------------------------------------------------------------
+void InputFileStager::release(std::size_t iFile) {
+
+  FileState_t& state = fFiles[iFile];
+  state.openFile.reset();
+  if (state.info.staged) {
+    std::remove(state.info.localPath.c_str());
+    fUsedBytes -= state.bytes;
+    state.bytes = 0U;
+    state.info.staged = false;
+  }
+
+} // InputFileStager::release()
+
+
+// -----------------------------------------------------------------------------
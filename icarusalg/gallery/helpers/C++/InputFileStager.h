@@ -0,0 +1,232 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/InputFileStager.h
+ * @brief  Opens or copies the next input files in background.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/InputFileStager.cxx
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_INPUTFILESTAGER_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_INPUTFILESTAGER_H
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+#include <memory> // std::unique_ptr
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+class TFile;
+
+
+// -----------------------------------------------------------------------------
+/// Returns whether `path` is a URL (e.g. `root://...`), not a local path.
+bool isRemoteFile(std::string const& path);
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Prepares the next input files while the current one is processed.
+ *
+ * Input files from `expandInputFiles()` are usually opened by
+ * `gallery::Event` one after the other, and with XRootD or dCache URLs each
+ * open may take seconds, during which the analysis waits. This object hands
+ * out the input files one at a time with `next()`, while a background thread
+ * prepares the following `Config::nAhead` ones. Local files are passed
+ * through unchanged. Remote files (`isRemoteFile()`) are prepared in one of
+ * two ways:
+ * * if `Config::scratchDir` is set, they are copied ("staged") there, and the
+ *   local copy is handed out; the copy is removed when the next file is
+ *   requested (or at destruction); no new copy is started while the copies
+ *   on disk take more than `Config::maxScratchBytes`, unless it is the one
+ *   needed next: the disk use exceeds the limit by at most one file;
+ * * otherwise, they are opened in advance and kept open until the next file
+ *   is requested: redirections and recalls from tape are then already done,
+ *   and the connection to the server is in place, when `gallery` opens them.
+ *
+ * Each preparation is attempted up to `Config::maxAttempts` times, waiting
+ * `Config::retryDelay` longer after each failure. A file which could not be
+ * prepared is still handed out, with the reason in `FileInfo::error`, and
+ * the caller decides whether to skip it.
+ *
+ * The time spent in `next()` waiting for a file to be ready is accumulated
+ * in `waitTime()`: if it is not negligible, more files should be prepared in
+ * advance.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * InputFileStager::Config config;
+ * config.scratchDir = "/scratch/myjob";
+ * InputFileStager inputFiles{ expandInputFiles(inputFileLists), config };
+ * while (!inputFiles.atEnd()) {
+ *   InputFileStager::FileInfo const& file = inputFiles.next();
+ *   if (!file.valid()) {
+ *     std::cerr << file.error << std::endl;
+ *     continue;
+ *   }
+ *   for (gallery::Event event({ file.localPath }); !event.atEnd();
+ *     event.next()
+ *   ) {
+ *     // ...
+ *   }
+ * }
+ * std::cout << "Waited " << inputFiles.waitTime().count()
+ *   << " s for the input files." << std::endl;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * ROOT thread safety is enabled on construction
+ * (`ROOT::EnableThreadSafety()`), since ROOT is used by two threads.
+ */
+class InputFileStager {
+
+    public:
+
+  /// Type of duration used to report time.
+  using Duration_t = std::chrono::duration<double>;
+
+  /// Configuration of the stager.
+  struct Config {
+
+    /// Number of files prepared in advance, beyond the current one.
+    unsigned int nAhead = 2U;
+
+    /// Directory to copy remote files into (empty: open them in advance).
+    std::string scratchDir;
+
+    /// Disk space the copies may use in `scratchDir`.
+    unsigned long long int maxScratchBytes = 20'000'000'000ULL;
+
+    /// Number of attempts to prepare a file before giving up.
+    unsigned int maxAttempts = 3U;
+
+    /// Wait before the second attempt (it grows with each further attempt).
+    std::chrono::seconds retryDelay { 5 };
+
+  }; // Config
+
+
+  /// Information on a file handed out.
+  struct FileInfo {
+
+    std::string path; ///< Path of the file as in the input list.
+
+    std::string localPath; ///< Path to be opened (copy, or same as `path`).
+
+    bool staged = false; ///< Whether `localPath` is a local copy.
+
+    unsigned int attempts = 0U; ///< Number of attempts to prepare the file.
+
+    Duration_t prepareTime { 0.0 }; ///< Time spent preparing the file.
+
+    std::string error; ///< Why the file could not be prepared (if so).
+
+    /// Returns whether the file was prepared successfully.
+    bool valid() const { return error.empty(); }
+
+  }; // FileInfo
+
+
+  /// Constructor: starts preparing the first files in background.
+  InputFileStager(std::vector<std::string> inputFiles, Config config);
+
+  /// Destructor: stops the background thread and removes all the copies.
+  ~InputFileStager();
+
+  // the background thread holds a pointer to this object
+  InputFileStager(InputFileStager const&) = delete;
+  InputFileStager& operator= (InputFileStager const&) = delete;
+
+
+  // --- BEGIN -- Iteration ----------------------------------------------------
+  /// @name Iteration
+  /// @{
+
+  /// Returns whether all the files have been handed out.
+  bool atEnd() const { return fNextToUse >= fInputFiles.size(); }
+
+  /**
+   * @brief Releases the current file, and returns the next one.
+   * @return information on the next file, valid until the next call
+   *
+   * This call blocks until the next file is ready. It must not be called
+   * when `atEnd()` is `true`.
+   */
+  FileInfo const& next();
+
+  /// @}
+  // --- END ---- Iteration ----------------------------------------------------
+
+
+  // --- BEGIN -- Statistics ---------------------------------------------------
+  /// @name Statistics
+  /// @{
+
+  /// Returns the total time spent in `next()` waiting for a file.
+  Duration_t waitTime() const { return fWaitTime; }
+
+  /// Returns the number of files handed out so far.
+  std::size_t nFiles() const { return fNextToUse; }
+
+  /// Returns the number of failed attempts (for all the files so far).
+  unsigned int nRetries() const;
+
+  /// Returns the total size of the files copied so far.
+  unsigned long long int stagedBytes() const;
+
+  /// @}
+  // --- END ---- Statistics ---------------------------------------------------
+
+
+    private:
+
+  /// State of a file, and what is kept while it is in use.
+  struct FileState_t {
+    FileInfo info; ///< Information for the caller.
+    bool ready = false; ///< Whether the preparation is complete.
+    unsigned long long int bytes = 0U; ///< Disk space used by the copy.
+    std::unique_ptr<TFile> openFile; ///< File kept open, if any.
+  }; // FileState_t
+
+
+  // --- BEGIN -- Configuration ------------------------------------------------
+  std::vector<std::string> const fInputFiles; ///< Files to be handed out.
+  Config const fConfig; ///< Configuration.
+  // --- END ---- Configuration ------------------------------------------------
+
+  // --- BEGIN -- Shared with the staging thread (protected by `fLock`) --------
+  mutable std::mutex fLock; ///< Protects the file states and counters.
+  std::condition_variable fFileReady; ///< Signals a prepared file.
+  std::condition_variable fSlotAvailable; ///< Signals released files.
+  std::vector<FileState_t> fFiles; ///< State of each of the files.
+  std::size_t fNextToUse = 0U; ///< Index of the next file to hand out.
+  unsigned long long int fUsedBytes = 0U; ///< Disk used by the copies now.
+  unsigned long long int fStagedBytes = 0U; ///< Size of all copies so far.
+  unsigned int fNRetries = 0U; ///< Number of failed attempts so far.
+  bool fStop = false; ///< Whether the staging thread should stop.
+  // --- END ---- Shared with the staging thread -------------------------------
+
+  Duration_t fWaitTime { 0.0 }; ///< Total time waited in `next()`.
+
+  std::thread fStager; ///< The background staging thread.
+
+
+  /// Prepares all the files, in order (in the background thread).
+  void stageFiles();
+
+  /// Prepares the file `iFile`, with retries; returns `false` if stopped.
+  bool prepare(std::size_t iFile, FileState_t& state);
+
+  /// Releases the resources of the file `iFile` (lock must be held).
+  void release(std::size_t iFile);
+
+}; // InputFileStager
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_INPUTFILESTAGER_H
@@ -0,0 +1,180 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/ParallelEventLoop.h
+ * @brief  Runs a gallery event loop on several threads.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/expandInputFiles.h
+ * 
+ * This library is header only, and it requires linking to `gallery`, ROOT
+ * and `icarusalg::gallery_helpers`.
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_PARALLELEVENTLOOP_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_PARALLELEVENTLOOP_H
+
+// ICARUS libraries
+#include "icarusalg/gallery/helpers/C++/expandInputFiles.h" // shardInputFiles()
+#include "icarusalg/gallery/helpers/C++/InputFileManifest.h"
+#include "icarusalg/Utilities/runConcurrently.h"
+
+// framework libraries
+#include "gallery/Event.h"
+
+// ROOT
+#include "TROOT.h" // ROOT::EnableThreadSafety()
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+#include <thread> // std::thread::hardware_concurrency()
+#include <functional> // std::invoke()
+#include <type_traits> // std::invoke_result_t
+#include <utility> // std::move(), std::as_const()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Processes the lists of files in `shards` concurrently.
+ * @see `runParallelEventLoop()`
+ * 
+ * This is the engine of `runParallelEventLoop()`, with up to one thread per
+ * list of files. Empty lists are still assigned an algorithm instance, with
+ * no event to process.
+ */
+template <typename MakeAlgorithm, typename ProcessEvent>
+std::invoke_result_t<MakeAlgorithm&, unsigned int> runParallelEventLoopOnShards(
+  std::vector<std::vector<std::string>> const& shards,
+  MakeAlgorithm makeAlgorithm, ProcessEvent processEvent
+) {
+  using Algorithm_t = std::invoke_result_t<MakeAlgorithm&, unsigned int>;
+  
+  if (shards.empty()) return std::invoke(makeAlgorithm, 0U);
+  
+  if (shards.size() > 1) ROOT::EnableThreadSafety();
+  
+  std::vector<Algorithm_t> algorithms;
+  algorithms.reserve(shards.size());
+  for (unsigned int iWorker = 0; iWorker < shards.size(); ++iWorker)
+    algorithms.push_back(std::invoke(makeAlgorithm, iWorker));
+  
+  // each shard has its own algorithm instance and its own gallery event
+  auto const processShard = [&](std::size_t iShard)
+    {
+      if (shards[iShard].empty()) return;
+      Algorithm_t& algorithm = algorithms[iShard];
+      for (
+        gallery::Event event(shards[iShard]); !event.atEnd(); event.next()
+      ) {
+        std::invoke(processEvent, algorithm, std::as_const(event));
+      }
+    };
+  icarus::ns::util::runConcurrently
+    (shards.size(), static_cast<unsigned int>(shards.size()), processShard);
+  
+  Algorithm_t& merged = algorithms.front();
+  for (unsigned int iWorker = 1; iWorker < algorithms.size(); ++iWorker)
+    merged.merge(std::move(algorithms[iWorker]));
+  
+  return std::move(merged);
+} // runParallelEventLoopOnShards()
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Processes all the events from `inputFiles` with `nWorkers` threads.
+ * @tparam MakeAlgorithm type of the callable creating an algorithm instance
+ * @tparam ProcessEvent type of the callable processing an event
+ * @param inputFiles list of the paths of all the ROOT files to process
+ * @param nWorkers number of threads to use (`0`: one per available core)
+ * @param makeAlgorithm creates a new algorithm instance, `makeAlgorithm(i)`
+ * @param processEvent processes one event, `processEvent(algorithm, event)`
+ * @return the algorithm instance with the results of all workers merged
+ * 
+ * The list of input files (as from `expandInputFiles()`) is split by
+ * `shardInputFiles()` into up to `nWorkers` contiguous parts. One algorithm
+ * instance is created for each part, in the calling thread, via
+ * `makeAlgorithm(iWorker)`. Then the parts are processed concurrently, up to
+ * one thread per part, each part with its own `gallery::Event` object,
+ * calling `processEvent(algorithm, event)` on each event with the algorithm
+ * instance of that part only. When all parts are done, the instances are
+ * merged into the first one, in order, via `first.merge(std::move(other))`,
+ * and the first instance is returned.
+ * 
+ * The algorithm type must then be move-constructible and provide a `merge()`
+ * method accepting another instance of the same type (by value, constant
+ * reference or rvalue reference). Since each part of the file list is
+ * always processed by the same algorithm instance, and the merge happens in
+ * order, the result does not depend on the scheduling of the threads.
+ * 
+ * If any of the workers throws an exception, the other workers still finish
+ * their parts, and then the exception from the first failing part is
+ * rethrown (see `icarus::ns::util::runConcurrently()`). If no input file is
+ * specified, an algorithm instance is created and returned without
+ * processing any event.
+ * 
+ * When using more than one worker, ROOT thread safety is enabled
+ * (`ROOT::EnableThreadSafety()`). Algorithms must not share objects
+ * which are not thread-safe: for example, each instance should own its own
+ * histograms (not registered in a `TDirectory`), to be merged by `merge()`.
+ * 
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * struct HitCounter {
+ *   art::InputTag hitTag;
+ *   unsigned long int nHits = 0;
+ *   
+ *   void analyze(gallery::Event const& event)
+ *     {
+ *       nHits
+ *         += event.getValidHandle<std::vector<recob::Hit>>(hitTag)->size();
+ *     }
+ *   void merge(HitCounter const& other) { nHits += other.nHits; }
+ * };
+ * 
+ * HitCounter const counter = runParallelEventLoop(
+ *   expandInputFiles(inputFiles), 8U,
+ *   [](unsigned int){ return HitCounter{ art::InputTag{ "gaushit" } }; },
+ *   [](HitCounter& counter, gallery::Event const& event)
+ *     { counter.analyze(event); }
+ *   );
+ * std::cout << "Total hits: " << counter.nHits << std::endl;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename MakeAlgorithm, typename ProcessEvent>
+std::invoke_result_t<MakeAlgorithm&, unsigned int> runParallelEventLoop(
+  std::vector<std::string> const& inputFiles, unsigned int nWorkers,
+  MakeAlgorithm makeAlgorithm, ProcessEvent processEvent
+) {
+  if (nWorkers == 0) nWorkers = std::thread::hardware_concurrency();
+  return runParallelEventLoopOnShards(shardInputFiles(inputFiles, nWorkers),
+    std::move(makeAlgorithm), std::move(processEvent));
+} // runParallelEventLoop()
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Processes all the events in `manifest` with `nWorkers` threads.
+ * @param manifest information on the input files, from `scanInputFiles()`
+ * @see `runParallelEventLoop(std::vector<std::string> const&, unsigned int, MakeAlgorithm, ProcessEvent)`
+ * 
+ * As the version with a list of input files, but the files are split among
+ * the workers so that each of them processes a similar number of events
+ * (see `shardInputFiles(std::vector<InputFileInfo> const&, unsigned int)`).
+ * Files which are not valid or have no events are skipped.
+ */
+template <typename MakeAlgorithm, typename ProcessEvent>
+std::invoke_result_t<MakeAlgorithm&, unsigned int> runParallelEventLoop(
+  std::vector<InputFileInfo> const& manifest, unsigned int nWorkers,
+  MakeAlgorithm makeAlgorithm, ProcessEvent processEvent
+) {
+  if (nWorkers == 0) nWorkers = std::thread::hardware_concurrency();
+  return runParallelEventLoopOnShards(shardInputFiles(manifest, nWorkers),
+    std::move(makeAlgorithm), std::move(processEvent));
+} // runParallelEventLoop(manifest)
+
+
+// -----------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_PARALLELEVENTLOOP_H
@@ -0,0 +1,283 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/PlotFileMerger.cxx
+ * @brief  Parallel merging of ROOT files with plot directory trees.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/PlotFileMerger.h
+ */
+
+// library header
+#include "icarusalg/gallery/helpers/C++/PlotFileMerger.h"
+
+// ICARUS libraries
+#include "icarusalg/Utilities/runConcurrently.h"
+
+// ROOT
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TList.h"
+#include "TTree.h"
+#include "TH1.h"
+#include "TROOT.h" // ROOT::EnableThreadSafety()
+
+// C/C++ libraries
+#include <memory> // std::unique_ptr
+#include <unordered_set>
+#include <algorithm> // std::min(), std::max()
+#include <cstdio> // std::remove()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Results of the merge of a single group of files.
+  struct MergeStepResult {
+    std::size_t nOpened = 0U; ///< Number of input files opened.
+    std::size_t nMerged = 0U; ///< Number of objects merged.
+    std::size_t nUnmergeable = 0U; ///< Objects copied from their first file.
+    std::vector<std::string> skipped; ///< Objects left out.
+    std::vector<std::string> errors; ///< Problems met.
+  }; // MergeStepResult
+
+
+  /// Reads the object of `key`, not owned by any directory.
+  std::unique_ptr<TObject> readObject(TKey& key) {
+    std::unique_ptr<TObject> obj { key.ReadObj() };
+    if (auto* const hist = dynamic_cast<TH1*>(obj.get()))
+      hist->SetDirectory(nullptr);
+    return obj;
+  } // readObject()
+
+
+  /// Returns the names of the keys in all `dirs`, in order of appearance.
+  std::vector<std::string> keyNames(std::vector<TDirectory*> const& dirs) {
+    std::vector<std::string> names;
+    std::unordered_set<std::string> seen;
+    for (TDirectory* dir: dirs) {
+      for (TObject* key: *(dir->GetListOfKeys())) {
+        std::string name = key->GetName();
+        if (seen.insert(name).second) names.push_back(std::move(name));
+      }
+    } // for
+    return names;
+  } // keyNames()
+
+
+  /// Merges the content of all `inputs` directories into `output`.
+  void mergeDirectory(
+    std::vector<TDirectory*> const& inputs, TDirectory& output,
+    std::string const& path, MergeStepResult& result
+  ) {
+
+    /*
+     * Each name is handled across all the inputs before moving to the next
+     * one, so that only one object (and its merge partner) is in memory.
+     * `TDirectory::GetKey()` returns the highest cycle of each name.
+     */
+    for (std::string const& name: keyNames(inputs)) {
+
+      std::string const objPath = path + name;
+
+      std::vector<TDirectory*> owners;
+      std::vector<TKey*> keys;
+      for (TDirectory* dir: inputs) {
+        TKey* const key = dir->GetKey(name.c_str());
+        if (!key) continue;
+        owners.push_back(dir);
+        keys.push_back(key);
+      } // for
+
+      TKey& firstKey = *(keys.front());
+      TClass* const objClass = TClass::GetClass(firstKey.GetClassName());
+      if (!objClass) {
+        result.errors.push_back(objPath + ": unknown class '"
+          + firstKey.GetClassName() + "'");
+        continue;
+      }
+
+      // directories: merged recursively
+      if (objClass->InheritsFrom(TDirectory::Class())) {
+        std::vector<TDirectory*> subdirs;
+        for (TDirectory* dir: owners) {
+          if (TDirectory* const subdir = dir->GetDirectory(name.c_str()))
+            subdirs.push_back(subdir);
+        }
+        TDirectory* const outputSubdir
+          = output.mkdir(name.c_str(), firstKey.GetTitle());
+        if (!outputSubdir) {
+          result.errors.push_back(objPath + ": can't create the directory");
+          continue;
+        }
+        mergeDirectory(subdirs, *outputSubdir, objPath + "/", result);
+        continue;
+      }
+
+      // trees would need their baskets copied too
+      if (objClass->InheritsFrom(TTree::Class())) {
+        result.skipped.push_back(objPath);
+        continue;
+      }
+
+      std::unique_ptr<TObject> merged = readObject(firstKey);
+      if (!merged) {
+        result.errors.push_back(objPath + ": can't read the object");
+        continue;
+      }
+
+      if (keys.size() > 1U) {
+        ROOT::MergeFunc_t const merge = objClass->GetMerge();
+        if (merge) {
+          for (std::size_t iKey = 1U; iKey < keys.size(); ++iKey) {
+            std::unique_ptr<TObject> other = readObject(*(keys[iKey]));
+            if (!other) {
+              result.errors.push_back(objPath + ": can't read the object from '"
+                + std::string{ owners[iKey]->GetFile()->GetName() } + "'");
+              continue;
+            }
+            TList others; // does not own the objects
+            others.Add(other.get());
+            merge(merged.get(), &others, nullptr);
+          } // for
+          ++result.nMerged;
+        }
+        else ++result.nUnmergeable;
+      } // if many
+
+      output.WriteTObject(merged.get(), name.c_str());
+
+    } // for names
+
+  } // mergeDirectory()
+
+
+  /// Merges all the `inputPaths` files into a new `outputPath` file.
+  MergeStepResult mergeFiles(
+    std::vector<std::string>::const_iterator begin,
+    std::vector<std::string>::const_iterator end,
+    std::string const& outputPath
+  ) {
+    MergeStepResult result;
+
+    std::vector<std::unique_ptr<TFile>> inputFiles;
+    std::vector<TDirectory*> inputs;
+    for (auto it = begin; it != end; ++it) {
+      std::unique_ptr<TFile> file { TFile::Open(it->c_str(), "READ") };
+      if (!file || file->IsZombie()) {
+        result.errors.push_back("can't open '" + *it + "'");
+        continue;
+      }
+      inputs.push_back(file.get());
+      inputFiles.push_back(std::move(file));
+    } // for
+    result.nOpened = inputFiles.size();
+
+    std::unique_ptr<TFile> outputFile
+      { TFile::Open(outputPath.c_str(), "RECREATE") };
+    if (!outputFile || outputFile->IsZombie()) {
+      result.errors.push_back("can't create '" + outputPath + "'");
+      return result;
+    }
+
+    if (!inputs.empty()) mergeDirectory(inputs, *outputFile, "", result);
+
+    outputFile->Close();
+    return result;
+  } // mergeFiles()
+
+
+  /// Returns the directory part of `path` (`"."` if none).
+  std::string directoryOf(std::string const& path) {
+    std::size_t const iSep = path.rfind('/');
+    if (iSep == std::string::npos) return ".";
+    return (iSep == 0)? "/": path.substr(0, iSep);
+  } // directoryOf()
+
+
+  /// Returns the file name part of `path`.
+  std::string fileNameOf(std::string const& path) {
+    std::size_t const iSep = path.rfind('/');
+    return (iSep == std::string::npos)? path: path.substr(iSep + 1);
+  } // fileNameOf()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+PlotMergeResult mergePlotFiles(
+  std::vector<std::string> const& inputPaths, std::string const& outputPath,
+  PlotMergeOptions const& options /* = {} */
+) {
+
+  PlotMergeResult result;
+  if (inputPaths.empty()) {
+    result.errors.push_back("no input file to merge");
+    return result;
+  }
+
+  std::size_t const fanIn = std::max(options.fanIn, 2U);
+  unsigned int const nThreads = std::max(options.nThreads, 1U);
+  std::string const tempPrefix
+    = (options.tempDir.empty()? directoryOf(outputPath): options.tempDir)
+    + "/" + fileNameOf(outputPath) + ".merge";
+
+  if (nThreads > 1U) ROOT::EnableThreadSafety();
+
+  // merged histograms are managed here, not by the directories they come from
+  bool const addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+
+  /*
+   * Tree reduction: at each level, files are merged in groups of `fanIn`;
+   * the last level has a single group, merged directly into the output.
+   */
+  std::vector<std::string> level = inputPaths;
+  bool temporary = false; // whether the files of this level are intermediate
+  for (unsigned int iLevel = 0U; ; ++iLevel) {
+
+    bool const lastLevel = (level.size() <= fanIn);
+    std::size_t const nGroups = (level.size() + fanIn - 1) / fanIn;
+
+    std::vector<std::string> next(nGroups);
+    for (std::size_t iGroup = 0; iGroup < nGroups; ++iGroup) {
+      next[iGroup] = lastLevel? outputPath: (tempPrefix
+        + "-L" + std::to_string(iLevel) + "-" + std::to_string(iGroup)
+        + ".root");
+    } // for
+
+    std::vector<MergeStepResult> stepResults(nGroups);
+    icarus::ns::util::runConcurrently(nGroups, nThreads,
+      [&](std::size_t iGroup)
+      {
+        auto const begin = level.cbegin() + iGroup * fanIn;
+        auto const end
+          = level.cbegin() + std::min((iGroup + 1) * fanIn, level.size());
+        stepResults[iGroup] = mergeFiles(begin, end, next[iGroup]);
+        if (temporary && !options.keepTemporaryFiles)
+          for (auto it = begin; it != end; ++it) std::remove(it->c_str());
+      });
+
+    for (MergeStepResult& stepResult: stepResults) {
+      if (iLevel == 0U) result.nInputFiles += stepResult.nOpened;
+      result.nMerged += stepResult.nMerged;
+      result.nUnmergeable += stepResult.nUnmergeable;
+      for (std::string& skipped: stepResult.skipped)
+        result.skipped.push_back(std::move(skipped));
+      for (std::string& error: stepResult.errors)
+        result.errors.push_back(std::move(error));
+    } // for
+    result.nMergeSteps += nGroups;
+
+    if (lastLevel) break;
+    level = std::move(next);
+    temporary = true;
+  } // for levels
+
+  TH1::AddDirectory(addDirectory);
+
+  return result;
+} // mergePlotFiles()
+
+
+// -----------------------------------------------------------------------------
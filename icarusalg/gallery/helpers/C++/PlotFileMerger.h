@@ -0,0 +1,102 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/PlotFileMerger.h
+ * @brief  Parallel merging of ROOT files with plot directory trees.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/PlotFileMerger.cxx
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_PLOTFILEMERGER_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_PLOTFILEMERGER_H
+
+// C/C++ libraries
+#include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+/// Settings of `mergePlotFiles()`.
+struct PlotMergeOptions {
+
+  /// Number of merges to run at the same time.
+  unsigned int nThreads = 1U;
+
+  /// Number of files merged together at each step of the reduction.
+  unsigned int fanIn = 8U;
+
+  /// Directory for the intermediate files (empty: same as the output file).
+  std::string tempDir;
+
+  /// Whether to keep the intermediate files (for debugging).
+  bool keepTemporaryFiles = false;
+
+}; // PlotMergeOptions
+
+
+/// Summary of the result of `mergePlotFiles()`.
+struct PlotMergeResult {
+
+  std::size_t nInputFiles = 0U; ///< Number of input files successfully read.
+
+  std::size_t nMergeSteps = 0U; ///< Number of file merges performed.
+
+  std::size_t nMerged = 0U; ///< Number of merges of objects from many files.
+
+  std::size_t nUnmergeable = 0U; ///< Objects kept from their first file.
+
+  std::vector<std::string> skipped; ///< Objects not copied (e.g. trees).
+
+  std::vector<std::string> errors; ///< Problems met (e.g. unreadable files).
+
+  /// Returns whether the merge completed with no error.
+  bool valid() const { return errors.empty(); }
+
+}; // PlotMergeResult
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Merges ROOT files with histograms in directory trees into one file.
+ * @param inputPaths the files to be merged
+ * @param outputPath the file to be created with the merged content
+ * @param options merge settings
+ * @return a summary of the merge
+ *
+ * This function merges the output of many jobs (or shards of a job) filling
+ * the same plots, typically organized in `icarus::ns::util::PlotSandbox`
+ * directories, or in per-event directories like the `R<run>E<event>` ones
+ * from `DrawPMTwaveforms`.
+ *
+ * The directory structure of the output is the union of the ones of the
+ * input files. Each object found in more than one file with the same path is
+ * merged with the `Merge()` method of its class (`TClass::GetMerge()`):
+ * histograms of all dimensions and profiles are summed, and the same
+ * happens to any other mergeable object (e.g. `TParameter` summaries).
+ * Objects which can't be merged (e.g. canvases) are taken from the first
+ * file they are found in. Objects present in a single file (like per-event
+ * directories) are just copied. Trees are not supported: they are left out
+ * and listed in `PlotMergeResult::skipped`.
+ *
+ * The merge is a parallel tree reduction: files are merged in groups of
+ * `options.fanIn` into intermediate files, which are then merged again in
+ * groups, until the last group is merged into the output file. The groups of
+ * each level are merged concurrently by `options.nThreads` threads, and
+ * intermediate files are removed as soon as they are merged.
+ * Each merge keeps all the files of its group open, but reads and writes one
+ * object at a time: the memory needed does not depend on the size of the
+ * files.
+ *
+ * Input files which can't be opened are skipped, and reported in
+ * `PlotMergeResult::errors`.
+ * With more than one thread, ROOT thread safety is enabled.
+ */
+PlotMergeResult mergePlotFiles(
+  std::vector<std::string> const& inputPaths, std::string const& outputPath,
+  PlotMergeOptions const& options = {}
+  );
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_PLOTFILEMERGER_H
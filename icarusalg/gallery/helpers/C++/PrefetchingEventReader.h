@@ -0,0 +1,316 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/PrefetchingEventReader.h
+ * @brief  Reads a fixed set of data products ahead of their use.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/ParallelEventLoop.h
+ *
+ * This library is header only, and it requires linking to `gallery` and ROOT.
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_PREFETCHINGEVENTREADER_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_PREFETCHINGEVENTREADER_H
+
+// framework libraries
+#include "gallery/Event.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Utilities/InputTag.h"
+
+// ROOT
+#include "TROOT.h" // ROOT::EnableThreadSafety(), ROOT::EnableImplicitMT()
+
+// C/C++ libraries
+#include <array>
+#include <tuple>
+#include <deque>
+#include <vector>
+#include <string>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <exception> // std::exception_ptr, std::current_exception()
+#include <type_traits> // std::is_same_v
+#include <utility> // std::index_sequence_for, std::move()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Event loop reading a fixed list of data products in background.
+ * @tparam Products types of all the data products to be read
+ *
+ * This object replaces a `gallery::Event` loop where the same data products
+ * are read in every event. All the products are declared at construction
+ * (their types as template arguments, their input tags as constructor
+ * arguments). A background thread reads the products of the next events
+ * (up to `readAhead` of them) while the current event is analysed, so that
+ * reading and decompressing data from the ROOT files happens away from the
+ * critical path of the analysis.
+ * The products of each event are copied from the `gallery::Event` into this
+ * object, and they stay valid until `next()` is called.
+ *
+ * The time spent waiting for the data of the next event is accumulated and
+ * reported by `waitTime()`: if this is a large fraction of the total time,
+ * the analysis is limited by input.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * using Reader_t = PrefetchingEventReader
+ *   <std::vector<recob::Track>, std::vector<recob::Hit>>;
+ *
+ * Reader_t event{ allInputFiles, { trackTag, hitsTag } };
+ * for (; !event.atEnd(); event.next()) {
+ *   trackAnalysis.processTracks(event.getProduct<0>());
+ *   hitAnalysisAlg.fillHistograms(event.getProduct<std::vector<recob::Hit>>());
+ * }
+ * std::cout << "Waited " << event.waitTime().count() << " s for input over "
+ *   << event.nEvents() << " events." << std::endl;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * ROOT thread safety is enabled on construction (`ROOT::EnableThreadSafety()`)
+ * since ROOT is used by two threads at the same time. If `implicitMTthreads`
+ * is not `0`, ROOT implicit multi-threading is also enabled with that many
+ * threads, which parallelises the decompression of the branches of each
+ * event. The `gallery::Event` reading the files uses its own `TTreeCache`.
+ *
+ * Exceptions thrown while reading an event are rethrown by `next()` (or the
+ * constructor) when that event is reached.
+ */
+template <typename... Products>
+class PrefetchingEventReader {
+
+    public:
+
+  /// Type of list of the tags of all the products, in the declared order.
+  using Tags_t = std::array<art::InputTag, sizeof...(Products)>;
+
+  /// Type of duration used to report time.
+  using Duration_t = std::chrono::duration<double>;
+
+
+  /**
+   * @brief Constructor: starts reading, and waits for the first event.
+   * @param inputFiles list of the paths of all the ROOT files to read
+   * @param tags input tag of each of the products
+   * @param readAhead (default: `1`) number of events read in advance
+   * @param implicitMTthreads (default: `0`) threads for ROOT implicit MT
+   */
+  PrefetchingEventReader(
+    std::vector<std::string> inputFiles, Tags_t tags,
+    unsigned int readAhead = 1U, unsigned int implicitMTthreads = 0U
+    );
+
+  /// Destructor: stops reading and waits for the background thread.
+  ~PrefetchingEventReader();
+
+  // the background thread holds a pointer to this object
+  PrefetchingEventReader(PrefetchingEventReader const&) = delete;
+  PrefetchingEventReader& operator= (PrefetchingEventReader const&) = delete;
+
+
+  // --- BEGIN -- Iteration ----------------------------------------------------
+  /// @name Iteration
+  /// @{
+
+  /// Returns whether all the events have been read.
+  bool atEnd() const { return !fCurrent.has_value(); }
+
+  /// Moves to the next event, waiting for it if it is not read yet.
+  void next() { advance(); }
+
+  /// @}
+  // --- END ---- Iteration ----------------------------------------------------
+
+
+  // --- BEGIN -- Current event ------------------------------------------------
+  /// @name Current event
+  /// @{
+
+  /// Returns the `I`-th declared data product for the current event.
+  template <std::size_t I>
+  decltype(auto) getProduct() const { return std::get<I>(fCurrent->products); }
+
+  /// Returns the data product of type `T` (must be declared only once).
+  template <typename T>
+  T const& getProduct() const { return std::get<T>(fCurrent->products); }
+
+  /// Returns the auxiliary information (run, event number...).
+  art::EventAuxiliary const& eventAuxiliary() const { return fCurrent->aux; }
+
+  /// Returns the number of the current entry in its file.
+  long long int fileEntry() const { return fCurrent->fileEntry; }
+
+  /// Returns the number of the current entry in the event tree of its file.
+  long long int eventEntry() const { return fCurrent->eventEntry; }
+
+  /// @}
+  // --- END ---- Current event ------------------------------------------------
+
+
+  // --- BEGIN -- Statistics ---------------------------------------------------
+  /// @name Statistics
+  /// @{
+
+  /// Returns the total time spent waiting for data to be read.
+  Duration_t waitTime() const { return fWaitTime; }
+
+  /// Returns the number of events made current so far.
+  unsigned long int nEvents() const { return fNEvents; }
+
+  /// @}
+  // --- END ---- Statistics ---------------------------------------------------
+
+
+    private:
+
+  /// All the data read for one event.
+  struct EventData_t {
+    std::tuple<Products...> products; ///< Copies of all the products.
+    art::EventAuxiliary aux; ///< Event auxiliary information.
+    long long int fileEntry; ///< Entry in the file.
+    long long int eventEntry; ///< Entry in the event tree.
+  }; // EventData_t
+
+
+  // --- BEGIN -- Configuration ------------------------------------------------
+  std::vector<std::string> const fInputFiles; ///< Files to be read.
+  Tags_t const fTags; ///< Tags of the products.
+  std::size_t const fReadAhead; ///< Maximum number of events in queue.
+  // --- END ---- Configuration ------------------------------------------------
+
+  // --- BEGIN -- Shared with the reading thread (protected by `fLock`) --------
+  std::mutex fLock; ///< Protects the queue and the state.
+  std::condition_variable fDataAvailable; ///< Signals data in the queue.
+  std::condition_variable fSpaceAvailable; ///< Signals space in the queue.
+  std::deque<EventData_t> fQueue; ///< Events read and not yet used.
+  std::exception_ptr fError; ///< Error from the reading thread.
+  bool fDone = false; ///< Whether the reading thread has finished.
+  bool fStop = false; ///< Whether the reading thread should stop.
+  // --- END ---- Shared with the reading thread -------------------------------
+
+  std::optional<EventData_t> fCurrent; ///< Data of the current event.
+
+  Duration_t fWaitTime { 0.0 }; ///< Total time waited for data.
+  unsigned long int fNEvents = 0; ///< Number of events made current.
+
+  std::thread fReader; ///< The background reading thread.
+
+
+  /// Moves the next event from the queue to current, waiting if needed.
+  void advance();
+
+  /// Reads all the events into the queue (in the background thread).
+  void readEvents();
+
+  /// Returns copies of all the products from `event`.
+  template <std::size_t... I>
+  std::tuple<Products...> readProducts
+    (gallery::Event const& event, std::index_sequence<I...>) const
+    { return { *(event.getValidHandle<Products>(fTags[I]))... }; }
+
+}; // PrefetchingEventReader
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename... Products>
+PrefetchingEventReader<Products...>::PrefetchingEventReader(
+  std::vector<std::string> inputFiles, Tags_t tags,
+  unsigned int readAhead /* = 1U */, unsigned int implicitMTthreads /* = 0U */
+)
+  : fInputFiles{ std::move(inputFiles) }
+  , fTags{ std::move(tags) }
+  , fReadAhead{ (readAhead > 0U)? readAhead: 1U }
+{
+  ROOT::EnableThreadSafety();
+  if (implicitMTthreads > 0U) ROOT::EnableImplicitMT(implicitMTthreads);
+
+  fReader = std::thread{ &PrefetchingEventReader::readEvents, this };
+  advance();
+} // PrefetchingEventReader<>::PrefetchingEventReader()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Products>
+PrefetchingEventReader<Products...>::~PrefetchingEventReader() {
+
+  {
+    std::lock_guard lock { fLock };
+    fStop = true;
+  }
+  fSpaceAvailable.notify_all();
+  if (fReader.joinable()) fReader.join();
+
+} // PrefetchingEventReader<>::~PrefetchingEventReader()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Products>
+void PrefetchingEventReader<Products...>::advance() {
+
+  fCurrent.reset(); // release the memory of the previous event first
+
+  auto const start = std::chrono::steady_clock::now();
+  std::unique_lock lock { fLock };
+  fDataAvailable.wait(lock, [this](){ return !fQueue.empty() || fDone; });
+  fWaitTime += std::chrono::steady_clock::now() - start;
+
+  if (fQueue.empty()) { // no more events
+    if (fError) std::rethrow_exception(std::exchange(fError, nullptr));
+    return;
+  }
+
+  fCurrent.emplace(std::move(fQueue.front()));
+  fQueue.pop_front();
+  ++fNEvents;
+  lock.unlock();
+  fSpaceAvailable.notify_one();
+
+} // PrefetchingEventReader<>::advance()
+
+
+// -----------------------------------------------------------------------------
+template <typename... Products>
+void PrefetchingEventReader<Products...>::readEvents() {
+
+  try {
+    for (gallery::Event event(fInputFiles); !event.atEnd(); event.next()) {
+
+      EventData_t data {
+        readProducts(event, std::index_sequence_for<Products...>{}),
+        event.eventAuxiliary(),
+        event.fileEntry(),
+        event.eventEntry()
+        };
+
+      std::unique_lock lock { fLock };
+      fSpaceAvailable.wait
+        (lock, [this](){ return fStop || (fQueue.size() < fReadAhead); });
+      if (fStop) break;
+      fQueue.push_back(std::move(data));
+      lock.unlock();
+      fDataAvailable.notify_one();
+
+    } // for
+  }
+  catch (...) {
+    std::lock_guard lock { fLock };
+    fError = std::current_exception();
+  }
+
+  {
+    std::lock_guard lock { fLock };
+    fDone = true;
+  }
+  fDataAvailable.notify_all();
+
+} // PrefetchingEventReader<>::readEvents()
+
+
+// -----------------------------------------------------------------------------
+
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_PREFETCHINGEVENTREADER_H
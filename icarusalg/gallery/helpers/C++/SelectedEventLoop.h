@@ -0,0 +1,59 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/SelectedEventLoop.h
+ * @brief  Event loop visiting only selected entries of the input files.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/EventIndex.h
+ *
+ * This library is header only, and it requires linking to `gallery`.
+ */
+
+#ifndef ICARUSALG_GALLERY_HELPERS_Cxx_SELECTEDEVENTLOOP_H
+#define ICARUSALG_GALLERY_HELPERS_Cxx_SELECTEDEVENTLOOP_H
+
+// library header
+#include "icarusalg/gallery/helpers/C++/InputFileManifest.h" // FileEntries
+
+// framework libraries
+#include "gallery/Event.h"
+
+// C/C++ libraries
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Calls `processEvent(event)` on each of the selected events.
+ * @tparam ProcessEvent type of callable processing a `gallery::Event`
+ * @param selection the files and entries to be processed
+ * @param processEvent callable object called on each selected event
+ * @return the number of processed events
+ * @see `EventIndex::select()`, `selectEntryRange()`
+ * 
+ * Only the files in `selection` are opened, one at a time, and in each of
+ * them the `gallery::Event` jumps directly to each selected entry
+ * (`gallery::Event::goToEntry()`), without reading the other events.
+ * The entries in each file are expected to be sorted.
+ */
+template <typename ProcessEvent>
+unsigned long int forEachSelectedEvent
+  (std::vector<FileEntries> const& selection, ProcessEvent&& processEvent)
+{
+  unsigned long int nEvents = 0;
+  for (FileEntries const& file: selection) {
+    if (file.entries.empty()) continue;
+    
+    gallery::Event event({ file.path });
+    for (long long int const entry: file.entries) {
+      event.goToEntry(entry);
+      processEvent(static_cast<gallery::Event const&>(event));
+      ++nEvents;
+    } // for entries
+  } // for files
+  return nEvents;
+} // forEachSelectedEvent()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_GALLERY_HELPERS_Cxx_SELECTEDEVENTLOOP_H
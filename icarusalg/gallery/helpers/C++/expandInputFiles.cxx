@@ -14,8 +14,15 @@
 // library header
 #include "expandInputFiles.h"
 
+// ICARUS libraries
+#include "icarusalg/Utilities/runConcurrently.h"
+
 // C/C++ libraries
 #include <fstream>
+#include <map>
+#include <algorithm> // std::find(), std::max()
+#include <exception> // std::exception_ptr, std::rethrow_exception()
+#include <utility> // std::move()
 #include <cctype> // std::isspace()
 #include <stdexcept> // std::runtime_error
 
@@ -86,65 +93,224 @@ inline bool isROOTfile(std::string const& filePath) {
 
 
 // -----------------------------------------------------------------------------
+namespace details {
+  
+  /// A path from a file list, and the line it was found at.
+  struct FileListEntry {
+    std::string path;
+    unsigned int line;
+  };
+  
+  
+  /// Returns all the paths in the file list `listPath`, without expanding.
 #if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
-inline
+  inline
 #endif
-std::vector<std::string> expandFileList(std::string const& listPath) {
+  std::vector<FileListEntry> readFileList(std::string const& listPath) {
+    
+    std::ifstream list(listPath);
+    if (!list) throw details::FileNotFoundError(listPath);
+    
+    std::vector<FileListEntry> entries;
+    std::string line;
+    unsigned int iLine = 0;
+    do {
+      ++iLine;
+      std::getline(list, line);
+      if (!list) break;
+      
+      auto const end = line.cend();
+      
+      //
+      // find the start of the file name
+      //
+      auto i = details::skipSpaces(line.cbegin(), end);
+      if (i == end) continue; // empty line
+      if (*i == '#') continue; // full comment line
+      
+      std::string filePath;
+      auto iChunk = i;
+      while(i != end) {
+        if (*i == '\\') {
+          filePath.append(iChunk, i); iChunk = i;
+          if (++i == end) break; // weird way to end a line, with a '\'
+          if ((*i == '\\') || (*i == '#')) iChunk = i; // eat the backspace
+          // the rest will be added with the next chuck
+        }
+        else if (std::isspace(*i)) {
+          filePath.append(iChunk, i); iChunk = i; // before, there were no spaces
+          auto const iAfter = details::skipSpaces(i, end);
+          if (iAfter == end) break; // spaces, then end of line: we are done
+          if (*iAfter == '#') break; // a comment starts after spaces: we are done
+          i = iAfter; // these spaces are part of file name; schedule for writing
+          continue;
+        }
+        ++i;
+      } // for
+      filePath.append(iChunk, i);
+      if (filePath.empty()) continue;
+      
+      entries.push_back({ std::move(filePath), iLine });
+      
+    } while (true);
+    return entries;
+  } // readFileList()
   
-  std::ifstream list(listPath);
-  if (!list) throw details::FileNotFoundError(listPath);
   
-  std::vector<std::string> files;
-  std::string line;
-  unsigned int iLine = 0;
-  do {
-    ++iLine; // currently unused
-    std::getline(list, line);
-    if (!list) break;
-    
-    auto const end = line.cend();
-    
-    //
-    // find the start of the file name
-    //
-    auto i = details::skipSpaces(line.cbegin(), end);
-    if (i == end) continue; // empty line
-    if (*i == '#') continue; // full comment line
-    
-    std::string filePath;
-    auto iChunk = i;
-    while(i != end) {
-      if (*i == '\\') {
-        filePath.append(iChunk, i); iChunk = i;
-        if (++i == end) break; // weird way to end a line, with a '\'
-        if ((*i == '\\') || (*i == '#')) iChunk = i; // eat the backspace
-        // the rest will be added with the next chuck
-      }
-      else if (std::isspace(*i)) {
-        filePath.append(iChunk, i); iChunk = i; // before, there were no spaces
-        auto const iAfter = details::skipSpaces(i, end);
-        if (iAfter == end) break; // spaces, then end of line: we are done
-        if (*iAfter == '#') break; // a comment starts after spaces: we are done
-        i = iAfter; // these spaces are part of file name; schedule for writing
+  /// Throws an exception if `listPath` is among its `parents`.
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+  inline
+#endif
+  void checkNotIncluded
+    (std::string const& listPath, std::vector<std::string> const& parents)
+  {
+    if (std::find(parents.begin(), parents.end(), listPath) != parents.end()) {
+      throw FileListExpansionBaseError
+        ("File list '" + listPath + "' includes itself");
+    }
+  } // checkNotIncluded()
+  
+  
+  /// Appends to `files` the ROOT files from `listPath` (and nested lists).
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+  inline
+#endif
+  void expandFileList(
+    std::vector<std::string>& files, std::string const& listPath,
+    std::vector<std::string>& parents
+  ) {
+    
+    checkNotIncluded(listPath, parents);
+    
+    std::vector<FileListEntry> const entries = readFileList(listPath);
+    
+    parents.push_back(listPath);
+    for (FileListEntry const& entry: entries) {
+      if (isROOTfile(entry.path)) {
+        files.push_back(entry.path);
         continue;
       }
-      ++i;
+      try {
+        expandFileList(files, entry.path, parents);
+      }
+      catch(FileListExpansionBaseError const& e) {
+        throw FileListErrorWrapper(listPath, entry.line, e);
+      }
     } // for
-    filePath.append(iChunk, i);
-    if (filePath.empty()) continue;
+    parents.pop_back();
+    
+  } // expandFileList()
+  
+  
+  /// Content of the file lists, read in parallel, one nesting level at a time.
+  class FileListCache {
+    
+      public:
+    FileListCache(std::vector<std::string> const& paths, unsigned int nThreads)
+      { readAll(paths, nThreads); }
+    
+    /// Appends to `files` the ROOT files from `listPath` (and nested lists).
+    void expand(
+      std::vector<std::string>& files, std::string const& listPath,
+      std::vector<std::string>& parents
+      ) const;
+    
+      private:
+    
+    /// Content of a list, or the error reading it.
+    struct ListContent_t {
+      std::vector<FileListEntry> entries;
+      std::exception_ptr error;
+    };
+    
+    std::map<std::string, ListContent_t> fLists;
+    
+    void readAll(std::vector<std::string> const& paths, unsigned int nThreads);
+    
+  }; // FileListCache
+  
+  
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+  inline
+#endif
+  void FileListCache::readAll
+    (std::vector<std::string> const& paths, unsigned int nThreads)
+  {
+    // each list is read once, even if it appears many times
+    std::vector<std::string> toRead;
+    auto const schedule = [this,&toRead](std::string const& path)
+      {
+        if (isROOTfile(path) || fLists.count(path)) return;
+        fLists[path]; // reserve the entry
+        toRead.push_back(path);
+      };
     
-    if (isROOTfile(filePath))
-      files.push_back(filePath);
-    else {
+    for (std::string const& path: paths) schedule(path);
+    while (!toRead.empty()) {
+      std::vector<ListContent_t> contents(toRead.size());
+      icarus::ns::util::runConcurrently(
+        toRead.size(), std::max(nThreads, 1U),
+        [&toRead,&contents](std::size_t i)
+        {
+          try { contents[i].entries = readFileList(toRead[i]); }
+          catch (...) { contents[i].error = std::current_exception(); }
+        });
+      
+      std::vector<std::string> const justRead = std::move(toRead);
+      toRead.clear();
+      for (std::size_t i = 0; i < justRead.size(); ++i) {
+        ListContent_t& content = fLists[justRead[i]];
+        content = std::move(contents[i]);
+        for (FileListEntry const& entry: content.entries) schedule(entry.path);
+      } // for
+    } // while
+    
+  } // FileListCache::readAll()
+  
+  
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+  inline
+#endif
+  void FileListCache::expand(
+    std::vector<std::string>& files, std::string const& listPath,
+    std::vector<std::string>& parents
+  ) const {
+    
+    checkNotIncluded(listPath, parents);
+    
+    ListContent_t const& content = fLists.at(listPath);
+    if (content.error) std::rethrow_exception(content.error);
+    
+    parents.push_back(listPath);
+    for (FileListEntry const& entry: content.entries) {
+      if (isROOTfile(entry.path)) {
+        files.push_back(entry.path);
+        continue;
+      }
       try {
-        details::appendToVector(files, expandFileList(filePath));
+        expand(files, entry.path, parents);
       }
-      catch(details::FileListExpansionBaseError const& e) {
-        throw details::FileListErrorWrapper(listPath, iLine, e);
+      catch(FileListExpansionBaseError const& e) {
+        throw FileListErrorWrapper(listPath, entry.line, e);
       }
-    }
+    } // for
+    parents.pop_back();
     
-  } while (true);
+  } // FileListCache::expand()
+  
+  
+} // namespace details
+
+
+// -----------------------------------------------------------------------------
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+inline
+#endif
+std::vector<std::string> expandFileList(std::string const& listPath) {
+  
+  std::vector<std::string> files;
+  std::vector<std::string> parents;
+  details::expandFileList(files, listPath, parents);
   return files;
 } // expandFileList()
 
@@ -167,4 +333,49 @@ std::vector<std::string> expandInputFiles
 } // expandInputFiles()
 
 
+// -----------------------------------------------------------------------------
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+inline
+#endif
+std::vector<std::string> expandInputFiles
+  (std::vector<std::string> const& filePaths, unsigned int nThreads)
+{
+  details::FileListCache const lists { filePaths, nThreads };
+  
+  std::vector<std::string> expanded;
+  std::vector<std::string> parents;
+  for (std::string const& path: filePaths) {
+    if (isROOTfile(path))
+      expanded.push_back(path);
+    else 
+      lists.expand(expanded, path, parents);
+  } // for
+  return expanded;
+} // expandInputFiles(nThreads)
+
+
+// -----------------------------------------------------------------------------
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+inline
+#endif
+std::vector<std::vector<std::string>> shardInputFiles
+  (std::vector<std::string> const& filePaths, unsigned int nShards)
+{
+  // no empty shard: at least one file per shard
+  std::size_t const nFiles = filePaths.size();
+  if (nShards == 0) nShards = 1;
+  if (nShards > nFiles) nShards = nFiles;
+  
+  std::vector<std::vector<std::string>> shards(nShards);
+  auto iFile = filePaths.begin();
+  for (std::size_t iShard = 0; iShard < nShards; ++iShard) {
+    // the first (nFiles % nShards) shards get one extra file
+    std::size_t const n = nFiles / nShards + ((iShard < nFiles % nShards)? 1: 0);
+    shards[iShard].assign(iFile, iFile + n);
+    iFile += n;
+  } // for
+  return shards;
+} // shardInputFiles()
+
+
 // -----------------------------------------------------------------------------
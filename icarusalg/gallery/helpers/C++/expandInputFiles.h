@@ -43,6 +43,7 @@ bool isROOTfile(std::string const& filePath);
 
 // -----------------------------------------------------------------------------
 /// Expands the content of a file list into a vector of file paths (recursive).
+/// A list including itself (also indirectly) is an error.
 #if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
 inline
 #endif
@@ -56,6 +57,32 @@ inline
 std::vector<std::string> expandInputFiles
   (std::vector<std::string> const& filePaths);
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief Expands all input files into a vector of file paths, in parallel.
+ * @param filePaths the paths of ROOT files and file lists
+ * @param nThreads number of file lists to read at the same time
+ * @return the paths of all the ROOT files, in the same order as
+ *         `expandInputFiles(filePaths)`
+ * 
+ * The file lists are read concurrently, one level of nesting at a time, and
+ * each list is read only once, even if it appears in many places.
+ * A list including itself (also indirectly) is an error.
+ */
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+inline
+#endif
+std::vector<std::string> expandInputFiles
+  (std::vector<std::string> const& filePaths, unsigned int nThreads);
+
+// -----------------------------------------------------------------------------
+/// Splits `filePaths` in up to `nShards` contiguous lists of similar size.
+#if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
+inline
+#endif
+std::vector<std::vector<std::string>> shardInputFiles
+  (std::vector<std::string> const& filePaths, unsigned int nShards);
+
 
 // -----------------------------------------------------------------------------
 #if ICARUSALG_GALLERY_HELPERS_Cxx_EXPANDINPUTFILES_INLINE_IMPLEMENTATION
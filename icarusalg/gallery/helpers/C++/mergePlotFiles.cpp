@@ -0,0 +1,91 @@
+/**
+ * @file   icarusalg/gallery/helpers/C++/mergePlotFiles.cpp
+ * @brief  Merges ROOT files with plot directory trees, in parallel.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date   October 15, 2026
+ * @see    icarusalg/gallery/helpers/C++/PlotFileMerger.h
+ *
+ * Usage:
+ *
+ *     mergePlotFiles [options] OutputFile InputFile [InputFile ...]
+ *
+ * Options:
+ * * `-j N`: number of merges to run at the same time (default: 1)
+ * * `--fanin N`: number of files merged together at each step (default: 8)
+ * * `--tempdir DIR`: where to write the intermediate files (default: same
+ *   directory as `OutputFile`)
+ * * `--keep`: do not remove the intermediate files
+ *
+ * Input files may also be file lists, which are expanded with
+ * `expandInputFiles()`. The exit code is non-zero if any error occurred.
+ */
+
+// ICARUS libraries
+#include "icarusalg/gallery/helpers/C++/PlotFileMerger.h"
+#include "icarusalg/gallery/helpers/C++/expandInputFiles.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept> // std::exception
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  PlotMergeOptions options;
+  std::vector<std::string> paths;
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    std::string const arg = argv[iArg];
+    bool const hasValue = (iArg + 1 < argc);
+    if ((arg == "-j") && hasValue) options.nThreads = std::atoi(argv[++iArg]);
+    else if ((arg == "--fanin") && hasValue)
+      options.fanIn = std::atoi(argv[++iArg]);
+    else if ((arg == "--tempdir") && hasValue) options.tempDir = argv[++iArg];
+    else if (arg == "--keep") options.keepTemporaryFiles = true;
+    else paths.push_back(arg);
+  } // for
+
+  if (paths.size() < 2U) {
+    std::cerr << "Usage:  " << argv[0]
+      << "  [-j N] [--fanin N] [--tempdir DIR] [--keep]"
+         "  OutputFile InputFile [InputFile ...]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const outputPath = paths.front();
+  std::vector<std::string> inputPaths;
+  try {
+    inputPaths = expandInputFiles
+      (std::vector<std::string>{ paths.begin() + 1, paths.end() });
+  }
+  catch (std::exception const& e) {
+    std::cerr << "Error expanding the input files:\n" << e.what() << std::endl;
+    return 1;
+  }
+
+  PlotMergeResult const result
+    = mergePlotFiles(inputPaths, outputPath, options);
+
+  std::cout << "Merged " << result.nInputFiles << "/" << inputPaths.size()
+    << " files into '" << outputPath << "' in " << result.nMergeSteps
+    << " steps: " << result.nMerged << " object merges, "
+    << result.nUnmergeable << " unmergeable objects kept from the first file."
+    << std::endl;
+  if (!result.skipped.empty()) {
+    std::cout << result.skipped.size() << " objects not supported and skipped:";
+    for (std::string const& path: result.skipped) std::cout << "\n  " << path;
+    std::cout << std::endl;
+  }
+  if (!result.valid()) {
+    std::cerr << result.errors.size() << " errors:";
+    for (std::string const& error: result.errors) std::cerr << "\n  " << error;
+    std::cerr << std::endl;
+    return 1;
+  }
+
+  return 0;
+} // main()
@@ -10,8 +10,11 @@ This module requires ROOT.
 __all__ = [
   'loadICARUSgeometry',
   'justLoadICARUSgeometry',
+  'clearGeometryCache',
+  'makeGeometryArrays',
 ]
 
+import os, logging
 import galleryUtils
 import LArSoftUtils
 import ROOTutils
@@ -136,28 +139,263 @@ def loadICARUSchannelMappingClass(
 # loadICARUSchannelMappingClass()
 
 
+################################################################################
+### Geometry cache
+###
+# Geometry service providers already loaded, by configuration key.
+GeometryCache = {}
+
+# Configuration objects already loaded, by configuration file path.
+ConfigurationCache = {}
+
+# Directory for the readout mapping cache files (empty: no files are written).
+DefaultMappingCacheDir = os.environ.get('ICARUSALG_GEOMETRY_CACHE',
+  os.path.join(
+    os.environ.get('XDG_CACHE_HOME', os.path.join(os.path.expanduser('~'), '.cache')),
+    'icarusalg',
+  ))
+
+
+def geometryConfigurationKey(
+  geometryConfig: "FHiCL configuration of the geometry service",
+  mappingClass: "Class object for the channel mapping",
+  ) -> "a string identifying geometry configuration and mapping":
+  """Returns a key identifying the geometry from its configuration.
+
+  The key includes the hash of the complete configuration of the geometry
+  service (which includes the channel mapping configuration, if present).
+  """
+  return "{}:{}".format(
+    getattr(mappingClass, '__cpp_name__', getattr(mappingClass, '__name__', '')),
+    geometryConfig.id().to_string(),
+    )
+# geometryConfigurationKey()
+
+
+def withReadoutMappingCache(
+  geometryConfig: "FHiCL configuration of the geometry service",
+  cachePath: "path of the readout mapping cache file",
+  ) -> "the configuration with the readout mapping cache file set":
+  """Returns a copy of `geometryConfig` using `cachePath` as mapping cache.
+
+  The cache file is set as `ReadoutMappingCache` of the `ChannelMapping`
+  configuration of the geometry, only if a cache file was not already
+  configured there. If there is no `ChannelMapping` table in `geometryConfig`,
+  `geometryConfig` is returned unchanged.
+  """
+  if not geometryConfig.has_key('ChannelMapping'): return geometryConfig
+  mapperConfig = galleryUtils.getTableIfPresent(geometryConfig, 'ChannelMapping')
+  if mapperConfig.get['std::string']('ReadoutMappingCache', ''):
+    return geometryConfig
+
+  mapperConfig = ROOT.fhicl.ParameterSet(mapperConfig)
+  mapperConfig.put_or_replace['std::string']('ReadoutMappingCache', cachePath)
+  geometryConfig = ROOT.fhicl.ParameterSet(geometryConfig)
+  geometryConfig.put_or_replace['fhicl::ParameterSet']\
+    ('ChannelMapping', mapperConfig)
+  return geometryConfig
+# withReadoutMappingCache()
+
+
+def clearGeometryCache():
+  """Forgets all the geometry and configuration objects loaded so far."""
+  GeometryCache.clear()
+  ConfigurationCache.clear()
+# clearGeometryCache()
+
+
+################################################################################
 def loadICARUSgeometry(
   config = None, registry = None, mappingClass = None,
+  useCache = True, mappingCacheDir = None,
   ):
   """Loads and returns ICARUS geometry with the standard ICARUS channel mapping.
 
   See `loadGeometry()` for the meaning of the arguments.
+
+  If `useCache` is set, the geometry is loaded only the first time a certain
+  geometry configuration is requested, and the same object is returned on the
+  following requests (the geometry is still registered into `registry`).
+
+  The readout mapping is also saved into a file in `mappingCacheDir`
+  (`DefaultMappingCacheDir` by default, which can be set via
+  `ICARUSALG_GEOMETRY_CACHE` environment variable) and later processes restore
+  it from there instead of building it again (see the `ReadoutMappingCache`
+  parameter of `icarus::ICARUSChannelMapAlg`), unless the configuration already
+  specifies its own cache file. An empty `mappingCacheDir` disables this.
   """
 
   if mappingClass is None:
     mappingClass = loadICARUSchannelMappingClass(config=config, registry=registry)
-  return LArSoftUtils.loadGeometry \
-    (config=config, registry=registry, mapping=mappingClass)
+
+  serviceName = 'Geometry'
+  geometryConfig \
+    = config.service(serviceName) if config else registry.config(serviceName)
+  if geometryConfig is None:
+    raise RuntimeError("Failed to retrieve the configuration for %s service" % serviceName)
+
+  key = geometryConfigurationKey(geometryConfig, mappingClass)
+  if useCache and key in GeometryCache:
+    geometry = GeometryCache[key]
+    if registry: registry.register(serviceName, geometry)
+    return geometry
+  # if cached
+
+  if mappingCacheDir is None: mappingCacheDir = DefaultMappingCacheDir
+  if mappingCacheDir:
+    try:
+      os.makedirs(mappingCacheDir, exist_ok=True)
+      cachePath = os.path.join(mappingCacheDir,
+        "ICARUSreadoutMapping-{}.bin".format(geometryConfig.id().to_string()))
+      geometryConfig = withReadoutMappingCache(geometryConfig, cachePath)
+    except OSError:
+      logging.warning(
+        "Can't create the readout mapping cache directory '%s'", mappingCacheDir
+        )
+  # if mapping cache
+
+  geometry = LArSoftUtils.loadGeometry(
+    config=config, registry=registry, mapping=mappingClass,
+    geometryConfig=geometryConfig,
+    )
+  if useCache: GeometryCache[key] = geometry
+  return geometry
 # loadICARUSgeometry()
 
 
-def justLoadICARUSgeometry(configFile, mappingClass = None):
+def justLoadICARUSgeometry(configFile, mappingClass = None, useCache = True):
   """Loads and returns ICARUS geometry from the specified configuration file.
 
   This is a one-stop procedure recommended only when running interactively.
+  With `useCache`, both the configuration and the geometry are loaded only on
+  the first call for each configuration (see `loadICARUSgeometry()`).
   """
-  return loadICARUSgeometry(config=LArSoftUtils.ConfigurationClass(configFile))
+  config = ConfigurationCache.get(configFile) if useCache else None
+  if config is None:
+    config = LArSoftUtils.ConfigurationClass(configFile)
+    if useCache: ConfigurationCache[configFile] = config
+  return loadICARUSgeometry \
+    (config=config, mappingClass=mappingClass, useCache=useCache)
 # justLoadICARUSgeometry()
 
 
+################################################################################
+### Geometry arrays
+###
+class _ArrayViewOwner:
+  """Exposes the memory of `array` to numpy while keeping `owner` alive.
+
+  Arrays made by `numpy.asarray()` on this object have it as their `base`,
+  and so do all the views taken from them.
+  """
+  def __init__(self, array, owner):
+    self.__array_interface__ = array.__array_interface__
+    self.array = array
+    self.owner = owner
+  # __init__()
+# class _ArrayViewOwner
+
+
+def arrayView(
+  vector: "C++ std::vector of numbers",
+  dtype: "numpy data type",
+  owner: "object owning the memory of `vector`" = None,
+  ):
+  """Returns a numpy array viewing the data of a C++ `vector` without copying.
+
+  The array (and every view of it) keeps `owner` alive; by default, that is
+  `vector` itself. When `vector` is a reference to data of another object,
+  that object should be specified as `owner`.
+  The array is valid only as long as `vector` is not resized.
+  """
+  import numpy
+  if vector.empty(): return numpy.empty(0, dtype=dtype)
+  data = vector.data()
+  data.reshape((vector.size(),)) # tell PyROOT the extent of the buffer
+  buffer = numpy.frombuffer(data, dtype=dtype, count=vector.size())
+  return numpy.asarray(_ArrayViewOwner(
+    buffer, owner=(vector if owner is None else owner)
+    ))
+# arrayView()
+
+
+class GeometryArraysClass:
+  """Channel, wire and optical detector tables as numpy arrays.
+
+  The arrays view the memory of a C++ `icarus::GeometryArrays` object
+  (`source`): no data is copied. Each array keeps `source` alive, so it stays
+  valid even after this object is gone.
+
+  Channel table (indexed by channel; `channelWire` is the first wire):
+    `channelCryostat`, `channelTPC`, `channelPlane`, `channelWire`,
+    `channelNWires`
+  Wire table (in geometry order):
+    `wireCryostat`, `wireTPC`, `wirePlane`, `wireNumber`, `wireChannel`,
+    `wireStartX`, `wireStartY`, `wireStartZ`, `wireEndX`, `wireEndY`,
+    `wireEndZ`
+  Optical detector table (indexed by optical detector number):
+    `opDetCenterX`, `opDetCenterY`, `opDetCenterZ`, `opDetCryostat`
+  The methods `wireStart()`, `wireEnd()` and `opDetCenter()` return copies of
+  the coordinates as arrays with shape `(N, 3)`.
+
+  Example: the wire number on each channel of collection planes
+      
+      arrays = ICARUSutils.makeGeometryArrays(geom)
+      collection = arrays.channelPlane == 2
+      collectionWires = arrays.channelWire[collection]
+      
+  """
+  IndexArrays = (
+    'channelCryostat', 'channelTPC', 'channelPlane', 'channelWire',
+    'channelNWires',
+    'wireCryostat', 'wireTPC', 'wirePlane', 'wireNumber', 'wireChannel',
+    'opDetCryostat',
+  )
+  CoordArrays = (
+    'wireStartX', 'wireStartY', 'wireStartZ',
+    'wireEndX', 'wireEndY', 'wireEndZ',
+    'opDetCenterX', 'opDetCenterY', 'opDetCenterZ',
+  )
+
+  def __init__(self, source: "icarus::GeometryArrays object"):
+    import numpy
+    self.source = source
+    for name in self.IndexArrays:
+      setattr(self, name,
+        arrayView(getattr(source, name)(), numpy.uintc, owner=source))
+    for name in self.CoordArrays:
+      setattr(self, name,
+        arrayView(getattr(source, name)(), numpy.float64, owner=source))
+  # __init__()
+
+  def nChannels(self): return len(self.channelNWires)
+  def nWires(self): return len(self.wireChannel)
+  def nOpDets(self): return len(self.opDetCryostat)
+
+  def wireStart(self):
+    import numpy
+    return numpy.stack((self.wireStartX, self.wireStartY, self.wireStartZ), axis=1)
+  def wireEnd(self):
+    import numpy
+    return numpy.stack((self.wireEndX, self.wireEndY, self.wireEndZ), axis=1)
+  def opDetCenter(self):
+    import numpy
+    return numpy.stack(
+      (self.opDetCenterX, self.opDetCenterY, self.opDetCenterZ), axis=1)
+
+# class GeometryArraysClass
+
+
+def makeGeometryArrays(geometry: "geometry service provider (geo::GeometryCore)"):
+  """Returns channel, wire and optical detector tables from `geometry`.
+
+  The tables are extracted in C++ with a single call and are returned as numpy
+  arrays (see `GeometryArraysClass`), ready for vectorized operations.
+  """
+  LArSoftUtils.SourceCode.loadHeaderFromUPS('icarusalg/Geometry/GeometryArrays.h')
+  LArSoftUtils.SourceCode.loadLibrary('icarusalg_Geometry')
+  return GeometryArraysClass(ROOT.icarus.GeometryArrays(geometry))
+# makeGeometryArrays()
+
+
 ################################################################################
@@ -47,12 +47,14 @@ readHeader = galleryUtils.readHeader
 ################################################################################
 ### LArSoft
 ################################################################################
-def loadGeometry(config=None, registry=None, mapping=None):
+def loadGeometry(config=None, registry=None, mapping=None, geometryConfig=None):
   """The argument `config` is an instance of `ConfigurationClass`.
 
   If a config object is provided, configurations will be read from there.
   Otherwise, they will be read from the registry.
   If a registry is provided, the services will be registered in there.
+  If `geometryConfig` is provided, it is used as the configuration of the
+  geometry service instead of the one from `config` or `registry`.
   """
   assert(config or registry)
   serviceName = 'Geometry'
@@ -64,7 +66,8 @@ def loadGeometry(config=None, registry=None, mapping=None):
     if registry: registry.register("message", None) # there is no direct access, sorry
   # if need to load message facility
 
-  geometryConfig = config.service(serviceName) if config else registry.config(serviceName)
+  if geometryConfig is None:
+    geometryConfig = config.service(serviceName) if config else registry.config(serviceName)
   if geometryConfig is None:
     raise RuntimeError("Failed to retrieve the configuration for %s service" % serviceName)
 
@@ -0,0 +1,117 @@
+/**
+ * @file test/AllocationCounter.h
+ * @brief Counts the heap allocations performed in a piece of code.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ *
+ * This library is header only, and it _replaces the global `operator new`_
+ * and `operator delete` of the program including it. For that reason, it must
+ * be included in exactly one source file of each test executable (which is
+ * the case of the single-file unit tests).
+ */
+
+#ifndef ICARUSALG_TEST_ALLOCATIONCOUNTER_H
+#define ICARUSALG_TEST_ALLOCATIONCOUNTER_H
+
+// C/C++ standard libraries
+#include <atomic>
+#include <new> // std::bad_alloc
+#include <cstdlib> // std::malloc(), std::free()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::test {
+
+  class AllocationCounter;
+
+  namespace details {
+
+    /// Number of allocations since the start of the program.
+    inline std::atomic<std::size_t> NAllocations { 0U };
+
+    /// Number of bytes allocated since the start of the program.
+    inline std::atomic<std::size_t> NAllocatedBytes { 0U };
+
+  } // namespace details
+
+} // namespace icarus::test
+
+
+/**
+ * @brief Counts the heap allocations since its construction.
+ *
+ * The allocations are counted through the replaced global `operator new`,
+ * by all threads; they include the ones of the standard containers with
+ * the default allocator. Aligned `operator new` is not counted.
+ *
+ * Since the test assertions may allocate memory themselves, the count should
+ * be read after the code under test and before the checks:
+ * ~~~~{.cpp}
+ * icarus::test::AllocationCounter allocations;
+ * for (auto const& point: points) index.withinRadius(point, 50.0, found);
+ * std::size_t const nAllocations = allocations.allocations();
+ *
+ * BOOST_TEST(nAllocations == 0U);
+ * ~~~~
+ */
+class icarus::test::AllocationCounter {
+
+    public:
+
+  /// Starts counting.
+  AllocationCounter() { restart(); }
+
+  /// Returns the number of allocations since the start of the count.
+  std::size_t allocations() const
+    { return details::NAllocations.load() - fStartAllocations; }
+
+  /// Returns the number of bytes allocated since the start of the count.
+  std::size_t bytes() const
+    { return details::NAllocatedBytes.load() - fStartBytes; }
+
+  /// Starts the count again from zero.
+  void restart()
+    {
+      fStartAllocations = details::NAllocations.load();
+      fStartBytes = details::NAllocatedBytes.load();
+    }
+
+
+    private:
+
+  std::size_t fStartAllocations; ///< Allocations at the start of the count.
+  std::size_t fStartBytes; ///< Allocated bytes at the start of the count.
+
+}; // icarus::test::AllocationCounter
+
+
+// -----------------------------------------------------------------------------
+// --- replacement of the global allocation functions
+// -----------------------------------------------------------------------------
+void* operator new(std::size_t size) {
+  ++icarus::test::details::NAllocations;
+  icarus::test::details::NAllocatedBytes += size;
+  if (void* p = std::malloc(size? size: 1U)) return p;
+  throw std::bad_alloc{};
+} // operator new()
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+// GCC 11+ can't see that `operator new()` above uses `std::malloc()`
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#  pragma GCC diagnostic pop
+#endif
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_TEST_ALLOCATIONCOUNTER_H
@@ -0,0 +1,145 @@
+/**
+ * @file   CachedKeySorting_test.cc
+ * @brief  Unit test for utilities from `CachedKeySorting.h`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/details/CachedKeySorting.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE CachedKeySorting
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/details/CachedKeySorting.h"
+
+// C/C++ standard library
+#include <algorithm> // std::stable_sort()
+#include <execution> // std::execution::par_unseq
+#include <functional> // std::less<>, std::greater<>
+#include <memory> // std::unique_ptr
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+void sortedKeyIndices_test() {
+
+  std::vector<int> const keys { 3, 1, 2, 1, 3, 0 };
+
+  std::vector<std::size_t> const expected { 5, 1, 3, 2, 0, 4 };
+  std::vector<std::size_t> const order
+    = icarus::details::sortedKeyIndices(keys, std::less<int>{});
+  BOOST_TEST(order == expected, boost::test_tools::per_element());
+
+  std::vector<std::size_t> const expectedRev { 0, 4, 2, 1, 3, 5 };
+  std::vector<std::size_t> const orderRev
+    = icarus::details::sortedKeyIndices(keys, std::greater<int>{});
+  BOOST_TEST(orderRev == expectedRev, boost::test_tools::per_element());
+
+} // sortedKeyIndices_test()
+
+
+//------------------------------------------------------------------------------
+using Data_t = std::pair<int, std::string>;
+
+/// Returns the name (second element) of each of the `data`.
+std::vector<std::string> names(std::vector<Data_t> const& data) {
+  std::vector<std::string> n;
+  for (Data_t const& d: data) n.push_back(d.second);
+  return n;
+}
+
+
+//------------------------------------------------------------------------------
+void sortByCachedKey_test() {
+
+  std::vector<Data_t> data {
+    { 2, "B1" }, { 0, "A" }, { 2, "B2" }, { 5, "D" }, { 3, "C" }, { 2, "B3" }
+    };
+
+  unsigned int nKeys = 0U;
+  auto const keyOf = [&nKeys](Data_t const& d){ ++nKeys; return d.first; };
+
+  std::vector<Data_t> expected { data };
+  std::stable_sort(expected.begin(), expected.end(),
+    [](Data_t const& a, Data_t const& b){ return a.first < b.first; });
+
+  icarus::details::sortByCachedKey
+    (data.begin(), data.end(), keyOf, std::less<int>{});
+  BOOST_TEST(nKeys == data.size()); // one key extraction per element
+  BOOST_TEST(names(data) == names(expected), boost::test_tools::per_element());
+
+  // sorting on reversed range: reverse order, still stable
+  std::stable_sort(expected.rbegin(), expected.rend(),
+    [](Data_t const& a, Data_t const& b){ return a.first < b.first; });
+  icarus::details::sortByCachedKey
+    (data.rbegin(), data.rend(), keyOf, std::less<int>{});
+  BOOST_TEST(names(data) == names(expected), boost::test_tools::per_element());
+
+} // sortByCachedKey_test()
+
+
+//------------------------------------------------------------------------------
+void sortByCachedKey_moveOnly_test() {
+
+  std::vector<std::unique_ptr<int>> data;
+  for (int const value: { 4, 2, 3, 1 })
+    data.push_back(std::make_unique<int>(value));
+
+  icarus::details::sortByCachedKey(data.begin(), data.end(),
+    [](std::unique_ptr<int> const& p){ return *p; }, std::less<int>{});
+
+  BOOST_TEST_REQUIRE(data.size() == 4U);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    BOOST_TEST_CONTEXT("element #" << i) {
+      BOOST_TEST_REQUIRE(bool(data[i]));
+      BOOST_TEST(*data[i] == static_cast<int>(i + 1));
+    }
+  }
+
+} // sortByCachedKey_moveOnly_test()
+
+
+//------------------------------------------------------------------------------
+void sortByCachedKey_parallel_test() {
+
+  // many equivalent keys, to exercise the stability of the parallel sorting
+  std::vector<std::pair<int, unsigned int>> data;
+  for (unsigned int i = 0; i < 50000U; ++i)
+    data.emplace_back((i * 7919U) % 101U, i);
+
+  std::vector<std::pair<int, unsigned int>> expected { data };
+  std::stable_sort(expected.begin(), expected.end(),
+    [](auto const& a, auto const& b){ return a.first < b.first; });
+
+  std::vector<int> const keys { 2, 1, 2 };
+  std::vector<std::size_t> const serialOrder
+    = icarus::details::sortedKeyIndices(keys, std::less<int>{});
+  std::vector<std::size_t> const parallelOrder
+    = icarus::details::sortedKeyIndices
+      (std::execution::par_unseq, keys, std::less<int>{});
+  BOOST_TEST(parallelOrder == serialOrder, boost::test_tools::per_element());
+
+  icarus::details::sortByCachedKey(std::execution::par_unseq,
+    data.begin(), data.end(),
+    [](auto const& d){ return d.first; }, std::less<int>{});
+  BOOST_TEST(data == expected);
+
+} // sortByCachedKey_parallel_test()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(sortedKeyIndices_testcase) {
+  sortedKeyIndices_test();
+} // BOOST_AUTO_TEST_CASE(sortedKeyIndices_testcase)
+
+BOOST_AUTO_TEST_CASE(sortByCachedKey_testcase) {
+  sortByCachedKey_test();
+  sortByCachedKey_moveOnly_test();
+} // BOOST_AUTO_TEST_CASE(sortByCachedKey_testcase)
+
+BOOST_AUTO_TEST_CASE(sortByCachedKey_parallel_testcase) {
+  sortByCachedKey_parallel_test();
+} // BOOST_AUTO_TEST_CASE(sortByCachedKey_parallel_testcase)
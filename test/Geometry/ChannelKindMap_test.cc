@@ -0,0 +1,80 @@
+/**
+ * @file   ChannelKindMap_test.cc
+ * @brief  Unit test for `icarus::ChannelKindMap`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/ChannelKindMap.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ChannelKindMap
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ChannelKindMap.h"
+
+
+//------------------------------------------------------------------------------
+void channelKindMapTest() {
+
+  using PlaneType = icarus::ChannelKindMap::PlaneType;
+
+  // two readout planes of 100 channels each, 10 wireless channels at the start
+  // of the first and 5 at each end of the second; 200 channels span 4 words
+  icarus::ChannelKindMap kinds { 200U };
+  BOOST_TEST(kinds.nChannels() == 200U);
+  BOOST_TEST(kinds.nWireless() == 200U);
+
+  kinds.setPlaneType(0U, 100U, PlaneType::FirstInduction);
+  kinds.setPlaneType(100U, 200U, PlaneType::Collection);
+  kinds.setWired(10U, 100U);
+  kinds.setWired(105U, 195U);
+
+  BOOST_TEST(kinds.nWireless() == 20U);
+
+  BOOST_TEST( kinds.isWireless(0U));
+  BOOST_TEST( kinds.isWireless(9U));
+  BOOST_TEST(!kinds.isWireless(10U));
+  BOOST_TEST(!kinds.isWireless(63U));
+  BOOST_TEST(!kinds.isWireless(64U));
+  BOOST_TEST(!kinds.isWireless(99U));
+  BOOST_TEST( kinds.isWireless(100U));
+  BOOST_TEST( kinds.isWireless(104U));
+  BOOST_TEST( kinds.isWired(105U));
+  BOOST_TEST( kinds.isWired(194U));
+  BOOST_TEST( kinds.isWireless(195U));
+  BOOST_TEST( kinds.isWireless(199U));
+
+  BOOST_TEST((kinds.planeType(0U) == PlaneType::FirstInduction));
+  BOOST_TEST((kinds.planeType(99U) == PlaneType::FirstInduction));
+  BOOST_TEST((kinds.planeType(100U) == PlaneType::Collection));
+
+  // out of the map
+  BOOST_TEST(!kinds.hasChannel(200U));
+  BOOST_TEST(kinds.isWireless(200U));
+  BOOST_TEST(kinds.isWireless(raw::InvalidChannelID));
+  BOOST_TEST((kinds.planeType(200U) == PlaneType::Unknown));
+
+  // bitmap
+  icarus::ChannelKindMap::Word_t const* bits = kinds.wirelessBits();
+  BOOST_TEST(bits[0] == 0x3FFU);
+  BOOST_TEST(((bits[1] >> (99U - 64U)) & 1U) == 0U);
+  BOOST_TEST(((bits[1] >> (100U - 64U)) & 1U) == 1U);
+
+  // empty map
+  icarus::ChannelKindMap const empty;
+  BOOST_TEST(empty.nChannels() == 0U);
+  BOOST_TEST(empty.nWireless() == 0U);
+  BOOST_TEST(empty.isWireless(0U));
+
+} // channelKindMapTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( ChannelKindMapTestCase ) {
+
+  channelKindMapTest();
+
+} // BOOST_AUTO_TEST_CASE( ChannelKindMapTestCase )
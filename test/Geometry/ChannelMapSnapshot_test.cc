@@ -0,0 +1,118 @@
+/**
+ * @file   ChannelMapSnapshot_test.cc
+ * @brief  Unit test for `icarus::ChannelMapPublisher`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/ChannelMapSnapshot.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ChannelMapSnapshot
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ChannelMapSnapshot.h"
+
+// C/C++ standard libraries
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+/// Publishes a snapshot whose kind table has `10 * generation` channels.
+icarus::ChannelMapPublisher::Generation_t publishNext
+  (icarus::ChannelMapPublisher& publisher)
+{
+  unsigned int const nChannels = 10U * (publisher.generation() + 1U);
+  return publisher.publish
+    (icarus::CompiledChannelMap{}, icarus::ChannelKindMap{ nChannels });
+} // publishNext()
+
+
+//------------------------------------------------------------------------------
+void publisherTest() {
+
+  icarus::ChannelMapPublisher publisher;
+  BOOST_TEST(publisher.generation() == 0U);
+  BOOST_TEST(!publisher.current());
+
+  icarus::ChannelMapPublisher::Reader reader { publisher };
+  BOOST_TEST(!reader.get());
+  BOOST_TEST(!reader.outdated());
+
+  BOOST_TEST(publishNext(publisher) == 1U);
+  BOOST_TEST(publisher.generation() == 1U);
+  BOOST_TEST_REQUIRE(publisher.current());
+  BOOST_TEST(publisher.current()->generation() == 1U);
+  BOOST_TEST(publisher.current()->kinds().nChannels() == 10U);
+
+  BOOST_TEST(reader.outdated());
+  BOOST_TEST(reader.refresh().generation() == 1U);
+  BOOST_TEST(!reader.outdated());
+
+  // the old snapshot stays valid while held
+  auto const old = publisher.current();
+  BOOST_TEST(publishNext(publisher) == 2U);
+  BOOST_TEST(old->generation() == 1U);
+  BOOST_TEST(old->kinds().nChannels() == 10U);
+  BOOST_TEST(reader.snapshot().generation() == 1U);
+  BOOST_TEST(reader.outdated());
+  BOOST_TEST(reader.refresh().kinds().nChannels() == 20U);
+
+} // publisherTest()
+
+
+//------------------------------------------------------------------------------
+void concurrentPublisherTest() {
+
+  /*
+   * One writer publishes many snapshots while readers refresh continuously;
+   * each reader must always see a consistent snapshot, with a generation
+   * never going back.
+   */
+  constexpr unsigned int NReaders = 4U;
+  constexpr unsigned int NPublications = 200U;
+
+  icarus::ChannelMapPublisher publisher;
+  publishNext(publisher);
+
+  std::atomic<bool> done { false };
+  std::vector<unsigned int> errors(NReaders, 0U);
+  std::vector<std::thread> readers;
+  for (unsigned int iReader = 0; iReader < NReaders; ++iReader) {
+    readers.emplace_back([&publisher,&done,&errors,iReader]()
+      {
+        icarus::ChannelMapPublisher::Reader reader { publisher };
+        icarus::ChannelMapPublisher::Generation_t last = 0U;
+        while (!done.load()) {
+          icarus::ChannelMapSnapshot const& snapshot = reader.refresh();
+          if (snapshot.generation() < last) ++errors[iReader];
+          if (snapshot.kinds().nChannels() != 10U * snapshot.generation())
+            ++errors[iReader];
+          last = snapshot.generation();
+        } // while
+      });
+  } // for
+
+  for (unsigned int i = 1; i < NPublications; ++i) publishNext(publisher);
+  done = true;
+  for (std::thread& reader: readers) reader.join();
+
+  BOOST_TEST(publisher.generation() == NPublications);
+  for (unsigned int iReader = 0; iReader < NReaders; ++iReader)
+    BOOST_TEST(errors[iReader] == 0U);
+
+} // concurrentPublisherTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ChannelMapSnapshotTestCase) {
+
+  publisherTest();
+  concurrentPublisherTest();
+
+} // BOOST_AUTO_TEST_CASE(ChannelMapSnapshotTestCase)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+/**
+ * @file   ChannelProcessingPlan_test.cc
+ * @brief  Unit test for `icarus::ChannelProcessingPlan`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/ChannelProcessingPlan.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ChannelProcessingPlan
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ChannelProcessingPlan.h"
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+void channelProcessingPlanTest() {
+
+  using Plan_t = icarus::ChannelProcessingPlan;
+  using PlaneType = Plan_t::PlaneType;
+
+  /*
+   * Two readout planes of 100 channels each:
+   * * first: 10 wireless channels, then 90 channels on plane C:0 T:0 P:0;
+   * * second: channels 100-149 on C:0 T:0 P:2, channels 130-194 on
+   *   C:0 T:1 P:2 (30 channels shared), then 5 wireless channels.
+   * Segments are aligned to multiples of 8 slots.
+   */
+  Plan_t plan { 200U, 8U };
+  BOOST_TEST(plan.nChannels() == 200U);
+  BOOST_TEST(plan.alignment() == 8U);
+  BOOST_TEST(plan.nSegments() == 0U);
+  BOOST_TEST(plan.slotOf(50U) == Plan_t::NoSlot);
+
+  readout::ROPID const ROP0 { 0U, 0U, 0U }, ROP1 { 0U, 0U, 1U };
+  geo::PlaneID const I1 { 0U, 0U, 0U }, C0 { 0U, 0U, 2U }, C1 { 0U, 1U, 2U };
+
+  Plan_t::Segment_t segment;
+  segment.ROP = ROP0;
+  segment.planeType = PlaneType::FirstInduction;
+  segment.plane = I1;
+  segment.firstWire = 0U;
+  segment.nPlanes = 1U;
+  segment.firstChannel = 10U;
+  segment.nChannels = 90U;
+  BOOST_TEST(plan.addSegment(segment).firstSlot == 0U);
+
+  segment.ROP = ROP1;
+  segment.planeType = PlaneType::Collection;
+  segment.plane = C0;
+  segment.firstChannel = 100U;
+  segment.nChannels = 30U;
+  BOOST_TEST(plan.addSegment(segment).firstSlot == 96U); // 90 -> 96
+
+  segment.firstWire = 30U;
+  segment.nPlanes = 2U;
+  segment.firstChannel = 130U;
+  segment.nChannels = 20U;
+  BOOST_TEST(plan.addSegment(segment).firstSlot == 128U); // 126 -> 128
+
+  segment.plane = C1;
+  segment.firstWire = 20U;
+  segment.nPlanes = 1U;
+  segment.firstChannel = 150U;
+  segment.nChannels = 45U;
+  BOOST_TEST(plan.addSegment(segment).firstSlot == 152U); // 148 -> 152
+
+  BOOST_TEST(plan.nSlots() == 197U);
+  plan.close();
+  BOOST_TEST(plan.nSlots() == 200U);
+
+  BOOST_TEST_REQUIRE(plan.nSegments() == 4U);
+  BOOST_TEST(plan.segment(0).endChannel() == 100U);
+  BOOST_TEST(plan.segment(0).endSlot() == 90U);
+  BOOST_TEST(plan.segment(2).nPlanes == 2U);
+  BOOST_TEST(plan.segment(3).plane == C1);
+  BOOST_TEST((plan.segment(3).planeType == PlaneType::Collection));
+
+  // channel <=> slot
+  BOOST_TEST(plan.slotOf(0U) == Plan_t::NoSlot);
+  BOOST_TEST(plan.slotOf(9U) == Plan_t::NoSlot);
+  BOOST_TEST(plan.slotOf(10U) == 0U);
+  BOOST_TEST(plan.slotOf(99U) == 89U);
+  BOOST_TEST(plan.slotOf(100U) == 96U);
+  BOOST_TEST(plan.slotOf(130U) == 128U);
+  BOOST_TEST(plan.slotOf(194U) == 196U);
+  BOOST_TEST(plan.slotOf(195U) == Plan_t::NoSlot);
+  BOOST_TEST(plan.slotOf(200U) == Plan_t::NoSlot);
+  BOOST_TEST(plan.slotOf(raw::InvalidChannelID) == Plan_t::NoSlot);
+
+  for (std::size_t slot = 0; slot < plan.nSlots(); ++slot) {
+    raw::ChannelID_t const channel = plan.channelAt(slot);
+    if (channel == raw::InvalidChannelID) continue; // padding
+    BOOST_TEST(plan.slotOf(channel) == slot);
+  }
+  BOOST_TEST(plan.channelAt(90U) == raw::InvalidChannelID);
+  BOOST_TEST(plan.channelAt(95U) == raw::InvalidChannelID);
+  BOOST_TEST(plan.channelAt(199U) == raw::InvalidChannelID);
+
+  // empty plan
+  Plan_t const empty;
+  BOOST_TEST(empty.nChannels() == 0U);
+  BOOST_TEST(empty.nSlots() == 0U);
+  BOOST_TEST(empty.slotOf(0U) == Plan_t::NoSlot);
+
+} // channelProcessingPlanTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ChannelProcessingPlanTestCase) {
+
+  channelProcessingPlanTest();
+
+} // BOOST_AUTO_TEST_CASE(ChannelProcessingPlanTestCase)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+/**
+ * @file   PMTgeometryTable_test.cc
+ * @brief  Unit test for `icarus::details::PMTgeometryTable`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/details/PMTgeometryTable.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PMTgeometryTable
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/details/PMTgeometryTable.h"
+
+// C/C++ standard library
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+/**
+ * Fills a table with two cryostats, each with two walls of PMT:
+ * * cryostat 0, wall 0 (_x_ = -10): a row of 3 PMT at _z_ = 0, 50, 100;
+ * * cryostat 0, wall 1 (_x_ = +10): a row of 3 PMT at _z_ = 0, 50, 100;
+ * * cryostat 1, wall 0 (_x_ = 90): a column of 2 PMT at _y_ = 0, 50;
+ * * cryostat 1, wall 1 (_x_ = 110): a single PMT.
+ * All rows are at _y_ = 0 unless stated otherwise.
+ */
+icarus::details::PMTgeometryTable makeTestTable() {
+
+  icarus::details::PMTgeometryTable table;
+  table.reserve(9U);
+
+  for (double const x: { -10.0, 10.0 }) {
+    for (double const z: { 0.0, 50.0, 100.0 })
+      table.addPMT({ x, 0.0, z }, 0U, (x < 0.0)? 0U: 1U);
+  }
+  table.addPMT({ 90.0, 0.0, 0.0 }, 1U, 0U);
+  table.addPMT({ 90.0, 50.0, 0.0 }, 1U, 0U);
+  table.addPMT({ 110.0, 0.0, 0.0 }, 1U, 1U);
+
+  table.buildNeighbors(60.0);
+
+  return table;
+} // makeTestTable()
+
+
+//------------------------------------------------------------------------------
+void queryTest() {
+
+  using Channel_t = icarus::details::PMTgeometryTable::Channel_t;
+  using Channels_t = std::vector<Channel_t>;
+
+  icarus::details::PMTgeometryTable const table = makeTestTable();
+
+  BOOST_TEST(!table.empty());
+  BOOST_TEST(table.nPMTs() == 9U);
+  BOOST_TEST(table.hasChannel(8U));
+  BOOST_TEST(!table.hasChannel(9U));
+
+  geo::Point_t const center = table.center(4U);
+  BOOST_TEST(center.X() == 10.0);
+  BOOST_TEST(center.Y() == 0.0);
+  BOOST_TEST(center.Z() == 50.0);
+  BOOST_TEST(table.centerY()[7U] == 50.0);
+  BOOST_TEST(table.cryostat(2U) == 0U);
+  BOOST_TEST(table.cryostat(6U) == 1U);
+  BOOST_TEST(table.wall(2U) == 0U);
+  BOOST_TEST(table.wall(3U) == 1U);
+
+  auto const wall = table.wallChannels(0U, 1U);
+  BOOST_TEST(Channels_t(wall.begin(), wall.end()) == (Channels_t{ 3U, 4U, 5U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(table.wallChannels(1U, 1U).size() == 1U);
+  BOOST_TEST(table.wallChannels(5U, 0U).size() == 0U);
+
+} // queryTest()
+
+
+//------------------------------------------------------------------------------
+void neighborTest() {
+
+  using Channel_t = icarus::details::PMTgeometryTable::Channel_t;
+  using Channels_t = std::vector<Channel_t>;
+
+  icarus::details::PMTgeometryTable const table = makeTestTable();
+
+  auto neighbors = [&table](Channel_t channel)
+    {
+      auto const n = table.neighbors(channel);
+      return Channels_t(n.begin(), n.end());
+    };
+
+  BOOST_TEST(table.neighborDistance() == 60.0);
+
+  // PMT on the other wall (20 cm away) are not neighbours
+  BOOST_TEST(neighbors(0U) == (Channels_t{ 1U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(neighbors(1U) == (Channels_t{ 0U, 2U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(table.nNeighbors(4U) == 2U);
+  BOOST_TEST(neighbors(6U) == (Channels_t{ 7U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(table.nNeighbors(8U) == 0U);
+  BOOST_TEST(neighbors(8U).empty());
+
+} // neighborTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( PMTgeometryTableTestCase ) {
+
+  queryTest();
+  neighborTest();
+
+} // BOOST_AUTO_TEST_CASE( PMTgeometryTableTestCase )
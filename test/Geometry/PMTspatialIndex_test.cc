@@ -0,0 +1,204 @@
+/**
+ * @file   PMTspatialIndex_test.cc
+ * @brief  Unit test for `icarus::PMTspatialIndex`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/PMTspatialIndex.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PMTspatialIndex
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/PMTspatialIndex.h"
+#include "icarusalg/Geometry/details/PMTgeometryTable.h"
+#include "test/AllocationCounter.h"
+
+// C/C++ standard library
+#include <random>
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+/**
+ * Fills a table with two cryostats with two walls each, with the same layout
+ * of PMT as ICARUS: rows at _y_ = -105.6, -52.8, 0, 52.8, 105.6, with the PMT
+ * of odd rows shifted by half a step of 49.88 cm in _z_.
+ * Some PMT are exactly at the same distance from some of the test points.
+ */
+icarus::details::PMTgeometryTable makeTestTable() {
+
+  icarus::details::PMTgeometryTable table;
+  for (unsigned int cryostat = 0U; cryostat < 2U; ++cryostat) {
+    for (unsigned int wall = 0U; wall < 2U; ++wall) {
+      double const x = ((cryostat == 0U)? -200.0: 200.0)
+        + ((wall == 0U)? -180.0: 180.0);
+      for (int row = -2; row <= 2; ++row) {
+        double const shift = (row % 2 == 0)? 0.0: 24.94;
+        for (int col = -9; col < 9; ++col) {
+          table.addPMT
+            ({ x, row * 52.8, col * 49.88 + shift }, cryostat, wall);
+        }
+      } // for rows
+    } // for walls
+  } // for cryostats
+
+  return table;
+} // makeTestTable()
+
+
+/// Returns the PMT closest to `point` among the ones in `cryostat`
+/// (any cryostat if `cryostat` is too large), with a linear scan.
+icarus::PMTspatialIndex::OpDet_t linearNearest(
+  icarus::details::PMTgeometryTable const& table, geo::Point_t const& point,
+  unsigned int cryostat = std::numeric_limits<unsigned int>::max()
+) {
+  icarus::PMTspatialIndex::OpDet_t best = icarus::PMTspatialIndex::NoOpDet;
+  double bestDist2 = std::numeric_limits<double>::max();
+  for (unsigned int channel = 0U; channel < table.nPMTs(); ++channel) {
+    if ((cryostat < 2U) && (table.cryostat(channel) != cryostat)) continue;
+    double const dist2 = (table.center(channel) - point).Mag2();
+    if (dist2 >= bestDist2) continue;
+    bestDist2 = dist2;
+    best = channel;
+  } // for
+  return best;
+} // linearNearest()
+
+
+//------------------------------------------------------------------------------
+void nearestTest() {
+
+  icarus::details::PMTgeometryTable const table = makeTestTable();
+  icarus::PMTspatialIndex const index { table };
+
+  BOOST_TEST(index.nOpDets() == table.nPMTs());
+  BOOST_TEST(index.nCryostats() == 2U);
+
+  std::mt19937 engine { 12345 };
+  std::uniform_real_distribution<double> uniformX { -500.0, 500.0 };
+  std::uniform_real_distribution<double> uniformY { -200.0, 200.0 };
+  std::uniform_real_distribution<double> uniformZ { -600.0, 600.0 };
+
+  std::vector<geo::Point_t> points;
+  for (int i = 0; i < 2000; ++i)
+    points.emplace_back(uniformX(engine), uniformY(engine), uniformZ(engine));
+  // points equidistant from two or more PMT (ties)
+  points.emplace_back(-380.0, 26.4, 0.0);
+  points.emplace_back(-200.0, 0.0, 24.94);
+  points.emplace_back(0.0, 0.0, 0.0);
+
+  unsigned int nMismatches = 0U;
+  for (geo::Point_t const& point: points) {
+    unsigned int const cryostat = (point.X() < 0.0)? 0U: 1U;
+    if (index.nearest(point) != linearNearest(table, point)) ++nMismatches;
+    if (index.nearestInCryostat(point, cryostat)
+      != linearNearest(table, point, cryostat))
+    {
+      ++nMismatches;
+    }
+  } // for
+  BOOST_TEST(nMismatches == 0U);
+
+  BOOST_TEST(index.nearestInCryostat(points.front(), 2U)
+    == icarus::PMTspatialIndex::NoOpDet);
+
+  // batch
+  std::vector<icarus::PMTspatialIndex::OpDet_t> found(points.size());
+  index.nearest(points.size(), points.data(), found.data());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    BOOST_TEST(found[i] == index.nearest(points[i]));
+
+} // nearestTest()
+
+
+//------------------------------------------------------------------------------
+void radiusTest() {
+
+  using OpDets_t = std::vector<icarus::PMTspatialIndex::OpDet_t>;
+
+  icarus::details::PMTgeometryTable const table = makeTestTable();
+  icarus::PMTspatialIndex const index { table };
+
+  std::vector<geo::Point_t> const points {
+    { -380.0, 0.0, 0.0 }, { -300.0, 30.0, 100.0 }, { 380.0, 0.0, 0.0 },
+    { 0.0, 0.0, 0.0 }
+    };
+  double const radius = 110.0;
+
+  OpDets_t opDets;
+  std::vector<std::size_t> offsets;
+  OpDets_t allOpDets;
+  index.withinRadius(points.size(), points.data(), radius, offsets, allOpDets);
+  BOOST_TEST(offsets.size() == points.size() + 1U);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    OpDets_t expected;
+    for (unsigned int channel = 0U; channel < table.nPMTs(); ++channel) {
+      if ((table.center(channel) - points[i]).R() <= radius)
+        expected.push_back(channel);
+    }
+    BOOST_TEST(index.withinRadius(points[i], radius, opDets)
+      == expected.size());
+    BOOST_TEST(opDets == expected, boost::test_tools::per_element());
+    OpDets_t const batch
+      { allOpDets.begin() + offsets[i], allOpDets.begin() + offsets[i + 1] };
+    BOOST_TEST(batch == expected, boost::test_tools::per_element());
+  } // for
+
+  BOOST_TEST(index.withinRadius(points.back(), -1.0, opDets) == 0U);
+
+} // radiusTest()
+
+
+//------------------------------------------------------------------------------
+void allocationTest() {
+
+  using OpDets_t = std::vector<icarus::PMTspatialIndex::OpDet_t>;
+
+  icarus::details::PMTgeometryTable const table = makeTestTable();
+  icarus::PMTspatialIndex const index { table };
+
+  std::vector<geo::Point_t> const points {
+    { -380.0, 0.0, 0.0 }, { -300.0, 30.0, 100.0 }, { 380.0, 0.0, 0.0 },
+    { 0.0, 0.0, 0.0 }
+    };
+  OpDets_t found(points.size());
+  OpDets_t opDets;
+  opDets.reserve(table.nPMTs());
+  std::vector<std::size_t> offsets;
+  OpDets_t allOpDets;
+  // the first batch query sizes the output buffers
+  index.withinRadius(points.size(), points.data(), 110.0, offsets, allOpDets);
+
+  // queries do not allocate memory once the output buffers are large enough
+  icarus::test::AllocationCounter allocations;
+  std::size_t n = 0U;
+  for (geo::Point_t const& point: points) {
+    n += index.nearest(point);
+    n += index.nearestInCryostat(point, 0U);
+    n += index.withinRadius(point, 110.0, opDets);
+  }
+  index.nearest(points.size(), points.data(), found.data());
+  index.withinRadius(points.size(), points.data(), 110.0, offsets, allOpDets);
+  std::size_t const nAllocations = allocations.allocations();
+
+  BOOST_TEST(n > 0U);
+  BOOST_TEST(nAllocations == 0U);
+
+} // allocationTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( PMTspatialIndexTestCase ) {
+
+  nearestTest();
+  radiusTest();
+  allocationTest();
+
+} // BOOST_AUTO_TEST_CASE( PMTspatialIndexTestCase )
@@ -0,0 +1,182 @@
+/**
+ * @file   WireGeometryTable_test.cc
+ * @brief  Unit test for `icarus::details::WireGeometryTable`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Geometry/details/WireGeometryTable.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE WireGeometryTable
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Geometry/details/WireGeometryTable.h"
+
+// C/C++ standard library
+#include <vector>
+#include <cstdint> // std::uint8_t
+
+
+//------------------------------------------------------------------------------
+/**
+ * Fills a table with a single TPC with two planes of 10 wires with pitch 1:
+ * * plane 0: wires along _y_ from -5 to 5, at _z_ = 0, 1, ..., 9;
+ * * plane 1: wires along _z_ from -0.5 to 9.5, at _y_ = -4.5, -3.5, ..., 4.5,
+ *   except wire 5 which is split and covers only _z_ from 3.5 to 5.5.
+ */
+icarus::details::WireGeometryTable makeTestTable() {
+
+  icarus::details::WireGeometryTable table;
+  table.resize(1U, 1U, 2U);
+  table.reserve(20U);
+
+  table.addPlane({ 0U, 0U, 0U }, 1.0, { 0.0, 0.0, 1.0 });
+  for (int i = 0; i < 10; ++i)
+    table.addWire({ 0.0, 0.0, 1.0 * i }, { 0.0, 1.0, 0.0 }, 5.0);
+
+  table.addPlane({ 0U, 0U, 1U }, 1.0, { 0.0, 1.0, 0.0 });
+  for (int i = 0; i < 10; ++i) {
+    table.addWire
+      ({ 0.5, -4.5 + i, 4.5 }, { 0.0, 0.0, 1.0 }, ((i == 5)? 1.0: 5.0));
+  }
+
+  return table;
+} // makeTestTable()
+
+
+//------------------------------------------------------------------------------
+void queryTest() {
+
+  geo::PlaneID const plane0 { 0U, 0U, 0U };
+  geo::PlaneID const plane1 { 0U, 0U, 1U };
+
+  icarus::details::WireGeometryTable const table = makeTestTable();
+
+  BOOST_TEST(!table.empty());
+  BOOST_TEST(table.nWires() == 20U);
+  BOOST_TEST(table.hasPlane(plane0));
+  BOOST_TEST(table.hasPlane(plane1));
+  BOOST_TEST(!table.hasPlane(geo::PlaneID{ 0U, 0U, 2U }));
+  BOOST_TEST(!table.hasPlane(geo::PlaneID{ 0U, 1U, 0U }));
+  BOOST_TEST(!table.hasPlane(geo::PlaneID{}));
+
+  BOOST_TEST(table.nWires(plane1) == 10U);
+  BOOST_TEST(table.pitch(plane1) == 1.0);
+  BOOST_TEST(table.wireIndex({ plane1, 3U }) == 13U);
+
+  geo::Point_t const center = table.wireCenter({ plane1, 3U });
+  BOOST_TEST(center.X() == 0.5);
+  BOOST_TEST(center.Y() == -1.5);
+  BOOST_TEST(center.Z() == 4.5);
+  BOOST_TEST(table.wireDirection({ plane0, 2U }).Y() == 1.0);
+  BOOST_TEST(table.halfLength({ plane1, 5U }) == 1.0);
+  BOOST_TEST(table.centerZ()[table.wireIndex({ plane0, 7U })] == 7.0);
+
+  BOOST_TEST(table.wireCoordinate(plane0, 2.0, 3.25) == 3.25);
+  BOOST_TEST(table.wireCoordinate(plane1, -2.0, 3.0) == 2.5);
+
+} // queryTest()
+
+
+//------------------------------------------------------------------------------
+void intersectionTest() {
+
+  geo::PlaneID const plane0 { 0U, 0U, 0U };
+  geo::PlaneID const plane1 { 0U, 0U, 1U };
+
+  icarus::details::WireGeometryTable const table = makeTestTable();
+
+  double y = -99.0, z = -99.0;
+  BOOST_TEST(table.intersect({ plane0, 3U }, { plane1, 2U }, y, z));
+  BOOST_TEST(y == -2.5);
+  BOOST_TEST(z == 3.0);
+
+  // lines cross, but out of the split wire
+  BOOST_TEST(!table.intersect({ plane0, 3U }, { plane1, 5U }, y, z));
+  BOOST_TEST(y == 0.5);
+  BOOST_TEST(z == 3.0);
+
+  // parallel wires
+  y = z = -99.0;
+  BOOST_TEST(!table.intersect({ plane0, 1U }, { plane0, 2U }, y, z));
+  BOOST_TEST(y == -99.0);
+  BOOST_TEST(z == -99.0);
+
+  std::vector<geo::WireID> const wires1
+    { { plane0, 3U }, { plane0, 4U }, { plane0, 1U } };
+  std::vector<geo::WireID> const wires2
+    { { plane1, 2U }, { plane1, 5U }, { plane0, 2U } };
+  std::vector<double> ys(3U), zs(3U);
+  std::vector<std::uint8_t> crossing(3U);
+  BOOST_TEST(table.intersect(3U, wires1.data(), wires2.data(),
+    ys.data(), zs.data(), crossing.data()) == 2U);
+  BOOST_TEST(crossing[0] == 1);
+  BOOST_TEST(crossing[1] == 1);
+  BOOST_TEST(crossing[2] == 0);
+  BOOST_TEST(ys[1] == 0.5);
+  BOOST_TEST(zs[1] == 4.0);
+  BOOST_TEST(ys[2] == 0.0);
+
+} // intersectionTest()
+
+
+//------------------------------------------------------------------------------
+void boxTest() {
+
+  using WireNo_t = icarus::details::WireGeometryTable::WireNo_t;
+  using WireRange_t = icarus::details::WireGeometryTable::WireRange_t;
+
+  geo::PlaneID const plane0 { 0U, 0U, 0U };
+  geo::PlaneID const plane1 { 0U, 0U, 1U };
+
+  icarus::details::WireGeometryTable const table = makeTestTable();
+
+  std::vector<WireNo_t> wires { 99U };
+
+  BOOST_TEST((table.wireRangeInBox(plane0, -1.0, 1.0, 2.5, 4.5)
+    == WireRange_t{ 3U, 5U }));
+  BOOST_TEST(table.wiresCrossingBox(plane0, -1.0, 1.0, 2.5, 4.5, wires) == 2U);
+  BOOST_TEST(wires == (std::vector<WireNo_t>{ 3U, 4U }),
+    boost::test_tools::per_element());
+
+  // the box touches wire 9 and goes beyond the plane
+  BOOST_TEST(table.wiresCrossingBox(plane0, 4.0, 8.0, 9.0, 12.0, wires) == 1U);
+  BOOST_TEST(wires == (std::vector<WireNo_t>{ 9U }),
+    boost::test_tools::per_element());
+
+  // the box is on the line of wire 5, but beyond its end
+  BOOST_TEST((table.wireRangeInBox(plane1, 0.0, 1.0, 6.0, 7.0)
+    == WireRange_t{ 5U, 6U }));
+  BOOST_TEST(table.wiresCrossingBox(plane1, 0.0, 1.0, 6.0, 7.0, wires) == 0U);
+  BOOST_TEST(wires.empty());
+  BOOST_TEST(table.wiresCrossingBox(plane1, 0.0, 1.0, 5.0, 7.0, wires) == 1U);
+
+  // the box is off the plane ends (y of plane 0)
+  BOOST_TEST(table.wiresCrossingBox(plane0, 6.0, 8.0, 2.5, 4.5, wires) == 0U);
+
+  // no wire on the side of the plane, or in an unknown plane
+  WireRange_t const range = table.wireRangeInBox(plane0, 0.0, 1.0, 12.0, 15.0);
+  BOOST_TEST(range.first == range.second);
+  BOOST_TEST(table.wiresCrossingBox
+    (geo::PlaneID{ 0U, 0U, 2U }, 0.0, 1.0, 0.0, 5.0, wires) == 0U);
+
+} // boxTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( WireGeometryTableQueryTestCase ) {
+
+  queryTest();
+
+} // BOOST_AUTO_TEST_CASE( WireGeometryTableQueryTestCase )
+
+
+BOOST_AUTO_TEST_CASE( WireGeometryTableIntersectionTestCase ) {
+
+  intersectionTest();
+  boxTest();
+
+} // BOOST_AUTO_TEST_CASE( WireGeometryTableIntersectionTestCase )
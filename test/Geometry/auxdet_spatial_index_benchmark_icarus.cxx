@@ -0,0 +1,176 @@
+/**
+ * @file   auxdet_spatial_index_benchmark_icarus.cxx
+ * @brief  Compares `icarus::AuxDetSpatialIndex` with LArSoft CRT strip search.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     auxdet_spatial_index_benchmark_icarus ConfigurationFile [Points]
+ *
+ * The standard ICARUS geometry is loaded with
+ * `icarus::geo::LoadStandardICARUSgeometry()` from the FHiCL configuration
+ * file `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`).
+ * `Points` points (default: 100000) are generated, half of them inside random
+ * CRT strips and half uniformly in the box enclosing all CRT modules; for each
+ * point the module and strip containing it are looked for with both
+ * `geo::GeometryCore::FindAuxDetSensitiveAtPosition()` and
+ * `icarus::AuxDetSpatialIndex::findSensitive()`. The time per query of each
+ * method is printed, and the program fails if the two disagree.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/AuxDetSpatialIndex.h"
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/AuxDetGeo.h"
+#include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm> // std::min(), std::max()
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using Clock_t = std::chrono::steady_clock;
+  using Location_t = icarus::AuxDetSpatialIndex::Location_t;
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [Points]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nPoints = (argc > 2)? std::atoi(argv[2]): 100000;
+  if (nPoints <= 0) {
+    std::cerr << "Invalid number of points: '" << argv[2] << "'" << std::endl;
+    return 1;
+  }
+
+  auto const geom = icarus::geo::LoadStandardICARUSgeometry(configPath);
+  if (geom->NAuxDets() == 0) {
+    std::cerr << "Geometry has no auxiliary detectors!" << std::endl;
+    return 1;
+  }
+
+  //
+  // index construction
+  //
+  auto const startBuild = Clock_t::now();
+  icarus::AuxDetSpatialIndex const index { *geom };
+  std::chrono::duration<double> const buildTime = Clock_t::now() - startBuild;
+
+  std::cout << "Index of " << index.nAuxDets() << " modules and "
+    << index.nSensitive() << " strips built in " << (buildTime.count() * 1e3)
+    << " ms (grid: " << index.gridSize()[0] << " x " << index.gridSize()[1]
+    << " x " << index.gridSize()[2] << " cells)" << std::endl;
+
+  //
+  // test points
+  //
+  std::mt19937 engine { 12345 };
+  std::uniform_real_distribution<double> uniform { -1.0, 1.0 };
+
+  double min[3] { +1e9, +1e9, +1e9 }, max[3] { -1e9, -1e9, -1e9 };
+  for (std::size_t ad = 0; ad < geom->NAuxDets(); ++ad) {
+    geo::Point_t const c = geom->AuxDet(ad).GetCenter();
+    double const coords[3] { c.X(), c.Y(), c.Z() };
+    for (int i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], coords[i] - 500.0);
+      max[i] = std::max(max[i], coords[i] + 500.0);
+    }
+  } // for
+
+  std::vector<geo::Point_t> points;
+  points.reserve(nPoints);
+  for (int i = 0; i < nPoints; ++i) {
+    if (i % 2 == 0) {
+      geo::AuxDetGeo const& ad
+        = geom->AuxDet(engine() % geom->NAuxDets());
+      geo::AuxDetSensitiveGeo const& sv
+        = ad.SensitiveVolume(engine() % ad.NSensitiveVolume());
+      double const halfWidth = std::min(sv.HalfWidth1(), sv.HalfWidth2());
+      points.push_back(sv.toWorldCoords(geo::AuxDetSensitiveGeo::LocalPoint_t{
+        0.99 * halfWidth * uniform(engine),
+        0.99 * sv.HalfHeight() * uniform(engine),
+        0.99 * sv.Length() / 2.0 * uniform(engine)
+        }));
+    }
+    else {
+      points.emplace_back(
+        (min[0] + max[0] + (max[0] - min[0]) * uniform(engine)) / 2.0,
+        (min[1] + max[1] + (max[1] - min[1]) * uniform(engine)) / 2.0,
+        (min[2] + max[2] + (max[2] - min[2]) * uniform(engine)) / 2.0
+        );
+    }
+  } // for
+
+  //
+  // LArSoft search
+  //
+  std::vector<Location_t> expected(points.size());
+  auto const startLArSoft = Clock_t::now();
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    try {
+      std::size_t ad, sv;
+      geom->FindAuxDetSensitiveAtPosition(points[i], ad, sv);
+      expected[i] = { ad, sv };
+    }
+    catch (cet::exception const&) {} // not found: keep invalid location
+  } // for
+  std::chrono::duration<double> const LArSoftTime
+    = Clock_t::now() - startLArSoft;
+
+  //
+  // index search
+  //
+  std::vector<Location_t> found(points.size());
+  auto const startIndex = Clock_t::now();
+  for (std::size_t i = 0; i < points.size(); ++i)
+    found[i] = index.findSensitive(points[i]);
+  std::chrono::duration<double> const indexTime = Clock_t::now() - startIndex;
+
+  //
+  // comparison
+  //
+  unsigned int nFound = 0U, nMismatches = 0U;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if (expected[i]) ++nFound;
+    if ((expected[i].auxDet == found[i].auxDet)
+      && (expected[i].sensitive == found[i].sensitive)
+    ) {
+      continue;
+    }
+    if (++nMismatches <= 10U) {
+      std::cerr << "Mismatch at " << points[i] << ": LArSoft ("
+        << expected[i].auxDet << ", " << expected[i].sensitive
+        << "), index (" << found[i].auxDet << ", " << found[i].sensitive
+        << ")" << std::endl;
+    }
+  } // for
+
+  std::cout << points.size() << " points, " << nFound << " inside strips\n"
+    << "  LArSoft: " << (LArSoftTime.count() / points.size() * 1e6)
+    << " us/query\n"
+    << "  index:   " << (indexTime.count() / points.size() * 1e6)
+    << " us/query\n"
+    << "  mismatches: " << nMismatches
+    << std::endl;
+
+  return (nMismatches == 0U)? 0: 1;
+} // main()
@@ -0,0 +1,195 @@
+/**
+ * @file   channel_map_benchmark_icarus.cxx
+ * @brief  Compares `icarus::CompiledChannelMap` with geometry channel queries.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     channel_map_benchmark_icarus ConfigurationFile [Queries]
+ *
+ * The ICARUS geometry is set up with `icarus::ICARUSChannelMapAlg` from the
+ * `Geometry` (or `services.Geometry`) configuration in the FHiCL file
+ * `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`), and the compiled
+ * channel mapping is extracted from it with
+ * `icarus::ICARUSChannelMapAlg::compiledMap()`.
+ * `Queries` random channels and wires (default: 1000000) are then looked up
+ * with `ChannelToROP()`, `ChannelToWire()` and `PlaneWireToChannel()`,
+ * both via `geo::GeometryCore` (virtual calls to the channel mapping) and via
+ * the compiled mapping. The time per query of each method is printed, and the
+ * program fails if the two disagree.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ICARUSstandaloneGeometrySetup.h"
+#include "icarusalg/Geometry/ICARUSChannelMapAlg.h"
+#include "icarusalg/Geometry/CompiledChannelMap.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "cetlib/filepath_maker.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <memory> // std::make_unique()
+#include <utility> // std::move()
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using namespace std::string_literals;
+  using Clock_t = std::chrono::steady_clock;
+  using Duration_t = std::chrono::duration<double>;
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [Queries]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nQueries = (argc > 2)? std::atoi(argv[2]): 1000000;
+  if (nQueries <= 0) {
+    std::cerr << "Invalid number of queries: '" << argv[2] << "'" << std::endl;
+    return 1;
+  }
+
+  //
+  // geometry setup, keeping a reference to the channel mapping
+  //
+  fhicl::ParameterSet config;
+  {
+    std::unique_ptr<cet::filepath_maker> const policy
+      { cet::lookup_policy_selector{}.select("permissive", "FHICL_FILE_PATH") };
+    fhicl::make_ParameterSet(configPath, *policy, config);
+  }
+  fhicl::ParameterSet geomConfig = config;
+  for (std::string const& path: { "services.Geometry"s, "Geometry"s }) {
+    if (!config.is_key_to_table(path)) continue;
+    geomConfig = config.get<fhicl::ParameterSet>(path);
+    break;
+  }
+
+  auto channelMapPtr = std::make_unique<icarus::ICARUSChannelMapAlg>(
+    icarus::geo::details::ConfigObjectMaker<icarus::ICARUSChannelMapAlg>::make
+      (geomConfig.get<fhicl::ParameterSet>("ChannelMapping"))
+    );
+  icarus::ICARUSChannelMapAlg const& channelMap = *channelMapPtr;
+  auto const geom = lar::standalone::SetupGeometryWithChannelMapping
+    (geomConfig, std::move(channelMapPtr));
+
+  auto const startCompile = Clock_t::now();
+  icarus::CompiledChannelMap const compiled = channelMap.compiledMap();
+  Duration_t const compileTime = Clock_t::now() - startCompile;
+
+  std::cout << "Compiled mapping of " << compiled.Nchannels()
+    << " channels extracted in " << (compileTime.count() * 1e3) << " ms"
+    << std::endl;
+
+  //
+  // queries
+  //
+  std::mt19937 engine { 12345 };
+
+  std::vector<raw::ChannelID_t> channels(nQueries);
+  for (raw::ChannelID_t& channel: channels)
+    channel = engine() % geom->Nchannels();
+
+  std::vector<geo::WireID> allWires;
+  for (geo::WireID const& wid: geom->Iterate<geo::WireID>())
+    allWires.push_back(wid);
+  std::vector<geo::WireID> wires(nQueries);
+  for (geo::WireID& wid: wires) wid = allWires[engine() % allWires.size()];
+
+  //
+  // geometry queries
+  //
+  std::vector<readout::ROPID> expectedROPs(nQueries);
+  std::vector<geo::WireID> expectedWires(nQueries);
+  std::vector<raw::ChannelID_t> expectedChannels(nQueries);
+
+  auto const startGeomROP = Clock_t::now();
+  for (int i = 0; i < nQueries; ++i)
+    expectedROPs[i] = geom->ChannelToROP(channels[i]);
+  Duration_t const geomROPtime = Clock_t::now() - startGeomROP;
+
+  auto const startGeomWire = Clock_t::now();
+  for (int i = 0; i < nQueries; ++i)
+    expectedWires[i] = geom->ChannelToWire(channels[i]).front();
+  Duration_t const geomWireTime = Clock_t::now() - startGeomWire;
+
+  auto const startGeomChannel = Clock_t::now();
+  for (int i = 0; i < nQueries; ++i)
+    expectedChannels[i] = geom->PlaneWireToChannel(wires[i]);
+  Duration_t const geomChannelTime = Clock_t::now() - startGeomChannel;
+
+  //
+  // compiled mapping queries
+  //
+  std::vector<readout::ROPID> foundROPs(nQueries);
+  std::vector<geo::WireID> foundWires(nQueries);
+  std::vector<raw::ChannelID_t> foundChannels(nQueries);
+
+  auto const startROP = Clock_t::now();
+  for (int i = 0; i < nQueries; ++i)
+    foundROPs[i] = compiled.ChannelToROP(channels[i]);
+  Duration_t const ROPtime = Clock_t::now() - startROP;
+
+  auto const startWire = Clock_t::now();
+  for (int i = 0; i < nQueries; ++i)
+    foundWires[i] = compiled.ChannelToWire(channels[i]).front();
+  Duration_t const wireTime = Clock_t::now() - startWire;
+
+  auto const startChannel = Clock_t::now();
+  for (int i = 0; i < nQueries; ++i)
+    foundChannels[i] = compiled.PlaneWireToChannel(wires[i]);
+  Duration_t const channelTime = Clock_t::now() - startChannel;
+
+  //
+  // comparison
+  //
+  unsigned int nMismatches = 0U;
+  for (int i = 0; i < nQueries; ++i) {
+    if ((expectedROPs[i] == foundROPs[i])
+      && (expectedWires[i] == foundWires[i])
+      && (expectedChannels[i] == foundChannels[i])
+    ) {
+      continue;
+    }
+    if (++nMismatches <= 10U) {
+      std::cerr << "Mismatch on channel " << channels[i] << ": ROP "
+        << expectedROPs[i] << " vs. " << foundROPs[i] << ", first wire "
+        << expectedWires[i] << " vs. " << foundWires[i]
+        << "; on wire " << wires[i] << ": channel " << expectedChannels[i]
+        << " vs. " << foundChannels[i] << std::endl;
+    }
+  } // for
+
+  auto const perQuery = [nQueries](Duration_t const& time)
+    { return time.count() / nQueries * 1e6; };
+
+  std::cout << nQueries << " queries (us/query: geometry / compiled)\n"
+    << "  ChannelToROP():       " << perQuery(geomROPtime)
+      << " / " << perQuery(ROPtime) << "\n"
+    << "  ChannelToWire():      " << perQuery(geomWireTime)
+      << " / " << perQuery(wireTime) << "\n"
+    << "  PlaneWireToChannel(): " << perQuery(geomChannelTime)
+      << " / " << perQuery(channelTime) << "\n"
+    << "  mismatches: " << nMismatches
+    << std::endl;
+
+  return (nMismatches == 0U)? 0: 1;
+} // main()
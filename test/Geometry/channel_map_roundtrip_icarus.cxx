@@ -0,0 +1,267 @@
+/**
+ * @file   channel_map_roundtrip_icarus.cxx
+ * @brief  Round trip check and timing of all ICARUS channels.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `geometry_icarus_test.cxx`
+ *
+ * Usage:
+ *
+ *     channel_map_roundtrip_icarus ConfigurationFile [MaxThreads]
+ *
+ * The standard ICARUS geometry is loaded with
+ * `icarus::geo::LoadStandardICARUSgeometry()` from the FHiCL configuration
+ * file `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`).
+ *
+ * Every channel is taken through `ChannelToWire()`, `PlaneWireToChannel()`,
+ * `ChannelToROP()` and `FirstChannelInROP()`, checking that:
+ * * the channel belongs to a readout plane, and it is within the channel
+ *   range of that readout plane;
+ * * each of its wires maps back to the same channel, and its plane belongs to
+ *   the same readout plane.
+ *
+ * Then the latency of each of the four calls is measured in blocks of
+ * consecutive channels and its percentiles are printed.
+ *
+ * Finally, the full round trip of all channels is run at the same time by an
+ * increasing number of threads (powers of 2 up to `MaxThreads`, by default
+ * all the hardware threads), each on all channels, sharing the same geometry.
+ * The throughput of each configuration and the speed-up relative to a single
+ * thread are printed: since the channel mapping queries are `const` and take
+ * no lock, the throughput should scale with the number of threads.
+ *
+ * The program fails if any of the checks fails.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <iostream>
+#include <iomanip> // std::setw()
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm> // std::sort(), std::min()
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using Clock_t = std::chrono::steady_clock;
+  using Duration_t = std::chrono::duration<double>;
+
+  /// Number of consecutive calls timed together.
+  constexpr std::size_t BlockSize = 16U;
+
+  /// Maximum number of failures printed.
+  constexpr unsigned int MaxPrintedFailures = 10U;
+
+
+  /**
+   * @brief Runs the full round trip on all channels.
+   * @param geom the geometry
+   * @param verbose whether to print the failures
+   * @return the number of failed checks
+   */
+  unsigned int checkAllChannels(geo::GeometryCore const& geom, bool verbose) {
+
+    // counts a failure, and returns where to print it (if anywhere)
+    unsigned int nFailures = 0U;
+    auto failure = [&nFailures,verbose]() -> std::ostream*
+      {
+        ++nFailures;
+        return (verbose && (nFailures <= MaxPrintedFailures))
+          ? &std::cerr: nullptr;
+      };
+
+    unsigned int const nChannels = geom.Nchannels();
+    for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+
+      readout::ROPID const rop = geom.ChannelToROP(channel);
+      if (!rop) {
+        if (auto* out = failure()) {
+          *out << "Channel " << channel << " has no readout plane."
+            << std::endl;
+        }
+        continue;
+      }
+
+      raw::ChannelID_t const first = geom.FirstChannelInROP(rop);
+      if ((channel < first) || (channel >= first + geom.Nchannels(rop))) {
+        if (auto* out = failure()) {
+          *out << "Channel " << channel << " is out of the range of its "
+            << rop << " (" << first << " -- "
+            << (first + geom.Nchannels(rop)) << ")." << std::endl;
+        }
+      }
+
+      for (geo::WireID const& wire: geom.ChannelToWire(channel)) {
+        raw::ChannelID_t const back = geom.PlaneWireToChannel(wire);
+        readout::ROPID const wireROP = geom.WirePlaneToROP(wire);
+        if ((back == channel) && (wireROP == rop)) continue;
+        if (auto* out = failure()) {
+          *out << "Channel " << channel << " (" << rop << ") -> " << wire
+            << " -> channel " << back << " (" << wireROP << ")."
+            << std::endl;
+        }
+      } // for wires
+
+    } // for channels
+
+    return nFailures;
+  } // checkAllChannels()
+
+
+  /**
+   * @brief Measures the latency of `call(i)` for `i` from `0` to `n`.
+   * @return the average latency of each block of `BlockSize` calls [s]
+   */
+  template <typename Call>
+  std::vector<double> blockLatencies(std::size_t n, Call call) {
+
+    std::vector<double> latencies;
+    latencies.reserve(n / BlockSize + 1U);
+    std::size_t volatile sink = 0U; // keeps the calls from being optimized out
+    for (std::size_t begin = 0; begin < n; begin += BlockSize) {
+      std::size_t const end = std::min(begin + BlockSize, n);
+      std::size_t acc = 0U;
+      auto const start = Clock_t::now();
+      for (std::size_t i = begin; i < end; ++i) acc += call(i);
+      Duration_t const elapsed = Clock_t::now() - start;
+      sink = sink + acc;
+      latencies.push_back(elapsed.count() / (end - begin));
+    } // for blocks
+    return latencies;
+  } // blockLatencies()
+
+
+  /// Prints the percentiles of the `latencies`.
+  void printPercentiles(std::string const& name, std::vector<double> latencies)
+  {
+    if (latencies.empty()) return;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p)
+      {
+        return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]
+          * 1e9;
+      };
+    std::cout << "  " << std::setw(20) << std::left << name << std::right
+      << " p50: " << std::setw(8) << percentile(0.50)
+      << "  p90: " << std::setw(8) << percentile(0.90)
+      << "  p99: " << std::setw(8) << percentile(0.99)
+      << "  p99.9: " << std::setw(8) << percentile(0.999)
+      << "  max: " << std::setw(8) << (latencies.back() * 1e9)
+      << " ns/call" << std::endl;
+  } // printPercentiles()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [MaxThreads]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const maxThreads = (argc > 2)
+    ? std::atoi(argv[2])
+    : static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+  if (maxThreads <= 0) {
+    std::cerr << "Invalid number of threads: '" << argv[2] << "'" << std::endl;
+    return 1;
+  }
+
+  auto const geom = icarus::geo::LoadStandardICARUSgeometry(configPath);
+  unsigned int const nChannels = geom->Nchannels();
+
+  //
+  // round trip checks
+  //
+  unsigned int const nFailures = checkAllChannels(*geom, true);
+  std::cout << nChannels << " channels checked: " << nFailures << " failures."
+    << std::endl;
+
+  //
+  // latencies
+  //
+  std::vector<readout::ROPID> ROPs(nChannels);
+  std::vector<geo::WireID> wires; // the first wire of each channel with wires
+  for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+    ROPs[channel] = geom->ChannelToROP(channel);
+    std::vector<geo::WireID> const channelWires = geom->ChannelToWire(channel);
+    if (!channelWires.empty()) wires.push_back(channelWires.front());
+  } // for
+
+  std::cout << "Latency (blocks of " << BlockSize << " channels):"
+    << std::endl;
+  printPercentiles("ChannelToWire()", blockLatencies(nChannels,
+    [&geom](std::size_t i){ return geom->ChannelToWire(i).size(); }));
+  printPercentiles("PlaneWireToChannel()", blockLatencies(wires.size(),
+    [&geom,&wires](std::size_t i)
+      { return std::size_t(geom->PlaneWireToChannel(wires[i])); }));
+  printPercentiles("ChannelToROP()", blockLatencies(nChannels,
+    [&geom](std::size_t i){ return std::size_t(geom->ChannelToROP(i).ROP); }));
+  printPercentiles("FirstChannelInROP()", blockLatencies(nChannels,
+    [&geom,&ROPs](std::size_t i)
+      { return std::size_t(geom->FirstChannelInROP(ROPs[i])); }));
+
+  //
+  // multi-thread scaling
+  //
+  std::vector<int> threadCounts;
+  for (int n = 1; n < maxThreads; n *= 2) threadCounts.push_back(n);
+  threadCounts.push_back(maxThreads);
+
+  std::cout << "Round trip of all channels, each thread on all of them:"
+    << std::endl;
+  double singleThroughput = 0.0;
+  unsigned int nThreadFailures = 0U;
+  for (int const nThreads: threadCounts) {
+
+    std::vector<unsigned int> failures(nThreads, 0U);
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    auto const start = Clock_t::now();
+    for (int iThread = 0; iThread < nThreads; ++iThread) {
+      threads.emplace_back([&geom,&failures,iThread]()
+        { failures[iThread] = checkAllChannels(*geom, false); });
+    }
+    for (std::thread& thread: threads) thread.join();
+    Duration_t const elapsed = Clock_t::now() - start;
+
+    for (unsigned int const n: failures) nThreadFailures += n;
+
+    double const throughput = nThreads * nChannels / elapsed.count();
+    if (nThreads == 1) singleThroughput = throughput;
+    double const speedup = throughput / singleThroughput;
+
+    std::cout << "  " << std::setw(3) << nThreads << " threads: "
+      << std::setw(8) << (elapsed.count() * 1e3) << " ms, "
+      << std::setw(10) << (throughput / 1e6) << " M channels/s, speed-up "
+      << std::setw(6) << speedup << " (efficiency: "
+      << (speedup / nThreads * 100.0) << "%)" << std::endl;
+
+  } // for thread counts
+
+  if (nThreadFailures > 0U) {
+    std::cerr << nThreadFailures
+      << " failures in the multi-thread round trips!" << std::endl;
+  }
+
+  return ((nFailures == 0U) && (nThreadFailures == 0U))? 0: 1;
+} // main()
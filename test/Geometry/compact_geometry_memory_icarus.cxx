@@ -0,0 +1,109 @@
+/**
+ * @file   compact_geometry_memory_icarus.cxx
+ * @brief  Compares the memory held by full and compact ICARUS geometry.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     compact_geometry_memory_icarus ConfigurationFile [full|compact]
+ *
+ * The standard ICARUS geometry is loaded from the FHiCL configuration file
+ * `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`), either in full with
+ * `icarus::geo::LoadStandardICARUSgeometry()` or, by default, as compact
+ * tables with `icarus::geo::LoadCompactICARUSgeometry()`.
+ * The resident memory of the process held after the loading is printed.
+ * Since memory released to the allocator is not always returned to the
+ * system, the two modes are meant to be compared in separate runs.
+ *
+ * In compact mode, the tables are also checked for consistency: every wire
+ * of every channel must belong to a plane present in the tables, and every
+ * PMT center must be inside its cryostat.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+#include "icarusalg/Geometry/CompactGeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <string>
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [full|compact]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  std::string const mode = (argc > 2)? argv[2]: "compact";
+  if ((mode != "full") && (mode != "compact")) {
+    std::cerr << "Invalid mode: '" << mode << "'" << std::endl;
+    return 1;
+  }
+
+  long const startMemory = icarus::geo::details::residentMemoryKiB();
+
+  if (mode == "full") {
+
+    auto const geom = icarus::geo::LoadStandardICARUSgeometry(configPath);
+    long const memory = icarus::geo::details::residentMemoryKiB();
+    std::cout << "Full geometry: " << geom->Nchannels() << " channels, "
+      << geom->NOpDets() << " optical detectors; "
+      << (memory - startMemory) << " kiB held" << std::endl;
+    return 0;
+
+  } // if full
+
+  icarus::CompactGeometry const geom
+    = icarus::geo::LoadCompactICARUSgeometry(configPath);
+  long const memory = icarus::geo::details::residentMemoryKiB();
+
+  icarus::CompiledChannelMap const& channelMap = geom.channelMap();
+  std::cout << "Compact geometry: " << channelMap.Nchannels() << " channels, "
+    << geom.wireGeometry().nWires() << " wires, "
+    << geom.pmtGeometry().nPMTs() << " optical detectors; "
+    << (memory - startMemory) << " kiB held" << std::endl;
+
+  //
+  // consistency checks
+  //
+  unsigned int nErrors = 0U;
+  for (raw::ChannelID_t channel = 0; channel < channelMap.Nchannels();
+    ++channel
+  ) {
+    for (geo::WireID const& wid: channelMap.ChannelToWire(channel)) {
+      if (geom.hasPlane(wid) && (wid.Wire < geom.plane(wid).nWires))
+        continue;
+      std::cerr << "Channel " << channel << " is mapped to wire C:"
+        << wid.Cryostat << " T:" << wid.TPC << " P:" << wid.Plane
+        << " W:" << wid.Wire << " not in the compact geometry" << std::endl;
+      ++nErrors;
+    } // for wires
+  } // for channels
+
+  icarus::details::PMTgeometryTable const& PMTs = geom.pmtGeometry();
+  for (unsigned int channel = 0; channel < PMTs.nPMTs(); ++channel) {
+    geo::CryostatID const cid { PMTs.cryostat(channel) };
+    if (geom.cryostatBox(cid).ContainsPosition(PMTs.center(channel)))
+      continue;
+    std::cerr << "PMT channel " << channel << " is outside its cryostat C:"
+      << cid.Cryostat << std::endl;
+    ++nErrors;
+  } // for PMT
+
+  if (nErrors > 0U) {
+    std::cerr << nErrors << " errors found." << std::endl;
+    return 1;
+  }
+  return 0;
+} // main()
@@ -0,0 +1,350 @@
+/**
+ * @file   geometry_iteration_benchmark_icarus.cxx
+ * @brief  Times full loops on the ICARUS geometry and readout elements.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `geometry_iterator_loop_icarus_test.cxx`
+ *
+ * Usage:
+ *
+ *     geometry_iteration_benchmark_icarus ConfigurationFile [Repetitions [JSONfile]]
+ *
+ * The ICARUS geometry is set up with `icarus::ICARUSChannelMapAlg` from the
+ * `Geometry` (or `services.Geometry`) configuration in the FHiCL file
+ * `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`).
+ * While `geometry_iterator_loop_icarus_test` checks that the geometry
+ * iterators visit the right elements, this program measures how long it takes
+ * to visit all of them: cryostats, TPCs, planes, wires, channels, TPC sets and
+ * readout planes are looped through with the `geo::GeometryCore` iterators
+ * and, where available, with the flat interfaces of `ICARUSChannelMapAlg`
+ * (ID spans, `icarus::CompiledChannelMap`, wire geometry table).
+ *
+ * Each loop is run `Repetitions` times (default: 10) after one warm-up run;
+ * the average time of a loop and per element are printed and written, with
+ * the number of elements, into the JSON file `JSONfile` (default:
+ * `geometry_iteration_benchmark_icarus.json`), to be compared across
+ * releases.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/ICARUSstandaloneGeometrySetup.h"
+#include "icarusalg/Geometry/ICARUSChannelMapAlg.h"
+#include "icarusalg/Geometry/CompiledChannelMap.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "cetlib/filepath_maker.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <fstream>
+#include <iomanip> // std::setw()
+#include <chrono>
+#include <vector>
+#include <string>
+#include <memory> // std::make_unique()
+#include <utility> // std::move(), std::pair
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+/// Timing of a single loop.
+struct LoopTiming_t {
+  std::string name; ///< What is looped through.
+  std::string interface; ///< Which interface is used for the loop.
+  std::size_t nElements = 0U; ///< Number of elements visited per loop.
+  double time = 0.0; ///< Average time per loop [s]
+  double checksum = 0.0; ///< Accumulated value, to keep the loop alive.
+}; // LoopTiming_t
+
+
+/**
+ * @brief Times `loop` on average over `nRepetitions` runs.
+ * @param loop callable returning the number of elements and a checksum
+ *
+ * The loop is run once more before timing, as warm-up.
+ */
+template <typename Loop>
+LoopTiming_t timeLoop(
+  std::string name, std::string interface, unsigned int nRepetitions,
+  Loop loop
+) {
+  using Clock_t = std::chrono::steady_clock;
+
+  LoopTiming_t timing;
+  timing.name = std::move(name);
+  timing.interface = std::move(interface);
+
+  timing.checksum = loop().second; // warm-up
+
+  auto const start = Clock_t::now();
+  for (unsigned int i = 0; i < nRepetitions; ++i) {
+    auto const [ n, checksum ] = loop();
+    timing.nElements = n;
+    timing.checksum += checksum;
+  }
+  std::chrono::duration<double> const elapsed = Clock_t::now() - start;
+  timing.time = elapsed.count() / nRepetitions;
+
+  return timing;
+} // timeLoop()
+
+
+/// Writes the timings into a JSON file.
+bool writeJSON(
+  std::string const& path, std::string const& configPath,
+  unsigned int nRepetitions, std::vector<LoopTiming_t> const& timings
+) {
+  std::ofstream out { path };
+  if (!out) return false;
+
+  // only quotes and backslashes are escaped (enough for file paths)
+  auto quoted = [](std::string const& s)
+    {
+      std::string q { "\"" };
+      for (char const c: s) {
+        if ((c == '"') || (c == '\\')) q += '\\';
+        q += c;
+      }
+      return q + '"';
+    };
+
+  out << "{\n"
+    << "  \"benchmark\": \"geometry_iteration_benchmark_icarus\",\n"
+    << "  \"configuration\": " << quoted(configPath) << ",\n"
+    << "  \"repetitions\": " << nRepetitions << ",\n"
+    << "  \"loops\": [";
+  for (std::size_t i = 0; i < timings.size(); ++i) {
+    LoopTiming_t const& t = timings[i];
+    out << ((i == 0)? "\n": ",\n")
+      << "    { \"name\": " << quoted(t.name)
+      << ", \"interface\": " << quoted(t.interface)
+      << ", \"elements\": " << t.nElements
+      << ", \"time_us\": " << (t.time * 1e6)
+      << ", \"ns_per_element\": "
+        << ((t.nElements > 0U)? (t.time / t.nElements * 1e9): 0.0)
+      << " }";
+  } // for
+  out << "\n  ]\n}\n";
+
+  return static_cast<bool>(out);
+} // writeJSON()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using namespace std::string_literals;
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0]
+      << "  ConfigurationFile [Repetitions [JSONfile]]" << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nRepetitions = (argc > 2)? std::atoi(argv[2]): 10;
+  if (nRepetitions <= 0) {
+    std::cerr << "Invalid number of repetitions: '" << argv[2] << "'"
+      << std::endl;
+    return 1;
+  }
+  std::string const JSONpath
+    = (argc > 3)? argv[3]: "geometry_iteration_benchmark_icarus.json";
+
+  //
+  // geometry setup, keeping a reference to the channel mapping
+  //
+  fhicl::ParameterSet config;
+  {
+    std::unique_ptr<cet::filepath_maker> const policy
+      { cet::lookup_policy_selector{}.select("permissive", "FHICL_FILE_PATH") };
+    fhicl::make_ParameterSet(configPath, *policy, config);
+  }
+  fhicl::ParameterSet geomConfig = config;
+  for (std::string const& path: { "services.Geometry"s, "Geometry"s }) {
+    if (!config.is_key_to_table(path)) continue;
+    geomConfig = config.get<fhicl::ParameterSet>(path);
+    break;
+  }
+
+  auto channelMapPtr = std::make_unique<icarus::ICARUSChannelMapAlg>(
+    icarus::geo::details::ConfigObjectMaker<icarus::ICARUSChannelMapAlg>::make
+      (geomConfig.get<fhicl::ParameterSet>("ChannelMapping"))
+    );
+  icarus::ICARUSChannelMapAlg const& channelMap = *channelMapPtr;
+  auto const geom = lar::standalone::SetupGeometryWithChannelMapping
+    (geomConfig, std::move(channelMapPtr));
+
+  icarus::CompiledChannelMap const compiled = channelMap.compiledMap();
+  icarus::details::WireGeometryTable const& wireTable
+    = channelMap.wireGeometry();
+
+  //
+  // the loops
+  //
+  using Result_t = std::pair<std::size_t, double>;
+  std::string const GeomCore = "GeometryCore";
+  std::string const ICARUSmap = "ICARUSChannelMapAlg";
+
+  std::vector<LoopTiming_t> timings;
+
+  timings.push_back(timeLoop("cryostats", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (geo::CryostatGeo const& cryo: geom->Iterate<geo::CryostatGeo>())
+        { ++res.first; res.second += cryo.NTPC(); }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("TPCs", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (geo::TPCGeo const& TPC: geom->Iterate<geo::TPCGeo>())
+        { ++res.first; res.second += TPC.Nplanes(); }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("planes", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (geo::PlaneGeo const& plane: geom->Iterate<geo::PlaneGeo>())
+        { ++res.first; res.second += plane.Nwires(); }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("wires", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (geo::WireGeo const& wire: geom->Iterate<geo::WireGeo>())
+        { ++res.first; res.second += wire.HalfL(); }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("wires", ICARUSmap, nRepetitions,
+    [&wireTable]()
+    {
+      Result_t res { wireTable.nWires(), 0.0 };
+      double const* halfLength = wireTable.halfLength();
+      for (std::size_t i = 0; i < res.first; ++i) res.second += halfLength[i];
+      return res;
+    }));
+
+  timings.push_back(timeLoop("wire IDs", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (geo::WireID const& wid: geom->Iterate<geo::WireID>())
+        { ++res.first; res.second += wid.Wire; }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("channels", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { geom->Nchannels(), 0.0 };
+      for (raw::ChannelID_t ch = 0; ch < res.first; ++ch)
+        res.second += geom->ChannelToWire(ch).size();
+      return res;
+    }));
+
+  timings.push_back(timeLoop("channels", ICARUSmap, nRepetitions,
+    [&compiled]()
+    {
+      Result_t res { compiled.Nchannels(), 0.0 };
+      for (raw::ChannelID_t ch = 0; ch < res.first; ++ch)
+        res.second += compiled.NwiresOnChannel(ch);
+      return res;
+    }));
+
+  timings.push_back(timeLoop("TPC sets", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (readout::TPCsetID const& sid: geom->Iterate<readout::TPCsetID>())
+        { ++res.first; res.second += geom->TPCsetToTPCs(sid).size(); }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("TPC sets", ICARUSmap, nRepetitions,
+    [&channelMap,nCryostats=geom->Ncryostats()]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (readout::CryostatID::CryostatID_t c = 0; c < nCryostats; ++c) {
+        readout::CryostatID const cid { c };
+        unsigned int const nTPCsets = channelMap.NTPCsets(cid);
+        for (readout::TPCsetID::TPCsetID_t s = 0; s < nTPCsets; ++s) {
+          ++res.first;
+          res.second += channelMap.TPCsetTPCIDs({ cid, s }).size();
+        }
+      } // for cryostats
+      return res;
+    }));
+
+  timings.push_back(timeLoop("ROPs", GeomCore, nRepetitions,
+    [&geom]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (readout::ROPID const& rid: geom->Iterate<readout::ROPID>())
+        { ++res.first; res.second += geom->ROPtoWirePlanes(rid).size(); }
+      return res;
+    }));
+
+  timings.push_back(timeLoop("ROPs", ICARUSmap, nRepetitions,
+    [&channelMap,nCryostats=geom->Ncryostats()]()
+    {
+      Result_t res { 0U, 0.0 };
+      for (readout::CryostatID::CryostatID_t c = 0; c < nCryostats; ++c) {
+        readout::CryostatID const cid { c };
+        unsigned int const nTPCsets = channelMap.NTPCsets(cid);
+        for (readout::TPCsetID::TPCsetID_t s = 0; s < nTPCsets; ++s) {
+          readout::TPCsetID const sid { cid, s };
+          unsigned int const nROPs = channelMap.NROPs(sid);
+          for (readout::ROPID::ROPID_t r = 0; r < nROPs; ++r) {
+            ++res.first;
+            res.second += channelMap.ROPwirePlaneIDs({ sid, r }).size();
+          }
+        } // for TPC sets
+      } // for cryostats
+      return res;
+    }));
+
+  //
+  // report
+  //
+  std::cout << "Average over " << nRepetitions << " loops:\n";
+  for (LoopTiming_t const& t: timings) {
+    std::cout << "  " << std::setw(10) << t.name
+      << " (" << std::setw(19) << t.interface << "): "
+      << std::setw(8) << t.nElements << " elements in "
+      << std::setw(10) << (t.time * 1e6) << " us ("
+      << ((t.nElements > 0U)? (t.time / t.nElements * 1e9): 0.0)
+      << " ns/element) [checksum: " << t.checksum << "]\n";
+  } // for
+  std::cout << std::flush;
+
+  if (!writeJSON(JSONpath, configPath, nRepetitions, timings)) {
+    std::cerr << "Failed to write the summary into '" << JSONpath << "'."
+      << std::endl;
+    return 1;
+  }
+  std::cout << "Summary written into '" << JSONpath << "'." << std::endl;
+
+  return 0;
+} // main()
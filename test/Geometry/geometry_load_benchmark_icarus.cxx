@@ -0,0 +1,97 @@
+/**
+ * @file   geometry_load_benchmark_icarus.cxx
+ * @brief  Measures the time spent in each phase of ICARUS geometry loading.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     geometry_load_benchmark_icarus ConfigurationFile [Iterations]
+ *
+ * The standard ICARUS geometry is loaded with
+ * `icarus::geo::LoadStandardICARUSgeometry()` from the FHiCL configuration
+ * file `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`) `Iterations` times
+ * (default: 5). The breakdown of each loading is printed, followed by the
+ * average time of each phase over all iterations but the first one (which
+ * includes one-time costs like library loading and file system caching).
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <iomanip> // std::setw()
+#include <vector>
+#include <string>
+#include <utility> // std::move()
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [Iterations]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nIterations = (argc > 2)? std::atoi(argv[2]): 5;
+  if (nIterations <= 0) {
+    std::cerr << "Invalid number of iterations: '" << argv[2] << "'"
+      << std::endl;
+    return 1;
+  }
+
+  std::vector<icarus::geo::GeometryLoadProfile> profiles;
+  for (int i = 0; i < nIterations; ++i) {
+
+    icarus::geo::GeometryLoadProfile profile;
+    {
+      auto const geom
+        = icarus::geo::LoadStandardICARUSgeometry(configPath, profile);
+      if (!geom || (geom->Nchannels() == 0)) {
+        std::cerr << "Geometry loading failed at iteration #" << i
+          << std::endl;
+        return 1;
+      }
+    } // geometry destroyed here
+
+    std::cout << "[#" << i << "] ";
+    profile.dump(std::cout, "  ");
+    std::cout << std::endl;
+
+    profiles.push_back(std::move(profile));
+
+  } // for iterations
+
+  //
+  // averages (skipping the first iteration, if possible)
+  //
+  std::size_t const first = (profiles.size() > 1)? 1U: 0U;
+  std::size_t const n = profiles.size() - first;
+
+  icarus::geo::GeometryLoadProfile average = profiles.back();
+  for (auto& phase: average.phases) {
+    phase.wallTime = 0.0;
+    phase.memoryDelta = 0L;
+    for (std::size_t i = first; i < profiles.size(); ++i) {
+      auto const* iterPhase = profiles[i].phase(phase.name);
+      if (!iterPhase) continue;
+      phase.wallTime += iterPhase->wallTime / n;
+      phase.memoryDelta += iterPhase->memoryDelta / static_cast<long>(n);
+    } // for iterations
+  } // for phases
+
+  std::cout << "\nAverage over " << n << " iterations:\n";
+  average.dump(std::cout, "  ");
+  std::cout << std::endl;
+
+  return 0;
+} // main()
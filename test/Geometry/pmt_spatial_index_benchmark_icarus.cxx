@@ -0,0 +1,180 @@
+/**
+ * @file   pmt_spatial_index_benchmark_icarus.cxx
+ * @brief  Compares `icarus::PMTspatialIndex` with LArSoft closest PMT search.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     pmt_spatial_index_benchmark_icarus ConfigurationFile [Points] [Radius]
+ *
+ * The standard ICARUS geometry is loaded with
+ * `icarus::geo::LoadStandardICARUSgeometry()` from the FHiCL configuration
+ * file `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`).
+ * `Points` points (default: 100000) are generated uniformly in the cryostats;
+ * for each point the closest optical detector is looked for with both
+ * `geo::GeometryCore::GetClosestOpDet()` and
+ * `icarus::PMTspatialIndex::nearestInCryostat()` (one point at a time and in
+ * batch), and the optical detectors within `Radius` (default: 100 cm) are
+ * looked for with both a linear scan and
+ * `icarus::PMTspatialIndex::withinRadius()`. The time per query of each
+ * method is printed, and the program fails if they disagree.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/PMTspatialIndex.h"
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::atoi(), std::atof()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using Clock_t = std::chrono::steady_clock;
+  using Duration_t = std::chrono::duration<double>;
+  using OpDet_t = icarus::PMTspatialIndex::OpDet_t;
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0]
+      << "  ConfigurationFile [Points] [Radius]" << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nPoints = (argc > 2)? std::atoi(argv[2]): 100000;
+  if (nPoints <= 0) {
+    std::cerr << "Invalid number of points: '" << argv[2] << "'" << std::endl;
+    return 1;
+  }
+  double const radius = (argc > 3)? std::atof(argv[3]): 100.0;
+
+  auto const geom = icarus::geo::LoadStandardICARUSgeometry(configPath);
+  if (geom->NOpDets() == 0) {
+    std::cerr << "Geometry has no optical detectors!" << std::endl;
+    return 1;
+  }
+
+  //
+  // index construction
+  //
+  auto const startBuild = Clock_t::now();
+  icarus::PMTspatialIndex const index { *geom };
+  Duration_t const buildTime = Clock_t::now() - startBuild;
+
+  std::cout << "Index of " << index.nOpDets() << " optical detectors in "
+    << index.nCryostats() << " cryostats built in "
+    << (buildTime.count() * 1e3) << " ms" << std::endl;
+
+  //
+  // test points, uniformly in the cryostats
+  //
+  std::mt19937 engine { 12345 };
+  std::uniform_real_distribution<double> uniform { 0.0, 1.0 };
+
+  std::vector<geo::Point_t> points;
+  std::vector<unsigned int> cryostats;
+  points.reserve(nPoints);
+  cryostats.reserve(nPoints);
+  for (int i = 0; i < nPoints; ++i) {
+    geo::CryostatGeo const& cryo
+      = geom->Cryostat(geo::CryostatID(i % geom->Ncryostats()));
+    points.emplace_back(
+      cryo.MinX() + (cryo.MaxX() - cryo.MinX()) * uniform(engine),
+      cryo.MinY() + (cryo.MaxY() - cryo.MinY()) * uniform(engine),
+      cryo.MinZ() + (cryo.MaxZ() - cryo.MinZ()) * uniform(engine)
+      );
+    cryostats.push_back(cryo.ID().Cryostat);
+  } // for
+
+  //
+  // closest optical detector
+  //
+  std::vector<OpDet_t> expected(points.size());
+  auto const startLArSoft = Clock_t::now();
+  for (std::size_t i = 0; i < points.size(); ++i)
+    expected[i] = geom->GetClosestOpDet(points[i]);
+  Duration_t const LArSoftTime = Clock_t::now() - startLArSoft;
+
+  std::vector<OpDet_t> found(points.size());
+  auto const startIndex = Clock_t::now();
+  for (std::size_t i = 0; i < points.size(); ++i)
+    found[i] = index.nearestInCryostat(points[i], cryostats[i]);
+  Duration_t const indexTime = Clock_t::now() - startIndex;
+
+  std::vector<OpDet_t> foundBatch(points.size());
+  auto const startBatch = Clock_t::now();
+  index.nearestInCryostat
+    (points.size(), points.data(), cryostats.data(), foundBatch.data());
+  Duration_t const batchTime = Clock_t::now() - startBatch;
+
+  unsigned int nMismatches = 0U;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if ((expected[i] == found[i]) && (found[i] == foundBatch[i])) continue;
+    if (++nMismatches <= 10U) {
+      std::cerr << "Mismatch at " << points[i] << ": LArSoft " << expected[i]
+        << ", index " << found[i] << " (batch: " << foundBatch[i] << ")"
+        << std::endl;
+    }
+  } // for
+
+  //
+  // optical detectors within the radius
+  //
+  std::size_t nLinear = 0U;
+  std::vector<OpDet_t> opDets;
+  auto const startLinear = Clock_t::now();
+  for (geo::Point_t const& point: points) {
+    opDets.clear();
+    for (OpDet_t opDet = 0U; opDet < geom->NOpDets(); ++opDet) {
+      if (geom->OpDetGeoFromOpDet(opDet).DistanceToPoint(point) <= radius)
+        opDets.push_back(opDet);
+    }
+    nLinear += opDets.size();
+  } // for
+  Duration_t const linearRadiusTime = Clock_t::now() - startLinear;
+
+  std::vector<std::size_t> offsets;
+  std::vector<OpDet_t> allOpDets;
+  auto const startRadius = Clock_t::now();
+  std::size_t const nIndex = index.withinRadius
+    (points.size(), points.data(), radius, offsets, allOpDets);
+  Duration_t const indexRadiusTime = Clock_t::now() - startRadius;
+
+  if (nIndex != nLinear) {
+    std::cerr << "Optical detectors within " << radius << " cm: "
+      << nLinear << " from linear scan, " << nIndex << " from index"
+      << std::endl;
+    ++nMismatches;
+  }
+
+  auto perQuery = [n=points.size()](Duration_t const& time)
+    { return time.count() / n * 1e6; };
+  std::cout << points.size() << " points\n"
+    << "  closest optical detector:\n"
+    << "    LArSoft:       " << perQuery(LArSoftTime) << " us/query\n"
+    << "    index:         " << perQuery(indexTime) << " us/query\n"
+    << "    index (batch): " << perQuery(batchTime) << " us/query\n"
+    << "  optical detectors within " << radius << " cm ("
+    << (double(nIndex) / points.size()) << " per point):\n"
+    << "    linear scan:   " << perQuery(linearRadiusTime) << " us/query\n"
+    << "    index (batch): " << perQuery(indexRadiusTime) << " us/query\n"
+    << "  mismatches: " << nMismatches
+    << std::endl;
+
+  return (nMismatches == 0U)? 0: 1;
+} // main()
@@ -0,0 +1,122 @@
+/**
+ * @file   rop_and_tpcset_building_benchmark_icarus.cxx
+ * @brief  Measures the scaling of `icarus::details::ROPandTPCsetBuildingAlg`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     rop_and_tpcset_building_benchmark_icarus ConfigurationFile [Iterations]
+ *
+ * The standard ICARUS geometry is loaded with
+ * `icarus::geo::LoadStandardICARUSgeometry()` from the FHiCL configuration
+ * file `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`).
+ * Synthetic geometries are then built by replicating its cryostats, so that
+ * they have 1, 2, 4, 8 and 16 times the original number of TPCs, and the
+ * algorithm building TPC sets and readout planes is run on each of them
+ * `Iterations` times (default: 10). The average time per run is printed,
+ * together with the time per TPC, which should stay about constant.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/details/ROPandTPCsetBuildingAlg.h"
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/GeometryData.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <iomanip> // std::setw()
+#include <chrono>
+#include <string>
+#include <utility> // std::move()
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Returns a list with `factor` copies of each cryostat in `geom`.
+  geo::GeometryData_t::CryostatList_t replicateCryostats
+    (geo::GeometryCore const& geom, unsigned int factor)
+  {
+    geo::GeometryData_t::CryostatList_t cryostats;
+    cryostats.reserve(geom.Ncryostats() * factor);
+    for (unsigned int i = 0; i < factor; ++i)
+      for (geo::CryostatGeo const& cryo: geom.IterateCryostats())
+        cryostats.push_back(cryo);
+
+    // assign consistent IDs to all the copies
+    for (std::size_t c = 0; c < cryostats.size(); ++c) {
+      cryostats[c].UpdateAfterSorting
+        (geo::CryostatID{ static_cast<geo::CryostatID::CryostatID_t>(c) });
+    }
+    return cryostats;
+  } // replicateCryostats()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [Iterations]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nIterations = (argc > 2)? std::atoi(argv[2]): 10;
+  if (nIterations <= 0) {
+    std::cerr << "Invalid number of iterations: '" << argv[2] << "'"
+      << std::endl;
+    return 1;
+  }
+
+  auto const geom = icarus::geo::LoadStandardICARUSgeometry(configPath);
+
+  std::cout << "Scale    TPCs    TPC sets   time/run [ms]   time/TPC [us]"
+    << std::endl;
+
+  for (unsigned int factor: { 1U, 2U, 4U, 8U, 16U }) {
+
+    geo::GeometryData_t::CryostatList_t const cryostats
+      = replicateCryostats(*geom, factor);
+
+    unsigned int const nTPCs = geom->TotalNTPC() * factor;
+    unsigned int nTPCsets = 0U;
+
+    icarus::details::ROPandTPCsetBuildingAlg builder
+      ("ROPandTPCsetBuildingAlgBenchmark");
+
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIterations; ++i) {
+      auto results = builder.run(cryostats);
+      nTPCsets = 0U;
+      for (unsigned int const n: std::move(results).TPCsetCount())
+        nTPCsets += n;
+    } // for iterations
+    std::chrono::duration<double> const elapsed
+      = std::chrono::steady_clock::now() - start;
+
+    double const timePerRun = elapsed.count() / nIterations;
+    std::cout
+      << std::setw(4) << factor << "x"
+      << std::setw(8) << nTPCs
+      << std::setw(12) << nTPCsets
+      << std::setw(16) << std::fixed << std::setprecision(3)
+        << (timePerRun * 1e3)
+      << std::setw(16) << std::fixed << std::setprecision(3)
+        << (timePerRun / nTPCs * 1e6)
+      << std::endl;
+
+  } // for scale factors
+
+  return 0;
+} // main()
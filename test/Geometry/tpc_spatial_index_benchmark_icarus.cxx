@@ -0,0 +1,172 @@
+/**
+ * @file   tpc_spatial_index_benchmark_icarus.cxx
+ * @brief  Compares `icarus::TPCspatialIndex` with LArSoft TPC search.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     tpc_spatial_index_benchmark_icarus ConfigurationFile [Points]
+ *
+ * The standard ICARUS geometry is loaded with
+ * `icarus::geo::LoadStandardICARUSgeometry()` from the FHiCL configuration
+ * file `ConfigurationFile` (e.g. `standard_g4_icarus.fcl`).
+ * `Points` points (default: 1000000) are generated, half of them inside random
+ * TPC and half uniformly in a box enclosing all the cryostats with some
+ * margin; for each point the TPC and TPC set containing it are looked for
+ * with both `geo::GeometryCore::PositionToTPCID()` (followed by
+ * `geo::GeometryCore::TPCtoTPCset()`) and the batch query
+ * `icarus::TPCspatialIndex::findTPCsAndTPCsets()`. The time per point of each
+ * method is printed, and the program fails if the two disagree.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Geometry/TPCspatialIndex.h"
+#include "icarusalg/Geometry/LoadStandardICARUSgeometry.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm> // std::min(), std::max()
+#include <cstdlib> // std::atoi()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using Clock_t = std::chrono::steady_clock;
+
+  if (argc < 2) {
+    std::cerr << "Usage:  " << argv[0] << "  ConfigurationFile [Points]"
+      << std::endl;
+    return 1;
+  }
+
+  std::string const configPath = argv[1];
+  int const nPoints = (argc > 2)? std::atoi(argv[2]): 1000000;
+  if (nPoints <= 0) {
+    std::cerr << "Invalid number of points: '" << argv[2] << "'" << std::endl;
+    return 1;
+  }
+
+  auto const geom = icarus::geo::LoadStandardICARUSgeometry(configPath);
+  if (geom->NTPC() == 0) {
+    std::cerr << "Geometry has no TPC!" << std::endl;
+    return 1;
+  }
+
+  //
+  // index construction
+  //
+  auto const startBuild = Clock_t::now();
+  icarus::TPCspatialIndex const index { *geom };
+  std::chrono::duration<double> const buildTime = Clock_t::now() - startBuild;
+
+  std::cout << "Index of " << index.nTPCs() << " TPC built in "
+    << (buildTime.count() * 1e3)
+    << " ms (grid: " << index.gridSize()[0] << " x " << index.gridSize()[1]
+    << " x " << index.gridSize()[2] << " cells)" << std::endl;
+
+  //
+  // test points
+  //
+  std::mt19937 engine { 12345 };
+  std::uniform_real_distribution<double> uniform { 0.0, 1.0 };
+
+  double min[3] { +1e9, +1e9, +1e9 }, max[3] { -1e9, -1e9, -1e9 };
+  std::vector<geo::TPCGeo const*> TPCs;
+  for (geo::CryostatGeo const& cryo: geom->IterateCryostats()) {
+    double const cmin[3] { cryo.MinX(), cryo.MinY(), cryo.MinZ() };
+    double const cmax[3] { cryo.MaxX(), cryo.MaxY(), cryo.MaxZ() };
+    for (int i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], cmin[i] - 50.0);
+      max[i] = std::max(max[i], cmax[i] + 50.0);
+    }
+    for (geo::TPCGeo const& tpc: cryo.IterateTPCs()) TPCs.push_back(&tpc);
+  } // for
+
+  std::vector<geo::Point_t> points;
+  points.reserve(nPoints);
+  for (int i = 0; i < nPoints; ++i) {
+    if (i % 2 == 0) {
+      geo::TPCGeo const& tpc = *(TPCs[engine() % TPCs.size()]);
+      points.emplace_back(
+        tpc.MinX() + (tpc.MaxX() - tpc.MinX()) * uniform(engine),
+        tpc.MinY() + (tpc.MaxY() - tpc.MinY()) * uniform(engine),
+        tpc.MinZ() + (tpc.MaxZ() - tpc.MinZ()) * uniform(engine)
+        );
+    }
+    else {
+      points.emplace_back(
+        min[0] + (max[0] - min[0]) * uniform(engine),
+        min[1] + (max[1] - min[1]) * uniform(engine),
+        min[2] + (max[2] - min[2]) * uniform(engine)
+        );
+    }
+  } // for
+
+  //
+  // LArSoft search
+  //
+  std::vector<geo::TPCID> expectedTPCs(points.size());
+  std::vector<readout::TPCsetID> expectedTPCsets(points.size());
+  auto const startLArSoft = Clock_t::now();
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    expectedTPCs[i] = geom->PositionToTPCID(points[i]);
+    if (expectedTPCs[i])
+      expectedTPCsets[i] = geom->TPCtoTPCset(expectedTPCs[i]);
+  } // for
+  std::chrono::duration<double> const LArSoftTime
+    = Clock_t::now() - startLArSoft;
+
+  //
+  // index search
+  //
+  std::vector<geo::TPCID> foundTPCs(points.size());
+  std::vector<readout::TPCsetID> foundTPCsets(points.size());
+  auto const startIndex = Clock_t::now();
+  index.findTPCsAndTPCsets
+    (points.size(), points.data(), foundTPCs.data(), foundTPCsets.data());
+  std::chrono::duration<double> const indexTime = Clock_t::now() - startIndex;
+
+  //
+  // comparison
+  //
+  unsigned int nFound = 0U, nMismatches = 0U;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if (expectedTPCs[i]) ++nFound;
+    if ((expectedTPCs[i] == foundTPCs[i])
+      && (expectedTPCsets[i] == foundTPCsets[i])
+    ) {
+      continue;
+    }
+    if (++nMismatches <= 10U) {
+      std::cerr << "Mismatch at " << points[i] << ": LArSoft ("
+        << expectedTPCs[i] << ", " << expectedTPCsets[i]
+        << "), index (" << foundTPCs[i] << ", " << foundTPCsets[i]
+        << ")" << std::endl;
+    }
+  } // for
+
+  std::cout << points.size() << " points, " << nFound << " inside TPC\n"
+    << "  LArSoft: " << (LArSoftTime.count() / points.size() * 1e6)
+    << " us/point\n"
+    << "  index:   " << (indexTime.count() / points.size() * 1e6)
+    << " us/point\n"
+    << "  mismatches: " << nMismatches
+    << std::endl;
+
+  return (nMismatches == 0U)? 0: 1;
+} // main()
@@ -0,0 +1,220 @@
+/**
+ * @file   PMTpairMajorityEmulator_test.cc
+ * @brief  Unit test for `opdet::PMTpairMajorityEmulator`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PMTpairMajorityEmulatorTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/PMTpairMajorityEmulator.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <algorithm> // std::max()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+using Emulator_t = opdet::PMTpairMajorityEmulator;
+
+constexpr double TickDuration = 0.002; // microseconds
+constexpr raw::ADC_Count_t Baseline = 15000;
+
+
+/// Emulates the trigger tick by tick on a time axis starting at `0`.
+Emulator_t::Result_t bruteForceTrigger(
+  Emulator_t::Params_t const& params,
+  std::vector<raw::OpDetWaveform> const& waveforms, std::size_t nTicks
+) {
+  // samples on the common time axis, positive polarity
+  std::vector<std::vector<int>> channels;
+  for (raw::OpDetWaveform const& waveform: waveforms) {
+    std::size_t const channel = waveform.ChannelNumber();
+    if (channel >= channels.size()) channels.resize(channel + 1);
+    channels[channel].resize(nTicks, 0);
+    long int const first = std::lround(waveform.TimeStamp() / TickDuration);
+    for (std::size_t i = 0; i < waveform.size(); ++i) {
+      long int const tick = first + i;
+      if ((tick < 0) || (tick >= static_cast<long int>(nTicks))) continue;
+      channels[channel][tick] = params.polarity * (waveform[i] - Baseline);
+    }
+  }
+  auto sample = [&channels](Emulator_t::Channel_t channel, std::size_t tick)
+    {
+      return ((channel < channels.size()) && !channels[channel].empty())
+        ? channels[channel][tick]: 0;
+    };
+
+  std::size_t const nPairs = params.pairs.size();
+  std::vector<std::vector<bool>> gates(nPairs, std::vector<bool>(nTicks));
+  for (std::size_t iPair = 0; iPair < nPairs; ++iPair) {
+    auto const [ first, second ] = params.pairs[iPair];
+    for (std::size_t tick = 0; tick < nTicks; ++tick) {
+      if (sample(first, tick) + sample(second, tick) < params.threshold)
+        continue;
+      for (std::size_t t = tick; t < std::min(tick + params.gateTicks, nTicks);
+        ++t
+      )
+        gates[iPair][t] = true;
+    } // for ticks
+  } // for pairs
+
+  std::size_t const windowPairs = (params.windowPairs == 0U)
+    ? nPairs: std::min(params.windowPairs, nPairs);
+  Emulator_t::Result_t result;
+  for (std::size_t tick = 0; tick < nTicks; ++tick) {
+    std::size_t iWindow = 0;
+    for (std::size_t start = 0; start + windowPairs <= nPairs;
+      start += params.windowStride, ++iWindow
+    ) {
+      Emulator_t::Count_t count = 0;
+      for (std::size_t iPair = start; iPair < start + windowPairs; ++iPair)
+        if (gates[iPair][tick]) ++count;
+      result.maxCount = std::max(result.maxCount, count);
+      if (!result.fired() && (count >= params.majority)) {
+        result.tick = tick;
+        result.window = iWindow;
+      }
+    } // for windows
+  } // for ticks
+  return result;
+} // bruteForceTrigger()
+
+
+//------------------------------------------------------------------------------
+void BasicTest() {
+
+  Emulator_t::Params_t params;
+  params.pairs = Emulator_t::standardPairs(5U);
+  params.polarity = -1;
+  params.threshold = 100;
+  params.gateTicks = 10U;
+  params.windowPairs = 2U;
+  params.windowStride = 1U;
+  params.majority = 2U;
+
+  BOOST_TEST(params.pairs.size() == 3U);
+  BOOST_TEST(params.pairs[0].second == 1U);
+  BOOST_TEST(params.pairs[2].second == Emulator_t::NoChannel);
+
+  Emulator_t emulator { params };
+  BOOST_TEST(emulator.nPairs() == 3U);
+  BOOST_TEST(emulator.nWindows() == 2U);
+
+  // pulses: channels 0 and 1 add up to the threshold at tick 20,
+  //         channel 2 alone reaches it at tick 25
+  std::vector<raw::ADC_Count_t> quiet(100U, Baseline);
+  std::vector<raw::ADC_Count_t> pulse0 = quiet, pulse1 = quiet, pulse2 = quiet;
+  pulse0[20] = Baseline - 60;
+  pulse1[20] = Baseline - 40;
+  pulse2[25] = Baseline - 100;
+  std::vector<raw::OpDetWaveform> const waveforms {
+    raw::OpDetWaveform{ 0.0, 0U, pulse0 },
+    raw::OpDetWaveform{ 0.0, 1U, pulse1 },
+    raw::OpDetWaveform{ 0.0, 2U, pulse2 },
+    raw::OpDetWaveform{ 0.0, 3U, quiet },
+    raw::OpDetWaveform{ 0.0, 4U, quiet },
+  };
+
+  emulator.setup(0.0, TickDuration, 100U);
+  emulator.addWaveforms
+    (waveforms, std::vector<raw::ADC_Count_t>(5U, Baseline));
+  Emulator_t::Result_t const result = emulator.process();
+
+  BOOST_TEST(emulator.channelSamples(2U)[25] == 100);
+  BOOST_TEST(emulator.pairSamples(0U)[20] == 100);
+  BOOST_TEST(emulator.pairGates(0U)[19] == 0U);
+  BOOST_TEST(emulator.pairGates(0U)[20] == 1U);
+  BOOST_TEST(emulator.pairGates(0U)[29] == 1U);
+  BOOST_TEST(emulator.pairGates(0U)[30] == 0U);
+  BOOST_TEST(emulator.windowCounts(0U)[27] == 2U);
+  BOOST_TEST(emulator.windowCounts(1U)[27] == 1U);
+
+  BOOST_TEST(result.fired());
+  BOOST_TEST(result.tick == 25U);
+  BOOST_TEST(result.window == 0U);
+  BOOST_TEST(result.maxCount == 2U);
+
+  // a higher majority is not reached
+  params.majority = 3U;
+  Emulator_t strict { params };
+  strict.setup(0.0, TickDuration, 100U);
+  strict.addWaveforms(waveforms, std::vector<raw::ADC_Count_t>(5U, Baseline));
+  BOOST_TEST(!strict.process());
+
+} // BasicTest()
+
+
+//------------------------------------------------------------------------------
+void RandomTest() {
+
+  constexpr std::size_t NChannels = 40U;
+  constexpr std::size_t NTicks = 3000U;
+
+  std::mt19937 engine { 2468 };
+  std::uniform_real_distribution<double> startDist
+    { -500 * TickDuration, NTicks * TickDuration };
+  std::uniform_int_distribution<std::size_t> lengthDist { 1U, 1500U };
+  std::uniform_int_distribution<int> noiseDist { -3, 3 };
+  std::uniform_int_distribution<int> pulseDist { 0, 400 };
+
+  Emulator_t::Params_t params;
+  params.pairs = Emulator_t::standardPairs(NChannels);
+  params.polarity = -1;
+  params.threshold = 300;
+  params.gateTicks = 37U;
+  params.windowPairs = 6U;
+  params.windowStride = 3U;
+  params.majority = 3U;
+  Emulator_t emulator { params };
+
+  for (unsigned int iEvent = 0; iEvent < 20U; ++iEvent) {
+    BOOST_TEST_CONTEXT("event #" << iEvent) {
+
+      std::vector<raw::OpDetWaveform> waveforms;
+      for (std::size_t channel = 0; channel < NChannels; ++channel) {
+        std::vector<raw::ADC_Count_t> samples(lengthDist(engine));
+        for (raw::ADC_Count_t& sample: samples) {
+          sample = Baseline + noiseDist(engine);
+          if (pulseDist(engine) == 0) sample -= pulseDist(engine);
+        }
+        waveforms.emplace_back(startDist(engine), channel, std::move(samples));
+      } // for channels
+
+      Emulator_t::Result_t const expected
+        = bruteForceTrigger(params, waveforms, NTicks);
+
+      emulator.setup(0.0, TickDuration, NTicks); // reused across events
+      emulator.addWaveforms
+        (waveforms, std::vector<raw::ADC_Count_t>(NChannels, Baseline));
+      Emulator_t::Result_t const result = emulator.process();
+
+      BOOST_TEST(result.tick == expected.tick);
+      BOOST_TEST(result.window == expected.window);
+      BOOST_TEST(result.maxCount == expected.maxCount);
+
+    } // context
+  } // for events
+
+} // RandomTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(PMTpairMajorityEmulatorTestCase) {
+
+  BasicTest();
+  RandomTest();
+
+} // BOOST_AUTO_TEST_CASE(PMTpairMajorityEmulatorTestCase)
+
+
+//------------------------------------------------------------------------------
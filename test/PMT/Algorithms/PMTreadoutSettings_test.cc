@@ -0,0 +1,102 @@
+/**
+ * @file   PMTreadoutSettings_test.cc
+ * @brief  Unit test for `opdet::PMTreadoutSettings`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/PMTreadoutSettings.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PMTreadoutSettingsTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/PMTreadoutSettings.h"
+
+// C/C++ standard libraries
+#include <stdexcept> // std::out_of_range, std::runtime_error
+
+
+//------------------------------------------------------------------------------
+void ChannelSettingTableTest() {
+
+  opdet::ChannelSettingTable<int> table;
+
+  BOOST_TEST(table.empty());
+  BOOST_TEST(!table.contains(0));
+  BOOST_TEST(table(5, -1) == -1);
+  BOOST_TEST(table.get(5) == nullptr);
+  BOOST_CHECK_THROW(table(5), std::out_of_range);
+
+  table.set(5, 50);
+  table.set(130, 1300); // beyond the first bitmap word
+  BOOST_TEST(!table.empty());
+  BOOST_TEST(table.nSet() == 2U);
+  BOOST_TEST(table.size() == 131U);
+  BOOST_TEST(table.contains(5));
+  BOOST_TEST(table.contains(130));
+  BOOST_TEST(!table.contains(4));
+  BOOST_TEST(!table.contains(64));
+  BOOST_TEST(!table.contains(1000));
+  BOOST_TEST(table(5) == 50);
+  BOOST_TEST(table(130, -1) == 1300);
+  BOOST_TEST(table(129, -1) == -1);
+  BOOST_TEST_REQUIRE(table.get(130) != nullptr);
+  BOOST_TEST(*table.get(130) == 1300);
+
+  table.set(5, 55); // replacement
+  BOOST_TEST(table.nSet() == 2U);
+  BOOST_TEST(table(5) == 55);
+
+  table.clear();
+  BOOST_TEST(table.empty());
+  BOOST_TEST(!table.contains(5));
+
+} // ChannelSettingTableTest()
+
+
+//------------------------------------------------------------------------------
+void PMTreadoutSettingsTest() {
+
+  opdet::PMTreadoutSettings settings { 360U };
+  BOOST_TEST(settings.baselines().size() == 360U);
+  BOOST_TEST(settings.baselines().empty());
+
+  settings.add({ 0U, 14900, 14500, 1, 15 });
+  settings.add({ 1U, 14950, std::nullopt, 1, 13 });
+  settings.add({ 359U, std::nullopt, 14400, std::nullopt, std::nullopt });
+
+  BOOST_TEST(settings.baselines().nSet() == 2U);
+  BOOST_TEST(settings.thresholds().nSet() == 2U);
+  BOOST_TEST(settings.boardNumbers().nSet() == 2U);
+  BOOST_TEST(settings.boardChannels().nSet() == 2U);
+
+  BOOST_TEST(settings.baselines()(0U) == 14900);
+  BOOST_TEST(settings.baselines()(1U) == 14950);
+  BOOST_TEST(!settings.baselines().contains(359U));
+  BOOST_TEST(settings.thresholds()(0U) == 14500);
+  BOOST_TEST(!settings.thresholds().contains(1U));
+  BOOST_TEST(settings.thresholds()(359U) == 14400);
+  BOOST_TEST(settings.boardChannels()(1U) == 13);
+
+  // a setting can't be set twice, but different settings can
+  BOOST_CHECK_THROW(
+    settings.add({ 0U, 14000, std::nullopt, std::nullopt, std::nullopt }),
+    std::runtime_error
+    );
+  settings.add({ 1U, std::nullopt, 14550, std::nullopt, std::nullopt });
+  BOOST_TEST(settings.thresholds()(1U) == 14550);
+
+} // PMTreadoutSettingsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(PMTreadoutSettingsTestCase) {
+
+  ChannelSettingTableTest();
+  PMTreadoutSettingsTest();
+
+} // BOOST_AUTO_TEST_CASE(PMTreadoutSettingsTestCase)
+
+
+//------------------------------------------------------------------------------
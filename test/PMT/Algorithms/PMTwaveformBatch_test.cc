@@ -0,0 +1,132 @@
+/**
+ * @file   PMTwaveformBatch_test.cc
+ * @brief  Unit test for `opdet::PMTwaveformBatch`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/PMTwaveformBatch.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PMTwaveformBatchTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/PMTwaveformBatch.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+void BasicTest() {
+
+  opdet::PMTwaveformBatch batch{ { -1, 4U, 10 } };
+  BOOST_TEST(batch.empty());
+
+  std::vector<raw::OpDetWaveform> const waveforms {
+    raw::OpDetWaveform{ 0.0, 0U, { 100, 102, 100, 102, 90, 80, 101 } },
+    raw::OpDetWaveform{ 0.0, 1U, { 200, 200 } }, // shorter than baseline
+    raw::OpDetWaveform{ 0.0, 2U, {} },
+  };
+  batch.add(waveforms);
+  BOOST_TEST(batch.size() == 3U);
+  BOOST_TEST(batch.nSamples() == 9U);
+  BOOST_TEST(batch.nSamples(0U) == 7U);
+  BOOST_TEST(batch.nSamples(2U) == 0U);
+
+  batch.process(opdet::PMTwaveformBatch::Backend::Reference);
+
+  BOOST_TEST(batch.baseline(0U) == 101.0f);
+  BOOST_TEST(batch.baselineRMS(0U) == 1.0f);
+  BOOST_TEST(batch.baseline(1U) == 200.0f);
+  BOOST_TEST(batch.baselineRMS(1U) == 0.0f);
+  BOOST_TEST(batch.baseline(2U) == 0.0f);
+
+  std::vector<raw::ADC_Count_t> const expected { 1, -1, 1, -1, 11, 21, 0 };
+  std::vector<raw::ADC_Count_t> const subtracted
+    (batch.subtracted(0U), batch.subtracted(0U) + batch.nSamples(0U));
+  BOOST_TEST(subtracted == expected, boost::test_tools::per_element());
+
+  std::vector<opdet::PMTwaveformBatch::Gate_t> const expectedGates
+    { 0, 0, 0, 0, 1, 1, 0 };
+  std::vector<opdet::PMTwaveformBatch::Gate_t> const gates
+    (batch.gates(0U), batch.gates(0U) + batch.nSamples(0U));
+  BOOST_TEST(gates == expectedGates, boost::test_tools::per_element());
+
+  batch.clear();
+  BOOST_TEST(batch.empty());
+  BOOST_TEST(batch.nSamples() == 0U);
+
+} // BasicTest()
+
+
+//------------------------------------------------------------------------------
+void BackendComparisonTest() {
+
+  using Backend = opdet::PMTwaveformBatch::Backend;
+
+  std::mt19937 engine { 1357 };
+  std::normal_distribution<double> noise { 0.0, 2.5 };
+  std::uniform_int_distribution<std::size_t> lengthDist { 1U, 12000U };
+  std::uniform_int_distribution<int> pulseDist { 0, 500 };
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (unsigned int channel = 0; channel < 360U; ++channel) {
+    std::vector<raw::ADC_Count_t> samples(lengthDist(engine));
+    raw::ADC_Count_t const baseline = 14900 + channel % 50;
+    for (raw::ADC_Count_t& sample: samples) {
+      sample = baseline + static_cast<raw::ADC_Count_t>(noise(engine));
+      if (pulseDist(engine) == 0) sample -= pulseDist(engine);
+    }
+    waveforms.emplace_back(0.0, channel, std::move(samples));
+  } // for
+
+  opdet::PMTwaveformBatch::Params_t const params { -1, 50U, 15 };
+  opdet::PMTwaveformBatch reference { params }, parallel { params };
+  reference.add(waveforms);
+  parallel.add(waveforms);
+  reference.process(Backend::Reference);
+  parallel.process(Backend::Parallel);
+
+  BOOST_TEST_REQUIRE(parallel.size() == reference.size());
+  BOOST_TEST_REQUIRE(parallel.nSamples() == reference.nSamples());
+  for (std::size_t i = 0; i < reference.size(); ++i) {
+    BOOST_TEST_CONTEXT("waveform #" << i) {
+      BOOST_TEST(parallel.baseline(i) == reference.baseline(i),
+        1e-6 % boost::test_tools::tolerance());
+      BOOST_TEST(parallel.baselineRMS(i) == reference.baselineRMS(i),
+        1e-6 % boost::test_tools::tolerance());
+
+      std::size_t const n = reference.nSamples(i);
+      std::vector<raw::ADC_Count_t> const refSamples
+        (reference.subtracted(i), reference.subtracted(i) + n);
+      std::vector<raw::ADC_Count_t> const parSamples
+        (parallel.subtracted(i), parallel.subtracted(i) + n);
+      BOOST_TEST(parSamples == refSamples);
+
+      std::vector<opdet::PMTwaveformBatch::Gate_t> const refGates
+        (reference.gates(i), reference.gates(i) + n);
+      std::vector<opdet::PMTwaveformBatch::Gate_t> const parGates
+        (parallel.gates(i), parallel.gates(i) + n);
+      BOOST_TEST(parGates == refGates);
+    } // context
+  } // for
+
+} // BackendComparisonTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(PMTwaveformBatchTestCase) {
+
+  BasicTest();
+  BackendComparisonTest();
+
+} // BOOST_AUTO_TEST_CASE(PMTwaveformBatchTestCase)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,158 @@
+/**
+ * @file   PMTwaveformTimeIndex_test.cc
+ * @brief  Unit test for `opdet::PMTwaveformTimeIndex`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PMTwaveformTimeIndexTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/PMTwaveformTimeIndex.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::is_permutation()
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+constexpr double TickDuration = 0.002; // microseconds
+
+/// Returns the waveforms overlapping `[ start, stop [` by checking all.
+std::vector<std::size_t> bruteForceOverlaps(
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  double start, double stop, long int channel = -1
+) {
+  std::vector<std::size_t> found;
+  for (std::size_t i = 0; i < waveforms.size(); ++i) {
+    raw::OpDetWaveform const& waveform = waveforms[i];
+    if ((channel >= 0) && (waveform.ChannelNumber() != channel)) continue;
+    double const end = waveform.TimeStamp() + waveform.size() * TickDuration;
+    if ((waveform.TimeStamp() < stop) && (end > start)) found.push_back(i);
+  }
+  return found;
+} // bruteForceOverlaps()
+
+
+/// Returns whether `positions` are sorted by waveform start time.
+bool sortedByTime(
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  std::vector<std::size_t> const& positions
+) {
+  for (std::size_t i = 1; i < positions.size(); ++i) {
+    if (waveforms[positions[i]].TimeStamp()
+      < waveforms[positions[i - 1]].TimeStamp()
+    )
+      return false;
+  }
+  return true;
+} // sortedByTime()
+
+
+//------------------------------------------------------------------------------
+void BasicTest() {
+
+  std::vector<raw::OpDetWaveform> const waveforms {
+    raw::OpDetWaveform{ 5.0, 2U, std::vector<raw::ADC_Count_t>(1000U) },
+    raw::OpDetWaveform{ -2.0, 1U, std::vector<raw::ADC_Count_t>(500U) },
+    raw::OpDetWaveform{ 0.0, 2U, std::vector<raw::ADC_Count_t>(5000U) },
+  };
+  // spans: #0 [ 5, 7 [, #1 [ -2, -1 [, #2 [ 0, 10 [
+
+  opdet::PMTwaveformTimeIndex const index { waveforms, TickDuration };
+
+  BOOST_TEST(index.size() == 3U);
+  BOOST_TEST(!index.hasChannelPartitions());
+  BOOST_TEST(index.sorted() == (std::vector<std::size_t>{ 1U, 2U, 0U }));
+  BOOST_TEST(index.endTime(0U) == 7.0);
+  BOOST_TEST(&index.waveform(1U) == &waveforms[1U]);
+
+  using Positions_t = std::vector<std::size_t>;
+  BOOST_TEST(index.overlapping(-5.0, -2.0).empty());
+  BOOST_TEST(index.overlapping(-5.0, 0.0) == Positions_t{ 1U });
+  BOOST_TEST(index.overlapping(-1.0, 0.0).empty());
+  BOOST_TEST(index.overlapping(6.0, 6.5) == (Positions_t{ 2U, 0U }));
+  BOOST_TEST(index.overlapping(-10.0, 20.0) == (Positions_t{ 1U, 2U, 0U }));
+  BOOST_TEST(index.overlapping(8.0, 8.0).empty());
+  BOOST_TEST(index.overlapping(2U, 4.0, 6.0) == (Positions_t{ 2U, 0U }));
+  BOOST_TEST(index.overlapping(1U, 4.0, 6.0).empty());
+  BOOST_TEST(index.at(7.0) == Positions_t{ 2U });
+  BOOST_TEST(index.at(5.0) == (Positions_t{ 2U, 0U }));
+
+  opdet::PMTwaveformTimeIndex const emptyIndex
+    { std::vector<raw::OpDetWaveform>{}, TickDuration, true };
+  BOOST_TEST(emptyIndex.empty());
+  BOOST_TEST(emptyIndex.overlapping(-10.0, 20.0).empty());
+  BOOST_TEST(emptyIndex.overlapping(0U, -10.0, 20.0).empty());
+
+} // BasicTest()
+
+
+//------------------------------------------------------------------------------
+void RandomTest() {
+
+  std::mt19937 engine { 4321 };
+  std::uniform_real_distribution<double> timeDist { -1500.0, 1500.0 };
+  std::uniform_int_distribution<unsigned int> channelDist { 0U, 359U };
+  std::uniform_int_distribution<std::size_t> sizeDist { 1U, 20000U };
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (unsigned int i = 0; i < 5000U; ++i) {
+    waveforms.emplace_back(timeDist(engine), channelDist(engine),
+      std::vector<raw::ADC_Count_t>(sizeDist(engine)));
+  }
+
+  opdet::PMTwaveformTimeIndex const index { waveforms, TickDuration };
+  opdet::PMTwaveformTimeIndex const channelIndex
+    { waveforms, TickDuration, true };
+  BOOST_TEST(channelIndex.hasChannelPartitions());
+  BOOST_TEST(sortedByTime(waveforms, index.sorted()));
+
+  for (unsigned int iQuery = 0; iQuery < 200U; ++iQuery) {
+    double const start = timeDist(engine);
+    double const stop = start + timeDist(engine) / 30.0 + 50.0;
+    unsigned int const channel = channelDist(engine);
+    BOOST_TEST_CONTEXT("query: [ " << start << " ; " << stop << " ]") {
+
+      std::vector<std::size_t> const found = index.overlapping(start, stop);
+      std::vector<std::size_t> const expected
+        = bruteForceOverlaps(waveforms, start, stop);
+      BOOST_TEST(found.size() == expected.size());
+      BOOST_TEST(sortedByTime(waveforms, found));
+      BOOST_TEST(
+        std::is_permutation(found.begin(), found.end(), expected.begin()));
+
+      std::vector<std::size_t> const expectedOnChannel
+        = bruteForceOverlaps(waveforms, start, stop, channel);
+      for (auto const* idx: { &index, &channelIndex }) {
+        std::vector<std::size_t> const foundOnChannel
+          = idx->overlapping(channel, start, stop);
+        BOOST_TEST(foundOnChannel.size() == expectedOnChannel.size());
+        BOOST_TEST(sortedByTime(waveforms, foundOnChannel));
+        BOOST_TEST(std::is_permutation(foundOnChannel.begin(),
+          foundOnChannel.end(), expectedOnChannel.begin()));
+      } // for
+    } // context
+  } // for queries
+
+} // RandomTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(PMTwaveformTimeIndexTestCase) {
+
+  BasicTest();
+  RandomTest();
+
+} // BOOST_AUTO_TEST_CASE(PMTwaveformTimeIndexTestCase)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,353 @@
+/**
+ * @file   SharedWaveformBaseline_test.cc
+ * @brief  Unit test for `opdet::SharedWaveformBaseline`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/SharedWaveformBaseline.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE SharedWaveformBaselineTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/SharedWaveformBaseline.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cmath> // std::sqrt()
+#include <utility> // std::move()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+using BaselineAlg_t = opdet::SharedWaveformBaseline;
+using BaselineInfo_t = BaselineAlg_t::BaselineInfo_t;
+using Waveforms_t = std::vector<raw::OpDetWaveform const*>;
+
+/// Default parameters: 20 samples, 3 RMS, 5 samples in a row.
+BaselineAlg_t::Params_t const DefaultParams { 20U, 3.0, 5U };
+
+/// RMS of the quiet noise from `quietWaveform()`.
+double const QuietRMS = std::sqrt(0.5);
+
+
+/// Returns `nSamples` samples around `level`, with RMS `QuietRMS`.
+std::vector<raw::ADC_Count_t> quietSamples
+  (std::size_t nSamples, raw::ADC_Count_t level)
+{
+  static constexpr int Noise[] = { 0, +1, 0, -1 };
+  std::vector<raw::ADC_Count_t> samples;
+  samples.reserve(nSamples);
+  for (std::size_t i = 0; i < nSamples; ++i)
+    samples.push_back(static_cast<raw::ADC_Count_t>(level + Noise[i % 4]));
+  return samples;
+} // quietSamples()
+
+
+/// Returns a waveform on `channel` with `nSamples` quiet samples at `level`.
+raw::OpDetWaveform quietWaveform
+  (raw::Channel_t channel, std::size_t nSamples, raw::ADC_Count_t level)
+  { return { 0.0, channel, quietSamples(nSamples, level) }; }
+
+
+/// Returns a waveform on `channel` with `nFirst` samples at `first`, then
+/// `nSecond` samples at `second`.
+raw::OpDetWaveform stepWaveform(
+  raw::Channel_t channel,
+  std::size_t nFirst, raw::ADC_Count_t first,
+  std::size_t nSecond, raw::ADC_Count_t second
+) {
+  std::vector<raw::ADC_Count_t> samples(nFirst, first);
+  samples.insert(samples.end(), nSecond, second);
+  return { 0.0, channel, std::move(samples) };
+} // stepWaveform()
+
+
+/// Returns pointers to all the `waveforms`.
+Waveforms_t pointersTo(std::vector<raw::OpDetWaveform> const& waveforms) {
+  Waveforms_t pointers;
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    pointers.push_back(&waveform);
+  return pointers;
+} // pointersTo()
+
+
+/// Checks that the two results are the same.
+void checkSameBaseline
+  (BaselineInfo_t const& result, BaselineInfo_t const& expected)
+{
+  BOOST_TEST(result.baseline == expected.baseline);
+  BOOST_TEST
+    (result.RMS == expected.RMS, 1e-9 % boost::test_tools::tolerance());
+  BOOST_TEST(result.nWaveforms == expected.nWaveforms);
+  BOOST_TEST(result.nSamples == expected.nSamples);
+} // checkSameBaseline()
+
+
+//------------------------------------------------------------------------------
+void agreementTest() {
+  /*
+   * Four quiet waveforms and one with a dip at its beginning:
+   * both modes exclude the latter and average the others.
+   */
+  BaselineAlg_t const alg { DefaultParams, "SharedWaveformBaselineTest" };
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (int i = 0; i < 4; ++i) waveforms.push_back(quietWaveform(5, 60, 1000));
+  waveforms.push_back(stepWaveform(5, 10, 900, 50, 1000));
+  Waveforms_t const group = pointersTo(waveforms);
+
+  BaselineInfo_t const standard = alg(group);
+  BOOST_TEST(standard.baseline == 1000.0);
+  BOOST_TEST(standard.RMS == QuietRMS, 1e-6 % boost::test_tools::tolerance());
+  BOOST_TEST(standard.nWaveforms == 4U);
+  BOOST_TEST(standard.nSamples == 80U);
+
+  BaselineAlg_t::Workspace_t workspace;
+  checkSameBaseline(alg(group, workspace), standard);
+
+  // the workspace can be reused, with the same result
+  checkSameBaseline(alg(group, workspace), standard);
+
+} // agreementTest()
+
+
+//------------------------------------------------------------------------------
+void firstPortionMedianTest() {
+  /*
+   * The first 20 samples of each waveform are at 1000, the other ones at 1100.
+   * The standard mode takes the median from all the samples (1100), and then
+   * excludes all the waveforms; the single-pass mode uses only the first
+   * portion (1000), and includes all of them.
+   */
+  BaselineAlg_t const alg { DefaultParams, "SharedWaveformBaselineTest" };
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (int i = 0; i < 3; ++i)
+    waveforms.push_back(stepWaveform(7, 20, 1000, 80, 1100));
+  Waveforms_t const group = pointersTo(waveforms);
+
+  BaselineInfo_t const standard = alg(group);
+  BOOST_TEST(standard.baseline == 1100.0); // median of the medians
+  BOOST_TEST(standard.RMS == 0.0);
+  BOOST_TEST(standard.nWaveforms == 3U);
+  BOOST_TEST(standard.nSamples == 0U);
+
+  BaselineAlg_t::Workspace_t workspace;
+  BaselineInfo_t const singlePass = alg(group, workspace);
+  BOOST_TEST(singlePass.baseline == 1000.0);
+  BOOST_TEST(singlePass.RMS == 0.0);
+  BOOST_TEST(singlePass.nWaveforms == 3U);
+  BOOST_TEST(singlePass.nSamples == 60U);
+
+} // firstPortionMedianTest()
+
+
+//------------------------------------------------------------------------------
+void shortWaveformTest() {
+  /*
+   * A waveform shorter than the first portion is ignored by the single-pass
+   * mode (the standard mode does not support it).
+   */
+  BaselineAlg_t const alg { DefaultParams, "SharedWaveformBaselineTest" };
+  BaselineAlg_t::Workspace_t workspace;
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (int i = 0; i < 3; ++i) waveforms.push_back(quietWaveform(2, 60, 1000));
+  Waveforms_t const longGroup = pointersTo(waveforms);
+
+  waveforms.push_back(quietWaveform(2, 10, 2000));
+  Waveforms_t const group = pointersTo(waveforms);
+
+  BaselineInfo_t const expected = alg(longGroup);
+  BOOST_TEST(expected.baseline == 1000.0);
+  BOOST_TEST(expected.nWaveforms == 3U);
+  BOOST_TEST(expected.nSamples == 60U);
+
+  checkSameBaseline(alg(group, workspace), expected);
+
+  // with only short waveforms, the median of their medians is used
+  std::vector<raw::OpDetWaveform> shortWaveforms;
+  for (raw::ADC_Count_t const level: { 1000, 1010, 1020 })
+    shortWaveforms.push_back(stepWaveform(2, 10, level, 0, level));
+  Waveforms_t const shortGroup = pointersTo(shortWaveforms);
+
+  BaselineInfo_t const shortBaseline = alg(shortGroup, workspace);
+  BOOST_TEST(shortBaseline.baseline == 1010.0);
+  BOOST_TEST(shortBaseline.RMS == BaselineInfo_t::NoInfo);
+  BOOST_TEST(shortBaseline.nWaveforms == 3U);
+  BOOST_TEST(shortBaseline.nSamples == 0U);
+
+} // shortWaveformTest()
+
+
+//------------------------------------------------------------------------------
+void allExcludedTest() {
+  /*
+   * Each waveform has half of its first portion 10 ADC away from the other
+   * half, with an acceptance range of 1 RMS (5 ADC): all waveforms are
+   * excluded, and both modes fall back to the median of the medians.
+   */
+  BaselineAlg_t const alg
+    { { 20U, 1.0, 5U }, "SharedWaveformBaselineTest" };
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (int i = 0; i < 3; ++i)
+    waveforms.push_back(stepWaveform(3, 10, 1000, 10, 1010));
+  Waveforms_t const group = pointersTo(waveforms);
+
+  BaselineInfo_t const standard = alg(group);
+  BOOST_TEST((standard.baseline == 1000.0 || standard.baseline == 1010.0));
+  BOOST_TEST(standard.RMS == 5.0, 1e-6 % boost::test_tools::tolerance());
+  BOOST_TEST(standard.nWaveforms == 3U);
+  BOOST_TEST(standard.nSamples == 0U);
+
+  BaselineAlg_t::Workspace_t workspace;
+  checkSameBaseline(alg(group, workspace), standard);
+
+} // allExcludedTest()
+
+
+//------------------------------------------------------------------------------
+void emptyGroupTest() {
+
+  BaselineAlg_t const alg { DefaultParams, "SharedWaveformBaselineTest" };
+  BaselineAlg_t::Workspace_t workspace;
+
+  Waveforms_t const noWaveforms;
+  BaselineInfo_t const standard = alg(noWaveforms);
+  BaselineInfo_t const singlePass = alg(noWaveforms, workspace);
+  for (BaselineInfo_t const& info: { standard, singlePass }) {
+    BOOST_TEST(info.baseline == BaselineInfo_t::NoInfo);
+    BOOST_TEST(info.RMS == BaselineInfo_t::NoInfo);
+    BOOST_TEST(info.nWaveforms == 0U);
+    BOOST_TEST(info.nSamples == 0U);
+  } // for
+
+} // emptyGroupTest()
+
+
+//------------------------------------------------------------------------------
+void channelBaselinesTest() {
+  /*
+   * Baselines of many channels, some without waveforms, with different numbers
+   * of threads: the results must be the same as one channel at a time.
+   */
+  BaselineAlg_t const alg { DefaultParams, "SharedWaveformBaselineTest" };
+
+  constexpr raw::Channel_t NChannels = 60;
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (raw::Channel_t channel = 0; channel < NChannels; ++channel) {
+    if (channel % 7 == 3) continue; // no waveform on this channel
+    raw::ADC_Count_t const level = 1000 + 5 * (channel % 11);
+    for (unsigned int i = 0; i < 1 + channel % 4; ++i)
+      waveforms.push_back(quietWaveform(channel, 40 + 10 * i, level));
+    if (channel % 5 == 0) // excluded waveform
+      waveforms.push_back(stepWaveform(channel, 10, level - 100, 30, level));
+  } // for
+
+  std::vector<Waveforms_t> byChannel(NChannels);
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    byChannel[waveform.ChannelNumber()].push_back(&waveform);
+
+  std::vector<BaselineInfo_t> expected;
+  BaselineAlg_t::Workspace_t workspace;
+  for (Waveforms_t const& group: byChannel)
+    expected.push_back(group.empty()? BaselineInfo_t{}: alg(group, workspace));
+
+  auto const checkBaselines = [&expected](std::vector<BaselineInfo_t> const& b)
+    {
+      BOOST_TEST_REQUIRE(b.size() == expected.size());
+      for (std::size_t channel = 0; channel < b.size(); ++channel) {
+        BOOST_TEST_CONTEXT("channel " << channel) {
+          checkSameBaseline(b[channel], expected[channel]);
+        }
+      } // for
+    };
+
+  for (unsigned int const nThreads: { 1U, 4U, 0U }) {
+    BOOST_TEST_CONTEXT("threads: " << nThreads) {
+      checkBaselines(alg.channelBaselines(byChannel, nThreads));
+    }
+  } // for
+
+  std::vector<BaselineAlg_t::Workspace_t> workspaces(3);
+  checkBaselines(alg.channelBaselines(byChannel, workspaces));
+  checkBaselines(alg.channelBaselines(byChannel, workspaces)); // reused
+
+  std::vector<BaselineAlg_t::Workspace_t> noWorkspaces;
+  checkBaselines(alg.channelBaselines(byChannel, noWorkspaces));
+  BOOST_TEST(noWorkspaces.size() == 1U);
+
+} // channelBaselinesTest()
+
+
+//------------------------------------------------------------------------------
+void channelBaselinesExceptionTest() {
+  /*
+   * Channels with only empty waveforms make the extraction throw;
+   * the exception must reach the caller, whichever thread processed them.
+   */
+  BaselineAlg_t const alg { DefaultParams, "SharedWaveformBaselineTest" };
+
+  constexpr raw::Channel_t NChannels = 40;
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (raw::Channel_t channel = 0; channel < NChannels; ++channel) {
+    if (channel % 8 == 5) // empty waveform
+      waveforms.push_back(stepWaveform(channel, 0, 1000, 0, 1000));
+    else
+      waveforms.push_back(quietWaveform(channel, 60, 1000));
+  } // for
+
+  std::vector<Waveforms_t> byChannel(NChannels);
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    byChannel[waveform.ChannelNumber()].push_back(&waveform);
+
+  BaselineAlg_t::Workspace_t workspace;
+  BOOST_CHECK_THROW(alg(byChannel[5], workspace), cet::exception);
+
+  for (unsigned int const nThreads: { 1U, 4U, 0U }) {
+    BOOST_TEST_CONTEXT("threads: " << nThreads) {
+      BOOST_CHECK_THROW
+        (alg.channelBaselines(byChannel, nThreads), cet::exception);
+    }
+  } // for
+
+} // channelBaselinesExceptionTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( AgreementTestCase ) {
+  agreementTest();
+} // BOOST_AUTO_TEST_CASE( AgreementTestCase )
+
+BOOST_AUTO_TEST_CASE( FirstPortionMedianTestCase ) {
+  firstPortionMedianTest();
+} // BOOST_AUTO_TEST_CASE( FirstPortionMedianTestCase )
+
+BOOST_AUTO_TEST_CASE( ShortWaveformTestCase ) {
+  shortWaveformTest();
+} // BOOST_AUTO_TEST_CASE( ShortWaveformTestCase )
+
+BOOST_AUTO_TEST_CASE( AllExcludedTestCase ) {
+  allExcludedTest();
+} // BOOST_AUTO_TEST_CASE( AllExcludedTestCase )
+
+BOOST_AUTO_TEST_CASE( EmptyGroupTestCase ) {
+  emptyGroupTest();
+} // BOOST_AUTO_TEST_CASE( EmptyGroupTestCase )
+
+BOOST_AUTO_TEST_CASE( ChannelBaselinesTestCase ) {
+  channelBaselinesTest();
+} // BOOST_AUTO_TEST_CASE( ChannelBaselinesTestCase )
+
+BOOST_AUTO_TEST_CASE( ChannelBaselinesExceptionTestCase ) {
+  channelBaselinesExceptionTest();
+} // BOOST_AUTO_TEST_CASE( ChannelBaselinesExceptionTestCase )
@@ -0,0 +1,120 @@
+/**
+ * @file   StreamingWaveformBaseline_test.cc
+ * @brief  Unit test for `opdet::StreamingWaveformBaseline`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/StreamingWaveformBaseline.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE StreamingWaveformBaselineTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/StreamingWaveformBaseline.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::nth_element(), std::max()
+#include <iterator> // std::back_inserter()
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+using Sample_t = opdet::StreamingWaveformBaseline::Sample_t;
+
+/// Returns the median of the `window` samples up to `i` (included).
+Sample_t referenceBaseline
+  (std::vector<Sample_t> const& samples, std::size_t i, std::size_t window)
+{
+  std::size_t const first = (i + 1 >= window)? i + 1 - window: 0U;
+  std::vector<Sample_t> data
+    { samples.begin() + first, samples.begin() + i + 1 };
+  auto const middle = data.begin() + data.size() / 2;
+  std::nth_element(data.begin(), middle, data.end());
+  return *middle;
+} // referenceBaseline()
+
+
+//------------------------------------------------------------------------------
+void BasicTest() {
+  
+  opdet::StreamingWaveformBaseline baseline { { 3U } };
+  
+  BOOST_TEST(baseline.parameters().windowSize == 3U);
+  BOOST_TEST(!baseline.ready());
+  BOOST_TEST(baseline.nSamples() == 0U);
+  
+  BOOST_TEST(baseline.add(10) == 10);   // { 10 }
+  BOOST_TEST(baseline.add(20) == 20);   // { 10, 20 }
+  BOOST_TEST(!baseline.ready());
+  BOOST_TEST(baseline.add(12) == 12);   // { 10, 20, 12 }
+  BOOST_TEST(baseline.ready());
+  BOOST_TEST(baseline.add(5000) == 20); // { 20, 12, 5000 }
+  BOOST_TEST(baseline.add(11) == 12);   // { 12, 5000, 11 }
+  BOOST_TEST(baseline.add(11) == 11);   // { 5000, 11, 11 }
+  BOOST_TEST(baseline.nSamples() == 6U);
+  BOOST_TEST(baseline.baseline() == 11);
+  
+  baseline.reset();
+  BOOST_TEST(!baseline.ready());
+  BOOST_TEST(baseline.nSamples() == 0U);
+  BOOST_TEST(baseline.add(-8000) == -8000);
+  
+} // BasicTest()
+
+
+//------------------------------------------------------------------------------
+void RandomWaveformTest() {
+  
+  std::mt19937 engine { 13579 };
+  std::normal_distribution<double> noise { 0.0, 3.0 };
+  
+  for (std::size_t const window: { 1U, 2U, 7U, 64U, 255U }) {
+    
+    opdet::StreamingWaveformBaseline baseline { { window } };
+    
+    for (int iWaveform = 0; iWaveform < 3; ++iWaveform) {
+      
+      // drifting baseline, noise and negative pulses
+      std::vector<Sample_t> samples(2000U);
+      for (std::size_t i = 0; i < samples.size(); ++i) {
+        double value = 14000.0 - 1500.0 * iWaveform + i * 0.05 + noise(engine);
+        if (i % 400 >= 200 && i % 400 < 220) value -= 2000.0;
+        samples[i] = static_cast<Sample_t>(value);
+      }
+      
+      // process in chunks of different sizes
+      baseline.reset();
+      std::vector<Sample_t> baselines;
+      std::size_t const chunks[] = { 1U, 13U, 500U, 486U, 1000U };
+      auto it = samples.cbegin();
+      for (std::size_t const chunk: chunks) {
+        baseline.process(it, it + chunk, std::back_inserter(baselines));
+        it += chunk;
+      }
+      BOOST_TEST_REQUIRE(baselines.size() == samples.size());
+      BOOST_TEST(baseline.nSamples() == samples.size());
+      
+      unsigned int nMismatches = 0U;
+      for (std::size_t i = 0; i < samples.size(); ++i)
+        if (baselines[i] != referenceBaseline(samples, i, window)) ++nMismatches;
+      BOOST_TEST(nMismatches == 0U);
+      
+    } // for waveforms
+    
+  } // for windows
+  
+} // RandomWaveformTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( AllTests ) {
+  
+  BasicTest();
+  RandomWaveformTest();
+  
+} // BOOST_AUTO_TEST_CASE( AllTests )
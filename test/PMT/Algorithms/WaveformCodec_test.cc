@@ -0,0 +1,131 @@
+/**
+ * @file   WaveformCodec_test.cc
+ * @brief  Unit test for `opdet::WaveformCodec`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/PMT/Algorithms/WaveformCodec.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE WaveformCodecTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/WaveformCodec.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <limits>
+#include <cmath> // std::exp()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+using Sample_t = opdet::WaveformCodec::Sample_t;
+
+/// Returns a waveform with Gaussian noise around `baseline` and a few pulses.
+std::vector<Sample_t> makeWaveform
+  (std::size_t nSamples, double baseline, double noiseRMS, unsigned int seed)
+{
+  std::mt19937 engine { seed };
+  std::normal_distribution<double> noise { 0.0, noiseRMS };
+  std::vector<Sample_t> samples(nSamples);
+  for (std::size_t i = 0; i < nSamples; ++i) {
+    double value = baseline + noise(engine);
+    for (std::size_t const pulse: { nSamples / 4, nSamples / 2 }) {
+      if (i < pulse) continue;
+      value -= 800.0 * std::exp(-static_cast<double>(i - pulse) / 12.0);
+    }
+    samples[i] = static_cast<Sample_t>(std::round(value));
+  } // for
+  return samples;
+} // makeWaveform()
+
+
+/// Checks that `samples` are decoded back unchanged.
+void checkRoundTrip
+  (std::vector<Sample_t> const& samples, Sample_t reference)
+{
+  opdet::EncodedWaveform const encoded
+    = opdet::WaveformCodec::encode(samples, reference);
+  BOOST_TEST(encoded.nSamples == samples.size());
+  BOOST_TEST(encoded.nBlocks()
+    == (samples.size() + opdet::WaveformCodec::BlockSize - 1)
+      / opdet::WaveformCodec::BlockSize
+    );
+
+  std::vector<Sample_t> const decoded = opdet::WaveformCodec::decode(encoded);
+  BOOST_TEST(decoded == samples, boost::test_tools::per_element());
+} // checkRoundTrip()
+
+
+//------------------------------------------------------------------------------
+void RoundTripTest() {
+
+  // empty, partial blocks and exact blocks
+  for (std::size_t const nSamples: { 0U, 1U, 31U, 32U, 33U, 64U, 5000U }) {
+    BOOST_TEST_CONTEXT("samples: " << nSamples) {
+      checkRoundTrip(makeWaveform(nSamples, 14900.0, 3.0, nSamples), 14900);
+    }
+  }
+
+  // constant waveform: nothing but the widths is stored
+  std::vector<Sample_t> const flat(100U, 8000);
+  checkRoundTrip(flat, 8000);
+  opdet::EncodedWaveform const flatEncoded
+    = opdet::WaveformCodec::encode(flat, 8000);
+  BOOST_TEST(flatEncoded.words.empty());
+
+  // extreme values and a far reference
+  constexpr Sample_t Min = std::numeric_limits<Sample_t>::lowest();
+  constexpr Sample_t Max = std::numeric_limits<Sample_t>::max();
+  std::vector<Sample_t> const extremes { Min, Max, 0, -1, 1, Max, Min };
+  checkRoundTrip(extremes, Min);
+  checkRoundTrip(extremes, Max);
+  checkRoundTrip(extremes, 0);
+  BOOST_TEST(opdet::WaveformCodec::encode(extremes, Min).widths.front()
+    == opdet::WaveformCodec::MaxWidth);
+
+} // RoundTripTest()
+
+
+//------------------------------------------------------------------------------
+void CompressionTest() {
+
+  std::vector<Sample_t> const samples = makeWaveform(5000U, 14900.3, 3.0, 6);
+  Sample_t const reference = opdet::WaveformCodec::referenceFor(14900.3);
+  BOOST_TEST(reference == 14900);
+
+  opdet::EncodedWaveform const encoded
+    = opdet::WaveformCodec::encode(samples, reference);
+
+  std::size_t const rawBytes = samples.size() * sizeof(Sample_t);
+  BOOST_TEST_MESSAGE("Encoded " << rawBytes << " bytes into "
+    << encoded.bytes() << " bytes");
+  BOOST_TEST(encoded.bytes() * 3U < rawBytes);
+
+  // reusing the objects gives the same result
+  opdet::EncodedWaveform reused;
+  opdet::WaveformCodec::encode(makeWaveform(200U, 300.0, 50.0, 7), 0, reused);
+  opdet::WaveformCodec::encode(samples, reference, reused);
+  BOOST_TEST(reused.widths == encoded.widths, boost::test_tools::per_element());
+  BOOST_TEST(reused.words == encoded.words, boost::test_tools::per_element());
+
+  std::vector<Sample_t> decoded(10U, 0);
+  opdet::WaveformCodec::decode(reused, decoded);
+  BOOST_TEST(decoded == samples, boost::test_tools::per_element());
+
+} // CompressionTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WaveformCodecTestCase) {
+
+  RoundTripTest();
+  CompressionTest();
+
+} // BOOST_AUTO_TEST_CASE(WaveformCodecTestCase)
+
+
+//------------------------------------------------------------------------------
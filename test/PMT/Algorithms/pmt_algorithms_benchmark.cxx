@@ -0,0 +1,314 @@
+/**
+ * @file   pmt_algorithms_benchmark.cxx
+ * @brief  Measures the throughput of PMT waveform algorithms.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     pmt_algorithms_benchmark \
+ *       [Samples [NoiseRMS [Pulses [Iterations [Scale]]]]]
+ *
+ * A synthetic ICARUS-like event is generated by
+ * `testing::mockup::SyntheticEventGenerator`, with 360 PMT channels, each with
+ * `4 x Scale` waveforms (default `Scale`: 1) of `Samples` samples (default:
+ * 5000) at the times of common light flashes. Each waveform has a baseline
+ * with Gaussian noise of `NoiseRMS` ADC counts (default: 3) and `Pulses`
+ * negative pulses (default: 3).
+ *
+ * Each algorithm is run `Iterations` times (default: 20) on the whole event:
+ * * `SharedWaveformBaseline` in its standard mode, single-pass mode and
+ *   all-channel mode (`channelBaselines()`, one thread);
+ * * the negative polarity `icarus::waveform_operations` helpers (baseline
+ *   subtraction, threshold search, peak search, integral);
+ * * the grouping of the waveforms by channel
+ *   (`icarus::ns::util::GroupByIndex`);
+ * * the clustering of the waveforms in time (`util::clusterBy()`,
+ *   `util::clusterIndicesBy()` with a reused buffer, and
+ *   `util::forEachSortedCluster()` on waveforms already sorted by time).
+ *
+ * The results are printed on screen as comma-separated values, one line per
+ * algorithm, with a header line first. For each algorithm, the columns are:
+ * the name of the benchmark, the number of channels, waveforms and samples of
+ * the event, the number of iterations, the total time [s], the processing
+ * rate (samples per second, or waveforms per second for the clustering) and
+ * the number of memory allocations and allocated bytes per iteration.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/SharedWaveformBaseline.h"
+#include "icarusalg/Utilities/WaveformOperations.h"
+#include "icarusalg/Utilities/SimpleClustering.h"
+#include "icarusalg/Utilities/GroupByIndex.h"
+#include "test/SyntheticEventGenerator.h"
+#include "test/AllocationCounter.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm> // std::min(), std::sort()
+#include <functional> // std::less<>
+#include <cmath> // std::abs()
+#include <cstdlib> // std::atof(), std::atol()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  constexpr unsigned int NChannels = 360U;
+
+  /// Synthetic event.
+  struct Event_t {
+    std::vector<raw::OpDetWaveform> waveforms;
+
+    /// Waveforms grouped by channel.
+    std::vector<std::vector<raw::OpDetWaveform const*>> byChannel;
+
+    std::size_t nSamples = 0U; ///< Total number of samples.
+  }; // Event_t
+
+
+  /// Returns an event with the specified features.
+  Event_t makeEvent(
+    std::size_t nSamples, double noiseRMS, unsigned int nPulses, double scale
+  ) {
+    // only the optical waveforms are used: no track, cluster nor hit
+    struct NoData {};
+    using Generator_t
+      = testing::mockup::SyntheticEventGenerator<NoData, NoData, NoData>;
+
+    Generator_t::Config_t config = Generator_t::Config_t{}.scaled(scale);
+    config.nOpChannels = NChannels;
+    config.samplesPerWaveform = nSamples;
+    config.noiseRMS = noiseRMS;
+    config.pulsesPerWaveform = nPulses;
+
+    Event_t event;
+    event.waveforms = Generator_t{ config }.makeWaveforms();
+    event.nSamples = event.waveforms.size() * nSamples;
+
+    // pointers are taken only after the collection is complete
+    event.byChannel.resize(NChannels);
+    for (raw::OpDetWaveform const& waveform: event.waveforms)
+      event.byChannel[waveform.ChannelNumber()].push_back(&waveform);
+
+    return event;
+  } // makeEvent()
+
+
+  /// Runs `algo()` `nIterations` times, and prints the results.
+  template <typename Algo>
+  void benchmark(
+    std::string const& name, Event_t const& event, std::size_t nItems,
+    unsigned int nIterations, Algo algo
+  ) {
+
+    algo(); // warm up, and first allocation of reused memory
+
+    icarus::test::AllocationCounter const allocationCounter;
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nIterations; ++i) algo();
+    std::chrono::duration<double> const elapsed
+      = std::chrono::steady_clock::now() - start;
+    std::size_t const allocations = allocationCounter.allocations();
+    std::size_t const bytes = allocationCounter.bytes();
+
+    std::cout << name
+      << "," << NChannels
+      << "," << event.waveforms.size()
+      << "," << event.nSamples
+      << "," << nIterations
+      << "," << elapsed.count()
+      << "," << (nItems * nIterations / elapsed.count())
+      << "," << (static_cast<double>(allocations) / nIterations)
+      << "," << (static_cast<double>(bytes) / nIterations)
+      << std::endl;
+
+  } // benchmark()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using Sample_t = raw::ADC_Count_t;
+  using Operations_t
+    = icarus::waveform_operations::NegativePolarityOperations<Sample_t>;
+
+  std::size_t const nSamples = (argc > 1)? std::atol(argv[1]): 5000;
+  double const noiseRMS = (argc > 2)? std::atof(argv[2]): 3.0;
+  long int const nPulses = (argc > 3)? std::atol(argv[3]): 3;
+  long int const nIterations = (argc > 4)? std::atol(argv[4]): 20;
+  double const scale = (argc > 5)? std::atof(argv[5]): 1.0;
+  if ((nSamples == 0) || (noiseRMS < 0.0) || (nPulses < 0)
+    || (nIterations <= 0) || (scale <= 0.0)
+  ) {
+    std::cerr << "Usage:  " << argv[0]
+      << "  [Samples [NoiseRMS [Pulses [Iterations [Scale]]]]]" << std::endl;
+    return 1;
+  }
+
+  Event_t const event = makeEvent(nSamples, noiseRMS, nPulses, scale);
+  std::size_t const nWaveforms = event.waveforms.size();
+
+  // prevents the compiler from optimizing away the results
+  double volatile checksum = 0.0;
+
+  std::cout << "benchmark,channels,waveforms,samples,iterations,time_s"
+    ",rate_per_s,allocations_per_iteration,allocated_bytes_per_iteration"
+    << std::endl;
+
+  //
+  // baselines
+  //
+  opdet::SharedWaveformBaseline const baselineAlg
+    { { 200U, 3.0, 10U }, "pmt_algorithms_benchmark" };
+  std::size_t const nBaselineSamples
+    = nWaveforms * std::min(nSamples, baselineAlg.parameters().nSample);
+
+  benchmark("SharedWaveformBaseline", event, nBaselineSamples, nIterations,
+    [&]()
+    {
+      for (auto const& waveforms: event.byChannel)
+        checksum = checksum + baselineAlg(waveforms).baseline;
+    });
+
+  opdet::SharedWaveformBaseline::Workspace_t workspace;
+  benchmark("SharedWaveformBaseline_workspace", event, nBaselineSamples,
+    nIterations,
+    [&]()
+    {
+      for (auto const& waveforms: event.byChannel)
+        checksum = checksum + baselineAlg(waveforms, workspace).baseline;
+    });
+
+  std::vector<opdet::SharedWaveformBaseline::Workspace_t> workspaces(1U);
+  benchmark("SharedWaveformBaseline_channels", event, nBaselineSamples,
+    nIterations,
+    [&]()
+    {
+      auto const baselines
+        = baselineAlg.channelBaselines(event.byChannel, workspaces);
+      checksum = checksum + baselines.front().baseline;
+    });
+
+  //
+  // waveform operations
+  //
+  Sample_t const baseline = 14925;
+  Sample_t const threshold = 200; // above noise: search reaches the pulses
+  std::vector<Sample_t> subtracted(nSamples);
+
+  benchmark("subtractBaseline", event, event.nSamples, nIterations,
+    [&]()
+    {
+      for (raw::OpDetWaveform const& waveform: event.waveforms) {
+        Operations_t::subtractBaseline(waveform.data(),
+          waveform.data() + waveform.size(), baseline, subtracted.data());
+        checksum = checksum + subtracted.back();
+      }
+    });
+
+  benchmark("findFirstReaching", event, event.nSamples, nIterations,
+    [&]()
+    {
+      Operations_t const op { baseline };
+      for (raw::OpDetWaveform const& waveform: event.waveforms) {
+        Sample_t const* const begin = waveform.data();
+        checksum = checksum + (op.findFirstReachingAmplitude
+          (begin, begin + waveform.size(), threshold) - begin);
+      }
+    });
+
+  benchmark("findMax", event, event.nSamples, nIterations,
+    [&]()
+    {
+      for (raw::OpDetWaveform const& waveform: event.waveforms) {
+        Sample_t const* const begin = waveform.data();
+        checksum = checksum
+          + (Operations_t::findMax(begin, begin + waveform.size()) - begin);
+      }
+    });
+
+  benchmark("integral", event, event.nSamples, nIterations,
+    [&]()
+    {
+      for (raw::OpDetWaveform const& waveform: event.waveforms) {
+        Sample_t const* const begin = waveform.data();
+        checksum = checksum + Operations_t::integral
+          (begin, begin + waveform.size(), baseline);
+      }
+    });
+
+  //
+  // grouping
+  //
+  benchmark("GroupByIndex", event, nWaveforms, nIterations,
+    [&]()
+    {
+      icarus::ns::util::GroupByIndex<raw::OpDetWaveform> const byChannel{
+        event.waveforms,
+        [](raw::OpDetWaveform const& waveform)
+          { return waveform.ChannelNumber(); }
+        };
+      checksum = checksum + byChannel.size();
+    });
+
+  //
+  // clustering
+  //
+  benchmark("clusterBy", event, nWaveforms, nIterations,
+    [&]()
+    {
+      auto const clusters = util::clusterBy(
+        event.waveforms,
+        [](raw::OpDetWaveform const& waveform){ return waveform.TimeStamp(); },
+        [](double a, double b){ return std::abs(a - b) < 2.0; }, // [us]
+        [](raw::OpDetWaveform const& waveform){ return &waveform; },
+        std::less<double>{}
+        );
+      checksum = checksum + clusters.size();
+    });
+
+  util::ClusterIndices<double> clusterIndices;
+  benchmark("clusterIndicesBy", event, nWaveforms, nIterations,
+    [&]()
+    {
+      checksum = checksum + util::clusterIndicesBy(
+        event.waveforms,
+        [](raw::OpDetWaveform const& waveform){ return waveform.TimeStamp(); },
+        [](double a, double b){ return std::abs(a - b) < 2.0; }, // [us]
+        std::less<double>{}, clusterIndices
+        );
+    });
+
+  std::vector<raw::OpDetWaveform const*> sortedWaveforms;
+  for (raw::OpDetWaveform const& waveform: event.waveforms)
+    sortedWaveforms.push_back(&waveform);
+  std::sort(sortedWaveforms.begin(), sortedWaveforms.end(),
+    [](raw::OpDetWaveform const* a, raw::OpDetWaveform const* b)
+      { return a->TimeStamp() < b->TimeStamp(); }
+    );
+  benchmark("forEachSortedCluster", event, nWaveforms, nIterations,
+    [&]()
+    {
+      checksum = checksum + util::forEachSortedCluster(
+        sortedWaveforms.cbegin(), sortedWaveforms.cend(),
+        [](raw::OpDetWaveform const* waveform){ return waveform->TimeStamp(); },
+        [](double a, double b){ return std::abs(a - b) < 2.0; }, // [us]
+        [](auto, auto){}
+        );
+    });
+
+  std::cerr << "(checksum: " << checksum << ")" << std::endl;
+
+  return 0;
+} // main()
@@ -0,0 +1,83 @@
+/**
+ * @file   streaming_baseline_benchmark.cxx
+ * @brief  Measures the throughput of `opdet::StreamingWaveformBaseline`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ *
+ * Usage:
+ *
+ *     streaming_baseline_benchmark [Samples [Window [Chunk]]]
+ *
+ * A synthetic waveform of `Samples` samples (default: 10000000) is generated,
+ * with a slowly drifting baseline, Gaussian noise and negative pulses, and its
+ * running baseline is extracted with a window of `Window` samples (default:
+ * 500), feeding the algorithm `Chunk` samples at a time (default: 5000).
+ * The number of processed samples per second is printed.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/PMT/Algorithms/StreamingWaveformBaseline.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm> // std::min()
+#include <cstdlib> // std::atol()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+  
+  using Sample_t = opdet::StreamingWaveformBaseline::Sample_t;
+  
+  std::size_t const nSamples = (argc > 1)? std::atol(argv[1]): 10'000'000;
+  std::size_t const windowSize = (argc > 2)? std::atol(argv[2]): 500;
+  std::size_t const chunkSize = (argc > 3)? std::atol(argv[3]): 5000;
+  if ((nSamples == 0) || (windowSize == 0) || (chunkSize == 0)) {
+    std::cerr << "Usage:  " << argv[0] << "  [Samples [Window [Chunk]]]"
+      << std::endl;
+    return 1;
+  }
+  
+  //
+  // synthetic waveform
+  //
+  std::mt19937 engine { 24680 };
+  std::normal_distribution<double> noise { 0.0, 3.0 };
+  std::vector<Sample_t> samples(nSamples);
+  for (std::size_t i = 0; i < nSamples; ++i) {
+    double value = 14000.0 + 20.0 * ((i / 100000) % 5) + noise(engine);
+    if (i % 5000 < 30) value -= 1000.0 * (30.0 - i % 5000) / 30.0;
+    samples[i] = static_cast<Sample_t>(value);
+  } // for
+  
+  //
+  // processing
+  //
+  opdet::StreamingWaveformBaseline algorithm { { windowSize } };
+  std::vector<Sample_t> baselines(chunkSize);
+  long long checksum = 0;
+  
+  auto const start = std::chrono::steady_clock::now();
+  for (std::size_t first = 0; first < nSamples; first += chunkSize) {
+    auto const begin = samples.cbegin() + first;
+    auto const end = begin + std::min(chunkSize, nSamples - first);
+    algorithm.process(begin, end, baselines.begin());
+    checksum += algorithm.baseline();
+  } // for
+  std::chrono::duration<double> const elapsed
+    = std::chrono::steady_clock::now() - start;
+  
+  std::cout << "Running median over " << windowSize << " samples, chunks of "
+    << chunkSize << ": " << nSamples << " samples in "
+    << (elapsed.count() * 1e3) << " ms, "
+    << (nSamples / elapsed.count() / 1e6) << " Msamples/s"
+    << " (checksum: " << checksum << ")"
+    << std::endl;
+  
+  return 0;
+} // main()
@@ -13,6 +13,11 @@
 // ICARUS libraries
 #include "icarusalg/Utilities/WaveformOperations.h"
 
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
 
 //------------------------------------------------------------------------------
 void NegativePolarityTest() {
@@ -122,6 +127,143 @@ void PositivePolarityTest() {
 } // void PositivePolarityTest()
 
 
+//------------------------------------------------------------------------------
+template <typename Sample_t>
+void RangeOperationsTest() {
+  
+  using NegOp = icarus::waveform_operations::NegativePolarityOperations<Sample_t>;
+  using PosOp = icarus::waveform_operations::PositivePolarityOperations<Sample_t>;
+  
+  // a negative pulse on baseline 100, long enough to span many search blocks
+  std::vector<Sample_t> samples(100U, Sample_t{ 100 });
+  samples[70] = 90;
+  samples[71] = 60;
+  samples[72] = 60;
+  samples[73] = 95;
+  samples[80] = 104;
+  samples[81] = 104;
+  Sample_t const* const begin = samples.data();
+  Sample_t const* const end = begin + samples.size();
+  
+  //
+  // baseline subtraction
+  //
+  std::vector<Sample_t> subtracted(samples.size());
+  NegOp{ 100 }.subtractBaseline(begin, end, subtracted.data());
+  BOOST_TEST(subtracted[0] == 0);
+  BOOST_TEST(subtracted[71] == 40);
+  BOOST_TEST(subtracted[80] == -4);
+  
+  PosOp::subtractBaseline(begin, end, 100, subtracted.data());
+  BOOST_TEST(subtracted[0] == 0);
+  BOOST_TEST(subtracted[71] == -40);
+  BOOST_TEST(subtracted[80] == 4);
+  
+  // in place
+  std::vector<Sample_t> inPlace = samples;
+  NegOp::subtractBaseline(inPlace.data(), inPlace.data() + inPlace.size(), 100,
+    inPlace.data());
+  BOOST_TEST(inPlace[72] == 40);
+  
+  //
+  // threshold crossing
+  //
+  BOOST_TEST(NegOp::findFirstReaching(begin, end, 90) == begin + 70);
+  BOOST_TEST(NegOp::findFirstReaching(begin, end, 80) == begin + 71);
+  BOOST_TEST(NegOp::findFirstReaching(begin, end, 50) == end);
+  BOOST_TEST(NegOp{ 100 }.findFirstReachingAmplitude(begin, end, 10)
+    == begin + 70);
+  BOOST_TEST(PosOp::findFirstReaching(begin, end, 101) == begin + 80);
+  BOOST_TEST(PosOp{ 100 }.findFirstReachingAmplitude(begin, end, 5) == end);
+  BOOST_TEST(NegOp::findFirstReaching(begin, begin, 100) == begin);
+  
+  //
+  // extrema
+  //
+  BOOST_TEST(NegOp::findMax(begin, end) == begin + 71);
+  BOOST_TEST(NegOp::findMin(begin, end) == begin + 80);
+  BOOST_TEST(PosOp::findMax(begin, end) == begin + 80);
+  BOOST_TEST(PosOp::findMin(begin, end) == begin + 71);
+  BOOST_TEST(PosOp::findMax(end, end) == end);
+  
+  //
+  // integral
+  //
+  // pulse: 10 + 40 + 40 + 5 = 95; overshoot: 2 x 4
+  BOOST_TEST(NegOp::integral(begin, end, 100) == 95 - 8);
+  BOOST_TEST(NegOp{ 100 }.integral(begin + 70, begin + 74) == 95);
+  BOOST_TEST(PosOp::integral(begin, end, 100) == 8 - 95);
+  BOOST_TEST(PosOp{ 100 }.integral(begin, begin) == 0);
+  
+} // void RangeOperationsTest()
+
+
+//------------------------------------------------------------------------------
+/// Sample-by-sample reference for `findFirstRunOutside()`.
+template <typename Iter, typename Sample_t>
+Iter referenceFirstRunOutside(
+  Iter begin, Iter end, Sample_t lower, Sample_t upper,
+  std::size_t minBelow, std::size_t minAbove
+) {
+  std::size_t nAbove = 0U, nBelow = 0U;
+  for (auto it = begin; it != end; ++it) {
+    if (*it > upper) {
+      nBelow = 0U;
+      if (++nAbove >= minAbove) return it - minAbove + 1;
+    }
+    else if (*it < lower) {
+      nAbove = 0U;
+      if (++nBelow >= minBelow) return it - minBelow + 1;
+    }
+    else nAbove = nBelow = 0U;
+  } // for
+  return end;
+} // referenceFirstRunOutside()
+
+
+void RunSearchTest() {
+  
+  using icarus::waveform_operations::findFirstRun;
+  using icarus::waveform_operations::findFirstRunOutside;
+  
+  std::vector<int> const samples
+    //  0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
+    {   0, 5, 5, 0, 5, 5, 5, 0,-5,-5,-5,-5, 0, 5, 5, 5 };
+  auto const begin = samples.begin(), end = samples.end();
+  auto const high = [](int s){ return s > 1; };
+  
+  BOOST_TEST((findFirstRun(begin, end, 0U, high) == begin));
+  BOOST_TEST((findFirstRun(begin, end, 1U, high) == begin + 1));
+  BOOST_TEST((findFirstRun(begin, end, 2U, high) == begin + 1));
+  BOOST_TEST((findFirstRun(begin, end, 3U, high) == begin + 4));
+  BOOST_TEST((findFirstRun(begin, end, 4U, high) == end));
+  BOOST_TEST((findFirstRun(begin + 5, end, 3U, high) == begin + 13));
+  BOOST_TEST((findFirstRun(begin, begin, 1U, high) == begin));
+  
+  BOOST_TEST((findFirstRunOutside(begin, end, -1, +1, 4U, 3U) == begin + 4));
+  BOOST_TEST((findFirstRunOutside(begin, end, -1, +1, 4U, 4U) == begin + 8));
+  BOOST_TEST((findFirstRunOutside(begin, end, -1, +1, 5U, 4U) == end));
+  BOOST_TEST((findFirstRunOutside(begin, end, -1, +5, 2U, 2U) == begin + 8));
+  
+  // comparison with the sample-by-sample search on random waveforms
+  std::mt19937 engine { 2468 };
+  std::normal_distribution<double> noise { 0.0, 2.0 };
+  std::vector<short> waveform(500U);
+  for (unsigned int iTrial = 0; iTrial < 1000U; ++iTrial) {
+    for (short& s: waveform) s = static_cast<short>(noise(engine));
+    std::size_t const minBelow = 1 + iTrial % 7, minAbove = 1 + iTrial % 5;
+    short const width = static_cast<short>(iTrial % 6);
+    BOOST_TEST((
+      findFirstRunOutside(waveform.cbegin(), waveform.cend(),
+        short(-width), width, minBelow, minAbove)
+      == referenceFirstRunOutside(waveform.cbegin(), waveform.cend(),
+        short(-width), width, minBelow, minAbove)
+      ));
+  } // for
+  
+} // RunSearchTest()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
@@ -129,6 +271,9 @@ BOOST_AUTO_TEST_CASE( AllTests ) {
   
   NegativePolarityTest();
   PositivePolarityTest();
+  RangeOperationsTest<signed short int>();
+  RangeOperationsTest<float>();
+  RunSearchTest();
   
 } // BOOST_AUTO_TEST_CASE( AllTests )
 
@@ -0,0 +1,335 @@
+/**
+ * @file test/SyntheticEventGenerator.h
+ * @brief Fills mockup events with synthetic data products of tunable size.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ * @see test/FrameworkEventMockup.h
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSALG_TEST_SYNTHETICEVENTGENERATOR_H
+#define ICARUSALG_TEST_SYNTHETICEVENTGENERATOR_H
+
+// ICARUS libraries
+#include "test/FrameworkEventMockup.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max(), std::shuffle(), std::sort()
+#include <random>
+#include <vector>
+#include <utility> // std::pair, std::move()
+#include <cmath> // std::exp(), std::lround()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace testing::mockup {
+  template <typename Track, typename Cluster, typename Hit>
+  class SyntheticEventGenerator;
+} // namespace testing::mockup
+
+/**
+ * @brief Creates events with synthetic tracks, clusters, hits and waveforms.
+ * @tparam Track type of the track objects
+ * @tparam Cluster type of the cluster objects
+ * @tparam Hit type of the hit objects
+ *
+ * Each generated `testing::mockup::Event` contains:
+ * * `std::vector<Hit>` (tag: `hits`), `std::vector<Cluster>` (`clusters`) and
+ *   `std::vector<Track>` (`tracks`), all default-constructed;
+ * * `art::Assns<Cluster, Hit>` (`clusters`): each cluster is associated to
+ *   `hitsPerCluster` hits picked at random (so hits may be shared);
+ * * `art::Assns<Track, Cluster>` (`tracks`): each track is associated to
+ *   `clustersPerTrack` clusters picked at random;
+ * * `art::Assns<Track, Hit>` (`tracks`): each track is associated to the hits
+ *   of its clusters;
+ * * `std::vector<raw::OpDetWaveform>` (`opdaq`): `waveformsPerChannel`
+ *   waveforms for each of `nOpChannels` channels, at the times of common
+ *   flashes, with a baseline with Gaussian noise and a few negative pulses.
+ *
+ * The associations are stored in random order.
+ * With the same configuration, the content of the event is always the same.
+ *
+ * The configuration `Config_t::production()` roughly reproduces the size of an
+ * ICARUS event, and `Config_t::scaled()` multiplies all the object counts
+ * (not the fan-outs nor the waveform length):
+ * ~~~~{.cpp}
+ * struct Track {}; struct Cluster {}; struct Hit {};
+ * using Generator_t
+ *   = testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>;
+ *
+ * testing::mockup::Event const event
+ *   = Generator_t{ Generator_t::Config_t::production().scaled(10.0) }();
+ * auto const& waveforms
+ *   = event.getProduct<std::vector<raw::OpDetWaveform>>("opdaq");
+ * ~~~~
+ */
+template <typename Track, typename Cluster, typename Hit>
+class testing::mockup::SyntheticEventGenerator {
+
+    public:
+
+  /// Configuration of the generated event.
+  struct Config_t {
+
+    std::size_t nHits = 1000U; ///< Number of hits.
+    std::size_t nClusters = 20U; ///< Number of clusters.
+    std::size_t nTracks = 5U; ///< Number of tracks.
+    std::size_t hitsPerCluster = 50U; ///< Hits associated to each cluster.
+    std::size_t clustersPerTrack = 3U; ///< Clusters associated to each track.
+
+    unsigned int nOpChannels = 360U; ///< Number of optical channels.
+    std::size_t waveformsPerChannel = 4U; ///< Waveforms on each channel.
+    std::size_t samplesPerWaveform = 5000U; ///< Samples in each waveform.
+    double noiseRMS = 3.0; ///< Baseline noise [ADC].
+    unsigned int pulsesPerWaveform = 3U; ///< Negative pulses per waveform.
+
+    unsigned int seed = 13579U; ///< Seed of the random engine.
+
+    /// Returns a configuration with about the data of an ICARUS event.
+    static Config_t production()
+      {
+        Config_t config;
+        config.nHits = 100000U;
+        config.nClusters = 2000U;
+        config.nTracks = 200U;
+        return config;
+      }
+
+    /// Returns this configuration with all the object counts times `factor`
+    /// (but at least one of each kind).
+    Config_t scaled(double factor) const
+      {
+        auto scale = [factor](std::size_t n)
+          {
+            long int const scaled = std::lround(n * factor);
+            return static_cast<std::size_t>(std::max(scaled, 1L));
+          };
+        Config_t config = *this;
+        config.nHits = scale(nHits);
+        config.nClusters = scale(nClusters);
+        config.nTracks = scale(nTracks);
+        config.waveformsPerChannel = scale(waveformsPerChannel);
+        return config;
+      }
+
+  }; // Config_t
+
+
+  // tags of the data products
+  static art::InputTag const HitTag; ///< Tag of hits.
+  static art::InputTag const ClusterTag; ///< Tag of clusters and their assns.
+  static art::InputTag const TrackTag; ///< Tag of tracks and their assns.
+  static art::InputTag const WaveformTag; ///< Tag of optical waveforms.
+
+
+  /// Constructor: sets the configuration of the events.
+  explicit SyntheticEventGenerator(Config_t config): fConfig(std::move(config))
+    {}
+
+  /// Returns the configuration of the events.
+  Config_t const& config() const { return fConfig; }
+
+  /// Returns a new event.
+  testing::mockup::Event operator() () const;
+
+  /// Returns the waveforms as in the event, without creating the event.
+  std::vector<raw::OpDetWaveform> makeWaveforms() const;
+
+
+    private:
+
+  using IndexPairs_t = std::vector<std::pair<std::size_t, std::size_t>>;
+
+  Config_t fConfig; ///< Configuration of the events.
+
+
+  /// Returns `n` associated pairs for each left object, right ones at random.
+  IndexPairs_t makePairs(
+    std::size_t nLeft, std::size_t nRight, std::size_t n,
+    std::mt19937& engine
+    ) const;
+
+  /// Adds to `event` associations with the specified `pairs`, shuffled.
+  template <typename L, typename R>
+  static void putAssns(
+    testing::mockup::Event& event,
+    art::InputTag const& leftTag, art::InputTag const& rightTag,
+    art::InputTag const& assnsTag, IndexPairs_t pairs, std::mt19937& engine
+    );
+
+  /// Adds to `waveforms` the ones of the configuration (own random engine).
+  void fillWaveforms(std::vector<raw::OpDetWaveform>& waveforms) const;
+
+}; // testing::mockup::SyntheticEventGenerator
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename Track, typename Cluster, typename Hit>
+art::InputTag const
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::HitTag
+  { "hits" };
+
+template <typename Track, typename Cluster, typename Hit>
+art::InputTag const
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::ClusterTag
+  { "clusters" };
+
+template <typename Track, typename Cluster, typename Hit>
+art::InputTag const
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::TrackTag
+  { "tracks" };
+
+template <typename Track, typename Cluster, typename Hit>
+art::InputTag const
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::WaveformTag
+  { "opdaq" };
+
+
+// -----------------------------------------------------------------------------
+template <typename Track, typename Cluster, typename Hit>
+testing::mockup::Event
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::operator() ()
+  const
+{
+  std::mt19937 engine { fConfig.seed };
+
+  testing::mockup::Event event;
+  event.put(std::vector<Hit>(fConfig.nHits), HitTag);
+  event.put(std::vector<Cluster>(fConfig.nClusters), ClusterTag);
+  event.put(std::vector<Track>(fConfig.nTracks), TrackTag);
+
+  IndexPairs_t const clusterHits = makePairs
+    (fConfig.nClusters, fConfig.nHits, fConfig.hitsPerCluster, engine);
+  IndexPairs_t const trackClusters = makePairs
+    (fConfig.nTracks, fConfig.nClusters, fConfig.clustersPerTrack, engine);
+
+  // the hits of a track are the ones of its clusters
+  std::vector<std::vector<std::size_t>> hitsOfCluster(fConfig.nClusters);
+  for (auto const& [ cluster, hit ]: clusterHits)
+    hitsOfCluster[cluster].push_back(hit);
+  IndexPairs_t trackHits;
+  for (auto const& [ track, cluster ]: trackClusters) {
+    for (std::size_t const hit: hitsOfCluster[cluster])
+      trackHits.emplace_back(track, hit);
+  }
+
+  putAssns<Cluster, Hit>
+    (event, ClusterTag, HitTag, ClusterTag, clusterHits, engine);
+  putAssns<Track, Cluster>
+    (event, TrackTag, ClusterTag, TrackTag, trackClusters, engine);
+  putAssns<Track, Hit>
+    (event, TrackTag, HitTag, TrackTag, std::move(trackHits), engine);
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  fillWaveforms(waveforms);
+  event.put(std::move(waveforms), WaveformTag);
+
+  return event;
+} // testing::mockup::SyntheticEventGenerator::operator()
+
+
+// -----------------------------------------------------------------------------
+template <typename Track, typename Cluster, typename Hit>
+std::vector<raw::OpDetWaveform>
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::makeWaveforms()
+  const
+{
+  std::vector<raw::OpDetWaveform> waveforms;
+  fillWaveforms(waveforms);
+  return waveforms;
+} // testing::mockup::SyntheticEventGenerator::makeWaveforms()
+
+
+// -----------------------------------------------------------------------------
+template <typename Track, typename Cluster, typename Hit>
+auto testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::makePairs(
+  std::size_t nLeft, std::size_t nRight, std::size_t n, std::mt19937& engine
+) const -> IndexPairs_t {
+  IndexPairs_t pairs;
+  if (nRight == 0U) return pairs;
+  std::uniform_int_distribution<std::size_t> pick { 0U, nRight - 1U };
+  pairs.reserve(nLeft * n);
+  for (std::size_t left = 0U; left < nLeft; ++left)
+    for (std::size_t i = 0U; i < n; ++i) pairs.emplace_back(left, pick(engine));
+  return pairs;
+} // testing::mockup::SyntheticEventGenerator::makePairs()
+
+
+// -----------------------------------------------------------------------------
+template <typename Track, typename Cluster, typename Hit>
+template <typename L, typename R>
+void testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::putAssns(
+  testing::mockup::Event& event,
+  art::InputTag const& leftTag, art::InputTag const& rightTag,
+  art::InputTag const& assnsTag, IndexPairs_t pairs, std::mt19937& engine
+) {
+  testing::mockup::PtrMaker<L> const makeLeftPtr { event, leftTag };
+  testing::mockup::PtrMaker<R> const makeRightPtr { event, rightTag };
+  std::shuffle(pairs.begin(), pairs.end(), engine);
+  art::Assns<L, R> assns;
+  for (auto const& [ left, right ]: pairs)
+    assns.addSingle(makeLeftPtr(left), makeRightPtr(right));
+  event.put(std::move(assns), assnsTag);
+} // testing::mockup::SyntheticEventGenerator::putAssns()
+
+
+// -----------------------------------------------------------------------------
+template <typename Track, typename Cluster, typename Hit>
+void
+testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>::fillWaveforms
+  (std::vector<raw::OpDetWaveform>& waveforms) const
+{
+  /*
+   * Flashes are spread between -1 and +1 ms; each channel has a waveform
+   * starting 10 us before each flash, with a random jitter of 10 ns.
+   */
+  std::mt19937 engine { fConfig.seed };
+  std::size_t const nSamples = fConfig.samplesPerWaveform;
+  std::normal_distribution<double> noise { 0.0, fConfig.noiseRMS };
+  std::uniform_real_distribution<double> uniform { 0.0, 1.0 };
+
+  std::vector<double> flashTimes; // [us]
+  for (std::size_t i = 0; i < fConfig.waveformsPerChannel; ++i)
+    flashTimes.push_back(-1000.0 + 2000.0 * uniform(engine));
+  std::sort(flashTimes.begin(), flashTimes.end());
+
+  waveforms.reserve(waveforms.size() + fConfig.nOpChannels * flashTimes.size());
+  for (unsigned int channel = 0; channel < fConfig.nOpChannels; ++channel) {
+    double const baseline = 14900.0 + 50.0 * uniform(engine);
+    for (double const flashTime: flashTimes) {
+      double const time = flashTime - 10.0 + 0.01 * uniform(engine);
+      std::vector<raw::ADC_Count_t> samples(nSamples);
+      for (raw::ADC_Count_t& sample: samples)
+        sample = static_cast<raw::ADC_Count_t>(baseline + noise(engine));
+      // negative pulses, away from the first samples used for baselines
+      unsigned int const nPulses = fConfig.pulsesPerWaveform;
+      for (unsigned int iPulse = 0; iPulse < nPulses; ++iPulse) {
+        std::size_t const start = static_cast<std::size_t>
+          (nSamples * (0.5 + 0.5 * uniform(engine)));
+        double const amplitude = 50.0 + 2000.0 * uniform(engine);
+        for (std::size_t i = start; i < std::min(start + 40, nSamples); ++i) {
+          samples[i] -= static_cast<raw::ADC_Count_t>
+            (amplitude * std::exp(-(i - start) / 8.0));
+        }
+      } // for pulses
+      waveforms.emplace_back(time, channel, std::move(samples));
+    } // for flashes
+  } // for channels
+
+} // testing::mockup::SyntheticEventGenerator::fillWaveforms()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSALG_TEST_SYNTHETICEVENTGENERATOR_H
@@ -18,12 +18,16 @@
 // ICARUS and LArSoft libraries
 #include "test/FrameworkEventMockup.h"
 #include "larcorealg/CoreUtils/enumerate.h"
+#include "larcorealg/CoreUtils/DebugUtils.h" // lar::debug::demangle()
 
 // C/C++ standard libraries
+#include <algorithm> // std::is_sorted()
 #include <map>
 #include <vector>
 #include <any>
-#include <stdexcept> // std::runtime_error
+#include <optional>
+#include <stdexcept> // std::runtime_error, std::logic_error
+#include <string>
 #include <typeindex>
 #include <typeinfo>
 #include <utility> // std::move()
@@ -249,7 +253,9 @@ void AssnsCrosser1_test() {
   {
     auto const& Bs = AtoB.assPtrs(makeAptr(0));
     static_assert
-      (std::is_same_v<decltype(Bs), std::vector<art::Ptr<DataTypeB>> const&>);
+      (std::is_same_v
+        <decltype(Bs), gsl::span<art::Ptr<DataTypeB> const> const&>
+      );
     
     BOOST_TEST(Bs.empty());
   }
@@ -291,7 +297,9 @@ void AssnsCrosser1_test() {
   {
     auto const& Bs = AtoB.assPtrs(makeAptr(6));
     static_assert
-      (std::is_same_v<decltype(Bs), std::vector<art::Ptr<DataTypeB>> const&>);
+      (std::is_same_v
+        <decltype(Bs), gsl::span<art::Ptr<DataTypeB> const> const&>
+      );
     BOOST_TEST(Bs.empty());
   }
   
@@ -336,7 +344,9 @@ void AssnsCrosser2check(
   {
     auto const& Cs = AtoC.assPtrs(makeAptr(0));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     
     BOOST_TEST(Cs.empty());
   }
@@ -373,7 +383,9 @@ void AssnsCrosser2check(
   {
     auto const& Cs = AtoC.assPtrs(makeAptr(5));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     BOOST_TEST(Cs.empty());
   }
   
@@ -474,6 +486,91 @@ void AssnsCrosserDiamond_test() {
 } // AssnsCrosserDiamond_test()
 
 
+//------------------------------------------------------------------------------
+void AssnsCrosserSharedMiddle_test() {
+  /*
+   * Test with intermediate objects shared by more than one key, comparing the
+   * index-based and the pointer-based engines.
+   */
+  
+  std::vector<DataTypeA> dataA
+    { DataTypeA{ 10 }, DataTypeA{ 11 }, DataTypeA{ 12 } };
+  std::vector<DataTypeB> dataB { DataTypeB{ 20 }, DataTypeB{ 21 } };
+  std::vector<DataTypeC> dataC { DataTypeC{ 30 }, DataTypeC{ 31 } };
+  
+  testing::mockup::Event event;
+  
+  event.put(std::move(dataA), art::InputTag{ "A" });
+  event.put(std::move(dataB), art::InputTag{ "B" });
+  event.put(std::move(dataC), art::InputTag{ "C" });
+  
+  testing::mockup::PtrMaker<DataTypeA> makeAptr{ event, art::InputTag{ "A" } };
+  testing::mockup::PtrMaker<DataTypeB> makeBptr{ event, art::InputTag{ "B" } };
+  testing::mockup::PtrMaker<DataTypeC> makeCptr{ event, art::InputTag{ "C" } };
+  
+  /*
+   * The plan:
+   *  A[0] <=> B[0]
+   *  A[1] <=> B[0]
+   *  A[2] <=> B[1]
+   * 
+   *  B[0] <=> C[0], C[1]
+   *  B[1] <=> C[1]
+   */
+  art::Assns<DataTypeA, DataTypeB> assnsAB;
+  assnsAB.addSingle(makeAptr(2), makeBptr(1));
+  assnsAB.addSingle(makeAptr(0), makeBptr(0));
+  assnsAB.addSingle(makeAptr(1), makeBptr(0));
+  event.put(std::move(assnsAB), art::InputTag{ "B" });
+  
+  art::Assns<DataTypeB, DataTypeC> assnsBC;
+  assnsBC.addSingle(makeBptr(0), makeCptr(0));
+  assnsBC.addSingle(makeBptr(1), makeCptr(1));
+  assnsBC.addSingle(makeBptr(0), makeCptr(1));
+  event.put(std::move(assnsBC), art::InputTag{ "C" });
+  
+  using icarus::ns::util::InputSpecs;
+  using NoSelector_t = icarus::ns::util::details::PointerSelector<DataTypeA>;
+  
+  auto const indexMap = icarus::ns::util::details::IndexJoiner
+    <DataTypeA, DataTypeB, DataTypeC>::join(
+      event, InputSpecs<DataTypeB>{ "B" }, InputSpecs<DataTypeC>{ "C" },
+      std::optional<NoSelector_t>{}
+    );
+  BOOST_TEST_REQUIRE(indexMap.has_value());
+  
+  icarus::ns::util::details::FlatAssnsMap<DataTypeA, DataTypeC> const ptrMap {
+    icarus::ns::util::details::MapJoiner<DataTypeA, DataTypeB, DataTypeC>
+      ::joinForward(event, "B", "C", std::optional<NoSelector_t>{})
+    };
+  
+  std::vector<std::vector<art::Ptr<DataTypeC>>> const expected {
+    { makeCptr(0), makeCptr(1) },
+    { makeCptr(0), makeCptr(1) },
+    { makeCptr(1) }
+  };
+  
+  for (auto const& [ iA, expectedCs ]: util::enumerate(expected)) {
+    BOOST_TEST_CONTEXT("A[" << iA << "]") {
+      auto const indexCs = indexMap->assPtrs(makeAptr(iA));
+      auto const ptrCs = ptrMap.assPtrs(makeAptr(iA));
+      BOOST_CHECK_EQUAL_COLLECTIONS(
+        indexCs.begin(), indexCs.end(), expectedCs.begin(), expectedCs.end()
+        );
+      BOOST_CHECK_EQUAL_COLLECTIONS(
+        ptrCs.begin(), ptrCs.end(), expectedCs.begin(), expectedCs.end()
+        );
+    }
+  } // for
+  
+  // the same through the public interface
+  auto const AtoC = icarus::ns::util::makeAssnsCrosser<DataTypeA>
+    (event, InputSpecs<DataTypeB>{ "B" }, InputSpecs<DataTypeC>{ "C" });
+  BOOST_TEST(AtoC.assPtrs(makeAptr(1)).size() == 2);
+  
+} // AssnsCrosserSharedMiddle_test()
+
+
 //------------------------------------------------------------------------------
 void AssnsCrosser3check(
   testing::mockup::Event const& event,
@@ -524,7 +621,9 @@ void AssnsCrosser3check(
   {
     auto const& Ds = AtoD.assPtrs(makeAptr(0));
     static_assert
-      (std::is_same_v<decltype(Ds), std::vector<art::Ptr<DataTypeD>> const&>);
+      (std::is_same_v
+        <decltype(Ds), gsl::span<art::Ptr<DataTypeD> const> const&>
+      );
     
     BOOST_TEST(Ds.empty());
   }
@@ -556,7 +655,9 @@ void AssnsCrosser3check(
   {
     auto const& Ds = AtoD.assPtrs(makeAptr(5));
     static_assert
-      (std::is_same_v<decltype(Ds), std::vector<art::Ptr<DataTypeD>> const&>);
+      (std::is_same_v
+        <decltype(Ds), gsl::span<art::Ptr<DataTypeD> const> const&>
+      );
     BOOST_TEST(Ds.empty());
   }
   
@@ -700,7 +801,9 @@ void AssnsCrosserInputList1_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeA1ptr(0));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     
     BOOST_TEST(Cs.empty());
   }
@@ -718,7 +821,9 @@ void AssnsCrosserInputList1_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeA1ptr(2));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     BOOST_TEST(Cs.empty());
   }
   
@@ -744,7 +849,9 @@ void AssnsCrosserInputList1_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeA2ptr(3));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     BOOST_TEST(Cs.empty());
   }
   
@@ -775,7 +882,9 @@ void AssnsCrosserStartList1_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeAptr(0));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     
     BOOST_TEST(Cs.empty());
   }
@@ -808,7 +917,9 @@ void AssnsCrosserStartList1_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeAptr(5));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     BOOST_TEST(Cs.empty());
   }
   
@@ -871,7 +982,9 @@ void AssnsCrosserStartList4_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeAptr(0));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     
     BOOST_TEST(Cs.empty());
   }
@@ -904,7 +1017,9 @@ void AssnsCrosserStartList4_test() {
   {
     auto const& Cs = AtoC.assPtrs(makeAptr(5));
     static_assert
-      (std::is_same_v<decltype(Cs), std::vector<art::Ptr<DataTypeC>> const&>);
+      (std::is_same_v
+        <decltype(Cs), gsl::span<art::Ptr<DataTypeC> const> const&>
+      );
     BOOST_TEST(Cs.empty());
   }
   
@@ -1055,9 +1170,469 @@ void InputSpecsClassDocumentation_test() {
 } // InputSpecsClassDocumentation_test()
 
 
+//------------------------------------------------------------------------------
+void FlatAssnsMap_test() {
+  /*
+   * Tests the compact association map on its own.
+   */
+  
+  testing::mockup::Event const event = makeTestEvent1();
+  
+  testing::mockup::PtrMaker<DataTypeA> makeA1ptr
+    { event, art::InputTag{ "A1" } };
+  testing::mockup::PtrMaker<DataTypeA> makeA2ptr
+    { event, art::InputTag{ "A2" } };
+  testing::mockup::PtrMaker<DataTypeB> makeBptr{ event, art::InputTag{ "B" } };
+  
+  // keys from two data products, added out of order; one key with no targets
+  icarus::ns::util::details::AssnsMap<DataTypeA, DataTypeB> map;
+  map.add(makeA2ptr(1), makeBptr(3));
+  map.add(makeA1ptr(1), makeBptr(0));
+  map.add(makeA2ptr(0), std::vector{ makeBptr(2), makeBptr(4) });
+  map.add(makeA1ptr(1), makeBptr(1));
+  map.add(makeA1ptr(0), std::vector<art::Ptr<DataTypeB>>{});
+  
+  icarus::ns::util::details::FlatAssnsMap<DataTypeA, DataTypeB> const flatMap
+    { std::move(map) };
+  
+  BOOST_TEST(map.empty());
+  BOOST_TEST(!flatMap.empty());
+  BOOST_TEST(flatMap.nKeys() == 3);
+  BOOST_TEST(flatMap.nTargets() == 5);
+  
+  std::vector<art::Ptr<DataTypeA>> const& keys = flatMap.keys();
+  BOOST_TEST(std::is_sorted(keys.begin(), keys.end()));
+  
+  BOOST_TEST(flatMap.assPtrs(makeA1ptr(0)).empty());
+  
+  {
+    auto const Bs = flatMap.assPtrs(makeA1ptr(1));
+    BOOST_TEST(Bs.size() == 2);
+    if (Bs.size() > 0) BOOST_TEST(Bs[0] == makeBptr(0));
+    if (Bs.size() > 1) BOOST_TEST(Bs[1] == makeBptr(1));
+  }
+  
+  {
+    auto const Bs = flatMap.assPtrs(makeA2ptr(0));
+    BOOST_TEST(Bs.size() == 2);
+    if (Bs.size() > 0) BOOST_TEST(Bs[0] == makeBptr(2));
+    if (Bs.size() > 1) BOOST_TEST(Bs[1] == makeBptr(4));
+  }
+  
+  {
+    auto const Bs = flatMap.assPtrs(makeA2ptr(1));
+    BOOST_TEST(Bs.size() == 1);
+    if (Bs.size() > 0) BOOST_TEST(Bs[0] == makeBptr(3));
+  }
+  
+  BOOST_TEST(flatMap.assPtrs(makeA2ptr(2)).empty());
+  
+} // FlatAssnsMap_test()
+
+
+//------------------------------------------------------------------------------
+void HopStats_test() {
+  
+  testing::mockup::Event const event = makeTestEvent1();
+  
+  icarus::ns::util::details::HopStats stats;
+  stats.add(event.getProduct<art::Assns<DataTypeB, DataTypeC>>("C"));
+  
+  BOOST_TEST(stats.nAssns == 7);
+  BOOST_TEST(stats.nLeft == 4);
+  BOOST_TEST(stats.nRight == 7);
+  BOOST_TEST(stats.fanOut() == 7.0 / 4.0);
+  
+  // C[0] appears twice
+  stats.add(event.getProduct<art::Assns<DataTypeC, DataTypeD>>("D"));
+  BOOST_TEST(stats.nAssns == 13);
+  BOOST_TEST(stats.nLeft == 9);
+  BOOST_TEST(stats.nRight == 13);
+  
+} // HopStats_test()
+
+
+//------------------------------------------------------------------------------
+void TraversalCostModel_test() {
+  
+  using icarus::ns::util::details::HopStats;
+  using icarus::ns::util::details::TraversalCostModel;
+  
+  // each hop is: { associations, left elements, right elements }
+  
+  // a handful of keys into a large association: forward
+  {
+    TraversalCostModel const model
+      { { { 1000, 1000, 1000 }, { 1000000, 1000, 1000000 } }, 2 };
+    BOOST_TEST(model.nHops() == 2);
+    BOOST_TEST(model.bestSplit() == 2);
+    BOOST_TEST(model.cost(2) < model.cost(0));
+  }
+  
+  // all keys, but a tiny last hop: backward
+  {
+    TraversalCostModel const model
+      { { { 1000000, 1000, 1000000 }, { 10, 10, 10 } } };
+    BOOST_TEST(model.bestSplit() == 0);
+    BOOST_TEST(model.cost(0) < model.cost(2));
+  }
+  
+  // too many keys for the start list to matter: same as no selection
+  {
+    std::vector<HopStats> const hops
+      { { 1000000, 1000, 1000000 }, { 10, 10, 10 } };
+    BOOST_TEST(
+      TraversalCostModel(hops, 5000).cost(2) == TraversalCostModel(hops).cost(2)
+      );
+  }
+  
+  // fan-in to few elements, then fan-out and a sparse end: from the middle
+  {
+    TraversalCostModel const model{ {
+      { 100000, 100, 100000 }, { 100000, 100000, 100 },
+      { 1000000, 100, 1000000 }, { 1000, 1000, 1000 }
+      } };
+    BOOST_TEST(model.nHops() == 4);
+    BOOST_TEST(model.bestSplit() == 2);
+    for (std::size_t split: { 0, 1, 3, 4 })
+      BOOST_TEST(model.cost(2) < model.cost(split));
+  }
+  
+  // a tie goes forward
+  {
+    TraversalCostModel const model{ { { 10, 10, 10 } } };
+    BOOST_TEST(model.cost(0) == model.cost(1));
+    BOOST_TEST(model.bestSplit() == 1);
+  }
+  
+} // TraversalCostModel_test()
+
+
+//------------------------------------------------------------------------------
+void AssnsCrosserTraversal_test() {
+  /*
+   * All the traversal algorithms must give the same result.
+   * See `makeTestEvent1()` for the plan.
+   */
+  
+  testing::mockup::Event const event = makeTestEvent1();
+  
+  testing::mockup::PtrMaker<DataTypeA> makeAptr{ event, art::InputTag{ "A" } };
+  testing::mockup::PtrMaker<DataTypeD> makeDptr{ event, art::InputTag{ "D" } };
+  
+  using Selector_t = icarus::ns::util::details::PointerSelector<DataTypeA>;
+  using Joiner_t = icarus::ns::util::details::MapJoiner
+    <DataTypeA, DataTypeB, DataTypeC, DataTypeD>;
+  using Map_t = icarus::ns::util::details::FlatAssnsMap<DataTypeA, DataTypeD>;
+  
+  auto sorted = [](auto const& ptrs)
+    {
+      std::vector<art::Ptr<DataTypeD>> sortedPtrs{ ptrs.begin(), ptrs.end() };
+      std::sort(sortedPtrs.begin(), sortedPtrs.end());
+      return sortedPtrs;
+    };
+  
+  std::vector<std::vector<art::Ptr<DataTypeD>>> const expected {
+    {},
+    { makeDptr(0), makeDptr(1), makeDptr(2) },
+    {},
+    {},
+    {}
+  };
+  
+  std::optional<Selector_t> const noSelection;
+  std::vector<std::pair<std::string, Map_t>> maps;
+  maps.emplace_back("forward",
+    Map_t{ Joiner_t::joinForward(event, "B", "C", "D", noSelection) });
+  maps.emplace_back("backward",
+    Map_t{ Joiner_t::joinBackward(event, "B", "C", "D", noSelection) });
+  for (std::size_t split: { 1, 2 }) {
+    maps.emplace_back("split " + std::to_string(split), Map_t{
+      Joiner_t::joinFromMiddle(split, event, "B", "C", "D", noSelection)
+      });
+  }
+  
+  for (auto const& [ name, map ]: maps) {
+    BOOST_TEST_CONTEXT(name) {
+      for (auto const& [ iA, expectedDs ]: util::enumerate(expected)) {
+        BOOST_TEST_CONTEXT("A[" << iA << "]") {
+          auto const Ds = sorted(map.assPtrs(makeAptr(iA)));
+          BOOST_CHECK_EQUAL_COLLECTIONS
+            (Ds.begin(), Ds.end(), expectedDs.begin(), expectedDs.end());
+        }
+      } // for
+    }
+  } // for
+  
+  BOOST_CHECK_THROW(
+    Joiner_t::joinFromMiddle(0, event, "B", "C", "D", noSelection),
+    std::logic_error
+    );
+  BOOST_CHECK_THROW(
+    Joiner_t::joinFromMiddle(3, event, "B", "C", "D", noSelection),
+    std::logic_error
+    );
+  
+  // selection of keys, with and without associations
+  std::optional<Selector_t> const selection{ std::in_place,
+    std::vector{ makeAptr(1), makeAptr(2) }, std::vector<art::ProductID>{}
+    };
+  Map_t const backwardSelected
+    { Joiner_t::joinBackward(event, "B", "C", "D", selection) };
+  Map_t const middleSelected
+    { Joiner_t::joinFromMiddle(1, event, "B", "C", "D", selection) };
+  for (Map_t const* map: { &backwardSelected, &middleSelected }) {
+    BOOST_TEST(map->nKeys() == 1);
+    auto const Ds = sorted(map->assPtrs(makeAptr(1)));
+    BOOST_CHECK_EQUAL_COLLECTIONS
+      (Ds.begin(), Ds.end(), expected[1].begin(), expected[1].end());
+  } // for
+  
+} // AssnsCrosserTraversal_test()
+
+
+//------------------------------------------------------------------------------
+void AssnsCrosserOptions_test() {
+  /*
+   * Concurrent reading must give the same result as the serial one,
+   * and one timing record must be added for each hop.
+   * See `makeTestEvent1()` for the plan.
+   */
+  
+  testing::mockup::Event const event = makeTestEvent1();
+  
+  testing::mockup::PtrMaker<DataTypeA> makeAptr{ event, art::InputTag{ "A" } };
+  testing::mockup::PtrMaker<DataTypeA> makeA1ptr
+    { event, art::InputTag{ "A1" } };
+  testing::mockup::PtrMaker<DataTypeA> makeA2ptr
+    { event, art::InputTag{ "A2" } };
+  
+  using icarus::ns::util::AssnsCrosserHopTiming;
+  using icarus::ns::util::AssnsCrosserOptions;
+  using icarus::ns::util::hopTo;
+  using Selector_t = icarus::ns::util::details::PointerSelector<DataTypeA>;
+  using MapAC_t = icarus::ns::util::details::FlatAssnsMap<DataTypeA, DataTypeC>;
+  using MapAD_t = icarus::ns::util::details::FlatAssnsMap<DataTypeA, DataTypeD>;
+  
+  auto checkRecord = [](
+    AssnsCrosserHopTiming const& record,
+    std::string const& left, std::string const& right,
+    std::size_t nProducts, std::size_t nAssns
+  ) {
+    BOOST_TEST(record.left == left);
+    BOOST_TEST(record.right == right);
+    BOOST_TEST(record.nProducts == nProducts);
+    BOOST_TEST(record.nAssns == nAssns);
+    BOOST_TEST(record.readTime >= 0.0);
+    BOOST_TEST(record.mergeTime >= 0.0);
+    BOOST_TEST(record.joinTime >= 0.0);
+    BOOST_TEST(record.totalTime()
+      == record.readTime + record.mergeTime + record.joinTime);
+  };
+  
+  std::string const nameA = lar::debug::demangle<DataTypeA>();
+  std::string const nameB = lar::debug::demangle<DataTypeB>();
+  std::string const nameC = lar::debug::demangle<DataTypeC>();
+  std::string const nameD = lar::debug::demangle<DataTypeD>();
+  
+  std::optional<Selector_t> const noSelection;
+  
+  //
+  // pointer-based engine, with two data products in the first hop
+  //
+  using MapJoinerAC_t
+    = icarus::ns::util::details::MapJoiner<DataTypeA, DataTypeB, DataTypeC>;
+  
+  std::vector<AssnsCrosserHopTiming> timing;
+  MapAC_t const serialMap{ MapJoinerAC_t::joinForward
+    (event, hopTo<DataTypeB>{ "B:1", "B:2" }, "C", noSelection)
+    };
+  MapAC_t const concurrentMap{ MapJoinerAC_t::joinForward(
+    event, hopTo<DataTypeB>{ "B:1", "B:2" }, "C", noSelection,
+    AssnsCrosserOptions{ 4U, &timing }
+    ) };
+  
+  BOOST_TEST(concurrentMap.nKeys() == serialMap.nKeys());
+  BOOST_TEST(concurrentMap.nTargets() == serialMap.nTargets());
+  for (art::Ptr<DataTypeA> const& ptrA: {
+    makeA1ptr(0), makeA1ptr(1), makeA2ptr(0), makeA2ptr(1), makeA2ptr(2)
+  }) {
+    BOOST_TEST_CONTEXT("A: " << ptrA) {
+      auto const expected = serialMap.assPtrs(ptrA);
+      auto const Cs = concurrentMap.assPtrs(ptrA);
+      BOOST_CHECK_EQUAL_COLLECTIONS
+        (Cs.begin(), Cs.end(), expected.begin(), expected.end());
+    }
+  } // for
+  
+  BOOST_TEST(timing.size() == 2);
+  if (timing.size() == 2) {
+    checkRecord(timing[0], nameA, nameB, 2, 4);
+    checkRecord(timing[1], nameB, nameC, 1, 7);
+  }
+  
+  //
+  // index-based engine
+  //
+  using IndexJoiner_t = icarus::ns::util::details::IndexJoiner
+    <DataTypeA, DataTypeB, DataTypeC, DataTypeD>;
+  
+  timing.clear();
+  std::optional<MapAD_t> const indexMap = IndexJoiner_t::join
+    (event, "B", "C", "D", noSelection, AssnsCrosserOptions{ 3U, &timing });
+  BOOST_TEST(indexMap.has_value());
+  
+  BOOST_TEST(timing.size() == 3);
+  if (timing.size() == 3) {
+    checkRecord(timing[0], nameA, nameB, 1, 4);
+    checkRecord(timing[1], nameB, nameC, 1, 7);
+    checkRecord(timing[2], nameC, nameD, 1, 6);
+  }
+  
+  //
+  // full object, using as many threads as the hardware supports
+  //
+  using icarus::ns::util::startFrom;
+  icarus::ns::util::AssnsCrosser<DataTypeA, DataTypeB, DataTypeC, DataTypeD>
+  const serialAtoD{ event, "B", "C", "D" };
+  
+  timing.clear();
+  icarus::ns::util::AssnsCrosser const concurrentAtoD{
+    event, AssnsCrosserOptions{ 0U, &timing },
+    startFrom<DataTypeA>{},
+    hopTo<DataTypeB>{ "B" }, hopTo<DataTypeC>{ "C" }, hopTo<DataTypeD>{ "D" }
+    };
+  BOOST_TEST(!timing.empty());
+  
+  for (std::size_t iA = 0; iA < 5; ++iA) {
+    BOOST_TEST_CONTEXT("A[" << iA << "]") {
+      auto const expected = serialAtoD.assPtrs(makeAptr(iA));
+      auto const Ds = concurrentAtoD.assPtrs(makeAptr(iA));
+      BOOST_CHECK_EQUAL_COLLECTIONS
+        (Ds.begin(), Ds.end(), expected.begin(), expected.end());
+    }
+  } // for
+  
+} // AssnsCrosserOptions_test()
+
+
+//------------------------------------------------------------------------------
+void AssnsCrosserCache_test() {
+  /*
+   * Crossers sharing a cache must give the same result as independent ones,
+   * and reuse the hops crossed by the previous ones.
+   * See `makeTestEvent1()` for the plan.
+   */
+  
+  testing::mockup::Event const event = makeTestEvent1();
+  
+  testing::mockup::PtrMaker<DataTypeA> makeAptr{ event, art::InputTag{ "A" } };
+  testing::mockup::PtrMaker<DataTypeA> makeA1ptr
+    { event, art::InputTag{ "A1" } };
+  
+  using icarus::ns::util::AssnsCrosser;
+  using icarus::ns::util::AssnsCrosserCache;
+  using icarus::ns::util::AssnsCrosserOptions;
+  using icarus::ns::util::startFrom, icarus::ns::util::hopTo;
+  
+  auto checkSame = [](auto const& crosser, auto const& expected, auto ptrA)
+    {
+      BOOST_TEST_CONTEXT("A: " << ptrA) {
+        auto const expectedPtrs = expected.assPtrs(ptrA);
+        auto const ptrs = crosser.assPtrs(ptrA);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+          ptrs.begin(), ptrs.end(), expectedPtrs.begin(), expectedPtrs.end()
+          );
+      }
+    };
+  
+  AssnsCrosser<DataTypeA, DataTypeB, DataTypeC> const expectedAtoC
+    { event, "B", "C" };
+  AssnsCrosser<DataTypeA, DataTypeB, DataTypeC, DataTypeD> const expectedAtoD
+    { event, "B", "C", "D" };
+  AssnsCrosser<DataTypeA, DataTypeB, DataTypeC> const expectedA1toC
+    { event, "B:1", "C" };
+  
+  AssnsCrosserCache cache;
+  AssnsCrosserOptions const options{ 1U, nullptr, &cache };
+  BOOST_TEST(cache.empty());
+  BOOST_TEST(cache.hits() == 0);
+  BOOST_TEST(cache.misses() == 0);
+  
+  // first crosser: nothing to reuse; A => B and A => B => C are memoized
+  AssnsCrosser const AtoC{ event, options,
+    startFrom<DataTypeA>{}, hopTo<DataTypeB>{ "B" }, hopTo<DataTypeC>{ "C" }
+    };
+  BOOST_TEST(cache.hits() == 0);
+  BOOST_TEST(cache.misses() == 1);
+  BOOST_TEST(cache.size() == 2);
+  
+  // A => B => C is reused, C => D is crossed
+  AssnsCrosser const AtoD{ event, options,
+    startFrom<DataTypeA>{},
+    hopTo<DataTypeB>{ "B" }, hopTo<DataTypeC>{ "C" }, hopTo<DataTypeD>{ "D" }
+    };
+  BOOST_TEST(cache.hits() == 1);
+  BOOST_TEST(cache.misses() == 1);
+  BOOST_TEST(cache.size() == 3);
+  
+  // all reused
+  AssnsCrosser const AtoCagain{ event, options,
+    startFrom<DataTypeA>{}, hopTo<DataTypeB>{ "B" }, hopTo<DataTypeC>{ "C" }
+    };
+  BOOST_TEST(cache.hits() == 2);
+  BOOST_TEST(cache.misses() == 1);
+  BOOST_TEST(cache.size() == 3);
+  
+  // different input tag, different chain
+  AssnsCrosser const A1toC{ event, options,
+    startFrom<DataTypeA>{}, hopTo<DataTypeB>{ "B:1" }, hopTo<DataTypeC>{ "C" }
+    };
+  BOOST_TEST(cache.hits() == 2);
+  BOOST_TEST(cache.misses() == 2);
+  BOOST_TEST(cache.size() == 5);
+  
+  // with a selection of keys the cache is not used
+  AssnsCrosser const selectedAtoC{ event, options,
+    startFrom<DataTypeA>{ makeAptr(1), makeAptr(2) },
+    hopTo<DataTypeB>{ "B" }, hopTo<DataTypeC>{ "C" }
+    };
+  BOOST_TEST(cache.hits() == 2);
+  BOOST_TEST(cache.misses() == 2);
+  BOOST_TEST(cache.size() == 5);
+  
+  for (std::size_t iA = 0; iA < 5; ++iA) {
+    checkSame(AtoC, expectedAtoC, makeAptr(iA));
+    checkSame(AtoCagain, expectedAtoC, makeAptr(iA));
+    checkSame(AtoD, expectedAtoD, makeAptr(iA));
+  }
+  for (std::size_t iA = 0; iA < 2; ++iA)
+    checkSame(A1toC, expectedA1toC, makeA1ptr(iA));
+  checkSame(selectedAtoC, expectedAtoC, makeAptr(1));
+  checkSame(selectedAtoC, expectedAtoC, makeAptr(2));
+  BOOST_TEST(selectedAtoC.assPtrs(makeAptr(3)).empty());
+  
+  cache.clear();
+  BOOST_TEST(cache.empty());
+  BOOST_TEST(cache.hits() == 2);
+  BOOST_TEST(cache.misses() == 2);
+  cache.resetCounters();
+  BOOST_TEST(cache.hits() == 0);
+  BOOST_TEST(cache.misses() == 0);
+  
+} // AssnsCrosserCache_test()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
+BOOST_AUTO_TEST_CASE( FlatAssnsMap_testCase ) {
+  
+  FlatAssnsMap_test();
+  
+} // BOOST_AUTO_TEST_CASE( FlatAssnsMap_testCase )
+
+
 BOOST_AUTO_TEST_CASE( AssnsCrosser1_testCase ) {
   
   AssnsCrosser1_test();
@@ -1069,6 +1644,7 @@ BOOST_AUTO_TEST_CASE( AssnsCrosser2_testCase ) {
   
   AssnsCrosser2_test();
   AssnsCrosserDiamond_test();
+  AssnsCrosserSharedMiddle_test();
   
 } // BOOST_AUTO_TEST_CASE( AssnsCrosser2_testCase )
 
@@ -1102,6 +1678,24 @@ BOOST_AUTO_TEST_CASE( AssnsCrosserStart_testCase ) {
 } // BOOST_AUTO_TEST_CASE( AssnsCrosserStart_testCase )
 
 
+BOOST_AUTO_TEST_CASE( AssnsCrosserTraversal_testCase ) {
+  
+  HopStats_test();
+  TraversalCostModel_test();
+  AssnsCrosserTraversal_test();
+  
+} // BOOST_AUTO_TEST_CASE( AssnsCrosserTraversal_testCase )
+
+
+BOOST_AUTO_TEST_CASE( AssnsCrosserOptions_testCase ) {
+  
+  AssnsCrosserOptions_test();
+  AssnsCrosserCache_test();
+  
+} // BOOST_AUTO_TEST_CASE( AssnsCrosserOptions_testCase )
+
+
+//------------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE( AssnsCrosserDocumentation_testCase ) {
   
   AssnsCrosserClassDocumentation_test();
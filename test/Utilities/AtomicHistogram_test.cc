@@ -0,0 +1,147 @@
+/**
+ * @file   AtomicHistogram_test.cc
+ * @brief  Unit test for `icarus::ns::util::AtomicHistogram`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/AtomicHistogram.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE AtomicHistogram
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/AtomicHistogram.h"
+
+// ROOT
+#include "TH1D.h"
+#include "TH2D.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <thread>
+
+
+//------------------------------------------------------------------------------
+void fill1DTest() {
+
+  constexpr unsigned int NThreads = 8U;
+  constexpr int NValues = 20000;
+
+  // values span beyond the histogram range on both sides
+  auto valueOf = [](unsigned int iThread, int i)
+    { return -6.0 + 0.0007 * (i + 7 * iThread); };
+  auto weightOf = [](int i){ return (i % 3 == 0)? 0.5: 1.0; };
+
+  icarus::ns::util::AtomicHist1D content { { { 100U, -5.0, 5.0 } } };
+  BOOST_TEST(content.nCells() == 102U);
+
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&content,&valueOf,&weightOf,iThread]()
+      {
+        for (int i = 0; i < NValues; ++i)
+          content.fill(valueOf(iThread, i), weightOf(i));
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  BOOST_TEST(content.entries() == NThreads * NValues);
+  BOOST_TEST(content.weighted());
+
+  TH1D expected { "HExpected", "Expected", 100, -5.0, 5.0 };
+  expected.SetDirectory(nullptr);
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread)
+    for (int i = 0; i < NValues; ++i)
+      expected.Fill(valueOf(iThread, i), weightOf(i));
+
+  TH1D hist { "HTest", "Test", 100, -5.0, 5.0 };
+  hist.SetDirectory(nullptr);
+  content.transferTo(hist);
+
+  BOOST_TEST(hist.GetEntries() == expected.GetEntries());
+  for (int bin = 0; bin <= 101; ++bin) {
+    BOOST_TEST_CONTEXT("bin: " << bin) {
+      BOOST_TEST(hist.GetBinContent(bin) == expected.GetBinContent(bin));
+      BOOST_TEST(hist.GetBinError(bin) == expected.GetBinError(bin),
+        1e-6 % boost::test_tools::tolerance());
+    }
+  } // for
+
+  // content is moved, not copied
+  BOOST_TEST(content.entries() == 0U);
+  BOOST_TEST(!content.weighted());
+  for (std::size_t bin = 0; bin < content.nCells(); ++bin)
+    BOOST_TEST(content.binContent(bin) == 0.0);
+
+  // a second transfer adds to the existing content
+  content.fill(0.05);
+  content.transferTo(hist);
+  BOOST_TEST(hist.GetEntries() == expected.GetEntries() + 1.0);
+  BOOST_TEST(hist.GetBinContent(51) == expected.GetBinContent(51) + 1.0);
+
+} // fill1DTest()
+
+
+//------------------------------------------------------------------------------
+void fill2DTest() {
+
+  constexpr unsigned int NThreads = 4U;
+  constexpr int NValues = 10000;
+
+  auto xOf = [](unsigned int iThread, int i)
+    { return -1.0 + 0.00013 * (i + iThread); };
+  auto yOf = [](unsigned int iThread, int i)
+    { return 12.0 - 0.0011 * i * (iThread + 1); };
+
+  icarus::ns::util::AtomicHist2D content
+    { { { { 10U, 0.0, 1.0 }, { 20U, 0.0, 10.0 } } } };
+  BOOST_TEST(content.nCells() == 12U * 22U);
+
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&content,&xOf,&yOf,iThread]()
+      {
+        for (int i = 0; i < NValues; ++i)
+          content.fill(xOf(iThread, i), yOf(iThread, i));
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  BOOST_TEST(!content.weighted());
+
+  TH2D expected { "HExpected2D", "Expected", 10, 0.0, 1.0, 20, 0.0, 10.0 };
+  expected.SetDirectory(nullptr);
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread)
+    for (int i = 0; i < NValues; ++i)
+      expected.Fill(xOf(iThread, i), yOf(iThread, i));
+
+  TH2D hist { "HTest2D", "Test", 10, 0.0, 1.0, 20, 0.0, 10.0 };
+  hist.SetDirectory(nullptr);
+  content.transferTo(hist);
+
+  BOOST_TEST(hist.GetEntries() == expected.GetEntries());
+  for (int ix = 0; ix <= 11; ++ix) {
+    for (int iy = 0; iy <= 21; ++iy) {
+      BOOST_TEST_CONTEXT("bin: (" << ix << ", " << iy << ")") {
+        BOOST_TEST
+          (hist.GetBinContent(ix, iy) == expected.GetBinContent(ix, iy));
+      }
+    } // for y
+  } // for x
+
+} // fill2DTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( AtomicHistogramTestCase ) {
+
+  fill1DTest();
+  fill2DTest();
+
+} // BOOST_AUTO_TEST_CASE( AtomicHistogramTestCase )
+
+
+//------------------------------------------------------------------------------
@@ -15,6 +15,10 @@
 // ICARUS libraries
 #include "icarusalg/Utilities/BinningSpecs.h"
 
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
 
 // -----------------------------------------------------------------------------
 void BinningSpecs_NBinsFor_test() {
@@ -88,6 +92,24 @@ void BinningSpecs_test() {
 } // BinningSpecs_test()
 
 
+// -----------------------------------------------------------------------------
+void BinningSpecs_binIndices_test() {
+  
+  using icarus::ns::util::BinningSpecs;
+  
+  BinningSpecs const binning { -5.0, 8.0, 2.0 }; // range 13 split into 7 bins
+  
+  std::vector<double> values;
+  for (double value = -7.5; value < 14.0; value += 0.25) values.push_back(value);
+  std::vector<int> indices(values.size());
+  
+  binning.binIndices(values, indices);
+  for (std::size_t i = 0; i < values.size(); ++i)
+    BOOST_TEST(indices[i] == binning.binWith(values[i]));
+  
+} // BinningSpecs_binIndices_test()
+
+
 // -----------------------------------------------------------------------------
 void makeBinningFromBinWidth_alignment_test() {
   
@@ -311,6 +333,7 @@ BOOST_AUTO_TEST_CASE( BinningSpecs_testCase ) {
   
   BinningSpecs_NBinsFor_test();
   BinningSpecs_test();
+  BinningSpecs_binIndices_test();
   
 } // BOOST_AUTO_TEST_CASE( BinningSpecs_testCase )
 
@@ -13,6 +13,58 @@
 // ICARUS libraries
 #include "icarusalg/Utilities/ChangeMonitor.h"
 
+// C/C++ standard libraries
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <type_traits> // std::is_same_v
+
+
+//------------------------------------------------------------------------------
+/// A value too large for a single atomic, with all elements set the same.
+struct LargeValue {
+  std::array<int, 8U> values;
+  
+  LargeValue(int v = 0) { values.fill(v); }
+  
+}; // LargeValue
+
+bool operator== (LargeValue const& a, LargeValue const& b)
+  { return a.values == b.values; }
+
+
+/// A 16-byte value, whose `std::atomic` may need a lock (or libatomic).
+struct TwoDoubles {
+  double a = 0.0, b = 0.0;
+  
+  TwoDoubles() = default;
+  TwoDoubles(int v): a(v), b(-v) {}
+  
+}; // TwoDoubles
+
+bool operator== (TwoDoubles const& x, TwoDoubles const& y)
+  { return (x.a == y.a) && (x.b == y.b); }
+
+
+/// Returns a value of type `T` representing the number `n`.
+template <typename T>
+T makeValue(unsigned int n) {
+  if constexpr (std::is_same_v<T, std::string>) return std::to_string(n);
+  else return T(n);
+} // makeValue()
+
+
+/// Returns whether `value` is one of the values between `1` and `n`.
+template <typename T>
+bool isValid(T const& value, unsigned int n) {
+  for (unsigned int i = 1; i <= n; ++i)
+    if (value == makeValue<T>(i)) return true;
+  return false;
+} // isValid()
+
+
 
 //------------------------------------------------------------------------------
 void documentationTest() {
@@ -123,6 +175,72 @@ void ThreadSafeChangeMonitor_documentationTest() {
 } // ThreadSafeChangeMonitor_documentationTest()
 
 
+//------------------------------------------------------------------------------
+template <typename T>
+void ThreadSafeChangeMonitor_sequenceTest() {
+  
+  icarus::ns::util::ThreadSafeChangeMonitor<T> monitor;
+  BOOST_CHECK((!monitor.hasReference()));
+  
+  BOOST_CHECK((!monitor(makeValue<T>(0))));
+  BOOST_CHECK((monitor.hasReference()));
+  BOOST_TEST((monitor.reference() == makeValue<T>(0)));
+  
+  auto&& res = monitor(makeValue<T>(1));
+  BOOST_CHECK((!!res));
+  BOOST_TEST((res.value() == makeValue<T>(0)));
+  BOOST_TEST((monitor.reference() == makeValue<T>(1)));
+  
+  BOOST_CHECK((!monitor(makeValue<T>(1))));
+  BOOST_TEST((monitor.reference() == makeValue<T>(1)));
+  
+  icarus::ns::util::ThreadSafeChangeMonitor<T> const refMonitor
+    { makeValue<T>(5) };
+  BOOST_CHECK((refMonitor.hasReference()));
+  BOOST_TEST((refMonitor.reference() == makeValue<T>(5)));
+  
+} // ThreadSafeChangeMonitor_sequenceTest()
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+void ThreadSafeChangeMonitor_concurrencyTest() {
+  
+  /*
+   * Each thread updates the monitor with its own value, over and over.
+   * The values seen must all be ones that were written (not torn),
+   * and each change reported by a thread must be from a different value.
+   */
+  constexpr unsigned int NThreads = 8U;
+  constexpr unsigned int NUpdates = 20000U;
+  
+  icarus::ns::util::ThreadSafeChangeMonitor<T> monitor;
+  std::atomic<unsigned int> nChanges { 0U }, nErrors { 0U };
+  
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&monitor,&nChanges,&nErrors,iThread]()
+      {
+        T const myValue = makeValue<T>(iThread + 1U);
+        for (unsigned int i = 0; i < NUpdates; ++i) {
+          auto const prev = monitor(myValue);
+          if (!isValid(monitor.reference(), NThreads)) ++nErrors;
+          if (!prev) continue;
+          ++nChanges;
+          // a change is reported only from a different value
+          if ((*prev == myValue) || !isValid(*prev, NThreads)) ++nErrors;
+        } // for
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+  
+  BOOST_TEST(nErrors.load() == 0U);
+  BOOST_TEST(nChanges.load() > 0U);
+  BOOST_CHECK((monitor.hasReference()));
+  
+} // ThreadSafeChangeMonitor_concurrencyTest()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
@@ -140,3 +258,17 @@ BOOST_AUTO_TEST_CASE( ThreadSafeChangeMonitorTestCase ) {
 } // BOOST_AUTO_TEST_CASE( ThreadSafeChangeMonitorTestCase )
 
 
+BOOST_AUTO_TEST_CASE( LockFreeChangeMonitorTestCase ) {
+  
+  ThreadSafeChangeMonitor_sequenceTest<int>(); // atomic
+  ThreadSafeChangeMonitor_sequenceTest<TwoDoubles>(); // seqlock
+  ThreadSafeChangeMonitor_sequenceTest<LargeValue>(); // seqlock
+  ThreadSafeChangeMonitor_sequenceTest<std::string>(); // mutex
+  
+  ThreadSafeChangeMonitor_concurrencyTest<int>();
+  ThreadSafeChangeMonitor_concurrencyTest<TwoDoubles>();
+  ThreadSafeChangeMonitor_concurrencyTest<LargeValue>();
+  
+} // BOOST_AUTO_TEST_CASE( LockFreeChangeMonitorTestCase )
+
+
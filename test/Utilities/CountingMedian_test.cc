@@ -0,0 +1,122 @@
+/**
+ * @file CountingMedian_test.cc
+ * @brief Unit test for `CountingMedian` class.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 14, 2026
+ * @see icarusalg/Utilities/CountingMedian.h
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE CountingMedian
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/CountingMedian.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::nth_element()
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/// Returns the median of `data` as defined by `std::nth_element()`.
+template <typename T>
+T referenceMedian(std::vector<T> data) {
+  auto const middle = data.begin() + data.size() / 2;
+  std::nth_element(data.begin(), middle, data.end());
+  return *middle;
+} // referenceMedian()
+
+
+// -----------------------------------------------------------------------------
+void BasicTest() {
+  
+  icarus::ns::util::CountingMedian<short> counter;
+  
+  BOOST_TEST(counter.empty());
+  BOOST_TEST(counter.size() == 0U);
+  BOOST_TEST(counter.count(5) == 0U);
+  
+  counter.add(5);
+  BOOST_TEST(!counter.empty());
+  BOOST_TEST(counter.size() == 1U);
+  BOOST_TEST(counter.min() == 5);
+  BOOST_TEST(counter.max() == 5);
+  BOOST_TEST(counter.count(5) == 1U);
+  BOOST_TEST(counter.median() == 5);
+  
+  counter.add(3);
+  BOOST_TEST(counter.size() == 2U);
+  BOOST_TEST(counter.min() == 3);
+  BOOST_TEST(counter.max() == 5);
+  BOOST_TEST(counter.median() == 5); // element #1 of { 3, 5 }
+  
+  counter.add(3);
+  BOOST_TEST(counter.median() == 3); // element #1 of { 3, 3, 5 }
+  BOOST_TEST(counter.count(3) == 2U);
+  BOOST_TEST(counter.count(4) == 0U);
+  BOOST_TEST(counter.nth(0) == 3);
+  BOOST_TEST(counter.nth(1) == 3);
+  BOOST_TEST(counter.nth(2) == 5);
+  BOOST_TEST(counter.nth(3) == 5);
+  
+  // far values require relocating the counters
+  counter.add(-1000);
+  counter.add(+2000);
+  BOOST_TEST(counter.size() == 5U);
+  BOOST_TEST(counter.min() == -1000);
+  BOOST_TEST(counter.max() == +2000);
+  BOOST_TEST(counter.count(3) == 2U);
+  BOOST_TEST(counter.count(5) == 1U);
+  BOOST_TEST(counter.median() == 3); // { -1000, 3, 3, 5, 2000 }
+  
+  counter.clear();
+  BOOST_TEST(counter.empty());
+  BOOST_TEST(counter.count(3) == 0U);
+  
+  std::vector<short> const data { 7, 9, 8, 7, 7, 10 };
+  BOOST_TEST(counter.median(data.begin(), data.end()) == referenceMedian(data));
+  BOOST_TEST(counter.size() == data.size());
+  
+} // BasicTest()
+
+
+// -----------------------------------------------------------------------------
+void RandomTest() {
+  
+  std::mt19937 engine { 1234 };
+  icarus::ns::util::CountingMedian<short> counter;
+  
+  for (unsigned int iSet = 0; iSet < 200U; ++iSet) {
+    
+    // data sets with different sizes, centers and spreads
+    std::normal_distribution<double> gauss
+      { 1000.0 * (iSet % 17) - 8000.0, 1.0 + (iSet % 50) * 10.0 };
+    std::vector<short> data(1 + iSet * 3);
+    for (short& value: data) value = static_cast<short>(gauss(engine));
+    
+    counter.clear();
+    counter.add(data.begin(), data.end());
+    BOOST_TEST(counter.size() == data.size());
+    BOOST_TEST(counter.median() == referenceMedian(data));
+    
+    BOOST_TEST(counter.median(data.rbegin(), data.rend())
+      == referenceMedian(data));
+    
+  } // for
+  
+} // RandomTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(CountingMedianTestCase) {
+  
+  BasicTest();
+  RandomTest();
+  
+} // BOOST_AUTO_TEST_CASE(CountingMedianTestCase)
+
+
+// -----------------------------------------------------------------------------
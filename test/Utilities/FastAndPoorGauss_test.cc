@@ -16,6 +16,7 @@
 
 // LArSoft libraries
 #include "larcorealg/CoreUtils/counter.h"
+#include "larcorealg/CoreUtils/span.h"
 
 
 // ROOT
@@ -24,6 +25,12 @@
 #include "TF1.h"
 #include "TFitResult.h"
 
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::generate()
+#include <stdexcept> // std::invalid_argument
+#include <cstdint> // std::uintptr_t
+
 
 //------------------------------------------------------------------------------
 template <std::size_t NSamples>
@@ -68,6 +75,76 @@ void Test(TFile* pFile = nullptr, bool statChecks = true) {
 } // void Test()
 
 
+//------------------------------------------------------------------------------
+template <std::size_t NSamples>
+void StaticTableTest() {
+  
+  // the table computed by the compiler matches the standard one
+  constexpr util::StaticFastAndPoorGauss<NSamples> staticGauss {};
+  static_assert(staticGauss(0.5) > 0.0);
+  static_assert(staticGauss(0.5) == -staticGauss(0.4999));
+  
+  util::FastAndPoorGauss<NSamples> gauss;
+  util::UniformSequence<> extract { NSamples };
+  for (auto _ [[gnu::unused]]: util::counter(NSamples)) {
+    double const u = extract();
+    BOOST_CHECK_SMALL(staticGauss(u) - gauss(u), 1e-9);
+  } // for
+  
+} // StaticTableTest()
+
+
+//------------------------------------------------------------------------------
+void DynamicTableTest() {
+  
+  constexpr std::size_t NSamples = 32768U;
+  using Gauss_t = util::DynamicFastAndPoorGauss<>;
+  
+  Gauss_t const dynamicGauss { NSamples };
+  BOOST_TEST(dynamicGauss.nPoints() == NSamples);
+  auto const tableAddress
+    = reinterpret_cast<std::uintptr_t>(dynamicGauss.table());
+  BOOST_TEST(tableAddress % Gauss_t::Alignment == 0U);
+  
+  // same values as the standard table
+  util::FastAndPoorGauss<NSamples> gauss;
+  util::UniformSequence<> extract { NSamples };
+  for (auto _ [[gnu::unused]]: util::counter(NSamples)) {
+    double const u = extract();
+    BOOST_TEST(dynamicGauss(u) == gauss(u));
+  } // for
+  
+  // tables are shared only between objects with the same number of points
+  Gauss_t const sameGauss { NSamples };
+  BOOST_TEST(sameGauss.table() == dynamicGauss.table());
+  Gauss_t const coarseGauss { NSamples / 2 };
+  BOOST_TEST(coarseGauss.table() != dynamicGauss.table());
+  
+  // large tables are supported
+  Gauss_t const fineGauss { 1U << 22 };
+  BOOST_TEST(fineGauss(0.5) > 0.0);
+  BOOST_TEST(fineGauss(0.0) < -5.0);
+  
+  BOOST_CHECK_THROW(Gauss_t{ 1000U }, std::invalid_argument);
+  
+} // DynamicTableTest()
+
+
+//------------------------------------------------------------------------------
+template <typename Gauss>
+void BatchTransformTest(Gauss const& gauss) {
+  
+  std::vector<double> u(1000U);
+  std::generate(u.begin(), u.end(), util::UniformSequence<>{ 997U });
+  
+  std::vector<double> z(u.size(), 0.0);
+  gauss.transform(util::make_const_span(u), util::make_span(z));
+  
+  for (std::size_t i = 0; i < u.size(); ++i) BOOST_TEST(z[i] == gauss(u[i]));
+  
+} // BatchTransformTest()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
@@ -90,3 +167,27 @@ BOOST_AUTO_TEST_CASE( TestCase ) {
   
 } // BOOST_AUTO_TEST_CASE( TestCase )
 
+
+BOOST_AUTO_TEST_CASE( StaticTableTestCase ) {
+  
+  StaticTableTest<  16U>();
+  StaticTableTest<1024U>();
+  
+} // BOOST_AUTO_TEST_CASE( StaticTableTestCase )
+
+
+BOOST_AUTO_TEST_CASE( DynamicTableTestCase ) {
+  
+  DynamicTableTest();
+  
+} // BOOST_AUTO_TEST_CASE( DynamicTableTestCase )
+
+
+BOOST_AUTO_TEST_CASE( BatchTransformTestCase ) {
+  
+  BatchTransformTest(util::FastAndPoorGauss<1024U>{});
+  BatchTransformTest(util::StaticFastAndPoorGauss<1024U>{});
+  BatchTransformTest(util::DynamicFastAndPoorGauss<>{ 65536U });
+  
+} // BOOST_AUTO_TEST_CASE( BatchTransformTestCase )
+
@@ -0,0 +1,143 @@
+/**
+ * @file   FastPoissonAndExponential_test.cc
+ * @brief  Unit test for `util::FastPoisson` and `util::FastExponential`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/FastPoissonAndExponential.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE FastPoissonAndExponential
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/FastPoissonAndExponential.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::generate()
+#include <stdexcept> // std::invalid_argument
+#include <cmath> // std::exp(), std::lgamma(), std::log(), std::abs()
+
+
+//------------------------------------------------------------------------------
+void ExponentialTest() {
+
+  constexpr unsigned int NPoints = 1'000'000U;
+
+  util::FastExponential<> const expo { 1U << 16 };
+  BOOST_TEST(expo.nPoints() == (1U << 16));
+  BOOST_CHECK_THROW(util::FastExponential<>{ 1000U }, std::invalid_argument);
+
+  util::ExponentialTransformer<double> const scale { 25.0 };
+
+  // a uniform sequence gives the moments of the tabulated distribution
+  std::vector<double> u(NPoints);
+  std::generate(u.begin(), u.end(), util::UniformSequence<>{ NPoints });
+  std::vector<double> t(NPoints);
+  expo.transform(u, t);
+
+  double sum = 0.0, sumSq = 0.0, tMax = 0.0;
+  unsigned int nAboveMedian = 0U;
+  for (unsigned int i = 0; i < NPoints; ++i) {
+    BOOST_TEST(t[i] == expo(u[i])); // batch and single are the same
+    sum += t[i];
+    sumSq += t[i] * t[i];
+    tMax = std::max(tMax, t[i]);
+    if (t[i] > std::log(2.0)) ++nAboveMedian;
+  }
+  double const mean = sum / NPoints;
+  double const variance = sumSq / NPoints - mean * mean;
+  BOOST_TEST(mean == 1.0, 0.1 % boost::test_tools::tolerance());
+  BOOST_TEST(variance == 1.0, 0.1 % boost::test_tools::tolerance());
+  BOOST_TEST(tMax <= std::log(2.0 * expo.nPoints()) + 1e-9);
+  BOOST_TEST(nAboveMedian == NPoints / 2,
+    0.1 % boost::test_tools::tolerance());
+
+  BOOST_TEST(scale(expo(0.5)) == 25.0 * expo(0.5));
+  BOOST_TEST(scale.mean() == 25.0);
+
+} // ExponentialTest()
+
+
+//------------------------------------------------------------------------------
+void PoissonTest(double mean) {
+
+  BOOST_TEST_MESSAGE("Testing Poisson with mean " << mean);
+
+  constexpr unsigned int NPoints = 1U << 20;
+
+  util::FastPoisson<> const poisson { mean };
+  BOOST_TEST(poisson.mean() == mean);
+  BOOST_TEST(poisson.minCount() <= static_cast<unsigned int>(mean));
+  BOOST_TEST(poisson.maxCount() >= static_cast<unsigned int>(mean));
+
+  std::vector<double> u(NPoints);
+  std::generate(u.begin(), u.end(), util::UniformSequence<>{ NPoints });
+  std::vector<util::FastPoisson<>::Count_t> n(NPoints);
+  poisson.transform(u, n);
+
+  std::vector<unsigned int> counts(poisson.maxCount() + 1, 0U);
+  double sum = 0.0, sumSq = 0.0;
+  for (unsigned int i = 0; i < NPoints; ++i) {
+    BOOST_TEST_REQUIRE(n[i] == poisson(u[i])); // batch and single are the same
+    BOOST_TEST_REQUIRE(n[i] >= poisson.minCount());
+    BOOST_TEST_REQUIRE(n[i] <= poisson.maxCount());
+    ++counts[n[i]];
+    sum += n[i];
+    sumSq += double(n[i]) * n[i];
+  }
+  double const average = sum / NPoints;
+  double const variance = sumSq / NPoints - average * average;
+  BOOST_TEST(average == mean, 0.01 % boost::test_tools::tolerance());
+  BOOST_TEST(variance == mean, 0.01 % boost::test_tools::tolerance());
+
+  // the uniform sequence reproduces the probabilities to the table resolution
+  for (unsigned int k = poisson.minCount(); k <= poisson.maxCount(); ++k) {
+    double const expected
+      = std::exp(k * std::log(mean) - mean - std::lgamma(k + 1.0));
+    BOOST_TEST_CONTEXT("k=" << k) {
+      BOOST_TEST(std::abs(double(counts[k]) / NPoints - expected)
+        < 4.0 / NPoints * poisson.nPoints());
+    }
+  } // for
+
+} // PoissonTest()
+
+
+void PoissonLimitsTest() {
+
+  util::FastPoisson<> const zero { 0.0 };
+  BOOST_TEST(zero(0.0) == 0U);
+  BOOST_TEST(zero(0.999) == 0U);
+
+  BOOST_CHECK_THROW(util::FastPoisson<>{ -1.0 }, std::invalid_argument);
+  BOOST_CHECK_THROW(util::FastPoisson<>(20.0, 10.0), std::invalid_argument);
+
+  util::FastPoisson<float> const small { 3.5 };
+  BOOST_TEST(small(0.0f) == small.minCount());
+  BOOST_TEST(small(0.99999f) <= small.maxCount());
+
+} // PoissonLimitsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FastExponentialTestCase) {
+
+  ExponentialTest();
+
+} // BOOST_AUTO_TEST_CASE(FastExponentialTestCase)
+
+
+BOOST_AUTO_TEST_CASE(FastPoissonTestCase) {
+
+  PoissonTest(0.2);
+  PoissonTest(4.5);
+  PoissonTest(60.0);
+  PoissonTest(800.0);
+  PoissonLimitsTest();
+
+} // BOOST_AUTO_TEST_CASE(FastPoissonTestCase)
+
+
+//------------------------------------------------------------------------------
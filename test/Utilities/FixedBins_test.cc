@@ -14,6 +14,9 @@
 // ICARUS libraries
 #include "icarusalg/Utilities/FixedBins.h"
 
+// C/C++ standard libraries
+#include <vector>
+
 
 // -----------------------------------------------------------------------------
 void BasicTest() {
@@ -245,12 +248,84 @@ void BasicTest() {
 } // BasicTest()
 
 
+//------------------------------------------------------------------------------
+void InsertTest() {
+  
+  std::vector<double> const values { 3.5, -4.0, 0.5, 3.0, 7.9, -4.0 };
+  
+  icarus::ns::util::FixedBins expected { 2.0, -1.0 };
+  for (double const value: values) expected.add(value);
+  
+  icarus::ns::util::FixedBins bins { 2.0, -1.0 };
+  bins.insert(values);
+  BOOST_TEST((bins.min() == expected.min()));
+  BOOST_TEST((bins.max() == expected.max()));
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (bins.begin(), bins.end(), expected.begin(), expected.end());
+  
+  // insertion extending the existing range on both sides
+  std::vector<double> const more { 10.0, -8.0 };
+  bins.insert(more.begin(), more.end());
+  for (double const value: more) expected.add(value);
+  BOOST_TEST((bins.min() == -9.0));
+  BOOST_TEST((bins.max() == +11.0));
+  BOOST_TEST((bins.countFor(-4.0) == 2U));
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (bins.begin(), bins.end(), expected.begin(), expected.end());
+  
+  // empty insertion
+  bins.insert(std::vector<double>{});
+  BOOST_TEST((bins.nBins() == expected.nBins()));
+  
+} // InsertTest()
+
+
+//------------------------------------------------------------------------------
+void MergeTest() {
+  
+  icarus::ns::util::FixedBins a { 2.0, -1.0 };
+  a.insert(std::vector<double>{ 3.5, 4.0, 6.0 });
+  
+  // same binning with a different offset and different fill range
+  icarus::ns::util::FixedBins b { 2.0, 5.0 };
+  BOOST_TEST(a.hasCompatibleBinning(b));
+  BOOST_TEST(!a.hasCompatibleBinning(icarus::ns::util::FixedBins{ 2.0, 0.0 }));
+  BOOST_TEST(!a.hasCompatibleBinning(icarus::ns::util::FixedBins{ 1.0, -1.0 }));
+  b.insert(std::vector<double>{ -4.0, 4.5, 12.0 });
+  
+  icarus::ns::util::FixedBins merged = a.emptyCopy();
+  BOOST_TEST(merged.empty());
+  BOOST_TEST((merged.binWidth() == a.binWidth()));
+  BOOST_TEST((merged.offset() == a.offset()));
+  
+  merged.merge(a);
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (merged.begin(), merged.end(), a.begin(), a.end());
+  
+  merged.merge(b);
+  std::vector<unsigned int> const expectedContent
+    = { 1U, 0U, 0U, 0U, 3U, 1U, 0U, 0U, 1U };
+  BOOST_TEST((merged.min() == -5.0));
+  BOOST_TEST((merged.max() == 13.0));
+  BOOST_CHECK_EQUAL_COLLECTIONS(merged.begin(), merged.end(),
+    expectedContent.begin(), expectedContent.end());
+  
+  // merging an empty object changes nothing
+  merged.merge(a.emptyCopy());
+  BOOST_CHECK_EQUAL_COLLECTIONS(merged.begin(), merged.end(),
+    expectedContent.begin(), expectedContent.end());
+  
+} // MergeTest()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
 BOOST_AUTO_TEST_CASE( TestCase ) {
   
   BasicTest();
+  InsertTest();
+  MergeTest();
   
 } // BOOST_AUTO_TEST_CASE( TestCase )
 
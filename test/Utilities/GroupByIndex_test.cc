@@ -0,0 +1,217 @@
+/**
+ * @file   GroupByIndex_test.cc
+ * @brief  Unit test for `icarus::ns::util::GroupByIndex`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/GroupByIndex.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE GroupByIndex
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/GroupByIndex.h"
+#include "test/AllocationCounter.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+  
+  struct Data_t {
+    std::size_t channel;
+    int value;
+  };
+  
+  /// Returns the expected groups of `data`, one vector per channel.
+  std::vector<std::vector<Data_t const*>> referenceGroups
+    (std::vector<Data_t> const& data)
+  {
+    std::vector<std::vector<Data_t const*>> groups;
+    for (Data_t const& d: data) {
+      if (d.channel >= groups.size()) groups.resize(d.channel + 1);
+      groups[d.channel].push_back(&d);
+    }
+    return groups;
+  } // referenceGroups()
+  
+  
+  /// Checks that `byChannel` has the same content as `expected`.
+  template <typename T>
+  void checkGroups(
+    icarus::ns::util::GroupByIndex<T> const& byChannel,
+    std::vector<std::vector<T const*>> const& expected
+  ) {
+    BOOST_TEST(byChannel.size() == expected.size());
+    BOOST_TEST(byChannel.empty() == expected.empty());
+    
+    std::size_t nObjects = 0U;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      BOOST_TEST_CONTEXT("group #" << i) {
+        auto const group = byChannel[i];
+        BOOST_TEST(group.size() == expected[i].size());
+        std::vector<T const*> const content{ group.begin(), group.end() };
+        BOOST_TEST(content == expected[i]);
+        nObjects += group.size();
+      }
+    } // for
+    BOOST_TEST(byChannel.nObjects() == nObjects);
+    
+    // past the last group, groups are empty
+    BOOST_TEST(byChannel[expected.size()].empty());
+    BOOST_TEST(byChannel[expected.size() + 100U].empty());
+    
+    // iteration covers all groups in order
+    std::size_t iGroup = 0U;
+    for (auto const& group: byChannel) {
+      BOOST_TEST_CONTEXT("iterated group #" << iGroup) {
+        BOOST_TEST_REQUIRE(iGroup < expected.size());
+        BOOST_TEST(group.data() == byChannel[iGroup].data());
+        BOOST_TEST(group.size() == expected[iGroup].size());
+      }
+      ++iGroup;
+    } // for
+    BOOST_TEST(iGroup == expected.size());
+    
+  } // checkGroups()
+  
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void basicTest() {
+  
+  std::vector<Data_t> const data {
+    { 2U, 0 }, { 0U, 1 }, { 2U, 2 }, { 4U, 3 }, { 0U, 4 }, { 2U, 5 }
+  };
+  
+  icarus::ns::util::GroupByIndex const byChannel
+    { data, [](Data_t const& d){ return d.channel; } };
+  
+  BOOST_TEST(byChannel.size() == 5U);
+  BOOST_TEST(byChannel.nObjects() == data.size());
+  
+  BOOST_TEST(byChannel[0].size() == 2U);
+  BOOST_TEST(byChannel[0][0] == &data[1]);
+  BOOST_TEST(byChannel[0][1] == &data[4]);
+  BOOST_TEST(byChannel[1].empty());
+  BOOST_TEST(byChannel[2].size() == 3U);
+  BOOST_TEST(byChannel[2][0] == &data[0]);
+  BOOST_TEST(byChannel[2][1] == &data[2]);
+  BOOST_TEST(byChannel[2][2] == &data[5]);
+  BOOST_TEST(byChannel[3].empty());
+  BOOST_TEST(byChannel[4].size() == 1U);
+  BOOST_TEST(byChannel[4][0] == &data[3]);
+  BOOST_TEST(byChannel[5].empty());
+  
+  checkGroups(byChannel, referenceGroups(data));
+  
+} // basicTest()
+
+
+//------------------------------------------------------------------------------
+void emptyTest() {
+  
+  std::vector<Data_t> const data;
+  
+  icarus::ns::util::GroupByIndex const byChannel
+    { data, [](Data_t const& d){ return d.channel; } };
+  
+  BOOST_TEST(byChannel.empty());
+  BOOST_TEST(byChannel.size() == 0U);
+  BOOST_TEST(byChannel.nObjects() == 0U);
+  BOOST_TEST(byChannel[0].empty());
+  BOOST_TEST((byChannel.begin() == byChannel.end()));
+  
+} // emptyTest()
+
+
+//------------------------------------------------------------------------------
+void parallelTest() {
+  
+  constexpr std::size_t NChannels = 360U;
+  constexpr std::size_t NData = 200000U;
+  
+  std::mt19937 engine { 12345 };
+  std::uniform_int_distribution<std::size_t> pickChannel { 0U, NChannels - 1 };
+  
+  std::vector<Data_t> data;
+  data.reserve(NData);
+  for (std::size_t i = 0; i < NData; ++i)
+    data.push_back({ pickChannel(engine), static_cast<int>(i) });
+  
+  auto const expected = referenceGroups(data);
+  
+  for (unsigned int const nThreads: { 1U, 2U, 3U, 8U, 0U }) {
+    BOOST_TEST_CONTEXT("threads: " << nThreads) {
+      icarus::ns::util::GroupByIndex const byChannel
+        { data, [](Data_t const& d){ return d.channel; }, nThreads };
+      checkGroups(byChannel, expected);
+    }
+  } // for threads
+  
+  // exceptions from the key extraction reach the caller
+  auto const failingKey = [](Data_t const& d)
+    {
+      if (d.value == static_cast<int>(NData - 10U))
+        throw std::runtime_error("bad channel");
+      return d.channel;
+    };
+  BOOST_CHECK_THROW(
+    (icarus::ns::util::GroupByIndex{ data, failingKey, 4U }),
+    std::runtime_error
+    );
+  
+} // parallelTest()
+
+
+//------------------------------------------------------------------------------
+void allocationTest() {
+  
+  std::vector<Data_t> const data {
+    { 2U, 0 }, { 0U, 1 }, { 2U, 2 }, { 4U, 3 }, { 0U, 4 }, { 2U, 5 }
+  };
+  
+  icarus::ns::util::GroupByIndex const byChannel
+    { data, [](Data_t const& d){ return d.channel; } };
+  
+  // access to the groups does not allocate memory
+  icarus::test::AllocationCounter allocations;
+  std::size_t n = 0U;
+  for (std::size_t i = 0; i < byChannel.size() + 2U; ++i)
+    n += byChannel[i].size();
+  for (auto const& group: byChannel) n += group.size();
+  std::size_t const nAllocations = allocations.allocations();
+  
+  BOOST_TEST(n == 2U * data.size());
+  BOOST_TEST(nAllocations == 0U);
+  
+} // allocationTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( GroupByIndexTestCase ) {
+  
+  basicTest();
+  emptyTest();
+  allocationTest();
+  
+} // BOOST_AUTO_TEST_CASE( GroupByIndexTestCase )
+
+
+BOOST_AUTO_TEST_CASE( GroupByIndexParallelTestCase ) {
+  
+  parallelTest();
+  
+} // BOOST_AUTO_TEST_CASE( GroupByIndexParallelTestCase )
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+/**
+ * @file   HitColumns_test.cc
+ * @brief  Unit test for `icarus::ns::util::HitColumns`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/HitColumns.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE HitColumns
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/HitColumns.h"
+
+// LArSoft libraries
+#include "lardataobj/RecoBase/Hit.h"
+
+// C/C++ standard libraries
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Returns a hit on `wid` with values derived from `i`.
+  recob::Hit makeHit(unsigned int i, geo::WireID const& wid) {
+    return recob::Hit{
+      raw::ChannelID_t(100 + i),          // channel
+      raw::TDCtick_t(10 * i),             // start_tick
+      raw::TDCtick_t(10 * i + 8),         // end_tick
+      10.0f * i + 4.0f,                   // peak_time
+      0.5f,                               // sigma_peak_time
+      1.5f + i,                           // rms
+      20.0f + i,                          // peak_amplitude
+      1.0f,                               // sigma_peak_amplitude
+      30.0f + i,                          // summedADC
+      40.0f + i,                          // hit_integral
+      2.0f,                               // hit_sigma_integral
+      short(1 + i % 2),                   // multiplicity
+      short(i % 2),                       // local_index
+      0.25f * i,                          // goodness_of_fit
+      int(i),                             // dof
+      (wid.Plane == 2)? geo::kW: geo::kU, // view
+      geo::kCollection,                   // signal_type
+      wid                                 // wireID
+      };
+  } // makeHit()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void HitColumnsTest() {
+
+  using icarus::ns::util::HitColumns;
+
+  // 2 cryostats with 4 TPC each, two TPC per TPC set; TPC 3 of cryostat 1
+  // is not in any TPC set
+  HitColumns::Layout_t layout;
+  layout.nCryostats = 2U;
+  layout.maxTPCs = 4U;
+  layout.maxPlanes = 3U;
+  layout.maxTPCsets = 2U;
+  layout.TPCsetOfTPC = { 0U, 0U, 1U, 1U, 0U, 0U, 1U, HitColumns::NoIndex };
+
+  BOOST_TEST(layout.nPlanes() == 24U);
+  BOOST_TEST(layout.nTPCsets() == 4U);
+  BOOST_TEST(layout.hasPlane(geo::PlaneID{ 1U, 3U, 2U }));
+  BOOST_TEST(!layout.hasPlane(geo::PlaneID{ 2U, 0U, 0U }));
+  BOOST_TEST(!layout.hasPlane(geo::PlaneID{}));
+
+  std::vector<geo::WireID> const wires {
+    geo::WireID{ 0U, 0U, 0U, 10U },
+    geo::WireID{ 0U, 3U, 2U, 20U },
+    geo::WireID{ 1U, 1U, 1U, 30U },
+    geo::WireID{ 1U, 3U, 2U, 40U }, // no TPC set
+    geo::WireID{ 2U, 0U, 0U, 50U }, // out of the layout
+    geo::WireID{}                   // invalid
+  };
+  std::vector<recob::Hit> hits;
+  for (unsigned int i = 0; i < wires.size(); ++i)
+    hits.push_back(makeHit(i, wires[i]));
+
+  HitColumns columns { layout };
+  BOOST_TEST(columns.empty());
+
+  columns.fill(hits);
+  BOOST_TEST(!columns.empty());
+  BOOST_TEST(columns.size() == hits.size());
+
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    recob::Hit const& hit = hits[i];
+    BOOST_TEST_CONTEXT("hit #" << i) {
+      BOOST_TEST(columns.channel()[i] == hit.Channel());
+      BOOST_TEST(columns.view()[i] == hit.View());
+      BOOST_TEST(columns.startTick()[i] == hit.StartTick());
+      BOOST_TEST(columns.endTick()[i] == hit.EndTick());
+      BOOST_TEST(columns.peakTime()[i] == hit.PeakTime());
+      BOOST_TEST(columns.RMS()[i] == hit.RMS());
+      BOOST_TEST(columns.peakAmplitude()[i] == hit.PeakAmplitude());
+      BOOST_TEST(columns.summedADC()[i] == hit.SummedADC());
+      BOOST_TEST(columns.integral()[i] == hit.Integral());
+      BOOST_TEST(columns.goodnessOfFit()[i] == hit.GoodnessOfFit());
+      BOOST_TEST(columns.degreesOfFreedom()[i] == hit.DegreesOfFreedom());
+      BOOST_TEST(columns.multiplicity()[i] == hit.Multiplicity());
+      BOOST_TEST(columns.localIndex()[i] == hit.LocalIndex());
+      if (hit.WireID().isValid) {
+        BOOST_TEST(columns.wireID(i) == hit.WireID());
+        BOOST_TEST(columns.wire()[i] == hit.WireID().Wire);
+      }
+    }
+  } // for
+
+  // precomputed indices
+  BOOST_TEST(columns.planeIndex()[0] == 0U);
+  BOOST_TEST(columns.TPCset()[0] == 0U);
+  BOOST_TEST(columns.TPCsetIndex()[0] == 0U);
+  BOOST_TEST(columns.TPCsetID(0) == (readout::TPCsetID{ 0U, 0U }));
+
+  BOOST_TEST(columns.planeIndex()[1] == 11U);
+  BOOST_TEST(columns.TPCset()[1] == 1U);
+  BOOST_TEST(columns.TPCsetIndex()[1] == 1U);
+  BOOST_TEST(columns.planeID(1) == (geo::PlaneID{ 0U, 3U, 2U }));
+
+  BOOST_TEST(columns.planeIndex()[2] == 16U);
+  BOOST_TEST(columns.planeIndex()[2] == layout.planeIndex(wires[2]));
+  BOOST_TEST(columns.TPCset()[2] == 0U);
+  BOOST_TEST(columns.TPCsetIndex()[2] == 2U);
+  BOOST_TEST(columns.TPCsetID(2) == (readout::TPCsetID{ 1U, 0U }));
+
+  BOOST_TEST(columns.planeIndex()[3] == 23U);
+  BOOST_TEST(columns.TPCset()[3] == HitColumns::NoIndex);
+  BOOST_TEST(columns.TPCsetIndex()[3] == HitColumns::NoIndex);
+  BOOST_TEST(!columns.TPCsetID(3).isValid);
+
+  for (std::size_t i: { 4U, 5U }) {
+    BOOST_TEST_CONTEXT("hit #" << i) {
+      BOOST_TEST(columns.planeIndex()[i] == HitColumns::NoIndex);
+      BOOST_TEST(columns.TPCset()[i] == HitColumns::NoIndex);
+      BOOST_TEST(columns.TPCsetIndex()[i] == HitColumns::NoIndex);
+    }
+  } // for
+
+  // a smaller event reuses the columns
+  hits.erase(hits.begin() + 2, hits.end());
+  columns.fill(hits);
+  BOOST_TEST(columns.size() == 2U);
+  BOOST_TEST(columns.integral()[1] == hits[1].Integral());
+
+  columns.clear();
+  BOOST_TEST(columns.empty());
+
+  // no layout: no index
+  HitColumns noLayout;
+  noLayout.fill(hits);
+  BOOST_TEST(noLayout.size() == 2U);
+  BOOST_TEST(noLayout.planeIndex()[0] == HitColumns::NoIndex);
+  BOOST_TEST(noLayout.TPCsetIndex()[1] == HitColumns::NoIndex);
+  BOOST_TEST(noLayout.peakTime()[1] == hits[1].PeakTime());
+
+} // HitColumnsTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( TestCase ) {
+
+  HitColumnsTest();
+
+} // BOOST_AUTO_TEST_CASE( TestCase )
@@ -0,0 +1,152 @@
+/**
+ * @file Instrumentation_test.cc
+ * @brief Unit test for the timers and counters in `Instrumentation.h`.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ * @see icarusalg/Utilities/Instrumentation.h
+ */
+
+// the macros are tested enabled
+#define ICARUSALG_INSTRUMENTATION 1
+
+// Boost libraries
+#define BOOST_TEST_MODULE Instrumentation
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/Instrumentation.h"
+#include "test/AllocationCounter.h"
+
+// C/C++ standard libraries
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+void TimerStatsTest() {
+
+  icarus::ns::util::TimerStats stats;
+  BOOST_TEST(stats.calls() == 0U);
+  BOOST_TEST(stats.mean() == 0.0);
+  BOOST_TEST(stats.min() == 0.0);
+
+  stats.add(1e-3);
+  stats.add(3e-3);
+  BOOST_TEST(stats.calls() == 2U);
+  BOOST_TEST(stats.total() == 4e-3, boost::test_tools::tolerance(1e-9));
+  BOOST_TEST(stats.mean() == 2e-3, boost::test_tools::tolerance(1e-9));
+  BOOST_TEST(stats.min() == 1e-3);
+  BOOST_TEST(stats.max() == 3e-3);
+  BOOST_TEST(stats.latencies().entries() == 2U);
+
+  // log10(1e-3) = -3 is in bin 41 of [ -7 ; 2 ] with 90 bins
+  BOOST_TEST(stats.latencies().binContent(41U) == 1.0);
+
+  stats.reset();
+  BOOST_TEST(stats.calls() == 0U);
+  BOOST_TEST(stats.total() == 0.0);
+  BOOST_TEST(stats.latencies().entries() == 0U);
+
+} // TimerStatsTest()
+
+
+// -----------------------------------------------------------------------------
+void ScopedTimerTest() {
+
+  icarus::ns::util::TimerStats stats;
+  {
+    icarus::ns::util::ScopedTimer timer { stats };
+    BOOST_TEST(stats.calls() == 0U);
+  }
+  BOOST_TEST(stats.calls() == 1U);
+  BOOST_TEST(stats.total() >= 0.0);
+
+  {
+    icarus::ns::util::ScopedTimer timer { stats };
+    timer.stop();
+    BOOST_TEST(stats.calls() == 2U);
+  } // no further record on destruction
+  BOOST_TEST(stats.calls() == 2U);
+
+} // ScopedTimerTest()
+
+
+// -----------------------------------------------------------------------------
+void ConcurrentTest() {
+
+  constexpr unsigned int NThreads = 4U;
+  constexpr unsigned int NCalls = 1000U;
+
+  icarus::ns::util::Instrumentation registry;
+  auto work = [&registry]()
+    {
+      auto& stats = registry.timer("work");
+      auto& counter = registry.counter("items");
+      for (unsigned int i = 0; i < NCalls; ++i) {
+        icarus::ns::util::ScopedTimer timer { stats };
+        counter.fetch_add(2U);
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < NThreads; ++i) threads.emplace_back(work);
+  for (std::thread& thread: threads) thread.join();
+
+  BOOST_TEST(registry.timer("work").calls() == NThreads * NCalls);
+  BOOST_TEST(registry.counter("items") == 2U * NThreads * NCalls);
+
+  std::ostringstream out;
+  registry.dump(out);
+  BOOST_TEST_MESSAGE(out.str());
+  BOOST_TEST(out.str().find("1 timers, 1 counters") == 0U);
+  BOOST_TEST(out.str().find("timer 'work': 4000 calls") != std::string::npos);
+  BOOST_TEST(out.str().find("counter 'items': 8000") != std::string::npos);
+
+  registry.reset();
+  BOOST_TEST(registry.timer("work").calls() == 0U);
+  BOOST_TEST(registry.counter("items") == 0U);
+
+} // ConcurrentTest()
+
+
+// -----------------------------------------------------------------------------
+void MacroTest() {
+
+  auto& registry = icarus::ns::util::Instrumentation::global();
+
+  auto timed = [](std::size_t i)
+    {
+      ICARUS_SCOPED_TIMER("MacroTest");
+      ICARUS_COUNT("MacroTest items", i);
+    };
+
+  for (std::size_t i = 0; i < 3U; ++i) timed(i);
+
+  BOOST_TEST(registry.timer("MacroTest").calls() == 3U);
+  BOOST_TEST(registry.counter("MacroTest items") == 3U);
+
+  // after the first time, timing does not allocate memory
+  icarus::test::AllocationCounter allocations;
+  for (std::size_t i = 0; i < 3U; ++i) timed(i);
+  std::size_t const nAllocations = allocations.allocations();
+
+  BOOST_TEST(nAllocations == 0U);
+  BOOST_TEST(registry.timer("MacroTest").calls() == 6U);
+
+} // MacroTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(InstrumentationTestCase) {
+
+  TimerStatsTest();
+  ScopedTimerTest();
+  ConcurrentTest();
+  MacroTest();
+
+} // BOOST_AUTO_TEST_CASE(InstrumentationTestCase)
+
+
+// -----------------------------------------------------------------------------
@@ -19,8 +19,13 @@
 
 // C/C++ standard libraries
 #include <iostream>
+#include <sstream>
 #include <utility> // std::pair<>
 #include <array>
+#include <vector>
+#include <set>
+#include <limits>
+#include <cstdint> // std::uint8_t, std::uint64_t
 #include <type_traits> // std::is_same_v, std::remove_reference_t
 
 
@@ -230,6 +235,160 @@ void TestUnsorted() {
 } // TestDuplicates()
 
 
+// -----------------------------------------------------------------------------
+void TestBuilder() {
+  
+  std::array const test { 1, 1, 3, 6, 6, 6, 7, 8, 11, 11 };
+  
+  icarus::IntegerRangesBuilder<int, true> builder;
+  BOOST_TEST(builder.empty());
+  for (int const value: test) builder.add(value);
+  BOOST_TEST(!builder.empty());
+  BOOST_TEST(builder.nRanges() == 4U);
+  
+  auto const ranges = builder.release();
+  BOOST_TEST(builder.empty());
+  
+  auto const expected = icarus::makeIntegerRanges(test);
+  BOOST_TEST(ranges.nRanges() == expected.nRanges());
+  auto const& rangeContent = ranges.ranges();
+  auto const& expectedContent = expected.ranges();
+  for (auto const& [ i, r, e ]: util::enumerate(rangeContent, expectedContent))
+  {
+    BOOST_TEST_MESSAGE("[" << i << "]");
+    BOOST_CHECK_EQUAL(r.lower, e.lower);
+    BOOST_CHECK_EQUAL(r.upper, e.upper);
+  } // for
+  
+  // the builder can be reused
+  builder.add(test.begin(), test.begin() + 3);
+  BOOST_TEST(builder.release().size() == 2U);
+  
+  builder.add(5);
+  BOOST_CHECK_THROW(builder.add(4), std::runtime_error);
+  
+} // TestBuilder()
+
+
+// -----------------------------------------------------------------------------
+void TestContains() {
+  
+  std::array const test { -3, -2, 1, 2, 3, 4, 6, 7, 8, 10, 11, 20 };
+  std::set<int> const values { test.begin(), test.end() };
+  
+  auto const ranges = icarus::makeIntegerRanges(test);
+  for (int v = -6; v < 25; ++v) {
+    BOOST_TEST_CONTEXT("value: " << v) {
+      BOOST_TEST(ranges.contains(v) == (values.count(v) > 0));
+    }
+  } // for
+  
+  BOOST_TEST(!icarus::IntegerRanges<int>{}.contains(0));
+  
+} // TestContains()
+
+
+// -----------------------------------------------------------------------------
+void TestSetOperations() {
+  
+  std::array const testA { 1, 2, 3, 4, 6, 7, 8, 10, 11, 15, 20, 21 };
+  std::array const testB { 0, 4, 5, 8, 9, 12, 13, 14, 16, 21, 22 };
+  
+  std::set<int> const setA { testA.begin(), testA.end() };
+  std::set<int> const setB { testB.begin(), testB.end() };
+  std::set<int> setAorB { setA }, setAandB;
+  setAorB.insert(setB.begin(), setB.end());
+  for (int const v: setA) if (setB.count(v)) setAandB.insert(v);
+  
+  auto const rangesA = icarus::makeIntegerRanges(testA);
+  auto const rangesB = icarus::makeIntegerRanges(testB);
+  
+  auto const AorB = rangesA | rangesB;
+  auto const AandB = rangesA & rangesB;
+  std::cout << "Union: " << AorB << "\nIntersection: " << AandB << std::endl;
+  
+  BOOST_TEST(AorB.size() == setAorB.size());
+  BOOST_TEST(AandB.size() == setAandB.size());
+  for (int v = -2; v < 25; ++v) {
+    BOOST_TEST_CONTEXT("value: " << v) {
+      BOOST_TEST(AorB.contains(v) == (setAorB.count(v) > 0));
+      BOOST_TEST(AandB.contains(v) == (setAandB.count(v) > 0));
+    }
+  } // for
+  
+  // contiguous ranges are merged
+  BOOST_TEST(AorB.nRanges() == 2U); // 0--16 and 20--22
+  
+  auto const& unionRanges = AorB.ranges();
+  for (std::size_t i = 1; i < unionRanges.size(); ++i)
+    BOOST_TEST(unionRanges[i - 1].upper < unionRanges[i].lower);
+  
+  BOOST_TEST((rangesA & icarus::IntegerRanges<int, true>{}).empty());
+  BOOST_TEST((rangesA | icarus::IntegerRanges<int, true>{}).size() == setA.size());
+  
+} // TestSetOperations()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void TestSerializationOf(std::vector<T> const& test) {
+  
+  auto const ranges = icarus::makeIntegerRanges(test);
+  std::vector<std::uint8_t> const data = ranges.serialize();
+  auto const restored
+    = icarus::IntegerRanges<T, true>::deserialize(data.data(), data.size());
+  
+  BOOST_TEST_MESSAGE("Ranges " << ranges << ": " << data.size() << " bytes");
+  BOOST_TEST(restored.nRanges() == ranges.nRanges());
+  auto const& restoredContent = restored.ranges();
+  auto const& rangeContent = ranges.ranges();
+  for (auto const& [ i, r, e ]: util::enumerate(restoredContent, rangeContent))
+  {
+    BOOST_TEST_MESSAGE("[" << i << "]");
+    BOOST_CHECK_EQUAL(r.lower, e.lower);
+    BOOST_CHECK_EQUAL(r.upper, e.upper);
+  } // for
+  
+} // TestSerializationOf()
+
+
+void TestSerialization() {
+  
+  TestSerializationOf(std::vector<int>{});
+  TestSerializationOf(std::vector<int>{ -1000, -999, -5, 1, 2, 3, 100000 });
+  TestSerializationOf(std::vector<unsigned int>
+    { 0U, 1U, 2U, 3U, 4U, 64U, 65U, 1000U, std::numeric_limits<unsigned int>::max() - 1U }
+    );
+  TestSerializationOf(std::vector<std::int64_t>
+    { std::numeric_limits<std::int64_t>::min(), 0, 1, 2 });
+  
+  // compactness: 360 PMT channels, a few disabled
+  std::vector<unsigned int> channels;
+  for (unsigned int ch = 0; ch < 360; ++ch)
+    if ((ch != 17) && (ch != 123) && ((ch < 200) || (ch >= 216)))
+      channels.push_back(ch);
+  auto const mask = icarus::makeIntegerRanges(channels);
+  BOOST_TEST(mask.serialize().size() <= 1U + 3U * mask.nRanges());
+  
+  // malformed data
+  std::vector<std::uint8_t> data = mask.serialize();
+  data.pop_back();
+  BOOST_CHECK_THROW
+    ((icarus::IntegerRanges<unsigned int>::deserialize(data)), std::runtime_error);
+  data = mask.serialize();
+  data.push_back(0U);
+  BOOST_CHECK_THROW
+    ((icarus::IntegerRanges<unsigned int>::deserialize(data)), std::runtime_error);
+  
+  // values not fitting the type
+  std::vector<std::uint8_t> const bigData
+    = icarus::makeIntegerRanges(std::vector<std::uint64_t>{ 1ULL << 40 }).serialize();
+  BOOST_CHECK_THROW
+    ((icarus::IntegerRanges<int>::deserialize(bigData)), std::runtime_error);
+  
+} // TestSerialization()
+
+
 //------------------------------------------------------------------------------
 void TestIntegerRangesDocumentation() {
   
@@ -275,6 +434,28 @@ BOOST_AUTO_TEST_CASE( BasicTestCase ) {
 } // BOOST_AUTO_TEST_CASE( BasicTestCase )
 
 
+BOOST_AUTO_TEST_CASE( BuilderTestCase ) {
+  
+  TestBuilder();
+  
+} // BOOST_AUTO_TEST_CASE( BuilderTestCase )
+
+
+BOOST_AUTO_TEST_CASE( QueryTestCase ) {
+  
+  TestContains();
+  TestSetOperations();
+  
+} // BOOST_AUTO_TEST_CASE( QueryTestCase )
+
+
+BOOST_AUTO_TEST_CASE( SerializationTestCase ) {
+  
+  TestSerialization();
+  
+} // BOOST_AUTO_TEST_CASE( SerializationTestCase )
+
+
 BOOST_AUTO_TEST_CASE( DocumentationTestCase ) {
   
   TestIntegerRangesDocumentation();
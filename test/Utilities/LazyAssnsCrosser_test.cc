@@ -0,0 +1,273 @@
+/**
+ * @file LazyAssnsCrosser_test.cc
+ * @brief Unit test for `icarus::ns::util::LazyAssnsCrosser` class.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ * @see icarusalg/Utilities/LazyAssnsCrosser.h
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE LazyAssnsCrosser
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_TEST()
+
+// library to test
+#include "icarusalg/Utilities/LazyAssnsCrosser.h"
+
+// ICARUS and LArSoft libraries
+#include "icarusalg/Utilities/AssnsCrosser.h"
+#include "test/FrameworkEventMockup.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort()
+#include <random>
+#include <vector>
+#include <stdexcept> // std::logic_error
+#include <utility> // std::move()
+#include <cstddef>
+
+
+//------------------------------------------------------------------------------
+// test data
+template <std::size_t Tag>
+struct DataType {
+
+  static constexpr std::size_t tag = Tag;
+
+  std::size_t ID = 0;
+
+}; // DataType<>
+
+
+struct DataTypeA: DataType<1> {};
+struct DataTypeB: DataType<2> {};
+struct DataTypeC: DataType<3> {};
+struct DataTypeD: DataType<4> {};
+
+
+/// Returns a sorted copy of the pointers in `ptrs`.
+template <typename Ptrs>
+auto sortedPtrs(Ptrs const& ptrs) {
+  std::vector<typename Ptrs::value_type> sorted{ ptrs.begin(), ptrs.end() };
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+} // sortedPtrs()
+
+
+//------------------------------------------------------------------------------
+/// Adds to `event` `n` objects of type `T` with tag `tag`.
+template <typename T>
+void putData(testing::mockup::Event& event, std::size_t n, char const* tag) {
+  std::vector<T> data(n);
+  for (std::size_t i = 0; i < n; ++i) data[i].ID = i;
+  event.put(std::move(data), art::InputTag{ tag });
+} // putData()
+
+
+/// Adds to `event` random associations from `leftTag` to `rightTag` objects.
+template <typename Left, typename Right>
+void putRandomAssns(
+  testing::mockup::Event& event, std::mt19937& engine,
+  char const* leftTag, char const* rightTag, char const* assnsTag,
+  std::size_t nAssns
+) {
+  testing::mockup::PtrMaker<Left> const makeLeftPtr
+    { event, art::InputTag{ leftTag } };
+  testing::mockup::PtrMaker<Right> const makeRightPtr
+    { event, art::InputTag{ rightTag } };
+  std::size_t const nLeft
+    = event.getProduct<std::vector<Left>>(art::InputTag{ leftTag }).size();
+  std::size_t const nRight
+    = event.getProduct<std::vector<Right>>(art::InputTag{ rightTag }).size();
+
+  std::uniform_int_distribution<std::size_t> leftDist { 0, nLeft - 1 };
+  std::uniform_int_distribution<std::size_t> rightDist { 0, nRight - 1 };
+
+  art::Assns<Left, Right> assns;
+  for (std::size_t i = 0; i < nAssns; ++i) {
+    assns.addSingle
+      (makeLeftPtr(leftDist(engine)), makeRightPtr(rightDist(engine)));
+  } // for
+  event.put(std::move(assns), art::InputTag{ assnsTag });
+
+} // putRandomAssns()
+
+
+//------------------------------------------------------------------------------
+void LazyAssnsCrosserComparison_test() {
+  /*
+   * Random associations, with two data products for the first hop;
+   * the result must be the same as `AssnsCrosser` one (up to the order).
+   */
+
+  testing::mockup::Event event;
+  std::mt19937 engine { 12345 };
+
+  putData<DataTypeA>(event, 200, "A");
+  putData<DataTypeB>(event, 300, "B");
+  putData<DataTypeC>(event, 400, "C");
+  putData<DataTypeD>(event, 100, "D");
+  putRandomAssns<DataTypeA, DataTypeB>(event, engine, "A", "B", "B:1", 150);
+  putRandomAssns<DataTypeA, DataTypeB>(event, engine, "A", "B", "B:2", 150);
+  putRandomAssns<DataTypeB, DataTypeC>(event, engine, "B", "C", "C", 500);
+  putRandomAssns<DataTypeC, DataTypeD>(event, engine, "C", "D", "D", 300);
+
+  using icarus::ns::util::hopTo;
+
+  auto const AtoD = icarus::ns::util::makeAssnsCrosser<DataTypeA>(event,
+    hopTo<DataTypeB>{ "B:1", "B:2" }, hopTo<DataTypeC>{ "C" },
+    hopTo<DataTypeD>{ "D" }
+    );
+  auto const lazyAtoD = icarus::ns::util::makeLazyAssnsCrosser<DataTypeA>(
+    event,
+    hopTo<DataTypeB>{ "B:1", "B:2" }, hopTo<DataTypeC>{ "C" },
+    hopTo<DataTypeD>{ "D" }
+    );
+
+  // nothing is indexed until queried
+  BOOST_TEST(lazyAtoD.nIndexedHops() == 0U);
+  BOOST_TEST(lazyAtoD.nResolvedKeys() == 0U);
+
+  testing::mockup::PtrMaker<DataTypeA> const makeAptr
+    { event, art::InputTag{ "A" } };
+
+  for (std::size_t iA = 0; iA < 200; ++iA) {
+    BOOST_TEST_CONTEXT("A[" << iA << "]") {
+      auto const expected = sortedPtrs(AtoD.assPtrs(makeAptr(iA)));
+      auto const Ds = sortedPtrs(lazyAtoD.assPtrs(makeAptr(iA)));
+      BOOST_CHECK_EQUAL_COLLECTIONS
+        (Ds.begin(), Ds.end(), expected.begin(), expected.end());
+    }
+  } // for
+  BOOST_TEST(lazyAtoD.nIndexedHops() == 3U);
+  BOOST_TEST(lazyAtoD.nResolvedKeys() == 200U);
+
+  // memoized result
+  auto const first = lazyAtoD.assPtrs(makeAptr(5));
+  auto const second = lazyAtoD.assPtrs(makeAptr(5));
+  BOOST_TEST(first.data() == second.data());
+  BOOST_TEST(lazyAtoD.nResolvedKeys() == 200U);
+
+  // unknown key
+  testing::mockup::PtrMaker<DataTypeA> const makeBadAptr
+    { event.getProductID<std::vector<DataTypeB>>(art::InputTag{ "B" }),
+      event.getProduct<std::vector<DataTypeA>>(art::InputTag{ "A" }) };
+  BOOST_TEST(lazyAtoD.assPtrs(makeBadAptr(0)).empty());
+  BOOST_TEST(!lazyAtoD.assPtr(makeBadAptr(0)));
+
+  // input specified by product ID
+  icarus::ns::util::LazyAssnsCrosser<DataTypeA, DataTypeB, DataTypeC> const
+  lazyAtoC{ event,
+    hopTo<DataTypeB>{ "B:1", "B:2" },
+    hopTo<DataTypeC>{ event.getProductID<art::Assns<DataTypeB, DataTypeC>>
+      (art::InputTag{ "C" }) }
+    };
+  auto const AtoC = icarus::ns::util::makeAssnsCrosser<DataTypeA>
+    (event, hopTo<DataTypeB>{ "B:1", "B:2" }, hopTo<DataTypeC>{ "C" });
+  for (std::size_t iA: { 0U, 17U, 199U }) {
+    BOOST_TEST_CONTEXT("A[" << iA << "]") {
+      auto const expected = sortedPtrs(AtoC.assPtrs(makeAptr(iA)));
+      auto const Cs = sortedPtrs(lazyAtoC.assPtrs(makeAptr(iA)));
+      BOOST_CHECK_EQUAL_COLLECTIONS
+        (Cs.begin(), Cs.end(), expected.begin(), expected.end());
+    }
+  } // for
+  BOOST_TEST(lazyAtoC.nResolvedKeys() == 3U);
+
+} // LazyAssnsCrosserComparison_test()
+
+
+//------------------------------------------------------------------------------
+void LazyAssnsCrosserDiamond_test() {
+  /*
+   * Test with a diamond association.
+   *
+   * The plan:
+   *  A[0] <=> B[0], B[1]
+   *  A[1] <=> B[1]
+   *
+   *  B[0] <=> C[0],
+   *  B[1] <=> C[0]
+   *
+   *  A[0] <=> B[0..1] <=> C[0] (but via two paths)
+   *  A[1] <=> B[1]    <=> C[0]
+   */
+
+  testing::mockup::Event event;
+  putData<DataTypeA>(event, 2, "A");
+  putData<DataTypeB>(event, 2, "B");
+  putData<DataTypeC>(event, 1, "C");
+
+  testing::mockup::PtrMaker<DataTypeA> makeAptr{ event, art::InputTag{ "A" } };
+  testing::mockup::PtrMaker<DataTypeB> makeBptr{ event, art::InputTag{ "B" } };
+  testing::mockup::PtrMaker<DataTypeC> makeCptr{ event, art::InputTag{ "C" } };
+
+  art::Assns<DataTypeA, DataTypeB> assnsAB;
+  assnsAB.addSingle(makeAptr(0), makeBptr(0));
+  assnsAB.addSingle(makeAptr(1), makeBptr(1));
+  assnsAB.addSingle(makeAptr(0), makeBptr(1));
+  event.put(std::move(assnsAB), art::InputTag{ "B" });
+
+  art::Assns<DataTypeB, DataTypeC> assnsBC;
+  assnsBC.addSingle(makeBptr(0), makeCptr(0));
+  assnsBC.addSingle(makeBptr(1), makeCptr(0));
+  event.put(std::move(assnsBC), art::InputTag{ "C" });
+
+  using icarus::ns::util::hopTo;
+
+  auto const AtoC = icarus::ns::util::makeLazyAssnsCrosser<DataTypeA>
+    (event, hopTo<DataTypeB>("B"), hopTo<DataTypeC>("C"));
+
+  auto const Cs = AtoC.assPtrs(makeAptr(0));
+  BOOST_TEST(Cs.size() == 2);
+  if (Cs.size() > 0) BOOST_TEST(Cs[0] == makeCptr(0));
+  if (Cs.size() > 1) BOOST_TEST(Cs[1] == makeCptr(0));
+
+  BOOST_CHECK_THROW(AtoC.assPtr(makeAptr(0)), art::Exception);
+  BOOST_TEST(AtoC.assPtr(makeAptr(1)) == makeCptr(0));
+
+} // LazyAssnsCrosserDiamond_test()
+
+
+//------------------------------------------------------------------------------
+void LazyAssnsCrosserSpecs_test() {
+  /*
+   * All hops need to be specified.
+   */
+  testing::mockup::Event event;
+  putData<DataTypeA>(event, 2, "A");
+  putData<DataTypeB>(event, 2, "B");
+  putData<DataTypeC>(event, 1, "C");
+  event.put(art::Assns<DataTypeA, DataTypeB>{}, art::InputTag{ "B" });
+  event.put(art::Assns<DataTypeB, DataTypeC>{}, art::InputTag{ "C" });
+
+  using icarus::ns::util::hopTo;
+  using LazyAtoC_t
+    = icarus::ns::util::LazyAssnsCrosser<DataTypeA, DataTypeB, DataTypeC>;
+
+  BOOST_CHECK_THROW(
+    (LazyAtoC_t{ event, hopTo<DataTypeB>{ "B" }, hopTo<DataTypeC>{} }),
+    std::logic_error
+    );
+
+  LazyAtoC_t const AtoC{ event, "B", "C" };
+  testing::mockup::PtrMaker<DataTypeA> makeAptr{ event, art::InputTag{ "A" } };
+  BOOST_TEST(AtoC.assPtrs(makeAptr(1)).empty());
+
+} // LazyAssnsCrosserSpecs_test()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( LazyAssnsCrosser_testCase ) {
+
+  LazyAssnsCrosserComparison_test();
+  LazyAssnsCrosserDiamond_test();
+  LazyAssnsCrosserSpecs_test();
+
+} // BOOST_AUTO_TEST_CASE( LazyAssnsCrosser_testCase )
+
+
+//------------------------------------------------------------------------------
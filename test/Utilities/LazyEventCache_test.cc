@@ -0,0 +1,130 @@
+/**
+ * @file   LazyEventCache_test.cc
+ * @brief  Unit test for `icarus::ns::util::LazyEventCache`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/LazyEventCache.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE LazyEventCacheTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/LazyEventCache.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <stdexcept> // std::runtime_error
+
+
+//------------------------------------------------------------------------------
+void lazyComputationTest() {
+
+  icarus::ns::util::LazyEventCache<int, double, unsigned int> cache;
+
+  unsigned int nCalls = 0U;
+  auto compute = [&nCalls](int key){ ++nCalls; return key * 2.0; };
+
+  BOOST_TEST(!cache.setEvent(1U)); // nothing to clear on the first event
+  BOOST_TEST(cache.size() == 0U);
+  BOOST_TEST(!cache.has(3));
+
+  BOOST_TEST(cache.get(3, compute) == 6.0);
+  BOOST_TEST(nCalls == 1U);
+  BOOST_TEST(cache.has(3));
+
+  // cached: no new computation
+  double const& value = cache.get(3, compute);
+  BOOST_TEST(value == 6.0);
+  BOOST_TEST(nCalls == 1U);
+
+  BOOST_TEST(cache.get(4, compute) == 8.0);
+  BOOST_TEST(nCalls == 2U);
+  BOOST_TEST(cache.size() == 2U);
+  BOOST_TEST(&cache.get(3, compute) == &value); // address is stable
+
+  // same event: nothing changes
+  BOOST_TEST(!cache.setEvent(1U));
+  BOOST_TEST(cache.get(3, compute) == 6.0);
+  BOOST_TEST(nCalls == 2U);
+
+  // new event: values are computed again
+  BOOST_TEST(cache.setEvent(2U));
+  BOOST_TEST(cache.size() == 0U);
+  BOOST_TEST(cache.get(3, compute) == 6.0);
+  BOOST_TEST(nCalls == 3U);
+
+} // lazyComputationTest()
+
+
+//------------------------------------------------------------------------------
+void failedComputationTest() {
+
+  icarus::ns::util::LazyEventCache<int, int, int> cache;
+  cache.setEvent(0);
+
+  BOOST_CHECK_THROW(
+    cache.get(1, [](int) -> int { throw std::runtime_error{ "failed" }; }),
+    std::runtime_error
+    );
+
+  // the failed computation is attempted again
+  BOOST_TEST(cache.get(1, [](int key){ return key + 10; }) == 11);
+
+} // failedComputationTest()
+
+
+//------------------------------------------------------------------------------
+void concurrentAccessTest() {
+
+  constexpr int NKeys = 50;
+  constexpr unsigned int NThreads = 8U;
+
+  icarus::ns::util::LazyEventCache<int, int, int> cache;
+  cache.setEvent(0);
+
+  std::vector<std::atomic<unsigned int>> nCalls(NKeys);
+  auto compute = [&nCalls](int key){ ++nCalls[key]; return key * key; };
+
+  std::atomic<unsigned int> nErrors { 0U };
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&cache,&compute,&nErrors,iThread]()
+      {
+        for (int i = 0; i < NKeys; ++i) {
+          int const key = (i + iThread) % NKeys;
+          if (cache.get(key, compute) != key * key) ++nErrors;
+        }
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  BOOST_TEST(nErrors == 0U);
+  BOOST_TEST(cache.size() == NKeys);
+  for (int key = 0; key < NKeys; ++key) BOOST_TEST(nCalls[key] == 1U);
+
+} // concurrentAccessTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( LazyEventCacheTestCase ) {
+
+  lazyComputationTest();
+  failedComputationTest();
+
+} // BOOST_AUTO_TEST_CASE( LazyEventCacheTestCase )
+
+
+BOOST_AUTO_TEST_CASE( LazyEventCacheThreadTestCase ) {
+
+  concurrentAccessTest();
+
+} // BOOST_AUTO_TEST_CASE( LazyEventCacheThreadTestCase )
+
+
+//------------------------------------------------------------------------------
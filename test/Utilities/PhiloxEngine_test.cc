@@ -0,0 +1,207 @@
+/**
+ * @file   PhiloxEngine_test.cc
+ * @brief  Unit test for `util::PhiloxEngine`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/PhiloxEngine.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PhiloxEngineTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/PhiloxEngine.h"
+
+// C/C++ standard libraries
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <cstdint> // std::uint64_t
+
+
+//------------------------------------------------------------------------------
+void knownAnswerTest() {
+
+  // test vectors from the reference implementation (Random123)
+  using Engine_t = util::PhiloxEngine;
+
+  Engine_t::Block_t const block0 = Engine_t::generate({}, {});
+  BOOST_TEST(block0[0] == 0x6627e8d5U);
+  BOOST_TEST(block0[1] == 0xe169c58dU);
+  BOOST_TEST(block0[2] == 0xbc57ac4cU);
+  BOOST_TEST(block0[3] == 0x9b00dbd8U);
+
+  Engine_t::Block_t const block1 = Engine_t::generate(
+    { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU },
+    { 0xffffffffU, 0xffffffffU }
+    );
+  BOOST_TEST(block1[0] == 0x408f276dU);
+  BOOST_TEST(block1[1] == 0x41c83b0eU);
+  BOOST_TEST(block1[2] == 0xa20bc7c6U);
+  BOOST_TEST(block1[3] == 0x6d5451fdU);
+
+  Engine_t::Block_t const block2 = Engine_t::generate(
+    { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U },
+    { 0xa4093822U, 0x299f31d0U }
+    );
+  BOOST_TEST(block2[0] == 0xd16cfe09U);
+  BOOST_TEST(block2[1] == 0x94fdccebU);
+  BOOST_TEST(block2[2] == 0x5001e420U);
+  BOOST_TEST(block2[3] == 0x24126ea1U);
+
+  // the engine starts from the block 0 of its stream
+  Engine_t engine;
+  for (std::uint32_t const word: block0)
+    BOOST_TEST(static_cast<unsigned int>(engine) == word);
+
+} // knownAnswerTest()
+
+
+//------------------------------------------------------------------------------
+void sequenceTest() {
+
+  constexpr int N = 1001;
+  constexpr std::uint64_t Seed = 0x123456789ULL;
+
+  util::PhiloxEngine engine { Seed, 7U };
+  BOOST_TEST(engine.seed() == Seed);
+  BOOST_TEST(engine.stream() == 7U);
+
+  std::vector<double> expected(N);
+  for (double& value: expected) {
+    value = engine.flat();
+    BOOST_TEST(value > 0.0);
+    BOOST_TEST(value < 1.0);
+  }
+
+  // same seed and stream, same sequence
+  util::PhiloxEngine other { Seed, 7U };
+  std::vector<double> values(N);
+  other.flatArray(N, values.data());
+  for (int i = 0; i < N; ++i) BOOST_TEST(values[i] == expected[i]);
+
+  // skipping ahead
+  for (unsigned int const skip: { 0U, 1U, 2U, 3U, 10U, 501U }) {
+    for (unsigned int const start: { 0U, 1U, 4U }) {
+      BOOST_TEST_CONTEXT("start: " << start << " skip: " << skip) {
+        other.setStream(7U);
+        for (unsigned int i = 0; i < start; ++i) other.flat();
+        other.discard(skip);
+        BOOST_TEST(other.flat() == expected[start + skip]);
+        BOOST_TEST(other.flat() == expected[start + skip + 1]);
+      }
+    } // for start
+  } // for skip
+
+  // setSeed() restarts the stream
+  other.setSeed(static_cast<long>(Seed), 0);
+  BOOST_TEST(other.stream() == 7U);
+  BOOST_TEST(other.flat() == expected[0]);
+
+  // a different stream gives a different sequence
+  other.setStream(8U);
+  BOOST_TEST(other.flat() != expected[0]);
+
+  long const seeds[] = { static_cast<long>(Seed), 7L, 0L };
+  other.setSeeds(seeds, 2);
+  BOOST_TEST(other.stream() == 7U);
+  BOOST_TEST(other.flat() == expected[0]);
+
+} // sequenceTest()
+
+
+//------------------------------------------------------------------------------
+void concurrentStreamTest() {
+
+  constexpr unsigned int NStreams = 16U;
+  constexpr int N = 500;
+  constexpr std::uint64_t Seed = 42U;
+
+  std::vector<std::vector<double>> expected(NStreams, std::vector<double>(N));
+  for (unsigned int stream = 0; stream < NStreams; ++stream) {
+    util::PhiloxEngine engine { Seed, stream };
+    engine.flatArray(N, expected[stream].data());
+  }
+
+  // each thread generates some streams, in reverse order
+  std::vector<std::vector<double>> values(NStreams, std::vector<double>(N));
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < 4U; ++iThread) {
+    threads.emplace_back([&values,iThread]()
+      {
+        for (unsigned int stream = NStreams; stream-- > 0; ) {
+          if (stream % 4U != iThread) continue;
+          util::PhiloxEngine engine { Seed, stream };
+          engine.flatArray(N, values[stream].data());
+        }
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  for (unsigned int stream = 0; stream < NStreams; ++stream) {
+    BOOST_TEST_CONTEXT("stream: " << stream) {
+      for (int i = 0; i < N; ++i)
+        BOOST_TEST(values[stream][i] == expected[stream][i]);
+    }
+  }
+
+} // concurrentStreamTest()
+
+
+//------------------------------------------------------------------------------
+void statusTest() {
+
+  constexpr int N = 9;
+
+  util::PhiloxEngine engine { 2468U, 3U };
+  engine.flat();
+  static_cast<unsigned int>(engine); // leaves the engine at an odd word
+
+  std::stringstream sstr;
+  engine.put(sstr);
+  std::vector<unsigned long> const state = engine.put();
+
+  std::vector<double> expected(N);
+  engine.flatArray(N, expected.data());
+
+  util::PhiloxEngine other;
+  other.get(sstr);
+  BOOST_TEST(!sstr.fail());
+  BOOST_TEST(other.seed() == 2468U);
+  BOOST_TEST(other.stream() == 3U);
+  for (double const value: expected) BOOST_TEST(other.flat() == value);
+
+  util::PhiloxEngine fromVector;
+  BOOST_TEST(fromVector.get(state));
+  for (double const value: expected) BOOST_TEST(fromVector.flat() == value);
+
+  // wrong state
+  std::stringstream wrongState { "MixMaxRng-begin 1 2 3" };
+  other.get(wrongState);
+  BOOST_TEST(wrongState.fail());
+  BOOST_TEST(!other.get(std::vector<unsigned long>{ 1U, 2U, 3U }));
+
+} // statusTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( PhiloxEngineTestCase ) {
+
+  knownAnswerTest();
+  sequenceTest();
+  statusTest();
+
+} // BOOST_AUTO_TEST_CASE( PhiloxEngineTestCase )
+
+
+BOOST_AUTO_TEST_CASE( PhiloxEngineThreadTestCase ) {
+
+  concurrentStreamTest();
+
+} // BOOST_AUTO_TEST_CASE( PhiloxEngineThreadTestCase )
+
+
+//------------------------------------------------------------------------------
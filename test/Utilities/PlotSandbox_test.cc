@@ -0,0 +1,380 @@
+/**
+ * @file   PlotSandbox_test.cc
+ * @brief  Unit test for `icarus::ns::util::PlotSandbox`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/PlotSandbox.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE PlotSandbox
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/PlotSandbox.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// ROOT libraries
+#include "TROOT.h" // ROOT::EnableThreadSafety()
+#include "TMemFile.h"
+#include "TDirectory.h"
+#include "TH1F.h"
+#include "TH2D.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+using PlotSandbox_t = icarus::ns::util::PlotSandbox<TDirectory*>;
+
+
+/// Returns the names of the subboxes of `box`, in iteration order.
+std::vector<std::string> subboxNames(PlotSandbox_t const& box) {
+  std::vector<std::string> names;
+  for (PlotSandbox_t const& subbox: box.subSandboxes())
+    names.push_back(subbox.name());
+  return names;
+} // subboxNames()
+
+
+//------------------------------------------------------------------------------
+void subboxLookupTest() {
+
+  TMemFile outputFile { "PlotSandbox_lookup.root", "RECREATE" };
+
+  PlotSandbox_t box { &outputFile, "Main", "main" };
+  BOOST_TEST(box.hasDirectory());
+  BOOST_TEST(!box.hasLazyDirectories());
+  BOOST_TEST(box.getDirectory() == outputFile.GetDirectory("Main"));
+
+  // subboxes are added not in alphabetical order
+  std::vector<std::string> const names { "Zeta", "Alpha", "Mu", "Beta" };
+  for (std::string const& name: names) box.addSubSandbox(name, name + " box");
+  box.addSubSandbox("Mu/Inner", "inner");
+  BOOST_TEST(box.nSubSandboxes() == names.size());
+  BOOST_CHECK_THROW(box.addSubSandbox("Alpha", "again"), cet::exception);
+  BOOST_CHECK_THROW(box.addSubSandbox("Nu/Inner", "none"), cet::exception);
+
+  // iteration follows the order of creation
+  BOOST_TEST(subboxNames(box) == names, boost::test_tools::per_element());
+
+  for (std::string const& name: names) {
+    BOOST_TEST_CONTEXT("subbox: '" << name << "'") {
+      PlotSandbox_t const* subbox = box.findSandbox(name);
+      BOOST_TEST_REQUIRE(subbox);
+      BOOST_TEST(subbox->name() == name);
+      BOOST_TEST(subbox->ID() == "Main/" + name);
+      BOOST_TEST(&box.demandSandbox(name) == subbox);
+    }
+  } // for
+
+  // lookup by path
+  PlotSandbox_t* inner = box.findSandbox("Mu/Inner");
+  BOOST_TEST_REQUIRE(inner);
+  BOOST_TEST(inner->ID() == "Main/Mu/Inner");
+  BOOST_TEST(&box.demandSandbox("Mu/Inner") == inner);
+  BOOST_TEST(!box.findSandbox("Inner"));
+  BOOST_TEST(!box.findSandbox("Alpha/Inner"));
+  BOOST_TEST(!box.findSandbox("Nu/Inner"));
+  BOOST_TEST(!box.findSandbox("Mu/Inner/Deeper"));
+  BOOST_CHECK_THROW(box.demandSandbox("Nu"), cet::exception);
+
+  // object names are processed through all the hierarchy
+  TH1F* hist = inner->make<TH1F>("HTest", "test", 10, 0.0, 1.0);
+  BOOST_TEST_REQUIRE(hist);
+  BOOST_TEST(hist->GetName() == std::string{ "HTest_Inner_Mu_Main" });
+  BOOST_TEST(inner->get<TH1F>("HTest") == hist);
+  BOOST_TEST(!box.get<TH1F>("HTest"));
+
+} // subboxLookupTest()
+
+
+//------------------------------------------------------------------------------
+void deleteSubSandboxTest() {
+
+  TMemFile outputFile { "PlotSandbox_delete.root", "RECREATE" };
+
+  PlotSandbox_t box { &outputFile, "Main", "" };
+  for (std::string const name: { "A", "B", "C", "D" })
+    box.addSubSandbox(name, "");
+  box.demandSandbox("B").make<TH1F>("HB", "", 10, 0.0, 1.0);
+
+  BOOST_TEST(box.deleteSubSandbox("B"));
+  BOOST_TEST(!box.deleteSubSandbox("B"));
+  BOOST_TEST(!box.deleteSubSandbox("B/A"));
+  BOOST_TEST(box.nSubSandboxes() == 3U);
+  BOOST_TEST(!box.findSandbox("B"));
+  BOOST_TEST(!box.getDirectory()->GetDirectory("B"));
+
+  // the boxes after the deleted one are still found
+  std::vector<std::string> expected { "A", "C", "D" };
+  BOOST_TEST(subboxNames(box) == expected, boost::test_tools::per_element());
+  for (std::string const& name: expected) {
+    BOOST_TEST_CONTEXT("subbox: '" << name << "'") {
+      PlotSandbox_t const* subbox = box.findSandbox(name);
+      BOOST_TEST_REQUIRE(subbox);
+      BOOST_TEST(subbox->name() == name);
+    }
+  } // for
+
+  // remove the last and the first box, then add one at the end
+  BOOST_TEST(box.deleteSubSandbox("D"));
+  BOOST_TEST(box.deleteSubSandbox("A"));
+  box.addSubSandbox("B", "");
+  expected = { "C", "B" };
+  BOOST_TEST(subboxNames(box) == expected, boost::test_tools::per_element());
+  for (std::string const& name: expected) {
+    BOOST_TEST_CONTEXT("subbox: '" << name << "'") {
+      PlotSandbox_t const* subbox = box.findSandbox(name);
+      BOOST_TEST_REQUIRE(subbox);
+      BOOST_TEST(subbox->name() == name);
+    }
+  } // for
+
+  // deletion by path
+  box.addSubSandbox("C/Inner", "");
+  BOOST_TEST(box.demandSandbox("C").nSubSandboxes() == 1U);
+  BOOST_TEST(box.deleteSubSandbox("C/Inner"));
+  BOOST_TEST(box.demandSandbox("C").nSubSandboxes() == 0U);
+  BOOST_TEST(!box.findSandbox("C/Inner"));
+
+} // deleteSubSandboxTest()
+
+
+//------------------------------------------------------------------------------
+void handleTest() {
+
+  TMemFile outputFile { "PlotSandbox_handle.root", "RECREATE" };
+
+  PlotSandbox_t box { &outputFile, "Main", "" };
+  TH1F* hist = box.make<TH1F>("HTest", "test", 10, 0.0, 10.0);
+  TH1F* subHist = box.make<TH1F>("sub/HTest", "test", 10, 0.0, 10.0);
+
+  icarus::ns::util::PlotHandle<TH1F> const handle = box.handle<TH1F>("HTest");
+  BOOST_TEST(handle.isValid());
+  BOOST_TEST(static_cast<bool>(handle));
+  BOOST_TEST(handle.get() == hist);
+
+  handle->Fill(2.5);
+  BOOST_TEST(hist->GetBinContent(3) == 1.0);
+  BOOST_TEST((*handle).GetEntries() == 1.0);
+
+  BOOST_TEST(box.handle<TH1F>("sub/HTest").get() == subHist);
+  BOOST_TEST(box.handle("HTest").get() == hist); // as TObject
+
+  BOOST_CHECK_THROW(box.handle<TH1F>("HMissing"), cet::exception);
+  BOOST_CHECK_THROW(box.handle<TH2D>("HTest"), cet::exception); // wrong type
+
+  icarus::ns::util::PlotHandle<TH1F> const invalid;
+  BOOST_TEST(!invalid.isValid());
+  BOOST_TEST(!invalid);
+  BOOST_TEST(!invalid.get());
+
+} // handleTest()
+
+
+//------------------------------------------------------------------------------
+void lazyDirectoriesTest() {
+
+  TMemFile outputFile { "PlotSandbox_lazy.root", "RECREATE" };
+
+  PlotSandbox_t box
+    { &outputFile, "Lazy", "lazy", PlotSandbox_t::LazyDirectories };
+  PlotSandbox_t& used = box.addSubSandbox("Used", "");
+  PlotSandbox_t& unused = box.addSubSandbox("Unused", "");
+  PlotSandbox_t& inner = used.addSubSandbox("Inner", "");
+
+  BOOST_TEST(box.hasLazyDirectories());
+  BOOST_TEST(used.hasLazyDirectories());
+  BOOST_TEST(inner.hasLazyDirectories());
+
+  // no directory until something is put in the box
+  BOOST_TEST(!box.hasDirectory());
+  BOOST_TEST(!used.hasDirectory());
+  BOOST_TEST(!unused.hasDirectory());
+  BOOST_TEST(!inner.hasDirectory());
+  BOOST_TEST(!outputFile.GetDirectory("Lazy"));
+  BOOST_TEST(box.empty());
+
+  // looking up objects, dumping and writing do not create directories
+  BOOST_TEST(!used.get("HUsed"));
+  box.dump(std::cout);
+  std::cout << std::endl;
+  BOOST_TEST(box.write() == 0U);
+  BOOST_TEST(!box.hasDirectory());
+  BOOST_TEST(!used.hasDirectory());
+
+  // the first object creates the directory of its box and of the parents only
+  TH1F* hist = used.make<TH1F>("HUsed", "", 10, 0.0, 1.0);
+  BOOST_TEST(box.hasDirectory());
+  BOOST_TEST(used.hasDirectory());
+  BOOST_TEST(!unused.hasDirectory());
+  BOOST_TEST(!inner.hasDirectory());
+  BOOST_TEST(used.get<TH1F>("HUsed") == hist);
+  BOOST_TEST(!box.empty());
+  BOOST_TEST(unused.empty());
+
+  TDirectory* lazyDir = outputFile.GetDirectory("Lazy");
+  BOOST_TEST_REQUIRE(lazyDir);
+  BOOST_TEST(box.getDirectory() == lazyDir);
+  BOOST_TEST(used.getDirectory() == lazyDir->GetDirectory("Used"));
+  BOOST_TEST(!lazyDir->GetDirectory("Unused"));
+  BOOST_TEST(!lazyDir->GetDirectory("Used/Inner"));
+
+  // a box with no directory can be deleted
+  BOOST_TEST(box.deleteSubSandbox("Unused"));
+  BOOST_TEST(box.nSubSandboxes() == 1U);
+
+  // explicitly asking for the directory creates it
+  TDirectory* innerDir = inner.getDirectory();
+  BOOST_TEST(inner.hasDirectory());
+  BOOST_TEST(innerDir == lazyDir->GetDirectory("Used/Inner"));
+
+} // lazyDirectoriesTest()
+
+
+//------------------------------------------------------------------------------
+void deferredTest() {
+
+  TMemFile outputFile { "PlotSandbox_deferred.root", "RECREATE" };
+
+  PlotSandbox_t box { &outputFile, "Deferred", "" };
+  PlotSandbox_t& subbox = box.addSubSandbox("Sub", "");
+
+  // the same plots, filled directly and deferred
+  TH1F* direct = box.make<TH1F>("HDirect", "", 20, -1.0, 1.0);
+  auto& deferred = box.makeDeferred<TH1F>("HDeferred", "", 20, -1.0, 1.0);
+  TH2D* direct2D
+    = subbox.make<TH2D>("HDirect2D", "", 5, 0.0, 1.0, 4, 0.0, 2.0);
+  auto& deferred2D
+    = subbox.makeDeferred<TH2D>("HDeferred2D", "", 5, 0.0, 1.0, 4, 0.0, 2.0);
+  BOOST_TEST(box.nDeferred() == 1U);
+  BOOST_TEST(subbox.nDeferred() == 1U);
+
+  // values span beyond the histogram range on both sides
+  for (int i = 0; i < 1000; ++i) {
+    double const x = -1.2 + 0.0025 * i;
+    double const w = (i % 4 == 0)? 2.0: 1.0;
+    direct->Fill(x, w);
+    deferred.fill(x, w);
+
+    double const u = 0.0011 * i, v = 0.0023 * i;
+    direct2D->Fill(u, v);
+    deferred2D.fill(u, v);
+  } // for
+
+  TH1F const* hist = box.get<TH1F>("HDeferred");
+  TH2D const* hist2D = subbox.get<TH2D>("HDeferred2D");
+  BOOST_TEST_REQUIRE(hist);
+  BOOST_TEST_REQUIRE(hist2D);
+  BOOST_TEST(hist->GetEntries() == 0.0); // not flushed yet
+  BOOST_TEST(hist2D->GetEntries() == 0.0);
+
+  box.flushDeferred(); // subboxes too
+
+  BOOST_TEST(hist->GetEntries() == direct->GetEntries());
+  for (int bin = 0; bin <= 21; ++bin) {
+    BOOST_TEST_CONTEXT("bin: " << bin) {
+      BOOST_TEST(hist->GetBinContent(bin) == direct->GetBinContent(bin));
+      BOOST_TEST(hist->GetBinError(bin) == direct->GetBinError(bin),
+        1e-6 % boost::test_tools::tolerance());
+    }
+  } // for
+
+  BOOST_TEST(hist2D->GetEntries() == direct2D->GetEntries());
+  for (int ix = 0; ix <= 6; ++ix) {
+    for (int iy = 0; iy <= 5; ++iy) {
+      BOOST_TEST_CONTEXT("bin: (" << ix << ", " << iy << ")") {
+        BOOST_TEST
+          (hist2D->GetBinContent(ix, iy) == direct2D->GetBinContent(ix, iy));
+      }
+    } // for y
+  } // for x
+
+  // the content was moved: flushing again changes nothing
+  box.flushDeferred();
+  BOOST_TEST(hist->GetEntries() == direct->GetEntries());
+  BOOST_TEST(hist->GetBinContent(10) == direct->GetBinContent(10));
+
+} // deferredTest()
+
+
+//------------------------------------------------------------------------------
+void writeAsyncTest() {
+
+  ROOT::EnableThreadSafety();
+
+  TMemFile outputFile { "PlotSandbox_write.root", "RECREATE" };
+
+  PlotSandbox_t box
+    { &outputFile, "Written", "", PlotSandbox_t::LazyDirectories };
+  PlotSandbox_t& filled = box.addSubSandbox("Filled", "");
+  box.addSubSandbox("Empty", "");
+
+  box.make<TH1F>("HMain", "", 10, 0.0, 1.0)->Fill(0.5);
+  filled.make<TH1F>("HFilled", "", 10, 0.0, 1.0)->Fill(0.25);
+
+  std::size_t const nWritten = box.writeAsync().get();
+  BOOST_TEST(nWritten >= 2U);
+
+  TDirectory* dir = outputFile.GetDirectory("Written");
+  BOOST_TEST_REQUIRE(dir);
+  BOOST_TEST(dir->GetKey("HMain_Written"));
+  TDirectory* filledDir = dir->GetDirectory("Filled");
+  BOOST_TEST_REQUIRE(filledDir);
+  BOOST_TEST(filledDir->GetKey("HFilled_Filled_Written"));
+  BOOST_TEST(!dir->GetDirectory("Empty")); // never used, never created
+
+  // writing again replaces the objects
+  BOOST_TEST(box.writeAsync().get() == nWritten);
+  BOOST_TEST(filledDir->GetListOfKeys()->GetSize() == 1);
+
+} // writeAsyncTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( SubboxTestCase ) {
+
+  subboxLookupTest();
+  deleteSubSandboxTest();
+
+} // BOOST_AUTO_TEST_CASE( SubboxTestCase )
+
+
+BOOST_AUTO_TEST_CASE( HandleTestCase ) {
+
+  handleTest();
+
+} // BOOST_AUTO_TEST_CASE( HandleTestCase )
+
+
+BOOST_AUTO_TEST_CASE( LazyDirectoriesTestCase ) {
+
+  lazyDirectoriesTest();
+
+} // BOOST_AUTO_TEST_CASE( LazyDirectoriesTestCase )
+
+
+BOOST_AUTO_TEST_CASE( DeferredTestCase ) {
+
+  deferredTest();
+
+} // BOOST_AUTO_TEST_CASE( DeferredTestCase )
+
+
+BOOST_AUTO_TEST_CASE( WriteTestCase ) {
+
+  writeAsyncTest();
+
+} // BOOST_AUTO_TEST_CASE( WriteTestCase )
+
+
+//------------------------------------------------------------------------------
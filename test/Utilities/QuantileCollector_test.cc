@@ -0,0 +1,132 @@
+/**
+ * @file QuantileCollector_test.cc
+ * @brief Unit test for `QuantileCollector` class.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ * @see icarusalg/Utilities/QuantileCollector.h
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE QuantileCollector
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/QuantileCollector.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort()
+#include <random>
+#include <stdexcept> // std::out_of_range
+#include <vector>
+#include <cmath> // std::abs()
+
+
+// -----------------------------------------------------------------------------
+void ExactTest() {
+
+  icarus::ns::util::QuantileCollector<double> stats;
+
+  BOOST_TEST(stats.isExact());
+  BOOST_TEST(!stats.has_data());
+  BOOST_TEST(stats.N() == 0U);
+  BOOST_CHECK_THROW(stats.median(), std::out_of_range);
+
+  stats.add(5.0);
+  BOOST_TEST(stats.has_data());
+  BOOST_TEST(stats.N() == 1U);
+  BOOST_TEST(stats.min() == 5.0);
+  BOOST_TEST(stats.max() == 5.0);
+  BOOST_TEST(stats.median() == 5.0);
+  BOOST_TEST(stats.RMS() == 0.0);
+
+  stats.add(3.0);
+  BOOST_TEST(stats.median() == 4.0); // average of { 3, 5 }
+  BOOST_TEST(stats.Average() == 4.0);
+  BOOST_TEST(stats.RMS() == 1.0);
+
+  stats.add(10.0);
+  BOOST_TEST(stats.median() == 5.0);
+  BOOST_TEST(stats.quantile(0.0) == 3.0);
+  BOOST_TEST(stats.quantile(1.0) == 10.0);
+  BOOST_TEST(stats.quantile(0.75) == 7.5);
+  BOOST_TEST(stats.quantile(2.0) == 10.0); // clamped
+  BOOST_TEST(stats.min() == 3.0);
+  BOOST_TEST(stats.max() == 10.0);
+
+  stats.add(1.0); // query after unsorted addition
+  BOOST_TEST(stats.median() == 4.0); // average of { 3, 5 } in { 1, 3, 5, 10 }
+
+  stats.clear();
+  BOOST_TEST(!stats.has_data());
+  BOOST_TEST(stats.isExact());
+
+  // integral data
+  icarus::ns::util::QuantileCollector<short> counts;
+  std::vector<short> const values { 4, -2, 7, 7, 0 };
+  counts.add(values.begin(), values.end());
+  BOOST_TEST(counts.N() == values.size());
+  BOOST_TEST(counts.median() == 4.0);
+  BOOST_TEST(counts.min() == -2);
+  BOOST_TEST(counts.max() == 7);
+
+} // ExactTest()
+
+
+// -----------------------------------------------------------------------------
+void BinnedTest() {
+
+  constexpr double BinWidth = 0.1;
+
+  icarus::ns::util::QuantileCollector<double> binned { BinWidth };
+  icarus::ns::util::QuantileCollector<double> exact;
+  BOOST_TEST(!binned.isExact());
+  BOOST_TEST(icarus::ns::util::QuantileCollector<double>{ 0.0 }.isExact());
+
+  std::mt19937 engine { 1234 };
+  std::normal_distribution<double> gauss { 14900.0, 2.0 };
+  for (unsigned int i = 0; i < 100000U; ++i) {
+    double const value = gauss(engine);
+    binned.add(value);
+    exact.add(value);
+  }
+
+  BOOST_TEST(binned.N() == exact.N());
+  BOOST_TEST(binned.min() == exact.min());
+  BOOST_TEST(binned.max() == exact.max());
+  BOOST_TEST(binned.Average() == exact.Average(),
+    1e-9 % boost::test_tools::tolerance());
+  BOOST_TEST(binned.RMS() == exact.RMS(),
+    1e-9 % boost::test_tools::tolerance());
+
+  for (double const fraction: { 0.0, 0.01, 0.25, 0.5, 0.75, 0.99, 1.0 }) {
+    BOOST_TEST_CONTEXT("fraction: " << fraction) {
+      BOOST_TEST(std::abs(binned.quantile(fraction) - exact.quantile(fraction))
+        < BinWidth);
+    }
+  } // for
+
+  // memory is bound by the spread of the values, not by their number
+  std::size_t const storage = binned.storageSize();
+  BOOST_TEST(storage < 1000U);
+  for (unsigned int i = 0; i < 100000U; ++i) binned.add(gauss(engine));
+  BOOST_TEST(binned.storageSize() <= storage + 100U);
+  BOOST_TEST(exact.storageSize() == exact.N());
+
+  binned.clear();
+  BOOST_TEST(!binned.has_data());
+  BOOST_TEST(!binned.isExact());
+
+} // BinnedTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(QuantileCollectorTestCase) {
+
+  ExactTest();
+  BinnedTest();
+
+} // BOOST_AUTO_TEST_CASE(QuantileCollectorTestCase)
+
+
+// -----------------------------------------------------------------------------
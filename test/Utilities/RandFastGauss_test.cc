@@ -0,0 +1,114 @@
+/**
+ * @file   RandFastGauss_test.cc
+ * @brief  Unit test for `util::RandFastGauss`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/RandFastGauss.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE RandFastGaussTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/RandFastGauss.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/MixMaxRng.h"
+
+// C/C++ standard libraries
+#include <sstream>
+#include <vector>
+#include <cmath> // std::sqrt()
+
+
+//------------------------------------------------------------------------------
+void fireArrayTest() {
+
+  constexpr int N = 10000;
+  constexpr long Seed = 12345;
+
+  CLHEP::MixMaxRng engine { Seed };
+  util::RandFastGauss gauss { engine, 5.0, 2.0 };
+
+  std::vector<double> expected(N);
+  for (double& value: expected) value = gauss.fire();
+
+  // same engine status, same sequence
+  engine.setSeed(Seed, 0);
+  std::vector<double> values(N);
+  gauss.fireArray(N, values.data());
+  for (int i = 0; i < N; ++i) BOOST_TEST(values[i] == expected[i]);
+
+  // and with parameters explicitly specified
+  engine.setSeed(Seed, 0);
+  gauss.fireArray(N, values.data(), 5.0, 2.0);
+  for (int i = 0; i < N; ++i) BOOST_TEST(values[i] == expected[i]);
+
+  engine.setSeed(Seed, 0);
+  util::RandFastGauss::shootArray(&engine, N, values.data(), 5.0, 2.0);
+  for (int i = 0; i < N; ++i) BOOST_TEST(values[i] == expected[i]);
+
+  // loose check of the distribution
+  double sum = 0.0, sumSq = 0.0;
+  for (double const value: values) { sum += value; sumSq += value * value; }
+  double const mean = sum / N;
+  double const RMS = std::sqrt(sumSq / N - mean * mean);
+  BOOST_TEST(mean == 5.0, boost::test_tools::tolerance(0.02));
+  BOOST_TEST(RMS == 2.0, boost::test_tools::tolerance(0.03));
+
+} // fireArrayTest()
+
+
+//------------------------------------------------------------------------------
+void statusTest() {
+
+  constexpr int N = 100;
+
+  // distribution parameters
+  CLHEP::MixMaxRng engine { 54321 };
+  util::RandFastGauss gauss { engine, -3.0, 0.1 };
+
+  std::stringstream sstr;
+  gauss.put(sstr);
+
+  util::RandFastGauss otherGauss { engine };
+  BOOST_TEST(otherGauss.defaultMean() == 0.0);
+  BOOST_TEST(otherGauss.defaultStdDev() == 1.0);
+  otherGauss.get(sstr);
+  BOOST_TEST(!sstr.fail());
+  BOOST_TEST(otherGauss.defaultMean() == -3.0);
+  BOOST_TEST(otherGauss.defaultStdDev() == 0.1);
+
+  // full state, with the static engine
+  std::stringstream state;
+  util::RandFastGauss::saveFullState(state);
+
+  std::vector<double> expected(N);
+  util::RandFastGauss::shootArray(N, expected.data());
+
+  util::RandFastGauss::restoreFullState(state);
+  BOOST_TEST(!state.fail());
+  for (double const value: expected)
+    BOOST_TEST(util::RandFastGauss::shoot() == value);
+
+  // wrong state
+  std::stringstream wrongState { "RandGauss CACHED_GAUSSIAN: 0" };
+  util::RandFastGauss::restoreDistState(wrongState);
+  BOOST_TEST(wrongState.fail());
+
+} // statusTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( RandFastGaussTestCase ) {
+
+  fireArrayTest();
+  statusTest();
+
+} // BOOST_AUTO_TEST_CASE( RandFastGaussTestCase )
+
+
+//------------------------------------------------------------------------------
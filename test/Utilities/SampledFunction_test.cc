@@ -17,6 +17,10 @@ namespace tt = boost::test_tools;
 // LArSoft libraries
 #include "larcorealg/CoreUtils/counter.h"
 
+// C/C++ standard libraries
+#include <vector>
+#include <memory> // std::unique_ptr
+
 
 //------------------------------------------------------------------------------
 template <typename T, typename U>
@@ -221,6 +225,99 @@ void ExtendedRangeTest() {
 } // void ExtendedRangeTest()
 
 
+//------------------------------------------------------------------------------
+void EvaluateTest() {
+
+  auto line = [](double x){ return 2.0 * x + 1.0; };
+
+  // [ 0.0, 4.0 ] with step size 1.0 and 4 subsamples (0.25 substep size):
+  // the samples are at 0.0, 0.25, 0.50, ..., 3.75
+  constexpr gsl::index nSamples = 4;
+  constexpr gsl::index nSubsamples = 4;
+  using SampledFunction_t = util::SampledFunction<>;
+  using Interpolation = SampledFunction_t::Interpolation;
+  SampledFunction_t const sampled { line, 0.0, 4.0, nSamples, nSubsamples };
+
+  auto const close = tt::tolerance(1.e-9);
+
+  // nearest sample
+  BOOST_TEST(sampled.evaluate(0.0) == line(0.0));
+  BOOST_TEST(sampled.evaluate(0.1) == line(0.0));
+  BOOST_TEST(sampled.evaluate(0.2) == line(0.25));
+  BOOST_TEST(sampled.evaluate(3.8) == line(3.75));
+  BOOST_TEST(sampled.evaluate(-0.1) == line(0.0));
+  BOOST_TEST(sampled.evaluate(-0.2) == 0.0);
+  BOOST_TEST(sampled.evaluate(3.9, -1.0) == -1.0);
+
+  // linear interpolation
+  BOOST_TEST(sampled.evaluate<Interpolation::linear>(0.1) == line(0.1), close);
+  BOOST_TEST(sampled.evaluate<Interpolation::linear>(2.6) == line(2.6), close);
+  BOOST_TEST(sampled.evaluate<Interpolation::linear>(3.75) == line(3.75), close);
+  // half way to the (zero) value beyond the last sample
+  BOOST_TEST(sampled.evaluate<Interpolation::linear>(3.875) == line(3.75) / 2.0,
+    close);
+  BOOST_TEST(sampled.evaluate<Interpolation::linear>(-1.0) == 0.0);
+  BOOST_TEST(sampled.evaluate<Interpolation::linear>(10.0) == 0.0);
+
+  // batch evaluation, with dynamic and fixed number of subsamples
+  std::vector<double> xs;
+  for (double x = -1.0; x < 5.0; x += 0.01) xs.push_back(x);
+  std::vector<double> values(xs.size());
+  std::vector<double> fixedValues(xs.size());
+  std::vector<double> modeValues(xs.size());
+
+  sampled.evaluate(xs, values);
+  sampled.evaluate<Interpolation::nearest, nSubsamples>(xs, fixedValues);
+  sampled.evaluate(xs, modeValues, Interpolation::nearest);
+  for (std::size_t i = 0; i < xs.size(); ++i) BOOST_TEST_CONTEXT("x=" << xs[i]) {
+    BOOST_TEST(values[i] == sampled.evaluate(xs[i]));
+    BOOST_TEST(fixedValues[i] == values[i]);
+    BOOST_TEST(modeValues[i] == values[i]);
+  }
+
+  sampled.evaluate<Interpolation::linear>(xs, values, 1.0);
+  sampled.evaluate<Interpolation::linear, nSubsamples>(xs, fixedValues, 1.0);
+  sampled.evaluate(xs, modeValues, Interpolation::linear, 1.0);
+  for (std::size_t i = 0; i < xs.size(); ++i) BOOST_TEST_CONTEXT("x=" << xs[i]) {
+    BOOST_TEST
+      (values[i] == sampled.evaluate<Interpolation::linear>(xs[i], 1.0));
+    BOOST_TEST(fixedValues[i] == values[i]);
+    BOOST_TEST(modeValues[i] == values[i]);
+    if ((xs[i] >= 0.0) && (xs[i] <= 3.75))
+      BOOST_TEST(values[i] == line(xs[i]), close);
+  }
+
+} // void EvaluateTest()
+
+
+//------------------------------------------------------------------------------
+void SharedStorageTest() {
+
+  // a functor which can't be copied (nor stored in a `std::function`)
+  struct Square {
+    std::unique_ptr<double> scale = std::make_unique<double>(0.5);
+    double operator() (double x) const { return *scale * x * x; }
+  }; // Square
+
+  constexpr gsl::index nSamples = 8;
+  constexpr gsl::index nSubsamples = 2;
+  Square const square;
+  util::SampledFunction<> const sampled
+    { square, 0.0, 4.0, nSamples, nSubsamples };
+  BOOST_TEST_REQUIRE(sampled.samplesStorage());
+  BOOST_TEST(sampled.samplesStorage()->size() == 16U);
+  BOOST_TEST(sampled.value(3, 1) == square(1.75));
+
+  // copies share the samples
+  util::SampledFunction<> const copy { sampled };
+  BOOST_TEST(copy.samplesStorage() == sampled.samplesStorage());
+  BOOST_TEST(copy.samplesStorage().use_count() == 2);
+  BOOST_TEST(copy.subsample(1).data() == sampled.subsample(1).data());
+  BOOST_TEST(copy.value(3, 1) == square(1.75));
+
+} // void SharedStorageTest()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
@@ -228,6 +325,8 @@ BOOST_AUTO_TEST_CASE( TestCase ) {
 
   IdentityTest();
   ExtendedRangeTest();
+  EvaluateTest();
+  SharedStorageTest();
 
 } // BOOST_AUTO_TEST_CASE( TestCase )
 
@@ -0,0 +1,211 @@
+/**
+ * @file   SampledTable_test.cc
+ * @brief  Unit test for `util::SampledTable`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/SampledTable.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE SampledTable
+#include <boost/test/unit_test.hpp>
+namespace tt = boost::test_tools;
+
+// ICARUS libraries
+#include "icarusalg/Utilities/SampledTable.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <cstdio> // std::remove()
+#include <unistd.h> // getpid()
+
+
+//------------------------------------------------------------------------------
+void QueryAndValuesTest() {
+
+  using Table_t = util::SampledTable<3U>;
+
+  auto plane = [](double x, double y, double z)
+    { return 1.0 + 2.0 * x - 3.0 * y + 0.5 * z; };
+
+  // sizes not multiple of the block edge, to exercise the padding
+  Table_t::Axes_t const axes {
+    Table_t::makeAxis(-1.0, 1.0, 5),  // step 0.4
+    Table_t::makeAxis( 0.0, 3.0, 6),  // step 0.5
+    Table_t::makeAxis( 2.0, 4.0, 9)
+    };
+  Table_t const table { plane, axes };
+
+  BOOST_TEST(Table_t::Dims == 3U);
+  BOOST_TEST(!table.empty());
+  BOOST_TEST(table.size() == 5 * 6 * 9);
+  BOOST_TEST(table.nSamples(1) == 6);
+  BOOST_TEST(table.lower(0) == -1.0);
+  BOOST_TEST(table.upper(0) == 1.0, tt::tolerance(1e-12));
+  BOOST_TEST(table.stepSize(1) == 0.5);
+  BOOST_TEST(table.storageSize() == 2U * 2U * 3U * Table_t::BlockSize);
+
+  std::vector<double> rowMajor;
+  for (gsl::index i = 0; i < 5; ++i) {
+    for (gsl::index j = 0; j < 6; ++j) {
+      for (gsl::index k = 0; k < 9; ++k) {
+        double const x = axes[0].lower + i * axes[0].step;
+        double const y = axes[1].lower + j * axes[1].step;
+        double const z = axes[2].lower + k * axes[2].step;
+        BOOST_TEST_CONTEXT("sample [" << i << "][" << j << "][" << k << "]") {
+          BOOST_TEST(table.value({ i, j, k }) == plane(x, y, z));
+        }
+        rowMajor.push_back(plane(x, y, z));
+      } // k
+    } // j
+  } // i
+
+  // the same table from row-major values
+  Table_t const fromValues = Table_t::fromValues(axes, rowMajor);
+  BOOST_TEST(fromValues.storageSize() == table.storageSize());
+  for (std::size_t i = 0; i < table.storageSize(); ++i)
+    BOOST_TEST(fromValues.samplesStorage().get()[i]
+      == table.samplesStorage().get()[i]);
+
+  rowMajor.pop_back();
+  BOOST_CHECK_THROW(Table_t::fromValues(axes, rowMajor), std::runtime_error);
+
+  // copies share the samples
+  Table_t const copy { table };
+  BOOST_TEST(copy.samplesStorage() == table.samplesStorage());
+
+} // QueryAndValuesTest()
+
+
+//------------------------------------------------------------------------------
+void EvaluateTest() {
+
+  using Table_t = util::SampledTable<2U>;
+  using Interpolation = Table_t::Interpolation;
+
+  // a bilinear function is interpolated exactly
+  auto bilinear = [](Table_t::Coords_t const& p)
+    { return 1.0 + p[0] + 2.0 * p[1] + 0.5 * p[0] * p[1]; };
+
+  // samples at 0, 1, ..., 5 (x) and 0, 0.5, ..., 3.5 (y)
+  Table_t const table {
+    bilinear,
+    { Table_t::Axis_t{ 0.0, 1.0, 6 }, Table_t::Axis_t{ 0.0, 0.5, 8 } }
+    };
+
+  auto const close = tt::tolerance(1.e-9);
+
+  // nearest sample
+  BOOST_TEST(table.evaluate({ 0.0, 0.0 }) == bilinear({ 0.0, 0.0 }));
+  BOOST_TEST(table.evaluate({ 2.4, 1.2 }) == bilinear({ 2.0, 1.0 }));
+  BOOST_TEST(table.evaluate({ 2.6, 1.3 }) == bilinear({ 3.0, 1.5 }));
+  BOOST_TEST(table.evaluate({ -0.4, 0.0 }) == bilinear({ 0.0, 0.0 }));
+  BOOST_TEST(table.evaluate({ -0.6, 0.0 }) == 0.0);
+  BOOST_TEST(table.evaluate({ 1.0, 3.9 }, -1.0) == -1.0);
+
+  // multilinear interpolation
+  for (double x = 0.0; x <= 5.0; x += 0.3) {
+    for (double y = 0.0; y <= 3.5; y += 0.2) {
+      BOOST_TEST_CONTEXT("point (" << x << ", " << y << ")") {
+        BOOST_TEST(table.evaluate<Interpolation::linear>({ x, y })
+          == bilinear({ x, y }), close);
+      }
+    }
+  }
+  // half way to the (zero) value beyond the last sample in x
+  BOOST_TEST(table.evaluate<Interpolation::linear>({ 5.5, 1.0 })
+    == bilinear({ 5.0, 1.0 }) / 2.0, close);
+  BOOST_TEST(table.evaluate<Interpolation::linear>({ -2.0, 1.0 }) == 0.0);
+  BOOST_TEST(table.evaluate<Interpolation::linear>({ 1.0, 9.0 }, 3.0) == 3.0);
+
+  // batch evaluation
+  std::vector<Table_t::Coords_t> xs;
+  for (double x = -1.0; x < 7.0; x += 0.13)
+    for (double y = -1.0; y < 5.0; y += 0.17) xs.push_back({ x, y });
+  std::vector<double> values(xs.size());
+  std::vector<double> modeValues(xs.size());
+
+  table.evaluate(xs, values);
+  table.evaluate(xs, modeValues, Interpolation::nearest);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    BOOST_TEST(values[i] == table.evaluate(xs[i]));
+    BOOST_TEST(modeValues[i] == values[i]);
+  }
+
+  table.evaluate<Interpolation::linear>(xs, values, 1.0);
+  table.evaluate(xs, modeValues, Interpolation::linear, 1.0);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    BOOST_TEST
+      (values[i] == table.evaluate<Interpolation::linear>(xs[i], 1.0));
+    BOOST_TEST(modeValues[i] == values[i]);
+  }
+
+} // EvaluateTest()
+
+
+//------------------------------------------------------------------------------
+void FileTest() {
+
+  using Table_t = util::SampledTable<3U, double, float>;
+  using Interpolation = Table_t::Interpolation;
+
+  auto function = [](double x, double y, double z)
+    { return static_cast<float>(x * y - z); };
+  Table_t::Axes_t const axes {
+    Table_t::makeAxis(0.0, 1.0, 7),
+    Table_t::makeAxis(0.0, 2.0, 10),
+    Table_t::makeAxis(-1.0, 1.0, 5)
+    };
+  Table_t const table { function, axes };
+
+  std::string const savedPath
+    = "SampledTable_test_saved_" + std::to_string(::getpid()) + ".bin";
+  std::string const sampledPath
+    = "SampledTable_test_sampled_" + std::to_string(::getpid()) + ".bin";
+
+  table.save(savedPath);
+  Table_t::sampleToFile(sampledPath, function, axes);
+
+  for (std::string const& path: { savedPath, sampledPath }) {
+    BOOST_TEST_CONTEXT("file: '" << path << "'") {
+      Table_t const mapped = Table_t::mapFile(path);
+      BOOST_TEST(mapped.size() == table.size());
+      BOOST_TEST(mapped.storageSize() == table.storageSize());
+      for (std::size_t i = 0; i < table.storageSize(); ++i)
+        BOOST_TEST(mapped.samplesStorage().get()[i]
+          == table.samplesStorage().get()[i]);
+      Table_t::Coords_t const p { 0.33, 1.27, 0.11 };
+      BOOST_TEST(mapped.evaluate<Interpolation::linear>(p)
+        == table.evaluate<Interpolation::linear>(p));
+
+      // a table of a different type is rejected
+      BOOST_CHECK_THROW(
+        (util::SampledTable<3U, double, double>::mapFile(path)),
+        std::runtime_error
+        );
+      BOOST_CHECK_THROW(
+        (util::SampledTable<2U, double, float>::mapFile(path)),
+        std::runtime_error
+        );
+    }
+  } // for
+
+  std::remove(savedPath.c_str());
+  std::remove(sampledPath.c_str());
+
+  BOOST_CHECK_THROW(Table_t::mapFile(savedPath), std::runtime_error);
+
+} // FileTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( TestCase ) {
+
+  QueryAndValuesTest();
+  EvaluateTest();
+  FileTest();
+
+} // BOOST_AUTO_TEST_CASE( TestCase )
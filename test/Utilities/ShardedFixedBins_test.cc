@@ -0,0 +1,79 @@
+/**
+ * @file ShardedFixedBins_test.cc
+ * @brief Unit test for `ShardedFixedBins` class.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 14, 2026
+ * @see icarusalg/Utilities/ShardedFixedBins.h
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ShardedFixedBins
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/ShardedFixedBins.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <thread>
+
+
+// -----------------------------------------------------------------------------
+void ConcurrentFillTest() {
+
+  constexpr unsigned int NThreads = 8U;
+  constexpr int NValues = 10000;
+
+  icarus::ns::util::ShardedFixedBins<double> bins { 0.5, 0.25 };
+  BOOST_TEST((bins.binWidth() == 0.5));
+  BOOST_TEST((bins.offset() == 0.25));
+
+  // each thread fills a different range, partially overlapping the others
+  auto valueOf = [](unsigned int iThread, int i)
+    { return 10.0 * iThread + 0.01 * i; };
+
+  std::vector<char> sameShard(NThreads, 0); // Boost checks are not thread-safe
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&bins,&valueOf,&sameShard,iThread]()
+      {
+        auto& localBins = bins.local();
+        sameShard[iThread] = (&bins.local() == &localBins);
+        for (int i = 0; i < NValues; ++i) localBins.add(valueOf(iThread, i));
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  for (char const same: sameShard) BOOST_TEST(same);
+
+  BOOST_TEST(bins.nShards() == NThreads);
+
+  icarus::ns::util::FixedBins<double> expected { 0.5, 0.25 };
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread)
+    for (int i = 0; i < NValues; ++i) expected.add(valueOf(iThread, i));
+
+  icarus::ns::util::FixedBins<double> const merged = bins.merged();
+  BOOST_TEST((merged.min() == expected.min()));
+  BOOST_TEST((merged.max() == expected.max()));
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (merged.begin(), merged.end(), expected.begin(), expected.end());
+
+  bins.clear();
+  BOOST_TEST(bins.nShards() == NThreads);
+  BOOST_TEST(bins.merged().empty());
+
+} // ConcurrentFillTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( TestCase ) {
+
+  ConcurrentFillTest();
+
+} // BOOST_AUTO_TEST_CASE( TestCase )
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+/**
+ * @file   ShardedPassCounter_test.cc
+ * @brief  Unit test for `icarus::ns::util::ShardedPassCounter`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/ShardedPassCounter.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ShardedPassCounterTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/ShardedPassCounter.h"
+
+// C/C++ standard libraries
+#include <thread>
+#include <vector>
+#include <atomic>
+
+
+//------------------------------------------------------------------------------
+void SingleThreadTest() {
+
+  icarus::ns::util::ShardedPassCounter<> counter;
+  BOOST_TEST(counter.empty());
+  BOOST_TEST(counter.total() == 0U);
+  BOOST_TEST(counter.passed() == 0U);
+  BOOST_TEST(counter.failed() == 0U);
+
+  counter.add(true);
+  counter.addPassed();
+  counter.addFailed();
+  counter.add(false);
+  counter.add(false);
+
+  BOOST_TEST(!counter.empty());
+  BOOST_TEST(counter.total() == 5U);
+  BOOST_TEST(counter.passed() == 2U);
+  BOOST_TEST(counter.failed() == 3U);
+
+  counter.reset();
+  BOOST_TEST(counter.empty());
+  BOOST_TEST(counter.passed() == 0U);
+
+} // SingleThreadTest()
+
+
+//------------------------------------------------------------------------------
+template <std::size_t NShards>
+void MultiThreadTest(unsigned int nThreads) {
+
+  /*
+   * Each thread registers a fixed number of events, passing one in three.
+   * The shards are fewer than the threads when `NShards` is small,
+   * to test shared shards too.
+   * While threads are running, the number of failed events must stay sane.
+   */
+  constexpr unsigned int NEvents = 100000U;
+
+  icarus::ns::util::ShardedPassCounter<unsigned long int, NShards> counter;
+
+  std::atomic<bool> done { false };
+  std::atomic<unsigned int> nErrors { 0U };
+  std::thread reader { [&counter,&done,&nErrors,nThreads]()
+    {
+      while (!done) {
+        if (counter.failed() > nThreads * NEvents) ++nErrors;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+    threads.emplace_back([&counter]()
+      { for (unsigned int i = 0; i < NEvents; ++i) counter.add(i % 3 == 0); }
+      );
+  }
+  for (std::thread& thread: threads) thread.join();
+  done = true;
+  reader.join();
+
+  unsigned long int const expectedPassed = nThreads * ((NEvents + 2U) / 3U);
+  BOOST_TEST(nErrors.load() == 0U);
+  BOOST_TEST(counter.total() == nThreads * NEvents);
+  BOOST_TEST(counter.passed() == expectedPassed);
+  BOOST_TEST(counter.failed() == nThreads * NEvents - expectedPassed);
+
+} // MultiThreadTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( ShardedPassCounterTestCase ) {
+
+  SingleThreadTest();
+
+} // BOOST_AUTO_TEST_CASE( ShardedPassCounterTestCase )
+
+
+BOOST_AUTO_TEST_CASE( ShardedPassCounterThreadTestCase ) {
+
+  MultiThreadTest<64U>(8U);
+  MultiThreadTest<3U>(8U); // shards are shared
+
+} // BOOST_AUTO_TEST_CASE( ShardedPassCounterThreadTestCase )
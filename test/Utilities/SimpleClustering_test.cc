@@ -0,0 +1,197 @@
+/**
+ * @file SimpleClustering_test.cc
+ * @brief Unit test for the clustering algorithms in `SimpleClustering.h`.
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @date October 15, 2026
+ * @see icarusalg/Utilities/SimpleClustering.h
+ */
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE SimpleClustering
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/SimpleClustering.h"
+#include "test/AllocationCounter.h"
+
+// C/C++ standard libraries
+#include <functional> // std::less<>
+#include <random>
+#include <vector>
+#include <cmath> // std::abs()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  struct Hit {
+    double time;
+    int id;
+  }; // Hit
+
+  auto const hitTime = [](Hit const& hit){ return hit.time; };
+  auto const hitID = [](Hit const& hit){ return hit.id; };
+  auto const closeTimes
+    = [](double a, double b){ return std::abs(a - b) < 2.0; };
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+void checkClusters(
+  std::vector<std::vector<int>> const& clusters,
+  std::vector<std::vector<int>> const& expected
+) {
+  BOOST_TEST_REQUIRE(clusters.size() == expected.size());
+  for (std::size_t iCluster = 0; iCluster < clusters.size(); ++iCluster) {
+    BOOST_TEST_CONTEXT("cluster #" << iCluster) {
+      BOOST_TEST(clusters[iCluster] == expected[iCluster],
+        boost::test_tools::per_element());
+    }
+  } // for
+} // checkClusters()
+
+
+// -----------------------------------------------------------------------------
+void SortedClusteringTest() {
+
+  // clusters: { 0, 1, 1.5 } { 3, 4.9 } { 10 }
+  std::vector<Hit> const hits
+    { { 0.0, 0 }, { 1.0, 1 }, { 1.5, 2 }, { 3.0, 3 }, { 4.9, 4 }, { 10.0, 5 } };
+  std::vector<std::vector<int>> const expected
+    { { 0, 1, 2 }, { 3, 4 }, { 5 } };
+
+  auto const clusters = util::clusterSortedBy(hits, hitTime, closeTimes, hitID);
+  checkClusters(clusters, expected);
+
+  auto const reference
+    = util::clusterBy(hits, hitTime, closeTimes, hitID, std::less<double>{});
+  checkClusters(clusters, reference);
+
+  std::vector<std::size_t> sizes;
+  std::size_t const nClusters = util::forEachSortedCluster(
+    hits.begin(), hits.end(), hitTime, closeTimes,
+    [&sizes](auto first, auto last){ sizes.push_back(last - first); }
+    );
+  BOOST_TEST(nClusters == 3U);
+  BOOST_TEST(sizes == (std::vector<std::size_t>{ 3U, 2U, 1U }),
+    boost::test_tools::per_element());
+
+  std::vector<Hit> const noHits;
+  BOOST_TEST(util::clusterSortedBy(noHits, hitTime, closeTimes).empty());
+  BOOST_TEST(util::forEachSortedCluster(noHits.begin(), noHits.end(),
+    hitTime, closeTimes, [](auto, auto){ BOOST_ERROR("Unexpected cluster"); })
+    == 0U);
+
+} // SortedClusteringTest()
+
+
+// -----------------------------------------------------------------------------
+void ClusterIndicesTest() {
+
+  std::mt19937 engine { 1234 };
+  std::uniform_real_distribution<double> uniform { 0.0, 1000.0 };
+
+  util::ClusterIndices<double> clusters;
+  for (unsigned int iSet = 0; iSet < 20U; ++iSet) {
+
+    std::vector<Hit> hits(iSet * 50U);
+    int id = 0;
+    for (Hit& hit: hits) hit = { uniform(engine), id++ };
+
+    std::size_t const nClusters = util::clusterIndicesBy
+      (hits, hitTime, closeTimes, std::less<double>{}, clusters);
+
+    auto const reference
+      = util::clusterBy(hits, hitTime, closeTimes, hitID, std::less<double>{});
+
+    BOOST_TEST(nClusters == reference.size());
+    BOOST_TEST(clusters.size() == reference.size());
+    BOOST_TEST(clusters.indices.size() == hits.size());
+    for (std::size_t iCluster = 0; iCluster < clusters.size(); ++iCluster) {
+      std::vector<int> cluster;
+      for (std::size_t const index: clusters.cluster(iCluster))
+        cluster.push_back(hits[index].id);
+      BOOST_TEST(clusters.clusterSize(iCluster) == cluster.size());
+      BOOST_TEST(cluster == reference[iCluster],
+        boost::test_tools::per_element());
+    } // for clusters
+
+  } // for sets
+
+  clusters.clear();
+  BOOST_TEST(clusters.empty());
+
+} // ClusterIndicesTest()
+
+
+// -----------------------------------------------------------------------------
+void ClusterIndicesTiesTest() {
+
+  // objects with the same key are sorted by index
+  std::vector<Hit> const hits
+    { { 5.0, 0 }, { 0.0, 1 }, { 5.0, 2 }, { 0.0, 3 }, { 9.0, 4 } };
+
+  util::ClusterIndices<double> clusters;
+  std::size_t const nClusters = util::clusterIndicesBy
+    (hits, hitTime, closeTimes, std::less<double>{}, clusters);
+
+  BOOST_TEST(nClusters == 3U);
+  BOOST_TEST(clusters.indices
+    == (std::vector<std::size_t>{ 1U, 3U, 0U, 2U, 4U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(clusters.offsets == (std::vector<std::size_t>{ 0U, 2U, 4U, 5U }),
+    boost::test_tools::per_element());
+
+} // ClusterIndicesTiesTest()
+
+
+// -----------------------------------------------------------------------------
+void AllocationTest() {
+
+  std::vector<Hit> const hits
+    { { 0.0, 0 }, { 1.0, 1 }, { 1.5, 2 }, { 3.0, 3 }, { 4.9, 4 }, { 10.0, 5 } };
+
+  util::ClusterIndices<double> clusters;
+  // the first clustering sizes the buffers
+  util::clusterIndicesBy
+    (hits, hitTime, closeTimes, std::less<double>{}, clusters);
+
+  // neither the sweep nor the clustering into the same buffers allocate
+  icarus::test::AllocationCounter allocations;
+  std::size_t const nSorted = util::forEachSortedCluster(
+    hits.begin(), hits.end(), hitTime, closeTimes, [](auto, auto){}
+    );
+  std::size_t const nIndexed = util::clusterIndicesBy
+    (hits, hitTime, closeTimes, std::less<double>{}, clusters);
+  std::size_t const nAllocations = allocations.allocations();
+
+  // the clustering into vectors, instead, allocates memory for each cluster
+  allocations.restart();
+  std::size_t const nClusters = util::clusterBy
+    (hits, hitTime, closeTimes, hitID, std::less<double>{}).size();
+  std::size_t const nVectorAllocations = allocations.allocations();
+
+  BOOST_TEST(nSorted == 3U);
+  BOOST_TEST(nIndexed == 3U);
+  BOOST_TEST(nAllocations == 0U);
+  BOOST_TEST(nClusters == 3U);
+  BOOST_TEST(nVectorAllocations >= nClusters);
+
+} // AllocationTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SimpleClusteringTestCase) {
+
+  SortedClusteringTest();
+  ClusterIndicesTest();
+  ClusterIndicesTiesTest();
+  AllocationTest();
+
+} // BOOST_AUTO_TEST_CASE(SimpleClusteringTestCase)
+
+
+// -----------------------------------------------------------------------------
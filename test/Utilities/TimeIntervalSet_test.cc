@@ -0,0 +1,123 @@
+/**
+ * @file   TimeIntervalSet_test.cc
+ * @brief  Unit test for `icarus::ns::util::TimeIntervalSet`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/TimeIntervalSet.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE TimeIntervalSetTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/TimeIntervalSet.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <vector>
+#include <cstdint> // std::uint8_t
+
+
+//------------------------------------------------------------------------------
+/// A minimal time type with a `value()`, like LArSoft time quantities.
+struct Tick {
+  double t;
+  explicit constexpr Tick(double t = 0.0): t{ t } {}
+  constexpr double value() const { return t; }
+};
+constexpr bool operator< (Tick a, Tick b) { return a.t < b.t; }
+constexpr bool operator>= (Tick a, Tick b) { return a.t >= b.t; }
+constexpr double operator- (Tick a, Tick b) { return a.t - b.t; }
+std::ostream& operator<< (std::ostream& out, Tick t) { return out << t.t; }
+
+
+//------------------------------------------------------------------------------
+void MergeTest() {
+  
+  using Interval_t = icarus::ns::util::TimeInterval<double>;
+  
+  icarus::ns::util::TimeIntervalSet<double> const set {
+      Interval_t{ 10.0, 12.0 }
+    , Interval_t{ -5.0, -1.0 }
+    , Interval_t{ 11.0, 15.0 } // overlapping
+    , Interval_t{ 15.0, 16.0 } // adjacent
+    , Interval_t{ 3.0, 3.0 }   // empty
+    , Interval_t{ 0.0, 1.0 }
+    };
+  std::cout << "Set: " << set << std::endl;
+  
+  BOOST_TEST(!set.empty());
+  BOOST_TEST(set.size() == 3U);
+  
+  std::vector<Interval_t> const intervals = set.intervals();
+  BOOST_TEST(intervals.size() == 3U);
+  BOOST_TEST(intervals[0].start == -5.0);
+  BOOST_TEST(intervals[0].stop == -1.0);
+  BOOST_TEST(intervals[1].start == 0.0);
+  BOOST_TEST(intervals[1].stop == 1.0);
+  BOOST_TEST(intervals[2].start == 10.0);
+  BOOST_TEST(intervals[2].stop == 16.0);
+  
+  BOOST_TEST(icarus::ns::util::TimeIntervalSet<double>{}.empty());
+  
+} // MergeTest()
+
+
+//------------------------------------------------------------------------------
+template <typename Time>
+void ContainsTest(unsigned int nIntervals) {
+  
+  /*
+   * Intervals [ 10k ; 10k + 3 [ for k = 0 ... nIntervals - 1;
+   * times are tested every 0.5 from -5 to beyond the last interval,
+   * one at a time and all together.
+   */
+  using Interval_t = icarus::ns::util::TimeInterval<Time>;
+  
+  std::vector<Interval_t> intervals;
+  for (unsigned int k = nIntervals; k-- > 0; ) // reversed
+    intervals.emplace_back(Time{ 10.0 * k }, Time{ 10.0 * k + 3.0 });
+  icarus::ns::util::TimeIntervalSet<Time> const set { intervals };
+  BOOST_TEST(set.size() == nIntervals);
+  
+  std::vector<Time> times;
+  std::vector<std::uint8_t> expected;
+  for (double t = -5.0; t < 10.0 * nIntervals + 5.0; t += 0.5) {
+    times.emplace_back(t);
+    bool inside = false;
+    for (Interval_t const& interval: intervals)
+      if (interval.contains(Time{ t })) inside = true;
+    expected.push_back(inside);
+  } // for
+  
+  std::vector<std::uint8_t> const mask = set.contains(times);
+  BOOST_TEST(mask.size() == times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    BOOST_TEST_CONTEXT("time: " << times[i]) {
+      BOOST_TEST(mask[i] == expected[i]);
+      BOOST_TEST(set.contains(times[i]) == (expected[i] != 0));
+    }
+  } // for
+  
+} // ContainsTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( TimeIntervalSetTestCase ) {
+  
+  MergeTest();
+  
+} // BOOST_AUTO_TEST_CASE( TimeIntervalSetTestCase )
+
+
+BOOST_AUTO_TEST_CASE( TimeIntervalSetSelectionTestCase ) {
+  
+  ContainsTest<double>(3U);  // scan of the intervals
+  ContainsTest<double>(20U); // binary search
+  ContainsTest<Tick>(3U);
+  ContainsTest<Tick>(20U);
+  
+} // BOOST_AUTO_TEST_CASE( TimeIntervalSetSelectionTestCase )
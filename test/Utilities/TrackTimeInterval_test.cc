@@ -32,6 +32,7 @@
 #include "larcorealg/Geometry/TPCGeo.h"
 #include "larcorealg/Geometry/PlaneGeo.h"
 #include "larcorealg/CoreUtils/counter.h"
+#include "larcorealg/CoreUtils/enumerate.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "larcorealg/TestUtils/boost_unit_test_base.h"
 #include "larcorealg/TestUtils/geometry_unit_test_base.h"
@@ -44,6 +45,7 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <memory> // std::shared_ptr<>
 #include <cmath> // std::abs()
 #include <cassert>
 
@@ -425,5 +427,132 @@ BOOST_AUTO_TEST_CASE(timeRangeOfHits_singleTPCset)
 } // BOOST_AUTO_TEST_CASE(PrintHitsOnAllPlanes)
 
 
+BOOST_AUTO_TEST_CASE(timeRangesOfHits_batch)
+{
+  /*
+   * Tracks of hits on many planes, processed one by one, with a workspace and
+   * all together, must all give the same result.
+   */
+  auto const& testEnv = TestFixture::Env();
+  auto const detClockData
+    = testEnv.Provider<detinfo::DetectorClocks>()->DataForJob();
+  detinfo::DetectorTimings const detTiming{ detClockData };
+  
+  geo::GeometryCore const& geom = *(testEnv.Provider<geo::GeometryCore>());
+  detinfo::DetectorPropertiesData detProp
+    = testEnv.Provider<detinfo::DetectorProperties>()->DataFor(detClockData);
+  
+  lar::util::TrackTimeInterval const chargeTime{ geom, detProp, detTiming };
+  
+  std::default_random_engine engine; // default seed, not that random
+  std::uniform_real_distribution<double> pickX{ -0.2, 1.2 };
+  
+  // one track per TPC, one per plane, and one through all planes
+  std::vector<std::vector<recob::Hit>> tracks;
+  std::vector<recob::Hit> allPlanes;
+  for (geo::TPCGeo const& TPC: geom.Iterate<geo::TPCGeo>()) {
+    
+    double const xC = TPC.GetCathodeCenter().X();
+    double const xA = TPC.FirstPlane().GetCenter().X();
+    
+    std::vector<recob::Hit> inTPC;
+    for (geo::PlaneGeo const& plane: TPC.IteratePlanes()) {
+      
+      geo::WireID const wireID{ plane.ID(), 10 };
+      raw::ChannelID_t const channel = geom.PlaneWireToChannel(wireID);
+      
+      std::vector<recob::Hit> onPlane;
+      for (int i = 0; i < 8; ++i) {
+        double const x = xA + (xC - xA) * pickX(engine);
+        onPlane.push_back(makeHitAt(
+          channel, detProp.ConvertXToTicks(x, plane.ID()),
+          plane.View(), geom.SignalType(channel), wireID
+          ));
+      } // for hits
+      
+      inTPC.insert(inTPC.end(), onPlane.begin(), onPlane.end());
+      allPlanes.push_back(onPlane.front());
+      tracks.push_back(std::move(onPlane));
+    } // for planes
+    tracks.push_back(std::move(inTPC));
+  } // for TPC
+  tracks.push_back(std::move(allPlanes));
+  tracks.emplace_back(); // and an empty one
+  
+  std::vector<lar::util::TrackTimeInterval::TimeRange> const batchRanges
+    = chargeTime.timeRangesOfHits(tracks);
+  BOOST_TEST(batchRanges.size() == tracks.size());
+  
+  lar::util::TrackTimeInterval::Workspace workspace;
+  for (auto const& [ iTrack, hits ]: util::enumerate(tracks)) {
+    BOOST_TEST_CONTEXT("track #" << iTrack) {
+      
+      lar::util::TrackTimeInterval::TimeRange const range
+        = chargeTime.timeRangeOfHits(hits);
+      lar::util::TrackTimeInterval::TimeRange const workspaceRange
+        = chargeTime.timeRangeOfHits(hits, workspace);
+      
+      BOOST_TEST(range.isValid() == !hits.empty());
+      BOOST_TEST(workspaceRange.start == range.start);
+      BOOST_TEST(workspaceRange.stop == range.stop);
+      BOOST_TEST(batchRanges[iTrack].start == range.start);
+      BOOST_TEST(batchRanges[iTrack].stop == range.stop);
+      
+    }
+  } // for tracks
+  
+  // the range of a single hit is the same as the range of the hit
+  for (recob::Hit const& hit: tracks.front()) {
+    lar::util::TrackTimeInterval::TimeRange const hitRange
+      = chargeTime.timeRange(hit);
+    lar::util::TrackTimeInterval::TimeRange const trackRange
+      = chargeTime.timeRangeOfHits(std::vector{ &hit }, workspace);
+    BOOST_TEST(trackRange.start == hitRange.start);
+    BOOST_TEST(trackRange.stop == hitRange.stop);
+  } // for
+  
+} // BOOST_AUTO_TEST_CASE(timeRangesOfHits_batch)
+
+
+BOOST_AUTO_TEST_CASE(TrackTimeIntervalMaker_cached)
+{
+  auto const& testEnv = TestFixture::Env();
+  auto const detClockData
+    = testEnv.Provider<detinfo::DetectorClocks>()->DataForJob();
+  detinfo::DetectorTimings const detTiming{ detClockData };
+  
+  geo::GeometryCore const& geom = *(testEnv.Provider<geo::GeometryCore>());
+  detinfo::DetectorPropertiesData detProp
+    = testEnv.Provider<detinfo::DetectorProperties>()->DataFor(detClockData);
+  
+  lar::util::TrackTimeIntervalMaker const trackTimeIntervalMaker{ geom };
+  
+  std::shared_ptr<lar::util::TrackTimeInterval const> const chargeTime
+    = trackTimeIntervalMaker.makeCached(detProp, detTiming);
+  BOOST_TEST_REQUIRE(chargeTime);
+  
+  // same timing: same object
+  BOOST_TEST
+    (trackTimeIntervalMaker.makeCached(detProp, detTiming) == chargeTime);
+  
+  // and the same results as a new one
+  lar::util::TrackTimeInterval const newChargeTime
+    = trackTimeIntervalMaker.make(detProp, detTiming);
+  
+  geo::PlaneID const planeID{ 0, 0, 0 };
+  for (double const tick: { 0.0, 850.0, 3000.0 }) {
+    BOOST_TEST_CONTEXT("tick: " << tick) {
+      lar::util::TrackTimeInterval::TimeRange const range
+        = chargeTime->timeRange(tick, planeID);
+      lar::util::TrackTimeInterval::TimeRange const newRange
+        = newChargeTime.timeRange(tick, planeID);
+      BOOST_TEST(range.start == newRange.start);
+      BOOST_TEST(range.stop == newRange.stop);
+    }
+  } // for
+  
+} // BOOST_AUTO_TEST_CASE(TrackTimeIntervalMaker_cached)
+
+
 
 // BOOST_AUTO_TEST_SUITE_END()
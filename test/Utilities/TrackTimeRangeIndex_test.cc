@@ -0,0 +1,151 @@
+/**
+ * @file   TrackTimeRangeIndex_test.cc
+ * @brief  Unit test for `lar::util::TrackTimeRangeIndex`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/TrackTimeRangeIndex.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE TrackTimeRangeIndexTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/TrackTimeRangeIndex.h"
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+using TimeRange = lar::util::TrackTimeInterval::TimeRange;
+using electronics_time = lar::util::TrackTimeInterval::electronics_time;
+using microseconds = lar::util::TrackTimeInterval::microseconds;
+
+
+/// Returns the tracks compatible with `time`, the old way.
+std::vector<std::size_t> bruteForceTracksAt(
+  std::vector<TimeRange> const& ranges, electronics_time time,
+  microseconds startMargin, microseconds stopMargin
+) {
+  std::vector<std::size_t> tracks;
+  for (std::size_t iTrack = 0; iTrack < ranges.size(); ++iTrack) {
+    if (ranges[iTrack].contains(time, startMargin, stopMargin))
+      tracks.push_back(iTrack);
+  }
+  return tracks;
+} // bruteForceTracksAt()
+
+
+//------------------------------------------------------------------------------
+void BasicTest() {
+
+  using namespace util::quantities::time_literals;
+
+  std::vector<TimeRange> const ranges {
+    TimeRange{ electronics_time{ 10.0 }, electronics_time{ 20.0 } },
+    TimeRange{ electronics_time{ 15.0 }, electronics_time{ 30.0 } },
+    TimeRange{}, // invalid: contains everything
+    TimeRange{ electronics_time{ 40.0 }, TimeRange::UndefinedTime },
+    TimeRange{ electronics_time{ 50.0 }, electronics_time{ 45.0 } }, // empty
+  };
+
+  lar::util::TrackTimeRangeIndex const index { ranges };
+  BOOST_TEST(index.size() == ranges.size());
+  BOOST_TEST(!index.empty());
+
+  using Tracks_t = std::vector<std::size_t>;
+  BOOST_TEST(index.tracksAt(electronics_time{ 5.0 }) == (Tracks_t{ 2 }));
+  BOOST_TEST(index.tracksAt(electronics_time{ 10.0 }) == (Tracks_t{ 0, 2 }));
+  BOOST_TEST(index.tracksAt(electronics_time{ 17.0 }) == (Tracks_t{ 0, 1, 2 }));
+  BOOST_TEST(index.tracksAt(electronics_time{ 20.0 }) == (Tracks_t{ 1, 2 }));
+  BOOST_TEST(index.tracksAt(electronics_time{ 1e9 }) == (Tracks_t{ 2, 3 }));
+
+  // with margins
+  lar::util::TrackTimeRangeIndex const wideIndex { ranges, 2_us, 5_us };
+  BOOST_TEST(wideIndex.tracksAt(electronics_time{ 8.0 }) == (Tracks_t{ 0, 2 }));
+  BOOST_TEST
+    (wideIndex.tracksAt(electronics_time{ 24.0 }) == (Tracks_t{ 0, 1, 2 }));
+
+  // batch
+  std::vector<electronics_time> const times {
+    electronics_time{ 20.0 }, electronics_time{ 5.0 }, electronics_time{ 17.0 }
+    };
+  std::vector<std::size_t> offsets, tracks;
+  index.tracksAt(times, offsets, tracks);
+  BOOST_TEST(offsets == (Tracks_t{ 0, 2, 3, 6 }));
+  BOOST_TEST(tracks == (Tracks_t{ 1, 2, 2, 0, 1, 2 }));
+
+  lar::util::TrackTimeRangeIndex const emptyIndex;
+  BOOST_TEST(emptyIndex.empty());
+  BOOST_TEST(emptyIndex.tracksAt(electronics_time{ 5.0 }).empty());
+  emptyIndex.tracksAt(times, offsets, tracks);
+  BOOST_TEST(offsets == (Tracks_t{ 0, 0, 0, 0 }));
+  BOOST_TEST(tracks.empty());
+
+} // BasicTest()
+
+
+//------------------------------------------------------------------------------
+void BruteForceComparisonTest() {
+
+  std::mt19937 engine { 2468 };
+  std::uniform_real_distribution<double> startDist { -1500.0, 2000.0 };
+  std::uniform_real_distribution<double> durationDist { 0.0, 1000.0 };
+  std::uniform_int_distribution<int> specialDist { 0, 40 };
+
+  std::vector<TimeRange> ranges;
+  for (unsigned int iTrack = 0; iTrack < 500U; ++iTrack) {
+    TimeRange range;
+    switch (specialDist(engine)) {
+      case 0: break; // invalid
+      case 1: range.start = electronics_time{ startDist(engine) }; break;
+      case 2: range.stop = electronics_time{ startDist(engine) }; break;
+      default:
+        range.start = electronics_time{ startDist(engine) };
+        range.stop = range.start + microseconds{ durationDist(engine) };
+    } // switch
+    ranges.push_back(range);
+  } // for
+
+  std::vector<electronics_time> times;
+  for (unsigned int iFlash = 0; iFlash < 300U; ++iFlash)
+    times.emplace_back(startDist(engine));
+  times.push_back(ranges[5].start); // exactly on boundaries
+  times.push_back(ranges[5].stop);
+
+  microseconds const startMargin { 3.0 }, stopMargin { 7.5 };
+  lar::util::TrackTimeRangeIndex const index
+    { ranges, startMargin, stopMargin };
+
+  std::vector<std::size_t> offsets, tracks;
+  index.tracksAt(times, offsets, tracks);
+  BOOST_TEST_REQUIRE(offsets.size() == times.size() + 1);
+
+  for (std::size_t iTime = 0; iTime < times.size(); ++iTime) {
+    std::vector<std::size_t> const expected
+      = bruteForceTracksAt(ranges, times[iTime], startMargin, stopMargin);
+    BOOST_TEST_CONTEXT("time #" << iTime << " (" << times[iTime] << ")") {
+      BOOST_TEST(index.tracksAt(times[iTime]) == expected,
+        boost::test_tools::per_element());
+      std::vector<std::size_t> const batch
+        (tracks.begin() + offsets[iTime], tracks.begin() + offsets[iTime + 1]);
+      BOOST_TEST(batch == expected, boost::test_tools::per_element());
+    } // context
+  } // for
+
+} // BruteForceComparisonTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TrackTimeRangeIndexTestCase) {
+
+  BasicTest();
+  BruteForceComparisonTest();
+
+} // BOOST_AUTO_TEST_CASE(TrackTimeRangeIndexTestCase)
+
+
+//------------------------------------------------------------------------------
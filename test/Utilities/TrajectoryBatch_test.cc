@@ -0,0 +1,157 @@
+/**
+ * @file   TrajectoryBatch_test.cc
+ * @brief  Unit test for `icarus::ns::util::TrajectoryBatch`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/TrajectoryBatch.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE TrajectoryBatchTest
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/TrajectoryBatch.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstdint> // std::uint8_t
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+/// A minimal point type, like `geo::Point_t`.
+struct Point {
+  double x, y, z;
+  double X() const { return x; }
+  double Y() const { return y; }
+  double Z() const { return z; }
+};
+
+/// A minimal box type, like `geo::BoxBoundedGeo`.
+struct Box {
+  Point min, max;
+  double MinX() const { return min.x; }
+  double MinY() const { return min.y; }
+  double MinZ() const { return min.z; }
+  double MaxX() const { return max.x; }
+  double MaxY() const { return max.y; }
+  double MaxZ() const { return max.z; }
+};
+
+
+//------------------------------------------------------------------------------
+void LengthTest() {
+
+  icarus::ns::util::TrajectoryBatch batch;
+  BOOST_TEST(batch.empty());
+
+  // a 3-4-5 triangle leg, a single point, an empty one, and a 3-segment line
+  std::vector<Point> const first { { 0.0, 0.0, 0.0 }, { 3.0, 4.0, 0.0 } };
+  BOOST_TEST(batch.add(first) == 0U);
+  BOOST_TEST(batch.add(std::vector<Point>{ { 7.0, 7.0, 7.0 } }) == 1U);
+  BOOST_TEST(batch.add(std::vector<Point>{}) == 2U);
+  BOOST_TEST(batch.add
+    (4U, [](std::size_t i){ return Point{ 0.0, 0.0, 2.0 * i }; }) == 3U
+    );
+
+  BOOST_TEST(batch.size() == 4U);
+  BOOST_TEST(batch.nPoints() == 7U);
+  BOOST_TEST(batch.nPoints(0) == 2U);
+  BOOST_TEST(batch.nPoints(1) == 1U);
+  BOOST_TEST(batch.nPoints(2) == 0U);
+  BOOST_TEST(batch.nPoints(3) == 4U);
+  BOOST_TEST(batch.firstPoint(3) == 3U);
+  BOOST_TEST(batch.z()[6] == 6.0);
+
+  std::vector<double> const lengths = batch.lengths();
+  BOOST_TEST(lengths.size() == 4U);
+  BOOST_TEST(lengths[0] == 5.0);
+  BOOST_TEST(lengths[1] == 0.0);
+  BOOST_TEST(lengths[2] == 0.0);
+  BOOST_TEST(lengths[3] == 6.0);
+
+  auto const directions = batch.startDirections();
+  BOOST_TEST(directions.size() == 4U);
+  BOOST_TEST(directions[0].x == 0.6);
+  BOOST_TEST(directions[0].y == 0.8);
+  BOOST_TEST(directions[0].z == 0.0);
+  BOOST_TEST(directions[1].x == 0.0);
+  BOOST_TEST(directions[1].y == 0.0);
+  BOOST_TEST(directions[1].z == 0.0);
+  BOOST_TEST(directions[3].z == 1.0);
+
+  // skipping points
+  batch.clear();
+  BOOST_TEST(batch.empty());
+  BOOST_TEST(batch.nPoints() == 0U);
+  batch.add(5U,
+    [](std::size_t i){ return Point{ 1.0 * i, 0.0, 0.0 }; },
+    [](std::size_t i){ return i != 2U; }
+    );
+  BOOST_TEST(batch.size() == 1U);
+  BOOST_TEST(batch.nPoints() == 4U);
+  BOOST_TEST(batch.lengths()[0] == 4.0);
+
+} // LengthTest()
+
+
+//------------------------------------------------------------------------------
+void ContainmentTest() {
+
+  std::vector<Box> const boxes {
+      { { 0.0, 0.0, 0.0 }, { 10.0, 10.0, 10.0 } }
+    , { { 20.0, 0.0, 0.0 }, { 30.0, 10.0, 10.0 } }
+    };
+  icarus::ns::util::BoxSet const volumes { boxes };
+  BOOST_TEST(volumes.size() == 2U);
+  BOOST_TEST(icarus::ns::util::BoxSet{}.empty());
+
+  BOOST_TEST( volumes.contains(5.0, 5.0, 5.0));
+  BOOST_TEST( volumes.contains(10.0, 10.0, 10.0)); // border is included
+  BOOST_TEST(!volumes.contains(15.0, 5.0, 5.0));
+  BOOST_TEST( volumes.contains(25.0, 5.0, 5.0));
+  BOOST_TEST(!volumes.contains(25.0, 5.0, 11.0));
+
+  // a line along x crossing both boxes and the gap between them
+  icarus::ns::util::TrajectoryBatch batch;
+  batch.add(33U, [](std::size_t i){ return Point{ 1.0 * i, 5.0, 5.0 }; });
+  batch.add(std::vector<Point>{ { -1.0, 5.0, 5.0 }, { 5.0, 5.0, 5.0 } });
+
+  std::vector<std::uint8_t> const mask = volumes.contains(batch);
+  BOOST_TEST(mask.size() == batch.nPoints());
+  for (std::size_t i = 0; i < 33U; ++i) {
+    BOOST_TEST_CONTEXT("point: " << i) {
+      BOOST_TEST(mask[i] == ((i <= 10U) || ((i >= 20U) && (i <= 30U))));
+    }
+  } // for
+  BOOST_TEST(mask[33] == 0);
+  BOOST_TEST(mask[34] == 1);
+
+  // the selected points are joined across the gap
+  icarus::ns::util::TrajectoryBatch const selected = batch.select(mask.data());
+  BOOST_TEST(selected.size() == 2U);
+  BOOST_TEST(selected.nPoints(0) == 22U);
+  BOOST_TEST(selected.nPoints(1) == 1U);
+  std::vector<double> const lengths = selected.lengths();
+  BOOST_TEST(lengths[0] == 30.0);
+  BOOST_TEST(lengths[1] == 0.0);
+
+} // ContainmentTest()
+
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+BOOST_AUTO_TEST_CASE( TrajectoryBatchTestCase ) {
+
+  LengthTest();
+
+} // BOOST_AUTO_TEST_CASE( TrajectoryBatchTestCase )
+
+
+BOOST_AUTO_TEST_CASE( BoxSetTestCase ) {
+
+  ContainmentTest();
+
+} // BOOST_AUTO_TEST_CASE( BoxSetTestCase )
@@ -0,0 +1,334 @@
+/**
+ * @file   assnscrosser_benchmark.cxx
+ * @brief  Compares the association joining engines of `AssnsCrosser`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/AssnsCrosser.h`
+ *
+ * Usage:
+ *
+ *     assnscrosser_benchmark [Keys [FanOut [Iterations [Threads]]]]
+ *
+ * A synthetic event (`testing::mockup::Event`) is generated with `Keys`
+ * objects of type `A` (default: 10000), each associated to `FanOut` (default:
+ * 4) objects of type `B`; each `B` is associated to `FanOut` objects of type
+ * `C` chosen at random (and therefore shared among different `B`), and each
+ * `C` to one object of type `D`. The associations are stored in random order.
+ *
+ * The associations `A` to `C` (two hops) and `A` to `D` (three hops) are
+ * joined `Iterations` times (default: 10) with:
+ * * the `art::Ptr`-based engine (`details::MapJoiner::joinForward()` followed
+ *   by the compaction into `details::FlatAssnsMap`);
+ * * the index-based engine (`details::IndexJoiner::join()`);
+ * * the complete `AssnsCrosser` construction (which picks the latter),
+ *   followed by the query of all the keys (two hops only);
+ * * the `art::Ptr`-based engine reading the associations with `Threads`
+ *   threads (default: `0`, as many as the hardware supports).
+ * 
+ * The complete `AssnsCrosser` is also run on tracks, clusters and hits from
+ * `testing::mockup::SyntheticEventGenerator`, with the configuration of a
+ * production-like event and one ten times larger (`production_x1` and
+ * `production_x10`); for these, the number of keys is the number of tracks.
+ * 
+ * After the benchmarks, the time spent in each hop by the last run of each
+ * engine is also printed.
+ *
+ * The results are printed on screen as comma-separated values, one line per
+ * benchmark, with a header line first. The columns are: the name of the
+ * benchmark, the number of keys, the fan-out, the number of associations read
+ * per iteration, the number of iterations, the total time [s], the processing
+ * rate (associations per second) and the number of joined targets (which must
+ * be the same for all the engines with the same number of hops).
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Utilities/AssnsCrosser.h"
+#include "test/FrameworkEventMockup.h"
+#include "test/SyntheticEventGenerator.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm> // std::shuffle()
+#include <optional>
+#include <vector>
+#include <string>
+#include <utility> // std::pair, std::move()
+#include <cstdlib> // std::atol()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  struct DataA { std::size_t ID; };
+  struct DataB { std::size_t ID; };
+  struct DataC { std::size_t ID; };
+  struct DataD { std::size_t ID; };
+
+  struct Track {};
+  struct Cluster {};
+  struct Hit {};
+
+
+  /// Stores into `event` shuffled associations with the specified `pairs`.
+  template <typename L, typename R>
+  std::size_t putAssns(
+    testing::mockup::Event& event, art::InputTag const& leftTag,
+    art::InputTag const& rightTag, art::InputTag const& assnsTag,
+    std::vector<std::pair<std::size_t, std::size_t>> pairs,
+    std::mt19937& engine
+  ) {
+    testing::mockup::PtrMaker<L> makeLeftPtr { event, leftTag };
+    testing::mockup::PtrMaker<R> makeRightPtr { event, rightTag };
+    std::shuffle(pairs.begin(), pairs.end(), engine);
+    art::Assns<L, R> assns;
+    for (auto const& [ left, right ]: pairs)
+      assns.addSingle(makeLeftPtr(left), makeRightPtr(right));
+    event.put(std::move(assns), assnsTag);
+    return pairs.size();
+  } // putAssns()
+
+
+  /// Returns a synthetic event, and the number of associations in each hop.
+  std::pair<testing::mockup::Event, std::vector<std::size_t>> makeEvent
+    (std::size_t nKeys, std::size_t fanOut)
+  {
+    std::mt19937 engine { 24680 };
+
+    std::size_t const nB = nKeys * fanOut;
+    std::size_t const nC = nB;
+    std::size_t const nD = nC;
+    std::uniform_int_distribution<std::size_t> pickC { 0, nC - 1 };
+
+    testing::mockup::Event event;
+    event.put(std::vector<DataA>(nKeys), art::InputTag{ "A" });
+    event.put(std::vector<DataB>(nB), art::InputTag{ "B" });
+    event.put(std::vector<DataC>(nC), art::InputTag{ "C" });
+    event.put(std::vector<DataD>(nD), art::InputTag{ "D" });
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+    std::vector<std::size_t> nAssns;
+
+    // each A has its own set of B
+    for (std::size_t iA = 0; iA < nKeys; ++iA)
+      for (std::size_t i = 0; i < fanOut; ++i)
+        pairs.emplace_back(iA, iA * fanOut + i);
+    nAssns.push_back(putAssns<DataA, DataB>
+      (event, "A", "B", "B", std::move(pairs), engine));
+
+    // each B has random C, shared among B
+    pairs.clear();
+    for (std::size_t iB = 0; iB < nB; ++iB)
+      for (std::size_t i = 0; i < fanOut; ++i)
+        pairs.emplace_back(iB, pickC(engine));
+    nAssns.push_back(putAssns<DataB, DataC>
+      (event, "B", "C", "C", std::move(pairs), engine));
+
+    // each C has one D
+    pairs.clear();
+    for (std::size_t iC = 0; iC < nC; ++iC) pairs.emplace_back(iC, nD - 1 - iC);
+    nAssns.push_back(putAssns<DataC, DataD>
+      (event, "C", "D", "D", std::move(pairs), engine));
+
+    return { std::move(event), std::move(nAssns) };
+  } // makeEvent()
+
+
+  /// Runs `algo()` `nIterations` times, and prints the results.
+  template <typename Algo>
+  void benchmark(
+    std::string const& name, std::size_t nKeys, std::size_t fanOut,
+    std::size_t nAssns, unsigned int nIterations, Algo algo
+  ) {
+
+    std::size_t const nTargets = algo(); // warm up
+
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nIterations; ++i) algo();
+    std::chrono::duration<double> const elapsed
+      = std::chrono::steady_clock::now() - start;
+
+    std::cout << name
+      << "," << nKeys
+      << "," << fanOut
+      << "," << nAssns
+      << "," << nIterations
+      << "," << elapsed.count()
+      << "," << (nAssns * nIterations / elapsed.count())
+      << "," << nTargets
+      << std::endl;
+
+  } // benchmark()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  using namespace icarus::ns::util;
+
+  long int const nKeys = (argc > 1)? std::atol(argv[1]): 10000;
+  long int const fanOut = (argc > 2)? std::atol(argv[2]): 4;
+  long int const nIterations = (argc > 3)? std::atol(argv[3]): 10;
+  long int const nThreads = (argc > 4)? std::atol(argv[4]): 0;
+  if ((nKeys <= 0) || (fanOut <= 0) || (nIterations <= 0) || (nThreads < 0))
+  {
+    std::cerr << "Usage:  " << argv[0]
+      << "  [Keys [FanOut [Iterations [Threads]]]]" << std::endl;
+    return 1;
+  }
+
+  auto const [ event, nAssns ] = makeEvent(nKeys, fanOut);
+  std::size_t const nAssns2 = nAssns[0] + nAssns[1];
+  std::size_t const nAssns3 = nAssns2 + nAssns[2];
+
+  using NoSelector_t = std::optional<details::PointerSelector<DataA>>;
+
+  std::cout << "benchmark,keys,fanout,associations,iterations,time_s"
+    ",rate_per_s,targets"
+    << std::endl;
+
+  //
+  // two hops
+  //
+  benchmark("2hops_pointers", nKeys, fanOut, nAssns2, nIterations,
+    [&event=event]()
+    {
+      details::FlatAssnsMap<DataA, DataC> const map {
+        details::MapJoiner<DataA, DataB, DataC>::joinForward
+          (event, "B", "C", NoSelector_t{})
+        };
+      return map.nTargets();
+    });
+
+  benchmark("2hops_indices", nKeys, fanOut, nAssns2, nIterations,
+    [&event=event]()
+    {
+      auto const map = details::IndexJoiner<DataA, DataB, DataC>::join
+        (event, "B", "C", NoSelector_t{});
+      return map? map->nTargets(): 0U;
+    });
+
+  testing::mockup::PtrMaker<DataA> const makeAptr { event, "A" };
+  benchmark("2hops_AssnsCrosser", nKeys, fanOut, nAssns2, nIterations,
+    [&event=event,&makeAptr,nKeys]()
+    {
+      AssnsCrosser<DataA, DataB, DataC> const AtoC { event, "B", "C" };
+      std::size_t nTargets = 0;
+      for (long int iA = 0; iA < nKeys; ++iA)
+        nTargets += AtoC.assPtrs(makeAptr(iA)).size();
+      return nTargets;
+    });
+
+  //
+  // three hops
+  //
+  benchmark("3hops_pointers", nKeys, fanOut, nAssns3, nIterations,
+    [&event=event]()
+    {
+      details::FlatAssnsMap<DataA, DataD> const map {
+        details::MapJoiner<DataA, DataB, DataC, DataD>::joinForward
+          (event, "B", "C", "D", NoSelector_t{})
+        };
+      return map.nTargets();
+    });
+
+  benchmark("3hops_indices", nKeys, fanOut, nAssns3, nIterations,
+    [&event=event]()
+    {
+      auto const map = details::IndexJoiner<DataA, DataB, DataC, DataD>::join
+        (event, "B", "C", "D", NoSelector_t{});
+      return map? map->nTargets(): 0U;
+    });
+
+  benchmark("3hops_pointers_threads", nKeys, fanOut, nAssns3, nIterations,
+    [&event=event,nThreads]()
+    {
+      details::FlatAssnsMap<DataA, DataD> const map {
+        details::MapJoiner<DataA, DataB, DataC, DataD>::joinForward(
+          event, "B", "C", "D", NoSelector_t{},
+          AssnsCrosserOptions{ static_cast<unsigned int>(nThreads) }
+          )
+        };
+      return map.nTargets();
+    });
+  
+  //
+  // production-like events: tracks to hits via clusters
+  //
+  using Generator_t
+    = testing::mockup::SyntheticEventGenerator<Track, Cluster, Hit>;
+  for (double const scale: { 1.0, 10.0 }) {
+    Generator_t::Config_t config
+      = Generator_t::Config_t::production().scaled(scale);
+    config.waveformsPerChannel = 0U; // optical waveforms are not needed here
+    testing::mockup::Event const prodEvent = Generator_t{ config }();
+
+    auto const& trackClusters = prodEvent.getProduct
+      <art::Assns<Track, Cluster>>(Generator_t::TrackTag);
+    auto const& clusterHits = prodEvent.getProduct
+      <art::Assns<Cluster, Hit>>(Generator_t::ClusterTag);
+    std::size_t const nProdAssns = trackClusters.size() + clusterHits.size();
+    testing::mockup::PtrMaker<Track> const makeTrackPtr
+      { prodEvent, Generator_t::TrackTag };
+    std::size_t const nTracks = config.nTracks;
+
+    benchmark("production_x" + std::to_string(static_cast<int>(scale)),
+      nTracks, config.clustersPerTrack, nProdAssns, nIterations,
+      [&prodEvent,&makeTrackPtr,nTracks]()
+      {
+        AssnsCrosser<Track, Cluster, Hit> const trackToHits
+          { prodEvent, Generator_t::TrackTag, Generator_t::ClusterTag };
+        std::size_t nTargets = 0;
+        for (std::size_t iTrack = 0; iTrack < nTracks; ++iTrack)
+          nTargets += trackToHits.assPtrs(makeTrackPtr(iTrack)).size();
+        return nTargets;
+      });
+  } // for scales
+
+  //
+  // time spent in each hop
+  //
+  std::vector<AssnsCrosserHopTiming> pointerTiming, indexTiming;
+  details::MapJoiner<DataA, DataB, DataC, DataD>::joinForward(
+    event, "B", "C", "D", NoSelector_t{},
+    AssnsCrosserOptions{ static_cast<unsigned int>(nThreads), &pointerTiming }
+    );
+  details::IndexJoiner<DataA, DataB, DataC, DataD>::join(
+    event, "B", "C", "D", NoSelector_t{},
+    AssnsCrosserOptions{ static_cast<unsigned int>(nThreads), &indexTiming }
+    );
+  
+  std::cout << "\nengine,left,right,products,associations"
+    ",read_s,merge_s,join_s,total_s"
+    << std::endl;
+  for (auto const& [ engine, timing ]: {
+    std::pair{ "pointers", &pointerTiming },
+    std::pair{ "indices", &indexTiming }
+  }) {
+    for (AssnsCrosserHopTiming const& hop: *timing) {
+      std::cout << engine
+        << "," << hop.left
+        << "," << hop.right
+        << "," << hop.nProducts
+        << "," << hop.nAssns
+        << "," << hop.readTime
+        << "," << hop.mergeTime
+        << "," << hop.joinTime
+        << "," << hop.totalTime()
+        << std::endl;
+    } // for hops
+  } // for engines
+  
+  return 0;
+} // main()
@@ -0,0 +1,223 @@
+/**
+ * @file   fastgauss_benchmark.cxx
+ * @brief  Accuracy and speed of `util::FastAndPoorGauss` versus table size.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/FastAndPoorGauss.h`
+ *
+ * Usage:
+ *
+ *     fastgauss_benchmark [Samples [Iterations]]
+ *
+ * Gaussian numbers are generated in batches of `Samples` (default: 4194304)
+ * values, `Iterations` times (default: 5), after a warm up batch, with:
+ * * `util::DynamicFastAndPoorGauss` (the same table as
+ *   `util::FastAndPoorGauss`) for tables of 2^8^ to 2^20^ points, both in
+ *   single (`float`) and double precision; the uniform numbers are generated
+ *   with `CLHEP::MixMaxRng::flatArray()` and then transformed in batch;
+ * * `CLHEP::RandGauss::shootArray()` on the same `CLHEP::MixMaxRng` engine;
+ * * `std::normal_distribution` on a `std::mt19937_64` engine, in single and
+ *   double precision.
+ *
+ * The results are printed on screen as comma-separated values, one line per
+ * benchmark, with a header line first. The columns are:
+ * * `sampler`, `type`, `points`: the algorithm, its precision and the number
+ *   of points in its table;
+ * * `table_bytes`: the size of the table [bytes];
+ * * `rate_per_s`: number of Gaussian values per second, including the
+ *   generation of the uniform numbers;
+ * * `transform_rate_per_s`: number of values per second transformed from
+ *   already generated uniform numbers (tables only);
+ * * `mean`, `stddev_dev`, `skewness`, `kurtosis_excess`: the moments of the
+ *   distribution of the table, compared to a standard normal distribution
+ *   (all should be `0`; `stddev_dev` is the standard deviation minus `1`);
+ * * `max_abs`: the largest value the table can return;
+ * * `tail3_dev`, `tail4_dev`, `tail5_dev`: relative deviation of the
+ *   probability of a value beyond 3, 4 and 5 standard deviations (in absolute
+ *   value) from the one of a normal distribution; `-1` means that the table
+ *   never returns such values.
+ *
+ * The accuracy figures are exact properties of the tables (each table entry
+ * is returned with the same probability), and they are left empty for the
+ * reference generators.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Utilities/FastAndPoorGauss.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/MixMaxRng.h"
+#include "CLHEP/Random/RandGauss.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm> // std::max()
+#include <vector>
+#include <string>
+#include <cmath> // std::sqrt(), std::erfc(), std::abs()
+#include <cstdlib> // std::atol()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Name of the data type `T`.
+  template <typename T>
+  char const* typeName() { return (sizeof(T) == 4)? "float": "double"; }
+
+
+  /// Runs `generate()` `nIterations` times and returns the rate [1/s].
+  template <typename Generate>
+  double timeRate
+    (std::size_t nSamples, unsigned int nIterations, Generate generate)
+  {
+    std::chrono::duration<double> elapsed { 0.0 };
+    for (unsigned int i = 0; i <= nIterations; ++i) { // first is warm up
+      auto const start = std::chrono::steady_clock::now();
+      generate();
+      if (i > 0) elapsed += std::chrono::steady_clock::now() - start;
+    } // for
+    return nSamples * nIterations / elapsed.count();
+  } // timeRate()
+
+
+  /// Prints the accuracy columns of the distribution of the `table`.
+  template <typename T>
+  void printTableAccuracy(T const* table, std::size_t nPoints) {
+
+    double sum = 0.0, sum2 = 0.0, sum3 = 0.0, sum4 = 0.0, maxAbs = 0.0;
+    std::size_t nBeyond[3] = { 0U, 0U, 0U };
+    for (std::size_t i = 0; i < nPoints; ++i) {
+      double const z = table[i];
+      double const z2 = z * z;
+      sum += z;
+      sum2 += z2;
+      sum3 += z2 * z;
+      sum4 += z2 * z2;
+      maxAbs = std::max(maxAbs, std::abs(z));
+      for (unsigned int k = 0; k < 3; ++k)
+        if (std::abs(z) > k + 3.0) ++nBeyond[k];
+    } // for
+
+    // moments around 0 are close enough to the central ones here
+    double const mean = sum / nPoints;
+    double const variance = sum2 / nPoints - mean * mean;
+    double const stddev = std::sqrt(variance);
+    std::cout
+      << "," << mean
+      << "," << (stddev - 1.0)
+      << "," << (sum3 / nPoints / (variance * stddev))
+      << "," << (sum4 / nPoints / (variance * variance) - 3.0)
+      << "," << maxAbs
+      ;
+    for (unsigned int k = 0; k < 3; ++k) {
+      double const expected = std::erfc((k + 3.0) / std::sqrt(2.0));
+      std::cout << "," << (double(nBeyond[k]) / nPoints / expected - 1.0);
+    }
+
+  } // printTableAccuracy()
+
+
+  /// Benchmarks a table of `nPoints` points with data type `T`.
+  template <typename T>
+  void benchmarkTable(
+    std::size_t nPoints, std::size_t nSamples, unsigned int nIterations,
+    CLHEP::HepRandomEngine& engine
+  ) {
+
+    util::DynamicFastAndPoorGauss<T> const gauss { nPoints };
+
+    std::vector<double> u(nSamples);
+    std::vector<T> z(nSamples);
+
+    double const rate = timeRate(nSamples, nIterations, [&]()
+      {
+        engine.flatArray(nSamples, u.data());
+        gauss.transform(u, z);
+      });
+    double const transformRate = timeRate(nSamples, nIterations,
+      [&](){ gauss.transform(u, z); });
+
+    std::cout << "FastAndPoorGauss," << typeName<T>()
+      << "," << nPoints
+      << "," << (nPoints * sizeof(T))
+      << "," << rate
+      << "," << transformRate
+      ;
+    printTableAccuracy(gauss.table(), nPoints);
+    std::cout << std::endl;
+
+  } // benchmarkTable()
+
+
+  /// Prints the line of a reference generator (no accuracy information).
+  void printReference(char const* name, char const* type, double rate) {
+    std::cout << name << "," << type << ",,," << rate << ",,,,,,,,,"
+      << std::endl;
+  } // printReference()
+
+
+  /// Benchmarks `std::normal_distribution` with data type `T`.
+  template <typename T>
+  void benchmarkStd(std::size_t nSamples, unsigned int nIterations) {
+
+    std::mt19937_64 engine { 24680 };
+    std::normal_distribution<T> gauss;
+    std::vector<T> z(nSamples);
+
+    double const rate = timeRate(nSamples, nIterations,
+      [&](){ for (T& value: z) value = gauss(engine); });
+
+    printReference("std::normal_distribution", typeName<T>(), rate);
+
+  } // benchmarkStd()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  constexpr unsigned int MinPowerOf2 = 8U;
+  constexpr unsigned int MaxPowerOf2 = 20U;
+
+  long int const nSamples = (argc > 1)? std::atol(argv[1]): (1L << 22);
+  long int const nIterations = (argc > 2)? std::atol(argv[2]): 5;
+  if ((nSamples <= 0) || (nIterations <= 0)) {
+    std::cerr << "Usage:  " << argv[0] << "  [Samples [Iterations]]"
+      << std::endl;
+    return 1;
+  }
+
+  CLHEP::MixMaxRng engine { 13579 };
+
+  std::cout << "sampler,type,points,table_bytes,rate_per_s"
+    ",transform_rate_per_s,mean,stddev_dev,skewness,kurtosis_excess,max_abs"
+    ",tail3_dev,tail4_dev,tail5_dev"
+    << std::endl;
+
+  for (unsigned int p = MinPowerOf2; p <= MaxPowerOf2; ++p)
+    benchmarkTable<float>(1UL << p, nSamples, nIterations, engine);
+  for (unsigned int p = MinPowerOf2; p <= MaxPowerOf2; ++p)
+    benchmarkTable<double>(1UL << p, nSamples, nIterations, engine);
+
+  //
+  // reference generators
+  //
+  std::vector<double> z(nSamples);
+  printReference("CLHEP::RandGauss", "double", timeRate(nSamples, nIterations,
+    [&]()
+      {
+        CLHEP::RandGauss::shootArray
+          (&engine, static_cast<int>(nSamples), z.data());
+      }
+    ));
+  benchmarkStd<float>(nSamples, nIterations);
+  benchmarkStd<double>(nSamples, nIterations);
+
+  return 0;
+} // main()
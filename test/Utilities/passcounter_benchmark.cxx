@@ -0,0 +1,117 @@
+/**
+ * @file   passcounter_benchmark.cxx
+ * @brief  Compares thread-safe pass counters under contention.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/AtomicPassCounter.h`,
+ *         `icarusalg/Utilities/ShardedPassCounter.h`
+ *
+ * Usage:
+ *
+ *     passcounter_benchmark [Events [MaxThreads]]
+ *
+ * Each of 1, 2, 4, ... up to `MaxThreads` threads (default: 64) registers
+ * `Events` events (default: 1000000) into the same counter, one in three
+ * passing, with:
+ * * `icarus::ns::util::AtomicPassCounter` (two atomic counters in the same
+ *   cache line);
+ * * `icarus::ns::util::ShardedPassCounter` (one cache line per thread);
+ * * `icarus::ns::util::PassCounter` protected by a mutex, as reference.
+ *
+ * The results are printed on screen as comma-separated values, one line per
+ * benchmark, with a header line first. The columns are: the name of the
+ * benchmark, the number of threads, the number of events per thread, the
+ * total time [s], the registration rate (events per second, all threads
+ * together) and whether the final counts are correct.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Utilities/AtomicPassCounter.h"
+#include "icarusalg/Utilities/ShardedPassCounter.h"
+#include "icarusalg/Utilities/PassCounter.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <cstdlib> // std::atol()
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// `PassCounter` with a lock around each registration.
+  struct LockedPassCounter: icarus::ns::util::PassCounter<unsigned long int> {
+    std::mutex lock;
+    void add(bool pass)
+      {
+        std::lock_guard lg { lock };
+        icarus::ns::util::PassCounter<unsigned long int>::add(pass);
+      }
+  }; // LockedPassCounter
+
+
+  /// Has `nThreads` threads add `nEvents` each to a new `Counter`.
+  template <typename Counter>
+  void benchmark
+    (std::string const& name, unsigned int nThreads, unsigned long int nEvents)
+  {
+    Counter counter;
+
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+      threads.emplace_back([&counter,nEvents]()
+        {
+          for (unsigned long int i = 0; i < nEvents; ++i)
+            counter.add(i % 3 == 0);
+        });
+    } // for
+    for (std::thread& thread: threads) thread.join();
+    std::chrono::duration<double> const elapsed
+      = std::chrono::steady_clock::now() - start;
+
+    bool const correct = (counter.total() == nThreads * nEvents)
+      && (counter.passed() == nThreads * ((nEvents + 2U) / 3U));
+
+    std::cout << name
+      << "," << nThreads
+      << "," << nEvents
+      << "," << elapsed.count()
+      << "," << (nThreads * nEvents / elapsed.count())
+      << "," << (correct? "yes": "no")
+      << std::endl;
+
+  } // benchmark()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  long int const nEvents = (argc > 1)? std::atol(argv[1]): 1000000;
+  long int const maxThreads = (argc > 2)? std::atol(argv[2]): 64;
+  if ((nEvents <= 0) || (maxThreads <= 0)) {
+    std::cerr << "Usage:  " << argv[0] << "  [Events [MaxThreads]]"
+      << std::endl;
+    return 1;
+  }
+
+  std::cout << "benchmark,threads,events,time_s,rate_per_s,correct"
+    << std::endl;
+
+  for (unsigned int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    benchmark<icarus::ns::util::AtomicPassCounter<unsigned long int>>
+      ("AtomicPassCounter", nThreads, nEvents);
+    benchmark<icarus::ns::util::ShardedPassCounter<unsigned long int>>
+      ("ShardedPassCounter", nThreads, nEvents);
+    benchmark<LockedPassCounter>("PassCounter_mutex", nThreads, nEvents);
+  } // for
+
+  return 0;
+} // main()
@@ -0,0 +1,140 @@
+/**
+ * @file   runConcurrently_test.cc
+ * @brief  Unit test for `icarus::ns::util::runConcurrently()`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/runConcurrently.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE runConcurrently
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/Utilities/runConcurrently.h"
+
+// C/C++ standard libraries
+#include <atomic>
+#include <stdexcept> // std::runtime_error
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+void allTasksTest() {
+
+  for (std::size_t const nTasks: { 0U, 1U, 2U, 100U }) {
+    for (unsigned int const nThreads: { 1U, 3U, 0U }) {
+      BOOST_TEST_CONTEXT("tasks: " << nTasks << ", threads: " << nThreads) {
+
+        std::vector<std::atomic<unsigned int>> runs(nTasks);
+        for (auto& count: runs) count = 0U;
+        icarus::ns::util::runConcurrently
+          (nTasks, nThreads, [&runs](std::size_t iTask){ ++runs[iTask]; });
+
+        for (std::size_t iTask = 0; iTask < nTasks; ++iTask)
+          BOOST_TEST(runs[iTask] == 1U);
+
+      } // context
+    } // for threads
+  } // for tasks
+
+} // allTasksTest()
+
+
+//------------------------------------------------------------------------------
+void workerIndexTest() {
+
+  constexpr std::size_t NTasks = 200U;
+  constexpr unsigned int NThreads = 4U;
+
+  std::thread::id const callerID = std::this_thread::get_id();
+  std::vector<unsigned int> workers(NTasks, NThreads);
+  std::vector<std::thread::id> threads(NTasks);
+  icarus::ns::util::runConcurrently(NTasks, NThreads,
+    [&workers,&threads](std::size_t iTask, unsigned int iWorker)
+    {
+      workers[iTask] = iWorker;
+      threads[iTask] = std::this_thread::get_id();
+    });
+
+  for (std::size_t iTask = 0; iTask < NTasks; ++iTask) {
+    BOOST_TEST_CONTEXT("task #" << iTask) {
+      BOOST_TEST(workers[iTask] < NThreads);
+      BOOST_TEST((threads[iTask] == callerID) == (workers[iTask] == 0U));
+    }
+  } // for
+
+  // with a single worker, everything happens in the calling thread
+  icarus::ns::util::runConcurrently(NTasks, 1U,
+    [&workers,&threads](std::size_t iTask, unsigned int iWorker)
+    {
+      workers[iTask] = iWorker;
+      threads[iTask] = std::this_thread::get_id();
+    });
+  for (std::size_t iTask = 0; iTask < NTasks; ++iTask) {
+    BOOST_TEST_CONTEXT("task #" << iTask) {
+      BOOST_TEST(workers[iTask] == 0U);
+      BOOST_TEST((threads[iTask] == callerID));
+    }
+  } // for
+
+} // workerIndexTest()
+
+
+//------------------------------------------------------------------------------
+void exceptionTest() {
+
+  constexpr std::size_t NTasks = 100U;
+
+  auto const failingTask = [](std::atomic<unsigned int>& nRuns)
+    {
+      return [&nRuns](std::size_t iTask)
+        {
+          if ((iTask == 42U) || (iTask == 7U))
+            throw std::runtime_error{ std::to_string(iTask) };
+          ++nRuns;
+        };
+    };
+
+  // the exception from the task with the lowest index is rethrown,
+  // after all the other tasks are done
+  for (unsigned int const nThreads: { 4U, 0U }) {
+    BOOST_TEST_CONTEXT("threads: " << nThreads) {
+      std::atomic<unsigned int> nRuns { 0U };
+      std::string message;
+      try {
+        icarus::ns::util::runConcurrently
+          (NTasks, nThreads, failingTask(nRuns));
+      }
+      catch (std::runtime_error const& e) { message = e.what(); }
+      BOOST_TEST(message == "7");
+      if (nThreads > 2U) BOOST_TEST(nRuns == NTasks - 2U);
+    }
+  } // for
+
+  // with a single thread, the first exception stops everything
+  std::atomic<unsigned int> nRuns { 0U };
+  BOOST_CHECK_THROW(
+    icarus::ns::util::runConcurrently(NTasks, 1U, failingTask(nRuns)),
+    std::runtime_error
+    );
+  BOOST_TEST(nRuns == 7U);
+
+} // exceptionTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( AllTasksTestCase ) {
+  allTasksTest();
+} // BOOST_AUTO_TEST_CASE( AllTasksTestCase )
+
+BOOST_AUTO_TEST_CASE( WorkerIndexTestCase ) {
+  workerIndexTest();
+} // BOOST_AUTO_TEST_CASE( WorkerIndexTestCase )
+
+BOOST_AUTO_TEST_CASE( ExceptionTestCase ) {
+  exceptionTest();
+} // BOOST_AUTO_TEST_CASE( ExceptionTestCase )
@@ -0,0 +1,175 @@
+/**
+ * @file   sortLike_benchmark.cxx
+ * @brief  Compares the sorting algorithms of `sortLike()`.
+ * @date   October 14, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/Utilities/sortLike.h`, `icarusalg/Utilities/sortBy.h`
+ *
+ * Usage:
+ *
+ *     sortLike_benchmark [Size [Iterations]]
+ *
+ * A collection of `Size` objects (default: 1000000) of a small structure
+ * (`Data`, 40 bytes) and a collection of as many random `float` keys are
+ * generated. The data is then sorted `Iterations` times (default: 5), each
+ * time from the same unsorted copy, with:
+ * * the swapping algorithm (`util::details::sortLikeBySwapping()`, the one
+ *   used by `util::sortLike()` for non-random-access iterators);
+ * * `util::sortLike()` (sorting a permutation of indices and applying it);
+ * * `util::sortLike()` with `std::execution::par` policy;
+ * * `std::sort()` comparing a key computed from each element, as reference;
+ * * `util::sortCollInPlaceBy()` with the same key (computed once per element).
+ *
+ * The results are printed on screen as comma-separated values, one line per
+ * benchmark, with a header line first. The columns are: the name of the
+ * benchmark, the size of the collection, the number of iterations, the total
+ * time [s], the sorting rate (elements per second) and whether the result
+ * is correctly sorted.
+ *
+ */
+
+// ICARUS libraries
+#include "icarusalg/Utilities/sortLike.h"
+#include "icarusalg/Utilities/sortBy.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm> // std::sort(), std::is_sorted()
+#include <execution> // std::execution::par
+#include <vector>
+#include <string>
+#include <cmath> // std::sin()
+#include <cstdlib> // std::atol()
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  struct Data {
+    double pos[4];
+    float key;
+    int ID;
+  };
+
+
+  /// A key which is not trivial to compute.
+  float computeKey(Data const& data)
+    { return std::sin(data.pos[0]) * data.pos[1] + data.pos[2] * data.pos[3]; }
+
+
+  /// Runs `algo(data)` on a copy of `unsorted`, `nIterations` times.
+  template <typename Algo, typename Check>
+  void benchmark(
+    std::string const& name, std::vector<Data> const& unsorted,
+    unsigned int nIterations, Algo algo, Check isSorted
+  ) {
+
+    std::vector<Data> data;
+    std::chrono::duration<double> elapsed { 0.0 };
+    for (unsigned int i = 0; i <= nIterations; ++i) { // first is warm up
+      data = unsorted;
+      auto const start = std::chrono::steady_clock::now();
+      algo(data);
+      if (i > 0) elapsed += std::chrono::steady_clock::now() - start;
+    } // for
+
+    std::cout << name
+      << "," << unsorted.size()
+      << "," << nIterations
+      << "," << elapsed.count()
+      << "," << (unsorted.size() * nIterations / elapsed.count())
+      << "," << (isSorted(data)? "yes": "no")
+      << std::endl;
+
+  } // benchmark()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  long int const size = (argc > 1)? std::atol(argv[1]): 1000000;
+  long int const nIterations = (argc > 2)? std::atol(argv[2]): 5;
+  if ((size <= 0) || (nIterations <= 0)) {
+    std::cerr << "Usage:  " << argv[0] << "  [Size [Iterations]]" << std::endl;
+    return 1;
+  }
+
+  std::mt19937 engine { 13579 };
+  std::uniform_real_distribution<double> flat { -10.0, 10.0 };
+
+  std::vector<Data> unsorted(size);
+  std::vector<float> keys(size);
+  for (long int i = 0; i < size; ++i) {
+    Data& data = unsorted[i];
+    for (double& x: data.pos) x = flat(engine);
+    data.key = static_cast<float>(flat(engine));
+    data.ID = i;
+    keys[i] = data.key;
+  } // for
+
+  auto const isSortedByStoredKey = [](std::vector<Data> const& data)
+    {
+      return std::is_sorted(data.begin(), data.end(),
+        [](Data const& a, Data const& b){ return a.key < b.key; });
+    };
+  auto const isSortedByComputedKey = [](std::vector<Data> const& data)
+    {
+      return std::is_sorted(data.begin(), data.end(),
+        [](Data const& a, Data const& b)
+          { return computeKey(a) < computeKey(b); }
+        );
+    };
+
+  std::cout << "benchmark,size,iterations,time_s,rate_per_s,sorted"
+    << std::endl;
+
+  //
+  // sorting by a separate key collection
+  //
+  benchmark("sortLike_swapping", unsorted, nIterations,
+    [&keys](std::vector<Data>& data)
+    {
+      util::details::sortLikeBySwapping(
+        data.begin(), data.end(), keys.cbegin(), keys.cend(), std::less<>{}
+        );
+    },
+    isSortedByStoredKey);
+
+  benchmark("sortLike_permutation", unsorted, nIterations,
+    [&keys](std::vector<Data>& data){ util::sortCollLike(data, keys); },
+    isSortedByStoredKey);
+
+  benchmark("sortLike_permutation_par", unsorted, nIterations,
+    [&keys](std::vector<Data>& data)
+      { util::sortCollLike(std::execution::par, data, keys); },
+    isSortedByStoredKey);
+
+  //
+  // sorting by a key computed from the elements
+  //
+  benchmark("std_sort_computed_key", unsorted, nIterations,
+    [](std::vector<Data>& data)
+    {
+      std::sort(data.begin(), data.end(),
+        [](Data const& a, Data const& b)
+          { return computeKey(a) < computeKey(b); }
+        );
+    },
+    isSortedByComputedKey);
+
+  benchmark("sortCollInPlaceBy", unsorted, nIterations,
+    [](std::vector<Data>& data){ util::sortCollInPlaceBy(data, computeKey); },
+    isSortedByComputedKey);
+
+  benchmark("sortCollInPlaceBy_par", unsorted, nIterations,
+    [](std::vector<Data>& data)
+      { util::sortCollInPlaceBy(std::execution::par, data, computeKey); },
+    isSortedByComputedKey);
+
+  return 0;
+} // main()
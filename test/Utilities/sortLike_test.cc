@@ -13,9 +13,14 @@
 
 // ICARUS libraries
 #include "icarusalg/Utilities/sortLike.h"
+#include "icarusalg/Utilities/sortBy.h"
 
 // C/C++ standard library
 #include <ostream>
+#include <execution> // std::execution::par
+#include <list>
+#include <numeric> // std::iota()
+#include <cstdlib> // std::abs()
 #include <algorithm> // std::sort()
 #include <functional> // std::greater<>
 #include <memory> // std::unique_ptr()
@@ -191,6 +196,82 @@ void sortCollLike_doc1_test() {
 } // sortCollLike_doc1_test()
 
 
+//------------------------------------------------------------------------------
+void sortLike_stable_test() {
+  
+  // many elements with the same key: their relative order must be preserved
+  constexpr std::size_t N = 10000;
+  std::vector<int> keys(N);
+  std::vector<std::size_t> data(N);
+  for (std::size_t i = 0; i < N; ++i) keys[i] = (i * 7919) % 13;
+  std::iota(data.begin(), data.end(), std::size_t{ 0 });
+  
+  std::vector<std::size_t> expected{ data };
+  std::stable_sort(expected.begin(), expected.end(),
+    [&keys](std::size_t a, std::size_t b){ return keys[a] < keys[b]; });
+  
+  std::vector<std::size_t> seqData{ data };
+  util::sortCollLike(seqData, keys);
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (seqData.cbegin(), seqData.cend(), expected.cbegin(), expected.cend());
+  
+  std::vector<std::size_t> parData{ data };
+  util::sortCollLike(std::execution::par, parData, keys);
+  BOOST_CHECK_EQUAL_COLLECTIONS
+    (parData.cbegin(), parData.cend(), expected.cbegin(), expected.cend());
+  
+} // sortLike_stable_test()
+
+
+//------------------------------------------------------------------------------
+void sortLike_forward_test() {
+  
+  // forward iterators take the swapping algorithm
+  std::list<char> name{ 'A', 'C', 'I', 'R', 'S', 'U' };
+  std::list<int> const order{ 3, 2, 1, 4, 6, 5 };
+  
+  util::sortLike(name.begin(), name.end(), order.begin(), order.end());
+  
+  BOOST_TEST((std::string{ name.begin(), name.end() } == "ICARUS"));
+  
+} // sortLike_forward_test()
+
+
+//------------------------------------------------------------------------------
+void sortCollInPlaceBy_test() {
+  
+  std::vector const values{ 8, -6, 4, -2, 7, -5, 3, 6, -8 };
+  
+  std::vector<NastyUncopiableData> data;
+  for (int v: values) data.emplace_back(v);
+  
+  unsigned int nKeyCalls = 0;
+  auto const absKey = [&nKeyCalls](NastyUncopiableData const& d)
+    { ++nKeyCalls; return std::abs(d.value()); };
+  
+  util::sortCollInPlaceBy(data, absKey);
+  
+  // sorting is stable: `8` comes before `-8`
+  std::vector const expected{ -2, 3, 4, -5, -6, 6, 7, 8, -8 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    boost::transform_iterator
+      (data.begin(), std::mem_fn(&NastyUncopiableData::value)),
+    boost::transform_iterator
+      (data.end(), std::mem_fn(&NastyUncopiableData::value)),
+    expected.cbegin(), expected.cend()
+    );
+  BOOST_TEST(nKeyCalls == values.size()); // each key computed only once
+  
+  std::vector<int> parData{ values };
+  util::sortCollInPlaceBy(std::execution::par, parData,
+    [](int v){ return std::abs(v); }, std::greater<>{});
+  std::vector const parExpected{ 8, -8, 7, -6, 6, -5, 4, 3, -2 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(parData.cbegin(), parData.cend(),
+    parExpected.cbegin(), parExpected.cend());
+  
+} // sortCollInPlaceBy_test()
+
+
 //------------------------------------------------------------------------------
 //---  The tests
 //---
@@ -200,6 +281,10 @@ BOOST_AUTO_TEST_CASE( sortLike_testcase ) {
   
   sortLike_doc1_test();
   
+  sortLike_stable_test();
+  
+  sortLike_forward_test();
+  
 } // BOOST_AUTO_TEST_CASE( sortLike_testcase )
 
 BOOST_AUTO_TEST_CASE( sortCollLike_testcase ) {
@@ -210,4 +295,8 @@ BOOST_AUTO_TEST_CASE( sortCollLike_testcase ) {
   
 } // BOOST_AUTO_TEST_CASE( sortCollLike_testcase )
 
-
+BOOST_AUTO_TEST_CASE( sortCollInPlaceBy_testcase ) {
+  
+  sortCollInPlaceBy_test();
+  
+} // BOOST_AUTO_TEST_CASE( sortCollInPlaceBy_testcase )
@@ -0,0 +1,526 @@
+/**
+ * @file   MCTruthAssociations_test.cc
+ * @brief  Unit test for `truth::MCTruthAssociations`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/gallery/MCTruthBase/MCTruthAssociations.h`
+ *
+ * A small event is built by hand, with hits from two data products and two
+ * hit/particle association products. The hit matching is compared with the
+ * one from the `std::set` the associations used to be stored into, and the
+ * batched purity and efficiency with the single-collection methods.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE MCTruthAssociations
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/gallery/MCTruthBase/MCTruthAssociations.h"
+#include "icarusalg/Utilities/HitColumns.h"
+#include "test/FrameworkEventMockup.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "nusimdata/SimulationBase/MCParticle.h"
+#include "nusimdata/SimulationBase/MCTruth.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace truth {
+
+  // for the comparison of `TrackIDE` collections
+  bool operator== (TrackIDE const& a, TrackIDE const& b) {
+    return (a.trackID == b.trackID) && (a.energyFrac == b.energyFrac)
+      && (a.energy == b.energy) && (a.numElectrons == b.numElectrons);
+  }
+
+  std::ostream& operator<< (std::ostream& out, TrackIDE const& ide) {
+    return out << "{ ID=" << ide.trackID << " fraction=" << ide.energyFrac
+      << " }";
+  }
+
+} // namespace truth
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using truth::HitParticleAssociations;
+
+  /// Returns a hit on wire `i` of the specified view.
+  recob::Hit makeHit(unsigned int i, geo::View_t view) {
+    return recob::Hit{
+      raw::ChannelID_t(100 + i),          // channel
+      raw::TDCtick_t(10 * i),             // start_tick
+      raw::TDCtick_t(10 * i + 8),         // end_tick
+      10.0f * i + 4.0f,                   // peak_time
+      0.5f,                               // sigma_peak_time
+      1.5f,                               // rms
+      20.0f + i,                          // peak_amplitude
+      1.0f,                               // sigma_peak_amplitude
+      30.0f + i,                          // summedADC
+      40.0f + 3.0f * i,                   // hit_integral
+      2.0f,                               // hit_sigma_integral
+      short(1),                           // multiplicity
+      short(0),                           // local_index
+      1.0f,                               // goodness_of_fit
+      int(5),                             // dof
+      view,                               // view
+      (view == geo::kW)? geo::kCollection: geo::kInduction, // signal_type
+      geo::WireID{ 0U, 0U, (view == geo::kW)? 2U: 0U, i } // wireID
+      };
+  } // makeHit()
+
+  /// Returns `n` hits, alternating views U and W.
+  std::vector<recob::Hit> makeHits(unsigned int n) {
+    std::vector<recob::Hit> hits;
+    for (unsigned int i = 0; i < n; ++i)
+      hits.push_back(makeHit(i, (i % 2 == 0)? geo::kU: geo::kW));
+    return hits;
+  } // makeHits()
+
+  /// Returns matching information with the specified fraction of energy.
+  anab::BackTrackerHitMatchingData makeMatch(float ideFraction) {
+    anab::BackTrackerHitMatchingData data;
+    data.ideFraction = ideFraction;
+    data.energy = 10.0 * ideFraction;
+    data.numElectrons = 2.5e4 * ideFraction;
+    return data;
+  } // makeMatch()
+
+  /// Returns the algorithm configuration.
+  fhicl::ParameterSet makeConfig
+    (float minHitEnergyFraction, unsigned int eveIdThreads)
+  {
+    fhicl::ParameterSet config;
+    config.put("MinHitEnergyFraction", minHitEnergyFraction);
+    config.put("EveIdThreads", eveIdThreads);
+    return config;
+  } // makeConfig()
+
+  /// Returns a geometry with no detector (the algorithm only keeps it).
+  geo::GeometryCore makeGeometry() {
+    fhicl::ParameterSet config;
+    config.put("SurfaceY", 0.0);
+    config.put("Name", std::string{ "test" });
+    return geo::GeometryCore{ config };
+  } // makeGeometry()
+
+
+  /**
+   * @brief A small event with hits matched to particles.
+   *
+   * Particles (track ID, process, mother; eve ID):
+   *  * key #0: track 1, primary muon (eve 1)
+   *  * key #1: track 2, decay electron from track 1 (eve 2)
+   *  * key #2: track 3, ionization electron from track 2 (eve 2)
+   *  * key #3: track 4, Compton electron from track 3 (eve 2)
+   *  * key #4: track 5, pair electron from track 1 (eve 1)
+   *  * key #5: track 10, primary proton (eve 10)
+   *  * key #6: track 11, inelastic proton from track 10 (eve 11), no MCTruth
+   *
+   * There are two hit products (`A` and `B`) and two hit/particle
+   * association products: the first with hits from both `A` and `B`,
+   * the second with hits from `B` only.
+   */
+  struct TestEvent {
+
+    testing::mockup::Event event;
+
+    std::vector<art::Ptr<simb::MCParticle>> particles;
+    truth::MCTruthTruthVec particleTruths;
+    std::vector<art::Ptr<recob::Hit>> allHits; ///< All hits, `A` then `B`.
+    truth::HitParticleAssociationsVec assns;
+
+    std::vector<recob::Hit> allHitCopies; ///< Content of `allHits`.
+
+    TestEvent();
+
+  }; // TestEvent
+
+
+  TestEvent::TestEvent() {
+
+    event.put(std::vector<simb::MCTruth>(2U), art::InputTag{ "generator" });
+    event.put(std::vector<simb::MCParticle>{
+        simb::MCParticle{  1,   13, "primary",          0, 0.105658, 1 },
+        simb::MCParticle{  2,   11, "Decay",            1, 0.000511, 1 },
+        simb::MCParticle{  3,   11, "eIoni",            2, 0.000511, 1 },
+        simb::MCParticle{  4,   11, "compt",            3, 0.000511, 1 },
+        simb::MCParticle{  5,   11, "conv",             1, 0.000511, 1 },
+        simb::MCParticle{ 10, 2212, "primary",          0, 0.938272, 1 },
+        simb::MCParticle{ 11, 2212, "protonInelastic", 10, 0.938272, 1 }
+      }, art::InputTag{ "largeant" });
+    event.put(makeHits(8U), art::InputTag{ "hitsA" });
+    event.put(makeHits(4U), art::InputTag{ "hitsB" });
+
+    testing::mockup::PtrMaker<simb::MCTruth> const makeTruthPtr
+      { event, art::InputTag{ "generator" } };
+    testing::mockup::PtrMaker<simb::MCParticle> const makePartPtr
+      { event, art::InputTag{ "largeant" } };
+    testing::mockup::PtrMaker<recob::Hit> const makeHitAPtr
+      { event, art::InputTag{ "hitsA" } };
+    testing::mockup::PtrMaker<recob::Hit> const makeHitBPtr
+      { event, art::InputTag{ "hitsB" } };
+
+    for (std::size_t key = 0; key < 7U; ++key)
+      particles.push_back(makePartPtr(key));
+
+    // the last particle has no MCTruth
+    particleTruths.assign(5U, makeTruthPtr(0));
+    particleTruths.push_back(makeTruthPtr(1));
+
+    for (std::size_t key = 0; key < 8U; ++key)
+      allHits.push_back(makeHitAPtr(key));
+    for (std::size_t key = 0; key < 4U; ++key)
+      allHits.push_back(makeHitBPtr(key));
+    for (art::Ptr<recob::Hit> const& hit: allHits)
+      allHitCopies.push_back(*hit);
+
+    // hit A#5 and B#3 are not matched; some associations are repeated
+    HitParticleAssociations assns1;
+    assns1.addSingle(makePartPtr(0), makeHitAPtr(0), makeMatch(0.9));
+    assns1.addSingle(makePartPtr(4), makeHitAPtr(0), makeMatch(0.1));
+    assns1.addSingle(makePartPtr(0), makeHitAPtr(1), makeMatch(1.0));
+    assns1.addSingle(makePartPtr(0), makeHitAPtr(1), makeMatch(1.0));
+    assns1.addSingle(makePartPtr(1), makeHitAPtr(2), makeMatch(0.6));
+    assns1.addSingle(makePartPtr(2), makeHitAPtr(2), makeMatch(0.4));
+    assns1.addSingle(makePartPtr(5), makeHitAPtr(3), makeMatch(1.0));
+    assns1.addSingle(makePartPtr(6), makeHitAPtr(4), makeMatch(0.5));
+    assns1.addSingle(makePartPtr(5), makeHitAPtr(4), makeMatch(0.5));
+    assns1.addSingle(makePartPtr(3), makeHitAPtr(6), makeMatch(0.3));
+    assns1.addSingle(makePartPtr(0), makeHitAPtr(6), makeMatch(0.7));
+    assns1.addSingle(makePartPtr(2), makeHitAPtr(7), makeMatch(1.0));
+    assns1.addSingle(makePartPtr(0), makeHitBPtr(0), makeMatch(1.0));
+    assns1.addSingle(makePartPtr(6), makeHitBPtr(1), makeMatch(1.0));
+    event.put(std::move(assns1), art::InputTag{ "mcassns" });
+
+    // hit B#1 is also in the first product, which takes precedence
+    HitParticleAssociations assns2;
+    assns2.addSingle(makePartPtr(5), makeHitBPtr(1), makeMatch(1.0));
+    assns2.addSingle(makePartPtr(1), makeHitBPtr(2), makeMatch(0.8));
+    assns2.addSingle(makePartPtr(4), makeHitBPtr(2), makeMatch(0.2));
+    assns2.addSingle(makePartPtr(1), makeHitBPtr(2), makeMatch(0.8));
+    event.put(std::move(assns2), art::InputTag{ "mcassnsB" });
+
+    assns.push_back(
+      &event.getProduct<HitParticleAssociations>(art::InputTag{ "mcassns" })
+      );
+    assns.push_back(
+      &event.getProduct<HitParticleAssociations>(art::InputTag{ "mcassnsB" })
+      );
+
+  } // TestEvent::TestEvent()
+
+
+  /// Returns the matches of `hit` the way they used to be stored and read.
+  std::vector<truth::TrackIDE> referenceTrackIDEs(
+    truth::HitParticleAssociationsVec const& assnsVec,
+    recob::Hit const* hit
+  ) {
+    using PartMatchDataPair = std::pair
+      <const simb::MCParticle*, const anab::BackTrackerHitMatchingData*>;
+
+    // the first association product with the hit wins
+    for (HitParticleAssociations const* assns: assnsVec) {
+      std::set<PartMatchDataPair> matches;
+      for (auto itr = assns->begin(); itr != assns->end(); ++itr) {
+        if (itr->second.get() == hit)
+          matches.emplace(itr->first.get(), itr->data);
+      }
+      if (matches.empty()) continue;
+
+      std::vector<truth::TrackIDE> IDEs;
+      for (auto const& [ part, data ]: matches) {
+        IDEs.push_back(truth::TrackIDE{
+          part->TrackId(), data->ideFraction, data->energy, data->numElectrons
+          });
+      }
+      return IDEs;
+    } // for
+    return {};
+  } // referenceTrackIDEs()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void hitMatchingTest() {
+
+  TestEvent const data;
+  geo::GeometryCore const geom = makeGeometry();
+
+  truth::MCTruthAssociations mcAssns { makeConfig(0.5f, 1U) };
+  mcAssns.setup(data.assns, data.particles, data.particleTruths, geom);
+
+  std::size_t nMatched = 0;
+  for (art::Ptr<recob::Hit> const& hit: data.allHits) {
+    BOOST_TEST_CONTEXT("hit " << hit) {
+      std::vector<truth::TrackIDE> const expected
+        = referenceTrackIDEs(data.assns, hit.get());
+      if (!expected.empty()) ++nMatched;
+
+      std::vector<truth::TrackIDE> const byPtr = mcAssns.HitToTrackID(hit);
+      BOOST_TEST(byPtr == expected, boost::test_tools::per_element());
+      std::vector<truth::TrackIDE> const byAddress
+        = mcAssns.HitToTrackID(hit.get());
+      BOOST_TEST(byAddress == expected, boost::test_tools::per_element());
+    }
+  } // for
+  BOOST_TEST(nMatched == 10U);
+
+  // hits of the requested tracks (above threshold), sorted by track ID
+  std::vector<int> const trackIDs { 10, 1, 99 };
+  std::vector<std::vector<art::Ptr<recob::Hit>>> expectedHits(2U);
+  for (art::Ptr<recob::Hit> const& hit: data.allHits) {
+    for (truth::TrackIDE const& ide: referenceTrackIDEs(data.assns, hit.get()))
+    {
+      if (!(ide.energyFrac > 0.5f)) continue;
+      if (ide.trackID == 1) expectedHits[0].push_back(hit);
+      if (ide.trackID == 10) expectedHits[1].push_back(hit);
+    } // for
+  } // for
+  auto const trackHits = mcAssns.TrackIDsToHits(data.allHits, trackIDs);
+  BOOST_TEST_REQUIRE(trackHits.size() == expectedHits.size());
+  for (std::size_t i = 0; i < expectedHits.size(); ++i) {
+    BOOST_TEST_CONTEXT("track #" << i) {
+      BOOST_TEST(trackHits[i] == expectedHits[i],
+        boost::test_tools::per_element());
+    }
+  } // for
+
+  // MCTruth
+  BOOST_TEST(mcAssns.MCTruthVector().size() == 2U);
+  BOOST_TEST(mcAssns.TrackIDToMCTruth(1) == data.particleTruths[0]);
+  BOOST_TEST(mcAssns.TrackIDToMCTruth(-4) == data.particleTruths[0]);
+  BOOST_TEST(mcAssns.TrackIDToMCTruth(10) == data.particleTruths[5]);
+  BOOST_CHECK_THROW(mcAssns.TrackIDToMCTruth(11), cet::exception);
+
+} // hitMatchingTest()
+
+
+//------------------------------------------------------------------------------
+void purityAndEfficiencyTest(float minHitEnergyFraction) {
+
+  TestEvent const data;
+  geo::GeometryCore const geom = makeGeometry();
+
+  truth::MCTruthAssociations mcAssns
+    { makeConfig(minHitEnergyFraction, 1U) };
+  mcAssns.setup(data.assns, data.particles, data.particleTruths, geom);
+
+  icarus::ns::util::HitColumns allHitColumns;
+  allHitColumns.fill(data.allHitCopies);
+
+  // collections are ranges of all the hits
+  std::vector<truth::HitCollectionSpec> const collections {
+    { 0U,  4U, { 1 },        geo::k3D },
+    { 2U,  8U, { 2, 3, 4 },  geo::k3D },
+    { 2U,  8U, { 4, 3, 2 },  geo::kU  },
+    { 8U, 12U, { 10, 11 },   geo::kW  },
+    { 0U, 12U, { 1, 5, 1 },  geo::k3D },
+    { 0U, 12U, { 10 },       geo::kU  },
+    { 5U,  5U, { 1 },        geo::k3D },
+    { 0U, 12U, {},           geo::k3D },
+    { 3U,  7U, { 99 },       geo::k3D }
+  };
+
+  std::vector<truth::HitCollectionMatch> const results
+    = mcAssns.HitCollectionPurityAndEfficiency
+      (collections, data.allHits, data.allHits);
+  std::vector<truth::HitCollectionMatch> const columnResults
+    = mcAssns.HitCollectionPurityAndEfficiency
+      (collections, data.allHits, data.allHits, allHitColumns);
+  BOOST_TEST_REQUIRE(results.size() == collections.size());
+  BOOST_TEST_REQUIRE(columnResults.size() == collections.size());
+
+  for (std::size_t iColl = 0; iColl < collections.size(); ++iColl) {
+    truth::HitCollectionSpec const& collection = collections[iColl];
+    std::vector<art::Ptr<recob::Hit>> const hits{
+      data.allHits.begin() + collection.begin,
+      data.allHits.begin() + collection.end
+      };
+    std::set<int> const trackIDs
+      { collection.trackIDs.begin(), collection.trackIDs.end() };
+
+    BOOST_TEST_CONTEXT("collection #" << iColl) {
+      for (truth::HitCollectionMatch const& result
+        : { results[iColl], columnResults[iColl] }
+      ) {
+        BOOST_TEST(result.purity
+          == mcAssns.HitCollectionPurity(trackIDs, hits),
+          boost::test_tools::tolerance(1e-6));
+        BOOST_TEST(result.efficiency
+          == mcAssns.HitCollectionEfficiency
+            (trackIDs, hits, data.allHits, collection.view),
+          boost::test_tools::tolerance(1e-6));
+        BOOST_TEST(result.chargePurity
+          == mcAssns.HitChargeCollectionPurity(trackIDs, hits),
+          boost::test_tools::tolerance(1e-6));
+        BOOST_TEST(result.chargeEfficiency
+          == mcAssns.HitChargeCollectionEfficiency
+            (trackIDs, hits, data.allHits, collection.view),
+          boost::test_tools::tolerance(1e-6));
+      } // for results
+    } // context
+  } // for collections
+
+  // not all the results are trivial
+  BOOST_TEST(results[1].purity > 0.0);
+  BOOST_TEST(results[1].purity < 1.0);
+  BOOST_TEST(results[4].efficiency > 0.0);
+
+  // a hit table not matching the hits is an error
+  icarus::ns::util::HitColumns const emptyColumns;
+  BOOST_CHECK_THROW(
+    mcAssns.HitCollectionPurityAndEfficiency
+      (collections, data.allHits, data.allHits, emptyColumns),
+    cet::exception
+    );
+
+} // purityAndEfficiencyTest()
+
+
+//------------------------------------------------------------------------------
+void eveIdTest() {
+
+  TestEvent const data;
+  geo::GeometryCore const geom = makeGeometry();
+
+  std::map<int, int> const expectedEveIDs
+    {
+      { 1, 1 }, { 2, 2 }, { 3, 2 }, { 4, 2 }, { 5, 1 },
+      { 10, 10 }, { 11, 11 }
+    };
+
+  for (unsigned int const nThreads: { 1U, 4U }) {
+    BOOST_TEST_CONTEXT("threads: " << nThreads) {
+
+      truth::MCTruthAssociations mcAssns { makeConfig(0.0f, nThreads) };
+      mcAssns.setup(data.assns, data.particles, data.particleTruths, geom);
+
+      truth::MCTruthParticleList const& particleList
+        = mcAssns.getParticleList();
+      for (auto const [ trackID, eveID ]: expectedEveIDs)
+        BOOST_TEST(particleList.EveId(trackID) == eveID);
+
+      BOOST_TEST((mcAssns.GetSetOfEveIDs() == std::set{ 1, 2, 10, 11 }));
+
+      // the matches of each hit, summed by eve ID
+      for (art::Ptr<recob::Hit> const& hit: data.allHits) {
+        BOOST_TEST_CONTEXT("hit " << hit) {
+          std::map<int, float> expected;
+          for (truth::TrackIDE const& ide
+            : referenceTrackIDEs(data.assns, hit.get())
+          ) {
+            expected[expectedEveIDs.at(ide.trackID)] += ide.energyFrac;
+          }
+
+          std::map<int, float> eveFractions;
+          for (truth::TrackIDE const& ide: mcAssns.HitToEveID(hit)) {
+            BOOST_TEST(eveFractions.count(ide.trackID) == 0U);
+            eveFractions[ide.trackID] = ide.energyFrac;
+          }
+          BOOST_TEST((eveFractions == expected));
+        } // context
+      } // for hits
+
+    } // context
+  } // for threads
+
+} // eveIdTest()
+
+
+//------------------------------------------------------------------------------
+void memoryStatsTest() {
+
+  TestEvent const data;
+  geo::GeometryCore const geom = makeGeometry();
+
+  // a smaller event: only the second association product, fewer particles
+  truth::HitParticleAssociationsVec const smallAssns { data.assns[1] };
+  std::vector<art::Ptr<simb::MCParticle>> const smallParticles
+    { data.particles.begin(), data.particles.begin() + 5 };
+
+  truth::MCTruthAssociations mcAssns { makeConfig(0.0f, 1U) };
+  BOOST_TEST(mcAssns.getMemoryStats().nEvents == 0U);
+  BOOST_TEST(mcAssns.getMemoryStats().peakBytes == 0U);
+
+  mcAssns.setup(data.assns, data.particles, data.particleTruths, geom);
+  truth::MCTruthMemoryStats const first = mcAssns.getMemoryStats();
+  BOOST_TEST(first.nEvents == 1U);
+  BOOST_TEST(first.eventBytes > 0U);
+  BOOST_TEST(first.peakBytes == first.eventBytes);
+
+  mcAssns.setup(smallAssns, smallParticles, data.particleTruths, geom);
+  truth::MCTruthMemoryStats const second = mcAssns.getMemoryStats();
+  BOOST_TEST(second.nEvents == 2U);
+  BOOST_TEST(second.eventBytes > 0U);
+  BOOST_TEST(second.eventBytes < first.eventBytes);
+  BOOST_TEST(second.peakBytes == first.peakBytes);
+
+  // the content is the one of the last event only
+  BOOST_TEST(mcAssns.getParticleList().size() == smallParticles.size());
+  BOOST_TEST(mcAssns.HitToTrackID(data.allHits[0]).empty());
+  BOOST_TEST(mcAssns.HitToTrackID(data.allHits[9]).size() == 1U);
+  BOOST_TEST(mcAssns.HitToTrackID(data.allHits[9]).front().trackID == 10);
+
+  // the full event again
+  mcAssns.setup(data.assns, data.particles, data.particleTruths, geom);
+  truth::MCTruthMemoryStats const third = mcAssns.getMemoryStats();
+  BOOST_TEST(third.nEvents == 3U);
+  BOOST_TEST(third.eventBytes >= second.eventBytes);
+  BOOST_TEST(third.peakBytes == std::max(first.peakBytes, third.eventBytes));
+  for (art::Ptr<recob::Hit> const& hit: data.allHits) {
+    BOOST_TEST(mcAssns.HitToTrackID(hit)
+      == referenceTrackIDEs(data.assns, hit.get()),
+      boost::test_tools::per_element());
+  }
+
+  // once the memory is there, the same event does not take any more
+  mcAssns.setup(data.assns, data.particles, data.particleTruths, geom);
+  truth::MCTruthMemoryStats const fourth = mcAssns.getMemoryStats();
+  BOOST_TEST(fourth.nEvents == 4U);
+  BOOST_TEST(fourth.eventBytes == third.eventBytes);
+  BOOST_TEST(fourth.peakBytes == third.peakBytes);
+
+} // memoryStatsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( HitMatchingTestCase ) {
+  hitMatchingTest();
+} // BOOST_AUTO_TEST_CASE( HitMatchingTestCase )
+
+BOOST_AUTO_TEST_CASE( PurityAndEfficiencyTestCase ) {
+  purityAndEfficiencyTest(0.0f);
+  purityAndEfficiencyTest(0.5f);
+} // BOOST_AUTO_TEST_CASE( PurityAndEfficiencyTestCase )
+
+BOOST_AUTO_TEST_CASE( EveIdTestCase ) {
+  eveIdTest();
+} // BOOST_AUTO_TEST_CASE( EveIdTestCase )
+
+BOOST_AUTO_TEST_CASE( MemoryStatsTestCase ) {
+  memoryStatsTest();
+} // BOOST_AUTO_TEST_CASE( MemoryStatsTestCase )
@@ -0,0 +1,301 @@
+/**
+ * @file   MCTruthHitParticleTable_test.cc
+ * @brief  Unit test for `truth::MCTruthHitParticleTable`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/gallery/MCTruthBase/MCTruthHitParticleTable.h`
+ *
+ * The content of the tables is compared with the one of the `std::map` of
+ * `std::set` that `truth::MCTruthAssociations` used to fill.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE MCTruthHitParticleTable
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/gallery/MCTruthBase/MCTruthHitParticleTable.h"
+#include "test/FrameworkEventMockup.h"
+
+// LArSoft libraries
+#include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+// framework libraries
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <set>
+#include <utility> // std::pair
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using HitParticleAssociations
+    = truth::MCTruthHitParticleTable::HitParticleAssociations;
+
+  /// Returns a hit on wire `i` with values derived from `i`.
+  recob::Hit makeHit(unsigned int i) {
+    return recob::Hit{
+      raw::ChannelID_t(100 + i),          // channel
+      raw::TDCtick_t(10 * i),             // start_tick
+      raw::TDCtick_t(10 * i + 8),         // end_tick
+      10.0f * i + 4.0f,                   // peak_time
+      0.5f,                               // sigma_peak_time
+      1.5f,                               // rms
+      20.0f + i,                          // peak_amplitude
+      1.0f,                               // sigma_peak_amplitude
+      30.0f + i,                          // summedADC
+      40.0f + i,                          // hit_integral
+      2.0f,                               // hit_sigma_integral
+      short(1),                           // multiplicity
+      short(0),                           // local_index
+      1.0f,                               // goodness_of_fit
+      int(5),                             // dof
+      geo::kW,                            // view
+      geo::kCollection,                   // signal_type
+      geo::WireID{ 0U, 0U, 2U, i }        // wireID
+      };
+  } // makeHit()
+
+  /// Returns `n` hits.
+  std::vector<recob::Hit> makeHits(unsigned int n) {
+    std::vector<recob::Hit> hits;
+    for (unsigned int i = 0; i < n; ++i) hits.push_back(makeHit(i));
+    return hits;
+  } // makeHits()
+
+  /// Returns a primary particle with the specified track ID.
+  simb::MCParticle makeParticle(int trackID)
+    { return simb::MCParticle{ trackID, 13, "primary", -1, 0.105658, 1 }; }
+
+  /// Returns matching information with the specified fraction of energy.
+  anab::BackTrackerHitMatchingData makeMatch(float ideFraction) {
+    anab::BackTrackerHitMatchingData data;
+    data.ideFraction = ideFraction;
+    data.energy = 10.0 * ideFraction;
+    data.numElectrons = 2.5e4 * ideFraction;
+    return data;
+  } // makeMatch()
+
+
+  // --- BEGIN -- Reference ----------------------------------------------------
+  // the maps of sets that `truth::MCTruthAssociations` used to fill
+  using PartMatchDataPair = std::pair
+    <const simb::MCParticle*, const anab::BackTrackerHitMatchingData*>;
+  using HitMatchDataPair = std::pair
+    <const recob::Hit*, const anab::BackTrackerHitMatchingData*>;
+
+  struct ReferenceTables {
+    std::map<const recob::Hit*, std::set<PartMatchDataPair>> hitToParts;
+    std::map<int, std::set<HitMatchDataPair>> trackToHits;
+  }; // ReferenceTables
+
+  ReferenceTables makeReference(HitParticleAssociations const& assns) {
+    ReferenceTables ref;
+    for (auto itr = assns.begin(); itr != assns.end(); ++itr) {
+      recob::Hit const* hit = itr->second.get();
+      simb::MCParticle const* part = itr->first.get();
+      ref.hitToParts[hit].emplace(part, itr->data);
+      ref.trackToHits[part->TrackId()].emplace(hit, itr->data);
+    } // for
+    return ref;
+  } // makeReference()
+  // --- END ---- Reference ----------------------------------------------------
+
+
+  /// Checks the particles of `hit` in `table` against the reference.
+  void checkParticlesOf(
+    truth::MCTruthHitParticleTable const& table,
+    ReferenceTables const& ref,
+    art::Ptr<recob::Hit> const& hit
+  ) {
+
+    std::vector<PartMatchDataPair> expected;
+    if (auto const itr = ref.hitToParts.find(hit.get());
+      itr != ref.hitToParts.end()
+    ) {
+      expected.assign(itr->second.begin(), itr->second.end());
+    }
+
+    std::vector<PartMatchDataPair> byAddress, byPtr;
+    for (auto const& match: table.particlesOf(hit.get()))
+      byAddress.emplace_back(match.particle, match.data);
+    for (auto const& match: table.particlesOf(hit))
+      byPtr.emplace_back(match.particle, match.data);
+
+    BOOST_TEST_CONTEXT("hit " << hit) {
+      BOOST_TEST(byAddress.size() == expected.size());
+      BOOST_TEST((byAddress == expected));
+      BOOST_TEST(byPtr.size() == expected.size());
+      BOOST_TEST((byPtr == expected));
+    }
+
+  } // checkParticlesOf()
+
+
+  /// Checks the whole content of `table` against the reference.
+  void checkTable(
+    truth::MCTruthHitParticleTable const& table,
+    HitParticleAssociations const& assns,
+    std::vector<art::Ptr<recob::Hit>> const& allHits,
+    std::vector<int> const& allTrackIDs
+  ) {
+
+    ReferenceTables const ref = makeReference(assns);
+
+    BOOST_TEST(table.nHits() == ref.hitToParts.size());
+    BOOST_TEST(table.nParticles() == ref.trackToHits.size());
+
+    for (art::Ptr<recob::Hit> const& hit: allHits)
+      checkParticlesOf(table, ref, hit);
+
+    for (int const trackID: allTrackIDs) {
+      std::vector<HitMatchDataPair> expected;
+      if (auto const itr = ref.trackToHits.find(trackID);
+        itr != ref.trackToHits.end()
+      ) {
+        expected.assign(itr->second.begin(), itr->second.end());
+      }
+
+      std::vector<HitMatchDataPair> hits;
+      for (auto const& match: table.hitsOf(trackID))
+        hits.emplace_back(match.hit, match.data);
+
+      BOOST_TEST_CONTEXT("track ID " << trackID) {
+        BOOST_TEST(hits.size() == expected.size());
+        BOOST_TEST((hits == expected));
+      }
+    } // for track ID
+
+  } // checkTable()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void singleProductTest() {
+
+  testing::mockup::Event event;
+  event.put(std::vector<simb::MCParticle>{
+      makeParticle(1), makeParticle(2), makeParticle(3), makeParticle(4)
+    }, art::InputTag{ "largeant" });
+  event.put(makeHits(6U), art::InputTag{ "hits" });
+
+  testing::mockup::PtrMaker<simb::MCParticle> const makePartPtr
+    { event, art::InputTag{ "largeant" } };
+  testing::mockup::PtrMaker<recob::Hit> const makeHitPtr
+    { event, art::InputTag{ "hits" } };
+
+  // hits #2 and #5 have no particle, particle #4 has no hit;
+  // the association of particle #1 and hit #0 is repeated
+  HitParticleAssociations assns;
+  assns.addSingle(makePartPtr(0), makeHitPtr(3), makeMatch(0.2));
+  assns.addSingle(makePartPtr(0), makeHitPtr(0), makeMatch(0.7));
+  assns.addSingle(makePartPtr(1), makeHitPtr(0), makeMatch(0.3));
+  assns.addSingle(makePartPtr(0), makeHitPtr(0), makeMatch(0.7));
+  assns.addSingle(makePartPtr(0), makeHitPtr(1), makeMatch(1.0));
+  assns.addSingle(makePartPtr(2), makeHitPtr(3), makeMatch(0.8));
+  assns.addSingle(makePartPtr(2), makeHitPtr(4), makeMatch(1.0));
+
+  std::vector<art::Ptr<recob::Hit>> allHits;
+  for (std::size_t i = 0; i < 6U; ++i) allHits.push_back(makeHitPtr(i));
+  std::vector<int> const allTrackIDs { 0, 1, 2, 3, 4, 5, -1 };
+
+  truth::MCTruthHitParticleTable table { assns };
+  checkTable(table, assns, allHits, allTrackIDs);
+
+  // a hit from another product has no particle,
+  // even if its key is matched in this table
+  event.put(makeHits(2U), art::InputTag{ "otherHits" });
+  testing::mockup::PtrMaker<recob::Hit> const makeOtherHitPtr
+    { event, art::InputTag{ "otherHits" } };
+  BOOST_TEST(table.particlesOf(makeOtherHitPtr(0)).empty());
+  BOOST_TEST(table.particlesOf(makeOtherHitPtr(0).get()).empty());
+  BOOST_TEST(table.particlesOf(art::Ptr<recob::Hit>{}).empty());
+  recob::Hit const* const noHit = nullptr;
+  BOOST_TEST(table.particlesOf(noHit).empty());
+
+  // filling again replaces all the content
+  HitParticleAssociations otherAssns;
+  otherAssns.addSingle(makePartPtr(3), makeHitPtr(5), makeMatch(1.0));
+  otherAssns.addSingle(makePartPtr(1), makeHitPtr(2), makeMatch(0.5));
+  table.fill(otherAssns);
+  checkTable(table, otherAssns, allHits, allTrackIDs);
+
+  table.clear();
+  BOOST_TEST(table.nHits() == 0U);
+  BOOST_TEST(table.nParticles() == 0U);
+  checkTable(table, HitParticleAssociations{}, allHits, allTrackIDs);
+
+} // singleProductTest()
+
+
+//------------------------------------------------------------------------------
+void twoProductsTest() {
+
+  /*
+   * Hits from two data products: keys are not unique anymore, and the table
+   * must fall back to the lookup by address.
+   */
+  testing::mockup::Event event;
+  event.put(std::vector<simb::MCParticle>{
+      makeParticle(1), makeParticle(2), makeParticle(3)
+    }, art::InputTag{ "largeant" });
+  event.put(makeHits(4U), art::InputTag{ "hitsA" });
+  event.put(makeHits(4U), art::InputTag{ "hitsB" });
+
+  testing::mockup::PtrMaker<simb::MCParticle> const makePartPtr
+    { event, art::InputTag{ "largeant" } };
+  testing::mockup::PtrMaker<recob::Hit> const makeHitAPtr
+    { event, art::InputTag{ "hitsA" } };
+  testing::mockup::PtrMaker<recob::Hit> const makeHitBPtr
+    { event, art::InputTag{ "hitsB" } };
+
+  // same keys from different products are matched to different particles;
+  // hit A#2 has no particle, while B#2 has
+  HitParticleAssociations assns;
+  assns.addSingle(makePartPtr(0), makeHitAPtr(0), makeMatch(1.0));
+  assns.addSingle(makePartPtr(1), makeHitBPtr(0), makeMatch(0.6));
+  assns.addSingle(makePartPtr(2), makeHitBPtr(0), makeMatch(0.4));
+  assns.addSingle(makePartPtr(0), makeHitAPtr(1), makeMatch(0.9));
+  assns.addSingle(makePartPtr(1), makeHitBPtr(2), makeMatch(1.0));
+  assns.addSingle(makePartPtr(1), makeHitBPtr(2), makeMatch(1.0));
+  assns.addSingle(makePartPtr(2), makeHitAPtr(3), makeMatch(0.5));
+  assns.addSingle(makePartPtr(2), makeHitBPtr(3), makeMatch(0.5));
+
+  std::vector<art::Ptr<recob::Hit>> allHits;
+  for (std::size_t i = 0; i < 4U; ++i) {
+    allHits.push_back(makeHitAPtr(i));
+    allHits.push_back(makeHitBPtr(i));
+  }
+  std::vector<int> const allTrackIDs { 0, 1, 2, 3, 4 };
+
+  truth::MCTruthHitParticleTable table;
+  table.fill(assns);
+  checkTable(table, assns, allHits, allTrackIDs);
+
+  // back to a single product: the lookup by key is used again
+  HitParticleAssociations assnsA;
+  assnsA.addSingle(makePartPtr(1), makeHitAPtr(2), makeMatch(1.0));
+  assnsA.addSingle(makePartPtr(0), makeHitAPtr(1), makeMatch(1.0));
+  table.fill(assnsA);
+  checkTable(table, assnsA, allHits, allTrackIDs);
+
+} // twoProductsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( SingleProductTestCase ) {
+  singleProductTest();
+} // BOOST_AUTO_TEST_CASE( SingleProductTestCase )
+
+BOOST_AUTO_TEST_CASE( TwoProductsTestCase ) {
+  twoProductsTest();
+} // BOOST_AUTO_TEST_CASE( TwoProductsTestCase )
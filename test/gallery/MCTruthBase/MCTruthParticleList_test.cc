@@ -0,0 +1,285 @@
+/**
+ * @file   MCTruthParticleList_test.cc
+ * @brief  Unit test for the lookup table and eve IDs of
+ *         `truth::MCTruthParticleList`.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/gallery/MCTruthBase/MCTruthParticleList.h`
+ *
+ * The answers with the flat lookup table (`BuildLookupTable()`) are compared
+ * with the ones from the particle map, and the eve IDs computed all at once
+ * (`ComputeAllEveIds()`) with the ones computed on demand, particle by
+ * particle.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE MCTruthParticleList
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/gallery/MCTruthBase/MCTruthParticleList.h"
+#include "icarusalg/gallery/MCTruthBase/MCTruthEmEveIdCalculator.h"
+
+// LArSoft libraries
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <stdexcept> // std::out_of_range
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /**
+   * @brief Returns particles with the specified track IDs.
+   * @param trackIDs the track IDs of the particles, in order
+   * @return a collection of particles, one per track ID
+   *
+   * The particles are in groups of 50, each starting with a primary particle.
+   * The mother of each other particle is one of the few particles before it
+   * in its group, and it is created by a hadronic process or by one of the
+   * electromagnetic processes which pass the eve ID on to the daughter.
+   * Every 37th particle instead has a mother which is not in the list.
+   */
+  std::vector<simb::MCParticle> makeParticles(std::vector<int> const& trackIDs)
+  {
+    static std::string const Processes[]
+      = { "Decay", "eIoni", "conv", "compt", "muIoni", "eBrem" };
+    int const lostMother
+      = *std::max_element(trackIDs.begin(), trackIDs.end()) + 1000;
+
+    std::vector<simb::MCParticle> particles;
+    for (std::size_t i = 0; i < trackIDs.size(); ++i) {
+      std::size_t const groupStart = i - i % 50;
+      if (i == groupStart) {
+        particles.emplace_back(trackIDs[i], 13, "primary", 0, 0.105658, 1);
+        continue;
+      }
+      std::size_t const iMother
+        = std::max(groupStart, i - 1 - std::min<std::size_t>(i % 3, i - 1));
+      int const mother = (i % 37 == 0)? lostMother: trackIDs[iMother];
+      particles.emplace_back
+        (trackIDs[i], 11, Processes[i % 6], mother, 0.000511, 1);
+    } // for
+
+    return particles;
+  } // makeParticles()
+
+
+  /// Fills `list` with all the `particles`.
+  void fillList(
+    truth::MCTruthParticleList& list,
+    std::vector<simb::MCParticle> const& particles
+  ) {
+    for (simb::MCParticle const& particle: particles) list.Add(&particle);
+  } // fillList()
+
+
+  /// The answers of the list about a track ID.
+  struct TrackInfo_t {
+    simb::MCParticle const* particle = nullptr;
+    bool known = false;
+    bool primary = false;
+    bool hasMother = false;
+    int mother = 0;
+
+    bool operator== (TrackInfo_t const& other) const
+      {
+        return (particle == other.particle) && (known == other.known)
+          && (primary == other.primary) && (hasMother == other.hasMother)
+          && (mother == other.mother);
+      }
+  }; // TrackInfo_t
+
+  TrackInfo_t trackInfo(truth::MCTruthParticleList const& list, int trackID) {
+    TrackInfo_t info;
+    info.particle = list.FindParticle(trackID);
+    info.known = list.KnownParticle(trackID);
+    info.primary = list.IsPrimary(trackID);
+    try {
+      info.mother = list.GetMotherOf(trackID);
+      info.hasMother = true;
+    }
+    catch (std::out_of_range const&) {}
+    BOOST_TEST(list.HasParticle(trackID) == (info.particle != nullptr));
+    return info;
+  } // trackInfo()
+
+
+  /// Returns the IDs to probe: all the track IDs, their opposite, and more.
+  std::vector<int> probeIDs(std::vector<int> const& trackIDs) {
+    std::vector<int> IDs { 0 };
+    for (int const trackID: trackIDs) {
+      IDs.push_back(trackID);
+      IDs.push_back(-trackID);
+      IDs.push_back(trackID + 1); // sometimes in the list, sometimes not
+    }
+    IDs.push_back(trackIDs.back() + 100000);
+    return IDs;
+  } // probeIDs()
+
+
+  /// Returns `n` track IDs from `first`, with one every `holes` skipped.
+  std::vector<int> denseTrackIDs(std::size_t n, int first, int holes) {
+    std::vector<int> trackIDs;
+    for (int trackID = first; trackIDs.size() < n; ++trackID)
+      if ((trackID - first) % holes != holes - 1) trackIDs.push_back(trackID);
+    return trackIDs;
+  } // denseTrackIDs()
+
+  /// Returns `n` track IDs from `first`, with distance `step`.
+  std::vector<int> sparseTrackIDs(std::size_t n, int first, int step) {
+    std::vector<int> trackIDs;
+    for (std::size_t i = 0; i < n; ++i)
+      trackIDs.push_back(first + static_cast<int>(i) * step);
+    return trackIDs;
+  } // sparseTrackIDs()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void lookupTableTest(std::vector<int> const& trackIDs) {
+
+  std::vector<simb::MCParticle> const particles = makeParticles(trackIDs);
+  std::vector<int> const IDs = probeIDs(trackIDs);
+
+  truth::MCTruthParticleList list;
+  fillList(list, particles);
+  BOOST_TEST(!list.HasLookupTable());
+
+  // answers from the particle map
+  std::vector<TrackInfo_t> expected;
+  for (int const trackID: IDs) expected.push_back(trackInfo(list, trackID));
+
+  std::size_t const mapMemory = list.MemoryUsage();
+  list.BuildLookupTable();
+  BOOST_TEST(list.HasLookupTable());
+  BOOST_TEST(list.MemoryUsage() > mapMemory);
+
+  for (std::size_t i = 0; i < IDs.size(); ++i) {
+    BOOST_TEST_CONTEXT("track ID " << IDs[i]) {
+      BOOST_TEST((trackInfo(list, IDs[i]) == expected[i]));
+    }
+  } // for
+
+  // the table is discarded when the list changes
+  simb::MCParticle const extra
+    { trackIDs.back() + 1, 13, "primary", 0, 0.105658, 1 };
+  list.Add(&extra);
+  BOOST_TEST(!list.HasLookupTable());
+  BOOST_TEST(list.FindParticle(extra.TrackId()) == &extra);
+
+  list.BuildLookupTable();
+  BOOST_TEST(list.HasLookupTable());
+  BOOST_TEST(list.FindParticle(extra.TrackId()) == &extra);
+  BOOST_TEST(list.IsPrimary(extra.TrackId()));
+
+  list.clear();
+  BOOST_TEST(!list.HasLookupTable());
+
+} // lookupTableTest()
+
+
+//------------------------------------------------------------------------------
+void lookupTableMemoryTest() {
+
+  /*
+   * With the same number of particles, a dense table has an entry for each
+   * track ID in the range (including the holes), a sparse table has one
+   * entry per particle.
+   */
+  constexpr std::size_t NParticles = 500;
+
+  std::vector<simb::MCParticle> const denseParticles
+    = makeParticles(denseTrackIDs(NParticles, 1, 2));
+  std::vector<simb::MCParticle> const sparseParticles
+    = makeParticles(sparseTrackIDs(NParticles, 1, 1000));
+
+  truth::MCTruthParticleList denseList, sparseList;
+  fillList(denseList, denseParticles);
+  fillList(sparseList, sparseParticles);
+  BOOST_TEST(denseList.MemoryUsage() == sparseList.MemoryUsage());
+
+  denseList.BuildLookupTable();
+  sparseList.BuildLookupTable();
+  BOOST_TEST(denseList.MemoryUsage() > sparseList.MemoryUsage());
+
+} // lookupTableMemoryTest()
+
+
+//------------------------------------------------------------------------------
+void allEveIdsTest(std::vector<int> const& trackIDs) {
+
+  std::vector<simb::MCParticle> const particles = makeParticles(trackIDs);
+  std::vector<int> const IDs = probeIDs(trackIDs);
+
+  // eve IDs computed on demand, one by one
+  std::vector<int> expected;
+  {
+    truth::MCTruthParticleList list;
+    fillList(list, particles);
+    list.AdoptEveIdCalculator(new truth::MCTruthEmEveIdCalculator);
+    for (int const trackID: IDs) expected.push_back(list.EveId(trackID));
+  }
+
+  // sanity check: there are particles which are their own eve,
+  // particles with an ancestor as eve, and particles with no eve
+  std::size_t nOwnEve = 0, nAncestorEve = 0, nNoEve = 0;
+  for (std::size_t i = 0; i < IDs.size(); ++i) {
+    if (IDs[i] <= 0) continue;
+    if (expected[i] == IDs[i]) ++nOwnEve;
+    else if (expected[i] == 0) ++nNoEve;
+    else ++nAncestorEve;
+  } // for
+  BOOST_TEST(nOwnEve > 0U);
+  BOOST_TEST(nAncestorEve > 0U);
+  BOOST_TEST(nNoEve > 0U);
+
+  for (unsigned int const nThreads: { 1U, 4U, 0U }) {
+    for (bool const lookupTable: { false, true }) {
+      BOOST_TEST_CONTEXT
+        ("threads: " << nThreads << ", lookup table: " << lookupTable)
+      {
+        truth::MCTruthParticleList list;
+        fillList(list, particles);
+        if (lookupTable) list.BuildLookupTable();
+        list.AdoptEveIdCalculator(new truth::MCTruthEmEveIdCalculator);
+        list.ComputeAllEveIds(nThreads);
+
+        for (std::size_t i = 0; i < IDs.size(); ++i) {
+          BOOST_TEST_CONTEXT("track ID " << IDs[i]) {
+            BOOST_TEST(list.EveId(IDs[i]) == expected[i]);
+          }
+        } // for
+      } // context
+    } // for lookup table
+  } // for threads
+
+} // allEveIdsTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( DenseLookupTableTestCase ) {
+  lookupTableTest(denseTrackIDs(200U, 1, 3));
+} // BOOST_AUTO_TEST_CASE( DenseLookupTableTestCase )
+
+BOOST_AUTO_TEST_CASE( SparseLookupTableTestCase ) {
+  lookupTableTest(sparseTrackIDs(200U, 5, 10000));
+} // BOOST_AUTO_TEST_CASE( SparseLookupTableTestCase )
+
+BOOST_AUTO_TEST_CASE( LookupTableMemoryTestCase ) {
+  lookupTableMemoryTest();
+} // BOOST_AUTO_TEST_CASE( LookupTableMemoryTestCase )
+
+BOOST_AUTO_TEST_CASE( DenseAllEveIdsTestCase ) {
+  allEveIdsTest(denseTrackIDs(1000U, 1, 4));
+} // BOOST_AUTO_TEST_CASE( DenseAllEveIdsTestCase )
+
+BOOST_AUTO_TEST_CASE( SparseAllEveIdsTestCase ) {
+  allEveIdsTest(sparseTrackIDs(1000U, 3, 7919));
+} // BOOST_AUTO_TEST_CASE( SparseAllEveIdsTestCase )
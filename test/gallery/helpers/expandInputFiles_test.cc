@@ -0,0 +1,90 @@
+/**
+ * @file   expandInputFiles_test.cc
+ * @brief  Unit test for the expansion of file lists.
+ * @date   October 15, 2026
+ * @author Gianluca Petrillo (petrillo@slac.stanford.edu)
+ * @see    `icarusalg/gallery/helpers/C++/expandInputFiles.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE expandInputFiles
+#include <boost/test/unit_test.hpp>
+
+// ICARUS libraries
+#include "icarusalg/gallery/helpers/C++/expandInputFiles.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+/// Writes a file list `path` with the specified `entries`, one per line.
+void writeList(std::string const& path, std::vector<std::string> const& entries)
+{
+  std::ofstream list { path };
+  list << "# test file list" << "\n";
+  for (std::string const& entry: entries) list << entry << "\n";
+} // writeList()
+
+
+//------------------------------------------------------------------------------
+void nestedListTest() {
+  
+  // the same list included twice is not a recursion
+  writeList("nested_inner.list", { "B.root", "C.root" });
+  writeList("nested_outer.list",
+    { "A.root", "nested_inner.list", "D.root", "nested_inner.list" });
+  
+  std::vector<std::string> const expected
+    { "A.root", "B.root", "C.root", "D.root", "B.root", "C.root" };
+  
+  std::vector<std::string> const files = expandFileList("nested_outer.list");
+  BOOST_TEST(files == expected, boost::test_tools::per_element());
+  
+  std::vector<std::string> const inputs { "Z.root", "nested_outer.list" };
+  std::vector<std::string> expectedInputs { "Z.root" };
+  expectedInputs.insert(expectedInputs.end(), expected.begin(), expected.end());
+  
+  BOOST_TEST(expandInputFiles(inputs) == expectedInputs,
+    boost::test_tools::per_element());
+  BOOST_TEST(expandInputFiles(inputs, 4U) == expectedInputs,
+    boost::test_tools::per_element());
+  
+} // nestedListTest()
+
+
+//------------------------------------------------------------------------------
+void selfIncludingListTest() {
+  
+  // a list including itself directly...
+  writeList("self.list", { "A.root", "self.list" });
+  
+  BOOST_CHECK_THROW(expandFileList("self.list"), std::runtime_error);
+  BOOST_CHECK_THROW
+    (expandInputFiles({ "self.list" }), std::runtime_error);
+  BOOST_CHECK_THROW
+    (expandInputFiles({ "self.list" }, 2U), std::runtime_error);
+  
+  // ... and through another list
+  writeList("loopA.list", { "A.root", "loopB.list" });
+  writeList("loopB.list", { "B.root", "loopA.list" });
+  
+  BOOST_CHECK_THROW(expandFileList("loopA.list"), std::runtime_error);
+  BOOST_CHECK_THROW
+    (expandInputFiles({ "loopB.list" }), std::runtime_error);
+  BOOST_CHECK_THROW
+    (expandInputFiles({ "loopA.list" }, 2U), std::runtime_error);
+  
+} // selfIncludingListTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(NestedListTestCase) {
+  nestedListTest();
+} // BOOST_AUTO_TEST_CASE(NestedListTestCase)
+
+BOOST_AUTO_TEST_CASE(SelfIncludingListTestCase) {
+  selfIncludingListTest();
+} // BOOST_AUTO_TEST_CASE(SelfIncludingListTestCase)